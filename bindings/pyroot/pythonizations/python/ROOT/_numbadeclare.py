@@ -20,8 +20,13 @@ def _NumbaDeclareDecorator(input_types, return_type, name=None):
     the attribute __cpp_wrapper__.
 
     Note that the callable is fully compiled without side-effects. The numba jitting uses the nopython
-    option which does not allow interaction with the Python interpreter. This means that you can use
-    the resulting function also safely in multi-threaded environments.
+    and nogil options which do not allow interaction with the Python interpreter. This means that you
+    can use the resulting function also safely in multi-threaded environments, for example in the
+    processing slots of RDataFrame. The fully qualified name of the C++ function is accessible by the
+    attribute __cpp_name__, and the decorated callable can be given directly to RDataFrame.Define and
+    RDataFrame.Filter:
+
+        df.Define("y", func, ["x"])
     '''
     # Make required imports
     try:
@@ -126,7 +131,7 @@ def _NumbaDeclareDecorator(input_types, return_type, name=None):
         # Jit the given Python callable with numba
         nb_return_type, nb_input_types = get_numba_signature(input_types, return_type)
         try:
-            nbjit = nb.jit(nb_return_type(*nb_input_types), nopython=True, inline='always')(func)
+            nbjit = nb.jit(nb_return_type(*nb_input_types), nopython=True, nogil=True, inline='always')(func)
         except:
             raise Exception('Failed to jit Python callable {} with numba.jit'.format(func))
         func.numba_func = nbjit
@@ -206,7 +211,7 @@ def pywrapper({SIGNATURE}):
         # Jit the Python wrapper code
         c_return_type, c_input_types = get_c_signature(input_types, return_type)
         try:
-            nbcfunc = nb.cfunc(c_return_type(*c_input_types), nopython=True)(locals()['pywrapper'])
+            nbcfunc = nb.cfunc(c_return_type(*c_input_types), nopython=True, nogil=True)(locals()['pywrapper'])
         except:
             raise Exception('Failed to jit Python wrapper with numba.cfunc')
         func.__py_wrapper__ = pywrappercode
@@ -307,6 +312,7 @@ namespace Numba {{
         if not err:
             raise Exception('Failed to jit C++ wrapper code with cling:\n{}'.format(cppwrappercode))
         func.__cpp_wrapper__ = cppwrappercode
+        func.__cpp_name__ = 'Numba::' + name
 
         return func
 
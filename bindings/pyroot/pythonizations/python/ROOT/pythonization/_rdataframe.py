@@ -130,6 +130,64 @@ def _histo_profile(self, fixed_args, *args):
     return res
 
 
+def _numba_expression(func, columns):
+    # Build the expression calling in C++ a Python callable declared with
+    # ROOT.Numba.Declare, with the given columns or with the names of its
+    # arguments as default
+    if columns is None:
+        code = getattr(func, "__code__", None)
+        if code is None:
+            raise TypeError("The columns of {} have to be given explicitly".format(func))
+        columns = code.co_varnames[:code.co_argcount]
+    elif isinstance(columns, str):
+        raise TypeError("The columns argument requires a list of strings")
+    return "{}({})".format(func.__cpp_name__, ", ".join(columns))
+
+
+def _is_numba_declared(func):
+    return callable(func) and hasattr(func, "__cpp_name__") and hasattr(func, "__cpp_wrapper__")
+
+
+def _define_numba(self, name, expression, columns=None):
+    # Accept as expression of Define a Python callable declared with
+    # ROOT.Numba.Declare, which is called in C++ without the GIL from all the
+    # processing slots:
+    # df.Define("y", numba_declared_func, ["x"])
+    if _is_numba_declared(expression):
+        return self._OriginalDefine(name, _numba_expression(expression, columns))
+    if columns is None:
+        return self._OriginalDefine(name, expression)
+    return self._OriginalDefine(name, expression, columns)
+
+
+def _filter_numba(self, expression, columns=None, name=None):
+    # Accept as expression of Filter a Python callable declared with
+    # ROOT.Numba.Declare, see _define_numba
+    if _is_numba_declared(expression):
+        expression = _numba_expression(expression, columns)
+        return self._OriginalFilter(expression, name) if name else self._OriginalFilter(expression)
+    args = [arg for arg in (columns, name) if arg is not None]
+    return self._OriginalFilter(expression, *args)
+
+
+@pythonization()
+def pythonize_rresultptr(klass, name):
+    # Parameters:
+    # klass: class to be pythonized
+    # name: string containing the name of the class
+
+    if name.startswith("ROOT::RDF::RResultPtr<"):
+        # Release the GIL while the event loop runs, so that other Python
+        # threads can proceed. Python callables invoked by the event loop
+        # acquire it again when they are called.
+        for method_name in ("GetValue", "GetPtr"):
+            method = getattr(klass, method_name, None)
+            if method is not None:
+                method.__release_gil__ = True
+
+    return True
+
+
 @pythonization()
 def pythonize_rdataframe(klass, name):
     # Parameters:
@@ -142,6 +200,15 @@ def pythonize_rdataframe(klass, name):
         # Add asNumpy feature
         klass.AsNumpy = RDataFrameAsNumpy
 
+        # Release the GIL while running the event loops
+        RDF.RunGraphs.__release_gil__ = True
+
+        # Accept functions declared with ROOT.Numba.Declare in Define and Filter
+        klass._OriginalDefine = klass.Define
+        klass.Define = _define_numba
+        klass._OriginalFilter = klass.Filter
+        klass.Filter = _filter_numba
+
         # Replace the implementation of the following RDF methods
         # to convert a tuple argument into a model object
         methods_with_TModel = {
@@ -124,6 +124,21 @@ t.SetBranchAddress('classb', cb)
 ms = ROOT.MyStruct()
 ds.SetBranchAddress('structb', ms)
 \endcode
+
+Finally, the branches of fundamental types, or of fixed-size arrays thereof,
+can be read into NumPy arrays with the bulk I/O interface of TBranch.
+TTree::AsNumpy returns a dictionary of arrays, like RDataFrame::AsNumpy, and
+TTree::IterBulk iterates over the baskets of a branch, yielding NumPy views
+over the buffer of each basket without copying its content:
+\code{.py}
+arrays = t.AsNumpy(['floatb', 'arrayb'])
+print(arrays['arrayb'].shape) # (t.GetEntries(), 10)
+
+total = 0.
+for first_entry, values in t.IterBulk('floatb'):
+    # values is only valid until the next iteration
+    total += values.sum()
+\endcode
 \htmlonly
 </div>
 \endhtmlonly
@@ -131,6 +146,7 @@ ds.SetBranchAddress('structb', ms)
 '''
 
 from libROOTPythonizations import AddBranchAttrSyntax, SetBranchAddressPyz, BranchPyz
+from libROOTPythonizations import GetEndianess, GetDataPointer
 
 import cppyy
 from ROOT import pythonization
@@ -293,6 +309,144 @@ def _TTreeAsMatrix(self, columns=None, exclude=None, dtype="double", return_labe
     else:
         return reshaped_matrix_np
 
+# Bulk reading into numpy arrays
+_bulk_dtype_map = {
+    "Bool_t": "b1",
+    "Char_t": "i1",
+    "UChar_t": "u1",
+    "Short_t": "i2",
+    "UShort_t": "u2",
+    "Int_t": "i4",
+    "UInt_t": "u4",
+    "Float_t": "f4",
+    "Double_t": "f8",
+    "Long64_t": "i8",
+    "ULong64_t": "u8",
+}
+
+
+class _BulkBufferView(object):
+    """Array interface over the values of a buffer filled by TBranch bulk reads.
+
+    The numpy arrays created from it keep it, and thereby the buffer, alive.
+    """
+    def __init__(self, buf, data, shape, typestr):
+        self.buf = buf
+        self.__array_interface__ = {
+            "shape": shape,
+            "typestr": typestr,
+            "version": 3,
+            "data": (data, True)
+        }
+
+
+def _bulk_trees(tree):
+    # Yield the trees of a chain, or the tree itself, with their first entry
+    if isinstance(tree, cppyy.gbl.TChain):
+        # Make sure that the offsets of all the trees are known
+        tree.GetEntries()
+        for i in range(tree.GetNtrees()):
+            offset = tree.GetTreeOffset()[i]
+            if tree.LoadTree(offset) < 0:
+                raise RuntimeError("Failed to load tree {} of chain {}.".format(i, tree.GetName()))
+            yield offset, tree.GetTree()
+    else:
+        yield 0, tree
+
+
+def _bulk_branch_info(tree, column):
+    # Return the numpy type string and the number of values per entry of a branch
+    branch = tree.GetBranch(column)
+    if not branch:
+        raise KeyError("Branch {} not found in tree {}.".format(column, tree.GetName()))
+    leaves = branch.GetListOfLeaves()
+    leaf_type = leaves[0].GetTypeName() if leaves.GetEntries() == 1 else None
+    if leaf_type not in _bulk_dtype_map or leaves[0].GetLeafCount() or not branch.SupportsBulkRead():
+        raise TypeError("Branch {} is not a fundamental type or a fixed-size array thereof and can not be read "
+                        "in bulk, please use RDataFrame.AsNumpy instead.".format(column))
+    dtype = _bulk_dtype_map[leaf_type]
+    endianess = GetEndianess() if dtype[1] != "1" else "|"
+    return branch, endianess + dtype, leaves[0].GetLenStatic()
+
+
+def _TTreeIterBulk(self, column):
+    """Iterate over the baskets of a branch with the bulk I/O interface.
+
+    The branch must hold a fundamental type or a fixed-size array thereof.
+    Each iteration reads one basket and yields the first entry of the basket
+    and a numpy view on its values, of shape (entries,) or (entries, length)
+    for arrays. The view is over the buffer of the basket and does not copy
+    its content: it is reused by the next iteration, so the values have to be
+    copied to be kept.
+
+    Parameters:
+        column: Name of the branch.
+
+    Yields:
+        (int, array): Index of the first entry and values of the basket
+    """
+    import numpy
+
+    for offset, tree in _bulk_trees(self):
+        branch, typestr, length = _bulk_branch_info(tree, column)
+        buf = cppyy.gbl.TBufferFile(cppyy.gbl.TBuffer.kWrite, 32 * 1024)
+        entry = 0
+        nentries = branch.GetEntries()
+        while entry < nentries:
+            count = branch.GetBulkRead().GetBulkEntries(entry, buf)
+            if count <= 0:
+                raise RuntimeError("Bulk read of branch {} failed at entry {}.".format(column, offset + entry))
+            count = min(count, nentries - entry)
+            shape = (count, length) if length > 1 else (count, )
+            data = GetDataPointer(buf, "TBufferFile", "GetCurrent")
+            yield offset + entry, numpy.asarray(_BulkBufferView(buf, data, shape, typestr))
+            entry += count
+
+
+def _TTreeAsNumpy(self, columns=None, exclude=None):
+    """Read-out branches of the TTree as a collection of numpy arrays.
+
+    Only the branches of fundamental types, or of fixed-size arrays thereof,
+    are supported: they are read in bulk, basket by basket, directly into
+    numpy arrays allocated once for all the entries. For the other branches,
+    please use RDataFrame.AsNumpy.
+
+    Parameters:
+        columns: If None return all branches as columns, otherwise specify names in iterable.
+        exclude: Exclude branches from selection.
+
+    Returns:
+        dict: Dict with column names as keys and numpy arrays with content as values
+    """
+    if isinstance(columns, str):
+        raise TypeError("The columns argument requires a list of strings")
+    if isinstance(exclude, str):
+        raise TypeError("The exclude argument requires a list of strings")
+
+    try:
+        import numpy
+    except:
+        raise ImportError("Failed to import numpy during call of TTree.AsNumpy.")
+
+    if columns is None:
+        columns = [branch.GetName() for branch in self.GetListOfBranches()]
+    if exclude is None:
+        exclude = []
+    columns = [col for col in columns if not col in exclude]
+
+    nentries = self.GetEntries()
+    py_arrays = {}
+    for column in columns:
+        _, typestr, length = _bulk_branch_info(self, column)
+        shape = (nentries, length) if length > 1 else (nentries, )
+        array = numpy.empty(shape, dtype=numpy.dtype(typestr))
+        for first, values in _TTreeIterBulk(self, column):
+            array[first:first + len(values)] = values
+        py_arrays[column] = array
+
+    return py_arrays
+
+
 @pythonization()
 def pythonize_ttree(klass, name):
     # Parameters:
@@ -329,4 +483,8 @@ def pythonize_ttree(klass, name):
         # AsMatrix
         klass.AsMatrix = _TTreeAsMatrix
 
+        # Bulk reading into numpy arrays
+        klass.AsNumpy = _TTreeAsNumpy
+        klass.IterBulk = _TTreeIterBulk
+
     return True
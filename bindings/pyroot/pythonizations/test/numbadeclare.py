@@ -128,6 +128,22 @@ class NumbaDeclareSimple(unittest.TestCase):
         self.assertEqual(mean_x.GetValue(), 1.5)
         self.assertEqual(mean_y.GetValue(), 3.0)
 
+    @unittest.skipIf(skip, skip_reason)
+    def test_rdataframe_callable(self):
+        """
+        Test declared function given as callable to Define and Filter
+        """
+        @ROOT.Numba.Declare(["unsigned long"], "double")
+        def fn13b(x):
+            return 2.0 * x
+        @ROOT.Numba.Declare(["double"], "bool")
+        def fn13c(y):
+            return y > 2.5
+        self.assertEqual(fn13b.__cpp_name__, "Numba::fn13b")
+        df = ROOT.RDataFrame(4).Define("y", fn13b, ["rdfentry_"]).Filter(fn13c)
+        self.assertEqual(df.Count().GetValue(), 2)
+        self.assertEqual(df.Sum("y").GetValue(), 10.0)
+
     # Test wrappings
     @unittest.skipIf(skip, skip_reason)
     def test_wrapper_in_void(self):
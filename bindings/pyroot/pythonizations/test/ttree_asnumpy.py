@@ -0,0 +1,86 @@
+import unittest
+import ROOT
+import numpy as np
+
+
+class TTreeAsNumpy(unittest.TestCase):
+    """
+    Test for the bulk reading of TTree branches into numpy arrays
+    """
+
+    filename = "ttree_asnumpy.root"
+    nentries = 10000
+
+    @classmethod
+    def setUpClass(cls):
+        f = ROOT.TFile(cls.filename, "RECREATE")
+        t = ROOT.TTree("tree", "tree")
+        x = np.empty(1, dtype=np.float32)
+        n = np.empty(1, dtype=np.int64)
+        a = np.empty(3, dtype=np.float64)
+        t.Branch("x", x, "x/F")
+        t.Branch("n", n, "n/L")
+        t.Branch("a", a, "a[3]/D")
+        # Use small baskets to read several of them
+        t.SetBasketSize("*", 4000)
+        for i in range(cls.nentries):
+            x[0] = 0.5 * i
+            n[0] = -i
+            a[:] = [i, 2 * i, 3 * i]
+            t.Fill()
+        f.Write()
+        f.Close()
+
+    def test_asnumpy(self):
+        f = ROOT.TFile(self.filename)
+        t = f.Get("tree")
+        arrays = t.AsNumpy()
+        self.assertEqual(sorted(arrays.keys()), ["a", "n", "x"])
+        ref = np.arange(self.nentries)
+        np.testing.assert_equal(arrays["x"], (0.5 * ref).astype(np.float32))
+        np.testing.assert_equal(arrays["n"], -ref)
+        self.assertEqual(arrays["a"].shape, (self.nentries, 3))
+        np.testing.assert_equal(arrays["a"][:, 2], 3 * ref)
+
+    def test_asnumpy_exclude(self):
+        f = ROOT.TFile(self.filename)
+        t = f.Get("tree")
+        arrays = t.AsNumpy(["x", "n"], exclude=["n"])
+        self.assertEqual(list(arrays.keys()), ["x"])
+
+    def test_chain(self):
+        c = ROOT.TChain("tree")
+        c.Add(self.filename)
+        c.Add(self.filename)
+        arrays = c.AsNumpy(["n"])
+        ref = np.arange(self.nentries)
+        np.testing.assert_equal(arrays["n"], np.concatenate([-ref, -ref]))
+
+    def test_iterbulk(self):
+        f = ROOT.TFile(self.filename)
+        t = f.Get("tree")
+        nbaskets = 0
+        expected = 0
+        for first, values in t.IterBulk("x"):
+            self.assertEqual(first, expected)
+            self.assertFalse(values.flags.writeable)
+            np.testing.assert_equal(values, (0.5 * np.arange(first, first + len(values))).astype(np.float32))
+            expected += len(values)
+            nbaskets += 1
+        self.assertEqual(expected, self.nentries)
+        self.assertGreater(nbaskets, 1)
+
+    def test_unsupported_branch(self):
+        f = ROOT.TFile("ttree_asnumpy_vector.root", "RECREATE")
+        t = ROOT.TTree("tree", "tree")
+        v = ROOT.std.vector("float")()
+        t.Branch("v", v)
+        t.Fill()
+        with self.assertRaises(TypeError):
+            t.AsNumpy(["v"])
+        with self.assertRaises(KeyError):
+            t.AsNumpy(["nonexistent"])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -418,6 +418,11 @@ if(veccore)
 else()
   set(hasveccore undef)
 endif()
+if(clad)
+  set(hasclad define)
+else()
+  set(hasclad undef)
+endif()
 if(dataframe)
   set(hasdataframe define)
 else()
@@ -507,6 +512,11 @@ if (uring)
 else()
   set(hasuring undef)
 endif()
+if (tracing)
+  set(hastracing define)
+else()
+  set(hastracing undef)
+endif()
 
 # clear cache to allow reconfiguring
 # with a different CMAKE_CXX_STANDARD
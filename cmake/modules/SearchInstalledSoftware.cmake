@@ -1237,6 +1237,20 @@ if (jemalloc)
   endif()
 endif()
 
+#---Check for BLAS/LAPACK----------------------------------------------------------
+if (lapack)
+  message(STATUS "Looking for LAPACK for libMatrix")
+  find_package(LAPACK)
+  if(NOT LAPACK_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "LAPACK not found and lapack option required")
+    else()
+      message(STATUS "LAPACK not found. Switching off lapack option")
+      set(lapack OFF CACHE BOOL "Disabled because LAPACK was not found (${lapack_description})" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for liburing----------------------------------------------------------------
 if (uring)
   if(NOT CMAKE_SYSTEM_NAME MATCHES Linux)
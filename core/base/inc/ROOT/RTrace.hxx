@@ -0,0 +1,103 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RTrace
+#define ROOT_RTrace
+
+#include "RConfig.h"
+#include "DllImport.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace ROOT {
+namespace Experimental {
+
+/**
+\class ROOT::Experimental::RTrace
+\ingroup Base
+\brief Timeline of ROOT's hot paths across threads, written as a Chrome trace.
+
+If ROOT is built with `-Dtracing=ON`, the hot paths of ROOT record spans while the recording is active: IMT tasks,
+TFile::ReadBuffers(), compression and decompression, TTreeCache::FillBuffer(), the reading and unzipping of RNTuple
+clusters, the event loop tasks of RDataFrame and its jitting. Write() stores them in the JSON format of the Chrome
+tracing, which can be opened in https://ui.perfetto.dev or chrome://tracing to see which threads wait for which.
+
+~~~ {.cpp}
+ROOT::Experimental::RTrace::Start();
+df.Sum("x").GetValue();
+ROOT::Experimental::RTrace::Stop();
+ROOT::Experimental::RTrace::Write("trace.json");
+~~~
+
+Alternatively, the environment variable ROOT_TRACE=trace.json records the whole process and writes the trace at
+exit. When the recording is inactive, a span costs one relaxed atomic load; without `-Dtracing=ON`, R__TRACE_SPAN()
+expands to nothing. Every thread records at most kMaxSpansPerThread spans, further ones are dropped.
+*/
+class RTrace {
+public:
+   static constexpr std::size_t kMaxSpansPerThread = 1 << 20;
+
+   static void Start();
+   static void Stop();
+   static bool IsActive();
+   static bool Write(const char *filename);
+   static void Clear();
+};
+
+namespace Internal {
+
+R__EXTERN std::atomic<bool> gTraceActive;
+
+/// Records the span from its construction to its destruction. `category` and `name` must be string literals.
+class RTraceSpan {
+   const char *fCategory;
+   const char *fName;
+   std::uint64_t fStart = 0;
+   bool fIsActive;
+
+public:
+   static std::uint64_t Now();
+   static void Record(const char *category, const char *name, std::uint64_t start, std::uint64_t end);
+
+   RTraceSpan(const char *category, const char *name)
+      : fCategory(category), fName(name), fIsActive(gTraceActive.load(std::memory_order_relaxed))
+   {
+      if (fIsActive)
+         fStart = Now();
+   }
+   RTraceSpan(const RTraceSpan &) = delete;
+   RTraceSpan &operator=(const RTraceSpan &) = delete;
+   ~RTraceSpan()
+   {
+      if (fIsActive)
+         Record(fCategory, fName, fStart, Now());
+   }
+};
+
+} // namespace Internal
+} // namespace Experimental
+} // namespace ROOT
+
+inline bool ROOT::Experimental::RTrace::IsActive()
+{
+   return Internal::gTraceActive.load(std::memory_order_relaxed);
+}
+
+#ifdef R__HAS_TRACING
+#define R__TRACE_SPAN(category, name) \
+   ::ROOT::Experimental::Internal::RTraceSpan _R__UNIQUE_(R__tracespan)(category, name)
+#else
+#define R__TRACE_SPAN(category, name) \
+   do {                               \
+   } while (false)
+#endif
+
+#endif
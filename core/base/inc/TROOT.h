@@ -68,6 +68,10 @@ namespace Internal {
 
    TROOT *GetROOT2();
 
+   // Deferred creation of the interpreter (Root.LazyInterpreter)
+   Bool_t IsInterpreterDeferred();
+   TInterpreter *InitDeferredInterpreter();
+
    // Manage parallel branch processing
    void EnableParBranchProcessing();
    void DisableParBranchProcessing();
@@ -95,6 +99,7 @@ class TROOT : public TDirectory {
 
 friend class TCling;
 friend TROOT *ROOT::Internal::GetROOT2();
+friend TInterpreter *ROOT::Internal::InitDeferredInterpreter();
 
 private:
    Int_t           fLineIsProcessing;     //To synchronize multi-threads
@@ -0,0 +1,220 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RTrace.hxx"
+#include "TError.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Internal {
+std::atomic<bool> gTraceActive{false};
+} // namespace Internal
+} // namespace Experimental
+} // namespace ROOT
+
+namespace {
+
+struct RSpan {
+   const char *fCategory;
+   const char *fName;
+   std::uint64_t fStart;
+   std::uint64_t fEnd;
+};
+
+/// The spans of one thread. Only the thread itself appends to them, the lock is uncontended unless
+/// the trace is written or cleared meanwhile.
+struct RThreadSpans {
+   std::mutex fMutex;
+   std::vector<RSpan> fSpans;
+   std::uint64_t fNDropped = 0;
+   std::uint32_t fThreadId = 0;
+};
+
+struct RTraceRegistry {
+   std::mutex fMutex;
+   /// Kept beyond the end of their threads, so that the trace covers the finished threads, too
+   std::vector<std::shared_ptr<RThreadSpans>> fThreads;
+};
+
+RTraceRegistry &GetRegistry()
+{
+   // Never destructed: spans can be recorded by threads ending after the static destructors
+   static auto registry = new RTraceRegistry;
+   return *registry;
+}
+
+RThreadSpans &GetThreadSpans()
+{
+   thread_local std::shared_ptr<RThreadSpans> threadSpans;
+   if (!threadSpans) {
+      threadSpans = std::make_shared<RThreadSpans>();
+      auto &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      threadSpans->fThreadId = registry.fThreads.size() + 1;
+      registry.fThreads.emplace_back(threadSpans);
+   }
+   return *threadSpans;
+}
+
+void WriteJsonString(FILE *out, const char *str)
+{
+   fputc('"', out);
+   for (; *str; ++str) {
+      if (*str == '"' || *str == '\\')
+         fputc('\\', out);
+      fputc(*str, out);
+   }
+   fputc('"', out);
+}
+
+#ifdef R__HAS_TRACING
+void WriteTraceAtExit()
+{
+   ROOT::Experimental::RTrace::Write(std::getenv("ROOT_TRACE"));
+}
+
+/// ROOT_TRACE=<file> records the whole process
+struct RTraceFromEnv {
+   RTraceFromEnv()
+   {
+      if (std::getenv("ROOT_TRACE")) {
+         ROOT::Experimental::RTrace::Start();
+         atexit(WriteTraceAtExit);
+      }
+   }
+} gTraceFromEnv;
+#endif
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Nanoseconds on a monotonic clock
+
+std::uint64_t ROOT::Experimental::Internal::RTraceSpan::Now()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append a span to the spans of the calling thread
+
+void ROOT::Experimental::Internal::RTraceSpan::Record(const char *category, const char *name, std::uint64_t start,
+                                                      std::uint64_t end)
+{
+   auto &threadSpans = GetThreadSpans();
+   std::lock_guard<std::mutex> lock(threadSpans.fMutex);
+   if (threadSpans.fSpans.size() >= RTrace::kMaxSpansPerThread) {
+      ++threadSpans.fNDropped;
+      return;
+   }
+   threadSpans.fSpans.push_back({category, name, start, end});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start recording spans, in addition to the ones recorded so far
+
+void ROOT::Experimental::RTrace::Start()
+{
+#ifndef R__HAS_TRACING
+   ::Warning("RTrace::Start", "ROOT was built without tracing support, please configure it with -Dtracing=ON");
+#endif
+   Internal::gTraceActive = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop recording spans, the spans in progress are still recorded
+
+void ROOT::Experimental::RTrace::Stop()
+{
+   Internal::gTraceActive = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the recorded spans
+
+void ROOT::Experimental::RTrace::Clear()
+{
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   for (auto &threadSpans : registry.fThreads) {
+      std::lock_guard<std::mutex> threadLock(threadSpans->fMutex);
+      threadSpans->fSpans.clear();
+      threadSpans->fNDropped = 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the recorded spans as a Chrome trace (JSON object format) to `filename`. Returns false if the file
+/// cannot be written.
+
+bool ROOT::Experimental::RTrace::Write(const char *filename)
+{
+   FILE *out = fopen(filename, "w");
+   if (!out) {
+      ::Error("RTrace::Write", "cannot open %s", filename);
+      return false;
+   }
+
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+
+   // Timestamps are relative to the first span
+   std::uint64_t origin = UINT64_MAX;
+   for (auto &threadSpans : registry.fThreads) {
+      std::lock_guard<std::mutex> threadLock(threadSpans->fMutex);
+      for (const auto &span : threadSpans->fSpans)
+         origin = std::min(origin, span.fStart);
+   }
+
+   const int pid = gSystem ? gSystem->GetPid() : 0;
+   std::uint64_t nDropped = 0;
+   bool first = true;
+   auto separator = [&] {
+      fputs(first ? "\n" : ",\n", out);
+      first = false;
+   };
+   fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", out);
+   for (auto &threadSpans : registry.fThreads) {
+      std::lock_guard<std::mutex> threadLock(threadSpans->fMutex);
+      if (threadSpans->fSpans.empty())
+         continue;
+      nDropped += threadSpans->fNDropped;
+      separator();
+      fprintf(out, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}", pid,
+              threadSpans->fThreadId, threadSpans->fThreadId);
+      for (const auto &span : threadSpans->fSpans) {
+         separator();
+         fputs("{\"ph\":\"X\",\"cat\":", out);
+         WriteJsonString(out, span.fCategory);
+         fputs(",\"name\":", out);
+         WriteJsonString(out, span.fName);
+         fprintf(out, ",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}", (span.fStart - origin) * 1e-3,
+                 (span.fEnd - span.fStart) * 1e-3, pid, threadSpans->fThreadId);
+      }
+   }
+   fputs("\n]}\n", out);
+   fclose(out);
+
+   if (nDropped)
+      ::Warning("RTrace::Write", "%llu spans were dropped, more than %zu spans per thread", (unsigned long long)nDropped,
+                kMaxSpansPerThread);
+   return true;
+}
@@ -19,6 +19,8 @@ Buffer base class used for serializing objects.
 #include "TClass.h"
 #include "TProcessID.h"
 
+#include <cstring>
+
 constexpr Int_t kExtraSpace    = 8;   // extra space at end of buffer (used for free block count)
 constexpr Int_t kMaxBufferSize  = 0x7FFFFFFE;  // largest possible size.
 
@@ -385,43 +387,70 @@ TVirtualArray *TBuffer::PopDataCache()
    return val;
 }
 
+namespace {
+
+#ifdef R__BYTESWAP
+// The swaps are written as plain shifts and masks on unsigned integers, loaded and stored with memcpy (the buffer is
+// not necessarily aligned): compilers recognize the pattern and, where the target provides byte shuffles (SSSE3,
+// AVX2, NEON), vectorize the loops below instead of swapping one value at a time.
+inline UShort_t SwapBytes(UShort_t x)
+{
+   return static_cast<UShort_t>((x >> 8) | (x << 8));
+}
+
+inline UInt_t SwapBytes(UInt_t x)
+{
+   return ((x & 0xff000000u) >> 24) | ((x & 0x00ff0000u) >> 8) | ((x & 0x0000ff00u) << 8) | ((x & 0x000000ffu) << 24);
+}
+
+inline ULong64_t SwapBytes(ULong64_t x)
+{
+   return (static_cast<ULong64_t>(SwapBytes(static_cast<UInt_t>(x))) << 32) | SwapBytes(static_cast<UInt_t>(x >> 32));
+}
+
+template <typename T>
+void SwapBytesInPlace(char *buf, Long64_t n)
+{
+   for (Long64_t idx = 0; idx < n; ++idx) {
+      T value;
+      memcpy(&value, buf + idx * sizeof(T), sizeof(T));
+      value = SwapBytes(value);
+      memcpy(buf + idx * sizeof(T), &value, sizeof(T));
+   }
+}
+#endif
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Byte-swap N primitive-elements in the buffer.
 /// Bulk API relies on this function.
+///
+/// Single-byte types need no swapping: the function returns true without touching the buffer.
+/// Returns false for types that cannot be swapped in place.
 
 Bool_t TBuffer::ByteSwapBuffer(Long64_t n, EDataType type)
 {
    char *input_buf = GetCurrent();
-   if ((type == EDataType::kShort_t) || (type == EDataType::kUShort_t)) {
+   if ((type == EDataType::kChar_t) || (type == EDataType::kUChar_t) || (type == EDataType::kBool_t)) {
+      // nothing to do
+   } else if ((type == EDataType::kShort_t) || (type == EDataType::kUShort_t)) {
 #ifdef R__BYTESWAP
-      Short_t *buf __attribute__((aligned(8))) = reinterpret_cast<Short_t*>(input_buf);
-      for (int idx=0; idx<n; idx++) {
-         Short_t tmp = *reinterpret_cast<Short_t*>(buf + idx); // Makes a copy of the values; frombuf can't handle aliasing.
-         char *tmp_ptr = reinterpret_cast<char *>(&tmp);
-         frombuf(tmp_ptr, buf + idx);
-      }
+      SwapBytesInPlace<UShort_t>(input_buf, n);
 #endif
    } else if ((type == EDataType::kFloat_t) || (type == EDataType::kInt_t) || (type == EDataType::kUInt_t)) {
 #ifdef R__BYTESWAP
-      Float_t *buf __attribute__((aligned(8))) = reinterpret_cast<Float_t*>(input_buf);
-      for (int idx=0; idx<n; idx++) {
-         Float_t tmp = *reinterpret_cast<Float_t*>(buf + idx); // Makes a copy of the values; frombuf can't handle aliasing.
-         char *tmp_ptr = reinterpret_cast<char *>(&tmp);
-         frombuf(tmp_ptr, buf + idx);
-      }
+      SwapBytesInPlace<UInt_t>(input_buf, n);
 #endif
    } else if ((type == EDataType::kDouble_t) || (type == EDataType::kLong64_t) || (type == EDataType::kULong64_t)) {
 #ifdef R__BYTESWAP
-      Double_t *buf __attribute__((aligned(8))) = reinterpret_cast<Double_t*>(input_buf);
-      for (int idx=0; idx<n; idx++) {
-         Double_t tmp = *reinterpret_cast<Double_t*>(buf + idx); // Makes a copy of the values; frombuf can't handle aliasing.
-         char *tmp_ptr = reinterpret_cast<char*>(&tmp);
-         frombuf(tmp_ptr, buf + idx);
-      }
+      SwapBytesInPlace<ULong64_t>(input_buf, n);
 #endif
    } else {
       return false;
    }
 
+   // avoid unused variable warnings on big-endian platforms
+   (void)input_buf;
    return true;
 }
@@ -97,7 +97,13 @@ TFile, TSQLServer, TGrid, etc. functionality.
 #include "TObjArray.h"
 #include "ThreadLocalStorage.h"
 
+#include <cctype>
+#include <cstring>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 TPluginManager *gPluginMgr;   // main plugin manager created in TROOT
 
@@ -108,6 +114,117 @@ static bool &TPH__IsReadingDirs() {
    return readingDirs;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Minimal scanner for the plugin macros which only register handlers.
+
+class TPluginMacroScanner {
+   const char *fCur;
+
+public:
+   TPluginMacroScanner(const char *text) : fCur(text) {}
+
+   /// Skip white spaces and comments.
+   void SkipBlanks()
+   {
+      while (*fCur) {
+         if (isspace((unsigned char)*fCur)) {
+            fCur++;
+         } else if (fCur[0] == '/' && fCur[1] == '/') {
+            while (*fCur && *fCur != '\n') fCur++;
+         } else if (fCur[0] == '/' && fCur[1] == '*') {
+            const char *end = strstr(fCur + 2, "*/");
+            fCur = end ? end + 2 : fCur + strlen(fCur);
+         } else {
+            break;
+         }
+      }
+   }
+
+   bool AtEnd() { SkipBlanks(); return !*fCur; }
+
+   /// Consume the given punctuation or keyword.
+   bool Expect(const char *token)
+   {
+      SkipBlanks();
+      size_t len = strlen(token);
+      if (strncmp(fCur, token, len)) return false;
+      if (isalnum((unsigned char)token[len-1]) && (isalnum((unsigned char)fCur[len]) || fCur[len] == '_'))
+         return false;
+      fCur += len;
+      return true;
+   }
+
+   /// Consume an identifier.
+   bool Identifier()
+   {
+      SkipBlanks();
+      if (!isalpha((unsigned char)*fCur) && *fCur != '_') return false;
+      while (isalnum((unsigned char)*fCur) || *fCur == '_') fCur++;
+      return true;
+   }
+
+   /// Consume a string literal, possibly made of several adjacent ones.
+   /// Escape sequences are not supported.
+   bool String(std::string &str)
+   {
+      str.clear();
+      SkipBlanks();
+      if (*fCur != '"') return false;
+      while (*fCur == '"') {
+         const char *end = fCur + 1;
+         while (*end && *end != '"' && *end != '\\' && *end != '\n') end++;
+         if (*end != '"') return false;
+         str.append(fCur + 1, end);
+         fCur = end + 1;
+         SkipBlanks();
+      }
+      return true;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Extract the handlers of a plugin macro made only of
+/// ~~~ {.cpp}
+///   void P10_Name()
+///   {
+///      gPluginMgr->AddHandler("base", "regexp", "class", "plugin", "ctor");
+///      ...
+///   }
+/// ~~~
+/// Return false for any other content (conditions, declarations, ...), which
+/// has to be executed by the interpreter.
+
+bool ParsePluginMacro(const char *path, std::vector<std::vector<std::string>> &handlers)
+{
+   std::ifstream file(path);
+   if (!file) return false;
+   std::stringstream content;
+   content << file.rdbuf();
+   const std::string text = content.str();
+
+   TPluginMacroScanner sc(text.c_str());
+   if (!sc.Expect("void") || !sc.Identifier() || !sc.Expect("(") || !sc.Expect(")") || !sc.Expect("{"))
+      return false;
+   while (!sc.Expect("}")) {
+      if (!sc.Expect("gPluginMgr") || !sc.Expect("->") || !sc.Expect("AddHandler") || !sc.Expect("("))
+         return false;
+      std::vector<std::string> args;
+      do {
+         std::string arg;
+         if (!sc.String(arg)) return false;
+         args.emplace_back(arg);
+      } while (sc.Expect(","));
+      if (!sc.Expect(")") || !sc.Expect(";") || args.size() < 4 || args.size() > 5)
+         return false;
+      handlers.emplace_back(args);
+   }
+   return sc.AtEnd();
+}
+
+} // namespace
+
 ClassImp(TPluginHandler);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,6 +529,18 @@ void TPluginManager::LoadHandlerMacros(const char *path)
       while ((s = (TObjString*)next())) {
          if (gDebug > 1)
             Info("LoadHandlerMacros", "   plugin macro: %s", s->String().Data());
+         // Register directly the handlers of the simple macros, without
+         // starting the interpreter
+         std::vector<std::vector<std::string>> handlers;
+         if (ParsePluginMacro(s->String(), handlers)) {
+            Bool_t readingDirs = TPH__IsReadingDirs();
+            TPH__IsReadingDirs() = kFALSE;
+            for (auto &h : handlers)
+               AddHandler(h[0].c_str(), h[1].c_str(), h[2].c_str(), h[3].c_str(),
+                          h.size() > 4 ? h[4].c_str() : nullptr, s->String());
+            TPH__IsReadingDirs() = readingDirs;
+            continue;
+         }
          Longptr_t res;
          if ((res = gROOT->Macro(s->String(), nullptr, kFALSE)) < 0) {
             Error("LoadHandlerMacros", "pluging macro %s returned %ld",
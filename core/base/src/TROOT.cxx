@@ -75,6 +75,7 @@ of a main program creating an interactive version is shown below:
 #include <string>
 #include <map>
 #include <cstdlib>
+#include <mutex>
 #ifdef WIN32
 #include <io.h>
 #include "Windows4Root.h"
@@ -369,6 +370,29 @@ namespace Internal {
 
    extern TROOT *gROOTLocal;
 
+   // With Root.LazyInterpreter, the interpreter is created by its first user (see TInterpreter::Instance()) rather
+   // than by GetROOT2(). Until then the dictionaries of the loaded libraries are buffered, as before the start of main.
+   static std::atomic<bool> gIsInterpreterDeferred{false};
+
+   Bool_t IsInterpreterDeferred() {
+      return gIsInterpreterDeferred;
+   }
+
+   TInterpreter *InitDeferredInterpreter() {
+      if (gIsInterpreterDeferred) {
+         static std::recursive_mutex creationMutex;
+         static bool isCreating = false;
+         std::lock_guard<std::recursive_mutex> lock(creationMutex);
+         // The calls made while the interpreter is being created get the partially initialized gCling
+         if (gIsInterpreterDeferred && !isCreating) {
+            isCreating = true;
+            gROOTLocal->InitInterpreter();
+            gIsInterpreterDeferred = false;
+         }
+      }
+      return gCling;
+   }
+
    TROOT *GetROOT1() {
       if (gROOTLocal)
          return gROOTLocal;
@@ -380,7 +404,17 @@ namespace Internal {
       static Bool_t initInterpreter = kFALSE;
       if (!initInterpreter) {
          initInterpreter = kTRUE;
-         gROOTLocal->InitInterpreter();
+         // The programs that only read and write objects of classes with dictionaries can do without the
+         // interpreter: with Root.LazyInterpreter, it is only created if needed (never for rootcling, which uses it).
+         if ((gEnv->GetValue("Root.LazyInterpreter", 0) || gSystem->Getenv("ROOT_LAZY_INTERPRETER")) &&
+             !dlsym(RTLD_DEFAULT, "usedToIdentifyRootClingByDlSym")) {
+            // What InitInterpreter() does besides creating the interpreter
+            gIsInterpreterDeferred = true;
+            atexit(at_exit_of_TROOT);
+            TROOT::fgRootInit = kTRUE;
+         } else {
+            gROOTLocal->InitInterpreter();
+         }
          // Load and init threads library
          gROOTLocal->InitThreads();
       }
@@ -1633,7 +1667,7 @@ TFunction *TROOT::GetGlobalFunction(const char *function, const char *params,
       R__LOCKGUARD(gROOTMutex);
       return (TFunction *)GetListOfGlobalFunctions(load)->FindObject(function);
    } else {
-      if (!fInterpreter)
+      if (!fInterpreter && !ROOT::Internal::InitDeferredInterpreter())
          Fatal("GetGlobalFunction", "fInterpreter not initialized");
 
       R__LOCKGUARD(gROOTMutex);
@@ -1666,7 +1700,7 @@ TFunction *TROOT::GetGlobalFunctionWithPrototype(const char *function,
       R__LOCKGUARD(gROOTMutex);
       return (TFunction *)GetListOfGlobalFunctions(load)->FindObject(function);
    } else {
-      if (!fInterpreter)
+      if (!fInterpreter && !ROOT::Internal::InitDeferredInterpreter())
          Fatal("GetGlobalFunctionWithPrototype", "fInterpreter not initialized");
 
       R__LOCKGUARD(gROOTMutex);
@@ -1751,7 +1785,7 @@ TCollection *TROOT::GetListOfGlobals(Bool_t load)
       TGlobalMappedFunction::GetEarlyRegisteredGlobals().Clear();
    }
 
-   if (!fInterpreter)
+   if (!fInterpreter && !ROOT::Internal::InitDeferredInterpreter())
       Fatal("GetListOfGlobals", "fInterpreter not initialized");
 
    if (load) fGlobals->Load();
@@ -1775,7 +1809,7 @@ TCollection *TROOT::GetListOfGlobalFunctions(Bool_t load)
       fGlobalFunctions = new TListOfFunctions(nullptr);
    }
 
-   if (!fInterpreter)
+   if (!fInterpreter && !ROOT::Internal::InitDeferredInterpreter())
       Fatal("GetListOfGlobalFunctions", "fInterpreter not initialized");
 
    // A thread that calls with load==true and a thread that calls with load==false
@@ -1808,7 +1842,8 @@ TCollection *TROOT::GetListOfGlobalFunctions(Bool_t load)
 
 TCollection *TROOT::GetListOfTypes(Bool_t /* load */)
 {
-   if (!fInterpreter)
+   // The types missing from the list are looked up in the interpreter, which is then created if deferred
+   if (!fInterpreter && !ROOT::Internal::IsInterpreterDeferred())
       Fatal("GetListOfTypes", "fInterpreter not initialized");
 
    return fTypes;
@@ -2039,8 +2074,9 @@ void TROOT::InitInterpreter()
       fprintf(stderr, "Fatal in <TROOT::InitInterpreter>: cannot load symbol %s\n", err.Data());
       exit(1);
    }
-   // Schedule the destruction of TROOT.
-   atexit(at_exit_of_TROOT);
+   // Schedule the destruction of TROOT, already done if the creation of the interpreter was deferred.
+   if (!ROOT::Internal::IsInterpreterDeferred())
+      atexit(at_exit_of_TROOT);
 
    gDestroyInterpreter = (DestroyInterpreter_t*) dlsym(gInterpreterLib, "DestroyInterpreter");
    if (!gDestroyInterpreter) {
@@ -2218,7 +2254,7 @@ Int_t TROOT::LoadMacro(const char *filename, int *error, Bool_t check)
    else
       terr = &lerr;
 
-   if (fInterpreter) {
+   if (fInterpreter || ROOT::Internal::InitDeferredInterpreter()) {
       TString aclicMode;
       TString arguments;
       TString io;
@@ -2261,7 +2297,7 @@ Longptr_t TROOT::Macro(const char *filename, Int_t *error, Bool_t padUpdate)
 {
    Longptr_t result = 0;
 
-   if (fInterpreter) {
+   if (fInterpreter || ROOT::Internal::InitDeferredInterpreter()) {
       TString aclicMode;
       TString arguments;
       TString io;
@@ -2358,7 +2394,7 @@ Longptr_t TROOT::ProcessLineFast(const char *line, Int_t *error)
 
    Longptr_t result = 0;
 
-   if (fInterpreter) {
+   if (fInterpreter || ROOT::Internal::InitDeferredInterpreter()) {
       TInterpreter::EErrorCode *code = (TInterpreter::EErrorCode*)error;
       result = gInterpreter->Calc(sline, code);
    }
@@ -2551,7 +2587,7 @@ void TROOT::RegisterModule(const char* modulename,
    atexit(CallCloseFiles);
 
    // Now register with TCling.
-   if (TROOT::Initialized()) {
+   if (TROOT::Initialized() && ROOT::Internal::gROOTLocal->fInterpreter) {
       gCling->RegisterModule(modulename, headers, includePaths, payloadCode, fwdDeclCode, triggerFunc,
                              fwdDeclsArgToSkip, classesHeaders, false, hasCxxModule);
    } else {
@@ -0,0 +1,53 @@
+#include "ROOT/RTrace.hxx"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using ROOT::Experimental::RTrace;
+using ROOT::Experimental::Internal::RTraceSpan;
+
+static std::string ReadFile(const char *path)
+{
+   std::ifstream in(path);
+   std::stringstream content;
+   content << in.rdbuf();
+   return content.str();
+}
+
+TEST(RTrace, RecordsOnlyWhileActive)
+{
+   RTrace::Clear();
+   {
+      RTraceSpan span("test", "inactive span");
+   }
+   RTrace::Start();
+   EXPECT_TRUE(RTrace::IsActive());
+   {
+      RTraceSpan span("test", "main span");
+   }
+   std::thread([] { RTraceSpan span("test", "thread \"span\""); }).join();
+   RTrace::Stop();
+   EXPECT_FALSE(RTrace::IsActive());
+
+   const char *path = "RTraceTests_trace.json";
+   ASSERT_TRUE(RTrace::Write(path));
+   auto trace = ReadFile(path);
+   gSystem->Unlink(path);
+
+   EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+   EXPECT_NE(std::string::npos, trace.find("\"name\":\"main span\""));
+   EXPECT_NE(std::string::npos, trace.find("\"name\":\"thread \\\"span\\\"\""));
+   EXPECT_EQ(std::string::npos, trace.find("inactive span"));
+   EXPECT_NE(std::string::npos, trace.find("\"ph\":\"M\",\"name\":\"thread_name\""));
+
+   RTrace::Clear();
+   ASSERT_TRUE(RTrace::Write(path));
+   trace = ReadFile(path);
+   gSystem->Unlink(path);
+   EXPECT_EQ(std::string::npos, trace.find("main span"));
+}
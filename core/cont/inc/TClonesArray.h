@@ -24,6 +24,9 @@
 
 #include "TObjArray.h"
 
+#include <utility>
+#include <vector>
+
 class TClass;
 
 class TClonesArray : public TObjArray {
@@ -31,6 +34,14 @@ class TClonesArray : public TObjArray {
 protected:
    TClass       *fClass;       //!Pointer to the class of the elements
    TObjArray    *fKeep;        //!Saved copies of pointers to objects
+   Bool_t        fUseArena = kFALSE; //!Allocate the objects in contiguous blocks
+   std::vector<std::pair<char *, Long_t>> fArenaBlocks; //!Blocks of the arena and their size in bytes
+   std::vector<TObject *> fArenaFree; //!Memory of the arena not attached to a slot
+
+private:
+   TObject         *AllocSlot();
+   Bool_t           IsInArena(const TObject *obj) const;
+   void             ReleaseSlot(Int_t idx);
 
 public:
    enum EStatusBits {
@@ -66,6 +77,8 @@ public:
    TObject         *ConstructedAt(Int_t idx, Option_t *clear_options);
    void             SetClass(const char *classname,Int_t size=1000);
    void             SetClass(const TClass *cl,Int_t size=1000);
+   void             SetArena(Bool_t enable = kTRUE);
+   Bool_t           UsesArena() const { return fUseArena; }
 
    void             AbsorbObjects(TClonesArray *tc);
    void             AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2);
@@ -22,6 +22,10 @@
 // Hash() function. Each class inheriting from TObject can override     //
 // Hash() as it sees fit.                                               //
 //                                                                      //
+// Tables with more than a few entries also keep an open addressing     //
+// index of the objects with their hash values, used by the lookups by  //
+// name.                                                                //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include "TCollection.h"
@@ -37,10 +41,15 @@ class THashTable : public TCollection {
 friend class  THashTableIter;
 
 private:
+   struct TIndexEntry;
+
    TList     **fCont;          //Hash table (table of lists)
    Int_t       fEntries;       //Number of objects in table
    Int_t       fUsedSlots;     //Number of used slots
    Int_t       fRehashLevel;   //Average collision rate which triggers rehash
+   TIndexEntry *fIndex;        //!Open addressing index of the objects, for the lookups by name
+   Int_t       fIndexSize;     //!Number of entries of fIndex, a power of 2
+   Int_t       fIndexUsed;     //!Number of entries of fIndex used or removed
 
    Int_t       GetCheckedHashValue(TObject *obj) const;
    Int_t       GetHashValue(const TObject *obj) const;
@@ -48,6 +57,11 @@ private:
    Int_t       GetHashValue(const char *str) const { return ::Hash(str) % fSize; }
 
    void        AddImpl(Int_t slot, TObject *object);
+   void        IndexAdd(TObject *obj, ULong_t hash);
+   void        IndexBuild();
+   void        IndexClear();
+   void        IndexInsert(TObject *obj, ULong_t hash);
+   void        IndexRemove(TObject *obj, ULong_t hash);
 
    THashTable(const THashTable&) = delete;
    THashTable& operator=(const THashTable&) = delete;
@@ -121,6 +121,24 @@ When investigating misuse of TClonesArray, please make sure of the following:
      TClonesArrays are not destroyed and created on every event. They
      must only be constructed/destructed at the beginning/end of the
      run.
+
+### Arena
+
+With SetArena(), the objects are allocated in contiguous blocks of
+memory (an arena) instead of one by one on the heap. The arena grows
+by blocks of at least as many objects as already allocated, and its
+memory is only released when the TClonesArray is deleted: the slots
+released by Expand(), ExpandCreate() or operator= are kept for the
+next objects. This keeps the objects of an event next to each other in
+memory, like for the arrays read by TBranchClones, which is faster to
+loop over for the large number of small objects of legacy event data
+models.
+~~~ {.cpp}
+  TClonesArray a("TTrack", 10000);
+  a.SetArena();
+~~~
+The objects of an arena cannot be absorbed by another TClonesArray
+(see AbsorbObjects()).
 */
 
 #include "TClonesArray.h"
@@ -133,6 +151,7 @@ When investigating misuse of TClonesArray, please make sure of the following:
 #include "TObjectTable.h"
 #include "snprintf.h"
 
+#include <cstddef>
 #include <cstdlib>
 
 ClassImp(TClonesArray);
@@ -247,8 +266,7 @@ TClonesArray& TClonesArray::operator=(const TClonesArray& tc)
 
    for (i = 0; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
-         fKeep->fCont[i] = nullptr;
+         ReleaseSlot(i);
          fCont[i] = nullptr;
       }
 
@@ -270,12 +288,12 @@ TClonesArray& TClonesArray::operator=(const TClonesArray& tc)
 TClonesArray::~TClonesArray()
 {
    if (fKeep) {
-      for (Int_t i = 0; i < fKeep->fSize; i++) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
-         fKeep->fCont[i] = nullptr;
-      }
+      for (Int_t i = 0; i < fKeep->fSize; i++)
+         ReleaseSlot(i);
    }
    SafeDelete(fKeep);
+   for (auto &block : fArenaBlocks)
+      ::operator delete(block.first);
 
    // Protect against erroneously setting of owner bit
    SetOwner(kFALSE);
@@ -481,10 +499,7 @@ void TClonesArray::Expand(Int_t newSize)
       // release allocated space in fKeep and set to 0 so
       // Expand() will shrink correctly
       for (int i = newSize; i < fSize; i++)
-         if (fKeep->fCont[i]) {
-            R__ReleaseMemory(fClass,fKeep->fCont[i]);
-            fKeep->fCont[i] = nullptr;
-         }
+         ReleaseSlot(i);
    }
 
    TObjArray::Expand(newSize);
@@ -515,7 +530,7 @@ void TClonesArray::ExpandCreate(Int_t n)
    Int_t i;
    for (i = 0; i < n; i++) {
       if (!fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = (TObject*)(fUseArena ? fClass->New(AllocSlot()) : fClass->New());
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -525,8 +540,7 @@ void TClonesArray::ExpandCreate(Int_t n)
 
    for (i = n; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
-         fKeep->fCont[i] = nullptr;
+         ReleaseSlot(i);
          fCont[i] = nullptr;
       }
 
@@ -552,7 +566,7 @@ void TClonesArray::ExpandCreateFast(Int_t n)
    Int_t i;
    for (i = 0; i < n; i++) {
       if (i >= oldSize || !fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = (TObject*)(fUseArena ? fClass->New(AllocSlot()) : fClass->New());
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -692,6 +706,100 @@ void TClonesArray::SetClass(const char *classname, Int_t s)
    SetClass(TClass::GetClass(classname),s);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the objects in contiguous blocks of memory (arena) instead of one
+/// by one on the heap, see the class documentation.
+/// The mode can only be changed before objects are allocated in the array.
+
+void TClonesArray::SetArena(Bool_t enable)
+{
+   if (enable == fUseArena) return;
+   if (fKeep) {
+      for (Int_t i = 0; i < fKeep->fSize; i++) {
+         if (fKeep->fCont[i]) {
+            Error("SetArena", "cannot change the allocation mode of a TClonesArray holding objects");
+            return;
+         }
+      }
+   }
+   for (auto &block : fArenaBlocks)
+      ::operator delete(block.first);
+   fArenaBlocks.clear();
+   fArenaFree.clear();
+   fUseArena = enable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory for a new object of the class, from the arena if it is
+/// used and from the heap otherwise. The object is not constructed.
+
+TObject *TClonesArray::AllocSlot()
+{
+   TObject *obj = nullptr;
+   if (!fUseArena) {
+      obj = (TObject*) TStorage::ObjectAlloc(fClass->Size());
+   } else {
+      if (fArenaFree.empty()) {
+         // Grow the arena geometrically, with zeroed memory so that the
+         // objects are not flagged as allocated on the heap
+         const Long_t align = alignof(std::max_align_t);
+         const Long_t size = (fClass->Size() + align - 1) / align * align;
+         Long_t n = 0;
+         for (auto &block : fArenaBlocks)
+            n += block.second / size;
+         n = TMath::Max(n, 16L);
+         char *block = (char *)::operator new(n * size);
+         memset(block, 0, n * size);
+         fArenaBlocks.emplace_back(block, n * size);
+         fArenaFree.reserve(n);
+         for (Long_t i = n - 1; i >= 0; i--)
+            fArenaFree.push_back((TObject *)(block + i * size));
+      }
+      obj = fArenaFree.back();
+      fArenaFree.pop_back();
+   }
+   // Reset the bit so that:
+   //    obj = myClonesArray[i];
+   //    obj->TestBit(TObject::kNotDeleted)
+   // will behave correctly.
+   // TObject::kNotDeleted is one of the higher bit that is not settable via the public
+   // interface. But luckily we are its friend.
+   obj->fBits &= ~kNotDeleted;
+   return obj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the memory of obj belongs to the arena of this array.
+
+Bool_t TClonesArray::IsInArena(const TObject *obj) const
+{
+   const char *addr = (const char *)obj;
+   for (auto &block : fArenaBlocks) {
+      if (addr >= block.first && addr < block.first + block.second)
+         return kTRUE;
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destruct if needed the object kept at slot idx and detach its memory from
+/// the slot. The memory of the arena is kept for the next objects, the heap
+/// memory is freed.
+
+void TClonesArray::ReleaseSlot(Int_t idx)
+{
+   TObject *obj = fKeep->fCont[idx];
+   if (!obj) return;
+   if (IsInArena(obj)) {
+      if (obj->TestBit(kNotDeleted))
+         fClass->Destructor(obj, kTRUE);
+      fArenaFree.push_back(obj);
+   } else {
+      R__ReleaseMemory(fClass, obj);
+   }
+   fKeep->fCont[idx] = nullptr;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// A TClonesArray is always the owner of the object it contains.
@@ -800,7 +908,7 @@ void TClonesArray::Streamer(TBuffer &b)
       if (CanBypassStreamer() && !b.TestBit(TBuffer::kCannotHandleMemberWiseStreaming)) {
          for (Int_t i = 0; i < nobjects; i++) {
             if (!fKeep->fCont[i]) {
-               fKeep->fCont[i] = (TObject*)fClass->New();
+               fKeep->fCont[i] = (TObject*)(fUseArena ? fClass->New(AllocSlot()) : fClass->New());
             } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                // The object has been deleted (or never initialized)
                fClass->New(fKeep->fCont[i]);
@@ -835,7 +943,7 @@ void TClonesArray::Streamer(TBuffer &b)
             b >> nch;
             if (nch) {
                if (!fKeep->fCont[i])
-                  fKeep->fCont[i] = (TObject*)fClass->New();
+                  fKeep->fCont[i] = (TObject*)(fUseArena ? fClass->New(AllocSlot()) : fClass->New());
                else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                   // The object has been deleted (or never initialized)
                   fClass->New(fKeep->fCont[i]);
@@ -918,16 +1026,8 @@ TObject *&TClonesArray::operator[](Int_t idx)
    if (idx >= fSize)
       Expand(TMath::Max(idx+1, GrowBy(fSize)));
 
-   if (!fKeep->fCont[idx]) {
-      fKeep->fCont[idx] = (TObject*) TStorage::ObjectAlloc(fClass->Size());
-      // Reset the bit so that:
-      //    obj = myClonesArray[i];
-      //    obj->TestBit(TObject::kNotDeleted)
-      // will behave correctly.
-      // TObject::kNotDeleted is one of the higher bit that is not settable via the public
-      // interface. But luckily we are its friend.
-      fKeep->fCont[idx]->fBits &= ~kNotDeleted;
-   }
+   if (!fKeep->fCont[idx])
+      fKeep->fCont[idx] = AllocSlot();
    fCont[idx] = fKeep->fCont[idx];
 
    fLast = TMath::Max(idx, GetAbsLast());
@@ -1008,6 +1108,13 @@ void TClonesArray::AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2)
       return;
    }
 
+   for (Int_t i = idx1; i <= idx2; i++) {
+      if (tc->IsInArena(tc->fKeep->fCont[i])) {
+         Error("AbsorbObjects", "cannot absorb objects allocated in the arena of another TClonesArray");
+         return;
+      }
+   }
+
    // cache the sorted status
    Bool_t wasSorted = IsSorted() && tc->IsSorted() &&
                       (Last() == 0 || Last()->Compare(tc->First()) == -1);
@@ -1022,7 +1129,7 @@ void TClonesArray::AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2)
    for (Int_t i = idx1; i <= idx2; i++) {
       Int_t newindex = oldSize+i -idx1;
       fCont[newindex] = tc->fCont[i];
-      R__ReleaseMemory(fClass,fKeep->fCont[newindex]);
+      ReleaseSlot(newindex);
       (*fKeep)[newindex] = (*(tc->fKeep))[i];
       tc->fCont[i] = 0;
       (*(tc->fKeep))[i] = 0;
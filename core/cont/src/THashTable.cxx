@@ -19,6 +19,14 @@ Hash() as it sees fit.
 THashTable does not preserve the insertion order of the objects.
 If the insertion order is important AND fast retrieval is needed
 use THashList instead.
+
+Once a table holds more than a few objects, it also keeps an open
+addressing index of the objects and of their hash values. The lookups
+by name, FindObject(const char*), probe this contiguous index and
+compare the hash values before the names, instead of going through
+the linked list of the slot. This requires the Hash() of the objects
+looked up by name to be the hash of their name, as for TNamed and
+TObjString.
 */
 
 #include "THashTable.h"
@@ -29,6 +37,22 @@ use THashList instead.
 
 ClassImp(THashTable);
 
+/// Entry of the open addressing index of a THashTable.
+struct THashTable::TIndexEntry {
+   ULong_t  fHash;       ///< Value of Hash() of the object when it was added
+   TObject *fObject;     ///< nullptr for empty entries, or the removed entry marker
+   Bool_t   fDuplicate;  ///< Another object of the index has the same name
+};
+
+namespace {
+   // Smallest number of objects for which the index is kept
+   const Int_t kIndexMinEntries = 8;
+
+   // Marker of the removed entries of the index
+   char gRemovedEntry;
+   TObject *const kRemovedEntry = reinterpret_cast<TObject *>(&gRemovedEntry);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a THashTable object. Capacity is the initial hashtable capacity
 /// (i.e. number of slots), by default kInitHashTableCapacity = 17, and
@@ -56,6 +80,9 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
    fUsedSlots = 0;
    if (rehashlevel < 2) rehashlevel = 0;
    fRehashLevel = rehashlevel;
+   fIndex     = nullptr;
+   fIndexSize = 0;
+   fIndexUsed = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +95,7 @@ THashTable::~THashTable()
    delete [] fCont;
    fCont = 0;
    fSize = 0;
+   IndexClear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,11 +121,13 @@ void THashTable::Add(TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   ULong_t hash = obj->CheckedHash();
+   Int_t slot = Int_t(hash % fSize);
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    AddImpl(slot,obj);
+   IndexAdd(obj,hash);
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
       Rehash(fEntries);
@@ -113,7 +143,8 @@ void THashTable::AddBefore(const TObject *before, TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   ULong_t hash = obj->CheckedHash();
+   Int_t slot = Int_t(hash % fSize);
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    if (!fCont[slot]) {
@@ -126,6 +157,7 @@ void THashTable::AddBefore(const TObject *before, TObject *obj)
       fCont[slot]->Add(obj);
    }
    fEntries++;
+   IndexAdd(obj,hash);
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
       Rehash(fEntries);
@@ -181,6 +213,7 @@ void THashTable::Clear(Option_t *option)
 
    fEntries   = 0;
    fUsedSlots = 0;
+   IndexClear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -229,6 +262,7 @@ void THashTable::Delete(Option_t *)
 
    fEntries   = 0;
    fUsedSlots = 0;
+   IndexClear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -237,10 +271,28 @@ void THashTable::Delete(Option_t *)
 
 TObject *THashTable::FindObject(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
+   const ULong_t hash = ::Hash(name);
+   Int_t slot = Int_t(hash % fSize);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
+   if (fIndex && name) {
+      const Int_t mask = fIndexSize - 1;
+      for (Int_t i = Int_t(hash & mask); fIndex[i].fObject; i = (i + 1) & mask) {
+         const TIndexEntry &entry = fIndex[i];
+         if (entry.fHash != hash || entry.fObject == kRemovedEntry)
+            continue;
+         const char *objname = entry.fObject->GetName();
+         if (objname && strcmp(name, objname) == 0) {
+            if (!entry.fDuplicate)
+               return entry.fObject;
+            // The list of the slot tells which of the objects with this name comes first
+            return fCont[slot] ? fCont[slot]->FindObject(name) : 0;
+         }
+      }
+      return 0;
+   }
+
    if (fCont[slot]) return fCont[slot]->FindObject(name);
    return 0;
 }
@@ -402,6 +454,7 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
    fSize      = ht->fSize;     // idem
    fEntries   = ht->fEntries;
    fUsedSlots = ht->fUsedSlots;
+   IndexBuild();
 
    // this should not happen, but it will prevent an endless loop
    // in case of a very bad hash function
@@ -416,7 +469,8 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 
 TObject *THashTable::Remove(TObject *obj)
 {
-   Int_t slot = GetHashValue(obj);
+   ULong_t hash = obj->Hash();
+   Int_t slot = Int_t(hash % fSize);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -425,6 +479,7 @@ TObject *THashTable::Remove(TObject *obj)
 
       TObject *ob = fCont[slot]->Remove(obj);
       if (ob) {
+         IndexRemove(ob, hash);
          fEntries--;
          if (fCont[slot]->GetSize() == 0) {
             SafeDelete(fCont[slot]);
@@ -448,6 +503,8 @@ TObject *THashTable::RemoveSlow(TObject *obj)
       if (fCont[i]) {
          TObject *ob = fCont[i]->Remove(obj);
          if (ob) {
+            // The hash value of the object is not known: the index is searched entirely
+            IndexRemove(ob, 0);
             fEntries--;
             if (fCont[i]->GetSize() == 0) {
                SafeDelete(fCont[i]);
@@ -460,6 +517,116 @@ TObject *THashTable::RemoveSlow(TObject *obj)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add obj, of hash value hash, to the index. The index is created once the
+/// table holds enough objects, and grown to stay at most half full.
+
+void THashTable::IndexAdd(TObject *obj, ULong_t hash)
+{
+   if (!fIndex) {
+      if (fEntries >= kIndexMinEntries)
+         IndexBuild();
+      return;
+   }
+   if (2 * (fIndexUsed + 1) > fIndexSize) {
+      IndexBuild();
+      return;
+   }
+   IndexInsert(obj, hash);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// (Re)create the index from the objects of the table.
+
+void THashTable::IndexBuild()
+{
+   IndexClear();
+   if (fEntries < kIndexMinEntries)
+      return;
+
+   fIndexSize = 16;
+   while (fIndexSize < 4 * fEntries)
+      fIndexSize *= 2;
+   fIndex = new TIndexEntry[fIndexSize];
+   memset(fIndex, 0, fIndexSize * sizeof(TIndexEntry));
+   for (Int_t i = 0; i < fSize; i++) {
+      if (!fCont[i])
+         continue;
+      for (TObjLink *lnk = fCont[i]->FirstLink(); lnk; lnk = lnk->Next())
+         IndexInsert(lnk->GetObject(), lnk->GetObject()->Hash());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the index.
+
+void THashTable::IndexClear()
+{
+   delete [] fIndex;
+   fIndex     = nullptr;
+   fIndexSize = 0;
+   fIndexUsed = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Insert obj in the index, which must have a free entry. The objects with the
+/// same name as another one of the index are flagged: for those, the lookups
+/// by name use the lists of the slots, which keep the order of the objects.
+
+void THashTable::IndexInsert(TObject *obj, ULong_t hash)
+{
+   const Int_t mask = fIndexSize - 1;
+   const char *name = obj->GetName();
+   Bool_t duplicate = kFALSE;
+   Int_t free = -1;
+   Int_t i = Int_t(hash & mask);
+   for (; fIndex[i].fObject; i = (i + 1) & mask) {
+      TIndexEntry &entry = fIndex[i];
+      if (entry.fObject == kRemovedEntry) {
+         if (free < 0)
+            free = i;
+         continue;
+      }
+      if (entry.fHash == hash) {
+         const char *objname = entry.fObject->GetName();
+         if (name && objname && strcmp(name, objname) == 0) {
+            entry.fDuplicate = kTRUE;
+            duplicate = kTRUE;
+         }
+      }
+   }
+   if (free < 0) {
+      free = i;
+      fIndexUsed++;
+   }
+   fIndex[free].fHash      = hash;
+   fIndex[free].fObject    = obj;
+   fIndex[free].fDuplicate = duplicate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove obj, found in the table with hash value hash, from the index.
+
+void THashTable::IndexRemove(TObject *obj, ULong_t hash)
+{
+   if (!fIndex)
+      return;
+   const Int_t mask = fIndexSize - 1;
+   for (Int_t i = Int_t(hash & mask); fIndex[i].fObject; i = (i + 1) & mask) {
+      if (fIndex[i].fObject == obj) {
+         fIndex[i].fObject = kRemovedEntry;
+         return;
+      }
+   }
+   // The hash value of the object is not the one it was added with
+   for (Int_t i = 0; i < fIndexSize; i++) {
+      if (fIndex[i].fObject == obj) {
+         fIndex[i].fObject = kRemovedEntry;
+         return;
+      }
+   }
+}
+
 /** \class THashTableIter
 Iterator of hash table.
 */
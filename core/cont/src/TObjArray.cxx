@@ -317,15 +317,22 @@ TObject *TObjArray::Before(const TObject *obj) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove all objects from the array. Does not delete the objects
 /// unless the TObjArray is the owner (set via SetOwner()).
+/// Only the slots up to the last object are reset, so that clearing a
+/// large array holding few objects is cheap.
 
 void TObjArray::Clear(Option_t *)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (IsOwner())
+   if (IsOwner()) {
       Delete();
-   else
-      Init(fSize, fLowerBound);
+   } else {
+      const Int_t n = GetAbsLast() + 1;
+      if (n > 0)
+         memset(fCont, 0, n*sizeof(TObject*));
+      fLast = -1;
+      Changed();
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
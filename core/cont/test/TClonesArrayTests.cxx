@@ -0,0 +1,83 @@
+#include "TClonesArray.h"
+#include "TError.h"
+#include "TNamed.h"
+
+#include "gtest/gtest.h"
+
+TEST(TClonesArray, ArenaIsContiguous)
+{
+   TClonesArray a("TNamed", 10);
+   a.SetArena();
+   EXPECT_TRUE(a.UsesArena());
+   a.ExpandCreate(10);
+   for (Int_t i = 1; i < 10; i++)
+      EXPECT_EQ((char *)a.UncheckedAt(i) - (char *)a.UncheckedAt(i - 1),
+                (char *)a.UncheckedAt(1) - (char *)a.UncheckedAt(0));
+   EXPECT_GE((char *)a.UncheckedAt(1) - (char *)a.UncheckedAt(0), (Long_t)sizeof(TNamed));
+   for (Int_t i = 0; i < 10; i++)
+      EXPECT_FALSE(a.UncheckedAt(i)->IsOnHeap());
+}
+
+TEST(TClonesArray, ArenaReusesSlots)
+{
+   TClonesArray a("TNamed", 4);
+   a.SetArena();
+   for (Int_t event = 0; event < 100; event++) {
+      const Int_t n = 1 + (event * 7) % 50;
+      a.Clear("C");
+      for (Int_t i = 0; i < n; i++) {
+         auto named = static_cast<TNamed *>(a.ConstructedAt(i));
+         named->SetName(TString::Format("obj%d", i));
+      }
+      ASSERT_EQ(a.GetEntriesFast(), n);
+      for (Int_t i = 0; i < n; i++)
+         EXPECT_STREQ(a.At(i)->GetName(), TString::Format("obj%d", i).Data());
+      // ExpandCreate releases the slots beyond n: their memory goes back to the arena
+      a.ExpandCreate(n);
+   }
+   a.Delete();
+   EXPECT_EQ(a.GetEntriesFast(), 0);
+}
+
+TEST(TClonesArray, ArenaMode)
+{
+   TClonesArray a("TNamed");
+   new (a[0]) TNamed("a", "a");
+   {
+      const auto level = gErrorIgnoreLevel;
+      gErrorIgnoreLevel = kFatal;
+      a.SetArena();
+      gErrorIgnoreLevel = level;
+   }
+   EXPECT_FALSE(a.UsesArena());
+
+   TClonesArray b("TNamed");
+   b.SetArena();
+   new (b[0]) TNamed("b", "b");
+   {
+      const auto level = gErrorIgnoreLevel;
+      gErrorIgnoreLevel = kFatal;
+      a.AbsorbObjects(&b);
+      gErrorIgnoreLevel = level;
+   }
+   EXPECT_EQ(a.GetEntriesFast(), 1);
+   EXPECT_EQ(b.GetEntriesFast(), 1);
+
+   // heap allocated objects can be absorbed by an arena
+   b.AbsorbObjects(&a);
+   EXPECT_EQ(b.GetEntriesFast(), 2);
+   EXPECT_STREQ(b.At(1)->GetName(), "a");
+}
+
+TEST(TObjArray, ClearResetsSlots)
+{
+   TObjArray a(100);
+   TNamed x("x", "x");
+   a.AddAt(&x, 10);
+   a.Clear();
+   EXPECT_TRUE(a.IsEmpty());
+   for (Int_t i = 0; i < a.GetSize(); i++)
+      EXPECT_EQ(a.UncheckedAt(i), nullptr);
+   a.AddAt(&x, 3);
+   EXPECT_EQ(a.GetEntriesFast(), 4);
+}
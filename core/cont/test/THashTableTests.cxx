@@ -0,0 +1,76 @@
+#include "THashList.h"
+#include "THashTable.h"
+#include "TNamed.h"
+#include "TObjString.h"
+#include "TString.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+TEST(THashTable, FindObjectByName)
+{
+   std::vector<std::unique_ptr<TNamed>> objects;
+   THashTable table;
+   for (Int_t i = 0; i < 1000; i++) {
+      objects.emplace_back(new TNamed(TString::Format("obj%d", i).Data(), "title"));
+      table.Add(objects.back().get());
+   }
+   for (Int_t i = 0; i < 1000; i++)
+      EXPECT_EQ(table.FindObject(TString::Format("obj%d", i)), objects[i].get());
+   EXPECT_EQ(table.FindObject("obj1000"), nullptr);
+   EXPECT_EQ(table.FindObject(""), nullptr);
+
+   for (Int_t i = 0; i < 1000; i += 2)
+      EXPECT_EQ(table.Remove(objects[i].get()), objects[i].get());
+   for (Int_t i = 0; i < 1000; i++)
+      EXPECT_EQ(table.FindObject(TString::Format("obj%d", i)), i % 2 ? objects[i].get() : nullptr);
+
+   table.Rehash(10);
+   for (Int_t i = 1; i < 1000; i += 2)
+      EXPECT_EQ(table.FindObject(TString::Format("obj%d", i)), objects[i].get());
+
+   table.Clear();
+   EXPECT_EQ(table.FindObject("obj1"), nullptr);
+}
+
+TEST(THashTable, FindObjectSameNames)
+{
+   TNamed first("same", "first"), second("same", "second"), third("same", "third");
+   std::vector<std::unique_ptr<TNamed>> others;
+   THashList list;
+   for (Int_t i = 0; i < 20; i++) {
+      others.emplace_back(new TNamed(TString::Format("other%d", i).Data(), ""));
+      list.Add(others.back().get());
+   }
+   list.Add(&first);
+   list.Add(&second);
+   // the lookups return the first object of the slot
+   EXPECT_EQ(list.FindObject("same"), &first);
+   list.AddBefore(&first, &third);
+   EXPECT_EQ(list.FindObject("same"), &third);
+   list.Remove(&third);
+   EXPECT_EQ(list.FindObject("same"), &first);
+   list.Remove(&first);
+   EXPECT_EQ(list.FindObject("same"), &second);
+   list.Remove(&second);
+   EXPECT_EQ(list.FindObject("same"), nullptr);
+   EXPECT_EQ(list.FindObject("other7"), others[7].get());
+}
+
+TEST(THashTable, RemoveSlow)
+{
+   THashTable table;
+   TObjString strings[50];
+   for (Int_t i = 0; i < 50; i++) {
+      strings[i].SetString(TString::Format("%d", i));
+      table.Add(&strings[i]);
+   }
+   // the hash of the object changes after it was added
+   strings[10].SetString("renamed");
+   EXPECT_EQ(table.RemoveSlow(&strings[10]), &strings[10]);
+   EXPECT_EQ(table.GetSize(), 49);
+   EXPECT_EQ(table.FindObject("renamed"), nullptr);
+   EXPECT_EQ(table.FindObject("11"), &strings[11]);
+}
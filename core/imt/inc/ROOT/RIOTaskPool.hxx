@@ -0,0 +1,94 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RIOTaskPool
+#define ROOT_RIOTaskPool
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::RIOTaskPool
+\ingroup Parallelism
+\brief A small pool of threads running tasks which mostly wait for I/O.
+
+The tasks of the pool are expected to block in the kernel or on the network rather than to burn CPU, and therefore
+run on their own threads in addition to the threads of ROOT's task arena. This lets read-ahead overlap with the
+compute work scheduled through IMT instead of competing with it for the arena's worker threads.
+
+Every task announces the number of bytes it is going to read. Submit() blocks while the bytes of the queued and
+running tasks would exceed the read-ahead limit, which bounds the memory held by data that is read but not yet
+processed. A task larger than the limit is accepted when no other task is in flight.
+
+When a task is finished, its optional continuation is handed over to ROOT's task arena if implicit multi-threading
+is enabled, so that the compute work depending on the data starts without an intermediate thread. Otherwise the
+continuation runs on the I/O thread.
+
+The pool shared by ROOT's components is returned by GetIOTaskPool(). Its number of threads and read-ahead limit are
+taken from the `Root.ImplicitMT.IOThreads` and `Root.ImplicitMT.IOMaxBytesInFlight` rootrc settings.
+*/
+class RIOTaskPool {
+public:
+   using Task_t = std::function<void(void)>;
+
+private:
+   struct RItem {
+      Task_t fTask;
+      Task_t fContinuation;
+      std::size_t fNBytes = 0;
+      std::promise<void> fPromise;
+   };
+
+   std::mutex fMutex;
+   /// Signals a non-empty queue or the shutdown of the pool
+   std::condition_variable fCvHasWork;
+   /// Signals that in-flight bytes are released
+   std::condition_variable fCvHasBudget;
+   std::deque<RItem> fQueue;
+   std::vector<std::thread> fThreads;
+   const std::size_t fMaxBytesInFlight;
+   /// Bytes announced by the queued and running tasks
+   std::size_t fBytesInFlight = 0;
+   /// Number of queued and running tasks
+   std::size_t fNInFlight = 0;
+   bool fIsShutdown = false;
+
+   void Run();
+
+public:
+   RIOTaskPool(unsigned nThreads, std::size_t maxBytesInFlight);
+   RIOTaskPool(const RIOTaskPool &) = delete;
+   RIOTaskPool &operator=(const RIOTaskPool &) = delete;
+   /// Runs the queued tasks before joining the threads
+   ~RIOTaskPool();
+
+   std::future<void> Submit(const Task_t &task, std::size_t nBytes = 0, const Task_t &continuation = Task_t());
+
+   unsigned GetNThreads() const { return fThreads.size(); }
+   std::size_t GetMaxBytesInFlight() const { return fMaxBytesInFlight; }
+   std::size_t GetBytesInFlight();
+};
+
+std::shared_ptr<RIOTaskPool> GetIOTaskPool();
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -43,6 +43,11 @@ class ROpaqueTaskArena;
 
 namespace Internal {
 
+class RNumaPinningObserver;
+
+/// Tag to attach ROOT's task arena to the tbb::task_arena of the calling thread, see GetGlobalTaskArena()
+enum class ETaskArenaAttach { kAttach };
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the available number of logical cores.
 ///
@@ -65,10 +70,20 @@ public:
    ~RTaskArenaWrapper(); // necessary to set size back to zero
    static unsigned TaskArenaSize(); // A static getter lets us check for RTaskArenaWrapper's existence
    ROOT::ROpaqueTaskArena &Access();
+   unsigned Resize(unsigned maxConcurrency = 0);
+   /// Returns true if the arena is attached to a tbb::task_arena owned by the application
+   bool IsAttached() const { return fAttached; }
+   unsigned NumaNodes() const;
+   unsigned NumaNodeOfSlot(unsigned slot) const;
 private:
    RTaskArenaWrapper(unsigned maxConcurrency = 0);
+   RTaskArenaWrapper(ETaskArenaAttach);
+   void InitPinning();
    friend std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency);
+   friend std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(ETaskArenaAttach);
    std::unique_ptr<ROOT::ROpaqueTaskArena> fTBBArena;
+   std::unique_ptr<RNumaPinningObserver> fPinning; ///< pins the threads to the NUMA nodes, if requested
+   bool fAttached = false;                         ///< the tbb::task_arena is owned by the application
    static unsigned fNWorkers;
 };
 
@@ -82,6 +97,22 @@ private:
 ////////////////////////////////////////////////////////////////////////////////
 std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency = 0);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Factory function returning a shared pointer to the instance of the global
+/// RTaskArenaWrapper, which is attached to the tbb::task_arena in which the
+/// calling thread runs if there is no instance yet.
+///
+/// Lets applications which already own a tbb::task_arena run the work of ROOT
+/// within their own arena and thread budget, instead of in a competing arena:
+/// ~~~{.cpp}
+/// arena.execute([&] {
+///    auto rootArena = ROOT::Internal::GetGlobalTaskArena(ROOT::Internal::ETaskArenaAttach::kAttach);
+///    ROOT::EnableImplicitMT(); // uses the attached arena as long as rootArena exists
+/// });
+/// ~~~
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(ETaskArenaAttach);
+
 } // namespace Internal
 } // namespace ROOT
 
@@ -29,6 +29,8 @@ class TTaskGroup {
    */
 private:
    void *fTaskContainer{nullptr};
+   /// Keeps ROOT's global task arena alive while the group is in use; tasks are run and waited for inside of it
+   void *fTaskArenaW{nullptr};
    std::atomic<bool> fCanRun{true};
    void ExecuteInIsolation(const std::function<void(void)> &operation);
 
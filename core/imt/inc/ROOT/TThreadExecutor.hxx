@@ -22,11 +22,14 @@
 # endif
 #else
 
+#include "ROOT/RSpan.hxx"
 #include "ROOT/TExecutorCRTP.hxx"
 #include "ROOT/TSeq.hxx"
 #include "RTaskArena.hxx"
 #include "TError.h"
 
+#include <algorithm> //std::sort, std::inplace_merge, std::stable_partition
+#include <cstddef>
 #include <functional> //std::function
 #include <initializer_list>
 #include <memory>
@@ -93,6 +96,17 @@ namespace ROOT {
       template<class T, class R> auto Reduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
       template<class T, class BINARYOP> auto Reduce(const std::vector<T> &objs, BINARYOP redfunc) -> decltype(redfunc(objs.front(), objs.front()));
 
+      // Parallel algorithms on contiguous data
+      //
+      template<class T, class COMPARE = std::less<T>>
+      void Sort(std::span<T> data, COMPARE comp = COMPARE());
+      template<class T, class BINARYOP = std::plus<T>>
+      void InclusiveScan(std::span<T> data, BINARYOP op = BINARYOP());
+      template<class T, class PRED>
+      std::size_t Partition(std::span<T> data, PRED pred);
+      template<class T, class R, class BINARYOP, class UNARYOP>
+      R TransformReduce(std::span<T> data, R init, BINARYOP redfunc, UNARYOP transform);
+
       unsigned GetPoolSize() const;
 
    private:
@@ -127,6 +141,8 @@ namespace ROOT {
       template<class T, class R>
       auto SeqReduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
 
+      std::size_t GetNChunks(std::size_t nElements) const;
+
       /// Pointer to the TBB task arena wrapper
       std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> fTaskArenaW = nullptr;
    };
@@ -569,6 +585,160 @@ namespace ROOT {
       return ParallelReduce(objs, redfunc);
    }
 
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Sort the elements of a contiguous range in parallel.
+   ///
+   /// The range is split in chunks which are sorted in parallel and then merged pairwise,
+   /// half as many merges running in parallel at each step. Like std::sort, the order of
+   /// equivalent elements is not preserved. Small ranges are sorted sequentially.
+   /// ~~~{.cpp}
+   /// std::vector<double> v = ...;
+   /// ROOT::TThreadExecutor pool;
+   /// pool.Sort(std::span<double>(v));
+   /// ~~~
+   /// \param data Elements to sort.
+   /// \param comp Comparison function object, as for std::sort.
+   template<class T, class COMPARE>
+   void TThreadExecutor::Sort(std::span<T> data, COMPARE comp)
+   {
+      const auto n = data.size();
+      T *first = data.data();
+      const auto nChunks = GetNChunks(n);
+      if (nChunks < 2) {
+         std::sort(first, first + n, comp);
+         return;
+      }
+      auto bound = [n, nChunks](std::size_t i) { return i * n / nChunks; };
+
+      ParallelFor(0U, nChunks, 1, [&](unsigned int i) { std::sort(first + bound(i), first + bound(i + 1), comp); });
+      for (std::size_t width = 1; width < nChunks; width *= 2) {
+         const unsigned nMerges = (nChunks + 2 * width - 1) / (2 * width);
+         ParallelFor(0U, nMerges, 1, [&](unsigned int i) {
+            const auto left = 2 * width * i;
+            const auto mid = std::min(left + width, nChunks);
+            const auto right = std::min(left + 2 * width, nChunks);
+            if (mid < right)
+               std::inplace_merge(first + bound(left), first + bound(mid), first + bound(right), comp);
+         });
+      }
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Replace in parallel each element of a contiguous range by the combination with `op`
+   /// of itself and all preceding elements (inclusive prefix sum), as std::inclusive_scan.
+   ///
+   /// The partial results of the chunks of the range are computed in parallel, then the
+   /// combination of the preceding chunks is applied to each chunk in parallel. `op` must be
+   /// associative; as the order of the operations differs from a sequential scan, results
+   /// of floating point additions can differ by rounding.
+   /// \param data Elements to scan, overwritten with the result.
+   /// \param op Binary associative operation.
+   template<class T, class BINARYOP>
+   void TThreadExecutor::InclusiveScan(std::span<T> data, BINARYOP op)
+   {
+      const auto n = data.size();
+      T *first = data.data();
+      const auto nChunks = GetNChunks(n);
+      if (nChunks < 2) {
+         std::partial_sum(first, first + n, first, op);
+         return;
+      }
+      auto bound = [n, nChunks](std::size_t i) { return i * n / nChunks; };
+
+      std::vector<T> carry(nChunks);
+      ParallelFor(0U, nChunks, 1, [&](unsigned int i) {
+         std::partial_sum(first + bound(i), first + bound(i + 1), first + bound(i), op);
+         carry[i] = first[bound(i + 1) - 1];
+      });
+      for (std::size_t i = 1; i < nChunks; ++i)
+         carry[i] = op(carry[i - 1], carry[i]);
+      ParallelFor(1U, nChunks, 1, [&](unsigned int i) {
+         for (auto j = bound(i); j < bound(i + 1); ++j)
+            first[j] = op(carry[i - 1], first[j]);
+      });
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Reorder in parallel the elements of a contiguous range such that the elements
+   /// satisfying `pred` precede the others, preserving the relative order (as std::stable_partition).
+   ///
+   /// The chunks of the range are partitioned in parallel and then moved in parallel to their
+   /// final position through a buffer of the size of the range, so T must be default constructible.
+   /// \param data Elements to partition.
+   /// \param pred Unary predicate.
+   /// \return The number of elements satisfying `pred`, i.e. the index of the first element of the second group.
+   template<class T, class PRED>
+   std::size_t TThreadExecutor::Partition(std::span<T> data, PRED pred)
+   {
+      const auto n = data.size();
+      T *first = data.data();
+      const auto nChunks = GetNChunks(n);
+      if (nChunks < 2)
+         return std::stable_partition(first, first + n, pred) - first;
+      auto bound = [n, nChunks](std::size_t i) { return i * n / nChunks; };
+
+      std::vector<std::size_t> nTrue(nChunks);
+      ParallelFor(0U, nChunks, 1, [&](unsigned int i) {
+         nTrue[i] = std::stable_partition(first + bound(i), first + bound(i + 1), pred) - (first + bound(i));
+      });
+
+      // destinations of the two groups of each chunk
+      std::vector<std::size_t> posTrue(nChunks), posFalse(nChunks);
+      std::size_t totalTrue = 0;
+      for (std::size_t i = 0; i < nChunks; ++i) {
+         posTrue[i] = totalTrue;
+         totalTrue += nTrue[i];
+      }
+      for (std::size_t i = 0; i < nChunks; ++i)
+         posFalse[i] = totalTrue + bound(i) - posTrue[i];
+
+      std::vector<T> buffer(n);
+      ParallelFor(0U, nChunks, 1, [&](unsigned int i) {
+         const auto mid = bound(i) + nTrue[i];
+         std::move(first + bound(i), first + mid, buffer.begin() + posTrue[i]);
+         std::move(first + mid, first + bound(i + 1), buffer.begin() + posFalse[i]);
+      });
+      ParallelFor(0U, nChunks, 1, [&](unsigned int i) {
+         std::move(buffer.begin() + bound(i), buffer.begin() + bound(i + 1), first + bound(i));
+      });
+      return totalTrue;
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Apply `transform` to the elements of a contiguous range and combine the results
+   /// with `redfunc` in parallel, starting from `init`, as std::transform_reduce.
+   ///
+   /// `redfunc` must be associative and commutative.
+   /// \param data Elements to transform.
+   /// \param init Initial value of the reduction.
+   /// \param redfunc Binary reduction function.
+   /// \param transform Unary function applied to each element.
+   /// \return The combination of `init` and of the transformed elements.
+   template<class T, class R, class BINARYOP, class UNARYOP>
+   R TThreadExecutor::TransformReduce(std::span<T> data, R init, BINARYOP redfunc, UNARYOP transform)
+   {
+      const auto n = data.size();
+      T *first = data.data();
+      const auto nChunks = GetNChunks(n);
+      if (nChunks < 2) {
+         for (std::size_t i = 0; i < n; ++i)
+            init = redfunc(init, transform(first[i]));
+         return init;
+      }
+      auto bound = [n, nChunks](std::size_t i) { return i * n / nChunks; };
+
+      std::vector<R> partials(nChunks, init);
+      ParallelFor(0U, nChunks, 1, [&](unsigned int i) {
+         R partial = transform(first[bound(i)]);
+         for (auto j = bound(i) + 1; j < bound(i + 1); ++j)
+            partial = redfunc(partial, transform(first[j]));
+         partials[i] = partial;
+      });
+      for (auto &partial : partials)
+         init = redfunc(init, partial);
+      return init;
+   }
+
    //////////////////////////////////////////////////////////////////////////
    /// \brief "Reduce", sequentially, an std::vector into a single object
    ///
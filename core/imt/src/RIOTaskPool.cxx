@@ -0,0 +1,166 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "RConfigure.h"
+
+#include "ROOT/RIOTaskPool.hxx"
+#include "TEnv.h"
+#include "TError.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROpaqueTaskArena.hxx"
+#include "ROOT/RTaskArena.hxx"
+#endif
+
+#include <exception>
+#include <utility>
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start `nThreads` I/O threads, at least one. A `maxBytesInFlight` of zero disables the read-ahead limit.
+RIOTaskPool::RIOTaskPool(unsigned nThreads, std::size_t maxBytesInFlight) : fMaxBytesInFlight(maxBytesInFlight)
+{
+   if (nThreads == 0)
+      nThreads = 1;
+   fThreads.reserve(nThreads);
+   for (unsigned i = 0; i < nThreads; ++i)
+      fThreads.emplace_back(&RIOTaskPool::Run, this);
+}
+
+RIOTaskPool::~RIOTaskPool()
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fIsShutdown = true;
+   }
+   fCvHasWork.notify_all();
+   for (auto &thread : fThreads)
+      thread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Queue a task reading about `nBytes`. Blocks while the read-ahead limit does not leave room for the task.
+/// The returned future becomes ready when the task is done and rethrows its exception, if any. The continuation
+/// is only run if the task succeeds.
+std::future<void> RIOTaskPool::Submit(const Task_t &task, std::size_t nBytes, const Task_t &continuation)
+{
+   RItem item;
+   item.fTask = task;
+   item.fContinuation = continuation;
+   item.fNBytes = nBytes;
+   auto future = item.fPromise.get_future();
+
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      if (fMaxBytesInFlight > 0) {
+         fCvHasBudget.wait(lock, [&] { return fNInFlight == 0 || fBytesInFlight + nBytes <= fMaxBytesInFlight; });
+      }
+      fBytesInFlight += nBytes;
+      ++fNInFlight;
+      fQueue.emplace_back(std::move(item));
+   }
+   fCvHasWork.notify_one();
+   return future;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Bytes announced by the queued and running tasks
+std::size_t RIOTaskPool::GetBytesInFlight()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fBytesInFlight;
+}
+
+void RIOTaskPool::Run()
+{
+   while (true) {
+      RItem item;
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCvHasWork.wait(lock, [this] { return fIsShutdown || !fQueue.empty(); });
+         if (fQueue.empty())
+            return;
+         item = std::move(fQueue.front());
+         fQueue.pop_front();
+      }
+
+      bool success = true;
+      try {
+         item.fTask();
+      } catch (...) {
+         success = false;
+         item.fPromise.set_exception(std::current_exception());
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fBytesInFlight -= item.fNBytes;
+         --fNInFlight;
+      }
+      fCvHasBudget.notify_all();
+
+      if (success) {
+         item.fPromise.set_value();
+         if (item.fContinuation) {
+#ifdef R__USE_IMT
+            if (ROOT::IsImplicitMTEnabled()) {
+               // Keep the arena alive until the continuation ran
+               auto arena = GetGlobalTaskArena();
+               auto continuation = std::move(item.fContinuation);
+               arena->Access().enqueue([arena, continuation] { continuation(); });
+               continue;
+            }
+#endif
+            item.fContinuation();
+         }
+      }
+   }
+}
+
+namespace {
+std::weak_ptr<RIOTaskPool> &GetIOTaskPoolWeakPtr()
+{
+   static std::weak_ptr<RIOTaskPool> weakPool;
+   return weakPool;
+}
+
+std::mutex &GetIOTaskPoolMutex()
+{
+   static std::mutex m;
+   return m;
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the I/O task pool shared by ROOT's components, creating it if needed. The pool lives as long as one of
+/// the returned pointers.
+std::shared_ptr<RIOTaskPool> GetIOTaskPool()
+{
+   const std::lock_guard<std::mutex> lock{GetIOTaskPoolMutex()};
+   auto &weakPool = GetIOTaskPoolWeakPtr();
+   if (auto sp = weakPool.lock())
+      return sp;
+
+   Int_t nThreads = gEnv->GetValue("Root.ImplicitMT.IOThreads", 2);
+   Int_t maxBytes = gEnv->GetValue("Root.ImplicitMT.IOMaxBytesInFlight", 256 * 1024 * 1024);
+   if (nThreads < 1) {
+      Warning("GetIOTaskPool", "Root.ImplicitMT.IOThreads must be positive, using one thread");
+      nThreads = 1;
+   }
+   auto sp = std::make_shared<RIOTaskPool>(nThreads, maxBytes > 0 ? maxBytes : 0);
+   weakPool = sp;
+   return sp;
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -1,5 +1,8 @@
 #include "tbb/task_arena.h"
 
 namespace ROOT {
-class ROpaqueTaskArena: public tbb::task_arena {};
+class ROpaqueTaskArena: public tbb::task_arena {
+public:
+   using tbb::task_arena::task_arena;
+};
 }
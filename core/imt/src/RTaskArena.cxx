@@ -3,15 +3,25 @@
 
 #include "ROOT/RTaskArena.hxx"
 #include "ROpaqueTaskArena.hxx"
+#include "TEnv.h"
 #include "TError.h"
 #include "TROOT.h"
+#include "TSystem.h"
 #include "TThread.h"
 #include <fstream>
 #include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
+#ifdef R__LINUX
+#include <sched.h>
+#endif
 #include "tbb/task_arena.h"
 #define TBB_PREVIEW_GLOBAL_CONTROL 1 // required for TBB versions preceding 2019_U4
 #include "tbb/global_control.h"
+#define TBB_PREVIEW_LOCAL_OBSERVER 1 // required for observers of a given task arena in older TBB versions
+#include "tbb/task_scheduler_observer.h"
 
 //////////////////////////////////////////////////////////////////////////
 ///
@@ -38,6 +48,14 @@
 /// root[] gTA->Access().max_concurrency() // call to tbb::task_arena::max_concurrency()
 /// ~~~
 ///
+/// On Linux machines with several NUMA nodes, the threads of the arena can be
+/// pinned to the nodes by setting `Root.ImplicitMT.NumaPinning: true` in the
+/// .rootrc or the environment variable `ROOT_IMT_NUMA_PINNING`. The slots of
+/// the arena are distributed in contiguous blocks over the nodes, a thread
+/// taking slot `i` running on the CPUs of node `i * nNodes / nSlots`. As the
+/// memory is allocated on the node of the thread first touching it, the data of
+/// the tasks then stay on the node of the thread processing them.
+///
 //////////////////////////////////////////////////////////////////////////
 
 namespace ROOT {
@@ -61,21 +79,27 @@ int LogicalCPUBandwithControl()
          return static_cast<int>(std::ceil(cfs_quota / cfs_period));
       }
    }
+   // cgroup v2: "<quota> <period>" or "max <period>"
+   std::ifstream f2("/sys/fs/cgroup/cpu.max");
+   std::string quota;
+   float period = 0;
+   if (f2 >> quota >> period && quota != "max" && period > 0) {
+      const float cfs_quota = std::stof(quota);
+      if (cfs_quota > 0)
+         return static_cast<int>(std::ceil(cfs_quota / period));
+   }
 #endif
    return std::thread::hardware_concurrency();
 }
 
+namespace {
+
 ////////////////////////////////////////////////////////////////////////////////
-/// Initializes the tbb::task_arena within RTaskArenaWrapper.
-///
-/// * Can't be reinitialized
-/// * Checks for CPU bandwidth control and avoids oversubscribing
-/// * If no BC in place and maxConcurrency<1, defaults to the default tbb number of threads,
-/// which is CPU affinity aware
-////////////////////////////////////////////////////////////////////////////////
-RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new ROpaqueTaskArena{})
+/// Limits the requested number of threads, 0 meaning as many as possible, to
+/// the default number of threads of TBB and to the CPU bandwidth control.
+unsigned ClampConcurrency(unsigned maxConcurrency)
 {
-   const unsigned tbbDefaultNumberThreads = fTBBArena->max_concurrency(); // not initialized, automatic state
+   const unsigned tbbDefaultNumberThreads = tbb::task_arena{}.max_concurrency(); // not initialized, automatic state
    maxConcurrency = maxConcurrency > 0 ? std::min(maxConcurrency, tbbDefaultNumberThreads) : tbbDefaultNumberThreads;
    const unsigned bcCpus = LogicalCPUBandwithControl();
    if (maxConcurrency > bcCpus) {
@@ -86,13 +110,169 @@ RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new RO
       Warning("RTaskArenaWrapper", "tbb::global_control is active, limiting the number of parallel workers"
                                    "from this task arena available for execution.");
    }
+   return maxConcurrency;
+}
+
+} // anonymous namespace
+
+#ifdef R__LINUX
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parses a list of CPUs or nodes in the kernel format, e.g. "0-3,8,10-11".
+std::vector<int> ParseCPUList(const std::string &list)
+{
+   std::vector<int> ids;
+   std::stringstream ss(list);
+   std::string range;
+   while (std::getline(ss, range, ',')) {
+      if (range.empty())
+         continue;
+      auto dash = range.find('-');
+      try {
+         int first = std::stoi(range.substr(0, dash));
+         int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+         for (int id = first; id <= last; ++id)
+            ids.push_back(id);
+      } catch (const std::exception &) {
+         return {};
+      }
+   }
+   return ids;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the CPUs of each online NUMA node usable by this process, skipping
+/// the nodes without any of them.
+std::vector<cpu_set_t> GetNumaNodesCPUs()
+{
+   std::vector<cpu_set_t> nodes;
+   cpu_set_t allowed;
+   CPU_ZERO(&allowed);
+   if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+      return nodes;
+
+   std::ifstream online("/sys/devices/system/node/online");
+   std::string list;
+   if (!online || !std::getline(online, list))
+      return nodes;
+
+   for (int node : ParseCPUList(list)) {
+      std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      std::string cpulist;
+      if (!f || !std::getline(f, cpulist))
+         continue;
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (int cpu : ParseCPUList(cpulist))
+         if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+            CPU_SET(cpu, &cpus);
+      if (CPU_COUNT(&cpus) > 0)
+         nodes.push_back(cpus);
+   }
+   return nodes;
+}
+
+} // anonymous namespace
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Observer of ROOT's task arena pinning its threads to the NUMA nodes, see
+/// RTaskArenaWrapper.
+////////////////////////////////////////////////////////////////////////////////
+class RNumaPinningObserver : public tbb::task_scheduler_observer {
+#ifdef R__LINUX
+   std::vector<cpu_set_t> fNodes; ///< CPUs of each NUMA node
+#endif
+   unsigned fNSlots;              ///< number of slots of the arena
+
+public:
+   RNumaPinningObserver(tbb::task_arena &arena, unsigned nSlots)
+      : tbb::task_scheduler_observer(arena), fNSlots(nSlots)
+   {
+#ifdef R__LINUX
+      fNodes = GetNumaNodesCPUs();
+      if (fNodes.size() > 1)
+         observe(true);
+#endif
+   }
+
+   ~RNumaPinningObserver() { observe(false); }
+
+   /// Returns the number of NUMA nodes the threads are pinned to, 0 if they are not pinned
+   unsigned GetNNodes() const
+   {
+#ifdef R__LINUX
+      return fNodes.size() > 1 ? fNodes.size() : 0;
+#else
+      return 0;
+#endif
+   }
+
+   void on_scheduler_entry(bool) override
+   {
+#ifdef R__LINUX
+      const int slot = tbb::this_task_arena::current_thread_index();
+      if (slot < 0 || fNSlots == 0)
+         return;
+      const auto &cpus = fNodes[(static_cast<unsigned>(slot) % fNSlots) * fNodes.size() / fNSlots];
+      sched_setaffinity(0, sizeof(cpus), &cpus);
+#endif
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Initializes the tbb::task_arena within RTaskArenaWrapper.
+///
+/// * Can't be reinitialized
+/// * Checks for CPU bandwidth control and avoids oversubscribing
+/// * If no BC in place and maxConcurrency<1, defaults to the default tbb number of threads,
+/// which is CPU affinity aware
+////////////////////////////////////////////////////////////////////////////////
+RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new ROpaqueTaskArena{})
+{
+   maxConcurrency = ClampConcurrency(maxConcurrency);
    fTBBArena->initialize(maxConcurrency);
    fNWorkers = maxConcurrency;
    ROOT::EnableThreadSafety();
+   InitPinning();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Attaches to the tbb::task_arena in which the calling thread runs, or
+/// initializes a new arena if the thread does not run in any arena.
+/// The threads of an attached arena are never pinned.
+////////////////////////////////////////////////////////////////////////////////
+RTaskArenaWrapper::RTaskArenaWrapper(ETaskArenaAttach)
+   : fTBBArena(new ROpaqueTaskArena{tbb::task_arena::attach{}}), fAttached(true)
+{
+   if (!fTBBArena->is_active()) {
+      Warning("RTaskArenaWrapper", "The calling thread does not run in a task arena, creating a new one");
+      fAttached = false;
+      fTBBArena->initialize(ClampConcurrency(0));
+   }
+   fNWorkers = fTBBArena->max_concurrency();
+   ROOT::EnableThreadSafety();
+   if (!fAttached)
+      InitPinning();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pins the threads of the arena to the NUMA nodes if requested.
+////////////////////////////////////////////////////////////////////////////////
+void RTaskArenaWrapper::InitPinning()
+{
+   if (gEnv->GetValue("Root.ImplicitMT.NumaPinning", 0) || gSystem->Getenv("ROOT_IMT_NUMA_PINNING")) {
+      fPinning.reset(new RNumaPinningObserver(*fTBBArena, fNWorkers));
+      if (fPinning->GetNNodes() == 0)
+         Info("RTaskArenaWrapper", "Only one NUMA node available, the threads are not pinned");
+   }
 }
 
 RTaskArenaWrapper::~RTaskArenaWrapper()
 {
+   // stop observing before the arena goes away
+   fPinning.reset();
    fNWorkers = 0u;
 }
 
@@ -110,12 +290,69 @@ ROOT::ROpaqueTaskArena &RTaskArenaWrapper::Access()
    return *fTBBArena;
 }
 
-std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency)
+////////////////////////////////////////////////////////////////////////////////
+/// Reinitializes the arena with a new number of threads, limited as for a new
+/// arena: Resize(0) in particular follows a change of the CPU quota of the
+/// process. This must not be called while tasks run in the arena. An attached
+/// arena is not resized, it is controlled by its owner.
+/// Returns the number of threads of the arena.
+////////////////////////////////////////////////////////////////////////////////
+unsigned RTaskArenaWrapper::Resize(unsigned maxConcurrency)
+{
+   if (fAttached) {
+      Warning("Resize", "Cannot resize an attached task arena, keeping %d threads", fNWorkers);
+      return fNWorkers;
+   }
+   maxConcurrency = ClampConcurrency(maxConcurrency);
+   if (maxConcurrency == fNWorkers)
+      return fNWorkers;
+
+   fPinning.reset();
+   fTBBArena->terminate();
+   fTBBArena->initialize(maxConcurrency);
+   fNWorkers = maxConcurrency;
+   InitPinning();
+   return fNWorkers;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the number of NUMA nodes the threads of the arena are pinned to,
+/// 0 if they are not pinned.
+////////////////////////////////////////////////////////////////////////////////
+unsigned RTaskArenaWrapper::NumaNodes() const
+{
+   return fPinning ? fPinning->GetNNodes() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the NUMA node on which the tasks running in the given slot of the
+/// arena (tbb::this_task_arena::current_thread_index()) are pinned, 0 if the
+/// threads are not pinned. Lets the users of the arena keep per-node data.
+////////////////////////////////////////////////////////////////////////////////
+unsigned RTaskArenaWrapper::NumaNodeOfSlot(unsigned slot) const
+{
+   const unsigned nNodes = NumaNodes();
+   return nNodes ? (slot % fNWorkers) * nNodes / fNWorkers : 0;
+}
+
+namespace {
+std::weak_ptr<ROOT::Internal::RTaskArenaWrapper> &GetGlobalTaskArenaWeakPtr()
 {
    static std::weak_ptr<ROOT::Internal::RTaskArenaWrapper> weak_GTAWrapper;
+   return weak_GTAWrapper;
+}
 
+std::mutex &GetGlobalTaskArenaMutex()
+{
    static std::mutex m;
-   const std::lock_guard<std::mutex> lock{m};
+   return m;
+}
+} // anonymous namespace
+
+std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency)
+{
+   const std::lock_guard<std::mutex> lock{GetGlobalTaskArenaMutex()};
+   auto &weak_GTAWrapper = GetGlobalTaskArenaWeakPtr();
    if (auto sp = weak_GTAWrapper.lock()) {
       if (maxConcurrency && (sp->TaskArenaSize() != maxConcurrency)) {
          Warning("RTaskArenaWrapper", "There's already an active task arena. Proceeding with the current %d threads",
@@ -128,5 +365,21 @@ std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned m
    return sp;
 }
 
+std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(ETaskArenaAttach attach)
+{
+   const std::lock_guard<std::mutex> lock{GetGlobalTaskArenaMutex()};
+   auto &weak_GTAWrapper = GetGlobalTaskArenaWeakPtr();
+   if (auto sp = weak_GTAWrapper.lock()) {
+      if (!sp->IsAttached()) {
+         Warning("RTaskArenaWrapper", "There's already an active task arena. Proceeding with the current %d threads",
+                 sp->TaskArenaSize());
+      }
+      return sp;
+   }
+   std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> sp(new ROOT::Internal::RTaskArenaWrapper(attach));
+   weak_GTAWrapper = sp;
+   return sp;
+}
+
 } // namespace Internal
 } // namespace ROOT
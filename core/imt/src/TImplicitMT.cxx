@@ -20,7 +20,10 @@
 
 #include "TError.h"
 #include "ROOT/RTaskArena.hxx"
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
 #include <atomic>
+#include <functional>
 
 static std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> &R__GetTaskArena4IMT()
 {
@@ -79,3 +82,8 @@ extern "C" bool ROOT_TImplicitMT_IsParBranchProcessingEnabled()
 {
    return GetParBranchProcessingCount() > 0;
 };
+
+extern "C" void ROOT_TImplicitMT_Foreach(const std::function<void(unsigned)> &func, UInt_t nTimes)
+{
+   ROOT::TThreadExecutor().Foreach(func, ROOT::TSeqU(nTimes));
+};
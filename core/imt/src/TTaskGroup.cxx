@@ -12,9 +12,12 @@
 #include "RConfigure.h"
 
 #include "ROOT/TTaskGroup.hxx"
+#include "ROOT/RTrace.hxx"
 
 #ifdef R__USE_IMT
 #include "TROOT.h"
+#include "ROpaqueTaskArena.hxx"
+#include "ROOT/RTaskArena.hxx"
 #include "tbb/task_group.h"
 #include "tbb/task_arena.h"
 #endif
@@ -41,6 +44,11 @@ tbb::task_group *CastToTG(void* p) {
    return (tbb::task_group *) p;
 }
 
+std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> &CastToTAW(void *p)
+{
+   return *((std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> *)p);
+}
+
 #endif
 
 } // namespace Internal
@@ -59,6 +67,7 @@ TTaskGroup::TTaskGroup()
    if (!ROOT::IsImplicitMTEnabled()) {
       throw std::runtime_error("Implicit parallelism not enabled. Cannot instantiate a TTaskGroup.");
    }
+   fTaskArenaW = ((void *)new std::shared_ptr<ROOT::Internal::RTaskArenaWrapper>(GetGlobalTaskArena()));
    fTaskContainer = ((void *)new tbb::task_group());
 #endif
 }
@@ -72,6 +81,8 @@ TTaskGroup &TTaskGroup::operator=(TTaskGroup &&other)
 {
    fTaskContainer = other.fTaskContainer;
    other.fTaskContainer = nullptr;
+   fTaskArenaW = other.fTaskArenaW;
+   other.fTaskArenaW = nullptr;
    fCanRun.store(other.fCanRun);
    return *this;
 }
@@ -83,6 +94,21 @@ TTaskGroup::~TTaskGroup()
       return;
    Wait();
    delete CastToTG(fTaskContainer);
+   delete &CastToTAW(fTaskArenaW);
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Run operation in the ROOT task arena, i.e. with the number of
+/// worker threads requested through ROOT::EnableImplicitMT(). Without the
+/// arena, tasks would be scheduled in the default TBB arena that spans
+/// all cores of the machine.
+void TTaskGroup::ExecuteInIsolation(const std::function<void(void)> &operation)
+{
+#ifdef R__USE_IMT
+   CastToTAW(fTaskArenaW)->Access().execute([&] { operation(); });
+#else
+   operation();
 #endif
 }
 
@@ -92,7 +118,7 @@ void TTaskGroup::Cancel()
 {
 #ifdef R__USE_IMT
    fCanRun = false;
-   CastToTG(fTaskContainer)->cancel();
+   ExecuteInIsolation([&] { CastToTG(fTaskContainer)->cancel(); });
    fCanRun = true;
 #endif
 }
@@ -111,7 +137,12 @@ void TTaskGroup::Run(const std::function<void(void)> &closure)
    while (!fCanRun)
       /* empty */;
 
-   CastToTG(fTaskContainer)->run(closure);
+   ExecuteInIsolation([&] {
+      CastToTG(fTaskContainer)->run([closure] {
+         R__TRACE_SPAN("imt", "TTaskGroup task");
+         closure();
+      });
+   });
 #else
    closure();
 #endif
@@ -124,7 +155,7 @@ void TTaskGroup::Wait()
 {
 #ifdef R__USE_IMT
    fCanRun = false;
-   CastToTG(fTaskContainer)->wait();
+   ExecuteInIsolation([&] { CastToTG(fTaskContainer)->wait(); });
    fCanRun = true;
 #endif
 }
@@ -3,6 +3,7 @@
 
 #include "ROOT/TThreadExecutor.hxx"
 #include "ROpaqueTaskArena.hxx"
+#include "ROOT/RTrace.hxx"
 #if !defined(_MSC_VER)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -169,7 +170,10 @@ void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned
    }
    fTaskArenaW->Access().execute([&] {
       tbb::this_task_arena::isolate([&] {
-         tbb::parallel_for(start, end, step, f);
+         tbb::parallel_for(start, end, step, [&f](unsigned int i) {
+            R__TRACE_SPAN("imt", "TThreadExecutor task");
+            f(i);
+         });
       });
    });
 }
@@ -210,6 +214,20 @@ float TThreadExecutor::ParallelReduce(const std::vector<float> &objs,
    return fTaskArenaW->Access().execute([&] { return ROOT::Internal::ParallelReduceHelper<float>(objs, redfunc); });
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// \brief Number of chunks in which the parallel algorithms (Sort, InclusiveScan, Partition,
+/// TransformReduce) split a range of nElements elements: a few per worker thread for load
+/// balancing, but not smaller than a minimal size below which the scheduling overhead dominates.
+/// \param nElements Number of elements of the range.
+/// \return The number of chunks, 1 if the range should be processed sequentially.
+std::size_t TThreadExecutor::GetNChunks(std::size_t nElements) const
+{
+   constexpr std::size_t kMinChunkSize = 1024;
+   constexpr std::size_t kChunksPerThread = 4;
+   const auto nChunks = std::min<std::size_t>(kChunksPerThread * GetPoolSize(), nElements / kMinChunkSize);
+   return nChunks > 1 ? nChunks : 1;
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// \brief Returns the number of worker threads in the task arena.
 /// \return the number of worker threads assigned to the task arena.
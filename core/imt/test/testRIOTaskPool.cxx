@@ -0,0 +1,82 @@
+#include "TROOT.h"
+#include "ROOT/RIOTaskPool.hxx"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using ROOT::Internal::RIOTaskPool;
+
+TEST(RIOTaskPool, RunsTasks)
+{
+   RIOTaskPool pool(2, 0);
+   EXPECT_EQ(2u, pool.GetNThreads());
+   std::atomic<int> sum{0};
+   std::vector<std::future<void>> futures;
+   for (int i = 1; i <= 100; ++i)
+      futures.emplace_back(pool.Submit([&sum, i] { sum += i; }));
+   for (auto &f : futures)
+      f.wait();
+   EXPECT_EQ(5050, sum);
+   EXPECT_EQ(0u, pool.GetBytesInFlight());
+}
+
+TEST(RIOTaskPool, ForwardsExceptions)
+{
+   RIOTaskPool pool(1, 0);
+   std::atomic<bool> continued{false};
+   auto f = pool.Submit([] { throw std::runtime_error("read error"); }, 0, [&continued] { continued = true; });
+   EXPECT_THROW(f.get(), std::runtime_error);
+   EXPECT_FALSE(continued);
+}
+
+TEST(RIOTaskPool, LimitsBytesInFlight)
+{
+   RIOTaskPool pool(2, 100);
+   std::promise<void> release;
+   auto released = release.get_future().share();
+   pool.Submit([released] { released.wait(); }, 80);
+   EXPECT_EQ(80u, pool.GetBytesInFlight());
+
+   std::atomic<bool> submitted{false};
+   std::thread submitter([&] {
+      pool.Submit([] {}, 80).wait();
+      submitted = true;
+   });
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   EXPECT_FALSE(submitted);
+
+   release.set_value();
+   submitter.join();
+   EXPECT_TRUE(submitted);
+
+   // A task larger than the limit is accepted when nothing else is in flight
+   pool.Submit([] {}, 1000).wait();
+}
+
+TEST(RIOTaskPool, RunsContinuation)
+{
+   RIOTaskPool pool(1, 0);
+   std::promise<int> result;
+   int data = 0;
+   pool.Submit([&data] { data = 42; }, 0, [&] { result.set_value(data); });
+   EXPECT_EQ(42, result.get_future().get());
+}
+
+#ifdef R__USE_IMT
+TEST(RIOTaskPool, RunsContinuationInTaskArena)
+{
+   ROOT::EnableImplicitMT(2);
+   auto pool = ROOT::Internal::GetIOTaskPool();
+   std::promise<std::thread::id> ioThread, computeThread;
+   pool->Submit([&] { ioThread.set_value(std::this_thread::get_id()); }, 0,
+                [&] { computeThread.set_value(std::this_thread::get_id()); });
+   EXPECT_NE(ioThread.get_future().get(), computeThread.get_future().get());
+   ROOT::DisableImplicitMT();
+}
+#endif
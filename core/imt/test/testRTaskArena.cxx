@@ -2,6 +2,8 @@
 #include "ROOT/RTaskArena.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 #include "../src/ROpaqueTaskArena.hxx"
+#include "ROOTUnitTestSupport.h"
+#include <atomic>
 #include <fstream>
 #include <random>
 #include <thread>
@@ -74,6 +76,39 @@ TEST(RTaskArena, KeepSize)
    ASSERT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), nCores);
 }
 
+TEST(RTaskArena, Resize)
+{
+   const unsigned nCores = plausibleNCores(randGenerator);
+   auto gTAInstance = ROOT::Internal::GetGlobalTaskArena(nCores);
+   const unsigned newNCores = plausibleNCores(randGenerator);
+   EXPECT_EQ(gTAInstance->Resize(newNCores), newNCores);
+   EXPECT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), newNCores);
+   EXPECT_EQ(static_cast<unsigned>(gTAInstance->Access().max_concurrency()), newNCores);
+   EXPECT_EQ(gTAInstance->Resize(), maxConcurrency);
+}
+
+TEST(RTaskArena, AttachToExternalArena)
+{
+   const unsigned nCores = plausibleNCores(randGenerator);
+   tbb::task_arena external(nCores);
+   external.execute([&] {
+      auto gTAInstance = ROOT::Internal::GetGlobalTaskArena(ROOT::Internal::ETaskArenaAttach::kAttach);
+      EXPECT_TRUE(gTAInstance->IsAttached());
+      EXPECT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), nCores);
+
+      // IMT and executors use the attached arena
+      ROOT::TThreadExecutor threadExecutor;
+      EXPECT_EQ(threadExecutor.GetPoolSize(), nCores);
+      std::atomic<int> count(0);
+      threadExecutor.Foreach([&] { ++count; }, 10);
+      EXPECT_EQ(count, 10);
+
+      ROOT_EXPECT_WARNING(gTAInstance->Resize(1), "Resize", "Cannot resize an attached task arena, keeping " +
+                                                                std::to_string(nCores) + " threads");
+   });
+   EXPECT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), 0u);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Integration Tests
 
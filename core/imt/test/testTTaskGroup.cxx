@@ -3,7 +3,9 @@
 #include "gtest/gtest.h"
 
 #ifdef R__USE_IMT
+#include "ROOT/RTaskArena.hxx"
 #include "ROOT/TTaskGroup.hxx"
+#include "tbb/task_arena.h"
 
 using namespace ROOT::Experimental;
 
@@ -27,4 +29,15 @@ TEST(TTaskGroup, NestedExecution)
    EXPECT_EQ(Fibonacci(7), 13);
 }
 
+TEST(TTaskGroup, RunsInROOTTaskArena)
+{
+   if (!ROOT::IsImplicitMTEnabled())
+      ROOT::EnableImplicitMT(4);
+   int concurrency = 0;
+   TTaskGroup tg;
+   tg.Run([&] { concurrency = tbb::this_task_arena::max_concurrency(); });
+   tg.Wait();
+   EXPECT_EQ(static_cast<int>(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize()), concurrency);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "ROOT/TThreadExecutor.hxx"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifdef R__USE_IMT
+
+// large enough to be split in several chunks
+const std::size_t kSize = 100000;
+
+std::vector<int> RandomInts(std::size_t n)
+{
+   std::mt19937 gen(1);
+   std::uniform_int_distribution<int> dist(-1000, 1000);
+   std::vector<int> v(n);
+   for (auto &e : v)
+      e = dist(gen);
+   return v;
+}
+
+TEST(TThreadExecutor, Sort)
+{
+   ROOT::TThreadExecutor pool;
+   auto v = RandomInts(kSize);
+   auto expected = v;
+   std::sort(expected.begin(), expected.end());
+   pool.Sort(std::span<int>(v));
+   EXPECT_EQ(v, expected);
+
+   pool.Sort(std::span<int>(v), std::greater<int>());
+   std::reverse(expected.begin(), expected.end());
+   EXPECT_EQ(v, expected);
+
+   std::vector<int> small{3, 1, 2};
+   pool.Sort(std::span<int>(small));
+   EXPECT_EQ(small, std::vector<int>({1, 2, 3}));
+}
+
+TEST(TThreadExecutor, InclusiveScan)
+{
+   ROOT::TThreadExecutor pool;
+   auto v = RandomInts(kSize);
+   std::vector<long> lv(v.begin(), v.end());
+   std::vector<long> expected(lv.size());
+   std::partial_sum(lv.begin(), lv.end(), expected.begin());
+   pool.InclusiveScan(std::span<long>(lv));
+   EXPECT_EQ(lv, expected);
+
+   std::vector<long> empty;
+   pool.InclusiveScan(std::span<long>(empty));
+   EXPECT_TRUE(empty.empty());
+}
+
+TEST(TThreadExecutor, Partition)
+{
+   ROOT::TThreadExecutor pool;
+   auto v = RandomInts(kSize);
+   auto expected = v;
+   auto isEven = [](int i) { return i % 2 == 0; };
+   const std::size_t nEven = std::stable_partition(expected.begin(), expected.end(), isEven) - expected.begin();
+   EXPECT_EQ(pool.Partition(std::span<int>(v), isEven), nEven);
+   EXPECT_EQ(v, expected);
+}
+
+TEST(TThreadExecutor, TransformReduce)
+{
+   ROOT::TThreadExecutor pool;
+   const auto v = RandomInts(kSize);
+   long expected = 10;
+   for (auto e : v)
+      expected += long(e) * e;
+   auto square = [](int i) { return long(i) * i; };
+   EXPECT_EQ(pool.TransformReduce(std::span<const int>(v), 10L, std::plus<long>(), square), expected);
+}
+
+#endif
@@ -45,7 +45,7 @@ TBaseClass::TBaseClass(BaseClassInfo_t *info, TClass *cl) :
 
 TBaseClass::~TBaseClass()
 {
-   gCling->BaseClassInfo_Delete(fInfo);
+   if (fInfo) gCling->BaseClassInfo_Delete(fInfo);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
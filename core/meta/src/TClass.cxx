@@ -87,6 +87,8 @@ In order to access the name of a class within the ROOT type system, the method T
 #include "TThreadSlots.h"
 #include "ThreadLocalStorage.h"
 
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <cctype>
 #include <set>
@@ -167,6 +169,87 @@ namespace {
      }
    };
 
+   // A lock-free cache of the loaded classes returned by TClass::GetClass, one table indexed by the requested
+   // (normalized) name and one by type_info. The slots only hold the TClass pointer: a hit is confirmed by comparing
+   // the name or the type_info of the class itself, so that collisions simply miss and no key has to be stored.
+   // Hence there is nothing to allocate and readers never take a lock.
+   //
+   // The tables are emptied whenever a class is removed from the list of classes or unloaded. An insertion checks the
+   // generation counter again after its store, to undo it if a removal started since the class was looked up.
+   class TClassLookupCache {
+      static constexpr std::size_t kNSlots = 4096; // power of 2
+
+      std::atomic<ULong64_t> fGeneration{0};
+      std::atomic<bool> fIsUsed{false};
+      std::atomic<TClass *> fByName[kNSlots];
+      std::atomic<TClass *> fByType[kNSlots];
+
+      static std::size_t GetSlot(ULong64_t hash) { return (hash * 0x9E3779B97F4A7C15ull) >> 52; }
+
+      static std::size_t GetSlot(const char *name) { return GetSlot(TString::Hash(name, strlen(name))); }
+
+      static std::size_t GetSlot(const std::type_info &typeinfo)
+      {
+         return GetSlot(static_cast<ULong64_t>(reinterpret_cast<std::uintptr_t>(&typeinfo)));
+      }
+
+      TClass *Insert(std::atomic<TClass *> &slot, TClass *cl, ULong64_t generation)
+      {
+         fIsUsed = true;
+         slot = cl;
+         if (fGeneration != generation) {
+            TClass *expected = cl;
+            slot.compare_exchange_strong(expected, nullptr);
+         }
+         return cl;
+      }
+
+   public:
+      ULong64_t GetGeneration() const { return fGeneration; }
+
+      TClass *Find(const char *name) const
+      {
+         TClass *cl = fByName[GetSlot(name)].load(std::memory_order_acquire);
+         return (cl && strcmp(cl->GetName(), name) == 0) ? cl : nullptr;
+      }
+
+      TClass *Find(const std::type_info &typeinfo) const
+      {
+         TClass *cl = fByType[GetSlot(typeinfo)].load(std::memory_order_acquire);
+         return (cl && cl->GetTypeInfo() == &typeinfo) ? cl : nullptr;
+      }
+
+      /// Cache `cl`, a loaded class, if it is named `name`. Return `cl`.
+      TClass *Insert(const char *name, TClass *cl, ULong64_t generation)
+      {
+         if (strcmp(cl->GetName(), name) != 0)
+            return cl;
+         return Insert(fByName[GetSlot(name)], cl, generation);
+      }
+
+      /// Cache `cl`, a loaded class, if its type_info is `typeinfo`. Return `cl`.
+      TClass *Insert(const std::type_info &typeinfo, TClass *cl, ULong64_t generation)
+      {
+         if (cl->GetTypeInfo() != &typeinfo)
+            return cl;
+         return Insert(fByType[GetSlot(typeinfo)], cl, generation);
+      }
+
+      void Clear()
+      {
+         ++fGeneration;
+         if (!fIsUsed.exchange(false))
+            return;
+         for (auto &slot : fByName)
+            slot = nullptr;
+         for (auto &slot : fByType)
+            slot = nullptr;
+      }
+   };
+
+   // Constant-initialized, hence usable before and during the static initialization of the dictionaries
+   TClassLookupCache gClassLookupCache;
+
 }
 
 std::atomic<Int_t> TClass::fgClassCount;
@@ -526,6 +609,8 @@ void TClass::RemoveClass(TClass *oldcl)
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
    }
+   // After the removal, so that no lookup can cache the class again
+   gClassLookupCache.Clear();
    if (oldcl->fClassInfo) {
       //GetDeclIdMap()->Remove((void*)(oldcl->fClassInfo));
    }
@@ -1450,7 +1535,7 @@ void TClass::Init(const char *name, Version_t cversion,
 
    Bool_t isStl = TClassEdit::IsSTLCont(fName);
 
-   if (!gInterpreter)
+   if (!ROOT::Internal::IsInterpreterDeferred() && !gInterpreter)
       ::Fatal("TClass::Init", "gInterpreter not initialized");
 
    if (givenInfo) {
@@ -1500,7 +1585,10 @@ void TClass::Init(const char *name, Version_t cversion,
          if (proto)
             proto->FillTClass(this);
       }
-      if (!fHasRootPcmInfo && gInterpreter->CheckClassInfo(fName, /* autoload = */ kTRUE)) {
+      // If the creation of the interpreter is deferred, the info of a class with a dictionary is only looked up
+      // when needed (fCanLoadClassInfo), e.g. to build a TStreamerInfo without rootpcm information.
+      const bool deferClassInfo = fState == kHasTClassInit && ROOT::Internal::IsInterpreterDeferred();
+      if (!fHasRootPcmInfo && !deferClassInfo && gInterpreter->CheckClassInfo(fName, /* autoload = */ kTRUE)) {
          gInterpreter->SetClassInfo(this);   // sets fClassInfo pointer
          if (fClassInfo) {
             // This should be moved out of GetCheckSum itself however the last time
@@ -1705,7 +1793,8 @@ TClass::~TClass()
    if (fDeclFileLine >= -1)
       TClass::RemoveClass(this);
 
-   gCling->ClassInfo_Delete(fClassInfo);
+   if (fClassInfo)
+      gCling->ClassInfo_Delete(fClassInfo);
    fClassInfo=nullptr;
 
    if (fClassMenuList)
@@ -2967,6 +3056,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 
    if (!gROOT->GetListOfClasses())  return nullptr;
 
+   // Classes found before are returned without taking any lock.
+   if (TClass *cached = gClassLookupCache.Find(name))
+      return cached;
+   const auto generation = gClassLookupCache.GetGeneration();
+
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
@@ -2974,7 +3068,8 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 
    // Early return to release the lock without having to execute the
    // long-ish normalization.
-   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return cl;
+   if (cl && cl->IsLoaded()) return gClassLookupCache.Insert(name, cl, generation);
+   if (cl && cl->TestBit(kUnloading)) return cl;
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -3209,12 +3304,17 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (!gROOT->GetListOfClasses())
       return nullptr;
 
+   // Classes found before are returned without taking any lock.
+   if (TClass *cached = gClassLookupCache.Find(typeinfo))
+      return cached;
+   const auto generation = gClassLookupCache.GetGeneration();
+
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    TClass* cl = GetIdMap()->Find(typeinfo.name());
 
-   if (cl && cl->IsLoaded()) return cl;
+   if (cl && cl->IsLoaded()) return gClassLookupCache.Insert(typeinfo, cl, generation);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -3261,10 +3361,10 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    }
 
    // try AutoLoading the typeinfo
-   int autoload_old = gCling->SetClassAutoLoading(1);
+   int autoload_old = gInterpreter->SetClassAutoLoading(1);
    if (!autoload_old) {
       // Re-disable, we just meant to test
-      gCling->SetClassAutoLoading(0);
+      gInterpreter->SetClassAutoLoading(0);
    }
    if (autoload_old && gInterpreter->AutoLoad(typeinfo,kTRUE)) {
       // Disable autoload to avoid potential infinite recursion
@@ -6276,13 +6376,15 @@ void TClass::SetUnloaded()
 
    // Make sure SetClassInfo, re-calculated the state.
    fState = kForwardDeclared;
+   // Now that the class is no longer loaded, it cannot be cached again
+   gClassLookupCache.Clear();
 
    delete fIsA; fIsA = nullptr;
    // Disable the autoloader while calling SetClassInfo, to prevent
    // the library from being reloaded!
    {
       TInterpreter::SuspendAutoLoadingRAII autoloadOff(gInterpreter);
-      TInterpreter::SuspendAutoParsing autoParseRaii(gCling);
+      TInterpreter::SuspendAutoParsing autoParseRaii(gInterpreter);
       gInterpreter->SetClassInfo(this,kTRUE);
    }
    fDeclFileName = nullptr;
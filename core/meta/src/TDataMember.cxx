@@ -333,7 +333,7 @@ TDataMember& TDataMember::operator=(const TDataMember& dm)
 TDataMember::~TDataMember()
 {
    delete [] fArrayMaxIndex;
-   gCling->DataMemberInfo_Delete(fInfo);
+   if (fInfo) gCling->DataMemberInfo_Delete(fInfo);
    delete fValueSetter;
    delete fValueGetter;
    if (fOptions) {
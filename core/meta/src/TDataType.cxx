@@ -71,7 +71,7 @@ TDataType::TDataType(const char *typenam) : fInfo(nullptr), fProperty(kIsFundame
 
 TDataType::TDataType(const TDataType& dt) :
   TDictionary(dt),
-  fInfo(gCling->TypedefInfo_FactoryCopy(dt.fInfo)),
+  fInfo(dt.fInfo ? gCling->TypedefInfo_FactoryCopy(dt.fInfo) : nullptr),
   fSize(dt.fSize),
   fType(dt.fType),
   fProperty(dt.fProperty),
@@ -87,8 +87,8 @@ TDataType& TDataType::operator=(const TDataType& dt)
 {
    if(this!=&dt) {
       TDictionary::operator=(dt);
-      gCling->TypedefInfo_Delete(fInfo);
-      fInfo=gCling->TypedefInfo_FactoryCopy(dt.fInfo);
+      if (fInfo) gCling->TypedefInfo_Delete(fInfo);
+      fInfo = dt.fInfo ? gCling->TypedefInfo_FactoryCopy(dt.fInfo) : nullptr;
       fSize=dt.fSize;
       fType=dt.fType;
       fProperty=dt.fProperty;
@@ -104,7 +104,7 @@ TDataType& TDataType::operator=(const TDataType& dt)
 
 TDataType::~TDataType()
 {
-   gCling->TypedefInfo_Delete(fInfo);
+   if (fInfo) gCling->TypedefInfo_Delete(fInfo);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,7 +62,8 @@ TEnum::TEnum(const char *name, DeclId_t declid, TClass *cls)
 
 TEnum::~TEnum()
 {
-   gInterpreter->ClassInfo_Delete(fInfo);
+   if (fInfo)
+      gInterpreter->ClassInfo_Delete(fInfo);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -85,7 +85,7 @@ TFunction& TFunction::operator=(const TFunction &rhs)
 TFunction::~TFunction()
 {
    R__LOCKGUARD(gInterpreterMutex);
-   gCling->MethodInfo_Delete(fInfo);
+   if (fInfo) gCling->MethodInfo_Delete(fInfo);
 
    if (fMethodArgs) fMethodArgs->Delete();
    delete fMethodArgs;
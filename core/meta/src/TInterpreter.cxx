@@ -62,6 +62,9 @@ TInterpreter *TInterpreter::Instance()
       if (!getROOT) {
          ::Fatal("TInterpreter::Instance","TROOT object is required before accessing a TInterpreter");
       }
+      // With Root.LazyInterpreter, this is the first use of the interpreter
+      if (!gInterpreterLocal && ROOT::Internal::IsInterpreterDeferred())
+         ROOT::Internal::InitDeferredInterpreter();
    }
    return gInterpreterLocal;
 }
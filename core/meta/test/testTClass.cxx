@@ -1,9 +1,13 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
 
 #include "gtest/gtest.h"
 
+#include <thread>
+#include <vector>
+
 TEST(TClass, DictCheck)
 {
    gInterpreter->ProcessLine(".L stlDictCheck.h+");
@@ -22,3 +26,30 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, ConcurrentLookup)
+{
+   auto named = TClass::GetClass("TNamed");
+   ASSERT_NE(named, nullptr);
+   EXPECT_EQ(TClass::GetClass(typeid(TNamed)), named);
+
+   std::vector<std::thread> threads;
+   std::vector<int> nWrong(4, 0);
+   for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&nWrong, named, t]() {
+         for (int i = 0; i < 10000; ++i) {
+            if (TClass::GetClass("TNamed") != named || TClass::GetClass(typeid(TNamed)) != named ||
+                TClass::GetClass("class TNamed") != named)
+               ++nWrong[t];
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   for (auto n : nWrong)
+      EXPECT_EQ(n, 0);
+
+   // classes that do not exist are not cached
+   EXPECT_EQ(TClass::GetClass("ConcurrentLookupNoSuchClass", kTRUE, kTRUE), nullptr);
+   EXPECT_EQ(TClass::GetClass("ConcurrentLookupNoSuchClass", kTRUE, kTRUE), nullptr);
+}
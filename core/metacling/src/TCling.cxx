@@ -1186,11 +1186,38 @@ static GlobalModuleIndex *loadGlobalModuleIndex(cling::Interpreter &interp)
    return GlobalIndex;
 }
 
+/// Fill the module name to pcm file map of the header search options with the pcm files of the prebuilt module
+/// paths, listing each directory once. The lookup of a prebuilt module otherwise stats `<dir>/<name>.pcm` in every
+/// prebuilt module path, for each of the hundreds of modules in the modulemaps, which is slow on network file systems.
+/// Modules found in the map are not looked up on disk again; pcm files created later, e.g. by ACLiC, are still found
+/// by the lookup through the prebuilt module paths.
+static void IndexPrebuiltModuleFiles(clang::HeaderSearchOptions &HSOpts)
+{
+   for (const std::string &Dir : HSOpts.PrebuiltModulePaths) {
+      llvm::SmallString<256> AbsDir(Dir);
+      llvm::sys::fs::make_absolute(AbsDir);
+      std::error_code EC;
+      for (llvm::sys::fs::directory_iterator DirIt(AbsDir, EC), DirEnd; DirIt != DirEnd && !EC;
+           DirIt.increment(EC)) {
+         llvm::StringRef FilePath = DirIt->path();
+         if (llvm::sys::path::extension(FilePath) != ".pcm")
+            continue;
+         const auto Type = DirIt->type();
+         if (Type != llvm::sys::fs::file_type::regular_file && Type != llvm::sys::fs::file_type::symlink_file)
+            continue;
+         // The first directory providing a module wins, as in HeaderSearch::getPrebuiltModuleFileName.
+         HSOpts.PrebuiltModuleFiles.emplace(llvm::sys::path::stem(FilePath).str(), FilePath.str());
+      }
+   }
+}
+
 static void RegisterCxxModules(cling::Interpreter &clingInterp)
 {
    if (!clingInterp.getCI()->getLangOpts().Modules)
       return;
 
+   IndexPrebuiltModuleFiles(clingInterp.getCI()->getHeaderSearchOpts());
+
    // Loading of a module might deserialize.
    cling::Interpreter::PushTransactionRAII deserRAII(&clingInterp);
 
@@ -3092,7 +3119,8 @@ static Bool_t s_IsLibraryLoaded(const char* libname, cling::Interpreter* fInterp
 
 Bool_t TCling::IsLibraryLoaded(const char* libname) const
 {
-   R__LOCKGUARD(gInterpreterMutex);
+   // The list of loaded libraries is only modified by Load(), under the write lock.
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
    return s_IsLibraryLoaded(libname, GetInterpreterImpl());
 }
 
@@ -6159,8 +6187,10 @@ Int_t TCling::AutoLoad(const char *cls, Bool_t knowDictNotLoaded /* = kFALSE */)
 
    assert(IsClassAutoLoadingEnabled() && "Calling when AutoLoading is off!");
 
-   R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
+   // The dictionaries are only registered while loading a library, under the
+   // write lock: the common case of a class whose dictionary is already known
+   // (e.g. TClass::GetClass from several I/O threads) is answered with the
+   // read lock only, concurrently with other readers.
    if (!knowDictNotLoaded && gClassTable->GetDictNorm(cls)) {
       // The library is already loaded as the class's dictionary is known.
       // Return success.
@@ -6171,6 +6201,8 @@ Int_t TCling::AutoLoad(const char *cls, Bool_t knowDictNotLoaded /* = kFALSE */)
       return 1;
    }
 
+   R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
    if (gDebug > 2) {
       Info("TCling::AutoLoad",
            "Trying to autoload for %s", cls);
@@ -7085,6 +7117,9 @@ const char* TCling::GetClassSharedLibs(const char* cls)
    if (!cls || !*cls) {
       return 0;
    }
+   // The rootmap entries are only modified by (Un)LoadLibraryMap() and
+   // SetClassSharedLibs(), under the write lock.
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
    // lookup class to find list of libraries
    if (fMapfile) {
       TEnvRec* libs_record = 0;
@@ -7276,6 +7311,7 @@ const char* TCling::GetSharedLibDeps(const char* lib, bool useDyld/* = false*/)
       }
    }
 
+   R__READ_LOCKGUARD(ROOT::gCoreMutex);
    if (!fMapfile || !lib || !lib[0]) {
       return 0;
    }
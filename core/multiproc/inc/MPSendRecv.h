@@ -53,6 +53,9 @@ int MPSend(TSocket *s, unsigned code, T obj);
 
 MPCodeBufPair MPRecv(TSocket *s);
 
+// Sends a code and a serialized object, through shared memory if the object is large
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf);
+
 
 //this version reads classes from the message
 template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
@@ -98,11 +101,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    }
    TBufferFile objBuf(TBuffer::kWrite);
    objBuf.WriteObjectAny(&obj, c);
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \cond
@@ -138,13 +137,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    if(obj != nullptr)
       objBuf.WriteObjectAny(obj, obj->IsA());
 
-   //write everything together in a buffer
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \endcond
@@ -11,9 +11,134 @@
  
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
+#include "TEnv.h"
 #include "MPCode.h"
 #include <memory> //unique_ptr
 
+#include <cerrno>
+#include <cstring> //memcpy
+#include <sys/mman.h> //memfd_create, mmap
+#include <sys/socket.h> //sendmsg, recvmsg
+#include <unistd.h> //write, close
+
+namespace {
+
+// Flag in the size field of a message whose object is passed in a shared memory
+// segment: the file descriptor of the segment follows the header as ancillary data
+constexpr ULong64_t kSharedMemoryFlag = 1ULL << 63;
+
+#ifdef MFD_CLOEXEC
+////////////////////////////////////////////////////////////////////////////////
+/// Minimal size of the objects sent through shared memory instead of through the
+/// socket, from MultiProc.SharedMemoryThreshold, a negative value disables shared memory.
+
+Long64_t GetSharedMemoryThreshold()
+{
+   static const Long64_t threshold = gEnv->GetValue("MultiProc.SharedMemoryThreshold", 1024 * 1024);
+   return threshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an anonymous shared memory segment holding the buffer, -1 on failure
+
+int CreateSharedMemory(const char *buf, std::size_t len)
+{
+   int fd = memfd_create("MPSend", MFD_CLOEXEC);
+   if (fd < 0)
+      return -1;
+   std::size_t done = 0;
+   while (done < len) {
+      ssize_t n = write(fd, buf + done, len - done);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0) {
+         close(fd);
+         return -1;
+      }
+      done += n;
+   }
+   return fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send the file descriptor fd over the UNIX socket sock, attached to one byte of data
+
+bool SendFileDescriptor(int sock, int fd)
+{
+   char byte = 0;
+   iovec iov;
+   iov.iov_base = &byte;
+   iov.iov_len = 1;
+   char control[CMSG_SPACE(sizeof(int))];
+   memset(control, 0, sizeof(control));
+   msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = &iov;
+   msg.msg_iovlen = 1;
+   msg.msg_control = control;
+   msg.msg_controllen = sizeof(control);
+   cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+   cmsg->cmsg_level = SOL_SOCKET;
+   cmsg->cmsg_type = SCM_RIGHTS;
+   cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+   memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+   ssize_t n;
+   do {
+      n = sendmsg(sock, &msg, 0);
+   } while (n < 0 && errno == EINTR);
+   return n == 1;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Receive a file descriptor sent by SendFileDescriptor(), -1 on failure
+
+int RecvFileDescriptor(int sock)
+{
+   char byte;
+   iovec iov;
+   iov.iov_base = &byte;
+   iov.iov_len = 1;
+   char control[CMSG_SPACE(sizeof(int))];
+   msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = &iov;
+   msg.msg_iovlen = 1;
+   msg.msg_control = control;
+   msg.msg_controllen = sizeof(control);
+
+   ssize_t n;
+   do {
+      n = recvmsg(sock, &msg, 0);
+   } while (n < 0 && errno == EINTR);
+   if (n != 1)
+      return -1;
+   cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+   if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+      return -1;
+   int fd;
+   memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+   return fd;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// A TBufferFile reading from a mapped shared memory segment, unmapped at destruction
+
+class TMPSharedMemoryBuffer : public TBufferFile {
+   void *fAddr;
+   std::size_t fLen;
+
+public:
+   TMPSharedMemoryBuffer(void *addr, std::size_t len)
+      : TBufferFile(TBuffer::kRead, len, addr, false), fAddr(addr), fLen(len)
+   {
+   }
+   ~TMPSharedMemoryBuffer() { munmap(fAddr, fLen); }
+};
+
+} // anonymous namespace
+
 //////////////////////////////////////////////////////////////////////////
 /// Send a message with the specified code on the specified socket.
 /// This standalone function can be used to send a code
@@ -38,6 +163,43 @@ int MPSend(TSocket *s, unsigned code)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+/// Send a message with a code and a serialized object to socket s.
+/// Objects of at least MultiProc.SharedMemoryThreshold bytes (1 MB by default)
+/// are written to an anonymous shared memory segment (Linux only) of which only
+/// the file descriptor is passed over the socket, so that MPRecv() reads them
+/// from the mapped segment instead of copying them through the socket.
+/// \param s a pointer to a valid UNIX TSocket. No validity checks are performed\n
+/// \param code the code to be sent
+/// \param objBuf the serialized object, empty if the message has no object
+/// \return the number of bytes sent, as per TSocket::SendRaw, or -1 on failure
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf)
+{
+   TBufferFile wBuf(TBuffer::kWrite);
+   wBuf.WriteUInt(code);
+
+#ifdef MFD_CLOEXEC
+   const auto threshold = GetSharedMemoryThreshold();
+   if (threshold >= 0 && objBuf.Length() > 0 && objBuf.Length() >= threshold) {
+      int fd = CreateSharedMemory(objBuf.Buffer(), objBuf.Length());
+      if (fd >= 0) {
+         wBuf.WriteULong(kSharedMemoryFlag | objBuf.Length());
+         int nBytes = s->SendRaw(wBuf.Buffer(), wBuf.Length());
+         bool sent = nBytes > 0 && SendFileDescriptor(s->GetDescriptor(), fd);
+         close(fd); // the receiver has its own descriptor
+         return sent ? nBytes + 1 : -1;
+      }
+      // fall back to sending the object through the socket
+   }
+#endif
+
+   wBuf.WriteULong(objBuf.Length());
+   if (objBuf.Length())
+      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
+   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 /// Receive message from a socket.
 /// This standalone function can be used to read a message that
@@ -76,7 +238,23 @@ MPCodeBufPair MPRecv(TSocket *s)
 
    //receive object if needed
    std::unique_ptr<TBufferFile> objBuf; //defaults to nullptr
-   if (classBufSize != 0) {
+   if ((ULong64_t)classBufSize & kSharedMemoryFlag) {
+      //the object is in a shared memory segment, read it from where it is mapped
+      const std::size_t len = (ULong64_t)classBufSize & ~kSharedMemoryFlag;
+      int fd = RecvFileDescriptor(s->GetDescriptor());
+      if (fd < 0) {
+         Error("MPRecv", "[E] Could not receive the shared memory segment of the message\n");
+         return std::make_pair(MPCode::kRecvError, nullptr);
+      }
+      //private copy-on-write mapping: TBufferFile does not write while reading but expects a char*
+      void *addr = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (addr == MAP_FAILED) {
+         Error("MPRecv", "[E] Could not map the shared memory segment of the message, errno %d\n", errno);
+         return std::make_pair(MPCode::kRecvError, nullptr);
+      }
+      objBuf.reset(new TMPSharedMemoryBuffer(addr, len));
+   } else if (classBufSize != 0) {
       char *classBuf = new char[classBufSize];
       s->RecvRaw(classBuf, classBufSize);
       objBuf.reset(new TBufferFile(TBuffer::kRead, classBufSize, classBuf, true)); //the buffer is deleted by TBuffer's dtor
@@ -0,0 +1,68 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TLockProfiler
+#define ROOT_TLockProfiler
+
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+/**
+\class ROOT::TLockProfiler
+\ingroup Parallelism
+\brief Contention statistics of ROOT's global locks.
+
+If `Root.CoreMutex.Profile: true` is set in the .rootrc, or the environment variable ROOT_CORE_MUTEX_PROFILE is
+defined, ROOT::EnableThreadSafety() installs instrumented versions of ROOT::gCoreMutex, gInterpreterMutex,
+gROOTMutex, gGlobalMutex and of the mutexes created by R__LOCKGUARD2(). They record for each lock how often it
+was taken, how long the threads waited for it and which functions took it. The statistics are printed when the
+process exits and can be queried meanwhile with GetReport() and Print().
+
+gInterpreterMutex and gROOTMutex share the lock of ROOT::gCoreMutex, they only get separate statistics. All
+mutexes created by R__LOCKGUARD2() are accounted together under "R__LOCKGUARD2", their call sites tell them apart.
+
+The instrumentation costs two clock readings per lock and is not meant for production.
+*/
+class TLockProfiler {
+public:
+   /// Statistics of the locks taken by one function
+   struct RCallSite {
+      std::string fFunction;      ///< Calling function, or its address if it cannot be resolved
+      ULong64_t fNLocks = 0;      ///< Number of locks taken
+      ULong64_t fWaitTimeNs = 0;  ///< Total time waited for the lock
+   };
+
+   /// Statistics of one lock
+   struct RLockReport {
+      std::string fName;
+      ULong64_t fNReadLocks = 0;
+      ULong64_t fNWriteLocks = 0;
+      ULong64_t fNContended = 0;  ///< Number of locks that waited longer than kContendedNs
+      ULong64_t fWaitTimeNs = 0;  ///< Total time waited for the lock
+      ULong64_t fMaxWaitTimeNs = 0;
+      std::vector<RCallSite> fCallSites; ///< Sorted by decreasing wait time
+   };
+
+   /// A lock waiting longer than this is counted as contended
+   static constexpr ULong64_t kContendedNs = 1000;
+
+   static Bool_t IsEnabled();
+   static std::vector<RLockReport> GetReport();
+   static void Print(Int_t nCallSites = 10);
+   static void Reset();
+};
+
+} // namespace ROOT
+
+#endif
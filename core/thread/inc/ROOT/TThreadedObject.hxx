@@ -20,6 +20,7 @@
 
 
 #include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <deque>
 #include <functional>
@@ -110,6 +111,32 @@ namespace ROOT {
             static TDirectory *Create() { return nullptr; }
          };
 
+         /// Per-thread cache of the slots used by the current thread, indexed by the identifier of the
+         /// TThreadedObject modulo kSize. Identifiers are never reused, so an entry can never refer to
+         /// the slot of another (e.g. deleted) object; a collision only costs a lookup under the lock.
+         struct RSlotCache {
+            static constexpr unsigned kSize = 64;
+            struct REntry {
+               std::uint64_t fId = 0;    ///< Identifier of the TThreadedObject, 0 if the entry is empty
+               void *fSlotPtr = nullptr; ///< Address of the std::shared_ptr<T> of the slot
+            };
+            REntry fEntries[kSize];
+         };
+
+         /// Return a new identifier for a TThreadedObject, identifiers start at 1
+         std::uint64_t GetNewObjectId();
+
+         /// Return the slot cache of the calling thread
+         RSlotCache &GetThreadSlotCache();
+
+         /// Return the number of groups in which nObjs objects are merged in parallel, 1 if
+         /// implicit multi-threading is disabled or if there are too few objects
+         unsigned GetNMergeGroups(std::size_t nObjs);
+
+         /// Call func(i) for i in [0, nTimes), in ROOT's thread pool if implicit multi-threading
+         /// is enabled, sequentially otherwise
+         void ParallelForEach(const std::function<void(unsigned)> &func, unsigned nTimes);
+
       } // End of namespace TThreadedObjectUtils
    } // End of namespace Internal
 
@@ -119,15 +146,41 @@ namespace ROOT {
       using MergeFunctionType = std::function<void(std::shared_ptr<T>, std::vector<std::shared_ptr<T>>&)>;
 
       /// Merge TObjects
+      ///
+      /// If implicit multi-threading is enabled and there are enough objects, they are first merged
+      /// in groups in parallel, each group into a copy of its first object, and the partial results
+      /// are then merged into the target. The objects to be merged are not modified.
       template<class T>
       void MergeTObjects(std::shared_ptr<T> target, std::vector<std::shared_ptr<T>> &objs)
       {
          if (!target) return;
-         TList objTList;
-         // Cannot do better than this
-         for (auto obj : objs) {
-            if (obj && obj != target) objTList.Add(obj.get());
+         std::vector<T *> toMerge;
+         for (auto &obj : objs) {
+            if (obj && obj != target) toMerge.push_back(obj.get());
+         }
+
+         std::vector<std::unique_ptr<T>> partials;
+         const auto nGroups = Internal::TThreadedObjectUtils::GetNMergeGroups(toMerge.size());
+         if (nGroups > 1) {
+            partials.resize(nGroups);
+            auto mergeGroup = [&](unsigned g) {
+               const auto begin = g * toMerge.size() / nGroups;
+               const auto end = (g + 1) * toMerge.size() / nGroups;
+               partials[g].reset(Internal::TThreadedObjectUtils::Cloner<T>::Clone(toMerge[begin]));
+               TList groupTList;
+               for (auto i = begin + 1; i < end; ++i)
+                  groupTList.Add(toMerge[i]);
+               partials[g]->Merge(&groupTList);
+            };
+            Internal::TThreadedObjectUtils::ParallelForEach(mergeGroup, nGroups);
+            toMerge.clear();
+            for (auto &partial : partials)
+               toMerge.push_back(partial.get());
          }
+
+         TList objTList;
+         for (auto obj : toMerge)
+            objTList.Add(obj);
          target->Merge(&objTList);
       }
    } // end of namespace TThreadedObjectUtils
@@ -263,7 +316,8 @@ namespace ROOT {
 
       /// Access the pointer corresponding to the current slot. This method is
       /// not adequate for being called inside tight loops as it implies a
-      /// lookup in a mapping between the threadIDs and the slot indices.
+      /// lookup of the slot of the calling thread: it does not lock once the
+      /// thread used the object, but is still slower than a pointer on the stack.
       /// A good practice consists in copying the pointer onto the stack and
       /// proceed with the loop as shown in this work item (psudo-code) which
       /// will be sent to different threads:
@@ -278,7 +332,14 @@ namespace ROOT {
       /// ~~~
       std::shared_ptr<T> Get()
       {
-         return GetAtSlot(GetThisSlotNumber());
+         using Internal::TThreadedObjectUtils::RSlotCache;
+         auto &entry = Internal::TThreadedObjectUtils::GetThreadSlotCache().fEntries[fId % RSlotCache::kSize];
+         if (entry.fId == fId) {
+            auto &objPointer = *static_cast<std::shared_ptr<T> *>(entry.fSlotPtr);
+            if (objPointer)
+               return objPointer;
+         }
+         return GetThisSlot(entry);
       }
 
       /// Access the wrapped object and allow to call its methods.
@@ -331,8 +392,29 @@ namespace ROOT {
       std::deque<TDirectory*> fDirectories;              ///< A TDirectory per slot
       std::map<std::thread::id, unsigned> fThrIDSlotMap; ///< A mapping between the thread IDs and the slots
       mutable ROOT::TSpinMutex fSpinMutex;               ///< Protects concurrent access to fThrIDSlotMap, fObjPointers
+      const std::uint64_t fId = Internal::TThreadedObjectUtils::GetNewObjectId(); ///< Key in the threads' slot caches
       bool fIsMerged : 1;                                ///< Remember if the objects have been merged already
 
+      /// Get the object of the slot of this thread, creating slot and object if needed, and store the
+      /// slot in the thread's cache entry. The elements of a std::deque do not move when it grows, so
+      /// the cached address stays valid for the lifetime of the TThreadedObject.
+      std::shared_ptr<T> GetThisSlot(Internal::TThreadedObjectUtils::RSlotCache::REntry &entry)
+      {
+         const auto i = GetThisSlotNumber();
+         std::shared_ptr<T> *objPointer;
+         TDirectory *dir;
+         {
+            std::lock_guard<ROOT::TSpinMutex> lg(fSpinMutex);
+            objPointer = &fObjPointers[i];
+            dir = fDirectories[i];
+         }
+         if (!*objPointer)
+            objPointer->reset(Internal::TThreadedObjectUtils::Cloner<T>::Clone(fModel.get(), dir));
+         entry.fId = fId;
+         entry.fSlotPtr = objPointer;
+         return *objPointer;
+      }
+
       /// Get the slot number for this threadID, make a slot if needed
       unsigned GetThisSlotNumber()
       {
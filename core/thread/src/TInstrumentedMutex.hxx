@@ -0,0 +1,73 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TInstrumentedMutex
+#define ROOT_TInstrumentedMutex
+
+#include "TVirtualRWMutex.h"
+
+namespace ROOT {
+namespace Internal {
+
+struct TLockStats;
+
+/// Returns the statistics registered under `name`, creating them if needed
+TLockStats *GetLockStats(const char *name);
+
+/// Lets ROOT::TLockProfiler::IsEnabled() return true and prints the statistics at exit
+void EnableLockProfiler();
+
+/// Mutex recording the statistics of the locks taken on another mutex, see ROOT::TLockProfiler.
+class TInstrumentedMutex final : public TVirtualMutex {
+   TVirtualMutex *fMutex;
+   TLockStats *fStats;
+   bool fOwnsMutex;
+
+public:
+   TInstrumentedMutex(TVirtualMutex *mutex, TLockStats *stats, bool ownsMutex);
+   ~TInstrumentedMutex();
+
+   Int_t Lock() override;
+   Int_t TryLock() override;
+   Int_t UnLock() override;
+   Int_t CleanUp() override;
+
+   /// Creates an instrumented mutex accounted under "R__LOCKGUARD2"
+   TVirtualMutex *Factory(Bool_t recursive = kFALSE) override;
+};
+
+/// Read-write mutex recording the statistics of the locks taken on another one, see ROOT::TLockProfiler.
+class TInstrumentedRWMutex final : public TVirtualRWMutex {
+   TVirtualRWMutex *fMutex;
+   TLockStats *fStats;
+   bool fOwnsMutex;
+
+public:
+   TInstrumentedRWMutex(TVirtualRWMutex *mutex, TLockStats *stats, bool ownsMutex)
+      : fMutex(mutex), fStats(stats), fOwnsMutex(ownsMutex)
+   {
+   }
+   ~TInstrumentedRWMutex();
+
+   Hint_t *ReadLock() override;
+   void ReadUnLock(Hint_t *) override;
+   Hint_t *WriteLock() override;
+   void WriteUnLock(Hint_t *) override;
+
+   TVirtualRWMutex *Factory(Bool_t recursive = kFALSE) override;
+   std::unique_ptr<State> GetStateBefore() override;
+   std::unique_ptr<StateDelta> Rewind(const State &earlierState) override;
+   void Apply(std::unique_ptr<StateDelta> &&delta) override;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
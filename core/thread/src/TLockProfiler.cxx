@@ -0,0 +1,381 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::Internal::TInstrumentedMutex
+\brief Forwards the locks to another mutex and records them in a TLockStats.
+
+The statistics are updated with relaxed atomic operations, the call sites are kept in a fixed size open addressing
+table keyed by the return address of the locking function, which is filled without locks. Call sites which do not
+fit into the table are accounted together. Addresses are only resolved to function names by the report.
+*/
+
+#include "ROOT/TLockProfiler.hxx"
+#include "TInstrumentedMutex.hxx"
+
+#include "TClassEdit.h"
+#include "TString.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#ifndef _MSC_VER
+#include <dlfcn.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define R__CALLER_ADDRESS() __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define R__CALLER_ADDRESS() _ReturnAddress()
+#else
+#define R__CALLER_ADDRESS() nullptr
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+struct TLockStats {
+   struct RSite {
+      std::atomic<const void *> fAddress{nullptr};
+      std::atomic<ULong64_t> fNLocks{0};
+      std::atomic<ULong64_t> fWaitTimeNs{0};
+   };
+
+   /// Size of the call site table, a power of 2
+   static constexpr std::size_t kNSites = 1024;
+   /// Number of table slots tried before a call site is accounted with the others
+   static constexpr std::size_t kMaxProbes = 16;
+
+   const std::string fName;
+   std::atomic<ULong64_t> fNReadLocks{0};
+   std::atomic<ULong64_t> fNWriteLocks{0};
+   std::atomic<ULong64_t> fNContended{0};
+   std::atomic<ULong64_t> fWaitTimeNs{0};
+   std::atomic<ULong64_t> fMaxWaitTimeNs{0};
+   RSite fSites[kNSites];
+   /// Call sites which found no free slot in fSites
+   RSite fOtherSites;
+
+   explicit TLockStats(const std::string &name) : fName(name) {}
+
+   RSite &FindSite(const void *address)
+   {
+      auto hash = reinterpret_cast<std::uintptr_t>(address) >> 4;
+      for (std::size_t i = 0; i < kMaxProbes; ++i) {
+         auto &site = fSites[(hash + i) & (kNSites - 1)];
+         const void *current = site.fAddress.load(std::memory_order_relaxed);
+         if (current == address)
+            return site;
+         if (!current) {
+            if (site.fAddress.compare_exchange_strong(current, address, std::memory_order_relaxed) ||
+                current == address)
+               return site;
+         }
+      }
+      return fOtherSites;
+   }
+
+   void Record(const void *caller, ULong64_t waitNs, bool isWrite)
+   {
+      (isWrite ? fNWriteLocks : fNReadLocks).fetch_add(1, std::memory_order_relaxed);
+      fWaitTimeNs.fetch_add(waitNs, std::memory_order_relaxed);
+      if (waitNs > ROOT::TLockProfiler::kContendedNs)
+         fNContended.fetch_add(1, std::memory_order_relaxed);
+      auto max = fMaxWaitTimeNs.load(std::memory_order_relaxed);
+      while (waitNs > max && !fMaxWaitTimeNs.compare_exchange_weak(max, waitNs, std::memory_order_relaxed))
+         ;
+
+      auto &site = FindSite(caller);
+      site.fNLocks.fetch_add(1, std::memory_order_relaxed);
+      site.fWaitTimeNs.fetch_add(waitNs, std::memory_order_relaxed);
+   }
+
+   void Reset()
+   {
+      fNReadLocks = 0;
+      fNWriteLocks = 0;
+      fNContended = 0;
+      fWaitTimeNs = 0;
+      fMaxWaitTimeNs = 0;
+      // Keep the addresses, concurrent lockers may have picked their slot already
+      for (auto &site : fSites) {
+         site.fNLocks = 0;
+         site.fWaitTimeNs = 0;
+      }
+      fOtherSites.fNLocks = 0;
+      fOtherSites.fWaitTimeNs = 0;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+namespace {
+
+using Clock_t = std::chrono::steady_clock;
+
+ULong64_t NsSince(Clock_t::time_point start)
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - start).count();
+}
+
+struct RLockStatsRegistry {
+   std::mutex fMutex;
+   std::vector<std::unique_ptr<ROOT::Internal::TLockStats>> fStats;
+};
+
+RLockStatsRegistry &GetRegistry()
+{
+   // Never destructed: the instrumented global mutexes can be used until the very end of the process
+   static auto registry = new RLockStatsRegistry;
+   return *registry;
+}
+
+std::atomic<bool> gLockProfilerEnabled{false};
+
+/// Name of the function containing `address`
+std::string GetFunctionName(const void *address)
+{
+#ifndef _MSC_VER
+   Dl_info info;
+   if (dladdr(address, &info) && info.dli_sname) {
+      int errorCode = 0;
+      char *demangled = TClassEdit::DemangleName(info.dli_sname, errorCode);
+      std::string name = (demangled && !errorCode) ? demangled : info.dli_sname;
+      free(demangled);
+      return name;
+   }
+   if (info.dli_fname)
+      return TString::Format("%p (%s)", address, info.dli_fname).Data();
+#endif
+   return TString::Format("%p", address).Data();
+}
+
+void PrintAtExit()
+{
+   ROOT::TLockProfiler::Print();
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+TLockStats *GetLockStats(const char *name)
+{
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   for (auto &stats : registry.fStats) {
+      if (stats->fName == name)
+         return stats.get();
+   }
+   registry.fStats.emplace_back(new TLockStats(name));
+   return registry.fStats.back().get();
+}
+
+void EnableLockProfiler()
+{
+   if (!gLockProfilerEnabled.exchange(true))
+      atexit(PrintAtExit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Instrument `mutex`, which is deleted together with this object if `ownsMutex` is set
+
+TInstrumentedMutex::TInstrumentedMutex(TVirtualMutex *mutex, TLockStats *stats, bool ownsMutex)
+   : fMutex(mutex), fStats(stats), fOwnsMutex(ownsMutex)
+{
+}
+
+TInstrumentedMutex::~TInstrumentedMutex()
+{
+   if (fOwnsMutex)
+      delete fMutex;
+}
+
+Int_t TInstrumentedMutex::Lock()
+{
+   const void *caller = R__CALLER_ADDRESS();
+   auto start = Clock_t::now();
+   auto result = fMutex->Lock();
+   fStats->Record(caller, NsSince(start), true);
+   return result;
+}
+
+Int_t TInstrumentedMutex::TryLock()
+{
+   const void *caller = R__CALLER_ADDRESS();
+   auto start = Clock_t::now();
+   auto result = fMutex->TryLock();
+   if (result == 0)
+      fStats->Record(caller, NsSince(start), true);
+   return result;
+}
+
+Int_t TInstrumentedMutex::UnLock()
+{
+   return fMutex->UnLock();
+}
+
+Int_t TInstrumentedMutex::CleanUp()
+{
+   return fMutex->CleanUp();
+}
+
+TVirtualMutex *TInstrumentedMutex::Factory(Bool_t recursive)
+{
+   return new TInstrumentedMutex(fMutex->Factory(recursive), GetLockStats("R__LOCKGUARD2"), true);
+}
+
+TInstrumentedRWMutex::~TInstrumentedRWMutex()
+{
+   if (fOwnsMutex)
+      delete fMutex;
+}
+
+TVirtualRWMutex::Hint_t *TInstrumentedRWMutex::ReadLock()
+{
+   const void *caller = R__CALLER_ADDRESS();
+   auto start = Clock_t::now();
+   auto hint = fMutex->ReadLock();
+   fStats->Record(caller, NsSince(start), false);
+   return hint;
+}
+
+void TInstrumentedRWMutex::ReadUnLock(Hint_t *hint)
+{
+   fMutex->ReadUnLock(hint);
+}
+
+TVirtualRWMutex::Hint_t *TInstrumentedRWMutex::WriteLock()
+{
+   const void *caller = R__CALLER_ADDRESS();
+   auto start = Clock_t::now();
+   auto hint = fMutex->WriteLock();
+   fStats->Record(caller, NsSince(start), true);
+   return hint;
+}
+
+void TInstrumentedRWMutex::WriteUnLock(Hint_t *hint)
+{
+   fMutex->WriteUnLock(hint);
+}
+
+TVirtualRWMutex *TInstrumentedRWMutex::Factory(Bool_t recursive)
+{
+   return new TInstrumentedRWMutex(fMutex->Factory(recursive), GetLockStats("R__LOCKGUARD2"), true);
+}
+
+std::unique_ptr<TVirtualRWMutex::State> TInstrumentedRWMutex::GetStateBefore()
+{
+   return fMutex->GetStateBefore();
+}
+
+std::unique_ptr<TVirtualRWMutex::StateDelta> TInstrumentedRWMutex::Rewind(const State &earlierState)
+{
+   return fMutex->Rewind(earlierState);
+}
+
+void TInstrumentedRWMutex::Apply(std::unique_ptr<StateDelta> &&delta)
+{
+   fMutex->Apply(std::move(delta));
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether ROOT's global locks are instrumented
+
+Bool_t ROOT::TLockProfiler::IsEnabled()
+{
+   return gLockProfilerEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the statistics of all instrumented locks taken so far
+
+std::vector<ROOT::TLockProfiler::RLockReport> ROOT::TLockProfiler::GetReport()
+{
+   std::vector<RLockReport> reports;
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   for (auto &stats : registry.fStats) {
+      RLockReport report;
+      report.fName = stats->fName;
+      report.fNReadLocks = stats->fNReadLocks;
+      report.fNWriteLocks = stats->fNWriteLocks;
+      report.fNContended = stats->fNContended;
+      report.fWaitTimeNs = stats->fWaitTimeNs;
+      report.fMaxWaitTimeNs = stats->fMaxWaitTimeNs;
+
+      // Several return addresses belong to the same function
+      std::map<std::string, RCallSite> sites;
+      auto add = [&sites](const std::string &function, const Internal::TLockStats::RSite &site) {
+         auto &callSite = sites[function];
+         callSite.fFunction = function;
+         callSite.fNLocks += site.fNLocks;
+         callSite.fWaitTimeNs += site.fWaitTimeNs;
+      };
+      for (auto &site : stats->fSites) {
+         const void *address = site.fAddress;
+         if (address && site.fNLocks)
+            add(GetFunctionName(address), site);
+      }
+      if (stats->fOtherSites.fNLocks)
+         add("(other call sites)", stats->fOtherSites);
+
+      for (auto &entry : sites)
+         report.fCallSites.emplace_back(std::move(entry.second));
+      std::sort(report.fCallSites.begin(), report.fCallSites.end(), [](const RCallSite &a, const RCallSite &b) {
+         return a.fWaitTimeNs != b.fWaitTimeNs ? a.fWaitTimeNs > b.fWaitTimeNs : a.fNLocks > b.fNLocks;
+      });
+      reports.emplace_back(std::move(report));
+   }
+   return reports;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the statistics of all instrumented locks, with the `nCallSites` call sites which waited longest
+
+void ROOT::TLockProfiler::Print(Int_t nCallSites)
+{
+   for (const auto &report : GetReport()) {
+      if (report.fNReadLocks + report.fNWriteLocks == 0)
+         continue;
+      Printf("Lock %s: %llu read locks, %llu write locks, %llu contended, waited %.3f ms (max %.3f ms)",
+             report.fName.c_str(), report.fNReadLocks, report.fNWriteLocks, report.fNContended,
+             report.fWaitTimeNs * 1e-6, report.fMaxWaitTimeNs * 1e-6);
+      Int_t n = 0;
+      for (const auto &site : report.fCallSites) {
+         if (n++ == nCallSites)
+            break;
+         Printf("   %12llu locks, waited %10.3f ms   %s", site.fNLocks, site.fWaitTimeNs * 1e-6,
+                site.fFunction.c_str());
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clear the statistics of all instrumented locks
+
+void ROOT::TLockProfiler::Reset()
+{
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   for (auto &stats : registry.fStats)
+      stats->Reset();
+}
@@ -119,4 +119,69 @@ template class TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBB>;
 template class TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>;
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Take the Read Lock of the mutex.
+
+TVirtualRWMutex::Hint_t *TReaderBiasedRWMutexImp::ReadLock()
+{
+   return fMutexImp.ReadLock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take the Write Lock of the mutex.
+
+TVirtualRWMutex::Hint_t *TReaderBiasedRWMutexImp::WriteLock()
+{
+   return fMutexImp.WriteLock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the read lock of the mutex
+
+void TReaderBiasedRWMutexImp::ReadUnLock(TVirtualRWMutex::Hint_t *hint)
+{
+   fMutexImp.ReadUnLock(hint);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the write lock of the mutex
+
+void TReaderBiasedRWMutexImp::WriteUnLock(TVirtualRWMutex::Hint_t *hint)
+{
+   fMutexImp.WriteUnLock(hint);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create mutex and return pointer to it.
+
+TVirtualRWMutex *TReaderBiasedRWMutexImp::Factory(Bool_t /*recursive = kFALSE*/)
+{
+   return new TReaderBiasedRWMutexImp();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restore the mutex state to `state`, see TRWMutexImp::Rewind().
+
+std::unique_ptr<TVirtualRWMutex::StateDelta> TReaderBiasedRWMutexImp::Rewind(const TVirtualRWMutex::State &earlierState)
+{
+   return fMutexImp.Rewind(earlierState);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Apply the mutex state delta.
+
+void TReaderBiasedRWMutexImp::Apply(std::unique_ptr<TVirtualRWMutex::StateDelta> &&delta)
+{
+   fMutexImp.Apply(std::move(delta));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the mutex state *before* the current lock was taken. This function must
+/// only be called while the mutex is locked.
+
+std::unique_ptr<TVirtualRWMutex::State> TReaderBiasedRWMutexImp::GetStateBefore()
+{
+   return fMutexImp.GetStateBefore();
+}
+
 } // End of namespace ROOT
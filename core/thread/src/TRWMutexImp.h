@@ -14,6 +14,7 @@
 #include "TVirtualRWMutex.h"
 #include "ROOT/TSpinMutex.hxx"
 #include "TReentrantRWLock.hxx"
+#include "TReaderBiasedRWLock.hxx"
 
 #include "TBuffer.h" // Needed by ClassDefInlineOverride
 
@@ -36,6 +37,23 @@ public:
    ClassDefInlineOverride(TRWMutexImp,0)  // Concrete RW mutex lock class
 };
 
+class TReaderBiasedRWMutexImp : public TVirtualRWMutex {
+   ROOT::TReaderBiasedRWLock fMutexImp;
+
+public:
+   Hint_t * ReadLock() override;
+   void ReadUnLock(Hint_t *) override;
+   Hint_t * WriteLock() override;
+   void WriteUnLock(Hint_t *) override;
+
+   TVirtualRWMutex *Factory(Bool_t /*recursive*/ = kFALSE) override;
+   std::unique_ptr<State> GetStateBefore() override;
+   std::unique_ptr<StateDelta> Rewind(const State &earlierState) override;
+   void Apply(std::unique_ptr<StateDelta> &&delta) override;
+
+   ClassDefInlineOverride(TReaderBiasedRWMutexImp,0)  // RW mutex lock class with per-thread reader indicators
+};
+
 } // namespace ROOT.
 
 #endif
\ No newline at end of file
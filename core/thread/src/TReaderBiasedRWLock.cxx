@@ -0,0 +1,296 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::TReaderBiasedRWLock
+    \brief A reentrant read-write lock optimized for rare writers.
+
+Contrary to TReentrantRWLock, readers do not update any counter shared by
+all threads: each thread announces its read locks in its own indicator,
+on its own cache line, and only reads the shared writer flag. Taking and
+releasing a read lock thus does not bounce a cache line between the cores
+as long as there is no writer. The price is paid by the writers, which
+have to scan the indicators of all threads which have ever used the lock.
+
+A reader first sets its indicator and then checks the writer flag, while a
+writer first sets the flag and then scans the indicators: either the reader
+sees the writer and steps back, or the writer sees the reader and waits
+for it. Both stores and loads are sequentially consistent for this reason.
+
+The lock is reentrant as TReentrantRWLock: a reader can take the write
+lock, releasing its read locks for the time it waits for another writer,
+and a writer can take read locks.
+*/
+
+#include "TReaderBiasedRWLock.hxx"
+#include "TError.h"
+
+using namespace ROOT;
+
+namespace {
+struct TReaderBiasedRWLockState : public TVirtualRWMutex::State {
+   std::atomic<size_t> *fReadersCountLoc = nullptr;
+   size_t fReadersCount = 0;
+   size_t fWriteRecurse = 0;
+};
+
+struct TReaderBiasedRWLockStateDelta : public TVirtualRWMutex::StateDelta {
+   std::atomic<size_t> *fReadersCountLoc = nullptr;
+   int fDeltaReadersCount = 0;
+   int fDeltaWriteRecurse = 0;
+};
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////
+/// Return the indicator of the current thread, registering it at the first call.
+/// Must not be called with fMutex held.
+
+TReaderBiasedRWLock::LocalCounts *TReaderBiasedRWLock::GetLocal()
+{
+#ifdef R__HAS_TBB
+   auto &local = fLocal.local();
+   if (!local) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fLocals.emplace_back(new LocalCounts);
+      local = fLocals.back().get();
+   }
+   return local;
+#else
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto &local = fLocal[std::this_thread::get_id()];
+   if (!local) {
+      fLocals.emplace_back(new LocalCounts);
+      local = fLocals.back().get();
+   }
+   return local;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return true if no thread but the one of `local` holds read locks, not counting
+/// the threads waiting for the write lock. Must be called with fMutex held.
+
+bool TReaderBiasedRWLock::AreOtherReadersDone(const LocalCounts *local) const
+{
+   for (auto &other : fLocals) {
+      if (other.get() != local && !other->fUpgrading && other->fReadersCount.load() != 0)
+         return false;
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Acquire the lock in read mode.
+
+TVirtualRWMutex::Hint_t *TReaderBiasedRWLock::ReadLock()
+{
+   auto local = GetLocal();
+   auto hint = reinterpret_cast<TVirtualRWMutex::Hint_t *>(&local->fReadersCount);
+
+   const auto count = local->fReadersCount.load(std::memory_order_relaxed);
+   if (count > 0 || local->fIsWriter) {
+      // Re-entry: a writer waits for us anyway, don't wait for it
+      local->fReadersCount.store(count + 1);
+      return hint;
+   }
+
+   while (true) {
+      local->fReadersCount.store(1);
+      if (!fWriter.load())
+         return hint;
+
+      // A writer claimed the lock, step back and wait until it is done
+      local->fReadersCount.store(0);
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCond.notify_all(); // the writer might wait for our indicator
+      fCond.wait(lock, [this] { return !fWriter.load(); });
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Release the lock in read mode.
+
+void TReaderBiasedRWLock::ReadUnLock(TVirtualRWMutex::Hint_t *hint)
+{
+   std::atomic<size_t> *readersCount;
+   if (hint)
+      readersCount = reinterpret_cast<std::atomic<size_t> *>(hint);
+   else
+      readersCount = &GetLocal()->fReadersCount;
+
+   const auto count = readersCount->load(std::memory_order_relaxed) - 1;
+   readersCount->store(count);
+   if (count == 0 && fWriter.load()) {
+      // Make sure you wake up a writer waiting for the readers
+      std::lock_guard<std::mutex> lock(fMutex);
+      fCond.notify_all();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Acquire the lock in write mode.
+
+TVirtualRWMutex::Hint_t *TReaderBiasedRWLock::WriteLock()
+{
+   auto local = GetLocal();
+   auto hint = reinterpret_cast<TVirtualRWMutex::Hint_t *>(&local->fReadersCount);
+
+   std::unique_lock<std::mutex> lock(fMutex);
+
+   if (local->fIsWriter) {
+      ++fWriteRecurse;
+      return hint;
+   }
+
+   // Wait for other writers, if any, letting them ignore our read locks
+   if (fWriter.load()) {
+      local->fUpgrading = true;
+      fCond.notify_all();
+      fCond.wait(lock, [this] { return !fWriter.load(); });
+      local->fUpgrading = false;
+   }
+
+   // Claim the lock for this writer, new readers now step back
+   fWriter.store(true);
+   local->fIsWriter = true;
+   ++fWriteRecurse;
+
+   // Wait for the remaining readers
+   fCond.wait(lock, [this, local] { return AreOtherReadersDone(local); });
+
+   return hint;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Release the lock in write mode.
+
+void TReaderBiasedRWLock::WriteUnLock(TVirtualRWMutex::Hint_t *)
+{
+   auto local = GetLocal();
+
+   std::lock_guard<std::mutex> lock(fMutex);
+
+   if (!fWriter.load() || fWriteRecurse == 0 || !local->fIsWriter) {
+      Error("TReaderBiasedRWLock::WriteUnLock", "Write lock already released for %p", this);
+      return;
+   }
+
+   if (--fWriteRecurse == 0) {
+      local->fIsWriter = false;
+      fWriter.store(false);
+      // Notify all potential readers/writers that are waiting
+      fCond.notify_all();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Get the lock state before the most recent write lock was taken.
+
+std::unique_ptr<TVirtualRWMutex::State> TReaderBiasedRWLock::GetStateBefore()
+{
+   auto local = GetLocal();
+   if (!local->fIsWriter) {
+      Error("TReaderBiasedRWLock::GetStateBefore()", "Not holding the write lock!");
+      return nullptr;
+   }
+
+   std::unique_ptr<TReaderBiasedRWLockState> pState(new TReaderBiasedRWLockState);
+   pState->fReadersCountLoc = &local->fReadersCount;
+   pState->fReadersCount = local->fReadersCount.load();
+   // *Before* the most recent write lock (that is required by GetStateBefore())
+   // was taken, the write recursion level was `fWriteRecurse - 1`
+   pState->fWriteRecurse = fWriteRecurse - 1;
+
+   return std::unique_ptr<TVirtualRWMutex::State>(pState.release());
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Rewind to an earlier mutex state, returning the delta.
+
+std::unique_ptr<TVirtualRWMutex::StateDelta> TReaderBiasedRWLock::Rewind(const State &earlierState)
+{
+   auto &typedState = static_cast<const TReaderBiasedRWLockState &>(earlierState);
+   auto local = GetLocal();
+   if (typedState.fReadersCountLoc != &local->fReadersCount) {
+      Error("TReaderBiasedRWLock::Rewind", "State is from different thread!");
+      return nullptr;
+   }
+
+   std::unique_ptr<TReaderBiasedRWLockStateDelta> pStateDelta(new TReaderBiasedRWLockStateDelta);
+   pStateDelta->fReadersCountLoc = typedState.fReadersCountLoc;
+   pStateDelta->fDeltaReadersCount = (int)local->fReadersCount.load() - (int)typedState.fReadersCount;
+   pStateDelta->fDeltaWriteRecurse = (int)fWriteRecurse - (int)typedState.fWriteRecurse;
+
+   if (pStateDelta->fDeltaReadersCount < 0) {
+      Error("TReaderBiasedRWLock::Rewind", "Inconsistent read lock count!");
+      return nullptr;
+   }
+
+   if (pStateDelta->fDeltaWriteRecurse < 0) {
+      Error("TReaderBiasedRWLock::Rewind", "Inconsistent write lock count!");
+      return nullptr;
+   }
+
+   auto hint = reinterpret_cast<TVirtualRWMutex::Hint_t *>(typedState.fReadersCountLoc);
+   if (pStateDelta->fDeltaWriteRecurse != 0) {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         // Claim a recurse-state +1 to be able to call Unlock() below.
+         fWriteRecurse = typedState.fWriteRecurse + 1;
+      }
+      // Release this thread's write lock
+      WriteUnLock(hint);
+   } else {
+      Error("TReaderBiasedRWLock::Rewind", "has been called with no write lock held.");
+   }
+
+   if (pStateDelta->fDeltaReadersCount != 0) {
+      // Claim a recurse-state +1 to be able to call Unlock() below.
+      typedState.fReadersCountLoc->store(typedState.fReadersCount + 1);
+      // Release this thread's reader lock(s)
+      ReadUnLock(hint);
+   }
+   // else earlierState and *this are identical!
+
+   return std::unique_ptr<TVirtualRWMutex::StateDelta>(pStateDelta.release());
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Re-apply a delta.
+
+void TReaderBiasedRWLock::Apply(std::unique_ptr<StateDelta> &&state)
+{
+   if (!state) {
+      Error("TReaderBiasedRWLock::Apply", "Cannot apply empty delta!");
+      return;
+   }
+
+   auto typedDelta = static_cast<const TReaderBiasedRWLockStateDelta *>(state.get());
+
+   if (typedDelta->fDeltaWriteRecurse < 0) {
+      Error("TReaderBiasedRWLock::Apply", "Negative write recurse count delta!");
+      return;
+   }
+   if (typedDelta->fDeltaReadersCount < 0) {
+      Error("TReaderBiasedRWLock::Apply", "Negative read count delta!");
+      return;
+   }
+
+   if (typedDelta->fDeltaWriteRecurse != 0) {
+      WriteLock();
+      std::lock_guard<std::mutex> lock(fMutex);
+      fWriteRecurse += typedDelta->fDeltaWriteRecurse - 1;
+   }
+   if (typedDelta->fDeltaReadersCount != 0) {
+      ReadLock();
+      // "- 1" due to ReadLock() above.
+      auto &count = *typedDelta->fReadersCountLoc;
+      count.store(count.load() + typedDelta->fDeltaReadersCount - 1);
+   }
+}
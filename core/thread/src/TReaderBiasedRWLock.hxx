@@ -0,0 +1,78 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TReaderBiasedRWLock
+#define ROOT_TReaderBiasedRWLock
+
+#include "TVirtualRWMutex.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef R__HAS_TBB
+#include "tbb/enumerable_thread_specific.h"
+#else
+#include <unordered_map>
+#endif
+
+namespace ROOT {
+
+class TReaderBiasedRWLock {
+private:
+   /// Reader indicator of one thread, only written by its thread (or under fMutex).
+   /// The padding keeps the indicators of different threads on different cache lines.
+   struct LocalCounts {
+      std::atomic<size_t> fReadersCount{0}; ///<! Number of read locks held by the thread
+      bool fIsWriter = false;               ///<! The thread holds the write lock
+      bool fUpgrading = false;              ///<! The thread waits for the write lock while holding read locks
+      char fPadding[64];
+   };
+
+   std::atomic<bool> fWriter{false};                 ///<! Is there a writer?
+   size_t fWriteRecurse = 0;                         ///<! Number of re-entry in the write lock
+   std::mutex fMutex;                                ///<! Protects fLocals and the slow paths
+   std::condition_variable fCond;                    ///<! Signals the release of the write lock and of readers
+   std::vector<std::unique_ptr<LocalCounts>> fLocals; ///<! Indicators of all threads which ever used the lock
+#ifdef R__HAS_TBB
+   // Not a thread_local: see the comment about tls_get_addr_tail in TThread::Init.
+   tbb::enumerable_thread_specific<LocalCounts *, tbb::cache_aligned_allocator<LocalCounts *>, tbb::ets_key_per_instance>
+      fLocal; ///<! Indicator of the current thread
+#else
+   std::unordered_map<std::thread::id, LocalCounts *> fLocal; ///<! Indicator of each thread, protected by fMutex
+#endif
+
+   LocalCounts *GetLocal();
+   bool AreOtherReadersDone(const LocalCounts *local) const;
+
+public:
+   using State = TVirtualRWMutex::State;
+   using StateDelta = TVirtualRWMutex::StateDelta;
+
+   TReaderBiasedRWLock() = default;
+   TReaderBiasedRWLock(const TReaderBiasedRWLock &) = delete;
+   TReaderBiasedRWLock &operator=(const TReaderBiasedRWLock &) = delete;
+
+   TVirtualRWMutex::Hint_t *ReadLock();
+   void ReadUnLock(TVirtualRWMutex::Hint_t *);
+   TVirtualRWMutex::Hint_t *WriteLock();
+   void WriteUnLock(TVirtualRWMutex::Hint_t *);
+
+   std::unique_ptr<State> GetStateBefore();
+   std::unique_ptr<StateDelta> Rewind(const State &earlierState);
+   void Apply(std::unique_ptr<StateDelta> &&delta);
+};
+
+} // end of namespace ROOT
+
+#endif
@@ -34,11 +34,13 @@
 #include "TTimeStamp.h"
 #include "TInterpreter.h"
 #include "TError.h"
+#include "TEnv.h"
 #include "TSystem.h"
 #include "Varargs.h"
 #include "ThreadLocalStorage.h"
 #include "TThreadSlots.h"
 #include "TRWMutexImp.h"
+#include "TInstrumentedMutex.hxx"
 #include "snprintf.h"
 
 TThreadImp     *TThread::fgThreadImp = nullptr;
@@ -313,6 +315,27 @@ Bool_t TThread::IsInitialized()
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Whether ROOT::gCoreMutex is a TReaderBiasedRWLock, set by
+/// `Root.CoreMutex.ReaderBiased: true` in the .rootrc or by the environment
+/// variable ROOT_CORE_MUTEX_READER_BIASED. It scales better when many threads
+/// take read locks, e.g. for TClass lookups, but makes the write locks slower.
+
+static bool UseReaderBiasedCoreMutex()
+{
+   return gEnv->GetValue("Root.CoreMutex.ReaderBiased", 0) || gSystem->Getenv("ROOT_CORE_MUTEX_READER_BIASED");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether ROOT's global locks record contention statistics, set by
+/// `Root.CoreMutex.Profile: true` in the .rootrc or by the environment
+/// variable ROOT_CORE_MUTEX_PROFILE. See ROOT::TLockProfiler.
+
+static bool UseLockProfiler()
+{
+   return gEnv->GetValue("Root.CoreMutex.Profile", 0) || gSystem->Getenv("ROOT_CORE_MUTEX_PROFILE");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize global state and variables once.
 
@@ -339,17 +362,25 @@ void TThread::Init()
 
 
    // Create the single global mutex
+   const bool profileLocks = UseLockProfiler();
    gGlobalMutex = new TMutex(kTRUE);
-   // We need to make sure that gCling is initialized.
-   TInterpreter::Instance()->SetAlloclockfunc(CINT_alloc_lock);
-   gCling->SetAllocunlockfunc(CINT_alloc_unlock);
+   if (profileLocks)
+      gGlobalMutex =
+         new ROOT::Internal::TInstrumentedMutex(gGlobalMutex, ROOT::Internal::GetLockStats("gGlobalMutex"), true);
+   // We need to make sure that gCling is initialized, unless its creation is deferred to its first use.
+   if (!ROOT::Internal::IsInterpreterDeferred()) {
+      TInterpreter::Instance()->SetAlloclockfunc(CINT_alloc_lock);
+      gCling->SetAllocunlockfunc(CINT_alloc_unlock);
+   }
 
    // To avoid deadlocks, gInterpreterMutex and gROOTMutex need
    // to point at the same instance.
    // Both are now deprecated in favor of ROOT::gCoreMutex
    {
      R__LOCKGUARD(gGlobalMutex);
-     if (!ROOT::gCoreMutex) {
+     if (!ROOT::gCoreMutex && UseReaderBiasedCoreMutex()) {
+        ROOT::gCoreMutex = new ROOT::TReaderBiasedRWMutexImp();
+     } else if (!ROOT::gCoreMutex) {
         // To avoid dead locks, caused by shared library opening and/or static initialization
         // taking the same lock as 'tls_get_addr_tail', we can not use UniqueLockRecurseCount.
 #ifdef R__HAS_TBB
@@ -360,6 +391,15 @@ void TThread::Init()
      }
      gInterpreterMutex = ROOT::gCoreMutex;
      gROOTMutex = gInterpreterMutex;
+     if (profileLocks) {
+        // Same lock, separate statistics
+        using namespace ROOT::Internal;
+        ROOT::TVirtualRWMutex *coreMutex = ROOT::gCoreMutex;
+        gInterpreterMutex = new TInstrumentedMutex(coreMutex, GetLockStats("gInterpreterMutex"), false);
+        gROOTMutex = new TInstrumentedMutex(coreMutex, GetLockStats("gROOTMutex"), false);
+        ROOT::gCoreMutex = new TInstrumentedRWMutex(coreMutex, GetLockStats("gCoreMutex"), false);
+        EnableLockProfiler();
+     }
    }
 }
 
@@ -0,0 +1,63 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TThreadedObject.hxx"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include <atomic>
+
+namespace ROOT {
+namespace Internal {
+namespace TThreadedObjectUtils {
+
+namespace {
+/// Minimal number of objects merged by one task
+constexpr std::size_t kMinObjsPerMergeGroup = 4;
+} // anonymous namespace
+
+std::uint64_t GetNewObjectId()
+{
+   static std::atomic<std::uint64_t> lastId{0};
+   return ++lastId;
+}
+
+RSlotCache &GetThreadSlotCache()
+{
+   thread_local RSlotCache cache;
+   return cache;
+}
+
+unsigned GetNMergeGroups(std::size_t nObjs)
+{
+   if (!ROOT::IsImplicitMTEnabled())
+      return 1;
+   const std::size_t nGroups = std::min<std::size_t>(ROOT::GetThreadPoolSize(), nObjs / kMinObjsPerMergeGroup);
+   return nGroups > 1 ? nGroups : 1;
+}
+
+void ParallelForEach(const std::function<void(unsigned)> &func, unsigned nTimes)
+{
+   using Foreach_t = void (*)(const std::function<void(unsigned)> &, UInt_t);
+   if (ROOT::IsImplicitMTEnabled()) {
+      // libImt is loaded when implicit multi-threading is enabled
+      static auto foreach = (Foreach_t)gSystem->DynFindSymbol(nullptr, "ROOT_TImplicitMT_Foreach");
+      if (foreach) {
+         foreach(func, nTimes);
+         return;
+      }
+   }
+   for (unsigned i = 0; i < nTimes; ++i)
+      func(i);
+}
+
+} // namespace TThreadedObjectUtils
+} // namespace Internal
+} // namespace ROOT
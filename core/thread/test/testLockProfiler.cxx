@@ -0,0 +1,95 @@
+#include "TMutex.h"
+#include "ROOT/TLockProfiler.hxx"
+
+#include "../src/TInstrumentedMutex.hxx"
+#include "../src/TRWMutexImp.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+
+using ROOT::TLockProfiler;
+
+static TLockProfiler::RLockReport GetLockReport(const std::string &name)
+{
+   for (auto &report : TLockProfiler::GetReport()) {
+      if (report.fName == name)
+         return report;
+   }
+   return TLockProfiler::RLockReport();
+}
+
+TEST(TLockProfiler, CountsLocks)
+{
+   ROOT::TRWMutexImp<std::mutex> mutex;
+   ROOT::Internal::TInstrumentedRWMutex instrumented(&mutex, ROOT::Internal::GetLockStats("testCountsLocks"), false);
+
+   for (int i = 0; i < 3; ++i) {
+      auto hint = instrumented.ReadLock();
+      instrumented.ReadUnLock(hint);
+   }
+   for (int i = 0; i < 2; ++i) {
+      auto hint = instrumented.WriteLock();
+      instrumented.WriteUnLock(hint);
+   }
+
+   auto report = GetLockReport("testCountsLocks");
+   EXPECT_EQ(3u, report.fNReadLocks);
+   EXPECT_EQ(2u, report.fNWriteLocks);
+   ULong64_t nLocks = 0;
+   for (auto &site : report.fCallSites)
+      nLocks += site.fNLocks;
+   EXPECT_EQ(5u, nLocks);
+   EXPECT_FALSE(report.fCallSites.empty());
+}
+
+TEST(TLockProfiler, RecordsWaitTime)
+{
+   TMutex mutex(kTRUE);
+   ROOT::Internal::TInstrumentedMutex instrumented(&mutex, ROOT::Internal::GetLockStats("testRecordsWaitTime"), false);
+
+   std::promise<void> locked;
+   std::thread holder([&] {
+      instrumented.Lock();
+      locked.set_value();
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      instrumented.UnLock();
+   });
+   locked.get_future().wait();
+   instrumented.Lock();
+   instrumented.UnLock();
+   holder.join();
+
+   auto report = GetLockReport("testRecordsWaitTime");
+   EXPECT_EQ(2u, report.fNWriteLocks);
+   EXPECT_LE(1u, report.fNContended);
+   EXPECT_GE(report.fMaxWaitTimeNs, 10000000u);
+   EXPECT_GE(report.fWaitTimeNs, report.fMaxWaitTimeNs);
+
+   TLockProfiler::Reset();
+   report = GetLockReport("testRecordsWaitTime");
+   EXPECT_EQ(0u, report.fNWriteLocks);
+   EXPECT_EQ(0u, report.fWaitTimeNs);
+}
+
+TEST(TLockProfiler, FactoryMutexesAreAccountedTogether)
+{
+   TMutex mutex(kTRUE);
+   ROOT::Internal::TInstrumentedMutex instrumented(&mutex, ROOT::Internal::GetLockStats("testFactory"), false);
+   auto before = GetLockReport("R__LOCKGUARD2").fNWriteLocks;
+
+   TVirtualMutex *m1 = instrumented.Factory(kTRUE);
+   TVirtualMutex *m2 = instrumented.Factory(kTRUE);
+   m1->Lock();
+   m1->UnLock();
+   m2->Lock();
+   m2->UnLock();
+   delete m1;
+   delete m2;
+
+   EXPECT_EQ(before + 2, GetLockReport("R__LOCKGUARD2").fNWriteLocks);
+   EXPECT_EQ(0u, GetLockReport("testFactory").fNWriteLocks);
+}
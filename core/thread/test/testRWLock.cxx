@@ -262,6 +262,8 @@ auto gReentrantRWMutexStd = new ROOT::TReentrantRWLock<std::mutex>();
 auto gReentrantRWMutexStdTBB = new ROOT::TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBB>();
 auto gReentrantRWMutexStdTBBUnique = new ROOT::TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>();
 #endif
+auto gReaderBiasedRWMutex = new ROOT::TReaderBiasedRWLock();
+auto gRWMutexReaderBiased = new TReaderBiasedRWMutexImp();
 auto gSpinMutex = new ROOT::TSpinMutex();
 
 // Intentionally ignore the Fatal error due to the shread thread-local storage.
@@ -430,6 +432,26 @@ TEST(RWLock, ReadUnLockDirect)
    testReadUnLock(gReentrantRWMutex, gRepetition, gReadHint);
 }
 
+TEST(RWLock, WriteReaderBiasedDirectLock)
+{
+   gWriteHint = testWriteLock(gReaderBiasedRWMutex, gRepetition);
+}
+
+TEST(RWLock, WriteReaderBiasedDirectUnLock)
+{
+   testWriteUnLock(gReaderBiasedRWMutex, gRepetition, gWriteHint);
+}
+
+TEST(RWLock, ReadLockReaderBiasedDirect)
+{
+   gReadHint = testReadLock(gReaderBiasedRWMutex, gRepetition);
+}
+
+TEST(RWLock, ReadUnLockReaderBiasedDirect)
+{
+   testReadUnLock(gReaderBiasedRWMutex, gRepetition, gReadHint);
+}
+
 TEST(RWLock, WriteSpinTLDirectLock)
 {
    gWriteHint = testWriteLock(gReentrantRWMutexSMTL, gRepetition);
@@ -564,6 +586,31 @@ TEST(RWLock, ResetRestoreTL)
    ResetRestore(*gReentrantRWMutexTL);
 }
 
+TEST(RWLock, ReentrantReaderBiased)
+{
+   Reentrant(*gReaderBiasedRWMutex);
+}
+
+TEST(RWLock, ResetRestoreReaderBiased)
+{
+   ResetRestore(*gReaderBiasedRWMutex);
+}
+
+TEST(RWLock, concurrentResetRestoreReaderBiased)
+{
+   concurrentResetRestore(gRWMutexReaderBiased, 2, gRepetition / 10000);
+}
+
+TEST(RWLock, concurrentReadsAndWritesReaderBiased)
+{
+   concurrentReadsAndWrites(gRWMutexReaderBiased, 1, 2, gRepetition / 10000);
+}
+
+TEST(RWLock, LargeconcurrentReadsAndWritesReaderBiased)
+{
+   concurrentReadsAndWrites(gRWMutexReaderBiased, 10, 20, gRepetition / 10000);
+}
+
 
 TEST(RWLock, concurrentResetRestore)
 {
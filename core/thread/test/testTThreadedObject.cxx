@@ -128,6 +128,57 @@ TEST(TThreadedObject, SnapshotMerge)
    EXPECT_TRUE(hsum1 != hsum0);
 }
 
+TEST(TThreadedObject, GetReturnsSameObject)
+{
+   ROOT::TThreadedObject<int> tto(ROOT::TNumSlots{1}, 42);
+   auto p0 = tto.Get();
+   EXPECT_EQ(tto.Get(), p0);
+   EXPECT_EQ(tto.GetAtSlot(0), p0);
+
+   // a new object at the slot of this thread is seen by Get()
+   tto.SetAtSlot(0, std::make_shared<int>(43));
+   EXPECT_EQ(*tto.Get(), 43);
+
+   // and an emptied slot is filled again from the model
+   tto.SetAtSlot(0, nullptr);
+   EXPECT_EQ(*tto.Get(), 42);
+
+   // objects created after ours do not get our slot
+   ROOT::TThreadedObject<int> tto2(ROOT::TNumSlots{1}, 1);
+   EXPECT_EQ(*tto2.Get(), 1);
+   EXPECT_EQ(*tto.Get(), 42);
+}
+
+#ifdef R__USE_IMT
+TEST(TThreadedObject, MergeInParallel)
+{
+   TH1::AddDirectory(false);
+   ROOT::EnableImplicitMT(4);
+
+   const unsigned nSlots = 32;
+   TH1F expected("h", "h", 64, -4, 4);
+   ROOT::TThreadedObject<TH1F> tto(ROOT::TNumSlots{nSlots}, "h", "h", 64, -4, 4);
+   gRandom->SetSeed(1);
+   for (unsigned i = 0; i < nSlots; ++i) {
+      TH1F h("h", "h", 64, -4, 4);
+      h.FillRandom("gaus", 100);
+      tto.GetAtSlot(i)->Add(&h);
+      expected.Add(&h);
+   }
+
+   // the slots are not modified by a snapshot
+   auto snapshot = tto.SnapshotMerge();
+   IsHistEqual(*snapshot, expected);
+   EXPECT_DOUBLE_EQ(tto.GetAtSlot(1)->GetEntries(), 100);
+
+   auto hsum = tto.Merge();
+   IsHistEqual(*hsum, expected);
+   EXPECT_DOUBLE_EQ(hsum->GetEntries(), expected.GetEntries());
+
+   ROOT::DisableImplicitMT();
+}
+#endif
+
 TEST(TThreadedObject, GrowSlots)
 {
    // create a TThreadedObject with 3 slots...
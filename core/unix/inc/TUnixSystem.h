@@ -26,6 +26,8 @@
 #include "TTimer.h"
 #include <string>
 
+struct pollfd;
+
 typedef void (*SigHandler_t)(ESignals);
 
 
@@ -48,6 +50,7 @@ protected:
    static int          UnixSetitimer(Long_t ms);
    static int          UnixSelect(Int_t nfds, TFdSet *readready, TFdSet *writeready,
                                   Long_t timeout);
+   static int          UnixPoll(pollfd *fds, UInt_t nfds, Long_t timeout);
    static void         UnixSignal(ESignals sig, SigHandler_t h);
    static const char  *UnixSigname(ESignals sig);
    static void         UnixSigAlarmInterruptsSyscalls(Bool_t set);
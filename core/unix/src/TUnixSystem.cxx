@@ -43,6 +43,7 @@
 #include <map>
 #include <algorithm>
 #include <atomic>
+#include <vector>
 
 //#define G__OLDEXPAND
 
@@ -115,6 +116,7 @@
 #include <sys/un.h>
 #include <netdb.h>
 #include <fcntl.h>
+#include <poll.h>
 #if defined(R__SOLARIS)
 #   include <sys/systeminfo.h>
 #   include <sys/filio.h>
@@ -1171,36 +1173,39 @@ Int_t TUnixSystem::Select(TList *act, Long_t to)
 {
    Int_t rc = -4;
 
-   TFdSet rd, wr;
-   Int_t mxfd = -1;
+   // poll() has no limit on the values of the file descriptors, contrary to
+   // the fd_set of select(), and its cost only depends on their number
+   std::vector<pollfd> fds;
+   std::vector<TFileHandler *> handlers;
    TIter next(act);
    TFileHandler *h = 0;
    while ((h = (TFileHandler *) next())) {
       Int_t fd = h->GetFd();
       if (fd > -1) {
-         if (h->HasReadInterest()) {
-            rd.Set(fd);
-            mxfd = TMath::Max(mxfd, fd);
-         }
-         if (h->HasWriteInterest()) {
-            wr.Set(fd);
-            mxfd = TMath::Max(mxfd, fd);
-         }
+         short events = 0;
+         if (h->HasReadInterest())
+            events |= POLLIN;
+         if (h->HasWriteInterest())
+            events |= POLLOUT;
          h->ResetReadyMask();
+         if (events) {
+            fds.push_back({fd, events, 0});
+            handlers.push_back(h);
+         }
       }
    }
-   if (mxfd > -1)
-      rc = UnixSelect(mxfd+1, &rd, &wr, to);
+   if (!fds.empty())
+      rc = UnixPoll(fds.data(), fds.size(), to);
 
    // Set readiness bits
    if (rc > 0) {
-      next.Reset();
-      while ((h = (TFileHandler *) next())) {
-         Int_t fd = h->GetFd();
-         if (rd.IsSet(fd))
-            h->SetReadReady();
-         if (wr.IsSet(fd))
-            h->SetWriteReady();
+      for (size_t i = 0; i < fds.size(); ++i) {
+         if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+            if (handlers[i]->HasReadInterest())
+               handlers[i]->SetReadReady();
+         if (fds[i].revents & (POLLOUT | POLLERR))
+            if (handlers[i]->HasWriteInterest())
+               handlers[i]->SetWriteReady();
       }
    }
 
@@ -1219,27 +1224,24 @@ Int_t TUnixSystem::Select(TFileHandler *h, Long_t to)
 {
    Int_t rc = -4;
 
-   TFdSet rd, wr;
-   Int_t mxfd = -1;
-   Int_t fd = -1;
+   pollfd pfd{-1, 0, 0};
    if (h) {
-      fd = h->GetFd();
-      if (fd > -1) {
+      pfd.fd = h->GetFd();
+      if (pfd.fd > -1) {
          if (h->HasReadInterest())
-            rd.Set(fd);
+            pfd.events |= POLLIN;
          if (h->HasWriteInterest())
-            wr.Set(fd);
+            pfd.events |= POLLOUT;
          h->ResetReadyMask();
-         mxfd = fd;
-         rc = UnixSelect(mxfd+1, &rd, &wr, to);
+         rc = UnixPoll(&pfd, 1, to);
       }
    }
 
    // Fill output lists, if required
    if (rc > 0) {
-      if (rd.IsSet(fd))
+      if ((pfd.revents & (POLLIN | POLLHUP | POLLERR)) && h->HasReadInterest())
          h->SetReadReady();
-      if (wr.IsSet(fd))
+      if ((pfd.revents & (POLLOUT | POLLERR)) && h->HasWriteInterest())
          h->SetWriteReady();
    }
 
@@ -3872,6 +3874,31 @@ int TUnixSystem::UnixSetitimer(Long_t ms)
 
 //---- file descriptors --------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the events requested in the nfds entries of fds or for timeout
+/// (in milliseconds) to occur. Returns the number of ready descriptors,
+/// or 0 in case of timeout, or < 0 in case of an error, with -2 being EINTR
+/// and -3 EBADF, i.e. one of the descriptors is not open, as select() does.
+/// In case of EINTR the errno has been reset and the method can be called again.
+
+int TUnixSystem::UnixPoll(pollfd *fds, UInt_t nfds, Long_t timeout)
+{
+   int retcode = poll(fds, nfds, timeout >= 0 ? (int)timeout : -1);
+   if (retcode == -1) {
+      if (GetErrno() == EINTR) {
+         ResetErrno();  // errno is not self reseting
+         return -2;
+      }
+      return -1;
+   }
+
+   for (UInt_t i = 0; (retcode > 0) && (i < nfds); ++i)
+      if (fds[i].revents & POLLNVAL)
+         return -3;
+
+   return retcode;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Wait for events on the file descriptors specified in the readready and
 /// writeready masks or for timeout (in milliseconds) to occur. Returns
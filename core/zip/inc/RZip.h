@@ -23,6 +23,42 @@ extern "C" unsigned long R__memcompress(char *tgt, unsigned long tgtsize, char *
 
 extern "C" void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues);
 
+/**
+ * Same as R__zipMultipleAlgorithm, but ZSTD compresses the buffer with the dictionary `dictID` previously loaded with
+ * R__zipLoadDictionary. The dictionary is ignored by the other algorithms and when `dictID` is 0.
+ */
+extern "C" void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues, unsigned int dictID);
+
+/**
+ * Train a ZSTD dictionary of at most `dictCapacity` bytes on the `nSamples` buffers stored one after the other in
+ * `samples`. Returns the size of the dictionary written to `dict`, or 0 if no dictionary could be trained.
+ */
+extern "C" unsigned long R__zipTrainDictionary(char *dict, unsigned long dictCapacity, const char *samples, const unsigned long *sampleSizes, unsigned int nSamples);
+
+/**
+ * Make a ZSTD dictionary available to R__zipMultipleAlgorithmDict and to R__unzip, which finds the dictionary of a
+ * compressed buffer from its identifier in the ZSTD frame. Loading the same dictionary again does nothing.
+ * Returns the dictionary identifier, or 0 if `dict` is not a trained ZSTD dictionary.
+ */
+extern "C" unsigned int R__zipLoadDictionary(const char *dict, unsigned long dictSize);
+
+/**
+ * Offload of the ZLIB algorithm, e.g. to a hardware accelerator such as Intel QAT or IAA. The deflate function must
+ * compress `srcsize` bytes of `src` at the given level into `tgt`, of capacity `tgtsize`, as a zlib stream (RFC 1950)
+ * and return its size. The inflate function must decompress the zlib stream of `srcsize` bytes at `src` into `tgt`,
+ * of capacity `tgtsize`, and return the decompressed size. Both return 0 if they cannot process the buffer, which is
+ * then processed by zlib. As the offloaded streams are regular zlib streams, any reader can decompress them.
+ */
+typedef int (*R__ZLIBDeflateOffload_t)(int cxlevel, const char *src, int srcsize, char *tgt, int tgtsize);
+typedef int (*R__ZLIBInflateOffload_t)(const char *src, int srcsize, char *tgt, int tgtsize);
+
+/**
+ * Install the offload functions of the ZLIB algorithm; nullptr restores the zlib implementation. The functions can be
+ * called concurrently from several threads, e.g. for the blocks of a large buffer or during a multi-threaded flush of
+ * a TTree, which keeps several requests in flight on the accelerator.
+ */
+extern "C" void R__SetZLIBOffload(R__ZLIBDeflateOffload_t deflateOffload, R__ZLIBInflateOffload_t inflateOffload);
+
 /**
  * This is a historical definition, prior to ROOT supporting multiple algorithms in a single file.  Use
  * R__zipMultipleAlgorithm instead.
@@ -13,9 +13,11 @@
 #include "ZipLZMA.h"
 #include "ZipLZ4.h"
 #include "ZipZSTD.h"
+#include "ROOT/RTrace.hxx"
 
 #include "zlib.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cassert>
 
@@ -56,6 +58,18 @@ ROOT::RCompressionSetting::EAlgorithm::EValues R__ZipMode = ROOT::RCompressionSe
 ROOT::RCompressionSetting::EAlgorithm::EValues R__ZipMode = ROOT::RCompressionSetting::EAlgorithm::EValues::kZLIB;
 #endif
 
+/* ===========================================================================
+   Offload of the ZLIB algorithm, see R__SetZLIBOffload
+ */
+static std::atomic<R__ZLIBDeflateOffload_t> gZLIBDeflateOffload{nullptr};
+static std::atomic<R__ZLIBInflateOffload_t> gZLIBInflateOffload{nullptr};
+
+extern "C" void R__SetZLIBOffload(R__ZLIBDeflateOffload_t deflateOffload, R__ZLIBInflateOffload_t inflateOffload)
+{
+   gZLIBDeflateOffload = deflateOffload;
+   gZLIBInflateOffload = inflateOffload;
+}
+
 /* ===========================================================================
    Function to set the ZipMode
  */
@@ -78,6 +92,7 @@ unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int
 /*                      3 = old */
 void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
 {
+  R__TRACE_SPAN("zip", "R__zip");
 
   if (*srcsize < 1 + HDRSIZE + 1) {
      *irep = 0;
@@ -110,6 +125,36 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   }
 }
 
+void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm, unsigned int dictID)
+{
+  if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
+    compressionAlgorithm = R__ZipMode;
+  }
+
+  if (dictID == 0 || compressionAlgorithm != ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+    R__zipMultipleAlgorithm(cxlevel, srcsize, src, tgtsize, tgt, irep, compressionAlgorithm);
+    return;
+  }
+  R__TRACE_SPAN("zip", "R__zip");
+
+  if (*srcsize < 1 + HDRSIZE + 1 || cxlevel <= 0) {
+    *irep = 0;
+    return;
+  }
+
+  R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, dictID);
+}
+
+unsigned long R__zipTrainDictionary(char *dict, unsigned long dictCapacity, const char *samples, const unsigned long *sampleSizes, unsigned int nSamples)
+{
+  return R__ZSTDTrainDictionary(dict, dictCapacity, samples, sampleSizes, nSamples);
+}
+
+unsigned int R__zipLoadDictionary(const char *dict, unsigned long dictSize)
+{
+  return R__ZSTDLoadDictionary(dict, dictSize);
+}
+
   // The very old algorithm for backward compatibility
   // 0 for selecting with R__ZipMode in a backward compatible way
   // 3 for selecting in other cases
@@ -171,6 +216,21 @@ static void R__zipOld(int cxlevel, int *srcsize, char *src, int *tgtsize, char *
     return;
 }
 
+static void R__writeHeaderZLIB(char *tgt, int method, unsigned l_out_size, unsigned l_in_size)
+{
+    tgt[0] = 'Z';               /* Signature ZLib */
+    tgt[1] = 'L';
+    tgt[2] = (char) method;
+
+    tgt[3] = (char)(l_out_size & 0xff);        /* compressed size */
+    tgt[4] = (char)((l_out_size >> 8) & 0xff);
+    tgt[5] = (char)((l_out_size >> 16) & 0xff);
+
+    tgt[6] = (char)(l_in_size & 0xff);         /* decompressed size */
+    tgt[7] = (char)((l_in_size >> 8) & 0xff);
+    tgt[8] = (char)((l_in_size >> 16) & 0xff);
+}
+
 /**
  * Compress buffer contents using the venerable zlib algorithm.
  */
@@ -193,6 +253,16 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
        return;
     }
 
+    if (R__ZLIBDeflateOffload_t deflateOffload = gZLIBDeflateOffload.load(std::memory_order_relaxed)) {
+       const int nout = deflateOffload(cxlevel > 9 ? 9 : cxlevel, src, *srcsize, &tgt[HDRSIZE], *tgtsize - HDRSIZE);
+       if (nout > 0 && nout <= *tgtsize - HDRSIZE) {
+          R__writeHeaderZLIB(tgt, method, nout, *srcsize);
+          *irep = nout + HDRSIZE;
+          return;
+       }
+       /* fall back to zlib */
+    }
+
     stream.next_in   = (Bytef*)src;
     stream.avail_in  = (uInt)(*srcsize);
 
@@ -221,19 +291,9 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
     if (err != Z_OK)
        printf("error %d in deflateEnd (zlib)\n",err);
 
-    tgt[0] = 'Z';               /* Signature ZLib */
-    tgt[1] = 'L';
-    tgt[2] = (char) method;
-
     l_in_size   = (unsigned) (*srcsize);
     l_out_size  = stream.total_out;             /* compressed size */
-    tgt[3] = (char)(l_out_size & 0xff);
-    tgt[4] = (char)((l_out_size >> 8) & 0xff);
-    tgt[5] = (char)((l_out_size >> 16) & 0xff);
-
-    tgt[6] = (char)(l_in_size & 0xff);         /* decompressed size */
-    tgt[7] = (char)((l_in_size >> 8) & 0xff);
-    tgt[8] = (char)((l_in_size >> 16) & 0xff);
+    R__writeHeaderZLIB(tgt, method, l_out_size, l_in_size);
 
     *irep = stream.total_out + HDRSIZE;
 }
@@ -321,6 +381,7 @@ int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
 // age of the original code...
 void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
 {
+   R__TRACE_SPAN("zip", "R__unzip");
    long isize;
    uch *ibufptr, *obufptr;
    long ibufcnt, obufcnt;
@@ -394,6 +455,15 @@ void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
      z_stream stream; /* decompression stream */
      int err = 0;
 
+     if (R__ZLIBInflateOffload_t inflateOffload = gZLIBInflateOffload.load(std::memory_order_relaxed)) {
+        const int nout = inflateOffload((const char *)(&src[HDRSIZE]), *srcsize - HDRSIZE, (char *)tgt, *tgtsize);
+        if (nout > 0 && nout <= *tgtsize) {
+           *irep = nout;
+           return;
+        }
+        /* fall back to zlib */
+     }
+
      stream.next_in = (Bytef *)(&src[HDRSIZE]);
      stream.avail_in = (uInt)(*srcsize) - HDRSIZE;
      stream.next_out = (Bytef *)tgt;
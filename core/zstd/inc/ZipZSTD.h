@@ -17,6 +17,10 @@ extern "C" {
 #endif
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned int dictID);
+unsigned long R__ZSTDTrainDictionary(char *dict, unsigned long dictCapacity, const char *samples,
+                                     const unsigned long *sampleSizes, unsigned int nSamples);
+unsigned int R__ZSTDLoadDictionary(const char *dict, unsigned long dictSize);
 #ifdef __cplusplus
 }
 #endif
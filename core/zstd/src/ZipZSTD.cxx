@@ -14,7 +14,11 @@
 
 #include "zdict.h"
 #include <zstd.h>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <iostream>
 
@@ -22,17 +26,100 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
+namespace {
+
+/// A dictionary loaded with R__ZSTDLoadDictionary(), with its digested forms for decompression and for compression
+/// at each of the levels used so far.
+struct RZSTDDictionary {
+   std::string fData;
+   ZSTD_DDict *fDDict = nullptr;
+   std::map<int, ZSTD_CDict *> fCDicts;
+};
+
+std::mutex &GetDictionaryMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+// Never destroyed: baskets may still be compressed or decompressed while static objects are being destructed
+std::map<unsigned int, RZSTDDictionary *> &GetDictionaries()
+{
+   static auto dictionaries = new std::map<unsigned int, RZSTDDictionary *>;
+   return *dictionaries;
+}
+
+ZSTD_DDict *GetDDict(unsigned int dictID)
+{
+   std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+   auto it = GetDictionaries().find(dictID);
+   return it == GetDictionaries().end() ? nullptr : it->second->fDDict;
+}
+
+ZSTD_CDict *GetCDict(unsigned int dictID, int level)
+{
+   std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+   auto it = GetDictionaries().find(dictID);
+   if (it == GetDictionaries().end())
+      return nullptr;
+   auto &cdict = it->second->fCDicts[level];
+   if (!cdict)
+      cdict = ZSTD_createCDict(it->second->fData.data(), it->second->fData.size(), level);
+   return cdict;
+}
+
+// Creating a context costs more than compressing a small buffer: each thread keeps and reuses its contexts
+ZSTD_CCtx *GetCCtx()
+{
+   thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+   return ctx.get();
+}
+
+ZSTD_DCtx *GetDCtx()
+{
+   thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+   return ctx.get();
+}
+
+void WriteHeader(char *tgt, size_t deflate_size, size_t inflate_size)
+{
+    tgt[0] = 'Z';
+    tgt[1] = 'S';
+    tgt[2] = '\1';
+    tgt[3] = deflate_size & 0xff;
+    tgt[4] = (deflate_size >> 8) & 0xff;
+    tgt[5] = (deflate_size >> 16) & 0xff;
+    tgt[6] = inflate_size & 0xff;
+    tgt[7] = (inflate_size >> 8) & 0xff;
+    tgt[8] = (inflate_size >> 16) & 0xff;
+}
+
+} // anonymous namespace
+
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
-    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, 0);
+}
+
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned int dictID)
+{
+    ZSTD_CCtx *ctx = GetCCtx();
 
     *irep = 0;
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+    ZSTD_CDict *cdict = dictID ? GetCDict(dictID, 2*cxlevel) : nullptr;
+    if (R__unlikely(dictID && !cdict)) {
+        std::cerr << "Error in zip ZSTD. The dictionary " << dictID << " is not loaded." << std::endl;
+        return;
+    }
+
+    size_t retval = cdict ? ZSTD_compress_usingCDict(ctx,
+                                                     &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                                     src, static_cast<size_t>(*srcsize), cdict)
+                          : ZSTD_compressCCtx(ctx,
+                                              &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                              src, static_cast<size_t>(*srcsize),
+                                              2*cxlevel);
 
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
@@ -45,23 +132,12 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
         *irep = static_cast<size_t>(retval + kHeaderSize);
     }
 
-    size_t deflate_size = retval;
-    size_t inflate_size = static_cast<size_t>(*srcsize);
-    tgt[0] = 'Z';
-    tgt[1] = 'S';
-    tgt[2] = '\1';
-    tgt[3] = deflate_size & 0xff;
-    tgt[4] = (deflate_size >> 8) & 0xff;
-    tgt[5] = (deflate_size >> 16) & 0xff;
-    tgt[6] = inflate_size & 0xff;
-    tgt[7] = (inflate_size >> 8) & 0xff;
-    tgt[8] = (inflate_size >> 16) & 0xff;
+    WriteHeader(tgt, retval, static_cast<size_t>(*srcsize));
 }
 
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
-    Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    ZSTD_DCtx *ctx = GetDCtx();
     *irep = 0;
 
     if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
@@ -77,9 +153,22 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
       return;
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
-                                        (char *)tgt, static_cast<size_t>(*tgtsize),
-                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    // Buffers compressed with a dictionary carry its identifier in the ZSTD frame header
+    const unsigned int dictID = ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    ZSTD_DDict *ddict = dictID ? GetDDict(dictID) : nullptr;
+    if (R__unlikely(dictID && !ddict)) {
+      std::cerr << "R__unzipZSTD: the buffer was compressed with the dictionary " << dictID <<
+      ", which is not loaded." << std::endl;
+      return;
+    }
+
+    size_t retval = ddict ? ZSTD_decompress_usingDDict(ctx,
+                                                       (char *)tgt, static_cast<size_t>(*tgtsize),
+                                                       (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                                       ddict)
+                          : ZSTD_decompressDCtx(ctx,
+                                                (char *)tgt, static_cast<size_t>(*tgtsize),
+                                                (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
 
     /* The error code 18446744073709551546 arises when the tgt buffer is too small
      * However this error is already handled outside of the compression algorithm
@@ -95,3 +184,32 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
         *irep = retval;
     }
 }
+
+unsigned long R__ZSTDTrainDictionary(char *dict, unsigned long dictCapacity, const char *samples,
+                                     const unsigned long *sampleSizes, unsigned int nSamples)
+{
+    std::vector<size_t> sizes(sampleSizes, sampleSizes + nSamples);
+    size_t retval = ZDICT_trainFromBuffer(dict, dictCapacity, samples, sizes.data(), nSamples);
+    // Training fails e.g. when there are too few samples: the caller then simply does not use a dictionary
+    if (ZDICT_isError(retval))
+        return 0;
+    return retval;
+}
+
+unsigned int R__ZSTDLoadDictionary(const char *dict, unsigned long dictSize)
+{
+    const unsigned int dictID = ZSTD_getDictID_fromDict(dict, dictSize);
+    if (dictID == 0)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+    auto &entry = GetDictionaries()[dictID];
+    // Dictionaries with the same identifier are assumed to be the same: it is the case of the dictionaries of a
+    // tree stored in several files
+    if (!entry) {
+        entry = new RZSTDDictionary;
+        entry->fData.assign(dict, dictSize);
+        entry->fDDict = ZSTD_createDDict(entry->fData.data(), entry->fData.size());
+    }
+    return dictID;
+}
@@ -19,9 +19,11 @@
 #include "TGeoElement.h"
 
 #include <map>
+#include <vector>
 #include <iostream>
 
 class TGDMLMatrix;
+class TGeoTessellated;
 
 /*************************************************************************
  * TGDMLRefl - helper class for the import of GDML to ROOT.              *
@@ -125,6 +127,7 @@ private:
    const char*       NameShort(const char* name);
    double            Value(const char *svalue) const;
    void              DefineConstants();
+   void              CloseTessellated();
 
    //'define' section
    XMLNodePointer_t  ConProcess(TXMLEngine* gdml, XMLNodePointer_t node, XMLAttrPointer_t attr);
@@ -213,6 +216,7 @@ private:
    FileMap ffilemap;              //!Map containing files parsed during entire parsing, with their world volume name
    ConstMap fconsts;              //!Map containing values of constants declared in the file
    MatrixMap fmatrices;           //!Map containing matrices defined in the GDML file
+   std::vector<TGeoTessellated *> fPendingTessellated; //!Tessellated solids read but not closed yet
 
    ClassDef(TGDMLParse, 0)    //imports GDML using DOM and binds it to ROOT
 };
@@ -114,13 +114,190 @@ When most solids or volumes are added to the geometry they
 #include "TGeoSystemOfUnits.h"
 #include "TGeant4SystemOfUnits.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <string>
 #include <sstream>
 #include <locale>
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 ClassImp(TGDMLParse);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Recursive descent evaluation of the arithmetic expressions of the GDML
+/// attributes: numbers, constants, + - * / ^, parentheses and the usual
+/// functions. It follows the precedences of TFormula, ^ being right
+/// associative and binding more tightly than the unary minus. Anything else,
+/// e.g. unknown constants or functions, makes the evaluation fail, in which
+/// case TGDMLParse::Value falls back to TFormula.
+
+class TGDMLExpression {
+   const std::map<std::string, double> &fConsts;
+   const char *fPos;
+   bool fOk = true;
+
+   void SkipSpaces()
+   {
+      while (*fPos != 0 && isspace(*fPos))
+         ++fPos;
+   }
+
+   char Peek()
+   {
+      SkipSpaces();
+      return *fPos;
+   }
+
+   double Fail()
+   {
+      fOk = false;
+      return 0;
+   }
+
+   double Sum()
+   {
+      double val = Product();
+      while (fOk) {
+         char op = Peek();
+         if (op != '+' && op != '-')
+            break;
+         ++fPos;
+         double rhs = Product();
+         val = (op == '+') ? val + rhs : val - rhs;
+      }
+      return val;
+   }
+
+   double Product()
+   {
+      double val = Unary();
+      while (fOk) {
+         char op = Peek();
+         if (op != '*' && op != '/')
+            break;
+         ++fPos;
+         double rhs = Unary();
+         val = (op == '*') ? val * rhs : val / rhs;
+      }
+      return val;
+   }
+
+   double Unary()
+   {
+      char op = Peek();
+      if (op == '-' || op == '+') {
+         ++fPos;
+         double val = Unary();
+         return (op == '-') ? -val : val;
+      }
+      return Power();
+   }
+
+   double Power()
+   {
+      double base = Primary();
+      if (fOk && Peek() == '^') {
+         ++fPos;
+         return std::pow(base, Unary());
+      }
+      return base;
+   }
+
+   double Primary()
+   {
+      const std::locale &loc = std::locale::classic();
+      char c = Peek();
+      if (c == '(') {
+         ++fPos;
+         double val = Sum();
+         if (!fOk || Peek() != ')')
+            return Fail();
+         ++fPos;
+         return val;
+      }
+      if (std::isdigit(c, loc) || c == '.') {
+         if (c == '0' && (fPos[1] == 'x' || fPos[1] == 'X'))
+            return Fail();
+         char *end;
+         double val = strtod(fPos, &end);
+         if (end == fPos)
+            return Fail();
+         fPos = end;
+         return val;
+      }
+      if (!std::isalpha(c, loc) && c != '_')
+         return Fail();
+      const char *start = fPos;
+      while (std::isalnum(*fPos, loc) || *fPos == '_')
+         ++fPos;
+      std::string name(start, fPos);
+      if (*fPos != '(') {
+         auto it = fConsts.find(name);
+         return (it != fConsts.end()) ? it->second : Fail();
+      }
+      ++fPos;
+      double args[2];
+      int nargs = 0;
+      if (Peek() != ')') {
+         while (fOk) {
+            if (nargs == 2)
+               return Fail();
+            args[nargs++] = Sum();
+            if (Peek() != ',')
+               break;
+            ++fPos;
+         }
+      }
+      if (!fOk || Peek() != ')')
+         return Fail();
+      ++fPos;
+      return Function(name, nargs, args);
+   }
+
+   double Function(const std::string &name, int nargs, const double *args)
+   {
+      if (nargs == 1) {
+         static const std::map<std::string, double (*)(double)> functions = {
+            {"sin", std::sin},   {"cos", std::cos},   {"tan", std::tan},     {"asin", std::asin},
+            {"acos", std::acos}, {"atan", std::atan}, {"sqrt", std::sqrt},   {"exp", std::exp},
+            {"log", std::log},   {"log10", std::log10}, {"abs", std::fabs}, {"fabs", std::fabs}};
+         auto it = functions.find(name);
+         return (it != functions.end()) ? it->second(args[0]) : Fail();
+      }
+      if (nargs == 2) {
+         if (name == "pow")
+            return std::pow(args[0], args[1]);
+         if (name == "atan2")
+            return std::atan2(args[0], args[1]);
+         if (name == "min")
+            return std::min(args[0], args[1]);
+         if (name == "max")
+            return std::max(args[0], args[1]);
+      }
+      return Fail();
+   }
+
+public:
+   TGDMLExpression(const std::map<std::string, double> &consts, const char *expr) : fConsts(consts), fPos(expr) {}
+
+   /// Evaluate the whole expression, return false if it is not supported
+   bool Evaluate(double &val)
+   {
+      val = Sum();
+      return fOk && Peek() == 0;
+   }
+};
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor
 
@@ -177,6 +354,7 @@ TGeoVolume *TGDMLParse::GDMLReadFile(const char *filename)
 
       // display recursively all nodes and subnodes
       ParseGDML(gdml, mainnode);
+      CloseTessellated();
 
       // Release memory before exit
       gdml->FreeDoc(gdmldoc);
@@ -192,7 +370,8 @@ TGeoVolume *TGDMLParse::GDMLReadFile(const char *filename)
 
 const char *TGDMLParse::ParseGDML(TXMLEngine *gdml, XMLNodePointer_t node)
 {
-   DefineConstants();
+   if (fconsts.empty())
+      DefineConstants();
    XMLAttrPointer_t attr = gdml->GetFirstAttr(node);
    const char *name = gdml->GetNodeName(node);
    XMLNodePointer_t parentn = gdml->GetParent(node);
@@ -244,6 +423,11 @@ const char *TGDMLParse::ParseGDML(TXMLEngine *gdml, XMLNodePointer_t node)
    Bool_t hasIsotopes;
    Bool_t hasIsotopesExtended;
 
+   // Consecutive tessellated solids are closed together, before anything can use them
+   if (!fPendingTessellated.empty() && strcmp(name, tslstr) != 0 && strcmp(name, "triangular") != 0 &&
+       strcmp(name, "quadrangular") != 0)
+      CloseTessellated();
+
    if ((strcmp(name, posistr)) == 0) {
       node = PosProcess(gdml, node, attr);
    } else if ((strcmp(name, rotastr)) == 0) {
@@ -253,11 +437,15 @@ const char *TGDMLParse::ParseGDML(TXMLEngine *gdml, XMLNodePointer_t node)
    } else if ((strcmp(name, setustr)) == 0) {
       node = TopProcess(gdml, node);
    } else if ((strcmp(name, consstr)) == 0) {
+      // the units cannot be redefined by the constants of the file
       node = ConProcess(gdml, node, attr);
+      DefineConstants();
    } else if ((strcmp(name, varistr)) == 0) {
       node = ConProcess(gdml, node, attr);
+      DefineConstants();
    } else if ((strcmp(name, quanstr)) == 0) {
       node = QuantityProcess(gdml, node, attr);
+      DefineConstants();
    } else if ((strcmp(name, matrstr)) == 0) {
       node = MatrixProcess(gdml, node, attr);
    } else if ((strcmp(name, optsstr)) == 0) {
@@ -393,13 +581,37 @@ const char *TGDMLParse::ParseGDML(TXMLEngine *gdml, XMLNodePointer_t node)
    return fWorldName;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Close the tessellated solids read since the last call. Closing a solid
+/// merges the identical vertices of its facets, which is the most expensive
+/// part of reading large meshes; the solids are independent and are closed in
+/// parallel when implicit multi-threading is enabled.
+
+void TGDMLParse::CloseTessellated()
+{
+   const Int_t n = fPendingTessellated.size();
+#ifdef R__USE_IMT
+   if (n > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([this](Int_t i) { fPendingTessellated[i]->CloseShape(false); }, ROOT::TSeqI(n));
+      fPendingTessellated.clear();
+      return;
+   }
+#endif
+   for (Int_t i = 0; i < n; i++)
+      fPendingTessellated[i]->CloseShape(false);
+   fPendingTessellated.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Takes a string containing a mathematical expression and returns the value of
 /// the expression
 
 double TGDMLParse::Evaluate(const char *evalline)
 {
-
+   double val;
+   if (TGDMLExpression(fconsts, evalline).Evaluate(val))
+      return val;
    return TFormula("TFormula", evalline).Eval(0);
 }
 
@@ -766,6 +978,15 @@ Double_t TGDMLParse::Value(const char *svalue) const
    if (*end == 0)
       return val;
 
+   // Most expressions only combine numbers and constants, evaluate them
+   // directly rather than compiling a TFormula for each of them
+   if (TGDMLExpression(fconsts, svalue).Evaluate(val)) {
+      if (std::isnan(val) || std::isinf(val)) {
+         Fatal("Value", "Got bad value %lf from string '%s'", val, svalue);
+      }
+      return val;
+   }
+
    // Otherwise we'll use TFormula to evaluate the string, having first found
    // all the GDML variable names in it and marked them with [] so that
    // TFormula will recognize them as parameters.
@@ -1806,6 +2027,7 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine *gdml, XMLNodePointer_t node)
                   volref = ffilemap[fCurrentFile];
                } else {
                   volref = ParseGDML(gdml2, mainnode2);
+                  CloseTessellated();
                   ffilemap[fCurrentFile] = volref;
                }
 
@@ -4313,7 +4535,8 @@ XMLNodePointer_t TGDMLParse::Tessellated(TXMLEngine *gdml, XMLNodePointer_t node
       }
       child = gdml->GetNext(child);
    }
-   tsl->CloseShape(false);
+   // closed by CloseTessellated(), possibly in parallel with the following tessellated solids
+   fPendingTessellated.push_back(tsl);
 
    fsolmap[name.Data()] = tsl;
 
@@ -46,6 +46,7 @@
 #pragma link C++ class TGeoScale+;
 #pragma link C++ class TGeoIdentity+;
 #pragma link C++ class TGeoVoxelFinder-;
+#pragma link C++ class TGeoBVHFinder-;
 #pragma link C++ class TGeoShape+;
 #pragma link C++ class TGeoHelix+;
 #pragma link C++ class TGeoHalfSpace+;
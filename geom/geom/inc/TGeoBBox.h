@@ -52,11 +52,21 @@ public:
    virtual void          DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t *step) const;
    static  Double_t      DistFromInside(const Double_t *point,const Double_t *dir,
                                    Double_t dx, Double_t dy, Double_t dz, const Double_t *origin, Double_t stepmax=TGeoShape::Big());
+   virtual void          DistFromInsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                           const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                           Double_t *dists, Int_t vecsize, const Double_t *step) const;
    virtual Double_t      DistFromOutside(const Double_t *point, const Double_t *dir, Int_t iact=1,
                                    Double_t step=TGeoShape::Big(), Double_t *safe=0) const;
    virtual void          DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t *step) const;
    static  Double_t      DistFromOutside(const Double_t *point,const Double_t *dir,
                                    Double_t dx, Double_t dy, Double_t dz, const Double_t *origin, Double_t stepmax=TGeoShape::Big());
+   virtual void          DistFromOutsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                            const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                            Double_t *dists, Int_t vecsize, const Double_t *step) const;
+   static  void          DistFromOutsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                            const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                            Double_t *dists, Int_t vecsize, const Double_t *step,
+                                            Double_t boxdx, Double_t boxdy, Double_t boxdz, const Double_t *origin);
    virtual TGeoVolume   *Divide(TGeoVolume *voldiv, const char *divname, Int_t iaxis, Int_t ndiv,
                                 Double_t start, Double_t step);
    virtual const char   *GetAxisName(Int_t iaxis) const;
@@ -82,6 +92,8 @@ public:
    virtual TBuffer3D    *MakeBuffer3D() const;
    virtual Double_t      Safety(const Double_t *point, Bool_t in=kTRUE) const;
    virtual void          Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const;
+   virtual void          SafetySoA(const Double_t *x, const Double_t *y, const Double_t *z, Bool_t in,
+                                   Double_t *safe, Int_t vecsize) const;
    virtual void          SavePrimitive(std::ostream &out, Option_t *option = "");
    void                  SetBoxDimensions(Double_t dx, Double_t dy, Double_t dz, Double_t *origin=0);
    virtual void          SetDimensions(Double_t *param);
@@ -0,0 +1,61 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHFinder
+#define ROOT_TGeoBVHFinder
+
+#include "TGeoVoxelFinder.h"
+
+#include <vector>
+
+class TGeoBVHFinder : public TGeoVoxelFinder
+{
+public:
+   /// Node of the hierarchy. The nodes are stored in depth-first order: the first
+   /// child of an inner node follows it, fIndex is the index of the second child.
+   /// For a leaf, fIndex is the position of its first daughter in fPrimitives.
+   struct Node {
+      Float_t  fMin[3];   // lower corner of the bounding box
+      Float_t  fMax[3];   // upper corner of the bounding box
+      Int_t    fIndex;    // second child, or first daughter of a leaf
+      Int_t    fCount;    // number of daughters of a leaf, 0 for inner nodes
+   };
+
+private:
+   std::vector<Node>  fTree;        //! nodes of the hierarchy, rebuilt after reading
+   std::vector<Int_t> fPrimitives;  //! daughter indices referenced by the leaves
+
+   TGeoBVHFinder(const TGeoBVHFinder&) = delete;
+   TGeoBVHFinder& operator=(const TGeoBVHFinder&) = delete;
+
+   Int_t               BuildNode(Int_t first, Int_t count, Int_t depth);
+   void                BuildTree();
+   void                CheckRebuild() const;
+
+public :
+   TGeoBVHFinder();
+   TGeoBVHFinder(TGeoVolume *vol);
+   virtual ~TGeoBVHFinder();
+
+   virtual Double_t    Efficiency();
+   virtual void        FindOverlaps(Int_t inode) const;
+   virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
+   virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
+   virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
+   virtual Int_t      *GetSafetyCandidates(const Double_t *point, Double_t safmax, Int_t &ncheck, TGeoStateInfo &td);
+   Int_t               GetNnodes() const {return (Int_t)fTree.size();}
+   virtual void        Print(Option_t *option="") const;
+   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td);
+   virtual void        Voxelize(Option_t *option="");
+
+   ClassDef(TGeoBVHFinder, 1)                // bounding volume hierarchy finder
+};
+
+#endif
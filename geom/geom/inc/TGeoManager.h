@@ -12,6 +12,7 @@
 #ifndef ROOT_TGeoManager
 #define ROOT_TGeoManager
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <map>
@@ -123,8 +124,11 @@ private :
    NavigatorsMap_t       fNavigators;       //! Map between thread id's and navigator arrays
    static ThreadsMap_t  *fgThreadId;        //! Thread id's map
    static Int_t          fgNumThreads;      //! Number of registered threads
+   static std::atomic<UInt_t> fgThreadsEpoch;    //! Incremented when the thread id's map is cleared
+   static std::atomic<UInt_t> fgNavigatorsEpoch; //! Incremented when the navigators of any thread change
    static Bool_t         fgLockNavigators;   //! Lock existing navigators
    TGeoNavigator        *fCurrentNavigator; //! current navigator
+   TString               fNavigatorPlugin;  //! plugin handler of the navigators created, Geom.Navigator if empty
    TGeoVolume           *fCurrentVolume;    //! current volume
    TGeoVolume           *fTopVolume;        //! top level volume in geometry
    TGeoNode             *fTopNode;          //! top physical node
@@ -176,6 +180,9 @@ public:
    Int_t                  AddTrack(TVirtualGeoTrack *track);
    Int_t                  AddVolume(TGeoVolume *volume);
    TGeoNavigator         *AddNavigator();
+   TGeoNavigator         *CreateNavigator();
+   const char            *GetNavigatorPlugin() const;
+   void                   SetNavigatorPlugin(const char *name);
    Bool_t                 AddProperty(const char *property, Double_t value);
    Double_t               GetProperty(const char *name, Bool_t *error = nullptr) const;
    Double_t               GetProperty(size_t i, TString &name, Bool_t *error = nullptr) const;
@@ -42,6 +42,16 @@ protected:
    TGeoNode             *CrossDivisionCell();
    void                  SafetyOverlaps();
 
+   /// State of the navigator saved by the multi-track queries
+   struct TSavedState {
+      Double_t  fPoint[3], fDirection[3], fStep, fSafety;
+      TGeoNode *fNextNode;
+      Bool_t    fStartSafe, fIsEntering, fIsExiting, fIsStepEntering, fIsStepExiting, fIsOutside, fIsOnBoundary,
+                fIsSameLocation, fIsNullStep;
+   };
+   void                  SaveState(TSavedState &state);
+   void                  RestoreState(const TSavedState &state);
+
 private :
    Double_t              fStep;             //! step to be done from current point and direction
    Double_t              fSafety;           //! safety radius from current point
@@ -104,20 +114,29 @@ public :
    Int_t                  GetNmany() const {return fNmany;}
    //--- geometry queries
    TGeoNode              *CrossBoundaryAndLocate(Bool_t downwards, TGeoNode *skipnode);
-   TGeoNode              *FindNextBoundary(Double_t stepmax=TGeoShape::Big(),const char *path="", Bool_t frombdr=kFALSE);
+   virtual TGeoNode      *FindNextBoundary(Double_t stepmax=TGeoShape::Big(),const char *path="", Bool_t frombdr=kFALSE);
    TGeoNode              *FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix=kFALSE);
-   TGeoNode              *FindNextBoundaryAndStep(Double_t stepmax=TGeoShape::Big(), Bool_t compsafe=kFALSE);
-   TGeoNode              *FindNode(Bool_t safe_start=kTRUE);
-   TGeoNode              *FindNode(Double_t x, Double_t y, Double_t z);
+   void                   FindNextBoundarySoA(const TGeoVolume *vol, Int_t ntracks,
+                                              const Double_t *x, const Double_t *y, const Double_t *z,
+                                              const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                              Double_t *step, Int_t *inext) const;
+   virtual TGeoNode      *FindNextBoundaryAndStep(Double_t stepmax=TGeoShape::Big(), Bool_t compsafe=kFALSE);
+   virtual TGeoNode      *FindNode(Bool_t safe_start=kTRUE);
+   virtual TGeoNode      *FindNode(Double_t x, Double_t y, Double_t z);
    Double_t              *FindNormal(Bool_t forward=kTRUE);
    Double_t              *FindNormalFast();
    TGeoNode              *InitTrack(const Double_t *point, const Double_t *dir);
    TGeoNode              *InitTrack(Double_t x, Double_t y, Double_t z, Double_t nx, Double_t ny, Double_t nz);
    void                   ResetState();
    void                   ResetAll();
-   Double_t               Safety(Bool_t inside=kFALSE);
+   virtual Double_t       Safety(Bool_t inside=kFALSE);
    TGeoNode              *SearchNode(Bool_t downwards=kFALSE, const TGeoNode *skipnode=0);
    TGeoNode              *Step(Bool_t is_geom=kTRUE, Bool_t cross=kTRUE);
+   //--- multi-track queries, for vecsize points (and directions) in the master frame
+   virtual void           FindNode_v(const Double_t *points, TGeoNode **nodes, Int_t vecsize);
+   virtual void           Safety_v(const Double_t *points, Double_t *safe, Int_t vecsize);
+   virtual void           FindNextBoundary_v(const Double_t *points, const Double_t *dirs, const Double_t *stepmax,
+                                             Double_t *steps, TGeoNode **nextnodes, Int_t vecsize);
    const Double_t        *GetLastPoint() const {return fLastPoint;}
    Int_t                  GetVirtualLevel();
    Bool_t                 GotoSafeLevel();
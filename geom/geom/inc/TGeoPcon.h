@@ -60,9 +60,15 @@ public:
    virtual Double_t      DistFromInside(const Double_t *point, const Double_t *dir, Int_t iact=1,
                                    Double_t step=TGeoShape::Big(), Double_t *safe=0) const;
    virtual void          DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t *step) const;
+   virtual void          DistFromInsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                           const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                           Double_t *dists, Int_t vecsize, const Double_t *step) const;
    virtual Double_t      DistFromOutside(const Double_t *point, const Double_t *dir, Int_t iact=1,
                                    Double_t step=TGeoShape::Big(), Double_t *safe=0) const;
    virtual void          DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t *step) const;
+   virtual void          DistFromOutsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                            const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                            Double_t *dists, Int_t vecsize, const Double_t *step) const;
    Double_t              DistToSegZ(const Double_t *point, const Double_t *dir, Int_t &iz) const;
    virtual Int_t         DistancetoPrimitive(Int_t px, Int_t py);
    virtual TGeoVolume   *Divide(TGeoVolume *voldiv, const char *divname, Int_t iaxis, Int_t ndiv,
@@ -96,6 +102,8 @@ public:
    Double_t             &Z(Int_t ipl) {return fZ[ipl];}
    virtual Double_t      Safety(const Double_t *point, Bool_t in=kTRUE) const;
    virtual void          Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const;
+   virtual void          SafetySoA(const Double_t *x, const Double_t *y, const Double_t *z, Bool_t in,
+                                   Double_t *safe, Int_t vecsize) const;
    Double_t              SafetyToSegment(const Double_t *point, Int_t ipl, Bool_t in=kTRUE, Double_t safmin=TGeoShape::Big()) const;
    virtual void          SavePrimitive(std::ostream &out, Option_t *option = "");
    virtual void          SetDimensions(Double_t *param);
@@ -104,9 +104,15 @@ public:
    virtual Double_t      DistFromInside(const Double_t *point, const Double_t *dir, Int_t iact=1,
                                    Double_t step=TGeoShape::Big(), Double_t *safe=0) const = 0;
    virtual void          DistFromInside_v(const Double_t *, const Double_t *, Double_t *, Int_t, Double_t *) const {}
+   virtual void          DistFromInsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                           const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                           Double_t *dists, Int_t vecsize, const Double_t *step) const;
    virtual Double_t      DistFromOutside(const Double_t *point, const Double_t *dir, Int_t iact=1,
                                    Double_t step=TGeoShape::Big(), Double_t *safe=0) const = 0;
    virtual void          DistFromOutside_v(const Double_t *, const Double_t *, Double_t *, Int_t, Double_t *) const {}
+   virtual void          DistFromOutsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                            const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                            Double_t *dists, Int_t vecsize, const Double_t *step) const;
    static Double_t       DistToPhiMin(const Double_t *point, const Double_t *dir, Double_t s1, Double_t c1, Double_t s2, Double_t c2,
                                       Double_t sm, Double_t cm, Bool_t in=kTRUE);
    virtual TGeoVolume   *Divide(TGeoVolume *voldiv, const char *divname, Int_t iaxis, Int_t ndiv,
@@ -145,6 +151,8 @@ public:
    virtual void          Paint(Option_t *option="");
    virtual Double_t      Safety(const Double_t *point, Bool_t in=kTRUE) const = 0;
    virtual void          Safety_v(const Double_t *, const Bool_t *, Double_t *, Int_t) const {}
+   virtual void          SafetySoA(const Double_t *x, const Double_t *y, const Double_t *z, Bool_t in,
+                                   Double_t *safe, Int_t vecsize) const;
    static  Double_t      SafetyPhi(const Double_t *point, Bool_t in, Double_t phi1, Double_t phi2);
    static  Double_t      SafetySeg(Double_t r, Double_t z, Double_t r1, Double_t z1, Double_t r2, Double_t z2, Bool_t outer);
    virtual void          SetDimensions(Double_t *param)          = 0;
@@ -34,6 +34,7 @@ struct TGeoStateInfo {
    Int_t                fVoxCurrent;     // Index of current voxel in sorted list
    Int_t               *fVoxCheckList;   // List of candidates
    UChar_t             *fVoxBits1;       // Bits used for list intersection
+   Double_t            *fVoxDist;        // Distances to the candidates (bounding volume hierarchy)
    Int_t                fVoxSlices[3];   // Slice indices for current voxel
    Int_t                fVoxInc[3];      // Slice index increment
    Double_t             fVoxInvdir[3];   // 1/current director cosines
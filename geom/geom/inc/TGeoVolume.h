@@ -61,6 +61,7 @@ protected :
    Int_t              fNumber;         //  volume serial number in the list of volumes
    Int_t              fNtotal;         // total number of physical nodes
    Int_t              fRefCount;       // reference counter
+   Bool_t             fBVHVoxels;      // use a bounding volume hierarchy instead of voxels
    TGeoExtension     *fUserExtension;  //! Transient user-defined extension to volumes
    TGeoExtension     *fFWExtension;    //! Transient framework-defined extension to volumes
 
@@ -146,6 +147,7 @@ public:
    Bool_t          IsOverlappingCandidate() const {return TObject::TestBit(kVolumeOC);}
    Bool_t          IsReplicated() const {return TObject::TestBit(kVolumeReplicated);}
    Bool_t          IsSelected() const  {return TObject::TestBit(kVolumeSelected);}
+   Bool_t          IsBVHVoxels() const {return fBVHVoxels;}
    Bool_t          IsCylVoxels() const {return TObject::TestBit(kVoxelsCyl);}
    Bool_t          IsXYZVoxels() const {return TObject::TestBit(kVoxelsXYZ);}
    Bool_t          IsTopVolume() const;
@@ -210,6 +212,7 @@ public:
    void            SetAdded()      {TObject::SetBit(kVolumeAdded);}
    void            SetReplicated() {TObject::SetBit(kVolumeReplicated);}
    void            SetCurrentPoint(Double_t x, Double_t y, Double_t z);
+   void            SetBVHVoxels(Bool_t flag=kTRUE) {fBVHVoxels = flag;}
    void            SetCylVoxels(Bool_t flag=kTRUE) {TObject::SetBit(kVoxelsCyl, flag); TObject::SetBit(kVoxelsXYZ, !flag);}
    void            SetNodes(TObjArray *nodes) {fNodes = nodes; TObject::SetBit(kVolumeImportNodes);}
    void            SetOverlappingCandidate(Bool_t flag) {TObject::SetBit(kVolumeOC,flag);}
@@ -240,7 +243,7 @@ public:
    Double_t        Weight(Double_t precision=0.01, Option_t *option="va"); // *MENU*
    Double_t        WeightA() const;
 
-   ClassDef(TGeoVolume, 6)              // geometry volume descriptor
+   ClassDef(TGeoVolume, 7)              // geometry volume descriptor
 };
 
 ////////////////////////////////////////////////////////////////////////////
@@ -100,6 +100,7 @@ public :
    virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
    Int_t              *GetCheckList(Int_t &nelem, TGeoStateInfo &td) const;
    virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
+   virtual Int_t      *GetSafetyCandidates(const Double_t *point, Double_t safmax, Int_t &ncheck, TGeoStateInfo &td);
    virtual void        FindOverlaps(Int_t inode) const;
    Bool_t              IsInvalid() const {return TObject::TestBit(kGeoInvalidVoxels);}
    Bool_t              NeedRebuild() const {return TObject::TestBit(kGeoRebuildVoxels);}
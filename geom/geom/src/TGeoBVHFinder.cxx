@@ -0,0 +1,573 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoBVHFinder
+\ingroup Geometry_classes
+
+Finder class using a bounding volume hierarchy (BVH) of the bounding boxes of
+the daughters, instead of the 3D slices of TGeoVoxelFinder.
+
+The slices degrade for volumes with thousands of daughters of very different
+sizes, where a few large daughters spread over many slices. The hierarchy is
+built top-down with the surface area heuristic (SAH) on binned centroids, in
+O(n log n), and uses O(n) memory. Its nodes are stored in depth-first order in a
+contiguous array of 32-byte nodes, with single precision boxes rounded outwards.
+
+The hierarchy is selected per volume with TGeoVolume::SetBVHVoxels(), before
+closing the geometry:
+~~~{.cpp}
+   calorimeter->SetBVHVoxels();
+   gGeoManager->CloseGeometry();
+~~~
+It answers the same queries as TGeoVoxelFinder, used by the navigator in
+FindNode(), FindNextBoundary() and Safety(). The candidates crossed by a ray are
+returned by GetNextVoxel() one by one, in order of distance to their bounding
+box, until this distance exceeds the current step.
+
+The hierarchy is not written to files: it is rebuilt when first used.
+*/
+
+#include "TGeoBVHFinder.h"
+
+#include "TBuffer.h"
+#include "TMath.h"
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TGeoManager.h"
+#include "TGeoStateInfo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ClassImp(TGeoBVHFinder);
+
+namespace {
+
+const Int_t kNbins = 16;           // number of bins for the SAH
+const Int_t kMaxLeafSize = 4;      // leaves are split at least down to this size
+const Int_t kMaxDepth = 64;        // maximum depth of the hierarchy, size of the traversal stacks
+const Double_t kTraversalCost = 0.5; // cost of a node traversal w.r.t. the check of a daughter
+
+/// Round a double to the closest float which is lower or equal.
+Float_t RoundDown(Double_t val)
+{
+   Float_t f = (Float_t)val;
+   if ((Double_t)f > val) f = std::nextafter(f, -std::numeric_limits<Float_t>::max());
+   return f;
+}
+
+/// Round a double to the closest float which is greater or equal.
+Float_t RoundUp(Double_t val)
+{
+   Float_t f = (Float_t)val;
+   if ((Double_t)f < val) f = std::nextafter(f, std::numeric_limits<Float_t>::max());
+   return f;
+}
+
+/// Half of the surface area of a box.
+Double_t HalfArea(const Double_t *bmin, const Double_t *bmax)
+{
+   Double_t dx = bmax[0]-bmin[0];
+   Double_t dy = bmax[1]-bmin[1];
+   Double_t dz = bmax[2]-bmin[2];
+   return dx*dy + dy*dz + dz*dx;
+}
+
+/// Distance along the ray to the box, or a negative value if the box is not crossed.
+/// The distance is 0 for points inside the box.
+Double_t DistToBox(const Double_t *point, const Double_t *dir, const Double_t *bmin, const Double_t *bmax)
+{
+   Double_t tmin = 0.;
+   Double_t tmax = TGeoShape::Big();
+   for (Int_t i=0; i<3; i++) {
+      if (dir[i] == 0) {
+         if (point[i] < bmin[i] || point[i] > bmax[i]) return -1.;
+         continue;
+      }
+      Double_t invdir = 1./dir[i];
+      Double_t t1 = (bmin[i]-point[i])*invdir;
+      Double_t t2 = (bmax[i]-point[i])*invdir;
+      if (t1 > t2) std::swap(t1, t2);
+      if (t1 > tmin) tmin = t1;
+      if (t2 < tmax) tmax = t2;
+      if (tmin > tmax) return -1.;
+   }
+   return tmin;
+}
+
+/// Squared distance from a point to a box, 0 inside.
+Double_t Dist2ToBox(const Double_t *point, const Double_t *bmin, const Double_t *bmax)
+{
+   Double_t d2 = 0.;
+   for (Int_t i=0; i<3; i++) {
+      Double_t d = TMath::Max(bmin[i]-point[i], point[i]-bmax[i]);
+      if (d > 0) d2 += d*d;
+   }
+   return d2;
+}
+
+/// Limits of the bounding box of a daughter, enlarged by the tolerance.
+void DaughterLimits(const Double_t *boxes, Int_t id, Double_t *bmin, Double_t *bmax)
+{
+   const Double_t *box = &boxes[6*id];
+   for (Int_t i=0; i<3; i++) {
+      bmin[i] = box[i+3] - box[i] - TGeoShape::Tolerance();
+      bmax[i] = box[i+3] + box[i] + TGeoShape::Tolerance();
+   }
+}
+
+/// Limits of a node of the hierarchy.
+void NodeLimits(const TGeoBVHFinder::Node &node, Double_t *bmin, Double_t *bmax)
+{
+   for (Int_t i=0; i<3; i++) {
+      bmin[i] = node.fMin[i];
+      bmax[i] = node.fMax[i];
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+TGeoBVHFinder::TGeoBVHFinder() : TGeoVoxelFinder()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor for the volume VOL.
+
+TGeoBVHFinder::TGeoBVHFinder(TGeoVolume *vol) : TGeoVoxelFinder(vol)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoBVHFinder::~TGeoBVHFinder()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rebuild the hierarchy if the volume changed, or after reading it from a file.
+
+void TGeoBVHFinder::CheckRebuild() const
+{
+   if (NeedRebuild() || (fTree.empty() && fVolume->GetNdaughters())) {
+      TGeoBVHFinder *bvh = (TGeoBVHFinder*)this;
+      bvh->Voxelize();
+      fVolume->FindOverlaps();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the hierarchy of the bounding boxes computed by BuildVoxelLimits().
+
+void TGeoBVHFinder::BuildTree()
+{
+   Int_t nd = fVolume->GetNdaughters();
+   fTree.clear();
+   fPrimitives.resize(nd);
+   for (Int_t id=0; id<nd; id++) fPrimitives[id] = id;
+   if (!nd) return;
+   fTree.reserve(2*nd);
+   BuildNode(0, nd, 0);
+   fTree.shrink_to_fit();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the subtree of the COUNT daughters starting at position FIRST in
+/// fPrimitives and return the index of its root node. The daughters are split
+/// in two with the binned surface area heuristic.
+
+Int_t TGeoBVHFinder::BuildNode(Int_t first, Int_t count, Int_t depth)
+{
+   Int_t inode = fTree.size();
+   fTree.push_back(Node());
+   // bounds of the boxes and of their centers
+   Double_t bmin[3], bmax[3], cmin[3], cmax[3];
+   Double_t dmin[3], dmax[3];
+   for (Int_t i=0; i<3; i++) {
+      bmin[i] = cmin[i] = TGeoShape::Big();
+      bmax[i] = cmax[i] = -TGeoShape::Big();
+   }
+   for (Int_t ip=first; ip<first+count; ip++) {
+      Int_t id = fPrimitives[ip];
+      DaughterLimits(fBoxes, id, dmin, dmax);
+      for (Int_t i=0; i<3; i++) {
+         bmin[i] = TMath::Min(bmin[i], dmin[i]);
+         bmax[i] = TMath::Max(bmax[i], dmax[i]);
+         cmin[i] = TMath::Min(cmin[i], fBoxes[6*id+3+i]);
+         cmax[i] = TMath::Max(cmax[i], fBoxes[6*id+3+i]);
+      }
+   }
+   for (Int_t i=0; i<3; i++) {
+      fTree[inode].fMin[i] = RoundDown(bmin[i]);
+      fTree[inode].fMax[i] = RoundUp(bmax[i]);
+   }
+   fTree[inode].fIndex = first;
+   fTree[inode].fCount = count;
+   if (count <= 1 || depth >= kMaxDepth-1) return inode;
+
+   // find the best split among the bin boundaries of the three axes
+   Int_t bestAxis = -1;
+   Int_t bestSplit = 0;
+   Double_t bestCost = TGeoShape::Big();
+   Int_t binCount[kNbins];
+   Double_t binMin[kNbins][3], binMax[kNbins][3];
+   Double_t rightArea[kNbins];
+   Int_t rightCount[kNbins];
+   for (Int_t iaxis=0; iaxis<3; iaxis++) {
+      Double_t extent = cmax[iaxis]-cmin[iaxis];
+      if (extent <= 0) continue;
+      Double_t scale = kNbins/extent;
+      for (Int_t ib=0; ib<kNbins; ib++) {
+         binCount[ib] = 0;
+         for (Int_t i=0; i<3; i++) {
+            binMin[ib][i] = TGeoShape::Big();
+            binMax[ib][i] = -TGeoShape::Big();
+         }
+      }
+      for (Int_t ip=first; ip<first+count; ip++) {
+         Int_t id = fPrimitives[ip];
+         Int_t ib = TMath::Min(kNbins-1, Int_t((fBoxes[6*id+3+iaxis]-cmin[iaxis])*scale));
+         binCount[ib]++;
+         DaughterLimits(fBoxes, id, dmin, dmax);
+         for (Int_t i=0; i<3; i++) {
+            binMin[ib][i] = TMath::Min(binMin[ib][i], dmin[i]);
+            binMax[ib][i] = TMath::Max(binMax[ib][i], dmax[i]);
+         }
+      }
+      // sweep from the right, then from the left
+      Double_t smin[3], smax[3];
+      for (Int_t i=0; i<3; i++) {
+         smin[i] = TGeoShape::Big();
+         smax[i] = -TGeoShape::Big();
+      }
+      Int_t n = 0;
+      for (Int_t ib=kNbins-1; ib>0; ib--) {
+         n += binCount[ib];
+         for (Int_t i=0; i<3; i++) {
+            smin[i] = TMath::Min(smin[i], binMin[ib][i]);
+            smax[i] = TMath::Max(smax[i], binMax[ib][i]);
+         }
+         rightCount[ib] = n;
+         rightArea[ib] = n ? HalfArea(smin, smax) : 0.;
+      }
+      for (Int_t i=0; i<3; i++) {
+         smin[i] = TGeoShape::Big();
+         smax[i] = -TGeoShape::Big();
+      }
+      n = 0;
+      for (Int_t ib=0; ib<kNbins-1; ib++) {
+         n += binCount[ib];
+         for (Int_t i=0; i<3; i++) {
+            smin[i] = TMath::Min(smin[i], binMin[ib][i]);
+            smax[i] = TMath::Max(smax[i], binMax[ib][i]);
+         }
+         if (!n || !rightCount[ib+1]) continue;
+         Double_t cost = n*HalfArea(smin, smax) + rightCount[ib+1]*rightArea[ib+1];
+         if (cost < bestCost) {
+            bestCost = cost;
+            bestAxis = iaxis;
+            bestSplit = ib+1;
+         }
+      }
+   }
+   // all centers are the same: nothing to split
+   if (bestAxis < 0) return inode;
+   Double_t area = HalfArea(bmin, bmax);
+   Double_t splitCost = kTraversalCost + ((area > 0) ? bestCost/area : count);
+   if (splitCost >= count && count <= kMaxLeafSize) return inode;
+
+   // partition the daughters w.r.t. the split bin
+   Double_t scale = kNbins/(cmax[bestAxis]-cmin[bestAxis]);
+   Int_t *begin = &fPrimitives[first];
+   const Double_t *boxes = fBoxes;
+   const Double_t cmin0 = cmin[bestAxis];
+   Int_t *middle = std::partition(begin, begin+count, [&](Int_t id) {
+      return TMath::Min(kNbins-1, Int_t((boxes[6*id+3+bestAxis]-cmin0)*scale)) < bestSplit;
+   });
+   Int_t nleft = middle-begin;
+   if (nleft == 0 || nleft == count) return inode;
+
+   fTree[inode].fCount = 0;
+   BuildNode(first, nleft, depth+1);
+   Int_t right = BuildNode(first+nleft, count-nleft, depth+1);
+   fTree[inode].fIndex = right;
+   return inode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the average number of daughters per leaf and return its inverse.
+
+Double_t TGeoBVHFinder::Efficiency()
+{
+   printf("BVH efficiency for %s\n", fVolume->GetName());
+   CheckRebuild();
+   Int_t nleaves = 0;
+   for (auto &node : fTree) if (node.fCount) nleaves++;
+   if (!nleaves) return 0.;
+   Double_t eff = Double_t(nleaves)/fVolume->GetNdaughters();
+   printf("Nodes : %d  leaves : %d  daughters per leaf : %g\n", (Int_t)fTree.size(), nleaves, 1./eff);
+   return eff;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the list of nodes for which the bboxes overlap with inode's bbox,
+/// searching only the leaves of the hierarchy which are overlapping it.
+
+void TGeoBVHFinder::FindOverlaps(Int_t inode) const
+{
+   if (!fBoxes || fTree.empty()) return;
+   TGeoNode *node = fVolume->GetNode(inode);
+   Double_t omin[3], omax[3], bmin[3], bmax[3];
+   for (Int_t i=0; i<3; i++) {
+      omin[i] = fBoxes[6*inode+3+i] - fBoxes[6*inode+i];
+      omax[i] = fBoxes[6*inode+3+i] + fBoxes[6*inode+i];
+   }
+   std::vector<Int_t> ovlps;
+   Int_t stack[kMaxDepth+1];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t itree = stack[--nstack];
+      const Node &current = fTree[itree];
+      NodeLimits(current, bmin, bmax);
+      if (bmin[0] >= omax[0] || bmax[0] <= omin[0] ||
+          bmin[1] >= omax[1] || bmax[1] <= omin[1] ||
+          bmin[2] >= omax[2] || bmax[2] <= omin[2]) continue;
+      if (!current.fCount) {
+         stack[nstack++] = current.fIndex;
+         stack[nstack++] = itree+1;
+         continue;
+      }
+      for (Int_t ip=current.fIndex; ip<current.fIndex+current.fCount; ip++) {
+         Int_t ib = fPrimitives[ip];
+         if (ib == inode) continue; // everyone overlaps with itself
+         // same criterion as TGeoVoxelFinder::FindOverlaps
+         Bool_t overlap = kTRUE;
+         for (Int_t i=0; i<3; i++) {
+            Double_t ddx1 = omax[i] - (fBoxes[6*ib+3+i] - fBoxes[6*ib+i]);
+            Double_t ddx2 = (fBoxes[6*ib+3+i] + fBoxes[6*ib+i]) - omin[i];
+            if (ddx1*ddx2 <= 0.) {
+               overlap = kFALSE;
+               break;
+            }
+         }
+         if (overlap) ovlps.push_back(ib);
+      }
+   }
+   if (ovlps.empty()) {
+      node->SetOverlaps(0, 0);
+      return;
+   }
+   std::sort(ovlps.begin(), ovlps.end());
+   Int_t *list = new Int_t[ovlps.size()];
+   std::copy(ovlps.begin(), ovlps.end(), list);
+   node->SetOverlaps(list, ovlps.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughters whose bounding box contains POINT, in increasing order.
+
+Int_t *TGeoBVHFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td)
+{
+   CheckRebuild();
+   nelem = 0;
+   if (fTree.empty()) return 0;
+   Double_t bmin[3], bmax[3];
+   Int_t stack[kMaxDepth+1];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Node &current = fTree[inode];
+      if (point[0] < current.fMin[0] || point[0] > current.fMax[0] ||
+          point[1] < current.fMin[1] || point[1] > current.fMax[1] ||
+          point[2] < current.fMin[2] || point[2] > current.fMax[2]) continue;
+      if (!current.fCount) {
+         stack[nstack++] = current.fIndex;
+         stack[nstack++] = inode+1;
+         continue;
+      }
+      for (Int_t ip=current.fIndex; ip<current.fIndex+current.fCount; ip++) {
+         Int_t id = fPrimitives[ip];
+         DaughterLimits(fBoxes, id, bmin, bmax);
+         if (point[0] < bmin[0] || point[0] > bmax[0] ||
+             point[1] < bmin[1] || point[1] > bmax[1] ||
+             point[2] < bmin[2] || point[2] > bmax[2]) continue;
+         td.fVoxCheckList[nelem++] = id;
+      }
+   }
+   td.fVoxNcandidates = nelem;
+   if (!nelem) return 0;
+   std::sort(td.fVoxCheckList, td.fVoxCheckList+nelem);
+   return td.fVoxCheckList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// All the candidates are computed by SortCrossedVoxels(), see GetNextVoxel().
+
+Int_t *TGeoBVHFinder::GetNextCandidates(const Double_t * /*point*/, Int_t &ncheck, TGeoStateInfo & /*td*/)
+{
+   ncheck = 0;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the next daughter crossed by the ray given to SortCrossedVoxels(): this is
+/// the remaining candidate with the closest bounding box. Returns 0 when the
+/// closest bounding box is beyond the current step.
+
+Int_t *TGeoBVHFinder::GetNextVoxel(const Double_t * /*point*/, const Double_t * /*dir*/, Int_t &ncheck, TGeoStateInfo &td)
+{
+   CheckRebuild();
+   ncheck = 0;
+   Int_t n = td.fVoxNcandidates;
+   Int_t cur = td.fVoxCurrent;
+   if (cur >= n) return 0;
+   Int_t imin = cur;
+   for (Int_t i=cur+1; i<n; i++) {
+      if (td.fVoxDist[i] < td.fVoxDist[imin]) imin = i;
+   }
+   std::swap(td.fVoxDist[cur], td.fVoxDist[imin]);
+   std::swap(td.fVoxCheckList[cur], td.fVoxCheckList[imin]);
+   if (td.fVoxDist[cur] > gGeoManager->GetStep()) {
+      td.fVoxCurrent = n;
+      return 0;
+   }
+   td.fVoxCurrent++;
+   ncheck = 1;
+   return &td.fVoxCheckList[cur];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughters whose bounding box is closer than SAFMAX to POINT,
+/// skipping the subtrees which are farther.
+
+Int_t *TGeoBVHFinder::GetSafetyCandidates(const Double_t *point, Double_t safmax, Int_t &ncheck, TGeoStateInfo &td)
+{
+   CheckRebuild();
+   ncheck = 0;
+   if (fTree.empty()) return 0;
+   Double_t safmax2 = safmax*safmax;
+   Double_t bmin[3], bmax[3];
+   Int_t stack[kMaxDepth+1];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Node &current = fTree[inode];
+      NodeLimits(current, bmin, bmax);
+      if (Dist2ToBox(point, bmin, bmax) >= safmax2) continue;
+      if (!current.fCount) {
+         stack[nstack++] = current.fIndex;
+         stack[nstack++] = inode+1;
+         continue;
+      }
+      for (Int_t ip=current.fIndex; ip<current.fIndex+current.fCount; ip++) {
+         Int_t id = fPrimitives[ip];
+         DaughterLimits(fBoxes, id, bmin, bmax);
+         if (Dist2ToBox(point, bmin, bmax) >= safmax2) continue;
+         td.fVoxCheckList[ncheck++] = id;
+      }
+   }
+   td.fVoxNcandidates = ncheck;
+   return td.fVoxCheckList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hierarchy.
+
+void TGeoBVHFinder::Print(Option_t *) const
+{
+   printf("Bounding volume hierarchy of %s: %d daughters, %d nodes\n",
+          fVolume->GetName(), fVolume->GetNdaughters(), (Int_t)fTree.size());
+   Int_t nleaves = 0, maxleaf = 0;
+   for (auto &node : fTree) {
+      if (!node.fCount) continue;
+      nleaves++;
+      maxleaf = TMath::Max(maxleaf, node.fCount);
+   }
+   printf("   %d leaves, at most %d daughters per leaf\n", nleaves, maxleaf);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the daughters whose bounding boxes are crossed by the ray starting at POINT
+/// along DIR. They are stored with the distances to their boxes, such that
+/// GetNextVoxel() returns them in order of distance.
+
+void TGeoBVHFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td)
+{
+   CheckRebuild();
+   td.fVoxCurrent = 0;
+   td.fVoxNcandidates = 0;
+   if (fTree.empty()) return;
+   Int_t ncheck = 0;
+   Double_t bmin[3], bmax[3];
+   Int_t stack[kMaxDepth+1];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Node &current = fTree[inode];
+      NodeLimits(current, bmin, bmax);
+      if (DistToBox(point, dir, bmin, bmax) < 0) continue;
+      if (!current.fCount) {
+         stack[nstack++] = current.fIndex;
+         stack[nstack++] = inode+1;
+         continue;
+      }
+      for (Int_t ip=current.fIndex; ip<current.fIndex+current.fCount; ip++) {
+         Int_t id = fPrimitives[ip];
+         DaughterLimits(fBoxes, id, bmin, bmax);
+         Double_t snext = DistToBox(point, dir, bmin, bmax);
+         if (snext < 0) continue;
+         td.fVoxCheckList[ncheck] = id;
+         td.fVoxDist[ncheck] = snext;
+         ncheck++;
+      }
+   }
+   td.fVoxNcandidates = ncheck;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the bounding boxes of the daughters and build the hierarchy.
+/// If the volume is an assembly, make sure the bbox is computed.
+
+void TGeoBVHFinder::Voxelize(Option_t * /*option*/)
+{
+   if (fVolume->IsAssembly()) fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   for (Int_t i=0; i<nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly()) vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   BuildTree();
+   SetNeedRebuild(kFALSE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream an object of class TGeoBVHFinder.
+
+void TGeoBVHFinder::Streamer(TBuffer &R__b)
+{
+   if (R__b.IsReading()) {
+      R__b.ReadClassBuffer(TGeoBVHFinder::Class(), this);
+      // the hierarchy is rebuilt when first used
+      SetNeedRebuild();
+   } else {
+      R__b.WriteClassBuffer(TGeoBVHFinder::Class(), this);
+   }
+}
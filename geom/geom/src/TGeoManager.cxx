@@ -237,8 +237,12 @@ in order to enhance rays.
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "TROOT.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 #include "TGeoManager.h"
 #include "TStyle.h"
 #include "TVirtualPad.h"
@@ -298,6 +302,8 @@ Int_t  TGeoManager::fgMaxLevel        = 1;
 Int_t  TGeoManager::fgMaxDaughters    = 1;
 Int_t  TGeoManager::fgMaxXtruVert     = 1;
 Int_t  TGeoManager::fgNumThreads      = 0;
+std::atomic<UInt_t> TGeoManager::fgThreadsEpoch(0);
+std::atomic<UInt_t> TGeoManager::fgNavigatorsEpoch(1);
 UInt_t TGeoManager::fgExportPrecision = 17;
 TGeoManager::EDefaultUnits TGeoManager::fgDefaultUnits = TGeoManager::kG4Units;
 TGeoManager::ThreadsMap_t *TGeoManager::fgThreadId = 0;
@@ -728,25 +734,86 @@ TGeoNavigator *TGeoManager::AddNavigator()
    }
    TGeoNavigator *nav = array->AddNavigator();
    if (fClosed) nav->GetCache()->BuildInfoBranch();
+   ++fgNavigatorsEpoch;
    if (fMultiThread) fgMutex.unlock();
    return nav;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Create a navigator for this geometry, not added to the lists of navigators.
+/// The navigator is a TGeoNavigator unless a navigator plugin was selected by
+/// SetNavigatorPlugin(), see there.
+
+TGeoNavigator *TGeoManager::CreateNavigator()
+{
+   TString name = GetNavigatorPlugin();
+   if (!name.IsNull() && name != "root") {
+      TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("TGeoNavigator", name);
+      if (h && h->LoadPlugin() != -1) {
+         TGeoNavigator *nav = (TGeoNavigator *)h->ExecPlugin(1, this);
+         if (nav)
+            return nav;
+      }
+      Error("CreateNavigator", "Navigator plugin %s cannot be loaded, using TGeoNavigator", name.Data());
+      fNavigatorPlugin = "root";
+   }
+   return new TGeoNavigator(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the plugin handler of TGeoNavigator used to create the
+/// navigators, "root" for TGeoNavigator itself.
+
+const char *TGeoManager::GetNavigatorPlugin() const
+{
+   if (fNavigatorPlugin.IsNull())
+      return gEnv->GetValue("Geom.Navigator", "root");
+   return fNavigatorPlugin.Data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Select the class of the navigators created from now on, by the name of a
+/// plugin handler of TGeoNavigator. The plugin must derive from TGeoNavigator
+/// and have a constructor taking the TGeoManager. "root" selects TGeoNavigator
+/// itself, and an empty name the value of the Geom.Navigator resource
+/// (default "root"), so that the navigation engine can be chosen in .rootrc
+/// without changing the code of the application:
+/// ~~~ {.cpp}
+///    gGeoManager->SetNavigatorPlugin("myengine");
+///    gGeoManager->ClearNavigators(); // the existing navigators are not replaced
+///    gGeoManager->AddNavigator();
+/// ~~~
+/// The navigators already created are kept.
+
+void TGeoManager::SetNavigatorPlugin(const char *name)
+{
+   fNavigatorPlugin = name ? name : "";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns current navigator for the calling thread.
+/// The navigator is cached per thread, together with the manager and the epoch
+/// of the navigators maps, so the lookup does not lock unless a navigator was
+/// added, removed or switched since the last call.
 
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
+   TTHREAD_TLS(const TGeoManager*) tmgr = 0;
+   TTHREAD_TLS(UInt_t) tepoch = 0;
    TTHREAD_TLS(TGeoNavigator*) tnav = 0;
    if (!fMultiThread) return fCurrentNavigator;
-   TGeoNavigator *nav = tnav; // TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav) return nav;
+   UInt_t epoch = fgNavigatorsEpoch.load(std::memory_order_acquire);
+   if (tmgr == this && tepoch == epoch) return tnav;
+   TGeoNavigator *nav = 0;
    std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
-   nav = array->GetCurrentNavigator();
-   tnav = nav; // TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
+   {
+      std::lock_guard<std::mutex> guard(fgMutex);
+      NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
+      if (it != fNavigators.end()) nav = it->second->GetCurrentNavigator();
+   }
+   tmgr = this;
+   tepoch = epoch;
+   tnav = nav;
    return nav;
 }
 
@@ -756,9 +823,10 @@ TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 {
    std::thread::id threadId = std::this_thread::get_id();
+   if (fMultiThread) fgMutex.lock();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
+   TGeoNavigatorArray *array = (it == fNavigators.end()) ? 0 : it->second;
+   if (fMultiThread) fgMutex.unlock();
    return array;
 }
 
@@ -768,14 +836,17 @@ TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
 {
    std::thread::id threadId = std::this_thread::get_id();
+   if (fMultiThread) fgMutex.lock();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) {
+   TGeoNavigatorArray *array = (it == fNavigators.end()) ? 0 : it->second;
+   if (fMultiThread) fgMutex.unlock();
+   if (!array) {
       Error("SetCurrentNavigator", "No navigator defined for this thread\n");
       std::cout << "  thread id: " << threadId << std::endl;
       return kFALSE;
    }
-   TGeoNavigatorArray *array = it->second;
    TGeoNavigator *nav = array->SetCurrentNavigator(index);
+   ++fgNavigatorsEpoch;
    if (!nav) {
       Error("SetCurrentNavigator", "Navigator %d not existing for this thread\n", index);
       std::cout << "  thread id: " << threadId << std::endl;
@@ -806,6 +877,7 @@ void TGeoManager::ClearNavigators()
       if (arr) delete arr;
    }
    fNavigators.clear();
+   ++fgNavigatorsEpoch;
    if (fMultiThread) fgMutex.unlock();
 }
 
@@ -821,6 +893,7 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
             if (!arr->GetEntries()) fNavigators.erase(it);
+            ++fgNavigatorsEpoch;
             if (fMultiThread) fgMutex.unlock();
             return;
          }
@@ -895,28 +968,35 @@ void TGeoManager::ClearThreadsMap()
    fgMutex.lock();
    if (!fgThreadId->empty()) fgThreadId->clear();
    fgNumThreads = 0;
+   ++fgThreadsEpoch;
    fgMutex.unlock();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Translates the current thread id to an ordinal number. This can be used to
-/// manage data which is specific for a given thread.
+/// manage data which is specific for a given thread. The ordinal is cached per
+/// thread and stays valid until the map of threads is cleared, in which case the
+/// thread is registered again.
 
 Int_t TGeoManager::ThreadId()
 {
    TTHREAD_TLS(Int_t) tid = -1;
+   TTHREAD_TLS(UInt_t) tepoch = 0;
    Int_t ttid = tid; // TTHREAD_TLS_GET(Int_t,tid);
-   if (ttid > -1) return ttid;
+   if (ttid > -1 && tepoch == fgThreadsEpoch.load(std::memory_order_acquire)) return ttid;
    if (gGeoManager && !gGeoManager->IsMultiThread()) return 0;
    std::thread::id threadId = std::this_thread::get_id();
+   std::lock_guard<std::mutex> guard(fgMutex);
    TGeoManager::ThreadsMapIt_t it = fgThreadId->find(threadId);
-   if (it != fgThreadId->end()) return it->second;
-   // Map needs to be updated.
-   fgMutex.lock();
-   (*fgThreadId)[threadId] = fgNumThreads;
-   tid = fgNumThreads; // TTHREAD_TLS_SET(Int_t,tid,fgNumThreads);
-   ttid = fgNumThreads++;
-   fgMutex.unlock();
+   if (it != fgThreadId->end()) {
+      ttid = it->second;
+   } else {
+      // Map needs to be updated.
+      ttid = fgNumThreads++;
+      (*fgThreadId)[threadId] = ttid;
+   }
+   tid = ttid; // TTHREAD_TLS_SET(Int_t,tid,ttid);
+   tepoch = fgThreadsEpoch.load(std::memory_order_relaxed);
    return ttid;
 }
 
@@ -2883,17 +2963,38 @@ void TGeoManager::RestoreMasterVolume()
 void TGeoManager::Voxelize(Option_t *option)
 {
    TGeoVolume *vol;
-//   TGeoVoxelFinder *vox = 0;
    if (!fStreamVoxels && fgVerboseLevel>0) Info("Voxelize","Voxelizing...");
-//   Int_t nentries = fVolumes->GetSize();
+   // Sort the nodes and compute the bounding boxes of assemblies first, since
+   // the voxelization of a volume reads those of its daughters.
+   std::vector<TGeoVolume*> serial, parallel;
    TIter next(fVolumes);
    while ((vol = (TGeoVolume*)next())) {
       if (!fIsGeomReading) vol->SortNodes();
-      if (!fStreamVoxels) {
-         vol->Voxelize(option);
+      Bool_t concurrent = !vol->TestBit(TGeoVolume::kVolumeImportNodes);
+      if (vol->IsAssembly() && vol->GetNdaughters()) {
+         TGeoBBox *box = (TGeoBBox*)vol->GetShape();
+         box->ComputeBBox();
+         // a flat assembly box is recomputed at each voxelization
+         if (box->GetDX()<=0 || box->GetDY()<=0 || box->GetDZ()<=0) concurrent = kFALSE;
       }
-      if (!fIsGeomReading) vol->FindOverlaps();
+      // Volumes sharing the nodes of another volume are not processed concurrently
+      if (concurrent) parallel.push_back(vol);
+      else            serial.push_back(vol);
+   }
+   if (fStreamVoxels && fIsGeomReading) return;
+   auto voxelize = [this, option](TGeoVolume *v) {
+      if (!fStreamVoxels) v->Voxelize(option);
+      if (!fIsGeomReading) v->FindOverlaps();
+   };
+   for (auto v : serial) voxelize(v);
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && parallel.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(voxelize, parallel);
+      return;
    }
+#endif
+   for (auto v : parallel) voxelize(v);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
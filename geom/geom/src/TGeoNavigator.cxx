@@ -29,6 +29,13 @@ gGeoManager->SetCurrentNavigator(inav);
 gGeoManager->SetCurrentNavigator(0);
 ~~~
 
+The geometry queries FindNode, FindNextBoundary, FindNextBoundaryAndStep and
+Safety are virtual, so that another navigation engine can be plugged in by
+deriving from TGeoNavigator, see TGeoManager::SetNavigatorPlugin. The
+multi-track queries FindNode_v, Safety_v and FindNextBoundary_v answer for
+many points at once and leave the state of the navigator unchanged; the
+default implementations loop over the scalar queries, derived navigators
+may process the points together.
 */
 
 #include "TGeoNavigator.h"
@@ -43,6 +50,8 @@ gGeoManager->SetCurrentNavigator(0);
 #include "TGeoParallelWorld.h"
 #include "TGeoPhysicalNode.h"
 
+#include <vector>
+
 static Double_t gTolerance = TGeoShape::Tolerance();
 const char *kGeoOutsidePath = " ";
 const Int_t kN3 = 3*sizeof(Double_t);
@@ -1114,6 +1123,97 @@ TGeoNode *TGeoNavigator::FindNextDaughterBoundary(Double_t *point, Double_t *dir
    return nodefound;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the next boundary of a basket of tracks located in the same volume,
+/// for transport codes which group the tracks by volume. The points and directions
+/// of the tracks are given in the local frame of VOL as structures of arrays.
+/// Each of the shapes of VOL and of its daughters is queried once for the whole
+/// basket, see TGeoShape::DistFromInsideSoA() and TGeoShape::DistFromOutsideSoA().
+///
+/// On input step[i] is the maximum step of track i, on output it is the distance to
+/// the next boundary if this is closer. On output inext[i] is the index of the
+/// daughter entered by track i, -1 if it leaves VOL and -2 if no boundary is closer
+/// than the maximum step. The state of the navigator is not used. The daughters are
+/// checked in sequence, without voxels, and overlapping (MANY) nodes are not handled:
+/// FindNextBoundary() should be used for such volumes.
+
+void TGeoNavigator::FindNextBoundarySoA(const TGeoVolume *vol, Int_t ntracks,
+                                        const Double_t *x, const Double_t *y, const Double_t *z,
+                                        const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                        Double_t *step, Int_t *inext) const
+{
+   if (ntracks<=0) return;
+   std::vector<Double_t> dist(ntracks);
+   vol->GetShape()->DistFromInsideSoA(x, y, z, dx, dy, dz, dist.data(), ntracks, step);
+   for (Int_t i=0; i<ntracks; i++) {
+      inext[i] = -2;
+      if (dist[i]<step[i]) {
+         step[i] = dist[i];
+         inext[i] = -1;
+      }
+   }
+   Int_t nd = vol->GetNdaughters();
+   if (!nd) return;
+   // Points and directions in the frame of the current daughter
+   std::vector<Double_t> local(6*ntracks);
+   Double_t *lx = &local[0];
+   Double_t *ly = lx + ntracks;
+   Double_t *lz = ly + ntracks;
+   Double_t *ldx = lz + ntracks;
+   Double_t *ldy = ldx + ntracks;
+   Double_t *ldz = ldy + ntracks;
+   for (Int_t id=0; id<nd; id++) {
+      TGeoNode *node = vol->GetNode(id);
+      const TGeoMatrix *mat = node->GetMatrix();
+      const Double_t *px = x, *py = y, *pz = z;
+      const Double_t *pdx = dx, *pdy = dy, *pdz = dz;
+      if (mat->IsScale()) {
+         Double_t master[3], loc[3];
+         for (Int_t i=0; i<ntracks; i++) {
+            master[0] = x[i]; master[1] = y[i]; master[2] = z[i];
+            mat->MasterToLocal(master, loc);
+            lx[i] = loc[0]; ly[i] = loc[1]; lz[i] = loc[2];
+            master[0] = dx[i]; master[1] = dy[i]; master[2] = dz[i];
+            mat->MasterToLocalVect(master, loc);
+            ldx[i] = loc[0]; ldy[i] = loc[1]; ldz[i] = loc[2];
+         }
+         px = lx; py = ly; pz = lz;
+         pdx = ldx; pdy = ldy; pdz = ldz;
+      } else if (!mat->IsIdentity()) {
+         const Double_t *tr = mat->GetTranslation();
+         if (mat->IsRotation()) {
+            const Double_t *rot = mat->GetRotationMatrix();
+            for (Int_t i=0; i<ntracks; i++) {
+               const Double_t mt0 = x[i]-tr[0];
+               const Double_t mt1 = y[i]-tr[1];
+               const Double_t mt2 = z[i]-tr[2];
+               lx[i] = mt0*rot[0] + mt1*rot[3] + mt2*rot[6];
+               ly[i] = mt0*rot[1] + mt1*rot[4] + mt2*rot[7];
+               lz[i] = mt0*rot[2] + mt1*rot[5] + mt2*rot[8];
+               ldx[i] = dx[i]*rot[0] + dy[i]*rot[3] + dz[i]*rot[6];
+               ldy[i] = dx[i]*rot[1] + dy[i]*rot[4] + dz[i]*rot[7];
+               ldz[i] = dx[i]*rot[2] + dy[i]*rot[5] + dz[i]*rot[8];
+            }
+            pdx = ldx; pdy = ldy; pdz = ldz;
+         } else {
+            for (Int_t i=0; i<ntracks; i++) {
+               lx[i] = x[i]-tr[0];
+               ly[i] = y[i]-tr[1];
+               lz[i] = z[i]-tr[2];
+            }
+         }
+         px = lx; py = ly; pz = lz;
+      }
+      node->GetVolume()->GetShape()->DistFromOutsideSoA(px, py, pz, pdx, pdy, pdz, dist.data(), ntracks, step);
+      for (Int_t i=0; i<ntracks; i++) {
+         if (dist[i]<step[i]) {
+            step[i] = dist[i];
+            inext[i] = id;
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute distance to next boundary within STEPMAX. If no boundary is found,
 /// propagate current point along current direction with fStep=STEPMAX. Otherwise
@@ -1521,6 +1621,106 @@ TGeoNode *TGeoNavigator::FindNode(Double_t x, Double_t y, Double_t z)
    return found;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Save the current point, direction and flags, together with the current path
+/// pushed on the stack of the cache.
+
+void TGeoNavigator::SaveState(TSavedState &state)
+{
+   memcpy(state.fPoint, fPoint, kN3);
+   memcpy(state.fDirection, fDirection, kN3);
+   state.fStep = fStep;
+   state.fSafety = fSafety;
+   state.fNextNode = fNextNode;
+   state.fStartSafe = fStartSafe;
+   state.fIsEntering = fIsEntering;
+   state.fIsExiting = fIsExiting;
+   state.fIsStepEntering = fIsStepEntering;
+   state.fIsStepExiting = fIsStepExiting;
+   state.fIsOutside = fIsOutside;
+   state.fIsOnBoundary = fIsOnBoundary;
+   state.fIsSameLocation = fIsSameLocation;
+   state.fIsNullStep = fIsNullStep;
+   PushPath();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restore the state saved by SaveState.
+
+void TGeoNavigator::RestoreState(const TSavedState &state)
+{
+   PopPath();
+   memcpy(fPoint, state.fPoint, kN3);
+   memcpy(fDirection, state.fDirection, kN3);
+   fStep = state.fStep;
+   fSafety = state.fSafety;
+   fNextNode = state.fNextNode;
+   fStartSafe = state.fStartSafe;
+   fIsEntering = state.fIsEntering;
+   fIsExiting = state.fIsExiting;
+   fIsStepEntering = state.fIsStepEntering;
+   fIsStepExiting = state.fIsStepExiting;
+   fIsOutside = state.fIsOutside;
+   fIsOnBoundary = state.fIsOnBoundary;
+   fIsSameLocation = state.fIsSameLocation;
+   fIsNullStep = state.fIsNullStep;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the deepest nodes containing the vecsize points, given as consecutive
+/// triplets of master coordinates. nodes[i] is null for points outside of the
+/// geometry. The state of the navigator is not changed.
+
+void TGeoNavigator::FindNode_v(const Double_t *points, TGeoNode **nodes, Int_t vecsize)
+{
+   TSavedState state;
+   SaveState(state);
+   for (Int_t i = 0; i < vecsize; i++) {
+      TGeoNode *node = FindNode(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+      nodes[i] = fIsOutside ? nullptr : node;
+   }
+   RestoreState(state);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distances of the vecsize points, given as consecutive
+/// triplets of master coordinates, as Safety() would after locating them.
+/// The state of the navigator is not changed.
+
+void TGeoNavigator::Safety_v(const Double_t *points, Double_t *safe, Int_t vecsize)
+{
+   TSavedState state;
+   SaveState(state);
+   for (Int_t i = 0; i < vecsize; i++) {
+      FindNode(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+      safe[i] = Safety();
+   }
+   RestoreState(state);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute for vecsize tracks, starting at points along the unit directions
+/// dirs (consecutive triplets in the master frame), the distances to the next
+/// boundary, limited to stepmax[i] if stepmax is not null, as FindNextBoundary()
+/// would after locating the points. nextnodes, if not null, receives the nodes
+/// returned by FindNextBoundary. The state of the navigator is not changed.
+
+void TGeoNavigator::FindNextBoundary_v(const Double_t *points, const Double_t *dirs, const Double_t *stepmax,
+                                       Double_t *steps, TGeoNode **nextnodes, Int_t vecsize)
+{
+   TSavedState state;
+   SaveState(state);
+   for (Int_t i = 0; i < vecsize; i++) {
+      FindNode(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+      SetCurrentDirection(&dirs[3 * i]);
+      TGeoNode *next = FindNextBoundary(stepmax ? stepmax[i] : TGeoShape::Big());
+      steps[i] = fStep;
+      if (nextnodes)
+         nextnodes[i] = next;
+   }
+   RestoreState(state);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Computes fast normal to next crossed boundary, assuming that the current point
 /// is close enough to the boundary. Works only after calling FindNextBoundary.
@@ -1689,7 +1889,11 @@ Double_t TGeoNavigator::Safety(Bool_t inside)
 
    //---> check fast unsafe voxels
    Double_t *boxes = voxels->GetBoxes();
-   for (id=0; id<nd; id++) {
+   Int_t ncheck = 0;
+   TGeoStateInfo &info = *fCache->GetInfo();
+   Int_t *check_list = voxels->GetSafetyCandidates(point, fSafety, ncheck, info);
+   for (Int_t i=0; i<ncheck; i++) {
+      id = check_list[i];
       Int_t ist = 6*id;
       Double_t dxyz = 0.;
       Double_t dxyz0 = TMath::Abs(point[0]-boxes[ist+3])-boxes[ist];
@@ -1705,12 +1909,14 @@ Double_t TGeoNavigator::Safety(Bool_t inside)
       node = (TGeoNode*)nodes->UncheckedAt(id);
       safe = node->Safety(point, kFALSE);
       if (safe<gTolerance) {
+         fCache->ReleaseInfo();
          fSafety=0;
          fIsOnBoundary = kTRUE;
          return fSafety;
       }
       if (safe<fSafety) fSafety = safe;
    }
+   fCache->ReleaseInfo();
    if (fNmany  && !inside) SafetyOverlaps();
    return fSafety;
 }
@@ -2560,7 +2766,7 @@ ClassImp(TGeoNavigatorArray);
 TGeoNavigator *TGeoNavigatorArray::AddNavigator()
 {
    SetOwner(kTRUE);
-   TGeoNavigator *nav = new TGeoNavigator(fGeoManager);
+   TGeoNavigator *nav = fGeoManager->CreateNavigator();
    nav->BuildCache(kTRUE, kFALSE);
    Add(nav);
    SetCurrentNavigator(GetEntriesFast()-1);
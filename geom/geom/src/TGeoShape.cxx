@@ -431,6 +431,56 @@ Double_t TGeoShape::DistToPhiMin(const Double_t *point, const Double_t *dir, Dou
    return TMath::Min(sfi1, sfi2);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distances from a basket of points inside the shape, having the
+/// directions stored as structures of arrays (x, y, z) and (dx, dy, dz), to the
+/// surface of the shape. The distance of track i is stored in dists[i].
+/// This default implementation calls DistFromInside() track by track, the
+/// primitive shapes override it with loops that the compiler can vectorize.
+
+void TGeoShape::DistFromInsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                  const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                  Double_t *dists, Int_t vecsize, const Double_t *step) const
+{
+   Double_t point[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      point[0] = x[i]; point[1] = y[i]; point[2] = z[i];
+      dir[0] = dx[i]; dir[1] = dy[i]; dir[2] = dz[i];
+      dists[i] = DistFromInside(point, dir, 3, step[i]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distances from a basket of points outside the shape to its surface,
+/// see DistFromInsideSoA(). The distance is TGeoShape::Big() for the tracks which
+/// do not hit the shape within step[i].
+
+void TGeoShape::DistFromOutsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                   const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                   Double_t *dists, Int_t vecsize, const Double_t *step) const
+{
+   Double_t point[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      point[0] = x[i]; point[1] = y[i]; point[2] = z[i];
+      dir[0] = dx[i]; dir[1] = dy[i]; dir[2] = dz[i];
+      dists[i] = DistFromOutside(point, dir, 3, step[i]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distances of a basket of points stored as a structure of arrays,
+/// which are all inside (or all outside) the shape.
+
+void TGeoShape::SafetySoA(const Double_t *x, const Double_t *y, const Double_t *z, Bool_t in,
+                          Double_t *safe, Int_t vecsize) const
+{
+   Double_t point[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      point[0] = x[i]; point[1] = y[i]; point[2] = z[i];
+      safe[i] = Safety(point, in);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static method to compute normal to phi planes.
 
@@ -39,6 +39,7 @@ TGeoStateInfo::TGeoStateInfo(Int_t maxdaughters)
                fVoxCurrent(0),
                fVoxCheckList(0),
                fVoxBits1(0),
+               fVoxDist(0),
                fBoolSelected(0),
                fXtruSeg(0),
                fXtruIz(0),
@@ -50,6 +51,7 @@ TGeoStateInfo::TGeoStateInfo(Int_t maxdaughters)
    Int_t maxXtruVert  = TGeoManager::GetMaxXtruVert();
    fVoxCheckList = new Int_t[maxDaughters];
    fVoxBits1 = new UChar_t[2 + ((maxDaughters-1)>>3)];
+   fVoxDist = new Double_t[maxDaughters];
    fXtruXc = new Double_t[maxXtruVert];
    fXtruYc = new Double_t[maxXtruVert];
    fVoxSlices[0] = fVoxSlices[1] = fVoxSlices[2] = -1;
@@ -65,6 +67,7 @@ TGeoStateInfo::~TGeoStateInfo()
 {
    delete [] fVoxCheckList;
    delete [] fVoxBits1;
+   delete [] fVoxDist;
    delete [] fXtruXc;
    delete [] fXtruYc;
 }
@@ -771,3 +771,61 @@ void TGeoTrd1::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *
 {
    for (Int_t i=0; i<vecsize; i++) safe[i] = Safety(&points[3*i], inside[i]);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distances to the surface from a basket of inside points, stored as
+/// structures of arrays, with direct calls to the algorithm of this shape.
+/// Derived shapes which do not override it use the implementation of TGeoShape.
+
+void TGeoTrd1::DistFromInsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                 const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                 Double_t *dists, Int_t vecsize, const Double_t *step) const
+{
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoShape::DistFromInsideSoA(x, y, z, dx, dy, dz, dists, vecsize, step);
+      return;
+   }
+   Double_t point[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      point[0] = x[i]; point[1] = y[i]; point[2] = z[i];
+      dir[0] = dx[i]; dir[1] = dy[i]; dir[2] = dz[i];
+      dists[i] = TGeoTrd1::DistFromInside(point, dir, 3, step[i]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distances to the surface from a basket of outside points, see DistFromInsideSoA().
+
+void TGeoTrd1::DistFromOutsideSoA(const Double_t *x, const Double_t *y, const Double_t *z,
+                                  const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                  Double_t *dists, Int_t vecsize, const Double_t *step) const
+{
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoShape::DistFromOutsideSoA(x, y, z, dx, dy, dz, dists, vecsize, step);
+      return;
+   }
+   Double_t point[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      point[0] = x[i]; point[1] = y[i]; point[2] = z[i];
+      dir[0] = dx[i]; dir[1] = dy[i]; dir[2] = dz[i];
+      dists[i] = TGeoTrd1::DistFromOutside(point, dir, 3, step[i]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distances of a basket of points stored as a structure of arrays,
+/// which are all inside (or all outside) the shape.
+
+void TGeoTrd1::SafetySoA(const Double_t *x, const Double_t *y, const Double_t *z, Bool_t in,
+                         Double_t *safe, Int_t vecsize) const
+{
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoShape::SafetySoA(x, y, z, in, safe, vecsize);
+      return;
+   }
+   Double_t point[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      point[0] = x[i]; point[1] = y[i]; point[2] = z[i];
+      safe[i] = TGeoTrd1::Safety(point, in);
+   }
+}
@@ -400,6 +400,7 @@ volumes (or volume assemblies) as content.
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHFinder.h"
 #include "TGeoExtension.h"
 
 ClassImp(TGeoVolume);
@@ -458,6 +459,7 @@ TGeoVolume::TGeoVolume()
    fNumber   = 0;
    fNtotal   = 0;
    fRefCount = 0;
+   fBVHVoxels = kFALSE;
    fUserExtension = 0;
    fFWExtension = 0;
    TObject::ResetBit(kVolumeImportNodes);
@@ -490,6 +492,7 @@ TGeoVolume::TGeoVolume(const char *name, const TGeoShape *shape, const TGeoMediu
    fNumber   = 0;
    fNtotal   = 0;
    fRefCount = 0;
+   fBVHVoxels = kFALSE;
    fUserExtension = 0;
    fFWExtension = 0;
    if (fGeoManager) fNumber = fGeoManager->AddVolume(this);
@@ -1742,8 +1745,9 @@ TGeoVolume *TGeoVolume::CloneVolume() const
    vol->SetFinder(fFinder);
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetBVHVoxels(fBVHVoxels);
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = fBVHVoxels ? new TGeoBVHFinder(vol) : new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2297,7 +2301,8 @@ void TGeoVolume::VisibleDaughters(Bool_t vis)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// build the voxels for this volume
+/// build the voxels for this volume, or its bounding volume hierarchy if
+/// selected with SetBVHVoxels()
 
 void TGeoVolume::Voxelize(Option_t *option)
 {
@@ -2318,7 +2323,8 @@ void TGeoVolume::Voxelize(Option_t *option)
       fVoxels = 0;
    }
    // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   if (fBVHVoxels) fVoxels = new TGeoBVHFinder(this);
+   else            fVoxels = new TGeoVoxelFinder(this);
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -2845,8 +2851,9 @@ TGeoVolume *TGeoVolumeAssembly::CloneVolume() const
    ((TGeoShapeAssembly*)vol->GetShape())->NeedsBBoxRecompute();
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetBVHVoxels(fBVHVoxels);
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = fBVHVoxels ? new TGeoBVHFinder(vol) : new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2930,8 +2937,9 @@ TGeoVolumeAssembly *TGeoVolumeAssembly::MakeAssemblyFromVolume(TGeoVolume *volor
    vol->GetShape()->ComputeBBox();
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetBVHVoxels(volorig->IsBVHVoxels());
    if (volorig->GetVoxels()) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = volorig->IsBVHVoxels() ? new TGeoBVHFinder(vol) : new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
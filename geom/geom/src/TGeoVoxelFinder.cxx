@@ -342,6 +342,38 @@ void TGeoVoxelFinder::FindOverlaps(Int_t inode) const
    node->SetOverlaps(ovlps, novlp);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughters whose bounding box is closer than SAFMAX to POINT,
+/// used to compute the safe distance to the daughters.
+
+Int_t *TGeoVoxelFinder::GetSafetyCandidates(const Double_t *point, Double_t safmax, Int_t &ncheck, TGeoStateInfo &td)
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   ncheck = 0;
+   Int_t nd = fVolume->GetNdaughters();
+   Double_t safmax2 = safmax*safmax;
+   for (Int_t id=0; id<nd; id++) {
+      Int_t ist = 6*id;
+      Double_t dxyz = 0.;
+      Double_t dxyz0 = TMath::Abs(point[0]-fBoxes[ist+3])-fBoxes[ist];
+      if (dxyz0 > safmax) continue;
+      Double_t dxyz1 = TMath::Abs(point[1]-fBoxes[ist+4])-fBoxes[ist+1];
+      if (dxyz1 > safmax) continue;
+      Double_t dxyz2 = TMath::Abs(point[2]-fBoxes[ist+5])-fBoxes[ist+2];
+      if (dxyz2 > safmax) continue;
+      if (dxyz0>0) dxyz+=dxyz0*dxyz0;
+      if (dxyz1>0) dxyz+=dxyz1*dxyz1;
+      if (dxyz2>0) dxyz+=dxyz2*dxyz2;
+      if (dxyz >= safmax2) continue;
+      td.fVoxCheckList[ncheck++] = id;
+   }
+   td.fVoxNcandidates = ncheck;
+   return td.fVoxCheckList;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get indices for current slices on x, y, z
 
@@ -16,6 +16,9 @@
 
 #include "TAttCanvas.h"
 
+#include <string>
+#include <vector>
+
 class TCanvasImp;
 class TContextMenu;
 class TControlBar;
@@ -226,6 +229,7 @@ public:
    void                DeleteCanvasPainter();
 
    static TCanvas   *MakeDefCanvas();
+   static Bool_t     SaveAll(const std::vector<TPad *> &pads, const std::vector<std::string> &filenames, UInt_t nworkers = 1);
    static Bool_t     SupportAlpha();
 
    ClassDefOverride(TCanvas,8)  //Graphics canvas
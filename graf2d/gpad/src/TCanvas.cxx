@@ -44,11 +44,17 @@
 #include "TGraph.h"
 #include "TMath.h"
 #include "TView.h"
+#include "TSystem.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
 #include "TVirtualMutex.h"
 
+#ifndef _MSC_VER
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 class TCanvasInit {
 public:
    TCanvasInit() { TApplication::NeedGraphicsLibs(); }
@@ -1815,6 +1821,60 @@ void TCanvas::SavePrimitive(std::ostream &out, Option_t *option /*= ""*/)
    TPad::SavePrimitive(out,option);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Save each pad of pads in the file of the same index in filenames, with
+/// TPad::SaveAs. The file type is given by the extension of the file name
+/// (png, pdf, svg, ...).
+///
+/// In batch mode, with nworkers > 1, the files are produced by nworkers
+/// forked processes, each painting its copy of the pads. The painting
+/// (gPad, gVirtualPS, TASImage) relies on global state and cannot run
+/// in several threads, but the processes are independent. This is the
+/// fastest way to export a large number of plots, e.g.
+/// ~~~ {.cpp}
+///   std::vector<TPad *> pads;
+///   std::vector<std::string> names;
+///   ...
+///   TCanvas::SaveAll(pads, names, 8);
+/// ~~~
+/// Without batch mode, or on Windows, the pads are saved one after the other
+/// in this process.
+///
+/// Return kTRUE if all the files were produced.
+
+Bool_t TCanvas::SaveAll(const std::vector<TPad *> &pads, const std::vector<std::string> &filenames, UInt_t nworkers)
+{
+   if (pads.size() != filenames.size()) {
+      ::Error("TCanvas::SaveAll", "%d pads for %d file names", (Int_t)pads.size(), (Int_t)filenames.size());
+      return kFALSE;
+   }
+   const UInt_t n = pads.size();
+
+   auto save = [&](UInt_t i) {
+      TPad *pad = pads[i];
+      if (!pad) return 0;
+      TVirtualPad *padsav = gPad;
+      pad->SaveAs(filenames[i].c_str());
+      gPad = padsav;
+      return gSystem->AccessPathName(filenames[i].c_str()) ? 0 : 1;
+   };
+
+   UInt_t nsaved = 0;
+#ifndef _MSC_VER
+   if (nworkers > 1 && n > 1 && gROOT->IsBatch()) {
+      // forked processes cannot share a connection to the display, therefore batch mode only
+      ROOT::TProcessExecutor workers(TMath::Min(nworkers, n));
+      auto results = workers.Map(save, ROOT::TSeqU(n));
+      for (auto res : results) nsaved += res;
+      return nsaved == n;
+   }
+#else
+   (void) nworkers;
+#endif
+   for (UInt_t i = 0; i < n; i++) nsaved += save(i);
+   return nsaved == n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitives in this canvas as a C++ macro file.
 /// This function loops on all the canvas primitives and for each primitive
@@ -12,6 +12,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include "TROOT.h"
 #include "TBuffer.h"
@@ -4255,6 +4256,113 @@ void TPad::PaintLine3D(Double_t *p1, Double_t *p2)
    PaintLine(xpad[0],xpad[1],xpad[3],xpad[4]);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Number of cells per pixel of the pad used to decimate the polylines and
+/// polymarkers sent to gVirtualPS (resource Canvas.PSDecimation, 0 disables
+/// the decimation). ncols and nrows are set to the resolution of the pad in
+/// cells.
+
+static Bool_t GetPSDecimation(TVirtualPad *pad, Int_t &ncols, Int_t &nrows)
+{
+   Int_t factor = gEnv->GetValue("Canvas.PSDecimation", 4);
+   if (factor <= 0) return kFALSE;
+   ncols = factor * Int_t(pad->GetWw() * pad->GetAbsWNDC());
+   nrows = factor * Int_t(pad->GetWh() * pad->GetAbsHNDC());
+   return ncols > 0 && nrows > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reduce a polyline of n points to what is visible at the resolution of the
+/// output: the consecutive points falling in the same cell column are replaced
+/// by the first, the lowest, the highest and the last of them, in this order
+/// along the line. Return the number of points in xd, yd, or 0 if the line
+/// does not need to be reduced.
+
+template <typename T>
+static Int_t DecimatePolyLine(TVirtualPad *pad, Int_t n, const T *x, const T *y, std::vector<T> &xd, std::vector<T> &yd)
+{
+   Int_t ncols, nrows;
+   if (!GetPSDecimation(pad, ncols, nrows) || n <= 4*ncols) return 0;
+   const Double_t x1 = pad->GetX1();
+   const Double_t scale = ncols / (pad->GetX2() - x1);
+   xd.clear();
+   yd.clear();
+   xd.reserve(4*ncols);
+   yd.reserve(4*ncols);
+   auto add = [&](Int_t i) { xd.push_back(x[i]); yd.push_back(y[i]); };
+   Int_t i = 0;
+   while (i < n) {
+      const Long64_t col = (Long64_t)TMath::Floor((x[i] - x1) * scale);
+      Int_t imin = i, imax = i, last = i;
+      while (last+1 < n && (Long64_t)TMath::Floor((x[last+1] - x1) * scale) == col) {
+         last++;
+         if (y[last] < y[imin]) imin = last;
+         if (y[last] > y[imax]) imax = last;
+      }
+      add(i);
+      Int_t ilow = TMath::Min(imin, imax), ihigh = TMath::Max(imin, imax);
+      if (ilow != i) add(ilow);
+      if (ihigh != ilow && ihigh != i) add(ihigh);
+      if (last != ihigh && last != i) add(last);
+      i = last + 1;
+   }
+   return (Int_t)xd.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reduce a polymarker of n points to what is visible at the resolution of the
+/// output: a marker falling in the same cell as the previous one is dropped.
+/// Return the number of points in xd, yd, or 0 if the markers do not need
+/// to be reduced.
+
+template <typename T>
+static Int_t DecimatePolyMarker(TVirtualPad *pad, Int_t n, const T *x, const T *y, std::vector<T> &xd, std::vector<T> &yd)
+{
+   Int_t ncols, nrows;
+   if (!GetPSDecimation(pad, ncols, nrows) || n <= 4*ncols) return 0;
+   const Double_t x1 = pad->GetX1();
+   const Double_t y1 = pad->GetY1();
+   const Double_t xscale = ncols / (pad->GetX2() - x1);
+   const Double_t yscale = nrows / (pad->GetY2() - y1);
+   xd.clear();
+   yd.clear();
+   Long64_t lastcol = 0, lastrow = 0;
+   for (Int_t i = 0; i < n; i++) {
+      const Long64_t col = (Long64_t)TMath::Floor((x[i] - x1) * xscale);
+      const Long64_t row = (Long64_t)TMath::Floor((y[i] - y1) * yscale);
+      if (i > 0 && col == lastcol && row == lastrow) continue;
+      xd.push_back(x[i]);
+      yd.push_back(y[i]);
+      lastcol = col;
+      lastrow = row;
+   }
+   return (Int_t)xd.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Draw a polyline with gVirtualPS, decimated to the output resolution.
+
+template <typename T>
+static void DrawPSPolyLine(TVirtualPad *pad, Int_t n, T *x, T *y)
+{
+   std::vector<T> xd, yd;
+   Int_t nd = DecimatePolyLine(pad, n, x, y, xd, yd);
+   if (nd > 0) gVirtualPS->DrawPS(nd, xd.data(), yd.data());
+   else        gVirtualPS->DrawPS(n, x, y);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Draw a polymarker with gVirtualPS, decimated to the output resolution.
+
+template <typename T>
+static void DrawPSPolyMarker(TVirtualPad *pad, Int_t n, T *x, T *y)
+{
+   std::vector<T> xd, yd;
+   Int_t nd = DecimatePolyMarker(pad, n, x, y, xd, yd);
+   if (nd > 0) gVirtualPS->DrawPolyMarker(nd, xd.data(), yd.data());
+   else        gVirtualPS->DrawPolyMarker(n, x, y);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Paint polyline in CurrentPad World coordinates.
 
@@ -4285,7 +4393,7 @@ void TPad::PaintPolyLine(Int_t n, Float_t *x, Float_t *y, Option_t *)
       if (!gPad->IsBatch() && GetPainter())
          GetPainter()->DrawPolyLine(np, &x[i1], &y[i1]);
       if (gVirtualPS) {
-         gVirtualPS->DrawPS(np, &x[i1], &y[i1]);
+         DrawPSPolyLine(this, np, &x[i1], &y[i1]);
       }
       if (iclip) {
          x[i] = x1;
@@ -4338,7 +4446,7 @@ void TPad::PaintPolyLine(Int_t n, Double_t *x, Double_t *y, Option_t *option)
       if (!gPad->IsBatch() && GetPainter())
          GetPainter()->DrawPolyLine(np, &x[i1], &y[i1]);
       if (gVirtualPS) {
-         gVirtualPS->DrawPS(np, &x[i1], &y[i1]);
+         DrawPSPolyLine(this, np, &x[i1], &y[i1]);
       }
       if (iclip) {
          x[i] = x1;
@@ -4414,7 +4522,7 @@ void TPad::PaintPolyMarker(Int_t nn, Float_t *x, Float_t *y, Option_t *)
       if (!gPad->IsBatch() && GetPainter())
          GetPainter()->DrawPolyMarker(np, &x[i1], &y[i1]);
       if (gVirtualPS) {
-         gVirtualPS->DrawPolyMarker(np, &x[i1], &y[i1]);
+         DrawPSPolyMarker(this, np, &x[i1], &y[i1]);
       }
       i1 = -1;
       np = 0;
@@ -4445,7 +4553,7 @@ void TPad::PaintPolyMarker(Int_t nn, Double_t *x, Double_t *y, Option_t *)
       if (!gPad->IsBatch() && GetPainter())
          GetPainter()->DrawPolyMarker(np, &x[i1], &y[i1]);
       if (gVirtualPS) {
-         gVirtualPS->DrawPolyMarker(np, &x[i1], &y[i1]);
+         DrawPSPolyMarker(this, np, &x[i1], &y[i1]);
       }
       i1 = -1;
       np = 0;
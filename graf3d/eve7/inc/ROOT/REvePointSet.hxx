@@ -45,6 +45,7 @@ protected:
    std::vector<REveVector> fPoints;
    int                     fCapacity{0};
    int                     fSize{0};
+   int                     fMaxRenderedPoints{0}; ///< Maximum number of points sent to the clients, 0 for all
 
 public:
    REvePointSet(const std::string& name="", const std::string& title="", Int_t n_points = 0);
@@ -64,6 +65,9 @@ public:
    int   GetCapacity() const { return fCapacity; }
    int   GetSize()     const { return fSize;     }
 
+   int   GetMaxRenderedPoints() const { return fMaxRenderedPoints; }
+   void  SetMaxRenderedPoints(int n);
+
          REveVector& RefPoint(int n)       { assert (n < fSize); return fPoints[n]; }
    const REveVector& RefPoint(int n) const { assert (n < fSize); return fPoints[n]; }
 
@@ -14,6 +14,7 @@
 
 #include <ROOT/REveVector.hxx>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -29,7 +30,16 @@ private:
    std::vector<int>   fIndexBuffer;
    std::vector<float> fMatrix;
 
+   bool                  fQuantizeV{fgQuantizeV}; ///< Whether the vertices may be sent quantized
+   std::vector<uint16_t> fQuantVertexBuffer;      ///< Quantized vertices, filled by Quantize()
+   float                 fQuantV[6]{0};           ///< Minimum and step of the quantized vertex components
+
+   static bool fgQuantizeV; ///< Default of fQuantizeV
+
 public:
+   /// Smallest vertex buffer quantized, smaller buffers are always sent as floats
+   static constexpr int kMinQuantizedSize = 3 * 256;
+
    // If Primitive_e is changed, change also definition in EveElements.js.
 
    enum Primitive_e { GL_POINTS = 0, GL_LINES, GL_LINE_LOOP, GL_LINE_STRIP, GL_TRIANGLES };
@@ -88,6 +98,16 @@ public:
 
    void SetMatrix(const double *arr);
 
+   static void SetDefaultQuantizeV(bool on) { fgQuantizeV = on; }
+   static bool GetDefaultQuantizeV() { return fgQuantizeV; }
+
+   void SetQuantizeV(bool on) { fQuantizeV = on; }
+   bool GetQuantizeV() const { return fQuantizeV; }
+
+   void  Quantize();
+   bool  IsQuantizedV() const { return !fQuantVertexBuffer.empty(); }
+   const float *GetQuantizationV() const { return fQuantV; }
+
    const std::string GetRnrFunc() const { return fRnrFunc; }
 
    int SizeV() const { return fVertexBuffer.size(); }
@@ -95,7 +115,11 @@ public:
    int SizeI() const { return fIndexBuffer.size(); }
    int SizeT() const { return fMatrix.size(); }
 
-   int GetBinarySize() { return (SizeV() + SizeN() + SizeT()) * sizeof(float) + SizeI() * sizeof(int); }
+   int GetBinarySize()
+   {
+      int size_v = IsQuantizedV() ? (SizeV() * sizeof(uint16_t) + 3) / 4 * 4 : SizeV() * sizeof(float);
+      return size_v + (SizeN() + SizeT()) * sizeof(float) + SizeI() * sizeof(int);
+   }
 
    int Write(char *msg, int maxlen);
 };
@@ -1491,6 +1491,12 @@ Int_t REveElement::WriteCoreJson(nlohmann::json &j, Int_t rnr_offset)
          rd["index_size"] = fRenderData->SizeI();
          rd["trans_size"] = fRenderData->SizeT();
 
+         fRenderData->Quantize();
+         if (fRenderData->IsQuantizedV()) {
+            const float *q = fRenderData->GetQuantizationV();
+            rd["vert_quant"] = std::vector<float>(q, q + 6);
+         }
+
          j["render_data"] = rd;
 
          ret = fRenderData->GetBinarySize();
@@ -38,6 +38,9 @@ Setting of per-point TRef's is not supported.
 
 REvePointSet is a REveProjectable: it can be projected by using the
 REveProjectionManager class.
+
+For very large sets, SetMaxRenderedPoints() limits the number of points
+sent to the clients: a regular sample of the points is then displayed.
 */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -65,7 +68,8 @@ REvePointSet::REvePointSet(const REvePointSet& e) :
    REveElement(e),
    REveProjectable(e),
    TAttMarker(e),
-   TAttBBox(e)
+   TAttBBox(e),
+   fMaxRenderedPoints(e.fMaxRenderedPoints)
 {
 }
 
@@ -138,6 +142,16 @@ int REvePointSet::SetPoint(int n, float x, float y, float z)
    return fSize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of points sent to the clients, 0 to send all of them.
+/// Larger sets are displayed by a regular sample of their points.
+
+void REvePointSet::SetMaxRenderedPoints(int n)
+{
+   fMaxRenderedPoints = std::max(n, 0);
+   StampObjProps();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set marker style, propagate to projecteds.
 
@@ -182,6 +196,7 @@ void REvePointSet::CopyVizParams(const REveElement* el)
    if (m)
    {
       TAttMarker::operator=(*m);
+      fMaxRenderedPoints = m->fMaxRenderedPoints;
    }
 
    REveElement::CopyVizParams(el);
@@ -221,7 +236,16 @@ Int_t REvePointSet::WriteCoreJson(nlohmann::json& j, Int_t rnr_offset)
 
 void REvePointSet::BuildRenderData()
 {
-   if (fSize > 0)
+   if (fSize > 0 && fMaxRenderedPoints > 0 && fSize > fMaxRenderedPoints)
+   {
+      // every stride-th point, so that the sample spans the whole set
+      int stride = (fSize + fMaxRenderedPoints - 1) / fMaxRenderedPoints;
+      int n      = (fSize + stride - 1) / stride;
+      fRenderData = std::make_unique<REveRenderData>("makeHit", 3*n);
+      for (int i = 0; i < fSize; i += stride)
+         fRenderData->PushV(fPoints[i]);
+   }
+   else if (fSize > 0)
    {
       fRenderData = std::make_unique<REveRenderData>("makeHit", 3*fSize);
       fRenderData->PushV(&fPoints[0].fX, 3*fSize);
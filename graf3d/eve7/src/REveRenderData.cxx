@@ -12,11 +12,26 @@
 #include <ROOT/REveRenderData.hxx>
 #include <ROOT/REveUtil.hxx>
 
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 
 using namespace ROOT::Experimental;
 
+/** \class REveRenderData
+\ingroup REve
+Vertex, normal and index buffers of an element, sent to the clients as
+binary data.
+
+Large vertex buffers can be sent quantized, each component as a 16-bit
+integer on the range of its values, which halves their size. The precision
+is then 1/65535 of the extent of the vertices in each direction. This is
+enabled for a buffer with SetQuantizeV(), or for all buffers created from
+now on with SetDefaultQuantizeV().
+*/
+
+bool REveRenderData::fgQuantizeV = false;
+
 /////////////////////////////////////////////////////////////////////////////////////////
 /// Constructor
 
@@ -58,8 +73,16 @@ int REveRenderData::Write(char *msg, int maxlen)
    if (!fMatrix.empty())
       append(&fMatrix[0], fMatrix.size() * sizeof(float));
 
-   if (!fVertexBuffer.empty())
+   if (IsQuantizedV()) {
+      append(&fQuantVertexBuffer[0], fQuantVertexBuffer.size() * sizeof(uint16_t));
+      // keep the following buffers aligned on 4 bytes
+      static const char pad[4] = {0, 0, 0, 0};
+      int npad = (4 - off % 4) % 4;
+      if (npad)
+         append((void *) pad, npad);
+   } else if (!fVertexBuffer.empty()) {
       append(&fVertexBuffer[0], fVertexBuffer.size() * sizeof(float));
+   }
 
    if (!fNormalBuffer.empty())
       append(&fNormalBuffer[0], fNormalBuffer.size() * sizeof(float));
@@ -70,6 +93,44 @@ int REveRenderData::Write(char *msg, int maxlen)
    return off;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+/// Quantize the vertex buffer if enabled and large enough. Each of the x, y and
+/// z components is mapped to 16 bits on the range of its values: a component
+/// is min + q * step, with min and step returned by GetQuantizationV() as
+/// {min_x, min_y, min_z, step_x, step_y, step_z}.
+
+void REveRenderData::Quantize()
+{
+   fQuantVertexBuffer.clear();
+   if (!fQuantizeV || SizeV() < kMinQuantizedSize || SizeV() % 3 != 0)
+      return;
+
+   float vmin[3], vmax[3];
+   for (int c = 0; c < 3; ++c)
+      vmin[c] = vmax[c] = fVertexBuffer[c];
+   for (int i = 3; i < SizeV(); ++i) {
+      float v = fVertexBuffer[i];
+      int c = i % 3;
+      if (v < vmin[c])
+         vmin[c] = v;
+      else if (v > vmax[c])
+         vmax[c] = v;
+   }
+   for (int c = 0; c < 3; ++c) {
+      if (!std::isfinite(vmin[c]) || !std::isfinite(vmax[c]))
+         return;
+      fQuantV[c] = vmin[c];
+      fQuantV[c + 3] = (vmax[c] - vmin[c]) / 65535;
+   }
+
+   fQuantVertexBuffer.resize(SizeV());
+   for (int i = 0; i < SizeV(); ++i) {
+      int c = i % 3;
+      float step = fQuantV[c + 3];
+      fQuantVertexBuffer[i] = step > 0 ? (uint16_t) std::lround((fVertexBuffer[i] - fQuantV[c]) / step) : 0;
+   }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 /// Set transformation matrix
 
@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+
+#include <ROOT/REveRenderData.hxx>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace REX = ROOT::Experimental;
+
+// Vertices are kept as floats unless quantization is enabled
+TEST(REveRenderData, NotQuantized)
+{
+   REX::REveRenderData rd("makeHit");
+   for (int i = 0; i < REX::REveRenderData::kMinQuantizedSize; ++i)
+      rd.PushV(0.5f * i);
+   rd.Quantize();
+   EXPECT_FALSE(rd.IsQuantizedV());
+   EXPECT_EQ(rd.GetBinarySize(), REX::REveRenderData::kMinQuantizedSize * 4);
+}
+
+// Quantized vertices are written as 16-bit integers, padded to 4 bytes
+TEST(REveRenderData, Quantized)
+{
+   const int npoints = 1001;
+   REX::REveRenderData rd("makeHit");
+   rd.SetQuantizeV(true);
+   for (int i = 0; i < npoints; ++i)
+      rd.PushV(-10.f + 0.02f * i, 3.f, 100.f * std::sin(0.01f * i));
+   rd.PushI(7);
+   rd.Quantize();
+   ASSERT_TRUE(rd.IsQuantizedV());
+
+   const int vsize = (3 * npoints * 2 + 3) / 4 * 4;
+   ASSERT_EQ(rd.GetBinarySize(), vsize + 4);
+   std::vector<char> buf(rd.GetBinarySize());
+   EXPECT_EQ(rd.Write(buf.data(), buf.size()), rd.GetBinarySize());
+
+   const float *q = rd.GetQuantizationV();
+   EXPECT_FLOAT_EQ(q[0], -10.f);
+   EXPECT_FLOAT_EQ(q[1], 3.f);
+   EXPECT_FLOAT_EQ(q[4], 0.f);
+   std::vector<uint16_t> values(3 * npoints);
+   memcpy(values.data(), buf.data(), values.size() * sizeof(uint16_t));
+   for (int i = 0; i < npoints; ++i) {
+      EXPECT_NEAR(q[0] + values[3 * i] * q[3], -10.f + 0.02f * i, q[3]);
+      EXPECT_FLOAT_EQ(q[1] + values[3 * i + 1] * q[4], 3.f);
+      EXPECT_NEAR(q[2] + values[3 * i + 2] * q[5], 100.f * std::sin(0.01f * i), q[5]);
+   }
+   int index;
+   memcpy(&index, buf.data() + vsize, sizeof(int));
+   EXPECT_EQ(index, 7);
+}
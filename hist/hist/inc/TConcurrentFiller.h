@@ -0,0 +1,139 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TConcurrentFiller
+#define ROOT_TConcurrentFiller
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TProfileConcurrentFiller, TEfficiencyConcurrentFiller                //
+//                                                                      //
+// Fill a single TProfile, TProfile2D or TEfficiency from many threads  //
+// at the same time. The fills are accumulated with atomic operations   //
+// in arrays with the binning of the target, and added to it by Flush() //
+// or when the filler is destroyed.                                     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH1.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+class TEfficiency;
+
+namespace ROOT {
+namespace Internal {
+
+/// Concurrent filling of a histogram or a profile of up to three dimensions.
+/// For every bin, the sums of w and w^2 are accumulated with atomic additions, and for profiles also the sums of
+/// w*v and w*v^2 of the profiled values v. The global statistics go to a fixed number of shards, selected by the
+/// filling thread, so that threads rarely update the same atomics.
+class TConcurrentHistFiller {
+public:
+   TConcurrentHistFiller(TH1 &h, Bool_t isProfile = kFALSE, Double_t vmin = 0., Double_t vmax = 0.);
+   TConcurrentHistFiller(const TConcurrentHistFiller &) = delete;
+   TConcurrentHistFiller &operator=(const TConcurrentHistFiller &) = delete;
+   virtual ~TConcurrentHistFiller();
+
+   Int_t Fill(const Double_t *x, Double_t w);
+   void Flush();
+   TH1 &GetHistogram() const { return fHist; }
+
+protected:
+   Int_t FillProfile(const Double_t *x, Double_t v, Double_t w);
+   /// Add the sum of weights w to the entries of a profile bin
+   virtual void AddBinEntries(Int_t /*bin*/, Double_t /*w*/) {}
+   /// Return the array of the sums of w^2 per bin of the target
+   virtual TArrayD *GetBinSumw2() { return fHist.GetSumw2(); }
+
+private:
+   struct alignas(64) TShard {
+      std::atomic<Double_t> fStats[TH1::kNstat]; ///< Global statistics, with the layout of TH1::GetStats()
+      std::atomic<Long64_t> fEntries;            ///< Number of accepted fills
+   };
+   static constexpr Int_t kNShards = 16;
+
+   TH1 &fHist;                               ///< The histogram or profile filled
+   const Int_t fDim;                         ///< Number of axes of fHist
+   const Bool_t fIsProfile;                  ///< Whether fHist is a profile
+   const Double_t fVmin;                     ///< Profiled values outside of [fVmin, fVmax] are rejected if fVmin != fVmax
+   const Double_t fVmax;
+   const Bool_t fStatOverflows;              ///< Whether fills of under/overflow bins enter the statistics
+   const Int_t fNSums;                       ///< Number of sums per bin: w, w^2 and for profiles w*v, w*v^2
+   const Int_t fNStats;                      ///< Number of global statistics of fHist
+   std::unique_ptr<std::atomic<Double_t>[]> fSums; ///< [fNSums * number of cells] sums of the bins, bin-major
+   std::unique_ptr<TShard[]> fShards;        ///< [kNShards] global statistics
+   std::atomic<Bool_t> fHasWeights{kFALSE};  ///< Whether a weight different from 1 was used
+
+   Int_t FillImpl(const Double_t *x, Double_t v, Double_t w);
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+/// Thread-safe filling of a TProfile or a TProfile2D. See TConcurrentFiller.cxx for details.
+template <class PROFILE>
+class TProfileConcurrentFiller : public ROOT::Internal::TConcurrentHistFiller {
+   static_assert(std::is_same<PROFILE, TProfile>::value || std::is_same<PROFILE, TProfile2D>::value,
+                 "TProfileConcurrentFiller supports TProfile and TProfile2D");
+
+   void AddBinEntries(Int_t bin, Double_t w) final
+   {
+      auto &p = static_cast<PROFILE &>(GetHistogram());
+      p.SetBinEntries(bin, p.GetBinEntries(bin) + w);
+   }
+   TArrayD *GetBinSumw2() final { return static_cast<PROFILE &>(GetHistogram()).GetBinSumw2(); }
+
+   static Double_t GetVmin(const TProfile &p) { return p.GetYmin(); }
+   static Double_t GetVmax(const TProfile &p) { return p.GetYmax(); }
+   static Double_t GetVmin(const TProfile2D &p) { return p.GetZmin(); }
+   static Double_t GetVmax(const TProfile2D &p) { return p.GetZmax(); }
+
+public:
+   explicit TProfileConcurrentFiller(PROFILE &p) : TConcurrentHistFiller(p, kTRUE, GetVmin(p), GetVmax(p)) {}
+   ~TProfileConcurrentFiller() { Flush(); }
+
+   /// Fill a TProfile with the value y at x, with weight w
+   template <class P = PROFILE, std::enable_if_t<std::is_same<P, TProfile>::value, int> = 0>
+   Int_t Fill(Double_t x, Double_t y, Double_t w = 1.)
+   {
+      return FillProfile(&x, y, w);
+   }
+
+   /// Fill a TProfile2D with the value z at (x, y), with weight w
+   template <class P = PROFILE, std::enable_if_t<std::is_same<P, TProfile2D>::value, int> = 0>
+   Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w = 1.)
+   {
+      const Double_t xy[2] = {x, y};
+      return FillProfile(xy, z, w);
+   }
+};
+
+/// Thread-safe filling of a TEfficiency. See TConcurrentFiller.cxx for details.
+class TEfficiencyConcurrentFiller {
+   TEfficiency &fEfficiency;
+   ROOT::Internal::TConcurrentHistFiller fTotal;
+   ROOT::Internal::TConcurrentHistFiller fPassed;
+   std::atomic<Bool_t> fWeighted{kFALSE}; ///< Whether FillWeighted was called
+
+public:
+   explicit TEfficiencyConcurrentFiller(TEfficiency &eff);
+   ~TEfficiencyConcurrentFiller() { Flush(); }
+
+   void Fill(Bool_t bPassed, Double_t x, Double_t y = 0, Double_t z = 0);
+   void FillWeighted(Bool_t bPassed, Double_t weight, Double_t x, Double_t y = 0, Double_t z = 0);
+   void Flush();
+};
+
+#endif
@@ -26,6 +26,8 @@ class TList;
 
 class TEfficiency: public TNamed, public TAttLine, public TAttFill, public TAttMarker
 {
+   friend class TEfficiencyConcurrentFiller;
+
 public:
    /// Enumeration type for different statistic options for calculating confidence intervals
    /// kF* ... frequentist methods; kB* ... bayesian methods
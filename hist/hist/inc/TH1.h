@@ -54,6 +54,11 @@ class TVirtualFFT;
 class TVirtualHistPainter;
 class TRandom;
 
+namespace ROOT {
+namespace Internal {
+class TConcurrentHistFiller;
+}
+}
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -83,6 +88,7 @@ public:
    };
 
    friend class TH1Merger;
+   friend class ROOT::Internal::TConcurrentHistFiller;
 
 protected:
     Int_t         fNcells;          ///<  Number of bins(1D), cells (2D) +U/Overflows
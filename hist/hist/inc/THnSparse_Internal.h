@@ -23,6 +23,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -66,5 +68,50 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDef(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+
+/// Hash map from the hash of the compact coordinates of a filled bin to the bin's linear index, with open
+/// addressing and robin-hood insertion: an entry is at most as far from its home slot as its neighbours, which
+/// keeps the probe sequences short even at high load. Bins whose compact coordinates exceed 8 bytes can share
+/// a hash; they are all stored and Find() tells them apart with the predicate passed by the caller.
+class THnSparseBinMap {
+private:
+   struct Slot_t {
+      ULong64_t fHash;
+      Long64_t fBin; ///< -1 for an empty slot
+   };
+   std::vector<Slot_t> fSlots;
+   Long64_t fSize = 0; ///< Number of stored bins
+   Int_t fShift = 64;  ///< 64 - log2(number of slots)
+
+   /// Fibonacci hashing: the compact coordinates of neighbouring bins differ only in few bits
+   ULong64_t GetHome(ULong64_t hash) const { return fShift == 64 ? 0 : (hash * 0x9E3779B97F4A7C15ull) >> fShift; }
+   ULong64_t GetDistance(ULong64_t pos, ULong64_t hash) const { return (pos - GetHome(hash)) & (fSlots.size() - 1); }
+   void Rehash(std::size_t nslots);
+
+public:
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fSlots.size(); }
+   void Clear() { fSlots.clear(); fSize = 0; fShift = 64; }
+   void Reserve(Long64_t nbins);
+   void Insert(ULong64_t hash, Long64_t bin);
+
+   /// Return the bin with the given hash for which matches(bin) is true, or -1.
+   template <class MATCHES>
+   Long64_t Find(ULong64_t hash, MATCHES &&matches) const {
+      if (!fSize)
+         return -1;
+      const ULong64_t mask = fSlots.size() - 1;
+      ULong64_t pos = GetHome(hash);
+      for (ULong64_t dist = 0; ; ++dist, pos = (pos + 1) & mask) {
+         const Slot_t &slot = fSlots[pos];
+         // An entry further from its home would have taken this slot
+         if (slot.fBin < 0 || GetDistance(pos, slot.fHash) < dist)
+            return -1;
+         if (slot.fHash == hash && matches(slot.fBin))
+            return slot.fBin;
+      }
+   }
+};
+
 #endif // ROOT_THnSparse_Internal
 
@@ -128,6 +128,7 @@ public:
 
    Double_t operator()(Double_t x) const;
    Double_t operator()(const Double_t* x, const Double_t* p=0) const;  // Needed for creating TF1
+   void Evaluate(UInt_t n, const Double_t* x, Double_t* y) const;
 
    Double_t GetValue(Double_t x) const { return (*this)(x); }
    Double_t GetError(Double_t x) const;
@@ -164,6 +165,11 @@ public:
       TKDE *fKDE;
       UInt_t fNWeights;               ///< Number of kernel weights (bandwidth as vectorized for binning)
       std::vector<Double_t> fWeights; ///< Kernel weights (bandwidth)
+      std::vector<UInt_t> fOrder;     ///< Indices of the data points sorted by position
+      std::vector<Double_t> fSorted;  ///< Sorted data points, used to find the points within the kernel support
+      Double_t fSupport;              ///< Maximum distance of a point contributing to the estimate (0 if unbounded)
+      void SetSupport();
+      Double_t SumRange(Double_t x, Double_t dmin, Double_t dmax, Bool_t reflect, Double_t edge) const;
    public:
       TKernel(Double_t weight, TKDE *kde);
       void ComputeAdaptiveWeights();
@@ -28,6 +28,7 @@
 #include "TList.h"
 #include "TMath.h"
 #include "TROOT.h"
+#include "TEnv.h"
 
 #include "TVirtualPad.h" // for gPad
 
@@ -79,6 +80,12 @@ namespace HFit {
    template <class FitObject>
    double ComputeChi2(const FitObject & h1, TF1 &f1, bool useRange, bool usePL );
 
+#ifdef R__HAS_VECCORE
+   std::unique_ptr<TF1> MakeVectorizedFunction(const TF1 &f1, unsigned int npoints);
+#endif
+
+   bool UseFormulaGradient(TF1 &f1);
+
 
 
 }
@@ -116,6 +123,39 @@ int HFit::CheckFitFunction(const TF1 * f1, int dim) {
 
 }
 
+#ifdef R__HAS_VECCORE
+std::unique_ptr<TF1> HFit::MakeVectorizedFunction(const TF1 & f1, unsigned int npoints) {
+   // Return a vectorized copy of a formula based function, to be evaluated on ROOT::Double_v in the
+   // objective function, or a null pointer if f1 should be evaluated as it is.
+   // The copy is made only for fits with at least Fit.VectorizeFormula points (0 disables it),
+   // since jitting the vectorized signature of the formula is not free.
+   const TFormula * formula = f1.GetFormula();
+   if (!formula || formula->IsVectorized() || f1.GetNdim() == 0) return nullptr;
+   const int minPoints = gEnv->GetValue("Fit.VectorizeFormula", 1000);
+   if (minPoints <= 0 || npoints < (unsigned int) minPoints) return nullptr;
+
+   std::unique_ptr<TF1> vecFunc(new TF1(f1));
+   vecFunc->SetVectorized(true);
+   if (!vecFunc->IsVectorized() || !vecFunc->GetFormula()->IsValid()) return nullptr;
+   return vecFunc;
+}
+#endif
+
+bool HFit::UseFormulaGradient(TF1 & f1) {
+   // Generate with clad the gradient of a formula based function with respect to its parameters.
+   // If it succeeds, the fit uses the analytic gradient of the objective function and the
+   // minimizer does not need to compute it with finite differences.
+   // It can be switched off with Fit.CladGradient: no
+#ifdef R__HAS_CLAD
+   TFormula * formula = f1.GetFormula();
+   if (!formula || formula->IsVectorized() || !formula->IsValid()) return false;
+   if (!gEnv->GetValue("Fit.CladGradient", 1)) return false;
+   return formula->HasGeneratedGradient() || formula->GenerateGradientPar();
+#else
+   (void) f1;
+   return false;
+#endif
+}
 
 void HFit::GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range) {
    // get the range form the function and fill and return the DataRange object
@@ -232,11 +272,20 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    // set the fit function
    // if option grad is specified use gradient
-   if ( (linear || fitOption.Gradient) )
+   // the gradient is also used if clad can generate it for the formula, unless the chi2
+   // needs the coordinate errors, which are not supported by the gradient
+   bool useCoordErrors = fitdata->GetErrorType() == ROOT::Fit::BinData::kCoordError && fitdata->Opt().fCoordErrors;
+   if ( (linear || fitOption.Gradient || (!useCoordErrors && HFit::UseFormulaGradient(*f1))) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1));
 #ifdef R__HAS_VECCORE
    else if(f1->IsVectorized())
       fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunctionTempl<ROOT::Double_v> &>(ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v>(*f1)));
+   else if (auto vecFunc = HFit::MakeVectorizedFunction(*f1, fitdata->Size())) {
+      // the wrapper (and the one cloned by the fitter) own a copy of the vectorized function
+      ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v> vecWrapper(*vecFunc);
+      vecWrapper.SetAndCopyFunction();
+      fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunctionTempl<ROOT::Double_v> &>(vecWrapper));
+   }
 #endif
    else
       fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunction &>(ROOT::Math::WrappedMultiTF1(*f1) ) );
@@ -842,10 +891,19 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // set the fit function
    // if option grad is specified use gradient
    // need to create a wrapper for an automatic  normalized TF1 ???
-   if ( fitOption.Gradient ) {
+   if ( fitOption.Gradient || ((int) dim == fitfunc->GetNdim() && HFit::UseFormulaGradient(*fitfunc)) ) {
       assert ( (int) dim == fitfunc->GetNdim() );
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
+#ifdef R__HAS_VECCORE
+   else if (fitfunc->IsVectorized())
+      fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunctionTempl<ROOT::Double_v> &>(ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v>(*fitfunc, dim)));
+   else if (auto vecFunc = (int)dim == fitfunc->GetNdim() ? HFit::MakeVectorizedFunction(*fitfunc, fitdata->Size()) : nullptr) {
+      ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v> vecWrapper(*vecFunc, dim);
+      vecWrapper.SetAndCopyFunction();
+      fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunctionTempl<ROOT::Double_v> &>(vecWrapper));
+   }
+#endif
    else
       fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunction &>(ROOT::Math::WrappedMultiTF1(*fitfunc, dim) ) );
 
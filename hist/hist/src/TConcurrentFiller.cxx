@@ -0,0 +1,282 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TProfileConcurrentFiller
+    \ingroup Hist
+
+Fill a single TProfile or TProfile2D from many threads at the same time.
+
+The fills are accumulated in arrays of atomic sums with the binning of the
+profile: for each bin the sums of w, w^2, w*y and w*y^2. The global
+statistics are accumulated in a small, fixed number of shards, so that the
+threads rarely update the same memory. The memory used is twice the one of
+the profile whatever the number of threads, instead of one clone per thread
+with TThreadedObject.
+
+The accumulated sums are added to the profile by Flush(), which is called
+by the destructor. The profile must not be used while it is filled
+concurrently, nor Flush() be called concurrently with Fill().
+~~~ {.cpp}
+   TProfile prof("prof", "prof", 100, 0, 10);
+   {
+      TProfileConcurrentFiller<TProfile> filler(prof);
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](int i) { filler.Fill(x[i], y[i]); }, ROOT::TSeqI(n));
+   } // the contents are added to prof here
+~~~
+The axes of the profile cannot be extended by concurrent fills: the
+extension is switched off by the constructor if it was on, and the fills
+outside of the axis ranges go to the underflow and overflow bins.
+
+\class TEfficiencyConcurrentFiller
+    \ingroup Hist
+
+Fill a single TEfficiency from many threads at the same time, in the way
+TProfileConcurrentFiller fills a profile. Fill() and FillWeighted() have the
+signatures of the TEfficiency methods. The efficiency must have been built
+with its histograms.
+*/
+
+#include "TConcurrentFiller.h"
+#include "TEfficiency.h"
+#include "TMath.h"
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically add x to a.
+
+inline void AtomicAdd(std::atomic<Double_t> &a, Double_t x)
+{
+   Double_t old = a.load(std::memory_order_relaxed);
+   while (!a.compare_exchange_weak(old, old + x, std::memory_order_relaxed))
+      ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Shard of the calling thread: the threads are given consecutive shards in
+/// the order of their first fill.
+
+inline Int_t GetShardIndex(Int_t nShards)
+{
+   static std::atomic<UInt_t> gNextShard{0};
+   thread_local const UInt_t shard = gNextShard++;
+   return Int_t(shard % nShards);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of global statistics of a histogram or a profile, see TH1::GetStats.
+
+Int_t GetNStats(Int_t dim, Bool_t isProfile)
+{
+   if (isProfile)
+      return dim == 1 ? 6 : 9;
+   return dim == 1 ? 4 : (dim == 2 ? 7 : 11);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the concurrent filling of h. For profiles, vmin and vmax are the
+/// limits of the profiled values.
+
+ROOT::Internal::TConcurrentHistFiller::TConcurrentHistFiller(TH1 &h, Bool_t isProfile, Double_t vmin, Double_t vmax)
+   : fHist(h), fDim(h.GetDimension()), fIsProfile(isProfile), fVmin(vmin), fVmax(vmax),
+     fStatOverflows(h.GetStatOverflowsBehaviour()), fNSums(isProfile ? 4 : 2), fNStats(GetNStats(fDim, isProfile))
+{
+   if (fHist.GetBuffer())
+      fHist.BufferEmpty(1);
+   if (fHist.GetXaxis()->CanExtend() || fHist.GetYaxis()->CanExtend() || fHist.GetZaxis()->CanExtend()) {
+      fHist.Warning("TConcurrentHistFiller",
+                    "The axes of %s cannot be extended by concurrent fills: the fills outside of their range "
+                    "go to the underflow and overflow bins",
+                    fHist.GetName());
+      fHist.SetCanExtend(TH1::kNoAxis);
+   }
+
+   const Long64_t nSums = Long64_t(fNSums) * fHist.GetNcells();
+   fSums.reset(new std::atomic<Double_t>[nSums]);
+   for (Long64_t i = 0; i < nSums; ++i)
+      fSums[i].store(0., std::memory_order_relaxed);
+   fShards.reset(new TShard[kNShards]);
+   for (Int_t i = 0; i < kNShards; ++i) {
+      for (auto &stat : fShards[i].fStats)
+         stat.store(0., std::memory_order_relaxed);
+      fShards[i].fEntries.store(0, std::memory_order_relaxed);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The sums not flushed yet are lost.
+
+ROOT::Internal::TConcurrentHistFiller::~TConcurrentHistFiller() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram at the point x, an array of GetDimension() coordinates,
+/// with weight w. Return the global bin number, or -1 if the fill does not
+/// enter the statistics.
+
+Int_t ROOT::Internal::TConcurrentHistFiller::Fill(const Double_t *x, Double_t w)
+{
+   return FillImpl(x, 0., w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the profile with the value v at the point x, with weight w.
+
+Int_t ROOT::Internal::TConcurrentHistFiller::FillProfile(const Double_t *x, Double_t v, Double_t w)
+{
+   if (fVmin != fVmax) {
+      if (v < fVmin || v > fVmax || TMath::IsNaN(v))
+         return -1;
+   }
+   return FillImpl(x, v, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Accumulate a fill, following TH1::Fill and TProfile::Fill.
+
+Int_t ROOT::Internal::TConcurrentHistFiller::FillImpl(const Double_t *x, Double_t v, Double_t w)
+{
+   const TAxis *axes[3] = {fHist.GetXaxis(), fHist.GetYaxis(), fHist.GetZaxis()};
+   Int_t bins[3] = {0, 0, 0};
+   Bool_t inRange = kTRUE;
+   for (Int_t i = 0; i < fDim; ++i) {
+      bins[i] = axes[i]->FindFixBin(x[i]);
+      inRange = inRange && bins[i] > 0 && bins[i] <= axes[i]->GetNbins();
+   }
+   const Int_t bin = fHist.GetBin(bins[0], bins[1], bins[2]);
+
+   std::atomic<Double_t> *sums = &fSums[Long64_t(bin) * fNSums];
+   AtomicAdd(sums[0], w);
+   AtomicAdd(sums[1], w * w);
+   if (fIsProfile) {
+      AtomicAdd(sums[2], w * v);
+      AtomicAdd(sums[3], w * v * v);
+   }
+   if (w != 1. && !fHasWeights.load(std::memory_order_relaxed))
+      fHasWeights.store(kTRUE, std::memory_order_relaxed);
+
+   TShard &shard = fShards[GetShardIndex(kNShards)];
+   shard.fEntries.fetch_add(1, std::memory_order_relaxed);
+   if (!inRange && !fStatOverflows)
+      return -1;
+
+   // The profiled value enters the statistics as one more coordinate, e.g. the
+   // statistics of a TProfile are the first ones of a TH2.
+   Double_t c[3] = {0., 0., 0.};
+   for (Int_t i = 0; i < fDim; ++i)
+      c[i] = x[i];
+   if (fIsProfile)
+      c[fDim] = v;
+   Double_t stats[11] = {w,
+                         w * w,
+                         w * c[0],
+                         w * c[0] * c[0],
+                         w * c[1],
+                         w * c[1] * c[1],
+                         w * c[0] * c[1],
+                         w * c[2],
+                         w * c[2] * c[2],
+                         w * c[0] * c[2],
+                         w * c[1] * c[2]};
+   for (Int_t i = 0; i < fNStats; ++i)
+      AtomicAdd(shard.fStats[i], stats[i]);
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the accumulated sums to the histogram and reset them. This must not be
+/// called concurrently with Fill().
+
+void ROOT::Internal::TConcurrentHistFiller::Flush()
+{
+   if (fHasWeights.exchange(kFALSE) && GetBinSumw2()->fN == 0 && !fHist.TestBit(TH1::kIsNotW))
+      fHist.Sumw2(); // as done by the first weighted TH1::Fill
+   TArrayD *binSumw2 = GetBinSumw2();
+
+   // the statistics are computed from the bins if fHist has none: get them before adding the new contents
+   Double_t stats[TH1::kNstat] = {0};
+   fHist.GetStats(stats);
+   Long64_t nEntries = 0;
+   for (Int_t i = 0; i < kNShards; ++i) {
+      for (Int_t j = 0; j < fNStats; ++j)
+         stats[j] += fShards[i].fStats[j].exchange(0., std::memory_order_relaxed);
+      nEntries += fShards[i].fEntries.exchange(0, std::memory_order_relaxed);
+   }
+   if (nEntries == 0)
+      return;
+
+   const Int_t nCells = fHist.GetNcells();
+   for (Int_t bin = 0; bin < nCells; ++bin) {
+      std::atomic<Double_t> *sums = &fSums[Long64_t(bin) * fNSums];
+      const Double_t sumw2 = sums[1].exchange(0., std::memory_order_relaxed);
+      if (sumw2 == 0.)
+         continue; // not filled, or only with null weights
+      const Double_t sumw = sums[0].exchange(0., std::memory_order_relaxed);
+      if (fIsProfile) {
+         fHist.AddBinContent(bin, sums[2].exchange(0., std::memory_order_relaxed));
+         fHist.GetSumw2()->fArray[bin] += sums[3].exchange(0., std::memory_order_relaxed);
+         AddBinEntries(bin, sumw);
+      } else {
+         fHist.AddBinContent(bin, sumw);
+      }
+      if (binSumw2->fN)
+         binSumw2->fArray[bin] += sumw2;
+   }
+
+   fHist.PutStats(stats);
+   fHist.SetEntries(fHist.GetEntries() + nEntries);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the concurrent filling of eff.
+
+TEfficiencyConcurrentFiller::TEfficiencyConcurrentFiller(TEfficiency &eff)
+   : fEfficiency(eff), fTotal(*eff.fTotalHistogram), fPassed(*eff.fPassedHistogram)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the total histogram, and the passed histogram if bPassed is true, like TEfficiency::Fill.
+
+void TEfficiencyConcurrentFiller::Fill(Bool_t bPassed, Double_t x, Double_t y, Double_t z)
+{
+   const Double_t xyz[3] = {x, y, z};
+   fTotal.Fill(xyz, 1.);
+   if (bPassed)
+      fPassed.Fill(xyz, 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill with a weight, like TEfficiency::FillWeighted. The efficiency is switched
+/// to weighted events by the next Flush().
+
+void TEfficiencyConcurrentFiller::FillWeighted(Bool_t bPassed, Double_t weight, Double_t x, Double_t y, Double_t z)
+{
+   if (!fWeighted.load(std::memory_order_relaxed))
+      fWeighted.store(kTRUE, std::memory_order_relaxed);
+   const Double_t xyz[3] = {x, y, z};
+   fTotal.Fill(xyz, weight);
+   if (bPassed)
+      fPassed.Fill(xyz, weight);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the accumulated fills to the histograms of the efficiency. This must not
+/// be called concurrently with Fill() or FillWeighted().
+
+void TEfficiencyConcurrentFiller::Flush()
+{
+   if (fWeighted.exchange(kFALSE) && !fEfficiency.UsesWeights())
+      fEfficiency.SetUseWeightedEvents();
+   fTotal.Flush();
+   fPassed.Flush();
+}
@@ -2702,18 +2702,42 @@ TList* TEfficiency::GetListOfFunctions()
 ///
 /// The new weight is set according to:
 /// \f$  \frac{1}{w_{new}} = \sum_{i} \frac{1}{w_{i}} \f$
+///
+/// The total and passed histograms of all the objects are merged at once with
+/// TH1::Merge, which merges the bins of large histograms in parallel when
+/// implicit multi-threading is enabled.
 
 Long64_t TEfficiency::Merge(TCollection* pList)
 {
    if(!pList->IsEmpty()) {
+      TList totals;
+      TList passed;
+      Double_t invWeight = 1. / fWeight;
       TIter next(pList);
       TObject* obj = 0;
       TEfficiency* pEff = 0;
       while((obj = next())) {
          pEff = dynamic_cast<TEfficiency*>(obj);
-         if(pEff) {
+         if(!pEff)
+            continue;
+         if(fTotalHistogram == 0 || fPassedHistogram == 0 || pEff->fTotalHistogram == 0 || pEff->fPassedHistogram == 0) {
+            // empty or inconsistent objects are handled (and reported) by operator+=
+            const Bool_t wasEmpty = (fTotalHistogram == 0 && fPassedHistogram == 0);
             *this += *pEff;
+            if(wasEmpty)
+               invWeight = 1. / fWeight;
+            continue;
          }
+         totals.Add(pEff->fTotalHistogram);
+         passed.Add(pEff->fPassedHistogram);
+         invWeight += 1. / pEff->GetWeight();
+      }
+      if(!totals.IsEmpty()) {
+         fTotalHistogram->ResetBit(TH1::kIsAverage);
+         fPassedHistogram->ResetBit(TH1::kIsAverage);
+         fTotalHistogram->Merge(&totals);
+         fPassedHistogram->Merge(&passed);
+         SetWeight(1. / invWeight);
       }
    }
    return (Long64_t)fTotalHistogram->GetEntries();
@@ -21,6 +21,7 @@
 #include "TInterpreterValue.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include "TEnv.h"
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -212,6 +213,18 @@ static const TString gNamePrefix = "TFormula__";
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
 
+////////////////////////////////////////////////////////////////////////////////
+/// Pragma setting the optimization level of the code jitted for the formulas,
+/// from the Jit.OptimizationLevel resource (0 to 3, 2 by default). A lower
+/// level compiles faster, a higher one gives faster evaluations.
+
+static TString GetJitOptimizationPragma()
+{
+   Int_t level = gEnv->GetValue("Jit.OptimizationLevel", 2);
+   level = TMath::Max(0, TMath::Min(level, 3));
+   return TString::Format("#pragma cling optimize(%d)\n", level);
+}
+
 static void R__v5TFormulaUpdater(Int_t nobjects, TObject **from, TObject **to)
 {
    auto **fromv5 = (ROOT::v5::TFormula **)from;
@@ -833,7 +846,7 @@ void TFormula::InputFormulaIntoCling()
       gCling->ProcessLine(triggerAutoparsing);
 
       // add pragma for optimization of the formula
-      fClingInput = TString("#pragma cling optimize(2)\n") + fClingInput;
+      fClingInput = GetJitOptimizationPragma() + fClingInput;
 
       // Now that all libraries and headers are loaded, Declare() a performant version
       // of the same code:
@@ -3156,7 +3169,7 @@ bool TFormula::GenerateGradientPar()
       if (!functionExists(GetGradientFuncName())) {
          std::string GradReqFuncName = GetGradientFuncName() + "_req";
          // We want to call clad::differentiate(TFormula_id);
-         fGradGenerationInput = std::string("#pragma cling optimize(2)\n") +
+         fGradGenerationInput = std::string(GetJitOptimizationPragma().Data()) +
             "#pragma clad ON\n" +
             "void " + GradReqFuncName + "() {\n" +
             "clad::gradient(" + std::string(fClingName.Data()) + ");\n }\n" +
@@ -14,6 +14,7 @@
 #include <cstdio>
 #include <cctype>
 #include <climits>
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 #include <iostream>
@@ -3480,27 +3481,74 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
-   Int_t bin,i;
-
    fEntries += ntimes;
    Double_t ww = 1;
-   Int_t nbins   = fXaxis.GetNbins();
-   ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!GetStatOverflowsBehaviour()) continue;
-      }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
+
+   // Find the bins of a batch of values at once, then fill them and sum up the statistics of the batch,
+   // in the same order as Fill(x, w) would
+   constexpr Int_t kBatchSize = 256;
+   Int_t bins[kBatchSize];
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Bool_t canExtend = fXaxis.CanExtend() && !fXaxis.IsAlphanumeric();
+   for (Int_t first = 0; first < ntimes; first += kBatchSize) {
+      const Int_t n = std::min(kBatchSize, ntimes - first);
+      const Double_t *xs = &x[first * stride];
+      const Double_t *ws = w ? &w[first * stride] : nullptr;
+      Int_t i;
+
+      if (canExtend) {
+         const Double_t xmin = fXaxis.GetXmin();
+         const Double_t xmax = fXaxis.GetXmax();
+         for (i = 0; i < n; ++i) {
+            if (!(xs[i * stride] >= xmin && xs[i * stride] < xmax))
+               break;
+         }
+         // The axis is extended by some value of the batch: find the bins one by one
+         if (i < n) {
+            for (i = 0; i < n; ++i) {
+               const Double_t xi = xs[i * stride];
+               Int_t bin = fXaxis.FindBin(xi);
+               if (bin <0) continue;
+               if (ws) ww = ws[i * stride];
+               if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+               if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+               AddBinContent(bin, ww);
+               if (bin == 0 || bin > fXaxis.GetNbins()) {
+                  if (!statOverflows) continue;
+               }
+               Double_t z= ww;
+               fTsumw   += z;
+               fTsumw2  += z*z;
+               fTsumwx  += z*xi;
+               fTsumwx2 += z*xi*xi;
+            }
+            continue;
+         }
+      }
+
+      fXaxis.FindFixBins(n, xs, bins, stride);
+      for (i = 0; i < n; ++i) {
+         if (ws) ww = ws[i * stride];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bins[i]] += ww*ww;
+         AddBinContent(bins[i], ww);
+      }
+      const Int_t nbins = fXaxis.GetNbins();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      for (i = 0; i < n; ++i) {
+         const Bool_t inStats = statOverflows || (bins[i] > 0 && bins[i] <= nbins);
+         // zeros for the values outside of the statistics, also if they are infinite or NaN
+         const Double_t z = inStats ? (ws ? ws[i * stride] : 1.) : 0.;
+         const Double_t xi = inStats ? xs[i * stride] : 0.;
+         tsumw   += z;
+         tsumw2  += z*z;
+         tsumwx  += z*xi;
+         tsumwx2 += z*xi*xi;
+      }
+      fTsumw = tsumw;
+      fTsumw2 = tsumw2;
+      fTsumwx = tsumwx;
+      fTsumwx2 = tsumwx2;
    }
 }
 
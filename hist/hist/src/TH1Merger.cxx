@@ -8,9 +8,17 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -794,6 +802,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
 
+   std::vector<TH1 *> hists;
    TIter next(&fInputList);
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -810,13 +819,40 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      hists.push_back(hist);
+   }
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
-         // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-         MergeBin(hist, ibin, ibin);
+   // loop on bins of the histograms and do the merge, for the bins in [first, last)
+   auto mergeBins = [&](Int_t first, Int_t last) {
+      for (TH1 *hist : hists) {
+         for (Int_t ibin = first; ibin < last; ibin++) {
+            MergeBin(hist, ibin, ibin);
+         }
       }
+   };
+   const Int_t ncells = fH0->fNcells;
+   Int_t nchunks = 1;
+#ifdef R__USE_IMT
+   // With implicit multi-threading, large merges are split in ranges of bins merged in parallel. Every bin is
+   // updated by a single task, which requires that the bins of fH0 are independent of each other.
+   static constexpr Long64_t kMinParallelBins = 1 << 18;
+   const TClass *cl = fH0->IsA();
+   const Bool_t independentBins = fIsProfileMerge || cl == TH1D::Class() || cl == TH1F::Class() ||
+                                  cl == TH2D::Class() || cl == TH2F::Class() || cl == TH3D::Class() ||
+                                  cl == TH3F::Class();
+   if (independentBins && ROOT::IsImplicitMTEnabled() && Long64_t(ncells) * hists.size() >= kMinParallelBins)
+      nchunks = std::min(ncells / 1024 + 1, 4 * Int_t(ROOT::GetThreadPoolSize()));
+   if (nchunks > 1) {
+      auto mergeChunk = [&](Int_t ichunk) {
+         mergeBins(Int_t(Long64_t(ncells) * ichunk / nchunks), Int_t(Long64_t(ncells) * (ichunk + 1) / nchunks));
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(mergeChunk, ROOT::TSeqI(nchunks));
    }
+#endif
+   if (nchunks == 1)
+      mergeBins(0, ncells);
+
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
@@ -31,6 +31,15 @@
 #include "Math/MinimizerOptions.h"
 #include "Math/WrappedMultiTF1.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 
 /** \class THnBase
     \ingroup Hist
@@ -440,6 +449,108 @@ Bool_t THnBase::IsInRange(Int_t *coord) const
    return kTRUE;
 }
 
+#ifdef R__USE_IMT
+namespace {
+
+/// Number of filled bins of a THnSparse per task of a parallel projection
+constexpr Long64_t kMinBinsPerProjectionTask = 1 << 16;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Project the filled bins of `sparse` into `hn` or `hist` like THnBase::ProjectionAny(), in ranges of bins in
+/// parallel, one per empty clone of `hn` in `partialHns`, or `nTasks` if projecting into `hist`. Each task
+/// projects into its THnBase, or arrays of bin contents and errors for a TH1; they are merged into the result in
+/// the order of their ranges. Return whether bins outside of the axis ranges were skipped.
+
+Bool_t ProjectSparseParallel(ROOT::TThreadExecutor &pool, UInt_t nTasks, const THnSparse &sparse, Int_t ndim,
+                             const Int_t *dim, const Int_t *binOffsets, THnBase *hn,
+                             std::vector<std::unique_ptr<THnBase>> &partialHns, TH1 *hist, Bool_t wantErrors)
+{
+   struct RPartialProjection {
+      THnBase *fHn = nullptr;
+      std::vector<Double_t> fContent;
+      std::vector<Double_t> fError2;
+      Bool_t fHaveSkippedBin = kFALSE;
+   };
+   std::vector<RPartialProjection> partials(nTasks);
+   // Allocate the partial results and the compact coordinates of sparse up front, they are not thread-safe
+   std::vector<Int_t> coord0(sparse.GetNdimensions());
+   sparse.GetBinContent(0, coord0.data());
+   for (UInt_t task = 0; task < nTasks; ++task) {
+      RPartialProjection &partial = partials[task];
+      if (hn) {
+         partial.fHn = partialHns[task].get();
+      } else {
+         partial.fContent.resize(hist->GetNcells());
+         if (wantErrors)
+            partial.fError2.resize(hist->GetNcells());
+      }
+   }
+
+   const Bool_t haveErrors = sparse.GetCalculateErrors();
+   const Long64_t nbins = sparse.GetNbins();
+   auto project = [&](UInt_t task) {
+      RPartialProjection &partial = partials[task];
+      std::vector<Int_t> coord(sparse.GetNdimensions());
+      std::vector<Int_t> bins(ndim);
+      const Long64_t last = nbins * (task + 1) / nTasks;
+      for (Long64_t linBin = nbins * task / nTasks; linBin < last; ++linBin) {
+         Double_t v = sparse.GetBinContent(linBin, coord.data());
+         if (!sparse.IsInRange(coord.data())) {
+            partial.fHaveSkippedBin = kTRUE;
+            continue;
+         }
+         for (Int_t d = 0; d < ndim; ++d)
+            bins[d] = coord[dim[d]] - binOffsets[d];
+         Double_t err2 = 0.;
+         if (wantErrors)
+            err2 = haveErrors ? sparse.GetBinError2(linBin) : v;
+
+         if (hn) {
+            Long64_t targetLinBin = partial.fHn->GetBin(bins.data(), kTRUE /*allocate*/);
+            if (wantErrors)
+               partial.fHn->AddBinError2(targetLinBin, err2);
+            partial.fHn->AddBinContent(targetLinBin, v);
+         } else {
+            Int_t targetLinBin = bins[0];
+            if (ndim == 2) targetLinBin = hist->GetBin(bins[0], bins[1]);
+            else if (ndim == 3) targetLinBin = hist->GetBin(bins[0], bins[1], bins[2]);
+            partial.fContent[targetLinBin] += v;
+            if (wantErrors)
+               partial.fError2[targetLinBin] += err2;
+         }
+      }
+   };
+   pool.Foreach(project, ROOT::TSeqU(nTasks));
+
+   Bool_t haveSkippedBin = kFALSE;
+   std::vector<Int_t> bins(ndim);
+   for (auto &partial : partials) {
+      haveSkippedBin |= partial.fHaveSkippedBin;
+      if (hn) {
+         for (Long64_t i = 0; i < partial.fHn->GetNbins(); ++i) {
+            Double_t v = partial.fHn->GetBinContent(i, bins.data());
+            Long64_t targetLinBin = hn->GetBin(bins.data(), kTRUE /*allocate*/);
+            if (wantErrors)
+               hn->AddBinError2(targetLinBin, partial.fHn->GetBinError2(i));
+            hn->AddBinContent(targetLinBin, v);
+         }
+      } else {
+         for (Int_t bin = 0; bin < hist->GetNcells(); ++bin) {
+            // errors first, or sqrt(content) is taken into account
+            if (wantErrors) {
+               Double_t preverr = hist->GetBinError(bin);
+               hist->SetBinError(bin, TMath::Sqrt(preverr * preverr + partial.fError2[bin]));
+            }
+            hist->AddBinContent(bin, partial.fContent[bin]);
+         }
+      }
+   }
+   return haveSkippedBin;
+}
+
+} // unnamed namespace
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Project all bins into a ndim-dimensional THn / THnSparse (whatever
 /// *this is) or if (ndim < 4 and !wantNDim) a TH1/2/3 histogram,
@@ -521,60 +632,86 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    Bool_t wantErrors = haveErrors || (option && (strchr(option, 'E') || strchr(option, 'e')));
 
    Int_t* bins  = new Int_t[ndim];
-   Long64_t myLinBin = 0;
-
-   THnIter iter(this, kTRUE /*use axis range*/);
-
-   while ((myLinBin = iter.Next()) >= 0) {
-      Double_t v = GetBinContent(myLinBin);
-
-      for (Int_t d = 0; d < ndim; ++d) {
-         bins[d] = iter.GetCoord(dim[d]);
-         if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
-            Int_t binOffset = GetAxis(dim[d])->GetFirst();
-            // Don't subtract even more if underflow is alreday included:
-            if (binOffset > 0) --binOffset;
-            bins[d] -= binOffset;
-         }
+   Int_t* binOffsets = new Int_t[ndim];
+   for (Int_t d = 0; d < ndim; ++d) {
+      binOffsets[d] = 0;
+      if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
+         binOffsets[d] = GetAxis(dim[d])->GetFirst();
+         // Don't subtract even more if underflow is alreday included:
+         if (binOffsets[d] > 0) --binOffsets[d];
       }
-
-      Long64_t targetLinBin = -1;
-      if (!wantNDim) {
-         if (ndim == 1) targetLinBin = bins[0];
-         else if (ndim == 2) targetLinBin = hist->GetBin(bins[0], bins[1]);
-         else if (ndim == 3) targetLinBin = hist->GetBin(bins[0], bins[1], bins[2]);
-      } else {
-         targetLinBin = hn->GetBin(bins, kTRUE /*allocate*/);
+   }
+   Bool_t haveSkippedBin = kFALSE;
+
+#ifdef R__USE_IMT
+   const THnSparse *sparse = dynamic_cast<const THnSparse *>(this);
+   UInt_t nTasks = 0;
+   if (sparse && ROOT::IsImplicitMTEnabled() && GetNbins() >= 2 * kMinBinsPerProjectionTask) {
+      ROOT::TThreadExecutor pool;
+      nTasks = std::min<Long64_t>(pool.GetPoolSize(), GetNbins() / kMinBinsPerProjectionTask);
+      // The partial results must be cheap to merge compared to projecting the bins
+      if (hist && Long64_t(hist->GetNcells()) * nTasks > GetNbins())
+         nTasks = 0;
+      if (nTasks > 1) {
+         std::vector<std::unique_ptr<THnBase>> partialHns;
+         for (UInt_t task = 0; hn && task < nTasks; ++task)
+            partialHns.emplace_back(hn->CloneEmpty(hn->GetName(), hn->GetTitle(), hn->GetListOfAxes(), kTRUE));
+         haveSkippedBin = ProjectSparseParallel(pool, nTasks, *sparse, ndim, dim, binOffsets, hn, partialHns, hist,
+                                                wantErrors);
       }
-
-      if (wantErrors) {
-         Double_t err2 = 0.;
-         if (haveErrors) {
-            err2 = GetBinError2(myLinBin);
+   }
+   if (nTasks <= 1)
+#endif
+   {
+      Long64_t myLinBin = 0;
+      THnIter iter(this, kTRUE /*use axis range*/);
+
+      while ((myLinBin = iter.Next()) >= 0) {
+         Double_t v = GetBinContent(myLinBin);
+
+         for (Int_t d = 0; d < ndim; ++d)
+            bins[d] = iter.GetCoord(dim[d]) - binOffsets[d];
+
+         Long64_t targetLinBin = -1;
+         if (!wantNDim) {
+            if (ndim == 1) targetLinBin = bins[0];
+            else if (ndim == 2) targetLinBin = hist->GetBin(bins[0], bins[1]);
+            else if (ndim == 3) targetLinBin = hist->GetBin(bins[0], bins[1], bins[2]);
          } else {
-            err2 = v;
+            targetLinBin = hn->GetBin(bins, kTRUE /*allocate*/);
          }
-         if (wantNDim) {
-            hn->AddBinError2(targetLinBin, err2);
-         } else {
-            Double_t preverr = hist->GetBinError(targetLinBin);
-            hist->SetBinError(targetLinBin, TMath::Sqrt(preverr * preverr + err2));
+
+         if (wantErrors) {
+            Double_t err2 = 0.;
+            if (haveErrors) {
+               err2 = GetBinError2(myLinBin);
+            } else {
+               err2 = v;
+            }
+            if (wantNDim) {
+               hn->AddBinError2(targetLinBin, err2);
+            } else {
+               Double_t preverr = hist->GetBinError(targetLinBin);
+               hist->SetBinError(targetLinBin, TMath::Sqrt(preverr * preverr + err2));
+            }
          }
-      }
 
-      // only _after_ error calculation, or sqrt(v) is taken into account!
-      if (wantNDim)
-         hn->AddBinContent(targetLinBin, v);
-      else
-         hist->AddBinContent(targetLinBin, v);
+         // only _after_ error calculation, or sqrt(v) is taken into account!
+         if (wantNDim)
+            hn->AddBinContent(targetLinBin, v);
+         else
+            hist->AddBinContent(targetLinBin, v);
+      }
+      haveSkippedBin = iter.HaveSkippedBin();
    }
 
    delete [] bins;
+   delete [] binOffsets;
 
    if (wantNDim) {
       hn->SetEntries(fEntries);
    } else {
-      if (!iter.HaveSkippedBin()) {
+      if (!haveSkippedBin) {
          hist->SetEntries(fEntries);
       } else {
          // re-compute the entries
@@ -16,6 +16,8 @@
 #include "TDataMember.h"
 #include "TDataType.h"
 
+#include <utility>
+
 namespace {
 //______________________________________________________________________________
 //
@@ -488,6 +490,63 @@ void THnSparseArrayChunk::Sumw2()
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Move the bins into nslots slots, a power of two
+
+void THnSparseBinMap::Rehash(std::size_t nslots)
+{
+   std::vector<Slot_t> old(nslots, Slot_t{0, -1});
+   old.swap(fSlots);
+   fShift = 64;
+   for (std::size_t n = nslots; n > 1; n /= 2)
+      --fShift;
+   fSize = 0;
+   for (const Slot_t &slot : old) {
+      if (slot.fBin >= 0)
+         Insert(slot.fHash, slot.fBin);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for nbins bins without rehashing
+
+void THnSparseBinMap::Reserve(Long64_t nbins)
+{
+   // at most 80% of the slots are used
+   std::size_t nslots = 16;
+   while (nslots * 4 < (std::size_t)nbins * 5)
+      nslots *= 2;
+   if (nslots > fSlots.size())
+      Rehash(nslots);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a bin with the given hash of its compact coordinates
+
+void THnSparseBinMap::Insert(ULong64_t hash, Long64_t bin)
+{
+   if ((std::size_t)(fSize + 1) * 5 > fSlots.size() * 4)
+      Rehash(fSlots.empty() ? 16 : 2 * fSlots.size());
+
+   const ULong64_t mask = fSlots.size() - 1;
+   Slot_t entry{hash, bin};
+   ULong64_t pos = GetHome(hash);
+   for (ULong64_t dist = 0; ; ++dist, pos = (pos + 1) & mask) {
+      Slot_t &slot = fSlots[pos];
+      if (slot.fBin < 0) {
+         slot = entry;
+         ++fSize;
+         return;
+      }
+      // Take the slot from an entry closer to its home, and go on inserting that one
+      const ULong64_t slotDist = GetDistance(pos, slot.fHash);
+      if (slotDist < dist) {
+         std::swap(slot, entry);
+         dist = slotDist;
+      }
+   }
+}
+
 
 /** \class THnSparse
     \ingroup Hist
@@ -570,14 +629,15 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open-addressing hash map
+fBins (see THnSparseBinMap). For compact bin coordinates larger than 8 bytes
+different coordinates can have the same hash - which is extremely unlikely but
+possible. The map then stores all of their linear indexes, and the coordinates
+of each candidate are compared to the ones passed to GetBin() to retrieve the
+matching bin.
+
+The map is transient: it is rebuilt from the chunks when a streamed THnSparse
+is first accessed.
 */
 
 
@@ -652,34 +712,20 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 ////////////////////////////////////////////////////////////////////////////////
 ///We have been streamed; set up fBins
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinMap()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBins.Insert(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -688,11 +734,9 @@ void THnSparse::FillExMap()
 
 void THnSparse::Reserve(Long64_t nbins) {
    if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+      FillBinMap();
    }
+   fBins.Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -791,20 +835,12 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
    if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+      FillBinMap();
+   Long64_t linidx = fBins.Find(hash, [this, cc](Long64_t bin) {
+      return GetChunk(bin / fChunkSize)->Matches(bin % fChunkSize, cc->GetBuffer());
+   });
+   if (linidx >= 0 || !allocate)
+      return linidx;
 
    ++fFilledBins;
 
@@ -819,16 +855,7 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   fBins.Insert(hash, newidx);
    return newidx;
 }
 
@@ -880,7 +907,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += 2 * sizeof(Long64_t) * fBins.GetCapacity() /* THnSparseBinMap */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +989,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -43,6 +43,12 @@
 #include "TH1.h"
 #include "TVirtualPad.h"
 #include "TKDE.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 ClassImp(TKDE);
 
@@ -748,6 +754,38 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluates the kernel density estimate at the n points x, and stores the
+/// results in y. The points are evaluated in parallel when the implicit
+/// multi-threading is enabled.
+
+void TKDE::Evaluate(UInt_t n, const Double_t* x, Double_t* y) const {
+   if (!fKernel) {
+      (const_cast<TKDE*>(this))->ReInit();
+      if (!fKernel) {
+         std::fill(y, y + n, TMath::QuietNaN());
+         return;
+      }
+   }
+   const TKernel &kernel = *fKernel;
+#ifdef R__USE_IMT
+   if (n > 1 && ROOT::IsImplicitMTEnabled()) {
+      UInt_t nchunks = std::min(n, 4 * ROOT::GetThreadPoolSize());
+      auto evalChunk = [&](UInt_t ichunk) {
+         UInt_t first = ULong64_t(n) * ichunk / nchunks;
+         UInt_t last = ULong64_t(n) * (ichunk + 1) / nchunks;
+         for (UInt_t i = first; i < last; ++i)
+            y[i] = kernel(x[i]);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(evalChunk, ROOT::TSeqU(nchunks));
+      return;
+   }
+#endif
+   for (UInt_t i = 0; i < n; ++i)
+      y[i] = kernel(x[i]);
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -770,8 +808,41 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(1, weight)
-{}
+fWeights(1, weight),
+fSupport(-1)
+{
+   // sort the data points once, so that only the ones within the kernel support
+   // are summed when evaluating the estimate
+   UInt_t n = fNWeights;
+   fOrder.resize(n);
+   std::iota(fOrder.begin(), fOrder.end(), 0);
+   const std::vector<Double_t> &data = kde->fData;
+   std::sort(fOrder.begin(), fOrder.end(), [&data](UInt_t i, UInt_t j) { return data[i] < data[j]; });
+   fSorted.resize(n);
+   for (UInt_t i = 0; i < n; ++i) fSorted[i] = data[fOrder[i]];
+   SetSupport();
+}
+
+void TKDE::TKernel::SetSupport() {
+   // Computes the maximum distance from x of the points entering the estimate in x,
+   // from the support of the internal kernels and the largest bandwidth.
+   // User defined kernels can have an unbounded support: all points are used
+   Double_t range = 0;
+   switch (fKDE->fKernelType) {
+      case kGaussian :
+         range = 9.;   // see TKDE::GaussianKernel
+         break;
+      case kEpanechnikov :
+      case kBiweight :
+      case kCosineArch :
+         range = 1.;
+         break;
+      default :
+         fSupport = -1;
+         return;
+   }
+   fSupport = range * (*std::max_element(fWeights.begin(), fWeights.end()));
+}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
    // Gets the adaptive weights (bandwidths) for TKernel internal computation
@@ -808,6 +879,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    fWeights.resize(n);
    transform(weights.begin(), weights.end(), fWeights.begin(),
              std::bind(std::multiplies<Double_t>(), std::placeholders::_1, fKDE->fAdaptiveBandwidthFactor));
+   SetSupport();
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
 }
 
@@ -944,9 +1016,10 @@ TGraphErrors* TKDE::GetGraphWithErrors(UInt_t npx, double xmin, double xmax) {
    Double_t* ex = new Double_t[n + 1];
    Double_t* y = new Double_t[n + 1];
    Double_t* ey = new Double_t[n + 1];
-   for (UInt_t i = 0; i <= n; ++i) {
+   for (UInt_t i = 0; i <= n; ++i)
       x[i] = xmin + i * (xmax - xmin) / n;
-      y[i] = (*this)(x[i]);
+   Evaluate(n + 1, x, y);
+   for (UInt_t i = 0; i <= n; ++i) {
       ex[i] = 0;
       ey[i] = this->GetError(x[i]);
    }
@@ -1007,10 +1080,49 @@ const std::vector<Double_t> & TKDE::TKernel::GetAdaptiveWeights() const {
    return fWeights;
 }
 
+Double_t TKDE::TKernel::SumRange(Double_t x, Double_t dmin, Double_t dmax, Bool_t reflect, Double_t edge) const {
+   // Sums the kernels of the data points d in [dmin,dmax], centred in d or in 2 * edge - d if reflect is set
+   Double_t result(0.0);
+   Bool_t useCount = (fKDE->fBinCount.size() == fNWeights);
+   Bool_t hasAdaptiveWeights = (fWeights.size() == fNWeights);
+   Double_t invWeight = (!hasAdaptiveWeights) ? 1. / fWeights[0] : 0;
+   UInt_t first = std::lower_bound(fSorted.begin(), fSorted.end(), dmin) - fSorted.begin();
+   UInt_t last = std::upper_bound(fSorted.begin() + first, fSorted.end(), dmax) - fSorted.begin();
+   for (UInt_t k = first; k < last; ++k) {
+      UInt_t i = fOrder[k];
+      Double_t binCount = (useCount) ? fKDE->fBinCount[i] : 1.0;
+      if (hasAdaptiveWeights) {
+         if (fWeights[i] == 0) continue;
+         invWeight = 1. / fWeights[i];
+      }
+      Double_t xi = (reflect) ? 2. * edge - fSorted[k] : fSorted[k];
+      result += binCount * invWeight * (*fKDE->fKernelFunction)((x - xi) * invWeight);
+   }
+   return result;
+}
+
 Double_t TKDE::TKernel::operator()(Double_t x) const {
    // The internal class's unary function: returns the kernel density estimate
    Double_t result(0.0);
    UInt_t n = fKDE->fData.size();
+   // for kernels with a bounded support, only the points near x (or the ones whose mirror
+   // image is near x) are summed. The full sum is kept for user defined kernels and when
+   // the data have been re-filled since the kernel was created
+   if (fSupport >= 0 && n == fNWeights) {
+      result = SumRange(x, x - fSupport, x + fSupport, kFALSE, 0.);
+      if (fKDE->fAsymLeft) {
+         Double_t xm = 2. * fKDE->fXMin - x;
+         result += SumRange(x, xm - fSupport, xm + fSupport, kTRUE, fKDE->fXMin);
+      }
+      if (fKDE->fAsymRight) {
+         Double_t xm = 2. * fKDE->fXMax - x;
+         result += SumRange(x, xm - fSupport, xm + fSupport, kTRUE, fKDE->fXMax);
+      }
+      if ( TMath::IsNaN(result) ) {
+         fKDE->Warning("operator()","Result is NaN for  x %f \n",x);
+      }
+      return result / fKDE->fSumOfCounts;
+   }
    // case of bins or weighted data
    Bool_t useCount = (fKDE->fBinCount.size() == n);
    // also in case of unbinned unweighted data fSumOfCounts is sum of events in range
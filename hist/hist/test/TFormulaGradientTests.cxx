@@ -21,6 +21,10 @@
 #include <TFormula.h>
 #include <TF1.h>
 #include <TFitResult.h>
+#include <TEnv.h>
+#include <TH1D.h>
+
+#include <cmath>
 
 TEST(TFormulaGradientPar, Sanity)
 {
@@ -144,3 +148,30 @@ TEST(TFormulaGradientPar, GetGradFormula)
 #endif // R__WIN32
 }
 
+
+// Fits of formula based functions use the clad gradient, unless Fit.CladGradient is off
+TEST(TFormulaGradientPar, FitUsesGradient)
+{
+   TH1D h("hFitGrad", "", 100, -5, 5);
+   for (int i = 1; i <= h.GetNbinsX(); ++i) {
+      const double x = h.GetBinCenter(i);
+      h.SetBinContent(i, 50. * std::exp(-0.5 * (x - 0.5) * (x - 0.5) / 2.) + 1 + (i % 2));
+      h.SetBinError(i, 1.);
+   }
+
+   const int useGradient = gEnv->GetValue("Fit.CladGradient", 1);
+   double params[2][3];
+   for (int clad = 0; clad < 2; ++clad) {
+      gEnv->SetValue("Fit.CladGradient", clad);
+      TF1 f("fFitGrad", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+      f.SetParameters(40., 0., 1.);
+      auto res = h.Fit(&f, "QN0S");
+      EXPECT_EQ(0, res->Status());
+      EXPECT_EQ(clad == 1, f.GetFormula()->HasGeneratedGradient());
+      f.GetParameters(params[clad]);
+   }
+   gEnv->SetValue("Fit.CladGradient", useGradient);
+
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(params[0][i], params[1][i], 1e-4 * std::abs(params[0][i]));
+}
@@ -3,6 +3,10 @@
 #include "THn.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "THnSparse.h"
+#include "TROOT.h"
+
+#include <memory>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -111,3 +115,96 @@ TEST(THn, Projection) {
    }
 
 }
+
+// Lookup of the bins of a THnSparse, also with compact coordinates of more than 8 bytes
+TEST(THnSparse, GetBin) {
+   for (Int_t ndim : {2, 8}) {
+      std::vector<Int_t> bins(ndim, 1000);
+      std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1000.);
+      THnSparseD hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data(), 128);
+
+      std::vector<Int_t> coord(ndim);
+      auto setCoord = [&](Int_t i) {
+         for (Int_t d = 0; d < ndim; ++d)
+            coord[d] = 1 + (i * (d + 7) + d) % 1000;
+      };
+      const Int_t nfilled = 5000;
+      for (Int_t i = 0; i < nfilled; ++i) {
+         setCoord(i);
+         EXPECT_EQ(i, hs.GetBin(coord.data(), kTRUE));
+         hs.AddBinContent(i, i);
+      }
+      EXPECT_EQ(nfilled, hs.GetNbins());
+
+      for (Int_t i = 0; i < nfilled; ++i) {
+         setCoord(i);
+         EXPECT_EQ(i, hs.GetBin(coord.data(), kFALSE));
+         EXPECT_EQ(i, hs.GetBinContent(coord.data()));
+      }
+      coord.assign(ndim, 1000);
+      EXPECT_EQ(-1, hs.GetBin(coord.data(), kFALSE));
+
+      hs.Reset();
+      EXPECT_EQ(0, hs.GetNbins());
+      setCoord(42);
+      EXPECT_EQ(-1, hs.GetBin(coord.data(), kFALSE));
+   }
+}
+
+// Projections of a THnSparse are the same with and without IMT
+TEST(THnSparse, ProjectionIMT) {
+   const Int_t ndim = 4;
+   Int_t bins[ndim] = {50, 40, 30, 20};
+   Double_t xmin[ndim] = {0., 0., 0., 0.};
+   Double_t xmax[ndim] = {1., 1., 1., 1.};
+   THnSparseD hs("hsproj", "hsproj", ndim, bins, xmin, xmax);
+   hs.Sumw2();
+   // distinct bins, including underflow and overflow
+   Int_t coord[ndim];
+   for (Int_t i = 0; i < 300000; ++i) {
+      Int_t rest = i;
+      for (Int_t d = 0; d < ndim; ++d) {
+         coord[d] = rest % (bins[d] + 2);
+         rest /= bins[d] + 2;
+      }
+      Long64_t bin = hs.GetBin(coord, kTRUE);
+      hs.AddBinContent(bin, 1. + i % 3);
+      hs.AddBinError2(bin, (1. + i % 3) * (1. + i % 3));
+   }
+   hs.SetEntries(300000);
+   ASSERT_GE(hs.GetNbins(), 2 * (1 << 16));
+   hs.GetAxis(3)->SetRange(2, 15);
+
+   Int_t dims[2] = {0, 2};
+   std::unique_ptr<TH1D> h1(hs.Projection(1));
+   std::unique_ptr<TH2D> h2(hs.Projection(2, 0));
+   std::unique_ptr<THnSparse> hn(hs.Projection(2, dims));
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   std::unique_ptr<TH1D> h1MT(hs.Projection(1));
+   std::unique_ptr<TH2D> h2MT(hs.Projection(2, 0));
+   std::unique_ptr<THnSparse> hnMT(hs.Projection(2, dims));
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   for (Int_t bin = 0; bin < h1->GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(h1->GetBinContent(bin), h1MT->GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(h1->GetBinError(bin), h1MT->GetBinError(bin));
+   }
+   EXPECT_DOUBLE_EQ(h1->GetEntries(), h1MT->GetEntries());
+   for (Int_t bin = 0; bin < h2->GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(h2->GetBinContent(bin), h2MT->GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(h2->GetBinError(bin), h2MT->GetBinError(bin));
+   }
+   ASSERT_EQ(hn->GetNbins(), hnMT->GetNbins());
+   for (Long64_t i = 0; i < hn->GetNbins(); ++i) {
+      Double_t v = hn->GetBinContent(i, coord);
+      Long64_t binMT = hnMT->GetBin(coord, kFALSE);
+      ASSERT_LE(0, binMT);
+      EXPECT_DOUBLE_EQ(v, hnMT->GetBinContent(binMT));
+      EXPECT_DOUBLE_EQ(hn->GetBinError2(i), hnMT->GetBinError2(binMT));
+   }
+}
@@ -0,0 +1,175 @@
+#include "TConcurrentFiller.h"
+#include "TEfficiency.h"
+#include "TH1.h"
+#include "TList.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Values exactly representable, so that the sums do not depend on the order of the fills
+double XValue(int i)
+{
+   return (i % 120) * 0.125 - 2.;
+}
+double YValue(int i)
+{
+   return (i % 7) - 3.;
+}
+double Weight(int i)
+{
+   return 1. + (i % 3);
+}
+
+template <typename F>
+void RunThreads(int nThreads, int nFillsPerThread, F &&fill)
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t]() {
+         for (int i = t * nFillsPerThread; i < (t + 1) * nFillsPerThread; ++i)
+            fill(i);
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
+
+void ExpectSameProfile(const TH1 &expected, const TH1 &actual)
+{
+   EXPECT_EQ(expected.GetEntries(), actual.GetEntries());
+   double expectedStats[TH1::kNstat] = {0};
+   double actualStats[TH1::kNstat] = {0};
+   expected.GetStats(expectedStats);
+   actual.GetStats(actualStats);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_DOUBLE_EQ(expectedStats[i], actualStats[i]) << "statistics " << i;
+   for (int bin = 0; bin < expected.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(expected.GetBinContent(bin), actual.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(expected.GetBinError(bin), actual.GetBinError(bin)) << "bin " << bin;
+   }
+}
+
+} // namespace
+
+TEST(TConcurrentFiller, Profile)
+{
+   const int nThreads = 4;
+   const int nFills = 10000;
+   TProfile expected("expected", "expected", 10, -1., 10., -2.5, 2.5);
+   TProfile actual("actual", "actual", 10, -1., 10., -2.5, 2.5);
+   expected.SetDirectory(nullptr);
+   actual.SetDirectory(nullptr);
+   for (int i = 0; i < nThreads * nFills; ++i)
+      expected.Fill(XValue(i), YValue(i));
+
+   {
+      TProfileConcurrentFiller<TProfile> filler(actual);
+      RunThreads(nThreads, nFills, [&](int i) { filler.Fill(XValue(i), YValue(i)); });
+   }
+   ExpectSameProfile(expected, actual);
+   for (int bin = 0; bin < expected.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(expected.GetBinEntries(bin), actual.GetBinEntries(bin));
+}
+
+TEST(TConcurrentFiller, WeightedProfile2D)
+{
+   const int nThreads = 4;
+   const int nFills = 10000;
+   TProfile2D expected("expected", "expected", 10, -1., 10., 7, -3.5, 3.5);
+   TProfile2D actual("actual", "actual", 10, -1., 10., 7, -3.5, 3.5);
+   expected.SetDirectory(nullptr);
+   actual.SetDirectory(nullptr);
+   // the content filled before the concurrent fills is kept
+   expected.Fill(1., 1., 1.);
+   actual.Fill(1., 1., 1.);
+   for (int i = 0; i < nThreads * nFills; ++i)
+      expected.Fill(XValue(i), YValue(i), XValue(i) * YValue(i), Weight(i));
+
+   TProfileConcurrentFiller<TProfile2D> filler(actual);
+   RunThreads(nThreads, nFills,
+              [&](int i) { filler.Fill(XValue(i), YValue(i), XValue(i) * YValue(i), Weight(i)); });
+   filler.Flush();
+   ExpectSameProfile(expected, actual);
+   ASSERT_EQ(actual.GetBinSumw2()->GetSize(), actual.GetNcells());
+   for (int bin = 0; bin < expected.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(expected.GetBinSumw2()->At(bin), actual.GetBinSumw2()->At(bin));
+}
+
+TEST(TConcurrentFiller, Efficiency)
+{
+   const int nThreads = 4;
+   const int nFills = 10000;
+   TEfficiency expected("expected", "expected", 20, -2., 13.);
+   TEfficiency actual("actual", "actual", 20, -2., 13.);
+   expected.SetDirectory(nullptr);
+   actual.SetDirectory(nullptr);
+   for (int i = 0; i < nThreads * nFills; ++i)
+      expected.FillWeighted(i % 5 == 0, Weight(i), XValue(i));
+
+   {
+      TEfficiencyConcurrentFiller filler(actual);
+      RunThreads(nThreads, nFills, [&](int i) { filler.FillWeighted(i % 5 == 0, Weight(i), XValue(i)); });
+   }
+   EXPECT_TRUE(actual.UsesWeights());
+   ExpectSameProfile(*expected.GetTotalHistogram(), *actual.GetTotalHistogram());
+   ExpectSameProfile(*expected.GetPassedHistogram(), *actual.GetPassedHistogram());
+   for (int bin = 1; bin <= 20; ++bin)
+      EXPECT_DOUBLE_EQ(expected.GetEfficiency(bin), actual.GetEfficiency(bin));
+}
+
+TEST(TConcurrentFiller, EfficiencyMerge)
+{
+   TEfficiency expected("expected", "expected", 20, -2., 13.);
+   TEfficiency merged("merged", "merged", 20, -2., 13.);
+   expected.SetDirectory(nullptr);
+   merged.SetDirectory(nullptr);
+   TList list;
+   list.SetOwner();
+   for (int j = 0; j < 3; ++j) {
+      auto eff = new TEfficiency("part", "part", 20, -2., 13.);
+      eff->SetDirectory(nullptr);
+      for (int i = 0; i < 1000; ++i)
+         eff->Fill((i + j) % 3 == 0, XValue(i * (j + 1)));
+      eff->SetWeight(j + 1.);
+      expected += *eff;
+      list.Add(eff);
+   }
+   merged.Merge(&list);
+   EXPECT_DOUBLE_EQ(expected.GetWeight(), merged.GetWeight());
+   ExpectSameProfile(*expected.GetTotalHistogram(), *merged.GetTotalHistogram());
+   ExpectSameProfile(*expected.GetPassedHistogram(), *merged.GetPassedHistogram());
+}
+
+#ifdef R__USE_IMT
+TEST(TConcurrentFiller, ParallelProfileMerge)
+{
+   const int nBins = 100000;
+   TProfile serial("serial", "serial", nBins, 0., 15.);
+   TProfile parallel("parallel", "parallel", nBins, 0., 15.);
+   serial.SetDirectory(nullptr);
+   parallel.SetDirectory(nullptr);
+   TList list;
+   list.SetOwner();
+   for (int j = 0; j < 4; ++j) {
+      auto p = new TProfile("part", "part", nBins, 0., 15.);
+      p->SetDirectory(nullptr);
+      for (int i = 0; i < 20000; ++i)
+         p->Fill(XValue(i + j) + 2., YValue(i), Weight(i + j));
+      list.Add(p);
+   }
+
+   serial.Merge(&list);
+   ROOT::EnableImplicitMT(4);
+   parallel.Merge(&list);
+   ROOT::DisableImplicitMT();
+   ExpectSameProfile(serial, parallel);
+}
+#endif
@@ -2,8 +2,15 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH1D.h"
+#include "TF1.h"
+#include "TEnv.h"
 #include "THLimitsFinder.h"
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
 {
@@ -46,3 +53,101 @@ TEST(THLimitsFinder, Degenerate)
    EXPECT_LE(xmin, centralValue - 5.);
    EXPECT_GE(xmax, centralValue + 5.);
 }
+
+// FillN finds the same bins and statistics as Fill
+static void ExpectSameFill(TH1D &hFill, TH1D &hFillN, const std::vector<double> &xs, const std::vector<double> &ws)
+{
+   for (std::size_t i = 0; i < xs.size(); ++i)
+      hFill.Fill(xs[i], ws[i]);
+   hFillN.FillN(xs.size(), xs.data(), ws.data());
+
+   ASSERT_EQ(hFill.GetNbinsX(), hFillN.GetNbinsX());
+   for (int bin = 0; bin <= hFill.GetNbinsX() + 1; ++bin) {
+      EXPECT_EQ(hFill.GetBinContent(bin), hFillN.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(hFill.GetBinError(bin), hFillN.GetBinError(bin)) << "bin " << bin;
+   }
+   Double_t statsFill[4], statsFillN[4];
+   hFill.GetStats(statsFill);
+   hFillN.GetStats(statsFillN);
+   for (int i = 0; i < 4; ++i)
+      EXPECT_EQ(statsFill[i], statsFillN[i]) << "stat " << i;
+   EXPECT_EQ(hFill.GetEntries(), hFillN.GetEntries());
+}
+
+static std::vector<double> GetFillNValues()
+{
+   std::vector<double> xs{-1., 0., 0.1, 0.25, 0.5, 1., 2., 10., -0., std::numeric_limits<double>::quiet_NaN(),
+                          std::numeric_limits<double>::infinity()};
+   for (int i = 0; i < 1000; ++i)
+      xs.push_back(-0.2 + 1.4 * ((i * 7919) % 1000) / 1000.);
+   return xs;
+}
+
+TEST(TH1, FillNFixedBins)
+{
+   auto xs = GetFillNValues();
+   std::vector<double> ws(xs.size(), 1.);
+   TH1D hFill("hFill", "", 10, 0, 1);
+   TH1D hFillN("hFillN", "", 10, 0, 1);
+   ExpectSameFill(hFill, hFillN, xs, ws);
+
+   for (std::size_t i = 0; i < ws.size(); ++i)
+      ws[i] = 0.5 + i % 3;
+   TH1D hFillW("hFillW", "", 7, 0, 1);
+   TH1D hFillNW("hFillNW", "", 7, 0, 1);
+   hFillW.SetStatOverflows(TH1::EStatOverflows::kConsider);
+   hFillNW.SetStatOverflows(TH1::EStatOverflows::kConsider);
+   ExpectSameFill(hFillW, hFillNW, xs, ws);
+}
+
+TEST(TH1, FillNVariableBins)
+{
+   auto xs = GetFillNValues();
+   std::vector<double> ws(xs.size());
+   for (std::size_t i = 0; i < ws.size(); ++i)
+      ws[i] = (i % 5) - 1.;
+   const double edges[] = {0., 0.1, 0.25, 0.3, 0.5, 0.9, 1.};
+   TH1D hFill("hFillVar", "", 6, edges);
+   TH1D hFillN("hFillNVar", "", 6, edges);
+   ExpectSameFill(hFill, hFillN, xs, ws);
+}
+
+TEST(TH1, FillNExtendableAxis)
+{
+   std::vector<double> xs{0.5, 0.2, 3.5, -1.5, 0.7};
+   std::vector<double> ws(xs.size(), 2.);
+   TH1D hFill("hFillExt", "", 10, 0, 1);
+   TH1D hFillN("hFillNExt", "", 10, 0, 1);
+   hFill.SetCanExtend(TH1::kAllAxes);
+   hFillN.SetCanExtend(TH1::kAllAxes);
+   ExpectSameFill(hFill, hFillN, xs, ws);
+   EXPECT_EQ(0., hFillN.GetBinContent(0));
+   EXPECT_EQ(0., hFillN.GetBinContent(hFillN.GetNbinsX() + 1));
+}
+
+// Fits of formulas to many points use a vectorized copy of the formula, if available
+TEST(TH1, FitFormulaVectorized)
+{
+   TH1D h("hFitVec", "", 2000, -5, 5);
+   for (int i = 1; i <= h.GetNbinsX(); ++i) {
+      const double x = h.GetBinCenter(i);
+      h.SetBinContent(i, 100. * std::exp(-0.5 * (x - 0.3) * (x - 0.3)) + 1 + (i % 3));
+      h.SetBinError(i, 1.);
+   }
+
+   const int minPoints = gEnv->GetValue("Fit.VectorizeFormula", 1000);
+   double params[2][3];
+   for (int vectorize = 0; vectorize < 2; ++vectorize) {
+      gEnv->SetValue("Fit.VectorizeFormula", vectorize ? 1 : 0);
+      TF1 f("fFitVec", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+      f.SetParameters(80., 0., 1.5);
+      EXPECT_EQ(0, int(h.Fit(&f, "QN0")));
+      EXPECT_FALSE(f.IsVectorized());
+      f.GetParameters(params[vectorize]);
+   }
+   gEnv->SetValue("Fit.VectorizeFormula", minPoints);
+
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(params[0][i], params[1][i], 1e-6 * std::abs(params[0][i]));
+   EXPECT_NEAR(0.3, params[1][1], 1e-2);
+}
@@ -496,4 +496,32 @@ TEST(TKDE, tkde_io_mirror)
    for (size_t i = 0; i < t.xtest.size(); ++i) {
       EXPECT_NEAR(t.values1[i], t.values2[i], delta);
    }
-}
\ No newline at end of file
+}
+/// Batch evaluation and comparison with the sum over all the data points
+TEST(TKDE, tkde_evaluate)
+{
+   const int n = 5000;
+   TRandom3 r(2222);
+   std::vector<double> data(n);
+   for (int i = 0; i < n; ++i)
+      data[i] = r.Gaus(0, 2);
+
+   TKDE kde(n, data.data(), -10, 10, "KernelType:Epanechnikov;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned");
+   const int npx = 101;
+   std::vector<double> x(npx), y(npx);
+   for (int i = 0; i < npx; ++i)
+      x[i] = -10 + 0.2 * i;
+   kde.Evaluate(npx, x.data(), y.data());
+
+   double h = kde.GetFixedWeight();
+   for (int i = 0; i < npx; ++i) {
+      double sum = 0;
+      for (int j = 0; j < n; ++j) {
+         double u = (x[i] - data[j]) / h;
+         if (u > -1 && u < 1)
+            sum += 0.75 * (1 - u * u) / h;
+      }
+      EXPECT_DOUBLE_EQ(y[i], kde(x[i]));
+      EXPECT_NEAR(y[i], sum / n, 1.E-12);
+   }
+}
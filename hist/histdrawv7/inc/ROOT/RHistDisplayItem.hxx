@@ -28,7 +28,7 @@ class RAxisBase;
 class RHistDisplayItem : public RIndirectDisplayItem {
    std::vector<const RAxisBase *> fAxes;   ///< histogram axes, only temporary pointers
    std::vector<int> fIndicies;             ///< [left,right,step] for each axes
-   std::vector<double> fBinContent;        ///< extracted bins values
+   std::vector<double> fBinContent;        ///< extracted bins values, JSON_base64
    double fContMin{0.};                    ///< minimum content value
    double fContMinPos{0.};                 ///< minimum positive value
    double fContMax{0.};                    ///< maximum content value
@@ -10,6 +10,7 @@
  *************************************************************************/
 
 #include <cstdlib>
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <cctype>
@@ -5744,7 +5745,7 @@ void THistPainter::PaintColorLevelsFast(Option_t*)
 
 void THistPainter::PaintColorLevels(Option_t*)
 {
-   Double_t z, zc, xk, xstep, yk, ystep, xlow, xup, ylow, yup;
+   Double_t z, xk, xstep, yk, ystep, xlow, xup, ylow, yup;
 
    Double_t zmin = fH->GetMinimum();
    Double_t zmax = fH->GetMaximum();
@@ -5806,9 +5807,38 @@ void THistPainter::PaintColorLevels(Option_t*)
    if (fH->TestBit(TH1::kUserContour) == 0) fH->SetContour(ndiv);
    Double_t scale = (dz ? ndivz / dz : 1.0);
 
+   // The user contour levels in pad coordinates, sorted to find the level
+   // of a bin with a binary search
+   std::vector<Double_t> levels;
+   if (fH->TestBit(TH1::kUserContour)) {
+      levels.resize(ndiv);
+      for (Int_t k=0; k<ndiv; k++) levels[k] = fH->GetContourLevelPad(k);
+      std::sort(levels.begin(), levels.end());
+   }
+   Double_t level0 = fH->TestBit(TH1::kUserContour) ? fH->GetContourLevelPad(0) : 0;
+
+   // In cartesian coordinates the adjacent bins of a row with the same color
+   // are merged in a single box, which is painted when the next bin does not
+   // extend it. This reduces a lot the number of boxes sent to the pad
+   // painter (or to the PostScript/PDF/image files) for large histograms.
+   Double_t bxlow = 0, bylow = 0, bxup = 0, byup = 0;
+   Int_t bcolor = -1;
+   Int_t fillcolor = -1;
+   auto paintPendingBox = [&]() {
+      if (bcolor < 0) return;
+      if (bcolor != fillcolor) {
+         fillcolor = bcolor;
+         fH->SetFillColor(fillcolor);
+         fH->TAttFill::Modify();
+      }
+      gPad->PaintBox(bxlow, bylow, bxup, byup);
+      bcolor = -1;
+   };
+
    Int_t color;
    TProfile2D* prof2d = dynamic_cast<TProfile2D*>(fH);
    for (Int_t j=Hparam.yfirst; j<=Hparam.ylast;j++) {
+      paintPendingBox();
       yk    = fYaxis->GetBinLowEdge(j);
       ystep = fYaxis->GetBinWidth(j);
       for (Int_t i=Hparam.xfirst; i<=Hparam.xlast;i++) {
@@ -5865,34 +5895,37 @@ void THistPainter::PaintColorLevels(Option_t*)
          }
 
          if (fH->TestBit(TH1::kUserContour)) {
-            zc = fH->GetContourLevelPad(0);
-            if (z < zc) continue;
-            color = -1;
-            for (Int_t k=0; k<ndiv; k++) {
-               zc = fH->GetContourLevelPad(k);
-               if (z < zc) {
-                  continue;
-               } else {
-                  color++;
-               }
-            }
+            if (z < level0) continue;
+            // number of levels below or equal to z, minus one
+            color = Int_t(std::upper_bound(levels.begin(), levels.end(), z) - levels.begin()) - 1;
          } else {
             color = Int_t(0.01+(z-zmin)*scale);
          }
 
          Int_t theColor = Int_t((color+0.99)*Float_t(ncolors)/Float_t(ndivz));
          if (theColor > ncolors-1) theColor = ncolors-1;
-         fH->SetFillColor(gStyle->GetColorPalette(theColor));
-         fH->TAttFill::Modify();
+         Int_t fcolor = gStyle->GetColorPalette(theColor);
          if (Hoption.System != kPOLAR) {
-            gPad->PaintBox(xlow, ylow, xup, yup);
+            if (fcolor == bcolor && xlow == bxup && ylow == bylow && yup == byup) {
+               bxup = xup;
+            } else {
+               paintPendingBox();
+               bxlow  = xlow;
+               bylow  = ylow;
+               bxup   = xup;
+               byup   = yup;
+               bcolor = fcolor;
+            }
          } else  {
+            fH->SetFillColor(fcolor);
+            fH->TAttFill::Modify();
             TCrown crown(0,0,ylow,yup,xlow*TMath::RadToDeg(),xup*TMath::RadToDeg());
-            crown.SetFillColor(gStyle->GetColorPalette(theColor));
+            crown.SetFillColor(fcolor);
             crown.Paint();
          }
       }
    }
+   paintPendingBox();
 
    if (Hoption.Zscale) PaintPalette();
 
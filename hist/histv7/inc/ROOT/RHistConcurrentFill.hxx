@@ -19,7 +19,10 @@
 #include "ROOT/RSpan.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
 
+#include <array>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -31,17 +34,27 @@ class RHistConcurrentFillManager;
  \class RHistConcurrentFiller
  Buffers a thread's Fill calls and submits them to the
  RHistConcurrentFillManager. Enables multi-threaded filling.
+
+ The bins of the buffered coordinates are found by the filler itself, outside
+ of any lock; the manager only adds the weights to the bins.
  **/
 
 template <class HIST, int SIZE>
 class RHistConcurrentFiller: public Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE> {
    RHistConcurrentFillManager<HIST, SIZE> &fManager;
+   /// The shard of the manager this filler fills, -1 for the histogram itself.
+   int fShard;
+   /// The bins of the buffered coordinates, determined in `FlushImpl()`.
+   std::array<int, SIZE> fBinBuf;
 
 public:
    using CoordArray_t = typename HIST::CoordArray_t;
    using Weight_t = typename HIST::Weight_t;
 
-   RHistConcurrentFiller(RHistConcurrentFillManager<HIST, SIZE> &manager): fManager(manager) {}
+   RHistConcurrentFiller(RHistConcurrentFillManager<HIST, SIZE> &manager, int shard = -1)
+      : fManager(manager), fShard(shard)
+   {
+   }
 
    /// Thread-specific HIST::Fill().
    using Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE>::Fill;
@@ -59,7 +72,16 @@ public:
 
 private:
    friend class Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE>;
-   void FlushImpl() { fManager.FillN(this->GetCoords(), this->GetWeights()); }
+   void FlushImpl()
+   {
+      const auto coords = this->GetCoords();
+      if (coords.empty())
+         return;
+      const auto *impl = fManager.fHist.GetImpl();
+      for (size_t i = 0; i < coords.size(); ++i)
+         fBinBuf[i] = impl->GetBinIndexAndGrow(coords[i]);
+      fManager.FillBins(fShard, coords, std::span<const int>(fBinBuf.data(), coords.size()), this->GetWeights());
+   }
 };
 
 /**
@@ -68,9 +90,15 @@ private:
 
  The HIST template can be a RHist instance. This class hands out
  RHistConcurrentFiller objects that can concurrently fill the histogram. They
- buffer calls to Fill() until the buffer is full, and then swap the buffer
- with that of the RHistConcurrentFillManager. The manager than fills the
- histogram.
+ buffer calls to Fill() until the buffer is full, find the bins of the buffered
+ coordinates, and hand the bins and weights to the manager, which adds them to
+ the histogram under a lock.
+
+ With many threads, the manager can be constructed with a number of shards:
+ the fillers are distributed over the shards, each accumulating the statistics
+ of its fillers under its own lock. Merge(), also called on destruction of the
+ manager, adds them to the histogram. Until then the histogram does not see
+ the fills.
  **/
 
 template <class HIST, int SIZE = 1024>
@@ -83,13 +111,62 @@ public:
    using Weight_t = typename HIST::Weight_t;
 
 private:
+   using Stat_t = typename HIST::ImplBase_t::Stat_t;
+
+   /// Statistics accumulated by the fillers of one shard.
+   struct RShard {
+      std::mutex fMutex;
+      Stat_t fStat;
+      RShard(size_t nBins, size_t nOverflowBins) : fStat(nBins, nOverflowBins) {}
+   };
+
    HIST &fHist;
    std::mutex fFillMutex; // should become a spin lock
+   std::vector<std::unique_ptr<RShard>> fShards;
+   unsigned int fNextShard = 0;
+
+   /// Add the weights to the bins `binN` of the coordinates `xN`, into the given shard or the histogram.
+   void FillBins(int shard, const std::span<const CoordArray_t> xN, const std::span<const int> binN,
+                 const std::span<const Weight_t> weightN)
+   {
+      std::mutex &mutex = shard < 0 ? fFillMutex : fShards[shard]->fMutex;
+      Stat_t &stat = shard < 0 ? fHist.GetImpl()->GetStat() : fShards[shard]->fStat;
+      std::lock_guard<std::mutex> lockGuard(mutex);
+      for (size_t i = 0; i < xN.size(); ++i)
+         stat.Fill(xN[i], binN[i], weightN[i]);
+   }
 
 public:
-   RHistConcurrentFillManager(HIST &hist): fHist(hist) {}
+   /// Manage the filling of `hist`, directly or with `nShards` shards.
+   RHistConcurrentFillManager(HIST &hist, unsigned int nShards = 0): fHist(hist)
+   {
+      for (unsigned int i = 0; i < nShards; ++i)
+         fShards.emplace_back(new RShard(hist.GetImpl()->GetNBinsNoOver(), hist.GetImpl()->GetNOverflowBins()));
+   }
+
+   ~RHistConcurrentFillManager() { Merge(); }
 
-   RHistConcurrentFiller<HIST, SIZE> MakeFiller() { return RHistConcurrentFiller<HIST, SIZE>{*this}; }
+   /// Make a filler; with shards, fillers are distributed round-robin.
+   RHistConcurrentFiller<HIST, SIZE> MakeFiller()
+   {
+      std::lock_guard<std::mutex> lockGuard(fFillMutex);
+      if (fShards.empty())
+         return RHistConcurrentFiller<HIST, SIZE>{*this};
+      return RHistConcurrentFiller<HIST, SIZE>{*this, (int)(fNextShard++ % fShards.size())};
+   }
+
+   /// Add the statistics accumulated by the shards to the histogram, and reset them. Fills that fillers still
+   /// buffer are not included; Flush() them first.
+   void Merge()
+   {
+      for (auto &shard : fShards) {
+         std::lock(shard->fMutex, fFillMutex);
+         std::lock_guard<std::mutex> shardGuard(shard->fMutex, std::adopt_lock);
+         std::lock_guard<std::mutex> fillGuard(fFillMutex, std::adopt_lock);
+         fHist.GetImpl()->GetStat().Add(shard->fStat);
+         shard->fStat = Stat_t(fHist.GetImpl()->GetNBinsNoOver(), fHist.GetImpl()->GetNOverflowBins());
+      }
+   }
 
    /// Thread-specific HIST::FillN().
    void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN)
@@ -397,8 +397,8 @@ public:
    using BinStat_t = RBinStat;
 
 private:
-   std::array<Weight_t, DIMENSIONS> fMomentXW;
-   std::array<Weight_t, DIMENSIONS> fMomentX2W;
+   std::array<Weight_t, DIMENSIONS> fMomentXW{};
+   std::array<Weight_t, DIMENSIONS> fMomentX2W{};
    // FIXME: Add sum(w.x.y)-style stats.
 
 public:
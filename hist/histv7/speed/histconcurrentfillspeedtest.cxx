@@ -0,0 +1,130 @@
+/// \file histconcurrentfillspeedtest.cxx
+///
+/// Compare multi-threaded filling of a 2D histogram: TH2D with ROOT::TThreadedObject, and RH2D with
+/// RHistConcurrentFillManager, filling the histogram directly or through shards.
+///
+///     g++ -o concurrentfillspeedtest histconcurrentfillspeedtest.cxx `root-config --cflags --libs` -O3
+///     ./concurrentfillspeedtest [fills per thread, default 1e7] [number of threads, default 4]
+///
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+#include "TH2.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "ROOT/TThreadedObject.hxx"
+
+#include "ROOT/RHist.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace ROOT;
+
+struct Timer {
+   using TimePoint_t = decltype(std::chrono::high_resolution_clock::now());
+
+   const char *fTitle;
+   size_t fCount;
+   TimePoint_t fStart;
+
+   Timer(const char *title, size_t count)
+      : fTitle(title), fCount(count), fStart(std::chrono::high_resolution_clock::now())
+   {}
+
+   ~Timer()
+   {
+      using namespace std::chrono;
+      auto end = high_resolution_clock::now();
+      duration<double> time_span = duration_cast<duration<double>>(end - fStart);
+      std::cout << fCount << " * " << fTitle << ": " << time_span.count() << " seconds, \t";
+      std::cout << fCount / (1e6) / time_span.count() << " millions per seconds \n";
+   }
+};
+
+/// The same pseudo-random coordinates for all tests, one vector per thread.
+std::vector<std::vector<double>> GenerateInput(size_t count, unsigned int nThreads)
+{
+   std::vector<std::vector<double>> input(nThreads);
+   for (unsigned int t = 0; t < nThreads; ++t) {
+      TRandom3 r(t + 1);
+      input[t].resize(2 * count);
+      for (auto &x : input[t])
+         x = r.Uniform(-0.1, 1.1);
+   }
+   return input;
+}
+
+template <class FILLTHREAD>
+void RunThreads(unsigned int nThreads, FILLTHREAD fillThread)
+{
+   std::vector<std::thread> threads;
+   for (unsigned int t = 0; t < nThreads; ++t)
+      threads.emplace_back(fillThread, t);
+   for (auto &thr : threads)
+      thr.join();
+}
+
+double FillTThreadedObject(const std::vector<std::vector<double>> &input, unsigned int nThreads)
+{
+   const size_t count = input[0].size() / 2;
+   TThreadedObject<TH2D> hist("h", "h", 100, 0., 1., 100, 0., 1.);
+   std::shared_ptr<TH2D> merged;
+   {
+      Timer t("TH2D, TThreadedObject", count * nThreads);
+      RunThreads(nThreads, [&](unsigned int thread) {
+         auto slot = hist.Get();
+         const auto &x = input[thread];
+         for (size_t i = 0; i < count; ++i)
+            slot->Fill(x[2 * i], x[2 * i + 1]);
+      });
+      merged = hist.Merge();
+   }
+   return merged->GetEntries();
+}
+
+double FillConcurrentFillManager(const std::vector<std::vector<double>> &input, unsigned int nThreads,
+                                 unsigned int nShards)
+{
+   const size_t count = input[0].size() / 2;
+   Experimental::RH2D hist{{100, 0., 1.}, {100, 0., 1.}};
+   {
+      Timer t(nShards ? "RH2D, RHistConcurrentFillManager with shards" : "RH2D, RHistConcurrentFillManager",
+              count * nThreads);
+      Experimental::RHistConcurrentFillManager<Experimental::RH2D> fillMgr(hist, nShards);
+      RunThreads(nThreads, [&](unsigned int thread) {
+         auto filler = fillMgr.MakeFiller();
+         const auto &x = input[thread];
+         for (size_t i = 0; i < count; ++i)
+            filler.Fill({x[2 * i], x[2 * i + 1]});
+      });
+   }
+   return hist.GetEntries();
+}
+
+int main(int argc, char *argv[])
+{
+   const size_t count = argc > 1 ? (size_t)std::atof(argv[1]) : (size_t)1e7;
+   const unsigned int nThreads = argc > 2 ? std::atoi(argv[2]) : 4;
+
+   ROOT::EnableThreadSafety();
+   TH1::AddDirectory(false);
+   const auto input = GenerateInput(count, nThreads);
+
+   double entries[3];
+   entries[0] = FillTThreadedObject(input, nThreads);
+   entries[1] = FillConcurrentFillManager(input, nThreads, 0);
+   entries[2] = FillConcurrentFillManager(input, nThreads, nThreads);
+
+   for (double e : entries) {
+      if (e != (double)count * nThreads) {
+         std::cerr << "Wrong number of entries: " << e << '\n';
+         return 1;
+      }
+   }
+   return 0;
+}
@@ -143,3 +143,36 @@ TEST(ConcurrentFillTest, FillFlush)
    EXPECT_EQ(0, (int)Filler_1.GetCoords().size());
    EXPECT_EQ(0, (int)Filler_2.GetCoords().size());
 }
+
+// Test filling through shards, merged into the hist by Merge()
+TEST(ConcurrentFillTest, Shards)
+{
+   Experimental::RH2D hist{{100, 0., 1.}, {{0., 1., 2., 3., 10.}}};
+   {
+      Experimental::RHistConcurrentFillManager<Experimental::RH2D> fillMgr(hist, 3);
+
+      std::array<std::thread, 4> threads;
+      for (auto &thr : threads)
+         thr = std::thread(fillWithWeights, fillMgr.MakeFiller());
+      for (auto &thr : threads)
+         thr.join();
+
+      // The fills are in the shards
+      EXPECT_EQ(0, hist.GetEntries());
+      fillMgr.Merge();
+      EXPECT_EQ(4 * 3000, hist.GetEntries());
+      EXPECT_FLOAT_EQ(4 * 42.f, hist.GetBinContent({(double)42 / 100, (double)42 / 10}));
+
+      // Merging again does not add the shards twice
+      fillMgr.Merge();
+      EXPECT_EQ(4 * 3000, hist.GetEntries());
+
+      Filler_t filler = fillMgr.MakeFiller();
+      filler.Fill({0.1111, 4.22}, .5f);
+      filler.Flush();
+      EXPECT_EQ(4 * 3000, hist.GetEntries());
+   }
+   // The manager merges on destruction
+   EXPECT_EQ(4 * 3000 + 1, hist.GetEntries());
+   EXPECT_FLOAT_EQ(.5f, hist.GetBinContent({0.1111, 4.22}));
+}
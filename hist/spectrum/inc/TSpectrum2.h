@@ -13,6 +13,9 @@
 
 #include "TNamed.h"
 
+#include <utility>
+#include <vector>
+
 class TH1;
 
 class TSpectrum2 : public TNamed {
@@ -26,6 +29,7 @@ protected:
    TH1           *fHistogram;       ///< resulting histogram
 static Int_t      fgAverageWindow;  ///< Average window of searched peaks
 static Int_t      fgIterations;     ///< Maximum number of decon iterations (default=3)
+static Bool_t     fgUseFFT;         ///< Whether the deconvolutions use FFTs (default=kFALSE)
 
 public:
    enum {
@@ -47,6 +51,7 @@ public:
    virtual Int_t Search(const TH1 *hist, Double_t sigma=2, Option_t *option="", Double_t threshold=0.05);
    static void   SetAverageWindow(Int_t w=3);   //set average window
    static void   SetDeconIterations(Int_t n=3); //set max number of decon iterations
+   static void   SetUseFFT(Bool_t use=kTRUE);   //compute the deconvolutions with FFTs
    void          SetResolution(Double_t resolution=1); // *NOT USED*
 
    //new functions January 2006
@@ -57,6 +62,8 @@ public:
 
    static Int_t        StaticSearch(const TH1 *hist, Double_t sigma=2, Option_t *option="goff", Double_t threshold=0.05);
    static TH1         *StaticBackground(const TH1 *hist,Int_t niter=20, Option_t *option="");
+   static std::vector<std::vector<std::pair<Double_t, Double_t>>>
+                       SearchBatch(const std::vector<const TH1 *> &hists, Double_t sigma=2, Option_t *option="", Double_t threshold=0.05, Int_t maxpositions=100);
 
    ClassDef(TSpectrum2,1)  //Peak Finder, background estimator, Deconvolution for 2-D histograms
 };
@@ -25,6 +25,7 @@ protected:
    Double_t      *fPositionZ;      ///< [fNPeaks] Z positions of peaks
    Double_t       fResolution;     ///< *NOT USED* resolution of the neighboring peaks
    TH1           *fHistogram;      ///< resulting histogram
+static Bool_t      fgUseFFT;        ///< Whether the deconvolutions use FFTs (default=kFALSE)
 
 public:
    enum {
@@ -50,6 +51,7 @@ public:
    Int_t               SearchFast(const Double_t ***source, Double_t ***dest, Int_t ssizex, Int_t ssizey, Int_t ssizez, Double_t sigma, Double_t threshold, Bool_t markov, Int_t averWindow);
    Int_t               SearchHighRes(const Double_t ***source,Double_t ***dest, Int_t ssizex, Int_t ssizey, Int_t ssizez, Double_t sigma, Double_t threshold, Bool_t backgroundRemove,Int_t deconIterations, Bool_t markov, Int_t averWindow);
    void                SetResolution(Double_t resolution=1); // *NOT USED*
+   static void         SetUseFFT(Bool_t use=kTRUE); // compute the deconvolutions with FFTs
    const char         *SmoothMarkov(Double_t ***source, Int_t ssizex, Int_t ssizey, Int_t ssizez, Int_t averWindow);
 
    ClassDef(TSpectrum3,1)  //Peak Finder, Background estimator, Markov smoothing and Deconvolution for 3-D histograms
@@ -44,10 +44,19 @@
 #include "TList.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumCorrelation.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 #define PEAK_WINDOW 1024
 
 Int_t TSpectrum2::fgIterations    = 3;
 Int_t TSpectrum2::fgAverageWindow = 3;
+Bool_t TSpectrum2::fgUseFFT       = kFALSE;
 
 ClassImp(TSpectrum2);
 
@@ -115,6 +124,24 @@ void TSpectrum2::SetDeconIterations(Int_t n)
    fgIterations = n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// static function: Compute the iterations of the deconvolutions with FFTs of
+/// the spectra, see TSpectrum2::Deconvolution and TSpectrum2::SearchHighRes.
+/// Each iteration then costs O(N log N) operations for N channels instead of
+/// up to N times the size of the response. The results differ by rounding
+/// errors from the direct computation, used by default.
+/// The FFTs require the fftw library (ROOT built with fftw3=ON); if it is not
+/// available the direct computation is kept.
+
+void TSpectrum2::SetUseFFT(Bool_t use)
+{
+   if (use && !TSpectrumCorrelation::IsFFTAvailable()) {
+      ::Warning("TSpectrum2::SetUseFFT", "the fftw plugin is not available, the FFTs cannot be used");
+      use = kFALSE;
+   }
+   fgUseFFT = use;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///   This function calculates the background spectrum in the input histogram h.
 ///   The background is returned as a histogram.
@@ -932,6 +959,17 @@ const char *TSpectrum2::Deconvolution(Double_t **source, Double_t **resp,
       }
    }
 
+   //matrix b=ht*h in the layout of TSpectrumCorrelation
+   const Int_t sizes[2] = {ssizex, ssizey};
+   const Int_t halfWidths[2] = {lhx - 1, lhy - 1};
+   std::vector<Double_t> bmatrix((2 * lhx - 1) * (2 * lhy - 1));
+   for (j2 = i2min; j2 <= i2max; j2++) {
+      for (j1 = i1min; j1 <= i1max; j1++)
+         bmatrix[(j1 - i1min) + (2 * lhx - 1) * (j2 - i2min)] = working_space[j1 - i1min][j2 - i2min + 2 * ssizey];
+   }
+   TSpectrumCorrelation correlation(2, sizes, halfWidths, std::move(bmatrix), fgUseFFT);
+   std::vector<Double_t> xcur(ssizex * ssizey), xb(ssizex * ssizey);
+
    //START OF ITERATIONS
    for (repet = 0; repet < numberRepetitions; repet++) {
       if (repet != 0) {
@@ -943,30 +981,14 @@ const char *TSpectrum2::Deconvolution(Double_t **source, Double_t **resp,
          }
       }
       for (lindex = 0; lindex < numberIterations; lindex++) {
+         for (i2 = 0; i2 < ssizey; i2++) {
+            for (i1 = 0; i1 < ssizex; i1++)
+               xcur[i1 + ssizex * i2] = working_space[i1][i2 + 3 * ssizey];
+         }
+         correlation.Correlate(xcur.data(), xb.data());
          for (i2 = 0; i2 < ssizey; i2++) {
             for (i1 = 0; i1 < ssizex; i1++) {
-               ldb = 0;
-               j2min = i2;
-               if (j2min > lhy - 1)
-                  j2min = lhy - 1;
-               j2min = -j2min;
-               j2max = ssizey - i2 - 1;
-               if (j2max > lhy - 1)
-                  j2max = lhy - 1;
-               j1min = i1;
-               if (j1min > lhx - 1)
-                  j1min = lhx - 1;
-               j1min = -j1min;
-               j1max = ssizex - i1 - 1;
-               if (j1max > lhx - 1)
-                  j1max = lhx - 1;
-               for (j2 = j2min; j2 <= j2max; j2++) {
-                  for (j1 = j1min; j1 <= j1max; j1++) {
-                     ldc =  working_space[j1 - i1min][j2 - i2min + 2 * ssizey];
-                     lda = working_space[i1 + j1][i2 + j2 + 3 * ssizey];
-                     ldb = ldb + lda * ldc;
-                  }
-               }
+               ldb = xb[i1 + ssizex * i2];
                lda = working_space[i1][i2 + 3 * ssizey];
                ldc = working_space[i1][i2 + 1 * ssizey];
                if (ldc * lda != 0 && ldb != 0) {
@@ -1562,40 +1584,35 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
          working_space[i1][i2 + 2 * ssizey_ext] = 0;
       }
    }
+   //matrix b=ht*h in the layout of TSpectrumCorrelation
+   const Int_t sizes[2] = {ssizex_ext, ssizey_ext};
+   const Int_t halfWidths[2] = {lhx - 1, lhy - 1};
+   std::vector<Double_t> bmatrix((2 * lhx - 1) * (2 * lhy - 1));
+   for(j2 = -(lhy - 1); j2 <= lhy - 1; j2++){
+      for(j1 = -(lhx - 1); j1 <= lhx - 1; j1++){
+         k = (j1 + ssizex_ext) / ssizex_ext;
+         bmatrix[(j1 + lhx - 1) + (2 * lhx - 1) * (j2 + lhy - 1)] = working_space[(j1 + ssizex_ext) % ssizex_ext][j2 + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext];
+      }
+   }
+   TSpectrumCorrelation correlation(2, sizes, halfWidths, std::move(bmatrix), fgUseFFT);
+   std::vector<Double_t> xcur(ssizex_ext * ssizey_ext), xb(ssizex_ext * ssizey_ext);
+   std::vector<UChar_t> needed(ssizex_ext * ssizey_ext);
+
    //START OF ITERATIONS
    for(lindex = 0; lindex < deconIterations; lindex++){
       for(i2 = 0; i2 < ssizey_ext; i2++){
          for(i1 = 0; i1 < ssizex_ext; i1++){
             lda = working_space[i1][i2 + ssizey_ext];
             ldc = working_space[i1][i2 + 14 * ssizey_ext];
-            if(lda > 0.000001 && ldc > 0.000001){
-               ldb=0;
-               j2min=i2;
-               if(j2min > lhy - 1)
-                  j2min = lhy - 1;
-
-               j2min = -j2min;
-               j2max = ssizey_ext - i2 - 1;
-               if(j2max > lhy - 1)
-                  j2max = lhy - 1;
-
-               j1min = i1;
-               if(j1min > lhx - 1)
-                  j1min = lhx - 1;
-
-               j1min = -j1min;
-               j1max = ssizex_ext - i1 - 1;
-               if(j1max > lhx - 1)
-                  j1max = lhx - 1;
-
-               for(j2 = j2min; j2 <= j2max; j2++){
-                  for(j1 = j1min; j1 <= j1max; j1++){
-                     k = (j1 + ssizex_ext) / ssizex_ext;
-                     ldc = working_space[(j1 + ssizex_ext) % ssizex_ext][j2 + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext];
-                     lda = working_space[i1 + j1][i2 + j2 + ssizey_ext];
-                     ldb = ldb + lda * ldc;
-                  }
-               }
+            xcur[i1 + ssizex_ext * i2] = lda;
+            needed[i1 + ssizex_ext * i2] = lda > 0.000001 && ldc > 0.000001;
+         }
+      }
+      correlation.Correlate(xcur.data(), xb.data(), needed.data());
+      for(i2 = 0; i2 < ssizey_ext; i2++){
+         for(i1 = 0; i1 < ssizex_ext; i1++){
+            if(needed[i1 + ssizex_ext * i2]){
+               ldb = xb[i1 + ssizex_ext * i2];
                lda = working_space[i1][i2 + ssizey_ext];
                ldc = working_space[i1][i2 + 14 * ssizey_ext];
                if(ldc * lda != 0 && ldb != 0){
@@ -1721,3 +1738,46 @@ TH1 *TSpectrum2::StaticBackground(const TH1 *hist,Int_t niter, Option_t *option)
    TSpectrum2 s;
    return s.Background(hist,niter,option);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// static function: Search for peaks in each of the 2-d histograms hists, as
+/// done by Search(hist, sigma, option, threshold) for a TSpectrum2 finding up
+/// to maxpositions peaks. The option "goff" is always added: no polymarker
+/// is attached to the histograms.
+/// Return for each histogram the (x, y) positions of its peaks.
+///
+/// When implicit multi-threading is enabled, the histograms are searched in
+/// parallel tasks. The histograms must not be modified during the call.
+/// ~~~ {.cpp}
+///    ROOT::EnableImplicitMT();
+///    auto peaks = TSpectrum2::SearchBatch({h1, h2, h3}, 2, "nobackground");
+///    for (auto &xy : peaks[1])
+///       printf("peak of h2 at %g, %g\n", xy.first, xy.second);
+/// ~~~
+
+std::vector<std::vector<std::pair<Double_t, Double_t>>>
+TSpectrum2::SearchBatch(const std::vector<const TH1 *> &hists, Double_t sigma, Option_t *option, Double_t threshold,
+                        Int_t maxpositions)
+{
+   TString opt = option;
+   if (!opt.Contains("goff", TString::kIgnoreCase))
+      opt += " goff";
+   std::vector<std::vector<std::pair<Double_t, Double_t>>> peaks(hists.size());
+   auto search = [&](UInt_t i) {
+      TSpectrum2 s(maxpositions);
+      const Int_t npeaks = s.Search(hists[i], sigma, opt.Data(), threshold);
+      peaks[i].reserve(npeaks);
+      for (Int_t p = 0; p < npeaks; p++)
+         peaks[i].emplace_back(s.fPositionX[p], s.fPositionY[p]);
+   };
+#ifdef R__USE_IMT
+   if (hists.size() > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(search, ROOT::TSeqU(hists.size()));
+      return peaks;
+   }
+#endif
+   for (UInt_t i = 0; i < hists.size(); i++)
+      search(i);
+   return peaks;
+}
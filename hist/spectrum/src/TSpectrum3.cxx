@@ -48,8 +48,11 @@
 #include "TSpectrum3.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumCorrelation.h"
 #define PEAK_WINDOW 1024
 
+Bool_t TSpectrum3::fgUseFFT = kFALSE;
+
 ClassImp(TSpectrum3);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -216,6 +219,24 @@ Int_t TSpectrum3::Search(const TH1 * hin, Double_t sigma,
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// static function: Compute the iterations of the deconvolutions with FFTs of
+/// the spectra, see TSpectrum3::Deconvolution and TSpectrum3::SearchHighRes.
+/// Each iteration then costs O(N log N) operations for N channels instead of
+/// up to N times the size of the response. The results differ by rounding
+/// errors from the direct computation, used by default.
+/// The FFTs require the fftw library (ROOT built with fftw3=ON); if it is not
+/// available the direct computation is kept.
+
+void TSpectrum3::SetUseFFT(Bool_t use)
+{
+   if (use && !TSpectrumCorrelation::IsFFTAvailable()) {
+      ::Warning("TSpectrum3::SetUseFFT", "the fftw plugin is not available, the FFTs cannot be used");
+      use = kFALSE;
+   }
+   fgUseFFT = use;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// *NOT USED*
 ///  resolution: determines resolution of the neighbouring peaks
@@ -1722,6 +1743,20 @@ const char *TSpectrum3::Deconvolution(Double_t***source, const Double_t***resp,
       }
    }
 
+//matrix b=ht*h in the layout of TSpectrumCorrelation
+   const Int_t sizes[3] = {ssizex, ssizey, ssizez};
+   const Int_t halfWidths[3] = {lhx - 1, lhy - 1, lhz - 1};
+   std::vector<Double_t> bmatrix((2 * lhx - 1) * (2 * lhy - 1) * (2 * lhz - 1));
+   for (j3 = i3min; j3 <= i3max; j3++) {
+      for (j2 = i2min; j2 <= i2max; j2++) {
+         for (j1 = i1min; j1 <= i1max; j1++)
+            bmatrix[(j1 - i1min) + (2 * lhx - 1) * ((j2 - i2min) + (2 * lhy - 1) * (j3 - i3min))] =
+               working_space[j1 - i1min][j2 - i2min][j3 - i3min + 2 * ssizez];
+      }
+   }
+   TSpectrumCorrelation correlation(3, sizes, halfWidths, std::move(bmatrix), fgUseFFT);
+   std::vector<Double_t> xcur(ssizex * ssizey * ssizez), xb(ssizex * ssizey * ssizez);
+
  //START OF ITERATIONS
    for (repet = 0; repet < numberRepetitions; repet++) {
       if (repet != 0) {
@@ -1734,40 +1769,17 @@ const char *TSpectrum3::Deconvolution(Double_t***source, const Double_t***resp,
          }
       }
       for (lindex = 0; lindex < numberIterations; lindex++) {
+         for (i3 = 0; i3 < ssizez; i3++) {
+            for (i2 = 0; i2 < ssizey; i2++) {
+               for (i1 = 0; i1 < ssizex; i1++)
+                  xcur[i1 + ssizex * (i2 + ssizey * i3)] = working_space[i1][i2][i3 + 3 * ssizez];
+            }
+         }
+         correlation.Correlate(xcur.data(), xb.data());
          for (i3 = 0; i3 < ssizez; i3++) {
             for (i2 = 0; i2 < ssizey; i2++) {
                for (i1 = 0; i1 < ssizex; i1++) {
-                  ldb = 0;
-                  j3min = i3;
-                  if (j3min > lhz - 1)
-                     j3min = lhz - 1;
-                  j3min = -j3min;
-                  j3max = ssizez - i3 - 1;
-                  if (j3max > lhz - 1)
-                     j3max = lhz - 1;
-                  j2min = i2;
-                  if (j2min > lhy - 1)
-                     j2min = lhy - 1;
-                  j2min = -j2min;
-                  j2max = ssizey - i2 - 1;
-                  if (j2max > lhy - 1)
-                     j2max = lhy - 1;
-                  j1min = i1;
-                  if (j1min > lhx - 1)
-                     j1min = lhx - 1;
-                  j1min = -j1min;
-                  j1max = ssizex - i1 - 1;
-                  if (j1max > lhx - 1)
-                     j1max = lhx - 1;
-                  for (j3 = j3min; j3 <= j3max; j3++) {
-                     for (j2 = j2min; j2 <= j2max; j2++) {
-                        for (j1 = j1min; j1 <= j1max; j1++) {
-                           ldc =  working_space[j1 - i1min][j2 - i2min][j3 - i3min + 2 * ssizez];
-                           lda = working_space[i1 + j1][i2 + j2][i3 + j3 + 3 * ssizez];
-                           ldb = ldb + lda * ldc;
-                        }
-                     }
-                  }
+                  ldb = xb[i1 + ssizex * (i2 + ssizey * i3)];
                   lda = working_space[i1][i2][i3 + 3 * ssizez];
                   ldc = working_space[i1][i2][i3 + 1 * ssizez];
                   if (ldc * lda != 0 && ldb != 0) {
@@ -3026,49 +3038,39 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
       }
    }
 
+//matrix b=ht*h in the layout of TSpectrumCorrelation
+   const Int_t sizes[3] = {sizex_ext, sizey_ext, sizez_ext};
+   const Int_t halfWidths[3] = {lhx - 1, lhy - 1, lhz - 1};
+   std::vector<Double_t> bmatrix((2 * lhx - 1) * (2 * lhy - 1) * (2 * lhz - 1));
+   for (j3 = i3min; j3 <= i3max; j3++) {
+      for (j2 = i2min; j2 <= i2max; j2++) {
+         for (j1 = i1min; j1 <= i1max; j1++)
+            bmatrix[(j1 - i1min) + (2 * lhx - 1) * ((j2 - i2min) + (2 * lhy - 1) * (j3 - i3min))] =
+               working_space[j1 - i1min][j2 - i2min][j3 - i3min + 2 * sizez_ext];
+      }
+   }
+   TSpectrumCorrelation correlation(3, sizes, halfWidths, std::move(bmatrix), fgUseFFT);
+   std::vector<Double_t> xcur(sizex_ext * sizey_ext * sizez_ext), xb(sizex_ext * sizey_ext * sizez_ext);
+   std::vector<UChar_t> needed(sizex_ext * sizey_ext * sizez_ext);
+
 //START OF ITERATIONS
    for (lindex=0;lindex<deconIterations;lindex++){
       for (i3 = 0; i3 < sizez_ext; i3++) {
          for (i2 = 0; i2 < sizey_ext; i2++) {
             for (i1 = 0; i1 < sizex_ext; i1++) {
-               if (TMath::Abs(working_space[i1][i2][i3 + 3 * sizez_ext])>1e-6 && TMath::Abs(working_space[i1][i2][i3 + 1 * sizez_ext])>1e-6){
-                  ldb = 0;
-                  j3min = i3;
-                  if (j3min > lhz - 1)
-                     j3min = lhz - 1;
-
-                  j3min = -j3min;
-                  j3max = sizez_ext - i3 - 1;
-                  if (j3max > lhz - 1)
-                     j3max = lhz - 1;
-
-                  j2min = i2;
-                  if (j2min > lhy - 1)
-                     j2min = lhy - 1;
-
-                  j2min = -j2min;
-                  j2max = sizey_ext - i2 - 1;
-                  if (j2max > lhy - 1)
-                     j2max = lhy - 1;
-
-                  j1min = i1;
-                  if (j1min > lhx - 1)
-                     j1min = lhx - 1;
-
-                  j1min = -j1min;
-                  j1max = sizex_ext - i1 - 1;
-                  if (j1max > lhx - 1)
-                     j1max = lhx - 1;
-
-                  for (j3 = j3min; j3 <= j3max; j3++) {
-                     for (j2 = j2min; j2 <= j2max; j2++) {
-                        for (j1 = j1min; j1 <= j1max; j1++) {
-                           ldc =  working_space[j1 - i1min][j2 - i2min][j3 - i3min + 2 * sizez_ext];
-                           lda = working_space[i1 + j1][i2 + j2][i3 + j3 + 3 * sizez_ext];
-                           ldb = ldb + lda * ldc;
-                        }
-                     }
-                  }
+               lda = working_space[i1][i2][i3 + 3 * sizez_ext];
+               xcur[i1 + sizex_ext * (i2 + sizey_ext * i3)] = lda;
+               needed[i1 + sizex_ext * (i2 + sizey_ext * i3)] =
+                  TMath::Abs(lda)>1e-6 && TMath::Abs(working_space[i1][i2][i3 + 1 * sizez_ext])>1e-6;
+            }
+         }
+      }
+      correlation.Correlate(xcur.data(), xb.data(), needed.data());
+      for (i3 = 0; i3 < sizez_ext; i3++) {
+         for (i2 = 0; i2 < sizey_ext; i2++) {
+            for (i1 = 0; i1 < sizex_ext; i1++) {
+               if (needed[i1 + sizex_ext * (i2 + sizey_ext * i3)]){
+                  ldb = xb[i1 + sizex_ext * (i2 + sizey_ext * i3)];
                   lda = working_space[i1][i2][i3 + 3 * sizez_ext];
                   ldc = working_space[i1][i2][i3 + 1 * sizez_ext];
                   if (ldc * lda != 0 && ldb != 0) {
@@ -0,0 +1,277 @@
+// @(#)root/spectrum:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TSpectrumCorrelation
+    \ingroup Spectrumanalysis
+
+Internal helper of the Gold deconvolutions of TSpectrum2 and TSpectrum3.
+
+Each iteration of the deconvolution computes, for every channel i of the
+spectrum x, the sum y(i) = sum_j b(j) x(i+j) over the channels i+j inside
+of the spectrum, b being the fixed matrix b = h^T h of the response h. The
+half widths a of b can be as large as the spectrum, so that an iteration
+costs up to (2a+1)^d multiply-adds per channel.
+
+The direct computation keeps the summation order of the original loops and
+gives the same results; it is split in tasks when implicit multi-threading
+is enabled. The FFT computation pads the spectrum with at least a zeros in
+each dimension, so that the circular correlation equals the clipped one,
+and costs O(N log N) per iteration whatever the size of b. Its results
+differ from the direct ones by rounding errors. It requires the fftw
+plugin of TVirtualFFT, the direct computation is used if it is missing.
+*/
+
+#include "TSpectrumCorrelation.h"
+
+#include "RConfigure.h"
+#include "TMath.h"
+#include "TPluginManager.h"
+#include "TROOT.h"
+#include "TVirtualFFT.h"
+#include "TVirtualMutex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace {
+
+// Smallest number of multiply-adds for which a direct correlation is split in tasks
+const Long64_t kMinWork = 100000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Smallest size not below n with only factors 2, 3, 5 and 7, for which the
+/// FFTs are fast.
+
+Int_t GetFFTSize(Int_t n)
+{
+   for (Int_t size = TMath::Max(n, 1);; size++) {
+      Int_t m = size;
+      for (Int_t f : {2, 3, 5, 7}) {
+         while (m % f == 0)
+            m /= f;
+      }
+      if (m == 1)
+         return size;
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Correlation of spectra of ndim = 2 or 3 dimensions of sizes n, with the
+/// first index running fastest, with the kernel of half widths a. The kernel
+/// element b(j1,j2,j3), -a <= j <= a, is at index
+/// (j1+a1) + (2a1+1) * ((j2+a2) + (2a2+1) * (j3+a3)) of kernel. The FFTs are
+/// used if useFFT is true and the fftw plugin is available.
+
+TSpectrumCorrelation::TSpectrumCorrelation(Int_t ndim, const Int_t *n, const Int_t *a, std::vector<Double_t> kernel,
+                                           Bool_t useFFT)
+   : fNdim(ndim), fN{1, 1, 1}, fA{0, 0, 0}, fKernel(std::move(kernel))
+{
+   for (Int_t d = 0; d < fNdim; d++) {
+      fN[d] = n[d];
+      fA[d] = a[d];
+   }
+   if (useFFT && IsFFTAvailable())
+      InitFFT();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor, the FFTW plans are destroyed under the global lock as they are
+/// created by TVirtualFFT::FFT.
+
+TSpectrumCorrelation::~TSpectrumCorrelation()
+{
+   if (fForward || fBackward) {
+      R__LOCKGUARD(gROOTMutex);
+      delete fForward;
+      delete fBackward;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the FFTs can be computed, i.e. whether the real to complex and
+/// complex to real transforms of the fftw plugin can be loaded.
+
+Bool_t TSpectrumCorrelation::IsFFTAvailable()
+{
+   if (strcmp(TVirtualFFT::GetDefaultFFT(), "fftw") != 0 && strlen(TVirtualFFT::GetDefaultFFT()) != 0)
+      return kFALSE;
+   for (const char *name : {"fftwr2c", "fftwc2r"}) {
+      TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", name);
+      if (!h || h->CheckPlugin() == -1)
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the transforms of the padded spectra and compute the one of the kernel.
+
+void TSpectrumCorrelation::InitFFT()
+{
+   Int_t p[3] = {1, 1, 1};
+   Int_t dims[3];
+   Long64_t total = 1;
+   for (Int_t d = 0; d < fNdim; d++) {
+      p[d] = GetFFTSize(fN[d] + fA[d]);
+      total *= p[d];
+   }
+   // the FFTs are row major, the last index running fastest
+   for (Int_t d = 0; d < fNdim; d++)
+      dims[d] = p[fNdim - 1 - d];
+   if (total > kMaxInt)
+      return;
+
+   fForward = TVirtualFFT::FFT(fNdim, dims, "R2C ES K");
+   fBackward = TVirtualFFT::FFT(fNdim, dims, "C2R ES K");
+   if (!fForward || !fBackward) {
+      R__LOCKGUARD(gROOTMutex);
+      delete fForward;
+      delete fBackward;
+      fForward = fBackward = nullptr;
+      return;
+   }
+
+   // b(j) is placed at -j modulo the padded sizes, so that the convolution with
+   // it is the correlation with b
+   fPadded.assign(total, 0.);
+   const Int_t w1 = 2 * fA[0] + 1, w2 = 2 * fA[1] + 1;
+   for (Int_t j3 = -fA[2]; j3 <= fA[2]; j3++) {
+      const Int_t m3 = (p[2] - j3) % p[2];
+      for (Int_t j2 = -fA[1]; j2 <= fA[1]; j2++) {
+         const Int_t m2 = (p[1] - j2) % p[1];
+         for (Int_t j1 = -fA[0]; j1 <= fA[0]; j1++) {
+            const Int_t m1 = (p[0] - j1) % p[0];
+            fPadded[m1 + p[0] * (m2 + Long64_t(p[1]) * m3)] =
+               fKernel[(j1 + fA[0]) + w1 * ((j2 + fA[1]) + w2 * (j3 + fA[2]))];
+         }
+      }
+   }
+   const Long64_t ncomplex = total / p[0] * (p[0] / 2 + 1);
+   fKernelRe.resize(ncomplex);
+   fKernelIm.resize(ncomplex);
+   fRe.resize(ncomplex);
+   fIm.resize(ncomplex);
+   fForward->SetPoints(fPadded.data());
+   fForward->Transform();
+   fForward->GetPointsComplex(fKernelRe.data(), fKernelIm.data());
+   // the backward transform is not normalised
+   const Double_t norm = 1. / total;
+   for (Long64_t i = 0; i < ncomplex; i++) {
+      fKernelRe[i] *= norm;
+      fKernelIm[i] *= norm;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute y(i) = sum_j b(j) x(i+j), the sum running over the channels i+j of
+/// the spectrum. If needed is given, y(i) is only used by the caller where
+/// needed[i] is not null, and the direct computation skips the other channels.
+
+void TSpectrumCorrelation::Correlate(const Double_t *x, Double_t *y, const UChar_t *needed)
+{
+   if (fForward)
+      CorrelateFFT(x, y);
+   else
+      CorrelateDirect(x, y, needed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Direct computation, in the order of the loops of the deconvolutions: last
+/// index of the kernel outermost. The rows of the spectrum are processed in
+/// parallel tasks when implicit multi-threading is enabled.
+
+void TSpectrumCorrelation::CorrelateDirect(const Double_t *x, Double_t *y, const UChar_t *needed) const
+{
+   const Int_t n1 = fN[0], n2 = fN[1], n3 = fN[2];
+   const Int_t a1 = fA[0], a2 = fA[1], a3 = fA[2];
+   const Int_t w1 = 2 * a1 + 1, w2 = 2 * a2 + 1;
+   const Double_t *kernel = fKernel.data();
+   const Int_t nrows = n2 * n3;
+
+   auto rows = [&](Int_t first, Int_t last) {
+      for (Int_t row = first; row < last; row++) {
+         const Int_t i2 = row % n2, i3 = row / n2;
+         const Int_t j3min = -TMath::Min(i3, a3), j3max = TMath::Min(n3 - i3 - 1, a3);
+         const Int_t j2min = -TMath::Min(i2, a2), j2max = TMath::Min(n2 - i2 - 1, a2);
+         for (Int_t i1 = 0; i1 < n1; i1++) {
+            const Long64_t index = i1 + Long64_t(n1) * row;
+            if (needed && !needed[index])
+               continue;
+            const Int_t j1min = -TMath::Min(i1, a1), j1max = TMath::Min(n1 - i1 - 1, a1);
+            Double_t ldb = 0;
+            for (Int_t j3 = j3min; j3 <= j3max; j3++) {
+               for (Int_t j2 = j2min; j2 <= j2max; j2++) {
+                  const Double_t *xrow = x + i1 + Long64_t(n1) * ((i2 + j2) + Long64_t(n2) * (i3 + j3));
+                  const Double_t *krow = kernel + a1 + w1 * ((j2 + a2) + w2 * (j3 + a3));
+                  for (Int_t j1 = j1min; j1 <= j1max; j1++)
+                     ldb = ldb + xrow[j1] * krow[j1];
+               }
+            }
+            y[index] = ldb;
+         }
+      }
+   };
+
+#ifdef R__USE_IMT
+   const Long64_t work = Long64_t(n1) * nrows * Long64_t(fKernel.size());
+   if (nrows > 1 && work >= kMinWork && ROOT::IsImplicitMTEnabled()) {
+      const Int_t nchunks = TMath::Min(nrows, 4 * Int_t(ROOT::GetThreadPoolSize()));
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(
+         [&](Int_t ichunk) {
+            rows(Int_t(Long64_t(nrows) * ichunk / nchunks), Int_t(Long64_t(nrows) * (ichunk + 1) / nchunks));
+         },
+         ROOT::TSeqI(nchunks));
+      return;
+   }
+#endif
+   rows(0, nrows);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Computation with FFTs of the spectrum padded with zeros.
+
+void TSpectrumCorrelation::CorrelateFFT(const Double_t *x, Double_t *y)
+{
+   const Int_t p1 = GetFFTSize(fN[0] + fA[0]);
+   const Int_t p2 = fNdim > 1 ? GetFFTSize(fN[1] + fA[1]) : 1;
+   const Int_t nrows = fN[1] * fN[2];
+
+   std::fill(fPadded.begin(), fPadded.end(), 0.);
+   for (Int_t row = 0; row < nrows; row++) {
+      const Int_t i2 = row % fN[1], i3 = row / fN[1];
+      std::copy(x + Long64_t(fN[0]) * row, x + Long64_t(fN[0]) * (row + 1),
+                fPadded.begin() + p1 * (i2 + Long64_t(p2) * i3));
+   }
+   fForward->SetPoints(fPadded.data());
+   fForward->Transform();
+   fForward->GetPointsComplex(fRe.data(), fIm.data());
+   for (size_t i = 0; i < fRe.size(); i++) {
+      const Double_t re = fRe[i] * fKernelRe[i] - fIm[i] * fKernelIm[i];
+      fIm[i] = fRe[i] * fKernelIm[i] + fIm[i] * fKernelRe[i];
+      fRe[i] = re;
+   }
+   fBackward->SetPointsComplex(fRe.data(), fIm.data());
+   fBackward->Transform();
+   const Double_t *out = fBackward->GetPointsReal();
+   for (Int_t row = 0; row < nrows; row++) {
+      const Int_t i2 = row % fN[1], i3 = row / fN[1];
+      const Double_t *first = out + p1 * (i2 + Long64_t(p2) * i3);
+      std::copy(first, first + fN[0], y + Long64_t(fN[0]) * row);
+   }
+}
@@ -0,0 +1,59 @@
+// @(#)root/spectrum:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TSpectrumCorrelation
+#define ROOT_TSpectrumCorrelation
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TSpectrumCorrelation                                                 //
+//                                                                      //
+// Internal helper of the Gold deconvolutions of TSpectrum2 and         //
+// TSpectrum3: correlation of a spectrum with the fixed matrix          //
+// B = H^T * H, computed directly in parallel tasks, or with FFTs.      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+
+#include <vector>
+
+class TVirtualFFT;
+
+class TSpectrumCorrelation {
+   Int_t fNdim;                     ///< Number of dimensions, 2 or 3
+   Int_t fN[3];                     ///< Sizes of the spectra, the first index running fastest
+   Int_t fA[3];                     ///< Half widths of the kernel
+   std::vector<Double_t> fKernel;   ///< The kernel b(j) at (j1+a1) + (2a1+1) * ((j2+a2) + (2a2+1) * (j3+a3))
+   TVirtualFFT *fForward = nullptr; ///< Real to complex transform of the padded spectra
+   TVirtualFFT *fBackward = nullptr;///< Complex to real transform of the products
+   std::vector<Double_t> fPadded;   ///< Spectrum padded with zeros, and result of the backward transform
+   std::vector<Double_t> fKernelRe; ///< Transform of the kernel, normalised
+   std::vector<Double_t> fKernelIm;
+   std::vector<Double_t> fRe;       ///< Transform of the spectrum
+   std::vector<Double_t> fIm;
+
+   void InitFFT();
+   void CorrelateDirect(const Double_t *x, Double_t *y, const UChar_t *needed) const;
+   void CorrelateFFT(const Double_t *x, Double_t *y);
+
+public:
+   TSpectrumCorrelation(Int_t ndim, const Int_t *n, const Int_t *a, std::vector<Double_t> kernel, Bool_t useFFT);
+   TSpectrumCorrelation(const TSpectrumCorrelation &) = delete;
+   TSpectrumCorrelation &operator=(const TSpectrumCorrelation &) = delete;
+   ~TSpectrumCorrelation();
+
+   static Bool_t IsFFTAvailable();
+
+   Bool_t UsesFFT() const { return fForward != nullptr; }
+   void Correlate(const Double_t *x, Double_t *y, const UChar_t *needed = nullptr);
+};
+
+#endif
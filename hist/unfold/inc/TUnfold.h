@@ -207,10 +207,23 @@ class TUnfold : public TObject {
    TMatrixDSparse *fEinv;
    /// matrix E
    TMatrixDSparse *fE;
+   /// keep the matrices independent of tau between calls to DoUnfold()
+   Bool_t fKeepScanCache; //!
+   /// kept matrix A<sup>T</sup>V<sub>yy</sub><sup>-1</sup>
+   TMatrixDSparse *fScanAtVyyInv; //!
+   /// kept matrix A<sup>T</sup>V<sub>yy</sub><sup>-1</sup>A
+   TMatrixDSparse *fScanAtVyyInvA; //!
+   /// kept matrix L<sup>T</sup>L
+   TMatrixDSparse *fScanLSquared; //!
+   /// kept vector A<sup>T</sup>V<sub>yy</sub><sup>-1</sup>y
+   TMatrixDSparse *fScanRhsY; //!
+   /// kept vector L<sup>T</sup>Lx<sub>0</sub>, zero if the bias scale is zero
+   TMatrixDSparse *fScanRhsX0; //!
  protected:
    // Int_t IsNotSymmetric(TMatrixDSparse const &m) const;
    virtual Double_t DoUnfold(void);     // the unfolding algorithm
    virtual void ClearResults(void);     // clear all results
+   void SetScanCache(Bool_t keep);      // keep the matrices independent of tau between calls to DoUnfold()
    void ClearHistogram(TH1 *h,Double_t x=0.) const;
    virtual TString GetOutputBinName(Int_t iBinX) const; // name a bin
    TMatrixDSparse *MultiplyMSparseM(const TMatrixDSparse *a,const TMatrixD *b) const; // multiply sparse and non-sparse matrix
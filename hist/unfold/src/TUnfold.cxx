@@ -120,10 +120,64 @@ along with TUnfold.  If not, see <http://www.gnu.org/licenses/>.
 #include <TMath.h>
 #include "TUnfold.h"
 #include "TGraph.h"
+#include "TROOT.h"
+#include "RConfigure.h"
 
 #include <map>
 #include <vector>
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace {
+
+// smallest number of multiplications for which a sparse matrix
+// product is computed in parallel tasks
+const Long64_t kMinParallelWork = 1000000;
+
+// non-zero elements of consecutive rows of a sparse matrix
+struct SparseRows_t {
+   std::vector<Int_t> fRows;
+   std::vector<Int_t> fCols;
+   std::vector<Double_t> fData;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the rows of a sparse matrix with fillRows(first,last,rows), which
+/// appends the non-zero elements of rows first to last-1 to rows. If implicit
+/// multi-threading is enabled and the work is large, the rows are split in
+/// parallel tasks. The elements are collected in row order in both cases, so
+/// the result does not depend on the number of threads.
+
+template<class F>
+void FillSparseRows(Int_t nRows,Long64_t work,F &&fillRows,SparseRows_t &result)
+{
+#ifdef R__USE_IMT
+   if((nRows>1)&&(work>=kMinParallelWork)&&ROOT::IsImplicitMTEnabled()) {
+      const Int_t nChunks=TMath::Min(nRows,4*Int_t(ROOT::GetThreadPoolSize()));
+      std::vector<SparseRows_t> chunks(nChunks);
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t iChunk) {
+            fillRows(Int_t(Long64_t(nRows)*iChunk/nChunks),
+                     Int_t(Long64_t(nRows)*(iChunk+1)/nChunks),chunks[iChunk]);
+         },ROOT::TSeqI(nChunks));
+      for(auto &chunk : chunks) {
+         result.fRows.insert(result.fRows.end(),chunk.fRows.begin(),chunk.fRows.end());
+         result.fCols.insert(result.fCols.end(),chunk.fCols.begin(),chunk.fCols.end());
+         result.fData.insert(result.fData.end(),chunk.fData.begin(),chunk.fData.end());
+      }
+      return;
+   }
+#else
+   (void)work;
+#endif
+   fillRows(0,nRows,result);
+}
+
+} // namespace
+
 //#define DEBUG
 //#define DEBUG_DETAIL
 //#define FORCE_EIGENVALUE_DECOMPOSITION
@@ -142,6 +196,7 @@ TUnfold::~TUnfold(void)
    DeleteMatrix(&fVyyInv);
 
    ClearResults();
+   SetScanCache(kFALSE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +238,12 @@ void TUnfold::InitTUnfold(void)
    fE = 0;
    fEpsMatrix=1.E-13;
    fIgnoredBins=0;
+   fKeepScanCache = kFALSE;
+   fScanAtVyyInv = 0;
+   fScanAtVyyInvA = 0;
+   fScanLSquared = 0;
+   fScanRhsY = 0;
+   fScanRhsX0 = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,6 +304,28 @@ void TUnfold::ClearResults(void)
    fRhoAvg = -1.0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep or release the matrices which do not depend on tau.
+///
+/// \param[in] keep if true, the matrices computed by the next call to
+/// DoUnfold() are reused by the following calls, until SetScanCache(kFALSE)
+///
+/// The products \f$ A^{T}V_{yy}^{-1} \f$, \f$ A^{T}V_{yy}^{-1}A \f$,
+/// \f$ L^{T}L \f$ and the corresponding vectors are the most expensive
+/// parts of DoUnfold() besides the matrix inversions. They are kept by the
+/// scans of tau, during which the input, the bias and the regularisation
+/// conditions do not change. The kept matrices are deleted in any case.
+
+void TUnfold::SetScanCache(Bool_t keep)
+{
+   fKeepScanCache = keep;
+   DeleteMatrix(&fScanAtVyyInv);
+   DeleteMatrix(&fScanAtVyyInvA);
+   DeleteMatrix(&fScanLSquared);
+   DeleteMatrix(&fScanRhsY);
+   DeleteMatrix(&fScanRhsX0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Only for use by root streamer or derived classes.
 
@@ -300,29 +383,47 @@ Double_t TUnfold::DoUnfold(void)
       }
    }
    //
-   // get matrix
-   //              T
-   //            fA fV  = mAt_V
+   // get the matrices which do not depend on tau, or the ones kept
+   // from the previous call during a scan
    //
-   TMatrixDSparse *AtVyyinv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+   if(!fScanAtVyyInv) {
+      //
+      //              T
+      //            fA fV  = mAt_V
+      //
+      fScanAtVyyInv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+      //
+      //       T
+      //     fA fVyyinv fY  and  Lsquared fX0
+      //
+      fScanRhsY=MultiplyMSparseM(fScanAtVyyInv,fY);
+      fScanLSquared=MultiplyMSparseTranspMSparse(fL,fL);
+      if (fBiasScale != 0.0) {
+         fScanRhsX0=MultiplyMSparseM(fScanLSquared,fX0);
+      }
+      //
+      //              T
+      //           (fA fV)fA
+      //
+      fScanAtVyyInvA=MultiplyMSparseMSparse(fScanAtVyyInv,fA);
+   }
+   TMatrixDSparse *AtVyyinv=fScanAtVyyInv;
+   TMatrixDSparse *lSquared=fScanLSquared;
    //
    // get
    //       T
    //     fA fVyyinv fY + fTauSquared fBiasScale Lsquared fX0 = rhs
    //
-   TMatrixDSparse *rhs=MultiplyMSparseM(AtVyyinv,fY);
-   TMatrixDSparse *lSquared=MultiplyMSparseTranspMSparse(fL,fL);
+   TMatrixDSparse *rhs=new TMatrixDSparse(*fScanRhsY);
    if (fBiasScale != 0.0) {
-     TMatrixDSparse *rhs2=MultiplyMSparseM(lSquared,fX0);
-      AddMSparse(rhs, fTauSquared * fBiasScale ,rhs2);
-      DeleteMatrix(&rhs2);
+      AddMSparse(rhs, fTauSquared * fBiasScale ,fScanRhsX0);
    }
 
    //
    // get matrix
    //              T
    //           (fA fV)fA + fTauSquared*fLsquared  = fEinv
-   fEinv=MultiplyMSparseMSparse(AtVyyinv,fA);
+   fEinv=new TMatrixDSparse(*fScanAtVyyInvA);
    AddMSparse(fEinv,fTauSquared,lSquared);
 
    //
@@ -428,8 +529,6 @@ Double_t TUnfold::DoUnfold(void)
       DeleteMatrix(&corr);
    }
 
-   DeleteMatrix(&AtVyyinv);
-
    //
    // get error matrix on x
    //   fDXDY * Vyy * fDXDY#
@@ -492,7 +591,9 @@ Double_t TUnfold::DoUnfold(void)
    DeleteMatrix(&epsilon);
 
    DeleteMatrix(&LsquaredDx);
-   DeleteMatrix(&lSquared);
+   if(!fKeepScanCache) {
+      SetScanCache(kFALSE);
+   }
 
    // calculate/store matrices defining the derivatives dx/dA
    fDXDAM[0]=new TMatrixDSparse(*fE);
@@ -637,42 +738,41 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparse(const TMatrixDSparse *a,
       if(a_rows[irow+1]>a_rows[irow]) nMax += b->GetNcols();
    }
    if((nMax>0)&&(a_cols)&&(b_cols)) {
-      Int_t *r_rows=new Int_t[nMax];
-      Int_t *r_cols=new Int_t[nMax];
-      Double_t *r_data=new Double_t[nMax];
-      Double_t *row_data=new Double_t[b->GetNcols()];
-      Int_t n=0;
-      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]<=a_rows[irow]) continue;
-         // clear row data
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            row_data[icol]=0.0;
-         }
-         // loop over a-columns in this a-row
-         for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
-            Int_t k=a_cols[ia];
-            // loop over b-columns in b-row k
-            for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
-               row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+      auto fillRows=[&](Int_t first,Int_t last,SparseRows_t &out) {
+         std::vector<Double_t> row_data(b->GetNcols());
+         for (Int_t irow = first; irow < last; irow++) {
+            if(a_rows[irow+1]<=a_rows[irow]) continue;
+            // clear row data
+            for(Int_t icol=0;icol<b->GetNcols();icol++) {
+               row_data[icol]=0.0;
             }
-         }
-         // store nonzero elements
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            if(row_data[icol] != 0.0) {
-               r_rows[n]=irow;
-               r_cols[n]=icol;
-               r_data[n]=row_data[icol];
-               n++;
+            // loop over a-columns in this a-row
+            for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
+               Int_t k=a_cols[ia];
+               // loop over b-columns in b-row k
+               for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
+                  row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+               }
+            }
+            // store nonzero elements
+            for(Int_t icol=0;icol<b->GetNcols();icol++) {
+               if(row_data[icol] != 0.0) {
+                  out.fRows.push_back(irow);
+                  out.fCols.push_back(icol);
+                  out.fData.push_back(row_data[icol]);
+               }
             }
          }
-      }
+      };
+      // number of multiplications, for elements of b evenly spread over its rows
+      Long64_t work=Long64_t(a_rows[a->GetNrows()])*b_rows[b->GetNrows()]/
+         TMath::Max(b->GetNrows(),1);
+      SparseRows_t result;
+      FillSparseRows(a->GetNrows(),nMax+work,fillRows,result);
+      Int_t n=Int_t(result.fData.size());
       if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
+         r->SetMatrixArray(n,result.fRows.data(),result.fCols.data(),result.fData.data());
       }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-      delete[] row_data;
    }
 
    return r;
@@ -866,52 +966,53 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
       v_rows=v_sparse->GetRowIndexArray();
       v_data=v_sparse->GetMatrixArray();
    }
-   Int_t num_r=num_m1*num_m2+1;
-   Int_t *row_r=new Int_t[num_r];
-   Int_t *col_r=new Int_t[num_r];
-   Double_t *data_r=new Double_t[num_r];
-   num_r=0;
-   for(Int_t i=0;i<m1->GetNrows();i++) {
-      for(Int_t j=0;j<m2->GetNrows();j++) {
-         data_r[num_r]=0.0;
-         Int_t index_m1=rows_m1[i];
-         Int_t index_m2=rows_m2[j];
-         while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
-            Int_t k1=cols_m1[index_m1];
-            Int_t k2=cols_m2[index_m2];
-            if(k1<k2) {
-               index_m1++;
-            } else if(k1>k2) {
-               index_m2++;
-            } else {
-               if(v_sparse) {
-                  Int_t v_index=v_rows[k1];
-                  if(v_index<v_rows[k1+1]) {
-                     data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                        * v_data[v_index];
-                  }
-               } else if(v) {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                     * (*v)(k1,0);
+   auto fillRows=[&](Int_t first,Int_t last,SparseRows_t &out) {
+      for(Int_t i=first;i<last;i++) {
+         for(Int_t j=0;j<m2->GetNrows();j++) {
+            Double_t data_r=0.0;
+            Int_t index_m1=rows_m1[i];
+            Int_t index_m2=rows_m2[j];
+            while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
+               Int_t k1=cols_m1[index_m1];
+               Int_t k2=cols_m2[index_m2];
+               if(k1<k2) {
+                  index_m1++;
+               } else if(k1>k2) {
+                  index_m2++;
                } else {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2];
+                  if(v_sparse) {
+                     Int_t v_index=v_rows[k1];
+                     if(v_index<v_rows[k1+1]) {
+                        data_r += data_m1[index_m1] * data_m2[index_m2]
+                           * v_data[v_index];
+                     }
+                  } else if(v) {
+                     data_r += data_m1[index_m1] * data_m2[index_m2]
+                        * (*v)(k1,0);
+                  } else {
+                     data_r += data_m1[index_m1] * data_m2[index_m2];
+                  }
+                  index_m1++;
+                  index_m2++;
                }
-               index_m1++;
-               index_m2++;
             }
-         }
-         if(data_r[num_r] !=0.0) {
-            row_r[num_r]=i;
-            col_r[num_r]=j;
-            num_r++;
+            if(data_r !=0.0) {
+               out.fRows.push_back(i);
+               out.fCols.push_back(j);
+               out.fData.push_back(data_r);
+            }
          }
       }
-   }
+   };
+   // number of steps of the merge of the rows
+   Long64_t work=Long64_t(num_m1)*num_m2+
+      Long64_t(rows_m1[m1->GetNrows()])*num_m2+
+      Long64_t(rows_m2[m2->GetNrows()])*num_m1;
+   SparseRows_t result;
+   FillSparseRows(m1->GetNrows(),work,fillRows,result);
    TMatrixDSparse *r=CreateSparseMatrix(m1->GetNrows(),m2->GetNrows(),
-                                        num_r,row_r,col_r,data_r);
-   delete[] row_r;
-   delete[] col_r;
-   delete[] data_r;
+                                        Int_t(result.fData.size()),result.fRows.data(),
+                                        result.fCols.data(),result.fData.data());
    return r;
 }
 
@@ -2554,6 +2655,9 @@ Int_t TUnfold::ScanLcurve(Int_t nPoint,
   typedef std::map<Double_t,std::pair<Double_t,Double_t> > XYtau_t;
   XYtau_t curve;
 
+  // the input does not change during the scan
+  SetScanCache(kTRUE);
+
   //==========================================================
   // algorithm:
   //  (1) do the unfolding for nPoint-1 points
@@ -2879,6 +2983,7 @@ Int_t TUnfold::ScanLcurve(Int_t nPoint,
     delete[] logT;
   }
 
+  SetScanCache(kFALSE);
   return bestChoice;
 }
 
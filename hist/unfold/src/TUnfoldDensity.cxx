@@ -1350,6 +1350,9 @@ Int_t TUnfoldDensity::ScanTau
    TauScan_t curve;
    LCurve_t lcurve;
 
+   // the input does not change during the scan
+   SetScanCache(kTRUE);
+
    //==========================================================
    // algorithm:
    //  (1) do the unfolding for nPoint-1 points
@@ -1636,6 +1639,7 @@ Int_t TUnfoldDensity::ScanTau
       delete [] x;
       delete [] logT;
    }
+   SetScanCache(kFALSE);
    return bestChoice;
 }
 
@@ -0,0 +1,37 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwap
+#define ROOT_RByteSwap
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * Copy `n` values of 2, 4 or 8 bytes from `from` to `to`, reversing the order of the bytes of each value, i.e.
+ * converting them from or to the big-endian representation of the ROOT files on little-endian hosts. The buffers do not
+ * need to be aligned but must not overlap.
+ *
+ * The kernel is picked once according to the CPU: AVX2 or SSSE3 byte shuffles on x86-64, NEON byte reversals on
+ * ARM64, and a portable loop otherwise.
+ */
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+
+/// Return the name of the byte swap kernel selected for this CPU: "avx2", "ssse3", "neon" or "scalar".
+const char *GetByteSwapKernelName();
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
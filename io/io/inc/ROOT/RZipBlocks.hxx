@@ -0,0 +1,43 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RZipBlocks
+#define ROOT_RZipBlocks
+
+#include "Compression.h"
+#include "RtypesCore.h"
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * Compress `srcsize` bytes of `src` into `tgt` as a sequence of independently compressed blocks, each one with its
+ * own compression header, as read by UnzipBlocks() and by all versions of ROOT. Without implicit multi-threading the
+ * blocks have the largest possible size (kMAXZIPBUF). With implicit multi-threading, large buffers are split into
+ * one block per thread of the pool, at least 1 MB each, and the blocks are compressed in parallel.
+ *
+ * `tgt` must hold at least `srcsize` bytes. A ZSTD dictionary identifier can be given, see R__zipMultipleAlgorithmDict.
+ * Returns the compressed size, or 0 if the buffer could not be compressed or does not get smaller.
+ */
+Int_t ZipBlocks(Int_t cxlevel, ROOT::RCompressionSetting::EAlgorithm::EValues algorithm, char *src, Int_t srcsize,
+                char *tgt, UInt_t dictID = 0);
+
+/**
+ * Decompress the sequence of compressed blocks of at most `srcsize` bytes at `src` into `tgt`, until `objlen` bytes
+ * are produced. With implicit multi-threading, a large buffer made of several blocks is decompressed in parallel.
+ * Returns the number of bytes produced, or 0 if a block could not be decompressed. If `nintot` is given, it is set to
+ * the number of compressed bytes consumed.
+ */
+Int_t UnzipBlocks(unsigned char *src, Int_t srcsize, char *tgt, Int_t objlen, Int_t *nintot = nullptr);
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
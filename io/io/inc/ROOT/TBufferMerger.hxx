@@ -155,7 +155,7 @@ private:
    void MergeImpl();
 
    void Merge();
-   void Push(TBufferFile *buffer);
+   void Push(TMemFile *memfile);
    bool TryMerge(TBufferMergerFile *memfile);
 
    bool fCompressTemporaryKeys{false};                           //< Enable compression of the TKeys in the TMemFile (save memory at the expense of time, end result is unchanged)
@@ -164,7 +164,7 @@ private:
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
    mutable std::mutex fQueueMutex;                               //< Mutex used to lock fQueue
-   std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
+   std::queue<TMemFile *> fQueue;                                //< Queue to which data is pushed and merged
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
 };
 
@@ -202,7 +202,7 @@ public:
 
    using TMemFile::Write;
 
-   /** Write data into a TBufferFile and append it to TBufferMerger.
+   /** Write data into the memory file and append its content to TBufferMerger.
     * @param name Name
     * @param opt  Options
     * @param bufsize Buffer size
@@ -131,6 +131,8 @@ public:
    static void CompactFloatString(char *buf, unsigned len);
    static const char *ConvertFloat(Float_t v, char *buf, unsigned len, Bool_t not_optimize = kFALSE);
    static const char *ConvertDouble(Double_t v, char *buf, unsigned len, Bool_t not_optimize = kFALSE);
+   static const char *ConvertLong64(Long64_t v, char *buf, unsigned len);
+   static const char *ConvertULong64(ULong64_t v, char *buf, unsigned len);
 
 protected:
    static const char *fgFloatFmt;  ///<!  printf argument for floats, either "%f" or "%e" or "%10f" and so on
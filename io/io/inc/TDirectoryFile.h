@@ -26,6 +26,8 @@
 #include "TDatime.h"
 #include "TList.h"
 
+#include <memory>
+
 class TKey;
 class TFile;
 
@@ -46,10 +48,17 @@ protected:
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
 
    void        CleanTargets();
+   Int_t       CountKeysOfClass(const char *classname) const;
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
 
 private:
+   struct RKeyIndex;
+   std::unique_ptr<RKeyIndex> fKeyIndex; ///<! sorted index of the keys not yet in fKeys, for read-only directories
+
+   TKey       *FindKeyInIndex(const char *name, Short_t cycle, Bool_t exactCycle);
+   void        MaterializeKeys();
+
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
    void operator=(const TDirectoryFile &) = delete; //Directories cannot be copied
 
@@ -90,10 +99,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override;
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
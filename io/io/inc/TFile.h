@@ -22,6 +22,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <future>
+#include <memory>
 #include <string>
 
 #include "Compression.h"
@@ -54,10 +56,12 @@ class TFilePrefetch;
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class TFileCacheWrite;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
   friend class TBasket;
+  friend class TKey;
 #endif
 
 public:
@@ -161,6 +165,8 @@ protected:
    virtual Long64_t    SysSeek(Int_t fd, Long64_t offset, Int_t whence);
    virtual Int_t       SysStat(Int_t fd, Long_t *id, Long64_t *size, Long_t *flags, Long_t *modtime);
    virtual Int_t       SysSync(Int_t fd);
+   virtual Bool_t      CanWriteBufferAt() const;
+   virtual Bool_t      WriteBufferAt(const char *buf, Long64_t pos, Int_t len);
 
    // Interface for text-based TDirectory I/O
    virtual Long64_t    DirCreateEntry(TDirectory*) { return 0; }
@@ -172,6 +178,7 @@ private:
    TFile(const TFile &) = delete;            //Files cannot be copied
    void operator=(const TFile &) = delete;
 
+           Int_t       ReadBuffersLocal(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
    static  void        CpProgress(Long64_t bytesread, Long64_t size, TStopwatch &watch);
    static  TFile      *OpenFromCache(const char *name, Option_t * = "",
                                      const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault,
@@ -299,6 +306,10 @@ public:
                             const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault,
                             Int_t netopt = 0);
    static TFile       *Open(TFileOpenHandle *handle);
+   static std::future<std::unique_ptr<TFile>>
+                       OpenAsync(const char *name, Option_t *option = "",
+                                 const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault,
+                                 Int_t netopt = 0);
 
    static EFileType    GetType(const char *name, Option_t *option = "", TString *prefix = nullptr);
 
@@ -14,6 +14,8 @@
 
 #include "TObject.h"
 
+#include <memory>
+
 class TFile;
 
 class TFileCacheWrite : public TObject {
@@ -27,9 +29,15 @@ protected:
    Bool_t        fRecursive;      ///< flag to avoid recursive calls
 
 private:
+   struct RWriteBehind;
+   std::unique_ptr<RWriteBehind> fWriteBehind; ///<! buffer being written in the background, if write-behind is enabled
+
    TFileCacheWrite(const TFileCacheWrite &) = delete;            //cannot be copied
    TFileCacheWrite& operator=(const TFileCacheWrite &) = delete;
 
+   Bool_t              FlushImpl(Bool_t wait);
+   Bool_t              WaitForWriteBehind();
+
 public:
    TFileCacheWrite();
    TFileCacheWrite(TFile *file, Int_t buffersize);
@@ -40,6 +48,8 @@ public:
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t       WriteBuffer(const char *buf, Long64_t pos, Int_t len);
    virtual void        SetFile(TFile *file);
+   Bool_t              SetWriteBehind(Bool_t writeBehind = kTRUE);
+   Bool_t              IsWriteBehind() const { return fWriteBehind != nullptr; }
 
    ClassDef(TFileCacheWrite,1)  //TFile cache when writing
 };
@@ -17,6 +17,7 @@
 #include "TString.h"
 #include "TStopwatch.h"
 #include <string>
+#include <vector>
 
 class TFile;
 class TDirectory;
@@ -51,11 +52,14 @@ protected:
    Int_t          fMaxOpenedFiles;            ///< Maximum number of files opened at the same time by the TFileMerger
    Bool_t         fLocal;                     ///< Makes local copies of merging files if True (default is kTRUE)
    Bool_t         fHistoOneGo;                ///< Merger histos in one go (default is kTRUE)
+   Bool_t         fStreaming{kFALSE};         ///<! Merge the excess files by groups in temporary files (default is kFALSE)
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitation on the max number of files opened.
 
    Bool_t         OpenExcessFiles();
+   void           CloseInputFiles();
+   Bool_t         MergeToTemporaryFiles(Int_t type, std::vector<TString> &temporaries);
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
    virtual Bool_t MergeRecursive(TDirectory *target, TList *sourcelist, Int_t type = kRegular | kAll);
 
@@ -64,6 +68,8 @@ protected:
                 const TString &path,
                 TDirectory *current_sourcedir, TFile *current_file,
                 TKey *key, TObject *obj, TIter &nextkey);
+   Bool_t         MergeHistogramsInParallel(TDirectory *target, TList *sourcelist, Int_t type, const TString &path,
+                                            TDirectory *firstdir, THashList &allNames);
 public:
    /// Type of the partial merge
    enum EPartialMergeType {
@@ -122,6 +128,8 @@ public:
    virtual void   SetFastMethod(Bool_t fast=kTRUE)  {fFastMethod = fast;}
            Bool_t GetNotrees() const { return fNoTrees; }
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
+           Bool_t GetStreaming() const { return fStreaming; }
+   virtual void   SetStreaming(Bool_t streaming=kTRUE) {fStreaming = streaming;}
    virtual void        RecursiveRemove(TObject *obj);
 
    ClassDef(TFileMerger, 6)  // File copying and merging services
@@ -25,6 +25,7 @@
 
 class TObjArray;
 class TCollectionProxyFactory;
+class TVirtualStreamerInfo;
 
 class TGenCollectionProxy
    : public TVirtualCollectionProxy
@@ -290,6 +291,7 @@ protected:
    typedef std::vector<EnvironBase_t*>     Proxies_t;
    mutable TObjArray *fReadMemberWise;                                   ///< Array of bundle of TStreamerInfoActions to stream out (read)
    mutable std::map<std::string, TObjArray*> *fConversionReadMemberWise; ///< Array of bundle of TStreamerInfoActions to stream out (read) derived from another class.
+   mutable std::map<const TVirtualStreamerInfo*, TStreamerInfoActions::TActionSequence*> *fInfoReadMemberWise; ///< Bundles of TStreamerInfoActions to stream in (read) the content described by a given StreamerInfo, e.g. of a base class of the value class.
    mutable TStreamerInfoActions::TActionSequence *fWriteMemberWise;
    typedef void (*Sizing_t)(void *obj, size_t size);
    typedef void* (*Feedfunc_t)(void *from, void *to, size_t size);
@@ -428,6 +430,7 @@ public:
    virtual TStreamerInfoActions::TActionSequence *GetConversionReadMemberWiseActions(TClass *oldClass, Int_t version);
    virtual TStreamerInfoActions::TActionSequence *GetReadMemberWiseActions(Int_t version);
    virtual TStreamerInfoActions::TActionSequence *GetWriteMemberWiseActions();
+   TStreamerInfoActions::TActionSequence *GetInfoReadMemberWiseActions(TVirtualStreamerInfo *info);
 
    // Set of functions to iterate easily through the collection
 
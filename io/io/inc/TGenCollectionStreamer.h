@@ -39,6 +39,8 @@ protected:
    template <typename basictype> void ReadBufferVectorPrimitives(TBuffer &b, void *obj, const TClass *onFileClass);
    void ReadBufferVectorPrimitivesFloat16(TBuffer &b, void *obj, const TClass *onFileClass);
    void ReadBufferVectorPrimitivesDouble32(TBuffer &b, void *obj, const TClass *onFileClass);
+   template <typename basictype> void ReadBufferVectorOfVectorPrimitives(TBuffer &b, void *obj, const TClass *onFileClass);
+   template <typename basictype> Bool_t IsVectorOfVector() const;
    void ReadBufferDefault(TBuffer &b, void *obj, const TClass *onFileClass);
    void ReadBufferGeneric(TBuffer &b, void *obj, const TClass *onFileClass);
 
@@ -43,7 +43,6 @@ private:
    Bool_t      fWritable;       ///< TRUE if mapped file opened in RDWR mode
    Longptr_t   fSemaphore;      ///< Modification semaphore (or getpid() for WIN32)
    ULongptr_t  fhSemaphore;     ///< HANDLE of WIN32 Mutex object to implement semaphore
-   TObject    *fGetting;        ///< Don't deadlock in update mode, when from Get() Add() is called
    Int_t       fWritten;        ///< Number of objects written so far
    Double_t    fSumBuffer;      ///< Sum of buffer sizes of objects written so far
    Double_t    fSum2Buffer;     ///< Sum of squares of buffer sizes of objects written so far
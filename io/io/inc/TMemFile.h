@@ -84,6 +84,9 @@ protected:
 
    EMode ParseOption(Option_t *option);
 
+   TMemFile(const char *name, TMemBlock &blocks, Long64_t size);
+   std::unique_ptr<TMemFile> DetachContent();
+
    TMemFile &operator=(const TMemFile&) = delete; // Not implemented.
 
 public:
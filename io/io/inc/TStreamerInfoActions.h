@@ -266,10 +266,7 @@ namespace TStreamerInfoActions {
          auto seq = collectionProxy->GetReadMemberWiseActions(info->GetClassVersion());
          return {seq, kFALSE};
       }
-      static SequencePtr ReadMemberWiseActionsCollectionCreator(TStreamerInfo *info, TVirtualCollectionProxy *collectionProxy, TClass * /* originalClass */) {
-         auto seq = TStreamerInfoActions::TActionSequence::CreateReadMemberWiseActions(info,*collectionProxy);
-         return {seq, kTRUE};
-      }
+      static SequencePtr ReadMemberWiseActionsCollectionCreator(TStreamerInfo *info, TVirtualCollectionProxy *collectionProxy, TClass * /* originalClass */);
       // Creator5() = Creator1;
       static SequencePtr ReadMemberWiseActionsGetter(TStreamerInfo *info, TVirtualCollectionProxy * /* collectionProxy */, TClass * /* originalClass */) {
          auto seq = info->GetReadMemberWiseActions(kFALSE);
@@ -0,0 +1,210 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RByteSwap.hxx"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__INTEL_COMPILER)
+#define R__BYTESWAP_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BYTESWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+using Kernel_t = void (*)(char *, const char *, std::size_t);
+
+template <int kWordSize>
+struct RWord;
+template <>
+struct RWord<2> {
+   using Type = std::uint16_t;
+};
+template <>
+struct RWord<4> {
+   using Type = std::uint32_t;
+};
+template <>
+struct RWord<8> {
+   using Type = std::uint64_t;
+};
+
+inline std::uint16_t Swap(std::uint16_t x)
+{
+   return std::uint16_t((x >> 8) | (x << 8));
+}
+
+inline std::uint32_t Swap(std::uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_bswap32(x);
+#else
+   return ((x & 0xff000000u) >> 24) | ((x & 0x00ff0000u) >> 8) | ((x & 0x0000ff00u) << 8) | ((x & 0x000000ffu) << 24);
+#endif
+}
+
+inline std::uint64_t Swap(std::uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_bswap64(x);
+#else
+   return (std::uint64_t(Swap(std::uint32_t(x))) << 32) | Swap(std::uint32_t(x >> 32));
+#endif
+}
+
+/// The portable kernel, also used for the tails of the vector kernels
+template <int kWordSize>
+void SwapScalar(char *to, const char *from, std::size_t n)
+{
+   using Word_t = typename RWord<kWordSize>::Type;
+   for (std::size_t i = 0; i < n; ++i) {
+      Word_t word;
+      memcpy(&word, from + i * kWordSize, kWordSize);
+      word = Swap(word);
+      memcpy(to + i * kWordSize, &word, kWordSize);
+   }
+}
+
+#ifdef R__BYTESWAP_X86
+/// The pshufb mask reversing the bytes of the words of a 16 byte lane
+template <int kWordSize>
+inline __m128i MakeShuffleMask()
+{
+   alignas(16) char bytes[16];
+   for (int i = 0; i < 16; ++i)
+      bytes[i] = char((i / kWordSize) * kWordSize + kWordSize - 1 - i % kWordSize);
+   return _mm_load_si128(reinterpret_cast<const __m128i *>(bytes));
+}
+
+template <int kWordSize>
+__attribute__((target("ssse3"))) void SwapSSSE3(char *to, const char *from, std::size_t n)
+{
+   const __m128i mask = MakeShuffleMask<kWordSize>();
+   const std::size_t nbytes = n * kWordSize;
+   std::size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + i), _mm_shuffle_epi8(v, mask));
+   }
+   SwapScalar<kWordSize>(to + i, from + i, (nbytes - i) / kWordSize);
+}
+
+template <int kWordSize>
+__attribute__((target("avx2"))) void SwapAVX2(char *to, const char *from, std::size_t n)
+{
+   // vpshufb shuffles within each 16 byte lane, which the words never cross
+   const __m256i mask = _mm256_broadcastsi128_si256(MakeShuffleMask<kWordSize>());
+   const std::size_t nbytes = n * kWordSize;
+   std::size_t i = 0;
+   for (; i + 64 <= nbytes; i += 64) {
+      const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+      const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i + 32), _mm256_shuffle_epi8(v1, mask));
+   }
+   for (; i + 32 <= nbytes; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_shuffle_epi8(v, mask));
+   }
+   SwapScalar<kWordSize>(to + i, from + i, (nbytes - i) / kWordSize);
+}
+#endif
+
+#ifdef R__BYTESWAP_NEON
+inline uint8x16_t Reverse(uint8x16_t v, RWord<2> *)
+{
+   return vrev16q_u8(v);
+}
+inline uint8x16_t Reverse(uint8x16_t v, RWord<4> *)
+{
+   return vrev32q_u8(v);
+}
+inline uint8x16_t Reverse(uint8x16_t v, RWord<8> *)
+{
+   return vrev64q_u8(v);
+}
+
+template <int kWordSize>
+void SwapNEON(char *to, const char *from, std::size_t n)
+{
+   const std::size_t nbytes = n * kWordSize;
+   std::size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(from + i));
+      vst1q_u8(reinterpret_cast<uint8_t *>(to + i), Reverse(v, static_cast<RWord<kWordSize> *>(nullptr)));
+   }
+   SwapScalar<kWordSize>(to + i, from + i, (nbytes - i) / kWordSize);
+}
+#endif
+
+struct RKernels {
+   Kernel_t fSwap16;
+   Kernel_t fSwap32;
+   Kernel_t fSwap64;
+   const char *fName;
+};
+
+RKernels SelectKernels()
+{
+#if defined(R__BYTESWAP_X86)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return {SwapAVX2<2>, SwapAVX2<4>, SwapAVX2<8>, "avx2"};
+   if (__builtin_cpu_supports("ssse3"))
+      return {SwapSSSE3<2>, SwapSSSE3<4>, SwapSSSE3<8>, "ssse3"};
+#elif defined(R__BYTESWAP_NEON)
+   return {SwapNEON<2>, SwapNEON<4>, SwapNEON<8>, "neon"};
+#endif
+   return {SwapScalar<2>, SwapScalar<4>, SwapScalar<8>, "scalar"};
+}
+
+const RKernels &GetKernels()
+{
+   static const RKernels kernels = SelectKernels();
+   return kernels;
+}
+
+/// Arrays shorter than a vector register are swapped in place, without the indirect call
+const std::size_t kMinVectorBytes = 16;
+
+} // anonymous namespace
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   if (n * 2 < kMinVectorBytes)
+      SwapScalar<2>(static_cast<char *>(to), static_cast<const char *>(from), n);
+   else
+      GetKernels().fSwap16(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   if (n * 4 < kMinVectorBytes)
+      SwapScalar<4>(static_cast<char *>(to), static_cast<const char *>(from), n);
+   else
+      GetKernels().fSwap32(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   if (n * 8 < kMinVectorBytes)
+      SwapScalar<8>(static_cast<char *>(to), static_cast<const char *>(from), n);
+   else
+      GetKernels().fSwap64(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+const char *ROOT::Internal::GetByteSwapKernelName()
+{
+   return GetKernels().fName;
+}
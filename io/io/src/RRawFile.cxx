@@ -80,14 +80,17 @@ ROOT::Internal::RRawFile::Create(std::string_view url, ROptions options)
       return std::unique_ptr<RRawFile>(new RRawFileUnix(url, options));
 #endif
    }
-   if (transport == "http" || transport == "https") {
-      if (TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("ROOT::Internal::RRawFile")) {
+   if (transport == "http" || transport == "https" ||
+       transport == "root" || transport == "roots" || transport == "xroot") {
+      // RRawFileDavix for http[s], RRawFileNetXNG for root[s]
+      std::string urlStr(url);
+      if (TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("ROOT::Internal::RRawFile", urlStr.c_str())) {
          if (h->LoadPlugin() == 0) {
             return std::unique_ptr<RRawFile>(reinterpret_cast<RRawFile *>(h->ExecPlugin(2, &url, &options)));
          }
-         throw std::runtime_error("Cannot load plugin handler for RRawFileDavix");
+         throw std::runtime_error("Cannot load plugin handler for " + std::string(h->GetClass()));
       }
-      throw std::runtime_error("Cannot find plugin handler for RRawFileDavix");
+      throw std::runtime_error("Cannot find plugin handler for transport protocol: " + transport);
    }
    throw std::runtime_error("Unsupported transport protocol: " + transport);
 }
@@ -116,9 +116,13 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
 {
 #ifdef R__HAS_URING
    thread_local bool uring_failed = false;
+   // Setting up a ring is expensive compared to the reads of a typical cluster batch, so every thread keeps
+   // its ring for subsequent ReadV() calls
+   thread_local std::unique_ptr<RIoUring> ring;
    if (!uring_failed) {
       try {
-         RIoUring ring; // throws std::runtime_error
+         if (!ring)
+            ring = std::make_unique<RIoUring>(); // throws std::runtime_error
          std::vector<RIoUring::RReadEvent> reads;
          reads.reserve(nReq);
          for (std::size_t i = 0; i < nReq; ++i) {
@@ -129,9 +133,16 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
             ev.fFileDes = fFileDes;
             reads.push_back(ev);
          }
-         ring.SubmitReadsAndWait(reads.data(), nReq);
+         ring->SubmitReadsAndWait(reads.data(), nReq);
          for (std::size_t i = 0; i < nReq; ++i) {
             ioVec[i].fOutBytes = reads.at(i).fOutBytes;
+            // Short reads are possible also before the end of file; complete them with blocking I/O
+            if ((ioVec[i].fOutBytes > 0) && (ioVec[i].fOutBytes < ioVec[i].fSize)) {
+               ioVec[i].fOutBytes += ReadAtImpl(reinterpret_cast<unsigned char *>(ioVec[i].fBuffer) +
+                                                   ioVec[i].fOutBytes,
+                                                ioVec[i].fSize - ioVec[i].fOutBytes,
+                                                ioVec[i].fOffset + ioVec[i].fOutBytes);
+            }
          }
          return;
       }
@@ -140,6 +151,7 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
          Warning("RRawFileUnix",
               "io_uring setup failed, falling back to blocking I/O in ReadV");
          uring_failed = true;
+         ring.reset();
       }
    }
 #endif
@@ -0,0 +1,165 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RZipBlocks.hxx"
+#include "RZip.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <vector>
+
+namespace {
+
+// Blocks smaller than this are not worth a task of their own
+const Int_t kMinParallelBlockSize = 1024 * 1024;
+
+// Return the number of threads to use for a buffer of `size` bytes, 1 if it is to be processed serially
+UInt_t GetNWorkers(Int_t size)
+{
+   if (size < 2 * kMinParallelBlockSize || !ROOT::IsImplicitMTEnabled())
+      return 1;
+   return std::max(1u, std::min<UInt_t>(ROOT::GetThreadPoolSize(), size / kMinParallelBlockSize));
+}
+
+// Call `func(i)` for each i in [0, n), distributing the calls to `nworkers` threads including the calling one
+template <typename F>
+void RunWorkers(UInt_t nworkers, UInt_t n, F &&func)
+{
+   auto work = [&](UInt_t worker) {
+      for (UInt_t i = worker; i < n; i += nworkers)
+         func(i);
+   };
+   std::vector<std::future<void>> futures;
+   for (UInt_t worker = 1; worker < nworkers; ++worker)
+      futures.emplace_back(std::async(std::launch::async, work, worker));
+   work(0);
+   for (auto &future : futures)
+      future.get();
+}
+
+} // anonymous namespace
+
+Int_t ROOT::Internal::ZipBlocks(Int_t cxlevel, ROOT::RCompressionSetting::EAlgorithm::EValues algorithm, char *src,
+                                Int_t srcsize, char *tgt, UInt_t dictID)
+{
+   const UInt_t nworkers = GetNWorkers(srcsize);
+   if (nworkers == 1) {
+      Int_t noutot = 0;
+      for (Int_t nzip = 0; nzip < srcsize; nzip += kMAXZIPBUF) {
+         Int_t bufmax = std::min<Int_t>(kMAXZIPBUF, srcsize - nzip);
+         Int_t nout = 0;
+         R__zipMultipleAlgorithmDict(cxlevel, &bufmax, src + nzip, &bufmax, tgt + noutot, &nout, algorithm, dictID);
+         // the compressed blocks cannot be larger than their input, hence fit in tgt
+         if (nout == 0 || nout >= srcsize)
+            return 0;
+         noutot += nout;
+      }
+      return noutot;
+   }
+
+   // The compressed size of the blocks is not known in advance: each block is compressed into a buffer of its own
+   const UInt_t nblocks = std::max<UInt_t>(nworkers, 1 + (srcsize - 1) / kMAXZIPBUF);
+   const Int_t blockSize = 1 + (srcsize - 1) / nblocks;
+   std::vector<std::vector<char>> blocks(nblocks);
+   std::vector<Int_t> nouts(nblocks, 0);
+   RunWorkers(nworkers, nblocks, [&](UInt_t i) {
+      const Int_t begin = i * blockSize;
+      Int_t bufmax = std::min(blockSize, srcsize - begin);
+      if (bufmax <= 0)
+         return;
+      blocks[i].resize(bufmax);
+      R__zipMultipleAlgorithmDict(cxlevel, &bufmax, src + begin, &bufmax, blocks[i].data(), &nouts[i], algorithm,
+                                  dictID);
+   });
+
+   Int_t noutot = 0;
+   for (UInt_t i = 0; i < nblocks; ++i) {
+      if (blocks[i].empty())
+         continue;
+      if (nouts[i] == 0)
+         return 0;
+      noutot += nouts[i];
+   }
+   if (noutot >= srcsize)
+      return 0;
+   char *bufcur = tgt;
+   for (UInt_t i = 0; i < nblocks; ++i) {
+      memcpy(bufcur, blocks[i].data(), nouts[i]);
+      bufcur += nouts[i];
+   }
+   return noutot;
+}
+
+Int_t ROOT::Internal::UnzipBlocks(unsigned char *src, Int_t srcsize, char *tgt, Int_t objlen, Int_t *nintot)
+{
+   struct RBlock {
+      Int_t fIn;     ///< offset of the compressed block
+      Int_t fNin;    ///< compressed size of the block
+      Int_t fOut;    ///< offset of the uncompressed block
+      Int_t fNbuf;   ///< uncompressed size of the block
+   };
+
+   // Decompress in parallel only if the headers describe exactly the expected buffer
+   std::vector<RBlock> blocks;
+   if (GetNWorkers(objlen) > 1) {
+      Int_t in = 0, out = 0;
+      while (out < objlen && in + 9 <= srcsize) {
+         Int_t nin, nbuf;
+         if (R__unzip_header(&nin, src + in, &nbuf) != 0 || nin <= 0 || in + nin > srcsize)
+            break;
+         blocks.push_back({in, nin, out, nbuf});
+         in += nin;
+         out += nbuf;
+      }
+      if (out != objlen || blocks.size() < 2)
+         blocks.clear();
+   }
+
+   if (blocks.empty()) {
+      UChar_t *bufcur = src;
+      char *objbuf = tgt;
+      Int_t nin, nbuf, nout = 0, noutot = 0, nin_tot = 0;
+      while (1) {
+         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
+         if (hc != 0)
+            break;
+         R__unzip(&nin, bufcur, &nbuf, (unsigned char *)objbuf, &nout);
+         if (!nout)
+            break;
+         noutot += nout;
+         nin_tot += nin;
+         if (noutot >= objlen)
+            break;
+         bufcur += nin;
+         objbuf += nout;
+      }
+      if (nintot)
+         *nintot = nin_tot;
+      return nout ? noutot : 0;
+   }
+
+   const UInt_t nblocks = blocks.size();
+   std::vector<Int_t> nouts(nblocks, 0);
+   RunWorkers(std::min<UInt_t>(GetNWorkers(objlen), nblocks), nblocks, [&](UInt_t i) {
+      RBlock &block = blocks[i];
+      R__unzip(&block.fNin, src + block.fIn, &block.fNbuf, (unsigned char *)tgt + block.fOut, &nouts[i]);
+   });
+   Int_t noutot = 0;
+   for (UInt_t i = 0; i < nblocks; ++i) {
+      if (nouts[i] != blocks[i].fNbuf)
+         return 0;
+      noutot += nouts[i];
+   }
+   if (nintot)
+      *nintot = blocks.back().fIn + blocks.back().fNin;
+   return noutot;
+}
@@ -18,6 +18,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 */
 
 #include <string.h>
+#include <algorithm>
 #include <typeinfo>
 #include <string>
 
@@ -34,6 +35,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TStreamerInfoActions.h"
 #include "TInterpreter.h"
 #include "TVirtualMutex.h"
+#include "ROOT/RByteSwap.hxx"
 
 #if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
      defined(__GNUC__)
@@ -56,6 +58,95 @@ const Int_t  kMapOffset         = 2;   // first 2 map entries are taken by null
 
 ClassImp(TBufferFile);
 
+namespace {
+
+template <std::size_t N>
+void ByteSwapCopy(void *to, const void *from, std::size_t n);
+template <>
+void ByteSwapCopy<2>(void *to, const void *from, std::size_t n)
+{
+   ROOT::Internal::ByteSwapCopy16(to, from, n);
+}
+template <>
+void ByteSwapCopy<4>(void *to, const void *from, std::size_t n)
+{
+   ROOT::Internal::ByteSwapCopy32(to, from, n);
+}
+template <>
+void ByteSwapCopy<8>(void *to, const void *from, std::size_t n)
+{
+   ROOT::Internal::ByteSwapCopy64(to, from, n);
+}
+
+// Copy n values from the buffer, swapping their bytes with the vectorized kernels of ROOT/RByteSwap.hxx.
+template <typename T>
+inline void frombufArray(char *&buf, T *x, Int_t n)
+{
+#ifdef R__BYTESWAP
+   ByteSwapCopy<sizeof(T)>(x, buf, n);
+#else
+   memcpy(x, buf, n * sizeof(T));
+#endif
+   buf += n * sizeof(T);
+}
+
+// Copy n values to the buffer, swapping their bytes, see frombufArray().
+template <typename T>
+inline void tobufArray(char *&buf, const T *x, Int_t n)
+{
+#ifdef R__BYTESWAP
+   ByteSwapCopy<sizeof(T)>(buf, x, n);
+#else
+   memcpy(buf, x, n * sizeof(T));
+#endif
+   buf += n * sizeof(T);
+}
+
+// Number of values converted at once by the Float16_t and Double32_t array methods
+const Int_t kConvertChunkSize = 256;
+
+// Read n values stored as OnFile_t and convert them, by chunks converted from big-endian at once. TBufferSQL, which
+// inherits the Float16_t and Double32_t methods, reads each value through its own ReadUInt() and ReadFloat().
+template <typename OnFile_t, typename T, typename Convert>
+inline void ReadConverted(TBufferFile &b, char *&cur, T *x, Int_t n, const Convert &convert)
+{
+   if (typeid(b) != typeid(TBufferFile)) {
+      OnFile_t value;
+      for (Int_t i = 0; i < n; ++i) {
+         b >> value;
+         x[i] = convert(value);
+      }
+      return;
+   }
+   OnFile_t values[kConvertChunkSize];
+   for (Int_t first = 0; first < n; first += kConvertChunkSize) {
+      const Int_t m = std::min(kConvertChunkSize, n - first);
+      frombufArray(cur, values, m);
+      for (Int_t i = 0; i < m; ++i)
+         x[first + i] = convert(values[i]);
+   }
+}
+
+// Convert n values to OnFile_t and write them, see ReadConverted(). The buffer must have room for them.
+template <typename OnFile_t, typename T, typename Convert>
+inline void WriteConverted(TBufferFile &b, char *&cur, const T *x, Int_t n, const Convert &convert)
+{
+   if (typeid(b) != typeid(TBufferFile)) {
+      for (Int_t i = 0; i < n; ++i)
+         b << convert(x[i]);
+      return;
+   }
+   OnFile_t values[kConvertChunkSize];
+   for (Int_t first = 0; first < n; first += kConvertChunkSize) {
+      const Int_t m = std::min(kConvertChunkSize, n - first);
+      for (Int_t i = 0; i < m; ++i)
+         values[i] = convert(x[first + i]);
+      tobufArray(cur, values, m);
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Thread-safe check on StreamerInfos of a TClass
 
@@ -765,8 +856,7 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   frombufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -798,8 +888,7 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   frombufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -853,8 +942,7 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   frombufArray(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -885,8 +973,7 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   frombufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -914,8 +1001,7 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   frombufArray(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1038,8 +1124,7 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   frombufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1070,8 +1155,7 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   frombufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1123,8 +1207,7 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   frombufArray(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1154,8 +1237,7 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   frombufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1182,8 +1264,7 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   frombufArray(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1304,8 +1385,7 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    bswapcpy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   frombufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1326,8 +1406,7 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   frombufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1360,8 +1439,7 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   frombufArray(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1381,8 +1459,7 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   frombufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1399,8 +1476,7 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   frombufArray(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1419,9 +1495,7 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
       //a range was specified. We read an integer and convert it back to a float
       Double_t xmin = ele->GetXmin();
       Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
-      }
+      ReadConverted<UInt_t>(*this, fBufCur, f, n, [=](UInt_t aint) { return (Float_t)(aint/factor + xmin); });
    } else {
       Int_t i;
       Int_t nbits = 0;
@@ -1456,9 +1530,7 @@ void TBufferFile::ReadFastArrayWithFactor(Float_t *ptr, Int_t n, Double_t factor
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a float
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; ptr[j] = (Float_t)(aint/factor + minvalue);
-   }
+   ReadConverted<UInt_t>(*this, fBufCur, ptr, n, [=](UInt_t aint) { return (Float_t)(aint/factor + minvalue); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1501,20 +1573,14 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
       //a range was specified. We read an integer and convert it back to a double.
       Double_t xmin = ele->GetXmin();
       Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + xmin);
-      }
+      ReadConverted<UInt_t>(*this, fBufCur, d, n, [=](UInt_t aint) { return (Double_t)(aint/factor + xmin); });
    } else {
       Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) {
          //we read a float and convert it to double
-         Float_t afloat;
-         for (i = 0; i < n; i++) {
-            *this >> afloat;
-            d[i] = (Double_t)afloat;
-         }
+         ReadConverted<Float_t>(*this, fBufCur, d, n, [](Float_t afloat) { return (Double_t)afloat; });
       } else {
          //we read the exponent and the truncated mantissa of the float
          //and rebuild the double.
@@ -1546,9 +1612,7 @@ void TBufferFile::ReadFastArrayWithFactor(Double_t *d, Int_t n, Double_t factor,
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a double.
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + minvalue);
-   }
+   ReadConverted<UInt_t>(*this, fBufCur, d, n, [=](UInt_t aint) { return (Double_t)(aint/factor + minvalue); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1561,11 +1625,7 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
 
    if (!nbits) {
       //we read a float and convert it to double
-      Float_t afloat;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> afloat;
-         d[i] = (Double_t)afloat;
-      }
+      ReadConverted<Float_t>(*this, fBufCur, d, n, [](Float_t afloat) { return (Double_t)afloat; });
    } else {
       //we read the exponent and the truncated mantissa of the float
       //and rebuild the double.
@@ -1737,8 +1797,7 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   tobufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -1767,8 +1826,7 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   tobufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -1831,8 +1889,7 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   tobufArray(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1860,8 +1917,7 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   tobufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -1886,8 +1942,7 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   tobufArray(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2003,8 +2058,7 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   tobufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -2027,8 +2081,7 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   tobufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -2075,8 +2128,7 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   tobufArray(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2098,8 +2150,7 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   tobufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -2118,8 +2169,7 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   tobufArray(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2144,12 +2194,11 @@ void TBufferFile::WriteFastArrayFloat16(const Float_t *f, Int_t n, TStreamerElem
       Double_t factor = ele->GetFactor();
       Double_t xmin = ele->GetXmin();
       Double_t xmax = ele->GetXmax();
-      for (int j = 0; j < n; j++) {
-         Float_t x = f[j];
+      WriteConverted<UInt_t>(*this, fBufCur, f, n, [=](Float_t x) {
          if (x < xmin) x = xmin;
          if (x > xmax) x = xmax;
-         UInt_t aint = UInt_t(0.5+factor*(x-xmin)); *this << aint;
-      }
+         return UInt_t(0.5+factor*(x-xmin));
+      });
    } else {
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
@@ -2195,12 +2244,11 @@ void TBufferFile::WriteFastArrayDouble32(const Double_t *d, Int_t n, TStreamerEl
       Double_t factor = ele->GetFactor();
       Double_t xmin = ele->GetXmin();
       Double_t xmax = ele->GetXmax();
-      for (int j = 0; j < n; j++) {
-         Double_t x = d[j];
+      WriteConverted<UInt_t>(*this, fBufCur, d, n, [=](Double_t x) {
          if (x < xmin) x = xmin;
          if (x > xmax) x = xmax;
-         UInt_t aint = UInt_t(0.5+factor*(x-xmin)); *this << aint;
-      }
+         return UInt_t(0.5+factor*(x-xmin));
+      });
    } else {
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
@@ -2208,10 +2256,7 @@ void TBufferFile::WriteFastArrayDouble32(const Double_t *d, Int_t n, TStreamerEl
       Int_t i;
       if (!nbits) {
          //if no range and no bits specified, we convert from double to float
-         for (i = 0; i < n; i++) {
-            Float_t afloat = (Float_t)d[i];
-            *this << afloat;
-         }
+         WriteConverted<Float_t>(*this, fBufCur, d, n, [](Double_t x) { return (Float_t)x; });
       } else {
          //a range is not specified, but nbits is.
          //In this case we truncate the mantissa to nbits and we stream
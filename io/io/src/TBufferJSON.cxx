@@ -3039,7 +3039,7 @@ R__ALWAYS_INLINE void TBufferJSON::JsonWriteArrayCompress(const T *vname, Int_t
       fValue.Append("[");
       for (Int_t indx = 0; indx < arrsize; indx++) {
          if (indx > 0)
-            fValue.Append(fArraySepar.Data());
+            fValue.Append(fArraySepar);
          JsonWriteBasic(vname[indx]);
       }
       fValue.Append("]");
@@ -3120,7 +3120,7 @@ R__ALWAYS_INLINE void TBufferJSON::JsonWriteArrayCompress(const T *vname, Int_t
                fValue.Append("[");
                for (Int_t indx = p0; indx < pp; indx++) {
                   if (indx > p0)
-                     fValue.Append(fArraySepar.Data());
+                     fValue.Append(fArraySepar);
                   JsonWriteBasic(vname[indx]);
                }
                fValue.Append("]");
@@ -3881,8 +3881,7 @@ void TBufferJSON::WriteCharStar(char *s)
 void TBufferJSON::JsonWriteBasic(Char_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertLong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3891,8 +3890,7 @@ void TBufferJSON::JsonWriteBasic(Char_t value)
 void TBufferJSON::JsonWriteBasic(Short_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hd", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertLong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3901,8 +3899,7 @@ void TBufferJSON::JsonWriteBasic(Short_t value)
 void TBufferJSON::JsonWriteBasic(Int_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertLong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3911,8 +3908,7 @@ void TBufferJSON::JsonWriteBasic(Int_t value)
 void TBufferJSON::JsonWriteBasic(Long_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%ld", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertLong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3920,7 +3916,8 @@ void TBufferJSON::JsonWriteBasic(Long_t value)
 
 void TBufferJSON::JsonWriteBasic(Long64_t value)
 {
-   fValue.Append(std::to_string(value).c_str());
+   char buf[50];
+   fValue.Append(ConvertLong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3969,8 +3966,7 @@ void TBufferJSON::JsonWriteBasic(Bool_t value)
 void TBufferJSON::JsonWriteBasic(UChar_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertULong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3979,8 +3975,7 @@ void TBufferJSON::JsonWriteBasic(UChar_t value)
 void TBufferJSON::JsonWriteBasic(UShort_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hu", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertULong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3989,8 +3984,7 @@ void TBufferJSON::JsonWriteBasic(UShort_t value)
 void TBufferJSON::JsonWriteBasic(UInt_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertULong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3999,8 +3993,7 @@ void TBufferJSON::JsonWriteBasic(UInt_t value)
 void TBufferJSON::JsonWriteBasic(ULong_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%lu", value);
-   fValue.Append(buf);
+   fValue.Append(ConvertULong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4008,7 +4001,8 @@ void TBufferJSON::JsonWriteBasic(ULong_t value)
 
 void TBufferJSON::JsonWriteBasic(ULong64_t value)
 {
-   fValue.Append(std::to_string(value).c_str());
+   char buf[50];
+   fValue.Append(ConvertULong64(value, buf, sizeof(buf)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
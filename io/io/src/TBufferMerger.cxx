@@ -71,12 +71,12 @@ size_t TBufferMerger::GetQueueSize() const
    return fQueue.size();
 }
 
-void TBufferMerger::Push(TBufferFile *buffer)
+void TBufferMerger::Push(TMemFile *memfile)
 {
    {
       std::lock_guard<std::mutex> lock(fQueueMutex);
-      fBuffered += buffer->BufferSize();
-      fQueue.push(buffer);
+      fBuffered += memfile->GetSize();
+      fQueue.push(memfile);
    }
 
    if (fBuffered > fAutoSave)
@@ -114,16 +114,16 @@ void TBufferMerger::Merge()
 
 void TBufferMerger::MergeImpl()
 {
-   std::queue<TBufferFile *> queue;
+   std::queue<TMemFile *> queue;
    {
       std::lock_guard<std::mutex> q(fQueueMutex);
       std::swap(queue, fQueue);
       fBuffered = 0;
    }
 
+   // The files were opened by the threads which pushed them, only their content is merged here
    while (!queue.empty()) {
-      std::unique_ptr<TBufferFile> buffer{queue.front()};
-      fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
+      fMerger.AddAdoptFile(queue.front());
       queue.pop();
    }
 
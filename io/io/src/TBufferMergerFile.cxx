@@ -48,10 +48,10 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
    SetCompressionLevel(oldCompLevel);
 
    if (nbytes) {
-      TBufferFile *buffer = new TBufferFile(TBuffer::kWrite, GetSize());
-      CopyTo(*buffer);
-      buffer->SetReadMode();
-      fMerger.Push(buffer);
+      // Hand the memory blocks over to a read-only file instead of copying them; opening it (reading the keys and
+      // the streamer infos) also happens in this thread rather than in the one merging
+      if (auto content = DetachContent())
+         fMerger.Push(content.release());
       ResetAfterMerge(0);
    }
    return nbytes;
@@ -32,6 +32,9 @@ actions list for both are the same.
 #include "TError.h"
 #include "snprintf.h"
 
+#include <cmath>
+#include <cstring>
+
 ClassImp(TBufferText);
 
 const char *TBufferText::fgFloatFmt = "%e";
@@ -827,6 +830,61 @@ const char *TBufferText::GetDoubleFormat()
    return fgDoubleFmt;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// write decimal representation of the value into buf, as snprintf(buf, len, "%llu") would do,
+/// but without parsing a format string; two digits are produced per division
+
+void WriteDecimal(ULong64_t value, bool negative, char *buf, unsigned len)
+{
+   static const char kDigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+   if (len == 0)
+      return;
+
+   char tmp[24];
+   char *end = tmp + sizeof(tmp), *p = end;
+   while (value >= 100) {
+      const auto indx = (value % 100) * 2;
+      value /= 100;
+      *--p = kDigitPairs[indx + 1];
+      *--p = kDigitPairs[indx];
+   }
+   if (value >= 10) {
+      *--p = kDigitPairs[value * 2 + 1];
+      *--p = kDigitPairs[value * 2];
+   } else {
+      *--p = '0' + value;
+   }
+   if (negative)
+      *--p = '-';
+
+   unsigned n = end - p;
+   if (n > len - 1)
+      n = len - 1;
+   memcpy(buf, p, n);
+   buf[n] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// convert value without fractional part, produces same output as "%1.0f" format
+
+template <typename T>
+void ConvertIntegral(T value, char *buf, unsigned len)
+{
+   // values like -0. or beyond the 64-bit range are not worth special handling
+   if ((std::abs(value) < 1e18) && ((value != 0) || !std::signbit(value))) {
+      const Long64_t ivalue = static_cast<Long64_t>(value);
+      WriteDecimal(ivalue < 0 ? 0ull - static_cast<ULong64_t>(ivalue) : static_cast<ULong64_t>(ivalue), ivalue < 0, buf,
+                   len);
+   } else {
+      snprintf(buf, len, "%1.0f", value);
+   }
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// convert float to string with configured format
 
@@ -835,7 +893,7 @@ const char *TBufferText::ConvertFloat(Float_t value, char *buf, unsigned len, Bo
    if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e15)) {
-      snprintf(buf, len, "%1.0f", value);
+      ConvertIntegral(value, buf, len);
    } else {
       snprintf(buf, len, fgFloatFmt, value);
       CompactFloatString(buf, len);
@@ -851,10 +909,28 @@ const char *TBufferText::ConvertDouble(Double_t value, char *buf, unsigned len,
    if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e25)) {
-      snprintf(buf, len, "%1.0f", value);
+      ConvertIntegral(value, buf, len);
    } else {
       snprintf(buf, len, fgDoubleFmt, value);
       CompactFloatString(buf, len);
    }
    return buf;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// convert signed integer to string, produces same output as "%lld" format
+
+const char *TBufferText::ConvertLong64(Long64_t value, char *buf, unsigned len)
+{
+   WriteDecimal(value < 0 ? 0ull - static_cast<ULong64_t>(value) : static_cast<ULong64_t>(value), value < 0, buf, len);
+   return buf;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// convert unsigned integer to string, produces same output as "%llu" format
+
+const char *TBufferText::ConvertULong64(ULong64_t value, char *buf, unsigned len)
+{
+   WriteDecimal(value, false, buf, len);
+   return buf;
+}
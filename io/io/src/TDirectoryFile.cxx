@@ -48,10 +48,99 @@ End_Macro
 #include "TProcessUUID.h"
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
+#include "TEnv.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+namespace {
+
+/// Tag ending a keys record that holds a sorted index of the keys, "KIDX"
+const UInt_t kKeyIndexTag = 0x4b494458;
+
+/// The fields of a key header needed to look up a key, decoded without creating the TKey
+struct RKeyHeaderView {
+   Short_t fCycle = 0;
+   const char *fClassName = nullptr;
+   Int_t fClassNameLen = 0;
+   const char *fName = nullptr;
+   Int_t fNameLen = 0;
+   char *fEnd = nullptr; ///< First byte after the header
+};
+
+const char *ReadStringView(char *&buffer, Int_t &len)
+{
+   UChar_t nwh;
+   frombuf(buffer, &nwh);
+   if (nwh == 255)
+      frombuf(buffer, &len);
+   else
+      len = nwh;
+   const char *str = buffer;
+   buffer += len;
+   return str;
+}
+
+/// Decode the key header written by TKey::FillBuffer at `header`
+RKeyHeaderView DecodeKeyHeader(char *header)
+{
+   RKeyHeaderView view;
+   char *buffer = header + sizeof(Int_t); // fNbytes
+   Version_t version;
+   frombuf(buffer, &version);
+   buffer += sizeof(Int_t) + sizeof(UInt_t) + sizeof(Short_t); // fObjlen, fDatime, fKeylen
+   frombuf(buffer, &view.fCycle);
+   buffer += version > 1000 ? 2 * sizeof(Long64_t) : 2 * sizeof(UInt_t); // fSeekKey, fSeekPdir
+   view.fClassName = ReadStringView(buffer, view.fClassNameLen);
+   view.fName = ReadStringView(buffer, view.fNameLen);
+   Int_t titleLen;
+   ReadStringView(buffer, titleLen);
+   view.fEnd = buffer;
+   return view;
+}
+
+/// Compare a name stored without terminating null character with a C string, like strcmp
+int CompareName(const char *stored, Int_t len, const char *name)
+{
+   const int cmp = strncmp(stored, name, len);
+   if (cmp != 0)
+      return cmp;
+   return name[len] ? -1 : 0;
+}
+
+Bool_t IsLegalKey(const TKey *key, Long64_t fsize)
+{
+   return key->GetSeekKey() >= 64 && key->GetSeekKey() <= fsize && key->GetSeekPdir() >= 64 &&
+          key->GetSeekPdir() <= fsize;
+}
+
+} // anonymous namespace
+
+/// The keys record of a read-only directory, kept in memory such that the keys are created only when they are looked
+/// up. The record ends with the offsets of the key headers sorted by name (see TDirectoryFile::WriteKeys), which are
+/// used in place for binary searches.
+struct TDirectoryFile::RKeyIndex {
+   std::unique_ptr<char[]> fRecord; ///< The keys record, including its own key header
+   char *fData = nullptr;           ///< The data of the record: number of keys, key headers, index
+   char *fIndex = nullptr;          ///< The offsets of the key headers relative to fData, sorted by name
+   Int_t fNkeys = 0;
+   std::unordered_map<UInt_t, TKey *> fKeysByOffset; ///< The keys created so far, all of them are in fKeys
+
+   UInt_t GetOffset(Int_t i) const
+   {
+      char *buffer = fIndex + i * sizeof(UInt_t);
+      UInt_t offset;
+      frombuf(buffer, &offset);
+      return offset;
+   }
+};
+
 ClassImp(TDirectoryFile);
 
 
@@ -177,6 +266,8 @@ void TDirectoryFile::InitDirectoryFile(TClass *cl)
 
 TDirectoryFile::~TDirectoryFile()
 {
+   // the keys not yet created are not needed any more
+   fKeyIndex.reset();
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -232,6 +323,9 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
 
    fModified = kTRUE;
 
+   if (fKeyIndex)
+      MaterializeKeys();
+
    key->SetMotherDir(this);
 
    // This is a fast hash lookup in case the key does not already exist
@@ -266,7 +360,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
-      TIter next(fKeys);
+      TIter next(GetListOfKeys());
 
       cd();
 
@@ -575,6 +669,7 @@ void TDirectoryFile::Close(Option_t *option)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   fKeyIndex.reset();
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -946,6 +1041,14 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
+   if (fKeyIndex) {
+      TKey *key = FindKeyInIndex(namobj, cycle, kTRUE);
+      if (key) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObj();
+      }
+      return idcur;
+   }
    TKey *key;
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
@@ -1065,6 +1168,14 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
+   if (fKeyIndex) {
+      TKey *key = FindKeyInIndex(namobj, cycle, kTRUE);
+      if (!key)
+         return nullptr;
+      TDirectory::TContext ctxt(this);
+      return key->ReadObjectAny(expectedClass);
+   }
+
    auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
    if (!listOfKeys) {
       Error("GetObjectChecked", "Unexpected type of TDirectoryFile::fKeys!");
@@ -1106,6 +1217,9 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
+   if (fKeyIndex)
+      return const_cast<TDirectoryFile *>(this)->FindKeyInIndex(name, cycle, kFALSE);
+
    // TIter::TIter() already checks for null pointers
    TIter next( ((THashList *)(GetListOfKeys()))->GetListForObject(name) );
 
@@ -1120,6 +1234,109 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of this directory.
+///
+/// The keys that were not created yet by ReadKeys() are created now.
+
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   if (fKeyIndex)
+      const_cast<TDirectoryFile *>(this)->MaterializeKeys();
+   return fKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of this directory.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   if (fKeyIndex)
+      return fKeyIndex->fNkeys;
+   return fKeys->GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of this directory for objects of the given class,
+/// without creating the keys not read yet.
+
+Int_t TDirectoryFile::CountKeysOfClass(const char *classname) const
+{
+   Int_t n = 0;
+   if (fKeyIndex) {
+      for (Int_t i = 0; i < fKeyIndex->fNkeys; ++i) {
+         const auto view = DecodeKeyHeader(fKeyIndex->fData + fKeyIndex->GetOffset(i));
+         if (CompareName(view.fClassName, view.fClassNameLen, classname) == 0)
+            ++n;
+      }
+   } else if (fKeys) {
+      TIter next(fKeys);
+      while (auto key = (TKey *)next()) {
+         if (!strcmp(key->GetClassName(), classname))
+            ++n;
+      }
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up a key in the index of the keys and create it if needed.
+///
+/// The first key with the given name in the order of the list of keys is
+/// returned, if cycle is 9999 or if its cycle is cycle (exactCycle) or at most
+/// cycle (!exactCycle).
+
+TKey *TDirectoryFile::FindKeyInIndex(const char *name, Short_t cycle, Bool_t exactCycle)
+{
+   RKeyIndex &index = *fKeyIndex;
+   const UInt_t indexOffset = index.fIndex - index.fData;
+
+   // binary search of the first key with this name
+   Int_t first = 0, count = index.fNkeys;
+   while (count > 0) {
+      const Int_t step = count / 2;
+      const UInt_t offset = index.GetOffset(first + step);
+      if (offset >= indexOffset)
+         return nullptr; // corrupted index
+      const auto view = DecodeKeyHeader(index.fData + offset);
+      if (CompareName(view.fName, view.fNameLen, name) < 0) {
+         first += step + 1;
+         count -= step + 1;
+      } else {
+         count = step;
+      }
+   }
+
+   for (Int_t i = first; i < index.fNkeys; ++i) {
+      const UInt_t offset = index.GetOffset(i);
+      if (offset >= indexOffset)
+         return nullptr;
+      const auto view = DecodeKeyHeader(index.fData + offset);
+      if (CompareName(view.fName, view.fNameLen, name) != 0)
+         return nullptr;
+      if (cycle != 9999 && (exactCycle ? cycle != view.fCycle : cycle < view.fCycle))
+         continue;
+
+      TKey *&key = index.fKeysByOffset[offset];
+      if (!key) {
+         auto newkey = new TKey(this);
+         char *buffer = index.fData + offset;
+         newkey->ReadKeyBuffer(buffer);
+         if (!IsLegalKey(newkey, fFile->GetSize())) {
+            Error("FindKeyInIndex", "reading illegal key %s", newkey->GetName());
+            newkey->SetMotherDir(nullptr);
+            delete newkey;
+            index.fKeysByOffset.erase(offset);
+            return nullptr;
+         }
+         fKeys->Add(newkey);
+         key = newkey;
+      }
+      return key;
+   }
+   return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1169,7 +1386,7 @@ void TDirectoryFile::ls(Option_t *option) const
 
    if (diskobj && fKeys) {
       //*-* Loop on all the keys
-      TObjLink *lnk = fKeys->FirstLink();
+      TObjLink *lnk = GetListOfKeys()->FirstLink();
       while (lnk) {
          TKey *key = (TKey*)lnk->GetObject();
          TString s = key->GetName();
@@ -1337,6 +1554,12 @@ void TDirectoryFile::ReadAll(Option_t* opt)
 /// This is an efficient way (without opening/closing files) to view
 /// the latest updates of a file being modified by another process
 /// as it is typically the case in a data acquisition system.
+///
+/// If the file is not writable and the keys record holds an index of the
+/// keys sorted by name (see WriteKeys), the keys are not created here: the
+/// record is kept in memory and the keys are created when they are looked up
+/// by Get(), GetKey() or FindKey(). All the keys are created on the first
+/// call to GetListOfKeys().
 
 Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 {
@@ -1349,6 +1572,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    char *buffer;
    if (forceRead) {
+      fKeyIndex.reset();
       fKeys->Delete();
       //In case directory was updated by another process, read new
       //position for the keys
@@ -1384,23 +1608,43 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    Int_t nkeys = 0;
    Long64_t fsize = fFile->GetSize();
    if ( fSeekKeys >  0) {
-      TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
-      headerkey->ReadFile();
-      buffer = headerkey->GetBuffer();
-      headerkey->ReadKeyBuffer(buffer);
+      std::unique_ptr<char[]> record(new char[fNbytesKeys]);
+      fFile->Seek(fSeekKeys);
+      if (fFile->ReadBuffer(record.get(), fNbytesKeys)) {
+         Error("ReadKeys", "cannot read the keys of %s", GetName());
+         return 0;
+      }
+      // skip the header of the key of the record
+      buffer = record.get() + sizeof(Int_t) + sizeof(Version_t) + sizeof(Int_t) + sizeof(UInt_t);
+      Short_t keylen;
+      frombuf(buffer, &keylen);
+      buffer = record.get() + keylen;
+      char *data = buffer;
+      const Int_t datalen = fNbytesKeys - keylen;
 
-      TKey *key;
       frombuf(buffer, &nkeys);
+
+      UInt_t tag = 0, nindexed = 0;
+      if (datalen >= 3 * (Int_t)sizeof(UInt_t)) {
+         char *trailer = data + datalen - 2 * sizeof(UInt_t);
+         frombuf(trailer, &nindexed);
+         frombuf(trailer, &tag);
+      }
+      if (!fFile->IsWritable() && tag == kKeyIndexTag && nkeys >= 0 && nindexed == (UInt_t)nkeys &&
+          Long64_t(nkeys) * sizeof(UInt_t) + 3 * sizeof(UInt_t) <= (ULong64_t)datalen) {
+         fKeyIndex.reset(new RKeyIndex);
+         fKeyIndex->fData = data;
+         fKeyIndex->fIndex = data + datalen - 2 * sizeof(UInt_t) - nkeys * sizeof(UInt_t);
+         fKeyIndex->fNkeys = nkeys;
+         fKeyIndex->fRecord = std::move(record);
+         return nkeys;
+      }
+
+      TKey *key;
       for (Int_t i = 0; i < nkeys; i++) {
          key = new TKey(this);
          key->ReadKeyBuffer(buffer);
-         if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
-            break;
-         }
-         if (key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
+         if (!IsLegalKey(key, fsize)) {
             Error("ReadKeys","reading illegal key, exiting after %d keys",i);
             fKeys->Remove(key);
             nkeys = i;
@@ -1408,13 +1652,60 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
          }
          fKeys->Add(key);
       }
-      delete headerkey;
    }
 
    return nkeys;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Create all the keys of the index kept by ReadKeys() and fill the list of
+/// keys in the order of the keys record, reusing the keys created so far.
+
+void TDirectoryFile::MaterializeKeys()
+{
+   // Detach the index first: the keys deleted or added below must not come back here
+   std::unique_ptr<RKeyIndex> index(std::move(fKeyIndex));
+
+   // The keys removed from the list since they were created are owned by whoever removed them
+   auto &created = index->fKeysByOffset;
+   for (auto it = created.begin(); it != created.end();) {
+      if (fKeys->FindObject(it->second))
+         ++it;
+      else
+         it = created.erase(it);
+   }
+   fKeys->Clear();
+
+   const Long64_t fsize = fFile->GetSize();
+   char *buffer = index->fData + sizeof(Int_t);
+   for (Int_t i = 0; i < index->fNkeys; ++i) {
+      const UInt_t offset = buffer - index->fData;
+      TKey *key;
+      auto it = created.find(offset);
+      if (it != created.end()) {
+         key = it->second;
+         created.erase(it);
+         buffer = DecodeKeyHeader(buffer).fEnd;
+      } else {
+         key = new TKey(this);
+         key->ReadKeyBuffer(buffer);
+         if (!IsLegalKey(key, fsize)) {
+            Error("GetListOfKeys","reading illegal key, exiting after %d keys",i);
+            key->SetMotherDir(nullptr);
+            delete key;
+            break;
+         }
+      }
+      fKeys->Add(key);
+   }
+   // Only left if the record is corrupted
+   for (auto &entry : created) {
+      entry.second->SetMotherDir(nullptr);
+      delete entry.second;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
 ///
@@ -1428,6 +1719,13 @@ Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
 {
    if (!fFile) { Error("Read","No file open"); return 0; }
    TKey *key = nullptr;
+   if (fKeyIndex) {
+      key = FindKeyInIndex(keyname, 9999, kFALSE);
+      if (key)
+         return key->Read(obj);
+      Error("Read","Key not found");
+      return 0;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(keyname,key->GetName()) == 0) {
@@ -1461,13 +1759,14 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
-   TKey *key = fKeys ? (TKey*)fKeys->FindObject(fName) : nullptr;
+   TKey *key = fKeys ? (TKey*)GetListOfKeys()->FindObject(fName) : nullptr;
    TClass *cl = IsA();
    if (key) {
       cl = TClass::GetClass(key->GetClassName());
    }
    // NOTE: We should check that the content is really mergeable and in
    // the in-mmeory list, before deleting the keys.
+   fKeyIndex.reset();
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -1906,6 +2205,11 @@ Int_t TDirectoryFile::WriteTObject(const TObject *obj, const char *name, Option_
       oname = newName;
    }
 
+#ifdef R__USE_IMT
+   // The TKey constructor streams and compresses the object without holding the file's write lock, only the
+   // lookups and updates of the keys and the writing of the key into the file are serialized.
+   std::unique_lock<std::mutex> sentry(fFile->fWriteMutex);
+#endif
    if (opt.Contains("overwrite")) {
       //One must use GetKey. FindObject would return the lowest cycle of the key!
       //key = (TKey*)gDirectory->GetListOfKeys()->FindObject(oname);
@@ -1918,9 +2222,15 @@ Int_t TDirectoryFile::WriteTObject(const TObject *obj, const char *name, Option_
    if (opt.Contains("writedelete")) {
       oldkey = GetKey(oname);
    }
+#ifdef R__USE_IMT
+   sentry.unlock();
+#endif
    key = fFile->CreateKey(this, obj, oname, bsize);
    if (newName) delete [] newName;
 
+#ifdef R__USE_IMT
+   sentry.lock();
+#endif
    if (!key->GetSeekKey()) {
       fKeys->Remove(key);
       delete key;
@@ -2055,6 +2365,11 @@ Int_t TDirectoryFile::WriteObjectAny(const void *obj, const TClass *cl, const ch
       oname = newName;
    }
 
+#ifdef R__USE_IMT
+   // The TKey constructor streams and compresses the object without holding the file's write lock, only the
+   // lookups and updates of the keys and the writing of the key into the file are serialized.
+   std::unique_lock<std::mutex> sentry(fFile->fWriteMutex);
+#endif
    if (opt.Contains("overwrite")) {
       //One must use GetKey. FindObject would return the lowest cycle of the key!
       //key = (TKey*)gDirectory->GetListOfKeys()->FindObject(oname);
@@ -2067,9 +2382,15 @@ Int_t TDirectoryFile::WriteObjectAny(const void *obj, const TClass *cl, const ch
    if (opt.Contains("writedelete")) {
       oldkey = GetKey(oname);
    }
+#ifdef R__USE_IMT
+   sentry.unlock();
+#endif
    key = fFile->CreateKey(this, obj, cl, oname, bsize);
    if (newName) delete [] newName;
 
+#ifdef R__USE_IMT
+   sentry.lock();
+#endif
    if (!key->GetSeekKey()) {
       fKeys->Remove(key);
       delete key;
@@ -2118,6 +2439,12 @@ void TDirectoryFile::WriteDirHeader()
 /// Write Keys linked list on the file.
 ///
 ///  The linked list of keys (fKeys) is written as a single data record
+///
+///  If the directory has at least TFile.KeyIndexMinKeys keys (1000 by default,
+///  0 to disable), the record ends with the offsets of the key headers sorted
+///  by name, followed by the number of keys and a tag. Readers that do not
+///  know the index ignore it; ReadKeys() uses it for the lookups in read-only
+///  files without creating all the keys.
 
 void TDirectoryFile::WriteKeys()
 {
@@ -2134,7 +2461,7 @@ void TDirectoryFile::WriteKeys()
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
    }
 //*-* Write new keys record
-   TIter next(fKeys);
+   TIter next(GetListOfKeys());
    TKey *key;
    Int_t nkeys  = fKeys->GetSize();
    Int_t nbytes = sizeof nkeys;          //*-* Compute size of all keys
@@ -2142,17 +2469,39 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       nbytes += key->Sizeof();
    }
+   const Int_t minIndexed = gEnv->GetValue("TFile.KeyIndexMinKeys", 1000);
+   const Bool_t writeIndex = minIndexed > 0 && nkeys >= minIndexed;
+   if (writeIndex)
+      nbytes += (nkeys + 2) * sizeof(UInt_t);
    TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
    if (headerkey->GetSeekKey() == 0) {
       delete headerkey;
       return;
    }
    char *buffer = headerkey->GetBuffer();
+   char *data = buffer;
+   std::vector<std::pair<const char *, UInt_t>> offsets;
+   if (writeIndex)
+      offsets.reserve(nkeys);
    next.Reset();
    tobuf(buffer, nkeys);
    while ((key = (TKey*)next())) {
+      if (writeIndex)
+         offsets.emplace_back(key->GetName(), buffer - data);
       key->FillBuffer(buffer);
    }
+   if (writeIndex) {
+      // the keys with the same name stay in the order of the list, highest cycle first
+      std::stable_sort(offsets.begin(), offsets.end(),
+                       [](const std::pair<const char *, UInt_t> &a, const std::pair<const char *, UInt_t> &b) {
+                          return strcmp(a.first, b.first) < 0;
+                       });
+      buffer = data + nbytes - (nkeys + 2) * sizeof(UInt_t);
+      for (const auto &entry : offsets)
+         tobuf(buffer, entry.second);
+      tobuf(buffer, (UInt_t)nkeys);
+      tobuf(buffer, kKeyIndexTag);
+   }
 
    fSeekKeys     = headerkey->GetSeekKey();
    fNbytesKeys   = headerkey->GetNbytes();
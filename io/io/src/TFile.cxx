@@ -85,6 +85,8 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/uio.h>
+#   include <climits>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -138,7 +140,13 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TThreadSlots.h"
 #include "TGlobal.h"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include "ROOT/RTrace.hxx"
+#include <future>
 #include <memory>
+#include <vector>
+#ifdef R__HAS_URING
+#include "ROOT/RIoUring.hxx"
+#endif
 
 using std::sqrt;
 
@@ -844,7 +852,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file."
                               " The file was produced with version %d.%02d/%02d of ROOT.",
                               GetName(),  fVersion / 10000, (fVersion / 100) % (100), fVersion  % 100);
@@ -854,14 +862,8 @@ void TFile::Init(Bool_t create)
    }
 
    // Count number of TProcessIDs in this file
-   {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
-      }
-      fProcessIDs = new TObjArray(fNProcessIDs+1);
-   }
+   fNProcessIDs += CountKeysOfClass("TProcessID");
+   fProcessIDs = new TObjArray(fNProcessIDs+1);
    return;
 
 zombie:
@@ -1743,10 +1745,15 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 /// The value pos[i] is the seek position of block i of length len[i].
 /// Note that for nbuf=1, this call is equivalent to TFile::ReafBuffer.
 /// This function is overloaded by TNetFile, TWebFile, etc.
+/// For local files, all blocks are read with a single io_uring batch (if ROOT
+/// is built with io_uring support) or with a few preadv() calls, see
+/// ReadBuffersLocal().
 /// Returns kTRUE in case of failure.
 
 Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
+   R__TRACE_SPAN("io", "TFile::ReadBuffers");
+
    // called with buf=0, from TFileCacheRead to pass list of readahead buffers
    if (!buf) {
       for (Int_t j = 0; j < nbuf; j++) {
@@ -1757,6 +1764,10 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   Int_t st = ReadBuffersLocal(buf, pos, len, nbuf);
+   if (st >= 0)
+      return st != 0;
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1807,6 +1818,188 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf blocks described in arrays pos and len from a local file
+/// with vectored I/O, without changing the file offset between the blocks.
+///
+/// With io_uring, all the blocks are submitted as one batch. Otherwise blocks
+/// closer than 64 kB are read with a single preadv() call, the bytes between
+/// them going to a scratch buffer and being counted as extra bytes.
+/// If the rootrc variable TFile.DropPageCache is set, the pages read are then
+/// dropped from the page cache of the kernel, so that a large sequential scan
+/// does not evict the pages of other files.
+///
+/// Returns 0 on success, 1 on failure and -1 if the blocks must be read with
+/// ReadBuffer() instead, e.g. for the classes deriving from TFile.
+
+Int_t TFile::ReadBuffersLocal(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+#ifndef WIN32
+   if (IsA() != TFile::Class() || fD < 0 || nbuf <= 0 || TestBit(kDevNull))
+      return -1;
+
+   Double_t start = 0;
+   if (gPerfStats) start = TTimeStamp();
+
+   Long64_t nread = 0;   // bytes of the blocks
+   Long64_t nextra = 0;  // bytes read between the blocks
+   Int_t ncalls = 0;
+   Bool_t done = kFALSE;
+
+#ifdef R__HAS_URING
+   thread_local bool uringFailed = false;
+   // Setting up a ring is expensive compared to the reads of a cache fill, so every thread keeps its ring
+   thread_local std::unique_ptr<ROOT::Internal::RIoUring> ring;
+   if (!uringFailed) {
+      try {
+         if (!ring)
+            ring = std::make_unique<ROOT::Internal::RIoUring>(); // throws std::runtime_error
+         std::vector<ROOT::Internal::RIoUring::RReadEvent> reads(nbuf);
+         Long64_t k = 0;
+         for (Int_t i = 0; i < nbuf; ++i) {
+            reads[i].fBuffer = &buf[k];
+            reads[i].fOffset = pos[i] + fArchiveOffset;
+            reads[i].fSize = len[i];
+            reads[i].fFileDes = fD;
+            k += len[i];
+         }
+         ring->SubmitReadsAndWait(reads.data(), nbuf);
+         for (Int_t i = 0; i < nbuf; ++i) {
+            // Short reads are possible also before the end of file; complete them with blocking I/O
+            while (reads[i].fOutBytes < reads[i].fSize) {
+               ssize_t siz = ::pread(fD, (char *)reads[i].fBuffer + reads[i].fOutBytes,
+                                     reads[i].fSize - reads[i].fOutBytes, reads[i].fOffset + reads[i].fOutBytes);
+               if (siz < 0 && GetErrno() == EINTR) {
+                  ResetErrno();
+                  continue;
+               }
+               if (siz <= 0) {
+                  Error("ReadBuffers", "error reading all requested bytes from file %s, got %ld of %d", GetName(),
+                        (Long_t)reads[i].fOutBytes, len[i]);
+                  return 1;
+               }
+               reads[i].fOutBytes += siz;
+               ++ncalls;
+            }
+         }
+         nread = k;
+         ++ncalls;
+         done = kTRUE;
+      } catch (const std::runtime_error &e) {
+         Warning("ReadBuffers", "io_uring is not available, falling back to preadv: %s", e.what());
+         uringFailed = true;
+         ring.reset();
+      }
+   }
+#endif
+
+   if (!done) {
+      static constexpr Long64_t kMaxGap = 64 * 1024;
+#ifdef IOV_MAX
+      static constexpr Int_t kMaxIov = IOV_MAX;
+#else
+      static constexpr Int_t kMaxIov = 1024;
+#endif
+      std::vector<char> scratch;
+      std::vector<struct iovec> iov;
+      iov.reserve(std::min(2 * nbuf, kMaxIov));
+      Long64_t k = 0;
+      Int_t i = 0;
+      while (i < nbuf) {
+         // Collect the blocks of one preadv() call
+         iov.clear();
+         const Long64_t begin = pos[i];
+         Long64_t end = begin;
+         Long64_t ngap = 0;
+         while (i < nbuf && (Int_t)iov.size() + 2 <= kMaxIov) {
+            if (pos[i] < end || (pos[i] > end && pos[i] - end > kMaxGap))
+               break;
+            if (pos[i] > end) {
+               if (scratch.empty())
+                  scratch.resize(kMaxGap);
+               iov.push_back({scratch.data(), (size_t)(pos[i] - end)});
+               ngap += pos[i] - end;
+            }
+            iov.push_back({&buf[k], (size_t)len[i]});
+            k += len[i];
+            end = pos[i] + len[i];
+            ++i;
+         }
+         if (iov.empty()) {
+            // overlapping or unsorted block, read it alone
+            iov.push_back({&buf[k], (size_t)len[i]});
+            k += len[i];
+            end = pos[i] + len[i];
+            ++i;
+         }
+
+         // Read the range, resuming after short reads
+         Long64_t offset = begin + fArchiveOffset;
+         size_t first = 0;
+         while (first < iov.size()) {
+            ssize_t siz = ::preadv(fD, &iov[first], iov.size() - first, offset);
+            if (siz < 0 && GetErrno() == EINTR) {
+               ResetErrno();
+               continue;
+            }
+            if (siz < 0) {
+               SysError("ReadBuffers", "error reading from file %s", GetName());
+               return 1;
+            }
+            if (siz == 0) {
+               Error("ReadBuffers", "error reading all requested bytes from file %s, got %lld of %lld", GetName(),
+                     offset - fArchiveOffset - begin, end - begin);
+               return 1;
+            }
+            ++ncalls;
+            offset += siz;
+            while (first < iov.size() && (size_t)siz >= iov[first].iov_len) {
+               siz -= iov[first].iov_len;
+               ++first;
+            }
+            if (siz > 0) {
+               iov[first].iov_base = (char *)iov[first].iov_base + siz;
+               iov[first].iov_len -= siz;
+            }
+         }
+         nread += end - begin - ngap;
+         nextra += ngap;
+      }
+   }
+
+   // Leave the file offset after the last block, as the sequential reads do
+   Seek(pos[nbuf - 1] + len[nbuf - 1]);
+
+#if defined(R__LINUX) && !defined(R__WINGCC)
+   static const Bool_t dropPageCache = gEnv->GetValue("TFile.DropPageCache", 0);
+   if (dropPageCache) {
+      Long64_t first = pos[0], last = pos[0] + len[0];
+      for (Int_t i = 1; i < nbuf; ++i) {
+         first = std::min(first, pos[i]);
+         last = std::max(last, pos[i] + len[i]);
+      }
+      posix_fadvise(fD, first + fArchiveOffset, last - first, POSIX_FADV_DONTNEED);
+   }
+#endif
+
+   fBytesRead      += nread;
+   fgBytesRead     += nread;
+   fBytesReadExtra += nextra;
+   fReadCalls      += ncalls;
+   fgReadCalls     += ncalls;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats) {
+      gPerfStats->FileReadEvent(this, nread, start);
+   }
+   return 0;
+#else
+   (void)buf; (void)pos; (void)len; (void)nbuf;
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -4380,6 +4573,43 @@ TFile *TFile::Open(TFileOpenHandle *fh)
    return f;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open a file in a new thread, as TFile::Open() does, and return a future to
+/// get the TFile. When the future is ready the header, the keys and the
+/// StreamerInfo of the file are read, so that several files can be opened
+/// concurrently with any plugin (local, XRootD, Davix, ...), e.g. some files
+/// ahead of the ones being processed:
+/// ~~~{.cpp}
+/// std::vector<std::future<std::unique_ptr<TFile>>> files;
+/// for (auto &name : names)
+///    files.emplace_back(TFile::OpenAsync(name.c_str()));
+/// for (auto &future : files) {
+///    auto file = future.get();
+///    if (file) ...
+/// }
+/// ~~~
+/// The future holds nullptr if the file cannot be opened. As the future comes
+/// from std::async, its destructor waits for the end of the open. This calls
+/// ROOT::EnableThreadSafety(). Unlike AsyncOpen(), the file is owned by the
+/// caller and may be used by any thread once the future is ready.
+
+std::future<std::unique_ptr<TFile>> TFile::OpenAsync(const char *url, Option_t *options, const char *ftitle,
+                                                     Int_t compress, Int_t netopt)
+{
+   ROOT::EnableThreadSafety();
+
+   // copy the arguments, the thread may outlive them
+   std::string name(url ? url : ""), option(options ? options : ""), title(ftitle ? ftitle : "");
+   return std::async(std::launch::async, [name, option, title, compress, netopt]() {
+      // the file must not stay the current directory of a thread which goes away
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(name.c_str(), option.c_str(), title.c_str(), compress, netopt));
+      if (file && file->IsZombie())
+         file.reset();
+      return file;
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to system open. All arguments like in POSIX open().
 
@@ -4465,6 +4695,53 @@ Int_t TFile::SysSync(Int_t fd)
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if WriteBufferAt() is supported, i.e. for local files on
+/// POSIX systems.
+
+Bool_t TFile::CanWriteBufferAt() const
+{
+#ifndef WIN32
+   return IsA() == TFile::Class() && fD >= 0 && !TestBit(kDevNull);
+#else
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write a buffer at the position pos of the file, bypassing the write cache.
+///
+/// Unlike Seek() and WriteBuffer(), this neither uses nor changes the current
+/// offset of the file, nor the counters of written bytes, so that the write
+/// cache can call it from a background thread while the file is in use.
+/// Only supported if CanWriteBufferAt() returns kTRUE.
+/// Returns kTRUE in case of failure.
+
+Bool_t TFile::WriteBufferAt(const char *buf, Long64_t pos, Int_t len)
+{
+#ifndef WIN32
+   Long64_t offset = pos + fArchiveOffset;
+   while (len > 0) {
+      ssize_t siz = ::pwrite(fD, buf, len, offset);
+      if (siz < 0 && GetErrno() == EINTR) {
+         ResetErrno();
+         continue;
+      }
+      if (siz <= 0) {
+         SysError("WriteBufferAt", "error writing to file %s (%ld)", GetName(), (Long_t)siz);
+         return kTRUE;
+      }
+      buf += siz;
+      len -= siz;
+      offset += siz;
+   }
+   return kFALSE;
+#else
+   (void)buf; (void)pos; (void)len;
+   return kTRUE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total number of bytes written so far to the file.
 
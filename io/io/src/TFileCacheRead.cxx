@@ -764,7 +764,8 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
 /// If 'setPrefetching', enable the asynchronous prefetching
 /// (using TFilePrefetch) and if the gEnv and rootrc
 /// variable Cache.Directory is set, also enable the local
-/// caching of the prefetched blocks.
+/// caching of the prefetched blocks. The variable Cache.MaxSize
+/// (in MB) bounds the size of the cache directory.
 /// if 'setPrefetching', the old prefetcher is enabled is
 /// the gEnv and rootrc variable is TFile.AsyncReading
 
@@ -788,6 +789,7 @@ void TFileCacheRead::SetEnablePrefetchingImpl(Bool_t setPrefetching)
       if (strcmp(cacheDir, ""))
         if (!fPrefetch->SetCache((char*) cacheDir))
            fprintf(stderr, "Error while trying to set the cache directory: %s.\n", cacheDir);
+      fPrefetch->SetCacheMaxSize(Long64_t(gEnv->GetValue("Cache.MaxSize", 0.) * 1024 * 1024));
       if (fPrefetch->ThreadStart()){
          fprintf(stderr,"Error stating prefetching thread. Disabling prefetching.\n");
          fEnablePrefetching = 0;
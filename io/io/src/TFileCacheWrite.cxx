@@ -23,11 +23,30 @@ TXNetFile and TWebFile (via TFile::WriteBuffers()).
 
 The write cache is automatically created when writing a remote file
 (created in TFile::Open()).
+
+In write-behind mode (see SetWriteBehind() and the rootrc variable
+TFile.WriteBehind), the cache uses two buffers: when a buffer is full
+it is written to the file by a background thread while the next one
+is being filled, so that TTree::Fill() and the compression of the
+baskets are not blocked by the latency of the storage.
 */
 
 
+#include "TEnv.h"
 #include "TFile.h"
 #include "TFileCacheWrite.h"
+#include "TVirtualMonitoring.h"
+
+#include <future>
+#include <utility>
+
+/// The buffer written by the background writer
+struct TFileCacheWrite::RWriteBehind {
+   char *fBuffer = nullptr;       ///< buffer being written, of size fBufferSize
+   Long64_t fSeekStart = 0;       ///< position of the buffer in the file
+   Int_t fNtot = 0;               ///< number of bytes being written, 0 if none
+   std::future<Bool_t> fResult;   ///< kTRUE if the background write failed
+};
 
 ClassImp(TFileCacheWrite);
 
@@ -61,6 +80,7 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
    fRecursive   = kFALSE;
    fBuffer      = new char[fBufferSize];
    if (file) file->SetCacheWrite(this);
+   if (file && gEnv->GetValue("TFile.WriteBehind", 0)) SetWriteBehind(kTRUE);
    if (gDebug > 0) Info("TFileCacheWrite","Creating a write cache with buffersize=%d bytes",buffersize);
 }
 
@@ -69,15 +89,49 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
 
 TFileCacheWrite::~TFileCacheWrite()
 {
+   SetWriteBehind(kFALSE);
    delete [] fBuffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Flush the current write buffer to the file.
+/// In write-behind mode, also wait until the buffer is written.
 /// Returns kTRUE in case of error.
 
 Bool_t TFileCacheWrite::Flush()
 {
+   return FlushImpl(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the current write buffer to the file.
+/// In write-behind mode, the buffer is written by a background thread and,
+/// unless 'wait', the function returns as soon as the previous buffer is
+/// written. The errors of the background writes are returned by the next call.
+/// Returns kTRUE in case of error.
+
+Bool_t TFileCacheWrite::FlushImpl(Bool_t wait)
+{
+   if (fWriteBehind) {
+      // at most one buffer is written in the background
+      Bool_t status = WaitForWriteBehind();
+      if (fNtot) {
+         std::swap(fBuffer, fWriteBehind->fBuffer);
+         fWriteBehind->fSeekStart = fSeekStart;
+         fWriteBehind->fNtot = fNtot;
+         fNtot = 0;
+         TFile *file = fFile;
+         const char *buffer = fWriteBehind->fBuffer;
+         const Long64_t pos = fWriteBehind->fSeekStart;
+         const Int_t len = fWriteBehind->fNtot;
+         fWriteBehind->fResult =
+            std::async(std::launch::async, [file, buffer, pos, len] { return file->WriteBufferAt(buffer, pos, len); });
+      }
+      if (wait && WaitForWriteBehind())
+         status = kTRUE;
+      return status;
+   }
+
    if (!fNtot) return kFALSE;
    fFile->Seek(fSeekStart);
    //printf("Flushing buffer at fSeekStart=%lld, fNtot=%d\n",fSeekStart,fNtot);
@@ -88,6 +142,50 @@ Bool_t TFileCacheWrite::Flush()
    return status;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until the buffer written in the background, if any, is written and
+/// account for its bytes in the file.
+/// Returns kTRUE in case of error.
+
+Bool_t TFileCacheWrite::WaitForWriteBehind()
+{
+   if (!fWriteBehind || !fWriteBehind->fResult.valid())
+      return kFALSE;
+   Bool_t status = fWriteBehind->fResult.get();
+   if (status) {
+      fFile->SetBit(TFile::kWriteError);
+   } else {
+      fFile->fBytesWrite  += fWriteBehind->fNtot;
+      fFile->fgBytesWrite += fWriteBehind->fNtot;
+      if (gMonitoringWriter)
+         gMonitoringWriter->SendFileWriteProgress(fFile);
+   }
+   fWriteBehind->fNtot = 0;
+   return status;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the write-behind mode.
+///
+/// In write-behind mode, a full buffer is written to the file by a background
+/// thread while a second buffer is being filled. It requires a file which can
+/// write at explicit positions (see TFile::CanWriteBufferAt()), e.g. local
+/// files and TNetXNGFile. Disabling it waits for the pending write.
+/// Returns kTRUE if the write-behind mode is enabled.
+
+Bool_t TFileCacheWrite::SetWriteBehind(Bool_t writeBehind)
+{
+   if (writeBehind && !fWriteBehind && fFile && fFile->CanWriteBufferAt()) {
+      fWriteBehind.reset(new RWriteBehind);
+      fWriteBehind->fBuffer = new char[fBufferSize];
+   } else if (!writeBehind && fWriteBehind) {
+      WaitForWriteBehind();
+      delete [] fWriteBehind->fBuffer;
+      fWriteBehind.reset();
+   }
+   return IsWriteBehind();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print class internal structure.
 
@@ -107,9 +205,17 @@ void TFileCacheWrite::Print(Option_t *option) const
 
 Int_t TFileCacheWrite::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
-   if (pos < fSeekStart || pos+len > fSeekStart+fNtot) return -1;
-   memcpy(buf,fBuffer+pos-fSeekStart,len);
-   return 0;
+   if (pos >= fSeekStart && pos+len <= fSeekStart+fNtot) {
+      memcpy(buf,fBuffer+pos-fSeekStart,len);
+      return 0;
+   }
+   // the buffer being written in the background is not modified until the next flush
+   if (fWriteBehind && fWriteBehind->fNtot && pos >= fWriteBehind->fSeekStart &&
+       pos+len <= fWriteBehind->fSeekStart+fWriteBehind->fNtot) {
+      memcpy(buf,fWriteBehind->fBuffer+pos-fWriteBehind->fSeekStart,len);
+      return 0;
+   }
+   return -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,10 +232,11 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
    if (fSeekStart + fNtot != pos) {
       //we must flush the current cache
-      if (Flush()) return -1; //failure
+      if (FlushImpl(kFALSE)) return -1; //failure
    }
    if (fNtot + len >= fBufferSize) {
-      if (Flush()) return -1; //failure
+      //wait for the background write before writing directly to the file
+      if (FlushImpl(len >= fBufferSize)) return -1; //failure
       if (len >= fBufferSize) {
          //buffer larger than the cache itself: direct write to file
          fRecursive = kTRUE;
@@ -148,9 +255,14 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the file using this cache.
-/// Any write not yet flushed will be lost.
+/// Any write not yet flushed will be lost, the write in the background, if
+/// any, is completed on the previous file.
 
 void TFileCacheWrite::SetFile(TFile *file)
 {
+   if (fWriteBehind) {
+      WaitForWriteBehind();
+      if (!file || !file->CanWriteBufferAt()) SetWriteBehind(kFALSE);
+   }
    fFile = file;
 }
@@ -20,6 +20,24 @@ any of its remote file access plugins. It is therefore useful in
 a Grid environment where the files might be accessible only remotely.
 The merging interface allows files containing histograms and trees
 to be merged, like the standalone hadd program.
+
+When the implicit multi-threading is enabled (ROOT::EnableImplicitMT()),
+the histograms of each directory are merged in parallel for a regular
+(non incremental) merge: the source files are split in consecutive
+groups, one per thread, each thread reading and summing the histograms
+of its files, and the sums of the groups are then added in the order of
+the files and written. The other objects, the trees and the directories
+are merged sequentially, in the order of the files.
+
+By default, when there are more files than can be opened at once (see
+SetMaxOpenedFiles()), the files are merged by groups into the output file,
+the groups after the first one incrementally: all the merged objects then
+stay in memory until the end. With SetStreaming(), the groups are instead
+merged into temporary files, which are merged again by groups until they
+can all be opened together. Each group is a regular merge, which reads
+every object from the files of the group one after the other and writes
+the result right away, so that the memory used depends neither on the
+number of files nor on the number of objects.
 */
 
 #include "TFileMerger.h"
@@ -50,6 +68,8 @@ to be merged, like the standalone hadd program.
 #endif
 
 #include <cstring>
+#include <future>
+#include <vector>
 
 ClassImp(TFileMerger);
 
@@ -374,16 +394,36 @@ Bool_t TFileMerger::Merge(Bool_t)
 
 namespace {
 
-/// Merge a list of RNTuples
-Long64_t MergeRNTuples(TClass* rntupleHandle, const TString& /* target */, const TList& /* sources */) {
-   if (!rntupleHandle) {
+/// Merge the RNTuple `keyname` found in the directory `path` of the source files.  The RNTuple merge function
+/// receives the ntuple name as a TObjString followed by the input files that contain the ntuple.
+Long64_t MergeRNTuples(TClass *rntupleHandle, void *anchor, const char *keyname, const TString &path,
+                       TFile *firstSource, const TList &sources, TFileMergeInfo &info)
+{
+   if (!rntupleHandle || !rntupleHandle->GetMerge()) {
       return Long64_t(-1);
    }
-   // todo(max) implement rntuple merger
-   // [ ] build complete list of sources (some sources may actually be a directory with RNTuples inside)
-   // [ ] merge them
+
+   TList inputs;
+   TObjString ntupleName(keyname);
+   inputs.Add(&ntupleName);
+   TIter next(&sources);
+   if (firstSource) {
+      while (auto obj = next()) {
+         if (obj == firstSource)
+            break;
+      }
+      inputs.Add(firstSource);
+   }
+   while (auto source = static_cast<TFile *>(next())) {
+      auto dir = path.IsNull() ? static_cast<TDirectory *>(source) : source->GetDirectory(path);
+      if (dir && dir->GetListOfKeys()->FindObject(keyname))
+         inputs.Add(source);
+   }
+   if (inputs.GetEntries() < 2)
+      return Long64_t(-1);
+
    ROOT::MergeFunc_t func = rntupleHandle->GetMerge();
-   return func(static_cast<void*>(rntupleHandle), nullptr, nullptr);
+   return func(anchor, &inputs, &info);
 }
 
 Bool_t IsMergeable(TClass *cl)
@@ -597,13 +637,17 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
       // merge objects that don't derive from TObject
       if (std::string(keyclassname) == "ROOT::Experimental::RNTuple") {
          Warning("MergeRecursive", "merging RNTuples is experimental");
-         // todo(max): check if this works when a TDirectory is passed as the first
-         // input argument
-         Long64_t mergeResult = MergeRNTuples(cl, *path, *sourcelist);
+         Long64_t mergeResult = MergeRNTuples(cl, obj, keyname, path, current_file, *sourcelist, info);
+         if (ownobj)
+            cl->Destructor(obj);
          if (mergeResult < 0) {
             Error("MergeRecursive", "error merging RNTuples");
             return kFALSE;
          }
+         // The merged ntuple wrote its own anchor into the target file
+         oldkeyname = keyname;
+         info.Reset();
+         return kTRUE;
       } else {
          TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
          Error("MergeRecursive", "Merging objects that don't inherit from TObject is unimplemented (key: %s of type %s in file %s)",
@@ -804,6 +848,133 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Merge in parallel the histograms found in the directory `firstdir` of the
+/// first source file, for a regular merge with the implicit multi-threading.
+///
+/// The source files are split in consecutive groups, each one read by a
+/// thread which sums the histograms of its files; the sums are then added in
+/// the order of the groups and written in `target` in this thread. The names
+/// of the merged histograms are added to `allNames` so that the sequential
+/// merge skips them. Histograms are processed by batches to bound the memory.
+
+Bool_t TFileMerger::MergeHistogramsInParallel(TDirectory *target, TList *sourcelist, Int_t type, const TString &path,
+                                              TDirectory *firstdir, THashList &allNames)
+{
+   // Histograms have no ResetAfterMerge function, see MergeOne
+   if ((type & kResetable) && !(type & kNonResetable))
+      return kTRUE;
+
+   // The highest cycle of each histogram comes first in the list of keys
+   std::vector<TString> names;
+   std::vector<TClass *> classes;
+   TIter nextkey(firstdir->GetListOfKeys());
+   while (TKey *key = (TKey *)nextkey()) {
+      const char *keyname = key->GetName();
+      if (allNames.FindObject(keyname))
+         continue;
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (!cl || !cl->IsTObject() || !cl->GetMerge() || cl->GetResetAfterMerge() || !cl->InheritsFrom(R__TH1_Class))
+         continue;
+      if ((type & kOnlyListed) && !fObjectNames.Contains(TString(keyname) + " "))
+         continue;
+      allNames.Add(new TObjString(keyname));
+      names.emplace_back(keyname);
+      classes.emplace_back(cl);
+   }
+   if (names.empty())
+      return kTRUE;
+
+   std::vector<TFile *> files;
+   TIter nextfile(sourcelist);
+   while (TFile *file = (TFile *)nextfile())
+      files.push_back(file);
+   const std::size_t nGroups = std::min<std::size_t>(ROOT::GetThreadPoolSize(), files.size());
+   const std::size_t groupSize = (files.size() + nGroups - 1) / nGroups;
+
+   Bool_t status = kTRUE;
+   constexpr std::size_t kBatchSize = 1024;
+   for (std::size_t first = 0; first < names.size(); first += kBatchSize) {
+      const std::size_t nNames = std::min(kBatchSize, names.size() - first);
+      // sums[g][i] is the sum of the histogram first+i over the files of the group g
+      std::vector<std::vector<TObject *>> sums(nGroups, std::vector<TObject *>(nNames, nullptr));
+
+      // Each file is used by a single thread
+      auto mergeGroup = [&](std::size_t g) {
+         TFileMergeInfo info(target);
+         info.fIOFeatures = fIOFeatures;
+         info.fOptions = fMergeOptions;
+         TList inputs;
+         const std::size_t end = std::min(files.size(), (g + 1) * groupSize);
+         for (std::size_t f = g * groupSize; f < end; ++f) {
+            TDirectory *dir = files[f]->GetDirectory(path);
+            if (!dir)
+               continue;
+            // Any temporary object is attached to the source directory, which no other thread uses
+            TDirectory::TContext ctxt(dir);
+            for (std::size_t i = 0; i < nNames; ++i) {
+               TKey *key = (TKey *)dir->GetListOfKeys()->FindObject(names[first + i]);
+               if (!key)
+                  continue;
+               TObject *hobj = key->ReadObj();
+               if (!hobj) {
+                  Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
+                       key->GetName(), key->GetTitle(), files[f]->GetName());
+                  continue;
+               }
+               hobj->ResetBit(kMustCleanup);
+               if (!sums[g][i]) {
+                  sums[g][i] = hobj;
+                  continue;
+               }
+               inputs.Add(hobj);
+               if (classes[first + i]->GetMerge()(sums[g][i], &inputs, &info) < 0)
+                  Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                        key->GetName(), files[f]->GetName());
+               inputs.Clear();
+               info.fIsFirst = kFALSE;
+               delete hobj;
+            }
+         }
+      };
+      std::vector<std::future<void>> tasks;
+      for (std::size_t g = 1; g < nGroups; ++g)
+         tasks.emplace_back(std::async(std::launch::async, mergeGroup, g));
+      mergeGroup(0);
+      for (auto &task : tasks)
+         task.get();
+
+      // Add the sums of the groups in order and write the result
+      TFileMergeInfo info(target);
+      info.fIOFeatures = fIOFeatures;
+      info.fOptions = fMergeOptions;
+      TList inputs;
+      for (std::size_t i = 0; i < nNames; ++i) {
+         TObject *obj = nullptr;
+         for (std::size_t g = 0; g < nGroups; ++g) {
+            if (!sums[g][i])
+               continue;
+            if (!obj) {
+               obj = sums[g][i];
+               continue;
+            }
+            inputs.Add(sums[g][i]);
+            if (classes[first + i]->GetMerge()(obj, &inputs, &info) < 0)
+               Error("MergeRecursive", "calling Merge() on '%s' with the partial sums", names[first + i].Data());
+            inputs.Clear();
+            delete sums[g][i];
+         }
+         if (!obj) {
+            Info("MergeRecursive", "could not read object for key {%s}", names[first + i].Data());
+            continue;
+         }
+         target->cd();
+         status = WriteOneAndDelete(names[first + i], classes[first + i], obj, kTRUE, kTRUE, target) && status;
+      }
+   }
+   return status;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Merge all objects in a directory
 ///
@@ -870,6 +1041,13 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                return kFALSE; // Stop completely in case of error.
          } // while ( (obj = (TKey*)nextobj()))
 
+         // With the implicit multi-threading, the histograms read from the keys of the first file
+         // are merged by several threads
+         if (!(type & kIncremental) && current_file == sourcelist->First() && sourcelist->GetSize() > 1 &&
+             ROOT::IsImplicitMTEnabled() && ROOT::GetThreadPoolSize() > 1) {
+            status = MergeHistogramsInParallel(target, sourcelist, type, path, current_sourcedir, allNames) && status;
+         }
+
          // loop over all keys in this directory
          TIter nextkey( current_sourcedir->GetListOfKeys() );
          TKey *key;
@@ -964,24 +1142,13 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
 
    Bool_t result = kTRUE;
    Int_t type = in_type;
+   std::vector<TString> temporaries;
+   if (fStreaming && fExcessFiles.GetEntries() > 0)
+      result = MergeToTemporaryFiles(type, temporaries);
    while (result && fFileList.GetEntries()>0) {
       result = MergeRecursive(fOutputFile, &fFileList, type);
 
-      // Remove local copies if there are any
-      TIter next(&fFileList);
-      TFile *file;
-      while ((file = (TFile*) next())) {
-         // close the files
-         if (file->TestBit(kCanDelete)) file->Close();
-         // remove the temporary files
-         if(fLocal && !file->InheritsFrom(TMemFile::Class())) {
-            TString p(file->GetPath());
-            // coverity[unchecked_value] Index is return a value with range or NPos to select the whole name.
-            p = p(0, p.Index(':',0));
-            gSystem->Unlink(p);
-         }
-      }
-      fFileList.Clear();
+      CloseInputFiles();
       if (result && fExcessFiles.GetEntries() > 0) {
          // We merge the first set of files in the output,
          // we now need to open the next set and make
@@ -991,6 +1158,8 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
          result = OpenExcessFiles();
       }
    }
+   for (const auto &name : temporaries)
+      gSystem->Unlink(name);
    if (!result) {
       Error("Merge", "error during merge of your ROOT files");
    } else {
@@ -1025,6 +1194,89 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Close the source files merged so far and remove the local copies, if any.
+
+void TFileMerger::CloseInputFiles()
+{
+   TIter next(&fFileList);
+   TFile *file;
+   while ((file = (TFile*) next())) {
+      // close the files
+      if (file->TestBit(kCanDelete)) file->Close();
+      // remove the temporary files
+      if(fLocal && !file->InheritsFrom(TMemFile::Class())) {
+         TString p(file->GetPath());
+         // coverity[unchecked_value] Index is return a value with range or NPos to select the whole name.
+         p = p(0, p.Index(':',0));
+         gSystem->Unlink(p);
+      }
+   }
+   fFileList.Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Streaming merge of more files than can be opened at once: the source files
+/// are merged by groups of at most fMaxOpenedFiles - 1 into temporary files,
+/// which are merged again by groups until they can all be opened together.
+///
+/// The groups are regular merges whatever the type, which only applies to the
+/// final merge into the output file. On return, fFileList holds the opened
+/// temporary files and fExcessFiles is empty. The names of the temporary files
+/// still on disk are in temporaries, also in case of error; they are to be
+/// removed by the caller after the final merge.
+
+Bool_t TFileMerger::MergeToTemporaryFiles(Int_t type, std::vector<TString> &temporaries)
+{
+   const Int_t groupType = type & ~(kIncremental | kDelayWrite);
+   const Int_t compress = fOutputFile->GetCompressionSettings();
+   const Bool_t local = fLocal;
+   Bool_t result = kTRUE;
+   while (result && fFileList.GetEntries() + fExcessFiles.GetEntries() > fMaxOpenedFiles - 1) {
+      // The inputs of this level are the temporary files before firstOutput
+      const std::size_t firstOutput = temporaries.size();
+      while (result && fFileList.GetEntries() > 0) {
+         TUUID uuid;
+         TString name = TString::Format("%s/ROOTMERGE-%s.root", gSystem->TempDirectory(), uuid.AsString());
+         if (fPrintLevel > 0) {
+            Printf("%s Merging %d files into %s", fMsgPrefix.Data(), fFileList.GetEntries(), name.Data());
+         }
+         TFile *output = TFile::Open(name, "RECREATE", "", compress);
+         if (!output || output->IsZombie()) {
+            Error("MergeToTemporaryFiles", "cannot create the temporary file %s", name.Data());
+            delete output;
+            result = kFALSE;
+            break;
+         }
+         temporaries.push_back(name);
+         {
+            TDirectory::TContext ctxt;
+            result = MergeRecursive(output, &fFileList, groupType);
+         }
+         gROOT->GetListOfFiles()->Remove(output);
+         output->Close();
+         delete output;
+
+         CloseInputFiles();
+         if (result && fExcessFiles.GetEntries() > 0)
+            result = OpenExcessFiles();
+      }
+      for (std::size_t i = 0; i < firstOutput; ++i)
+         gSystem->Unlink(temporaries[i]);
+      temporaries.erase(temporaries.begin(), temporaries.begin() + firstOutput);
+      if (!result)
+         break;
+
+      // The temporary files are local, they are not copied again
+      fLocal = kFALSE;
+      for (const auto &name : temporaries)
+         fExcessFiles.Add(new TObjString(name));
+      result = OpenExcessFiles();
+   }
+   fLocal = local;
+   return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Open up to fMaxOpenedFiles of the excess files.
 
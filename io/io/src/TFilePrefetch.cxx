@@ -17,14 +17,24 @@
 #include "TVirtualMonitoring.h"
 #include "TSemaphore.h"
 #include "TFPBlock.h"
+#include "TLockFile.h"
 #include "strlcpy.h"
 
+#include <algorithm>
+#include <ctime>
 #include <string>
 #include <sstream>
 #include <cstdio>
 #include <cstdlib>
 #include <cctype>
 #include <cassert>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 static const int kMAX_READ_SIZE    = 2;   //maximum size of the read list of blocks
 
@@ -47,6 +57,12 @@ processing considerably decreases. Besides the prefetching
 mechanisms there is also a local caching option which can be
 enabled by the user. Both capabilities are disabled by default
 and must be explicitly enabled by the user.
+
+The cache directory can be shared by the processes of a node: the
+blocks are identified by the name of their file and their pieces,
+they are written atomically and, if a maximum size is set with
+SetCacheMaxSize(), the least recently read blocks are evicted under
+a lock file. Cache hits are read with a memory mapping of the block.
 */
 
 
@@ -56,6 +72,8 @@ and must be explicitly enabled by the user.
 TFilePrefetch::TFilePrefetch(TFile* file) :
   fFile(file),
   fConsumer(0),
+  fCacheMaxSize(0),
+  fCacheBytesAdded(0),
   fThreadJoined(kTRUE),
   fPrefetchFinished(kFALSE)
 {
@@ -109,8 +127,10 @@ void TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
 {
    char* path = 0;
 
-   if (CheckBlockInCache(path, block)){
-      block->SetBuffer(GetBlockFromCache(path, block->GetDataSize()));
+   char* buffer = 0;
+
+   if (CheckBlockInCache(path, block) && (buffer = GetBlockFromCache(path, block->GetDataSize()))){
+      block->SetBuffer(buffer);
       inCache = kTRUE;
    }
    else{
@@ -391,6 +411,30 @@ Int_t TFilePrefetch::SumHex(const char *hex)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the path of the cache file of a block and the path of its directory.
+///
+/// The name of the file is the MD5 of the name of the prefetched file and of
+/// the positions and lengths of the pieces of the block, so that blocks of
+/// different files never share a cache entry; the directory is the sum of the
+/// hex digits of the MD5 modulo 16.
+
+TString TFilePrefetch::GetCachePath(TFPBlock* block, TString &dirPath)
+{
+   TMD5 md;
+   TString concatStr(fFile ? fFile->GetEndpointUrl()->GetUrl() : "");
+   md.Update((UChar_t*)concatStr.Data(), concatStr.Length());
+   for (Int_t i=0; i < block->GetNoElem(); i++){
+      concatStr.Form("%lld:%d;", block->GetPos(i), block->GetLen(i));
+      md.Update((UChar_t*)concatStr.Data(), concatStr.Length());
+   }
+   md.Final();
+
+   TString fileName( md.AsString() );
+   dirPath.Form("%s/%i", fPathCache.Data(), SumHex(fileName) % 16);
+   return dirPath + "/" + fileName;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Test if the block is in cache.
 
@@ -399,60 +443,57 @@ Bool_t TFilePrefetch::CheckBlockInCache(char*& path, TFPBlock* block)
    if (fPathCache == "")
       return false;
 
-   Bool_t found = false;
-   TString fullPath(fPathCache); // path of the cached files.
-
-   Int_t value = 0;
-
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
-
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1(offset+len)
-   TMD5* md = new TMD5();
-
-   TString concatStr;
-   for (Int_t i=0; i < block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
-   }
-
-   md->Final();
-   TString fileName( md->AsString() );
-   value = SumHex(fileName);
-   value = value % 16;
-   TString dirName;
-   dirName.Form("%i", value);
-
-   fullPath += "/" + dirName + "/" + fileName;
+   TString dirPath;
+   TString fullPath = GetCachePath(block, dirPath);
 
    FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      path = new char[fullPath.Length() + 1];
-      strlcpy(path, fullPath,fullPath.Length() + 1);
-      found = true;
-   } else
-      found = false;
-
-   delete md;
-   return found;
+   if (gSystem->GetPathInfo(fullPath, stat) != 0 || stat.fSize != block->GetDataSize())
+      return false;
+
+   path = new char[fullPath.Length() + 1];
+   strlcpy(path, fullPath,fullPath.Length() + 1);
+   return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a buffer from cache.
+///
+/// The cache file is memory mapped (read with stdio on Windows) and copied in
+/// a buffer allocated with calloc, as the other buffers of the blocks. Its
+/// modification time is updated, this is the time used for the LRU eviction.
+/// Return 0 if the cache file cannot be read, e.g. because another process
+/// evicted it in the meantime.
 
 char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 {
-   char *buffer = 0;
-   TString strPath = path;
-
-   strPath += "?filetype=raw";
-   TFile* file = new TFile(strPath);
-
    Double_t start = 0;
    if (gPerfStats != 0) start = TTimeStamp();
 
-   buffer = (char*) calloc(length, sizeof(char));
-   file->ReadBuffer(buffer, 0, length);
+   char *buffer = (char*) calloc(length, sizeof(char));
+   Bool_t ok = kFALSE;
+#ifndef WIN32
+   int fd = open(path, O_RDONLY);
+   if (fd >= 0) {
+      void *map = length > 0 ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+      if (map != MAP_FAILED) {
+         memcpy(buffer, map, length);
+         munmap(map, length);
+         ok = kTRUE;
+      }
+      close(fd);
+   }
+#else
+   FILE *fp = fopen(path, "rb");
+   if (fp) {
+      ok = (fread(buffer, 1, length, fp) == (size_t)length);
+      fclose(fp);
+   }
+#endif
+   if (!ok) {
+      free(buffer);
+      return 0;
+   }
+   gSystem->Utime(path, (Long_t)time(nullptr), 0);
 
    fFile->fBytesRead  += length;
    fFile->fgBytesRead += length;
@@ -464,61 +505,90 @@ char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
    if (gPerfStats != 0) {
       gPerfStats->FileReadEvent(fFile, length, start);
    }
-
-   file->Close();
-   delete file;
    return buffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Save the block content in cache.
+///
+/// The block is written in a temporary file renamed to its final name, so that
+/// other processes sharing the cache directory never see a partial block.
 
 void TFilePrefetch::SaveBlockInCache(TFPBlock* block)
 {
    if (fPathCache == "")
       return;
 
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1
-   TMD5* md = new TMD5();
+   TString dirPath;
+   TString fullPath = GetCachePath(block, dirPath);
+   if (gSystem->AccessPathName(dirPath))
+      gSystem->mkdir(dirPath, kTRUE);
 
-   TString concatStr;
-   for(Int_t i=0; i< block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
+   TString tmpPath = TString::Format("%s.%d.tmp", fullPath.Data(), gSystem->GetPid());
+   FILE *fp = fopen(tmpPath, "wb");
+   if (!fp)
+      return;
+   Bool_t ok = (fwrite(block->GetBuffer(), 1, block->GetDataSize(), fp) == (size_t)block->GetDataSize());
+   ok = (fclose(fp) == 0) && ok;
+   if (!ok || gSystem->Rename(tmpPath, fullPath)) {
+      gSystem->Unlink(tmpPath);
+      return;
    }
-   md->Final();
 
-   TString fileName( md->AsString() );
-   Int_t value = SumHex(fileName);
-   value = value % 16;
-
-   TString fullPath( fPathCache );
-   TString dirName;
-   dirName.Form("%i", value);
-   fullPath += ("/" + dirName);
+   fCacheBytesAdded += block->GetDataSize();
+   if (fCacheMaxSize > 0 && fCacheBytesAdded > fCacheMaxSize / 16) {
+      fCacheBytesAdded = 0;
+      EvictFromCache();
+   }
+}
 
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the least recently used blocks of the cache directory until it uses
+/// less than 90% of the maximum size set with SetCacheMaxSize().
+///
+/// The eviction is protected by a lock file in the cache directory, so that the
+/// processes sharing the cache do not evict it at the same time.
 
-   TFile* file = 0;
-   fullPath += ("/" + fileName);
-   FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "update");
-   } else{
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "new");
+void TFilePrefetch::EvictFromCache()
+{
+   TLockFile lock(fPathCache + "/.lock", 60);
+
+   struct CacheEntry {
+      Long_t fTime;
+      Long64_t fSize;
+      TString fPath;
+   };
+   std::vector<CacheEntry> entries;
+   Long64_t total = 0;
+   for (Int_t i = 0; i < 16; i++) {
+      TString dirPath = TString::Format("%s/%i", fPathCache.Data(), i);
+      void *dir = gSystem->OpenDirectory(dirPath);
+      if (!dir)
+         continue;
+      while (const char *name = gSystem->GetDirEntry(dir)) {
+         if (name[0] == '.')
+            continue;
+         TString path = dirPath + "/" + name;
+         FileStat_t stat;
+         if (gSystem->GetPathInfo(path, stat) != 0 || !R_ISREG(stat.fMode))
+            continue;
+         entries.push_back({stat.fMtime, stat.fSize, path});
+         total += stat.fSize;
+      }
+      gSystem->FreeDirectory(dir);
    }
+   if (total <= fCacheMaxSize)
+      return;
 
-   if (file) {
-      // coverity[unchecked_value] We do not print error message, have not error
-      // return code and close the file anyway, not need to check the return value.
-      file->WriteBuffer(block->GetBuffer(), block->GetDataSize());
-      file->Close();
-      delete file;
+   std::sort(entries.begin(), entries.end(),
+             [](const CacheEntry &a, const CacheEntry &b) { return a.fTime < b.fTime; });
+   const Long64_t target = fCacheMaxSize / 10 * 9;
+   for (const auto &entry : entries) {
+      if (total <= target)
+         break;
+      if (!gSystem->Unlink(entry.fPath))
+         total -= entry.fSize;
    }
-   delete md;
 }
 
 
@@ -529,11 +599,23 @@ Bool_t TFilePrefetch::SetCache(const char* path)
 {
   fPathCache = path;
 
-  if (!gSystem->OpenDirectory(path)){
-    return (!gSystem->mkdir(path) ? true : false);
+  if (gSystem->AccessPathName(path)){
+    return (!gSystem->mkdir(path, kTRUE) ? true : false);
   }
 
   // Directory already exists
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of bytes of the cache directory.
+///
+/// When the blocks saved since the last check exceed 1/16 of this size, the
+/// least recently read blocks are deleted until the directory uses less than
+/// 90% of it, whichever process wrote them. A value of 0 (the default) means
+/// the cache is not bounded.
+
+void TFilePrefetch::SetCacheMaxSize(Long64_t maxBytes)
+{
+   fCacheMaxSize = maxBytes;
+}
@@ -419,7 +419,7 @@ TGenCollectionProxy::Value::Value(const std::string& inside_type, Bool_t silent)
 
             // R__ASSERT("FallBack, should be hardly used.");
 
-            TypeInfo_t *ti = gCling->TypeInfo_Factory();
+            TypeInfo_t *ti = gInterpreter->TypeInfo_Factory();
             gCling->TypeInfo_Init(ti,inside.c_str());
             if ( !gCling->TypeInfo_IsValid(ti) ) {
                if (isPointer) {
@@ -580,6 +580,7 @@ TGenCollectionProxy::TGenCollectionProxy(const TGenCollectionProxy& copy)
    fOnFileClass    = copy.fOnFileClass;
    fReadMemberWise = new TObjArray(TCollection::kInitCapacity,-1);
    fConversionReadMemberWise = 0;
+   fInfoReadMemberWise = nullptr;
    fWriteMemberWise = 0;
    fProperties     = copy.fProperties;
    fFunctionCreateIterators    = copy.fFunctionCreateIterators;
@@ -626,6 +627,7 @@ TGenCollectionProxy::TGenCollectionProxy(Info_t info, size_t iter_size)
    }
    fReadMemberWise = new TObjArray(TCollection::kInitCapacity,-1);
    fConversionReadMemberWise   = 0;
+   fInfoReadMemberWise         = nullptr;
    fWriteMemberWise            = 0;
    fFunctionCreateIterators    = 0;
    fFunctionCopyIterator       = 0;
@@ -677,6 +679,7 @@ TGenCollectionProxy::TGenCollectionProxy(const ROOT::TCollectionProxyInfo &info,
    }
    fReadMemberWise = new TObjArray(TCollection::kInitCapacity,-1);
    fConversionReadMemberWise   = 0;
+   fInfoReadMemberWise         = nullptr;
    fWriteMemberWise            = 0;
    fFunctionCreateIterators    = info.fCreateIterators;
    fFunctionCopyIterator       = info.fCopyIterator;
@@ -723,6 +726,11 @@ TGenCollectionProxy::~TGenCollectionProxy()
       delete fConversionReadMemberWise;
       fConversionReadMemberWise = 0;
    }
+   if (fInfoReadMemberWise) {
+      for (auto &entry : *fInfoReadMemberWise)
+         delete entry.second;
+      delete fInfoReadMemberWise;
+   }
    delete fWriteMemberWise;
 }
 
@@ -880,7 +888,7 @@ TGenCollectionProxy *TGenCollectionProxy::InitializeEx(Bool_t silent)
                fKey   = R__CreateValue(inside[1], silent);
 
                {
-                  TInterpreter::SuspendAutoParsing autoParseRaii(gCling);
+                  TInterpreter::SuspendAutoParsing autoParseRaii(gInterpreter);
                   if (0==TClass::GetClass(nam.c_str(), true, false, fValOffset, fValDiff)) {
                      // We need to emulate the pair
                      TVirtualStreamerInfo::Factory()->GenerateInfoForPair(inside[1], inside[2], silent, fValOffset, fValDiff);
@@ -1790,6 +1798,24 @@ TStreamerInfoActions::TActionSequence *TGenCollectionProxy::GetReadMemberWiseAct
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the set of action necessary to stream in member-wise the content of this
+/// collection described by 'info', which is not necessarily the StreamerInfo of the
+/// value class (it can for example describe one of its base classes).
+///
+/// The sub-branches of a split collection each need such a sequence; creating it
+/// once per proxy avoids compiling the same actions again for every sub-branch.
+
+TStreamerInfoActions::TActionSequence *TGenCollectionProxy::GetInfoReadMemberWiseActions(TVirtualStreamerInfo *info)
+{
+   if (!fInfoReadMemberWise)
+      fInfoReadMemberWise = new std::map<const TVirtualStreamerInfo*, TStreamerInfoActions::TActionSequence*>();
+   auto &result = (*fInfoReadMemberWise)[info];
+   if (!result)
+      result = TStreamerInfoActions::TActionSequence::CreateReadMemberWiseActions(info, *this);
+   return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the set of action necessary to stream out this collection member-wise.
 
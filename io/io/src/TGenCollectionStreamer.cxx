@@ -30,6 +30,9 @@ size(), clear(), resize(). resize() may be a void operation.
 #include "TStreamerElement.h"
 #include "TVirtualCollectionIterators.h"
 
+#include <typeinfo>
+#include <vector>
+
 TGenCollectionStreamer::TGenCollectionStreamer(const TGenCollectionStreamer& copy)
       : TGenCollectionProxy(copy), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault)
 {
@@ -1220,6 +1223,51 @@ void TGenCollectionStreamer::ReadBufferVectorPrimitivesDouble32(TBuffer &b, void
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if this proxies a compiled std::vector<std::vector<basictype>>.
+/// The type of the content of the inner vector is checked too, since for
+/// example vector<vector<Double32_t> > has the type_info of vector<vector<double> >
+/// but a different on-file representation.
+
+template <typename basictype>
+Bool_t TGenCollectionStreamer::IsVectorOfVector() const
+{
+   TClass *cl = GetCollectionClass();
+   if (!cl || !cl->GetTypeInfo() || *cl->GetTypeInfo() != typeid(std::vector<std::vector<basictype>>))
+      return kFALSE;
+   TVirtualCollectionProxy *innerProxy = fVal->fType ? fVal->fType->GetCollectionProxy() : nullptr;
+   return innerProxy && innerProxy->GetType() == TDataType::GetType(typeid(basictype));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a std::vector<std::vector<basictype>> directly, instead of streaming
+/// each inner vector through its TClass and collection proxy.
+
+template <typename basictype>
+void TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives(TBuffer &b, void *obj, const TClass *onFileClass)
+{
+   if (onFileClass && onFileClass != GetCollectionClass()) {
+      // Conversion from another collection type.
+      ReadBufferGeneric(b, obj, onFileClass);
+      return;
+   }
+
+   int nElements = 0;
+   b >> nElements;
+   if (nElements < 0)
+      return;
+
+   auto &outer = *static_cast<std::vector<std::vector<basictype>> *>(obj);
+   outer.resize(nElements);
+   for (auto &inner : outer) {
+      int nInner = 0;
+      b >> nInner;
+      inner.resize(nInner > 0 ? nInner : 0);
+      b.ReadFastArray(inner.data(), (Int_t)inner.size());
+   }
+}
+
+
 void TGenCollectionStreamer::ReadBuffer(TBuffer &b, void *obj, const TClass *onFileClass)
 {
    // Call the specialized function.  The first time this call ReadBufferDefault which
@@ -1302,6 +1350,35 @@ void TGenCollectionStreamer::ReadBufferDefault(TBuffer &b, void *obj, const TCla
             break;
       }
    }
+   else if (fSTL_type == ROOT::kSTLvector && fVal->fCase == kIsClass)
+   {
+      // Vectors of vectors of primitives are read without going through the
+      // TClass and the collection proxy of each inner vector.
+      if (IsVectorOfVector<Char_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Char_t>;
+      else if (IsVectorOfVector<Short_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Short_t>;
+      else if (IsVectorOfVector<Int_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Int_t>;
+      else if (IsVectorOfVector<Long_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Long_t>;
+      else if (IsVectorOfVector<Long64_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Long64_t>;
+      else if (IsVectorOfVector<Float_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Float_t>;
+      else if (IsVectorOfVector<Double_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<Double_t>;
+      else if (IsVectorOfVector<UChar_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<UChar_t>;
+      else if (IsVectorOfVector<UShort_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<UShort_t>;
+      else if (IsVectorOfVector<UInt_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<UInt_t>;
+      else if (IsVectorOfVector<ULong_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<ULong_t>;
+      else if (IsVectorOfVector<ULong64_t>())
+         fReadBufferFunc = &TGenCollectionStreamer::ReadBufferVectorOfVectorPrimitives<ULong64_t>;
+   }
    // TODO Could we do something better for RVec?
    (this->*fReadBufferFunc)(b,obj,onFileClass);
 }
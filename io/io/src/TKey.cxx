@@ -49,6 +49,7 @@
 
 #include <atomic>
 #include <iostream>
+#include <mutex>
 
 #include "TROOT.h"
 #include "TClass.h"
@@ -62,6 +63,7 @@
 #include "TInterpreter.h"
 #include "TError.h"
 #include "TVirtualStreamerInfo.h"
+#include "ROOT/RZipBlocks.hxx"
 #include "TSchemaRuleSet.h"
 #include "ThreadLocalStorage.h"
 
@@ -238,10 +240,21 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
 
    Build(motherDir, obj->ClassName(), -1);
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
+   Int_t lbuf, noutot;
    fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
    fBufferRef->SetParent(GetFile());
+#ifdef R__USE_IMT
+   // Only the updates of the list of keys and of the layout of the file are serialized between the threads writing
+   // into the same file: the object is streamed and compressed without holding the lock.
+   std::unique_lock<std::mutex> sentry;
+   if (GetFile())
+      sentry = std::unique_lock<std::mutex>(GetFile()->fWriteMutex);
+#endif
    fCycle     = fMotherDir->AppendKey(this);
+#ifdef R__USE_IMT
+   if (sentry)
+      sentry.unlock();
+#endif
 
    Streamer(*fBufferRef);         //write key itself
    fKeylen    = fBufferRef->Length();
@@ -258,34 +271,31 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
       fBuffer = new char[buflen];
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+      noutot = ROOT::Internal::ZipBlocks(cxlevel, cxAlgorithm, objbuf, fObjlen, bufcur);
+      if (noutot == 0) { //this happens when the buffer cannot be compressed
+         delete [] fBuffer;
+         fBuffer = nullptr;
       }
-      Create(noutot);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-      delete fBufferRef; fBufferRef = 0;
    } else {
+      noutot = 0;
+   }
+   if (!fBuffer)
       fBuffer = fBufferRef->Buffer();
-      Create(fObjlen);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
+
+#ifdef R__USE_IMT
+   if (sentry.mutex())
+      sentry.lock();
+#endif
+   Create(noutot ? noutot : fObjlen);
+#ifdef R__USE_IMT
+   if (sentry)
+      sentry.unlock();
+#endif
+   fBufferRef->SetBufferOffset(0);
+   Streamer(*fBufferRef);         //write key itself again
+   if (noutot) {
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+      delete fBufferRef; fBufferRef = 0;
    }
 }
 
@@ -329,12 +339,23 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
 
    fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
    fBufferRef->SetParent(GetFile());
+#ifdef R__USE_IMT
+   // Only the updates of the list of keys and of the layout of the file are serialized between the threads writing
+   // into the same file: the object is streamed and compressed without holding the lock.
+   std::unique_lock<std::mutex> sentry;
+   if (GetFile())
+      sentry = std::unique_lock<std::mutex>(GetFile()->fWriteMutex);
+#endif
    fCycle     = fMotherDir->AppendKey(this);
+#ifdef R__USE_IMT
+   if (sentry)
+      sentry.unlock();
+#endif
 
    Streamer(*fBufferRef);         //write key itself
    fKeylen    = fBufferRef->Length();
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
+   Int_t lbuf, noutot;
 
    fBufferRef->MapObject(actualStart,clActual);         //register obj in map in case of self reference
    clActual->Streamer((void*)actualStart, *fBufferRef); //write object
@@ -349,34 +370,31 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
       fBuffer = new char[buflen];
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+      noutot = ROOT::Internal::ZipBlocks(cxlevel, cxAlgorithm, objbuf, fObjlen, bufcur);
+      if (noutot == 0) { //this happens when the buffer cannot be compressed
+         delete [] fBuffer;
+         fBuffer = nullptr;
       }
-      Create(noutot);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-      delete fBufferRef; fBufferRef = 0;
    } else {
+      noutot = 0;
+   }
+   if (!fBuffer)
       fBuffer = fBufferRef->Buffer();
-      Create(fObjlen);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
+
+#ifdef R__USE_IMT
+   if (sentry.mutex())
+      sentry.lock();
+#endif
+   Create(noutot ? noutot : fObjlen);
+#ifdef R__USE_IMT
+   if (sentry)
+      sentry.unlock();
+#endif
+   fBufferRef->SetBufferOffset(0);
+   Streamer(*fBufferRef);         //write key itself again
+   if (noutot) {
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+      delete fBufferRef; fBufferRef = 0;
    }
 }
 
@@ -817,18 +835,7 @@ TObject *TKey::ReadObj()
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
+      Int_t nout = ROOT::Internal::UnzipBlocks(bufcur, fNbytes - fKeylen, objbuf, fObjlen);
       compressedBuffer.reset(nullptr);
       if (nout) {
          tobj->Streamer(bufferRef); //does not work with example 2 above
@@ -942,18 +949,7 @@ TObject *TKey::ReadObjWithBuffer(char *bufferRead)
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&bufferRead[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
+      Int_t nout = ROOT::Internal::UnzipBlocks(bufcur, fNbytes - fKeylen, objbuf, fObjlen);
       if (nout) {
          tobj->Streamer(bufferRef); //does not work with example 2 above
       } else {
@@ -1086,18 +1082,7 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
+      Int_t nout = ROOT::Internal::UnzipBlocks(bufcur, fNbytes - fKeylen, objbuf, fObjlen);
       if (nout) {
          cl->Streamer((void*)pobj, bufferRef, clOnfile);    //read object
       } else {
@@ -1174,18 +1159,7 @@ Int_t TKey::Read(TObject *obj)
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
-      Int_t nin, nout = 0, nbuf;
-      Int_t noutot = 0;
-      while (1) {
-         Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-         if (hc!=0) break;
-         R__unzip(&nin, bufcur, &nbuf, (unsigned char*) objbuf, &nout);
-         if (!nout) break;
-         noutot += nout;
-         if (noutot >= fObjlen) break;
-         bufcur += nin;
-         objbuf += nout;
-      }
+      Int_t nout = ROOT::Internal::UnzipBlocks(bufcur, fNbytes - fKeylen, objbuf, fObjlen);
       if (nout) obj->Streamer(bufferRef);
    } else {
       obj->Streamer(bufferRef);
@@ -101,6 +101,9 @@ robust Streamer mechanism I opted for 3).
 #include "mmprivate.h"
 
 #include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #if defined(R__UNIX) && !defined(R__MACOSX) && !defined(R__WINGCC)
 #define HAVE_SEMOP
@@ -215,7 +218,6 @@ TMapFile::TMapFile()
    fWritable    = kFALSE;
    fSemaphore   = -1;
    fhSemaphore  = 0;
-   fGetting     = nullptr;
    fWritten     = 0;
    fSumBuffer   = 0;
    fSum2Buffer  = 0;
@@ -251,7 +253,6 @@ TMapFile::TMapFile(const char *name, const char *title, Option_t *option,
    fOption      = StrDup(option);
    fDirectory   = nullptr;
    fBrowseList  = nullptr;
-   fGetting     = nullptr;
    fWritten     = 0;
    fSumBuffer   = 0;
    fSum2Buffer  = 0;
@@ -529,7 +530,6 @@ TMapFile::TMapFile(const TMapFile &f, Longptr_t offset) : TObject(f)
    fOffset      = offset;
    fDirectory   = nullptr;
    fBrowseList  = nullptr;
-   fGetting     = nullptr;
    fWritten     = f.fWritten;
    fSumBuffer   = f.fSumBuffer;
    fSum2Buffer  = f.fSum2Buffer;
@@ -598,10 +598,7 @@ void TMapFile::Add(const TObject *obj, const char *name)
 {
    if (!fWritable || !fMmallocDesc) return;
 
-   Bool_t lock = fGetting != obj ? kTRUE : kFALSE;
-
-   if (lock)
-      AcquireSemaphore();
+   AcquireSemaphore();
 
    ROOT::Internal::gMmallocDesc = fMmallocDesc;
 
@@ -626,43 +623,53 @@ void TMapFile::Add(const TObject *obj, const char *name)
 
    ROOT::Internal::gMmallocDesc = nullptr;
 
-   if (lock)
-      ReleaseSemaphore();
+   ReleaseSemaphore();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Update an object (or all objects, if obj == 0) in shared memory.
+///
+/// The objects are streamed into private buffers first; the semaphore is only
+/// held while these buffers are copied into the shared memory, so that readers
+/// calling Get() are not blocked while the objects are being streamed.
 
 void TMapFile::Update(TObject *obj)
 {
    if (!fWritable || !fMmallocDesc) return;
 
-   AcquireSemaphore();
-
-   ROOT::Internal::gMmallocDesc = fMmallocDesc;
-
    Bool_t all = (obj == 0) ? kTRUE : kFALSE;
 
+   // Only the writer modifies the list of records, no need to lock for walking it.
+   std::vector<std::pair<TMapRec *, std::unique_ptr<TBufferFile>>> streamed;
    TMapRec *mr = fFirst;
    while (mr) {
       if (all || mr->fObject == obj) {
-         TBufferFile *b;
-         if (!mr->fBufSize) {
-            b = new TBufferFile(TBuffer::kWrite, GetBestBuffer());
-            mr->fClassName = StrDup(mr->fObject->ClassName());
-         } else
-            b = new TBufferFile(TBuffer::kWrite, mr->fBufSize, mr->fBuffer);
+         std::unique_ptr<TBufferFile> b(new TBufferFile(TBuffer::kWrite, mr->fBufSize ? mr->fBufSize : GetBestBuffer()));
          b->MapObject(mr->fObject);  //register obj in map to handle self reference
          mr->fObject->Streamer(*b);
-         mr->fBufSize = b->BufferSize();
-         mr->fBuffer  = b->Buffer();
-         SumBuffer(b->Length());
-         b->DetachBuffer();
-         delete b;
+         streamed.emplace_back(mr, std::move(b));
       }
       mr = mr->fNext;
    }
 
+   AcquireSemaphore();
+
+   ROOT::Internal::gMmallocDesc = fMmallocDesc;
+
+   for (auto &entry : streamed) {
+      mr = entry.first;
+      const Int_t len = entry.second->Length();
+      if (!mr->fClassName)
+         mr->fClassName = StrDup(mr->fObject->ClassName());
+      if (len > mr->fBufSize) {
+         delete [] (char *)mr->fBuffer;
+         mr->fBuffer  = new char[len];
+         mr->fBufSize = len;
+      }
+      memcpy(mr->fBuffer, entry.second->Buffer(), len);
+      SumBuffer(len);
+   }
+
    ROOT::Internal::gMmallocDesc = nullptr;
 
    ReleaseSemaphore();
@@ -778,42 +785,49 @@ TObject *TMapFile::Get(const char *name, TObject *delObj)
 {
    if (!fMmallocDesc) return 0;
 
-   AcquireSemaphore();
-
    delete delObj;
 
-   TObject *obj = 0;
+   // Only copy the streamed object while holding the semaphore, it is
+   // streamed in after releasing it.
+   std::vector<char> buffer;
+   TString className;
+
+   AcquireSemaphore();
+
    TMapRec *mr = GetFirst();
    while (OrgAddress(mr)) {
       if (!strcmp(mr->GetName(fOffset), name)) {
-         if (!mr->fBufSize) goto release;
-         TClass *cl = TClass::GetClass(mr->GetClassName(fOffset));
-         if (!cl) {
-            Error("Get", "unknown class %s", mr->GetClassName(fOffset));
-            goto release;
+         if (mr->fBufSize) {
+            className = mr->GetClassName(fOffset);
+            const char *buf = (const char *)mr->GetBuffer(fOffset);
+            buffer.assign(buf, buf + mr->fBufSize);
          }
-
-         obj = (TObject *)cl->New();
-         if (!obj) {
-            Error("Get", "cannot create new object of class %s", mr->GetClassName(fOffset));
-            goto release;
-         }
-
-         fGetting = obj;
-         TBufferFile *b = new TBufferFile(TBuffer::kRead, mr->fBufSize, mr->GetBuffer(fOffset));
-         b->MapObject(obj);  //register obj in map to handle self reference
-         obj->Streamer(*b);
-         b->DetachBuffer();
-         delete b;
-         fGetting = 0;
-         goto release;
+         break;
       }
       mr = mr->GetNext(fOffset);
    }
 
-release:
    ReleaseSemaphore();
 
+   if (buffer.empty())
+      return 0;
+
+   TClass *cl = TClass::GetClass(className);
+   if (!cl) {
+      Error("Get", "unknown class %s", className.Data());
+      return 0;
+   }
+
+   TObject *obj = (TObject *)cl->New();
+   if (!obj) {
+      Error("Get", "cannot create new object of class %s", className.Data());
+      return 0;
+   }
+
+   TBufferFile b(TBuffer::kRead, buffer.size(), buffer.data(), kFALSE);
+   b.MapObject(obj);  //register obj in map to handle self reference
+   obj->Streamer(b);
+
    return obj;
 }
 
@@ -152,6 +152,36 @@ TMemFile::TMemFile(const char *name, std::unique_ptr<TBufferFile> buffer)
    buffer.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor to create a read-only TMemFile adopting the memory blocks of
+/// another TMemFile, see DetachContent(). The blocks are left empty.
+
+TMemFile::TMemFile(const char *path, TMemBlock &blocks, Long64_t size)
+   : TFile(path, "WEB", "read-only TMemFile", 0 /*compress*/), fIsOwnedByROOT(kTRUE), fSize(size),
+     fBlockSeek(&(fBlockList))
+{
+   fBlockList.fBuffer = blocks.fBuffer;
+   fBlockList.fSize = blocks.fSize;
+   fBlockList.fNext = blocks.fNext;
+   if (fBlockList.fNext)
+      fBlockList.fNext->fPrevious = &fBlockList;
+   blocks.fBuffer = nullptr;
+   blocks.fSize = 0;
+   blocks.fNext = nullptr;
+
+   fD = 0;
+   fOption = "READ";
+   fWritable = kFALSE;
+
+   if (!fBlockList.fBuffer) {
+      MakeZombie();
+      gDirectory = gROOT;
+      return;
+   }
+
+   Init(/* create */ false);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Usual Constructor.
 /// The defBlockSize parameter defines the size of the blocks of memory allocated
@@ -247,6 +277,35 @@ TMemFile::~TMemFile()
    TRACE("destroy")
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Move the content of this file into a new read-only TMemFile, without
+/// copying it, and start again with an empty memory block.
+///
+/// The file must be written (e.g. with Write()) before, and ResetAfterMerge()
+/// must be called after, as for CopyTo(). The new file is not registered in
+/// the list of files of gROOT and does not change gDirectory.
+
+std::unique_ptr<TMemFile> TMemFile::DetachContent()
+{
+   if (IsExternalData() || !fBlockList.fBuffer)
+      return nullptr;
+
+   std::unique_ptr<TMemFile> content;
+   {
+      TDirectory::TContext ctxt;
+      content.reset(new TMemFile(GetEndpointUrl()->GetUrl(), fBlockList, fSize));
+      R__LOCKGUARD(gROOTMutex);
+      gROOT->GetListOfFiles()->Remove(content.get());
+   }
+
+   fSize = 0;
+   SysOpen(GetName(), O_RDWR | O_CREAT, 0644);
+   fSysOffset = 0;
+   fBlockSeek = &fBlockList;
+   fBlockOffset = 0;
+   return content;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy the binary representation of the TMemFile into
 /// the memory area starting at 'to' and of length at most 'maxsize'
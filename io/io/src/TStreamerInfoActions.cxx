@@ -24,6 +24,10 @@
 #include "TVirtualCollectionIterators.h"
 #include "TProcessID.h"
 #include "TFile.h"
+#include "TGenCollectionProxy.h"
+
+#include <algorithm>
+#include <typeinfo>
 
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
@@ -1711,6 +1715,43 @@ namespace TStreamerInfoActions
       }
    }
 
+   /// Number of values of a data member of consecutive objects read or written with one call to the buffer.
+   static const Int_t kBulkChunkSize = 256;
+
+   /// Return true if the values of a data member of consecutive objects can be streamed as one array, i.e. if the
+   /// buffer is a TBufferFile itself: the text buffers add markup to each value and TBufferSQL maps them to columns.
+   static INLINE_TEMPLATE_ARGS bool CanStreamBulk(const TBuffer &buf)
+   {
+      return typeid(buf) == typeid(TBufferFile);
+   }
+
+   /// Read the values of a data member of `nobjects` objects, `addressOf(i)` being the address of the member of the
+   /// i-th object, with one virtual ReadFastArray() per chunk of values instead of one `operator>>` per value.
+   template <typename T, typename AddressOf>
+   static INLINE_TEMPLATE_ARGS void ReadColumn(TBuffer &buf, Long_t nobjects, const AddressOf &addressOf)
+   {
+      T values[kBulkChunkSize];
+      for (Long_t first = 0; first < nobjects; first += kBulkChunkSize) {
+         const Int_t n = std::min<Long_t>(kBulkChunkSize, nobjects - first);
+         buf.ReadFastArray(values, n);
+         for (Int_t i = 0; i < n; ++i)
+            *addressOf(first + i) = values[i];
+      }
+   }
+
+   /// Write the values of a data member of `nobjects` objects, see ReadColumn().
+   template <typename T, typename AddressOf>
+   static INLINE_TEMPLATE_ARGS void WriteColumn(TBuffer &buf, Long_t nobjects, const AddressOf &addressOf)
+   {
+      T values[kBulkChunkSize];
+      for (Long_t first = 0; first < nobjects; first += kBulkChunkSize) {
+         const Int_t n = std::min<Long_t>(kBulkChunkSize, nobjects - first);
+         for (Int_t i = 0; i < n; ++i)
+            values[i] = *addressOf(first + i);
+         buf.WriteFastArray(values, n);
+      }
+   }
+
    struct VectorLooper {
 
       template <typename T>
@@ -1719,6 +1760,11 @@ namespace TStreamerInfoActions
          const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
          iter = (char*)iter + config->fOffset;
          end = (char*)end + config->fOffset;
+         if (CanStreamBulk(buf)) {
+            char *first = (char*)iter;
+            ReadColumn<T>(buf, ((char*)end - first) / incr, [=](Long_t i) { return (T*)(first + i * incr); });
+            return 0;
+         }
          for(; iter != end; iter = (char*)iter + incr ) {
             T *x = (T*) ((char*) iter);
             buf >> *x;
@@ -1807,6 +1853,11 @@ namespace TStreamerInfoActions
          const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
          iter = (char*)iter + config->fOffset;
          end = (char*)end + config->fOffset;
+         if (CanStreamBulk(buf)) {
+            char *first = (char*)iter;
+            WriteColumn<T>(buf, ((char*)end - first) / incr, [=](Long_t i) { return (const T*)(first + i * incr); });
+            return 0;
+         }
          for(; iter != end; iter = (char*)iter + incr ) {
             T *x = (T*) ((char*) iter);
             buf << *x;
@@ -2094,6 +2145,11 @@ namespace TStreamerInfoActions
       {
          const Int_t offset = config->fOffset;
 
+         if (CanStreamBulk(buf)) {
+            void **first = (void**)iter;
+            ReadColumn<T>(buf, (void**)end - first, [=](Long_t i) { return (T*)((char*)first[i] + offset); });
+            return 0;
+         }
          for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
             T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
             buf >> *x;
@@ -2177,6 +2233,11 @@ namespace TStreamerInfoActions
       {
          const Int_t offset = config->fOffset;
 
+         if (CanStreamBulk(buf)) {
+            void **first = (void**)iter;
+            WriteColumn<T>(buf, (void**)end - first, [=](Long_t i) { return (const T*)((char*)first[i] + offset); });
+            return 0;
+         }
          for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
             T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
             buf << *x;
@@ -3904,6 +3965,22 @@ void TStreamerInfo::AddWriteMemberWiseVecPtrAction(TStreamerInfoActions::TAction
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the bundle of the actions necessary for the streaming memberwise of the content described by 'info' into the
+/// collection described by 'collectionProxy'. The sequence is cached by the proxy when it is a TGenCollectionProxy,
+/// and only created (and then owned by the caller) otherwise.
+
+TStreamerInfoActions::TActionSequence::SequencePtr
+TStreamerInfoActions::TActionSequence::ReadMemberWiseActionsCollectionCreator(TStreamerInfo *info,
+                                                                              TVirtualCollectionProxy *collectionProxy,
+                                                                              TClass * /* originalClass */)
+{
+   if (auto genProxy = dynamic_cast<TGenCollectionProxy *>(collectionProxy))
+      return {genProxy->GetInfoReadMemberWiseActions(info), kFALSE};
+   auto seq = TStreamerInfoActions::TActionSequence::CreateReadMemberWiseActions(info, *collectionProxy);
+   return {seq, kTRUE};
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create the bundle of the actions necessary for the streaming memberwise of the content described by 'info' into the collection described by 'proxy'
 
@@ -0,0 +1,91 @@
+#include "ROOT/RByteSwap.hxx"
+#include "TBufferFile.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using SwapFunc_t = void (*)(void *, const void *, std::size_t);
+
+void CheckSwap(SwapFunc_t swap, std::size_t wordSize)
+{
+   for (std::size_t n = 0; n < 100; ++n) {
+      // unaligned source and target, guard bytes around the target
+      std::vector<unsigned char> from(n * wordSize + 2), to(n * wordSize + 2, 0xee);
+      for (std::size_t i = 0; i < from.size(); ++i)
+         from[i] = (unsigned char)(7 * i + 1);
+      swap(to.data() + 1, from.data() + 1, n);
+      for (std::size_t w = 0; w < n; ++w) {
+         for (std::size_t b = 0; b < wordSize; ++b)
+            ASSERT_EQ(to[1 + w * wordSize + b], from[1 + w * wordSize + wordSize - 1 - b])
+               << "word size " << wordSize << ", " << n << " words, kernel " << ROOT::Internal::GetByteSwapKernelName();
+      }
+      EXPECT_EQ(to[0], 0xee);
+      EXPECT_EQ(to[1 + n * wordSize], 0xee);
+   }
+}
+
+} // anonymous namespace
+
+TEST(RByteSwap, Kernels)
+{
+   CheckSwap(ROOT::Internal::ByteSwapCopy16, 2);
+   CheckSwap(ROOT::Internal::ByteSwapCopy32, 4);
+   CheckSwap(ROOT::Internal::ByteSwapCopy64, 8);
+}
+
+TEST(RByteSwap, BufferFileArrays)
+{
+   const Int_t n = 1001; // several chunks of the Double32_t conversion, odd number of values
+   std::vector<Short_t> shorts(n);
+   std::vector<Int_t> ints(n);
+   std::vector<Long64_t> longs(n);
+   std::vector<Float_t> floats(n);
+   std::vector<Double_t> doubles(n);
+   for (Int_t i = 0; i < n; ++i) {
+      shorts[i] = Short_t(i * 31 - 7000);
+      ints[i] = i * 1000003 - 12345;
+      longs[i] = (Long64_t(i) << 40) - i;
+      floats[i] = 0.5f * i - 100.f;
+      doubles[i] = 0.25 * i - 1e6;
+   }
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   wbuf.WriteFastArray(shorts.data(), n);
+   wbuf.WriteFastArray(ints.data(), n);
+   wbuf.WriteFastArray(longs.data(), n);
+   wbuf.WriteFastArray(floats.data(), n);
+   wbuf.WriteFastArray(doubles.data(), n);
+   wbuf.WriteFastArrayDouble32(doubles.data(), n);
+
+   // the values are big-endian in the buffer
+   const unsigned char *intBytes = reinterpret_cast<const unsigned char *>(wbuf.Buffer()) + n * sizeof(Short_t);
+   const UInt_t second = UInt_t(ints[1]);
+   EXPECT_EQ(intBytes[4], (second >> 24) & 0xff);
+   EXPECT_EQ(intBytes[7], second & 0xff);
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   std::vector<Short_t> rshorts(n);
+   std::vector<Int_t> rints(n);
+   std::vector<Long64_t> rlongs(n);
+   std::vector<Float_t> rfloats(n);
+   std::vector<Double_t> rdoubles(n), rdoubles32(n);
+   rbuf.ReadFastArray(rshorts.data(), n);
+   rbuf.ReadFastArray(rints.data(), n);
+   rbuf.ReadFastArray(rlongs.data(), n);
+   rbuf.ReadFastArray(rfloats.data(), n);
+   rbuf.ReadFastArray(rdoubles.data(), n);
+   rbuf.ReadFastArrayDouble32(rdoubles32.data(), n);
+   EXPECT_EQ(rbuf.Length(), wbuf.Length());
+
+   EXPECT_EQ(rshorts, shorts);
+   EXPECT_EQ(rints, ints);
+   EXPECT_EQ(rlongs, longs);
+   EXPECT_EQ(rfloats, floats);
+   EXPECT_EQ(rdoubles, doubles);
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_EQ(rdoubles32[i], Double_t(Float_t(doubles[i])));
+}
@@ -43,6 +43,37 @@ TEST(RRawFileUnix, ReadV)
    }
 }
 
+TEST(RRawFileUnix, ReadVRepeated)
+{
+   auto file = "test_uring_readv_repeated";
+   FileRaii fileGuard(file, "abcdefghijklmnopqrstuvwxyz");
+   auto f = RRawFileUnix::Create(file);
+
+   // Subsequent calls reuse the thread's ring
+   for (int round = 0; round < 3; ++round) {
+      char buffers[3][8];
+      RIOVec iovecs[3];
+      iovecs[0].fBuffer = buffers[0];
+      iovecs[0].fOffset = 0;
+      iovecs[0].fSize = 3;
+      iovecs[1].fBuffer = buffers[1];
+      iovecs[1].fOffset = 10 + round;
+      iovecs[1].fSize = 2;
+      // Read across the end of file
+      iovecs[2].fBuffer = buffers[2];
+      iovecs[2].fOffset = 22;
+      iovecs[2].fSize = 8;
+      f->ReadV(iovecs, 3);
+
+      EXPECT_EQ(3u, iovecs[0].fOutBytes);
+      EXPECT_EQ(std::string("abc"), std::string(buffers[0], 3));
+      EXPECT_EQ(2u, iovecs[1].fOutBytes);
+      EXPECT_EQ(std::string(1, 'k' + round) + std::string(1, 'l' + round), std::string(buffers[1], 2));
+      EXPECT_EQ(4u, iovecs[2].fOutBytes);
+      EXPECT_EQ(std::string("wxyz"), std::string(buffers[2], 4));
+   }
+}
+
 TEST(RawUring, NopRoundTrip)
 {
    struct io_uring ring;
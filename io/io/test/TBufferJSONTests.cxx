@@ -1,5 +1,7 @@
 #include "TBufferJSON.h"
 #include "TNamed.h"
+#include <cmath>
+#include <cstdio>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -47,3 +49,34 @@ TEST(TBufferJSON, utf8_3)
    EXPECT_EQ(str0, named1->GetTitle());
 }
 
+
+// check that numbers are formatted as with printf
+TEST(TBufferJSON, NumberFormat)
+{
+   char buf[100], ref[100];
+
+   for (Long64_t v : {0ll, 1ll, -1ll, 9ll, 10ll, -99ll, 100ll, 12345ll, -1234567890123ll, 9223372036854775807ll,
+                      -9223372036854775807ll - 1}) {
+      snprintf(ref, sizeof(ref), "%lld", v);
+      EXPECT_STREQ(ref, TBufferText::ConvertLong64(v, buf, sizeof(buf)));
+   }
+
+   for (ULong64_t v : {0ull, 7ull, 42ull, 1000ull, 18446744073709551615ull}) {
+      snprintf(ref, sizeof(ref), "%llu", v);
+      EXPECT_STREQ(ref, TBufferText::ConvertULong64(v, buf, sizeof(buf)));
+   }
+
+   // output is truncated like with snprintf
+   EXPECT_STREQ("-12", TBufferText::ConvertLong64(-12345, buf, 4));
+
+   for (Double_t v : {0., -0., 1., -3., 1e10, -123456789012., 1e17, 5e18, 1e24, 0.5, -2.25, 1.1e-10}) {
+      snprintf(ref, sizeof(ref), (v == std::nearbyint(v)) ? "%1.0f" : "%.14e", v);
+      if (v != std::nearbyint(v))
+         TBufferText::CompactFloatString(ref, sizeof(ref));
+      EXPECT_STREQ(ref, TBufferText::ConvertDouble(v, buf, sizeof(buf)));
+      snprintf(ref, sizeof(ref), (v == std::nearbyint(v)) && (std::abs(v) < 1e15) ? "%1.0f" : "%e", (Float_t)v);
+      if (!((v == std::nearbyint(v)) && (std::abs(v) < 1e15)))
+         TBufferText::CompactFloatString(ref, sizeof(ref));
+      EXPECT_STREQ(ref, TBufferText::ConvertFloat(v, buf, sizeof(buf)));
+   }
+}
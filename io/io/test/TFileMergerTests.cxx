@@ -2,9 +2,15 @@
 
 #include "TFileMerger.h"
 
+#include "TFile.h"
+#include "TH1F.h"
 #include "TMemFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
 #include "TTree.h"
 
+#include <string>
+
 static void CreateATuple(TMemFile &file, const char *name, double value)
 {
    auto mytree = new TTree(name, "A tree");
@@ -68,3 +74,102 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    ROOT_EXPECT_ERROR(merger.OutputFile(std::move(output)), "TFileMerger::OutputFile",
                      "output file output.root is not writable");
 }
+
+#ifdef R__USE_IMT
+// With IMT, the histograms are merged by several threads; the result is the same
+TEST(TFileMerger, ParallelHistogramMerge)
+{
+   const int nFiles = 5;
+   const int nHistos = 50;
+   for (int f = 0; f < nFiles; ++f) {
+      TFile file(("ParallelHistogramMerge_" + std::to_string(f) + ".root").c_str(), "RECREATE");
+      auto dir = file.mkdir("dir");
+      for (int h = 0; h < nHistos; ++h) {
+         TH1F histo(("h" + std::to_string(h)).c_str(), "", 10, 0, 10);
+         histo.Fill(h % 10, f + 1);
+         file.WriteTObject(&histo);
+         dir->WriteTObject(&histo);
+      }
+      // only the last file has this one
+      if (f == nFiles - 1) {
+         TH1F extra("extra", "", 10, 0, 10);
+         extra.Fill(1);
+         file.WriteTObject(&extra);
+      }
+   }
+
+   ROOT::EnableImplicitMT(3);
+   {
+      TFileMerger merger(kFALSE, kFALSE);
+      ASSERT_TRUE(merger.OutputFile("ParallelHistogramMerge.root", "RECREATE"));
+      for (int f = 0; f < nFiles; ++f)
+         merger.AddFile(("ParallelHistogramMerge_" + std::to_string(f) + ".root").c_str());
+      EXPECT_TRUE(merger.Merge());
+   }
+   ROOT::DisableImplicitMT();
+
+   TFile output("ParallelHistogramMerge.root");
+   for (const char *dirname : {"", "dir/"}) {
+      for (int h = 0; h < nHistos; ++h) {
+         auto histo = output.Get<TH1F>((dirname + ("h" + std::to_string(h))).c_str());
+         ASSERT_NE(histo, nullptr);
+         EXPECT_EQ(histo->GetEntries(), nFiles);
+         EXPECT_DOUBLE_EQ(histo->GetBinContent(histo->FindBin(h % 10)), nFiles * (nFiles + 1) / 2);
+      }
+   }
+   auto extra = output.Get<TH1F>("extra");
+   ASSERT_NE(extra, nullptr);
+   EXPECT_EQ(extra->GetEntries(), 1);
+
+   for (int f = 0; f < nFiles; ++f)
+      gSystem->Unlink(("ParallelHistogramMerge_" + std::to_string(f) + ".root").c_str());
+   gSystem->Unlink("ParallelHistogramMerge.root");
+}
+#endif
+
+TEST(TFileMerger, StreamingMerge)
+{
+   const int nFiles = 7;
+   const int nHistos = 20;
+   for (int f = 0; f < nFiles; ++f) {
+      TFile file(("StreamingMerge_" + std::to_string(f) + ".root").c_str(), "RECREATE");
+      auto dir = file.mkdir("dir");
+      for (int h = 0; h < nHistos; ++h) {
+         TH1F histo(("h" + std::to_string(h)).c_str(), "", 10, 0, 10);
+         histo.Fill(h % 10, f + 1);
+         dir->WriteTObject(&histo);
+      }
+      double value = f;
+      TTree tree("tree", "A tree");
+      tree.SetImplicitMT(false);
+      tree.Branch("value", &value);
+      tree.Fill();
+      tree.Write();
+   }
+
+   {
+      TFileMerger merger(kFALSE, kFALSE);
+      // groups of two files: the inputs go through two levels of temporary files
+      merger.SetMaxOpenedFiles(3);
+      merger.SetStreaming();
+      ASSERT_TRUE(merger.OutputFile("StreamingMerge.root", "RECREATE"));
+      for (int f = 0; f < nFiles; ++f)
+         merger.AddFile(("StreamingMerge_" + std::to_string(f) + ".root").c_str());
+      EXPECT_TRUE(merger.Merge());
+   }
+
+   TFile output("StreamingMerge.root");
+   for (int h = 0; h < nHistos; ++h) {
+      auto histo = output.Get<TH1F>(("dir/h" + std::to_string(h)).c_str());
+      ASSERT_NE(histo, nullptr);
+      EXPECT_EQ(histo->GetEntries(), nFiles);
+      EXPECT_DOUBLE_EQ(histo->GetBinContent(histo->FindBin(h % 10)), nFiles * (nFiles + 1) / 2);
+   }
+   auto tree = output.Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   EXPECT_EQ(tree->GetEntries(), nFiles);
+
+   for (int f = 0; f < nFiles; ++f)
+      gSystem->Unlink(("StreamingMerge_" + std::to_string(f) + ".root").c_str());
+   gSystem->Unlink("StreamingMerge.root");
+}
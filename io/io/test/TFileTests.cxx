@@ -1,7 +1,21 @@
+#include "ROOT/RConfig.hxx"
+#include "RZip.h"
+#include "TEnv.h"
 #include "TFile.h"
+#include "TFileCacheWrite.h"
+#include "TKey.h"
+#include "TNamed.h"
+#include "TROOT.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
 // Tests ROOT-9857
 TEST(TFile, ReadFromSameFile)
 {
@@ -21,4 +35,238 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+static std::atomic<int> gNDeflateOffloads{0};
+static std::atomic<int> gNInflateOffloads{0};
+
+// An offload that cannot handle any buffer: zlib takes over
+static int DeclineDeflate(int, const char *, int, char *, int)
+{
+   ++gNDeflateOffloads;
+   return 0;
+}
+
+static int DeclineInflate(const char *, int, char *, int)
+{
+   ++gNInflateOffloads;
+   return 0;
+}
+
+TEST(TFile, ZLIBOffloadFallback)
+{
+   const auto filename = "ZLIBOffloadFallback.root";
+   std::vector<double> v(10000);
+   for (std::size_t i = 0; i < v.size(); ++i)
+      v[i] = i % 100;
+
+   R__SetZLIBOffload(DeclineDeflate, DeclineInflate);
+   {
+      TFile f(filename, "RECREATE", "", 101);
+      f.WriteObject(&v, "v");
+   }
+   EXPECT_GT(gNDeflateOffloads, 0);
+   {
+      TFile f(filename);
+      std::unique_ptr<std::vector<double>> read(f.Get<std::vector<double>>("v"));
+      ASSERT_NE(read, nullptr);
+      EXPECT_EQ(*read, v);
+   }
+   EXPECT_GT(gNInflateOffloads, 0);
+   R__SetZLIBOffload(nullptr, nullptr);
+   gSystem->Unlink(filename);
+}
+
+#ifdef R__USE_IMT
+// Large objects are compressed and decompressed as several blocks in parallel
+TEST(TFile, ParallelCompressionOfLargeKey)
+{
+   const auto filename = "ParallelCompressionOfLargeKey.root";
+   std::vector<double> v(2000000);
+   for (std::size_t i = 0; i < v.size(); ++i)
+      v[i] = i % 1000;
+
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(filename, "RECREATE", "", 505);
+      f.WriteObject(&v, "v");
+      auto key = f.GetKey("v");
+      ASSERT_NE(key, nullptr);
+      EXPECT_LT(key->GetNbytes(), key->GetObjlen());
+   }
+   {
+      TFile f(filename);
+      std::unique_ptr<std::vector<double>> read(f.Get<std::vector<double>>("v"));
+      ASSERT_NE(read, nullptr);
+      EXPECT_EQ(*read, v);
+   }
+   ROOT::DisableImplicitMT();
+   {
+      // the blocks can also be read serially
+      TFile f(filename);
+      std::unique_ptr<std::vector<double>> read(f.Get<std::vector<double>>("v"));
+      ASSERT_NE(read, nullptr);
+      EXPECT_EQ(*read, v);
+   }
+   gSystem->Unlink(filename);
+}
+#endif
+
+// Scattered blocks of a local file are read with vectored I/O
+TEST(TFile, ReadBuffersLocal)
+{
+   const auto filename = "ReadBuffersLocal.root";
+   std::vector<char> content(1024 * 1024);
+   for (std::size_t i = 0; i < content.size(); ++i)
+      content[i] = i % 251;
+   {
+      FILE *fp = fopen(filename, "wb");
+      ASSERT_NE(fp, nullptr);
+      fwrite(content.data(), 1, content.size(), fp);
+      fclose(fp);
+   }
+
+   // contiguous blocks, small and large gaps, and a block before the previous one
+   std::vector<Long64_t> pos{0, 100, 150, 1000, 300000, 300010, 500000, 20};
+   std::vector<Int_t> len{100, 50, 10, 2000, 10, 100000, 1000, 30};
+   Int_t total = 0;
+   for (auto l : len)
+      total += l;
+
+   TFile f((std::string(filename) + "?filetype=raw").c_str());
+   ASSERT_FALSE(f.IsZombie());
+   std::vector<char> buf(total);
+   const auto bytesRead = f.GetBytesRead();
+   ASSERT_FALSE(f.ReadBuffers(buf.data(), pos.data(), len.data(), pos.size()));
+   EXPECT_EQ(f.GetBytesRead() - bytesRead, total);
+   Int_t k = 0;
+   for (std::size_t i = 0; i < pos.size(); ++i) {
+      EXPECT_EQ(0, memcmp(&buf[k], &content[pos[i]], len[i])) << "block " << i;
+      k += len[i];
+   }
+
+   // reading past the end of the file fails
+   Long64_t pastEnd = content.size() - 10;
+   Int_t pastLen = 100;
+   EXPECT_TRUE(f.ReadBuffers(buf.data(), &pastEnd, &pastLen, 1));
+   gSystem->Unlink(filename);
+}
+
+// The write cache writes its full buffers in the background
+TEST(TFile, WriteBehindCache)
+{
+   const auto filename = "WriteBehindCache.root";
+   const int nObjects = 50;
+   {
+      TFile f(filename, "RECREATE");
+      auto cache = new TFileCacheWrite(&f, 100000);
+      ASSERT_TRUE(cache->SetWriteBehind());
+      for (int i = 0; i < nObjects; ++i) {
+         std::vector<int> v(1000 * (i % 7 + 1), i);
+         f.WriteObject(&v, ("v" + std::to_string(i)).c_str());
+      }
+      // the objects are readable before the file is closed, from the cache or from the file
+      std::unique_ptr<std::vector<int>> read(f.Get<std::vector<int>>("v5"));
+      ASSERT_NE(read, nullptr);
+      EXPECT_EQ(read->size(), 6000u);
+      EXPECT_EQ(read->at(0), 5);
+   }
+   TFile f(filename);
+   for (int i = 0; i < nObjects; ++i) {
+      std::unique_ptr<std::vector<int>> read(f.Get<std::vector<int>>(("v" + std::to_string(i)).c_str()));
+      ASSERT_NE(read, nullptr);
+      EXPECT_EQ(read->size(), 1000u * (i % 7 + 1));
+      EXPECT_EQ(read->back(), i);
+   }
+   gSystem->Unlink(filename);
+}
+
+// Large directories are written with a sorted index of their keys, used for the lookups in read-only files
+TEST(TFile, KeyIndex)
+{
+   const auto indexedName = "KeyIndex.root";
+   const auto plainName = "KeyIndexPlain.root";
+   const auto minKeys = gEnv->GetValue("TFile.KeyIndexMinKeys", 1000);
+   const int nObjects = 1500;
+   for (auto filename : {indexedName, plainName}) {
+      gEnv->SetValue("TFile.KeyIndexMinKeys", filename == indexedName ? 1000 : 0);
+      TFile f(filename, "RECREATE");
+      for (int i = nObjects - 1; i >= 0; --i) {
+         TNamed obj(("obj" + std::to_string(i)).c_str(), std::to_string(i).c_str());
+         obj.Write();
+      }
+      for (int cycle = 1; cycle <= 3; ++cycle) {
+         TNamed obj("dup", std::to_string(cycle).c_str());
+         obj.Write();
+      }
+      TNamed inner("inner", "inner");
+      f.mkdir("sub")->WriteObject(&inner, "inner");
+   }
+   gEnv->SetValue("TFile.KeyIndexMinKeys", minKeys);
+
+   TFile indexed(indexedName);
+   TFile plain(plainName);
+   for (TFile *f : {&indexed, &plain}) {
+      EXPECT_EQ(f->GetNkeys(), nObjects + 4);
+      std::unique_ptr<TNamed> obj(f->Get<TNamed>("obj1234"));
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), "1234");
+      EXPECT_EQ(f->Get("obj1500"), nullptr);
+      EXPECT_EQ(f->Get("ob"), nullptr);
+
+      std::unique_ptr<TNamed> dup(f->Get<TNamed>("dup"));
+      ASSERT_NE(dup, nullptr);
+      EXPECT_STREQ(dup->GetTitle(), "3");
+      std::unique_ptr<TNamed> dup1(f->Get<TNamed>("dup;1"));
+      ASSERT_NE(dup1, nullptr);
+      EXPECT_STREQ(dup1->GetTitle(), "1");
+      ASSERT_NE(f->FindKey("dup;2"), nullptr);
+      EXPECT_EQ(f->FindKey("dup;2")->GetCycle(), 2);
+      EXPECT_EQ(f->GetKey("dup")->GetCycle(), 3);
+
+      std::unique_ptr<TNamed> inner(f->Get<TNamed>("sub/inner"));
+      ASSERT_NE(inner, nullptr);
+   }
+
+   // all the keys are created in the order of the list of keys, including the ones looked up already
+   std::vector<std::string> indexedKeys, plainKeys;
+   for (auto key : TRangeDynCast<TKey>(indexed.GetListOfKeys()))
+      indexedKeys.emplace_back(std::string(key->GetName()) + ";" + std::to_string(key->GetCycle()));
+   for (auto key : TRangeDynCast<TKey>(plain.GetListOfKeys()))
+      plainKeys.emplace_back(std::string(key->GetName()) + ";" + std::to_string(key->GetCycle()));
+   EXPECT_EQ(indexedKeys, plainKeys);
+   EXPECT_EQ(indexed.GetNkeys(), nObjects + 4);
+
+   gSystem->Unlink(indexedName);
+   gSystem->Unlink(plainName);
+}
+
+TEST(TFile, OpenAsync)
+{
+   const int nFiles = 4;
+   std::vector<std::string> names;
+   for (int i = 0; i < nFiles; ++i) {
+      names.emplace_back("TFileOpenAsync_" + std::to_string(i) + ".root");
+      TFile f(names.back().c_str(), "RECREATE");
+      TNamed obj("obj", std::to_string(i).c_str());
+      f.WriteObject(&obj, "obj");
+   }
+
+   TDirectory *current = gDirectory;
+   std::vector<std::future<std::unique_ptr<TFile>>> futures;
+   for (auto &name : names)
+      futures.emplace_back(TFile::OpenAsync(name.c_str()));
+   auto missing = TFile::OpenAsync("TFileOpenAsync_missing.root");
+
+   for (int i = 0; i < nFiles; ++i) {
+      auto file = futures[i].get();
+      ASSERT_NE(file, nullptr);
+      std::unique_ptr<TNamed> obj(file->Get<TNamed>("obj"));
+      ASSERT_NE(obj, nullptr);
+      EXPECT_STREQ(obj->GetTitle(), std::to_string(i).c_str());
+   }
+   EXPECT_EQ(missing.get(), nullptr);
+   EXPECT_EQ(gDirectory, current);
+
+   for (auto &name : names)
+      gSystem->Unlink(name.c_str());
+}
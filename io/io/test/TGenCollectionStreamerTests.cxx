@@ -0,0 +1,54 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename T>
+void RoundTrip(const char *className, const T &in, T &out)
+{
+   TClass *cl = TClass::GetClass(className);
+   ASSERT_NE(nullptr, cl);
+
+   TBufferFile buf(TBuffer::kWrite);
+   cl->Streamer(const_cast<T *>(&in), buf);
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   cl->Streamer(&out, buf);
+}
+
+} // anonymous namespace
+
+TEST(TGenCollectionStreamer, VectorOfVectorOfFloat)
+{
+   std::vector<std::vector<float>> in{{1.f, 2.f, 3.f}, {}, {4.5f}, std::vector<float>(1000, 0.25f)};
+   // the content of the target is replaced
+   std::vector<std::vector<float>> out{{7.f}, {8.f}, {9.f}, {1.f}, {2.f}, {3.f}};
+   RoundTrip("vector<vector<float> >", in, out);
+   EXPECT_EQ(in, out);
+
+   std::vector<std::vector<float>> empty;
+   RoundTrip("vector<vector<float> >", empty, out);
+   EXPECT_TRUE(out.empty());
+}
+
+TEST(TGenCollectionStreamer, VectorOfVectorOfInt)
+{
+   std::vector<std::vector<int>> in{{1, -2}, {3}, {}, {4, 5, 6, 7}};
+   std::vector<std::vector<int>> out;
+   RoundTrip("vector<vector<int> >", in, out);
+   EXPECT_EQ(in, out);
+}
+
+TEST(TGenCollectionStreamer, VectorOfVectorOfDouble32)
+{
+   // Double32_t is stored as float, it must not be read as double
+   std::vector<std::vector<double>> in{{1.5, 2.25}, {}, {3.125}};
+   std::vector<std::vector<double>> out;
+   RoundTrip("vector<vector<Double32_t> >", in, out);
+   EXPECT_EQ(in, out);
+}
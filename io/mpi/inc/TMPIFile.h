@@ -26,10 +26,14 @@
 // be communicated over MPI to a master writer which combines the data  //
 // before writing it to file.                                           //
 //                                                                      //
+// Alternatively, WriteCollective() lets all ranks write their data     //
+// together into a single ZIP archive with MPI-IO, without collectors.  //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include "TMPIClientInfo.h"
 #include "TBits.h"
+#include "TDatime.h"
 #include "TFileMerger.h"
 #include "TMemFile.h"
 
@@ -56,6 +60,18 @@ private:
 
    char *fSendBuf = 0; // message buffer, only used by worker
 
+   struct ArchiveEntry {
+      Long64_t fOffset; // position of the local header of the member
+      Long64_t fSize;   // size of the member data
+      UInt_t fCRC32;    // checksum of the member data
+      Int_t fRank;      // global rank which wrote the member
+      Int_t fCall;      // WriteCollective() call which wrote the member
+   };
+
+   std::vector<ArchiveEntry> fArchiveDir; // members of the collective archive, only used by rank 0
+   Long64_t fArchiveEnd = 0;              // end of the member data in the collective archive
+   Int_t fArchiveCalls = 0;               // number of WriteCollective() calls
+
    struct ParallelFileMerger : public TObject {
    private:
       using ClientColl_t = std::vector<TMPIClientInfo>;
@@ -90,6 +106,9 @@ private:
    void SplitMPIComm();
    void UpdateEndProcess();
 
+   TString GetArchiveMemberName(Int_t rank, Int_t call) const;
+   Bool_t WriteArchiveDirectory(MPI_File fh, const TDatime &date);
+
    Bool_t IsReceived();
 
 public:
@@ -108,6 +127,7 @@ public:
    Int_t GetSplitLevel() const { return fSplitLevel; };
 
    TString GetMPIFilename() const { return fMPIFilename; };
+   TString GetArchiveName() const;
 
    // Collector Functions
    void RunCollector(Bool_t cache = kFALSE);
@@ -119,6 +139,9 @@ public:
    void CreateEmptyBufferAndSend();
    void Sync();
 
+   // Collective writing, called by all ranks
+   Bool_t WriteCollective();
+
    // Finalize work and save output in disk.
    void Close(Option_t *option = "") final;
 
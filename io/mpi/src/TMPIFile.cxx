@@ -14,6 +14,8 @@
 #include "TKey.h"
 #include "THashTable.h"
 #include "TMath.h"
+#include "TSystem.h"
+#include "RZip.h"
 
 ClassImp(TMPIFile);
 
@@ -44,6 +46,24 @@ Begin_Macro (source)
 }
 End_Macro
 
+### Collective writing
+
+On large allocations the collectors, which merge and write the data of
+all their workers serially, become the bottleneck. Instead of Sync() and
+RunCollector(), all ranks can call WriteCollective(), which writes the
+current content of every rank into a single archive with MPI-IO:
+
+~~~ {.cpp}
+   TMPIFile *newfile = new TMPIFile("mpi_output.root", "RECREATE");
+   // generate data objects on every rank
+   newfile->WriteCollective();
+   newfile->Close();
+~~~
+
+The archive "mpi_output.zip" contains one ROOT file per rank and call
+of WriteCollective(), named "mpi_output_<rank>_<call>.root", which can be
+opened as "mpi_output.zip#mpi_output_3_0.root" or chained with TChain.
+
 See TMPIFile class for the list of functions
 */
 
@@ -440,6 +460,233 @@ void TMPIFile::Sync()
    this->ResetAfterMerge((TFileMergeInfo *)0);
 }
 
+namespace {
+
+// ZIP format constants, see TZIPFile
+const UInt_t kZipVersion = 45; // version supporting the Zip64 extensions
+const Int_t kEntryHeaderSize = 30;
+const Int_t kEntryExtraSize = 20;
+const Int_t kDirHeaderSize = 46;
+const Int_t kDirExtraSize = 32;
+const Int_t kZip64EndRecordSize = 56;
+const Int_t kZip64EndLocatorSize = 20;
+const Int_t kEndHeaderSize = 22;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the nbytes lowest bytes of value in little-endian order at buf and
+/// advance buf.
+
+void PutLE(char *&buf, ULong64_t value, Int_t nbytes)
+{
+   for (Int_t i = 0; i < nbytes; i++) {
+      *buf++ = (char)(value & 0xff);
+      value >>= 8;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the date in MS-DOS format, time in the low and date in the high 16 bits.
+
+UInt_t GetDosDate(const TDatime &date)
+{
+   Int_t year = date.GetYear() < 1980 ? 0 : date.GetYear() - 1980;
+   UInt_t dosdate = (year << 9) | (date.GetMonth() << 5) | date.GetDay();
+   UInt_t dostime = (date.GetHour() << 11) | (date.GetMinute() << 5) | (date.GetSecond() / 2);
+   return (dosdate << 16) | dostime;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the archive written by WriteCollective(): the name of
+/// the file with the ".root" extension replaced by ".zip".
+
+TString TMPIFile::GetArchiveName() const
+{
+   TString name = GetName();
+   if (name.EndsWith(".root"))
+      name.Resize(name.Length() - 5);
+   return name + ".zip";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the archive member written by the given rank in the
+/// given call of WriteCollective().
+
+TString TMPIFile::GetArchiveMemberName(Int_t rank, Int_t call) const
+{
+   TString base = gSystem->BaseName(GetName());
+   if (base.EndsWith(".root"))
+      base.Resize(base.Length() - 5);
+   return TString::Format("%s_%d_%d.root", base.Data(), rank, call);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes the current content of the file of all ranks together into the ZIP
+/// archive GetArchiveName(), with MPI-IO and without collectors.
+///
+/// This is a collective operation, which has to be called by all the ranks
+/// of MPI_COMM_WORLD. Each rank serializes its content like Sync() does and
+/// writes it as the uncompressed member GetArchiveMemberName(rank, call) of
+/// the archive: the objects are already compressed in the member. The
+/// offsets of the members are agreed on with a scan of their sizes, and
+/// the data of all ranks is written with MPI_File_write_at_all(). Only the
+/// directory of the archive is gathered and written by rank 0. Every call
+/// appends new members to the archive, the first one truncates it.
+///
+/// Sync() and RunCollector() must not be used together with this function.
+/// Returns kTRUE on every rank if the archive was successfully written.
+
+Bool_t TMPIFile::WriteCollective()
+{
+   // serialize the content of this rank as an archive entry
+   this->Write();
+   const Long64_t size = this->GetEND();
+   const TString name = GetArchiveMemberName(fMPIGlobalRank, fArchiveCalls);
+   const Int_t headerSize = kEntryHeaderSize + name.Length() + kEntryExtraSize;
+   std::vector<char> entry(headerSize + size);
+   this->CopyTo(entry.data() + headerSize, size);
+   this->ResetAfterMerge((TFileMergeInfo *)0);
+
+   TDatime date;
+   const UInt_t crc = R__crc32(0, (const unsigned char *)entry.data() + headerSize, (UInt_t)size);
+
+   char *buf = entry.data();
+   PutLE(buf, 0x04034b50, 4);          // local header magic
+   PutLE(buf, kZipVersion, 2);         // version needed to extract
+   PutLE(buf, 0, 2);                   // flags
+   PutLE(buf, 0, 2);                   // method: stored
+   PutLE(buf, GetDosDate(date), 4);    // modification time and date
+   PutLE(buf, crc, 4);
+   PutLE(buf, 0xffffffff, 4);          // compressed size, in the Zip64 field
+   PutLE(buf, 0xffffffff, 4);          // uncompressed size, in the Zip64 field
+   PutLE(buf, name.Length(), 2);
+   PutLE(buf, kEntryExtraSize, 2);
+   memcpy(buf, name.Data(), name.Length());
+   buf += name.Length();
+   PutLE(buf, 0x0001, 2);              // Zip64 extended information
+   PutLE(buf, kEntryExtraSize - 4, 2);
+   PutLE(buf, size, 8);
+   PutLE(buf, size, 8);
+
+   // agree on the position of the entries
+   Long64_t entrySize = entry.size();
+   Long64_t offset = 0;
+   Long64_t total = 0;
+   MPI_Exscan(&entrySize, &offset, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+   MPI_Allreduce(&entrySize, &total, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+   if (fMPIGlobalRank == 0)
+      offset = 0;
+   offset += fArchiveEnd;
+
+   // gather the directory information on rank 0
+   Long64_t info[3] = {offset, size, (Long64_t)crc};
+   std::vector<Long64_t> infos(fMPIGlobalRank == 0 ? 3 * fMPIGlobalSize : 0);
+   MPI_Gather(info, 3, MPI_LONG_LONG, infos.data(), 3, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+
+   const TString archive = GetArchiveName();
+   MPI_File fh;
+   Int_t mode = MPI_MODE_WRONLY | MPI_MODE_CREATE;
+   Int_t ok = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(archive.Data()), mode, MPI_INFO_NULL, &fh) ==
+              MPI_SUCCESS;
+   if (!ok) {
+      Error("WriteCollective", "cannot open %s", archive.Data());
+      return kFALSE;
+   }
+   if (fArchiveCalls == 0)
+      MPI_File_set_size(fh, 0);
+
+   ok = MPI_File_write_at_all(fh, offset, entry.data(), (Int_t)entry.size(), MPI_CHAR, MPI_STATUS_IGNORE) ==
+        MPI_SUCCESS;
+   fArchiveEnd += total;
+
+   if (fMPIGlobalRank == 0) {
+      for (Int_t rank = 0; rank < fMPIGlobalSize; rank++)
+         fArchiveDir.push_back({infos[3 * rank], infos[3 * rank + 1], (UInt_t)infos[3 * rank + 2], rank,
+                                fArchiveCalls});
+      ok = WriteArchiveDirectory(fh, date) && ok;
+   }
+   fArchiveCalls++;
+
+   MPI_File_close(&fh);
+   MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+   if (!ok)
+      Error("WriteCollective", "error writing %s", archive.Data());
+   return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by rank 0 only: writes the directory of the collective archive
+/// after the data of the members.
+
+Bool_t TMPIFile::WriteArchiveDirectory(MPI_File fh, const TDatime &date)
+{
+   Long64_t dirSize = 0;
+   for (auto &e : fArchiveDir)
+      dirSize += kDirHeaderSize + GetArchiveMemberName(e.fRank, e.fCall).Length() + kDirExtraSize;
+   const Long64_t nentries = fArchiveDir.size();
+   std::vector<char> dir(dirSize + kZip64EndRecordSize + kZip64EndLocatorSize + kEndHeaderSize);
+
+   char *buf = dir.data();
+   for (auto &e : fArchiveDir) {
+      const TString name = GetArchiveMemberName(e.fRank, e.fCall);
+      PutLE(buf, 0x02014b50, 4);       // directory header magic
+      PutLE(buf, kZipVersion, 2);      // version made by
+      PutLE(buf, kZipVersion, 2);      // version needed to extract
+      PutLE(buf, 0, 2);                // flags
+      PutLE(buf, 0, 2);                // method: stored
+      PutLE(buf, GetDosDate(date), 4); // modification time and date
+      PutLE(buf, e.fCRC32, 4);
+      PutLE(buf, 0xffffffff, 4);       // compressed size, in the Zip64 field
+      PutLE(buf, 0xffffffff, 4);       // uncompressed size, in the Zip64 field
+      PutLE(buf, name.Length(), 2);
+      PutLE(buf, kDirExtraSize, 2);
+      PutLE(buf, 0, 2);                // comment length
+      PutLE(buf, 0, 2);                // disk number
+      PutLE(buf, 0, 2);                // internal attributes
+      PutLE(buf, 0, 4);                // external attributes
+      PutLE(buf, 0xffffffff, 4);       // offset of the local header, in the Zip64 field
+      memcpy(buf, name.Data(), name.Length());
+      buf += name.Length();
+      PutLE(buf, 0x0001, 2);           // Zip64 extended information
+      PutLE(buf, kDirExtraSize - 4, 2);
+      PutLE(buf, e.fSize, 8);
+      PutLE(buf, e.fSize, 8);
+      PutLE(buf, e.fOffset, 8);
+      PutLE(buf, 0, 4);                // disk number
+   }
+
+   // Zip64 end of directory record and locator, followed by the end header
+   PutLE(buf, 0x06064b50, 4);
+   PutLE(buf, kZip64EndRecordSize - 12, 8);
+   PutLE(buf, kZipVersion, 2);
+   PutLE(buf, kZipVersion, 2);
+   PutLE(buf, 0, 4);
+   PutLE(buf, 0, 4);
+   PutLE(buf, nentries, 8);
+   PutLE(buf, nentries, 8);
+   PutLE(buf, dirSize, 8);
+   PutLE(buf, fArchiveEnd, 8);
+
+   PutLE(buf, 0x07064b50, 4);
+   PutLE(buf, 0, 4);
+   PutLE(buf, fArchiveEnd + dirSize, 8);
+   PutLE(buf, 1, 4);
+
+   const ULong64_t nentries16 = TMath::Min(nentries, (Long64_t)0xffff);
+   PutLE(buf, 0x06054b50, 4);
+   PutLE(buf, 0, 2);
+   PutLE(buf, 0, 2);
+   PutLE(buf, nentries16, 2);
+   PutLE(buf, nentries16, 2);
+   PutLE(buf, 0xffffffff, 4);          // directory size, in the Zip64 record
+   PutLE(buf, 0xffffffff, 4);          // directory offset, in the Zip64 record
+   PutLE(buf, 0, 2);                   // comment length
+
+   return MPI_File_write_at(fh, fArchiveEnd, dir.data(), (Int_t)dir.size(), MPI_CHAR, MPI_STATUS_IGNORE) ==
+          MPI_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Closes the file. For Worker ranks, this function will signal to the
 /// Collector that the Worker has exited. It also closes the inherited TMemFile.
@@ -447,8 +694,9 @@ void TMPIFile::Sync()
 void TMPIFile::Close(Option_t *option)
 {
    if (IsOpen()) {
-      // sends empty buffer
-      CreateEmptyBufferAndSend();
+      // sends empty buffer, unless the data was written collectively
+      if (!fArchiveCalls)
+         CreateEmptyBufferAndSend();
       // call parent close function
       TMemFile::Close(option);
       
@@ -26,11 +26,14 @@
   \param -k   Skip corrupt or non-existent files, do not exit
   \param -O   Re-optimize basket size when merging TTree
   \param -v   Explicitly set the verbosity level: 0 request no output, 99 is the default
-  \param -j   Parallelise the execution in multiple processes
+  \param -j   Parallelise the execution in multiple processes; the final merge of the partial
+              files merges the histograms with as many threads
   \param -dbg  Parallelise the execution in multiple processes in debug mode (Does not delete  partial  files  stored
               inside working directory)
   \param -d   Carry out the partial multiprocess execution in the specified directory
   \param -n   Open at most `n` at once (use 0 to request to use the system maximum)
+  \param -s   Streaming merge: when there are more files than can be opened at once, merge
+              them by groups into temporary files instead of accumulating the results in memory
   \param -experimental-io-features `<feature>` Enables the corresponding experimental feature for output trees
   \return hadd returns a status code: 0 if OK, -1 otherwise
 
@@ -80,6 +83,17 @@
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
 
+  By default, when there are more source files than the maximum number of
+  opened files (see -n), the files are merged by groups into the target and
+  all the merged objects stay in memory until the end. With -s, each group is
+  merged into a temporary file, and the temporary files are merged again the
+  same way until they can all be opened at once; the objects are read from
+  the inputs one after the other and each result is written right away, so
+  that the memory used does not grow with the number of files or objects.
+  ```
+      hadd -s -n 500 result.root @list.txt
+  ```
+
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
@@ -117,6 +131,7 @@
 #include "haddCommandLineOptionsHelp.h"
 
 #include "TFileMerger.h"
+#include "TROOT.h"
 #ifndef R__WIN32
 #include "ROOT/TProcessExecutor.hxx"
 #endif
@@ -140,6 +155,7 @@ int main( int argc, char **argv )
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
    Bool_t debug = kFALSE;
+   Bool_t streaming = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
    TString cacheSize;
@@ -166,6 +182,9 @@ int main( int argc, char **argv )
       } else if ( strcmp(argv[a],"-O") == 0 ) {
          reoptimize = kTRUE;
          ++ffirst;
+      } else if ( strcmp(argv[a],"-s") == 0 ) {
+         streaming = kTRUE;
+         ++ffirst;
       } else if (strcmp(argv[a], "-dbg") == 0) {
          debug = kTRUE;
          verbosity = kTRUE;
@@ -464,6 +483,7 @@ int main( int argc, char **argv )
          }
       }
       merger.SetNotrees(noTrees);
+      merger.SetStreaming(streaming);
       merger.SetMergeOptions(cacheSize);
       merger.SetIOFeatures(features);
       Bool_t status;
@@ -530,6 +550,10 @@ int main( int argc, char **argv )
       auto res = p.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
       status = std::accumulate(res.begin(), res.end(), 0U) == partialFiles.size();
       if (status) {
+#ifdef R__USE_IMT
+         // The worker processes are gone, the histograms of the partial files can be merged by threads
+         ROOT::EnableImplicitMT(nProcesses);
+#endif
          status = reductionFunc();
       } else {
          std::cout << "hadd failed at the parallel stage" << std::endl;
@@ -25,6 +25,7 @@ protected:
    Int_t     fNdim;      //number of dimensions
    Int_t     fTotalSize; //total size of the transform
    Int_t    *fN;         //transform sizes in each dimension
+   Int_t     fHowMany;   //number of transforms done by each Transform()
    Int_t     fSign;      //sign of the exponent of the transform (-1 is FFTW_FORWARD and +1 FFTW_BACKWARD)
    TString   fFlags;     //transform flags
 
@@ -34,6 +35,7 @@ public:
    TFFTComplex();
    TFFTComplex(Int_t n, Bool_t inPlace);
    TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace = kFALSE);
+   TFFTComplex(Int_t ndim, Int_t *n, Int_t howmany, Bool_t inPlace);
    virtual ~TFFTComplex();
 
    virtual void       Init(Option_t *flags, Int_t sign, const Int_t* /*kind*/);
@@ -41,6 +43,7 @@ public:
    virtual Int_t     *GetN()    const {return fN;}
    virtual Int_t      GetNdim() const {return fNdim;}
    virtual Int_t      GetSize() const {return fTotalSize;}
+           Int_t      GetHowMany() const {return fHowMany;}
    virtual Option_t  *GetType() const {if (fSign==-1) return "C2CBackward"; else return "C2CForward";}
    virtual Int_t      GetSign() const {return fSign;}
    virtual Option_t  *GetTransformFlag() const {return fFlags;}
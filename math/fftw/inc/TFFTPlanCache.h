@@ -0,0 +1,43 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFFTPlanCache
+#define ROOT_TFFTPlanCache
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TFFTPlanCache                                                        //
+//                                                                      //
+// Process-wide cache of the fftw plans of the TVirtualFFT              //
+// implementations of the FFTW library, with the fftw wisdom and        //
+// threads settings.                                                    //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <functional>
+#include <string>
+
+class TFFTPlanCache {
+public:
+   static std::string MakeKey(const char *type, Int_t ndim, const Int_t *n, Int_t howmany, Bool_t inPlace,
+                              UInt_t flags, Int_t sign = 0, const Int_t *kinds = nullptr);
+   static void *Acquire(const std::string &key, const std::function<void *()> &create);
+   static void Release(void *plan);
+
+   static Int_t GetNPlans();
+   static Int_t GetNThreads();
+   static void SetNThreads(Int_t nthreads);
+   static Bool_t ImportWisdom(const char *filename);
+   static Bool_t ExportWisdom(const char *filename);
+};
+
+#endif
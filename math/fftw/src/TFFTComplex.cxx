@@ -31,6 +31,11 @@
 /// For a transform of the same size, but with different flags or sign, rerun the Init()
 /// function and continue with steps 3)-5)
 ///
+/// The plans are shared through TFFTPlanCache: the objects created for transforms of the
+/// same size, sign, flags and in-place mode reuse the plan of the first one. The
+/// TFFTComplex(ndim, n, howmany, inPlace) constructor computes howmany transforms of
+/// contiguous arrays at once, the data of transform k starting at point k * n[0] * ... * n[ndim-1].
+///
 /// NOTE:
 ///       1. running Init() function will overwrite the input array! Don't set any data
 ///          before running the Init() function
@@ -40,6 +45,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTComplex.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 #include "TComplex.h"
 
@@ -57,6 +63,7 @@ TFFTComplex::TFFTComplex()
    fN    = 0;
    fNdim = 0;
    fTotalSize = 0;
+   fHowMany = 1;
    fSign = 1;
 }
 
@@ -75,6 +82,7 @@ TFFTComplex::TFFTComplex(Int_t n, Bool_t inPlace)
    fN[0] = n;
    fTotalSize = n;
    fNdim = 1;
+   fHowMany = 1;
    fSign = 1;
    fPlan = 0;
 }
@@ -83,10 +91,20 @@ TFFTComplex::TFFTComplex(Int_t n, Bool_t inPlace)
 ///For multidim. transforms
 ///Allocates memory for the input array, and, if inPlace = kFALSE, for the output array
 
-TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
+TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace) : TFFTComplex(ndim, n, 1, inPlace)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///For howmany transforms of the same sizes, done by each Transform()
+///The data of the transforms follow each other in the arrays, GetSize() returns
+///the total number of points of all transforms
+
+TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Int_t howmany, Bool_t inPlace)
 {
    fNdim = ndim;
-   fTotalSize = 1;
+   fHowMany = howmany > 1 ? howmany : 1;
+   fTotalSize = fHowMany;
    fN = new Int_t[fNdim];
    for (Int_t i=0; i<fNdim; i++){
       fN[i] = n[i];
@@ -102,13 +120,12 @@ TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays and gives the plan back to TFFTPlanCache, where it is
+///reused by the next transforms of the same kind
 
 TFFTComplex::~TFFTComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -134,22 +151,27 @@ TFFTComplex::~TFFTComplex()
 /// - "P" (from "patient") - more time spend in finding the optimal way to do the transform
 /// - "EX" (from "exhaustive") - the most optimal way is found
 ///This option should be chosen depending on how many transforms of the same size and
-///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///type are going to be done. Planning is only done once per process, for the first
+///transform of this size and type, the plan is then taken from TFFTPlanCache.
 
 void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 {
    fSign = sign;
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
 
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fOut, sign,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fIn, sign, MapFlag(flags));
+   const UInt_t flag = MapFlag(flags);
+   fftw_complex *in = (fftw_complex*)fIn;
+   fftw_complex *out = fOut ? (fftw_complex*)fOut : in;
+   const std::string key = TFFTPlanCache::MakeKey("C2C", fNdim, fN, fHowMany, !fOut, flag, sign);
+   fPlan = TFFTPlanCache::Acquire(key, [&]() -> void * {
+      if (fHowMany == 1)
+         return fftw_plan_dft(fNdim, fN, in, out, sign, flag);
+      const Int_t dist = fTotalSize / fHowMany;
+      return fftw_plan_many_dft(fNdim, fN, fHowMany, in, nullptr, 1, dist, out, nullptr, 1, dist, sign, flag);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,7 +180,7 @@ void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 void TFFTComplex::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft((fftw_plan)fPlan, (fftw_complex*)fIn, fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn);
    else {
       Error("Transform", "transform not initialised");
       return;
@@ -42,6 +42,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTComplexReal.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 #include "TComplex.h"
 
@@ -108,13 +109,12 @@ TFFTComplexReal::TFFTComplexReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays and gives the plan back to TFFTPlanCache, where it is
+///reused by the next transforms of the same kind
 
 TFFTComplexReal::~TFFTComplexReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -142,21 +142,21 @@ TFFTComplexReal::~TFFTComplexReal()
 /// - "EX" (from "exhaustive") - the most optimal way is found
 ///
 ///This option should be chosen depending on how many transforms of the same size and
-///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///type are going to be done. Planning is only done once per process, for the first
+///transform of this size and type, the plan is then taken from TFFTPlanCache.
 
 void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
 
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN,(fftw_complex*)fIn,(Double_t*)fOut, MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, (Double_t*)fIn, MapFlag(flags));
+   const UInt_t flag = MapFlag(flags);
+   fftw_complex *in = (fftw_complex*)fIn;
+   Double_t *out = fOut ? (Double_t*)fOut : (Double_t*)fIn;
+   const std::string key = TFFTPlanCache::MakeKey("C2R", fNdim, fN, 1, !fOut, flag);
+   fPlan = TFFTPlanCache::Acquire(key, [&]() -> void * { return fftw_plan_dft_c2r(fNdim, fN, in, out, flag); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,7 +165,7 @@ void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*
 void TFFTComplexReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_c2r((fftw_plan)fPlan, (fftw_complex*)fIn, fOut ? (Double_t*)fOut : (Double_t*)fIn);
    else {
       Error("Transform", "transform was not initialized");
       return;
@@ -0,0 +1,270 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TFFTPlanCache
+    \ingroup FFTW
+
+Process-wide cache of the fftw plans used by TFFTComplex, TFFTRealComplex,
+TFFTComplexReal and TFFTReal.
+
+Creating a plan can take much longer than the transform itself, in
+particular with the "M", "P" and "EX" flags. The transform objects now get
+their plan from this cache, keyed by the type, sizes, direction or kinds,
+flags and in-place mode of the transform, and execute it on their own
+arrays: all of them are allocated by fftw_malloc and have the alignment the
+plan expects. Objects created again and again for transforms of the same
+size, e.g. by TVirtualFFT::FFT or in the fits of RooFFTConvPdf, therefore
+plan only once per process. A plan is kept while it is used, and the least
+recently used of the unused ones are destroyed when there are more than
+kMaxUnused of them. The planner of fftw is not thread-safe, the cache
+serialises the planning.
+
+The fftw wisdom, i.e. the knowledge gathered by the planner, can be saved
+and restored with ExportWisdom() and ImportWisdom(). If the resource
+FFTW.WisdomFile is set, the file is imported before the first plan is made
+and the wisdom is exported to it at the end of the process.
+
+SetNThreads() selects the number of threads of the plans made from now on,
+if ROOT was built with the fftw3_threads library.
+*/
+
+#include "TFFTPlanCache.h"
+
+#include "fftw3.h"
+#include "TEnv.h"
+#include "TError.h"
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+// Number of unused plans kept in the cache
+const Int_t kMaxUnused = 64;
+
+struct TPlanEntry {
+   void *fPlan;
+   Int_t fRefs;
+   ULong64_t fLastUse;
+};
+
+struct TPlanCache {
+   std::mutex fMutex;
+   std::map<std::string, TPlanEntry> fPlans;
+   std::unordered_map<void *, std::string> fKeys;
+   ULong64_t fClock = 0;
+   Int_t fNThreads = 1;
+   Bool_t fThreadsInit = kFALSE;
+   Bool_t fWisdomInit = kFALSE;
+   std::string fWisdomFile;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The cache is never destroyed, so that transforms can release their plans
+/// until the very end of the process.
+
+TPlanCache &GetCache()
+{
+   static TPlanCache *cache = new TPlanCache;
+   return *cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Export the wisdom to the file of FFTW.WisdomFile at exit.
+
+void ExportWisdomAtExit()
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   if (!cache.fWisdomFile.empty())
+      fftw_export_wisdom_to_filename(cache.fWisdomFile.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Import the wisdom of FFTW.WisdomFile the first time a plan is made. Must be
+/// called with the mutex of the cache locked.
+
+void InitWisdom(TPlanCache &cache)
+{
+   if (cache.fWisdomInit)
+      return;
+   cache.fWisdomInit = kTRUE;
+   cache.fWisdomFile = gEnv ? gEnv->GetValue("FFTW.WisdomFile", "") : "";
+   if (cache.fWisdomFile.empty())
+      return;
+   // a missing file is not an error, it is created at exit
+   fftw_import_wisdom_from_filename(cache.fWisdomFile.c_str());
+   std::atexit(ExportWisdomAtExit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destroy the least recently used unused plans beyond kMaxUnused. Must be
+/// called with the mutex of the cache locked.
+
+void Prune(TPlanCache &cache)
+{
+   Int_t nunused = 0;
+   for (auto &entry : cache.fPlans)
+      if (entry.second.fRefs == 0)
+         nunused++;
+   while (nunused > kMaxUnused) {
+      auto oldest = cache.fPlans.end();
+      for (auto it = cache.fPlans.begin(); it != cache.fPlans.end(); ++it) {
+         if (it->second.fRefs == 0 && (oldest == cache.fPlans.end() || it->second.fLastUse < oldest->second.fLastUse))
+            oldest = it;
+      }
+      cache.fKeys.erase(oldest->second.fPlan);
+      fftw_destroy_plan((fftw_plan)oldest->second.fPlan);
+      cache.fPlans.erase(oldest);
+      nunused--;
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Key of a plan: type of the transform, its ndim sizes n, number of
+/// transforms done by the plan, in-place mode, fftw flags, and sign or kinds.
+
+std::string TFFTPlanCache::MakeKey(const char *type, Int_t ndim, const Int_t *n, Int_t howmany, Bool_t inPlace,
+                                   UInt_t flags, Int_t sign, const Int_t *kinds)
+{
+   std::ostringstream key;
+   key << type << ':';
+   for (Int_t i = 0; i < ndim; i++)
+      key << n[i] << 'x';
+   key << ':' << howmany << ':' << inPlace << ':' << flags << ':' << sign;
+   if (kinds) {
+      for (Int_t i = 0; i < ndim; i++)
+         key << ',' << kinds[i];
+   }
+   return key.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the plan of the given key, made by create if it is not in the cache
+/// yet. The plan must be given back by Release() when it is not used anymore.
+/// Return nullptr, and cache nothing, if create fails.
+
+void *TFFTPlanCache::Acquire(const std::string &key, const std::function<void *()> &create)
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   // the number of threads is part of the plan
+   const std::string fullkey = key + ":t" + std::to_string(cache.fNThreads);
+   auto it = cache.fPlans.find(fullkey);
+   if (it != cache.fPlans.end()) {
+      it->second.fRefs++;
+      it->second.fLastUse = ++cache.fClock;
+      return it->second.fPlan;
+   }
+
+   InitWisdom(cache);
+#ifdef R__HAS_FFTW_THREADS
+   fftw_plan_with_nthreads(cache.fNThreads);
+#endif
+   void *plan = create();
+   if (!plan)
+      return nullptr;
+   cache.fPlans[fullkey] = TPlanEntry{plan, 1, ++cache.fClock};
+   cache.fKeys[plan] = fullkey;
+   return plan;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back a plan obtained by Acquire(). It stays in the cache for the next
+/// transforms of the same kind.
+
+void TFFTPlanCache::Release(void *plan)
+{
+   if (!plan)
+      return;
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   auto key = cache.fKeys.find(plan);
+   if (key == cache.fKeys.end()) {
+      fftw_destroy_plan((fftw_plan)plan);
+      return;
+   }
+   TPlanEntry &entry = cache.fPlans[key->second];
+   if (entry.fRefs > 0)
+      entry.fRefs--;
+   if (entry.fRefs == 0)
+      Prune(cache);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of plans in the cache, used or not.
+
+Int_t TFFTPlanCache::GetNPlans()
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return cache.fPlans.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of threads of the plans made from now on.
+
+Int_t TFFTPlanCache::GetNThreads()
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return cache.fNThreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of threads used by each transform planned from now on. The
+/// plans already made keep their number of threads. Only available if ROOT was
+/// built with the fftw3_threads library, otherwise the transforms stay serial.
+
+void TFFTPlanCache::SetNThreads(Int_t nthreads)
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+#ifdef R__HAS_FFTW_THREADS
+   if (!cache.fThreadsInit) {
+      if (!fftw_init_threads()) {
+         ::Error("TFFTPlanCache::SetNThreads", "fftw threads cannot be initialized");
+         return;
+      }
+      cache.fThreadsInit = kTRUE;
+   }
+   cache.fNThreads = nthreads > 1 ? nthreads : 1;
+#else
+   if (nthreads > 1)
+      ::Warning("TFFTPlanCache::SetNThreads", "ROOT was built without the fftw3_threads library, "
+                                              "the transforms are not multi-threaded");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the wisdom of filename to the one of the planner. Return kFALSE if the
+/// file cannot be read.
+
+Bool_t TFFTPlanCache::ImportWisdom(const char *filename)
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return fftw_import_wisdom_from_filename(filename) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Save the wisdom of the planner to filename. Return kFALSE on failure.
+
+Bool_t TFFTPlanCache::ExportWisdom(const char *filename)
+{
+   TPlanCache &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return fftw_export_wisdom_to_filename(filename) != 0;
+}
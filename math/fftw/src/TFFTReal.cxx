@@ -59,8 +59,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTReal.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 
+#include <vector>
+
 ClassImp(TFFTReal);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -123,7 +126,7 @@ TFFTReal::TFFTReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 
 TFFTReal::~TFFTReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
    fftw_free(fIn);
    fIn = 0;
@@ -155,8 +158,8 @@ TFFTReal::~TFFTReal()
 /// - "EX" (from "exhaustive") - the most optimal way is found
 ///
 ///  This option should be chosen depending on how many transforms of the same size and
-///  type are going to be done. Planning is only done once, for the first transform of this
-///  size and type.
+///  type are going to be done. Planning is only done once per process, for the first
+///  transform of this size and type, the plan is then taken from TFFTPlanCache.
 ///
 /// #### 2nd parameter:
 ///    is dummy and doesn't need to be specified
@@ -175,18 +178,20 @@ TFFTReal::~TFFTReal()
 
 void TFFTReal::Init( Option_t* flags,Int_t /*sign*/, const Int_t *kind)
 {
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
 
    if (!fKind)
       fKind = (fftw_r2r_kind*)fftw_malloc(sizeof(fftw_r2r_kind)*fNdim);
 
    if (MapOptions(kind)){
-      if (fOut)
-         fPlan = (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, (Double_t*)fOut, (fftw_r2r_kind*)fKind, MapFlag(flags));
-      else
-         fPlan = (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, (Double_t*)fIn, (fftw_r2r_kind*)fKind, MapFlag(flags));
+      const UInt_t flag = MapFlag(flags);
+      Double_t *in = (Double_t*)fIn;
+      Double_t *out = fOut ? (Double_t*)fOut : (Double_t*)fIn;
+      fftw_r2r_kind *kinds = (fftw_r2r_kind*)fKind;
+      std::vector<Int_t> keykinds(kinds, kinds + fNdim);
+      const std::string key = TFFTPlanCache::MakeKey("R2R", fNdim, fN, 1, !fOut, flag, 0, keykinds.data());
+      fPlan = TFFTPlanCache::Acquire(key, [&]() -> void * { return fftw_plan_r2r(fNdim, fN, in, out, kinds, flag); });
       fFlags = flags;
    }
 }
@@ -197,7 +202,7 @@ void TFFTReal::Init( Option_t* flags,Int_t /*sign*/, const Int_t *kind)
 void TFFTReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_r2r((fftw_plan)fPlan, (Double_t*)fIn, fOut ? (Double_t*)fOut : (Double_t*)fIn);
    else {
       Error("Transform", "transform hasn't been initialised");
       return;
@@ -43,6 +43,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTRealComplex.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 #include "TComplex.h"
 
@@ -112,13 +113,12 @@ TFFTRealComplex::TFFTRealComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays and gives the plan back to TFFTPlanCache, where it is
+///reused by the next transforms of the same kind
 
 TFFTRealComplex::~TFFTRealComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
    fftw_free(fIn);
    fIn = 0;
@@ -146,21 +146,21 @@ TFFTRealComplex::~TFFTRealComplex()
 /// - "EX" (from "exhaustive") - the most optimal way is found
 ///
 ///This option should be chosen depending on how many transforms of the same size and
-///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///type are going to be done. Planning is only done once per process, for the first
+///transform of this size and type, the plan is then taken from TFFTPlanCache.
 
 void TFFTRealComplex::Init(Option_t *flags,Int_t /*sign*/, const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
+   TFFTPlanCache::Release(fPlan);
    fPlan = 0;
 
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fOut,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fIn, MapFlag(flags));
+   const UInt_t flag = MapFlag(flags);
+   Double_t *in = (Double_t*)fIn;
+   fftw_complex *out = fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn;
+   const std::string key = TFFTPlanCache::MakeKey("R2C", fNdim, fN, 1, !fOut, flag);
+   fPlan = TFFTPlanCache::Acquire(key, [&]() -> void * { return fftw_plan_dft_r2c(fNdim, fN, in, out, flag); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -170,7 +170,7 @@ void TFFTRealComplex::Transform()
 {
 
    if (fPlan){
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_r2c((fftw_plan)fPlan, (Double_t*)fIn, fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn);
    }
    else {
       Error("Transform", "transform hasn't been initialised");
@@ -72,6 +72,7 @@ protected:
    Double_t fMCerror;         ///< and its error
 
    Double_t *fAlpha;          ///< [fDim] Internal parameters of the hyper-rectangle
+   Int_t   fOptParallel = 0;  ///<! Switch =1 to evaluate the batches of the distribution in parallel tasks
 
 public:
    TFoam();                          // Default constructor (used only by ROOT streamer)
@@ -95,6 +96,7 @@ public:
    // Generation
    virtual Double_t Eval(Double_t *);        // Evaluates value of the distribution function
    virtual void     MakeEvent();             // Makes (generates) single MC event
+   virtual void     MakeEvents(Int_t nev, Double_t *MCvect, Double_t *MCwt = nullptr); // Makes nev MC events at once
    virtual void     GetMCvect(Double_t *);   // Provides generated randomly MC vector
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
@@ -121,6 +123,7 @@ public:
    virtual void SetOptDrive(Int_t OptDrive){fOptDrive =OptDrive;}  // Sets optimization switch
    virtual void SetEvPerBin(Int_t EvPerBin){fEvPerBin =EvPerBin;}  // Sets max. no. of effective events per bin
    virtual void SetMaxWtRej(Double_t MaxWtRej){fMaxWtRej=MaxWtRej;}  // Sets max. weight for rejection
+   void SetOptParallel(Int_t OptParallel){fOptParallel =OptParallel;} // Sets option for parallel evaluation of the distribution
    virtual void SetInhiDiv(Int_t, Int_t );            // Set inhibition of cell division along certain edge
    virtual void SetXdivPRD(Int_t, Int_t, Double_t[]); // Set predefined division points
    // Getters and Setters
@@ -138,6 +141,8 @@ public:
    // Inline
 private:
    Double_t Sqr(Double_t x) const { return x*x;}      // Square function
+   void   EvalBatch(Int_t n, Double_t *xRand, Double_t *values); // Evaluates the distribution at n points
+   Bool_t AcceptEvent(TFoamCell *cell, Double_t wt, Double_t random); // Statistics and rejection of a MC event
 
    ClassDef(TFoam,2);   // General purpose self-adapting Monte Carlo event generator
 };
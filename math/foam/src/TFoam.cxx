@@ -68,6 +68,18 @@ Only `kDim` HAS TO BE redefined, the other parameters may be left at their defau
 Increasing `nSampl` sometimes helps, but it may cost CPU time.
 `MaxWtRej` may need to be increased for wild a distribution, while using `OptRej=0`.
 
+### Batches of events and parallel evaluation
+
+The distribution is evaluated in batches of points, both in the cell exploration
+of Initialize() and by MakeEvents(), which generates many MC events at once.
+The batches are passed to TFoamIntegrand::DensityBatch, which may be overridden
+for a vectorised evaluation. The points, the random numbers and the results are
+the same as with an evaluation point by point.
+With `FoamObject->SetOptParallel(1)` and implicit multi-threading enabled with
+ROOT::EnableImplicitMT(), the batches are split in parallel tasks: the
+distribution must then be thread-safe. The random numbers are still drawn in a
+single sequence, so that the results do not depend on the number of threads.
+
 Past versions of FOAM: August 2003, v.1.00; September 2003 v.1.01
 Adopted starting from FOAM-2.06 by P. Sawicki
 
@@ -91,6 +103,12 @@ S. Jadach, Computer Physics Communications 152 (2003) 55.
 #include "TRandom.h"
 #include "TMath.h"
 #include "TInterpreter.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 ClassImp(TFoam);
 
@@ -114,6 +132,7 @@ ClassImp(TFoam);
 
 static const Double_t gHigh= 1.0e150;
 static const Double_t gVlow=-1.0e150;
+static const Int_t    gMaxBatch=1000;  // Maximum number of points in a batch of evaluations of the distribution
 
 #define SW2 setprecision(7) << std::setw(12)
 
@@ -537,8 +556,6 @@ void TFoam::Explore(TFoamCell *cell)
 
    TFoamCell  *parent;
 
-   Double_t *xRand = new Double_t[fDim];
-
    Double_t *volPart=0;
 
    cell->CalcVolume();
@@ -560,35 +577,54 @@ void TFoam::Explore(TFoamCell *cell)
    fHistWt->Reset();
    //
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
+   // The distribution is evaluated in batches of points. nevEff grows by at
+   // most one per event, so that the exit condition cannot be met before the
+   // last event of a batch: the random numbers used, the weights and the
+   // results are the ones of an evaluation event by event.
    Double_t nevEff=0.;
-   for(iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
-
-      if(fDim>0){
-      for(j=0; j<fDim; j++)
-         xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+   std::vector<Double_t> alphas, xBatch, rhoBatch;
+   Bool_t exitLoop = kFALSE;
+   for(iev=0; iev<fNSampl && !exitLoop; ){
+      Long_t nBatch = (Long_t)TMath::Ceil(fNBin*fEvPerBin - nevEff) - 1;
+      nBatch = TMath::Max(1L, TMath::Min(nBatch, TMath::Min(fNSampl-iev, (Long_t)gMaxBatch)));
+      alphas.resize(nBatch*fDim);
+      xBatch.resize(nBatch*fDim);
+      rhoBatch.resize(nBatch);
+      for(Long_t ib=0; ib<nBatch; ib++){
+         MakeAlpha();               // generate uniformly vector inside hypercube
+         for(j=0; j<fDim; j++){
+            alphas[ib*fDim+j] = fAlpha[j];
+            xBatch[ib*fDim+j] = cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
       }
-
-      wt=dx*Eval(xRand);
-
-      nProj = 0;
-      if(fDim>0) {
-         for(k=0; k<fDim; k++) {
-            xproj =fAlpha[k];
-            ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
-            nProj++;
+      EvalBatch(nBatch, xBatch.data(), rhoBatch.data());
+
+      for(Long_t ib=0; ib<nBatch; ib++){
+         iev++;
+         wt=dx*rhoBatch[ib];
+
+         nProj = 0;
+         if(fDim>0) {
+            for(k=0; k<fDim; k++) {
+               xproj =alphas[ib*fDim+k];
+               ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
+               nProj++;
+            }
+         }
+         //
+         fNCalls++;
+         ceSum[0] += wt;    // sum of weights
+         ceSum[1] += wt*wt; // sum of weights squared
+         ceSum[2]++;        // sum of 1
+         if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
+         if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
+         // test MC loop exit condition
+         nevEff = ceSum[1] == 0. ? 0. : ceSum[0]*ceSum[0]/ceSum[1];
+         if( nevEff >= fNBin*fEvPerBin) {
+            exitLoop = kTRUE;
+            break;
          }
       }
-      //
-      fNCalls++;
-      ceSum[0] += wt;    // sum of weights
-      ceSum[1] += wt*wt; // sum of weights squared
-      ceSum[2]++;        // sum of 1
-      if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
-      if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
-      // test MC loop exit condition
-      nevEff = ceSum[1] == 0. ? 0. : ceSum[0]*ceSum[0]/ceSum[1];
-      if( nevEff >= fNBin*fEvPerBin) break;
    }   // ||||||||||||||||||||||||||END MC LOOP|||||||||||||||||||||||||||||
    //------------------------------------------------------------------
    //---  predefine logics of searching for the best division edge ---
@@ -660,7 +696,6 @@ void TFoam::Explore(TFoamCell *cell)
       parent->SetDriv( parDriv   +intDriv -driOld );
    }
    delete [] volPart;
-   delete [] xRand;
    //cell->Print();
 } // TFoam::Explore
 
@@ -1080,6 +1115,34 @@ Double_t TFoam::Eval(Double_t *xRand)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Evaluates the distribution at the n points of xRand, stored one after the
+/// other, with TFoamIntegrand::DensityBatch. With the option OptParallel=1 and
+/// implicit multi-threading enabled, the points are split in parallel tasks.
+
+void TFoam::EvalBatch(Int_t n, Double_t *xRand, Double_t *values)
+{
+   if(!fRho) {   //interactive mode
+      for(Int_t i=0; i<n; i++) values[i] = Eval(xRand + Long64_t(i)*fDim);
+      return;
+   }
+#ifdef R__USE_IMT
+   if (fOptParallel == 1 && n > 1 && ROOT::IsImplicitMTEnabled()) {
+      const Int_t nchunks = TMath::Min(n, 4*Int_t(ROOT::GetThreadPoolSize()));
+      auto chunk = [&](Int_t ichunk) {
+         const Int_t first = Int_t(Long64_t(n)*ichunk/nchunks);
+         const Int_t last  = Int_t(Long64_t(n)*(ichunk+1)/nchunks);
+         fRho->DensityBatch(fDim, last-first, xRand + Long64_t(first)*fDim, values + first);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(chunk, ROOT::TSeqI(nchunks));
+      return;
+   }
+#endif
+   fRho->DensityBatch(fDim, n, xRand, values);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method.
 /// Return randomly chosen active cell with probability equal to its
@@ -1126,7 +1189,7 @@ void TFoam::GenerCel2(TFoamCell *&pCell)
 void TFoam::MakeEvent(void)
 {
    Int_t      j;
-   Double_t   wt,dx,mcwt;
+   Double_t   wt,dx;
    TFoamCell *rCell;
    //
    //********************** MC LOOP STARS HERE **********************
@@ -1144,7 +1207,19 @@ ee0:
 
    wt=dx*Eval(fMCvect);
 
-   mcwt = wt / rCell->GetPrim();  // PRIMARY controls normalization
+   if(!AcceptEvent(rCell, wt, fOptRej == 1 ? fPseRan->Rndm() : 0.)) goto ee0;
+   //********************** MC LOOP ENDS HERE **********************
+} // MakeEvent
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Accumulates the statistics of the candidate event of weight wt=volume*density
+/// generated in cell and sets fMCwt. With OptRej=1, decides with the uniform
+/// random number random whether the event is rejected, and returns kFALSE if so.
+
+Bool_t TFoam::AcceptEvent(TFoamCell *cell, Double_t wt, Double_t random)
+{
+   Double_t mcwt = wt / cell->GetPrim();  // PRIMARY controls normalization
    fNCalls++;
    fMCwt   =  mcwt;
    // accumulation of statistics for the main MC weight
@@ -1157,9 +1232,7 @@ ee0:
    fHistWt->Fill(mcwt,1.0);          // histogram
    //*******  Optional rejection ******
    if(fOptRej == 1) {
-      Double_t random;
-      random=fPseRan->Rndm();
-      if( fMaxWtRej*random > fMCwt) goto ee0;  // Wt=1 events, internal rejection
+      if( fMaxWtRej*random > fMCwt) return kFALSE;  // Wt=1 events, internal rejection
       if( fMCwt<fMaxWtRej ) {
          fMCwt = 1.0;                  // normal Wt=1 event
       } else {
@@ -1167,8 +1240,57 @@ ee0:
          fSumOve += fMCwt-fMaxWtRej; // contribution of overweighted
       }
    }
-   //********************** MC LOOP ENDS HERE **********************
-} // MakeEvent
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// User method.
+/// It generates nev MC events at once: the nev*kDim coordinates are written one
+/// event after the other into MCvect, and the MC weights into MCwt if it is given.
+/// The events, the weights and the state of the random number generator are the
+/// same as after nev calls of MakeEvent, but the distribution is evaluated in
+/// batches of candidate events, see TFoamIntegrand::DensityBatch.
+/// With SetOptParallel(1) and implicit multi-threading enabled, the batches are
+/// evaluated in parallel tasks: the distribution must then be thread-safe.
+/// The generated MC vector and weight of the last event are also available with
+/// GetMCvect and GetMCwt.
+
+void TFoam::MakeEvents(Int_t nev, Double_t *MCvect, Double_t *MCwt)
+{
+   std::vector<TFoamCell*> cells;
+   std::vector<Double_t> xBatch, rhoBatch, randBatch;
+   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
+   Int_t nDone = 0;
+   while(nDone < nev) {
+      // each candidate gives at most one event: no more random numbers are
+      // drawn than by MakeEvent
+      const Int_t nBatch = TMath::Min(nev-nDone, gMaxBatch);
+      cells.resize(nBatch);
+      xBatch.resize(Long64_t(nBatch)*fDim);
+      rhoBatch.resize(nBatch);
+      randBatch.resize(nBatch);
+      // the candidates, with the random numbers in the order of MakeEvent
+      for(Int_t ib=0; ib<nBatch; ib++) {
+         GenerCel2(cells[ib]);
+         MakeAlpha();
+         cells[ib]->GetHcub(cellPosi,cellSize);
+         for(Int_t j=0; j<fDim; j++)
+            xBatch[Long64_t(ib)*fDim+j]= cellPosi[j] +fAlpha[j]*cellSize[j];
+         randBatch[ib] = fOptRej == 1 ? fPseRan->Rndm() : 0.;
+      }
+      EvalBatch(nBatch, xBatch.data(), rhoBatch.data());
+
+      for(Int_t ib=0; ib<nBatch; ib++) {
+         if(!AcceptEvent(cells[ib], cells[ib]->GetVolume()*rhoBatch[ib], randBatch[ib])) continue;
+         for(Int_t j=0; j<fDim; j++) {
+            fMCvect[j] = xBatch[Long64_t(ib)*fDim+j];
+            MCvect[Long64_t(nDone)*fDim+j] = fMCvect[j];
+         }
+         if(MCwt) MCwt[nDone] = fMCwt;
+         nDone++;
+      }
+   }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// User may get generated MC point/vector with help of this method
@@ -5,6 +5,23 @@
 
 /** \class TFoamIntegrand
 Abstract class representing n-dimensional real positive integrand function
+
+TFoam evaluates the function in batches of points with DensityBatch(), which
+by default calls Density() for each point. It can be overridden to evaluate
+the batches in a vectorised way.
 */
 
-ClassImp(TFoamIntegrand);
\ No newline at end of file
+ClassImp(TFoamIntegrand);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the density at the n points of ndim coordinates stored one after
+/// the other in x, and write the n values in values.
+/// If TFoam::SetOptParallel(1) is used with implicit multi-threading enabled,
+/// this method is called concurrently for different points: Density() and
+/// DensityBatch() must then be thread-safe.
+
+void TFoamIntegrand::DensityBatch(Int_t ndim, Int_t n, Double_t *x, Double_t *values)
+{
+   for (Int_t i = 0; i < n; i++)
+      values[i] = Density(ndim, x + Long64_t(i) * ndim);
+}
@@ -2,8 +2,14 @@
 // Author: Stephan Hageboeck, CERN  04/2020
 
 #include "TFoam.h"
+#include "TFoamIntegrand.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -50,3 +56,71 @@ TEST(TFoam, Readv1) {
     EXPECT_NEAR(x[1], results[i][1], 1.E-9);
   }
 }
+
+namespace {
+
+class Camel2Integrand : public TFoamIntegrand {
+public:
+   Double_t Density(Int_t nDim, Double_t *x) override { return Camel2(nDim, x); }
+};
+
+std::unique_ptr<TFoam> MakeFoam(TRandom &rng, TFoamIntegrand &rho, Int_t optParallel = 0)
+{
+   std::unique_ptr<TFoam> foam(new TFoam("foam"));
+   foam->SetkDim(2);
+   foam->SetnCells(200);
+   foam->SetChat(0);
+   foam->SetOptParallel(optParallel);
+   foam->Initialize(&rng, &rho);
+   return foam;
+}
+
+} // namespace
+
+// Generating events in batches gives the events of successive MakeEvent calls
+TEST(TFoam, MakeEvents) {
+  Camel2Integrand rho;
+  TRandom3 rng1(4357), rng2(4357);
+  auto foam1 = MakeFoam(rng1, rho);
+  auto foam2 = MakeFoam(rng2, rho);
+  EXPECT_EQ(foam1->GetnCalls(), foam2->GetnCalls());
+
+  const int nev = 2500;
+  std::vector<double> x(2 * nev), wt(nev);
+  foam2->MakeEvents(nev, x.data(), wt.data());
+  for (int i = 0; i < nev; ++i) {
+    double x1[2];
+    foam1->MakeEvent();
+    foam1->GetMCvect(x1);
+    EXPECT_EQ(x1[0], x[2 * i]);
+    EXPECT_EQ(x1[1], x[2 * i + 1]);
+    EXPECT_EQ(foam1->GetMCwt(), wt[i]);
+  }
+  EXPECT_EQ(foam1->GetnCalls(), foam2->GetnCalls());
+  EXPECT_EQ(rng1.Rndm(), rng2.Rndm());
+
+  double integ1, err1, integ2, err2;
+  foam1->GetIntegMC(integ1, err1);
+  foam2->GetIntegMC(integ2, err2);
+  EXPECT_EQ(integ1, integ2);
+  EXPECT_EQ(err1, err2);
+}
+
+#ifdef R__USE_IMT
+// The parallel evaluation of the distribution does not change the foam nor the events
+TEST(TFoam, ParallelEvaluation) {
+  Camel2Integrand rho;
+  TRandom3 rng1(4357), rng2(4357);
+  auto serial = MakeFoam(rng1, rho);
+  ROOT::EnableImplicitMT(4);
+  auto parallel = MakeFoam(rng2, rho, 1);
+  EXPECT_EQ(serial->GetPrimary(), parallel->GetPrimary());
+
+  const int nev = 1000;
+  std::vector<double> x1(2 * nev), x2(2 * nev);
+  serial->MakeEvents(nev, x1.data());
+  parallel->MakeEvents(nev, x2.data());
+  ROOT::DisableImplicitMT();
+  EXPECT_EQ(x1, x2);
+}
+#endif
@@ -0,0 +1,106 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class MultiFitter
+
+#ifndef ROOT_Fit_MultiFitter
+#define ROOT_Fit_MultiFitter
+
+#include "Fit/BinData.h"
+#include "Fit/FitConfig.h"
+#include "ROOT/EExecutionPolicy.hxx"
+#include "Math/IParamFunction.h"
+
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+
+   namespace Fit {
+
+//___________________________________________________________________________________
+/**
+   Compact result of one of the fits performed by ROOT::Fit::MultiFitter
+
+   @ingroup FitMain
+*/
+struct FitSummary {
+   int fStatus = -1;              ///< status of the minimizer, 0 if the minimization converged
+   bool fValid = false;           ///< whether the minimization succeeded
+   double fMinFcnValue = 0;       ///< chi2 or -log(likelihood) at the minimum
+   unsigned int fNdf = 0;         ///< number of data points minus number of free parameters
+   unsigned int fNCalls = 0;      ///< number of calls of the objective function
+   std::vector<double> fParams;   ///< fitted parameter values
+   std::vector<double> fErrors;   ///< parabolic errors of the fitted parameters
+};
+
+//___________________________________________________________________________________
+/**
+   MultiFitter performs many independent fits of the same model function, each to its own data
+   set, for example one fit per channel in a calibration.
+
+   The model function, the parameter settings and the minimizer options are given once and used
+   as starting point of every fit. Instead of paying the set-up of a Fitter per fit, the fits are
+   split in chunks and every chunk reuses one minimizer and one clone of the model function. With
+   the ROOT::EExecutionPolicy::kMultiThread policy the chunks run in parallel on the IMT pool; the
+   clones of the model function must then be independent of each other, e.g. a
+   ROOT::Math::WrappedMultiTF1 must own a copy of its TF1 (see WrappedMultiTF1::SetAndCopyFunction).
+
+   The results are returned as a vector of FitSummary, in the order of the data sets.
+
+   @ingroup FitMain
+*/
+class MultiFitter {
+
+public:
+
+   typedef ROOT::Math::IParamMultiFunction IModelFunction;
+
+   /**
+      Constructor from the model function, its parameters are the initial values of all fits
+   */
+   MultiFitter(const IModelFunction &func);
+
+   ~MultiFitter();
+
+   MultiFitter(const MultiFitter &) = delete;
+   MultiFitter &operator=(const MultiFitter &) = delete;
+
+   /**
+      Least square fits of the model to every data set
+   */
+   std::vector<FitSummary> Fit(const std::vector<std::shared_ptr<BinData>> &data,
+                               ROOT::EExecutionPolicy executionPolicy = ROOT::EExecutionPolicy::kSequential);
+
+   /**
+      Binned likelihood fits of the model to every data set (see Fitter::LikelihoodFit)
+   */
+   std::vector<FitSummary> LikelihoodFit(const std::vector<std::shared_ptr<BinData>> &data, bool extended = true,
+                                         ROOT::EExecutionPolicy executionPolicy = ROOT::EExecutionPolicy::kSequential);
+
+   /**
+      Configuration shared by all fits: parameter settings and minimizer options
+   */
+   FitConfig &Config() { return fConfig; }
+   const FitConfig &Config() const { return fConfig; }
+
+private:
+
+   std::vector<FitSummary> DoFit(const std::vector<std::shared_ptr<BinData>> &data, bool likelihood, bool extended,
+                                 ROOT::EExecutionPolicy executionPolicy);
+
+   std::unique_ptr<IModelFunction> fFunc;  // model function, cloned for every chunk of fits
+   FitConfig fConfig;                      // configuration of all the fits
+};
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_MultiFitter */
@@ -40,6 +40,8 @@ public:
    double operator()();
    /// Generate a random integer value with 48 bits
    uint64_t IntRndm();
+   /// Fill the array with `n` double-precision random numbers, the same as `n` calls of Rndm()
+   void RndmArray(int n, double *array);
 
    /// Initialize and seed the state of the generator
    void SetSeed(uint64_t seed);
@@ -62,6 +62,7 @@ namespace ROOT {
       int Counter() { return -1; }
       void SetCounter(int) {}
       void Iterate() {} 
+      void IterateAndFill(double *) {}
    };
 
 
@@ -107,6 +108,14 @@ public:
    void Iterate() {
       iterate(fRngState); 
    }
+   // iterate the state and convert all its N-1 numbers, as the next N-1 calls of Rndm() would do
+   void IterateAndFill(double * array) {
+      iterate(fRngState);
+      const myuint * v = fRngState->V;
+      for (int i = 1; i < ROOT_MM_N; ++i)
+         array[i-1] = (double)((int64_t)v[i]) * INV_MERSBASE;
+      fRngState->counter = ROOT_MM_N;
+   }
    int Counter() const {
       return fRngState->counter; 
    }
@@ -0,0 +1,142 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation file for class MultiFitter
+
+#include "Fit/MultiFitter.h"
+#include "Fit/Chi2FCN.h"
+#include "Fit/PoissonLikelihoodFCN.h"
+#include "Math/Minimizer.h"
+#include "Math/MinimizerOptions.h"
+#include "Math/Error.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+
+namespace ROOT {
+
+   namespace Fit {
+
+MultiFitter::MultiFitter(const IModelFunction &func) :
+   fFunc(dynamic_cast<IModelFunction *>(func.Clone()))
+{
+   fConfig.CreateParamsSettings(*fFunc);
+}
+
+MultiFitter::~MultiFitter() {}
+
+std::vector<FitSummary> MultiFitter::Fit(const std::vector<std::shared_ptr<BinData>> &data,
+                                         ROOT::EExecutionPolicy executionPolicy)
+{
+   return DoFit(data, false, false, executionPolicy);
+}
+
+std::vector<FitSummary> MultiFitter::LikelihoodFit(const std::vector<std::shared_ptr<BinData>> &data, bool extended,
+                                                   ROOT::EExecutionPolicy executionPolicy)
+{
+   return DoFit(data, true, extended, executionPolicy);
+}
+
+std::vector<FitSummary> MultiFitter::DoFit(const std::vector<std::shared_ptr<BinData>> &data, bool likelihood,
+                                           bool extended, ROOT::EExecutionPolicy executionPolicy)
+{
+   // perform the fits, splitting them in chunks which reuse one minimizer and one model function each
+   typedef ROOT::Math::IMultiGenFunction BaseFunc;
+
+   std::vector<FitSummary> results(data.size());
+   if (data.empty()) return results;
+
+   if (fConfig.ParamsSettings().size() != fFunc->NPar()) {
+      MATH_ERROR_MSG("MultiFitter::DoFit", "wrong size of the parameter settings in FitConfig");
+      return results;
+   }
+
+#ifndef R__USE_IMT
+   if (executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
+      MATH_WARN_MSG("MultiFitter::DoFit", "Multithread execution policy requires IMT, which is disabled. Changing "
+                                          "to ROOT::EExecutionPolicy::kSequential.");
+      executionPolicy = ROOT::EExecutionPolicy::kSequential;
+   }
+#endif
+
+   unsigned int nChunks = 1;
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
+      pool.reset(new ROOT::TThreadExecutor());
+      // a few chunks per thread, to balance the fits converging at different speeds
+      nChunks = std::min<std::size_t>(data.size(), 4 * pool->GetPoolSize());
+   }
+#endif
+
+   // the minimizers are created here, not in the tasks, since they go through the plugin manager
+   std::vector<std::unique_ptr<ROOT::Math::Minimizer>> minimizers(nChunks);
+   std::vector<std::shared_ptr<IModelFunction>> funcs(nChunks);
+   for (unsigned int i = 0; i < nChunks; ++i) {
+      minimizers[i].reset(fConfig.CreateMinimizer());
+      if (!minimizers[i]) {
+         MATH_ERROR_MSG("MultiFitter::DoFit", "Minimizer cannot be created");
+         return results;
+      }
+      // likelihood fits have an error definition of 0.5, unless one was explicitly set
+      if (likelihood && fConfig.MinimizerOptions().ErrorDef() == ROOT::Math::MinimizerOptions::DefaultErrorDef())
+         minimizers[i]->SetErrorDef(0.5);
+      if (fConfig.ParabErrors()) minimizers[i]->SetValidError(true);
+      funcs[i].reset(dynamic_cast<IModelFunction *>(fFunc->Clone()));
+   }
+
+   auto fitChunk = [&](unsigned int ichunk) {
+      ROOT::Math::Minimizer &minimizer = *minimizers[ichunk];
+      const std::size_t first = data.size() * ichunk / nChunks;
+      const std::size_t last = data.size() * (ichunk + 1) / nChunks;
+      for (std::size_t i = first; i < last; ++i) {
+         FitSummary &result = results[i];
+         if (!data[i] || data[i]->Size() == 0) {
+            MATH_WARN_MSG("MultiFitter::DoFit", "fit data is empty");
+            continue;
+         }
+
+         std::unique_ptr<BaseFunc> fcn;
+         if (likelihood)
+            fcn.reset(new PoissonLikelihoodFCN<BaseFunc>(data[i], funcs[ichunk], 0, extended));
+         else
+            fcn.reset(new Chi2FCN<BaseFunc>(data[i], funcs[ichunk]));
+
+         // start from the configured parameter settings
+         minimizer.Clear();
+         minimizer.SetFunction(*fcn);
+         minimizer.SetVariables(fConfig.ParamsSettings().begin(), fConfig.ParamsSettings().end());
+
+         result.fValid = minimizer.Minimize();
+         result.fStatus = minimizer.Status();
+         result.fMinFcnValue = minimizer.MinValue();
+         result.fNCalls = minimizer.NCalls();
+         if (data[i]->Size() > minimizer.NFree()) result.fNdf = data[i]->Size() - minimizer.NFree();
+         const unsigned int npar = minimizer.NDim();
+         result.fParams.assign(minimizer.X(), minimizer.X() + npar);
+         if (minimizer.Errors()) result.fErrors.assign(minimizer.Errors(), minimizer.Errors() + npar);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (pool) {
+      pool->Foreach(fitChunk, ROOT::TSeq<unsigned int>(nChunks));
+      return results;
+   }
+#endif
+   fitChunk(0);
+   return results;
+}
+
+   } // end namespace Fit
+
+} // end namespace ROOT
@@ -213,6 +213,41 @@ public:
       return bits * div;
    }
 
+   /// Fill the array with `n` floating point numbers, the same as `n` calls of NextRandomFloat(). All the numbers
+   /// left in the current state are converted in one loop, without checking for the end of the block each time.
+   void NextRandomFloats(int n, double *array)
+   {
+      static constexpr double div = 1.0 / (uint64_t(1) << w);
+      while (n > 0) {
+         if (fPosition + w > kMaxPos) {
+            Advance();
+         }
+
+         int left = (kMaxPos - fPosition) / w;
+         if (left > n) {
+            left = n;
+         }
+         for (int i = 0; i < left; i++) {
+            int pos = fPosition + i * w;
+            int idx = pos / 64;
+            int offset = pos % 64;
+            int numBits = 64 - offset;
+
+            uint64_t bits = fState[idx] >> offset;
+            if (numBits < w) {
+               bits |= fState[idx + 1] << numBits;
+            }
+            bits &= ((uint64_t(1) << w) - 1);
+            array[i] = bits * div;
+         }
+
+         fPosition += left * w;
+         assert(fPosition <= kMaxPos && "position out of range!");
+         array += left;
+         n -= left;
+      }
+   }
+
    /// Initialize and seed the state of the generator as in James' implementation
    void SetSeedJames(uint64_t s)
    {
@@ -425,6 +460,12 @@ uint64_t RanluxppEngine<p>::IntRndm()
    return fImpl->NextRandomBits();
 }
 
+template <int p>
+void RanluxppEngine<p>::RndmArray(int n, double *array)
+{
+   fImpl->NextRandomFloats(n, array);
+}
+
 template <int p>
 void RanluxppEngine<p>::SetSeed(uint64_t seed)
 {
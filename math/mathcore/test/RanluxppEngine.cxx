@@ -47,6 +47,21 @@ TEST(RanluxppEngine, random2048)
    EXPECT_EQ(rng.Rndm(), 0.74670661284082484599);
 }
 
+TEST(RanluxppEngine, RndmArray)
+{
+   RanluxppEngine2048 rng(314159265);
+   RanluxppEngine2048 rngArray(314159265);
+
+   // Start in the middle of a block and fill across several blocks.
+   EXPECT_EQ(rng.Rndm(), rngArray.Rndm());
+   double array[30];
+   rngArray.RndmArray(30, array);
+   for (int i = 0; i < 30; i++) {
+      EXPECT_EQ(rng.Rndm(), array[i]);
+   }
+   EXPECT_EQ(rng.IntRndm(), rngArray.IntRndm());
+}
+
 TEST(RanluxppCompatEngineJames, P3)
 {
    RanluxppCompatEngineJamesP3 rng(314159265);
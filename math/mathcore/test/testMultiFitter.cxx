@@ -0,0 +1,100 @@
+#include "Fit/BinData.h"
+#include "Fit/Fitter.h"
+#include "Fit/MultiFitter.h"
+#include "Math/WrappedParamFunction.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+static double Gaus(const double *x, const double *p)
+{
+   return p[0] * std::exp(-0.5 * (x[0] - p[1]) * (x[0] - p[1]) / (p[2] * p[2]));
+}
+
+// One histogram-like data set per channel, with different peak positions
+static std::vector<std::shared_ptr<ROOT::Fit::BinData>> MakeChannels(int nChannels)
+{
+   TRandom3 rndm(42);
+   std::vector<std::shared_ptr<ROOT::Fit::BinData>> channels;
+   for (int ichan = 0; ichan < nChannels; ++ichan) {
+      const double mean = -1. + 2. * ichan / nChannels;
+      auto data = std::make_shared<ROOT::Fit::BinData>(50, 1);
+      for (int i = 0; i < 50; ++i) {
+         const double x = -5. + 0.2 * (i + 0.5);
+         const double y = rndm.Poisson(100. * std::exp(-0.5 * (x - mean) * (x - mean)));
+         data->Add(x, y, std::max(std::sqrt(y), 1.));
+      }
+      channels.emplace_back(data);
+   }
+   return channels;
+}
+
+class MultiFitterTest : public ::testing::TestWithParam<ROOT::EExecutionPolicy> {
+};
+
+TEST_P(MultiFitterTest, SameAsFitter)
+{
+   if (GetParam() == ROOT::EExecutionPolicy::kMultiThread) {
+#ifdef R__USE_IMT
+      ROOT::EnableImplicitMT(4);
+#else
+      return;
+#endif
+   }
+
+   double p0[] = {80., 0., 1.5};
+   ROOT::Math::WrappedParamFunction<> model(&Gaus, 1, 3, p0);
+   auto channels = MakeChannels(40);
+
+   ROOT::Fit::MultiFitter multiFitter(model);
+   auto summaries = multiFitter.Fit(channels, GetParam());
+   ASSERT_EQ(channels.size(), summaries.size());
+
+   for (std::size_t ichan = 0; ichan < channels.size(); ++ichan) {
+      ROOT::Fit::Fitter fitter;
+      fitter.Config().SetParamsSettings(3, p0);
+      ASSERT_TRUE(fitter.Fit(*channels[ichan], model));
+      const auto &res = fitter.Result();
+      const auto &summary = summaries[ichan];
+      EXPECT_TRUE(summary.fValid);
+      EXPECT_EQ(res.Status(), summary.fStatus);
+      EXPECT_EQ(res.Ndf(), summary.fNdf);
+      EXPECT_NEAR(res.MinFcnValue(), summary.fMinFcnValue, 1e-6 * res.MinFcnValue());
+      ASSERT_EQ(3u, summary.fParams.size());
+      ASSERT_EQ(3u, summary.fErrors.size());
+      for (unsigned int ipar = 0; ipar < 3; ++ipar) {
+         EXPECT_NEAR(res.Parameter(ipar), summary.fParams[ipar], 1e-4 * std::abs(res.Error(ipar)));
+         EXPECT_NEAR(res.Error(ipar), summary.fErrors[ipar], 1e-3 * res.Error(ipar));
+      }
+   }
+
+#ifdef R__USE_IMT
+   if (GetParam() == ROOT::EExecutionPolicy::kMultiThread)
+      ROOT::DisableImplicitMT();
+#endif
+}
+
+TEST(MultiFitter, LikelihoodFit)
+{
+   double p0[] = {80., 0., 1.5};
+   ROOT::Math::WrappedParamFunction<> model(&Gaus, 1, 3, p0);
+   auto channels = MakeChannels(3);
+
+   ROOT::Fit::MultiFitter multiFitter(model);
+   multiFitter.Config().ParSettings(2).SetLimits(0.1, 10.);
+   auto summaries = multiFitter.LikelihoodFit(channels);
+   for (std::size_t ichan = 0; ichan < channels.size(); ++ichan) {
+      EXPECT_TRUE(summaries[ichan].fValid);
+      EXPECT_NEAR(-1. + 2. * ichan / channels.size(), summaries[ichan].fParams[1], 0.1);
+      EXPECT_NEAR(1., summaries[ichan].fParams[2], 0.1);
+   }
+}
+
+INSTANTIATE_TEST_SUITE_P(Sequential, MultiFitterTest, ::testing::Values(ROOT::EExecutionPolicy::kSequential));
+INSTANTIATE_TEST_SUITE_P(MultiThread, MultiFitterTest, ::testing::Values(ROOT::EExecutionPolicy::kMultiThread));
@@ -40,6 +40,12 @@
 #pragma link C++ function  TMatrixTSymCramerInv::Inv6x6(TMatrixTSym<float>&,Double_t*);
 #pragma link C++ function  TMatrixTSymCramerInv::Inv6x6(TMatrixTSym<double>&,Double_t*);
 
+#pragma link C++ namespace TMatrixTLapack;
+#pragma link C++ function  TMatrixTLapack::IsAvailable();
+#pragma link C++ function  TMatrixTLapack::GetMinSize();
+#pragma link C++ function  TMatrixTLapack::SetMinSize(Int_t);
+#pragma link C++ function  TMatrixTLapack::Use(Int_t);
+
 #pragma link C++ class TVectorT                <float>-;
 #pragma link C++ class TMatrixTBase            <float>-;
 #pragma link C++ class TMatrixT                <float>-;
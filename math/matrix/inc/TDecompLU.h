@@ -34,6 +34,7 @@ protected :
 
    static Bool_t DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,Double_t tol,Int_t &nrZeros);
    static Bool_t DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,Double_t tol,Int_t &nrZeros);
+   static Bool_t InvertLULapack  (TMatrixD &lu,Double_t tol,Double_t *det);
 
    virtual const TMatrixDBase &GetDecompMatrix() const { return fLU; }
 
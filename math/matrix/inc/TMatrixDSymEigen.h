@@ -30,6 +30,7 @@ protected :
 
    static void MakeTridiagonal (TMatrixD &v,TVectorD &d,TVectorD &e);
    static void MakeEigenVectors(TMatrixD &v,TVectorD &d,TVectorD &e);
+   static Bool_t MakeEigenVectorsLapack(TMatrixD &v,TVectorD &d);
 
    TMatrixD fEigenVectors; // Eigen-vectors of matrix
    TVectorD fEigenValues;  // Eigen-values
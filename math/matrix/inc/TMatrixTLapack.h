@@ -0,0 +1,52 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTLapack
+#define ROOT_TMatrixTLapack
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTLapack                                                       //
+//                                                                      //
+// Optimized BLAS/LAPACK backend of the dense matrix classes.           //
+//                                                                      //
+// When ROOT is built with -Dlapack=ON, the products of TMatrixT and    //
+// TMatrixTSym, the inversions, TDecompChol and TMatrixDSymEigen call   //
+// the BLAS/LAPACK library (OpenBLAS, MKL, ...) found at configuration  //
+// time for matrices with at least GetMinSize() rows and columns.       //
+// Smaller matrices keep the native routines, for which the call        //
+// overhead of the library does not pay off.                            //
+//                                                                      //
+// The wrappers take row-wise stored arrays, like the ones returned by  //
+// TMatrixT::GetMatrixArray(). They can only be called when Use()       //
+// returned kTRUE.                                                      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+
+namespace TMatrixTLapack {
+
+   Bool_t IsAvailable();
+   Int_t  GetMinSize();
+   void   SetMinSize(Int_t n);
+   Bool_t Use(Int_t n);
+
+   void   Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,const Float_t  *a,const Float_t  *b,Float_t  *c);
+   void   Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,const Double_t *a,const Double_t *b,Double_t *c);
+   Int_t  Getrf(Int_t n,Double_t *a,Int_t *ipiv);
+   Int_t  Getri(Int_t n,Double_t *a,const Int_t *ipiv);
+   Int_t  Potrf(Int_t n,Double_t *a);
+   Int_t  Potri(Int_t n,Double_t *a);
+   Int_t  Syevd(Int_t n,Double_t *a,Double_t *w);
+
+}
+
+#endif
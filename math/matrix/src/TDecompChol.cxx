@@ -25,6 +25,7 @@
 */
 
 #include "TDecompChol.h"
+#include "TMatrixTLapack.h"
 #include "TMath.h"
 
 ClassImp(TDecompChol);
@@ -102,6 +103,7 @@ TDecompChol::TDecompChol(const TDecompChol &another) : TDecompBase(another)
 ////////////////////////////////////////////////////////////////////////////////
 /// Matrix A is decomposed in component U so that A = U^T * U
 /// If the decomposition succeeds, bit kDecomposed is set , otherwise kSingular
+/// Large matrices are decomposed with LAPACK if available, see TMatrixTLapack.
 
 Bool_t TDecompChol::Decompose()
 {
@@ -115,31 +117,38 @@ Bool_t TDecompChol::Decompose()
    Int_t i,j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
+   if (TMatrixTLapack::Use(n)) {
+      if (TMatrixTLapack::Potrf(n,pU) != 0) {
          Error("Decompose()","matrix not positive definite");
          return kFALSE;
       }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
-
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
-               const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
+   } else {
+      for (icol = 0; icol < n; icol++) {
+         const Int_t rowOff = icol*n;
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         for (irow = 0; irow < icol; irow++) {
+            const Int_t pos_ij = irow*n+icol;
+            ujj -= pU[pos_ij]*pU[pos_ij];
+         }
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
+         }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
+         if (icol < n-1) {
+            for (j = icol+1; j < n; j++) {
+               for (i = 0; i < icol; i++) {
+                  const Int_t rowOff2 = i*n;
+                  pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
+               }
             }
+            for (j = icol+1; j < n; j++)
+               pU[rowOff+j] /= ujj;
          }
-         for (j = icol+1; j < n; j++)
-            pU[rowOff+j] /= ujj;
       }
    }
 
@@ -337,6 +346,7 @@ void TDecompChol::Det(Double_t &d1,Double_t &d2)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// For a symmetric matrix A(m,m), its inverse A_inv(m,m) is returned .
+/// Large matrices are inverted with LAPACK if available, see TMatrixTLapack.
 
 Bool_t TDecompChol::Invert(TMatrixDSym &inv)
 {
@@ -345,6 +355,31 @@ Bool_t TDecompChol::Invert(TMatrixDSym &inv)
       return kFALSE;
    }
 
+   const Int_t n = GetNrows();
+   if (TMatrixTLapack::Use(n)) {
+      if (TestBit(kSingular)) {
+         Error("Invert(TMatrixDSym &","Matrix is singular");
+         return kFALSE;
+      }
+      if (!TestBit(kDecomposed) && !Decompose()) {
+         Error("Invert(TMatrixDSym &","Decomposition failed");
+         return kFALSE;
+      }
+      TMatrixD tmp(fU);
+      Double_t *pT = tmp.GetMatrixArray();
+      if (TMatrixTLapack::Potri(n,pT) != 0) {
+         Error("Invert(TMatrixDSym &","Matrix is singular");
+         return kFALSE;
+      }
+      // only the upper triangle of the inverse is calculated
+      Double_t *pI = inv.GetMatrixArray();
+      for (Int_t irow = 0; irow < n; irow++) {
+         for (Int_t icol = irow; icol < n; icol++)
+            pI[irow*n+icol] = pI[icol*n+irow] = pT[irow*n+icol];
+      }
+      return kTRUE;
+   }
+
    inv.UnitMatrix();
 
    const Int_t colLwb = inv.GetColLwb();
@@ -10,8 +10,11 @@
  *************************************************************************/
 
 #include "TDecompLU.h"
+#include "TMatrixTLapack.h"
 #include "TMath.h"
 
+#include <vector>
+
 ClassImp(TDecompLU);
 
 /** \class TDecompLU
@@ -770,7 +773,52 @@ Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Calculate matrix inversion through in place forward/backward substitution
+/// Calculate matrix inversion with the LAPACK routines dgetrf and dgetri, see
+/// TMatrixTLapack. The matrix is singular when a diagonal element of the
+/// decomposition is smaller than tol, as for DecomposeLUCrout.
+
+Bool_t TDecompLU::InvertLULapack(TMatrixD &lu,Double_t tol,Double_t *det)
+{
+   const Int_t     n   = lu.GetNcols();
+   Double_t *pLU = lu.GetMatrixArray();
+
+   std::vector<Int_t> ipiv(n);
+   Int_t info = TMatrixTLapack::Getrf(n,pLU,ipiv.data());
+
+   Double_t sign = 1.0;
+   Int_t nrZeros = 0;
+   for (Int_t i = 0; i < n; i++) {
+      if (ipiv[i] != i+1)
+         sign = -sign;
+      if (TMath::Abs(pLU[i*n+i]) < tol)
+         nrZeros++;
+   }
+   if (info < 0 || nrZeros > 0) {
+      ::Error("TDecompLU::InvertLU","matrix is singular, %d diag elements < tolerance of %.4e",nrZeros,tol);
+      return kFALSE;
+   }
+
+   if (det) {
+      Double_t d1;
+      Double_t d2;
+      const TVectorD diagv = TMatrixDDiag_const(lu);
+      DiagProd(diagv,tol,d1,d2);
+      d1 *= sign;
+      *det = d1*TMath::Power(2.0,d2);
+   }
+
+   info = TMatrixTLapack::Getri(n,pLU,ipiv.data());
+   if (info != 0) {
+      ::Error("TDecompLU::InvertLU","matrix is singular");
+      return kFALSE;
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate matrix inversion through in place forward/backward substitution.
+/// Large matrices are inverted with LAPACK if available, see TMatrixTLapack.
 
 Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
 {
@@ -785,6 +833,9 @@ Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
    const Int_t     n   = lu.GetNcols();
    Double_t *pLU = lu.GetMatrixArray();
 
+   if (TMatrixTLapack::Use(n))
+      return InvertLULapack(lu,tol,det);
+
    Int_t worki[kWorkMax];
    Bool_t isAllocatedI = kFALSE;
    Int_t *index = worki;
@@ -24,12 +24,14 @@
 */
 
 #include "TMatrixDSymEigen.h"
+#include "TMatrixTLapack.h"
 #include "TMath.h"
 
 ClassImp(TMatrixDSymEigen);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor for eigen-problem of symmetric matrix A .
+/// Large matrices are decomposed with LAPACK if available, see TMatrixTLapack.
 
 TMatrixDSymEigen::TMatrixDSymEigen(const TMatrixDSym &a)
 {
@@ -43,6 +45,9 @@ TMatrixDSymEigen::TMatrixDSymEigen(const TMatrixDSym &a)
 
    fEigenVectors = a;
 
+   if (TMatrixTLapack::Use(nRows) && MakeEigenVectorsLapack(fEigenVectors,fEigenValues))
+      return;
+
    TVectorD offDiag;
    Double_t work[kWorkMax];
    if (nRows > kWorkMax) offDiag.ResizeTo(nRows);
@@ -322,6 +327,34 @@ void TMatrixDSymEigen::MakeEigenVectors(TMatrixD &v,TVectorD &d,TVectorD &e)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the eigenvalues and eigenvectors of the symmetric matrix v with the
+/// LAPACK routine dsyevd. The eigenvalues are sorted in decreasing order, like
+/// in MakeEigenVectors. Return kFALSE and leave v untouched if LAPACK fails.
+
+Bool_t TMatrixDSymEigen::MakeEigenVectorsLapack(TMatrixD &v,TVectorD &d)
+{
+   const Int_t n = v.GetNrows();
+   TMatrixD tmp(v);
+   TVectorD w(n);
+   Double_t *pT = tmp.GetMatrixArray();
+   if (TMatrixTLapack::Syevd(n,pT,w.GetMatrixArray()) != 0)
+      return kFALSE;
+
+   // The eigenvectors are returned in the rows of tmp, by increasing eigenvalue
+   Double_t *pV = v.GetMatrixArray();
+   Double_t *pD = d.GetMatrixArray();
+   for (Int_t i = 0; i < n; i++) {
+      const Int_t k = n-1-i;
+      pD[i] = w(k);
+      const Double_t *pEigen = pT+k*n;
+      for (Int_t j = 0; j < n; j++)
+         pV[j*n+i] = pEigen[j];
+   }
+
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Assignment operator
 
@@ -0,0 +1,237 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TMatrixTLapack
+    \ingroup Matrix
+
+TMatrixTLapack
+
+Optimized BLAS/LAPACK backend of the dense matrix classes.
+
+ROOT has to be configured with `-Dlapack=ON`, which links libMatrix
+against the BLAS/LAPACK library found by CMake (OpenBLAS, MKL, ...).
+The following operations then call the library for matrices with at
+least GetMinSize() rows and columns (64 by default):
+
+  - the products of TMatrixT and TMatrixTSym (Mult, TMult, MultT,
+    Similarity, operator*), through AMultB, AtMultB and AMultBt
+  - TMatrixT::Invert and TMatrixTSym::Invert, through TDecompLU::InvertLU
+  - TDecompChol::Decompose and TDecompChol::Invert
+  - the eigen-decomposition of TMatrixDSymEigen
+
+The backend is switched off at run time with SetMinSize(0):
+~~~
+  TMatrixTLapack::SetMinSize(0);   // always use the native routines
+  TMatrixTLapack::SetMinSize(16);  // use BLAS/LAPACK from 16x16 on
+~~~
+
+The matrices are stored row-wise, while BLAS and LAPACK expect them
+column-wise. The wrappers take this into account, so that their
+arguments are the row-wise arrays of the matrix classes.
+*/
+
+#include "TMatrixTLapack.h"
+
+#include <atomic>
+#include <vector>
+
+#ifdef R__HAS_LAPACK
+extern "C" {
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,
+            const float *alpha, const float *a, const int *lda, const float *b, const int *ldb,
+            const float *beta, float *c, const int *ldc);
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,
+            const double *alpha, const double *a, const int *lda, const double *b, const int *ldb,
+            const double *beta, double *c, const int *ldc);
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info);
+void dgetri_(const int *n, double *a, const int *lda, const int *ipiv, double *work, const int *lwork,
+             int *info);
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+void dpotri_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+void dsyevd_(const char *jobz, const char *uplo, const int *n, double *a, const int *lda, double *w,
+             double *work, const int *lwork, int *iwork, const int *liwork, int *info);
+}
+#endif
+
+namespace {
+   std::atomic<Int_t> gLapackMinSize(64);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if libMatrix was built with a BLAS/LAPACK library.
+
+Bool_t TMatrixTLapack::IsAvailable()
+{
+#ifdef R__HAS_LAPACK
+   return kTRUE;
+#else
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the smallest dimension of the matrices handled by BLAS/LAPACK.
+
+Int_t TMatrixTLapack::GetMinSize()
+{
+   return gLapackMinSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the smallest dimension of the matrices handled by BLAS/LAPACK. A value
+/// <= 0 disables the backend.
+
+void TMatrixTLapack::SetMinSize(Int_t n)
+{
+   gLapackMinSize = n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if an operation on matrices of dimension n is done by BLAS/LAPACK.
+
+Bool_t TMatrixTLapack::Use(Int_t n)
+{
+#ifdef R__HAS_LAPACK
+   const Int_t minSize = gLapackMinSize;
+   return minSize > 0 && n >= minSize;
+#else
+   (void)n;
+   return kFALSE;
+#endif
+}
+
+#ifdef R__HAS_LAPACK
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate C = op(A) * op(B), with C a (m x n) matrix and k the number of
+/// columns of op(A). op(A) is A^T if transa is set and A otherwise, and
+/// similarly for B.
+
+void TMatrixTLapack::Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,
+                          const Float_t *a,const Float_t *b,Float_t *c)
+{
+   // Column-wise, C^T = op(B)^T * op(A)^T
+   const char ta = transa ? 'T' : 'N';
+   const char tb = transb ? 'T' : 'N';
+   const Int_t lda = transa ? m : k;
+   const Int_t ldb = transb ? k : n;
+   const Float_t alpha = 1.0;
+   const Float_t beta  = 0.0;
+   sgemm_(&tb,&ta,&n,&m,&k,&alpha,b,&ldb,a,&lda,&beta,c,&n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate C = op(A) * op(B), with C a (m x n) matrix and k the number of
+/// columns of op(A). op(A) is A^T if transa is set and A otherwise, and
+/// similarly for B.
+
+void TMatrixTLapack::Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,
+                          const Double_t *a,const Double_t *b,Double_t *c)
+{
+   const char ta = transa ? 'T' : 'N';
+   const char tb = transb ? 'T' : 'N';
+   const Int_t lda = transa ? m : k;
+   const Int_t ldb = transb ? k : n;
+   const Double_t alpha = 1.0;
+   const Double_t beta  = 0.0;
+   dgemm_(&tb,&ta,&n,&m,&k,&alpha,b,&ldb,a,&lda,&beta,c,&n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// LU decomposition with partial pivoting of the (n x n) matrix a, in place.
+/// LAPACK decomposes the transpose of the matrix, which has the same determinant:
+/// it is the product of the diagonal elements, negated for every ipiv[i] != i+1.
+/// Return the LAPACK info: > 0 if a diagonal element is exactly zero.
+
+Int_t TMatrixTLapack::Getrf(Int_t n,Double_t *a,Int_t *ipiv)
+{
+   Int_t info = 0;
+   dgetrf_(&n,&n,a,&n,ipiv,&info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the decomposition returned by Getrf with the inverse of the matrix.
+
+Int_t TMatrixTLapack::Getri(Int_t n,Double_t *a,const Int_t *ipiv)
+{
+   Int_t info = 0;
+   Int_t lwork = -1;
+   Double_t wsize = 0;
+   dgetri_(&n,a,&n,ipiv,&wsize,&lwork,&info);
+   lwork = (Int_t)wsize;
+   if (lwork < n) lwork = n;
+   std::vector<Double_t> work(lwork);
+   dgetri_(&n,a,&n,ipiv,work.data(),&lwork,&info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cholesky decomposition A = U^T * U of the symmetric positive-definite
+/// (n x n) matrix a. U is returned in the upper triangle, the strictly lower
+/// triangle is not modified.
+/// Return the LAPACK info: > 0 if the matrix is not positive definite.
+
+Int_t TMatrixTLapack::Potrf(Int_t n,Double_t *a)
+{
+   // The upper triangle of a row-wise matrix is the lower one column-wise
+   const char uplo = 'L';
+   Int_t info = 0;
+   dpotrf_(&uplo,&n,a,&n,&info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the Cholesky factor U returned by Potrf with the upper triangle
+/// of the inverse of the matrix.
+
+Int_t TMatrixTLapack::Potri(Int_t n,Double_t *a)
+{
+   const char uplo = 'L';
+   Int_t info = 0;
+   dpotri_(&uplo,&n,a,&n,&info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Eigen-decomposition of the symmetric (n x n) matrix a with the divide and
+/// conquer algorithm. The eigenvalues are returned in ascending order in w,
+/// and the eigenvectors in the corresponding rows of a.
+
+Int_t TMatrixTLapack::Syevd(Int_t n,Double_t *a,Double_t *w)
+{
+   const char jobz = 'V';
+   const char uplo = 'L';
+   Int_t info = 0;
+   Int_t lwork = -1;
+   Int_t liwork = -1;
+   Double_t wsize = 0;
+   Int_t iwsize = 0;
+   dsyevd_(&jobz,&uplo,&n,a,&n,w,&wsize,&lwork,&iwsize,&liwork,&info);
+   if (info != 0) return info;
+   lwork = (Int_t)wsize;
+   liwork = iwsize;
+   std::vector<Double_t> work(lwork);
+   std::vector<Int_t> iwork(liwork);
+   dsyevd_(&jobz,&uplo,&n,a,&n,w,work.data(),&lwork,iwork.data(),&liwork,&info);
+   return info;
+}
+
+#else
+
+void TMatrixTLapack::Gemm(Bool_t,Bool_t,Int_t,Int_t,Int_t,const Float_t *,const Float_t *,Float_t *) {}
+void TMatrixTLapack::Gemm(Bool_t,Bool_t,Int_t,Int_t,Int_t,const Double_t *,const Double_t *,Double_t *) {}
+Int_t TMatrixTLapack::Getrf(Int_t,Double_t *,Int_t *) { return -1; }
+Int_t TMatrixTLapack::Getri(Int_t,Double_t *,const Int_t *) { return -1; }
+Int_t TMatrixTLapack::Potrf(Int_t,Double_t *) { return -1; }
+Int_t TMatrixTLapack::Potri(Int_t,Double_t *) { return -1; }
+Int_t TMatrixTLapack::Syevd(Int_t,Double_t *,Double_t *) { return -1; }
+
+#endif
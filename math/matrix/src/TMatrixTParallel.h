@@ -0,0 +1,80 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTParallel
+#define ROOT_TMatrixTParallel
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTParallel                                                     //
+//                                                                      //
+// Internal helpers to split the rows of a matrix operation in chunks,  //
+// processed by the implicit multi-threading pool when it is enabled.   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RConfigure.h"
+#include "RtypesCore.h"
+#include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace TMatrixTParallel {
+
+   // Smallest number of multiply-adds for which an operation is split in tasks
+   const Long64_t kMinWork = 100000;
+
+   //////////////////////////////////////////////////////////////////////////////
+   /// Number of chunks for an operation of `work` multiply-adds on n rows: one
+   /// without implicit multi-threading or for small operations, a few per
+   /// thread of the pool otherwise.
+
+   inline Int_t GetNChunks(Int_t n,Long64_t work)
+   {
+#ifdef R__USE_IMT
+      if (n > 1 && work >= kMinWork && ROOT::IsImplicitMTEnabled())
+         return TMath::Min(n,4*Int_t(ROOT::GetThreadPoolSize()));
+#else
+      (void)n;
+      (void)work;
+#endif
+      return 1;
+   }
+
+   //////////////////////////////////////////////////////////////////////////////
+   /// Call func(ichunk,first,last) for each of the nchunks contiguous ranges of
+   /// rows [first,last) covering [0,n). The chunks run in parallel if there are
+   /// more than one.
+
+   template<class F> void ForEachChunk(Int_t n,Int_t nchunks,F func)
+   {
+      auto chunk = [&](Int_t ichunk) {
+         const Int_t first = Int_t(Long64_t(n)*ichunk/nchunks);
+         const Int_t last  = Int_t(Long64_t(n)*(ichunk+1)/nchunks);
+         func(ichunk,first,last);
+      };
+#ifdef R__USE_IMT
+      if (nchunks > 1) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(chunk,ROOT::TSeqI(nchunks));
+         return;
+      }
+#endif
+      for (Int_t ichunk = 0; ichunk < nchunks; ichunk++)
+         chunk(ichunk);
+   }
+
+}
+
+#endif
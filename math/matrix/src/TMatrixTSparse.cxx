@@ -81,6 +81,10 @@
 #include "TBuffer.h"
 #include "TMatrixT.h"
 #include "TMath.h"
+#include "TMatrixTParallel.h"
+
+#include <algorithm>
+#include <vector>
 
 templateClassImp(TMatrixTSparse);
 
@@ -484,18 +488,24 @@ void TMatrixTSparse<Element>::ExtractRow(Int_t rown, Int_t coln, Element *v,Int_
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// General matrix multiplication. Create a matrix C such that C = A * B'.
-/// Note, matrix C is allocated for constr=1.
+/// General matrix multiplication. Create a matrix C such that C = A * B.
+/// Note, matrix C is allocated for constr=1, otherwise its sparse index is
+/// resized to the number of non-zero elements of the product.
+///
+/// The rows of C are accumulated from the rows of B selected by the non-zero
+/// elements of the rows of A (Gustavson's algorithm), so that the cost scales
+/// with the number of multiplications instead of the dimensions of C. For large
+/// matrices, the rows are computed in parallel with implicit multi-threading.
 
 template<class Element>
-void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMatrixTSparse<Element> &b,Int_t constr)
+void TMatrixTSparse<Element>::AMultB(const TMatrixTSparse<Element> &a,const TMatrixTSparse<Element> &b,Int_t constr)
 {
    if (gMatrixCheck) {
       R__ASSERT(a.IsValid());
       R__ASSERT(b.IsValid());
 
-      if (a.GetNcols() != b.GetNcols() || a.GetColLwb() != b.GetColLwb()) {
-         Error("AMultBt","A and B columns incompatible");
+      if (a.GetNcols() != b.GetNrows() || a.GetColLwb() != b.GetRowLwb()) {
+         Error("AMultB","A rows and B columns incompatible");
          return;
       }
 
@@ -508,87 +518,129 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMa
          Error("AMultB","this = &b");
          return;
       }
+
+      if (!constr && (this->GetNrows() != a.GetNrows() || this->GetNcols() != b.GetNcols())) {
+         Error("AMultB","this, A and B incompatible");
+         return;
+      }
    }
 
-   const Int_t * const pRowIndexa = a.GetRowIndexArray();
-   const Int_t * const pColIndexa = a.GetColIndexArray();
-   const Int_t * const pRowIndexb = b.GetRowIndexArray();
-   const Int_t * const pColIndexb = b.GetColIndexArray();
+   const Int_t nrowsc = a.GetNrows();
+   const Int_t ncolsc = b.GetNcols();
+
+   const Int_t   * const pRowIndexa = a.GetRowIndexArray();
+   const Int_t   * const pColIndexa = a.GetColIndexArray();
+   const Element * const pDataa     = a.GetMatrixArray();
+   const Int_t   * const pRowIndexb = b.GetRowIndexArray();
+   const Int_t   * const pColIndexb = b.GetColIndexArray();
+   const Element * const pDatab     = b.GetMatrixArray();
+
+   // number of multiplications of the product
+   Long64_t nmult = 0;
+   for (Int_t indexa = 0; indexa < (pRowIndexa ? pRowIndexa[nrowsc] : 0); indexa++) {
+      const Int_t irowb = pColIndexa[indexa];
+      nmult += pRowIndexb[irowb+1]-pRowIndexb[irowb];
+   }
+
+   // each chunk of rows of C is computed in its own buffers
+   struct RowsOfC {
+      std::vector<Int_t>   fNelems;   // number of non-zero elements of each row
+      std::vector<Int_t>   fColIndex;
+      std::vector<Element> fElements;
+   };
+   const Int_t nchunks = TMatrixTParallel::GetNChunks(nrowsc,nmult);
+   std::vector<RowsOfC> chunks(nchunks);
+
+   auto multRows = [&](Int_t ichunk,Int_t first,Int_t last) {
+      RowsOfC &rows = chunks[ichunk];
+      rows.fNelems.reserve(last-first);
+      std::vector<Element> sum(ncolsc);
+      std::vector<Int_t>   lastRow(ncolsc,-1); // last row of C in which a column was filled
+      std::vector<Int_t>   cols;
+      for (Int_t irowc = first; irowc < last; irowc++) {
+         cols.clear();
+         for (Int_t indexa = pRowIndexa[irowc]; indexa < pRowIndexa[irowc+1]; indexa++) {
+            const Int_t   irowb = pColIndexa[indexa];
+            const Element dataa = pDataa[indexa];
+            for (Int_t indexb = pRowIndexb[irowb]; indexb < pRowIndexb[irowb+1]; indexb++) {
+               const Int_t icolc = pColIndexb[indexb];
+               if (lastRow[icolc] != irowc) {
+                  lastRow[icolc] = irowc;
+                  sum[icolc] = dataa*pDatab[indexb];
+                  cols.push_back(icolc);
+               } else
+                  sum[icolc] += dataa*pDatab[indexb];
+            }
+         }
+         std::sort(cols.begin(),cols.end());
+         Int_t nelems = 0;
+         for (const Int_t icolc : cols) {
+            if (sum[icolc] != 0.0) {
+               rows.fColIndex.push_back(icolc);
+               rows.fElements.push_back(sum[icolc]);
+               nelems++;
+            }
+         }
+         rows.fNelems.push_back(nelems);
+      }
+   };
+   TMatrixTParallel::ForEachChunk(nrowsc,nchunks,multRows);
 
-   Int_t *pRowIndexc;
-   Int_t *pColIndexc;
-   if (constr) {
-      // make a best guess of the sparse structure; it will guarantee
-      // enough allocated space !
+   Int_t nelems_new = 0;
+   for (const RowsOfC &rows : chunks)
+      nelems_new += rows.fColIndex.size();
 
-      Int_t nr_nonzero_rowa = 0;
-      {
-         for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++)
-            if (pRowIndexa[irowa] < pRowIndexa[irowa+1])
-               nr_nonzero_rowa++;
-      }
-      Int_t nr_nonzero_rowb = 0;
-      {
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++)
-            if (pRowIndexb[irowb] < pRowIndexb[irowb+1])
-              nr_nonzero_rowb++;
+   if (constr)
+      Allocate(nrowsc,ncolsc,a.GetRowLwb(),b.GetColLwb(),1,nelems_new);
+   else
+      SetSparseIndex(nelems_new);
+
+   Int_t   * const pRowIndexc = this->GetRowIndexArray();
+   Int_t   * const pColIndexc = this->GetColIndexArray();
+   Element * const pDatac     = this->GetMatrixArray();
+   pRowIndexc[0] = 0;
+   Int_t irowc   = 0;
+   Int_t indexc  = 0;
+   for (const RowsOfC &rows : chunks) {
+      for (const Int_t nelems : rows.fNelems) {
+         pRowIndexc[irowc+1] = pRowIndexc[irowc]+nelems;
+         irowc++;
       }
+      std::copy(rows.fColIndex.begin(),rows.fColIndex.end(),pColIndexc+indexc);
+      std::copy(rows.fElements.begin(),rows.fElements.end(),pDatac+indexc);
+      indexc += rows.fColIndex.size();
+   }
+}
 
-      const Int_t nc = nr_nonzero_rowa*nr_nonzero_rowb; // best guess
-      Allocate(a.GetNrows(),b.GetNrows(),a.GetRowLwb(),b.GetRowLwb(),1,nc);
+////////////////////////////////////////////////////////////////////////////////
+/// General matrix multiplication. Create a matrix C such that C = A * B'.
+/// Note, matrix C is allocated for constr=1.
 
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
+template<class Element>
+void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMatrixTSparse<Element> &b,Int_t constr)
+{
+   if (gMatrixCheck) {
+      R__ASSERT(a.IsValid());
+      R__ASSERT(b.IsValid());
 
-      pRowIndexc[0] = 0;
-      Int_t ielem = 0;
-      for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++) {
-         pRowIndexc[irowa+1] = pRowIndexc[irowa];
-         if (pRowIndexa[irowa] >= pRowIndexa[irowa+1]) continue;
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++) {
-            if (pRowIndexb[irowb] >= pRowIndexb[irowb+1]) continue;
-            pRowIndexc[irowa+1]++;
-            pColIndexc[ielem++] = irowb;
-         }
+      if (a.GetNcols() != b.GetNcols() || a.GetColLwb() != b.GetColLwb()) {
+         Error("AMultBt","A and B columns incompatible");
+         return;
       }
-   } else {
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
-   }
 
-   const Element * const pDataa = a.GetMatrixArray();
-   const Element * const pDatab = b.GetMatrixArray();
-   Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
-      const Int_t sIndexa = pRowIndexa[irowc];
-      const Int_t eIndexa = pRowIndexa[irowc+1];
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t sIndexb = pRowIndexb[icolc];
-         const Int_t eIndexb = pRowIndexb[icolc+1];
-         Element sum = 0.0;
-         Int_t indexb = sIndexb;
-         for (Int_t indexa = sIndexa; indexa < eIndexa && indexb < eIndexb; indexa++) {
-            const Int_t icola = pColIndexa[indexa];
-            while (indexb < eIndexb && pColIndexb[indexb] <= icola) {
-               if (icola == pColIndexb[indexb]) {
-                 sum += pDataa[indexa]*pDatab[indexb];
-                 break;
-               }
-               indexb++;
-            }
-         }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
-         }
+      if (!constr && this->GetMatrixArray() == a.GetMatrixArray()) {
+         Error("AMultB","this = &a");
+         return;
+      }
+
+      if (!constr && this->GetMatrixArray() == b.GetMatrixArray()) {
+         Error("AMultB","this = &b");
+         return;
       }
-      pRowIndexc[irowc+1] = indexc_r;
    }
 
-   if (constr)
-      SetSparseIndex(indexc_r);
+   const TMatrixTSparse<Element> bt(TMatrixTSparse::kTransposed,b);
+   AMultB(a,bt,constr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
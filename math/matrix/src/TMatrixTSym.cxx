@@ -29,6 +29,7 @@
 #include "TMatrixTLazy.h"
 #include "TMatrixTSymCramerInv.h"
 #include "TDecompLU.h"
+#include "TMatrixTLapack.h"
 #include "TMatrixDSymEigen.h"
 #include "TMath.h"
 
@@ -382,18 +383,6 @@ void TMatrixTSym<Element>::TMult(const TMatrixT<Element> &a)
 {
    R__ASSERT(a.IsValid());
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,this->fNrows,this->fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),ap,a.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),ap,a.GetNcols(),1.0,cp,fNcols);
-  else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = a.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = ncolsa;
@@ -401,6 +390,16 @@ void TMatrixTSym<Element>::TMult(const TMatrixT<Element> &a)
    const Element * const bp = ap;
          Element *       cp = this->GetMatrixArray();
 
+   if (TMatrixTLapack::Use(TMath::Min(ncolsa,a.GetNrows()))) {
+      TMatrixTLapack::Gemm(kTRUE,kFALSE,ncolsa,ncolsa,a.GetNrows(),ap,bp,cp);
+      // make the result exactly symmetric
+      for (Int_t irow = 1; irow < ncolsa; irow++) {
+         for (Int_t icol = 0; icol < irow; icol++)
+            cp[irow*ncolsa+icol] = cp[icol*ncolsa+irow];
+      }
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+a.GetNcols()) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of A, Start bcp = A[0,0]
@@ -418,7 +417,6 @@ void TMatrixTSym<Element>::TMult(const TMatrixT<Element> &a)
    }
 
    R__ASSERT(cp == this->GetMatrixArray()+this->fNelems && acp0 == ap+ncolsa);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -430,18 +428,6 @@ void TMatrixTSym<Element>::TMult(const TMatrixTSym<Element> &a)
 {
    R__ASSERT(a.IsValid());
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,this->fNrows,this->fNcols,1.0,
-                   ap,a.GetNcols(),ap,a.GetNcols(),0.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap1,a.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = a.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = ncolsa;
@@ -449,6 +435,16 @@ void TMatrixTSym<Element>::TMult(const TMatrixTSym<Element> &a)
    const Element * const bp = ap;
          Element *       cp = this->GetMatrixArray();
 
+   if (TMatrixTLapack::Use(TMath::Min(ncolsa,a.GetNrows()))) {
+      TMatrixTLapack::Gemm(kTRUE,kFALSE,ncolsa,ncolsa,a.GetNrows(),ap,bp,cp);
+      // make the result exactly symmetric
+      for (Int_t irow = 1; irow < ncolsa; irow++) {
+         for (Int_t icol = 0; icol < irow; icol++)
+            cp[irow*ncolsa+icol] = cp[icol*ncolsa+irow];
+      }
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+a.GetNcols()) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of A, Start bcp = A[0,0]
@@ -466,7 +462,6 @@ void TMatrixTSym<Element>::TMult(const TMatrixTSym<Element> &a)
    }
 
    R__ASSERT(cp == this->GetMatrixArray()+this->fNelems && acp0 == ap+ncolsa);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1127,42 +1122,36 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixT<Element> &
    if (nrowsb != this->fNrows)
       this->ResizeTo(nrowsb,nrowsb);
 
-#ifdef CBLAS
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,ba.GetNcols(),
-                   1.0,bap,ba.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,ba.GetNcols(),
-                   1.0,bap,ba.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else
-      Error("Similarity","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nba     = nrowsb*ncolsa;
    const Int_t ncolsba = ncolsa;
    const Element *       bi1p = bp;
          Element *       cp   = this->GetMatrixArray();
          Element * const cp0  = cp;
 
-   Int_t ishift = 0;
-   const Element *barp0 = bap;
-   while (barp0 < bap+nba) {
-      const Element *brp0 = bi1p;
-      while (brp0 < bp+nb) {
-         const Element *barp = barp0;
-         const Element *brp  = brp0;
-         Element cij = 0;
-         while (brp < brp0+ncolsb)
-            cij += *barp++ * *brp++;
-         *cp++ = cij;
-         brp0 += ncolsb;
+   if (TMatrixTLapack::Use(TMath::Min(nrowsb,ncolsb))) {
+      // the full product is calculated, the lower triangle is overwritten below
+      AMultBt(bap,nba,ncolsba,bp,nb,ncolsb,cp0);
+   } else {
+      Int_t ishift = 0;
+      const Element *barp0 = bap;
+      while (barp0 < bap+nba) {
+         const Element *brp0 = bi1p;
+         while (brp0 < bp+nb) {
+            const Element *barp = barp0;
+            const Element *brp  = brp0;
+            Element cij = 0;
+            while (brp < brp0+ncolsb)
+               cij += *barp++ * *brp++;
+            *cp++ = cij;
+            brp0 += ncolsb;
+         }
+         barp0 += ncolsba;
+         bi1p += ncolsb;
+         cp += ++ishift;
       }
-      barp0 += ncolsba;
-      bi1p += ncolsb;
-      cp += ++ishift;
-   }
 
-   R__ASSERT(cp == cp0+this->fNelems+ishift && barp0 == bap+nba);
+      R__ASSERT(cp == cp0+this->fNelems+ishift && barp0 == bap+nba);
+   }
 
    cp = cp0;
    for (Int_t irow = 0; irow < this->fNrows; irow++) {
@@ -1172,7 +1161,6 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixT<Element> &
          cp[rowOff1+icol] = cp[rowOff2+irow];
       }
    }
-#endif
 
    if (isAllocated)
       delete [] bap;
@@ -1198,34 +1186,6 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixTSym<Element
       }
    }
 
-#ifdef CBLAS
-   const Int_t nrowsb = b.GetNrows();
-   const Int_t ncolsa = this->GetNcols();
-
-   Element work[kWorkMax];
-   Bool_t isAllocated = kFALSE;
-   Element *abtp = work;
-   if (this->fNcols > kWorkMax) {
-      isAllocated = kTRUE;
-      abtp = new Element[this->fNcols];
-   }
-
-   const TMatrixT<Element> abt(*this,TMatrixT<Element>::kMultTranspose,b);
-
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,this->fNrows,this->fNcols,1.0,
-                   bp,b.GetNcols(),abtp,abt.GetNcols(),0.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,this->fNrows,this->fNcols,1.0,
-                   bp,b.GetNcols(),abtp,abt.GetNcols(),0.0,cp,this->fNcols);
-   else
-      Error("Similarity","type %s not implemented in BLAS library",typeid(Element));
-
-   if (isAllocated)
-      delete [] abtp;
-#else
    const Int_t ncolsa = this->GetNcols();
    const Int_t nb     = b.GetNoElements();
    const Int_t nrowsb = b.GetNrows();
@@ -1249,25 +1209,30 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixTSym<Element
          Element *       cp   = this->GetMatrixArray();
          Element * const cp0  = cp;
 
-   Int_t ishift = 0;
-   const Element *barp0 = bap;
-   while (barp0 < bap+nba) {
-      const Element *brp0 = bi1p;
-      while (brp0 < bp+nb) {
-         const Element *barp = barp0;
-         const Element *brp  = brp0;
-         Element cij = 0;
-         while (brp < brp0+ncolsb)
-            cij += *barp++ * *brp++;
-         *cp++ = cij;
-         brp0 += ncolsb;
+   if (TMatrixTLapack::Use(TMath::Min(nrowsb,ncolsb))) {
+      // the full product is calculated, the lower triangle is overwritten below
+      AMultBt(bap,nba,ncolsba,bp,nb,ncolsb,cp0);
+   } else {
+      Int_t ishift = 0;
+      const Element *barp0 = bap;
+      while (barp0 < bap+nba) {
+         const Element *brp0 = bi1p;
+         while (brp0 < bp+nb) {
+            const Element *barp = barp0;
+            const Element *brp  = brp0;
+            Element cij = 0;
+            while (brp < brp0+ncolsb)
+               cij += *barp++ * *brp++;
+            *cp++ = cij;
+            brp0 += ncolsb;
+         }
+         barp0 += ncolsba;
+         bi1p += ncolsb;
+         cp += ++ishift;
       }
-      barp0 += ncolsba;
-      bi1p += ncolsb;
-      cp += ++ishift;
-   }
 
-   R__ASSERT(cp == cp0+this->fNelems+ishift && barp0 == bap+nba);
+      R__ASSERT(cp == cp0+this->fNelems+ishift && barp0 == bap+nba);
+   }
 
    cp = cp0;
    for (Int_t irow = 0; irow < this->fNrows; irow++) {
@@ -1280,7 +1245,6 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixTSym<Element
 
    if (isAllocated)
       delete [] bap;
-#endif
 
    return *this;
 }
@@ -1352,18 +1316,6 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::SimilarityT(const TMatrixT<Element>
    if (ncolsb != this->fNcols)
       this->ResizeTo(ncolsb,ncolsb);
 
-#ifdef CBLAS
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,this->fNrows,this->fNcols,bta.GetNcols(),
-                   1.0,btap,bta.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,this->fNrows,this->fNcols,bta.GetNcols(),
-                   1.0,btap,bta.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else
-      Error("similarityT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nbta     = bta.GetNoElements();
    const Int_t nb       = b.GetNoElements();
    const Int_t ncolsbta = bta.GetNcols();
@@ -1400,7 +1352,6 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::SimilarityT(const TMatrixT<Element>
          cp[rowOff1+icol] = cp[rowOff2+irow];
       }
    }
-#endif
 
    if (isAllocated)
       delete [] btap;
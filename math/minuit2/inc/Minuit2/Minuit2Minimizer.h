@@ -48,6 +48,14 @@ namespace Minuit2 {
    Refer to the [guide](https://root.cern.ch/root/htmldoc/guides/minuit2/Minuit2.html) for an introduction how Minuit
    works.
 
+   If the FCN is thread safe, the numerical gradient and the off-diagonal elements of the Hessian can be computed
+   in parallel with the threads of the ROOT IMT pool, setting the extra option "NThreads" (0 for all the threads of
+   the pool, see also MnStrategy::SetNThreads):
+
+   ~~~ {.cpp}
+   ROOT::Math::MinimizerOptions::Default("Minuit2").SetValue("NThreads", 8);
+   ~~~
+
    @ingroup Minuit
 */
 class Minuit2Minimizer : public ROOT::Math::Minimizer {
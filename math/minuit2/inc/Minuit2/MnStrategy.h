@@ -48,6 +48,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int NThreads() const { return fNThreads; }
+
    bool IsLow() const { return fStrategy == 0; }
    bool IsMedium() const { return fStrategy == 1; }
    bool IsHigh() const { return fStrategy >= 2; }
@@ -69,6 +71,11 @@ public:
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
 
+   // set number of threads of the ROOT IMT pool used for the numerical gradient and the off-diagonal
+   // elements of the Hessian, 0 for all threads of the pool; the FCN must then be thread safe
+   // 1 = compute them serially (default), ignored if ROOT is built without IMT
+   void SetNThreads(unsigned int nthreads) { fNThreads = nthreads; }
+
 private:
    unsigned int fStrategy;
 
@@ -80,6 +87,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   unsigned int fNThreads;
 };
 
 } // namespace Minuit2
@@ -494,6 +494,11 @@ bool Minuit2Minimizer::Minimize()
       strategy.SetHessianStepTolerance(hessStepTol);
       strategy.SetHessianG2Tolerance(hessStepTol);
 
+      // threads of the IMT pool used for the numerical gradient and Hessian
+      int nThreads = strategy.NThreads();
+      if (minuit2Opt->GetValue("NThreads", nThreads))
+         strategy.SetNThreads(nThreads);
+
       int storageLevel = 1;
       bool ret = minuit2Opt->GetValue("StorageLevel", storageLevel);
       if (ret)
@@ -1207,7 +1212,12 @@ bool Minuit2Minimizer::Hesse()
    if (Precision() > 0)
       fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse(strategy);
+   ROOT::Minuit2::MnStrategy hesseStrategy(strategy);
+   ROOT::Math::IOptions *minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   int nThreads = 1;
+   if (minuit2Opt && minuit2Opt->GetValue("NThreads", nThreads))
+      hesseStrategy.SetNThreads(nThreads);
+   ROOT::Minuit2::MnHesse hesse(hesseStrategy);
 
    // case when function minimum exists
    if (fMinimum) {
@@ -20,6 +20,7 @@
 #include "Minuit2/FunctionMinimum.h"
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/MPIProcess.h"
+#include "MnParallelFor.h"
 
 namespace ROOT {
 
@@ -241,31 +242,45 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
       unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
       unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-      unsigned int offsetVect = 0;
-      for (unsigned int in = 0; in < startParIndexOffDiagonal; in++)
-         if ((in + offsetVect) % (n - 1) == 0)
-            offsetVect += (in + offsetVect) / (n - 1);
+      // if this process computes all the elements, every row of them can be a task of the IMT pool
+      auto offDiagonalRow = [&](unsigned int i) {
+         MnAlgebraicVector xi = x;
+         xi(i) += dirin(i);
+         for (unsigned int j = i + 1; j < n; j++) {
+            xi(j) += dirin(j);
+            double fs1 = mfcn(xi);
+            vhmat(i, j) = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+            xi(j) -= dirin(j);
+         }
+      };
+      const bool allElements = startParIndexOffDiagonal == 0 && endParIndexOffDiagonal == n * (n - 1) / 2;
+      if (!allElements || !MnParallelFor(n - 1, fStrategy.NThreads(), offDiagonalRow)) {
+         unsigned int offsetVect = 0;
+         for (unsigned int in = 0; in < startParIndexOffDiagonal; in++)
+            if ((in + offsetVect) % (n - 1) == 0)
+               offsetVect += (in + offsetVect) / (n - 1);
 
-      for (unsigned int in = startParIndexOffDiagonal; in < endParIndexOffDiagonal; in++) {
+         for (unsigned int in = startParIndexOffDiagonal; in < endParIndexOffDiagonal; in++) {
 
-         int i = (in + offsetVect) / (n - 1);
-         if ((in + offsetVect) % (n - 1) == 0)
-            offsetVect += i;
-         int j = (in + offsetVect) % (n - 1) + 1;
+            int i = (in + offsetVect) / (n - 1);
+            if ((in + offsetVect) % (n - 1) == 0)
+               offsetVect += i;
+            int j = (in + offsetVect) % (n - 1) + 1;
 
-         if ((i + 1) == j || in == startParIndexOffDiagonal)
-            x(i) += dirin(i);
+            if ((i + 1) == j || in == startParIndexOffDiagonal)
+               x(i) += dirin(i);
 
-         x(j) += dirin(j);
+            x(j) += dirin(j);
 
-         double fs1 = mfcn(x);
-         double elem = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
-         vhmat(i, j) = elem;
+            double fs1 = mfcn(x);
+            double elem = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+            vhmat(i, j) = elem;
 
-         x(j) -= dirin(j);
+            x(j) -= dirin(j);
 
-         if (j % (n - 1) == 0 || in == endParIndexOffDiagonal - 1)
-            x(i) -= dirin(i);
+            if (j % (n - 1) == 0 || in == endParIndexOffDiagonal - 1)
+               x(i) -= dirin(i);
+         }
       }
 
       mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
@@ -0,0 +1,50 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnParallelFor
+#define ROOT_Minuit2_MnParallelFor
+
+// R__USE_IMT is only known when Minuit2 is built as part of ROOT
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+/// Call func(i) for i in [0, n) as tasks of the ROOT IMT pool, using nThreads threads (0 for all the threads of
+/// the pool). Returns false without calling func if nThreads is 1 or ROOT is built without IMT, the caller must
+/// then do the loop itself.
+template <class F>
+bool MnParallelFor(unsigned int n, unsigned int nThreads, F func)
+{
+#ifdef R__USE_IMT
+   if (nThreads == 1 || n < 2)
+      return false;
+   ROOT::TThreadExecutor pool(nThreads);
+   pool.Foreach(func, ROOT::TSeq<unsigned int>(n));
+   return true;
+#else
+   (void)n;
+   (void)nThreads;
+   (void)func;
+   return false;
+#endif
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_MnParallelFor
@@ -26,6 +26,7 @@
 #include <iomanip>
 
 #include "Minuit2/MPIProcess.h"
+#include "MnParallelFor.h"
 
 namespace ROOT {
 
@@ -97,35 +98,8 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 
    print.Debug("Calculating gradient around value", fcnmin, "at point", par.Vec());
 
-#ifndef _OPENMP
-
-   MPIProcess mpiproc(n, 0);
-
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
-   // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-   //#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for (int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef _OPENMP
-      // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
+   // compute the derivative along the parameter i; x is the point, restored on return
+   auto derivative = [&](unsigned int i, MnAlgebraicVector &x, MnPrint &print) {
       double xtf = x(i);
       double epspri = eps2 + std::fabs(grd(i) * eps2);
       double stepb4 = 0.;
@@ -173,10 +147,6 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 #pragma omp critical
 #endif
          {
-#ifdef _OPENMP
-            // must create thread-local MnPrint instances when printing inside threads
-            MnPrint print("Numerical2PGradientCalculator[OpenMP]");
-#endif
             if (i == 0 && j == 0) {
                print.Debug([&](std::ostream &os) {
                   os << std::setw(10) << "parameter" << std::setw(6) << "cycle" << std::setw(15) << "x" << std::setw(15)
@@ -205,8 +175,47 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
       //     vgrd(i) = grd;
       //     vgrd2(i) = g2;
       //     vgstp(i) = gstep;
+   };
+
+#ifndef _OPENMP
+
+   MPIProcess mpiproc(n, 0);
+
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   // the parameters are independent of each other, so they can be tasks of the IMT pool
+   // every task needs its own point and, for printing inside threads, its own MnPrint instance
+   auto derivativeTask = [&](unsigned int k) {
+      MnAlgebraicVector x = par.Vec();
+      MnPrint printTask("Numerical2PGradientCalculator[threads]");
+      derivative(startElementIndex + k, x, printTask);
+   };
+   if (!MnParallelFor(endElementIndex - startElementIndex, fStrategy.NThreads(), derivativeTask)) {
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++)
+         derivative(i, x, print);
+   }
+
+#else
+
+   // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+   //#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+   for (int i = 0; i < int(n); i++) {
+      // create in loop since each thread will use its own copy
+      MnAlgebraicVector x = par.Vec();
+      // must create thread-local MnPrint instances when printing inside threads
+      MnPrint printThread("Numerical2PGradientCalculator[OpenMP]");
+      derivative(i, x, printThread);
    }
 
+#endif
+
 #ifndef _OPENMP
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(g2);
@@ -12,6 +12,7 @@
 #include "Minuit2/MnUserParameterState.h"
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
 #include "Minuit2/MnMinos.h"
 #include "Minuit2/MnPlot.h"
 #include "Minuit2/MinosError.h"
@@ -26,6 +27,9 @@
 // The default number of dimension is 20 (fit in 40 parameters) on 1000 data events.
 // One can change the dimension and the number of events by doing:
 // ./test_Minuit2_Parallel    ndim  nevents
+// Without OpenMP, the fit is repeated computing the numerical gradient and Hessian with nthreads
+// threads of the ROOT IMT pool (MnStrategy::SetNThreads), the default is 4:
+// ./test_Minuit2_Parallel    ndim  nevents  nthreads
 
 using namespace ROOT::Minuit2;
 
@@ -72,7 +76,7 @@ struct LogLikeFCN : public FCNBase {
    const Data &fData;
 };
 
-int doFit(int ndim, int ndata)
+int doFit(int ndim, int ndata, unsigned int nthreads)
 {
 
    // generate the data (1000 data points) in 100 dimension
@@ -119,6 +123,16 @@ int doFit(int ndim, int ndata)
    // output
    std::cout << "minimum: " << min << std::endl;
 
+   // same minimization, computing numerical gradient and Hessian with threads
+   MnStrategy strategy(1);
+   strategy.SetNThreads(nthreads);
+   FunctionMinimum minThreads = fMinimizer.Minimize(fcn, MnUserParameterState(init_par, init_err), strategy);
+   std::cout << "minimum with " << nthreads << " threads: " << minThreads << std::endl;
+   if (minThreads.IsValid() != min.IsValid() || std::fabs(minThreads.Fval() - min.Fval()) > 1.E-6 * std::fabs(min.Fval())) {
+      std::cerr << "Minimization with threads gives a different minimum" << std::endl;
+      return 1;
+   }
+
    //     // create MINOS Error factory
    //     MnMinos Minos(fFCN, min);
 
@@ -153,6 +167,10 @@ int main(int argc, char **argv)
    if (argc > 2) {
       ndata = atoi(argv[2]);
    }
+   unsigned int nthreads = 4;
+   if (argc > 3) {
+      nthreads = atoi(argv[3]);
+   }
    std::cout << "do fit of " << ndim << " dimensional data on " << ndata << " events " << std::endl;
-   doFit(ndim, ndata);
+   return doFit(ndim, ndata, nthreads);
 }
@@ -12,6 +12,8 @@
 
 #include "TLorentzVector.h"
 
+class TRandom;
+
 class TGenPhaseSpace : public TObject {
 private:
    Int_t        fNt;             // number of decay particles
@@ -22,6 +24,8 @@ private:
    TLorentzVector  fDecPro[18];  //kinematics of the generated particles
 
    Double_t PDK(Double_t a, Double_t b, Double_t c);
+   void     GenerateRange(Long64_t first, Long64_t nEvents, Long64_t stride, Double_t *weights, Double_t *px,
+                          Double_t *py, Double_t *pz, Double_t *e, TRandom &rng) const;
 
 public:
    TGenPhaseSpace(): fNt(0), fMass(), fBeta(), fTeCmTm(0.), fWtMax(0.) {}
@@ -33,6 +37,12 @@ public:
    Double_t        Generate();
    TLorentzVector *GetDecay(Int_t n);
 
+   Double_t        Generate(TRandom &rng, Double_t *px, Double_t *py, Double_t *pz, Double_t *e) const;
+   void            GenerateBatch(Long64_t nEvents, Double_t *weights, Double_t *px, Double_t *py, Double_t *pz,
+                                 Double_t *e, TRandom &rng) const;
+   void            GenerateBatch(Long64_t nEvents, Double_t *weights, Double_t *px, Double_t *py, Double_t *pz,
+                                 Double_t *e, ULong64_t seed) const;
+
    Int_t    GetNt()      const { return fNt;}
    Double_t GetWtMax()   const { return fWtMax;}
 
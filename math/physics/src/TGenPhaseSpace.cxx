@@ -18,14 +18,82 @@
 see example of use in PhaseSpace.C
 
 Note that Momentum, Energy units are Gev/C, GeV
+
+### Batch generation
+
+GenerateBatch() generates many events at once into arrays, without the
+TLorentzVector of GetDecay(): the momentum components and energy of
+particle n in event i are at index n * nEvents + i of the arrays px, py,
+pz and e, of size GetNt() * nEvents, and the weight of event i is
+weights[i]. The events are generated in blocks, one particle at a time for
+all the events of a block, so that the rotations and boosts are loops
+over contiguous arrays which the compiler vectorises. The generation does
+not modify the TGenPhaseSpace and can be called concurrently, with one
+random generator per thread:
+~~~ {.cpp}
+   TGenPhaseSpace gen;
+   gen.SetDecay(W, 3, masses);
+   std::vector<double> w(n), px(3 * n), py(3 * n), pz(3 * n), e(3 * n);
+   TRandomMixMax rng(1234);
+   gen.GenerateBatch(n, w.data(), px.data(), py.data(), pz.data(), e.data(), rng);
+~~~
+With a seed instead of a generator, the events are generated in chunks of
+fixed size, each with its own TRandomMixMax stream seeded with seed plus
+the chunk number. The chunks are processed in parallel when implicit
+multi-threading is enabled, and the events do not depend on the number of
+threads.
+
+The single event overload of Generate() taking a generator allows one to
+generate the events in an RDataFrame without entries, with one generator
+per processing slot:
+~~~ {.cpp}
+   ROOT::RDataFrame df(1000000000);
+   std::vector<std::unique_ptr<TRandomMixMax>> rngs;
+   for (unsigned int slot = 0; slot < df.GetNSlots(); ++slot)
+      rngs.emplace_back(new TRandomMixMax(slot + 1));
+   // px, py, pz and e of the three particles, then the weight
+   auto events = df.DefineSlot("event", [&](unsigned int slot) {
+                      ROOT::RVec<double> p(13);
+                      p[12] = gen.Generate(*rngs[slot], &p[0], &p[3], &p[6], &p[9]);
+                      return p;
+                   }).Define("weight", "event[12]");
+~~~
 */
 
 #include "TGenPhaseSpace.h"
 #include "TRandom.h"
+#include "TRandomGen.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 const Int_t kMAXP = 18;
 
+namespace {
+
+// Number of events generated together by GenerateBatch
+const Int_t kBlockSize = 64;
+// Number of events of the chunks generated with independent random streams
+const Long64_t kChunkSize = 65536;
+
+////////////////////////////////////////////////////////////////////////////////
+/// The PDK function, as TGenPhaseSpace::PDK.
+
+inline Double_t MomentumPDK(Double_t a, Double_t b, Double_t c)
+{
+   Double_t x = (a-b-c)*(a+b+c)*(a-b+c)*(a+b-c);
+   x = TMath::Sqrt(x)/(2*a);
+   return x;
+}
+
+} // namespace
+
 ClassImp(TGenPhaseSpace);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -167,6 +235,235 @@ Double_t TGenPhaseSpace::Generate()
    return wt;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the events first to first + nEvents - 1 of a batch with the
+/// random generator rng: the components of particle n in event i are at
+/// index n * stride + i of the arrays. The random numbers are used in the
+/// order of Generate(), one event after the other.
+
+void TGenPhaseSpace::GenerateRange(Long64_t first, Long64_t nEvents, Long64_t stride, Double_t *weights,
+                                   Double_t *px, Double_t *py, Double_t *pz, Double_t *e, TRandom &rng) const
+{
+   const Int_t nt = fNt;
+   if (nt < 2 || nEvents <= 0)
+      return;
+   // fNt-2 numbers for the invariant masses, then two per rotation
+   const Int_t nrnd = nt - 2 + 2 * (nt - 1);
+   const Int_t block = Int_t(TMath::Min(nEvents, Long64_t(kBlockSize)));
+
+   std::vector<Double_t> work(block * (nrnd + 2 * nt + 6));
+   Double_t *rnd = work.data();
+   Double_t *invMas = rnd + block * nrnd; // [nt][block]
+   Double_t *pd = invMas + block * nt;    // [nt][block]
+   Double_t *cZ = pd + block * nt;
+   Double_t *sZ = cZ + block;
+   Double_t *cY = sZ + block;
+   Double_t *sY = cY + block;
+   Double_t *gamma = sY + block;
+   Double_t *gamma2 = gamma + block;
+
+   // TLorentzVector::Boost of nb vectors, with the betas b and the factors g and g2 computed from them;
+   // the steps are 0 for a boost common to all the events
+   auto boost = [](Int_t nb, Double_t *x, Double_t *y, Double_t *z, Double_t *t, const Double_t *bx,
+                   const Double_t *by, const Double_t *bz, Int_t bstep, const Double_t *g, const Double_t *g2,
+                   Int_t gstep) {
+      for (Int_t ev = 0; ev < nb; ev++) {
+         const Double_t bxe = bx[ev * bstep], bye = by[ev * bstep], bze = bz[ev * bstep];
+         const Double_t ge = g[ev * gstep], g2e = g2[ev * gstep];
+         const Double_t bp = bxe * x[ev] + bye * y[ev] + bze * z[ev];
+         const Double_t te = t[ev];
+         x[ev] = x[ev] + g2e * bp * bxe + ge * bxe * te;
+         y[ev] = y[ev] + g2e * bp * bye + ge * bye * te;
+         z[ev] = z[ev] + g2e * bp * bze + ge * bze * te;
+         t[ev] = ge * (te + bp);
+      }
+   };
+
+   const Double_t zero = 0.;
+   const Double_t b2 = fBeta[0] * fBeta[0] + fBeta[1] * fBeta[1] + fBeta[2] * fBeta[2];
+   const Double_t finalGamma = 1.0 / TMath::Sqrt(1.0 - b2);
+   const Double_t finalGamma2 = b2 > 0 ? (finalGamma - 1.0) / b2 : 0.0;
+
+   for (Long64_t start = first; start < first + nEvents; start += block) {
+      const Int_t nb = Int_t(TMath::Min(Long64_t(block), first + nEvents - start));
+      rng.RndmArray(nb * nrnd, rnd);
+
+      // sort the numbers of the invariant masses, there are at most 16 of them
+      for (Int_t ev = 0; ev < nb; ev++) {
+         Double_t *r = rnd + ev * nrnd;
+         for (Int_t k = 1; k < nt - 2; k++) {
+            const Double_t v = r[k];
+            Int_t l = k;
+            for (; l > 0 && r[l - 1] > v; l--)
+               r[l] = r[l - 1];
+            r[l] = v;
+         }
+      }
+
+      Double_t sum = 0;
+      for (Int_t n = 0; n < nt; n++) {
+         sum += fMass[n];
+         Double_t *m = invMas + n * block;
+         if (n == 0) {
+            for (Int_t ev = 0; ev < nb; ev++)
+               m[ev] = sum;
+         } else if (n == nt - 1) {
+            for (Int_t ev = 0; ev < nb; ev++)
+               m[ev] = fTeCmTm + sum;
+         } else {
+            for (Int_t ev = 0; ev < nb; ev++)
+               m[ev] = rnd[ev * nrnd + n - 1] * fTeCmTm + sum;
+         }
+      }
+
+      //
+      //-----> compute the weights of the events
+      //
+      Double_t *wt = weights + start;
+      for (Int_t ev = 0; ev < nb; ev++)
+         wt[ev] = fWtMax;
+      for (Int_t n = 0; n < nt - 1; n++) {
+         const Double_t *m0 = invMas + n * block;
+         const Double_t *m1 = m0 + block;
+         Double_t *p = pd + n * block;
+         for (Int_t ev = 0; ev < nb; ev++) {
+            p[ev] = MomentumPDK(m1[ev], m0[ev], fMass[n + 1]);
+            wt[ev] *= p[ev];
+         }
+      }
+
+      //
+      //-----> complete specification of the events (Raubold-Lynch method)
+      //
+      Double_t *x0 = px + start, *y0 = py + start, *z0 = pz + start, *t0 = e + start;
+      for (Int_t ev = 0; ev < nb; ev++) {
+         x0[ev] = 0;
+         y0[ev] = pd[ev];
+         z0[ev] = 0;
+         t0[ev] = TMath::Sqrt(pd[ev] * pd[ev] + fMass[0] * fMass[0]);
+      }
+
+      for (Int_t i = 1; i < nt; i++) {
+         const Double_t *p = pd + (i - 1) * block;
+         Double_t *xi = px + i * stride + start, *yi = py + i * stride + start;
+         Double_t *zi = pz + i * stride + start, *ti = e + i * stride + start;
+         for (Int_t ev = 0; ev < nb; ev++) {
+            xi[ev] = 0;
+            yi[ev] = -p[ev];
+            zi[ev] = 0;
+            ti[ev] = TMath::Sqrt(p[ev] * p[ev] + fMass[i] * fMass[i]);
+         }
+
+         const Double_t *r = rnd + nt - 2 + 2 * (i - 1);
+         for (Int_t ev = 0; ev < nb; ev++) {
+            cZ[ev] = 2 * r[ev * nrnd] - 1;
+            sZ[ev] = TMath::Sqrt(1 - cZ[ev] * cZ[ev]);
+            const Double_t angY = 2 * TMath::Pi() * r[ev * nrnd + 1];
+            cY[ev] = TMath::Cos(angY);
+            sY[ev] = TMath::Sin(angY);
+         }
+         for (Int_t j = 0; j <= i; j++) {
+            Double_t *xj = px + j * stride + start, *yj = py + j * stride + start, *zj = pz + j * stride + start;
+            for (Int_t ev = 0; ev < nb; ev++) {
+               Double_t x = xj[ev];
+               const Double_t y = yj[ev];
+               xj[ev] = cZ[ev] * x - sZ[ev] * y;
+               yj[ev] = sZ[ev] * x + cZ[ev] * y; // rotation around Z
+               x = xj[ev];
+               const Double_t z = zj[ev];
+               xj[ev] = cY[ev] * x - sY[ev] * z;
+               zj[ev] = sY[ev] * x + cY[ev] * z; // rotation around Y
+            }
+         }
+
+         if (i == nt - 1)
+            break;
+
+         // boost along y, cZ is reused for the betas
+         const Double_t *pi = pd + i * block;
+         const Double_t *mi = invMas + i * block;
+         for (Int_t ev = 0; ev < nb; ev++) {
+            const Double_t beta = pi[ev] / TMath::Sqrt(pi[ev] * pi[ev] + mi[ev] * mi[ev]);
+            const Double_t bb = beta * beta;
+            cZ[ev] = beta;
+            gamma[ev] = 1.0 / TMath::Sqrt(1.0 - bb);
+            gamma2[ev] = bb > 0 ? (gamma[ev] - 1.0) / bb : 0.0;
+         }
+         for (Int_t j = 0; j <= i; j++) {
+            boost(nb, px + j * stride + start, py + j * stride + start, pz + j * stride + start,
+                  e + j * stride + start, &zero, cZ, &zero, 1, gamma, gamma2, 1);
+         }
+      }
+
+      //
+      //---> final boost of all particles
+      //
+      for (Int_t n = 0; n < nt; n++) {
+         boost(nb, px + n * stride + start, py + n * stride + start, pz + n * stride + start, e + n * stride + start,
+               &fBeta[0], &fBeta[1], &fBeta[2], 0, &finalGamma, &finalGamma2, 0);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate a random final state with the random generator rng, without
+/// modifying this object: this can be called concurrently with different
+/// generators. The momentum components and energy of particle n are written
+/// to px[n], py[n], pz[n] and e[n], the arrays having GetNt() elements. The
+/// function returns the weight of the event.
+
+Double_t TGenPhaseSpace::Generate(TRandom &rng, Double_t *px, Double_t *py, Double_t *pz, Double_t *e) const
+{
+   Double_t wt = 0;
+   GenerateRange(0, 1, 1, &wt, px, py, pz, e, rng);
+   return wt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate nEvents random final states with the random generator rng,
+/// without modifying this object. The weight of event i is written to
+/// weights[i], and the momentum components and energy of its particle n to
+/// index n * nEvents + i of the arrays px, py, pz and e, which must have
+/// GetNt() * nEvents elements. The events are the ones of nEvents calls of
+/// Generate() with the same generator, up to rounding differences.
+
+void TGenPhaseSpace::GenerateBatch(Long64_t nEvents, Double_t *weights, Double_t *px, Double_t *py, Double_t *pz,
+                                   Double_t *e, TRandom &rng) const
+{
+   GenerateRange(0, nEvents, nEvents, weights, px, py, pz, e, rng);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate nEvents random final states into the arrays, with the layout of
+/// the GenerateBatch() overload taking a generator. The events are generated
+/// in chunks of 65536 events, chunk k with a TRandomMixMax of seed
+/// seed + k, so that the chunks are independent streams. They are generated
+/// in parallel when implicit multi-threading is enabled, with the same
+/// results as without. The seed must be positive.
+
+void TGenPhaseSpace::GenerateBatch(Long64_t nEvents, Double_t *weights, Double_t *px, Double_t *py, Double_t *pz,
+                                   Double_t *e, ULong64_t seed) const
+{
+   if (nEvents <= 0)
+      return;
+   const Long64_t nChunks = (nEvents + kChunkSize - 1) / kChunkSize;
+   auto generateChunk = [&](Long64_t chunk) {
+      TRandomMixMax rng(seed + chunk);
+      const Long64_t first = chunk * kChunkSize;
+      GenerateRange(first, TMath::Min(kChunkSize, nEvents - first), nEvents, weights, px, py, pz, e, rng);
+   };
+
+#ifdef R__USE_IMT
+   if (nChunks > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(generateChunk, ROOT::TSeq<Long64_t>(nChunks));
+      return;
+   }
+#endif
+   for (Long64_t chunk = 0; chunk < nChunks; chunk++)
+      generateChunk(chunk);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return Lorentz vector corresponding to decay n
 
@@ -200,6 +200,25 @@ public:
    */
    int SampleDiscr();
 
+   /**
+      Sample n values of a 1D distribution, written in x.
+      It returns false if the generator is not initialized.
+   */
+   bool Sample(double * x, unsigned int n);
+
+   /**
+      Sample n points of a multidimensional distribution, written in x one point after
+      the other: x must have a size of at least n times the distribution dimension.
+      It returns false if the generator is not initialized.
+   */
+   bool SampleMulti(double * x, unsigned int n);
+
+   /**
+      Sample n values of a discrete distribution, written in x.
+      It returns false if the generator is not initialized.
+   */
+   bool SampleDiscr(int * x, unsigned int n);
+
    /**
       set the random engine.
       Must be called before init to have effect
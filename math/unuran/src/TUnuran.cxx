@@ -397,6 +397,34 @@ bool TUnuran::SampleMulti(double * x)
    return true;
 }
 
+bool TUnuran::Sample(double * x, unsigned int n)
+{
+   // sample n values of a one-dimensional distribution
+   if (fGen == 0) return false;
+   for (unsigned int i = 0; i < n; ++i)
+      x[i] = unur_sample_cont(fGen);
+   return true;
+}
+
+bool TUnuran::SampleMulti(double * x, unsigned int n)
+{
+   // sample n points of a multidimensional distribution
+   if (fGen == 0) return false;
+   const int dim = unur_get_dimension(fGen);
+   for (unsigned int i = 0; i < n; ++i)
+      unur_sample_vec(fGen, x + size_t(i) * dim);
+   return true;
+}
+
+bool TUnuran::SampleDiscr(int * x, unsigned int n)
+{
+   // sample n values of a discrete distribution
+   if (fGen == 0) return false;
+   for (unsigned int i = 0; i < n; ++i)
+      x[i] = unur_sample_discr(fGen);
+   return true;
+}
+
 void TUnuran::SetSeed(unsigned int seed) {
    return fRng->SetSeed(seed);
 }
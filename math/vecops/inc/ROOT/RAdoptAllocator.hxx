@@ -11,6 +11,7 @@
 #ifndef ROOT_TADOPTALLOCATOR
 #define ROOT_TADOPTALLOCATOR
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 
@@ -18,6 +19,14 @@ namespace ROOT {
 namespace Detail {
 namespace VecOps {
 
+/// Largest block, in bytes, served by the thread-local cache of RAdoptAllocator
+constexpr std::size_t kMaxCachedBlockSize = 1024;
+/// Return a block of at least `bytes` bytes (at most kMaxCachedBlockSize), reusing a block
+/// released by the same thread if possible
+void *AllocateCachedBlock(std::size_t bytes);
+/// Give back a block obtained from AllocateCachedBlock with the same size
+void DeallocateCachedBlock(void *p, std::size_t bytes);
+
 /**
 \class ROOT::Detail::VecOps::RAdoptAllocator
 \ingroup vecops
@@ -45,6 +54,10 @@ Upon a second allocation, the vector *v* ceases to be a proxy
 v.emplace_back(0.);
 ~~~
 now the vector *v* owns its memory as a regular vector.
+
+The memory owned by the allocator, if smaller than kMaxCachedBlockSize, comes from a thread-local
+cache of blocks: the temporary collections created and destroyed for each entry of a dataset
+then reuse the same few blocks instead of calling malloc and free each time.
 **/
 
 template <typename T>
@@ -74,6 +87,12 @@ private:
    EAllocType fAllocType = EAllocType::kOwning;
    StdAlloc_t fStdAllocator;
 
+   /// Whether n objects fit in a block of the cache, which is aligned as by malloc
+   static constexpr bool UseBlockCache(std::size_t n)
+   {
+      return alignof(T) <= alignof(std::max_align_t) && n * sizeof(T) <= kMaxCachedBlockSize;
+   }
+
 public:
    /// This is the constructor which allows the allocator to adopt a certain memory region.
    RAdoptAllocator(pointer p) : fInitialAddress(p), fAllocType(EAllocType::kAdoptingNoAllocYet){};
@@ -111,13 +130,19 @@ public:
          return fInitialAddress;
       }
       fAllocType = EAllocType::kOwning;
+      if (UseBlockCache(n))
+         return static_cast<pointer>(AllocateCachedBlock(n * sizeof(T)));
       return StdAllocTraits_t::allocate(fStdAllocator, n);
    }
 
    /// \brief Dellocate some memory if that had not been adopted.
    void deallocate(pointer p, std::size_t n)
    {
-      if (p != fInitialAddress)
+      if (p == fInitialAddress)
+         return;
+      if (UseBlockCache(n))
+         DeallocateCachedBlock(p, n * sizeof(T));
+      else
          StdAllocTraits_t::deallocate(fStdAllocator, p, n);
    }
 
@@ -0,0 +1,207 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RLORENTZVECTORS
+#define ROOT_RLORENTZVECTORS
+
+#include <ROOT/RVec.hxx>
+
+#include <TError.h> // R__ASSERT
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace ROOT {
+namespace VecOps {
+
+/**
+\class ROOT::VecOps::RLorentzVectors
+\ingroup vecops
+\brief A collection of four-vectors stored as structure of arrays.
+\tparam T The floating point type of the components.
+
+RLorentzVectors keeps the (pt, eta, phi, mass) components of a collection of
+four-vectors in four RVecs, the way they are read from the columns of a dataset,
+instead of an RVec of ROOT::Math::PtEtaPhiMVector. The kinematic calculations
+(conversion to cartesian components, invariant masses, boosts, \f$\Delta R\f$)
+loop over the components with no temporary four-vector per element, in loops
+without branches that the compiler can vectorize.
+
+Example code, in an RDataFrame analysis:
+~~~{.cpp}
+using namespace ROOT::VecOps;
+auto df2 = df.Define("muons", [](const RVec<float> &pt, const RVec<float> &eta, const RVec<float> &phi,
+                                 const RVec<float> &m) { return RLorentzVectors<float>(pt, eta, phi, m); },
+                     {"Muon_pt", "Muon_eta", "Muon_phi", "Muon_mass"})
+              .Define("muons_px", "muons.Px()");
+~~~
+**/
+template <typename T>
+class RLorentzVectors {
+   RVec<T> fPt;
+   RVec<T> fEta;
+   RVec<T> fPhi;
+   RVec<T> fMass;
+
+public:
+   using size_type = typename RVec<T>::size_type;
+
+   RLorentzVectors() = default;
+
+   /// Build the collection from the components of the four-vectors
+   RLorentzVectors(RVec<T> pt, RVec<T> eta, RVec<T> phi, RVec<T> mass)
+      : fPt(std::move(pt)), fEta(std::move(eta)), fPhi(std::move(phi)), fMass(std::move(mass))
+   {
+      const auto size = fPt.size();
+      R__ASSERT(fEta.size() == size && fPhi.size() == size && fMass.size() == size);
+   }
+
+   /// Build the collection from the cartesian components (px, py, pz, E) of the four-vectors
+   static RLorentzVectors FromPxPyPzE(const RVec<T> &px, const RVec<T> &py, const RVec<T> &pz, const RVec<T> &e)
+   {
+      const auto size = px.size();
+      R__ASSERT(py.size() == size && pz.size() == size && e.size() == size);
+
+      RLorentzVectors v;
+      v.fPt.resize(size);
+      v.fEta.resize(size);
+      v.fPhi.resize(size);
+      v.fMass.resize(size);
+      for (size_type i = 0u; i < size; ++i) {
+         v.Set(i, px[i], py[i], pz[i], e[i]);
+      }
+      return v;
+   }
+
+   size_type size() const { return fPt.size(); }
+   bool empty() const { return fPt.empty(); }
+
+   const RVec<T> &Pt() const { return fPt; }
+   const RVec<T> &Eta() const { return fEta; }
+   const RVec<T> &Phi() const { return fPhi; }
+   const RVec<T> &M() const { return fMass; }
+
+   /// Return the x components of the momenta
+   RVec<T> Px() const
+   {
+      RVec<T> r(size());
+      for (size_type i = 0u; i < size(); ++i)
+         r[i] = fPt[i] * std::cos(fPhi[i]);
+      return r;
+   }
+
+   /// Return the y components of the momenta
+   RVec<T> Py() const
+   {
+      RVec<T> r(size());
+      for (size_type i = 0u; i < size(); ++i)
+         r[i] = fPt[i] * std::sin(fPhi[i]);
+      return r;
+   }
+
+   /// Return the z components of the momenta
+   RVec<T> Pz() const
+   {
+      RVec<T> r(size());
+      for (size_type i = 0u; i < size(); ++i)
+         r[i] = fPt[i] * std::sinh(fEta[i]);
+      return r;
+   }
+
+   /// Return the energies
+   RVec<T> E() const
+   {
+      RVec<T> r(size());
+      for (size_type i = 0u; i < size(); ++i) {
+         const auto p = fPt[i] * std::cosh(fEta[i]);
+         r[i] = std::sqrt(p * p + fMass[i] * fMass[i]);
+      }
+      return r;
+   }
+
+   /// Return the invariant masses of the pairs made of the i-th vector of this collection and
+   /// of the i-th vector of other, see also ROOT::VecOps::InvariantMasses
+   RVec<T> InvariantMasses(const RLorentzVectors &other) const
+   {
+      return ROOT::VecOps::InvariantMasses(fPt, fEta, fPhi, fMass, other.fPt, other.fEta, other.fPhi, other.fMass);
+   }
+
+   /// Return the invariant mass of the sum of all the vectors of the collection
+   T InvariantMass() const { return ROOT::VecOps::InvariantMass(fPt, fEta, fPhi, fMass); }
+
+   /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane between the i-th vector of this
+   /// collection and the i-th vector of other
+   RVec<T> DeltaR(const RLorentzVectors &other) const
+   {
+      return ROOT::VecOps::DeltaR(fEta, other.fEta, fPhi, other.fPhi);
+   }
+
+   /// Return the vectors boosted by the velocity (bx, by, bz), in units of c.
+   /// The boost is the same as the one of ROOT::Math::Boost.
+   RLorentzVectors Boost(T bx, T by, T bz) const
+   {
+      const T b2 = bx * bx + by * by + bz * bz;
+      R__ASSERT(b2 < 1);
+      const T gamma = 1 / std::sqrt(1 - b2);
+      const T gamma2 = b2 > 0 ? (gamma - 1) / b2 : T(0);
+
+      RLorentzVectors v;
+      v.fPt.resize(size());
+      v.fEta.resize(size());
+      v.fPhi.resize(size());
+      v.fMass.resize(size());
+      for (size_type i = 0u; i < size(); ++i) {
+         const auto x = fPt[i] * std::cos(fPhi[i]);
+         const auto y = fPt[i] * std::sin(fPhi[i]);
+         const auto z = fPt[i] * std::sinh(fEta[i]);
+         const auto p = fPt[i] * std::cosh(fEta[i]);
+         const auto e = std::sqrt(p * p + fMass[i] * fMass[i]);
+
+         const auto bp = bx * x + by * y + bz * z;
+         v.Set(i, x + gamma2 * bp * bx + gamma * bx * e, y + gamma2 * bp * by + gamma * by * e,
+               z + gamma2 * bp * bz + gamma * bz * e, gamma * (e + bp));
+      }
+      // the mass does not change, keep it exactly
+      v.fMass = fMass;
+      return v;
+   }
+
+private:
+   /// Set the i-th vector from its cartesian components, with the conventions of ROOT::Math::PtEtaPhiM4D
+   void Set(size_type i, T px, T py, T pz, T e)
+   {
+      // value of eta for a vector along the z axis, as in ROOT::Math::Impl::Eta_FromRhoZ
+      const T etaMax = 22756;
+      const auto pt = std::sqrt(px * px + py * py);
+      const auto m2 = e * e - px * px - py * py - pz * pz;
+      fPt[i] = pt;
+      fPhi[i] = (px == 0 && py == 0) ? T(0) : std::atan2(py, px);
+      fEta[i] = pt > 0 ? std::asinh(pz / pt) : (pz == 0 ? T(0) : (pz > 0 ? pz + etaMax : pz - etaMax));
+      fMass[i] = m2 >= 0 ? std::sqrt(m2) : -std::sqrt(-m2);
+   }
+};
+
+/// Return the invariant masses of the pairs made of the i-th vectors of v1 and v2
+template <typename T>
+RVec<T> InvariantMasses(const RLorentzVectors<T> &v1, const RLorentzVectors<T> &v2)
+{
+   return v1.InvariantMasses(v2);
+}
+
+/// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane between the i-th vectors of v1 and v2
+template <typename T>
+RVec<T> DeltaR(const RLorentzVectors<T> &v1, const RLorentzVectors<T> &v2)
+{
+   return v1.DeltaR(v2);
+}
+
+} // namespace VecOps
+} // namespace ROOT
+
+#endif
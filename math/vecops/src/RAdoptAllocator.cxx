@@ -1 +1,81 @@
 #include <ROOT/RAdoptAllocator.hxx>
+
+#include <new>
+#include <vector>
+
+namespace {
+
+// Blocks have sizes of 32, 64, ..., kMaxCachedBlockSize bytes
+constexpr std::size_t kMinBlockSize = 32;
+constexpr int kNSizeClasses = 6;
+static_assert((kMinBlockSize << (kNSizeClasses - 1)) == ROOT::Detail::VecOps::kMaxCachedBlockSize,
+              "size classes must cover the blocks up to kMaxCachedBlockSize");
+// Number of free blocks kept per size class and per thread
+constexpr std::size_t kMaxFreeBlocks = 64;
+
+int SizeClass(std::size_t bytes)
+{
+   int c = 0;
+   while ((kMinBlockSize << c) < bytes)
+      ++c;
+   return c;
+}
+
+struct RBlockCache {
+   std::vector<void *> fFree[kNSizeClasses];
+   RBlockCache();
+   ~RBlockCache();
+};
+
+enum class ECacheState : char { kNotCreated, kAlive, kDestroyed };
+// Plain thread-local flag, still usable while the objects with static storage are destroyed,
+// after the cache of the main thread
+thread_local ECacheState gCacheState = ECacheState::kNotCreated;
+
+RBlockCache::RBlockCache()
+{
+   for (auto &blocks : fFree)
+      blocks.reserve(kMaxFreeBlocks);
+   gCacheState = ECacheState::kAlive;
+}
+
+RBlockCache::~RBlockCache()
+{
+   gCacheState = ECacheState::kDestroyed;
+   for (auto &blocks : fFree)
+      for (void *p : blocks)
+         ::operator delete(p);
+}
+
+RBlockCache *GetCache()
+{
+   if (gCacheState == ECacheState::kDestroyed)
+      return nullptr;
+   thread_local RBlockCache cache;
+   return &cache;
+}
+
+} // anonymous namespace
+
+void *ROOT::Detail::VecOps::AllocateCachedBlock(std::size_t bytes)
+{
+   const int c = SizeClass(bytes);
+   RBlockCache *cache = GetCache();
+   if (cache && !cache->fFree[c].empty()) {
+      void *p = cache->fFree[c].back();
+      cache->fFree[c].pop_back();
+      return p;
+   }
+   return ::operator new(kMinBlockSize << c);
+}
+
+void ROOT::Detail::VecOps::DeallocateCachedBlock(void *p, std::size_t bytes)
+{
+   const int c = SizeClass(bytes);
+   RBlockCache *cache = GetCache();
+   if (cache && cache->fFree[c].size() < kMaxFreeBlocks) {
+      cache->fFree[c].push_back(p);
+      return;
+   }
+   ::operator delete(p);
+}
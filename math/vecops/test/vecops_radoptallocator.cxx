@@ -98,3 +98,27 @@ TEST(RAdoptAllocator, Traits)
 
 }
 
+
+TEST(RAdoptAllocator, BlockCache)
+{
+   std::vector<double> vmodel{1., 2., 3.};
+   const double *data = nullptr;
+   {
+      std::vector<double, RAdoptAllocator<double>> v(8, 1.);
+      data = v.data();
+   }
+   // a temporary of similar size reuses the block released by the previous one
+   std::vector<double, RAdoptAllocator<double>> v1(7, 2.);
+   EXPECT_EQ(data, v1.data());
+
+   // no caching for large blocks, and adopted memory is never released to the cache
+   std::vector<double, RAdoptAllocator<double>> v2(kMaxCachedBlockSize, 3.);
+   RAdoptAllocator<double> alloc(vmodel.data());
+   {
+      std::vector<double, RAdoptAllocator<double>> v3(vmodel.size(), 0., alloc);
+      EXPECT_EQ(vmodel.data(), v3.data());
+   }
+   std::vector<double, RAdoptAllocator<double>> v4(3, 4.);
+   EXPECT_NE(vmodel.data(), v4.data());
+   EXPECT_EQ(1., vmodel[0]);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <ROOT/RLorentzVectors.hxx>
+#include <ROOT/RVec.hxx>
+#include <Math/Vector3D.h>
+#include <Math/Vector4D.h>
+#include <Math/VectorUtil.h>
+
+using namespace ROOT::VecOps;
+using ROOT::Math::PtEtaPhiMVector;
+
+namespace {
+
+RLorentzVectors<double> MakeVectors()
+{
+   RVec<double> pt = {1, 5, 5, 10, 10, 0};
+   RVec<double> eta = {0.0, 0.1, -1.0, 0.5, 2.5, 0.0};
+   RVec<double> phi = {0.0, 0.0, 3.1, -0.5, -2.4, 0.0};
+   RVec<double> mass = {50, 0.1, 40, 50, 100, 0.5};
+   return RLorentzVectors<double>(pt, eta, phi, mass);
+}
+
+PtEtaPhiMVector Get(const RLorentzVectors<double> &v, std::size_t i)
+{
+   return PtEtaPhiMVector(v.Pt()[i], v.Eta()[i], v.Phi()[i], v.M()[i]);
+}
+
+} // namespace
+
+TEST(RLorentzVectors, Cartesian)
+{
+   const auto v = MakeVectors();
+   const auto px = v.Px();
+   const auto py = v.Py();
+   const auto pz = v.Pz();
+   const auto e = v.E();
+   ASSERT_EQ(v.size(), px.size());
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      const auto ref = Get(v, i);
+      EXPECT_NEAR(ref.Px(), px[i], 1e-9);
+      EXPECT_NEAR(ref.Py(), py[i], 1e-9);
+      EXPECT_NEAR(ref.Pz(), pz[i], 1e-9);
+      EXPECT_NEAR(ref.E(), e[i], 1e-9);
+   }
+
+   // back to (pt, eta, phi, mass)
+   const auto v2 = RLorentzVectors<double>::FromPxPyPzE(px, py, pz, e);
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      EXPECT_NEAR(v.Pt()[i], v2.Pt()[i], 1e-9);
+      EXPECT_NEAR(v.Eta()[i], v2.Eta()[i], 1e-9);
+      EXPECT_NEAR(v.Phi()[i], v2.Phi()[i], 1e-9);
+      EXPECT_NEAR(v.M()[i], v2.M()[i], 1e-6);
+   }
+}
+
+TEST(RLorentzVectors, InvariantMassAndDeltaR)
+{
+   const auto v1 = MakeVectors();
+   const auto v2 = v1.Boost(0.1, -0.2, 0.3);
+
+   const auto masses = InvariantMasses(v1, v2);
+   const auto dr = DeltaR(v1, v2);
+   PtEtaPhiMVector sum;
+   for (std::size_t i = 0; i < v1.size(); ++i) {
+      EXPECT_NEAR((Get(v1, i) + Get(v2, i)).M(), masses[i], 1e-6);
+      EXPECT_NEAR(ROOT::Math::VectorUtil::DeltaR(Get(v1, i), Get(v2, i)), dr[i], 1e-9);
+      sum += Get(v1, i);
+   }
+   EXPECT_NEAR(sum.M(), v1.InvariantMass(), 1e-6);
+}
+
+TEST(RLorentzVectors, Boost)
+{
+   const auto v = MakeVectors();
+   const ROOT::Math::XYZVector beta(0.1, -0.2, 0.3);
+   const auto boosted = v.Boost(beta.X(), beta.Y(), beta.Z());
+   ASSERT_EQ(v.size(), boosted.size());
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      const auto ref = ROOT::Math::VectorUtil::boost(Get(v, i), beta);
+      const auto res = Get(boosted, i);
+      EXPECT_NEAR(ref.Px(), res.Px(), 1e-9);
+      EXPECT_NEAR(ref.Py(), res.Py(), 1e-9);
+      EXPECT_NEAR(ref.Pz(), res.Pz(), 1e-9);
+      EXPECT_NEAR(ref.E(), res.E(), 1e-9);
+      EXPECT_EQ(v.M()[i], boosted.M()[i]);
+   }
+
+   // no boost
+   const auto same = v.Boost(0, 0, 0);
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      EXPECT_NEAR(v.Pt()[i], same.Pt()[i], 1e-9);
+      EXPECT_NEAR(v.Eta()[i], same.Eta()[i], 1e-9);
+      EXPECT_NEAR(v.Phi()[i], same.Phi()[i], 1e-9);
+   }
+}
@@ -28,7 +28,8 @@ struct RDavixFileDes;
 
 The RRawFileDavix class provides read-only access to remote non-ROOT files.  It uses the Davix library for
 the transport layer.  It instructs the RRawFile base class to buffer in larger chunks than the default for
-local files, assuming that remote file access has high(er) latency.
+local files, assuming that remote file access has high(er) latency.  Vector reads are sent as one multi-range
+request, or as Davix.ParallelReads concurrent single range requests if that setting is larger than one.
 
 */
 
@@ -36,6 +37,9 @@ class RRawFileDavix : public RRawFile {
 private:
    std::unique_ptr<Internal::RDavixFileDes> fFileDes;
 
+   /// Read the ranges with concurrent single range requests, see Davix.ParallelReads
+   void ReadVParallel(RIOVec *ioVec, unsigned int nReq);
+
 protected:
    void OpenImpl() final;
    size_t ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset) final;
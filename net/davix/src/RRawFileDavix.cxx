@@ -11,10 +11,16 @@
 
 #include "ROOT/RRawFileDavix.hxx"
 
+#include <TEnv.h>
 #include <TError.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <davix.hpp>
@@ -28,7 +34,7 @@ namespace ROOT {
 namespace Internal {
 
 struct RDavixFileDes {
-   RDavixFileDes() : fd(nullptr), pos(&ctx) {}
+   RDavixFileDes() : fd(nullptr), pos(&ctx), parallelReads(0) {}
    RDavixFileDes(const RDavixFileDes &) = delete;
    RDavixFileDes &operator=(const RDavixFileDes &) = delete;
    ~RDavixFileDes() = default;
@@ -36,6 +42,8 @@ struct RDavixFileDes {
    DAVIX_FD *fd;
    Davix::Context ctx;
    Davix::DavPosix pos;
+   /// Number of concurrent single range requests used by ReadV() instead of a multi-range request
+   int parallelReads;
 };
 
 } // namespace Internal
@@ -77,6 +85,8 @@ void ROOT::Internal::RRawFileDavix::OpenImpl()
    }
    if (fOptions.fBlockSize < 0)
       fOptions.fBlockSize = kDefaultBlockSize;
+   // Same setting as for TDavixFile
+   fFileDes->parallelReads = gEnv->GetValue("Davix.ParallelReads", 0);
 }
 
 size_t ROOT::Internal::RRawFileDavix::ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset)
@@ -91,6 +101,11 @@ size_t ROOT::Internal::RRawFileDavix::ReadAtImpl(void *buffer, size_t nbytes, st
 
 void ROOT::Internal::RRawFileDavix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
 {
+   if (fFileDes->parallelReads > 1 && nReq > 1) {
+      ReadVParallel(ioVec, nReq);
+      return;
+   }
+
    Davix::DavixError *davixErr = NULL;
    std::vector<Davix::DavIOVecInput> in(nReq);
    std::vector<Davix::DavIOVecOuput> out(nReq);
@@ -111,3 +126,40 @@ void ROOT::Internal::RRawFileDavix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
       ioVec[i].fOutBytes = out[i].diov_size;
    }
 }
+
+void ROOT::Internal::RRawFileDavix::ReadVParallel(RIOVec *ioVec, unsigned int nReq)
+{
+   std::atomic<unsigned int> next(0);
+   std::atomic<bool> failed(false);
+   std::mutex errorMutex;
+   std::string errorMsg;
+
+   auto readRanges = [&]() {
+      for (unsigned int i = next++; i < nReq && !failed; i = next++) {
+         Davix::DavixError *davixErr = nullptr;
+         auto retval = fFileDes->pos.pread(fFileDes->fd, ioVec[i].fBuffer, ioVec[i].fSize, ioVec[i].fOffset, &davixErr);
+         if (retval < 0) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!failed)
+               errorMsg = davixErr ? davixErr->getErrMsg() : std::string("unknown error");
+            failed = true;
+            Davix::DavixError::clearError(&davixErr);
+         } else {
+            ioVec[i].fOutBytes = static_cast<size_t>(retval);
+         }
+      }
+   };
+
+   const unsigned int nThreads = std::min(static_cast<unsigned int>(fFileDes->parallelReads), nReq);
+   std::vector<std::thread> threads;
+   threads.reserve(nThreads - 1);
+   for (unsigned int i = 1; i < nThreads; ++i)
+      threads.emplace_back(readRanges);
+   readRanges();
+   for (auto &thread : threads)
+      thread.join();
+
+   if (failed) {
+      throw std::runtime_error("Cannot do vector read from '" + fUrl + "', error: " + errorMsg);
+   }
+}
@@ -42,13 +42,18 @@
 #include "TDavixFileInternal.h"
 #include "snprintf.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdlib>
 #include <unistd.h>
 #include <fcntl.h>
 #include <davix.hpp>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <cstring>
 
 
@@ -564,6 +569,10 @@ void TDavixFileInternal::parseConfig()
    env_var = gEnv->GetValue("Davix.GSI.GridMode", (const char *)"y");
    if (!isno(env_var))
       enableGridMode();
+
+   parallelReads = gEnv->GetValue("Davix.ParallelReads", 0);
+   if (gDebug > 0 && parallelReads > 1)
+      Info("parseConfig", "Reading lists of buffers with %d concurrent requests", parallelReads);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -971,6 +980,10 @@ Long64_t TDavixFile::DavixReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, In
 {
    DavixError *davixErr = NULL;
    Double_t start_time = eventStart();
+
+   if (d_ptr->parallelReads > 1 && nbuf > 1)
+      return DavixParallelReadBuffers(fd, buf, pos, len, nbuf, start_time);
+
    DavIOVecInput in[nbuf];
    DavIOVecOuput out[nbuf];
 
@@ -993,3 +1006,58 @@ Long64_t TDavixFile::DavixReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, In
 
    return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the buffers with up to Davix.ParallelReads concurrent single range
+/// requests instead of one multi-range request, which many object stores do
+/// not support or serve slowly. The requests reuse the persistent connections
+/// of the davix session pool.
+
+Long64_t TDavixFile::DavixParallelReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, Int_t *len, Int_t nbuf,
+                                               Double_t start_time)
+{
+   std::vector<Long64_t> bufPos(nbuf);
+   for (Int_t i = 1; i < nbuf; ++i)
+      bufPos[i] = bufPos[i - 1] + len[i - 1];
+
+   std::atomic<Int_t> next(0);
+   std::atomic<Long64_t> total(0);
+   std::atomic<bool> failed(false);
+   std::mutex errorMutex;
+   std::string errorMsg;
+   int errorStatus = 0;
+
+   auto readBuffers = [&]() {
+      for (Int_t i = next++; i < nbuf && !failed; i = next++) {
+         DavixError *davixErr = NULL;
+         Long64_t ret = d_ptr->davixPosix->pread(fd, buf + bufPos[i], len[i], pos[i], &davixErr);
+         if (ret < 0) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!failed) {
+               errorMsg = davixErr ? davixErr->getErrMsg() : std::string("unknown error");
+               errorStatus = davixErr ? davixErr->getStatus() : 0;
+            }
+            failed = true;
+            DavixError::clearError(&davixErr);
+         } else {
+            total += ret;
+         }
+      }
+   };
+
+   const Int_t nThreads = std::min(d_ptr->parallelReads, nbuf);
+   std::vector<std::thread> threads;
+   threads.reserve(nThreads - 1);
+   for (Int_t i = 1; i < nThreads; ++i)
+      threads.emplace_back(readBuffers);
+   readBuffers();
+   for (auto &thread : threads)
+      thread.join();
+
+   if (failed) {
+      Error("DavixReadBuffers", "can not read data with davix: %s (%d)", errorMsg.c_str(), errorStatus);
+      return -1;
+   }
+   eventStop(start_time, total);
+   return total;
+}
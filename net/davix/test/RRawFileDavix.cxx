@@ -1,5 +1,6 @@
 #include "RConfigure.h"
 #include "ROOT/RRawFileDavix.hxx"
+#include "TEnv.h"
 
 #include <string>
 
@@ -63,3 +64,34 @@ TEST(RRawFileDavix, ReadV)
    EXPECT_EQ('H', buffer[0]);
    EXPECT_EQ('d', buffer[1]);
 }
+
+
+TEST(RRawFileDavix, ReadVParallel)
+{
+   gEnv->SetValue("Davix.ParallelReads", 2);
+   RRawFile::ROptions options;
+   options.fBlockSize = 0;
+   std::unique_ptr<RRawFileDavix> f(new RRawFileDavix("http://root.cern.ch/files/davix.test", options));
+
+   char buffer[3];
+   buffer[0] = buffer[1] = buffer[2] = 0;
+   RRawFile::RIOVec iovec[3];
+   iovec[0].fBuffer = &buffer[0];
+   iovec[0].fOffset = 0;
+   iovec[0].fSize = 1;
+   iovec[1].fBuffer = &buffer[1];
+   iovec[1].fOffset = 11;
+   iovec[1].fSize = 1;
+   iovec[2].fBuffer = &buffer[2];
+   iovec[2].fOffset = 4;
+   iovec[2].fSize = 1;
+   f->ReadV(iovec, 3);
+   gEnv->SetValue("Davix.ParallelReads", 0);
+
+   EXPECT_EQ(1U, iovec[0].fOutBytes);
+   EXPECT_EQ(1U, iovec[1].fOutBytes);
+   EXPECT_EQ(1U, iovec[2].fOutBytes);
+   EXPECT_EQ('H', buffer[0]);
+   EXPECT_EQ('d', buffer[1]);
+   EXPECT_EQ('o', buffer[2]);
+}
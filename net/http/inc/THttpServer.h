@@ -16,12 +16,14 @@
 #include "TList.h"
 #include "THttpCallArg.h"
 
+#include <functional>
 #include <mutex>
 #include <map>
 #include <string>
 #include <memory>
 #include <queue>
 #include <thread>
+#include <utility>
 #include <vector>
 
 class THttpEngine;
@@ -39,6 +41,7 @@ protected:
    Bool_t fOwnThread{kFALSE};           ///<! true when specialized thread allocated for processing requests
    std::thread fThrd;                   ///<! own thread
    Bool_t fWSOnly{kFALSE};              ///<! when true, handle only websockets / longpoll engine
+   Int_t fJsonThreads{0};               ///<! number of threads converting root.json requests concurrently
 
    TString fJSROOTSYS;       ///<! location of local JSROOT files
    TString fTopName{"ROOT"}; ///<! name of top folder, default - "ROOT"
@@ -64,6 +67,13 @@ protected:
 
    virtual void ProcessBatchHolder(std::shared_ptr<THttpCallArg> &arg);
 
+   void FinishRequest(std::shared_ptr<THttpCallArg> &arg, const TString &filename, Bool_t iszip, const TString &etag = "");
+
+   Bool_t IsParallelJson(std::shared_ptr<THttpCallArg> &arg);
+
+   void ProcessJsonRequests(
+      std::vector<std::pair<std::shared_ptr<THttpCallArg>, std::function<std::string()>>> &args);
+
    void StopServerThread();
 
    std::string BuildWSEntryPage();
@@ -130,6 +140,11 @@ public:
 
    void CreateServerThread();
 
+   void SetJsonThreads(Int_t nthreads);
+
+   /** returns number of threads converting root.json requests concurrently, 0 when disabled */
+   Int_t GetJsonThreads() const { return fJsonThreads; }
+
    /** Check if file is requested, thread safe */
    Bool_t IsFileRequested(const char *uri, TString &res) const;
 
@@ -14,8 +14,12 @@
 
 #include "TNamed.h"
 #include "TList.h"
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 
 class TFolder;
 class TKey;
@@ -53,6 +57,11 @@ protected:
    Bool_t fNodeStarted{kFALSE};        ///<! indicate if node was started
    Int_t fNumFields{0};                ///<! number of fields
    Int_t fNumChilds{0};                ///<! number of childs
+   Int_t fChildsFirst{0};              ///<! index of the first child of the expanded item which is stored
+   Int_t fChildsNumber{-1};            ///<! maximal number of stored childs of the expanded item, -1 for all
+   TString fChildsFilter;              ///<! wildcard expression which the names of the stored childs must match
+   Bool_t fChildsPaged{kFALSE};        ///<! if the range and the filter apply to the childs of this item
+   Int_t fChildsTotal{0};              ///<! number of childs of this item which match the filter
 
 public:
    TRootSnifferScanRec();
@@ -127,6 +136,10 @@ protected:
    TString fCurrentAllowedMethods;     ///<! list of allowed methods, extracted when analyzed object restrictions
    TList fRestrictions;                ///<! list of restrictions for different locations
    TString fAutoLoad;                  ///<! scripts names, which are add as _autoload parameter to h.json request
+   Long64_t fCacheMaxSize{0};          ///<! maximal size of cached replies, 0 disables the cache
+   Long64_t fCacheSize{0};             ///<! size of cached replies
+   std::mutex fCacheMutex;             ///<! protects the cache, replies may be stored from several threads
+   std::map<std::string, std::pair<ULong_t, std::string>> fCache; ///<! cached replies with hash of their object
 
    void ScanObjectMembers(TRootSnifferScanRec &rec, TClass *cl, char *ptr);
 
@@ -159,6 +172,8 @@ protected:
 
    virtual Bool_t HasStreamerInfo() const { return kFALSE; }
 
+   Bool_t ProduceFile(const std::string &path, const std::string &file, const std::string &options, std::string &res);
+
    virtual Bool_t ProduceJson(const std::string &path, const std::string &options, std::string &res);
 
    virtual Bool_t ProduceXml(const std::string &path, const std::string &options, std::string &res);
@@ -223,7 +238,8 @@ public:
    void SetCurrentCallArg(THttpCallArg *arg);
 
    /** Method scans normal objects, registered in ROOT */
-   void ScanHierarchy(const char *topname, const char *path, TRootSnifferStore *store, Bool_t only_fields = kFALSE);
+   void ScanHierarchy(const char *topname, const char *path, TRootSnifferStore *store, Bool_t only_fields = kFALSE,
+                      Int_t first = 0, Int_t number = -1, const char *filter = nullptr);
 
    TObject *FindTObjectInHierarchy(const char *path);
 
@@ -242,6 +258,21 @@ public:
 
    Bool_t Produce(const std::string &path, const std::string &file, const std::string &options, std::string &res);
 
+   void SetCacheSize(Long64_t maxsize);
+
+   /** Returns maximal size of cached replies, 0 when cache is disabled */
+   Long64_t GetCacheSize() const { return fCacheMaxSize; }
+
+   ULong_t GetCacheVersion(const char *path, const char *file);
+
+   std::string MakeCacheKey(const std::string &path, const std::string &file, const std::string &options) const;
+
+   Bool_t FindCachedReply(const std::string &key, ULong_t version, std::string &res);
+
+   void StoreCachedReply(const std::string &key, ULong_t version, const std::string &res);
+
+   virtual std::function<std::string()> PrepareJson(const std::string &path, const std::string &options);
+
    ClassDefOverride(TRootSniffer, 0) // Sniffer of ROOT objects (basic version)
 };
 
@@ -35,6 +35,8 @@ public:
    virtual void SetField(Int_t, const char *, const char *, Bool_t) {}
    virtual void BeforeNextChild(Int_t, Int_t, Int_t) {}
    virtual void CloseNode(Int_t, Int_t) {}
+   /** Called before CloseNode() of an item whose childs were selected with a range or a filter */
+   virtual void SetChildsRange(Int_t, Int_t, Int_t, Int_t) {}
 
    void SetResult(void *_res, TClass *_rescl, TDataMember *_resmemb, Int_t _res_chld, Int_t restr = 0);
 
@@ -80,6 +82,7 @@ class TRootSnifferStoreJson : public TRootSnifferStore {
 protected:
    TString &fBuf;           ///<! output buffer
    Bool_t fCompact{kFALSE}; ///<! produce compact json code
+   Bool_t fChildsClosed{kFALSE}; ///<! if the childs array of the current node was already closed
 public:
    explicit TRootSnifferStoreJson(TString &_buf, Bool_t _compact = kFALSE) : TRootSnifferStore(), fBuf(_buf), fCompact(_compact)
    {
@@ -89,6 +92,7 @@ public:
    void SetField(Int_t lvl, const char *field, const char *value, Bool_t with_quotes) final;
    void BeforeNextChild(Int_t lvl, Int_t nchld, Int_t nfld) final;
    void CloseNode(Int_t lvl, Int_t numchilds) final;
+   void SetChildsRange(Int_t lvl, Int_t numchilds, Int_t first, Int_t total) final;
 
    ClassDefOverride(TRootSnifferStoreJson, 0) // json results store of objects sniffer
 };
@@ -31,12 +31,16 @@
 #include "TCivetweb.h"
 #include "TFastCgi.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -61,6 +65,27 @@ public:
    void Timeout() override { fServer.ProcessRequests(); }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// Extract the range and the filter of the childs of the expanded item from the
+/// query of h.json and h.xml requests, for instance "first=100&number=50&filter=h*"
+
+static void GetChildsRange(const TString &query, Int_t &first, Int_t &number, TString &filter)
+{
+   if (query.Length() == 0)
+      return;
+   TUrl url;
+   url.SetOptions(query);
+   if (url.GetValueFromOptions("first"))
+      first = url.GetIntValueFromOptions("first");
+   if (url.GetValueFromOptions("number"))
+      number = url.GetIntValueFromOptions("number");
+   if (url.GetValueFromOptions("filter")) {
+      filter = url.GetValueFromOptions("filter");
+      filter.ReplaceAll("%2A", "*");
+      filter.ReplaceAll("%3F", "?");
+   }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////
@@ -438,6 +463,29 @@ void THttpServer::SetTimer(Long_t milliSec, Bool_t mode)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Convert the objects of root.json requests in up to nthreads threads
+///
+/// By default all requests are processed one after the other in the thread
+/// calling ProcessRequests(). With nthreads > 1, the objects of all queued
+/// root.json requests are still searched in this thread, but their conversion
+/// into JSON, often the most expensive part, runs concurrently. ProcessRequests()
+/// only returns when all conversions are done, and requests of other kinds are
+/// processed only once the previous conversions are finished, so that analysis
+/// code or commands do not modify the objects while they are converted.
+/// Objects accessed concurrently from other threads of the application must
+/// not be published in this mode. Also ROOT::EnableThreadSafety() is invoked.
+/// Sniffers overriding TRootSniffer::ProduceJson() should also override
+/// TRootSniffer::PrepareJson(), which is used instead in this mode.
+/// nthreads <= 1 disables the mode.
+
+void THttpServer::SetJsonThreads(Int_t nthreads)
+{
+   fJsonThreads = nthreads > 1 ? nthreads : 0;
+   if (fJsonThreads > 0)
+      ROOT::EnableThreadSafety();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates special thread to process all requests, directed to http server
 ///
@@ -643,6 +691,9 @@ Int_t THttpServer::ProcessRequests()
 
    std::unique_lock<std::mutex> lk(fMutex, std::defer_lock);
 
+   // root.json requests whose objects are converted concurrently, see SetJsonThreads()
+   std::vector<std::pair<std::shared_ptr<THttpCallArg>, std::function<std::string()>>> jsonArgs;
+
    // first process requests in the queue
    while (true) {
       std::shared_ptr<THttpCallArg> arg;
@@ -657,6 +708,41 @@ Int_t THttpServer::ProcessRequests()
       if (!arg)
          break;
 
+      if ((fJsonThreads > 1) && IsParallelJson(arg)) {
+         std::function<std::string()> convert;
+         fSniffer->SetCurrentCallArg(arg.get());
+         try {
+            std::string path = arg->fPathName.Data(), query = arg->fQuery.Data(), cached;
+            ULong_t version = fSniffer->GetCacheVersion(path.c_str(), "root.json");
+            std::string key = version ? fSniffer->MakeCacheKey(path, "root.json", query) : "";
+            if (version && fSniffer->FindCachedReply(key, version, cached)) {
+               convert = [cached]() { return cached; };
+            } else {
+               convert = fSniffer->PrepareJson(path, query);
+               if (convert && version) {
+                  auto sniffer = fSniffer.get();
+                  convert = [sniffer, convert, key, version]() {
+                     std::string res = convert();
+                     if (!res.empty())
+                        sniffer->StoreCachedReply(key, version, res);
+                     return res;
+                  };
+               }
+            }
+         } catch (...) {
+         }
+         fSniffer->SetCurrentCallArg(nullptr);
+
+         if (convert) {
+            cnt++;
+            jsonArgs.emplace_back(arg, std::move(convert));
+            continue;
+         }
+      }
+
+      // the request may modify the objects being converted
+      ProcessJsonRequests(jsonArgs);
+
       if (arg->fFileName == "root_batch_holder.js") {
          ProcessBatchHolder(arg);
          continue;
@@ -675,6 +761,8 @@ Int_t THttpServer::ProcessRequests()
       arg->NotifyCondition();
    }
 
+   ProcessJsonRequests(jsonArgs);
+
    // regularly call Process() method of engine to let perform actions in ROOT context
    TIter iter(&fEngines);
    THttpEngine *engine = nullptr;
@@ -967,6 +1055,19 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       iszip = kTRUE;
    }
 
+   // when replies are cached, the client can revalidate its copy with the version of the object
+   TString etag;
+   ULong_t version = IsWSOnly() ? 0 : fSniffer->GetCacheVersion(arg->fPathName.Data(), filename.Data());
+   if (version) {
+      TString request = arg->fFileName + "?" + arg->fQuery;
+      etag.Form("\"%lx-%x\"", (unsigned long)version, (unsigned)TString::Hash(request.Data(), request.Length()));
+      if (arg->GetRequestHeader("If-None-Match") == etag) {
+         arg->SetNotModified();
+         arg->AddHeader("ETag", etag.Data());
+         return;
+      }
+   }
+
    if (IsWSOnly()) {
       if (arg->fContent.empty())
          arg->Set404();
@@ -988,7 +1089,11 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
          const char *topname = fTopName.Data();
          if (arg->fTopName.Length() > 0)
             topname = arg->fTopName.Data();
-         fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store, filename == "get.xml");
+         Int_t first = 0, number = -1;
+         TString filter;
+         GetChildsRange(arg->fQuery, first, number, filter);
+         fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store, filename == "get.xml", first, number,
+                                 filter.Data());
       }
 
       res.Append("</root>");
@@ -1004,7 +1109,10 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       const char *topname = fTopName.Data();
       if (arg->fTopName.Length() > 0)
          topname = arg->fTopName.Data();
-      fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store);
+      Int_t first = 0, number = -1;
+      TString filter;
+      GetChildsRange(arg->fQuery, first, number, filter);
+      fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store, kFALSE, first, number, filter.Data());
       arg->SetContent(std::string(res.Data()));
       arg->SetJson();
    } else if (fSniffer->Produce(arg->fPathName.Data(), filename.Data(), arg->fQuery.Data(), arg->fContent)) {
@@ -1015,6 +1123,16 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       MissedRequest(arg.get());
    }
 
+   FinishRequest(arg, filename, iszip, etag);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the compression settings and the headers to the reply of a request
+/// processed by the sniffer
+
+void THttpServer::FinishRequest(std::shared_ptr<THttpCallArg> &arg, const TString &filename, Bool_t iszip,
+                                const TString &etag)
+{
    if (arg->Is404())
       return;
 
@@ -1028,14 +1146,84 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       arg->AddHeader(parname, Form("%u", (unsigned)fSniffer->GetStreamerInfoHash()));
    }
 
-   // try to avoid caching on the browser
-   arg->AddNoCacheHeader();
+   if (etag.Length() > 0) {
+      // browser may keep the reply, but has to revalidate it with the ETag
+      arg->AddHeader("ETag", etag.Data());
+      arg->AddHeader("Cache-Control", "private, no-cache");
+   } else {
+      // try to avoid caching on the browser
+      arg->AddNoCacheHeader();
+   }
 
    // potentially add cors header
    if (IsCors())
       arg->AddHeader("Access-Control-Allow-Origin", GetCors());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns kTRUE if the request is a root.json request, which ProcessRequest()
+/// would reply with TRootSniffer::ProduceJson()
+
+Bool_t THttpServer::IsParallelJson(std::shared_ptr<THttpCallArg> &arg)
+{
+   if (fTerminated || IsWSOnly() || arg->fPathName.IsNull() ||
+       ((arg->fFileName != "root.json") && (arg->fFileName != "root.json.gz")))
+      return kFALSE;
+
+   // a websocket handler may serve files from its directory
+   TString wsname = arg->fPathName;
+   auto pos = wsname.First('/');
+   if (pos != kNPOS)
+      wsname.Resize(pos);
+
+   return !FindWS(wsname.Data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert concurrently the objects of root.json requests prepared by
+/// ProcessRequests() and reply to these requests
+
+void THttpServer::ProcessJsonRequests(
+   std::vector<std::pair<std::shared_ptr<THttpCallArg>, std::function<std::string()>>> &args)
+{
+   if (args.empty())
+      return;
+
+   std::vector<std::string> results(args.size());
+   std::atomic<size_t> next{0};
+
+   auto convert = [&]() {
+      for (size_t n = next++; n < args.size(); n = next++) {
+         try {
+            results[n] = args[n].second();
+         } catch (...) {
+            results[n].clear();
+         }
+      }
+   };
+
+   std::vector<std::thread> threads;
+   for (size_t n = 1; (n < (size_t)fJsonThreads) && (n < args.size()); ++n)
+      threads.emplace_back(convert);
+   convert();
+   for (auto &thrd : threads)
+      thrd.join();
+
+   for (size_t n = 0; n < args.size(); ++n) {
+      auto &arg = args[n].first;
+      if (results[n].empty()) {
+         MissedRequest(arg.get());
+      } else {
+         arg->fContent = std::move(results[n]);
+         arg->SetContentType(GetMimeType("root.json"));
+      }
+      FinishRequest(arg, "root.json", arg->fFileName.EndsWith(".gz"));
+      arg->NotifyCondition();
+   }
+
+   args.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Register object in folders hierarchy
 ///
@@ -24,6 +24,7 @@
 #include "TObjString.h"
 #include "TObjArray.h"
 #include "TUrl.h"
+#include "TRegexp.h"
 #include "TImage.h"
 #include "TVirtualMutex.h"
 #include "TRootSnifferStore.h"
@@ -159,6 +160,8 @@ void TRootSnifferScanRec::CreateNode(const char *_node_name)
 void TRootSnifferScanRec::CloseNode()
 {
    if (fStore && fNodeStarted) {
+      if (fChildsPaged)
+         fStore->SetChildsRange(fLevel, fNumChilds, fChildsFirst, fChildsTotal);
       fStore->CloseNode(fLevel, fNumChilds);
       fNodeStarted = kFALSE;
    }
@@ -336,6 +339,17 @@ TRootSnifferScanRec::GoInside(TRootSnifferScanRec &super, TObject *obj, const ch
          return kFALSE;
    }
 
+   // only the childs of the expanded item in the range and matching the filter are stored,
+   // the others are still counted
+   if (super.fChildsPaged && (super.fMask & kScan) && !super.ScanOnlyFields()) {
+      if ((super.fChildsFilter.Length() > 0) && (fItemName.Index(TRegexp(super.fChildsFilter, kTRUE)) == kNPOS))
+         return kFALSE;
+      Int_t indx = super.fChildsTotal++;
+      if ((indx < super.fChildsFirst) ||
+          ((super.fChildsNumber >= 0) && (indx >= super.fChildsFirst + super.fChildsNumber)))
+         return kFALSE;
+   }
+
    fParent = &super;
    fLevel = super.fLevel;
    fStore = super.fStore;
@@ -343,6 +357,12 @@ TRootSnifferScanRec::GoInside(TRootSnifferScanRec &super, TObject *obj, const ch
    fMask = super.fMask & kActions;
    if (fRestriction == 0)
       fRestriction = super.fRestriction; // get restriction from parent
+   if (!super.fChildsPaged) {
+      // the range of childs is kept until the expanded item is found
+      fChildsFirst = super.fChildsFirst;
+      fChildsNumber = super.fChildsNumber;
+      fChildsFilter = super.fChildsFilter;
+   }
    Bool_t topelement(kFALSE);
 
    if (fMask & kScan) {
@@ -372,6 +392,7 @@ TRootSnifferScanRec::GoInside(TRootSnifferScanRec &super, TObject *obj, const ch
             topelement = kTRUE;
             fMask = (fMask & kOnlyFields) | kScan;
             fHasMore = (fMask & kOnlyFields) == 0;
+            fChildsPaged = fHasMore && ((fChildsFirst > 0) || (fChildsNumber >= 0) || (fChildsFilter.Length() > 0));
          }
       } else {
          if (!isslash)
@@ -994,9 +1015,16 @@ void TRootSniffer::ScanRoot(TRootSnifferScanRec &rec)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// scan ROOT hierarchy with provided store object
+///
+/// For items with many childs, like directories with many keys or trees with many branches,
+/// only the childs of the expanded item (the one specified by path, or the top item) with the
+/// names matching the wildcard expression filter are accounted. Of these, only number childs
+/// starting from the first one are stored; number < 0 stores all of them. In that case the JSON
+/// store adds the fields "_first" and "_nchilds" to the expanded item, with the index of the
+/// first stored child and the number of childs matching the filter.
 
 void TRootSniffer::ScanHierarchy(const char *topname, const char *path, TRootSnifferStore *store,
-                                     Bool_t only_fields)
+                                 Bool_t only_fields, Int_t first, Int_t number, const char *filter)
 {
    TRootSnifferScanRec rec;
    rec.fSearchPath = path;
@@ -1014,6 +1042,12 @@ void TRootSniffer::ScanHierarchy(const char *topname, const char *path, TRootSni
 
    rec.fStore = store;
 
+   rec.fChildsFirst = first > 0 ? first : 0;
+   rec.fChildsNumber = number;
+   rec.fChildsFilter = filter ? filter : "";
+   if (!rec.fSearchPath && !only_fields)
+      rec.fChildsPaged = (rec.fChildsFirst > 0) || (number >= 0) || (rec.fChildsFilter.Length() > 0);
+
    rec.CreateNode(topname);
 
    if (!rec.fSearchPath)
@@ -1128,9 +1162,26 @@ Bool_t TRootSniffer::CanExploreItem(const char *path)
 
 Bool_t TRootSniffer::ProduceJson(const std::string &path, const std::string &options, std::string &res)
 {
-   if (path.empty())
+   auto convert = PrepareJson(path, options);
+   if (!convert)
       return kFALSE;
 
+   res = convert();
+
+   return !res.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the object for a root.json request and return the function which
+/// converts it into JSON. The conversion does not use the sniffer and can run
+/// in another thread, as long as the object is not modified meanwhile.
+/// Returns an empty function if the object is not found or is not accessible.
+
+std::function<std::string()> TRootSniffer::PrepareJson(const std::string &path, const std::string &options)
+{
+   if (path.empty())
+      return nullptr;
+
    const char *path_ = path.c_str();
    if (*path_ == '/')
       path_++;
@@ -1146,13 +1197,15 @@ Bool_t TRootSniffer::ProduceJson(const std::string &path, const std::string &opt
    TDataMember *member = nullptr;
    void *obj_ptr = FindInHierarchy(path_, &obj_cl, &member);
    if (!obj_ptr || (!obj_cl && !member))
-      return kFALSE;
+      return nullptr;
 
-   // TODO: implement direct storage into std::string
-   TString buf = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member ? member->GetName() : nullptr);
-   res = buf.Data();
+   const char *member_name = member ? member->GetName() : nullptr;
 
-   return !res.empty();
+   return [obj_ptr, obj_cl, compact, member_name]() -> std::string {
+      // TODO: implement direct storage into std::string
+      TString buf = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member_name);
+      return buf.Data();
+   };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1476,12 +1529,36 @@ Bool_t TRootSniffer::ProduceImage(Int_t /*kind*/, const std::string & /*path*/,
 ///   "exe.txt"   - method execution with debug output
 ///   "cmd.json"  - execution of registered commands
 /// Result returned in std::string - can be binary or text.
+/// When enabled with SetCacheSize(), replies for objects data are taken from the cache
+/// as long as the object does not change.
 
 Bool_t TRootSniffer::Produce(const std::string &path, const std::string &file, const std::string &options, std::string &res)
 {
    if (file.empty())
       return kFALSE;
 
+   ULong_t version = GetCacheVersion(path.c_str(), file.c_str());
+   if (!version)
+      return ProduceFile(path, file, options, res);
+
+   std::string key = MakeCacheKey(path, file, options);
+   if (FindCachedReply(key, version, res))
+      return kTRUE;
+
+   if (!ProduceFile(path, file, options, res))
+      return kFALSE;
+
+   StoreCachedReply(key, version, res);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce the reply for specified file of the item, without the cache of replies,
+/// see Produce() for the list of supported files
+
+Bool_t TRootSniffer::ProduceFile(const std::string &path, const std::string &file, const std::string &options, std::string &res)
+{
+
    if (file == "root.bin")
       return ProduceBinary(path, options, res);
 
@@ -1528,6 +1605,96 @@ Bool_t TRootSniffer::Produce(const std::string &path, const std::string &file, c
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable cache of replies for objects data: root.json, root.xml, root.bin and images.
+///
+/// A reply is produced again only when hash of its object, returned by GetItemHash(),
+/// changes. Default implementation hashes the object data members, which for
+/// instance changes with every histogram fill, but not when only data referenced
+/// by pointers is modified. Derived classes may reimplement GetItemHash() to provide
+/// another version of the objects. When the cache exceeds maxsize bytes, it is cleared.
+/// maxsize 0 disables the cache (default).
+
+void TRootSniffer::SetCacheSize(Long64_t maxsize)
+{
+   std::lock_guard<std::mutex> grd(fCacheMutex);
+   fCacheMaxSize = maxsize > 0 ? maxsize : 0;
+   fCache.clear();
+   fCacheSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns version of the reply for specified file of the item, used as key of the cache
+/// and as HTTP ETag. Returns 0 when the reply cannot be cached.
+
+ULong_t TRootSniffer::GetCacheVersion(const char *path, const char *file)
+{
+   if ((fCacheMaxSize <= 0) || !path || !*path || !file)
+      return 0;
+
+   if (strcmp(file, "root.json") && strcmp(file, "root.xml") && strcmp(file, "root.bin") &&
+       strcmp(file, "root.png") && strcmp(file, "root.jpeg") && strcmp(file, "root.gif"))
+      return 0;
+
+   return GetItemHash(path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns key of the cached reply, which includes user name as the accessible items may differ between users
+
+std::string TRootSniffer::MakeCacheKey(const std::string &path, const std::string &file, const std::string &options) const
+{
+   std::string key;
+   if (fCurrentArg && fCurrentArg->GetUserName())
+      key = fCurrentArg->GetUserName();
+   key.append("\n");
+   key.append(path);
+   key.append("\n");
+   key.append(file);
+   key.append("\n");
+   key.append(options);
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Search the cache for a reply with specified key and version
+
+Bool_t TRootSniffer::FindCachedReply(const std::string &key, ULong_t version, std::string &res)
+{
+   std::lock_guard<std::mutex> grd(fCacheMutex);
+   auto iter = fCache.find(key);
+   if ((iter == fCache.end()) || (iter->second.first != version))
+      return kFALSE;
+   res = iter->second.second;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store reply in the cache, replacing previous version of the reply
+
+void TRootSniffer::StoreCachedReply(const std::string &key, ULong_t version, const std::string &res)
+{
+   std::lock_guard<std::mutex> grd(fCacheMutex);
+
+   auto iter = fCache.find(key);
+   if (iter != fCache.end()) {
+      fCacheSize -= iter->second.second.length();
+      fCache.erase(iter);
+   }
+
+   Long64_t len = res.length();
+   if (len > fCacheMaxSize / 2)
+      return;
+
+   if (fCacheSize + len > fCacheMaxSize) {
+      fCache.clear();
+      fCacheSize = 0;
+   }
+
+   fCache.emplace(key, std::make_pair(version, res));
+   fCacheSize += len;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// return item from the subfolders structure
 
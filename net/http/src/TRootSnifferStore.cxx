@@ -170,7 +170,23 @@ void TRootSnifferStoreJson::BeforeNextChild(Int_t lvl, Int_t nchld, Int_t)
 
 void TRootSnifferStoreJson::CloseNode(Int_t lvl, Int_t numchilds)
 {
-   if (numchilds > 0)
+   if ((numchilds > 0) && !fChildsClosed)
       fBuf.Append(TString::Format("%s%*s]", (fCompact ? "" : "\n"), fCompact ? 0 : lvl * 4 + 2, ""));
+   fChildsClosed = kFALSE;
    fBuf.Append(TString::Format("%s%*s}", (fCompact ? "" : "\n"), fCompact ? 0 : lvl * 4, ""));
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// called before closing a node whose childs were selected with a range or a filter
+/// the childs array is closed and "_first" and "_nchilds" fields are added,
+/// with the index of the first stored child and the number of childs matching the filter
+
+void TRootSnifferStoreJson::SetChildsRange(Int_t lvl, Int_t numchilds, Int_t first, Int_t total)
+{
+   if ((numchilds > 0) && !fChildsClosed) {
+      fBuf.Append(TString::Format("%s%*s]", (fCompact ? "" : "\n"), fCompact ? 0 : lvl * 4 + 2, ""));
+      fChildsClosed = kTRUE;
+   }
+   SetField(lvl, "_first", TString::Format("%d", first).Data(), kFALSE);
+   SetField(lvl, "_nchilds", TString::Format("%d", total).Data(), kFALSE);
+}
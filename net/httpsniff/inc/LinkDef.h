@@ -4,6 +4,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
+#pragma link C++ class THistDeltaWSHandler;
 #pragma link C++ class TRootSnifferFull;
 
 #endif
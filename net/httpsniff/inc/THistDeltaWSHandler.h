@@ -0,0 +1,89 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THistDeltaWSHandler
+#define ROOT_THistDeltaWSHandler
+
+#include "THttpWSHandler.h"
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+class TH1;
+
+class THistDeltaWSHandler : public THttpWSHandler {
+
+public:
+   /// Kind of the binary messages sent to the clients
+   enum EMessageKind {
+      kKeyFrame = 0, ///< contents of all bins
+      kDelta = 1     ///< indexes and contents of the bins changed since previous message
+   };
+
+protected:
+   using Clock_t = std::chrono::steady_clock;
+
+   struct RHist {
+      TH1 *fHist{nullptr};               ///<! registered histogram
+      std::vector<Double_t> fSent;       ///<! bins contents sent with last message
+      Double_t fSentEntries{0};          ///<! number of entries sent with last message
+      UInt_t fSeq{0};                    ///<! sequence number of last message
+      Int_t fNDeltas{0};                 ///<! number of deltas sent since last key frame
+      Clock_t::time_point fLastSend;     ///<! time of last message
+   };
+
+   struct RClient {
+      UInt_t fWSId{0};                   ///<! websocket id
+      Bool_t fAll{kFALSE};               ///<! subscribed to all histograms
+      std::set<std::string> fSubscribed; ///<! names of subscribed histograms
+      std::set<TH1 *> fNeedKeyFrame;     ///<! histograms for which client has to get key frame
+   };
+
+   std::vector<RHist> fHists;     ///<! registered histograms
+   std::vector<RClient> fClients; ///<! connected clients
+   Int_t fMinInterval{1000};      ///<! minimal interval between messages for the same histogram, in ms
+   Int_t fKeyFrameInterval{100};  ///<! number of deltas between two key frames
+
+   Bool_t IsSubscribed(const RClient &client, TH1 *hist) const;
+
+   void MakeMessage(RHist &entry, Bool_t keyframe, const std::vector<UInt_t> &changed, std::string &msg) const;
+
+public:
+   THistDeltaWSHandler(const char *name = "hist_updates", const char *title = "Histograms updates");
+   virtual ~THistDeltaWSHandler();
+
+   void Register(TH1 *hist);
+
+   void Unregister(TH1 *hist);
+
+   /// Set minimal interval in ms between two messages for the same histogram, changes in between are coalesced
+   void SetMinInterval(Int_t ms) { fMinInterval = ms > 0 ? ms : 0; }
+
+   /// Returns minimal interval in ms between two messages for the same histogram
+   Int_t GetMinInterval() const { return fMinInterval; }
+
+   /// Set number of delta messages sent before a new key frame
+   void SetKeyFrameInterval(Int_t n) { fKeyFrameInterval = n > 0 ? n : 0; }
+
+   /// Returns number of delta messages sent before a new key frame
+   Int_t GetKeyFrameInterval() const { return fKeyFrameInterval; }
+
+   Int_t Update();
+
+   Bool_t ProcessWS(THttpCallArg *arg) override;
+
+   void RecursiveRemove(TObject *obj) override;
+
+   ClassDefOverride(THistDeltaWSHandler, 0) // websocket handler sending changed bins of histograms
+};
+
+#endif
@@ -0,0 +1,306 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THistDeltaWSHandler.h"
+
+#include "TH1.h"
+#include "TROOT.h"
+#include "TList.h"
+#include "TVirtualMutex.h"
+#include "Bytes.h"
+
+#include <algorithm>
+#include <cstring>
+
+/** \class THistDeltaWSHandler
+\ingroup http
+
+Websocket handler which pushes the changes of registered histograms to subscribed clients
+as binary messages.
+
+Clients subscribe by sending "SUBSCRIBE:name" (or "SUBSCRIBE:*" for all histograms) and
+"UNSUBSCRIBE:name". Each call of Update() compares the bins contents with the ones sent
+last time and sends to the clients either a delta with the changed bins only or, for new
+clients, after resizing and every GetKeyFrameInterval() deltas, a key frame with all bins.
+Messages for the same histogram are sent at most every GetMinInterval() ms, changes done
+in between are coalesced into the next message. A client which could not receive a
+message, for instance because previous one is still being sent, gets the next key frame.
+Axes, titles and other attributes are not sent, clients get them once with root.json.
+
+All numbers are big-endian:
+
+    UChar_t  kind            // kKeyFrame or kDelta
+    UChar_t  reserved
+    UShort_t namelen
+    char     name[namelen]   // histogram name
+    UInt_t   seq             // message number for this histogram
+    UInt_t   ncells          // TH1::GetNcells(), including under- and overflows
+    Double_t entries
+    // kKeyFrame
+    Double_t content[ncells]
+    // kDelta
+    UInt_t   nchanged
+    { UInt_t bin; Double_t content; } [nchanged]
+
+Update() and the registration methods must be called from the thread processing
+the http requests, as the handler runs in synchronous mode.
+*/
+
+ClassImp(THistDeltaWSHandler);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, handler should be registered with THttpServer::RegisterWS()
+
+THistDeltaWSHandler::THistDeltaWSHandler(const char *name, const char *title) : THttpWSHandler(name, title)
+{
+   R__LOCKGUARD(gROOTMutex);
+   gROOT->GetListOfCleanups()->Add(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+THistDeltaWSHandler::~THistDeltaWSHandler()
+{
+   R__LOCKGUARD(gROOTMutex);
+   gROOT->GetListOfCleanups()->Remove(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register histogram, its changes are sent to the subscribed clients
+
+void THistDeltaWSHandler::Register(TH1 *hist)
+{
+   if (!hist)
+      return;
+   for (auto &entry : fHists)
+      if (entry.fHist == hist)
+         return;
+
+   // let the histogram destructor call RecursiveRemove()
+   hist->SetBit(kMustCleanup);
+
+   fHists.emplace_back();
+   fHists.back().fHist = hist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister histogram
+
+void THistDeltaWSHandler::Unregister(TH1 *hist)
+{
+   fHists.erase(std::remove_if(fHists.begin(), fHists.end(), [hist](const RHist &entry) { return entry.fHist == hist; }),
+                fHists.end());
+   for (auto &client : fClients)
+      client.fNeedKeyFrame.erase(hist);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister histograms which are deleted
+
+void THistDeltaWSHandler::RecursiveRemove(TObject *obj)
+{
+   for (auto &entry : fHists)
+      if (entry.fHist == obj) {
+         Unregister(entry.fHist);
+         break;
+      }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns kTRUE if client subscribed to the histogram
+
+Bool_t THistDeltaWSHandler::IsSubscribed(const RClient &client, TH1 *hist) const
+{
+   return client.fAll || (client.fSubscribed.count(hist->GetName()) > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill message with the key frame or the listed changed bins of the histogram
+
+void THistDeltaWSHandler::MakeMessage(RHist &entry, Bool_t keyframe, const std::vector<UInt_t> &changed,
+                                      std::string &msg) const
+{
+   const char *name = entry.fHist->GetName();
+   UShort_t namelen = (UShort_t)std::min(strlen(name), (size_t)0xffff);
+   UInt_t ncells = entry.fSent.size();
+
+   msg.resize(4 + namelen + 16 + (keyframe ? 8 * ncells : 4 + 12 * changed.size()));
+
+   char *buf = &msg[0];
+   *buf++ = (char)(keyframe ? kKeyFrame : kDelta);
+   *buf++ = 0;
+   tobuf(buf, namelen);
+   memcpy(buf, name, namelen);
+   buf += namelen;
+   tobuf(buf, entry.fSeq);
+   tobuf(buf, ncells);
+   tobuf(buf, entry.fSentEntries);
+   if (keyframe) {
+      for (auto value : entry.fSent)
+         tobuf(buf, value);
+   } else {
+      tobuf(buf, (UInt_t)changed.size());
+      for (auto bin : changed) {
+         tobuf(buf, bin);
+         tobuf(buf, entry.fSent[bin]);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send changes of registered histograms to subscribed clients
+/// Should be called regularly, for instance from a timer or the event loop
+/// Returns number of sent messages
+
+Int_t THistDeltaWSHandler::Update()
+{
+   if (fClients.empty())
+      return 0;
+
+   Int_t nsent = 0;
+   auto now = Clock_t::now();
+   std::vector<UInt_t> changed;
+   std::string msg;
+
+   // send message to the client, client has to get next key frame when sending fails
+   auto send = [&](RClient &client, TH1 *hist) {
+      if (SendWS(client.fWSId, msg.data(), msg.length()) < 0) {
+         client.fNeedKeyFrame.insert(hist);
+      } else {
+         client.fNeedKeyFrame.erase(hist);
+         nsent++;
+      }
+   };
+
+   for (auto &entry : fHists) {
+      TH1 *hist = entry.fHist;
+
+      Bool_t anyclient = kFALSE, anykey = kFALSE;
+      for (auto &client : fClients)
+         if (IsSubscribed(client, hist)) {
+            anyclient = kTRUE;
+            if (client.fNeedKeyFrame.count(hist))
+               anykey = kTRUE;
+         }
+      if (!anyclient)
+         continue;
+
+      UInt_t ncells = hist->GetNcells();
+      Bool_t resized = entry.fSent.size() != ncells;
+      Bool_t due = resized || (now - entry.fLastSend >= std::chrono::milliseconds(fMinInterval));
+
+      if (due) {
+         changed.clear();
+         if (!resized)
+            for (UInt_t bin = 0; bin < ncells; ++bin)
+               if (hist->GetBinContent(bin) != entry.fSent[bin])
+                  changed.push_back(bin);
+
+         Double_t entries = hist->GetEntries();
+
+         // a delta larger than the key frame is not useful
+         Bool_t keyframe = resized || ((fKeyFrameInterval > 0) && (entry.fNDeltas >= fKeyFrameInterval)) ||
+                           (12 * changed.size() >= 8 * (size_t)ncells);
+
+         if (keyframe || !changed.empty() || (entries != entry.fSentEntries)) {
+            if (keyframe) {
+               entry.fSent.resize(ncells);
+               for (UInt_t bin = 0; bin < ncells; ++bin)
+                  entry.fSent[bin] = hist->GetBinContent(bin);
+            } else {
+               for (auto bin : changed)
+                  entry.fSent[bin] = hist->GetBinContent(bin);
+            }
+            entry.fSentEntries = entries;
+            entry.fSeq++;
+            entry.fNDeltas = keyframe ? 0 : entry.fNDeltas + 1;
+            entry.fLastSend = now;
+
+            MakeMessage(entry, keyframe, changed, msg);
+
+            for (auto &client : fClients)
+               if (IsSubscribed(client, hist) && (keyframe || !client.fNeedKeyFrame.count(hist)))
+                  send(client, hist);
+
+            if (keyframe)
+               continue;
+         }
+      }
+
+      // clients which missed previous messages get current state immediately
+      if (anykey) {
+         MakeMessage(entry, kTRUE, changed, msg);
+         for (auto &client : fClients)
+            if (IsSubscribed(client, hist) && client.fNeedKeyFrame.count(hist))
+               send(client, hist);
+      }
+   }
+
+   return nsent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process websocket requests: connection of the clients and subscriptions
+
+Bool_t THistDeltaWSHandler::ProcessWS(THttpCallArg *arg)
+{
+   if (!arg || (arg->GetWSId() == 0))
+      return kTRUE;
+
+   UInt_t wsid = arg->GetWSId();
+
+   if (arg->IsMethod("WS_CONNECT"))
+      return kTRUE;
+
+   if (arg->IsMethod("WS_READY")) {
+      fClients.emplace_back();
+      fClients.back().fWSId = wsid;
+      return kTRUE;
+   }
+
+   auto iter = std::find_if(fClients.begin(), fClients.end(), [wsid](const RClient &client) { return client.fWSId == wsid; });
+
+   if (arg->IsMethod("WS_CLOSE")) {
+      if (iter != fClients.end())
+         fClients.erase(iter);
+      return kTRUE;
+   }
+
+   if (!arg->IsMethod("WS_DATA") || (iter == fClients.end()))
+      return kFALSE;
+
+   std::string msg((const char *)arg->GetPostData(), arg->GetPostDataLength());
+
+   if (msg.compare(0, 10, "SUBSCRIBE:") == 0) {
+      std::string name = msg.substr(10);
+      if (name == "*")
+         iter->fAll = kTRUE;
+      else
+         iter->fSubscribed.insert(name);
+      for (auto &entry : fHists)
+         if (IsSubscribed(*iter, entry.fHist))
+            iter->fNeedKeyFrame.insert(entry.fHist);
+      return kTRUE;
+   }
+
+   if (msg.compare(0, 12, "UNSUBSCRIBE:") == 0) {
+      std::string name = msg.substr(12);
+      if (name == "*") {
+         iter->fAll = kFALSE;
+         iter->fSubscribed.clear();
+      } else {
+         iter->fSubscribed.erase(name);
+      }
+      return kTRUE;
+   }
+
+   return kFALSE;
+}
@@ -53,6 +53,7 @@
 #pragma link C++ class TApplicationServer;
 #pragma link C++ class TUDPSocket;
 #pragma link C++ class TParallelMergingFile+;
+#pragma link C++ class TParallelMergingServer;
 
 #ifdef R__SSL
 #pragma link C++ class TS3HTTPRequest+;
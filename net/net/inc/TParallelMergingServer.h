@@ -0,0 +1,83 @@
+// @(#)root/net:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TParallelMergingServer
+#define ROOT_TParallelMergingServer
+
+#include "TObject.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TMessage;
+
+class TParallelMergingServer : public TObject {
+
+public:
+   /// Kinds of the messages sent to the clients when they connect
+   enum EStatusKind {
+      kStartConnection = 0, ///< carries the index of the client
+      kProtocol = 1,        ///< carries the protocol version
+      kProtocolVersion = 1
+   };
+
+private:
+   struct RFileMerger;
+   struct RShard;
+
+   Int_t fPort;                                   ///< port on which the clients are accepted
+   UInt_t fNThreads;                              ///< number of merging threads
+   Int_t fMaxClients{100};                        ///< maximal number of clients connected at the same time
+   Float_t fMergeThreshold{0.75};                 ///< fraction of the clients which have to report before a merge
+   Long64_t fMaxPendingBytes{512 * 1024 * 1024};  ///< received bytes not yet merged above which clients are not read
+   Bool_t fWriteCache{kFALSE};                    ///< use a TFileCacheWrite for the output files
+
+   std::mutex fMutex;                             ///<! protects fPendingBytes
+   std::condition_variable fCondition;            ///<! signalled when uploads have been merged
+   Long64_t fPendingBytes{0};                     ///<! received bytes not yet merged
+   std::vector<std::unique_ptr<RShard>> fShards;  ///<! merging threads and their queues
+
+   TParallelMergingServer(const TParallelMergingServer &) = delete;
+   TParallelMergingServer &operator=(const TParallelMergingServer &) = delete;
+
+   void Enqueue(TMessage *mess);
+   void Merged(Long64_t nbytes);
+   void ProcessShard(RShard &shard);
+
+public:
+   TParallelMergingServer(Int_t port = 1095, UInt_t nthreads = 0);
+   virtual ~TParallelMergingServer();
+
+   /// Set maximal number of clients connected at the same time
+   void SetMaxClients(Int_t n) { fMaxClients = n; }
+   Int_t GetMaxClients() const { return fMaxClients; }
+
+   /// Set fraction of the clients of an output file which have to report before the file is merged
+   void SetMergeThreshold(Float_t frac) { fMergeThreshold = frac; }
+   Float_t GetMergeThreshold() const { return fMergeThreshold; }
+
+   /// Set number of received bytes waiting to be merged above which no further upload is read from the clients
+   void SetMaxPendingBytes(Long64_t nbytes) { fMaxPendingBytes = nbytes; }
+   Long64_t GetMaxPendingBytes() const { return fMaxPendingBytes; }
+
+   /// Enable a TFileCacheWrite of 32 MB for the output files
+   void SetWriteCache(Bool_t on = kTRUE) { fWriteCache = on; }
+   Bool_t GetWriteCache() const { return fWriteCache; }
+
+   UInt_t GetNThreads() const { return fNThreads; }
+
+   Int_t Run();
+
+   ClassDefOverride(TParallelMergingServer, 0) // Multi-threaded server merging the uploads of TParallelMergingFile
+};
+
+#endif
@@ -87,7 +87,12 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
       fBufComp    = fBuffer;
       fBufCompCur = fBuffer + bufsize;
       fBuffer     = nullptr;
-      Uncompress();
+      if (Uncompress() == 0) {
+         // the compressed copy is not needed to read the message
+         delete [] fBufComp;
+         fBufComp    = nullptr;
+         fBufCompCur = nullptr;
+      }
    }
 
    if (fWhat == kMESS_OBJECT) {
@@ -0,0 +1,489 @@
+// @(#)root/net:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TParallelMergingServer.h"
+
+#include "TBits.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TError.h"
+#include "TFileCacheWrite.h"
+#include "TFileMerger.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TMemFile.h"
+#include "TMessage.h"
+#include "TMonitor.h"
+#include "TROOT.h"
+#include "TServerSocket.h"
+#include "TSocket.h"
+#include "TTimeStamp.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+
+/** \class TParallelMergingServer
+\ingroup net
+
+Server merging the files uploaded by the clients using TParallelMergingFile,
+into the files of the same name, as done by tutorials/net/parallelMergeServer.C
+but with several merging threads.
+
+The sockets are read by the thread calling Run(), the uploads are then merged by
+a pool of threads. Each output file is assigned to one of the threads based on
+its name, so that the uploads for different files are merged concurrently while
+the uploads for the same file are merged in order, by incremental
+TFileMerger::PartialMerge calls. The objects which are reset after merging, like
+TTree, are merged as soon as they are received; the other ones, like histograms,
+are merged once GetMergeThreshold() of the clients of the file have reported or
+when a client is late compared to the usual reporting intervals.
+
+When more than GetMaxPendingBytes() have been received and are not merged yet,
+the server stops reading the clients until the merging threads have caught up,
+so that the clients get blocked in their uploads instead of the server running
+out of memory.
+
+~~~ {.cpp}
+TParallelMergingServer server(1095, 8);
+server.Run(); // returns once all the clients have finished
+~~~
+*/
+
+ClassImp(TParallelMergingServer);
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if the directory contains objects which are reset after merging
+
+Bool_t NeedInitialMerge(TDirectory *dir)
+{
+   if (!dir)
+      return kFALSE;
+
+   TIter nextkey(dir->GetListOfKeys());
+   while (auto key = (TKey *)nextkey()) {
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (!cl)
+         continue;
+      if (cl->InheritsFrom(TDirectory::Class())) {
+         TDirectory *subdir = (TDirectory *)dir->GetList()->FindObject(key->GetName());
+         if (!subdir)
+            subdir = (TDirectory *)key->ReadObj();
+         if (NeedInitialMerge(subdir))
+            return kTRUE;
+      } else if (cl->GetResetAfterMerge()) {
+         return kTRUE;
+      }
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the keys of the objects which are reset after merging (withReset) or
+/// of the ones which are not
+
+void DeleteObjects(TDirectory *dir, Bool_t withReset)
+{
+   if (!dir)
+      return;
+
+   TIter nextkey(dir->GetListOfKeys());
+   while (auto key = (TKey *)nextkey()) {
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (!cl)
+         continue;
+      if (cl->InheritsFrom(TDirectory::Class())) {
+         TDirectory *subdir = (TDirectory *)dir->GetList()->FindObject(key->GetName());
+         if (!subdir)
+            subdir = (TDirectory *)key->ReadObj();
+         DeleteObjects(subdir, withReset);
+      } else if (withReset == (cl->GetResetAfterMerge() != nullptr)) {
+         key->Delete();
+         dir->GetListOfKeys()->Remove(key);
+         delete key;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the keys of source into destination, replacing the keys of the same name
+
+void MigrateKeys(TDirectory *destination, TDirectory *source)
+{
+   if (!destination || !source)
+      return;
+
+   TIter nextkey(source->GetListOfKeys());
+   while (auto key = (TKey *)nextkey()) {
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (!cl)
+         continue;
+      if (cl->InheritsFrom(TDirectory::Class())) {
+         TDirectory *source_subdir = (TDirectory *)source->GetList()->FindObject(key->GetName());
+         if (!source_subdir)
+            source_subdir = (TDirectory *)key->ReadObj();
+         TDirectory *destination_subdir = destination->GetDirectory(key->GetName());
+         if (!destination_subdir)
+            destination_subdir = destination->mkdir(key->GetName());
+         MigrateKeys(destination_subdir, source_subdir);
+      } else {
+         TKey *oldkey = destination->GetKey(key->GetName());
+         if (oldkey) {
+            oldkey->Delete();
+            delete oldkey;
+         }
+         // both files come from the same client, there is no pid offset
+         TKey *newkey = new TKey(destination, *key, 0);
+         destination->GetFile()->SumBuffer(newkey->GetObjlen());
+         newkey->WriteFile(0);
+         if (destination->GetFile()->TestBit(TFile::kWriteError))
+            return;
+      }
+   }
+   destination->SaveSelf();
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// State of an output file and of the last uploads of its clients
+
+struct TParallelMergingServer::RFileMerger {
+   struct RClient {
+      std::unique_ptr<TFile> fFile;        ///< objects of the client merged again at each merge
+      Double_t fLastContact{0};            ///< time of last upload
+      Double_t fTimeSincePrevContact{0};   ///< interval between last two uploads
+   };
+
+   TFileMerger fMerger{kFALSE, kTRUE};     ///< merger of the output file
+   std::vector<RClient> fClients;          ///< clients, by index
+   TBits fContacts;                        ///< clients which have reported since last merge
+   UInt_t fNContacts{0};                   ///< number of uploads since last merge
+   Double_t fLastMerge;                    ///< time of last merge
+
+   RFileMerger(const std::string &filename, Bool_t writeCache) : fLastMerge(TTimeStamp().AsDouble())
+   {
+      fMerger.SetPrintLevel(0);
+      fMerger.OutputFile(filename.c_str(), "RECREATE");
+      if (writeCache)
+         new TFileCacheWrite(fMerger.GetOutputFile(), 32 * 1024 * 1024);
+   }
+
+   /// Merge the objects of input which are reset after merging and remove them from input
+   Bool_t InitialMerge(TFile *input)
+   {
+      fMerger.AddFile(input);
+      Bool_t result = fMerger.PartialMerge(TFileMerger::kIncremental | TFileMerger::kResetable);
+      DeleteObjects(input, kTRUE);
+      return result;
+   }
+
+   /// Merge the last uploads of all the clients into the output file
+   Bool_t Merge()
+   {
+      // remove the objects which are not incrementally merged, they are merged again from all the clients
+      DeleteObjects(fMerger.GetOutputFile(), kFALSE);
+      for (auto &client : fClients)
+         if (client.fFile)
+            fMerger.AddFile(client.fFile.get());
+      Bool_t result = fMerger.PartialMerge(TFileMerger::kAllIncremental);
+
+      // keep only the objects which always have to be re-merged, like histograms
+      for (auto &client : fClients)
+         if (client.fFile)
+            DeleteObjects(client.fFile.get(), kTRUE);
+
+      fLastMerge = TTimeStamp().AsDouble();
+      fNContacts = 0;
+      fContacts.Clear();
+      return result;
+   }
+
+   /// Returns true if some uploads were not merged yet
+   Bool_t NeedFinalMerge() { return fContacts.CountBits() > 0; }
+
+   /// Returns true if enough clients have reported or if clients are late compared to their usual interval
+   Bool_t NeedMerge(Float_t threshold)
+   {
+      if (fClients.empty())
+         return kFALSE;
+
+      Double_t sum = 0, sum2 = 0;
+      UInt_t n = 0;
+      for (auto &client : fClients) {
+         if (!client.fFile)
+            continue;
+         sum += client.fTimeSincePrevContact;
+         sum2 += client.fTimeSincePrevContact * client.fTimeSincePrevContact;
+         ++n;
+      }
+      if (n == 0)
+         return kFALSE;
+      Double_t avg = sum / n;
+      Double_t sigma = sum2 ? TMath::Sqrt(std::max(0., sum2 / n - avg * avg)) : 0;
+      if (TTimeStamp().AsDouble() - fLastMerge > avg + 2 * sigma)
+         return kTRUE;
+
+      Float_t cut = threshold * n;
+      return fContacts.CountBits() > cut || fNContacts > 2 * cut;
+   }
+
+   /// Register the upload of a client, the merger takes ownership of the file
+   void RegisterClient(UInt_t clientId, TFile *file)
+   {
+      ++fNContacts;
+      fContacts.SetBitNumber(clientId);
+      if (fClients.size() <= clientId)
+         fClients.resize(clientId + 1);
+
+      RClient &client = fClients[clientId];
+      if (client.fFile) {
+         // keep the objects of the previous upload which are not in the new one
+         MigrateKeys(client.fFile.get(), file);
+         delete file;
+      } else {
+         client.fFile.reset(file);
+      }
+
+      Double_t now = TTimeStamp().AsDouble();
+      if (client.fLastContact > 0)
+         client.fTimeSincePrevContact = now - client.fLastContact;
+      client.fLastContact = now;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merging thread with its queue of uploads
+
+struct TParallelMergingServer::RShard {
+   struct RUpload {
+      std::unique_ptr<TMessage> fMessage; ///< received message
+      Int_t fClientId{-1};                ///< index of the client
+      std::string fFilename;              ///< name of the output file
+      Long64_t fLength{0};                ///< length of the file in the message
+   };
+
+   std::mutex fMutex;                                           ///< protects fQueue and fStop
+   std::condition_variable fCondition;                          ///< signalled when an upload is queued or at stop
+   std::deque<RUpload> fQueue;                                  ///< uploads waiting to be merged
+   Bool_t fStop{kFALSE};                                        ///< no more uploads will come
+   std::map<std::string, std::unique_ptr<RFileMerger>> fFiles; ///< output files, only used by the thread
+   std::thread fThread;                                         ///< merging thread
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, the server listens on the port once Run() is called.
+/// By default uses one merging thread per core.
+
+TParallelMergingServer::TParallelMergingServer(Int_t port, UInt_t nthreads) : fPort(port), fNThreads(nthreads)
+{
+   if (fNThreads == 0)
+      fNThreads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TParallelMergingServer::~TParallelMergingServer()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Queue a received upload to the thread merging its output file, takes ownership of the message
+
+void TParallelMergingServer::Enqueue(TMessage *mess)
+{
+   RShard::RUpload upload;
+   upload.fMessage.reset(mess);
+
+   TString filename;
+   mess->ReadInt(upload.fClientId);
+   mess->ReadTString(filename);
+   mess->ReadLong64(upload.fLength);
+   upload.fFilename = filename.Data();
+
+   if ((upload.fClientId < 0) || (upload.fLength <= 0) || (upload.fLength > mess->BufferSize() - mess->Length())) {
+      Error("Run", "invalid upload from client %d for %s", upload.fClientId, filename.Data());
+      return;
+   }
+
+   RShard &shard = *fShards[std::hash<std::string>()(upload.fFilename) % fShards.size()];
+
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fPendingBytes += mess->BufferSize();
+   }
+   {
+      std::lock_guard<std::mutex> lock(shard.fMutex);
+      shard.fQueue.emplace_back(std::move(upload));
+   }
+   shard.fCondition.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Account merged upload, wakes up the receiving thread if it was waiting
+
+void TParallelMergingServer::Merged(Long64_t nbytes)
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fPendingBytes -= nbytes;
+   }
+   fCondition.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Body of the merging threads: merge the queued uploads until the server stops,
+/// then do the final merge of the output files and close them
+
+void TParallelMergingServer::ProcessShard(RShard &shard)
+{
+   while (true) {
+      RShard::RUpload upload;
+      {
+         std::unique_lock<std::mutex> lock(shard.fMutex);
+         shard.fCondition.wait(lock, [&shard] { return shard.fStop || !shard.fQueue.empty(); });
+         if (shard.fQueue.empty())
+            break;
+         upload = std::move(shard.fQueue.front());
+         shard.fQueue.pop_front();
+      }
+
+      // UPDATE because the objects reset after merging are removed from the file once merged
+      TMessage *mess = upload.fMessage.get();
+      Long64_t nbytes = mess->BufferSize();
+      TMemFile *transient =
+         new TMemFile(upload.fFilename.c_str(), mess->Buffer() + mess->Length(), upload.fLength, "UPDATE");
+      upload.fMessage.reset();
+
+      auto &merger = shard.fFiles[upload.fFilename];
+      if (!merger)
+         merger.reset(new RFileMerger(upload.fFilename, fWriteCache));
+
+      if (NeedInitialMerge(transient))
+         merger->InitialMerge(transient);
+      merger->RegisterClient(upload.fClientId, transient);
+      if (merger->NeedMerge(fMergeThreshold)) {
+         if (gDebug > 0)
+            Info("Run", "merging %s from %d clients", upload.fFilename.c_str(), (int)merger->fClients.size());
+         merger->Merge();
+      }
+
+      Merged(nbytes);
+   }
+
+   for (auto &entry : shard.fFiles)
+      if (entry.second->NeedFinalMerge())
+         entry.second->Merge();
+   shard.fFiles.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Accept the clients and merge their uploads until all of them have finished.
+/// Returns the number of clients which connected or -1 if the port could not
+/// be opened.
+
+Int_t TParallelMergingServer::Run()
+{
+   TServerSocket ss(fPort, kTRUE, fMaxClients);
+   if (!ss.IsValid()) {
+      Error("Run", "cannot listen on port %d", fPort);
+      return -1;
+   }
+
+   ROOT::EnableThreadSafety();
+
+   fPendingBytes = 0;
+   fShards.clear();
+   for (UInt_t n = 0; n < fNThreads; ++n) {
+      fShards.emplace_back(new RShard);
+      RShard &shard = *fShards.back();
+      shard.fThread = std::thread([this, &shard] { ProcessShard(shard); });
+   }
+
+   TMonitor mon;
+   mon.Add(&ss);
+   std::set<TSocket *> clients;
+   Int_t nclients = 0;
+
+   auto close = [&](TSocket *s) {
+      mon.Remove(s);
+      s->Close();
+      clients.erase(s);
+      delete s;
+   };
+
+   while (true) {
+      {
+         // leave the clients blocked in their uploads while the merging threads are behind
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCondition.wait(lock, [this] { return fPendingBytes <= fMaxPendingBytes; });
+      }
+
+      TSocket *s = mon.Select();
+      if (!s || (s == (TSocket *)-1))
+         continue;
+
+      if (s == &ss) {
+         TSocket *client = ss.Accept();
+         if (!client || (client == (TSocket *)-1))
+            continue;
+         if ((Int_t)clients.size() >= fMaxClients) {
+            Warning("Run", "only %d clients can be connected at the same time", fMaxClients);
+            client->Close();
+            delete client;
+            continue;
+         }
+         client->Send(nclients++, kStartConnection);
+         client->Send(kProtocolVersion, kProtocol);
+         clients.insert(client);
+         mon.Add(client);
+         continue;
+      }
+
+      TMessage *mess = nullptr;
+      if ((s->Recv(mess) <= 0) || !mess) {
+         // client died
+         close(s);
+      } else if (mess->What() == kMESS_STRING) {
+         // client finished
+         close(s);
+      } else if (mess->What() == kMESS_ANY) {
+         Enqueue(mess);
+         mess = nullptr;
+      } else {
+         Warning("Run", "unexpected message %d", mess->What());
+      }
+      delete mess;
+
+      if (clients.empty() && (nclients > 0))
+         break;
+   }
+
+   for (auto &shard : fShards) {
+      {
+         std::lock_guard<std::mutex> lock(shard->fMutex);
+         shard->fStop = kTRUE;
+      }
+      shard->fCondition.notify_one();
+   }
+   for (auto &shard : fShards)
+      shard->fThread.join();
+   fShards.clear();
+
+   return nclients;
+}
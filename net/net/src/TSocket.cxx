@@ -35,6 +35,10 @@
 #include "TVirtualAuth.h"
 #include "TStreamerInfo.h"
 #include "TProcessID.h"
+#include "RZip.h"
+
+#include <algorithm>
+#include <vector>
 
 
 ULong64_t TSocket::fgBytesSent = 0;
@@ -808,6 +812,109 @@ Int_t TSocket::Recv(Int_t &status, Int_t &kind)
    return n;   // number of bytes read (2 * sizeof(Int_t)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Receive the len bytes following the length word of a message into a new
+/// buffer laid out as expected by TMessage(void *, Int_t). A compressed message
+/// is uncompressed chunk by chunk while it is being received, so that only the
+/// uncompressed message and one compressed chunk are in memory at any time,
+/// instead of the complete compressed message in addition to the uncompressed
+/// one. In that case kMESS_ZIP is cleared in the buffer and iszip is set.
+/// Returns the number of bytes read or the error code of RecvRaw(), -1 if the
+/// compressed data are inconsistent; in case of error buf is 0.
+
+static Int_t RecvMessageBuffer(Int_t sock, UInt_t len, char *&buf, Int_t &bufsize, Bool_t &iszip)
+{
+   const Int_t hdrlen = sizeof(UInt_t) + sizeof(UInt_t); // length and message type
+   const Int_t chdrlen = 9;                                // header of a compressed chunk
+
+   buf = nullptr;
+   bufsize = 0;
+   iszip = kFALSE;
+
+   Int_t n;
+   UInt_t what = 0;
+   if (len >= 2*sizeof(UInt_t)) {
+      if ((n = gSystem->RecvRaw(sock, &what, sizeof(UInt_t), 0)) <= 0)
+         return n;
+      what = net2host(what);
+   }
+
+   if (!(what & kMESS_ZIP)) {
+      buf = new char[len+sizeof(UInt_t)];
+      char *cur = buf + sizeof(UInt_t);
+      UInt_t nread = 0;
+      if (len >= 2*sizeof(UInt_t)) {
+         tobuf(cur, what);
+         nread = sizeof(UInt_t);
+      }
+      if ((n = gSystem->RecvRaw(sock, cur, len - nread, 0)) <= 0) {
+         delete [] buf;
+         buf = nullptr;
+         return n;
+      }
+      bufsize = len + sizeof(UInt_t);
+      return len;
+   }
+
+   Int_t buflen;
+   if ((n = gSystem->RecvRaw(sock, &buflen, sizeof(Int_t), 0)) <= 0)
+      return n;
+   buflen = net2host((UInt_t)buflen);
+
+   // bytes of the message still to be read, which have to be drained in case of error
+   Long64_t left = (Long64_t)len - 2*(Long64_t)sizeof(UInt_t);
+   std::vector<UChar_t> chunk;
+   Bool_t ok = (buflen >= hdrlen);
+   if (ok) {
+      buf = new char[buflen];
+      char *cur = buf + sizeof(UInt_t);
+      tobuf(cur, what & ~kMESS_ZIP);
+   }
+   Int_t nout = 0, noutot = 0;
+   while (left > 0) {
+      Int_t nin = 0, nbuf = 0;
+      if (ok) {
+         chunk.resize(chdrlen);
+         ok = (left >= chdrlen);
+      }
+      if (ok) {
+         if ((n = gSystem->RecvRaw(sock, chunk.data(), chdrlen, 0)) <= 0)
+            break;
+         left -= chdrlen;
+         ok = (R__unzip_header(&nin, chunk.data(), &nbuf) == 0) && (nin - chdrlen <= left) &&
+              (nbuf <= buflen - hdrlen - noutot);
+      }
+      if (!ok) {
+         // skip the rest of the message to keep the connection usable
+         chunk.resize(std::min(left, (Long64_t)kMAXZIPBUF));
+         if ((n = gSystem->RecvRaw(sock, chunk.data(), chunk.size(), 0)) <= 0)
+            break;
+         left -= chunk.size();
+         continue;
+      }
+      chunk.resize(nin);
+      if ((nin > chdrlen) && (n = gSystem->RecvRaw(sock, chunk.data() + chdrlen, nin - chdrlen, 0)) <= 0)
+         break;
+      left -= nin - chdrlen;
+      R__unzip(&nin, chunk.data(), &nbuf, (UChar_t *)buf + hdrlen + noutot, &nout);
+      ok = (nout == nbuf);
+      noutot += nout;
+   }
+
+   if (left > 0 || !ok || (noutot != buflen - hdrlen)) {
+      if (left <= 0)
+         ::Error("TSocket::Recv", "inconsistent compressed message (%d bytes uncompressed, %d expected)",
+                 noutot, buflen - hdrlen);
+      delete [] buf;
+      buf = nullptr;
+      return (left > 0) ? n : -1;
+   }
+
+   bufsize = buflen;
+   iszip = kTRUE;
+   return len;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Receive a TMessage object. The user must delete the TMessage object.
 /// Returns length of message in bytes (can be 0 if other side of connection
@@ -839,13 +946,14 @@ oncemore:
    len = net2host(len);  //from network to host byte order
 
    ResetBit(TSocket::kBrokenConn);
-   char *buf = new char[len+sizeof(UInt_t)];
-   if ((n = gSystem->RecvRaw(fSocket, buf+sizeof(UInt_t), len, 0)) <= 0) {
+   char *buf;
+   Int_t bufsize;
+   Bool_t iszip;
+   if ((n = RecvMessageBuffer(fSocket, len, buf, bufsize, iszip)) <= 0) {
       if (n == 0 || n == -5) {
          // Connection closed, reset or broken
          MarkBrokenConnection();
       }
-      delete [] buf;
       mess = 0;
       return n;
    }
@@ -853,7 +961,9 @@ oncemore:
    fBytesRecv  += n + sizeof(UInt_t);
    fgBytesRecv += n + sizeof(UInt_t);
 
-   mess = new TMessage(buf, len+sizeof(UInt_t));
+   mess = new TMessage(buf, bufsize);
+   if (iszip)
+      mess->SetCompressionSettings(1);
 
    // receive any streamer infos
    if (RecvStreamerInfos(mess))
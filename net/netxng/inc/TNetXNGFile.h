@@ -50,13 +50,14 @@ private:
    // if requested
    Int_t                   fReadvIorMax; // Max size of a single readv chunk
    Int_t                   fReadvIovMax; // Max number of readv chunks
+   Long64_t                fReadvMaxInFlight; // Max number of bytes requested by pending readvs
    Int_t                   fQueryReadVParams;
    TString                 fNewUrl;
 
 public:
    TNetXNGFile() : TFile(),
       fFile(0), fUrl(0), fMode(XrdCl::OpenFlags::None), fInitCondVar(0),
-      fReadvIorMax(0), fReadvIovMax(0) {}
+      fReadvIorMax(0), fReadvIovMax(0), fReadvMaxInFlight(0) {}
    TNetXNGFile(const char *url, const char *lurl, Option_t *mode , const char *title ,
                Int_t compress , Int_t netopt , Bool_t parallelopen );
    TNetXNGFile(const char *url, Option_t *mode = "", const char *title = "",
@@ -72,6 +73,8 @@ public:
    virtual Int_t    ReOpen(Option_t *modestr);
    virtual Bool_t   IsOpen() const;
    virtual Bool_t   WriteBuffer(const char *buffer, Int_t length);
+   virtual Bool_t   CanWriteBufferAt() const;
+   virtual Bool_t   WriteBufferAt(const char *buffer, Long64_t position, Int_t length);
    virtual void     Flush();
    virtual Bool_t   ReadBuffer(char *buffer, Int_t length);
    virtual Bool_t   ReadBuffer(char *buffer, Long64_t position, Int_t length);
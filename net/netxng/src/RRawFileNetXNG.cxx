@@ -0,0 +1,201 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RRawFileNetXNG.hxx"
+
+#include <XrdCl/XrdClFile.hh>
+#include <XrdCl/XrdClXRootDResponses.hh>
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int kDefaultBlockSize = 128 * 1024; // Read in relatively large 128k blocks for better network utilization
+// Limits of one XRootD readv request, same defaults as TNetXNGFile
+constexpr std::size_t kReadvIovMax = 1024;    // chunks per request
+constexpr std::uint32_t kReadvIorMax = 2097136; // bytes per chunk
+
+/// Collects the responses of the readv requests sent by one ReadV() call
+struct RReadVState {
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   std::size_t fPending = 0;
+   std::string fError;
+   /// Bytes read for each chunk of each readv request
+   std::vector<std::vector<std::uint32_t>> fOutBytes;
+};
+
+class RReadVHandler : public XrdCl::ResponseHandler {
+private:
+   RReadVState &fState;
+   std::size_t fIndex;
+
+public:
+   RReadVHandler(RReadVState &state, std::size_t index) : fState(state), fIndex(index) {}
+
+   void HandleResponse(XrdCl::XRootDStatus *status, XrdCl::AnyObject *response) final
+   {
+      XrdCl::VectorReadInfo *info = nullptr;
+      if (response)
+         response->Get(info);
+      {
+         // Notify under the lock: the state lives on the stack of the waiting ReadV()
+         std::lock_guard<std::mutex> lock(fState.fMutex);
+         if (!status->IsOK()) {
+            if (fState.fError.empty())
+               fState.fError = status->ToStr();
+         } else if (info) {
+            const auto &chunks = info->GetChunks();
+            auto &outBytes = fState.fOutBytes[fIndex];
+            for (std::size_t i = 0; i < chunks.size() && i < outBytes.size(); ++i)
+               outBytes[i] = chunks[i].length;
+         }
+         --fState.fPending;
+         fState.fCondition.notify_one();
+      }
+      delete status;
+      delete response;
+      delete this;
+   }
+};
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+struct RNetXNGFileDes {
+   RNetXNGFileDes() = default;
+   RNetXNGFileDes(const RNetXNGFileDes &) = delete;
+   RNetXNGFileDes &operator=(const RNetXNGFileDes &) = delete;
+   ~RNetXNGFileDes() = default;
+
+   XrdCl::File fFile;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+
+ROOT::Internal::RRawFileNetXNG::RRawFileNetXNG(std::string_view url, ROptions options)
+   : RRawFile(url, options), fFileDes(new RNetXNGFileDes())
+{
+}
+
+ROOT::Internal::RRawFileNetXNG::~RRawFileNetXNG()
+{
+   if (fFileDes->fFile.IsOpen())
+      fFileDes->fFile.Close();
+}
+
+std::unique_ptr<ROOT::Internal::RRawFile> ROOT::Internal::RRawFileNetXNG::Clone() const
+{
+   return std::make_unique<RRawFileNetXNG>(fUrl, fOptions);
+}
+
+std::uint64_t ROOT::Internal::RRawFileNetXNG::GetSizeImpl()
+{
+   XrdCl::StatInfo *info = nullptr;
+   auto status = fFileDes->fFile.Stat(false, info);
+   if (!status.IsOK()) {
+      throw std::runtime_error("Cannot determine size of '" + fUrl + "', error: " + status.ToStr());
+   }
+   std::uint64_t size = info->GetSize();
+   delete info;
+   return size;
+}
+
+void ROOT::Internal::RRawFileNetXNG::OpenImpl()
+{
+   auto status = fFileDes->fFile.Open(fUrl, XrdCl::OpenFlags::Read);
+   if (!status.IsOK()) {
+      throw std::runtime_error("Cannot open '" + fUrl + "', error: " + status.ToStr());
+   }
+   if (fOptions.fBlockSize < 0)
+      fOptions.fBlockSize = kDefaultBlockSize;
+}
+
+size_t ROOT::Internal::RRawFileNetXNG::ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset)
+{
+   // The size of one XrdCl read is a 32-bit integer
+   size_t total = 0;
+   while (total < nbytes) {
+      std::uint32_t size = std::min<size_t>(nbytes - total, 1u << 30);
+      std::uint32_t bytesRead = 0;
+      auto status = fFileDes->fFile.Read(offset + total, size, static_cast<char *>(buffer) + total, bytesRead);
+      if (!status.IsOK()) {
+         throw std::runtime_error("Cannot read from '" + fUrl + "', error: " + status.ToStr());
+      }
+      total += bytesRead;
+      if (bytesRead < size)
+         break;
+   }
+   return total;
+}
+
+void ROOT::Internal::RRawFileNetXNG::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
+{
+   // Split the requests into readv requests within the protocol limits, remembering the request of each chunk
+   std::vector<XrdCl::ChunkList> chunkLists;
+   std::vector<std::vector<unsigned int>> requests;
+   for (unsigned int i = 0; i < nReq; ++i) {
+      ioVec[i].fOutBytes = 0;
+      for (std::size_t done = 0; done < ioVec[i].fSize;) {
+         if (chunkLists.empty() || chunkLists.back().size() == kReadvIovMax) {
+            chunkLists.emplace_back();
+            requests.emplace_back();
+         }
+         std::uint32_t size = std::min<std::size_t>(ioVec[i].fSize - done, kReadvIorMax);
+         chunkLists.back().emplace_back(ioVec[i].fOffset + done, size, static_cast<char *>(ioVec[i].fBuffer) + done);
+         requests.back().push_back(i);
+         done += size;
+      }
+   }
+
+   RReadVState state;
+   state.fOutBytes.resize(chunkLists.size());
+   for (std::size_t n = 0; n < chunkLists.size(); ++n)
+      state.fOutBytes[n].resize(chunkLists[n].size(), 0);
+
+   // Send all the readv requests before waiting for the responses
+   for (std::size_t n = 0; n < chunkLists.size(); ++n) {
+      {
+         std::lock_guard<std::mutex> lock(state.fMutex);
+         ++state.fPending;
+      }
+      auto handler = new RReadVHandler(state, n);
+      auto status = fFileDes->fFile.VectorRead(chunkLists[n], nullptr, handler);
+      if (!status.IsOK()) {
+         delete handler;
+         std::lock_guard<std::mutex> lock(state.fMutex);
+         --state.fPending;
+         if (state.fError.empty())
+            state.fError = status.ToStr();
+         break;
+      }
+   }
+
+   {
+      std::unique_lock<std::mutex> lock(state.fMutex);
+      state.fCondition.wait(lock, [&state] { return state.fPending == 0; });
+   }
+   if (!state.fError.empty()) {
+      throw std::runtime_error("Cannot do vector read from '" + fUrl + "', error: " + state.fError);
+   }
+
+   for (std::size_t n = 0; n < chunkLists.size(); ++n) {
+      for (std::size_t j = 0; j < chunkLists[n].size(); ++j)
+         ioVec[requests[n][j]].fOutBytes += state.fOutBytes[n][j];
+   }
+}
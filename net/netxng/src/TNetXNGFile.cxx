@@ -30,6 +30,7 @@
 #include <XrdCl/XrdClXRootDResponses.hh>
 #include <XrdCl/XrdClDefaultEnv.hh>
 #include <XrdVersion.hh>
+#include <atomic>
 #include <iostream>
 
 //------------------------------------------------------------------------------
@@ -87,8 +88,11 @@ class TAsyncReadvHandler: public XrdCl::ResponseHandler
 
       TAsyncReadvHandler(std::vector<XrdCl::XRootDStatus*> *statuses,
                          Int_t                              statusIndex,
-                         TSemaphore                        *semaphore):
-         fStatuses(statuses), fStatusIndex(statusIndex), fSemaphore(semaphore) {}
+                         TSemaphore                        *semaphore,
+                         std::atomic<Long64_t>             *bytesInFlight,
+                         Long64_t                           bytes):
+         fStatuses(statuses), fStatusIndex(statusIndex), fSemaphore(semaphore),
+         fBytesInFlight(bytesInFlight), fBytes(bytes) {}
 
 
       //------------------------------------------------------------------------
@@ -99,6 +103,7 @@ class TAsyncReadvHandler: public XrdCl::ResponseHandler
                                   XrdCl::AnyObject    *response)
       {
          fStatuses->at(fStatusIndex) = status;
+         *fBytesInFlight -= fBytes;
          fSemaphore->Post();
          delete response;
          delete this;
@@ -108,6 +113,8 @@ class TAsyncReadvHandler: public XrdCl::ResponseHandler
       std::vector<XrdCl::XRootDStatus*> *fStatuses;    // Pointer to status vector
       Int_t                              fStatusIndex; // Index into status vector
       TSemaphore                        *fSemaphore;   // Synchronize the responses
+      std::atomic<Long64_t>             *fBytesInFlight; // Bytes requested and not yet received
+      Long64_t                           fBytes;       // Bytes requested by this readv
 };
 
 
@@ -162,6 +169,7 @@ TNetXNGFile::TNetXNGFile(const char *url,
    fQueryReadVParams = 1;
    fReadvIorMax = 2097136;
    fReadvIovMax = 1024;
+   fReadvMaxInFlight = 0;
 
    if (ParseOpenMode(mode, fOption, fMode, kTRUE)<0) {
       Error("Open", "could not parse open mode %s", mode);
@@ -531,48 +539,61 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    if( !chunks.empty() )
       chunkLists.push_back(chunks);
 
-   TAsyncReadvHandler *handler;
-   XRootDStatus        status;
+   TAsyncReadvHandler   *handler;
+   XRootDStatus          status;
+   std::atomic<Long64_t> bytesInFlight(0);
    semaphore = new TSemaphore(0);
    statuses  = new std::vector<XRootDStatus*>(chunkLists.size());
 
-   // Read asynchronously but wait for all responses
-   std::vector<ChunkList>::iterator it;
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it)
-   {
-      handler = new TAsyncReadvHandler(statuses, it - chunkLists.begin(),
-                                       semaphore);
-      status = fFile->VectorRead(*it, 0, handler);
+   // Issue all the vector reads without waiting for their responses, but keep
+   // at most fReadvMaxInFlight bytes requested and not yet received
+   size_t nIssued = 0, nReceived = 0;
+   Bool_t failed = kFALSE;
+   for (; nIssued < chunkLists.size(); ++nIssued) {
+      const ChunkList &chunkList = chunkLists[nIssued];
+      Long64_t bytes = 0;
+      for (const auto &chunk : chunkList)
+         bytes += chunk.length;
+
+      while (fReadvMaxInFlight > 0 && nReceived < nIssued &&
+             bytesInFlight + bytes > fReadvMaxInFlight) {
+         semaphore->Wait();
+         ++nReceived;
+      }
+
+      bytesInFlight += bytes;
+      handler = new TAsyncReadvHandler(statuses, nIssued, semaphore,
+                                       &bytesInFlight, bytes);
+      status = fFile->VectorRead(chunkList, 0, handler);
 
       if (!status.IsOK()) {
          Error("ReadBuffers", "%s", status.ToStr().c_str());
-         return kTRUE;
+         delete handler;
+         failed = kTRUE;
+         break;
       }
    }
 
-   // Wait for all responses
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it) {
+   // Wait for all responses, also in case of failure: the pending reads still
+   // write into the buffer and use the semaphore
+   for (; nReceived < nIssued; ++nReceived) {
       semaphore->Wait();
    }
 
    // Check for errors
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it) {
-      XRootDStatus *st = statuses->at(it - chunkLists.begin());
-
-      if (!st->IsOK()) {
+   for (size_t i = 0; i < nIssued; ++i) {
+      XRootDStatus *st = statuses->at(i);
+      if (!failed && !st->IsOK()) {
          Error("ReadBuffers", "%s", st->ToStr().c_str());
-         for( ; it != chunkLists.end(); ++it )
-         {
-            st = statuses->at( it - chunkLists.begin() );
-            delete st;
-         }
-         delete statuses;
-         delete semaphore;
-
-         return kTRUE;
+         failed = kTRUE;
       }
       delete st;
    }
+   delete statuses;
+   delete semaphore;
+
+   if (failed)
+      return kTRUE;
 
    // Bump the globals
    fBytesRead  += totalBytes;
@@ -588,8 +609,6 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    if (gMonitoringWriter)
       gMonitoringWriter->SendFileReadProgress(this);
 
-   delete statuses;
-   delete semaphore;
    return kFALSE;
 }
 
@@ -637,6 +656,36 @@ Bool_t TNetXNGFile::WriteBuffer(const char *buffer, Int_t length)
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// The xroot client writes at explicit offsets, so the write cache can write
+/// its buffers in the background.
+
+Bool_t TNetXNGFile::CanWriteBufferAt() const
+{
+   return IsUseable() && fWritable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write a buffer at the given position, without using or changing the
+/// current offset, see TFile::WriteBufferAt().
+///
+/// param buffer:   the buffer to be written
+/// param position: the position in the file
+/// param length:   the length of the buffer
+/// returns:        kTRUE in case of failure
+
+Bool_t TNetXNGFile::WriteBufferAt(const char *buffer, Long64_t position, Int_t length)
+{
+   using namespace XrdCl;
+
+   XRootDStatus st = fFile->Write(position, length, buffer);
+   if (!st.IsOK()) {
+      Error("WriteBufferAt", "%s", st.ToStr().c_str());
+      return kTRUE;
+   }
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TNetXNGFile::Flush()
@@ -877,6 +926,7 @@ void TNetXNGFile::SetEnv()
       env->PutString("ClientMonitorParam", val.Data());
 
    fQueryReadVParams = gEnv->GetValue("NetXNG.QueryReadVParams", 1);
+   fReadvMaxInFlight = gEnv->GetValue("NetXNG.ReadvMaxInFlight", 256 * 1024 * 1024);
    env->PutInt( "MultiProtocol", gEnv->GetValue("TFile.CrossProtocolRedirects", 1));
 
    // Old style netrc file
@@ -19,7 +19,9 @@
 
 #include "RooSpan.h"
 
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 class RooArgSet;
@@ -44,6 +46,7 @@ struct RunContext {
   RooSpan<const double> operator[](const RooAbsReal* owner) const { return getBatch(owner); }
   RooSpan<double> getWritableBatch(const RooAbsReal* owner);
   RooSpan<double> makeBatch(const RooAbsReal* owner, std::size_t size);
+  bool ownsMemory(const double* data) const;
 
   /// Clear all computation results without freeing memory.
   void clear() { spans.clear(); rangeName = nullptr; }
@@ -54,6 +57,10 @@ struct RunContext {
   std::unordered_map<const RooAbsReal*, std::vector<double>> ownedMemory;
   const char* rangeName{nullptr}; /// If evaluation should only occur in a range, the range name can be passed here.
   std::vector<double> logProbabilities; /// Possibility to register log probabilities.
+  /// Copies of data in the memory of an accelerator such as a GPU, indexed by the address of the data on the host,
+  /// with their size. They are managed by the computation library of the accelerator; since they are not cleared
+  /// by clear(), the observables of a fit only need to be copied to the accelerator once.
+  std::unordered_map<const double*, std::pair<std::shared_ptr<double>, std::size_t>> deviceMemory;
 };
 
 }
@@ -61,6 +61,18 @@ void loadComputeLibrary() {
   } else if (gDebug>0) {
     std::cout << "In roofitcore/InitUtils.cxx:loadComputeLibrary(): Library " + libName + " was loaded successfully" << std::endl;
   }
+
+#ifdef R__RF_CUDA_LIB
+  // The CUDA library forwards to the CPU library what it cannot compute, so it is loaded last.
+  if (gEnv->GetValue("RooFit.LoadCUDAComputationLibrary", 0) != 0) {
+    const auto cudaReturnValue = gSystem->Load("libRooBatchCompute_CUDA");
+    if (cudaReturnValue < 0) {
+      std::cerr << "In roofitcore/InitUtils.cxx:loadComputeLibrary(): Unable to load libRooBatchCompute_CUDA, using " + libName + "." << std::endl;
+    } else if (gDebug>0) {
+      std::cout << "In roofitcore/InitUtils.cxx:loadComputeLibrary(): Library libRooBatchCompute_CUDA was loaded successfully" << std::endl;
+    }
+  }
+#endif //R__RF_CUDA_LIB
 }
 
 } //end anonymous namespace
@@ -0,0 +1,416 @@
+// CUDA backend of the RooBatchCompute library
+#include "RooBatchCompute.h"
+
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace RooBatchCompute {
+  namespace RF_ARCH {
+
+    /// Throw if a call to the CUDA runtime failed.
+    void checkCuda(cudaError_t error, const char* what)
+    {
+      if (error != cudaSuccess)
+        throw std::runtime_error(std::string("RooBatchCompute_CUDA: ") + what + " failed: " + cudaGetErrorString(error));
+    }
+
+    /// Input of a kernel, either an array in the memory of the device or a scalar.
+    /// It is passed by value to the kernels, so that the scalar parameters of a PDF don't need a copy to the device.
+    struct Batch {
+      const double* _array = nullptr;
+      double _scalar = 0.0;
+
+      __device__ double operator[](size_t i) const {
+        return _array ? _array[i] : _scalar;
+      }
+    };
+
+    /// The kernel shared by all the PDFs: each thread computes the PDF for some of the events.
+    template <class Computer_t, class... Batches_t>
+    __global__ void computeKernel(Computer_t computer, size_t n, double* __restrict output, Batches_t... batches)
+    {
+      for (size_t i = blockIdx.x*blockDim.x + threadIdx.x; i < n; i += blockDim.x*gridDim.x) {
+        output[i] = computer(i, batches...);
+      }
+    }
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // The computers below compute the same as their counterparts in RooBatchCompute.cxx, for one event.
+
+    struct ArgusBGComputer {
+      __device__ double operator()(size_t i, Batch M, Batch M0, Batch C, Batch P) const
+      {
+        if (M[i] >= M0[i]) return 0.0;
+        const double t = M[i]/M0[i];
+        const double u = 1 - t*t;
+        return M[i]*exp(C[i]*u + P[i]*log(u));
+      }
+    };
+
+    struct BifurGaussComputer {
+      __device__ double operator()(size_t i, Batch X, Batch M, Batch SL, Batch SR) const
+      {
+        const double arg = X[i]-M[i];
+        if (arg <= 1e-30 && arg >= -1e-30) return 1.0;
+        const double t = arg / (arg < 0.0 ? SL[i] : SR[i]);
+        return exp(-0.5*t*t);
+      }
+    };
+
+    struct BukinComputer {
+      __device__ double operator()(size_t i, Batch X, Batch XP, Batch SP, Batch XI, Batch R1, Batch R2) const
+      {
+        const double r3 = log(2.0);
+        const double r6 = exp(-6.0);
+        const double r7 = 2*sqrt(2*log(2.0));
+
+        const double r1 = XI[i]*rsqrt(XI[i]*XI[i]+1);
+        const double r4 = sqrt(XI[i]*XI[i]+1);
+        const double hp = 1 / (SP[i]*r7);
+        const double x1 = XP[i] + 0.5*SP[i]*r7*(r1-1);
+        const double x2 = XP[i] + 0.5*SP[i]*r7*(r1+1);
+
+        double r5 = 1.0;
+        if (XI[i]>r6 || XI[i]<-r6) r5 = XI[i]/log(r4+XI[i]);
+
+        double factor=1, y=X[i]-x1, Yp=XP[i]-x1, yi=r4-XI[i], rho=R1[i];
+        if (X[i]>=x2) {
+          factor = -1;
+          y = X[i]-x2;
+          Yp = XP[i]-x2;
+          yi = r4+XI[i];
+          rho = R2[i];
+        }
+
+        double result = rho*y*y/Yp/Yp -r3 + factor*4*r3*y*hp*r5*r4/yi/yi;
+        if (X[i]>=x1 && X[i]<x2) {
+          if (XI[i]<r6 && XI[i]>-r6) {
+            result = -4*r3*(X[i]-XP[i])*(X[i]-XP[i])*hp*hp;
+          } else {
+            result = log(1 + 4*XI[i]*r4*(X[i]-XP[i])*hp) / log(1 +2*XI[i]*( XI[i]-r4 ));
+            result *= -result*r3;
+          }
+        }
+        return exp(result);
+      }
+    };
+
+    struct BreitWignerComputer {
+      __device__ double operator()(size_t i, Batch X, Batch M, Batch W) const
+      {
+        const double arg = X[i]-M[i];
+        return 1 / (arg*arg + 0.25*W[i]*W[i]);
+      }
+    };
+
+    struct CBShapeComputer {
+      __device__ double operator()(size_t i, Batch M, Batch M0, Batch S, Batch A, Batch N) const
+      {
+        const double t = (M[i]-M0[i]) / S[i];
+        if ( (A[i]>0 && t>=-A[i]) || (A[i]<0 && -t>=A[i]) ) {
+          return exp(-0.5*t*t);
+        }
+        return exp(N[i]*log(N[i] / (N[i] -A[i]*A[i] -A[i]*t)) - 0.5*A[i]*A[i]);
+      }
+    };
+
+    struct ChiSquareComputer {
+      __device__ double operator()(size_t i, Batch X, Batch N) const
+      {
+        constexpr double ln2 = 0.693147180559945309417232121458;
+        const double arg = (N[i]-2)*log(X[i]) -X[i] -N[i]*ln2;
+        return exp(0.5*arg) / tgamma(N[i]/2.0);
+      }
+    };
+
+    struct DstD0BGComputer {
+      __device__ double operator()(size_t i, Batch DM, Batch DM0, Batch C, Batch A, Batch B) const
+      {
+        const double ratio = DM[i] / DM0[i];
+        const double arg1 = (DM0[i]-DM[i]) / C[i];
+        const double arg2 = A[i]*log(ratio);
+        const double result = (1 -exp(arg1)) * exp(arg2) +B[i]*(ratio-1);
+        return result < 0 ? 0.0 : result;
+      }
+    };
+
+    struct ExponentialComputer {
+      __device__ double operator()(size_t i, Batch x, Batch c) const
+      {
+        return exp(x[i]*c[i]);
+      }
+    };
+
+    struct GammaComputer {
+      __device__ double operator()(size_t i, Batch X, Batch G, Batch B, Batch M) const
+      {
+        if (X[i] == M[i]) {
+          return ((G[i]==1.0) ? 1. : 0.)/B[i];
+        }
+        const double invBeta = 1/B[i];
+        const double arg = (X[i]-M[i])*invBeta;
+        return exp(-lgamma(G[i]) - arg + log(arg)*(G[i]-1)) * invBeta;
+      }
+    };
+
+    struct GaussianComputer {
+      __device__ double operator()(size_t i, Batch x, Batch mean, Batch sigma) const
+      {
+        const double arg = x[i]-mean[i];
+        const double halfBySigmaSq = -0.5 / (sigma[i]*sigma[i]);
+        return exp(arg*arg*halfBySigmaSq);
+      }
+    };
+
+    struct JohnsonComputer {
+      __device__ double operator()(size_t i, Batch mass, Batch mu, Batch lambda, Batch gamma, Batch delta) const
+      {
+        constexpr double sqrt_twoPi = 2.506628274631000502415765284811;
+        if (mass[i] < massThreshold) return 0.0;
+        const double arg = (mass[i]-mu[i]) / lambda[i];
+        const double expo = gamma[i] + delta[i]*asinh(arg);
+        return delta[i]*exp(-0.5*expo*expo)*rsqrt(1. +arg*arg) / (sqrt_twoPi*lambda[i]);
+      }
+      const double massThreshold;
+    };
+
+    struct LognormalComputer {
+      __device__ double operator()(size_t i, Batch X, Batch M0, Batch K) const
+      {
+        constexpr double rootOf2pi = 2.506628274631000502415765284811;
+        const double lnk = fabs(log(K[i]));
+        double arg = log(X[i]/M0[i])/lnk;
+        arg *= -0.5*arg;
+        return exp(arg) / (X[i]*lnk*rootOf2pi);
+      }
+    };
+
+    struct NovosibirskComputer {
+      __device__ double operator()(size_t i, Batch X, Batch P, Batch W, Batch T) const
+      {
+        constexpr double xi = 2.3548200450309494; // 2 Sqrt( Ln(4) )
+        const double asinhTail = asinh(0.5*xi*T[i]);
+        const double ln = log(1 -(X[i]-P[i])*T[i]/W[i]);
+        double result = ln/asinhTail;
+        result *= -0.125*xi*xi*result;
+        result -= 2.0/xi/xi*asinhTail*asinhTail;
+        return exp(result);
+      }
+    };
+
+    struct PoissonComputer {
+      __device__ double operator()(size_t i, Batch x, Batch mean) const
+      {
+        if (protectNegative && mean[i] < 0.) return 1.E-3;
+        const double x_i = noRounding ? x[i] : floor(x[i]);
+        if (x_i < 0.) return 0.;
+        if (x_i == 0.) return exp(-mean[i]);
+        return exp(x_i*log(mean[i]) - mean[i] - lgamma(x_i + 1.));
+      }
+      const bool protectNegative;
+      const bool noRounding;
+    };
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /**
+     * \brief Implementation of the RooBatchComputeInterface that runs the computations on a CUDA device.
+     *
+     * The observables are copied to the device the first time that they are used with a RunContext, and they stay
+     * there in RunContext::deviceMemory for the following evaluations, e.g. at each step of a fit. Only the results,
+     * and the inputs computed by other PDFs on the host, are copied at each evaluation.
+     *
+     * Small batches, inputs without any vector and the PDFs that are not ported to CUDA (Bernstein, Chebychev, Landau,
+     * Polynomial and Voigtian) are forwarded to the CPU library that was registered before this one. If no CUDA device
+     * is found, this class does not register itself, and all computations stay on the CPU.
+     */
+    class RooBatchComputeClass : public RooBatchComputeInterface {
+      private:
+        /// Below this number of events, the copies to and from the device cost more than the computation on the CPU.
+        static constexpr size_t minDeviceBatchSize = 1024;
+        static constexpr unsigned int threadsPerBlock = 256;
+        static constexpr unsigned int maxBlocks = 1024;
+
+        RooBatchComputeInterface* _cpu = nullptr;
+
+        /// Allocate an array of `size` doubles on the device, freed when the last copy of the pointer is destroyed.
+        static std::shared_ptr<double> allocateOnDevice(size_t size)
+        {
+          double* ptr = nullptr;
+          checkCuda(cudaMalloc(&ptr, size*sizeof(double)), "cudaMalloc");
+          return std::shared_ptr<double>(ptr, [](double* p) { cudaFree(p); });
+        }
+
+        /// Return the copy on the device of `size` doubles at `hostData`, allocating it if needed.
+        /// `upToDate` is set to true if the data were already on the device.
+        static double* deviceArray(RunContext& evalData, const double* hostData, size_t size, bool& upToDate)
+        {
+          auto item = evalData.deviceMemory.find(hostData);
+          if (item != evalData.deviceMemory.end() && item->second.second == size) {
+            upToDate = true;
+            return item->second.first.get();
+          }
+
+          upToDate = false;
+          auto& entry = evalData.deviceMemory[hostData];
+          entry = {allocateOnDevice(size), size};
+          return entry.first.get();
+        }
+
+        /// Make the input of a kernel for the span `input`. Data which don't change during a fit are copied
+        /// only once, while the results of other computations, owned by the RunContext, are copied every time.
+        static Batch toDevice(RunContext& evalData, RooSpan<const double> input)
+        {
+          Batch batch;
+          if (input.size() <= 1) {
+            batch._scalar = input.empty() ? 0.0 : input[0];
+            return batch;
+          }
+
+          bool upToDate = false;
+          double* array = deviceArray(evalData, input.data(), input.size(), upToDate);
+          if (!upToDate || evalData.ownsMemory(input.data())) {
+            checkCuda(cudaMemcpy(array, input.data(), input.size()*sizeof(double), cudaMemcpyHostToDevice), "cudaMemcpy");
+          }
+          batch._array = array;
+          return batch;
+        }
+
+        /// Compute the batch size like the CPU implementation, and decide if the computation is worth a device.
+        static size_t analyseInputSpans(std::initializer_list<RooSpan<const double>> parameters, bool& useDevice)
+        {
+          size_t batchSize = SIZE_MAX;
+          useDevice = false;
+          for (const auto& span : parameters) {
+            if (span.size() > 1) {
+              batchSize = std::min(batchSize, span.size());
+              useDevice = true;
+            }
+          }
+          if (!useDevice) batchSize = 1;
+          useDevice = useDevice && batchSize >= minDeviceBatchSize;
+          return batchSize;
+        }
+
+        /// Check if a computation with these inputs should run on the device.
+        static bool worthDevice(std::initializer_list<RooSpan<const double>> parameters)
+        {
+          bool useDevice = false;
+          analyseInputSpans(parameters, useDevice);
+          return useDevice;
+        }
+
+        /// Copy the inputs to the device if needed, run the kernel and copy the results back into a batch of evalData.
+        template <class Computer_t, typename... Args_t>
+        RooSpan<double> startComputation(const RooAbsReal* caller, RunContext& evalData, Computer_t computer, Args_t... args)
+        {
+          bool useDevice = false;
+          const size_t batchSize = analyseInputSpans({args...}, useDevice);
+          RooSpan<double> output = evalData.makeBatch(caller, batchSize);
+
+          bool upToDate = false;
+          double* devOutput = deviceArray(evalData, output.data(), batchSize, upToDate);
+          const unsigned int nBlocks = std::min<size_t>((batchSize + threadsPerBlock - 1) / threadsPerBlock, maxBlocks);
+          computeKernel<<<nBlocks, threadsPerBlock>>>(computer, batchSize, devOutput, toDevice(evalData, args)...);
+          checkCuda(cudaGetLastError(), "kernel launch");
+          checkCuda(cudaMemcpy(output.data(), devOutput, batchSize*sizeof(double), cudaMemcpyDeviceToHost), "cudaMemcpy");
+
+          return output;
+        }
+
+      public:
+        RooBatchComputeClass() {
+          int nDevices = 0;
+          if (cudaGetDeviceCount(&nDevices) != cudaSuccess || nDevices == 0) {
+            // Keep the CPU library
+            return;
+          }
+          _cpu = RooBatchCompute::dispatch;
+          if (_cpu) RooBatchCompute::dispatch = this;
+        }
+
+        RooSpan<double> computeArgusBG(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> m, RooSpan<const double> m0, RooSpan<const double> c, RooSpan<const double> p)  override {
+          if (!worthDevice({m, m0, c, p})) return _cpu->computeArgusBG(caller, evalData, m, m0, c, p);
+          return startComputation(caller, evalData, ArgusBGComputer{}, m, m0, c, p);
+        }
+        void computeBernstein(size_t batchSize, double * __restrict output, const double * __restrict const xData, double xmin, double xmax, std::vector<double> coef)  override {
+          _cpu->computeBernstein(batchSize, output, xData, xmin, xmax, coef);
+        }
+        RooSpan<double> computeBifurGauss(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigmaL, RooSpan<const double> sigmaR)  override {
+          if (!worthDevice({x, mean, sigmaL, sigmaR})) return _cpu->computeBifurGauss(caller, evalData, x, mean, sigmaL, sigmaR);
+          return startComputation(caller, evalData, BifurGaussComputer{}, x, mean, sigmaL, sigmaR);
+        }
+        RooSpan<double> computeBukin(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> Xp, RooSpan<const double> sigp, RooSpan<const double> xi, RooSpan<const double> rho1, RooSpan<const double> rho2)  override {
+          if (!worthDevice({x, Xp, sigp, xi, rho1, rho2})) return _cpu->computeBukin(caller, evalData, x, Xp, sigp, xi, rho1, rho2);
+          return startComputation(caller, evalData, BukinComputer{}, x, Xp, sigp, xi, rho1, rho2);
+        }
+        RooSpan<double> computeBreitWigner(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> width)  override {
+          if (!worthDevice({x, mean, width})) return _cpu->computeBreitWigner(caller, evalData, x, mean, width);
+          return startComputation(caller, evalData, BreitWignerComputer{}, x, mean, width);
+        }
+        RooSpan<double> computeCBShape(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> m, RooSpan<const double> m0, RooSpan<const double> sigma, RooSpan<const double> alpha, RooSpan<const double> n)  override {
+          if (!worthDevice({m, m0, sigma, alpha, n})) return _cpu->computeCBShape(caller, evalData, m, m0, sigma, alpha, n);
+          return startComputation(caller, evalData, CBShapeComputer{}, m, m0, sigma, alpha, n);
+        }
+        void computeChebychev(size_t batchSize, double * __restrict output, const double * __restrict const xData, double xmin, double xmax, std::vector<double> coef)  override {
+          _cpu->computeChebychev(batchSize, output, xData, xmin, xmax, coef);
+        }
+        RooSpan<double> computeChiSquare(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> ndof)  override {
+          if (!worthDevice({x, ndof})) return _cpu->computeChiSquare(caller, evalData, x, ndof);
+          return startComputation(caller, evalData, ChiSquareComputer{}, x, ndof);
+        }
+        RooSpan<double> computeDstD0BG(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> dm, RooSpan<const double> dm0, RooSpan<const double> C, RooSpan<const double> A, RooSpan<const double> B)  override {
+          if (!worthDevice({dm, dm0, C, A, B})) return _cpu->computeDstD0BG(caller, evalData, dm, dm0, C, A, B);
+          return startComputation(caller, evalData, DstD0BGComputer{}, dm, dm0, C, A, B);
+        }
+        RooSpan<double> computeExponential(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> c)  override {
+          if (!worthDevice({x, c})) return _cpu->computeExponential(caller, evalData, x, c);
+          return startComputation(caller, evalData, ExponentialComputer{}, x, c);
+        }
+        RooSpan<double> computeGamma(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> gamma, RooSpan<const double> beta, RooSpan<const double> mu)  override {
+          if (!worthDevice({x, gamma, beta, mu})) return _cpu->computeGamma(caller, evalData, x, gamma, beta, mu);
+          return startComputation(caller, evalData, GammaComputer{}, x, gamma, beta, mu);
+        }
+        RooSpan<double> computeGaussian(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigma)  override {
+          if (!worthDevice({x, mean, sigma})) return _cpu->computeGaussian(caller, evalData, x, mean, sigma);
+          return startComputation(caller, evalData, GaussianComputer{}, x, mean, sigma);
+        }
+        RooSpan<double> computeJohnson(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> mass, RooSpan<const double> mu, RooSpan<const double> lambda, RooSpan<const double> gamma, RooSpan<const double> delta, double massThreshold)  override {
+          if (!worthDevice({mass, mu, lambda, gamma, delta})) return _cpu->computeJohnson(caller, evalData, mass, mu, lambda, gamma, delta, massThreshold);
+          return startComputation(caller, evalData, JohnsonComputer{massThreshold}, mass, mu, lambda, gamma, delta);
+        }
+        RooSpan<double> computeLandau(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigma)  override {
+          return _cpu->computeLandau(caller, evalData, x, mean, sigma);
+        }
+        RooSpan<double> computeLognormal(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> m0, RooSpan<const double> k)  override {
+          if (!worthDevice({x, m0, k})) return _cpu->computeLognormal(caller, evalData, x, m0, k);
+          return startComputation(caller, evalData, LognormalComputer{}, x, m0, k);
+        }
+        RooSpan<double> computeNovosibirsk(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> peak, RooSpan<const double> width, RooSpan<const double> tail)  override {
+          if (!worthDevice({x, peak, width, tail})) return _cpu->computeNovosibirsk(caller, evalData, x, peak, width, tail);
+          return startComputation(caller, evalData, NovosibirskComputer{}, x, peak, width, tail);
+        }
+        RooSpan<double> computePoisson(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, bool protectNegative, bool noRounding)  override {
+          if (!worthDevice({x, mean})) return _cpu->computePoisson(caller, evalData, x, mean, protectNegative, noRounding);
+          return startComputation(caller, evalData, PoissonComputer{protectNegative, noRounding}, x, mean);
+        }
+        void computePolynomial(size_t batchSize, double* __restrict output, const double* __restrict const X, int lowestOrder, std::vector<BracketAdapterWithMask>& coefList)  override {
+          _cpu->computePolynomial(batchSize, output, X, lowestOrder, coefList);
+        }
+        RooSpan<double> computeVoigtian(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> width, RooSpan<const double> sigma)  override {
+          return _cpu->computeVoigtian(caller, evalData, x, mean, width, sigma);
+        }
+    }; // End class RooBatchComputeClass
+
+    /// Static object to trigger the constructor which overwrites the dispatch pointer.
+    static RooBatchComputeClass computeObj;
+
+  } //End namespace RF_ARCH
+} //End namespace RooBatchCompute
@@ -100,4 +100,16 @@ RooSpan<double> RunContext::makeBatch(const RooAbsReal* owner, std::size_t size)
   return {item->second};
 }
 
+
+/// Check if `data` points to memory owned by this RunContext, i.e. to the result
+/// of a computation rather than to data that stay the same through a fit.
+bool RunContext::ownsMemory(const double* data) const {
+  for (const auto& item : ownedMemory) {
+    if (item.second.data() == data)
+      return true;
+  }
+
+  return false;
+}
+
 }
@@ -588,37 +588,29 @@ Double_t ParamHistFunc::evaluate() const
 /// \param[in/out] evalData Input/output data for evaluating the ParamHistFunc.
 /// \param[in] normSet Normalisation set passed on to objects that are serving values to us.
 RooSpan<double> ParamHistFunc::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
-  std::vector<double> oldValues;
   std::vector<RooSpan<const double>> data;
   std::size_t batchSize = 0;
 
   // Retrieve data for all variables
   for (auto arg : _dataVars) {
     const auto* var = static_cast<RooRealVar*>(arg);
-    oldValues.push_back(var->getVal());
     data.push_back(var->getValues(evalData, normSet));
     batchSize = std::max(batchSize, data.back().size());
   }
 
+  // Values of the parameters of all bins, read only once per batch
+  std::vector<double> binValues(_dataSet.numEntries());
+  for (std::size_t bin = 0; bin < binValues.size(); ++bin) {
+    binValues[bin] = getParameter(bin).getVal();
+  }
+
+  std::vector<std::size_t> binIndices;
+  _dataSet.getIndices(data, binIndices);
+
   // Run computation for each entry in the dataset
   RooSpan<double> output = evalData.makeBatch(this, batchSize);
-
   for (std::size_t i = 0; i < batchSize; ++i) {
-    for (unsigned int j = 0; j < _dataVars.size(); ++j) {
-      assert(i < data[j].size());
-      auto& var = static_cast<RooRealVar&>(_dataVars[j]);
-      var.setCachedValue(data[j][i], /*notifyClients=*/false);
-    }
-
-    const auto index = _dataSet.getIndex(_dataVars, /*fast=*/true);
-    const RooRealVar& param = getParameter(index);
-    output[i] = param.getVal();
-  }
-
-  // Restore old values
-  for (unsigned int j = 0; j < _dataVars.size(); ++j) {
-    auto& var = static_cast<RooRealVar&>(_dataVars[j]);
-    var.setCachedValue(oldValues[j], /*notifyClients=*/false);
+    output[i] = binValues[binIndices[i]];
   }
 
   return output;
@@ -330,10 +330,11 @@ RooSpan<double> PiecewiseInterpolation::evaluateSpan(RooBatchCompute::RunContext
     switch(icode) {
     case 0: {
       // piece-wise linear
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        if(param >0)
+      if (param > 0) {
+        for (unsigned int j=0; j < nominal.size(); ++j)
           sum[j] += param * (high[j]    - nominal[j]);
-        else
+      } else {
+        for (unsigned int j=0; j < nominal.size(); ++j)
           sum[j] += param * (nominal[j] - low[j]    );
       }
       break;
@@ -379,26 +380,30 @@ RooSpan<double> PiecewiseInterpolation::evaluateSpan(RooBatchCompute::RunContext
       }
       break;
     }
-    case 4:
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        const double x  = param;
-        if (x > 1.) {
+    case 4: {
+      // The branches only depend on the parameter, so that the loops over the bins can be vectorised
+      const double x  = param;
+      if (x > 1.) {
+        for (unsigned int j=0; j < nominal.size(); ++j)
           sum[j] += x * (high[j]    - nominal[j]);
-        } else if (x < -1.) {
+      } else if (x < -1.) {
+        for (unsigned int j=0; j < nominal.size(); ++j)
           sum[j] += x * (nominal[j] - low[j]);
-        } else {
+      } else {
+        const double poly = 15. + x * x * (-10. + x * x * 3.  );
+        for (unsigned int j=0; j < nominal.size(); ++j) {
           const double eps_plus = high[j] - nominal[j];
           const double eps_minus = nominal[j] - low[j];
           const double S = 0.5 * (eps_plus + eps_minus);
           const double A = 0.0625 * (eps_plus - eps_minus);
 
-          double val = nominal[j] + x * (S + x * A * ( 15. + x * x * (-10. + x * x * 3.  ) ) );
+          const double val = nominal[j] + x * (S + x * A * poly);
 
-          if (val < 0.) val = 0.;
-          sum[j] += val - nominal[j];
+          sum[j] += std::max(val, 0.) - nominal[j];
         }
       }
       break;
+    }
     case 5:
       for (unsigned int j=0; j < nominal.size(); ++j) {
         if (param > 1. || param < -1.) {
@@ -35,6 +35,9 @@ public:
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const override;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const override;
 
+  std::string translate(RooFit::Detail::CodegenContext& ctx) const override;
+  std::string translateIntegral(Int_t code, const char* rangeName, RooFit::Detail::CodegenContext& ctx) const override;
+
   Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const override;
   void generateEvent(Int_t code) override;
 
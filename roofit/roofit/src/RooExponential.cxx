@@ -29,6 +29,7 @@ range and values of the arguments.
 
 #include "RooRealVar.h"
 #include "RooBatchCompute.h"
+#include "CodegenContext.h"
 
 
 #include <cmath>
@@ -92,3 +93,29 @@ RooSpan<double> RooExponential::evaluateSpan(RooBatchCompute::RunContext& evalDa
   return RooBatchCompute::dispatch->computeExponential(this, evalData, x->getValues(evalData, normSet), c->getValues(evalData, normSet));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of evaluate(), for the code generation of RooFuncWrapper.
+
+std::string RooExponential::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  return "TMath::Exp(" + ctx.getResult(c.arg()) + " * " + ctx.getResult(x.arg()) + ")";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of analyticalIntegral(), for the code generation of RooFuncWrapper.
+
+std::string RooExponential::translateIntegral(Int_t code, const char* rangeName, RooFit::Detail::CodegenContext& ctx) const
+{
+  using RooFit::Detail::CodegenContext;
+  assert(code == 1 || code ==2);
+
+  auto& constant  = code == 1 ? c : x;
+  auto& integrand = code == 1 ? x : c;
+
+  const std::string k = ctx.getResult(constant.arg());
+  const std::string max = CodegenContext::literal(integrand.max(rangeName));
+  const std::string min = CodegenContext::literal(integrand.min(rangeName));
+  return "(" + k + " == 0. ? " + max + " - " + min + " : (TMath::Exp(" + k + " * " + max + ") - TMath::Exp("
+      + k + " * " + min + ")) / " + k + ")";
+}
+
@@ -26,6 +26,7 @@ Plain Gaussian p.d.f
 #include "RooMath.h"
 #include "RooHelpers.h"
 #include "RooBatchCompute.h"
+#include "CodegenContext.h"
 
 
 ClassImp(RooGaussian);
@@ -67,6 +68,36 @@ RooSpan<double> RooGaussian::evaluateSpan(RooBatchCompute::RunContext& evalData,
   return RooBatchCompute::dispatch->computeGaussian(this, evalData, x->getValues(evalData, normSet), mean->getValues(evalData, normSet), sigma->getValues(evalData, normSet));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of evaluate(), for the code generation of RooFuncWrapper.
+
+std::string RooGaussian::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  const std::string arg = "(" + ctx.getResult(x.arg()) + " - " + ctx.getResult(mean.arg()) + ")";
+  const std::string sig = ctx.getResult(sigma.arg());
+  return "TMath::Exp(-0.5*" + arg + "*" + arg + "/(" + sig + "*" + sig + "))";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of analyticalIntegral(), for the code generation of RooFuncWrapper.
+/// To make the expression differentiable, it uses the difference of two error functions
+/// instead of the upper-tail formulation of analyticalIntegral().
+
+std::string RooGaussian::translateIntegral(Int_t code, const char* rangeName, RooFit::Detail::CodegenContext& ctx) const
+{
+  using RooFit::Detail::CodegenContext;
+  assert(code==1 || code==2);
+
+  const std::string sig = ctx.getResult(sigma.arg());
+  const std::string center = ctx.getResult(code == 1 ? mean.arg() : x.arg());
+  const auto& integrand = code == 1 ? x : mean;
+  const std::string xscale = "(" + CodegenContext::literal(TMath::Sqrt2()) + " * " + sig + ")";
+
+  return CodegenContext::literal(0.5 * std::sqrt(TMath::TwoPi())) + " * " + sig
+      + " * (TMath::Erf((" + CodegenContext::literal(integrand.max(rangeName)) + " - " + center + ") / " + xscale
+      + ") - TMath::Erf((" + CodegenContext::literal(integrand.min(rangeName)) + " - " + center + ") / " + xscale + "))";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooGaussian::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOFIT_ROOFITCORE_INC_CODEGENCONTEXT_H_
+#define ROOFIT_ROOFITCORE_INC_CODEGENCONTEXT_H_
+
+#include "RooArgList.h"
+#include "RooArgSet.h"
+
+#include <map>
+#include <string>
+
+class RooAbsArg;
+class RooAbsPdf;
+
+namespace RooFit {
+namespace Detail {
+
+/// Collects the C++ code that computes a RooFit function, while the nodes of the
+/// computation graph translate themselves with RooAbsReal::translate().
+///
+/// The code is split in two parts. The values that depend only on the parameters
+/// are computed once, before the loops over the events. The values that depend on
+/// the observables are computed in the body of the current loop over the events,
+/// where `i` is the index of the event. The nodes that depend neither on the
+/// parameters nor on the observables are folded into literals.
+///
+/// The parameters are read from the array `params`, the observables from the
+/// array `obs`, in which every observable occupies one column of consecutive
+/// events.
+class CodegenContext {
+public:
+  CodegenContext(const RooArgList& params, const RooArgSet& observables);
+
+  std::string getResult(const RooAbsArg& arg);
+  std::string getNormalizedResult(const RooAbsPdf& pdf, const RooArgSet& normSet);
+  std::string getExpectedEvents(const RooAbsPdf& pdf, const RooArgSet& normSet);
+
+  /// Set the positions of the columns of the observables in `obs` for the next loop.
+  void setColumns(std::map<std::string, std::size_t> columns) { _columns = std::move(columns); }
+  std::string takeLoopCode();
+  /// Return the code that computes the values depending only on the parameters.
+  const std::string& globalCode() const { return _globalCode; }
+
+  static std::string literal(double value);
+
+private:
+  std::string addResult(const std::string& key, const std::string& expr, bool eventDependent);
+  bool isConstant(const RooAbsArg& arg) const;
+
+  RooArgList _params;
+  RooArgSet _observables;
+  std::map<std::string, std::size_t> _columns;
+  std::map<std::string, std::pair<std::string, bool>> _results; // variable name and event dependence of the results
+  std::string _globalCode;
+  std::string _loopCode;
+  std::size_t _nTmp = 0;
+};
+
+}
+}
+
+#endif
@@ -357,3 +357,4 @@
 #endif 
 #pragma link C++ class RooBinSamplingPdf+;
 #pragma link C++ class RooBinWidthFunction+;
+#pragma link C++ class RooFuncWrapper+;
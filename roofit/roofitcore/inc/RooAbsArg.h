@@ -30,6 +30,7 @@
 #include <stack>
 #include <string>
 #include <iostream>
+#include <vector>
 
 #ifndef R__LESS_INCLUDES
 #include "TClass.h"
@@ -494,6 +495,7 @@ public:
   }
   /// Notify that a shape-like property (*e.g.* binning) has changed.
   void setShapeDirty() { setShapeDirty(nullptr); }
+  static void propagateValueDirty(const std::vector<RooAbsArg*>& args);
 
   const char* aggregateCacheUniqueSuffix() const ;
   virtual const char* cacheUniqueSuffix() const { return 0 ; }
@@ -89,6 +89,8 @@ public:
   PdfCacheElem* getCache(const RooArgSet* nset, Bool_t recalculate=kTRUE) const ;
   void clearCacheObject(PdfCacheElem& cache) const ;
 
+  RooSpan<double> evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const ;
+
   virtual const char* payloadUniqueSuffix() const { return 0 ; }
   
   friend class PdfCacheElem ;
@@ -37,6 +37,7 @@ public:
     // Return value of integrand at given observable values
     return (*_function)(x); 
   }
+  void integrand(RooSpan<const double> points, Double_t x[], RooSpan<double> results) const;
   inline const RooAbsFunc *integrand() const { 
     // Return integrand function binding
     return _function; 
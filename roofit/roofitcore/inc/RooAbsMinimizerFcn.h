@@ -89,7 +89,7 @@ public:
    bool getOptConst();
    std::vector<double> getParameterValues() const;
 
-   Bool_t SetPdfParamVal(int index, double value) const;
+   Bool_t SetPdfParamVal(int index, double value, bool notifyClients = true) const;
 
    /// Enable or disable offsetting on the function to be minimized, which enhances numerical precision.
    virtual void setOffsetting(Bool_t flag) = 0;
@@ -252,6 +252,12 @@ public:
     return expectedEvents(&nset) ; 
   }
 
+  // Code generation support, see RooFuncWrapper
+  virtual std::string translateNormalized(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const ;
+  /// Return a C++ expression of expectedEvents(). An empty string, returned by this default
+  /// implementation, signals that the class does not support code generation.
+  virtual std::string translateExpectedEvents(RooFit::Detail::CodegenContext& /*ctx*/, const RooArgSet& /*normSet*/) const { return ""; }
+
   // Printing interface (human readable)
   virtual void printValue(std::ostream& os) const ;
   virtual void printMultiline(std::ostream& os, Int_t contents, Bool_t verbose=kFALSE, TString indent="") const ;
@@ -46,6 +46,11 @@ namespace RooBatchCompute{
 class BatchInterfaceAccessor;
 struct RunContext;
 }
+namespace RooFit {
+namespace Detail {
+class CodegenContext;
+}
+}
 struct TreeReadBuffer; /// A space to attach TBranches
 
 class TH1;
@@ -176,6 +181,16 @@ public:
   }
   Bool_t getForceNumInt() const { return _forceNumInt ; }
 
+  // Code generation support, see RooFuncWrapper
+  /// Return a C++ expression of the value of this function, made of the results of its servers
+  /// that are obtained with RooFit::Detail::CodegenContext::getResult(). An empty string, returned
+  /// by this default implementation, signals that the class does not support code generation.
+  virtual std::string translate(RooFit::Detail::CodegenContext& /*ctx*/) const { return ""; }
+  /// Return a C++ expression of the analytical integral with the given code, see analyticalIntegral().
+  /// An empty string, returned by this default implementation, signals that the integral does not
+  /// support code generation.
+  virtual std::string translateIntegral(Int_t /*code*/, const char* /*rangeName*/, RooFit::Detail::CodegenContext& /*ctx*/) const { return ""; }
+
   // Chi^2 fits to histograms
   virtual RooFitResult* chi2FitTo(RooDataHist& data, const RooCmdArg& arg1=RooCmdArg::none(),  const RooCmdArg& arg2=RooCmdArg::none(),  
                               const RooCmdArg& arg3=RooCmdArg::none(),  const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),  
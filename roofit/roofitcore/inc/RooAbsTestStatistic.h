@@ -23,6 +23,7 @@
 #include "Math/Util.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 class RooArgSet ;
@@ -45,6 +46,7 @@ public:
     std::string rangeName = "";
     std::string addCoefRangeName = "";
     int nCPU = 1;
+    int nThreads = 1;
     RooFit::MPSplit interleave = RooFit::BulkPartition;
     bool verbose = true;
     bool splitCutRange = false;
@@ -109,9 +111,9 @@ protected:
   
   RooSetProxy _paramSet ;          // Parameters of the test statistic (=parameters of the input function)
 
-  enum GOFOpMode { SimMaster,MPMaster,Slave } ;
+  enum GOFOpMode { SimMaster,MPMaster,Slave,ThreadMaster } ;
   GOFOpMode operMode() const { 
-    // Return test statistic operation mode of this instance (SimMaster, MPMaster or Slave)
+    // Return test statistic operation mode of this instance (SimMaster, MPMaster, Slave or ThreadMaster)
     return _gofOpMode ; 
   }
 
@@ -135,6 +137,8 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, std::string const& rangeName, std::string const& addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, std::string const& rangeName, std::string const& addCoefRangeName) ;
+  void initThreadMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, std::string const& rangeName, std::string const& addCoefRangeName) ;
+  Double_t evaluateThreads() const ;
 
   mutable Bool_t _init = false;   //! Is object initialized  
   GOFOpMode _gofOpMode = Slave;   // Operation mode of test statistic instance 
@@ -153,6 +157,12 @@ protected:
   Int_t          _nCPU = 1;   //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray = nullptr; //! Array of parallel execution frond ends
 
+  // Multi-threaded mode data
+  Int_t          _nThreads = 1; //! Number of threads to use in multi-threaded calculation mode
+  pRooAbsTestStatistic* _threadGofArray = nullptr; //! Array of test statistics, one per thread, that calculate chunks of events
+  mutable std::vector<std::pair<Double_t,Double_t>> _chunkOffsets; //! Offsets (value and carry) of the chunks in multi-threaded mode
+  mutable Bool_t _threadsReady = false; //! Were all the per-thread test statistics evaluated once since their last setup?
+
   RooFit::MPSplit _mpinterl = RooFit::BulkPartition; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset = false; // Apply interval value offset to control numeric precision?
   mutable ROOT::Math::KahanSum<double> _offset = 0.0; //! Offset as KahanSum to avoid loss of precision
@@ -20,6 +20,8 @@
 #include "RooPrintable.h"
 #include "RooArgSet.h"
 
+#include <vector>
+
 class RooAbsReal;
 class RooRealVar;
 class RooDataSet;
@@ -28,7 +30,7 @@ class RooNumGenFactory ;
 
 class RooAcceptReject : public RooAbsNumGenerator {
 public:
-  RooAcceptReject() : _nextCatVar(0), _nextRealVar(0) {
+  RooAcceptReject() : _nextCatVar(0), _nextRealVar(0), _uniformBlock(0), _nextUniform(0) {
     // coverity[UNINIT_CTOR]
   } ; 
   RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVars, const RooNumGenConfig& config, Bool_t verbose=kFALSE, const RooAbsReal* maxFuncVal=0);
@@ -54,6 +56,7 @@ protected:
 
   void addEventToCache();
   const RooArgSet *nextAcceptedEvent();
+  Double_t nextUniform();
 
   Double_t _maxFuncVal, _funcSum;      // Maximum function value found, and sum of all samples made
   UInt_t _realSampleDim,_catSampleMult;// Number of real and discrete dimensions to be samplesd
@@ -65,6 +68,10 @@ protected:
 
   UInt_t _minTrialsArray[4];           // Minimum number of trials samples for 1,2,3 dimensional problems
 
+  UInt_t _uniformBlock;                // Number of uniform numbers of the accept test generated at once
+  std::vector<Double_t> _uniforms;     //! Block of uniform numbers for the accept test
+  UInt_t _nextUniform;                 // Index of the next number in _uniforms
+
   ClassDef(RooAcceptReject,0) // Context for generating a dataset from a PDF
 };
 
@@ -64,6 +64,9 @@ public:
   /// is the sum of all coefficients.
   Double_t expectedEvents(const RooArgSet* nset) const override;
 
+  std::string translateNormalized(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const override;
+  std::string translateExpectedEvents(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const override;
+
   const RooArgList& pdfList() const { 
     // Return list of component p.d.fs
     return _pdfList ; 
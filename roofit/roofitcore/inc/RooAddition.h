@@ -72,6 +72,7 @@ protected:
   mutable RooObjCacheManager _cacheMgr ; // The cache manager
 
   Double_t evaluate() const;
+  std::string translate(RooFit::Detail::CodegenContext& ctx) const;
 
   ClassDef(RooAddition,2) // Sum of RooAbsReal objects
 };
@@ -155,6 +155,7 @@ public:
   Int_t getIndex(const RooArgSet& coord, Bool_t fast = false) const {
     return getIndex(static_cast<const RooAbsCollection&>(coord), fast);
   }
+  void getIndices(const std::vector<RooSpan<const double>>& coords, std::vector<std::size_t>& indices) const;
 
   void removeSelfFromDir() { removeFromDir(this) ; }
 
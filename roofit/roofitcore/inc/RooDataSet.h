@@ -23,10 +23,13 @@ class RooDataHist;
 
 #include "RooAbsData.h"
 #include "RooDirItem.h"
+#include "RooSpan.h"
 
 #include "ROOT/RStringView.hxx"
 
 #include <list>
+#include <map>
+#include <string>
 
 
 #define USEMEMPOOLFORDATASET
@@ -123,6 +126,7 @@ public:
   virtual void addFast(const RooArgSet& row, Double_t weight=1.0, Double_t weightError=0);
 
   void append(RooDataSet& data) ;
+  Int_t appendColumns(const std::map<std::string, RooSpan<const double>>& columns);
   Bool_t merge(RooDataSet* data1, RooDataSet* data2=0, RooDataSet* data3=0,  
  	       RooDataSet* data4=0, RooDataSet* data5=0, RooDataSet* data6=0) ; 
   Bool_t merge(std::list<RooDataSet*> dsetList) ;
@@ -29,6 +29,11 @@
 namespace RooBatchCompute {
   struct RunContext;
 }
+namespace RooFit {
+  namespace Detail {
+    class CodegenContext;
+  }
+}
 class RooAbsReal;
 
 class RooFormula : public TNamed, public RooPrintable {
@@ -60,6 +65,7 @@ public:
   /// Evalute all parameters/observables, and then evaluate formula.
   Double_t eval(const RooArgSet* nset=0) const;
   RooSpan<double> evaluateSpan(const RooAbsReal* dataOwner, RooBatchCompute::RunContext& inputData, const RooArgSet* nset = nullptr) const;
+  std::string translate(RooFit::Detail::CodegenContext& ctx) const;
 
   /// DEBUG: Dump state information
   void dump() const;
@@ -71,6 +71,7 @@ public:
   // Function evaluation
   virtual Double_t evaluate() const ;
   RooSpan<double> evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const;
+  std::string translate(RooFit::Detail::CodegenContext& ctx) const;
 
   protected:
   // Post-processing of server redirection
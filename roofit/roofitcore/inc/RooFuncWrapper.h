@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOFIT_ROOFITCORE_INC_ROOFUNCWRAPPER_H_
+#define ROOFIT_ROOFITCORE_INC_ROOFUNCWRAPPER_H_
+
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+
+#include <string>
+#include <vector>
+
+class RooAbsData;
+class RooAbsPdf;
+
+class RooFuncWrapper final : public RooAbsReal {
+public:
+  RooFuncWrapper() = default;
+  RooFuncWrapper(const char* name, const char* title, RooAbsPdf& pdf, RooAbsData& data, bool extended = false);
+  RooFuncWrapper(const RooFuncWrapper& other, const char* name = nullptr);
+
+  TObject* clone(const char* newname) const override { return new RooFuncWrapper(*this, newname); }
+
+  Double_t defaultErrorLevel() const override { return 0.5; }
+
+  /// Return the generated code of the likelihood.
+  const std::string& code() const { return _code; }
+  /// Return the parameters, in the order of the array that the generated function reads.
+  const RooArgList& parameters() const { return _params; }
+  /// Check if the gradient of the likelihood was generated with automatic differentiation.
+  bool hasGradient() const { return _grad != nullptr; }
+  void gradient(double* out) const;
+
+protected:
+  Double_t evaluate() const override;
+
+private:
+  using Func = double (*)(double*, double const*, double const*);
+  using Grad = void (*)(double*, double const*, double const*, double*);
+
+  void buildCode(RooAbsPdf& pdf, RooAbsData& data, bool extended);
+  void declareFunction();
+  void updateParameters() const;
+
+  RooListProxy _params;
+  std::string _funcName;
+  std::string _code;
+  Func _func = nullptr; //!
+  Grad _grad = nullptr; //!
+  std::vector<double> _observables; // Columns of the observables, one block per category
+  std::vector<double> _weights;     // Weights of the events, one block per category
+  mutable std::vector<double> _paramValues; //!
+
+  ClassDefOverride(RooFuncWrapper, 0) // Likelihood compiled from the code generated by its computation graph
+};
+
+#endif
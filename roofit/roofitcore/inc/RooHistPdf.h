@@ -105,6 +105,7 @@ protected:
   Bool_t importWorkspaceHook(RooWorkspace& ws) ;
   
   Double_t evaluate() const;
+  RooSpan<double> evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* /*normSet*/) const;
   Double_t totalVolume() const ;
   friend class RooAbsCachedPdf ;
   Double_t totVolume() const ;
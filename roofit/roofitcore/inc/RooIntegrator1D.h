@@ -19,6 +19,8 @@
 #include "RooAbsIntegrator.h"
 #include "RooNumIntConfig.h"
 
+#include <vector>
+
 class RooIntegrator1D : public RooAbsIntegrator {
 public:
 
@@ -73,6 +75,7 @@ protected:
   Double_t addTrapezoids(Int_t n) ;
   Double_t addMidpoints(Int_t n) ;
   void extrapolate(Int_t n) ;
+  Double_t sumIntegrand() ;
   
   // Numerical integrator workspace
   Double_t _xmin;              //! Lower integration bound
@@ -85,6 +88,8 @@ protected:
   Double_t *_c ;                       //! Integrator workspace
   Double_t *_d ;                       //! Integrator workspace
   Double_t _savedResult;               //! Integrator workspace
+  std::vector<Double_t> _points;       //! Points of the current refinement step
+  std::vector<Double_t> _values;       //! Values of the integrand at these points
 
   Double_t* xvec(Double_t& xx) { _x[0] = xx ; return _x ; }
 
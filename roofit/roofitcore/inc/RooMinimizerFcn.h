@@ -54,6 +54,7 @@ private:
    double DoEval(const double *x) const override;
 
    RooAbsReal *_funct;
+   mutable std::vector<RooAbsArg*> _changedParams; // Parameters changed in the current call of DoEval
 };
 
 #endif
@@ -70,6 +70,9 @@ public:
   virtual ExtendMode extendMode() const ;
   virtual Double_t expectedEvents(const RooArgSet* nset) const ; 
 
+  std::string translateNormalized(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const override;
+  std::string translateExpectedEvents(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const override;
+
   const RooArgList& pdfList() const { return _pdfList ; }
 
   virtual Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const;
@@ -78,6 +78,7 @@ protected:
   Double_t calculate(const RooArgList& partIntList) const;
   Double_t evaluate() const;
   RooSpan<double> evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const;
+  std::string translate(RooFit::Detail::CodegenContext& ctx) const;
 
   const char* makeFPName(const char *pfx,const RooArgSet& terms) const ;
   ProdMap* groupProductTerms(const RooArgSet&) const;
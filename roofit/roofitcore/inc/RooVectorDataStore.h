@@ -25,6 +25,8 @@
 #include "ROOT/RStringView.hxx"
 
 #include <list>
+#include <map>
+#include <string>
 #include <vector>
 #include <algorithm>
 
@@ -71,6 +73,9 @@ public:
   // Write current row
   virtual Int_t fill() override;
 
+  // Append blocks of columns
+  Int_t appendColumns(const std::map<std::string, RooSpan<const double>>& columns);
+
   // Retrieve a row
   using RooAbsDataStore::get;
   virtual const RooArgSet* get(Int_t index) const override;
@@ -246,6 +251,16 @@ public:
       _vec.push_back(*_buf);
     }
 
+    /// Append a block of values.
+    void append(RooSpan<const double> values) {
+      _vec.insert(_vec.end(), values.begin(), values.end());
+    }
+
+    /// Append `n` copies of the value in the buffer, like calling fill() `n` times.
+    void fill(std::size_t n) {
+      _vec.insert(_vec.end(), n, *_buf);
+    }
+
     void write(Int_t i) {
       assert(static_cast<std::size_t>(i) < _vec.size());
       _vec[i] = *_buf ;
@@ -427,6 +442,23 @@ public:
       if (_vecEL) (*_vecEL)[i] = *_bufEL ;
       if (_vecEH) (*_vecEH)[i] = *_bufEH ;
     }
+
+    /// Append a block of values. The errors are the ones in the buffers, as in fill().
+    void append(RooSpan<const double> values) {
+      RealVector::append(values) ;
+      const std::size_t n = values.size() ;
+      if (_vecE) _vecE->insert(_vecE->end(), n, *_bufE) ;
+      if (_vecEL) _vecEL->insert(_vecEL->end(), n, *_bufEL) ;
+      if (_vecEH) _vecEH->insert(_vecEH->end(), n, *_bufEH) ;
+    }
+
+    /// Append `n` copies of the value and errors in the buffers, like calling fill() `n` times.
+    void fill(std::size_t n) {
+      RealVector::fill(n) ;
+      if (_vecE) _vecE->insert(_vecE->end(), n, *_bufE) ;
+      if (_vecEL) _vecEL->insert(_vecEL->end(), n, *_bufEL) ;
+      if (_vecEH) _vecEH->insert(_vecEH->end(), n, *_bufEH) ;
+    }
     
     void reset() { 
       RealVector::reset();
@@ -547,6 +579,11 @@ public:
       _vec.push_back(*_buf) ; 
     }
 
+    /// Append `n` copies of the state in the buffer, like calling fill() `n` times.
+    void fill(std::size_t n) {
+      _vec.insert(_vec.end(), n, *_buf) ;
+    }
+
     void write(std::size_t i) {
       _vec[i] = *_buf;
     }
@@ -0,0 +1,218 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\class RooFit::Detail::CodegenContext
+\ingroup Roofitcore
+
+Helper of RooFuncWrapper, which collects the code generated by the nodes of a
+computation graph. A node that supports the code generation overrides
+RooAbsReal::translate(), and returns an expression of the results of its
+servers:
+~~~{.cpp}
+std::string RooAddition::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  std::string result;
+  for (const auto arg : _set) {
+    result += (result.empty() ? "" : " + ") + ctx.getResult(*arg);
+  }
+  return result;
+}
+~~~
+Each result is stored in a temporary variable and computed only once, in
+dependency order.
+**/
+
+#include "CodegenContext.h"
+
+#include "RooAbsPdf.h"
+#include "RooAbsRealLValue.h"
+
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+using namespace RooFit::Detail;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a context.
+/// \param[in] params The parameters, which are read from the array `params` in the order of this list.
+/// \param[in] observables The observables, read from the array `obs`. See setColumns().
+
+CodegenContext::CodegenContext(const RooArgList& params, const RooArgSet& observables) :
+  _params(params), _observables(observables)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a floating-point literal with all the digits of `value`.
+
+std::string CodegenContext::literal(double value)
+{
+  std::stringstream ss;
+  ss << std::setprecision(17) << value;
+  std::string str = ss.str();
+  if (str.find_first_of(".en") == std::string::npos) {
+    str += ".";
+  }
+  return value < 0 ? "(" + str + ")" : str;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the value of `arg` depends neither on the parameters nor on the observables.
+
+bool CodegenContext::isConstant(const RooAbsArg& arg) const
+{
+  return !arg.dependsOnValue(_params) && !arg.dependsOnValue(_observables);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare a temporary variable that holds the value of `expr`, and return its name.
+
+std::string CodegenContext::addResult(const std::string& key, const std::string& expr, bool eventDependent)
+{
+  std::string name = "t" + std::to_string(_nTmp++);
+  if (eventDependent) {
+    _loopCode += "      const double " + name + " = " + expr + ";\n";
+  } else {
+    _globalCode += "   const double " + name + " = " + expr + ";\n";
+  }
+  _results[key] = {name, eventDependent};
+  return name;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an expression for the value of `arg`, generating the code that computes it
+/// if this did not happen yet. For a pdf, this is the unnormalised value.
+/// \throws std::runtime_error if `arg` or one of its servers does not support the code generation.
+
+std::string CodegenContext::getResult(const RooAbsArg& arg)
+{
+  const std::string key = arg.GetName();
+  auto found = _results.find(key);
+  if (found != _results.end()) {
+    return found->second.first;
+  }
+
+  const Int_t param = _params.index(&arg);
+  if (param >= 0) {
+    return "params[" + std::to_string(param) + "]";
+  }
+  if (_observables.find(arg)) {
+    auto column = _columns.find(key);
+    if (column == _columns.end()) {
+      throw std::runtime_error("CodegenContext: no data for the observable " + key);
+    }
+    return "obs[" + std::to_string(column->second) + " + i]";
+  }
+
+  auto real = dynamic_cast<const RooAbsReal*>(&arg);
+  if (!real) {
+    throw std::runtime_error(std::string("CodegenContext: the category ") + arg.GetName()
+        + " cannot be translated to code.");
+  }
+  if (isConstant(arg)) {
+    return literal(real->getVal());
+  }
+
+  const std::string expr = real->translate(*this);
+  if (expr.empty()) {
+    throw std::runtime_error(std::string("CodegenContext: ") + arg.GetName() + " of the class "
+        + arg.ClassName() + " does not support code generation.");
+  }
+  return addResult(key, expr, arg.dependsOnValue(_observables));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an expression for the value of `pdf` normalised over the observables in `normSet`,
+/// see RooAbsPdf::translateNormalized().
+/// \throws std::runtime_error if the value cannot be translated to code.
+
+std::string CodegenContext::getNormalizedResult(const RooAbsPdf& pdf, const RooArgSet& normSet)
+{
+  std::unique_ptr<RooArgSet> pdfObs(pdf.getObservables(normSet));
+  if (pdfObs->empty()) {
+    return getResult(pdf);
+  }
+
+  std::string key = std::string(pdf.GetName()) + "|";
+  for (const auto arg : *pdfObs) {
+    key += std::string(arg->GetName()) + ",";
+  }
+  auto found = _results.find(key);
+  if (found != _results.end()) {
+    return found->second.first;
+  }
+
+  if (isConstant(pdf)) {
+    return literal(pdf.getVal(*pdfObs));
+  }
+
+  const std::string expr = pdf.translateNormalized(*this, *pdfObs);
+  if (expr.empty()) {
+    throw std::runtime_error(std::string("CodegenContext: the normalisation of ") + pdf.GetName()
+        + " of the class " + pdf.ClassName() + " over " + key.substr(key.find('|') + 1)
+        + " does not support code generation.");
+  }
+  return addResult(key, expr, pdf.dependsOnValue(_observables));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an expression for the number of events expected by `pdf`, see RooAbsPdf::translateExpectedEvents().
+/// \throws std::runtime_error if the value cannot be translated to code.
+
+std::string CodegenContext::getExpectedEvents(const RooAbsPdf& pdf, const RooArgSet& normSet)
+{
+  const std::string key = std::string(pdf.GetName()) + "|expectedEvents";
+  auto found = _results.find(key);
+  if (found != _results.end()) {
+    return found->second.first;
+  }
+
+  if (!pdf.dependsOnValue(_params)) {
+    return literal(pdf.expectedEvents(normSet));
+  }
+
+  const std::string expr = pdf.translateExpectedEvents(*this, normSet);
+  if (expr.empty()) {
+    throw std::runtime_error(std::string("CodegenContext: the expected events of ") + pdf.GetName()
+        + " of the class " + pdf.ClassName() + " do not support code generation.");
+  }
+  return addResult(key, expr, false);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the code of the body of the current loop over the events, and start
+/// the next loop. The values that depend on the observables will be computed
+/// again in the next loop.
+
+std::string CodegenContext::takeLoopCode()
+{
+  for (auto it = _results.begin(); it != _results.end();) {
+    it = it->second.second ? _results.erase(it) : std::next(it);
+  }
+  std::string code;
+  std::swap(code, _loopCode);
+  return code;
+}
@@ -101,6 +101,8 @@ for single nodes.
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <unordered_set>
+#include <vector>
 
 using namespace std;
 
@@ -930,6 +932,36 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Mark all `args` as having changed their values, and propagate this to their
+/// clients. Unlike calling setValueDirty() on each of them, every node of the
+/// computation graph is visited only once, even if it is reached on several paths
+/// or depends on several of the changed objects.
+/// This is useful after changing the values of many parameters without notifying
+/// their clients, e.g. with RooAbsReal::setCachedValue().
+
+void RooAbsArg::propagateValueDirty(const std::vector<RooAbsArg*>& args)
+{
+  if (args.empty()) return ;
+
+  std::unordered_set<const RooAbsArg*> visited ;
+  std::vector<RooAbsArg*> stack(args.begin(), args.end()) ;
+  while (!stack.empty()) {
+    RooAbsArg* arg = stack.back() ;
+    stack.pop_back() ;
+    if (!visited.insert(arg).second) continue ;
+
+    arg->_allBatchesDirty = true ;
+    if (arg->_operMode!=Auto || _inhibitDirty) continue ;
+
+    arg->_valueDirty = kTRUE ;
+    for (auto client : arg->_clientListValue) {
+      stack.push_back(client) ;
+    }
+  }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Mark this object as having changed its shape, and propagate this status
 /// change to all of our clients.
@@ -42,6 +42,9 @@ using namespace std ;
 #include "RooRealVar.h"
 #include "RooChangeTracker.h"
 #include "RooExpensiveObjectCache.h"
+#include "RunContext.h"
+
+#include <algorithm>
 
 ClassImp(RooAbsCachedPdf);
 
@@ -105,6 +108,28 @@ Double_t RooAbsCachedPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the p.d.f. for a batch of events by looking them up in
+/// the cache histogram, as getValV() does for a single event. The cache is
+/// (re)filled once for the whole batch if the parameters changed.
+
+RooSpan<double> RooAbsCachedPdf::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const
+{
+  if (_disableCache) {
+    return RooAbsPdf::evaluateSpan(evalData, normSet) ;
+  }
+
+  PdfCacheElem* cache = getCache(normSet) ;
+
+  auto cacheValues = cache->pdf()->getValues(evalData, normSet) ;
+  auto output = evalData.makeBatch(this, cacheValues.size()) ;
+  std::copy(cacheValues.begin(), cacheValues.end(), output.begin()) ;
+
+  return output ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to RooHistPdf cache pdf for given choice of observables
 
@@ -30,8 +30,12 @@ functions that implement the RooAbsFunc interface.
 
 #include "RooAbsIntegrator.h"
 #include "RooMsgService.h"
+#include "RooRealBinding.h"
 #include "TClass.h"
 
+#include <cassert>
+#include <vector>
+
 using namespace std;
 
 ClassImp(RooAbsIntegrator);
@@ -57,6 +61,41 @@ RooAbsIntegrator::RooAbsIntegrator(const RooAbsFunc& function, Bool_t doPrintEva
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the integrand at several points, which differ only in the first coordinate.
+/// If the integrand is a RooRealBinding, all points are computed in one call of the
+/// batch interface, RooRealBinding::getValues(). Otherwise, the points are computed one by one.
+/// \param[in] points Values of the first coordinate.
+/// \param[in,out] x Values of the other coordinates in `x[1]`, ..., `x[dim-1]`. `x[0]` may be overwritten.
+/// \param[out] results Values of the integrand, one for each point.
+
+void RooAbsIntegrator::integrand(RooSpan<const double> points, Double_t x[], RooSpan<double> results) const
+{
+  assert(points.size() == results.size());
+
+  if (auto realBinding = dynamic_cast<const RooRealBinding*>(_function)) {
+    std::vector<RooSpan<const double>> coordinates{points};
+    for (UInt_t i = 1; i < _function->getDimension(); ++i) {
+      coordinates.emplace_back(x + i, 1);
+    }
+
+    // The batch is empty if a parameter is invalid, in which case the integrand is zero,
+    // and it has one element if the integrand doesn't depend on the first coordinate.
+    const RooSpan<const double> values = realBinding->getValues(coordinates);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      results[i] = values.empty() ? 0. : values[values.size() == 1 ? 0 : i];
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    x[0] = points[i];
+    results[i] = integrand(x);
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate integral value with given array of parameter values
 
@@ -399,15 +399,23 @@ void RooAbsMinimizerFcn::ApplyCovarianceMatrix(TMatrixDSym &V)
    }
 }
 
-/// Set value of parameter i.
-Bool_t RooAbsMinimizerFcn::SetPdfParamVal(int index, double value) const
+/// Set value of parameter i. Return true if the value changed.
+/// If `notifyClients` is false, the clients of the parameter are not set dirty.
+/// The caller has to do this, e.g. with RooAbsArg::propagateValueDirty().
+Bool_t RooAbsMinimizerFcn::SetPdfParamVal(int index, double value, bool notifyClients) const
 {
   auto par = static_cast<RooRealVar*>(&(*_floatParamList)[index]);
 
   if (par->getVal()!=value) {
     if (_verbose) cout << par->GetName() << "=" << value << ", " ;
     
-    par->setVal(value);
+    if (notifyClients) {
+      par->setVal(value);
+    } else {
+      Double_t clipValue;
+      par->inRange(value, nullptr, &clipValue);
+      par->setCachedValue(clipValue, false);
+    }
     return kTRUE;
   }
 
@@ -173,6 +173,7 @@ called for each data event.
 #include "RooHelpers.h"
 #include "RooBatchCompute.h"
 #include "RooFormulaVar.h"
+#include "CodegenContext.h"
 
 #include "TClass.h"
 #include "TMath.h"
@@ -876,6 +877,8 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///   <tr><td> 3 = RooFit::Hybrid <td> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                     30 dataset entries, for which strategy 2 is followed.
 ///   </table>
+/// <tr><td> `NumThreads(int num)`             <td> Calculate the NLL with num threads of the ROOT thread pool (requires ROOT::EnableImplicitMT()).
+///                                               The events are split in chunks that are distributed over the threads. Ignored if NumCPU() is also given.
 /// <tr><td> `BatchMode(bool on)`              <td> Batch evaluation mode. See fitTo().
 /// <tr><td> `Optimize(Bool_t flag)`           <td> Activate constant term optimization (on by default)
 /// <tr><td> `SplitRange(Bool_t flag)`         <td> Use separate fit ranges in a simultaneous fit. Actual range name for each subsample is assumed to
@@ -989,6 +992,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
   pc.defineInt("interleave","NumCPU",1,0) ;
+  pc.defineInt("numthreads","NumThreads",0,1) ;
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData", 0, 2);
@@ -1073,6 +1077,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   RooAbsTestStatistic::Configuration cfg;
   cfg.addCoefRangeName = addCoefRangeName ? addCoefRangeName : "";
   cfg.nCPU = numcpu;
+  cfg.nThreads = pc.getInt("numthreads");
   cfg.interleave = interl;
   cfg.verbose = verbose;
   cfg.splitCutRange = static_cast<bool>(splitr);
@@ -1309,6 +1314,7 @@ int RooAbsPdf::calculateSumW2CorrectedCovMatrix(RooMinimizer &minimizer, RooAbsR
 ///   <tr><td> 3 = RooFit::Hybrid <td> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                     30 dataset entries, for which strategy 2 is followed.
 ///   </table>
+/// <tr><td> `NumThreads(int num)`              <td> Calculate the NLL with `num` threads, see createNLL().
 /// <tr><td> `SplitRange(Bool_t flag)`          <td>  Use separate fit ranges in a simultaneous fit. Actual range name for each subsample is assumed
 ///                                                 to by `rangeName_indexState` where indexState is the state of the master index category of the simultaneous fit.
 /// Using `Range("range"), SplitRange()` as switches, different ranges could be set like this:
@@ -1436,7 +1442,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
 
   RooLinkedList fitCmdList(cmdList) ;
   RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,"
-      "RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,"
+      "RangeWithName,SumCoefRange,NumCPU,NumThreads,SplitRange,Constrained,Constrain,ExternalConstraints,"
       "CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode,IntegrateBins");
 
   pc.defineDouble("prefit", "Prefit",0,0);
@@ -3223,6 +3229,37 @@ Double_t RooAbsPdf::expectedEvents(const RooArgSet*) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a C++ expression of the value of this p.d.f normalised over the observables
+/// in `normSet`, for the code generation of RooFuncWrapper. This default implementation
+/// divides the result of translate() by the analytical integral over all of `normSet`,
+/// if translateIntegral() supports it. An empty string signals that the normalisation
+/// does not support code generation.
+
+std::string RooAbsPdf::translateNormalized(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const
+{
+  if (selfNormalized()) {
+    return ctx.getResult(*this);
+  }
+  if (getForceNumInt()) {
+    return "";
+  }
+
+  RooArgSet allVars(normSet);
+  RooArgSet analVars;
+  const Int_t code = getAnalyticalIntegral(allVars, analVars, nullptr);
+  if (code == 0 || analVars.size() != normSet.size()) {
+    return "";
+  }
+  const std::string integral = translateIntegral(code, nullptr, ctx);
+  if (integral.empty()) {
+    return "";
+  }
+  return ctx.getResult(*this) + " / (" + integral + ")";
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change global level of verbosity for p.d.f. evaluations
 
@@ -109,9 +109,21 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 
 using namespace std ;
 
+namespace {
+
+/// Serialises the logging of evaluation errors
+std::recursive_mutex &evalErrorMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+}
+
 ClassImp(RooAbsReal)
 
 Bool_t RooAbsReal::_globalSelectComp = false;
@@ -3664,6 +3676,9 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  // Errors may be logged concurrently by the threads of a multi-threaded likelihood
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3719,6 +3734,9 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  // Errors may be logged concurrently by the threads of a multi-threaded likelihood
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
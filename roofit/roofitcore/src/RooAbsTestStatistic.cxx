@@ -32,6 +32,13 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+The calculation can also be multi-threaded, see RooFit::NumThreads().
+Then, every thread owns a copy of the test statistic, with its own clones
+of the function and of the data. The events are split in chunks, several
+per thread, which are picked up by the threads of the ROOT thread pool when
+they are free. The values of the chunks are summed in a fixed order, so the
+result does not depend on which thread computed which chunk.
 **/
 
 #include "RooAbsTestStatistic.h"
@@ -52,6 +59,15 @@ combined in the main thread.
 
 #include "TTimeStamp.h"
 #include "TClass.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <mutex>
 #include <string>
 #include <stdexcept>
 
@@ -75,6 +91,8 @@ ClassImp(RooAbsTestStatistic);
 /// in each processing block many vary greatly thereby distributing the workload rather unevenly.
 /// \param[in] interleave is set to true, the interleave partitioning strategy is used where each partition
 /// i takes all bins for which (ibin % ncpu == i) which is more likely to result in an even workload.
+/// \param[in] nThreads If larger than one, and nCPU is one, the test statistic calculation will be parallelized
+/// over multiple threads of the ROOT thread pool.
 /// \param[in] verbose Be more verbose.
 /// \param[in] splitCutRange If true, a different rangeName constructed as rangeName_{catName} will be used
 /// as range definition for each index state of a RooSimultaneous. This means that a different range can be defined
@@ -97,10 +115,12 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _splitRange(cfg.splitCutRange),
   _verbose(cfg.verbose),
   // Determine if RooAbsReal is a RooSimultaneous
-  _gofOpMode{(cfg.nCPU>1 || cfg.nCPU==-1) ? MPMaster : (dynamic_cast<RooSimultaneous*>(_func) ? SimMaster : Slave)},
+  _gofOpMode{(cfg.nCPU>1 || cfg.nCPU==-1) ? MPMaster :
+             (dynamic_cast<RooSimultaneous*>(_func) ? SimMaster : (cfg.nThreads>1 ? ThreadMaster : Slave))},
   _nEvents{data.numEntries()},
   _nCPU(cfg.nCPU != -1 ? cfg.nCPU : 1),
-  _mpinterl(cfg.interleave)
+  _mpinterl(cfg.interleave),
+  _nThreads(std::max(cfg.nThreads, 1))
 {
   // Register all parameters as servers
   _paramSet.add(*std::unique_ptr<RooArgSet>{real.getParameters(&data)});
@@ -132,11 +152,13 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _splitRange(other._splitRange),
   _verbose(other._verbose),
   // Determine if RooAbsReal is a RooSimultaneous
-  _gofOpMode{(other._nCPU>1 || other._nCPU==-1) ? MPMaster : (dynamic_cast<RooSimultaneous*>(_func) ? SimMaster : Slave)},
+  _gofOpMode{(other._nCPU>1 || other._nCPU==-1) ? MPMaster :
+             (dynamic_cast<RooSimultaneous*>(_func) ? SimMaster : (other._nThreads>1 ? ThreadMaster : Slave))},
   _nEvents{_data->numEntries()},
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU != -1 ? other._nCPU : 1),
   _mpinterl(other._mpinterl),
+  _nThreads(other._nThreads),
   _doOffset(other._doOffset),
   _offset(other._offset),
   _evalCarry(other._evalCarry)
@@ -162,6 +184,11 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _gofArray ;
   }
 
+  if (ThreadMaster == _gofOpMode && _init) {
+    for (Int_t i = 0; i < _nThreads; ++i) delete _threadGofArray[i];
+    delete[] _threadGofArray ;
+  }
+
   delete _projDeps ;
 
 }
@@ -173,7 +200,8 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data, and then combined. If the test statistic calculation is parallelized,
-/// partitions are calculated in nCPU processes and combined a posteriori.
+/// partitions are calculated in nCPU processes or in chunks by nThreads threads,
+/// and combined a posteriori.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -238,6 +266,16 @@ Double_t RooAbsTestStatistic::evaluate() const
 
     return ret ;
 
+  } else if (ThreadMaster == _gofOpMode) {
+
+    Double_t ret = evaluateThreads();
+
+    const Double_t norm = globalNormalization();
+    ret /= norm;
+    _evalCarry /= norm;
+
+    return ret ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -293,6 +331,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName,_addCoefRangeName) ;
+  } else if (ThreadMaster == _gofOpMode) {
+    initThreadMode(_func,_data,_projDeps,_rangeName,_addCoefRangeName) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName,_addCoefRangeName) ;
   }
@@ -322,6 +362,11 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 // 	cout << "redirecting servers on " << _mpfeArray[i]->GetName() << endl;
       }
     }
+  } else if (ThreadMaster == _gofOpMode && _threadGofArray) {
+    // Forward to slaves
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _threadGofArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
+    }
   }
   return kFALSE;
 }
@@ -372,6 +417,12 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (ThreadMaster == _gofOpMode) {
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _threadGofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    // The caches may be rebuilt by the next evaluation
+    _threadsReady = kFALSE;
   }
 }
 
@@ -442,6 +493,137 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create one component test statistic
+/// per thread. Each of them has its own clones of the function and of the data,
+/// because the evaluation changes the values of the observables.
+
+void RooAbsTestStatistic::initThreadMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, std::string const& rangeName, std::string const& addCoefRangeName)
+{
+  _threadGofArray = new pRooAbsTestStatistic[_nThreads];
+
+  Configuration cfg;
+  cfg.rangeName = rangeName;
+  cfg.addCoefRangeName = addCoefRangeName;
+  cfg.nCPU = 1;
+  cfg.nThreads = 1;
+  // The slaves calculate chunks of events, only the interleaving and the bulk partitioning apply
+  cfg.interleave = _mpinterl==RooFit::Interleave ? RooFit::Interleave : RooFit::BulkPartition;
+  cfg.verbose = _verbose;
+  cfg.splitCutRange = _splitRange;
+  // This configuration parameter is stored in the RooAbsOptTestStatistic.
+  // It would have been cleaner to move the member variable into RooAbsTestStatistic,
+  // but to avoid incrementing the class version we do the dynamic_cast trick.
+  if(auto thisAsRooAbsOptTestStatistic = dynamic_cast<RooAbsOptTestStatistic const*>(this)) {
+    cfg.integrateOverBinsPrecision = thisAsRooAbsOptTestStatistic->_integrateBinsPrecision;
+  }
+
+  for (Int_t i = 0; i < _nThreads; ++i) {
+    RooAbsTestStatistic* gof = create(Form("%s_THR%d",GetName(),i),Form("%s_THR%d",GetTitle(),i),*real,*data,*projDeps,cfg);
+    gof->recursiveRedirectServers(_paramSet);
+    _threadGofArray[i] = gof;
+  }
+  _chunkOffsets.clear();
+  _threadsReady = kFALSE;
+
+  coutI(Eval) << "RooAbsTestStatistic::initThreadMode: created " << _nThreads << " test statistics for multi-threaded calculation." << endl;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the test statistic in multi-threaded mode. The events are split in
+/// a few chunks per thread, which are calculated by the first free thread. The
+/// values of the chunks are summed in the order of the chunks, such that the result
+/// does not depend on the scheduling. If offsetting is enabled, each chunk is
+/// offset by its own value at the first evaluation.
+
+Double_t RooAbsTestStatistic::evaluateThreads() const
+{
+  // The number of events after the reduction of the data to the fit range
+  const Int_t nEvents = _threadGofArray[0]->_nEvents;
+  const Int_t nChunks = std::max(1, std::min(nEvents, _nThreads*4));
+  const Int_t nSlaves = std::min(_nThreads, nChunks);
+
+  std::vector<std::pair<Double_t,Double_t>> results(nChunks);
+  if (_doOffset && _chunkOffsets.size() != static_cast<std::size_t>(nChunks)) {
+    _chunkOffsets.assign(nChunks, {0., 0.});
+  }
+
+  auto evalChunk = [&](RooAbsTestStatistic* slave, Int_t k) {
+    slave->setMPSet(k, nChunks);
+    Double_t value;
+    if (slave->_mpinterl == RooFit::Interleave) {
+      value = slave->evaluatePartition(k, nEvents, nChunks);
+    } else {
+      value = slave->evaluatePartition(static_cast<std::size_t>(nEvents) * k / nChunks,
+                                       static_cast<std::size_t>(nEvents) * (k + 1) / nChunks, 1);
+    }
+    results[k] = {value, slave->getCarry()};
+  };
+
+  if (!_threadsReady) {
+    // Evaluate all slaves once in this thread, such that their caches and
+    // the objects that are created lazily exist before the concurrent evaluations.
+    for (Int_t k = 0; k < nChunks; ++k) {
+      evalChunk(_threadGofArray[k % nSlaves], k);
+    }
+    _threadsReady = kTRUE;
+  } else {
+#ifdef R__USE_IMT
+    // Stack of the slaves that are not evaluating any chunk now
+    std::vector<RooAbsTestStatistic*> idle(_threadGofArray, _threadGofArray + nSlaves);
+    std::mutex idleMutex;
+    auto task = [&](Int_t k) {
+      RooAbsTestStatistic* slave;
+      {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        slave = idle.back();
+        idle.pop_back();
+      }
+      evalChunk(slave, k);
+      std::lock_guard<std::mutex> lock(idleMutex);
+      idle.push_back(slave);
+    };
+    ROOT::TThreadExecutor pool(nSlaves);
+    pool.Foreach(task, ROOT::TSeq<Int_t>(nChunks));
+#else
+    for (Int_t k = 0; k < nChunks; ++k) {
+      evalChunk(_threadGofArray[k % nSlaves], k);
+    }
+#endif
+  }
+
+  // Combine the chunks and apply the offsets
+  Double_t sum(0), carry = 0.;
+  ROOT::Math::KahanSum<double> totalOffset = 0.0;
+  for (Int_t k = 0; k < nChunks; ++k) {
+    Double_t y = results[k].first;
+    carry += results[k].second;
+    if (_doOffset) {
+      auto& chunkOffset = _chunkOffsets[k];
+      if (chunkOffset.first==0 && y!=0) {
+        chunkOffset = results[k];
+      }
+      y -= chunkOffset.first;
+      carry -= chunkOffset.second;
+      totalOffset += chunkOffset.first;
+    }
+    y -= carry;
+    const Double_t t = sum + y;
+    carry = (t - sum) - y;
+    sum = t;
+  }
+  if (_doOffset) {
+    _offset = totalOffset;
+  }
+
+  _evalCarry = carry;
+  return sum;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -524,6 +706,7 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
       cfg.verbose = _verbose;
       cfg.splitCutRange = _splitRange;
       cfg.binnedL = binnedL;
+      cfg.nThreads = _nThreads;
       // This configuration parameter is stored in the RooAbsOptTestStatistic.
       // It would have been cleaner to move the member variable into RooAbsTestStatistic,
       // but to avoid incrementing the class version we do the dynamic_cast trick.
@@ -634,6 +817,14 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
       delete dlist; // delete only list, data will be used
     }
     break;
+  case ThreadMaster:
+    // Forward to slaves, each of them has its own clone of the data
+    initialize();
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _threadGofArray[i]->setDataSlave(indata, kTRUE);
+    }
+    _threadsReady = kFALSE;
+    break;
   case MPMaster:
     // Not supported
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
@@ -674,6 +865,13 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case ThreadMaster:
+    // The offsets are applied per chunk of events by this instance, see evaluateThreads()
+    _doOffset = flag;
+    _chunkOffsets.clear();
+    _offset = 0;
+    setValueDirty();
+    break;
   }
 }
 
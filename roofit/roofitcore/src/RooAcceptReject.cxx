@@ -64,9 +64,12 @@ void RooAcceptReject::registerSampler(RooNumGenFactory& fact)
   RooRealVar nTrial1D("nTrial1D","Number of trial samples for 1-dim generation",1000,0,1e9) ;
   RooRealVar nTrial2D("nTrial2D","Number of trial samples for 2-dim generation",100000,0,1e9) ;
   RooRealVar nTrial3D("nTrial3D","Number of trial samples for N-dim generation",10000000,0,1e9) ;
+  RooRealVar nUniformBlock("nUniformBlock","Number of uniform numbers of the accept test generated at once (0: one per test)",0,0,1e9) ;
 
   RooAcceptReject* proto = new RooAcceptReject ;
-  fact.storeProtoSampler(proto,RooArgSet(nTrial0D,nTrial1D,nTrial2D,nTrial3D)) ;
+  RooArgSet params(nTrial0D,nTrial1D,nTrial2D,nTrial3D) ;
+  params.add(nUniformBlock) ;
+  fact.storeProtoSampler(proto,params) ;
 }
 
 
@@ -78,12 +81,13 @@ void RooAcceptReject::registerSampler(RooNumGenFactory& fact)
 /// cloned and so will not be disturbed during the generation process.
 
 RooAcceptReject::RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVars, const RooNumGenConfig& config, Bool_t verbose, const RooAbsReal* maxFuncVal) :
-  RooAbsNumGenerator(func,genVars,verbose,maxFuncVal), _nextCatVar(0), _nextRealVar(0)
+  RooAbsNumGenerator(func,genVars,verbose,maxFuncVal), _nextCatVar(0), _nextRealVar(0), _uniformBlock(0), _nextUniform(0)
 {
   _minTrialsArray[0] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial0D")) ;
   _minTrialsArray[1] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial1D")) ;
   _minTrialsArray[2] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial2D")) ;
   _minTrialsArray[3] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial3D")) ;
+  _uniformBlock = static_cast<UInt_t>(config.getConfigSection("RooAcceptReject").getRealValue("nUniformBlock",0)) ;
 
   _realSampleDim = _realVars.getSize() ;
   TIterator* iter = _catVars.createIterator() ;
@@ -271,7 +275,7 @@ const RooArgSet *RooAcceptReject::nextAcceptedEvent()
   while((event= _cache->get(_eventsUsed))) {    
     _eventsUsed++ ;
     // accept this cached event?
-    Double_t r= RooRandom::uniform();
+    Double_t r= nextUniform();
     if(r*_maxFuncVal > _funcValPtr->getVal()) {
       //cout << " event number " << _eventsUsed << " has been rejected" << endl ;
       continue;
@@ -290,6 +294,27 @@ const RooArgSet *RooAcceptReject::nextAcceptedEvent()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the uniform number of the next accept test. If the configuration
+/// parameter nUniformBlock is set, the numbers are generated in blocks of that
+/// size with RooRandom::uniform(UInt_t,Double_t[]), which uses the bulk generation
+/// of the random engine. This changes the sequence of the generated events with
+/// respect to the default, which draws one number per test.
+
+Double_t RooAcceptReject::nextUniform()
+{
+  if (_uniformBlock==0) return RooRandom::uniform() ;
+
+  if (_nextUniform>=_uniforms.size()) {
+    _uniforms.resize(_uniformBlock) ;
+    RooRandom::uniform(_uniformBlock,_uniforms.data()) ;
+    _nextUniform = 0 ;
+  }
+  return _uniforms[_nextUniform++] ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a trial event to our cache and update our estimates
 /// of the function maximum value and integral.
@@ -75,6 +75,7 @@ An (enforced) condition for this assumption is that each \f$ \mathrm{PDF}_i \f$
 #include "RooRealIntegral.h"
 #include "RooNaNPacker.h"
 #include "RooBatchCompute.h"
+#include "CodegenContext.h"
 
 #include <algorithm>
 #include <memory>
@@ -1021,6 +1022,74 @@ Double_t RooAddPdf::expectedEvents(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of the normalised sum, for the code generation of RooFuncWrapper.
+/// Recursive fractions and coefficients that are interpreted in a reference range or
+/// over reference observables that differ from `normSet` are not supported.
+
+std::string RooAddPdf::translateNormalized(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const
+{
+  if (_recursive || _refCoefRangeName || (!_refCoefNorm.empty() && !_refCoefNorm.equals(normSet))) {
+    return "";
+  }
+
+  std::vector<std::string> coefs;
+  if (_allExtendable) {
+    for (auto const& arg : _pdfList) {
+      coefs.push_back(ctx.getExpectedEvents(static_cast<RooAbsPdf&>(*arg), normSet));
+    }
+  } else {
+    for (auto const& arg : _coefList) {
+      coefs.push_back(ctx.getResult(*arg));
+    }
+  }
+
+  std::string sumCoefs;
+  for (auto const& coef : coefs) {
+    sumCoefs += (sumCoefs.empty() ? "" : " + ") + coef;
+  }
+  if (coefs.size() < _pdfList.size()) {
+    // The last coefficient is one minus the sum of the fractions
+    coefs.push_back("(1. - (" + sumCoefs + "))");
+  }
+
+  std::string result;
+  for (std::size_t i = 0; i < _pdfList.size(); ++i) {
+    auto const& pdf = static_cast<RooAbsPdf&>(_pdfList[i]);
+    result += (result.empty() ? "" : " + ") + coefs[i] + " * " + ctx.getNormalizedResult(pdf, normSet);
+  }
+  if (_haveLastCoef || _allExtendable) {
+    result = "(" + result + ") / (" + sumCoefs + ")";
+  }
+  return result;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of expectedEvents(), for the code generation of RooFuncWrapper.
+
+std::string RooAddPdf::translateExpectedEvents(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const
+{
+  if (_refCoefRangeName) {
+    return "";
+  }
+
+  std::string result;
+  if (_allExtendable) {
+    for (auto const& arg : _pdfList) {
+      result += (result.empty() ? "" : " + ") + ctx.getExpectedEvents(static_cast<RooAbsPdf&>(*arg), normSet);
+    }
+  } else {
+    for (auto const& arg : _coefList) {
+      result += (result.empty() ? "" : " + ") + ctx.getResult(*arg);
+    }
+  }
+  return result;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface function used by test statistics to freeze choice of observables
 /// for interpretation of fraction coefficients
@@ -37,6 +37,7 @@ in the two sets.
 #include "RooNLLVar.h"
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
+#include "CodegenContext.h"
 
 #include <algorithm>
 #include <cmath>
@@ -179,6 +180,19 @@ Double_t RooAddition::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of the sum, for the code generation of RooFuncWrapper.
+
+std::string RooAddition::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  std::string result;
+  for (const auto arg : _set) {
+    result += (result.empty() ? "" : " + ") + ctx.getResult(*arg);
+  }
+  return result.empty() ? "0." : result;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the default error level for MINUIT error analysis
 /// If the addition contains one or more RooNLLVars and 
@@ -969,6 +969,64 @@ Int_t RooDataHist::getIndex(const RooAbsCollection& coord, Bool_t fast) const {
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the bin indices of a batch of coordinates, as getIndex() does for a single point.
+/// The bins are looked up one variable at a time, and directly computed for uniform binnings.
+/// \param[in] coords One span of values for each variable of the histogram, in the order of get().
+/// A span with a single value is used for all points, and the current value of the variable is
+/// used if the span is empty. Categories always use their current state.
+/// \param[out] indices The bin indices. The vector is resized to the length of the longest span.
+void RooDataHist::getIndices(const std::vector<RooSpan<const double>>& coords, std::vector<std::size_t>& indices) const
+{
+  checkInit() ;
+  assert(coords.size() == _vars.size());
+
+  std::size_t nPoints = 1;
+  for (const auto& values : coords) {
+    nPoints = std::max(nPoints, values.size());
+  }
+  indices.assign(nPoints, 0);
+
+  for (unsigned int i=0; i < _vars.size(); ++i) {
+    const RooAbsBinning* binning = _lvbins[i].get();
+    const std::size_t mult = _idxMult[i];
+    const RooSpan<const double>& values = coords[i];
+
+    if (!binning || values.size() < 2) {
+      // Same bin for all points
+      std::size_t offset = 0;
+      if (!binning) {
+        auto cat = static_cast<const RooAbsCategoryLValue*>(_vars[i]);
+        offset = mult * cat->getBin(static_cast<const char*>(nullptr));
+      } else {
+        const double val = values.empty() ? static_cast<const RooAbsReal*>(_vars[i])->getVal() : values[0];
+        offset = mult * binning->binNumber(val);
+      }
+      for (auto& idx : indices) {
+        idx += offset;
+      }
+      continue;
+    }
+
+    assert(values.size() == nPoints);
+    if (auto uniform = dynamic_cast<const RooUniformBinning*>(binning)) {
+      // Same computation as RooUniformBinning::binNumber()
+      const double xlo = uniform->lowBound();
+      const double binw = uniform->averageBinWidth();
+      const int maxBin = uniform->numBins() - 1;
+      for (std::size_t j=0; j < nPoints; ++j) {
+        const int bin = static_cast<int>((values[j] - xlo) / binw);
+        indices[j] += mult * std::min(std::max(bin, 0), maxBin);
+      }
+    } else {
+      for (std::size_t j=0; j < nPoints; ++j) {
+        indices[j] += mult * binning->binNumber(values[j]);
+      }
+    }
+  }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate the bin index corresponding to the coordinates passed as argument.
 /// \param[in] coords Coordinates. If `fast == false`, these can be partial.
@@ -61,6 +61,7 @@ Check the tutorial rf506_msgservice.C for details.
 #include "RooArgList.h"
 #include "RooMsgService.h"
 #include "RooBatchCompute.h"
+#include "CodegenContext.h"
 
 #include "TObjString.h"
 #include "TClass.h"
@@ -365,6 +366,31 @@ Double_t RooFormula::eval(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a C++ expression of the formula, in which the `x[i]` are replaced by the
+/// results of the variables, for the code generation of RooFuncWrapper.
+/// Formulas that use special TFormula syntax, which is not valid C++, fail to compile.
+std::string RooFormula::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  if (!_tFormula) return "";
+
+  const std::string formula = _tFormula->GetTitle();
+  static const std::regex ordinalRegex("x\\[([0-9]+)\\]");
+  std::string result;
+  auto last = formula.cbegin();
+  for (std::sregex_iterator it(formula.cbegin(), formula.cend(), ordinalRegex), end; it != end; ++it) {
+    const auto& match = *it;
+    const std::size_t index = std::stoul(match[1].str());
+    result.append(last, match[0].first);
+    result += "(" + ctx.getResult(_origList[index]) + ")";
+    last = match[0].second;
+  }
+  result.append(last, formula.cend());
+
+  return "(" + result + ")";
+}
+
+
 RooSpan<double> RooFormula::evaluateSpan(const RooAbsReal* dataOwner, RooBatchCompute::RunContext& inputData, const RooArgSet* nset) const {
   if (!_tFormula) {
     coutF(Eval) << __func__ << " (" << GetName() << "): Formula didn't compile: " << GetTitle() << endl;
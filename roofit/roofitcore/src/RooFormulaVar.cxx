@@ -54,6 +54,7 @@
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "CodegenContext.h"
 
 
 using namespace std;
@@ -170,6 +171,15 @@ RooSpan<double> RooFormulaVar::evaluateSpan(RooBatchCompute::RunContext& inputDa
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of the formula, for the code generation of RooFuncWrapper.
+
+std::string RooFormulaVar::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  return getFormula().translate(ctx);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Propagate server change information to embedded RooFormula object
 
@@ -0,0 +1,284 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\class RooFuncWrapper
+\ingroup Roofitcore
+
+Negative log-likelihood of a pdf and a dataset, which is translated to C++ code
+and compiled with the interpreter. Instead of evaluating the computation graph
+node by node, with a virtual call per node and per event, the compiled function
+runs one flat loop over the events of the dataset:
+- The nodes that depend neither on the parameters nor on the observables are folded into literals.
+- The values that depend only on the parameters, like the normalisation integrals, are computed once before the loop.
+- A RooSimultaneous gets one loop for each of its categories, with only the code of the pdf of that category.
+
+~~~{.cpp}
+RooFuncWrapper nll("nll", "nll", pdf, data, true); // Extended likelihood
+std::cout << nll.code() << std::endl; // The generated code
+double value = nll.getVal();          // Same value as pdf.createNLL(data, Extended())
+~~~
+
+If ROOT was built with clad, the gradient of the likelihood with respect to all
+parameters() is also generated, see gradient().
+
+The code generation is supported by the classes which implement RooAbsReal::translate(),
+RooAbsReal::translateIntegral() and RooAbsPdf::translateNormalized(). The constructor
+throws a std::runtime_error if the pdf contains a class that does not support it. Fit
+ranges and constraint terms are not supported.
+**/
+
+#include "RooFuncWrapper.h"
+
+#include "CodegenContext.h"
+#include "RooAbsData.h"
+#include "RooAbsPdf.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
+#include "RooMsgService.h"
+
+#include "RConfigure.h"
+#include "TInterpreter.h"
+#include "TList.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <stdexcept>
+
+using RooFit::Detail::CodegenContext;
+
+ClassImp(RooFuncWrapper);
+
+namespace {
+
+/// Return a name for the generated function, which is unique in the interpreter.
+std::string makeFuncName(const char* name)
+{
+  static std::atomic<int> counter{0};
+  std::string funcName = std::string("RooFuncWrapper_") + name;
+  for (auto& c : funcName) {
+    if (!std::isalnum(static_cast<unsigned char>(c))) {
+      c = '_';
+    }
+  }
+  return funcName + "_" + std::to_string(counter++);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and compile the negative log-likelihood of `pdf` and `data`.
+/// \param[in] name Name of the function.
+/// \param[in] title Title of the function.
+/// \param[in] pdf The pdf. If it is a RooSimultaneous, the data are split by its index category.
+/// \param[in] data The dataset. The observables are the real-valued variables of the dataset that the pdf depends on.
+/// \param[in] extended Add the extended likelihood term.
+/// \throws std::runtime_error if the pdf cannot be translated, or the code does not compile.
+
+RooFuncWrapper::RooFuncWrapper(const char* name, const char* title, RooAbsPdf& pdf, RooAbsData& data, bool extended) :
+  RooAbsReal(name, title),
+  _params("!params", "Parameters of the likelihood", this),
+  _funcName(makeFuncName(name))
+{
+  std::unique_ptr<RooArgSet> params(pdf.getParameters(data));
+  for (const auto arg : *params) {
+    if (dynamic_cast<RooRealVar*>(arg)) {
+      _params.add(*arg);
+    }
+  }
+
+  buildCode(pdf, data, extended);
+  declareFunction();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor. The copy uses the same compiled function.
+
+RooFuncWrapper::RooFuncWrapper(const RooFuncWrapper& other, const char* name) :
+  RooAbsReal(other, name),
+  _params("!params", this, other._params),
+  _funcName(other._funcName),
+  _code(other._code),
+  _func(other._func),
+  _grad(other._grad),
+  _observables(other._observables),
+  _weights(other._weights)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code of the function. The columns of the observables and the
+/// weights are copied out of `data`, one block per category.
+
+void RooFuncWrapper::buildCode(RooAbsPdf& pdf, RooAbsData& data, bool extended)
+{
+  RooArgSet observables;
+  for (const auto arg : *data.get()) {
+    if (dynamic_cast<RooAbsReal*>(arg) && pdf.dependsOn(*arg)) {
+      observables.add(*arg);
+    }
+  }
+
+  std::vector<std::pair<RooAbsPdf*, RooAbsData*>> components;
+  TList* dataList = nullptr;
+  if (auto sim = dynamic_cast<RooSimultaneous*>(&pdf)) {
+    dataList = data.split(sim->indexCat(), true);
+    for (const auto& state : sim->indexCat()) {
+      RooAbsPdf* catPdf = sim->getPdf(state.first.c_str());
+      auto catData = static_cast<RooAbsData*>(dataList->FindObject(state.first.c_str()));
+      if (catPdf && catData) {
+        components.emplace_back(catPdf, catData);
+      }
+    }
+  } else {
+    components.emplace_back(&pdf, &data);
+  }
+
+  CodegenContext ctx(_params, observables);
+  std::string loops;
+  try {
+    for (const auto& component : components) {
+      RooAbsPdf& compPdf = *component.first;
+      RooAbsData& compData = *component.second;
+      const std::size_t nEvents = compData.numEntries();
+      if (nEvents == 0 && !(extended && compPdf.canBeExtended())) {
+        continue;
+      }
+
+      std::unique_ptr<RooArgSet> normSet(compPdf.getObservables(observables));
+      const std::size_t weightBase = _weights.size();
+      std::map<std::string, std::size_t> columns;
+      for (const auto obs : *normSet) {
+        columns[obs->GetName()] = _observables.size();
+        for (std::size_t i = 0; i < nEvents; ++i) {
+          const RooArgSet* row = compData.get(i);
+          _observables.push_back(static_cast<RooAbsReal*>(row->find(*obs))->getVal());
+        }
+      }
+      for (std::size_t i = 0; i < nEvents; ++i) {
+        compData.get(i);
+        _weights.push_back(compData.weight());
+      }
+      ctx.setColumns(std::move(columns));
+
+      if (nEvents > 0) {
+        const std::string value = ctx.getNormalizedResult(compPdf, *normSet);
+        loops += "   for (int i = 0; i < " + std::to_string(nEvents) + "; ++i) {\n"
+            + ctx.takeLoopCode()
+            + "      nll -= weights[" + std::to_string(weightBase) + " + i] * TMath::Log(" + value + ");\n"
+            + "   }\n";
+      }
+
+      if (extended && compPdf.canBeExtended()) {
+        const std::string expected = ctx.getExpectedEvents(compPdf, *normSet);
+        loops += "   nll += " + expected + " - " + CodegenContext::literal(compData.sumEntries())
+            + " * TMath::Log(" + expected + ");\n";
+      }
+    }
+  } catch (...) {
+    if (dataList) {
+      dataList->Delete();
+      delete dataList;
+    }
+    throw;
+  }
+  if (dataList) {
+    dataList->Delete();
+    delete dataList;
+  }
+
+  _code = "double " + _funcName + "(double *params, double const *obs, double const *weights)\n{\n"
+      + ctx.globalCode()
+      + "   double nll = 0.;\n"
+      + loops
+      + "   return nll;\n}\n";
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the generated code, and its gradient if clad is available.
+
+void RooFuncWrapper::declareFunction()
+{
+  if (!gInterpreter->Declare(("#include \"TMath.h\"\n" + _code).c_str())) {
+    throw std::runtime_error("RooFuncWrapper: the generated code of " + std::string(GetName())
+        + " failed to compile:\n" + _code);
+  }
+  _func = reinterpret_cast<Func>(gInterpreter->ProcessLine((_funcName + ";").c_str()));
+  if (!_func) {
+    throw std::runtime_error("RooFuncWrapper: cannot find the compiled function " + _funcName);
+  }
+
+#ifdef R__HAS_CLAD
+  static bool cladRuntimeIncluded = false;
+  if (!cladRuntimeIncluded) {
+    cladRuntimeIncluded = true;
+    gInterpreter->Declare("#include <Math/CladDerivator.h>\n#pragma clad OFF");
+  }
+  const std::string gradRequest = "#pragma clad ON\n"
+      "void " + _funcName + "_req() {\n"
+      "   clad::gradient(" + _funcName + ", \"params\");\n}\n"
+      "#pragma clad OFF";
+  if (gInterpreter->Declare(gradRequest.c_str())) {
+    _grad = reinterpret_cast<Grad>(gInterpreter->ProcessLine((_funcName + "_grad;").c_str()));
+  }
+  if (!_grad) {
+    coutW(Minimization) << "RooFuncWrapper::declareFunction(" << GetName()
+        << ") the gradient of the likelihood could not be generated." << std::endl;
+  }
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the current values of the parameters to the array read by the compiled function.
+
+void RooFuncWrapper::updateParameters() const
+{
+  _paramValues.resize(_params.size());
+  for (std::size_t i = 0; i < _paramValues.size(); ++i) {
+    _paramValues[i] = static_cast<RooAbsReal&>(_params[i]).getVal();
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the compiled likelihood.
+
+Double_t RooFuncWrapper::evaluate() const
+{
+  updateParameters();
+  return _func(_paramValues.data(), _observables.data(), _weights.data());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the gradient of the likelihood with respect to parameters() to `out`,
+/// which must hold one value per parameter.
+/// \throws std::logic_error if no gradient was generated, see hasGradient().
+
+void RooFuncWrapper::gradient(double* out) const
+{
+  if (!_grad) {
+    throw std::logic_error("RooFuncWrapper::gradient(): no gradient was generated for " + std::string(GetName()));
+  }
+  updateParameters();
+  std::fill(out, out + _paramValues.size(), 0.);
+  _grad(_paramValues.data(), _observables.data(), _weights.data(), out);
+}
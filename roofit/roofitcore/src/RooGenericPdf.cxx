@@ -50,6 +50,7 @@ the names of the arguments are not hard coded.
 #include "RooMsgService.h"
 #include "RooArgList.h"
 #include "RunContext.h"
+#include "CodegenContext.h"
 
 
 
@@ -139,6 +140,15 @@ RooSpan<double> RooGenericPdf::evaluateSpan(RooBatchCompute::RunContext& inputDa
   return results;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of the formula, for the code generation of RooFuncWrapper.
+
+std::string RooGenericPdf::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  return formula().translate(ctx);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change formula expression to given expression
 
@@ -37,6 +37,8 @@ discrete dimensions and may have negative values.
 #include "TError.h"
 #include "TBuffer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 using namespace std;
@@ -222,6 +224,31 @@ RooSpan<double> RooHistFunc::evaluateSpan(RooBatchCompute::RunContext& evalData,
 
   auto results = evalData.makeBatch(this, batchSize);
 
+  if (_intOrder == 0 && _histObsList.size() == inputValues.size()
+      && std::all_of(inputValues.begin(), inputValues.end(),
+                     [batchSize](const RooSpan<const double>& values) { return values.size() == batchSize; })) {
+    // No interpolation: compute all bin indices at once, and gather the weights
+    // from the contiguous array of bin contents.
+    std::vector<std::size_t> binIndices;
+    _dataHist->getIndices(inputValues, binIndices);
+    for (std::size_t i = 0; i < batchSize; ++i) {
+      results[i] = _dataHist->weight(binIndices[i]);
+    }
+
+    // Points outside of the range of the histogram
+    for (auto j = 0u; j < _histObsList.size(); ++j) {
+      const auto minMax = static_cast<const RooAbsRealLValue*>(_histObsList[j])->getRange(nullptr);
+      for (std::size_t i = 0; i < batchSize; ++i) {
+        const double val = inputValues[j][i];
+        const double epsilon = 1e-8 * std::abs(val);
+        if (val < minMax.first - epsilon || val > minMax.second + epsilon) {
+          results[i] = 0.;
+        }
+      }
+    }
+    return results;
+  }
+
   for (std::size_t i = 0; i < batchSize; ++i) {
     bool skip = false;
 
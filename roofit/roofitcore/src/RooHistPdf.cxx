@@ -36,10 +36,13 @@ discrete dimensions.
 #include "RooWorkspace.h"
 #include "RooGlobalFunc.h"
 #include "RooHelpers.h"
+#include "RunContext.h"
 
 #include "TError.h"
 #include "TBuffer.h"
 
+#include <algorithm>
+
 using namespace std;
 
 ClassImp(RooHistPdf);
@@ -223,6 +226,58 @@ Double_t RooHistPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of the histogram for a batch of events. As in evaluate(),
+/// the values are zero for events outside of the range of the histogram observables
+/// if these are not the observables of the p.d.f. themselves.
+
+RooSpan<double> RooHistPdf::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* /*normSet*/) const
+{
+  std::vector<RooSpan<const double>> inputValues;
+  std::size_t batchSize = 1;
+  for (unsigned int i=0; i < _pdfObsList.size(); ++i) {
+    RooAbsArg* harg = _histObsList[i];
+    RooAbsArg* parg = _pdfObsList[i];
+
+    auto realObs = dynamic_cast<const RooAbsReal*>(parg);
+    if (realObs) {
+      auto inputs = realObs->getValues(evalData, nullptr);
+      batchSize = std::max(batchSize, inputs.size());
+      inputValues.push_back(std::move(inputs));
+    } else {
+      // Categories don't come in batches, transfer their current state once
+      if (harg != parg) {
+        parg->syncCache() ;
+        harg->copyCache(parg,kTRUE) ;
+      }
+      inputValues.emplace_back();
+    }
+  }
+
+  auto results = evalData.makeBatch(this, batchSize);
+
+  for (std::size_t i = 0; i < batchSize; ++i) {
+    bool skip = false;
+
+    for (unsigned int j = 0; j < _pdfObsList.size(); ++j) {
+      RooAbsArg* harg = _histObsList[j];
+
+      if (i < inputValues[j].size()) {
+        harg->setCachedValue(inputValues[j][i], false);
+      }
+      if (harg != _pdfObsList[j] && !harg->inRange(nullptr)) {
+        skip = true;
+        break;
+      }
+    }
+
+    results[i] = skip ? 0. : std::max(_dataHist->weightFast(_histObsList, _intOrder, !_unitNorm, _cdfBoundaries), 0.);
+  }
+
+  return results;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total volume spanned by the observables of the RooHistPdf
 
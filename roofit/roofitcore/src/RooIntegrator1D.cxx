@@ -368,12 +368,14 @@ Double_t RooIntegrator1D::addMidpoints(Int_t n)
     del= _range/(3.*tnm);
     ddel= del+del;
     x= _xmin + 0.5*del;
-    for(sum= 0, j= 1; j <= it; j++) {
-      sum+= integrand(xvec(x));
+    _points.clear();
+    for(j= 1; j <= it; j++) {
+      _points.push_back(x);
       x+= ddel;
-      sum+= integrand(xvec(x));
+      _points.push_back(x);
       x+= del;
-    }      
+    }
+    sum= sumIntegrand();
     return (_savedResult= (_savedResult + _range*sum/tnm)/3.);
   }
 }
@@ -398,12 +400,11 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
     const double del = _range/nInt;
     const double xmin = _xmin;
 
-    double sum = 0.;
-    // TODO Replace by batch computation
+    _points.resize(nInt);
     for (int j=0; j<nInt; ++j) {
-      double x = xmin + (0.5+j)*del;
-      sum += integrand(xvec(x));
+      _points[j] = xmin + (0.5+j)*del;
     }
+    const double sum = sumIntegrand();
 
     return (_savedResult= 0.5*(_savedResult + _range*sum/nInt));
   }
@@ -411,6 +412,23 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the sum of the integrand over all points in `_points`. The points are
+/// evaluated in one batch if the integrand supports it.
+
+Double_t RooIntegrator1D::sumIntegrand()
+{
+  _values.resize(_points.size());
+  RooAbsIntegrator::integrand(_points, _x, _values);
+
+  double sum = 0.;
+  for (double value : _values) {
+    sum += value;
+  }
+  return sum;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Extrapolate result to final value
 
@@ -66,11 +66,16 @@ void RooMinimizerFcn::setOptimizeConstOnFunction(RooAbsArg::ConstOpCode opcode,
 /// Evaluate function given the parameters in `x`.
 double RooMinimizerFcn::DoEval(const double *x) const {
 
-  // Set the parameter values for this iteration
+  // Set the parameter values for this iteration. The clients of the changed
+  // parameters are notified together, visiting each node of the graph once.
+  _changedParams.clear();
   for (unsigned index = 0; index < _nDim; index++) {
     if (_logfile) (*_logfile) << x[index] << " " ;
-    SetPdfParamVal(index,x[index]);
+    if (SetPdfParamVal(index, x[index], false)) {
+      _changedParams.push_back(&(*_floatParamList)[index]);
+    }
   }
+  RooAbsArg::propagateValueDirty(_changedParams);
 
   // Calculate the function for these parameters
   RooAbsReal::setHideOffset(kFALSE) ;
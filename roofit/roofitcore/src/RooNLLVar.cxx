@@ -58,6 +58,7 @@ namespace {
     cfg.rangeName = RooCmdConfig::decodeStringOnTheFly("RooNLLVar::RooNLLVar","RangeWithName",0,"",args...);
     cfg.addCoefRangeName = RooCmdConfig::decodeStringOnTheFly("RooNLLVar::RooNLLVar","AddCoefRange",0,"",args...);
     cfg.nCPU = RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","NumCPU",0,1,args...);
+    cfg.nThreads = RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","NumThreads",0,1,args...);
     cfg.interleave = RooFit::BulkPartition;
     cfg.verbose = static_cast<bool>(RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","Verbose",0,1,args...));
     cfg.splitCutRange = static_cast<bool>(RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","SplitRange",0,0,args...));
@@ -81,6 +82,7 @@ RooNLLVar::RooNLLVar()
 ///  -------------------------|------------
 ///  Extended()               | Include extended term in calculation
 ///  NumCPU()                 | Activate parallel processing feature
+///  NumThreads()             | Activate multi-threaded processing feature
 ///  Range()                  | Fit only selected region
 ///  SumCoefRange()           | Set the range in which to interpret the coefficients of RooAddPdf components
 ///  SplitRange()             | Fit range is split by index category of simultaneous PDF
@@ -261,6 +263,19 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==SimMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
+  } else if ( _gofOpMode==ThreadMaster) {
+    initialize();
+    for (Int_t i=0 ; i<_nThreads ; i++)
+      ((RooNLLVar*)_threadGofArray[i])->applyWeightSquared(flag);
+    if (flag != _weightSq) {
+      _weightSq = flag;
+      // The offsets of the chunks are recalculated for the new weights
+      if (isOffsetting()) {
+        enableOffsetting(kFALSE);
+        enableOffsetting(kTRUE);
+      }
+    }
+    setValueDirty();
   }
 }
 
@@ -61,6 +61,7 @@ have to appear in any specific place in the list.
 #include "RooBatchCompute.h"
 #include "RooHelpers.h"
 #include "strtok.h"
+#include "CodegenContext.h"
 
 #include <cstring>
 #include <sstream>
@@ -1872,6 +1873,46 @@ Double_t RooProdPdf::expectedEvents(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of the normalised product, for the code generation of RooFuncWrapper.
+/// Only products of p.d.f.s that are normalised over disjoint sets of observables, without
+/// conditional terms, are supported. As in the evaluation of the product, the terms that do
+/// not depend on the observables in `normSet` drop out.
+
+std::string RooProdPdf::translateNormalized(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const
+{
+  RooFIter iter = _pdfNSetList.fwdIterator();
+  RooArgSet* nset ;
+  while ((nset=(RooArgSet*)iter.next())) {
+    if (!nset->empty()) return "";
+  }
+
+  RooArgSet seenObs;
+  std::string result;
+  for (auto const& arg : _pdfList) {
+    auto const& pdf = static_cast<RooAbsPdf&>(*arg);
+    std::unique_ptr<RooArgSet> pdfObs(pdf.getObservables(normSet));
+    if (pdfObs->empty()) continue;
+    if (seenObs.overlaps(*pdfObs)) return "";
+    seenObs.add(*pdfObs);
+    result += (result.empty() ? "" : " * ") + ctx.getNormalizedResult(pdf, *pdfObs);
+  }
+  return result.empty() ? "1." : result;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of expectedEvents(), for the code generation of RooFuncWrapper.
+
+std::string RooProdPdf::translateExpectedEvents(RooFit::Detail::CodegenContext& ctx, const RooArgSet& normSet) const
+{
+  if (_extendedIndex<0) return "";
+  return ctx.getExpectedEvents(static_cast<RooAbsPdf&>(_pdfList[_extendedIndex]), normSet);
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return generator context optimized for generating events from product p.d.f.s
 
@@ -31,6 +31,7 @@ A RooProduct represents the product of a given set of RooAbsReal objects.
 #include "RooMsgService.h"
 #include "RunContext.h"
 #include "RooTrace.h"
+#include "CodegenContext.h"
 
 #include <cmath>
 #include <memory>
@@ -384,6 +385,25 @@ Double_t RooProduct::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression of the product, for the code generation of RooFuncWrapper.
+/// Products with category components are only supported if the categories are constant.
+
+std::string RooProduct::translate(RooFit::Detail::CodegenContext& ctx) const
+{
+  std::string result;
+  for (const auto item : _compRSet) {
+    result += (result.empty() ? "" : " * ") + ctx.getResult(*item);
+  }
+  for (const auto item : _compCSet) {
+    auto ccomp = static_cast<const RooAbsCategory*>(item);
+    if (!ccomp->isConstant()) return "";
+    result += (result.empty() ? "" : " * ") + RooFit::Detail::CodegenContext::literal(ccomp->getCurrentIndex());
+  }
+  return result.empty() ? "1." : result;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate product of input functions for all points found in `evalData`.
 RooSpan<double> RooProduct::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
@@ -311,7 +311,7 @@ RooSpan<double> RooRealSumPdf::evaluateSpan(RooBatchCompute::RunContext& evalDat
   // Introduce floor if so requested
   if (_doFloor || _doFloorGlobal) {
     for (unsigned int j = 0; j < values.size(); ++j) {
-      values[j] += std::max(0., values[j]);
+      values[j] = std::max(0., values[j]);
     }
   }
 
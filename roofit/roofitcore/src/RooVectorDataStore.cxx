@@ -390,6 +390,73 @@ Int_t RooVectorDataStore::fill()
 
   return 0 ;
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append a block of events, given as one column of values for each observable.
+/// Each column is copied in one go into the storage, which is much faster than
+/// filling the events one by one with fill(). The stored columns can be retrieved
+/// for the batch evaluation with getBatches(), without further copies.
+/// \param[in] columns Values of the real-valued observables, by name. All columns need to have
+/// the same length. The observables without a column are filled with their current value, as
+/// fill() does. For a weighted dataset, the column of the weight variable holds the weights.
+/// \return The number of appended events, or -1 if the columns don't match the observables.
+/// No event is appended in this case.
+
+Int_t RooVectorDataStore::appendColumns(const std::map<std::string, RooSpan<const double>>& columns)
+{
+  if (columns.empty()) {
+    return 0;
+  }
+
+  const std::size_t nEvents = columns.begin()->second.size();
+  for (const auto& column : columns) {
+    const RooAbsArg* arg = _varsww.find(column.first.c_str());
+    if (!arg || !dynamic_cast<const RooAbsReal*>(arg)) {
+      coutE(InputArguments) << "RooVectorDataStore::appendColumns(" << GetName() << ") the column " << column.first
+          << " does not correspond to a real-valued observable of the dataset." << std::endl;
+      return -1;
+    }
+    if (column.second.size() != nEvents) {
+      coutE(InputArguments) << "RooVectorDataStore::appendColumns(" << GetName() << ") the column " << column.first
+          << " has " << column.second.size() << " values instead of " << nEvents << "." << std::endl;
+      return -1;
+    }
+  }
+
+  for (auto realVec : _realStoreList) {
+    auto column = columns.find(realVec->bufArg()->GetName());
+    if (column != columns.end()) {
+      realVec->append(column->second);
+    } else {
+      realVec->fill(nEvents);
+    }
+  }
+  for (auto fullVec : _realfStoreList) {
+    auto column = columns.find(fullVec->bufArg()->GetName());
+    if (column != columns.end()) {
+      fullVec->append(column->second);
+    } else {
+      fullVec->fill(nEvents);
+    }
+  }
+  for (auto catVec : _catStoreList) {
+    catVec->fill(nEvents);
+  }
+
+  // use Kahan's algorithm to sum up weights to avoid loss of precision
+  auto weights = _wgtVar ? columns.find(_wgtVar->GetName()) : columns.end();
+  for (std::size_t i = 0; i < nEvents; ++i) {
+    const Double_t wgt = weights != columns.end() ? weights->second[i] : (_wgtVar ? _wgtVar->getVal() : 1.);
+    Double_t y = wgt - _sumWeightCarry;
+    Double_t t = _sumWeight + y;
+    _sumWeightCarry = (t - _sumWeight) - y;
+    _sumWeight = t;
+  }
+
+  return static_cast<Int_t>(nEvents);
+}
  
 
 
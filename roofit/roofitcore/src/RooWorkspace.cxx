@@ -76,6 +76,7 @@ and try reading again.
 #include "strlcpy.h"
 
 #include <map>
+#include <unordered_set>
 #include <sstream>
 #include <string>
 #include <iostream>
@@ -2604,19 +2605,19 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
       // Make expensive object cache of all objects point to intermal copy.
       // Somehow this doesn't work OK automatically
-      TIterator* iter = _allOwnedNodes.createIterator() ;
-      while((node=(RooAbsArg*)iter->Next())) {
-	node->setExpensiveObjectCache(_eocache) ;
-   node->setWorkspace(*this);
-   if (node->IsA()->InheritsFrom(RooAbsOptTestStatistic::Class())) {
-      RooAbsOptTestStatistic *tmp = (RooAbsOptTestStatistic *)node;
-      if (tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
-         cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
-              << " : " << tmp->sealNotice() << endl;
-      }
-   }
+      for (RooAbsArg* arg : _allOwnedNodes) {
+        arg->setExpensiveObjectCache(_eocache) ;
+        arg->setWorkspace(*this);
+        if (auto tmp = dynamic_cast<RooAbsOptTestStatistic*>(arg)) {
+          if (tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
+            cout << "RooWorkspace::Streamer(" << GetName() << ") " << arg->IsA()->GetName() << "::" << arg->GetName()
+                 << " : " << tmp->sealNotice() << endl;
+          }
+        }
       }
-      delete iter ;
+
+      // The lookups of components by name should not scan tens of thousands of nodes
+      _allOwnedNodes.useHashMapForFind(true);
 
 
    } else {
@@ -2625,14 +2626,18 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
      map<RooAbsArg*,vector<RooAbsArg *> > extClients, extValueClients, extShapeClients ;
 
-     TIterator* iter = _allOwnedNodes.createIterator() ;
-     RooAbsArg* tmparg ;
-     while((tmparg=(RooAbsArg*)iter->Next())) {
+     // Set of the owned nodes, for a constant-time lookup of the clients.
+     // Large workspaces have tens of thousands of nodes, and a linear search
+     // of the clients in _allOwnedNodes makes writing them quadratic.
+     const std::unordered_set<const RooAbsArg*> ownedNodes(_allOwnedNodes.begin(), _allOwnedNodes.end());
+     auto isOwned = [&ownedNodes](const RooAbsArg* arg) { return ownedNodes.count(arg) > 0; };
+
+     for (RooAbsArg* tmparg : _allOwnedNodes) {
 
        // Loop over client list of this arg
        std::vector<RooAbsArg *> clientsTmp{tmparg->_clientList.begin(), tmparg->_clientList.end()};
        for (auto client : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*client)) {
+         if (!isOwned(client)) {
 
            const auto refCount = tmparg->_clientList.refCount(client);
            auto& bufferVec = extClients[tmparg];
@@ -2645,7 +2650,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over value client list of this arg
        clientsTmp.assign(tmparg->_clientListValue.begin(), tmparg->_clientListValue.end());
        for (auto vclient : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*vclient)) {
+         if (!isOwned(vclient)) {
            cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
 				       << " has external value client link to " << vclient << " (" << vclient->GetName() << ") with ref count " << tmparg->_clientListValue.refCount(vclient) << endl ;
 
@@ -2660,7 +2665,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over shape client list of this arg
        clientsTmp.assign(tmparg->_clientListShape.begin(), tmparg->_clientListShape.end());
        for (auto sclient : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*sclient)) {
+         if (!isOwned(sclient)) {
            cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
 				         << " has external shape client link to " << sclient << " (" << sclient->GetName() << ") with ref count " << tmparg->_clientListShape.refCount(sclient) << endl ;
 
@@ -2673,7 +2678,6 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        }
 
      }
-     delete iter ;
 
      R__b.WriteClassBuffer(RooWorkspace::Class(),this);
 
@@ -13,6 +13,9 @@
 #include "RooHelpers.h"
 #include "RooGaussian.h"
 #include "RooPoisson.h"
+#include "RooHistPdf.h"
+#include "RooCachedPdf.h"
+#include "RunContext.h"
 
 #include "TClass.h"
 #include "TRandom.h"
@@ -183,3 +186,38 @@ TEST(RooAbsPdf, MultiRangeFit)
     }
   }
 }
+
+
+// The RooHistPdf and the pdfs cached in a histogram, like RooFFTConvPdf, are
+// evaluated in batches without falling back to the scalar evaluation, and give
+// the same values as in scalar mode.
+TEST(RooAbsPdf, BatchEvaluationOfHistogramPdfs)
+{
+  RooRealVar x("x", "x", 0, -5, 5);
+  RooRealVar mean("mean", "mean", 0.5, -1, 1);
+  RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 10);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+  std::unique_ptr<RooDataHist> hist(gauss.generateBinned(x, 10000));
+  RooHistPdf histPdf("histPdf", "histPdf", x, *hist, 1);
+  RooCachedPdf cachedPdf("cachedPdf", "cachedPdf", gauss);
+
+  std::unique_ptr<RooDataSet> data(gauss.generate(x, 200));
+  RooArgSet normSet(x);
+
+  RooHelpers::HijackMessageStream hijack(RooFit::INFO, RooFit::FastEvaluations);
+
+  for (RooAbsPdf* pdf : std::initializer_list<RooAbsPdf*>{&histPdf, &cachedPdf}) {
+    RooBatchCompute::RunContext evalData;
+    data->getBatches(evalData);
+    auto values = pdf->getValues(evalData, &normSet);
+    ASSERT_EQ(values.size(), static_cast<std::size_t>(data->numEntries())) << pdf->GetName();
+
+    for (int i = 0; i < data->numEntries(); ++i) {
+      x.setVal(data->get(i)->getRealValue("x"));
+      EXPECT_NEAR(values[i], pdf->getVal(normSet), 1.E-12) << pdf->GetName() << " event " << i;
+    }
+  }
+
+  EXPECT_TRUE(hijack.str().empty()) << hijack.str();
+}
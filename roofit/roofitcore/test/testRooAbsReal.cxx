@@ -2,6 +2,7 @@
 // Author: Stephan Hageboeck, CERN 05/2020
 
 #include "RooRealVar.h"
+#include "RooFormulaVar.h"
 #include "RooDataSet.h"
 #include "RooHelpers.h"
 #include "RooGlobalFunc.h"
@@ -48,3 +49,21 @@ TEST(RooAbsReal, ReadFromTree)
   EXPECT_EQ(msgs.find(std::string(a.GetName()) + targetMsg), std::string::npos) << "Expect not to see INFO messages for conversion of double branch to double.";
 }
 
+/// Changing values without notifying the clients, and propagating the dirty flags together.
+TEST(RooAbsReal, PropagateValueDirty)
+{
+  RooRealVar x("x", "x", 1., -10., 10.);
+  RooRealVar y("y", "y", 2., -10., 10.);
+  RooFormulaVar sum("sum", "x + y", RooArgList(x, y));
+  RooFormulaVar prod("prod", "sum * x", RooArgList(sum, x));
+  EXPECT_DOUBLE_EQ(prod.getVal(), 3.);
+
+  x.setCachedValue(2., false);
+  y.setCachedValue(3., false);
+  // The clients still have their cached values
+  EXPECT_DOUBLE_EQ(prod.getVal(), 3.);
+
+  RooAbsArg::propagateValueDirty({&x, &y});
+  EXPECT_DOUBLE_EQ(sum.getVal(), 5.);
+  EXPECT_DOUBLE_EQ(prod.getVal(), 10.);
+}
@@ -5,6 +5,7 @@
 #include "RooDataHist.h"
 #include "RooGlobalFunc.h"
 #include "RooRealVar.h"
+#include "RooBinning.h"
 #include "RooHelpers.h"
 #include "RooCategory.h"
 #include "RunContext.h"
@@ -703,3 +704,42 @@ TEST(RooDataHist, Interpolation2DSimple)
       }
    }
 }
+
+/// The bin indices of batches of coordinates must match the ones of getIndex(),
+/// for uniform and for variable binnings.
+TEST(RooDataHist, BatchBinIndices)
+{
+   RooRealVar x("x", "x", 0, -10, 10);
+   RooRealVar y("y", "y", 0, 0, 10);
+   x.setBins(20);
+   const double yBoundaries[] = {0., 1., 1.5, 4., 7., 10.};
+   y.setBinning(RooBinning(5, yBoundaries));
+
+   RooDataHist dataHist("dataHist", "dataHist", RooArgSet(x, y));
+
+   std::vector<double> xValues;
+   std::vector<double> yValues;
+   for (int i = 0; i < 200; ++i) {
+      xValues.push_back(-12. + 0.12 * i);
+      yValues.push_back(-1. + 0.06 * ((7 * i) % 200));
+   }
+
+   std::vector<std::size_t> indices;
+   dataHist.getIndices({RooSpan<const double>(xValues), RooSpan<const double>(yValues)}, indices);
+   ASSERT_EQ(indices.size(), xValues.size());
+   for (std::size_t i = 0; i < xValues.size(); ++i) {
+      x.setVal(xValues[i]);
+      y.setVal(yValues[i]);
+      EXPECT_EQ(indices[i], static_cast<std::size_t>(dataHist.getIndex(RooArgSet(x, y))))
+         << "x=" << xValues[i] << " y=" << yValues[i];
+   }
+
+   // A single value is used for all points
+   y.setVal(5.);
+   const double yValue = 5.;
+   dataHist.getIndices({RooSpan<const double>(xValues), RooSpan<const double>(&yValue, 1)}, indices);
+   for (std::size_t i = 0; i < xValues.size(); ++i) {
+      x.setVal(xValues[i]);
+      EXPECT_EQ(indices[i], static_cast<std::size_t>(dataHist.getIndex(RooArgSet(x, y))));
+   }
+}
@@ -6,6 +6,7 @@
 #include "RooRealVar.h"
 #include "RooHelpers.h"
 #include "RooCategory.h"
+#include "RunContext.h"
 
 #include <TFile.h>
 #include <TTree.h>
@@ -22,6 +23,7 @@
 
 #include <fstream>
 #include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -259,3 +261,53 @@ TEST(RooDataSet, CrashAfterImportFromTree) {
   EXPECT_EQ(static_cast<RooRealVar*>(data_set->get(1)->find("var"))->getVal(), 2.);
 
 }
+
+/// Appending whole columns must give the same dataset as adding the events one by one.
+TEST(RooDataSet, AppendColumns) {
+  RooRealVar x("x", "x", -10., 10.);
+  RooRealVar y("y", "y", 3., -10., 10.);
+  RooRealVar w("w", "w", 1., 0., 10.);
+
+  std::vector<double> xValues;
+  std::vector<double> wValues;
+  for (int i = 0; i < 100; ++i) {
+    xValues.push_back(-5. + 0.1 * i);
+    wValues.push_back(0.5 + 0.01 * i);
+  }
+
+  RooDataSet rowWise("rowWise", "rowWise", RooArgSet(x, y, w), RooFit::WeightVar(w));
+  for (std::size_t i = 0; i < xValues.size(); ++i) {
+    x.setVal(xValues[i]);
+    rowWise.add(RooArgSet(x, y), wValues[i]);
+  }
+
+  RooDataSet columnWise("columnWise", "columnWise", RooArgSet(x, y, w), RooFit::WeightVar(w));
+  EXPECT_EQ(columnWise.appendColumns({{"x", RooSpan<const double>(xValues)}, {"w", RooSpan<const double>(wValues)}}),
+            static_cast<Int_t>(xValues.size()));
+
+  ASSERT_EQ(columnWise.numEntries(), rowWise.numEntries());
+  EXPECT_DOUBLE_EQ(columnWise.sumEntries(), rowWise.sumEntries());
+  for (int i = 0; i < rowWise.numEntries(); ++i) {
+    const RooArgSet* row = rowWise.get(i);
+    const RooArgSet* column = columnWise.get(i);
+    EXPECT_EQ(static_cast<RooRealVar*>(column->find("x"))->getVal(), static_cast<RooRealVar*>(row->find("x"))->getVal());
+    EXPECT_EQ(static_cast<RooRealVar*>(column->find("y"))->getVal(), 3.);
+    EXPECT_EQ(columnWise.weight(), rowWise.weight());
+  }
+
+  // The columns are available for the batch evaluation
+  RooBatchCompute::RunContext evalData;
+  columnWise.getBatches(evalData);
+  auto xBatch = evalData.getBatch(static_cast<RooAbsReal*>(columnWise.get()->find("x")));
+  ASSERT_EQ(xBatch.size(), xValues.size());
+  for (std::size_t i = 0; i < xValues.size(); ++i) {
+    EXPECT_EQ(xBatch[i], xValues[i]);
+  }
+
+  // Columns of different length or of unknown variables are rejected without adding events
+  std::vector<double> shortColumn(10, 1.);
+  RooHelpers::HijackMessageStream hijack(RooFit::ERROR, RooFit::InputArguments);
+  EXPECT_EQ(columnWise.appendColumns({{"x", RooSpan<const double>(xValues)}, {"y", RooSpan<const double>(shortColumn)}}), -1);
+  EXPECT_EQ(columnWise.appendColumns({{"z", RooSpan<const double>(shortColumn)}}), -1);
+  EXPECT_EQ(columnWise.numEntries(), rowWise.numEntries());
+}
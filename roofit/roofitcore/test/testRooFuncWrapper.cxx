@@ -0,0 +1,114 @@
+// Tests for the RooFuncWrapper
+
+#include "RooAddPdf.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooExponential.h"
+#include "RooFormulaVar.h"
+#include "RooFuncWrapper.h"
+#include "RooGaussian.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Compare the gradient of the wrapper, if it was generated, with the numerical derivatives.
+void checkGradient(RooFuncWrapper &wrapper)
+{
+   if (!wrapper.hasGradient())
+      return;
+
+   const RooArgList &params = wrapper.parameters();
+   std::vector<double> grad(params.size());
+   wrapper.gradient(grad.data());
+   for (std::size_t i = 0; i < params.size(); ++i) {
+      auto &par = static_cast<RooRealVar &>(params[i]);
+      const double val = par.getVal();
+      const double h = 1.e-5 * std::max(1., std::abs(val));
+      par.setVal(val + h);
+      const double up = wrapper.getVal();
+      par.setVal(val - h);
+      const double down = wrapper.getVal();
+      par.setVal(val);
+      EXPECT_NEAR(grad[i], (up - down) / (2. * h), 1.e-4 * std::max(1., std::abs(grad[i]))) << par.GetName();
+   }
+}
+
+} // namespace
+
+TEST(RooFuncWrapper, ExtendedAddPdf)
+{
+   using namespace RooFit;
+
+   RooRealVar x("x", "x", 0, 10);
+   RooRealVar mean("mean", "mean", 5., 0, 10);
+   RooRealVar width("width", "width", 1., 0.1, 10);
+   RooRealVar c("c", "c", -0.2, -10, -0.01);
+   RooRealVar nsig("nsig", "nsig", 300, 0, 1000);
+   RooRealVar nbkg("nbkg", "nbkg", 700, 0, 1000);
+
+   RooGaussian sig("sig", "sig", x, mean, width);
+   RooExponential bkg("bkg", "bkg", x, c);
+   RooAddPdf model("model", "model", RooArgList(sig, bkg), RooArgList(nsig, nbkg));
+
+   std::unique_ptr<RooDataSet> data{model.generate(x)};
+
+   std::unique_ptr<RooAbsReal> nll{model.createNLL(*data, Extended())};
+   RooFuncWrapper wrapper("nllWrapped", "nllWrapped", model, *data, true);
+
+   EXPECT_NEAR(nll->getVal(), wrapper.getVal(), 1.e-8 * std::abs(nll->getVal()));
+
+   // The compiled function must follow the parameters
+   mean.setVal(4.5);
+   width.setVal(1.5);
+   nsig.setVal(400);
+   EXPECT_NEAR(nll->getVal(), wrapper.getVal(), 1.e-8 * std::abs(nll->getVal()));
+
+   checkGradient(wrapper);
+}
+
+TEST(RooFuncWrapper, Simultaneous)
+{
+   using namespace RooFit;
+
+   RooRealVar x("x", "x", -10, 10);
+   RooRealVar mean("mean", "mean", 0., -5, 5);
+   RooRealVar width("width", "width", 2., 0.1, 10);
+   RooRealVar shift("shift", "shift", 1., -5, 5);
+   RooRealVar frac("frac", "frac", 0.3, 0., 1.);
+
+   RooGaussian gauss1("gauss1", "gauss1", x, mean, width);
+   RooFormulaVar mean2("mean2", "mean2", "mean + shift", RooArgList(mean, shift));
+   RooGaussian gauss2("gauss2", "gauss2", x, mean2, width);
+   RooAddPdf model2("model2", "model2", RooArgList(gauss1, gauss2), RooArgList(frac));
+
+   RooCategory cat("cat", "cat");
+   cat.defineType("one");
+   cat.defineType("two");
+
+   RooSimultaneous sim("sim", "sim", cat);
+   sim.addPdf(gauss1, "one");
+   sim.addPdf(model2, "two");
+
+   std::unique_ptr<RooDataSet> data1{gauss1.generate(x, 100)};
+   std::unique_ptr<RooDataSet> data2{model2.generate(x, 200)};
+   RooDataSet combData("combData", "combData", x, Index(cat), Import("one", *data1), Import("two", *data2));
+
+   std::unique_ptr<RooAbsReal> nll{sim.createNLL(combData)};
+   RooFuncWrapper wrapper("nllWrapped", "nllWrapped", sim, combData);
+
+   EXPECT_NEAR(nll->getVal(), wrapper.getVal(), 1.e-8 * std::abs(nll->getVal()));
+
+   shift.setVal(-1.);
+   frac.setVal(0.6);
+   EXPECT_NEAR(nll->getVal(), wrapper.getVal(), 1.e-8 * std::abs(nll->getVal()));
+
+   checkGradient(wrapper);
+}
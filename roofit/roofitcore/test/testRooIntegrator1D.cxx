@@ -0,0 +1,48 @@
+// Tests for the RooIntegrator1D
+
+#include "RooFormulaVar.h"
+#include "RooIntegrator1D.h"
+#include "RooRealBinding.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace {
+
+/// Forwards to another function binding, but hides that it supports batch evaluations.
+class ScalarFunc : public RooAbsFunc {
+public:
+  ScalarFunc(const RooAbsFunc& func) : RooAbsFunc(func.getDimension()), _func(func) { }
+  Double_t operator()(const Double_t xvector[]) const override { return _func(xvector); }
+  Double_t getMinLimit(UInt_t dimension) const override { return _func.getMinLimit(dimension); }
+  Double_t getMaxLimit(UInt_t dimension) const override { return _func.getMaxLimit(dimension); }
+
+private:
+  const RooAbsFunc& _func;
+};
+
+}
+
+/// The integrands of RooRealBinding are evaluated in batches, which must give the
+/// same integrals as the evaluation point by point.
+TEST(RooIntegrator1D, BatchEvaluation)
+{
+  RooRealVar x("x", "x", 0., 3.);
+  RooRealVar c("c", "c", 1., 0.1, 10.);
+  RooFormulaVar func("func", "func", "x*x*exp(-c*x)", RooArgList(x, c));
+
+  RooRealBinding binding(func, x);
+  ScalarFunc scalarBinding(binding);
+  const double expected = 2. - 17. * std::exp(-3.);
+
+  for (auto rule : {RooIntegrator1D::Trapezoid, RooIntegrator1D::Midpoint}) {
+    RooIntegrator1D batchIntegrator(binding, rule);
+    RooIntegrator1D scalarIntegrator(scalarBinding, rule);
+
+    const double batchResult = batchIntegrator.integral();
+    EXPECT_NEAR(batchResult, expected, 1.e-6);
+    EXPECT_NEAR(batchResult, scalarIntegrator.integral(), 1.e-12);
+  }
+}
@@ -13,6 +13,8 @@
 #include <RooBinning.h>
 #include <RooPlot.h>
 #include <RooRandom.h>
+#include <RooAddPdf.h>
+#include <RooAbsReal.h>
 
 #include <gtest/gtest.h>
 
@@ -260,6 +262,69 @@ TEST(RooNLLVar, IntegrateBins_RooDataHist) {
 }
 
 
+/// Check that the multi-threaded likelihood gives the same value as the serial one.
+TEST(RooNLLVar, NumThreads) {
+  RooRandom::randomGenerator()->SetSeed(1337ul);
+
+  RooRealVar x("x", "x", -10., 10.);
+  RooRealVar m("m", "m", 0.5, -5., 5.);
+  RooRealVar s("s", "s", 1.5, 0.1, 5.);
+  RooGenericPdf gauss("gauss", "std::exp(-0.5*std::pow((x-m)/s, 2))", RooArgSet(x, m, s));
+  RooGenericPdf flat("flat", "1", RooArgSet(x));
+  RooRealVar nsig("nsig", "nsig", 5000., 0., 20000.);
+  RooRealVar nbkg("nbkg", "nbkg", 2000., 0., 20000.);
+  RooAddPdf model("model", "model", RooArgList(gauss, flat), RooArgList(nsig, nbkg));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 7003));
+  x.setRange("sub", -3., 6.);
+
+  for (bool batchMode : {false, true}) {
+    for (const char* range : {static_cast<const char*>(nullptr), "sub"}) {
+      std::unique_ptr<RooAbsReal> nll( model.createNLL(*data, RooFit::Extended(), RooFit::BatchMode(batchMode),
+          range ? RooFit::Range(range) : RooCmdArg::none()) );
+      std::unique_ptr<RooAbsReal> nllThreads( model.createNLL(*data, RooFit::Extended(), RooFit::BatchMode(batchMode),
+          range ? RooFit::Range(range) : RooCmdArg::none(), RooFit::NumThreads(3)) );
+
+      for (double mVal : {0.5, -0.2, 1.3}) {
+        m.setVal(mVal);
+        EXPECT_NEAR(nll->getVal(), nllThreads->getVal(), 1.E-9 * std::abs(nll->getVal()))
+            << "batchMode=" << batchMode << " range=" << (range ? range : "none") << " m=" << mVal;
+      }
+    }
+  }
+
+  // With offsetting, the differences of the likelihood values are the same
+  m.setVal(0.5);
+  std::unique_ptr<RooAbsReal> nll( model.createNLL(*data, RooFit::Extended()) );
+  std::unique_ptr<RooAbsReal> nllThreads( model.createNLL(*data, RooFit::Extended(), RooFit::NumThreads(2),
+      RooFit::Offset(true)) );
+  const double ref0 = nll->getVal();
+  EXPECT_NEAR(ref0, nllThreads->getVal(), 1.E-9 * std::abs(ref0));
+  RooAbsReal::setHideOffset(false);
+  nllThreads->setValueDirty();
+  EXPECT_NEAR(nllThreads->getVal(), 0., 1.E-9);
+  m.setVal(0.7);
+  EXPECT_NEAR(nll->getVal() - ref0, nllThreads->getVal(), 1.E-6);
+  RooAbsReal::setHideOffset(true);
+
+  // The fit results are the same
+  m.setVal(0.);
+  s.setVal(1.);
+  std::unique_ptr<RooFitResult> fit1( model.fitTo(*data, RooFit::Extended(), RooFit::Save(), RooFit::PrintLevel(-1)) );
+  m.setVal(0.);
+  s.setVal(1.);
+  std::unique_ptr<RooFitResult> fit2( model.fitTo(*data, RooFit::Extended(), RooFit::Save(), RooFit::PrintLevel(-1),
+      RooFit::NumThreads(4)) );
+  EXPECT_EQ(fit1->status(), fit2->status());
+  EXPECT_NEAR(fit1->minNll(), fit2->minNll(), 1.E-6);
+  for (auto par : fit1->floatParsFinal()) {
+    auto& var1 = static_cast<RooRealVar&>(*par);
+    auto& var2 = static_cast<RooRealVar&>(*fit2->floatParsFinal().find(par->GetName()));
+    EXPECT_NEAR(var1.getVal(), var2.getVal(), 1.E-4 * var1.getError()) << var1.GetName();
+  }
+}
+
+
 TEST(RooChi2Var, IntegrateBins) {
   RooRandom::randomGenerator()->SetSeed(1337ul);
 
@@ -7,13 +7,18 @@
 #include "RooArgList.h"
 #include "RooRealVar.h"
 #include "RooAbsReal.h"
+#include "RooAddition.h"
 #include "RooStats/ModelConfig.h"
 
 #include "TFile.h"
+#include "TMemFile.h"
 #include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <memory>
+#include <string>
+
 using namespace RooStats;
 
 /// ROOT-9777, cloning a RooWorkspace. The ModelConfig did not get updated
@@ -231,3 +236,36 @@ TEST_F(TestRooWorkspaceWithGaussian, HashLookupInWorkspace) {
   EXPECT_FALSE(model_constrained_orig->dependsOn(*ws->var("mu2")));
   EXPECT_NE(ws->pdf("Gauss_editPdf_orig"), nullptr);
 }
+
+/// Writing a workspace temporarily removes the links to clients outside of the
+/// workspace. They must be restored after writing, also for large workspaces.
+TEST(RooWorkspace, WriteLargeWorkspaceWithExternalClients)
+{
+   RooWorkspace ws("ws");
+   RooArgList terms;
+   for (int i = 0; i < 2000; ++i) {
+      const std::string name = "c" + std::to_string(i);
+      ws.import(RooRealVar(name.c_str(), name.c_str(), i));
+      terms.add(*ws.var(name.c_str()));
+   }
+   ws.import(RooAddition("sum", "sum", terms));
+
+   // Client outside of the workspace
+   RooAddition external("external", "external", RooArgList(*ws.var("c0"), *ws.var("c1")));
+   ASSERT_TRUE(ws.var("c0")->clients().containsByPointer(&external));
+
+   TMemFile file("testWorkspaceLarge.root", "RECREATE");
+   ASSERT_GT(file.WriteObject(&ws, "ws"), 0);
+
+   EXPECT_TRUE(ws.var("c0")->clients().containsByPointer(&external));
+   EXPECT_TRUE(ws.var("c1")->valueClients().containsByPointer(&external));
+
+   RooWorkspace* wsRead = nullptr;
+   file.GetObject("ws", wsRead);
+   ASSERT_NE(wsRead, nullptr);
+   std::unique_ptr<RooWorkspace> wsReadOwned{wsRead};
+
+   ASSERT_NE(wsRead->function("sum"), nullptr);
+   EXPECT_DOUBLE_EQ(wsRead->function("sum")->getVal(), 1999. * 2000. / 2.);
+   EXPECT_EQ(wsRead->var("c0")->clients().size(), 1u);
+}
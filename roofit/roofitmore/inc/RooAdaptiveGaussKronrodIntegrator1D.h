@@ -20,6 +20,7 @@
 #include "RooNumIntConfig.h"
 
 double RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueFunction(double x, void *data) ;
+void RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueBatchFunction(const double *x, double *fx, size_t n, void *data) ;
 
 class RooAdaptiveGaussKronrodIntegrator1D : public RooAbsIntegrator {
 public:
@@ -68,6 +69,7 @@ protected:
   mutable DomainType _domainType ;
 
   friend double RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueFunction(double x, void *data) ;
+  friend void RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueBatchFunction(const double *x, double *fx, size_t n, void *data) ;
 
   Bool_t initialize();
 
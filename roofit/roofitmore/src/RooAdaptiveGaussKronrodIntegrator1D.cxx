@@ -68,6 +68,8 @@ ClassImp(RooAdaptiveGaussKronrodIntegrator1D);
 struct gsl_function_struct
 {
   double (* function) (double x, void * params);
+  // Optional: evaluate the function at n points in one call
+  void (* batch_function) (const double * x, double * fx, size_t n, void * params);
   void * params;
 };
 typedef struct gsl_function_struct gsl_function ;
@@ -327,6 +329,17 @@ double RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueFunction(double x, void *data
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Glue function interfacing to GSL code, which evaluates all points of a
+/// Gauss-Kronrod rule in one batch
+
+void RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueBatchFunction(const double *x, double *fx, size_t n, void *data) 
+{
+  RooAdaptiveGaussKronrodIntegrator1D* instance = (RooAdaptiveGaussKronrodIntegrator1D*) data ;
+  instance->integrand(RooSpan<const double>(x, n), instance->_x, RooSpan<double>(fx, n)) ;
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate and return integral at at given parameter values
@@ -345,6 +358,7 @@ Double_t RooAdaptiveGaussKronrodIntegrator1D::integral(const Double_t *yvec)
   // Setup glue function
   gsl_function F;
   F.function = &RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueFunction ;
+  F.batch_function = &RooAdaptiveGaussKronrodIntegrator1D_GSL_GlueBatchFunction ;
   F.params = this ;
 
   // Return values
@@ -489,6 +503,9 @@ enum
   };
 
 
+/* largest number of kronrod abscissae of a rule, used by the 61-point rule */
+#define GSL_QK_MAX_N 31
+
 void
 gsl_integration_qk (const int n, const double xgk[],
                     const double wg[], const double wgk[],
@@ -1033,17 +1050,51 @@ gsl_integration_qk (const int n,
   const double center = 0.5 * (a + b);
   const double half_length = 0.5 * (b - a);
   const double abs_half_length = fabs (half_length);
-  const double f_center = GSL_FN_EVAL (f, center);
+  double f_center;
 
   double result_gauss = 0;
-  double result_kronrod = f_center * wgk[n - 1];
+  double result_kronrod;
 
-  double result_abs = fabs (result_kronrod);
+  double result_abs;
   double result_asc = 0;
   double mean = 0, err = 0;
 
   int j;
 
+  /* evaluate the function at the centre and at all abscissae */
+
+  if (f->batch_function)
+    {
+      double x[2 * GSL_QK_MAX_N - 1], fx[2 * GSL_QK_MAX_N - 1];
+      x[0] = center;
+      for (j = 0; j < n - 1; j++)
+        {
+          const double abscissa = half_length * xgk[j];
+          x[2 * j + 1] = center - abscissa;
+          x[2 * j + 2] = center + abscissa;
+        }
+      (*(f->batch_function)) (x, fx, 2 * n - 1, f->params);
+      f_center = fx[0];
+      for (j = 0; j < n - 1; j++)
+        {
+          fv1[j] = fx[2 * j + 1];
+          fv2[j] = fx[2 * j + 2];
+        }
+    }
+  else
+    {
+      f_center = GSL_FN_EVAL (f, center);
+      for (j = 0; j < n - 1; j++)
+        {
+          const double abscissa = half_length * xgk[j];
+          fv1[j] = GSL_FN_EVAL (f, center - abscissa);
+          fv2[j] = GSL_FN_EVAL (f, center + abscissa);
+        }
+    }
+
+  result_kronrod = f_center * wgk[n - 1];
+  result_abs = fabs (result_kronrod);
+
   if (n % 2 == 0)
     {
       result_gauss = f_center * wg[n / 2 - 1];
@@ -1052,12 +1103,9 @@ gsl_integration_qk (const int n,
   for (j = 0; j < (n - 1) / 2; j++)
     {
       const int jtw = j * 2 + 1;        /* j=1,2,3 jtw=2,4,6 */
-      const double abscissa = half_length * xgk[jtw];
-      const double fval1 = GSL_FN_EVAL (f, center - abscissa);
-      const double fval2 = GSL_FN_EVAL (f, center + abscissa);
+      const double fval1 = fv1[jtw];
+      const double fval2 = fv2[jtw];
       const double fsum = fval1 + fval2;
-      fv1[jtw] = fval1;
-      fv2[jtw] = fval2;
       result_gauss += wg[j] * fsum;
       result_kronrod += wgk[jtw] * fsum;
       result_abs += wgk[jtw] * (fabs (fval1) + fabs (fval2));
@@ -1066,11 +1114,8 @@ gsl_integration_qk (const int n,
   for (j = 0; j < n / 2; j++)
     {
       int jtwm1 = j * 2;
-      const double abscissa = half_length * xgk[jtwm1];
-      const double fval1 = GSL_FN_EVAL (f, center - abscissa);
-      const double fval2 = GSL_FN_EVAL (f, center + abscissa);
-      fv1[jtwm1] = fval1;
-      fv2[jtwm1] = fval2;
+      const double fval1 = fv1[jtwm1];
+      const double fval2 = fv2[jtwm1];
       result_kronrod += wgk[jtwm1] * (fval1 + fval2);
       result_abs += wgk[jtwm1] * (fabs (fval1) + fabs (fval2));
     };
@@ -2009,6 +2054,7 @@ gsl_integration_qags (const gsl_function *f,
    */
 
 static double i_transform (double t, void *params);
+static void i_transform_batch (const double * t, double * ft, size_t n, void *params);
 
 int
 gsl_integration_qagi (gsl_function * f,
@@ -2021,6 +2067,7 @@ gsl_integration_qagi (gsl_function * f,
   gsl_function f_transform;
 
   f_transform.function = &i_transform;
+  f_transform.batch_function = f->batch_function ? &i_transform_batch : 0;
   f_transform.params = f;
 
   status = qags (&f_transform, 0.0, 1.0, 
@@ -2041,6 +2088,24 @@ i_transform (double t, void *params)
   return (y / t) / t;
 }
 
+static void
+i_transform_batch (const double * t, double * ft, size_t n, void *params)
+{
+  gsl_function *f = (gsl_function *) params;
+  double x[4 * GSL_QK_MAX_N - 2], fx[4 * GSL_QK_MAX_N - 2];
+  size_t i;
+  for (i = 0; i < n; i++)
+    {
+      x[i] = (1 - t[i]) / t[i];
+      x[n + i] = -x[i];
+    }
+  (*(f->batch_function)) (x, fx, 2 * n, f->params);
+  for (i = 0; i < n; i++)
+    {
+      ft[i] = ((fx[i] + fx[n + i]) / t[i]) / t[i];
+    }
+}
+
 
 /* QAGIL: Evaluate an integral over an infinite range using the
    transformation,
@@ -2052,6 +2117,7 @@ i_transform (double t, void *params)
 struct il_params { double b ; gsl_function * f ; } ;
 
 static double il_transform (double t, void *params);
+static void il_transform_batch (const double * t, double * ft, size_t n, void *params);
 
 int
 gsl_integration_qagil (gsl_function * f,
@@ -2069,6 +2135,7 @@ gsl_integration_qagil (gsl_function * f,
   transform_params.f = f ;
 
   f_transform.function = &il_transform;
+  f_transform.batch_function = f->batch_function ? &il_transform_batch : 0;
   f_transform.params = &transform_params;
 
   status = qags (&f_transform, 0.0, 1.0, 
@@ -2091,6 +2158,25 @@ il_transform (double t, void *params)
   return (y / t) / t;
 }
 
+static void
+il_transform_batch (const double * t, double * ft, size_t n, void *params)
+{
+  struct il_params *p = (struct il_params *) params;
+  double b = p->b;
+  gsl_function * f = p->f;
+  double x[2 * GSL_QK_MAX_N - 1];
+  size_t i;
+  for (i = 0; i < n; i++)
+    {
+      x[i] = b - (1 - t[i]) / t[i];
+    }
+  (*(f->batch_function)) (x, ft, n, f->params);
+  for (i = 0; i < n; i++)
+    {
+      ft[i] = (ft[i] / t[i]) / t[i];
+    }
+}
+
 /* QAGIU: Evaluate an integral over an infinite range using the
    transformation
 
@@ -2101,6 +2187,7 @@ il_transform (double t, void *params)
 struct iu_params { double a ; gsl_function * f ; } ;
 
 static double iu_transform (double t, void *params);
+static void iu_transform_batch (const double * t, double * ft, size_t n, void *params);
 
 int
 gsl_integration_qagiu (gsl_function * f,
@@ -2118,6 +2205,7 @@ gsl_integration_qagiu (gsl_function * f,
   transform_params.f = f ;
 
   f_transform.function = &iu_transform;
+  f_transform.batch_function = f->batch_function ? &iu_transform_batch : 0;
   f_transform.params = &transform_params;
 
   status = qags (&f_transform, 0.0, 1.0, 
@@ -2140,6 +2228,25 @@ iu_transform (double t, void *params)
   return (y / t) / t;
 }
 
+static void
+iu_transform_batch (const double * t, double * ft, size_t n, void *params)
+{
+  struct iu_params *p = (struct iu_params *) params;
+  double a = p->a;
+  gsl_function * f = p->f;
+  double x[2 * GSL_QK_MAX_N - 1];
+  size_t i;
+  for (i = 0; i < n; i++)
+    {
+      x[i] = a + (1 - t[i]) / t[i];
+    }
+  (*(f->batch_function)) (x, ft, n, f->params);
+  for (i = 0; i < n; i++)
+    {
+      ft[i] = (ft[i] / t[i]) / t[i];
+    }
+}
+
 /* Main integration function */
 
 static int
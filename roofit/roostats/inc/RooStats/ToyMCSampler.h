@@ -25,6 +25,7 @@
 #include "RooRealVar.h"
 #include "RooDataSet.h"
 
+#include <algorithm>
 #include <vector>
 #include <list>
 #include <string>
@@ -80,6 +81,7 @@ class ToyMCSampler: public TestStatSampler {
       virtual SamplingDistribution* GetSamplingDistribution(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributions(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributionsSingleWorker(RooArgSet& paramPoint);
+      virtual RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
 
       virtual SamplingDistribution* AppendSamplingDistribution(
          RooArgSet& allParameters,
@@ -227,6 +229,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // Generate and evaluate the toys in this number of forked processes on the local machine.
+      // Ignored if a ProofConfig is set.
+      void SetNWorkers(unsigned int nWorkers) { fNWorkers = std::max(nWorkers, 1u); }
+      unsigned int GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -272,6 +279,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
 
       ProofConfig *fProofConfig;   //!
+      unsigned int fNWorkers;   //! number of worker processes of local parallel runs
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
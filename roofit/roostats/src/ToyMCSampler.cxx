@@ -24,7 +24,11 @@ ToyMCSampler is an implementation of the TestStatSampler interface.
 It generates Toy Monte Carlo for a given parameter point and evaluates a
 TestStatistic.
 
-For parallel runs, ToyMCSampler can be given an instance of ProofConfig
+For parallel runs on the local machine, use SetNWorkers(). The toys are then
+split between forked worker processes, each with its own copy of the models
+and its own seed of the random generator, and the results are merged.
+
+For parallel runs, ToyMCSampler can also be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
 */
@@ -50,6 +54,13 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#ifndef _MSC_VER
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+
 
 using namespace RooFit;
 using namespace std;
@@ -172,6 +183,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
    fNuisanceParametersSampler = NULL;
 
    //suppress messages for num integration of Roofit
@@ -205,6 +217,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
    fNuisanceParametersSampler = NULL;
 
    //suppress messages for num integration of Roofit
@@ -310,8 +323,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if (fNWorkers > 1 && fNToys > 1)
+         return GetSamplingDistributionsMultiProcess(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
@@ -353,6 +369,72 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and evaluate the toys in fNWorkers forked processes, see SetNWorkers().
+/// Each worker runs GetSamplingDistributionsSingleWorker() on its share of the toys,
+/// with a seed drawn from RooRandom::randomGenerator() in the parent process, such
+/// that the random streams of the workers are independent and the results reproducible.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef _MSC_VER
+   oocoutW((TObject*)NULL, InputArguments)
+      << "ToyMCSampler: worker processes are not supported on Windows. Generating the toys serially."
+      << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#else
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   const Int_t totToys = fNToys;
+   const unsigned int nWorkers = std::min(fNWorkers, static_cast<unsigned int>(totToys));
+   std::vector<UInt_t> seeds(nWorkers);
+   for (auto& seed : seeds) {
+      // The seed 0 would make TRandom3 pick a random seed
+      seed = 1 + RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max() - 1);
+   }
+
+   // Runs in a forked copy of this process, which owns its copy of the models
+   auto work = [&](unsigned int iWorker) {
+      RooRandom::randomGenerator()->SetSeed(seeds[iWorker]);
+      fNToys = totToys / nWorkers + (iWorker < totToys % nWorkers ? 1 : 0);
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   };
+   ROOT::TProcessExecutor workers(nWorkers);
+   std::vector<RooDataSet*> results = workers.Map(work, ROOT::TSeqU(nWorkers));
+
+   RooDataSet* output = nullptr;
+   for (RooDataSet* result : results) {
+      if (!result) continue;
+      if (!output) {
+         output = result;
+      } else {
+         output->append(*result);
+         delete result;
+      }
+   }
+   if (!output || output->numEntries() != totToys) {
+      oocoutW((TObject*)NULL, Generation)
+         << "ToyMCSampler: the workers returned " << (output ? output->numEntries() : 0) << " of "
+         << totToys << " toys." << endl;
+   }
+
+   return output;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -0,0 +1,45 @@
+// Tests for the ToyMCSampler
+
+#include "RooStats/ToyMCSampler.h"
+#include "RooStats/ProfileLikelihoodTestStat.h"
+#include "RooStats/SamplingDistribution.h"
+
+#include "RooGaussian.h"
+#include "RooRandom.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+
+/// The toys generated by worker processes must all be merged into the sampling distribution.
+TEST(ToyMCSampler, MultiProcess)
+{
+   RooRealVar x("x", "x", -10, 10);
+   RooRealVar mean("mean", "mean", 0., -5, 5);
+   RooRealVar sigma("sigma", "sigma", 1.);
+   RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+
+   RooStats::ProfileLikelihoodTestStat testStat(gauss);
+   RooStats::ToyMCSampler sampler(testStat, 30);
+   sampler.SetPdf(gauss);
+   RooArgSet observables(x);
+   sampler.SetObservables(observables);
+   sampler.SetParametersForTestStat(RooArgSet(mean));
+   sampler.SetNEventsPerToy(50);
+   sampler.SetNWorkers(3);
+   EXPECT_EQ(sampler.GetNWorkers(), 3u);
+
+   RooRandom::randomGenerator()->SetSeed(1234);
+   RooArgSet paramPoint(mean);
+   std::unique_ptr<RooStats::SamplingDistribution> samplingDist{sampler.GetSamplingDistribution(paramPoint)};
+   ASSERT_NE(samplingDist, nullptr);
+
+   const auto& values = samplingDist->GetSamplingDistribution();
+   ASSERT_EQ(values.size(), 30u);
+   for (double value : values) {
+      EXPECT_TRUE(std::isfinite(value));
+      EXPECT_GE(value, -1.e-6);
+   }
+}
@@ -0,0 +1,444 @@
+// @(#)root/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Write and read throughput of TTree and RNTuple
+//
+// Every combination of the selected formats, schemas, compression
+// settings and numbers of IMT threads writes a file of synthetic events
+// and reads it back. The schemas mimic the layout of typical HEP data:
+//
+//   flat   10 float and 10 int scalars
+//   lhcb   20 double and 6 int scalars, like the LHCb B2HHH open data
+//   h1     50 float and 20 int scalars and one track collection, like H1
+//   cms    10 scalars and 4 collections of 6 floats, like CMS NanoAOD
+//
+// The values are drawn from a fixed seed, so that runs on different
+// machines or ROOT versions write the same data. The results are written
+// in the JSON format of Google Benchmark, so that they can be compared
+// between releases with its tools/compare.py.
+//
+// Usage:
+//   stressIOThroughput [-format ttree,rntuple] [-schema flat,lhcb,h1,cms]
+//                      [-comp 0,101,404,505] [-threads 0,4]
+//                      [-entries 200000] [-repetitions 3] [-dir /tmp]
+//                      [-url root://host//path/] [-json results.json] [-keep]
+//
+// With -url, the files are not written but read from the given prefix,
+// e.g. from a local run done with -keep whose directory is exported with
+// XRootD or HTTP. The reads see the page cache of the operating system,
+// drop it between runs measuring cold reads.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TDatime.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+#include <ROOT/RRawFile.hxx>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleReader;
+using ROOT::Experimental::RNTupleWriteOptions;
+using ROOT::Experimental::RNTupleWriter;
+
+namespace {
+
+struct RSchema {
+   const char *fName;
+   int fNFloat;
+   int fNInt;
+   int fNDouble;
+   int fNCollections;
+   int fNCollectionVars;
+   double fMeanMultiplicity;
+};
+
+const RSchema kSchemas[] = {
+   {"flat", 10, 10, 0, 0, 0, 0.},
+   {"lhcb", 0, 6, 20, 0, 0, 0.},
+   {"h1", 50, 20, 0, 1, 4, 10.},
+   {"cms", 5, 5, 0, 4, 6, 5.},
+};
+
+/// Values of one event, shared by the TTree branches and the RNTuple fields
+struct REvent {
+   std::vector<float> fFloats;
+   std::vector<int> fInts;
+   std::vector<double> fDoubles;
+   std::vector<std::vector<float>> fCollections; ///< fNCollections * fNCollectionVars vectors
+
+   explicit REvent(const RSchema &s)
+      : fFloats(s.fNFloat), fInts(s.fNInt), fDoubles(s.fNDouble), fCollections(s.fNCollections * s.fNCollectionVars)
+   {
+   }
+
+   void Generate(const RSchema &s, TRandom &rnd)
+   {
+      for (auto &v : fFloats)
+         v = rnd.Gaus(0, 10);
+      for (auto &v : fInts)
+         v = rnd.Poisson(20);
+      for (auto &v : fDoubles)
+         v = rnd.Exp(1000);
+      for (int c = 0; c < s.fNCollections; ++c) {
+         const int n = rnd.Poisson(s.fMeanMultiplicity);
+         for (int i = 0; i < s.fNCollectionVars; ++i) {
+            auto &vec = fCollections[c * s.fNCollectionVars + i];
+            vec.resize(n);
+            for (auto &v : vec)
+               v = rnd.Landau(20, 5);
+         }
+      }
+   }
+};
+
+std::string VarName(const char *kind, int i)
+{
+   return TString::Format("%s%d", kind, i).Data();
+}
+
+std::string CollectionName(const RSchema &s, int k)
+{
+   return TString::Format("coll%d_var%d", k / s.fNCollectionVars, k % s.fNCollectionVars).Data();
+}
+
+struct RConfig {
+   std::vector<std::string> fFormats{"ttree", "rntuple"};
+   std::vector<std::string> fSchemas{"flat", "lhcb", "h1", "cms"};
+   std::vector<int> fCompressions{0, 101, 404, 505};
+   std::vector<int> fThreads{0};
+   Long64_t fEntries = 200000;
+   int fRepetitions = 3;
+   std::string fDir;
+   std::string fUrl;
+   std::string fJson;
+   bool fKeep = false;
+};
+
+/// Result of one write or read, the fields of a Google Benchmark run
+struct RResult {
+   std::string fName;
+   int fRepetition = 0;
+   double fRealTime = 0; ///< seconds
+   double fCpuTime = 0;  ///< seconds, all threads
+   Long64_t fEntries = 0;
+   Long64_t fFileSize = 0;
+};
+
+std::vector<std::string> SplitList(const char *arg)
+{
+   std::vector<std::string> items;
+   TString list(arg);
+   auto tokens = list.Tokenize(",");
+   for (auto token : *tokens)
+      items.emplace_back(static_cast<TObjString *>(token)->GetString().Data());
+   delete tokens;
+   return items;
+}
+
+Long64_t GetFileSize(const std::string &path)
+{
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(path.c_str(), stat) == 0)
+      return stat.fSize;
+   // Remote file
+   return ROOT::Internal::RRawFile::Create(path)->GetSize();
+}
+
+//------------------------------------------------------------------------------
+
+void WriteTTree(const RSchema &s, int compression, Long64_t nEntries, const std::string &path)
+{
+   std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "RECREATE", "", compression));
+   if (!file || file->IsZombie())
+      throw std::runtime_error("cannot create " + path);
+   auto tree = new TTree("Events", "stressIOThroughput");
+   REvent event(s);
+   for (int i = 0; i < s.fNFloat; ++i)
+      tree->Branch(VarName("f", i).c_str(), &event.fFloats[i], (VarName("f", i) + "/F").c_str());
+   for (int i = 0; i < s.fNInt; ++i)
+      tree->Branch(VarName("i", i).c_str(), &event.fInts[i], (VarName("i", i) + "/I").c_str());
+   for (int i = 0; i < s.fNDouble; ++i)
+      tree->Branch(VarName("d", i).c_str(), &event.fDoubles[i], (VarName("d", i) + "/D").c_str());
+   std::vector<std::vector<float> *> collections;
+   for (auto &vec : event.fCollections)
+      collections.push_back(&vec);
+   for (std::size_t k = 0; k < collections.size(); ++k)
+      tree->Branch(CollectionName(s, k).c_str(), &collections[k]);
+
+   TRandom3 rnd(4357);
+   for (Long64_t n = 0; n < nEntries; ++n) {
+      event.Generate(s, rnd);
+      tree->Fill();
+   }
+   file->Write();
+}
+
+void ReadTTree(const RSchema &s, const std::string &path, Long64_t &nEntries)
+{
+   std::unique_ptr<TFile> file(TFile::Open(path.c_str()));
+   if (!file || file->IsZombie())
+      throw std::runtime_error("cannot open " + path);
+   auto tree = file->Get<TTree>("Events");
+   REvent event(s);
+   for (int i = 0; i < s.fNFloat; ++i)
+      tree->SetBranchAddress(VarName("f", i).c_str(), &event.fFloats[i]);
+   for (int i = 0; i < s.fNInt; ++i)
+      tree->SetBranchAddress(VarName("i", i).c_str(), &event.fInts[i]);
+   for (int i = 0; i < s.fNDouble; ++i)
+      tree->SetBranchAddress(VarName("d", i).c_str(), &event.fDoubles[i]);
+   std::vector<std::vector<float> *> collections(event.fCollections.size(), nullptr);
+   for (std::size_t k = 0; k < collections.size(); ++k)
+      tree->SetBranchAddress(CollectionName(s, k).c_str(), &collections[k]);
+
+   nEntries = tree->GetEntries();
+   for (Long64_t n = 0; n < nEntries; ++n)
+      tree->GetEntry(n);
+   for (auto vec : collections)
+      delete vec;
+}
+
+void WriteRNTuple(const RSchema &s, int compression, Long64_t nEntries, const std::string &path)
+{
+   auto model = RNTupleModel::Create();
+   std::vector<std::shared_ptr<float>> floats;
+   std::vector<std::shared_ptr<int>> ints;
+   std::vector<std::shared_ptr<double>> doubles;
+   std::vector<std::shared_ptr<std::vector<float>>> collections;
+   for (int i = 0; i < s.fNFloat; ++i)
+      floats.emplace_back(model->MakeField<float>(VarName("f", i)));
+   for (int i = 0; i < s.fNInt; ++i)
+      ints.emplace_back(model->MakeField<int>(VarName("i", i)));
+   for (int i = 0; i < s.fNDouble; ++i)
+      doubles.emplace_back(model->MakeField<double>(VarName("d", i)));
+   for (int k = 0; k < s.fNCollections * s.fNCollectionVars; ++k)
+      collections.emplace_back(model->MakeField<std::vector<float>>(CollectionName(s, k)));
+
+   RNTupleWriteOptions options;
+   options.SetCompression(compression);
+   auto writer = RNTupleWriter::Recreate(std::move(model), "Events", path, options);
+
+   REvent event(s);
+   TRandom3 rnd(4357);
+   for (Long64_t n = 0; n < nEntries; ++n) {
+      event.Generate(s, rnd);
+      for (int i = 0; i < s.fNFloat; ++i)
+         *floats[i] = event.fFloats[i];
+      for (int i = 0; i < s.fNInt; ++i)
+         *ints[i] = event.fInts[i];
+      for (int i = 0; i < s.fNDouble; ++i)
+         *doubles[i] = event.fDoubles[i];
+      for (std::size_t k = 0; k < collections.size(); ++k)
+         std::swap(*collections[k], event.fCollections[k]);
+      writer->Fill();
+   }
+}
+
+void ReadRNTuple(const std::string &path, Long64_t &nEntries)
+{
+   auto reader = RNTupleReader::Open("Events", path);
+   nEntries = reader->GetNEntries();
+   for (Long64_t n = 0; n < nEntries; ++n)
+      reader->LoadEntry(n);
+}
+
+//------------------------------------------------------------------------------
+
+void PrintResult(const RResult &r)
+{
+   printf("%-48s rep %d  %8.3f s real  %8.3f s cpu  %8.1f MB/s  %10.0f entries/s\n", r.fName.c_str(), r.fRepetition,
+          r.fRealTime, r.fCpuTime, r.fFileSize / r.fRealTime / 1e6, r.fEntries / r.fRealTime);
+}
+
+void WriteJson(const RConfig &config, const std::vector<RResult> &results, const char *argv0)
+{
+   FILE *out = fopen(config.fJson.c_str(), "w");
+   if (!out) {
+      fprintf(stderr, "cannot write %s\n", config.fJson.c_str());
+      return;
+   }
+   TDatime now;
+   fprintf(out, "{\n  \"context\": {\n");
+   fprintf(out, "    \"date\": \"%s\",\n", now.AsSQLString());
+   fprintf(out, "    \"host_name\": \"%s\",\n", gSystem->HostName());
+   fprintf(out, "    \"executable\": \"%s\",\n", argv0);
+   fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+   fprintf(out, "    \"root_version\": \"%s\",\n", gROOT->GetVersion());
+   fprintf(out, "    \"root_git_commit\": \"%s\",\n", gROOT->GetGitCommit());
+   fprintf(out, "    \"entries\": %lld,\n", config.fEntries);
+   fprintf(out, "    \"library_build_type\": \"release\"\n  },\n");
+   fprintf(out, "  \"benchmarks\": [");
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      const auto &r = results[i];
+      fprintf(out, "%s\n    {\n", i ? "," : "");
+      fprintf(out, "      \"name\": \"%s\",\n", r.fName.c_str());
+      fprintf(out, "      \"run_name\": \"%s\",\n", r.fName.c_str());
+      fprintf(out, "      \"run_type\": \"iteration\",\n");
+      fprintf(out, "      \"repetitions\": %d,\n", config.fRepetitions);
+      fprintf(out, "      \"repetition_index\": %d,\n", r.fRepetition);
+      fprintf(out, "      \"threads\": 1,\n");
+      fprintf(out, "      \"iterations\": 1,\n");
+      fprintf(out, "      \"real_time\": %.6e,\n", r.fRealTime * 1e3);
+      fprintf(out, "      \"cpu_time\": %.6e,\n", r.fCpuTime * 1e3);
+      fprintf(out, "      \"time_unit\": \"ms\",\n");
+      fprintf(out, "      \"bytes_per_second\": %.6e,\n", r.fFileSize / r.fRealTime);
+      fprintf(out, "      \"items_per_second\": %.6e,\n", r.fEntries / r.fRealTime);
+      fprintf(out, "      \"file_size\": %lld\n", r.fFileSize);
+      fprintf(out, "    }");
+   }
+   fprintf(out, "\n  ]\n}\n");
+   fclose(out);
+}
+
+void Usage(const char *argv0)
+{
+   printf("Usage: %s [-format ttree,rntuple] [-schema flat,lhcb,h1,cms] [-comp 0,101,404,505]\n"
+          "          [-threads 0,4] [-entries N] [-repetitions N] [-dir path] [-url prefix]\n"
+          "          [-json file] [-keep]\n",
+          argv0);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   RConfig config;
+   config.fDir = gSystem->TempDirectory();
+   for (int i = 1; i < argc; ++i) {
+      const bool hasValue = i + 1 < argc;
+      if (!strcmp(argv[i], "-keep")) {
+         config.fKeep = true;
+      } else if (!hasValue) {
+         Usage(argv[0]);
+         return 1;
+      } else if (!strcmp(argv[i], "-format")) {
+         config.fFormats = SplitList(argv[++i]);
+      } else if (!strcmp(argv[i], "-schema")) {
+         config.fSchemas = SplitList(argv[++i]);
+      } else if (!strcmp(argv[i], "-comp")) {
+         config.fCompressions.clear();
+         for (auto &c : SplitList(argv[++i]))
+            config.fCompressions.push_back(std::atoi(c.c_str()));
+      } else if (!strcmp(argv[i], "-threads")) {
+         config.fThreads.clear();
+         for (auto &t : SplitList(argv[++i]))
+            config.fThreads.push_back(std::atoi(t.c_str()));
+      } else if (!strcmp(argv[i], "-entries")) {
+         config.fEntries = std::atoll(argv[++i]);
+      } else if (!strcmp(argv[i], "-repetitions")) {
+         config.fRepetitions = std::atoi(argv[++i]);
+      } else if (!strcmp(argv[i], "-dir")) {
+         config.fDir = argv[++i];
+      } else if (!strcmp(argv[i], "-url")) {
+         config.fUrl = argv[++i];
+      } else if (!strcmp(argv[i], "-json")) {
+         config.fJson = argv[++i];
+      } else {
+         Usage(argv[0]);
+         return 1;
+      }
+   }
+
+   std::vector<RResult> results;
+   int nFailed = 0;
+   for (const auto &format : config.fFormats) {
+      const bool isTTree = (format == "ttree");
+      if (!isTTree && format != "rntuple") {
+         fprintf(stderr, "unknown format %s\n", format.c_str());
+         return 1;
+      }
+      for (const auto &schemaName : config.fSchemas) {
+         const RSchema *schema = nullptr;
+         for (const auto &s : kSchemas)
+            if (schemaName == s.fName)
+               schema = &s;
+         if (!schema) {
+            fprintf(stderr, "unknown schema %s\n", schemaName.c_str());
+            return 1;
+         }
+         for (auto compression : config.fCompressions) {
+            const std::string fileName =
+               TString::Format("stressIOThroughput_%s_%s_%d.root", format.c_str(), schema->fName, compression).Data();
+            const std::string localPath = config.fDir + "/" + fileName;
+            const std::string readPath = config.fUrl.empty() ? localPath : config.fUrl + fileName;
+
+            for (auto nThreads : config.fThreads) {
+               if (nThreads > 0)
+                  ROOT::EnableImplicitMT(nThreads);
+               const std::string suffix =
+                  TString::Format("/%s/comp:%d/threads:%d", schema->fName, compression, nThreads).Data();
+
+               for (int rep = 0; rep < config.fRepetitions; ++rep) {
+                  TStopwatch timer;
+                  try {
+                     if (config.fUrl.empty()) {
+                        timer.Start();
+                        if (isTTree)
+                           WriteTTree(*schema, compression, config.fEntries, localPath);
+                        else
+                           WriteRNTuple(*schema, compression, config.fEntries, localPath);
+                        timer.Stop();
+                        RResult w{format + "/Write" + suffix, rep, timer.RealTime(), timer.CpuTime(),
+                                  config.fEntries, GetFileSize(localPath)};
+                        PrintResult(w);
+                        results.emplace_back(w);
+                     }
+
+                     Long64_t nEntries = 0;
+                     timer.Start();
+                     if (isTTree)
+                        ReadTTree(*schema, readPath, nEntries);
+                     else
+                        ReadRNTuple(readPath, nEntries);
+                     timer.Stop();
+                     RResult r{format + "/Read" + suffix, rep, timer.RealTime(), timer.CpuTime(), nEntries,
+                               GetFileSize(readPath)};
+                     PrintResult(r);
+                     results.emplace_back(r);
+                  } catch (const std::exception &e) {
+                     fprintf(stderr, "%s%s FAILED: %s\n", format.c_str(), suffix.c_str(), e.what());
+                     ++nFailed;
+                  }
+               }
+
+               if (nThreads > 0)
+                  ROOT::DisableImplicitMT();
+            }
+            if (config.fUrl.empty() && !config.fKeep)
+               gSystem->Unlink(localPath.c_str());
+         }
+      }
+   }
+
+   if (!config.fJson.empty())
+      WriteJson(config, results, argv[0]);
+   return nFailed ? 1 : 0;
+}
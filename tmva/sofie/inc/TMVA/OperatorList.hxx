@@ -1,3 +1,11 @@
 #include "TMVA/ROperator_Transpose.hxx"
 #include "TMVA/ROperator_Gemm.hxx"
 #include "TMVA/ROperator_Relu.hxx"
+#include "TMVA/ROperator_Sigmoid.hxx"
+#include "TMVA/ROperator_Tanh.hxx"
+#include "TMVA/ROperator_Softmax.hxx"
+#include "TMVA/ROperator_Conv.hxx"
+#include "TMVA/ROperator_BatchNormalization.hxx"
+#include "TMVA/ROperator_BasicBinary.hxx"
+#include "TMVA/ROperator_Concat.hxx"
+#include "TMVA/ROperator_Reshape.hxx"
@@ -38,7 +38,7 @@ private:
    std::string fGC; //generated code
    bool fNeedGemm = true;
 
-   const std::vector<std::string> fAllowedStdLib = {"algorithm"};
+   const std::vector<std::string> fAllowedStdLib = {"algorithm", "cmath"};
    std::set<std::string> fNeededStdLib = {"vector"};
 
 
@@ -61,6 +61,7 @@ public:
    const ETensorType& GetTensorType(std::string name);
 
    bool CheckIfTensorAlreadyExist(std::string tensor_name);
+   bool IsInitializedTensor(std::string tensor_name);
    void AddInputTensorInfo(std::string input_name, ETensorType type, std::vector<Dim> shape);
    void AddInputTensorInfo(std::string input_name, ETensorType type, std::vector<size_t> shape);
    void AddOperator(std::unique_ptr<ROperator> op, int order_execution = -1);
@@ -76,8 +77,10 @@ public:
    std::shared_ptr<void> GetInitializedTensorData(std::string tensor_name);
 
 
+   void FuseOperators();
    void Initialize();
-   void Generate();
+   // batchSize > 0 replaces the first dimension of the input tensors, and their parametric dimensions
+   void Generate(int batchSize = -1);
 
    void PrintGenerated(){
       std::cout << fGC;
@@ -25,6 +25,18 @@ public:
    virtual std::string Generate(std::string OpName) = 0;  //expect unique opname for each operator within the same RModel
    virtual std::string Header() { return "";}
 
+   // hooks used by RModel to fuse operators before they are initialized
+   virtual std::vector<std::string> GetInputTensorNames() { return {}; }
+   virtual std::vector<std::string> GetOutputTensorNames() { return {}; }
+   // elementwise activation computed by this operator, if it is one
+   virtual EActivationType GetActivationType() { return EActivationType::UNDEFINED; }
+   // per-channel scale and shift computed by this operator, if it is one and its parameters are initialized tensors
+   virtual bool GetChannelScaleShift(RModel&, std::vector<float>& /*scale*/, std::vector<float>& /*shift*/) { return false; }
+   // apply an activation to the output, which is renamed; return false if not supported
+   virtual bool FuseActivation(EActivationType, std::string /*nameY*/) { return false; }
+   // multiply the output channels by scale and add shift, by updating the weights; return false if not supported
+   virtual bool FuseChannelScaleShift(RModel&, const std::vector<float>& /*scale*/, const std::vector<float>& /*shift*/, std::string /*nameY*/) { return false; }
+
 
    //virtual void Forward_reference() = 0;
    //irtual void Forward_blas() = 0;
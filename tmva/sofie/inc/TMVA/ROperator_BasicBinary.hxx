@@ -0,0 +1,134 @@
+#ifndef TMVA_SOFIE_ROPERATOR_BASICBINARY
+#define TMVA_SOFIE_ROPERATOR_BASICBINARY
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+enum EBasicBinaryOperator { Add, Sub, Mul, Div };
+
+template <typename T, EBasicBinaryOperator Op>
+struct BinaryOperatorTrait {};
+
+template <typename T>
+struct BinaryOperatorTrait<T, Add> {
+   static const std::string Name() { return "Add"; }
+   static std::string Op(const std::string& t1, const std::string t2) { return t1 + " + " + t2; }
+};
+
+template <typename T>
+struct BinaryOperatorTrait<T, Sub> {
+   static const std::string Name() { return "Sub"; }
+   static std::string Op(const std::string& t1, const std::string t2) { return t1 + " - " + t2; }
+};
+
+template <typename T>
+struct BinaryOperatorTrait<T, Mul> {
+   static const std::string Name() { return "Mul"; }
+   static std::string Op(const std::string& t1, const std::string t2) { return t1 + " * " + t2; }
+};
+
+template <typename T>
+struct BinaryOperatorTrait<T, Div> {
+   static const std::string Name() { return "Div"; }
+   static std::string Op(const std::string& t1, const std::string t2) { return t1 + " / " + t2; }
+};
+
+// Elementwise binary operator. Inputs of different shapes are supported if the smaller one is an
+// initialized tensor, which is broadcast to the shape of the output when the model is initialized.
+template <typename T, EBasicBinaryOperator Op>
+class ROperator_BasicBinary final : public ROperator
+{
+
+private:
+
+   std::string fNA;
+   std::string fNB;
+   std::string fNY;
+   std::vector<size_t> fShapeY;
+
+public:
+   ROperator_BasicBinary() = delete;
+   ROperator_BasicBinary(std::string nameA, std::string nameB, std::string nameY):
+      fNA(UTILITY::Clean_name(nameA)), fNB(UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY)){
+      if (!std::is_same<T, float>::value){
+         throw std::runtime_error("TMVA SOFIE Encountered unsupported type parsing a " + BinaryOperatorTrait<T, Op>::Name() + " operator");
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   // multidirectional broadcasting of the two input shapes
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto& a = input[0];
+      auto& b = input[1];
+      const size_t rank = std::max(a.size(), b.size());
+      std::vector<size_t> y(rank);
+      for (size_t i = 0; i < rank; i++){
+         const size_t da = (i + a.size() >= rank) ? a[i + a.size() - rank] : 1;
+         const size_t db = (i + b.size() >= rank) ? b[i + b.size() - rank] : 1;
+         if (da != db && da != 1 && db != 1){
+            throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op cannot broadcast the shapes of its inputs");
+         }
+         y[i] = std::max(da, db);
+      }
+      return {y};
+   }
+
+   std::vector<std::string> GetInputTensorNames(){ return {fNA, fNB}; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (!model.CheckIfTensorAlreadyExist(fNA) || !model.CheckIfTensorAlreadyExist(fNB)){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op Input Tensor " + fNA + " or " + fNB + " is not found in model");
+      }
+      auto shapeA = model.GetTensorShape(fNA);
+      auto shapeB = model.GetTensorShape(fNB);
+      fShapeY = ShapeInference({shapeA, shapeB})[0];
+      BroadcastInput(model, fNA, shapeA);
+      BroadcastInput(model, fNB, shapeB);
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNA), fShapeY);
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeY.empty()){
+         throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op called to Generate without being initialized first");
+      }
+      std::stringstream out;
+      out << "\t" << "for (int id = 0; id < " << ConvertShapeToLength(fShapeY) << " ; id++){\n";
+      out << "\t\t" << "tensor_" << fNY << "[id] = " << BinaryOperatorTrait<T, Op>::Op("tensor_" + fNA + "[id]", "tensor_" + fNB + "[id]") << ";\n";
+      out << "\t}\n";
+      return out.str();
+   }
+
+private:
+   // replace an input by a copy broadcast to the output shape
+   void BroadcastInput(RModel& model, std::string& name, const std::vector<size_t>& shape){
+      if (shape == fShapeY) return;
+      if (!model.IsInitializedTensor(name)){
+         throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op supports broadcasting only for initialized tensors, not for " + name);
+      }
+      const T* data = static_cast<T*>(model.GetInitializedTensorData(name).get());
+      std::shared_ptr<void> broadcastData(UTILITY::Unidirectional_broadcast<T>(data, shape, fShapeY), std::default_delete<T[]>());
+      const ETensorType type = model.GetTensorType(name);
+      name = fNY + name + "broadcast";
+      model.AddInitializedTensor(name, type, fShapeY, broadcastData);
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_BASICBINARY
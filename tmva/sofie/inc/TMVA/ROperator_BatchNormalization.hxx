@@ -0,0 +1,137 @@
+#ifndef TMVA_SOFIE_ROPERATOR_BATCHNORMALIZATION
+#define TMVA_SOFIE_ROPERATOR_BATCHNORMALIZATION
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <cmath>
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+// Batch normalization in inference mode: Y = (X - mean) / sqrt(var + epsilon) * scale + B, along the channel axis 1.
+// The parameters must be initialized tensors; they are combined into one scale and one shift per channel.
+// RModel folds this operator into the weights of a preceding Conv or Gemm.
+template <typename T>
+class ROperator_BatchNormalization final : public ROperator
+{
+
+private:
+
+   float fAttrEpsilon = 1e-5;
+
+   std::string fNX;
+   std::string fNScale;
+   std::string fNB;
+   std::string fNMean;
+   std::string fNVar;
+   std::string fNY;
+   std::vector<size_t> fShape;
+
+   std::string fNChannelScale;
+   std::string fNChannelShift;
+
+public:
+   ROperator_BatchNormalization() = delete;
+   ROperator_BatchNormalization(float epsilon, std::string nameX, std::string nameScale, std::string nameB,
+                                std::string nameMean, std::string nameVar, std::string nameY):
+      fAttrEpsilon(epsilon), fNX(UTILITY::Clean_name(nameX)), fNScale(UTILITY::Clean_name(nameScale)),
+      fNB(UTILITY::Clean_name(nameB)), fNMean(UTILITY::Clean_name(nameMean)), fNVar(UTILITY::Clean_name(nameVar)),
+      fNY(UTILITY::Clean_name(nameY)){
+      if (!std::is_same<T, float>::value){
+         throw std::runtime_error("TMVA SOFIE Encountered unsupported type parsing a BatchNormalization operator");
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      return {input[0]};
+   }
+
+   std::vector<std::string> GetInputTensorNames(){ return {fNX, fNScale, fNB, fNMean, fNVar}; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+   bool GetChannelScaleShift(RModel& model, std::vector<float>& scale, std::vector<float>& shift){
+      for (auto& name : {fNScale, fNB, fNMean, fNVar}){
+         if (!model.IsInitializedTensor(name)) return false;
+      }
+      const size_t nChannels = ConvertShapeToLength(model.GetTensorShape(fNScale));
+      for (auto& name : {fNB, fNMean, fNVar}){
+         if (ConvertShapeToLength(model.GetTensorShape(name)) != nChannels){
+            throw std::runtime_error("TMVA SOFIE BatchNormalization Op parameter " + name + " has not one value per channel");
+         }
+      }
+      const float* dataScale = static_cast<float*>(model.GetInitializedTensorData(fNScale).get());
+      const float* dataB = static_cast<float*>(model.GetInitializedTensorData(fNB).get());
+      const float* dataMean = static_cast<float*>(model.GetInitializedTensorData(fNMean).get());
+      const float* dataVar = static_cast<float*>(model.GetInitializedTensorData(fNVar).get());
+      scale.resize(nChannels);
+      shift.resize(nChannels);
+      for (size_t c = 0; c < nChannels; c++){
+         scale[c] = dataScale[c] / std::sqrt(dataVar[c] + fAttrEpsilon);
+         shift[c] = dataB[c] - dataMean[c] * scale[c];
+      }
+      return true;
+   }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op Input Tensor " + fNX + " is not found in model");
+      }
+      fShape = model.GetTensorShape(fNX);
+      if (fShape.size() < 2){
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op Input Tensor " + fNX + " has no channel dimension");
+      }
+      std::vector<float> scale, shift;
+      if (!GetChannelScaleShift(model, scale, shift)){
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op supports only initialized scale, bias, mean and variance");
+      }
+      if (scale.size() != fShape[1]){
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op parameters do not match the channels of " + fNX);
+      }
+      fNChannelScale = fNY + "channelscale";
+      fNChannelShift = fNY + "channelshift";
+      std::shared_ptr<void> scaleData(new float[scale.size()], std::default_delete<float[]>());
+      std::copy(scale.begin(), scale.end(), static_cast<float*>(scaleData.get()));
+      std::shared_ptr<void> shiftData(new float[shift.size()], std::default_delete<float[]>());
+      std::copy(shift.begin(), shift.end(), static_cast<float*>(shiftData.get()));
+      model.AddInitializedTensor(fNChannelScale, ETensorType::FLOAT, {scale.size()}, scaleData);
+      model.AddInitializedTensor(fNChannelShift, ETensorType::FLOAT, {shift.size()}, shiftData);
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShape);
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShape.empty()){
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op called to Generate without being initialized first");
+      }
+      size_t spatial = 1;
+      for (size_t i = 2; i < fShape.size(); i++){
+         spatial *= fShape[i];
+      }
+      std::stringstream out;
+      out << "\t" << "for (int n = 0; n < " << fShape[0] << " ; n++){\n";
+      out << "\t\t" << "for (int c = 0; c < " << fShape[1] << " ; c++){\n";
+      out << "\t\t\t" << "int " << OpName << "_offset = (n * " << fShape[1] << " + c) * " << spatial << ";\n";
+      out << "\t\t\t" << "for (int id = " << OpName << "_offset; id < " << OpName << "_offset + " << spatial << " ; id++){\n";
+      out << "\t\t\t\t" << "tensor_" << fNY << "[id] = tensor_" << fNX << "[id] * tensor_" << fNChannelScale << "[c] + tensor_" << fNChannelShift << "[c];\n";
+      out << "\t\t\t}\n";
+      out << "\t\t}\n";
+      out << "\t}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_BATCHNORMALIZATION
@@ -0,0 +1,112 @@
+#ifndef TMVA_SOFIE_ROPERATOR_CONCAT
+#define TMVA_SOFIE_ROPERATOR_CONCAT
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+template <typename T>
+class ROperator_Concat final : public ROperator
+{
+
+private:
+
+   int fAxis;
+   std::vector<std::string> fInputs;
+   std::string fNY;
+   std::vector<std::vector<size_t>> fInputShapes;
+   std::vector<size_t> fShapeY;
+
+public:
+   ROperator_Concat() = delete;
+   ROperator_Concat(int axis, std::vector<std::string> inputs, std::string nameY):
+      fAxis(axis), fNY(UTILITY::Clean_name(nameY)){
+      for (auto& name: inputs){
+         fInputs.push_back(UTILITY::Clean_name(name));
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   // all inputs must have the same shape, except for the size of the concatenated axis
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      std::vector<size_t> ret = input[0];
+      const int rank = ret.size();
+      if (fAxis < -rank || fAxis >= rank){
+         throw std::runtime_error("TMVA SOFIE Concat Op axis " + std::to_string(fAxis) + " is out of range");
+      }
+      const size_t axis = fAxis < 0 ? fAxis + rank : fAxis;
+      for (size_t i = 1; i < input.size(); i++){
+         if (input[i].size() != ret.size()){
+            throw std::runtime_error("TMVA SOFIE Concat Op input tensors have different ranks");
+         }
+         for (size_t j = 0; j < ret.size(); j++){
+            if (j == axis){
+               ret[j] += input[i][j];
+            } else if (input[i][j] != ret[j]){
+               throw std::runtime_error("TMVA SOFIE Concat Op input tensors have incompatible shapes");
+            }
+         }
+      }
+      return {ret};
+   }
+
+   std::vector<std::string> GetInputTensorNames(){ return fInputs; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (fInputs.empty()){
+         throw std::runtime_error("TMVA SOFIE Concat Op has no input tensors");
+      }
+      for (auto& name: fInputs){
+         if (model.CheckIfTensorAlreadyExist(name) == false){   //input must be a graph input, or already initialized intermediate tensor
+            throw std::runtime_error("TMVA SOFIE Concat Op Input Tensor " + name + " is not found in model");
+         }
+         fInputShapes.push_back(model.GetTensorShape(name));
+      }
+      fShapeY = ShapeInference(fInputShapes)[0];
+      if (fAxis < 0) fAxis += fShapeY.size();
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fInputs[0]), fShapeY);
+      model.AddNeededStdLib("algorithm");
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeY.empty()){
+         throw std::runtime_error("TMVA SOFIE Concat Op called to Generate without being initialized first");
+      }
+      // every input is copied as blocks of its dimensions from the axis onwards, one per index of the outer dimensions
+      size_t outer = 1;
+      for (int i = 0; i < fAxis; i++){
+         outer *= fShapeY[i];
+      }
+      const size_t blockY = ConvertShapeToLength(fShapeY) / outer;
+      std::stringstream out;
+      size_t offset = 0;
+      for (size_t i = 0; i < fInputs.size(); i++){
+         const size_t block = ConvertShapeToLength(fInputShapes[i]) / outer;
+         out << "\t" << "for (int id = 0; id < " << outer << " ; id++){\n";
+         out << "\t\t" << "std::copy(tensor_" << fInputs[i] << " + id * " << block << ", tensor_" << fInputs[i] << " + (id + 1) * " << block
+             << ", tensor_" << fNY << " + id * " << blockY << " + " << offset << ");\n";
+         out << "\t}\n";
+         offset += block;
+      }
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_CONCAT
@@ -0,0 +1,253 @@
+#ifndef TMVA_SOFIE_ROPERATOR_CONV
+#define TMVA_SOFIE_ROPERATOR_CONV
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+#include <algorithm>
+#include <iomanip>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+// 2-dimensional convolution of an input of shape (N, C, H, W) with weights of shape (M, C / group, kH, kW).
+// The generated code rearranges the input patches of each group in a column buffer (im2col), and multiplies
+// it with the weights using BLAS sgemm.
+template <typename T>
+class ROperator_Conv final : public ROperator
+{
+
+private:
+   std::string fAttrAutopad = "NOTSET";
+   std::vector<size_t> fAttrDilations;
+   size_t fAttrGroup = 1;
+   std::vector<size_t> fAttrKernelShape;
+   std::vector<size_t> fAttrPads;
+   std::vector<size_t> fAttrStrides;
+
+   std::string fNX;
+   std::string fNW;
+   std::string fNB = "";
+   std::string fNY;
+   std::string fNXcol;
+   std::vector<size_t> fShapeX;
+   std::vector<size_t> fShapeW;
+   std::vector<size_t> fShapeY;
+
+   std::string fType;
+
+   EActivationType fActivation = EActivationType::UNDEFINED;   // activation fused into this operator
+
+public:
+
+   ROperator_Conv() = delete;
+   ROperator_Conv(std::string autopad, std::vector<size_t> dilations, size_t group, std::vector<size_t> kernelShape,
+                  std::vector<size_t> pads, std::vector<size_t> strides, std::string nameX, std::string nameW,
+                  std::string nameB, std::string nameY):
+      fAttrAutopad(autopad), fAttrDilations(dilations), fAttrGroup(group), fAttrKernelShape(kernelShape),
+      fAttrPads(pads), fAttrStrides(strides), fNX(UTILITY::Clean_name(nameX)), fNW(UTILITY::Clean_name(nameW)),
+      fNB(nameB.empty() ? "" : UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY)) {
+
+      if (std::is_same<T, float>::value) {
+         fType = "float";
+      }else{
+         throw std::runtime_error("TMVA SOFIE Encountered unsupported type parsing a Conv operator");
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   // expects the shapes of X and W, after the attributes were completed by Initialize
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      if (input.size() < 2) throw std::runtime_error("TMVA SOFIE Conv Op Shape Inference needs the input and the weight tensors");
+      auto& x = input[0];
+      auto& w = input[1];
+      std::vector<size_t> y(4);
+      y[0] = x[0];
+      y[1] = w[0];
+      for (size_t i = 0; i < 2; i++){
+         size_t extent = fAttrDilations[i] * (fAttrKernelShape[i] - 1) + 1;
+         y[i + 2] = (x[i + 2] + fAttrPads[i] + fAttrPads[i + 2] - extent) / fAttrStrides[i] + 1;
+      }
+      return {y};
+   }
+
+   std::vector<std::string> GetInputTensorNames(){
+      if (fNB != "") return {fNX, fNW, fNB};
+      return {fNX, fNW};
+   }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+   bool FuseActivation(EActivationType activation, std::string nameY){
+      if (fActivation != EActivationType::UNDEFINED) return false;
+      fActivation = activation;
+      fNY = UTILITY::Clean_name(nameY);
+      return true;
+   }
+
+   // Y * scale + shift = (W * scale) X + (B * scale + shift), per output channel
+   bool FuseChannelScaleShift(RModel& model, const std::vector<float>& scale, const std::vector<float>& shift, std::string nameY){
+      if (fActivation != EActivationType::UNDEFINED) return false;
+      if (!model.IsInitializedTensor(fNW) || (fNB != "" && !model.IsInitializedTensor(fNB))) return false;
+      std::vector<size_t> shapeW = model.GetTensorShape(fNW);
+      const size_t nChannels = shapeW[0];
+      if (scale.size() != nChannels || shift.size() != nChannels) return false;
+
+      const size_t length = ConvertShapeToLength(shapeW);
+      const size_t channelSize = length / nChannels;
+      const float* dataW = static_cast<float*>(model.GetInitializedTensorData(fNW).get());
+      std::shared_ptr<void> newW(new float[length], std::default_delete<float[]>());
+      float* newDataW = static_cast<float*>(newW.get());
+      for (size_t i = 0; i < length; i++){
+         newDataW[i] = dataW[i] * scale[i / channelSize];
+      }
+      model.UpdateInitializedTensor(fNW, ETensorType::FLOAT, shapeW, newW);
+
+      std::shared_ptr<void> newB(new float[nChannels], std::default_delete<float[]>());
+      float* newDataB = static_cast<float*>(newB.get());
+      if (fNB == ""){
+         std::copy(shift.begin(), shift.end(), newDataB);
+         fNB = UTILITY::Clean_name(nameY) + "bias";
+         model.AddInitializedTensor(fNB, ETensorType::FLOAT, {nChannels}, newB);
+      }else{
+         const float* dataB = static_cast<float*>(model.GetInitializedTensorData(fNB).get());
+         for (size_t i = 0; i < nChannels; i++){
+            newDataB[i] = dataB[i] * scale[i] + shift[i];
+         }
+         model.UpdateInitializedTensor(fNB, ETensorType::FLOAT, {nChannels}, newB);
+      }
+      fNY = UTILITY::Clean_name(nameY);
+      return true;
+   }
+
+   void Initialize(RModel& model){
+      if (!model.CheckIfTensorAlreadyExist(fNX) || !model.CheckIfTensorAlreadyExist(fNW)){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE Conv Op Input Tensor " + fNX + " or " + fNW + " is not found in model");
+      }
+      if (fNB != "" && !model.CheckIfTensorAlreadyExist(fNB)){
+         throw std::runtime_error("TMVA SOFIE Conv Op Input Tensor " + fNB + " is not found in model");
+      }
+      fShapeX = model.GetTensorShape(fNX);
+      fShapeW = model.GetTensorShape(fNW);
+      if (fShapeX.size() != 4 || fShapeW.size() != 4){
+         throw std::runtime_error("TMVA SOFIE Conv Op supports only 2-dimensional convolutions with input and weight tensors of 4 dimensions");
+      }
+      if (fShapeX[1] != fShapeW[1] * fAttrGroup || fShapeW[0] % fAttrGroup != 0){
+         throw std::runtime_error("TMVA SOFIE Conv Op the channels of " + fNX + " and " + fNW + " do not match the number of groups");
+      }
+
+      if (fAttrKernelShape.empty()) fAttrKernelShape = {fShapeW[2], fShapeW[3]};
+      if (fAttrDilations.empty()) fAttrDilations = {1, 1};
+      if (fAttrStrides.empty()) fAttrStrides = {1, 1};
+      if (fAttrAutopad == "NOTSET"){
+         if (fAttrPads.empty()) fAttrPads = {0, 0, 0, 0};
+      }else if (fAttrAutopad == "VALID"){
+         fAttrPads = {0, 0, 0, 0};
+      }else if (fAttrAutopad == "SAME_UPPER" || fAttrAutopad == "SAME_LOWER"){
+         fAttrPads.assign(4, 0);
+         for (size_t i = 0; i < 2; i++){
+            // output size is ceil(input / stride)
+            const size_t out = (fShapeX[i + 2] + fAttrStrides[i] - 1) / fAttrStrides[i];
+            const size_t extent = fAttrDilations[i] * (fAttrKernelShape[i] - 1) + 1;
+            const size_t needed = (out - 1) * fAttrStrides[i] + extent;
+            const size_t total = needed > fShapeX[i + 2] ? needed - fShapeX[i + 2] : 0;
+            const size_t small = total / 2;
+            fAttrPads[i] = (fAttrAutopad == "SAME_UPPER") ? small : total - small;
+            fAttrPads[i + 2] = total - fAttrPads[i];
+         }
+      }else{
+         throw std::runtime_error("TMVA SOFIE Conv Op unknown auto_pad " + fAttrAutopad);
+      }
+      if (fAttrKernelShape.size() != 2 || fAttrDilations.size() != 2 || fAttrStrides.size() != 2 || fAttrPads.size() != 4){
+         throw std::runtime_error("TMVA SOFIE Conv Op attributes do not describe a 2-dimensional convolution");
+      }
+
+      fShapeY = ShapeInference({fShapeX, fShapeW})[0];
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShapeY);
+
+      // buffer for the patches of one group of input channels
+      fNXcol = fNY + "xcol";
+      model.AddIntermediateTensor(fNXcol, model.GetTensorType(fNX),
+                                  {fShapeW[1] * fShapeW[2] * fShapeW[3], fShapeY[2] * fShapeY[3]});
+      model.AddNeededStdLib("algorithm");
+      if (fActivation != EActivationType::UNDEFINED){
+         model.AddNeededStdLib("cmath");
+      }
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeX.empty() || fShapeW.empty() || fShapeY.empty()){
+         throw std::runtime_error("TMVA SOFIE Conv Op called to Generate without being initialized first");
+      }
+      const size_t channels = fShapeX[1];
+      const size_t height = fShapeX[2];
+      const size_t width = fShapeX[3];
+      const size_t groupChannels = fShapeW[1];
+      const size_t groupFilters = fShapeW[0] / fAttrGroup;
+      const size_t outHeight = fShapeY[2];
+      const size_t outWidth = fShapeY[3];
+      const size_t outSize = outHeight * outWidth;
+      const size_t k = groupChannels * fShapeW[2] * fShapeW[3];
+
+      std::stringstream out;
+      out << "\t" << "char " << OpName << "_trans = 'n';\n";
+      out << "\t" << "int " << OpName << "_m = " << groupFilters << ";\n";
+      out << "\t" << "int " << OpName << "_n = " << outSize << ";\n";
+      out << "\t" << "int " << OpName << "_k = " << k << ";\n";
+      out << "\t" << "float " << OpName << "_alpha = 1;\n";
+      out << "\t" << "float " << OpName << "_beta = " << (fNB != "" ? 1 : 0) << ";\n";
+      out << "\t" << "for (int n = 0; n < " << fShapeX[0] << " ; n++){\n";
+      out << "\t\t" << "for (int g = 0; g < " << fAttrGroup << " ; g++){\n";
+      // im2col
+      out << "\t\t\t" << "for (int c = 0; c < " << groupChannels << " ; c++){\n";
+      out << "\t\t\t\t" << "const float* " << OpName << "_x = tensor_" << fNX << " + (n * " << channels << " + g * " << groupChannels
+          << " + c) * " << height * width << ";\n";
+      out << "\t\t\t\t" << "for (int kh = 0; kh < " << fShapeW[2] << " ; kh++){\n";
+      out << "\t\t\t\t\t" << "for (int kw = 0; kw < " << fShapeW[3] << " ; kw++){\n";
+      out << "\t\t\t\t\t\t" << "float* " << OpName << "_col = tensor_" << fNXcol << " + ((c * " << fShapeW[2] << " + kh) * "
+          << fShapeW[3] << " + kw) * " << outSize << ";\n";
+      out << "\t\t\t\t\t\t" << "for (int oh = 0; oh < " << outHeight << " ; oh++){\n";
+      out << "\t\t\t\t\t\t\t" << "int ih = oh * " << fAttrStrides[0] << " - " << fAttrPads[0] << " + kh * " << fAttrDilations[0] << ";\n";
+      out << "\t\t\t\t\t\t\t" << "for (int ow = 0; ow < " << outWidth << " ; ow++){\n";
+      out << "\t\t\t\t\t\t\t\t" << "int iw = ow * " << fAttrStrides[1] << " - " << fAttrPads[1] << " + kw * " << fAttrDilations[1] << ";\n";
+      out << "\t\t\t\t\t\t\t\t" << OpName << "_col[oh * " << outWidth << " + ow] = (ih >= 0 && ih < " << height << " && iw >= 0 && iw < "
+          << width << ") ? " << OpName << "_x[ih * " << width << " + iw] : 0;\n";
+      out << "\t\t\t\t\t\t\t}\n";
+      out << "\t\t\t\t\t\t}\n";
+      out << "\t\t\t\t\t}\n";
+      out << "\t\t\t\t}\n";
+      out << "\t\t\t}\n";
+      // Y = W * Xcol (+ B), for the filters of this group
+      out << "\t\t\t" << "float* " << OpName << "_y = tensor_" << fNY << " + (n * " << fShapeW[0] << " + g * " << groupFilters
+          << ") * " << outSize << ";\n";
+      if (fNB != ""){
+         out << "\t\t\t" << "for (int m = 0; m < " << groupFilters << " ; m++){\n";
+         out << "\t\t\t\t" << "std::fill(" << OpName << "_y + m * " << outSize << ", " << OpName << "_y + (m + 1) * " << outSize
+             << ", tensor_" << fNB << "[g * " << groupFilters << " + m]);\n";
+         out << "\t\t\t}\n";
+      }
+      out << "\t\t\t" << "BLAS::sgemm_(&" << OpName << "_trans, &" << OpName << "_trans, &" << OpName << "_n, &" << OpName
+          << "_m, &" << OpName << "_k, &" << OpName << "_alpha, tensor_" << fNXcol << ", &" << OpName << "_n, tensor_" << fNW
+          << " + g * " << groupFilters * k << ", &" << OpName << "_k, &" << OpName << "_beta, " << OpName << "_y, &" << OpName << "_n);\n";
+      out << "\t\t}\n";
+      out << "\t}\n";
+      if (fActivation != EActivationType::UNDEFINED){
+         out << UTILITY::Generate_activation(fActivation, fNY, ConvertShapeToLength(fShapeY));
+      }
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_CONV
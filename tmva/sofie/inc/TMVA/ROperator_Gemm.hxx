@@ -37,6 +37,8 @@ namespace SOFIE{
 
       std::string fType;
 
+      EActivationType fActivation = EActivationType::UNDEFINED;   // activation fused into this operator
+
    public:
 
       ROperator_Gemm() = delete;
@@ -96,6 +98,63 @@ namespace SOFIE{
 
 
 
+      std::vector<std::string> GetInputTensorNames(){
+         if (fNC != "") return {fNA, fNB, fNC};
+         return {fNA, fNB};
+      }
+      std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+      bool FuseActivation(EActivationType activation, std::string nameY){
+         if (fActivation != EActivationType::UNDEFINED) return false;
+         fActivation = activation;
+         fNY = UTILITY::Clean_name(nameY);
+         return true;
+      }
+
+      // Y * scale + shift = alpha * A * (B * scale) + beta * (C * scale + shift / beta), per column of Y
+      bool FuseChannelScaleShift(RModel& model, const std::vector<float>& scale, const std::vector<float>& shift, std::string nameY){
+         if (fType != "float" || fActivation != EActivationType::UNDEFINED) return false;
+         if (!model.IsInitializedTensor(fNB) || (fNC != "" && !model.IsInitializedTensor(fNC))) return false;
+         std::vector<size_t> shapeB = model.GetTensorShape(fNB);
+         if (shapeB.size() != 2) return false;
+         const size_t n = fAttrTransB ? shapeB[0] : shapeB[1];
+         const size_t k = fAttrTransB ? shapeB[1] : shapeB[0];
+         if (scale.size() != n || shift.size() != n) return false;
+
+         const float* dataB = static_cast<float*>(model.GetInitializedTensorData(fNB).get());
+         std::shared_ptr<void> newB(new float[n * k], std::default_delete<float[]>());
+         float* newDataB = static_cast<float*>(newB.get());
+         for (size_t i = 0; i < n * k; i++){
+            const size_t column = fAttrTransB ? i / k : i % n;
+            newDataB[i] = dataB[i] * scale[column];
+         }
+         model.UpdateInitializedTensor(fNB, ETensorType::FLOAT, shapeB, newB);
+
+         if (fNC == "" || fAttrBeta == 0){
+            fNC = UTILITY::Clean_name(nameY) + "bias";
+            std::shared_ptr<void> newC(new float[n], std::default_delete<float[]>());
+            std::copy(shift.begin(), shift.end(), static_cast<float*>(newC.get()));
+            model.AddInitializedTensor(fNC, ETensorType::FLOAT, {1, n}, newC);
+            fAttrBeta = 1.0;
+         }else{
+            // expand C to one value per column, if needed
+            std::vector<size_t> shapeC = model.GetTensorShape(fNC);
+            std::vector<size_t> newShapeC(shapeC);
+            if (newShapeC.empty()) newShapeC.push_back(n);
+            newShapeC.back() = n;
+            const float* dataC = static_cast<float*>(model.GetInitializedTensorData(fNC).get());
+            std::shared_ptr<void> newC(UTILITY::Unidirectional_broadcast<float>(dataC, shapeC, newShapeC), std::default_delete<float[]>());
+            float* newDataC = static_cast<float*>(newC.get());
+            const size_t length = ConvertShapeToLength(newShapeC);
+            for (size_t i = 0; i < length; i++){
+               newDataC[i] = newDataC[i] * scale[i % n] + shift[i % n] / fAttrBeta;
+            }
+            model.UpdateInitializedTensor(fNC, ETensorType::FLOAT, newShapeC, newC);
+         }
+         fNY = UTILITY::Clean_name(nameY);
+         return true;
+      }
+
       void Initialize(RModel& model){
          //TODO: propagate A or B as specified by ONNX standard
 
@@ -119,8 +178,8 @@ namespace SOFIE{
          if (fNC != ""){
             fShapeC = model.GetTensorShape(fNC);
 
-            bool broadcast_needed = false;
-            for (int i =0; i < fShapeC.size(); i++){
+            bool broadcast_needed = (fShapeC.size() != fShapeY.size());
+            for (int i =0; i < fShapeC.size() && !broadcast_needed; i++){
                if (fShapeC[i]!=fShapeY[i]){
                   broadcast_needed = true;
                   break;
@@ -145,6 +204,9 @@ namespace SOFIE{
 
          model.AddIntermediateTensor(fNY, model.GetTensorType(fNA), fShapeY);
          model.AddNeededStdLib("algorithm");
+         if (fActivation != EActivationType::UNDEFINED){
+            model.AddNeededStdLib("cmath");
+         }
 
       }
 
@@ -181,6 +243,9 @@ namespace SOFIE{
              << ", &" << OpName << "_ldb, " << "tensor_" << fNA << ", &" << OpName << "_lda, &" << OpName << "_beta, " << "tensor_" << fNY << ", &"
              << OpName << "_n);\n";
           }
+          if (fActivation != EActivationType::UNDEFINED){
+             out << UTILITY::Generate_activation(fActivation, fNY, m * n);
+          }
 
           return out.str();
 
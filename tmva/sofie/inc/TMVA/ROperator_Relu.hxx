@@ -35,6 +35,10 @@ public:
       return ret;
    }
 
+   std::vector<std::string> GetInputTensorNames(){ return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+   EActivationType GetActivationType(){ return EActivationType::RELU; }
+
    void Initialize(RModel& model){
       if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
          throw std::runtime_error("TMVA SOFIE Relu Op Input Tensor is not found in model");
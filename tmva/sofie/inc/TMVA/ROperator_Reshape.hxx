@@ -0,0 +1,138 @@
+#ifndef TMVA_SOFIE_ROPERATOR_RESHAPE
+#define TMVA_SOFIE_ROPERATOR_RESHAPE
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+enum EReshapeOpMode { Reshape, Flatten };
+
+// Reshape, with the new shape given by an initialized INT64 tensor, or Flatten, which makes a
+// matrix out of the dimensions before and from the axis. The data are copied unchanged.
+template <typename T>
+class ROperator_Reshape final : public ROperator
+{
+
+private:
+
+   EReshapeOpMode fOpMode;
+   int fAxis;             // axis of Flatten
+   std::string fNData;
+   std::string fNShape;   // shape tensor of Reshape
+   std::string fNY;
+   std::vector<size_t> fShapeInput;
+   std::vector<size_t> fShapeY;
+
+public:
+   ROperator_Reshape() = delete;
+   ROperator_Reshape(std::string nameData, std::string nameShape, std::string nameY):
+      fOpMode(Reshape), fAxis(0), fNData(UTILITY::Clean_name(nameData)), fNShape(UTILITY::Clean_name(nameShape)),
+      fNY(UTILITY::Clean_name(nameY)){}
+   ROperator_Reshape(int axis, std::string nameData, std::string nameY):
+      fOpMode(Flatten), fAxis(axis), fNData(UTILITY::Clean_name(nameData)), fNY(UTILITY::Clean_name(nameY)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   // input[0] is the shape of the data; for Reshape, input[1] holds the requested shape
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      const auto& shape = input[0];
+      const size_t length = ConvertShapeToLength(shape);
+      std::vector<size_t> ret;
+      if (fOpMode == Flatten){
+         const int rank = shape.size();
+         const int axis = fAxis < 0 ? fAxis + rank : fAxis;
+         if (axis < 0 || axis > rank){
+            throw std::runtime_error("TMVA SOFIE Flatten Op axis " + std::to_string(fAxis) + " is out of range");
+         }
+         size_t outer = 1;
+         for (int i = 0; i < axis; i++){
+            outer *= shape[i];
+         }
+         ret = {outer, length / outer};
+      } else {
+         ret = input[1];
+         if (ConvertShapeToLength(ret) != length){
+            throw std::runtime_error("TMVA SOFIE Reshape Op cannot change the number of elements of " + fNData);
+         }
+      }
+      return {ret};
+   }
+
+   std::vector<std::string> GetInputTensorNames(){
+      if (fOpMode == Reshape) return {fNData, fNShape};
+      return {fNData};
+   }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNData) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE Reshape Op Input Tensor " + fNData + " is not found in model");
+      }
+      fShapeInput = model.GetTensorShape(fNData);
+      if (fOpMode == Flatten){
+         fShapeY = ShapeInference({fShapeInput})[0];
+      } else {
+         if (!model.IsInitializedTensor(fNShape) || model.GetTensorType(fNShape) != ETensorType::INT64){
+            throw std::runtime_error("TMVA SOFIE Reshape Op supports only a shape given by an initialized INT64 tensor, not " + fNShape);
+         }
+         const int64_t* data = static_cast<int64_t*>(model.GetInitializedTensorData(fNShape).get());
+         const size_t rank = ConvertShapeToLength(model.GetTensorShape(fNShape));
+         // a 0 keeps the input dimension, a -1 is deduced from the remaining ones
+         std::vector<size_t> shape(rank);
+         size_t known = 1;
+         int inferred = -1;
+         for (size_t i = 0; i < rank; i++){
+            if (data[i] == 0){
+               if (i >= fShapeInput.size()){
+                  throw std::runtime_error("TMVA SOFIE Reshape Op cannot copy dimension " + std::to_string(i) + " of " + fNData);
+               }
+               shape[i] = fShapeInput[i];
+            } else if (data[i] == -1){
+               if (inferred >= 0){
+                  throw std::runtime_error("TMVA SOFIE Reshape Op shape " + fNShape + " has more than one dimension set to -1");
+               }
+               inferred = i;
+               continue;
+            } else if (data[i] > 0){
+               shape[i] = data[i];
+            } else {
+               throw std::runtime_error("TMVA SOFIE Reshape Op shape " + fNShape + " has a negative dimension");
+            }
+            known *= shape[i];
+         }
+         if (inferred >= 0){
+            shape[inferred] = (known > 0) ? ConvertShapeToLength(fShapeInput) / known : 0;
+         }
+         fShapeY = ShapeInference({fShapeInput, shape})[0];
+      }
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNData), fShapeY);
+      model.AddNeededStdLib("algorithm");
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeY.empty()){
+         throw std::runtime_error("TMVA SOFIE Reshape Op called to Generate without being initialized first");
+      }
+      std::stringstream out;
+      out << "\t" << "std::copy(tensor_" << fNData << ", tensor_" << fNData << " + " << ConvertShapeToLength(fShapeY)
+          << ", tensor_" << fNY << ");\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_RESHAPE
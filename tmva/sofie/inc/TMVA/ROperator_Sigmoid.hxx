@@ -0,0 +1,75 @@
+#ifndef TMVA_SOFIE_ROPERATOR_SIGMOID
+#define TMVA_SOFIE_ROPERATOR_SIGMOID
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+template <typename T>
+class ROperator_Sigmoid final : public ROperator
+{
+
+private:
+
+   std::string fNX;
+   std::string fNY;
+   std::vector<size_t> fShape;
+
+public:
+   ROperator_Sigmoid() = delete;
+   ROperator_Sigmoid(std::string nameX, std::string nameY):
+      fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return input;
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto ret = input; //suggest copy to compiler
+      return ret;
+   }
+
+   std::vector<std::string> GetInputTensorNames(){ return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+   EActivationType GetActivationType(){ return EActivationType::SIGMOID; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE Sigmoid Op Input Tensor is not found in model");
+      }
+      fShape = model.GetTensorShape(fNX);
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShape);
+      model.AddNeededStdLib("cmath");
+   }
+
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShape.empty()){
+         throw std::runtime_error("TMVA SOFIE Sigmoid Op called to Generate without being initialized first");
+      }
+      std::stringstream out;
+      int length = 1;
+      for(auto& i: fShape){
+         length *= i;
+      }
+      out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
+      out << "\t\t" << "tensor_" << fNY << "[id] = " << UTILITY::Activation_expression(GetActivationType(), "tensor_" + fNX + "[id]") << ";\n";
+      out << "\t}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_SIGMOID
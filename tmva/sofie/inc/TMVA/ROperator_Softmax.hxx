@@ -0,0 +1,101 @@
+#ifndef TMVA_SOFIE_ROPERATOR_SOFTMAX
+#define TMVA_SOFIE_ROPERATOR_SOFTMAX
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+// Softmax along one axis of the input, with the definition of ONNX opset 13.
+template <typename T>
+class ROperator_Softmax final : public ROperator
+{
+
+private:
+
+   int_t fAttrAxis = -1;
+
+   std::string fNX;
+   std::string fNY;
+   std::vector<size_t> fShape;
+
+public:
+   ROperator_Softmax() = delete;
+   ROperator_Softmax(int_t axis, std::string nameX, std::string nameY):
+      fAttrAxis(axis), fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return input;
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto ret = input; //suggest copy to compiler
+      return ret;
+   }
+
+   std::vector<std::string> GetInputTensorNames(){ return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE Softmax Op Input Tensor is not found in model");
+      }
+      fShape = model.GetTensorShape(fNX);
+      const int_t rank = fShape.size();
+      if (fAttrAxis < -rank || fAttrAxis >= rank){
+         throw std::runtime_error("TMVA SOFIE Softmax Op axis " + std::to_string(fAttrAxis) + " is out of range");
+      }
+      if (fAttrAxis < 0) fAttrAxis += rank;
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShape);
+      model.AddNeededStdLib("algorithm");
+      model.AddNeededStdLib("cmath");
+   }
+
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShape.empty()){
+         throw std::runtime_error("TMVA SOFIE Softmax Op called to Generate without being initialized first");
+      }
+      size_t outer = 1;
+      size_t inner = 1;
+      for (int_t i = 0; i < fAttrAxis; i++) outer *= fShape[i];
+      for (size_t i = fAttrAxis + 1; i < fShape.size(); i++) inner *= fShape[i];
+      const size_t dim = fShape[fAttrAxis];
+
+      const std::string x = "tensor_" + fNX + "[" + OpName + "_offset + d * " + std::to_string(inner) + "]";
+      const std::string y = "tensor_" + fNY + "[" + OpName + "_offset + d * " + std::to_string(inner) + "]";
+      std::stringstream out;
+      out << "\t" << "for (int i = 0; i < " << outer << " ; i++){\n";
+      out << "\t\t" << "for (int j = 0; j < " << inner << " ; j++){\n";
+      out << "\t\t\t" << "int " << OpName << "_offset = i * " << dim * inner << " + j;\n";
+      out << "\t\t\t" << "float " << OpName << "_max = tensor_" << fNX << "[" << OpName << "_offset];\n";
+      out << "\t\t\t" << "for (int d = 1; d < " << dim << " ; d++){\n";
+      out << "\t\t\t\t" << OpName << "_max = std::max(" << OpName << "_max, " << x << ");\n";
+      out << "\t\t\t}\n";
+      out << "\t\t\t" << "float " << OpName << "_sum = 0;\n";
+      out << "\t\t\t" << "for (int d = 0; d < " << dim << " ; d++){\n";
+      out << "\t\t\t\t" << y << " = std::exp(" << x << " - " << OpName << "_max);\n";
+      out << "\t\t\t\t" << OpName << "_sum += " << y << ";\n";
+      out << "\t\t\t}\n";
+      out << "\t\t\t" << "for (int d = 0; d < " << dim << " ; d++){\n";
+      out << "\t\t\t\t" << y << " /= " << OpName << "_sum;\n";
+      out << "\t\t\t}\n";
+      out << "\t\t}\n";
+      out << "\t}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_SOFTMAX
@@ -41,6 +41,9 @@ public:
       return input;
    }
 
+   std::vector<std::string> GetInputTensorNames(){ return {fNData}; }
+   std::vector<std::string> GetOutputTensorNames(){ return {fNOutput}; }
+
    std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
       if (input.size() > 1) throw std::runtime_error("TMVA SOFIE Tranpose Op Shape Inference only need 1 input tensor");
       auto& data = input[0];
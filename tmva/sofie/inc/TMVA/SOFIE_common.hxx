@@ -23,6 +23,11 @@ enum class ETensorType{
 
 typedef std::int64_t int_t;
 
+// elementwise activations, which can be fused into the preceding operator
+enum class EActivationType{
+   UNDEFINED = 0, RELU = 1, SIGMOID = 2, TANH = 3
+};
+
 std::string ConvertTypeToString(ETensorType type);
 
 struct Dim{
@@ -75,6 +80,10 @@ namespace UTILITY{
 template<typename T>
 T* Unidirectional_broadcast(const T* original_data, const std::vector<size_t> original_shape, const std::vector<size_t> target_shape);
 std::string Clean_name(std::string input_tensor_name);
+// generated code of an activation applied to the expression x
+std::string Activation_expression(EActivationType activation, std::string x);
+// generated code of a loop applying an activation in place to the first length elements of a tensor
+std::string Generate_activation(EActivationType activation, std::string tensor_name, std::size_t length);
 }
 
 namespace BLAS{
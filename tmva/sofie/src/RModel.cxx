@@ -80,6 +80,10 @@ namespace SOFIE{
       throw std::runtime_error("TMVA SOFIE tensor [" + name + "] for which the shape is requested is not found");
    }
 
+   bool RModel::IsInitializedTensor(std::string tensor_name){
+      return fInitializedTensors.find(tensor_name) != fInitializedTensors.end();
+   }
+
    bool RModel::CheckIfTensorAlreadyExist(std::string tensor_name){
       if (fReadyInputTensorInfos.find(tensor_name) != fReadyInputTensorInfos.end())  return true;
       if (fInitializedTensors.find(tensor_name) != fInitializedTensors.end()) return true;
@@ -158,13 +162,72 @@ namespace SOFIE{
       }
    }
 
+   // Fuse an operator into the preceding one, which produces its input:
+   // - a BatchNormalization is folded into the weights of a Conv or Gemm,
+   // - an elementwise activation is applied by a Conv or Gemm to its output.
+   // This saves the intermediate tensor and one loop over it in the generated code.
+   void RModel::FuseOperators(){
+      // number of operators reading each tensor; the fusion needs to know all inputs
+      std::unordered_map<std::string, int> nConsumers;
+      for (auto& op : fOperators){
+         auto inputs = op->GetInputTensorNames();
+         if (inputs.empty()) return;
+         for (auto& name : inputs) nConsumers[name]++;
+      }
+      for (auto& name : fOutputTensorNames) nConsumers[name]++;
+
+      size_t id = 0;
+      while (id + 1 < fOperators.size()){
+         auto& op = fOperators[id];
+         auto& next = fOperators[id + 1];
+         auto outputs = op->GetOutputTensorNames();
+         auto nextInputs = next->GetInputTensorNames();
+         auto nextOutputs = next->GetOutputTensorNames();
+         bool fused = false;
+         if (outputs.size() == 1 && nextOutputs.size() == 1 && nextInputs[0] == outputs[0] && nConsumers[outputs[0]] == 1){
+            std::vector<float> scale, shift;
+            if (next->GetActivationType() != EActivationType::UNDEFINED){
+               fused = op->FuseActivation(next->GetActivationType(), nextOutputs[0]);
+            }else if (next->GetChannelScaleShift(*this, scale, shift)){
+               // the weights are updated in place; they must not be used by other operators
+               bool weightsOwned = true;
+               auto inputs = op->GetInputTensorNames();
+               for (size_t i = 1; i < inputs.size(); i++){
+                  if (nConsumers[inputs[i]] != 1) weightsOwned = false;
+               }
+               fused = weightsOwned && op->FuseChannelScaleShift(*this, scale, shift, nextOutputs[0]);
+            }
+         }
+         if (fused){
+            for (auto& name : nextInputs) nConsumers[name]--;
+            fOperators.erase(fOperators.begin() + id + 1);
+         }else{
+            id++;
+         }
+      }
+   }
+
    void RModel::Initialize(){
+      FuseOperators();
       for (auto& i : fOperators){
          i->Initialize(*this);
       }
    }
 
-   void RModel::Generate(){
+   void RModel::Generate(int batchSize){
+      if (batchSize > 0){
+         for (auto& i: fReadyInputTensorInfos){
+            if (!i.second.shape.empty()) i.second.shape[0] = batchSize;
+         }
+         for (auto& i: fInputTensorInfos){
+            std::vector<size_t> shape;
+            for (auto& dim: i.second.shape){
+               shape.push_back(dim.isParam || shape.empty() ? batchSize : dim.dim);
+            }
+            fReadyInputTensorInfos[i.first] = TensorInfo{i.second.type, shape};
+         }
+         fInputTensorInfos.clear();
+      }
       Initialize();
       fGC += ("//Code generated automatically by TMVA for Inference of Model file [" + fFileName + "] at [" + fParseTime.substr(0, fParseTime.length()-1) +"] \n");
       for (auto& i: fNeededStdLib){
@@ -194,16 +257,24 @@ namespace SOFIE{
             fGC += floats.str() +"};\n";
          }
       }
+      // the intermediate tensors are buffers of a Session, allocated once; one session is needed per thread
+      fGC += "struct Session {\n";
+      if (!fReadyInputTensorInfos.empty() && !fReadyInputTensorInfos.begin()->second.shape.empty()){
+         fGC += "static constexpr std::size_t kBatchSize = " + std::to_string(fReadyInputTensorInfos.begin()->second.shape[0]) + ";\n";
+      }
       for (auto&i: fIntermediateTensorInfos){
          if (i.second.type == ETensorType::FLOAT){
-            size_t length = 1;
-            for (auto & dim: i.second.shape){
-               length *= dim;
-            }
-            fGC += "float tensor_" + i.first + "[" + std::to_string(length) + "];\n";
+            size_t length = ConvertShapeToLength(i.second.shape);
+            fGC += "std::vector<float> fTensor_" + i.first + " = std::vector<float>(" + std::to_string(length) + ");\n";
+            fGC += "float * tensor_" + i.first + " = fTensor_" + i.first + ".data();\n";
          }
       }
+      fGC += "Session() = default;\n";
+      fGC += "Session(Session&&) = default;\n";
+      fGC += "Session(const Session&) = delete;\n";
+      fGC += "Session& operator=(const Session&) = delete;\n";
 
+      std::string outputLength;
       if (fOutputTensorNames.size() == 1){
          auto f = fIntermediateTensorInfos.find(fOutputTensorNames[0]);
          if (f == fIntermediateTensorInfos.end()){
@@ -212,34 +283,40 @@ namespace SOFIE{
             if (f->second.type == ETensorType::FLOAT){
                fGC += "std::vector<float> ";
             }
+            outputLength = std::to_string(ConvertShapeToLength(f->second.shape));
          }
       }else{
          std::cout << fOutputTensorNames.size() << std::endl;
          throw std::runtime_error("TMVA-SOFIE: More than 1 output tensor is not yet supported");
       }
 
-      fGC += "infer(";
+      std::string inputArgs;
+      std::string inputNames;
       for (auto& i: fReadyInputTensorInfos){
-         size_t length = 1;
-         for (auto& dim: i.second.shape){
-            length *= dim;
-         }
          if (i.second.type == ETensorType::FLOAT){
-         fGC += "float* tensor_" + i.first + ",";
+            inputArgs += "float* tensor_" + i.first + ",";
+            inputNames += "tensor_" + i.first + ",";
          }
       }
-      fGC.pop_back(); //remove last ","
-      fGC += "){\n";
+      inputArgs.pop_back(); //remove last ","
+      inputNames.pop_back();
+      fGC += "infer(" + inputArgs + "){\n";
 
       for (int id = 0; id < fOperators.size() ; id++){
          fGC+= (fOperators[id]->Generate(std::to_string(id)));
       }
       if (fOutputTensorNames.size() == 1){
-         fGC += "\tstd::vector<float> ret (tensor_" + fOutputTensorNames[0] + ", tensor_" + fOutputTensorNames[0] + " + sizeof(tensor_" +
-               fOutputTensorNames[0] + ") / sizeof(tensor_" + fOutputTensorNames[0] + "[0]));\n";
+         fGC += "\tstd::vector<float> ret (tensor_" + fOutputTensorNames[0] + ", tensor_" + fOutputTensorNames[0] + " + " + outputLength + ");\n";
          fGC += "\treturn ret;\n";
       }
       fGC += "}\n";
+      fGC += "};\n";
+
+      // single-threaded entry point, running a session shared by all calls
+      fGC += "std::vector<float> infer(" + inputArgs + "){\n";
+      fGC += "\tstatic Session session;\n";
+      fGC += "\treturn session.infer(" + inputNames + ");\n";
+      fGC += "}\n";
       }
       fGC += ("} //TMVA_SOFIE_" + fName + "\n");
    }
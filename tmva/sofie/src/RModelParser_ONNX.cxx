@@ -3,6 +3,8 @@
 
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <cstring>
 
 namespace TMVA{
 namespace Experimental{
@@ -152,6 +154,288 @@ std::unique_ptr<ROperator> make_ROperator_Gemm(const onnx::NodeProto& nodeproto,
    return std::move(op);
 }
 
+namespace {
+
+// type of the first input of a node, which must have been registered by the graph inputs or by a previous node
+ETensorType GetInputType(const onnx::NodeProto& nodeproto, std::unordered_map<std::string, ETensorType>& tensor_type){
+   auto input_name = nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it == tensor_type.end()){
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser " + nodeproto.op_type() + " op has input tensor" + input_name + " but its type is not yet registered");
+   }
+   return it->second;
+}
+
+void RegisterOutputType(const onnx::NodeProto& nodeproto, ETensorType output_type, std::unordered_map<std::string, ETensorType>& tensor_type){
+   auto it = tensor_type.find(nodeproto.output(0));
+   if (it == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+}
+
+template <template <typename> class Op>
+std::unique_ptr<ROperator> make_ROperator_Activation(const onnx::NodeProto& nodeproto, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new Op<float>(nodeproto.input(0), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator " + nodeproto.op_type() + " does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type})[0], tensor_type);
+   return op;
+}
+
+template <EBasicBinaryOperator Op>
+std::unique_ptr<ROperator> make_ROperator_BasicBinary(const onnx::NodeProto& nodeproto, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_BasicBinary<float, Op>(nodeproto.input(0), nodeproto.input(1), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator " + nodeproto.op_type() + " does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type, input_type})[0], tensor_type);
+   return op;
+}
+
+}
+
+std::unique_ptr<ROperator> make_ROperator_Sigmoid(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+   return make_ROperator_Activation<ROperator_Sigmoid>(nodeproto, tensor_type);
+}
+
+std::unique_ptr<ROperator> make_ROperator_Tanh(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+   return make_ROperator_Activation<ROperator_Tanh>(nodeproto, tensor_type);
+}
+
+std::unique_ptr<ROperator> make_ROperator_Add(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+   return make_ROperator_BasicBinary<Add>(nodeproto, tensor_type);
+}
+
+std::unique_ptr<ROperator> make_ROperator_Sub(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+   return make_ROperator_BasicBinary<Sub>(nodeproto, tensor_type);
+}
+
+std::unique_ptr<ROperator> make_ROperator_Mul(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+   return make_ROperator_BasicBinary<Mul>(nodeproto, tensor_type);
+}
+
+std::unique_ptr<ROperator> make_ROperator_Div(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+   return make_ROperator_BasicBinary<Div>(nodeproto, tensor_type);
+}
+
+std::unique_ptr<ROperator> make_ROperator_Softmax(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   int_t attr_axis = -1;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "axis"){
+         attr_axis = nodeproto.attribute(i).i();
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Softmax<float>(attr_axis, nodeproto.input(0), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Softmax does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type})[0], tensor_type);
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Conv(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   std::string attr_autopad = "NOTSET";
+   std::vector<size_t> attr_dilations;
+   size_t attr_group = 1;
+   std::vector<size_t> attr_kernel_shape;
+   std::vector<size_t> attr_pads;
+   std::vector<size_t> attr_strides;
+
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "auto_pad"){
+         attr_autopad = nodeproto.attribute(i).s();
+      }else if (attribute_name == "dilations"){
+         attr_dilations.assign(nodeproto.attribute(i).ints().begin(), nodeproto.attribute(i).ints().end());
+      }else if (attribute_name == "group"){
+         attr_group = nodeproto.attribute(i).i();
+      }else if (attribute_name == "kernel_shape"){
+         attr_kernel_shape.assign(nodeproto.attribute(i).ints().begin(), nodeproto.attribute(i).ints().end());
+      }else if (attribute_name == "pads"){
+         attr_pads.assign(nodeproto.attribute(i).ints().begin(), nodeproto.attribute(i).ints().end());
+      }else if (attribute_name == "strides"){
+         attr_strides.assign(nodeproto.attribute(i).ints().begin(), nodeproto.attribute(i).ints().end());
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   std::string name_b = (nodeproto.input_size() > 2) ? nodeproto.input(2) : "";
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Conv<float>(attr_autopad, attr_dilations, attr_group, attr_kernel_shape, attr_pads, attr_strides,
+                                         nodeproto.input(0), nodeproto.input(1), name_b, nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Conv does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type, input_type})[0], tensor_type);
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_BatchNormalization(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   float attr_epsilon = 1e-5;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "epsilon"){
+         attr_epsilon = nodeproto.attribute(i).f();
+      }else if (attribute_name == "momentum" || attribute_name == "training_mode"){
+         // only relevant for training
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+   if (nodeproto.input_size() != 5 || nodeproto.output_size() != 1){
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator BatchNormalization is supported only in inference mode");
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_BatchNormalization<float>(attr_epsilon, nodeproto.input(0), nodeproto.input(1), nodeproto.input(2),
+                                                       nodeproto.input(3), nodeproto.input(4), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator BatchNormalization does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type})[0], tensor_type);
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Concat(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   int attr_axis = 0;
+   bool has_axis = false;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "axis"){
+         attr_axis = nodeproto.attribute(i).i();
+         has_axis = true;
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+   if (!has_axis){
+      throw std::runtime_error("TMVA::SOFIE Error - Model Loading - Operator Concat requires the attribute axis");
+   }
+
+   std::vector<std::string> inputs(nodeproto.input().begin(), nodeproto.input().end());
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Concat<float>(attr_axis, inputs, nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Concat does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type})[0], tensor_type);
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Reshape(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "allowzero" && nodeproto.attribute(i).i() != 0){
+         throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Reshape does not support the attribute allowzero");
+      }else if (attribute_name != "allowzero"){
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Reshape<float>(nodeproto.input(0), nodeproto.input(1), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Reshape does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type})[0], tensor_type);
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Flatten(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = GetInputType(nodeproto, tensor_type);
+
+   std::unique_ptr<ROperator> op;
+
+   int attr_axis = 1;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "axis"){
+         attr_axis = nodeproto.attribute(i).i();
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Reshape<float>(attr_axis, nodeproto.input(0), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Flatten does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   RegisterOutputType(nodeproto, op->TypeInference({input_type})[0], tensor_type);
+   return op;
+}
+
 } //INTERNAL
 
 
@@ -256,6 +540,8 @@ RModel RModelParser_ONNX::Parse(std::string filename){
       }
 
       std::string input_name = graph.initializer(i).name();
+      // initializers need not be listed among the graph inputs
+      tensor_type[input_name] = static_cast<ETensorType>(graph.initializer(i).data_type());
 
       switch(static_cast<ETensorType>(graph.initializer(i).data_type())){
          case ETensorType::FLOAT : {
@@ -272,6 +558,18 @@ RModel RModelParser_ONNX::Parse(std::string filename){
             rmodel.AddInitializedTensor(input_name, ETensorType::FLOAT, fShape, data);
             break;
          }
+         case ETensorType::INT64 : {
+            std::shared_ptr<void> data(malloc(fLength * sizeof(int64_t)), free);
+
+            if (tensorproto->raw_data().empty() == false){
+               std::memcpy(data.get(), tensorproto->raw_data().c_str(), fLength * sizeof(int64_t));
+            }else{
+               std::copy(tensorproto->int64_data().begin(), tensorproto->int64_data().end(), static_cast<int64_t*>(data.get()));
+            }
+
+            rmodel.AddInitializedTensor(input_name, ETensorType::INT64, fShape, data);
+            break;
+         }
          default: throw std::runtime_error("Data type in weight tensor " + graph.initializer(i).name() + " not supported!\n");
       }
    }
@@ -1,5 +1,6 @@
 #include "TMVA/SOFIE_common.hxx"
 #include<cctype>
+#include<sstream>
 
 namespace TMVA{
 namespace Experimental{
@@ -100,6 +101,24 @@ std::string UTILITY::Clean_name(std::string input_tensor_name){
    return s;
 }
 
+std::string UTILITY::Activation_expression(EActivationType activation, std::string x){
+   switch(activation){
+      case EActivationType::RELU : return "((" + x + " > 0 )? " + x + " : 0)";
+      case EActivationType::SIGMOID : return "1 / (1 + std::exp(-" + x + "))";
+      case EActivationType::TANH : return "std::tanh(" + x + ")";
+      default : throw std::runtime_error("TMVA::SOFIE Error - unknown activation type");
+   }
+}
+
+std::string UTILITY::Generate_activation(EActivationType activation, std::string tensor_name, std::size_t length){
+   std::string x = "tensor_" + tensor_name + "[id]";
+   std::stringstream out;
+   out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
+   out << "\t\t" << x << " = " << Activation_expression(activation, x) << ";\n";
+   out << "\t}\n";
+   return out.str();
+}
+
 template float* UTILITY::Unidirectional_broadcast(const float* original_data, const std::vector<size_t> original_shape, const std::vector<size_t> target_shape);
 
 }//SOFIE
@@ -41,6 +41,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TH2.h"
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "TMVA/Types.h"
@@ -193,6 +196,23 @@ namespace TMVA {
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
       inline void SetNVars(Int_t n){fNvars = n;}
 
+      // the variables of a training sample, binned once for all the trees of a forest
+      struct GlobalBinning {
+         std::vector<UInt_t>   fNBins;    // number of bins of each variable
+         std::vector<UInt_t>   fOffset;   // index of the first bin of each variable in the histograms of a node
+         std::vector<Double_t> fXmin;     // lower edge of the bins of each variable
+         std::vector<Double_t> fBinWidth; // width of the bins of each variable
+         std::vector<UShort_t> fBins;     // bin of each event and variable, one column per variable
+         std::unordered_map<const TMVA::Event*, UInt_t> fRows; // row of each event in the columns
+
+         UInt_t GetNRows() const { return fRows.size(); }
+         const UShort_t *GetColumn(UInt_t ivar) const { return fBins.data() + std::size_t(ivar) * GetNRows(); }
+      };
+      static std::shared_ptr<const GlobalBinning> CreateGlobalBinning( const EventConstList & eventSample, Int_t nCuts,
+                                                                       const DataSetInfo* dataInfo = NULL );
+      // split the nodes with histograms of the shared bins instead of the node-local grid of TrainNodeFast
+      inline void SetGlobalBinning(std::shared_ptr<const GlobalBinning> binning) { fGlobalBinning = binning; }
+
    private:
       // utility functions
      
@@ -202,6 +222,8 @@ namespace TMVA {
       // calculates the purity S/(S+B) of a given event sample
       Double_t SamplePurity(EventList eventSample);
 
+      Double_t TrainNodeBinned( const EventConstList & eventSample,  DecisionTreeNode *node );
+
       UInt_t    fNvars;          // number of variables used to separate S and B
       Int_t     fNCuts;          // number of grid point in variable cut scans
       Bool_t    fUseFisherCuts;  // use multivariate splits using the Fisher criterium
@@ -240,6 +262,9 @@ namespace TMVA {
 
       DataSetInfo*  fDataSetInfo;
 
+      std::shared_ptr<const GlobalBinning> fGlobalBinning; //! shared bins of the training sample, see SetGlobalBinning()
+      std::map<const DecisionTreeNode*, std::vector<Double_t> > fNodeHistograms; //! histograms kept to derive those of the sibling nodes
+
       ClassDef(DecisionTree,0);               // implementation of a Decision Tree
    };
   
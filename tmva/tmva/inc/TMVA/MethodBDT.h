@@ -236,6 +236,7 @@ namespace TMVA {
       Bool_t                          fUseFisherCuts;   // use multivariate splits using the Fisher criterium
       Double_t                        fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t                          fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
+      Bool_t                          fUseGlobalBinning; // bin the variables once for all trees and split the nodes with histograms of these bins
       Bool_t                          fUseYesNoLeaf;    // use sig or bkg classification in leave nodes or sig/bkg
       Double_t                        fNodePurityLimit; // purity limit for sig/bkg nodes
       UInt_t                          fNNodesMax;       // max # of nodes
@@ -22,6 +22,14 @@
 #include "TMVA/RTensor.hxx"
 #include "TMVA/TreeInference/Forest.hxx"
 #include "TFile.h"
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
 
 #include <vector>
 #include <string>
@@ -92,11 +100,29 @@ public:
    std::vector<Value_t> Compute(const std::vector<Value_t> &x) { return this->Compute<std::vector<Value_t>>(x); }
 
    /// Compute model prediction on input RTensor
+   ///
+   /// If implicit multi-threading is enabled, the events of a tensor in row major layout are
+   /// split into blocks, which are processed in parallel.
    RTensor<Value_t> Compute(const RTensor<Value_t> &x)
    {
       const auto rows = x.GetShape()[0];
       RTensor<Value_t> y({rows, static_cast<std::size_t>(fNumOutputs)}, MemoryLayout::ColumnMajor);
       const bool layout = x.GetMemoryLayout() == MemoryLayout::ColumnMajor ? false : true;
+#ifdef R__USE_IMT
+      const std::size_t minRowsPerTask = 4096;
+      if (ROOT::IsImplicitMTEnabled() && layout && rows >= 2 * minRowsPerTask) {
+         const std::size_t numInputs = x.GetSize() / rows;
+         const std::size_t numTasks = std::min<std::size_t>(rows / minRowsPerTask, 4 * ROOT::GetThreadPoolSize());
+         auto computeBlock = [&](unsigned int task) {
+            const std::size_t begin = rows * task / numTasks;
+            const std::size_t end = rows * (task + 1) / numTasks;
+            for (int i = 0; i < fNumOutputs; i++)
+               fBackends[i].Inference(x.GetData() + begin * numInputs, end - begin, true, &y(begin, i));
+         };
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(computeBlock, ROOT::TSeqU(numTasks));
+      } else
+#endif
       for (int i = 0; i < fNumOutputs; i++)
          fBackends[i].Inference(x.GetData(), rows, layout, &y(0, i));
       if (fNormalizeOutputs) {
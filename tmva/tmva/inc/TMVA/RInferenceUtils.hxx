@@ -1,13 +1,29 @@
 #ifndef TMVA_RINFERENCEUTILS
 #define TMVA_RINFERENCEUTILS
 
+#include <cstddef>
+#include <type_traits>
 #include <utility> // std::forward, std::index_sequence
+#include <vector>
 
 namespace TMVA {
 namespace Experimental {
 
 namespace Internal {
 
+/// Detect models with the batch interface `void Compute(const T *input, T *output, std::size_t nEvents) const`
+/// and `std::size_t GetOutputSize() const`, such as RReader
+template <typename F, typename T, typename = void>
+struct HasBatchCompute : std::false_type {
+};
+
+template <typename F, typename T>
+struct HasBatchCompute<F, T,
+                       decltype(std::declval<const F &>().Compute(std::declval<const T *>(), std::declval<T *>(),
+                                                                 std::size_t(1)),
+                                void(std::declval<const F &>().GetOutputSize()))> : std::true_type {
+};
+
 /// Compute helper
 template <typename I, typename T, typename F>
 class ComputeHelper;
@@ -18,9 +34,27 @@ class ComputeHelper<std::index_sequence<N...>, T, F> {
    using AlwaysT = T;
    F fFunc;
 
+   /// Evaluate the model through its batch interface, on inputs stored on the stack
+   std::vector<T> Call(std::true_type, AlwaysT<N>... args)
+   {
+      const T input[] = {args...};
+      std::vector<T> output(fFunc.GetOutputSize());
+      fFunc.Compute(input, output.data(), 1);
+      return output;
+   }
+
+   auto Call(std::false_type, AlwaysT<N>... args) -> decltype(fFunc.Compute({args...}))
+   {
+      return fFunc.Compute({args...});
+   }
+
 public:
    ComputeHelper(F &&f) : fFunc(std::forward<F>(f)) {}
-   auto operator()(AlwaysT<N>... args) -> decltype(fFunc.Compute({args...})) { return fFunc.Compute({args...}); }
+   auto operator()(AlwaysT<N>... args)
+      -> decltype(this->Call(HasBatchCompute<typename std::decay<F>::type, T>{}, args...))
+   {
+      return Call(HasBatchCompute<typename std::decay<F>::type, T>{}, args...);
+   }
 };
 
 } // namespace Internal
@@ -4,10 +4,15 @@
 #include "TString.h"
 #include "TXMLEngine.h"
 
+#include "TMath.h"
+#include "TMVA/MethodBase.h"
 #include "TMVA/RTensor.hxx"
 #include "TMVA/Reader.h"
+#include "ROOT/RSpan.hxx"
+#include "TVirtualRWMutex.h"
 
 #include <memory> // std::unique_ptr
+#include <mutex>
 #include <sstream> // std::stringstream
 
 namespace TMVA {
@@ -25,10 +30,11 @@ struct XMLConfig {
    std::vector<std::string> expressions;
    unsigned int numClasses;
    std::vector<std::string> classes;
+   unsigned int numTargets;
    AnalysisType analysisType;
    XMLConfig()
       : numVariables(0), variables(std::vector<std::string>(0)), numClasses(0), classes(std::vector<std::string>(0)),
-        analysisType(Internal::AnalysisType::Undefined)
+        numTargets(0), analysisType(Internal::AnalysisType::Undefined)
    {
    }
 };
@@ -68,6 +74,10 @@ inline XMLConfig ParseXMLConfig(const std::string &filename)
             c.classes.push_back(xml.GetAttr(thisNode, "Name"));
          }
       }
+      // Read out number of regression targets
+      else if (nodeName.compare("Targets") == 0) {
+         c.numTargets = std::atoi(xml.GetAttr(node, "NTrgt"));
+      }
       // Read out analysis type
       else if (nodeName.compare("GeneralInfo") == 0) {
          std::string analysisType = "";
@@ -107,22 +117,78 @@ inline XMLConfig ParseXMLConfig(const std::string &filename)
    return c;
 }
 
+/// TMVA::Reader with its input variables and booked method, evaluated by one thread at a time
+struct ReaderInstance {
+   std::unique_ptr<Reader> fReader;
+   std::vector<float> fValues;
+   MethodBase *fMethod = nullptr;
+};
+
+/// Readers of an RReader which are not in use
+struct ReaderPool {
+   std::mutex fMutex;
+   std::vector<std::unique_ptr<ReaderInstance>> fReaders;
+};
+
 } // namespace Internal
 
 /// TMVA::Reader legacy interface
+///
+/// The model is not modified by the evaluation, and Compute() can be called concurrently from several
+/// threads on the same RReader. A TMVA::Reader is not thread-safe, hence the RReader keeps a pool of
+/// readers of the same weight file: every call of Compute() takes a reader from the pool for the
+/// evaluation of its whole batch of events, and a new reader is only booked if all readers are in use.
 class RReader {
 private:
-   std::unique_ptr<Reader> fReader;
-   std::vector<float> fValues;
+   std::string fPath;
    std::vector<std::string> fVariables;
    std::vector<std::string> fExpressions;
    unsigned int fNumClasses;
+   unsigned int fNumTargets;
    const char *name = "RReader";
    Internal::AnalysisType fAnalysisType;
 
+   std::unique_ptr<Internal::ReaderPool> fPool;
+
+   std::unique_ptr<Internal::ReaderInstance> MakeReader() const
+   {
+      auto instance = std::make_unique<Internal::ReaderInstance>();
+      // Booking a method goes through the global state of TMVA
+      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      instance->fReader = std::make_unique<Reader>("Silent");
+      const auto numVars = fVariables.size();
+      instance->fValues = std::vector<float>(numVars);
+      for (std::size_t i = 0; i < numVars; i++) {
+         instance->fReader->AddVariable(TString(fExpressions[i]), &instance->fValues[i]);
+      }
+      instance->fMethod = dynamic_cast<MethodBase *>(instance->fReader->BookMVA(name, fPath.c_str()));
+      if (!instance->fMethod)
+         throw std::runtime_error("Failed to book TMVA method from " + fPath + ".");
+      return instance;
+   }
+
+   std::unique_ptr<Internal::ReaderInstance> AcquireReader() const
+   {
+      {
+         std::lock_guard<std::mutex> lock(fPool->fMutex);
+         if (!fPool->fReaders.empty()) {
+            auto instance = std::move(fPool->fReaders.back());
+            fPool->fReaders.pop_back();
+            return instance;
+         }
+      }
+      return MakeReader();
+   }
+
+   void ReleaseReader(std::unique_ptr<Internal::ReaderInstance> instance) const
+   {
+      std::lock_guard<std::mutex> lock(fPool->fMutex);
+      fPool->fReaders.emplace_back(std::move(instance));
+   }
+
 public:
    /// Create TMVA model from XML file
-   RReader(const std::string &path)
+   RReader(const std::string &path) : fPath(path), fPool(std::make_unique<Internal::ReaderPool>())
    {
       // Load config
       auto c = Internal::ParseXMLConfig(path);
@@ -130,53 +196,89 @@ public:
       fExpressions = c.expressions;
       fAnalysisType = c.analysisType;
       fNumClasses = c.numClasses;
+      fNumTargets = c.numTargets > 0 ? c.numTargets : 1;
 
-      // Setup reader
-      fReader = std::make_unique<Reader>("Silent");
-      const auto numVars = fVariables.size();
-      fValues = std::vector<float>(numVars);
-      for (std::size_t i = 0; i < numVars; i++) {
-         fReader->AddVariable(TString(fExpressions[i]), &fValues[i]);
+      // Setup the first reader
+      fPool->fReaders.emplace_back(MakeReader());
+   }
+
+   /// Number of output values per event: one for classification, one per target for regression
+   /// and one per class for multiclass
+   std::size_t GetOutputSize() const
+   {
+      if (fAnalysisType == Internal::AnalysisType::Multiclass)
+         return fNumClasses;
+      if (fAnalysisType == Internal::AnalysisType::Regression)
+         return fNumTargets;
+      return 1;
+   }
+
+   /// \brief Compute model predictions on a batch of events
+   /// \param[in] input Input values of the events, nEvents rows of GetVariableNames().size() values
+   /// \param[out] output Output values of the events, nEvents rows of GetOutputSize() values
+   /// \param[in] nEvents Number of events
+   ///
+   /// This function is thread-safe and does not allocate memory, unless all readers of the pool are in use.
+   void Compute(const float *input, float *output, std::size_t nEvents) const
+   {
+      if (fAnalysisType == Internal::AnalysisType::Undefined)
+         throw std::runtime_error("RReader has undefined analysis type.");
+
+      const std::size_t numVars = fVariables.size();
+      const std::size_t numOutputs = GetOutputSize();
+      auto instance = AcquireReader();
+      Reader &reader = *instance->fReader;
+      MethodBase *method = instance->fMethod;
+      for (std::size_t i = 0; i < nEvents; i++) {
+         const float *x = input + i * numVars;
+         float *y = output + i * numOutputs;
+         bool isNaN = false;
+         for (std::size_t j = 0; j < numVars; j++) {
+            instance->fValues[j] = x[j];
+            isNaN |= TMath::IsNaN(x[j]);
+         }
+         // Classification
+         if (fAnalysisType == Internal::AnalysisType::Classification) {
+            // Same value as TMVA::Reader::EvaluateMVA for invalid inputs
+            y[0] = isNaN ? -999 : reader.EvaluateMVA(method);
+         }
+         // Regression
+         else if (fAnalysisType == Internal::AnalysisType::Regression) {
+            const auto &values = reader.EvaluateRegression(method);
+            std::copy_n(values.begin(), std::min(numOutputs, values.size()), y);
+         }
+         // Multiclass
+         else {
+            const auto &values = reader.EvaluateMulticlass(method);
+            std::copy_n(values.begin(), std::min(numOutputs, values.size()), y);
+         }
       }
-      fReader->BookMVA(name, path.c_str());
+      ReleaseReader(std::move(instance));
+   }
+
+   /// Compute model predictions on a batch of events stored in spans, see Compute(const float *, float *, std::size_t)
+   void Compute(std::span<const float> input, std::span<float> output, std::size_t nEvents) const
+   {
+      if (input.size() < nEvents * fVariables.size())
+         throw std::runtime_error("Size of input span is smaller than number of events times number of variables.");
+      if (output.size() < nEvents * GetOutputSize())
+         throw std::runtime_error("Size of output span is smaller than number of events times number of outputs.");
+      Compute(input.data(), output.data(), nEvents);
    }
 
    /// Compute model prediction on vector
-   std::vector<float> Compute(const std::vector<float> &x)
+   std::vector<float> Compute(const std::vector<float> &x) const
    {
       if (x.size() != fVariables.size())
          throw std::runtime_error("Size of input vector is not equal to number of variables.");
 
-      // Copy over inputs to memory used by TMVA reader
-      for (std::size_t i = 0; i < x.size(); i++) {
-         fValues[i] = x[i];
-      }
-
-      // Take lock to protect model evaluation
-      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
-      // Evaluate TMVA model
-      // Classification
-      if (fAnalysisType == Internal::AnalysisType::Classification) {
-         return std::vector<float>({static_cast<float>(fReader->EvaluateMVA(name))});
-      }
-      // Regression
-      else if (fAnalysisType == Internal::AnalysisType::Regression) {
-         return fReader->EvaluateRegression(name);
-      }
-      // Multiclass
-      else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
-         return fReader->EvaluateMulticlass(name);
-      }
-      // Throw error
-      else {
-         throw std::runtime_error("RReader has undefined analysis type.");
-         return std::vector<float>();
-      }
+      std::vector<float> y(GetOutputSize());
+      Compute(x.data(), y.data(), 1);
+      return y;
    }
 
    /// Compute model prediction on input RTensor
-   RTensor<float> Compute(RTensor<float> &x)
+   RTensor<float> Compute(RTensor<float> &x) const
    {
       // Error-handling for input tensor
       const auto shape = x.GetShape();
@@ -197,31 +299,33 @@ public:
          y = y.Reshape({numEntries, numClasses});
 
       // Fill output tensor
-      for (std::size_t i = 0; i < numEntries; i++) {
-         for (std::size_t j = 0; j < numVars; j++) {
-            fValues[j] = x(i, j);
-         }
-         R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
-         // Classification
-         if (fAnalysisType == Internal::AnalysisType::Classification) {
-            y(i) = fReader->EvaluateMVA(name);
-         }
-         // Regression
-         else if (fAnalysisType == Internal::AnalysisType::Regression) {
-            y(i) = fReader->EvaluateRegression(name)[0];
-         }
-         // Multiclass
-         else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
-            const auto p = fReader->EvaluateMulticlass(name);
-            for (std::size_t k = 0; k < numClasses; k++)
-               y(i, k) = p[k];
+      const std::size_t numOutputs = GetOutputSize();
+      const bool contiguous = x.GetMemoryLayout() == MemoryLayout::RowMajor &&
+                              x.GetStrides() == Internal::ComputeStridesFromShape(shape, MemoryLayout::RowMajor);
+      // Regression tensors only hold the first target
+      if (contiguous && (fAnalysisType != Internal::AnalysisType::Regression || numOutputs == 1)) {
+         Compute(x.GetData(), y.GetData(), numEntries);
+      } else {
+         std::vector<float> input(numVars);
+         std::vector<float> output(numOutputs);
+         for (std::size_t i = 0; i < numEntries; i++) {
+            for (std::size_t j = 0; j < numVars; j++) {
+               input[j] = x(i, j);
+            }
+            Compute(input.data(), output.data(), 1);
+            if (fAnalysisType == Internal::AnalysisType::Multiclass) {
+               for (std::size_t k = 0; k < numClasses; k++)
+                  y(i, k) = output[k];
+            } else {
+               y(i) = output[0];
+            }
          }
       }
 
       return y;
    }
 
-   std::vector<std::string> GetVariableNames() { return fVariables; }
+   std::vector<std::string> GetVariableNames() const { return fVariables; }
 };
 
 } // namespace Experimental
@@ -0,0 +1,334 @@
+#ifndef TMVA_RSTREAMINGDATALOADER
+#define TMVA_RSTREAMINGDATALOADER
+
+#include "TMVA/RTensor.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+#include "TMatrixT.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace TMVA {
+namespace Experimental {
+
+/// \brief Stream the training data of a dataframe in batches, without loading the whole dataset in memory
+///
+/// The event loop of the dataframe runs in a background thread, which gathers the entries in chunks
+/// of `chunkSize` entries. At most `nPrefetch` chunks wait in memory to be consumed, the event loop
+/// is paused while the queue is full. The entries of every chunk are shuffled before it is queued.
+/// With implicit multi-threading, each processing slot fills its own chunks, such that the entries
+/// are also mixed across the dataset.
+///
+/// Every call of StartEpoch() runs the event loop again, and the epoch is consumed either in batches
+/// of RTensor with GetNextBatch(), or chunk by chunk with GetNextChunk(), whose matrices are in the
+/// layout of DNN::TensorInput, such that a DNN::TTensorDataLoader can cut them into batches:
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// RStreamingDataLoader<float> loader(df, {"x", "y", "z"}, {"label"}, "weight", 256);
+/// loader.StartEpoch();
+/// while (auto batch = loader.GetNextBatch()) {
+///    // batch->fX is [n, 3], batch->fY is [n, 1] and batch->fWeights is [n]
+/// }
+///
+/// std::vector<TMatrixT<Double_t>> inputs;
+/// TMatrixT<Double_t> outputs, weights;
+/// loader.StartEpoch();
+/// while (loader.GetNextChunk(inputs, outputs, weights)) {
+///    const std::size_t n = outputs.GetNrows();
+///    DNN::TTensorDataLoader<DNN::TensorInput, DNN::TCpu<Float_t>> chunkLoader(
+///       DNN::TensorInput(inputs, outputs, weights), n, batchSize, {1, 1, 3}, {1, batchSize, 3}, 1);
+///    for (auto batch : chunkLoader) { ... }
+/// }
+/// ~~~
+/// The columns are read through a jitted Define, hence they may have any arithmetic type.
+template <typename T>
+class RStreamingDataLoader {
+   static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                 "RStreamingDataLoader supports only float and double");
+
+public:
+   /// Batch of entries, with the features of shape [n, nFeatures], the targets [n, nTargets] and the weights [n]
+   struct RBatch {
+      RTensor<T> fX;
+      RTensor<T> fY;
+      RTensor<T> fWeights;
+   };
+
+private:
+   /// Entries read by the event loop, one row with the features, the targets and the weight per entry
+   struct RChunk {
+      std::vector<T> fData;
+      std::size_t fNRows = 0;
+   };
+
+   static const char *GetRowColumn() { return "tmva_streaming_row"; }
+
+   ROOT::RDF::RNode fRows; ///< Node defining the column with the row of each entry
+   std::size_t fNFeatures;
+   std::size_t fNTargets;
+   std::size_t fBatchSize;
+   std::size_t fChunkSize;
+   std::size_t fNPrefetch;
+   bool fShuffle;
+   unsigned int fSeed;
+   unsigned int fEpoch = 0;
+
+   std::thread fProducer;
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   std::deque<RChunk> fQueue;       ///< Chunks ready to be consumed
+   bool fDone = true;               ///< The event loop of the current epoch has finished
+   std::atomic<bool> fStop{false};  ///< The consumer gave up the current epoch
+   std::exception_ptr fError;       ///< Exception thrown by the event loop
+
+   RChunk fCurrent;                 ///< Chunk being cut into batches
+   std::size_t fCurrentRow = 0;
+
+   std::size_t GetRowSize() const { return fNFeatures + fNTargets + 1; }
+
+   static std::string MakeRowExpression(const std::vector<std::string> &features,
+                                        const std::vector<std::string> &targets, const std::string &weight)
+   {
+      const std::string type = std::is_same<T, float>::value ? "float" : "double";
+      std::string expr = "ROOT::VecOps::RVec<" + type + ">{";
+      for (const auto &col : features)
+         expr += "static_cast<" + type + ">(" + col + "), ";
+      for (const auto &col : targets)
+         expr += "static_cast<" + type + ">(" + col + "), ";
+      expr += weight.empty() ? "static_cast<" + type + ">(1)" : "static_cast<" + type + ">(" + weight + ")";
+      return expr + "}";
+   }
+
+   void ShuffleRows(RChunk &chunk, std::mt19937 &generator) const
+   {
+      const std::size_t rowSize = GetRowSize();
+      std::vector<std::size_t> order(chunk.fNRows);
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), generator);
+      std::vector<T> data(chunk.fData.size());
+      for (std::size_t i = 0; i < chunk.fNRows; i++)
+         std::copy_n(chunk.fData.begin() + order[i] * rowSize, rowSize, data.begin() + i * rowSize);
+      chunk.fData.swap(data);
+   }
+
+   /// Queue a chunk filled by the event loop, waiting while the queue is full.
+   void Push(RChunk &chunk, std::mt19937 &generator)
+   {
+      if (fShuffle)
+         ShuffleRows(chunk, generator);
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCondition.wait(lock, [this] { return fQueue.size() < fNPrefetch || fStop; });
+         if (!fStop)
+            fQueue.emplace_back(std::move(chunk));
+      }
+      fCondition.notify_all();
+      chunk = RChunk();
+      chunk.fData.reserve(fChunkSize * GetRowSize());
+   }
+
+   /// Run the event loop of one epoch, executed by the background thread.
+   void Produce(unsigned int epoch)
+   {
+      try {
+         const unsigned int nSlots = fRows.GetNSlots();
+         std::vector<RChunk> chunks(nSlots);
+         std::vector<std::mt19937> generators;
+         for (unsigned int slot = 0; slot < nSlots; slot++)
+            generators.emplace_back(fSeed + epoch * nSlots + slot);
+
+         auto fill = [&](unsigned int slot, const ROOT::VecOps::RVec<T> &row) {
+            if (fStop)
+               return;
+            RChunk &chunk = chunks[slot];
+            chunk.fData.insert(chunk.fData.end(), row.begin(), row.end());
+            if (++chunk.fNRows == fChunkSize)
+               Push(chunk, generators[slot]);
+         };
+         fRows.ForeachSlot(fill, {GetRowColumn()});
+         for (unsigned int slot = 0; slot < nSlots; slot++) {
+            if (chunks[slot].fNRows > 0 && !fStop)
+               Push(chunks[slot], generators[slot]);
+         }
+      } catch (...) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fError = std::current_exception();
+      }
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fDone = true;
+      }
+      fCondition.notify_all();
+   }
+
+   /// Wait for the next chunk of the epoch. Return false at the end of the epoch.
+   bool PopChunk(RChunk &chunk)
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return !fQueue.empty() || fDone; });
+      if (fError) {
+         std::exception_ptr error = fError;
+         fError = nullptr;
+         std::rethrow_exception(error);
+      }
+      if (fQueue.empty())
+         return false;
+      chunk = std::move(fQueue.front());
+      fQueue.pop_front();
+      lock.unlock();
+      fCondition.notify_all();
+      return true;
+   }
+
+   void StopProducer()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = true;
+      }
+      fCondition.notify_all();
+      if (fProducer.joinable())
+         fProducer.join();
+   }
+
+public:
+   /// \brief Construct a loader of the entries of a dataframe
+   /// \param[in] df Dataframe node, e.g. reading a TTree or an RNTuple
+   /// \param[in] features Columns of the features
+   /// \param[in] targets Columns of the targets, e.g. the class label
+   /// \param[in] weight Column of the weights of the entries, all weights are 1 if empty
+   /// \param[in] batchSize Number of entries in the batches returned by GetNextBatch()
+   /// \param[in] chunkSize Number of entries read and shuffled together
+   /// \param[in] nPrefetch Maximum number of chunks read ahead by the background thread
+   /// \param[in] shuffle Shuffle the entries of every chunk
+   /// \param[in] seed Seed of the shuffling, which changes with every epoch
+   RStreamingDataLoader(ROOT::RDF::RNode df, const std::vector<std::string> &features,
+                        const std::vector<std::string> &targets, const std::string &weight = "",
+                        std::size_t batchSize = 32, std::size_t chunkSize = 100000, std::size_t nPrefetch = 2,
+                        bool shuffle = true, unsigned int seed = 0)
+      : fRows(df.Define(GetRowColumn(), MakeRowExpression(features, targets, weight))), fNFeatures(features.size()),
+        fNTargets(targets.size()), fBatchSize(batchSize), fChunkSize(chunkSize), fNPrefetch(nPrefetch),
+        fShuffle(shuffle), fSeed(seed)
+   {
+      if (features.empty() || targets.empty())
+         throw std::runtime_error("RStreamingDataLoader: features and targets must not be empty.");
+      if (batchSize == 0 || chunkSize == 0 || nPrefetch == 0)
+         throw std::runtime_error("RStreamingDataLoader: batch size, chunk size and number of prefetched chunks must be positive.");
+      // the event loop, and its jitting, run in the background thread
+      ROOT::EnableThreadSafety();
+   }
+
+   RStreamingDataLoader(const RStreamingDataLoader &) = delete;
+   RStreamingDataLoader &operator=(const RStreamingDataLoader &) = delete;
+
+   ~RStreamingDataLoader() { StopProducer(); }
+
+   std::size_t GetNFeatures() const { return fNFeatures; }
+   std::size_t GetNTargets() const { return fNTargets; }
+   std::size_t GetBatchSize() const { return fBatchSize; }
+
+   /// Start reading the dataset in the background. An epoch in progress is abandoned, its event loop
+   /// still runs to the end of the dataset, but without reading the columns into chunks.
+   void StartEpoch()
+   {
+      StopProducer();
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fQueue.clear();
+         fDone = false;
+         fError = nullptr;
+      }
+      fStop = false;
+      fCurrent = RChunk();
+      fCurrentRow = 0;
+      const unsigned int epoch = fEpoch++;
+      fProducer = std::thread([this, epoch] { Produce(epoch); });
+   }
+
+   /// \brief Return the next batch of the epoch
+   /// \return Batch of batchSize entries, fewer for the last batch of the epoch, or nullptr at the end of the epoch
+   std::unique_ptr<RBatch> GetNextBatch()
+   {
+      const std::size_t rowSize = GetRowSize();
+      std::vector<T> rows;
+      rows.reserve(fBatchSize * rowSize);
+      std::size_t n = 0;
+      while (n < fBatchSize) {
+         if (fCurrentRow == fCurrent.fNRows) {
+            if (!PopChunk(fCurrent))
+               break;
+            fCurrentRow = 0;
+            continue;
+         }
+         const std::size_t take = std::min(fBatchSize - n, fCurrent.fNRows - fCurrentRow);
+         rows.insert(rows.end(), fCurrent.fData.begin() + fCurrentRow * rowSize,
+                     fCurrent.fData.begin() + (fCurrentRow + take) * rowSize);
+         fCurrentRow += take;
+         n += take;
+      }
+      if (n == 0)
+         return nullptr;
+
+      std::unique_ptr<RBatch> batch(
+         new RBatch{RTensor<T>({n, fNFeatures}), RTensor<T>({n, fNTargets}), RTensor<T>({n})});
+      T *x = batch->fX.GetData();
+      T *y = batch->fY.GetData();
+      T *w = batch->fWeights.GetData();
+      for (std::size_t i = 0; i < n; i++) {
+         const auto row = rows.begin() + i * rowSize;
+         std::copy_n(row, fNFeatures, x + i * fNFeatures);
+         std::copy_n(row + fNFeatures, fNTargets, y + i * fNTargets);
+         w[i] = row[fNFeatures + fNTargets];
+      }
+      return batch;
+   }
+
+   /// \brief Fill the next chunk of the epoch in the layout of DNN::TensorInput
+   /// \param[out] inputs One matrix [n, nFeatures] with the features
+   /// \param[out] outputs Matrix [n, nTargets] with the targets
+   /// \param[out] weights Matrix [n, 1] with the weights
+   /// \return False at the end of the epoch
+   bool GetNextChunk(std::vector<TMatrixT<Double_t>> &inputs, TMatrixT<Double_t> &outputs,
+                     TMatrixT<Double_t> &weights)
+   {
+      if (fCurrentRow == fCurrent.fNRows) {
+         if (!PopChunk(fCurrent))
+            return false;
+         fCurrentRow = 0;
+      }
+      const std::size_t rowSize = GetRowSize();
+      const Int_t n = fCurrent.fNRows - fCurrentRow;
+      inputs.assign(1, TMatrixT<Double_t>(n, fNFeatures));
+      outputs.ResizeTo(n, fNTargets);
+      weights.ResizeTo(n, 1);
+      for (Int_t i = 0; i < n; i++) {
+         const auto row = fCurrent.fData.begin() + (fCurrentRow + i) * rowSize;
+         for (std::size_t j = 0; j < fNFeatures; j++)
+            inputs[0](i, j) = row[j];
+         for (std::size_t j = 0; j < fNTargets; j++)
+            outputs(i, j) = row[fNFeatures + j];
+         weights(i, 0) = row[fNFeatures + fNTargets];
+      }
+      fCurrentRow = fCurrent.fNRows;
+      return true;
+   }
+};
+
+} // namespace Experimental
+} // namespace TMVA
+
+#endif // TMVA_RSTREAMINGDATALOADER
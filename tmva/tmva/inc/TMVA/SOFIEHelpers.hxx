@@ -0,0 +1,147 @@
+#ifndef TMVA_SOFIEHELPERS
+#define TMVA_SOFIEHELPERS
+
+#include "ROOT/RDF/ActionHelpers.hxx"
+#include "TROOT.h"
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility> // std::index_sequence
+#include <vector>
+
+class TTreeReader;
+
+namespace TMVA {
+namespace Experimental {
+
+namespace Internal {
+
+/// Functor evaluating a model generated by SOFIE on one entry, with one session per processing slot
+template <typename I, typename Session_t, typename T>
+class SofieFunctorHelper;
+
+template <std::size_t... N, typename Session_t, typename T>
+class SofieFunctorHelper<std::index_sequence<N...>, Session_t, T> {
+   template <std::size_t Idx>
+   using AlwaysT = T;
+   std::vector<std::vector<float>> fInputs;
+   std::vector<std::shared_ptr<Session_t>> fSessions;
+
+public:
+   SofieFunctorHelper(unsigned int nSlots) : fInputs(nSlots)
+   {
+      for (unsigned int i = 0; i < nSlots; ++i)
+         fSessions.emplace_back(std::make_shared<Session_t>());
+   }
+
+   std::vector<float> operator()(unsigned int slot, AlwaysT<N>... args)
+   {
+      auto &input = fInputs[slot];
+      input = {static_cast<float>(args)...};
+      return fSessions[slot]->infer(input.data());
+   }
+};
+
+} // namespace Internal
+
+/// Helper to evaluate a model generated by SOFIE in RDataFrame.DefineSlot nodes.
+/// The N columns of type T are the input tensor of the model, which must have been generated
+/// with a batch size of 1. Every processing slot runs its own session.
+/// ~~~{.cpp}
+/// auto df2 = df.DefineSlot("output", SofieFunctor<3, TMVA_SOFIE_model::Session>(nSlots), {"x", "y", "z"});
+/// ~~~
+template <std::size_t N, typename Session_t, typename T = float>
+auto SofieFunctor(unsigned int nSlots = 0) -> Internal::SofieFunctorHelper<std::make_index_sequence<N>, Session_t, T>
+{
+   if (nSlots == 0)
+      nSlots = ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1;
+   return Internal::SofieFunctorHelper<std::make_index_sequence<N>, Session_t, T>(nSlots);
+}
+
+/// RDataFrame action which evaluates a model generated by SOFIE on batches of entries.
+///
+/// The values of the columns of Session_t::kBatchSize entries are gathered in each processing slot,
+/// and the model runs once for the whole batch, such that every layer is a single matrix multiplication.
+/// The model must have one input tensor, of shape [kBatchSize, number of columns]. The last batch
+/// of each slot is padded with zeros.
+///
+/// The result contains the output of the model for each entry. With implicit multi-threading, the
+/// entries are grouped by processing slot, instead of following the order of the dataset.
+/// ~~~{.cpp}
+/// model.Generate(256); // code of TMVA_SOFIE_model::Session, for batches of 256 entries
+/// ...
+/// auto outputs = df.Book<float, float, float>(SofieBatchHelper<TMVA_SOFIE_model::Session>(), {"x", "y", "z"});
+/// ~~~
+template <typename Session_t>
+class SofieBatchHelper : public ROOT::Detail::RDF::RActionImpl<SofieBatchHelper<Session_t>> {
+public:
+   using Result_t = std::vector<std::vector<float>>;
+
+private:
+   std::shared_ptr<Result_t> fResult;
+   std::vector<std::unique_ptr<Session_t>> fSessions;
+   std::vector<std::vector<float>> fInputs; // Values of the batch being gathered, one vector per slot
+   std::vector<std::size_t> fNEntries;      // Number of entries in the batch being gathered
+   std::vector<Result_t> fOutputs;          // Outputs of the entries processed by each slot
+
+   void RunBatch(unsigned int slot)
+   {
+      const std::size_t batchSize = Session_t::kBatchSize;
+      const std::size_t nEntries = fNEntries[slot];
+      if (nEntries == 0)
+         return;
+      auto &input = fInputs[slot];
+      const std::size_t entrySize = input.size() / nEntries;
+      input.resize(batchSize * entrySize, 0.f);
+      const std::vector<float> output = fSessions[slot]->infer(input.data());
+      const std::size_t outputSize = output.size() / batchSize;
+      for (std::size_t i = 0; i < nEntries; ++i)
+         fOutputs[slot].emplace_back(output.begin() + i * outputSize, output.begin() + (i + 1) * outputSize);
+      input.clear();
+      fNEntries[slot] = 0;
+   }
+
+public:
+   SofieBatchHelper() : fResult(std::make_shared<Result_t>())
+   {
+      const unsigned int nSlots = ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1;
+      for (unsigned int i = 0; i < nSlots; ++i)
+         fSessions.emplace_back(new Session_t());
+      fInputs.resize(nSlots);
+      fNEntries.resize(nSlots, 0);
+      fOutputs.resize(nSlots);
+   }
+   SofieBatchHelper(SofieBatchHelper &&) = default;
+   SofieBatchHelper(const SofieBatchHelper &) = delete;
+
+   std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+   void Initialize() {}
+   void InitTask(TTreeReader *, unsigned int) {}
+   std::string GetActionName() { return "SofieBatch"; }
+
+   template <typename... ColumnTypes>
+   void Exec(unsigned int slot, ColumnTypes... values)
+   {
+      auto &input = fInputs[slot];
+      for (auto &&val : {static_cast<float>(values)...})
+         input.push_back(val);
+      if (++fNEntries[slot] == Session_t::kBatchSize)
+         RunBatch(slot);
+   }
+
+   void Finalize()
+   {
+      for (unsigned int slot = 0; slot < fSessions.size(); ++slot) {
+         RunBatch(slot);
+         fResult->insert(fResult->end(), std::make_move_iterator(fOutputs[slot].begin()),
+                         std::make_move_iterator(fOutputs[slot].end()));
+         fOutputs[slot].clear();
+      }
+   }
+};
+
+} // namespace Experimental
+} // namespace TMVA
+
+#endif // TMVA_SOFIEHELPERS
@@ -65,6 +65,8 @@ struct BranchlessTree {
    std::vector<int> fInputs;   ///< Cut variables / inputs
 
    inline T Inference(const T *input, const int stride);
+   inline void InferenceBatch(const T *inputs, const int rows, const int strideTree, const int strideBatch,
+                              int *indices, T *predictions);
    inline void FillSparse();
    inline std::string GetInferenceCode(const std::string& funcName, const std::string& typeName);
 };
@@ -83,6 +85,33 @@ inline T BranchlessTree<T>::Inference(const T *input, const int stride)
    return fThresholds[index];
 }
 
+/// Perform inference on a block of input vectors and add the tree scores to the predictions
+///
+/// The events are traversed together, one level of the tree after the other, so that the
+/// loop over the events has no dependencies between its iterations and can be vectorized.
+/// \param[in] inputs Pointer to data containing the input values of the first event
+/// \param[in] rows Number of events
+/// \param[in] strideTree Stride to go from one input variable to the next one
+/// \param[in] strideBatch Stride to go from one event to the next one
+/// \param[in] indices Buffer for the node indices, with space for rows values
+/// \param[in] predictions Pointer to the buffer of the predictions, to which the tree scores are added
+template <typename T>
+inline void BranchlessTree<T>::InferenceBatch(const T *inputs, const int rows, const int strideTree,
+                                              const int strideBatch, int *indices, T *predictions)
+{
+   const int *cutInputs = fInputs.data();
+   const T *thresholds = fThresholds.data();
+   std::fill(indices, indices + rows, 0);
+   for (int level = 0; level < fTreeDepth; ++level) {
+      for (int i = 0; i < rows; ++i) {
+         const int index = indices[i];
+         indices[i] = 2 * index + 1 + (inputs[i * strideBatch + cutInputs[index] * strideTree] > thresholds[index]);
+      }
+   }
+   for (int i = 0; i < rows; ++i)
+      predictions[i] += thresholds[indices[i]];
+}
+
 /// Fill nodes of a sparse tree forming a full tree
 ///
 /// Sparse parts of the tree are marked with -1 values in the feature vector. The
@@ -70,11 +70,16 @@ struct ForestBase {
    ForestType fTrees;                  ///< Store the forest, either as vector or jitted function
    int fNumInputs;                     ///< Number of input variables
 
+   static constexpr int kBlockSize = 64; ///< Number of events traversing the trees together
+
    void Inference(const T *inputs, const int rows, bool layout, T *predictions);
 };
 
 /// Perform inference of the forest on a batch of inputs
 ///
+/// The events are processed in blocks of kBlockSize, which traverse all trees together
+/// while their inputs stay in the cache, see BranchlessTree::InferenceBatch.
+///
 /// \param[in] inputs Pointer to data containing the inputs
 /// \param[in] rows Number of events in inputs vector
 /// \param[in] layout Row major (true) or column major (false) memory layout
@@ -84,12 +89,15 @@ inline void ForestBase<T, ForestType>::Inference(const T *inputs, const int rows
 {
    const auto strideTree = layout ? 1 : rows;
    const auto strideBatch = layout ? fNumInputs : 1;
-   for (int i = 0; i < rows; i++) {
-      predictions[i] = 0.0;
+   int indices[kBlockSize];
+   for (int begin = 0; begin < rows; begin += kBlockSize) {
+      const int n = std::min(kBlockSize, rows - begin);
+      std::fill(predictions + begin, predictions + begin + n, 0.0);
       for (auto &tree : fTrees) {
-         predictions[i] += tree.Inference(inputs + i * strideBatch, strideTree);
+         tree.InferenceBatch(inputs + begin * strideBatch, n, strideTree, strideBatch, indices, predictions + begin);
       }
-      predictions[i] = fObjectiveFunc(predictions[i]);
+      for (int i = begin; i < begin + n; i++)
+         predictions[i] = fObjectiveFunc(predictions[i]);
    }
 }
 
@@ -17,6 +17,8 @@
 
 #include "TMVA/DNN/Architectures/Cpu.h"
 
+#include <algorithm>
+#include <atomic>
 
 #ifdef R__HAS_TMVACPU
 #include "TMVA/DNN/Architectures/Cpu/Blas.h"
@@ -27,7 +29,57 @@
 namespace TMVA {
 namespace DNN {
 
+namespace {
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the n outputs of a layer to the input of its activation function and apply the activation
+/// function in place, in a single pass over the data while it is still in cache. The functions are the
+/// same as in ActivationFunctions.hxx. Return false if the activation function is not supported here,
+/// it must then be applied with ActivationFunctionForward.
+template <typename AFloat>
+bool FusedActivationForward(AFloat *output, AFloat *activationInput, size_t n, EActivationFunction activFunc)
+{
+   switch (activFunc) {
+   case EActivationFunction::kIdentity:
+      std::copy(output, output + n, activationInput);
+      return true;
+   case EActivationFunction::kRelu:
+      for (size_t i = 0; i < n; i++) {
+         const AFloat x = output[i];
+         activationInput[i] = x;
+         output[i] = (x < 0.0) ? 0.0 : x;
+      }
+      return true;
+   case EActivationFunction::kSigmoid:
+      for (size_t i = 0; i < n; i++) {
+         const AFloat x = output[i];
+         activationInput[i] = x;
+         output[i] = 1.0 / (1.0 + exp(-x));
+      }
+      return true;
+   case EActivationFunction::kTanh:
+      for (size_t i = 0; i < n; i++) {
+         const AFloat x = output[i];
+         activationInput[i] = x;
+         output[i] = tanh(x);
+      }
+      return true;
+   default:
+      return false;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of tasks in which the events of a batch are processed, such that the
+/// work buffers are allocated once per task instead of once per event.
+template <typename AFloat>
+size_t GetNBatchTasks(size_t batchSize)
+{
+   const size_t poolSize = TCpuMatrix<AFloat>::GetThreadExecutor().GetPoolSize();
+   return std::max<size_t>(1, std::min(batchSize, poolSize));
+}
+
+} // namespace
 
 template <typename AFloat>
 void TCpu<AFloat>::MultiplyTranspose(TCpuMatrix<AFloat> &output, const TCpuMatrix<AFloat> &input,
@@ -347,32 +399,42 @@ void TCpu<AFloat>::ConvLayerForward(TCpuTensor<AFloat> & output,
    TCpuMatrix<AFloat>::InitializeOneVector(output.GetWSize());   // since it is used in AddCOnvBiases
 
 
-   auto f = [&] (UInt_t i)
+   const size_t batchSize = input.GetFirstSize();
+   const size_t nTasks = GetNBatchTasks<AFloat>(batchSize);
+   std::atomic<bool> fused{true};
+
+   auto f = [&] (UInt_t task)
    {
        // dropout not yet implemented for CNN
        // if (applyDropout && (dropoutProbability != 1.0)) {
        //    Dropout(input[i], dropoutProbability);
        // }
 
+       // Im2colFast sets all the elements, the buffer is reused for all the events of the task
        TCpuMatrix<AFloat> inputTr(nLocalViews, nLocalViewPixels);
-       //inputTr.Zero();   // this is not thread safe
 
-       Im2colFast(inputTr, input.At(i).GetMatrix(), forwardIndices);
+       for (size_t i = task * batchSize / nTasks; i < (task + 1) * batchSize / nTasks; i++) {
+          Im2colFast(inputTr, input.At(i).GetMatrix(), forwardIndices);
 
-       Matrix_t output_m = output.At(i).GetMatrix();
-       MultiplyTranspose(output_m, weights, inputTr);
-       AddConvBiases(output_m, biases);
+          Matrix_t output_m = output.At(i).GetMatrix();
+          MultiplyTranspose(output_m, weights, inputTr);
+          AddConvBiases(output_m, biases);
 
+          // save the output of the convolution (input to activation function) and apply the activation
+          Matrix_t inputActivationFunc_m = inputActivationFunc.At(i).GetMatrix();
+          if (!FusedActivationForward(output_m.GetRawDataPointer(), inputActivationFunc_m.GetRawDataPointer(),
+                                      output_m.GetNoElements(), activFunc))
+             fused = false;
+       }
    };
 
-   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(input.GetFirstSize()));
+   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(nTasks));
 
-   //evaluateDerivative<TCpu<AFloat>>(derivatives, activFunc, output);
-   // need to save output of convolution (input to activation function)
-   Copy(inputActivationFunc, output);
-
-   //evaluate<TCpu<AFloat>>(output, activFunc);
-   ActivationFunctionForward(output, activFunc, ActivationDescriptor_t());
+   if (!fused) {
+      // need to save output of convolution (input to activation function)
+      Copy(inputActivationFunc, output);
+      ActivationFunctionForward(output, activFunc, ActivationDescriptor_t());
+   }
 }
 
 //____________________________________________________________________________
@@ -467,26 +529,23 @@ void TCpu<AFloat>::CalculateConvActivationGradients(TCpuTensor<AFloat> &activati
     //for (size_t i = 0; i < batchSize; i++) {
     R__ASSERT(batchSize == df.GetFirstSize() );
     R__ASSERT(batchSize == activationGradientsBackward.GetFirstSize() );
-    auto f = [&] (UInt_t i)
+    const size_t nTasks = GetNBatchTasks<AFloat>(batchSize);
+    auto f = [&] (UInt_t task)
    {
        // Im2col(dfTr, df[i], height, width, filterHeight, filterWidth, tempStrideRows, tempStrideCols,
        //       tempZeroPaddingHeight, tempZeroPaddingWidth);
 
       TCpuMatrix<AFloat> dfTr(tempNLocalViews, tempNLocalViewPixels);
 
-      Im2colFast(dfTr, df.At(i).GetMatrix(), vIndices);
-
-       //TMVA_DNN_PrintTCpuMatrix(df[i],"df[i]");
-       //TMVA_DNN_PrintTCpuMatrix(dfTr,"dfTr");
-
-      Matrix_t agb_m = activationGradientsBackward.At(i).GetMatrix();
-      MultiplyTranspose(agb_m, rotWeights, dfTr);
-
-       //TMVA_DNN_PrintTCpuMatrix(activationGradientsBackward[i],"activGrad-result");
+      for (size_t i = task * batchSize / nTasks; i < (task + 1) * batchSize / nTasks; i++) {
+         Im2colFast(dfTr, df.At(i).GetMatrix(), vIndices);
 
+         Matrix_t agb_m = activationGradientsBackward.At(i).GetMatrix();
+         MultiplyTranspose(agb_m, rotWeights, dfTr);
+      }
    };
 
-    TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI( batchSize ) );
+    TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI( nTasks ) );
 }
 
 //____________________________________________________________________________
@@ -523,62 +582,41 @@ void TCpu<AFloat>::CalculateConvWeightGradients(TCpuMatrix<AFloat> &weightGradie
 
    //std::cout << "do back-propagation in conv layer - compute weight gradient" << std::endl;
 
-   // std::vector< TCpuMatrix<AFloat> > vres;//(batchSize);
-   // for (size_t i = 0; i < batchSize; i++) {
-   //    vres.emplace_back(depth, nLocalViewPixels);
-   //    //TMVA_DNN_PrintTCpuMatrix(df[i],"df");
-   //    //TMVA_DNN_PrintTCpuMatrix(activationsBackward[i],"df");
-
-   //}
-   //TCpuTensor<AFloat> vres( { batchSize, depth, nLocalViewPIxels} );
-   TCpuTensor<AFloat> vres( batchSize, depth, nLocalViewPixels);
+   // computing the gradient is equivalent of doing a convolution of the input using as conv kernel the delta's
+   // (the df[] values). N.B. only stride values=1 are now supported.
+   // Each task sums the gradients of its events, the sums of the tasks are added at the end.
+   const size_t nTasks = GetNBatchTasks<AFloat>(batchSize);
+   TCpuTensor<AFloat> vres(nTasks, depth, nLocalViewPixels);
 
-   auto fmap = [&](int i) {
-
-      //TMVA_DNN_PrintTCpuMatrix(df[i],"df-i");
+   auto fmap = [&](int task) {
       TCpuMatrix<AFloat> xTr(nLocalViews, nLocalViewPixels);
       TCpuMatrix<AFloat> res(depth, nLocalViewPixels);
-
-      //computing t he gradient is equivalent of doing a convolution of the input using as conv kernel the delta's (the df[] values)
-      //N.B. only stride values=1 are now supported
-
-      //xTr.Zero();
-      // Im2col(xTr, const_cast<TCpuMatrix<AFloat> &>(activationsBackward[i]), inputHeight, inputWidth, filterHeight , filterWidth,
-      //        tempStrideRows, tempStrideCols, tempZeroPaddingHeight, tempZeroPaddingWidth);
-      Im2colFast(xTr, activationsBackward.At(i).GetMatrix(), vIndices);
-
-      //std::cout << "doing im2colfast" << std::endl;
-      //TMVA_DNN_PrintTCpuMatrix(xTr,"xTr-i");
-      //TMVA_DNN_PrintTCpuMatrix(activationsBackward[i],"actbackward-i");
-      Matrix_t mres = vres.At(i).GetMatrix();
-      Multiply( mres, df.At(i).GetMatrix(), xTr);
-      //TMVA_DNN_PrintTCpuMatrix(vres[i],"res_ofMT");
-
-      return;
-      //return res;
+      Matrix_t sum = vres.At(task).GetMatrix();
+      AFloat *sumData = sum.GetRawDataPointer();
+      const AFloat *resData = res.GetRawDataPointer();
+      const size_t n = sum.GetNoElements();
+      std::fill(sumData, sumData + n, AFloat(0));
+
+      for (size_t i = task * batchSize / nTasks; i < (task + 1) * batchSize / nTasks; i++) {
+         Im2colFast(xTr, activationsBackward.At(i).GetMatrix(), vIndices);
+         Multiply(res, df.At(i).GetMatrix(), xTr);
+         for (size_t j = 0; j < n; j++)
+            sumData[j] += resData[j];
+      }
    };
 
-   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(fmap, ROOT::TSeqI( batchSize ) );
-
-//   auto freduce = [&](const TCpuTensor<AFloat> & vres) {
-      R__ASSERT(vres.GetFirstSize() == batchSize);
-      for (size_t i = 0; i < batchSize; i++) {
-         //TMVA_DNN_PrintTCpuMatrix(vres[i],"res");
-         Matrix_t vres_m = vres.At(i).GetMatrix();
-         for (size_t j = 0; j < depth; j++) {
-            for (size_t k = 0; k < filterDepth; k++) {
-               size_t kOffset = k * filterSize;
-               for (size_t l = 0; l < filterSize; l++) {
-                  //weightGradients(j, k * (filterHeight * filterWidth) + l) += res(k, (tempNLocalViews - 1) - l);
-                  weightGradients(j, kOffset + l) += vres_m(j,  kOffset + l);
-               }
-            }
-         }
-         // TMVA_DNN_PrintTCpuMatrix(weightGradients,"weights_i");
-      }
-      //  };
+   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(fmap, ROOT::TSeqI( nTasks ) );
+
+   // the columns of the weight gradients are the pixels of the local views, as for the results of the tasks
+   R__ASSERT(weightGradients.GetNrows() == depth);
+   AFloat *wgData = weightGradients.GetRawDataPointer();
+   for (size_t task = 0; task < nTasks; task++) {
+      Matrix_t sum = vres.At(task).GetMatrix();
+      const AFloat *sumData = sum.GetRawDataPointer();
+      for (size_t j = 0; j < sum.GetNoElements(); j++)
+         wgData[j] += sumData[j];
+   }
 
-   //TCpuMatrix<AFloat>::GetThreadExecutor().MapReduce(fmap, ROOT::TSeqI( batchSize ) , freduce);
    //TMVA_DNN_PrintTCpuMatrix(weightGradients,"W-Grad");
 }
 
@@ -588,15 +626,16 @@ void TCpu<AFloat>::CalculateConvBiasGradients(TCpuMatrix<AFloat> &biasGradients,
                                               size_t batchSize, size_t depth, size_t nLocalViews)
 {
    biasGradients.Zero();
-   for (size_t i = 0; i < depth; i++) {
-      AFloat sum = 0;
+   // the matrix of each event is column major, [depth, nLocalViews]
+   AFloat *bg = biasGradients.GetRawDataPointer();
+   for (size_t k = 0; k < batchSize; k++) {
+      const Matrix_t df_m = df.At(k).GetMatrix();
+      const AFloat *data = df_m.GetRawDataPointer();
       for (size_t j = 0; j < nLocalViews; j++) {
-         for (size_t k = 0; k < batchSize; k++) {
-            sum += df(k,i,j);
-            //sum += df[k](i, j);
+         for (size_t i = 0; i < depth; i++) {
+            bg[i] += data[j * depth + i];
          }
       }
-      biasGradients(i, 0) = sum;
    }
 }
 
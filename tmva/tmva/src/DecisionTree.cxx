@@ -221,7 +221,8 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fSigClass   (d.fSigClass),
    fTreeID     (d.fTreeID),
    fAnalysisType(d.fAnalysisType),
-   fDataSetInfo    (d.fDataSetInfo)
+   fDataSetInfo    (d.fDataSetInfo),
+   fGlobalBinning  (d.fGlobalBinning)
 {
    this->SetRoot( new TMVA::DecisionTreeNode ( *((DecisionTreeNode*)(d.GetRoot())) ) );
    this->SetParentTreeInNodes();
@@ -1268,6 +1269,253 @@ void TMVA::DecisionTree::GetRandomisedVariables(Bool_t *useVariable, UInt_t *map
    if (nSelectedVars != useNvars) { std::cout << "Bug in TrainNode - GetRandisedVariables()... sorry" << std::endl; std::exit(1);}
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Bin the variables of the events of a training sample once, such that all the
+/// trees of a forest can split their nodes with TrainNodeBinned() instead of
+/// recomputing the bins of the variables in every node.
+///
+/// Each variable gets nCuts+1 equidistant bins between its minimum and its
+/// maximum in the sample, integer variables (type 'I') one bin per value.
+
+std::shared_ptr<const TMVA::DecisionTree::GlobalBinning>
+TMVA::DecisionTree::CreateGlobalBinning( const EventConstList & eventSample, Int_t nCuts, const DataSetInfo* dataInfo )
+{
+   auto binning = std::make_shared<GlobalBinning>();
+   if (eventSample.empty()) return binning;
+
+   std::vector<const TMVA::Event*> events;
+   events.reserve(eventSample.size());
+   for (const TMVA::Event *ev : eventSample) {
+      if (binning->fRows.emplace(ev, events.size()).second) events.push_back(ev);
+   }
+
+   const UInt_t nvars = events[0]->GetNVariables();
+   const UInt_t nrows = events.size();
+   const UInt_t maxBins = std::numeric_limits<UShort_t>::max() + 1;
+   binning->fNBins.resize(nvars);
+   binning->fOffset.resize(nvars+1, 0);
+   binning->fXmin.resize(nvars);
+   binning->fBinWidth.resize(nvars);
+   binning->fBins.resize(std::size_t(nvars) * nrows);
+
+   auto binVariable = [&](UInt_t ivar) {
+      Double_t xmin = events[0]->GetValueFast(ivar);
+      Double_t xmax = xmin;
+      for (const TMVA::Event *ev : events) {
+         xmin = TMath::Min(xmin, Double_t(ev->GetValueFast(ivar)));
+         xmax = TMath::Max(xmax, Double_t(ev->GetValueFast(ivar)));
+      }
+      UInt_t nBins = nCuts+1;
+      Double_t binWidth = (xmax - xmin) / Double_t(nBins);
+      if (dataInfo && dataInfo->GetVariableInfo(ivar).GetVarType() == 'I' && xmax - xmin + 1 <= maxBins) {
+         nBins = UInt_t(xmax - xmin) + 1;
+         binWidth = 1;
+      }
+      nBins = TMath::Min(nBins, maxBins);
+      if (!(binWidth > 0)) binWidth = 1; // only one value, all events in the first bin
+      const Double_t invBinWidth = 1./binWidth;
+
+      UShort_t *column = binning->fBins.data() + std::size_t(ivar) * nrows;
+      for (UInt_t irow=0; irow<nrows; irow++) {
+         column[irow] = TMath::Min(Int_t(nBins-1), TMath::Max(0, int(invBinWidth*(events[irow]->GetValueFast(ivar)-xmin))));
+      }
+      binning->fNBins[ivar] = nBins;
+      binning->fXmin[ivar] = xmin;
+      binning->fBinWidth[ivar] = binWidth;
+      return 0;
+   };
+   TMVA::Config::Instance().GetThreadExecutor().Map(binVariable, ROOT::TSeqU(nvars));
+
+   for (UInt_t ivar=0; ivar<nvars; ivar++) binning->fOffset[ivar+1] = binning->fOffset[ivar] + binning->fNBins[ivar];
+
+   return binning;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decide how to split a node like TrainNodeFast(), but with the bins of the
+/// variables computed once for the whole training sample by CreateGlobalBinning().
+///
+/// The histograms of the node are filled in parallel, each thread looping over a
+/// partition of the events and reading the bins from the columns of the binning.
+/// As all the nodes share the same bins, the histograms of a left daughter are the
+/// histograms of its parent minus those of its right sibling, which BuildTree()
+/// trains first; they are then obtained without looping over the events.
+
+Double_t TMVA::DecisionTree::TrainNodeBinned( const EventConstList & eventSample,
+                                              TMVA::DecisionTreeNode *node )
+{
+   const GlobalBinning &binning = *fGlobalBinning;
+   const UInt_t nTotBins = binning.fOffset[fNvars];
+   const UInt_t nevents = eventSample.size();
+
+   // layout of the histograms: the sums of all the events of the node, then for each
+   // quantity one block with the bins of all variables
+   enum { kS, kB, kSUnWeighted, kBUnWeighted, kTarget, kTarget2, kNQuantities };
+   const UInt_t nQuantities = DoRegression() ? kNQuantities : kTarget;
+   auto index = [nTotBins](UInt_t quantity, UInt_t ibin) { return kNQuantities + quantity * nTotBins + ibin; };
+   const std::size_t histSize = index(nQuantities, 0);
+
+   std::vector<Bool_t> useVariable(fNvars, kTRUE);
+   if (fRandomisedTree) { // choose for each node splitting a random subset of variables to choose from
+      std::unique_ptr<Bool_t[]> useRandom(new Bool_t[fNvars+1]);
+      std::unique_ptr<UInt_t[]> mapVariable(new UInt_t[fNvars+1]);
+      UInt_t tmp=fUseNvars;
+      GetRandomisedVariables(useRandom.get(),mapVariable.get(),tmp);
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) useVariable[ivar] = useRandom[ivar];
+   }
+
+   // randomised trees only fill the variables they use, hence their histograms cannot be subtracted
+   const Bool_t fillAll = !fRandomisedTree;
+   auto parent = static_cast<TMVA::DecisionTreeNode*>(node->GetParent());
+   const Bool_t isLeft = parent && node == parent->GetLeft();
+   const Bool_t isRight = parent && node == parent->GetRight();
+   if (!parent) fNodeHistograms.clear();
+
+   std::vector<Double_t> hist;
+   if (fillAll && isLeft) {
+      auto itParent = fNodeHistograms.find(parent);
+      auto itSibling = fNodeHistograms.find(static_cast<TMVA::DecisionTreeNode*>(parent->GetRight()));
+      if (itParent != fNodeHistograms.end() && itSibling != fNodeHistograms.end()) {
+         hist = itParent->second;
+         const std::vector<Double_t> &sibling = itSibling->second;
+         for (std::size_t i=0; i<histSize; i++) hist[i] -= sibling[i];
+      }
+   }
+   if (isLeft) {
+      // the right sibling is done, and a parent that is itself a right daughter is still needed by its sibling
+      fNodeHistograms.erase(static_cast<TMVA::DecisionTreeNode*>(parent->GetRight()));
+      if (parent->GetParent() == nullptr || parent == parent->GetParent()->GetLeft()) fNodeHistograms.erase(parent);
+   }
+
+   if (hist.empty()) {
+      const UInt_t nPartitions = TMath::Max(1u, TMath::Min(TMVA::Config::Instance().GetThreadExecutor().GetPoolSize(), nevents/1000));
+      auto fillPartition = [&](UInt_t partition) {
+         std::vector<Double_t> h(histSize, 0.);
+         const UInt_t start = ULong64_t(nevents) * partition / nPartitions;
+         const UInt_t end = ULong64_t(nevents) * (partition+1) / nPartitions;
+         // one lookup of the rows in the binning, then the columns are read variable by variable
+         std::vector<UInt_t> rows(end-start);
+         std::vector<UInt_t> quantity(end-start);
+         std::vector<Double_t> weight(end-start), target(end-start);
+         for (UInt_t iev=start; iev<end; iev++) {
+            const TMVA::Event *ev = eventSample[iev];
+            const UInt_t i = iev - start;
+            rows[i] = binning.fRows.at(ev);
+            quantity[i] = ev->GetClass() == fSigClass ? kS : kB;
+            weight[i] = ev->GetWeight();
+            h[quantity[i]] += weight[i];
+            h[quantity[i] + kSUnWeighted] += 1;
+            if (DoRegression()) {
+               target[i] = ev->GetTarget(0);
+               h[kTarget] += weight[i]*target[i];
+               h[kTarget2] += weight[i]*target[i]*target[i];
+            }
+         }
+         for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+            if (!fillAll && !useVariable[ivar]) continue;
+            const UShort_t *column = binning.GetColumn(ivar);
+            const UInt_t offset = binning.fOffset[ivar];
+            for (UInt_t i=0; i<rows.size(); i++) {
+               const UInt_t ibin = offset + column[rows[i]];
+               h[index(quantity[i], ibin)] += weight[i];
+               h[index(quantity[i] + kSUnWeighted, ibin)] += 1;
+               if (DoRegression()) {
+                  h[index(kTarget, ibin)] += weight[i]*target[i];
+                  h[index(kTarget2, ibin)] += weight[i]*target[i]*target[i];
+               }
+            }
+         }
+         return h;
+      };
+      auto redfunc = [](const std::vector<std::vector<Double_t>> &v) {
+         std::vector<Double_t> sum = v[0];
+         for (std::size_t j=1; j<v.size(); j++) {
+            for (std::size_t i=0; i<sum.size(); i++) sum[i] += v[j][i];
+         }
+         return sum;
+      };
+      hist = nPartitions > 1 ? TMVA::Config::Instance().GetThreadExecutor().MapReduce(fillPartition, ROOT::TSeqU(nPartitions), redfunc)
+                             : fillPartition(0);
+   }
+
+   // keep the histograms if a daughter or the sibling may be derived from them
+   if (fillAll && (isRight || node->GetDepth()+1 < fMaxDepth)) fNodeHistograms[node] = hist;
+
+   const Double_t nTotS = hist[kS];
+   const Double_t nTotB = hist[kB];
+   const Double_t nTotS_unWeighted = hist[kSUnWeighted];
+   const Double_t nTotB_unWeighted = hist[kBUnWeighted];
+
+   Double_t separationGainTotal = -1;
+   Int_t mxVar = -1;
+   Int_t mxCutIndex = -1;
+   Double_t mxSelS = 0, mxSelB = 0;
+   std::vector<Double_t> cum(nQuantities);
+   for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+      if (!useVariable[ivar] || almost_equal_float(node->GetSampleMax(ivar), node->GetSampleMin(ivar))) continue;
+      const UInt_t offset = binning.fOffset[ivar];
+      std::fill(cum.begin(), cum.end(), 0.);
+      // turn the histograms into cumulative distributions while scanning the cuts,
+      // the last bin contains "all events" --> skip
+      for (UInt_t iBin=0; iBin+1 < binning.fNBins[ivar]; iBin++) {
+         for (UInt_t q=0; q<nQuantities; q++) cum[q] += hist[index(q, offset+iBin)];
+         // only allow splits where both daughter nodes match the specified miniumum number
+         const Double_t sl = cum[kSUnWeighted];
+         const Double_t bl = cum[kBUnWeighted];
+         const Double_t slW = cum[kS];
+         const Double_t blW = cum[kB];
+         const Double_t sr = nTotS_unWeighted-sl;
+         const Double_t br = nTotB_unWeighted-bl;
+         const Double_t srW = nTotS-slW;
+         const Double_t brW = nTotB-blW;
+         if ( ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
+              && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize) ) {
+            Double_t sepTmp;
+            if (DoRegression()) {
+               sepTmp = fRegType->GetSeparationGain(slW+blW, cum[kTarget], cum[kTarget2],
+                                                    nTotS+nTotB, hist[kTarget], hist[kTarget2]);
+            } else {
+               sepTmp = fSepType->GetSeparationGain(slW, blW, nTotS, nTotB);
+            }
+            if (separationGainTotal < sepTmp) {
+               separationGainTotal = sepTmp;
+               mxVar = ivar;
+               mxCutIndex = iBin;
+               mxSelS = slW;
+               mxSelB = blW;
+            }
+         }
+      }
+   }
+
+   if (mxVar >= 0) {
+      Bool_t cutType = kTRUE;
+      if (DoRegression()) {
+         const Double_t mean = hist[kTarget]/(nTotS+nTotB);
+         const Double_t mean2 = hist[kTarget2]/(nTotS+nTotB);
+         node->SetSeparationIndex(fRegType->GetSeparationIndex(nTotS+nTotB,hist[kTarget],hist[kTarget2]));
+         node->SetResponse(mean);
+         if (almost_equal_double(mean2, mean*mean)) node->SetRMS(0);
+         else node->SetRMS(TMath::Sqrt(mean2 - mean*mean));
+      }
+      else {
+         node->SetSeparationIndex(fSepType->GetSeparationIndex(nTotS,nTotB));
+         cutType = mxSelS/nTotS > mxSelB/nTotB;
+      }
+      node->SetSelector((UInt_t)mxVar);
+      node->SetCutValue(binning.fXmin[mxVar] + Double_t(mxCutIndex+1)*binning.fBinWidth[mxVar]);
+      node->SetCutType(cutType);
+      node->SetSeparationGain(separationGainTotal);
+      node->SetNFisherCoeff(0);
+      fVariableImportance[mxVar] += separationGainTotal*separationGainTotal * (nTotS+nTotB) * (nTotS+nTotB) ;
+   }
+   else {
+      separationGainTotal = 0;
+   }
+
+   return separationGainTotal;
+}
+
 // Multithreaded version of DecisionTree::TrainNodeFast
 #ifdef R__USE_IMT
 //====================================================================================
@@ -1374,6 +1622,8 @@ struct TrainNodeInfo{
 Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                                             TMVA::DecisionTreeNode *node )
 {
+   if (fGlobalBinning && !fUseFisherCuts) return TrainNodeBinned(eventSample, node);
+
    // #### OK let's comment this one to see how to parallelize it
    Double_t  separationGainTotal = -1;
    Double_t *separationGain    = new Double_t[fNvars+1];
@@ -1893,6 +2143,8 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
 Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                                             TMVA::DecisionTreeNode *node )
 {
+   if (fGlobalBinning && !fUseFisherCuts) return TrainNodeBinned(eventSample, node);
+
 // #### OK let's comment this one to see how to parallelize it
    Double_t  separationGainTotal = -1, sepTmp;
    Double_t *separationGain    = new Double_t[fNvars+1];
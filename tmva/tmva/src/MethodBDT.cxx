@@ -181,6 +181,7 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseGlobalBinning(kFALSE)
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -236,6 +237,7 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseGlobalBinning(kFALSE)
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -311,6 +313,8 @@ Bool_t TMVA::MethodBDT::HasAnalysisType( Types::EAnalysisType type, UInt_t numbe
 ///  - nCuts:           the number of steps in the optimisation of the cut for a node (if < 0, then
 ///                  step size is determined by the events)
 ///  - UseFisherCuts:   use multivariate splits using the Fisher criterion
+///  - UseGlobalBinning: bin the variables once for all trees (nCuts+1 bins over the range of the
+///                  training sample), and split the nodes with histograms filled in parallel
 ///  - UseYesNoLeaf     decide if the classification is done simply by the node type, or the S/B
 ///                  (from the training) in the leaf node
 ///  - NodePurityLimit  the minimum purity to classify a node as a signal node (used in pruning and boosting to determine
@@ -419,6 +423,7 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
+   DeclareOptionRef(fUseGlobalBinning=kFALSE,"UseGlobalBinning","Bin the variables once on the full training sample and split the nodes with histograms of these bins, filled in parallel (requires nCuts>0)");
 
 
    DeclareOptionRef(fDoPreselection=kFALSE,"DoPreselection","and and apply automatic pre-selection for 100% efficient signal (bkg) cuts prior to training");
@@ -606,6 +611,12 @@ void TMVA::MethodBDT::ProcessOptions()
       fNCuts=20;
    }
 
+   if (fUseGlobalBinning && (fUseFisherCuts || fNCuts <= 0)) {
+      Log() << kWARNING << "The option UseGlobalBinning is only available with nCuts>0 and without UseFisherCuts,"
+            << " I will ignore it!" << Endl;
+      fUseGlobalBinning = kFALSE;
+   }
+
    if (fNTrees==0){
       Log() << kERROR << " Zero Decision Trees demanded... that does not work !! "
             << " I set it to 1 .. just so that the program does not crash"
@@ -1264,6 +1275,10 @@ void TMVA::MethodBDT::Train()
       InitGradBoost(fEventSample);
    }
 
+   // the bins are shared by all trees, the bagged samples being subsets of the event sample
+   std::shared_ptr<const DecisionTree::GlobalBinning> globalBinning;
+   if (fUseGlobalBinning) globalBinning = DecisionTree::CreateGlobalBinning(fEventSample, fNCuts, &(DataInfo()));
+
    Int_t itree=0;
    Bool_t continueBoost=kTRUE;
    //for (int itree=0; itree<fNTrees; itree++) {
@@ -1297,6 +1312,7 @@ void TMVA::MethodBDT::Train()
                                                  fRandomisedTrees, fUseNvars, fUsePoissonNvars, fMaxDepth,
                                                  itree*nClasses+i, fNodePurityLimit, itree*nClasses+1));
             fForest.back()->SetNVars(GetNvar());
+            if (globalBinning) fForest.back()->SetGlobalBinning(globalBinning);
             if (fUseFisherCuts) {
                fForest.back()->SetUseFisherCuts();
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
@@ -1324,6 +1340,7 @@ void TMVA::MethodBDT::Train()
 
          fForest.push_back(dt);
          fForest.back()->SetNVars(GetNvar());
+         if (globalBinning) fForest.back()->SetGlobalBinning(globalBinning);
          if (fUseFisherCuts) {
             fForest.back()->SetUseFisherCuts();
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
@@ -6,6 +6,7 @@
 #include "TMVA/TreeInference/BranchlessTree.hxx"
 #include "TMVA/TreeInference/Objectives.hxx"
 
+#include <algorithm>
 #include <vector>
 
 using namespace TMVA::Experimental;
@@ -132,6 +133,37 @@ TEST(BranchlessJittedTree, InferenceFullTreeDepth2)
    EXPECT_FLOAT_EQ(tree.Inference(input3, 1), r3);
 }
 
+TEST(BranchlessTree, InferenceBatch)
+{
+   BranchlessTree<float> tree;
+   tree.fTreeDepth = 2;
+   tree.fThresholds = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+   tree.fInputs = {0, 1, 2};
+
+   // More events than one block of the forest, in both memory layouts
+   const int rows = 150;
+   const int numInputs = 3;
+   std::vector<float> rowMajor(rows * numInputs);
+   std::vector<float> colMajor(rows * numInputs);
+   for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < numInputs; j++) {
+         const float value = ((i * 7 + j * 3) % 11) * 0.5 - 2.0;
+         rowMajor[i * numInputs + j] = value;
+         colMajor[j * rows + i] = value;
+      }
+   }
+   std::vector<int> indices(rows);
+   std::vector<float> predictions(rows, 1.0);
+   tree.InferenceBatch(rowMajor.data(), rows, 1, numInputs, indices.data(), predictions.data());
+   for (int i = 0; i < rows; i++)
+      EXPECT_FLOAT_EQ(predictions[i], 1.0 + tree.Inference(&rowMajor[i * numInputs], 1));
+
+   std::fill(predictions.begin(), predictions.end(), 0.0);
+   tree.InferenceBatch(colMajor.data(), rows, rows, 1, indices.data(), predictions.data());
+   for (int i = 0; i < rows; i++)
+      EXPECT_FLOAT_EQ(predictions[i], tree.Inference(&rowMajor[i * numInputs], 1));
+}
+
 template <typename ForestType>
 void TestInferenceSingleTree(const std::string& tag)
 {
@@ -277,3 +309,48 @@ TEST(BranchlessJittedForest, SortTrees)
    for (int i = 0; i < rows; i++)
       EXPECT_FLOAT_EQ(predictions1[i], predictions2[i]);
 }
+
+template <typename ForestType>
+void TestInferenceManyRows(const std::string& tag)
+{
+   const auto maxDepth = 1;
+   const auto numInputs = 2;
+   const auto numTrees = 2;
+   WriteModel("myModel", "Test" + tag + "4.root", "identity", {0, 1}, {0, 0},
+              {0.0, 1.0, -1.0, 0.0, 2.0, -2.0}, {maxDepth}, {numTrees}, {numInputs}, {1});
+
+   ForestType forest;
+   forest.Load("myModel", "Test" + tag + "4.root", 0);
+
+   // Span several blocks of events, the last one incomplete
+   const int rows = 200;
+   std::vector<float> rowMajor(rows * numInputs);
+   std::vector<float> colMajor(rows * numInputs);
+   std::vector<float> expected(rows);
+   for (int i = 0; i < rows; i++) {
+      const float x = (i % 3) - 1.0;
+      const float y = (i % 5) - 2.0;
+      rowMajor[i * numInputs] = x;
+      rowMajor[i * numInputs + 1] = y;
+      colMajor[i] = x;
+      colMajor[rows + i] = y;
+      expected[i] = (x > 0.0 ? -1.0 : 1.0) + (y > 0.0 ? -2.0 : 2.0);
+   }
+   std::vector<float> predictions(rows);
+   forest.Inference(rowMajor.data(), rows, true, predictions.data());
+   for (int i = 0; i < rows; i++)
+      EXPECT_FLOAT_EQ(predictions[i], expected[i]);
+   forest.Inference(colMajor.data(), rows, false, predictions.data());
+   for (int i = 0; i < rows; i++)
+      EXPECT_FLOAT_EQ(predictions[i], expected[i]);
+}
+
+TEST(BranchlessJittedForest, InferenceManyRows)
+{
+   TestInferenceManyRows<BranchlessJittedForest<float>>("BranchlessJittedForest");
+}
+
+TEST(BranchlessForest, InferenceManyRows)
+{
+   TestInferenceManyRows<BranchlessForest<float>>("BranchlessForest");
+}
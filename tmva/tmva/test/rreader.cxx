@@ -11,6 +11,9 @@
 #include <TMVA/RTensor.hxx>
 #include <TMVA/RTensorUtils.hxx>
 
+#include <thread>
+#include <vector>
+
 using namespace TMVA::Experimental;
 
 // Classification
@@ -175,6 +178,32 @@ TEST(RReader, ClassificationComputeTensor)
    EXPECT_EQ(shapeY[0], shapeX[0]);
 }
 
+TEST(RReader, ClassificationComputeBatch)
+{
+   TrainClassificationModel();
+   ROOT::RDataFrame df("TreeS", filenameClassification);
+   auto x = AsTensor<float>(df, variablesClassification);
+   const auto numEntries = x.GetShape()[0];
+
+   const RReader model(modelClassification);
+   EXPECT_EQ(model.GetOutputSize(), 1ul);
+   std::vector<float> y(numEntries);
+   model.Compute(std::span<const float>(x.GetData(), x.GetSize()), std::span<float>(y.data(), y.size()), numEntries);
+
+   // Evaluate the halves of the batch concurrently, with a second reader of the pool
+   std::vector<float> y2(numEntries);
+   const auto half = numEntries / 2;
+   std::thread t([&] { model.Compute(x.GetData(), y2.data(), half); });
+   model.Compute(x.GetData() + half * 4, y2.data() + half, numEntries - half);
+   t.join();
+
+   for (std::size_t i = 0; i < numEntries; i++) {
+      const std::vector<float> xi = {x(i, 0), x(i, 1), x(i, 2), x(i, 3)};
+      EXPECT_FLOAT_EQ(y[i], model.Compute(xi)[0]);
+      EXPECT_FLOAT_EQ(y[i], y2[i]);
+   }
+}
+
 TEST(RReader, ClassificationComputeDataFrame)
 {
    TrainClassificationModel();
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "TMVA/RStreamingDataLoader.hxx"
+#include "ROOT/RDataFrame.hxx"
+
+#include <vector>
+
+using namespace TMVA::Experimental;
+
+namespace {
+ROOT::RDF::RNode MakeDataFrame(ROOT::RDataFrame &df)
+{
+   return df.Define("a", "1.f * rdfentry_").Define("b", "-1.f * rdfentry_").Define("y", "int(rdfentry_ % 2)");
+}
+} // namespace
+
+TEST(RStreamingDataLoader, Batches)
+{
+   ROOT::RDataFrame df(1000);
+   RStreamingDataLoader<float> loader(MakeDataFrame(df), {"a", "b"}, {"y"}, "", 64, 100, 2, false);
+
+   loader.StartEpoch();
+   std::size_t nBatches = 0;
+   std::size_t entry = 0;
+   while (auto batch = loader.GetNextBatch()) {
+      const std::size_t n = batch->fX.GetShape()[0];
+      EXPECT_EQ(n, nBatches < 15 ? 64u : 40u);
+      EXPECT_EQ(batch->fY.GetShape()[1], 1u);
+      for (std::size_t i = 0; i < n; i++, entry++) {
+         EXPECT_EQ(batch->fX(i, 0), 1.f * entry);
+         EXPECT_EQ(batch->fX(i, 1), -1.f * entry);
+         EXPECT_EQ(batch->fY(i, 0), 1.f * (entry % 2));
+         EXPECT_EQ(batch->fWeights(i), 1.f);
+      }
+      nBatches++;
+   }
+   EXPECT_EQ(nBatches, 16u);
+   EXPECT_EQ(entry, 1000u);
+}
+
+TEST(RStreamingDataLoader, ShuffleEpochs)
+{
+   ROOT::RDataFrame df(1000);
+   RStreamingDataLoader<double> loader(MakeDataFrame(df), {"a", "b"}, {"y"}, "a", 32, 128, 1, true, 42);
+
+   for (int epoch = 0; epoch < 2; epoch++) {
+      loader.StartEpoch();
+      std::vector<int> seen(1000, 0);
+      bool shuffled = false;
+      std::size_t entry = 0;
+      while (auto batch = loader.GetNextBatch()) {
+         for (std::size_t i = 0; i < batch->fX.GetShape()[0]; i++, entry++) {
+            const double a = batch->fX(i, 0);
+            EXPECT_EQ(batch->fX(i, 1), -a);
+            EXPECT_EQ(batch->fWeights(i), a);
+            seen[static_cast<int>(a)]++;
+            shuffled |= a != entry;
+         }
+      }
+      EXPECT_TRUE(shuffled);
+      for (auto n : seen)
+         EXPECT_EQ(n, 1);
+   }
+}
+
+TEST(RStreamingDataLoader, TensorInputChunks)
+{
+   ROOT::RDataFrame df(250);
+   RStreamingDataLoader<float> loader(MakeDataFrame(df), {"a", "b"}, {"y"}, "", 10, 100, 2, false);
+
+   std::vector<TMatrixT<Double_t>> inputs;
+   TMatrixT<Double_t> outputs, weights;
+   std::vector<Int_t> sizes;
+   Int_t entry = 0;
+   loader.StartEpoch();
+   while (loader.GetNextChunk(inputs, outputs, weights)) {
+      ASSERT_EQ(inputs.size(), 1u);
+      const Int_t n = outputs.GetNrows();
+      EXPECT_EQ(inputs[0].GetNrows(), n);
+      EXPECT_EQ(inputs[0].GetNcols(), 2);
+      EXPECT_EQ(weights.GetNrows(), n);
+      for (Int_t i = 0; i < n; i++, entry++) {
+         EXPECT_EQ(inputs[0](i, 0), entry);
+         EXPECT_EQ(outputs(i, 0), entry % 2);
+         EXPECT_EQ(weights(i, 0), 1.);
+      }
+      sizes.push_back(n);
+   }
+   EXPECT_EQ(sizes, std::vector<Int_t>({100, 100, 50}));
+}
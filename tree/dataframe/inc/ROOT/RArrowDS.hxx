@@ -57,6 +57,11 @@ public:
 /// \param[in] table an apache::arrow table to use as a source.
 RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a RDataFrame that reads an Apache Arrow IPC file or a Parquet file.
+/// \param[in] fileName the file to read, Parquet files are recognized by their ".parquet" extension.
+RDataFrame MakeArrowDataFrame(std::string_view fileName, std::vector<std::string> const &columns = {});
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -53,7 +53,13 @@ private:
    std::map<std::string, ColType_t> fColTypes;
    std::list<ColType_t> fColTypesList;
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
+   // The values of the lines read by the last GetEntryRanges call, per column and line: only the vector that
+   // corresponds to the type of each column is filled
+   std::vector<std::vector<double>> fDoubleValues;
+   std::vector<std::vector<Long64_t>> fLong64Values;
+   std::vector<std::vector<std::string>> fStringValues;
+   // std::deque because different lines are parsed concurrently, and concurrent writes to vector<bool> are not safe
+   std::vector<std::deque<bool>> fBoolValues;
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -62,13 +68,14 @@ private:
    std::vector<std::deque<bool>> fBoolEvtValues; // one per column per slot
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   void FillRecord(const std::string &, std::size_t);
+   void FillRecords(const std::vector<std::string> &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
    void InferType(const std::string &, unsigned int);
-   std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   std::vector<std::string> ParseColumns(const std::string &) const;
+   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t) const;
    ColType_t GetType(std::string_view colName) const;
 
 protected:
@@ -31,6 +31,7 @@
 #include "RtypesCore.h"
 #include "TBranch.h"
 #include "TClassEdit.h"
+#include "TConcurrentFiller.h"
 #include "TClassRef.h"
 #include "TDirectory.h"
 #include "TError.h" // for R__ASSERT, Warning
@@ -44,11 +45,14 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -57,9 +61,21 @@
 
 /// \cond HIDDEN_SYMBOLS
 
+class TH2;
+class TH3;
+class TProfile;
+class TProfile2D;
+
 namespace ROOT {
+namespace RDF {
+template <typename Proxied, typename DataSource>
+class RInterface;
+} // namespace RDF
+
 namespace Detail {
 namespace RDF {
+class RLoopManager;
+
 template <typename Helper>
 class RActionImpl {
 public:
@@ -186,6 +202,13 @@ public:
 
    ULong64_t &PartialUpdate(unsigned int slot);
 
+   CountHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ULong64_t> *>(newResult);
+      *result = 0;
+      return CountHelper(result, fCounts.size());
+   }
+
    std::string GetActionName() { return "Count"; }
 };
 
@@ -304,6 +327,12 @@ public:
       return std::make_unique<RMergeableFill<Hist_t>>(*fResultHist);
    }
 
+   FillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<Hist_t> *>(newResult);
+      return FillHelper(result, fNSlots);
+   }
+
    std::string GetActionName() { return "Fill"; }
 };
 
@@ -319,9 +348,127 @@ extern template void FillHelper::Exec(unsigned int, const std::vector<int> &, co
 extern template void
 FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vector<unsigned int> &);
 
+/// Whether HIST::FillN(n, x, w) fills a 1D histogram with n values, see FillParHelper.
+template <typename HIST>
+struct HasFillN1D
+   : std::integral_constant<bool, std::is_base_of<TH1, HIST>::value && !std::is_base_of<TH2, HIST>::value &&
+                                     !std::is_base_of<TH3, HIST>::value && !std::is_base_of<TProfile, HIST>::value> {
+};
+
+/// Whether HIST::FillN(n, x, y, w, stride) fills a 2D histogram or a profile with n pairs of values, see FillParHelper.
+template <typename HIST>
+struct HasFillN2D
+   : std::integral_constant<bool, (std::is_base_of<TH2, HIST>::value && !std::is_base_of<TProfile2D, HIST>::value) ||
+                                     std::is_base_of<TProfile, HIST>::value> {
+};
+
+/// Whether all the column types are arithmetic types or collections of arithmetic types.
+template <typename... Ts>
+struct AreFillNArgs : std::true_type {
+};
+
+template <typename T, bool = IsDataContainer<T>::value>
+struct FillNValue {
+   using type = T;
+};
+
+template <typename T>
+struct FillNValue<T, true> {
+   using type = std::decay_t<decltype(*std::begin(std::declval<const T &>()))>;
+};
+
+template <typename T, typename... Ts>
+struct AreFillNArgs<T, Ts...>
+   : std::integral_constant<bool, std::is_arithmetic<typename FillNValue<T>::type>::value && AreFillNArgs<Ts...>::value> {
+};
+
+/// Return a pointer to the values of a collection as a contiguous array of doubles.
+/// Collections of doubles are used in place, all others are copied into `buffer`.
+inline const double *AsDoubles(const RVec<double> &xs, std::vector<double> &)
+{
+   return xs.data();
+}
+
+inline const double *AsDoubles(const std::vector<double> &xs, std::vector<double> &)
+{
+   return xs.data();
+}
+
+template <typename T, std::enable_if_t<std::is_same<std::remove_const_t<T>, double>::value, int> = 0>
+const double *AsDoubles(const std::span<T> &xs, std::vector<double> &)
+{
+   return xs.data();
+}
+
+template <typename Coll>
+const double *AsDoubles(const Coll &xs, std::vector<double> &buffer)
+{
+   buffer.assign(std::begin(xs), std::end(xs));
+   return buffer.data();
+}
+
+/// Return the weights to pass to FillN: a null pointer for unit weights, the values of a collection of weights or
+/// a scalar weight broadcast to all `n` values.
+inline const double *GetFillNWeights(std::nullptr_t, std::size_t, std::vector<double> &)
+{
+   return nullptr;
+}
+
+template <typename W, std::enable_if_t<IsDataContainer<W>::value, int> = 0>
+const double *GetFillNWeights(const W &ws, std::size_t, std::vector<double> &buffer)
+{
+   return AsDoubles(ws, buffer);
+}
+
+template <typename W, std::enable_if_t<std::is_arithmetic<W>::value, int> = 0>
+const double *GetFillNWeights(W w, std::size_t n, std::vector<double> &buffer)
+{
+   buffer.assign(n, w);
+   return buffer.data();
+}
+
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
    std::vector<HIST *> fObjects;
+   /// Per-slot scratch buffers used to pass collections of values and weights that are not doubles to FillN
+   std::vector<std::array<std::vector<double>, 3>> fFillNBuffers;
+
+   template <typename... Colls>
+   using FillN1D_t = std::integral_constant<bool, HasFillN1D<HIST>::value && AreFillNArgs<Colls...>::value>;
+   template <typename... Colls>
+   using FillN2D_t = std::integral_constant<bool, HasFillN2D<HIST>::value && AreFillNArgs<Colls...>::value>;
+
+   // Fill the histogram of this slot with all values at once rather than with one (virtual) Fill call per value
+   template <typename X0, typename W>
+   bool FillN1D(unsigned int slot, const X0 &x0s, const W &ws, std::true_type)
+   {
+      const auto n = x0s.size();
+      auto &buffers = fFillNBuffers[slot];
+      fObjects[slot]->FillN(n, AsDoubles(x0s, buffers[0]), GetFillNWeights(ws, n, buffers[1]));
+      return true;
+   }
+
+   template <typename X0, typename W>
+   bool FillN1D(unsigned int, const X0 &, const W &, std::false_type)
+   {
+      return false;
+   }
+
+   template <typename X0, typename X1, typename W>
+   bool FillN2D(unsigned int slot, const X0 &x0s, const X1 &x1s, const W &ws, std::true_type)
+   {
+      const auto n = x0s.size();
+      auto &buffers = fFillNBuffers[slot];
+      fObjects[slot]->FillN(n, AsDoubles(x0s, buffers[0]), AsDoubles(x1s, buffers[1]),
+                            GetFillNWeights(ws, n, buffers[2]), 1);
+      return true;
+   }
+
+   template <typename X0, typename X1, typename W>
+   bool FillN2D(unsigned int, const X0 &, const X1 &, const W &, std::false_type)
+   {
+      return false;
+   }
 
    void UnsetDirectoryIfPossible(TH1 *h) {
       h->SetDirectory(nullptr);
@@ -360,7 +507,8 @@ public:
    FillParHelper(FillParHelper &&) = default;
    FillParHelper(const FillParHelper &) = delete;
 
-   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
+   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fObjects(nSlots, nullptr), fFillNBuffers(nSlots)
    {
       fObjects[0] = h.get();
       // Initialise all other slots
@@ -395,9 +543,11 @@ public:
    template <typename X0, std::enable_if_t<IsDataContainer<X0>::value || std::is_same<X0, std::string>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
+      if (FillN1D(slot, x0s, nullptr, FillN1D_t<X0>{}))
+         return;
       auto thisSlotH = fObjects[slot];
       for (auto x0 = x0s.begin(); x0 != x0s.end(); x0++) {
-         thisSlotH->Fill(*x0); // TODO: Can be optimised in case T == vector<double>
+         thisSlotH->Fill(*x0);
       }
    }
 
@@ -418,11 +568,14 @@ public:
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
+      // 1D weighted or 2D histograms
+      if (FillN1D(slot, x0s, x1s, FillN1D_t<X0, X1>{}) || FillN2D(slot, x0s, x1s, nullptr, FillN2D_t<X0, X1>{}))
+         return;
       auto x0sIt = std::begin(x0s);
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt); // TODO: Can be optimised in case T == vector<double>
+         thisSlotH->Fill(*x0sIt, *x1sIt);
       }
    }
 
@@ -430,6 +583,8 @@ public:
              std::enable_if_t<IsDataContainer<X0>::value && !IsDataContainer<W>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const W w)
    {
+      if (FillN1D(slot, x0s, w, FillN1D_t<X0, W>{}))
+         return;
       auto thisSlotH = fObjects[slot];
       for (auto &&x : x0s) {
          thisSlotH->Fill(x, w);
@@ -445,12 +600,15 @@ public:
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
+      // 2D weighted histograms and profiles. TH3 and TProfile2D do not offer a FillN.
+      if (FillN2D(slot, x0s, x1s, x2s, FillN2D_t<X0, X1, X2>{}))
+         return;
       auto x0sIt = std::begin(x0s);
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       auto x2sIt = std::begin(x2s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt); // TODO: Can be optimised in case T == vector<double>
+         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt);
       }
    }
 
@@ -463,11 +621,13 @@ public:
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
+      if (FillN2D(slot, x0s, x1s, w, FillN2D_t<X0, X1, W>{}))
+         return;
       auto x0sIt = std::begin(x0s);
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, w); // TODO: Can be optimised in case T == vector<double>
+         thisSlotH->Fill(*x0sIt, *x1sIt, w);
       }
    }
 
@@ -487,7 +647,7 @@ public:
       auto x2sIt = std::begin(x2s);
       auto x3sIt = std::begin(x3s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++, x3sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, *x3sIt); // TODO: Can be optimised in case T == vector<double>
+         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, *x3sIt);
       }
    }
 
@@ -532,9 +692,194 @@ public:
       return std::make_unique<RMergeableFill<HIST>>(*fObjects[0]);
    }
 
+   FillParHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      return FillParHelper(result, fObjects.size());
+   }
+
    std::string GetActionName() { return "FillPar"; }
 };
 
+/// Stand-in for TProfileConcurrentFiller for the histogram types that have no lock-free filler
+struct NoConcurrentFiller {
+   NoConcurrentFiller(TH1 &) {}
+   template <typename... Xs>
+   void Fill(Xs...)
+   {
+   }
+};
+
+/// Fills a single histogram shared by all processing slots.
+/// Every slot buffers the arguments of up to `bufSize` Fill calls, and replays them into the shared histogram under a
+/// lock when its buffer is full and at the end of each task. Contrary to FillParHelper, which clones the histogram once
+/// per slot, memory usage does not grow with the number of bins times the number of slots.
+/// TProfile and TProfile2D with fixed axes are instead filled directly by all slots through a TProfileConcurrentFiller,
+/// without buffers nor lock.
+/// Callbacks registered with OnPartialResult are not supported, as the shared histogram is updated concurrently.
+template <typename HIST, std::size_t NArgs>
+class SharedFillHelper : public RActionImpl<SharedFillHelper<HIST, NArgs>> {
+   using FillArgs_t = std::array<double, NArgs>;
+   using ConcurrentFiller_t =
+      std::conditional_t<std::is_same<HIST, ::TProfile>::value || std::is_same<HIST, ::TProfile2D>::value,
+                         TProfileConcurrentFiller<HIST>, NoConcurrentFiller>;
+   static constexpr bool kHasConcurrentFiller = !std::is_same<ConcurrentFiller_t, NoConcurrentFiller>::value;
+
+   template <typename T>
+   using IsFillContainer_t =
+      std::integral_constant<bool, IsDataContainer<T>::value || std::is_same<T, std::string>::value>;
+
+   const std::shared_ptr<HIST> fResultHist;
+   const std::size_t fBufSize;                      ///< Maximum number of Fill calls buffered by each slot
+   std::vector<std::vector<FillArgs_t>> fBuffers; ///< The arguments of the buffered Fill calls, per slot
+   std::unique_ptr<std::mutex> fMutex;            ///< Serializes the flushes of the buffers into fResultHist
+   std::unique_ptr<ConcurrentFiller_t> fConcurrentFiller; ///< Fills fResultHist directly, if it can be used
+
+   template <typename... Xs>
+   static constexpr bool AnyFillContainer()
+   {
+      bool any = false;
+      for (bool isContainer : {false, IsFillContainer_t<Xs>::value...})
+         any = any || isContainer;
+      return any;
+   }
+
+   template <typename T, std::enable_if_t<IsFillContainer_t<T>::value, int> = 0>
+   static bool HasSize(const T &x, std::size_t size)
+   {
+      return x.size() == size;
+   }
+
+   template <typename T, std::enable_if_t<!IsFillContainer_t<T>::value, int> = 0>
+   static bool HasSize(const T &, std::size_t)
+   {
+      return true; // scalars are used for every element of the containers, e.g. as weights
+   }
+
+   template <typename T, std::enable_if_t<IsFillContainer_t<T>::value, int> = 0>
+   static double GetFillArg(const T &x, std::size_t i)
+   {
+      return x[i];
+   }
+
+   template <typename T, std::enable_if_t<!IsFillContainer_t<T>::value, int> = 0>
+   static double GetFillArg(const T &x, std::size_t)
+   {
+      return x;
+   }
+
+   template <std::size_t... S>
+   void FillHist(const FillArgs_t &args, std::index_sequence<S...>)
+   {
+      fResultHist->Fill(args[S]...);
+   }
+
+   void Flush(unsigned int slot)
+   {
+      auto &buffer = fBuffers[slot];
+      if (buffer.empty())
+         return;
+      {
+         std::lock_guard<std::mutex> lock(*fMutex);
+         for (const auto &args : buffer)
+            FillHist(args, std::make_index_sequence<NArgs>{});
+      }
+      buffer.clear();
+   }
+
+   template <std::size_t... S>
+   void FillConcurrent(const FillArgs_t &args, std::index_sequence<S...>)
+   {
+      fConcurrentFiller->Fill(args[S]...);
+   }
+
+   void Push(unsigned int slot, const FillArgs_t &args)
+   {
+      if (fConcurrentFiller) {
+         FillConcurrent(args, std::make_index_sequence<NArgs>{});
+         return;
+      }
+      auto &buffer = fBuffers[slot];
+      buffer.emplace_back(args);
+      if (buffer.size() >= fBufSize)
+         Flush(slot);
+   }
+
+public:
+   SharedFillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots, std::size_t bufSize)
+      : fResultHist(h), fBufSize(bufSize), fBuffers(nSlots), fMutex(std::make_unique<std::mutex>())
+   {
+   }
+   SharedFillHelper(SharedFillHelper &&) = default;
+   SharedFillHelper(const SharedFillHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int slot)
+   {
+      if (!fConcurrentFiller)
+         fBuffers[slot].reserve(fBufSize);
+   }
+
+   template <typename... Xs, std::enable_if_t<!AnyFillContainer<Xs...>(), int> = 0>
+   void Exec(unsigned int slot, const Xs &... xs)
+   {
+      Push(slot, FillArgs_t{{static_cast<double>(xs)...}});
+   }
+
+   template <typename X0, typename... Xs, std::enable_if_t<AnyFillContainer<X0, Xs...>(), int> = 0>
+   void Exec(unsigned int slot, const X0 &x0, const Xs &... xs)
+   {
+      // ROOT-10092: Filling with a scalar as first column and a collection as second is not supported
+      if (!IsFillContainer_t<X0>::value) {
+         throw std::runtime_error(
+            "Cannot fill object if the type of the first column is a scalar and the one of the second a container.");
+      }
+      const std::size_t size = x0.size();
+      for (bool hasSize : {true, HasSize(xs, size)...}) {
+         if (!hasSize)
+            throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
+      }
+      for (std::size_t i = 0u; i < size; ++i)
+         Push(slot, FillArgs_t{{GetFillArg(x0, i), GetFillArg(xs, i)...}});
+   }
+
+   /// Flush the buffer of the slot and release its memory until the next task
+   void FinalizeTask(unsigned int slot)
+   {
+      Flush(slot);
+      std::vector<FillArgs_t>().swap(fBuffers[slot]);
+   }
+
+   void Initialize()
+   {
+      auto axesCanExtend = [](const TH1 &h) {
+         return h.GetXaxis()->CanExtend() || h.GetYaxis()->CanExtend() || h.GetZaxis()->CanExtend();
+      };
+      if (kHasConcurrentFiller && !axesCanExtend(*fResultHist))
+         fConcurrentFiller = std::make_unique<ConcurrentFiller_t>(*fResultHist);
+   }
+
+   void Finalize()
+   {
+      fConcurrentFiller.reset(); // adds its sums to fResultHist
+      for (auto slot = 0u; slot < fBuffers.size(); ++slot)
+         Flush(slot);
+   }
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableFill<HIST>>(*fResultHist);
+   }
+
+   SharedFillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      return SharedFillHelper(result, fBuffers.size(), fBufSize);
+   }
+
+   std::string GetActionName() { return "SharedFill"; }
+};
+
 class FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
 public:
    using Result_t = ::TGraph;
@@ -858,6 +1203,12 @@ public:
 
    ResultType &PartialUpdate(unsigned int slot) { return fMins[slot]; }
 
+   MinHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return MinHelper(result, fMins.size());
+   }
+
    std::string GetActionName() { return "Min"; }
 };
 
@@ -909,6 +1260,12 @@ public:
 
    ResultType &PartialUpdate(unsigned int slot) { return fMaxs[slot]; }
 
+   MaxHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return MaxHelper(result, fMaxs.size());
+   }
+
    std::string GetActionName() { return "Max"; }
 };
 
@@ -973,6 +1330,12 @@ public:
 
    ResultType &PartialUpdate(unsigned int slot) { return fSums[slot]; }
 
+   SumHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return SumHelper(result, fSums.size());
+   }
+
    std::string GetActionName() { return "Sum"; }
 };
 
@@ -1011,6 +1374,12 @@ public:
 
    double &PartialUpdate(unsigned int slot);
 
+   MeanHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<double> *>(newResult);
+      return MeanHelper(result, fSums.size());
+   }
+
    std::string GetActionName() { return "Mean"; }
 };
 
@@ -1059,6 +1428,12 @@ public:
       return std::make_unique<RMergeableStdDev>(*fResultStdDev, counts, mean);
    }
 
+   StdDevHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<double> *>(newResult);
+      return StdDevHelper(result, fNSlots);
+   }
+
    std::string GetActionName() { return "StdDev"; }
 };
 
@@ -1634,6 +2009,167 @@ public:
    }
 };
 
+/// Helper object for a Snapshot that copies the compressed baskets of the input TTree instead of reading and
+/// writing every entry, see RSnapshotOptions::fFastClone.
+/// It is only used when all entries of the input are written and all columns are branches of the input TTree written
+/// unchanged: the event loop does not read any column and the copy happens in Finalize.
+class SnapshotCloneHelper : public RActionImpl<SnapshotCloneHelper> {
+   const std::string fFileName;
+   const std::string fDirName;
+   const std::string fTreeName;
+   const RSnapshotOptions fOptions;
+   const ColumnNames_t fBranchNames;
+   const std::string fInputTreeName;
+   std::vector<std::string> fInputFileNames; // The files of the input dataset, one per tree
+   std::vector<std::string> fInputTreePaths; // The path of each input tree in its file
+
+public:
+   using ColumnTypes_t = TypeList<>;
+   SnapshotCloneHelper(std::string_view filename, std::string_view dirname, std::string_view treename,
+                       const ColumnNames_t &bnames, const RSnapshotOptions &options, const TTree &inputTree);
+   SnapshotCloneHelper(const SnapshotCloneHelper &) = delete;
+   SnapshotCloneHelper(SnapshotCloneHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int) {}
+   void Initialize() {}
+   void Finalize();
+
+   std::string GetActionName() { return "Snapshot"; }
+};
+
+/// Type-erased writer of the RNTuple produced by a Snapshot with ESnapshotOutputFormat::kRNTuple.
+/// Every slot fills the ntuple through its own RNTupleFillContext: its clusters are compressed by the slot itself and
+/// handed over to the file sink once they are complete, without a merging thread. Implemented in RDFActionHelpers.cxx;
+/// throws if ROOT is built without RNTuple support.
+class RNTupleSnapshotWriter {
+   struct RImpl;
+   std::unique_ptr<RImpl> fImpl;
+
+public:
+   RNTupleSnapshotWriter(const std::string &fileName, const std::string &ntupleName, const ColumnNames_t &fieldNames,
+                         const std::vector<std::string> &typeNames, unsigned int nSlots,
+                         const RSnapshotOptions &options);
+   RNTupleSnapshotWriter(const RNTupleSnapshotWriter &) = delete;
+   RNTupleSnapshotWriter &operator=(const RNTupleSnapshotWriter &) = delete;
+   ~RNTupleSnapshotWriter();
+
+   /// Appends an entry; `values` holds the addresses of the values to write, one per field.
+   void Fill(unsigned int slot, void *const *values);
+   /// Total number of entries filled by all slots so far
+   ULong64_t GetNEntries() const;
+   /// Commits the remaining clusters and closes the ntuple. If `outputDataFrame` is not null, it is replaced by an
+   /// RDataFrame that reads the written ntuple.
+   void Finalize(ROOT::RDF::RInterface<RLoopManager, void> *outputDataFrame);
+};
+
+struct RNTupleSnapshotNoBuffer {
+};
+
+/// Maps the type of a Snapshot column to the type of the RNTuple field it is written to
+template <typename T>
+struct RNTupleSnapshotColumn {
+   using Buffer_t = RNTupleSnapshotNoBuffer;
+   static std::string GetTypeName() { return TypeID2TypeName(typeid(T)); }
+   static void *GetAddress(T &value, Buffer_t &) { return &value; }
+};
+
+/// RVecs do not have the memory layout of a std::vector, which is what the generic RNTuple collection field expects:
+/// they are copied into a per-slot std::vector
+template <typename T>
+struct RNTupleSnapshotColumn<RVec<T>> {
+   using Buffer_t = std::vector<T>;
+   static std::string GetTypeName() { return "std::vector<" + TypeID2TypeName(typeid(T)) + ">"; }
+   static void *GetAddress(RVec<T> &value, Buffer_t &buffer)
+   {
+      buffer.assign(value.begin(), value.end());
+      return &buffer;
+   }
+};
+
+/// RVec<bool> has a dedicated RNTuple field
+template <>
+struct RNTupleSnapshotColumn<RVec<bool>> {
+   using Buffer_t = RNTupleSnapshotNoBuffer;
+   static std::string GetTypeName() { return "ROOT::VecOps::RVec<bool>"; }
+   static void *GetAddress(RVec<bool> &value, Buffer_t &) { return &value; }
+};
+
+/// Helper object for a Snapshot action to RNTuple, used both for single- and multi-thread event loops
+template <typename... ColTypes>
+class SnapshotNTupleHelper : public RActionImpl<SnapshotNTupleHelper<ColTypes...>> {
+   const unsigned int fNSlots;
+   const std::string fFileName;
+   const std::string fNTupleName;
+   const RSnapshotOptions fOptions;
+   const ColumnNames_t fOutputFieldNames;
+   /// The RDataFrame returned by Snapshot; it is pointed to the ntuple once it is written
+   std::shared_ptr<ROOT::RDF::RInterface<RLoopManager, void>> fOutputDataFrame;
+   std::unique_ptr<RNTupleSnapshotWriter> fWriter;
+   /// Addresses of the values of the current entry, per slot
+   std::vector<std::vector<void *>> fValueAddresses;
+   /// Per-slot storage for the values that need to be converted before being written
+   std::vector<std::tuple<typename RNTupleSnapshotColumn<ColTypes>::Buffer_t...>> fBuffers;
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotNTupleHelper(const unsigned int nSlots, std::string_view filename, std::string_view dirname,
+                        std::string_view ntuplename, const ColumnNames_t &bnames, const RSnapshotOptions &options,
+                        const std::shared_ptr<ROOT::RDF::RInterface<RLoopManager, void>> &outputDataFrame)
+      : fNSlots(nSlots), fFileName(filename), fNTupleName(ntuplename), fOptions(options),
+        fOutputFieldNames(ReplaceDotWithUnderscore(bnames)), fOutputDataFrame(outputDataFrame),
+        fValueAddresses(fNSlots, std::vector<void *>(sizeof...(ColTypes), nullptr)), fBuffers(fNSlots)
+   {
+      if (!dirname.empty())
+         throw std::invalid_argument("Snapshot: RNTuple output cannot be written into a TFile subdirectory");
+      TString fileMode = fOptions.fMode;
+      fileMode.ToLower();
+      if (fileMode != "recreate")
+         throw std::invalid_argument("Snapshot: RNTuple output only supports the \"RECREATE\" file mode");
+   }
+   SnapshotNTupleHelper(const SnapshotNTupleHelper &) = delete;
+   SnapshotNTupleHelper(SnapshotNTupleHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &... values)
+   {
+      using ind_t = std::index_sequence_for<ColTypes...>;
+      SetValueAddresses(slot, values..., ind_t{});
+      fWriter->Fill(slot, fValueAddresses[slot].data());
+   }
+
+   template <std::size_t... S>
+   void SetValueAddresses(unsigned int slot, ColTypes &... values, std::index_sequence<S...> /*dummy*/)
+   {
+      auto &addresses = fValueAddresses[slot];
+      auto &buffers = fBuffers[slot];
+      int expander[] = {
+         (addresses[S] = RNTupleSnapshotColumn<ColTypes>::GetAddress(values, std::get<S>(buffers)), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      (void)buffers;
+   }
+
+   void Initialize()
+   {
+      fWriter = std::make_unique<RNTupleSnapshotWriter>(
+         fFileName, fNTupleName, fOutputFieldNames,
+         std::vector<std::string>{RNTupleSnapshotColumn<ColTypes>::GetTypeName()...}, fNSlots, fOptions);
+   }
+
+   void Finalize()
+   {
+      if (fWriter->GetNEntries() == 0) {
+         Warning("Snapshot",
+                 "No input entries (input TTree was empty or no entry passed the Filters). Output RNTuple is empty.");
+      }
+      fWriter->Finalize(fOutputDataFrame.get());
+      fWriter.reset();
+   }
+
+   std::string GetActionName() { return "Snapshot"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
@@ -15,6 +15,7 @@
 #include "RDefineBase.hxx"
 #include "RDefineReader.hxx"
 #include "RDSColumnReader.hxx"
+#include "RProfiler.hxx"
 #include "RTreeColumnReader.hxx"
 
 #include <ROOT/RDataSource.hxx>
@@ -67,12 +68,16 @@ template <typename T>
 std::unique_ptr<RDFDetail::RColumnReaderBase>
 MakeColumnReadersHelper(unsigned int slot, RDFDetail::RDefineBase *define,
                         const std::map<std::string, std::vector<void *>> &DSValuePtrsMap, TTreeReader *r,
-                        ROOT::RDF::RDataSource *ds, const std::string &colName)
+                        ROOT::RDF::RDataSource *ds, const std::string &colName, RProfiler *profiler)
 {
    const auto DSValuePtrsIt = DSValuePtrsMap.find(colName);
    const std::vector<void *> *DSValuePtrsPtr = DSValuePtrsIt != DSValuePtrsMap.end() ? &DSValuePtrsIt->second : nullptr;
    R__ASSERT(define != nullptr || r != nullptr || DSValuePtrsPtr != nullptr || ds != nullptr);
-   return MakeColumnReader<T>(slot, define, r, ds, DSValuePtrsPtr, colName);
+   auto reader = MakeColumnReader<T>(slot, define, r, ds, DSValuePtrsPtr, colName);
+   // the time spent in defines is measured by the defines themselves
+   if (profiler != nullptr && define == nullptr)
+      reader.reset(new RProfiledColumnReader(std::move(reader), *profiler, slot, colName));
+   return reader;
 }
 
 /// This type aggregates some of the arguments passed to InitColumnReaders.
@@ -85,6 +90,7 @@ struct RColumnReadersInfo {
    const bool *fIsDefine;
    const std::map<std::string, std::vector<void *>> &fDSValuePtrsMap;
    ROOT::RDF::RDataSource *fDataSource;
+   RProfiler *fProfiler = nullptr; ///< If not null, the readers of dataset columns are profiled
 };
 
 /// Create a group of column readers, one per type in the parameter pack.
@@ -100,17 +106,19 @@ MakeColumnReaders(unsigned int slot, TTreeReader *r, TypeList<ColTypes...>, cons
    const bool *isDefine = colInfo.fIsDefine;
    const auto &DSValuePtrsMap = colInfo.fDSValuePtrsMap;
    auto *ds = colInfo.fDataSource;
+   auto *profiler = colInfo.fProfiler;
 
    const auto &customColMap = customCols.GetColumns();
 
    int i = -1;
    std::array<std::unique_ptr<RDFDetail::RColumnReaderBase>, sizeof...(ColTypes)> ret{
       {{(++i, MakeColumnReadersHelper<ColTypes>(slot, isDefine[i] ? customColMap.at(colNames[i]).get() : nullptr,
-                                                DSValuePtrsMap, r, ds, colNames[i]))}...}};
+                                                DSValuePtrsMap, r, ds, colNames[i], profiler))}...}};
    return ret;
 
    // avoid bogus "unused variable" warnings
    (void)ds;
+   (void)profiler;
    (void)slot;
    (void)r;
 }
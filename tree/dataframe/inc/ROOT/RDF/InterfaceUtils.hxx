@@ -121,15 +121,41 @@ struct HistoUtils<T, false> {
    static bool HasAxisLimits(T &) { return true; }
 };
 
+// Filling of objects that are not histograms: one clone per slot
+template <typename... ColTypes, typename ActionResultType, typename PrevNodeType>
+std::unique_ptr<RActionBase>
+BuildFillAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h, const unsigned int nSlots,
+                std::shared_ptr<PrevNodeType> prevNode, const RBookedDefines &defines, std::false_type /*isTH1*/)
+{
+   using Helper_t = FillParHelper<ActionResultType>;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+   return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), defines);
+}
+
+// Filling of histograms: one clone per slot, or a single histogram shared by all slots if shared filling is enabled
+// (see ROOT::RDF::Experimental::EnableSharedHistoFill)
+template <typename... ColTypes, typename ActionResultType, typename PrevNodeType>
+std::unique_ptr<RActionBase>
+BuildFillAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h, const unsigned int nSlots,
+                std::shared_ptr<PrevNodeType> prevNode, const RBookedDefines &defines, std::true_type /*isTH1*/)
+{
+   const auto sharedFillBufSize = prevNode->GetLoopManagerUnchecked()->GetSharedFillBufferSize();
+   if (sharedFillBufSize == 0 || nSlots == 1)
+      return BuildFillAction<ColTypes...>(bl, h, nSlots, std::move(prevNode), defines, std::false_type{});
+
+   using Helper_t = SharedFillHelper<ActionResultType, sizeof...(ColTypes)>;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+   return std::make_unique<Action_t>(Helper_t(h, nSlots, sharedFillBufSize), bl, std::move(prevNode), defines);
+}
+
 // Generic filling (covers Histo2D, Histo3D, Profile1D and Profile2D actions, with and without weights)
 template <typename... ColTypes, typename ActionTag, typename ActionResultType, typename PrevNodeType>
 std::unique_ptr<RActionBase>
 BuildAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h, const unsigned int nSlots,
             std::shared_ptr<PrevNodeType> prevNode, ActionTag, const RBookedDefines &defines)
 {
-   using Helper_t = FillParHelper<ActionResultType>;
-   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
-   return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), defines);
+   return BuildFillAction<ColTypes...>(bl, h, nSlots, std::move(prevNode), defines,
+                                       std::is_base_of<TH1, ActionResultType>{});
 }
 
 // Histo1D filling (must handle the special case of distinguishing FillParHelper and FillHelper
@@ -141,9 +167,7 @@ std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::sha
    auto hasAxisLimits = HistoUtils<::TH1D>::HasAxisLimits(*h);
 
    if (hasAxisLimits) {
-      using Helper_t = FillParHelper<::TH1D>;
-      using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
-      return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), defines);
+      return BuildFillAction<ColTypes...>(bl, h, nSlots, std::move(prevNode), defines, std::true_type{});
    } else {
       using Helper_t = FillHelper;
       using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
@@ -233,9 +257,16 @@ struct SnapshotHelperArgs {
    std::string fTreeName;
    std::vector<std::string> fOutputColNames;
    ROOT::RDF::RSnapshotOptions fOptions;
+   /// The RDataFrame returned by Snapshot, only used by the RNTuple output format
+   std::shared_ptr<ROOT::RDF::RInterface<RLoopManager, void>> fOutputDataFrame;
 };
 
 // Snapshot action
+/// Return whether a Snapshot of colNames requested with RSnapshotOptions::fFastClone can copy the baskets of the input
+/// TTree, i.e. whether all its entries are written and all columns are top-level branches written unchanged.
+bool CanCloneSnapshotBranches(RNodeBase &prevNode, const ColumnNames_t &colNames, const ColumnNames_t &outputColNames,
+                              const RBookedDefines &defines);
+
 template <typename... ColTypes, typename PrevNodeType>
 std::unique_ptr<RActionBase>
 BuildAction(const ColumnNames_t &colNames, const std::shared_ptr<SnapshotHelperArgs> &snapHelperArgs,
@@ -249,7 +280,22 @@ BuildAction(const ColumnNames_t &colNames, const std::shared_ptr<SnapshotHelperA
    const auto &options = snapHelperArgs->fOptions;
 
    std::unique_ptr<RActionBase> actionPtr;
-   if (!ROOT::IsImplicitMTEnabled()) {
+   if (options.fFastClone && options.fOutputFormat != ROOT::RDF::ESnapshotOutputFormat::kRNTuple &&
+       CanCloneSnapshotBranches(*prevNode, colNames, outputColNames, defines)) {
+      // the baskets of the input are copied at the end of the event loop, no column is read
+      using Helper_t = SnapshotCloneHelper;
+      using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<>>;
+      actionPtr.reset(new Action_t(
+         Helper_t(filename, dirname, treename, colNames, options, *prevNode->GetLoopManagerUnchecked()->GetTree()),
+         /*columns=*/{}, prevNode, defines));
+   } else if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+      // the same helper serves single- and multi-thread snapshots, every slot writes its own clusters
+      using Helper_t = SnapshotNTupleHelper<ColTypes...>;
+      using Action_t = RAction<Helper_t, PrevNodeType>;
+      actionPtr.reset(new Action_t(
+         Helper_t(nSlots, filename, dirname, treename, outputColNames, options, snapHelperArgs->fOutputDataFrame),
+         colNames, prevNode, defines));
+   } else if (!ROOT::IsImplicitMTEnabled()) {
       // single-thread snapshot
       using Helper_t = SnapshotHelper<ColTypes...>;
       using Action_t = RAction<Helper_t, PrevNodeType>;
@@ -301,10 +347,16 @@ void CheckForDefinition(const std::string &where, std::string_view definedColVie
 
 std::string PrettyPrintAddr(const void *const addr);
 
-void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter, std::shared_ptr<RNodeBase> *prevNodeOnHeap,
-                   std::string_view name, std::string_view expression,
-                   const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &branches,
-                   const RBookedDefines &customCols, TTree *tree, RDataSource *ds);
+/// Create an empty file with a unique name in the temporary directory and return its path
+std::string MakeTemporaryFileName(const std::string &prefix);
+
+/// Return the options with which RInterface::CacheOnDisk writes the cached columns
+ROOT::RDF::RSnapshotOptions GetCacheOnDiskOptions();
+
+std::shared_ptr<RJittedFilter>
+BookFilterJit(RLoopManager *lm, std::shared_ptr<RNodeBase> *prevNodeOnHeap, std::string_view name,
+              std::string_view expression, const std::map<std::string, std::string> &aliasMap,
+              const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds);
 
 std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_view expression, RLoopManager &lm,
                                                    RDataSource *ds, const RBookedDefines &customCols,
@@ -21,6 +21,7 @@
 #include <array>
 #include <cstddef> // std::size_t
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -87,14 +88,24 @@ public:
       return fHelper.GetMergeableValue();
    }
 
-   void Initialize() final { fHelper.Initialize(); }
+   void Initialize() final
+   {
+      fProfiler = fLoopManager->GetProfiler();
+      if (fProfiler)
+         fProfilerID = fProfiler->RegisterNode(RProfiler::ENodeKind::kAction, fHelper.GetActionName(), this);
+      for (auto &define : GetDefines().GetColumns())
+         define.second->SetProfiler(fProfiler);
+      const bool isEager = static_cast<RNodeBase *>(&fPrevData) == fLoopManager;
+      fLoopManager->RegisterColumnsRead(GetColumnNames(), GetDefines(), isEager);
+      fHelper.Initialize();
+   }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : GetDefines().GetColumns())
          bookedBranch.second->InitSlot(r, slot);
       RDFInternal::RColumnReadersInfo info{RActionBase::GetColumnNames(), RActionBase::GetDefines(), fIsDefine.data(),
-                                           fLoopManager->GetDSValuePtrs(), fLoopManager->GetDataSource()};
+                                           fLoopManager->GetDSValuePtrs(), fLoopManager->GetDataSource(), fProfiler};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
       fHelper.InitTask(r, slot);
    }
@@ -109,8 +120,14 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
-         CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      if (fPrevData.CheckFilters(slot, entry)) {
+         if (fProfiler) {
+            RProfiledScope scope(*fProfiler, slot, fProfilerID);
+            CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+         } else {
+            CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+         }
+      }
    }
 
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
@@ -133,13 +150,16 @@ public:
       SetHasRun();
    }
 
+   const RNodeBase *GetPrevNode() const final { return &fPrevData; }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       auto prevNode = fPrevData.GetGraph();
       auto prevColumns = prevNode->GetDefinedColumns();
 
       // Action nodes do not need to go through CreateFilterNode: they are never common nodes between multiple branches
-      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName());
+      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName() +
+                                                                   GetProfileLabel(fProfiler, fProfilerID));
 
       auto upmostNode = AddDefinesToGraph(thisNode, GetDefines(), prevColumns);
 
@@ -153,7 +173,36 @@ public:
    /// user-defined callback registered via RResultPtr::RegisterCallback
    void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
 
+   void AddVariations(RVariationTags_t &variations) const final
+   {
+      fPrevData.AddVariations(variations);
+      RDFInternal::AddVariations(GetColumnNames(), GetDefines(), variations);
+   }
+
+   std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variationName, std::size_t varIdx, void *newResult) final
+   {
+      auto prevDataPtr = fPrevDataPtr;
+      if (fPrevData.HasVariation(variationName))
+         prevDataPtr = std::static_pointer_cast<PrevDataFrame>(fPrevData.GetVariedFilter(variationName, varIdx));
+      return std::make_unique<RAction>(MakeNewHelperImpl(newResult, 0), GetColumnNames(), std::move(prevDataPtr),
+                                       GetDefines().MakeVaried(variationName, varIdx));
+   }
+
 private:
+   // this overload is SFINAE'd out if Helper does not implement `MakeNew`
+   template <typename H = Helper>
+   auto MakeNewHelperImpl(void *newResult, int) -> decltype(std::declval<H>().MakeNew(newResult))
+   {
+      return fHelper.MakeNew(newResult);
+   }
+
+   // this one is always available but has lower precedence thanks to `...`
+   Helper MakeNewHelperImpl(void *, ...)
+   {
+      throw std::logic_error("The " + fHelper.GetActionName() + " action does not support systematic variations.");
+   }
+
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
    // the template parameter is required to defer instantiation of the method to SFINAE time
    template <typename H = Helper>
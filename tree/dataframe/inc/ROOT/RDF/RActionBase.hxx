@@ -25,6 +25,7 @@ namespace RDF {
 class RLoopManager;
 class RDefineBase;
 class RMergeableValueBase;
+class RNodeBase;
 } // namespace RDF
 } // namespace Detail
 
@@ -33,6 +34,7 @@ namespace RDF {
 namespace GraphDrawing {
 class GraphNode;
 }
+class RProfiler;
 
 using namespace ROOT::Detail::RDF;
 
@@ -41,6 +43,8 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   RProfiler *fProfiler = nullptr; ///< non-owning ptr to the profiler of the RLoopManager, if enabled
+   unsigned int fProfilerID = 0;   ///< The ID of this node in fProfiler
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -57,6 +61,7 @@ public:
 
    const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
    RBookedDefines &GetDefines() { return fDefines; }
+   const RBookedDefines &GetDefines() const { return fDefines; }
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
@@ -74,6 +79,10 @@ public:
    virtual void SetHasRun() { fHasRun = true; }
 
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
+   /// Return the node upstream of this action
+   virtual const RNodeBase *GetPrevNode() const = 0;
+   /// Return the action that processes the entries: this one, or the one created when this action is jitted
+   virtual const RActionBase &GetConcreteAction() const { return *this; }
 
    /**
       Retrieve a wrapper to the result of the action that knows how to merge
@@ -82,6 +91,13 @@ public:
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const = 0;
 
    virtual std::function<void(unsigned int)> GetDataBlockCallback() = 0;
+
+   /// Add the systematic variations that affect this action or the nodes upstream of it to `variations`.
+   virtual void AddVariations(RVariationTags_t &variations) const = 0;
+   /// Create a clone of this action that processes the varied value with index `varIdx` of the given variation and
+   /// writes its result in `newResult`, a pointer to a `std::shared_ptr` to a result of the same type.
+   virtual std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variationName, std::size_t varIdx, void *newResult) = 0;
 };
 } // namespace RDF
 } // namespace Internal
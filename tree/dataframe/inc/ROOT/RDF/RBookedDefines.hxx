@@ -22,6 +22,7 @@ namespace ROOT {
 namespace Detail {
 namespace RDF {
 class RDefineBase;
+class RVariationBase;
 }
 }
 
@@ -30,6 +31,9 @@ namespace RDF {
 
 namespace RDFDetail = ROOT::Detail::RDF;
 
+/// The names of the systematic variations that affect a node, and the tags of each variation.
+using RVariationTags_t = std::map<std::string, std::vector<std::string>>;
+
 /**
  * \class ROOT::Internal::RDF::RBookedDefines
  * \ingroup dataframe
@@ -43,10 +47,13 @@ class RBookedDefines {
    // Since RBookedDefines is meant to be an immutable, copy-on-write object, the actual values are set as const
    using RDefineBasePtrMapPtr_t = std::shared_ptr<const RDefineBasePtrMap_t>;
    using ColumnNamesPtr_t = std::shared_ptr<const ColumnNames_t>;
+   using RVariationBasePtrs_t = std::vector<std::shared_ptr<RDFDetail::RVariationBase>>;
+   using RVariationBasePtrsPtr_t = std::shared_ptr<const RVariationBasePtrs_t>;
 
 private:
    RDefineBasePtrMapPtr_t fDefines;
    ColumnNamesPtr_t fDefinesNames;  // also abused to keep track of aliases for each branch of the computation graph
+   RVariationBasePtrsPtr_t fVariations; ///< The systematic variations booked with Vary in this branch of the graph
 
 public:
    ////////////////////////////////////////////////////////////////////////////
@@ -64,7 +71,7 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates the object starting from the provided maps
    RBookedDefines(RDefineBasePtrMapPtr_t defines, ColumnNamesPtr_t defineNames)
-      : fDefines(defines), fDefinesNames(defineNames)
+      : fDefines(defines), fDefinesNames(defineNames), fVariations(std::make_shared<RVariationBasePtrs_t>())
    {
    }
 
@@ -72,7 +79,7 @@ public:
    /// \brief Creates a new wrapper with empty maps
    RBookedDefines()
       : fDefines(std::make_shared<RDefineBasePtrMap_t>()),
-        fDefinesNames(std::make_shared<ColumnNames_t>())
+        fDefinesNames(std::make_shared<ColumnNames_t>()), fVariations(std::make_shared<RVariationBasePtrs_t>())
    {
    }
 
@@ -100,6 +107,23 @@ public:
    /// in each branch of the computation graph.
    /// Internally it recreates the vector with the new name, and swaps it with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns the systematic variations booked in this branch of the computation graph
+   const RVariationBasePtrs_t &GetVariations() const { return *fVariations; }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Add a new systematic variation.
+   /// Internally it recreates the list with the new variation, and swaps it with the old one.
+   void AddVariation(const std::shared_ptr<RDFDetail::RVariationBase> &variation);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the defines seen by the nodes that process the varied value with index `varIdx` of the given
+   /// variation.
+   ///
+   /// The varied column is replaced by the corresponding varied value, and so is every define that depends on it,
+   /// directly or indirectly. The returned object has no further variations.
+   RBookedDefines MakeVaried(const std::string &variationName, std::size_t varIdx) const;
 };
 
 } // Namespace RDF
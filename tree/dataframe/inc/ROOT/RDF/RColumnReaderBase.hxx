@@ -14,6 +14,12 @@
 #include <Rtypes.h>
 
 namespace ROOT {
+namespace Internal {
+namespace RDF {
+class RProfiledColumnReader;
+}
+} // namespace Internal
+
 namespace Detail {
 namespace RDF {
 
@@ -39,6 +45,7 @@ public:
    }
 
 private:
+   friend class ROOT::Internal::RDF::RProfiledColumnReader; // forwards to the GetImpl of the reader it decorates
    virtual void *GetImpl(Long64_t entry) = 0;
 };
 
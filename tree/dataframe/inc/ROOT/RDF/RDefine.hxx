@@ -120,7 +120,8 @@ public:
    {
       if (!fIsInitialized[slot]) {
          fIsInitialized[slot] = true;
-         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fDSValuePtrs, fDataSource};
+         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fDSValuePtrs, fDataSource,
+                                              fProfiler};
          fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
       }
@@ -137,13 +138,35 @@ public:
    {
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
          // evaluate this filter, cache the result
-         UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         if (fProfiler) {
+            RDFInternal::RProfiledScope scope(*fProfiler, slot, fProfilerID);
+            UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         } else {
+            UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         }
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
       }
    }
 
    const std::type_info &GetTypeId() const { return typeid(ret_type); }
 
+   void AddDatasetColumns(std::set<std::string> &columns) const final
+   {
+      RDFInternal::AddDatasetColumns(fColumnNames, fDefines, columns);
+   }
+
+   void AddVariations(RDFInternal::RVariationTags_t &variations) const final
+   {
+      RDFInternal::AddVariations(fColumnNames, fDefines, variations);
+   }
+
+   std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &variationName, std::size_t varIdx) final
+   {
+      return std::make_shared<RDefine>(fName, fType, RDFInternal::CopyForVariation(fExpression, "Define"),
+                                       fColumnNames, fNSlots, fDefines.MakeVaried(variationName, varIdx),
+                                       fDSValuePtrs, fDataSource);
+   }
+
    /// Clean-up operations to be performed at the end of a task.
    void FinaliseSlot(unsigned int slot) final
    {
@@ -17,7 +17,9 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 
 class TTreeReader;
@@ -26,6 +28,11 @@ namespace ROOT {
 namespace RDF {
 class RDataSource;
 }
+namespace Internal {
+namespace RDF {
+class RProfiler;
+}
+} // namespace Internal
 namespace Detail {
 namespace RDF {
 
@@ -46,6 +53,10 @@ protected:
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
    const std::map<std::string, std::vector<void *>> &fDSValuePtrs; // reference to RLoopManager's data member
    ROOT::RDF::RDataSource *fDataSource; ///< non-owning ptr to the RDataSource, if any. Used to retrieve column readers.
+   RDFInternal::RProfiler *fProfiler = nullptr; ///< non-owning ptr to the profiler of the RLoopManager, if enabled
+   unsigned int fProfilerID = 0;                ///< The ID of this node in fProfiler
+   /// The clones of this define that process the systematic variations, by variation name and index
+   std::map<std::pair<std::string, std::size_t>, std::shared_ptr<RDefineBase>> fVariedDefines;
 
    static unsigned int GetNextID();
 
@@ -69,10 +80,37 @@ public:
    virtual void FinaliseSlot(unsigned int slot) = 0;
    /// Return the unique identifier of this RDefineBase.
    unsigned int GetID() const { return fID; }
+   /// Profile the evaluations of this define and of the defines it depends on with the given profiler.
+   virtual void SetProfiler(RDFInternal::RProfiler *profiler);
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler; }
+   unsigned int GetProfilerID() const { return fProfilerID; }
+   /// Add the names of the dataset columns read by this define, directly or through other defines, to `columns`.
+   virtual void AddDatasetColumns(std::set<std::string> &columns) const = 0;
+   /// Add the systematic variations that affect this define, directly or through other defines, to `variations`.
+   virtual void AddVariations(RDFInternal::RVariationTags_t &variations) const = 0;
+   /// Create a clone of this define that reads the varied value with index `varIdx` of the given variation.
+   virtual std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &variationName, std::size_t varIdx) = 0;
+   /// Return the clone of this define for the given varied value, creating it on first use.
+   /// All the nodes that process the same varied value share the same clone.
+   std::shared_ptr<RDefineBase> GetVariedDefine(const std::string &variationName, std::size_t varIdx);
 };
 
 } // ns RDF
 } // ns Detail
+
+namespace Internal {
+namespace RDF {
+/// Add the names of the dataset columns read by a node with the given input columns to `datasetColumns`, following the
+/// inputs of the given defines.
+void AddDatasetColumns(const std::vector<std::string> &columns, const RBookedDefines &defines,
+                       std::set<std::string> &datasetColumns);
+
+/// Add the systematic variations that affect a node with the given input columns to `variations`, following the
+/// inputs of the given defines.
+void AddVariations(const std::vector<std::string> &columns, const RBookedDefines &defines,
+                   RVariationTags_t &variations);
+} // namespace RDF
+} // namespace Internal
 } // ns ROOT
 
 #endif // ROOT_RCUSTOMCOLUMNBASE
@@ -89,7 +89,13 @@ public:
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+            bool passed;
+            if (fProfiler) {
+               RDFInternal::RProfiledScope scope(*fProfiler, slot, fProfilerID);
+               passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+            } else {
+               passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+            }
             passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
                    : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = passed;
@@ -113,10 +119,18 @@ public:
       for (auto &bookedBranch : fDefines.GetColumns())
          bookedBranch.second->InitSlot(r, slot);
       RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fLoopManager->GetDSValuePtrs(),
-                                           fLoopManager->GetDataSource()};
+                                           fLoopManager->GetDataSource(), fProfiler};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
    }
 
+   void InitNode() final
+   {
+      RFilterBase::InitNode();
+      // filters attached to the RLoopManager read their columns for every entry
+      const bool isEager = static_cast<RNodeBase *>(&fPrevData) == fLoopManager;
+      fLoopManager->RegisterColumnsRead(fColumnNames, fDefines, isEager);
+   }
+
    // recursive chain of `Report`s
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { PartialReport(rep); }
 
@@ -164,6 +178,25 @@ public:
          v.reset();
    }
 
+   void AddVariations(RDFInternal::RVariationTags_t &variations) const final
+   {
+      fPrevData.AddVariations(variations);
+      RDFInternal::AddVariations(fColumnNames, fDefines, variations);
+   }
+
+   /// The clone is an unnamed filter, so it does not appear in the cutflow reports.
+   std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &variationName, std::size_t varIdx) final
+   {
+      auto prevDataPtr = fPrevDataPtr;
+      if (fPrevData.HasVariation(variationName))
+         prevDataPtr = std::static_pointer_cast<PrevDataFrame>(fPrevData.GetVariedFilter(variationName, varIdx));
+      auto variedFilter = std::make_shared<RFilter>(RDFInternal::CopyForVariation(fFilter, "Filter"), fColumnNames,
+                                                    std::move(prevDataPtr),
+                                                    fDefines.MakeVaried(variationName, varIdx));
+      fLoopManager->Book(variedFilter.get());
+      return variedFilter;
+   }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // Recursively call for the previous node.
@@ -27,6 +27,12 @@ namespace RDF {
 class RCutFlowReport;
 } // ns RDF
 
+namespace Internal {
+namespace RDF {
+class RProfiler;
+}
+} // namespace Internal
+
 namespace Detail {
 namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
@@ -43,6 +49,8 @@ protected:
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    RDFInternal::RBookedDefines fDefines;
+   RDFInternal::RProfiler *fProfiler = nullptr; ///< non-owning ptr to the profiler of the RLoopManager, if enabled
+   unsigned int fProfilerID = 0;                ///< The ID of this node in fProfiler
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -67,6 +75,8 @@ public:
    virtual void FinaliseSlot(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler; }
+   unsigned int GetProfilerID() const { return fProfilerID; }
 };
 
 } // ns RDF
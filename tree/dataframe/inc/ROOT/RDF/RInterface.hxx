@@ -17,8 +17,10 @@
 #include "ROOT/RDF/HistoModels.hxx"
 #include "ROOT/RDF/InterfaceUtils.hxx"
 #include "ROOT/RDF/RRange.hxx"
+#include "ROOT/RDF/RVariation.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RDF/RLazyDSImpl.hxx"
+#include "ROOT/RResultMap.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/RStringView.hxx"
@@ -36,6 +38,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdio> // std::remove
 #include <initializer_list>
 #include <iterator> // std::back_insterter
 #include <limits>
@@ -77,6 +80,19 @@ template <typename Proxied, typename DataSource>
 class RInterface;
 
 using RNode = RInterface<::ROOT::Detail::RDF::RNodeBase, void>;
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+/// Return the RLoopManager at the root of the computation graph of the given node
+ROOT::Detail::RDF::RLoopManager *GetLoopManager(const ROOT::RDF::RNode &node);
+/// Return the definition of a function that books the Filters, Defines and Ranges leading to the given node with typed
+/// C++ callables, see ROOT::RDF::Experimental::GenerateCode
+std::string GenerateGraphCode(const ROOT::RDF::RNode &node, const std::string &functionName);
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
 
 // clang-format off
 /**
@@ -99,6 +115,8 @@ class RInterface {
    using RLoopManager = RDFDetail::RLoopManager;
    friend std::string cling::printValue(::ROOT::RDataFrame *tdf); // For a nice printing at the prompt
    friend class RDFInternal::GraphDrawing::GraphCreatorHelper;
+   friend RLoopManager *RDFInternal::GetLoopManager(const RNode &node);
+   friend std::string RDFInternal::GenerateGraphCode(const RNode &node, const std::string &functionName);
 
    template <typename T, typename W>
    friend class RInterface;
@@ -255,12 +273,11 @@ public:
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer_t<decltype(upcastNodeOnHeap)>::element_type;
       RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fDefines, fDataSource);
-      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name);
-
-      RDFInternal::BookFilterJit(jittedFilter, upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
-                                 fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
+      // an identical filter that was already booked on the same node is returned instead of a new one
+      auto jittedFilter =
+         RDFInternal::BookFilterJit(fLoopManager, upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
+                                    fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
 
-      fLoopManager->Book(jittedFilter.get());
       return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fDefines, fDataSource);
    }
 
@@ -477,6 +494,59 @@ public:
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column.
+   /// \param[in] colName The name of the column whose values are varied.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object producing all the varied values of the column at once, as an RVec with one element per tag.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] tags The names of the varied values, e.g. `{"down", "up"}`.
+   /// \param[in] variationName The name of this set of variations. If empty, the name of the varied column is used.
+   /// \return the first node of the computation graph for which the variations are available.
+   ///
+   /// The varied values are evaluated once per entry, in the same event loop as the nominal values. The actions
+   /// booked downstream of this node produce varied results, which can be retrieved with
+   /// ROOT::RDF::Experimental::VariationsFor():
+   /// ~~~{.cpp}
+   /// auto nominal = df.Vary("pt", [](double pt) { return ROOT::RVec<double>{pt * 0.9, pt * 1.1}; }, {"pt"},
+   ///                        {"down", "up"})
+   ///                  .Filter("pt > 10")
+   ///                  .Histo1D("pt");
+   /// auto histos = ROOT::RDF::Experimental::VariationsFor(nominal);
+   /// histos["nominal"].Draw();
+   /// histos["pt:down"].Draw("SAME");
+   /// ~~~
+   /// The filters and defines that depend on the varied column, directly or indirectly, are evaluated once per varied
+   /// value, the others are shared with the nominal computation. The type of the elements of the returned RVec must
+   /// be the type of the varied column. The expression reads the nominal values of its input columns.
+   // clang-format on
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  const std::vector<std::string> &tags, std::string_view variationName = "")
+   {
+      return VaryImpl(colName, std::move(expression), inputColumns, tags, variationName);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column, with automatically generated tags.
+   /// \param[in] colName The name of the column whose values are varied.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object producing all the varied values of the column at once, as an RVec with `nVariations` elements.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] nVariations The number of varied values. Their tags are "0", "1", ..., "nVariations-1".
+   /// \param[in] variationName The name of this set of variations. If empty, the name of the varied column is used.
+   /// \return the first node of the computation graph for which the variations are available.
+   ///
+   /// See the other Vary() overload for more information.
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  std::size_t nVariations, std::string_view variationName = "")
+   {
+      std::vector<std::string> tags;
+      for (std::size_t i = 0u; i < nVariations; ++i)
+         tags.emplace_back(std::to_string(i));
+      return VaryImpl(colName, std::move(expression), inputColumns, tags, variationName);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Allow to refer to a column with a different name.
    /// \param[in] alias name of the column alias
@@ -569,6 +639,20 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// With `opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple`, the output is an RNTuple named `treename` instead
+   /// of a TTree. In multi-thread runs, every processing slot then compresses and writes its own clusters, as opposed
+   /// to the TTree output for which all the data is merged and written by a single TBufferMerger thread. The output
+   /// file must be opened in "RECREATE" mode, `fAutoFlush` sets the cluster size and `fSplitLevel` is ignored;
+   /// RVec columns are stored as `std::vector`. The returned RDataFrame reads the RNTuple once the event loop has run.
+   ///
+   /// Slimming a TTree, i.e. writing a subset of its branches for all of its entries, does not require to decompress
+   /// and recompress the data: with `opts.fFastClone = true`, the compressed baskets of the selected branches are
+   /// copied to the output as they are. This happens if the Snapshot is booked directly on the RDataFrame (no Filter or
+   /// Range), the input is a TTree or TChain stored in files without friends or entry lists, and all columns are
+   /// top-level branches written with their original names; otherwise a regular Snapshot is performed and the reason is
+   /// logged on the "ROOT.RDF" channel at info level. The output keeps the compression settings and the basket layout
+   /// of the input, and its entries are in the order of the input also in multi-thread runs.
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -602,11 +686,12 @@ public:
       treename = parsedTreePath.fTreeName;
       const auto &dirname = parsedTreePath.fDirName;
 
-      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(RDFInternal::SnapshotHelperArgs{
-         std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
-
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      auto newRDF = MakeSnapshotDataFrame(fullTreeName, filename, validCols, options);
+
+      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(
+         RDFInternal::SnapshotHelperArgs{std::string(filename), std::string(dirname), std::string(treename),
+                                         columnListWithoutSizeColumns, options, newRDF});
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, RDFDetail::RInferredType>(
          validCols, newRDF, snapHelperArgs, validCols.size());
@@ -800,6 +885,49 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in an uncompressed file.
+   /// \tparam ColumnTypes variadic list of branch/column types.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] fileName The file to write. If empty, a temporary file is created and it is removed when the returned
+   /// RDataFrame and all its nodes are destroyed.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// Like Cache(), this action runs the event loop and returns a new `RDataFrame` object that only contains the cached
+   /// columns, but the values are written to disk rather than kept in memory: use it for datasets that do not fit in
+   /// memory and that will be processed many times. The values are stored without compression, as an RNTuple if ROOT
+   /// was built with `root7=ON` and as a TTree otherwise, so that subsequent event loops read them from the page cache
+   /// of the operating system without decompressing them; the file takes correspondingly more space than the input.
+   /// See Snapshot() for the types of columns that can be cached.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto skim = df.Filter("pt > 100").CacheOnDisk<float, float>({"pt", "eta"});
+   /// for (auto i : ROOT::TSeqI(10))
+   ///    skim.Histo1D<float>(model(i), "pt")->Fit(...); // each event loop reads the uncompressed skim
+   /// ~~~
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> CacheOnDisk(const ColumnNames_t &columnList, std::string_view fileName = "")
+   {
+      return CacheOnDiskImpl(fileName, [&](const std::string &path) {
+         return Snapshot<ColumnTypes...>("cache", path, columnList, RDFInternal::GetCacheOnDiskOptions());
+      });
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in an uncompressed file.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] fileName The file to write. If empty, a temporary file is used.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// The column types are inferred (this invocation relies on jitting). See the previous overload for more information.
+   RInterface<RLoopManager> CacheOnDisk(const ColumnNames_t &columnList, std::string_view fileName = "")
+   {
+      return CacheOnDiskImpl(fileName, [&](const std::string &path) {
+         return Snapshot("cache", path, columnList, RDFInternal::GetCacheOnDiskOptions());
+      });
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end).
@@ -828,6 +956,13 @@ public:
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
       fLoopManager->Book(rangePtr.get());
+
+      RDFInternal::RCodeGenStep step;
+      step.fObject = rangePtr;
+      step.fKind = "Range";
+      step.fArgs = std::to_string(begin) + ", " + std::to_string(end) + ", " + std::to_string(stride);
+      step.fPrevNode = static_cast<RDFDetail::RNodeBase *>(fProxiedPtr.get());
+      fLoopManager->RegisterCodeGenStep(static_cast<RDFDetail::RNodeBase *>(rangePtr.get()), std::move(step));
       RInterface<RDFDetail::RRange<Proxied>, DS_t> tdf_r(std::move(rangePtr), *fLoopManager, fDefines, fDataSource);
       return tdf_r;
    }
@@ -2681,6 +2816,57 @@ private:
       return newInterface;
    }
 
+   template <typename F>
+   RInterface<Proxied, DS_t> VaryImpl(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                      const std::vector<std::string> &tags, std::string_view variationName)
+   {
+      using RetType = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsRVec_t<RetType>::value,
+                    "Error in `Vary`: the expression must return an RVec with the varied values of the column.");
+      using VariedCol_t = typename RetType::value_type;
+
+      if (tags.empty())
+         throw std::invalid_argument("Vary: at least one tag must be specified.");
+      const std::string varName = variationName.empty() ? std::string(colName) : std::string(variationName);
+      for (const auto &variation : fDefines.GetVariations()) {
+         if (variation->GetVariationName() == varName)
+            throw std::invalid_argument("Vary: a variation named \"" + varName + "\" was already booked.");
+      }
+
+      // the varied column must exist, and its type must be the one of the varied values
+      const auto nominalColumn = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      const auto nominalType = GetColumnType(nominalColumn);
+      bool typesMatch = false;
+      try {
+         typesMatch = RDFInternal::TypeName2TypeID(nominalType) == typeid(VariedCol_t);
+      } catch (const std::runtime_error &) {
+         typesMatch = nominalType == RDFInternal::TypeID2TypeName(typeid(VariedCol_t));
+      }
+      if (!typesMatch) {
+         throw std::runtime_error("Vary: the type of column \"" + nominalColumn + "\" is " + nominalType +
+                                  " but the expression returns values of type " +
+                                  RDFInternal::TypeID2TypeName(typeid(VariedCol_t)) + ".");
+      }
+
+      using ColTypes_t = typename TTraits::CallableTraits<F>::arg_types;
+      constexpr auto nColumns = ColTypes_t::list_size;
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, inputColumns);
+      CheckAndFillDSColumns(validColumnNames, ColTypes_t());
+
+      using Variation_t = RDFDetail::RVariation<F>;
+      auto variation = std::make_shared<Variation_t>(nominalColumn, varName, tags, nominalType,
+                                                     std::move(expression), validColumnNames,
+                                                     fLoopManager->GetNSlots(), fDefines,
+                                                     fLoopManager->GetDSValuePtrs(), fDataSource);
+
+      RDFInternal::RBookedDefines newCols(fDefines);
+      newCols.AddVariation(variation);
+
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+
+      return newInterface;
+   }
+
    // This overload is chosen when the callable passed to Define or DefineSlot returns void.
    // It simply fires a compile-time error. This is preferable to a static_assert in the main `Define` overload because
    // this way compilation of `Define` has no way to continue after throwing the error.
@@ -2695,6 +2881,17 @@ private:
       return *this; // never reached
    }
 
+   /// The RDataFrame returned by Snapshot. An RNTuple can only be opened once it is written: in this case, the
+   /// returned RDataFrame is a placeholder that the Snapshot action replaces at the end of the event loop.
+   static std::shared_ptr<ROOT::RDataFrame>
+   MakeSnapshotDataFrame(std::string_view fullTreeName, std::string_view filename, const ColumnNames_t &validCols,
+                         const RSnapshotOptions &options)
+   {
+      if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple)
+         return std::make_shared<ROOT::RDataFrame>(ULong64_t(0));
+      return std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+   }
+
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>> SnapshotImpl(std::string_view fullTreeName, std::string_view filename,
                                                      const ColumnNames_t &columnList, const RSnapshotOptions &options)
@@ -2710,11 +2907,12 @@ private:
       const auto &treename = parsedTreePath.fTreeName;
       const auto &dirname = parsedTreePath.fDirName;
 
-      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(RDFInternal::SnapshotHelperArgs{
-         std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
-
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      auto newRDF = MakeSnapshotDataFrame(fullTreeName, filename, validCols, options);
+
+      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(
+         RDFInternal::SnapshotHelperArgs{std::string(filename), std::string(dirname), std::string(treename),
+                                         columnListWithoutSizeColumns, options, newRDF});
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, ColumnTypes...>(validCols, newRDF, snapHelperArgs);
 
@@ -2723,6 +2921,24 @@ private:
       return resPtr;
    }
 
+   /// Write the cache with the given Snapshot call and return the RDataFrame reading it.
+   template <typename SnapshotFn>
+   RInterface<RLoopManager> CacheOnDiskImpl(std::string_view fileName, SnapshotFn &&snapshot)
+   {
+      const bool isTemporary = fileName.empty();
+      const std::string path = isTemporary ? RDFInternal::MakeTemporaryFileName("rdf_cache") : std::string(fileName);
+      try {
+         RInterface<RLoopManager> cachedRDF = *snapshot(path);
+         if (isTemporary)
+            cachedRDF.fLoopManager->AddTemporaryFile(path);
+         return cachedRDF;
+      } catch (...) {
+         if (isTemporary)
+            std::remove(path.c_str());
+         throw;
+      }
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Implementation of cache.
    template <typename... ColTypes, std::size_t... S>
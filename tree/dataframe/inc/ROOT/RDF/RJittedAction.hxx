@@ -57,11 +57,17 @@ public:
    void SetHasRun() final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
+   const RNodeBase *GetPrevNode() const final;
+   const RActionBase &GetConcreteAction() const final;
 
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
 
    std::function<void(unsigned int)> GetDataBlockCallback() final;
+
+   void AddVariations(RVariationTags_t &variations) const final;
+   std::unique_ptr<RActionBase>
+   MakeVariedAction(const std::string &variationName, std::size_t varIdx, void *newResult) final;
 };
 
 } // ns RDF
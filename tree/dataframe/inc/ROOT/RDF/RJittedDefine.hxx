@@ -45,6 +45,10 @@ public:
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
    void FinaliseSlot(unsigned int slot) final;
+   void SetProfiler(RDFInternal::RProfiler *profiler) final;
+   void AddDatasetColumns(std::set<std::string> &columns) const final;
+   void AddVariations(RDFInternal::RVariationTags_t &variations) const final;
+   std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &variationName, std::size_t varIdx) final;
 };
 
 } // ns RDF
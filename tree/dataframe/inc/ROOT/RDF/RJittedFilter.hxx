@@ -37,7 +37,7 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 /// RJittedFilter is the type of the node returned by jitted Filter calls: the concrete filter can be created and set
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
-   std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   std::shared_ptr<RFilterBase> fConcreteFilter = nullptr;
 
 public:
    RJittedFilter(RLoopManager *lm, std::string_view name);
@@ -59,6 +59,8 @@ public:
    void AddFilterName(std::vector<std::string> &filters) final;
    void FinaliseSlot(unsigned int slot) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
+   void AddVariations(RDFInternal::RVariationTags_t &variations) const final;
+   std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &variationName, std::size_t varIdx) final;
 };
 
 } // ns RDF
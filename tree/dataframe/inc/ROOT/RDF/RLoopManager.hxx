@@ -13,14 +13,19 @@
 
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/RDataBlockNotifier.hxx"
+#include "ROOT/RDF/Utils.hxx"
 
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // forward declarations
+class TEntryList;
 class TTree;
 class TTreeReader;
 class TDirectory;
@@ -29,6 +34,9 @@ namespace ROOT {
 namespace RDF {
 class RCutFlowReport;
 class RDataSource;
+namespace Experimental {
+struct RProgressInfo;
+} // ns Experimental
 } // ns RDF
 
 namespace Internal {
@@ -37,6 +45,21 @@ std::vector<std::string> GetBranchNames(TTree &t, bool allowDuplicates = true);
 
 class RActionBase;
 class GraphNode;
+class RProfiler;
+class RProgressMonitor;
+class RBookedDefines;
+
+/// A Filter, Define or Range booked in the computation graph, as typed C++ code (see GenerateGraphCode)
+struct RCodeGenStep {
+   std::weak_ptr<void> fObject; ///< The filter, range or define, to detect entries whose object does not exist anymore
+   unsigned int fIndex = 0u;    ///< The order in which the steps were booked
+   std::string fKind;           ///< "Filter", "Range" or "Define"
+   std::string fName;           ///< The name of the defined column, or of the filter
+   std::string fArgs;           ///< The arguments of the call, e.g. a typed lambda and the names of its input columns
+   const void *fPrevNode = nullptr; ///< For filters and ranges, the address of the upstream node (as RNodeBase)
+   /// The defines read by the step, as pairs of column name and address of the define (as RDefineBase)
+   std::vector<std::pair<std::string, const void *>> fDefines;
+};
 
 namespace GraphDrawing {
 class GraphCreatorHelper;
@@ -50,6 +73,8 @@ namespace RDFInternal = ROOT::Internal::RDF;
 
 class RFilterBase;
 class RRangeBase;
+class RJittedDefine;
+class RJittedFilter;
 using ROOT::RDF::RDataSource;
 using ColumnNames_t = std::vector<std::string>;
 
@@ -104,9 +129,14 @@ class RLoopManager : public RNodeBase {
    std::vector<RFilterBase *> fBookedNamedFilters; ///< Contains a subset of fBookedFilters, i.e. only the named filters
    std::vector<RRangeBase *> fBookedRanges;
 
+   /// Files written for this computation graph, e.g. by RInterface::CacheOnDisk. They must be removed after the input
+   /// TTree or data source reading them is closed, hence this member comes before fTree and fDataSource.
+   RDFInternal::RTemporaryFiles fTemporaryFiles;
    /// Shared pointer to the input TTree. It does not delete the pointee if the TTree/TChain was passed directly as an
    /// argument to RDataFrame's ctor (in which case we let users retain ownership).
    std::shared_ptr<TTree> fTree{nullptr};
+   /// The entries of fTree to process, with global entry numbers. If null, the entry list of fTree (if any) is used.
+   std::unique_ptr<TEntryList> fEntryList;
    const ColumnNames_t fDefaultColumns;
    const ULong64_t fNEmptyEntries{0};
    const unsigned int fNSlots{1};
@@ -119,6 +149,12 @@ class RLoopManager : public RNodeBase {
    std::vector<Callback_t> fDataBlockCallbacks; ///< Registered callbacks to call at the beginning of each "data block"
    RDFInternal::RDataBlockNotifier fDataBlockNotifier;
    unsigned int fNRuns{0}; ///< Number of event loops run
+   /// In multi-process event loops, the part of the dataset processed by this process (see RunMultiProcess())
+   unsigned int fPartitionIdx{0};
+   unsigned int fNPartitions{1};
+   /// If fHasPartitionRange, the entries [begin, end) of the tree processed by this process instead (see RunCached())
+   bool fHasPartitionRange{false};
+   std::pair<ULong64_t, ULong64_t> fPartitionRange{0ull, 0ull};
 
    /// Registry of per-slot value pointers for booked data-source columns
    std::map<std::string, std::vector<void *>> fDSValuePtrMap;
@@ -126,6 +162,31 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// Jitted Filters and Defines booked so far, indexed by their expression and by the nodes that produce their
+   /// inputs (see RDFInternal::BookFilterJit and RDFInternal::BookDefineJit). Identical nodes are booked only once.
+   std::unordered_map<std::string, std::weak_ptr<RJittedFilter>> fJittedFilters;
+   std::unordered_map<std::string, std::weak_ptr<RJittedDefine>> fJittedDefines;
+   /// The Filters, Defines and Ranges that can be written out as typed C++ code, indexed by their address
+   std::unordered_map<const void *, RDFInternal::RCodeGenStep> fCodeGenSteps;
+   unsigned int fNCodeGenSteps = 0u;
+
+   /// Collects the time spent in each node during the event loops, if profiling was enabled (see EnableProfiling())
+   std::shared_ptr<RDFInternal::RProfiler> fProfiler;
+   /// Reports the progress of the event loops, if enabled (see EnableProgressReport())
+   std::shared_ptr<RDFInternal::RProgressMonitor> fProgressMonitor;
+
+   /// If true, branches that are only read downstream of a Filter are not prefetched by the TTreeCache
+   bool fStagedTreeCache{false};
+   /// If non-zero, histograms booked from now on are shared by all slots, which buffer this many fills each
+   unsigned int fSharedFillBufferSize{0};
+   /// Dataset columns read for every entry and only for some entries, collected in InitNodes (see RegisterColumnsRead())
+   std::set<std::string> fEagerColumns;
+   std::set<std::string> fLazyColumns;
+   /// Branches that are dropped from the TTreeCache of every tree of the dataset, if fStagedTreeCache is set
+   std::vector<std::string> fLazyBranches;
+   /// The TTreeReader of each processing slot, set while a task is running
+   std::vector<TTreeReader *> fTreeReaders;
+
    void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -140,6 +201,10 @@ class RLoopManager : public RNodeBase {
    void CleanUpTask(TTreeReader *r, unsigned int slot);
    void EvalChildrenCounts();
    void SetupDataBlockCallbacks(TTreeReader *r, unsigned int slot);
+   void SetupLazyBranches();
+   void DropLazyBranchesFromCache(unsigned int slot);
+   std::pair<ULong64_t, ULong64_t> GetPartitionEntryRange(ULong64_t nEntries) const;
+   Long64_t GetNEntriesToProcess() const;
 
 public:
    RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
@@ -152,8 +217,12 @@ public:
    void Jit();
    RLoopManager *GetLoopManagerUnchecked() final { return this; }
    void Run();
+   void RunMultiProcess(unsigned int nWorkers, const std::vector<void *> &results);
+   void RunCached(const std::string &cacheDir, unsigned int nWorkers, const std::vector<void *> &results);
    const ColumnNames_t &GetDefaultColumnNames() const;
    TTree *GetTree() const;
+   TEntryList *GetEntryList() const;
+   void SetEntryList(std::unique_ptr<TEntryList> entryList);
    ::TDirectory *GetDirectory() const;
    ULong64_t GetNEmptyEntries() const { return fNEmptyEntries; }
    RDataSource *GetDataSource() const { return fDataSource.get(); }
@@ -198,6 +267,58 @@ public:
    const ColumnNames_t &GetBranchNames();
 
    void AddDataBlockCallback(std::function<void(unsigned int)> &&callback);
+
+   void EnableProfiling();
+   /// Return the profiler of this computation graph, or nullptr if profiling is not enabled
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler.get(); }
+   /// Report the progress of the following event loops to `callback` every `intervalSeconds`, sampling the number of
+   /// entries processed by each slot every `sampleEveryN` entries
+   void EnableProgressReport(std::function<void(const ROOT::RDF::Experimental::RProgressInfo &)> callback,
+                             double intervalSeconds, ULong64_t sampleEveryN);
+
+   /// Choose whether branches that are only read downstream of a Filter are left out of the TTreeCache.
+   /// Their baskets are then only read if an entry that passes the filters needs them.
+   void SetStagedTreeCache(bool enable) { fStagedTreeCache = enable; }
+   /// Choose whether the histograms booked from now on are filled by all slots at once, each slot buffering up to
+   /// `bufferSize` fills, instead of being cloned once per slot. Zero disables shared filling.
+   void SetSharedFillBufferSize(unsigned int bufferSize) { fSharedFillBufferSize = bufferSize; }
+   unsigned int GetSharedFillBufferSize() const { return fSharedFillBufferSize; }
+   /// Remove the given file when this RLoopManager is destroyed
+   void AddTemporaryFile(const std::string &path) { fTemporaryFiles.Add(path); }
+   void RegisterColumnsRead(const ColumnNames_t &columns, const RDFInternal::RBookedDefines &defines, bool eager);
+
+   /// Return the jitted filter booked with the given key, or nullptr if there is none that is still in use
+   std::shared_ptr<RJittedFilter> GetJittedFilter(const std::string &key) const
+   {
+      auto it = fJittedFilters.find(key);
+      return it == fJittedFilters.end() ? nullptr : it->second.lock();
+   }
+   void RegisterJittedFilter(const std::string &key, const std::shared_ptr<RJittedFilter> &filter)
+   {
+      fJittedFilters[key] = filter;
+   }
+   /// Return the jitted define booked with the given key, or nullptr if there is none that is still in use
+   std::shared_ptr<RJittedDefine> GetJittedDefine(const std::string &key) const
+   {
+      auto it = fJittedDefines.find(key);
+      return it == fJittedDefines.end() ? nullptr : it->second.lock();
+   }
+   void RegisterJittedDefine(const std::string &key, const std::shared_ptr<RJittedDefine> &define)
+   {
+      fJittedDefines[key] = define;
+   }
+   /// Record the code of a Filter, Define or Range booked at the given address
+   void RegisterCodeGenStep(const void *key, RDFInternal::RCodeGenStep &&step)
+   {
+      step.fIndex = fNCodeGenSteps++;
+      fCodeGenSteps[key] = std::move(step);
+   }
+   /// Return the code of the Filter, Define or Range at the given address, or nullptr if none was recorded
+   const RDFInternal::RCodeGenStep *GetCodeGenStep(const void *key) const
+   {
+      auto it = fCodeGenSteps.find(key);
+      return it == fCodeGenSteps.end() || it->second.fObject.expired() ? nullptr : &it->second;
+   }
 };
 
 } // ns RDF
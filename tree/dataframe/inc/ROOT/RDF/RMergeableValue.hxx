@@ -20,6 +20,7 @@
 #include <memory>
 #include <stdexcept>
 #include <algorithm> // std::min, std::max
+#include <type_traits>
 
 #include "RtypesCore.h"
 #include "TList.h" // RMergeableFill::Merge
@@ -57,6 +58,19 @@ public:
       (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
    */
    RMergeableValueBase() = default;
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Type-erased version of the `Merge` methods, for mergeables whose
+   ///        result type is only known at runtime, e.g. because they were
+   ///        received from another process.
+   /// \throws std::invalid_argument If the other mergeable does not hold a
+   ///         result of the same type of action.
+   virtual void MergeAny(const RMergeableValueBase &other) = 0;
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Copy-assign the wrapped result to the action result object at
+   ///        `destination`, which must be of the type of the wrapped result.
+   /// \throws std::logic_error If the result type is not copy-assignable.
+   virtual void CopyValueTo(void *destination) const = 0;
 };
 
 /**
@@ -145,6 +159,17 @@ class RMergeableValue : public RMergeableValueBase {
    /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
    virtual void Merge(const RMergeableValue<T> &) = 0;
 
+   template <typename U>
+   static auto AssignValue(U &destination, const U &source, int) -> decltype(destination = source, void())
+   {
+      destination = source;
+   }
+   template <typename U>
+   static void AssignValue(U &, const U &, long)
+   {
+      throw std::logic_error("The result of this action cannot be copied to another object.");
+   }
+
 protected:
    T fValue;
 
@@ -164,6 +189,16 @@ public:
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Retrieve the result wrapped by this mergeable.
    const T &GetValue() const { return fValue; }
+
+   void MergeAny(const RMergeableValueBase &other) final
+   {
+      const auto othercast = dynamic_cast<const RMergeableValue<T> *>(&other);
+      if (!othercast)
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      Merge(*othercast);
+   }
+
+   void CopyValueTo(void *destination) const final { AssignValue(*static_cast<T *>(destination), fValue, 0); }
 };
 
 /**
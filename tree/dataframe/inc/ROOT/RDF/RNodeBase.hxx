@@ -11,10 +11,14 @@
 #ifndef ROOT_RDFNODEBASE
 #define ROOT_RDFNODEBASE
 
+#include "ROOT/RDF/RBookedDefines.hxx"
 #include "RtypesCore.h"
 
+#include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 
 namespace ROOT {
@@ -43,6 +47,8 @@ protected:
    RLoopManager *fLoopManager;
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
+   /// The clones of this node that process the systematic variations, by variation name and index
+   std::map<std::pair<std::string, std::size_t>, std::shared_ptr<RNodeBase>> fVariedFilters;
 
 public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
@@ -63,6 +69,33 @@ public:
    }
 
    virtual RLoopManager *GetLoopManagerUnchecked() { return fLoopManager; }
+
+   /// Add the systematic variations that affect this node or the nodes upstream of it to `variations`.
+   virtual void AddVariations(ROOT::Internal::RDF::RVariationTags_t &) const {}
+
+   bool HasVariation(const std::string &variationName) const
+   {
+      ROOT::Internal::RDF::RVariationTags_t variations;
+      AddVariations(variations);
+      return variations.count(variationName) > 0;
+   }
+
+   /// Create a clone of this node (and of the upstream nodes affected by the variation) that processes the varied
+   /// value with index `varIdx` of the given variation.
+   virtual std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &, std::size_t)
+   {
+      throw std::logic_error("This node does not support systematic variations.");
+   }
+
+   /// Return the clone of this node for the given varied value, creating it on first use.
+   /// All the nodes that process the same varied value share the same clone.
+   std::shared_ptr<RNodeBase> GetVariedFilter(const std::string &variationName, std::size_t varIdx)
+   {
+      auto &variedFilter = fVariedFilters[{variationName, varIdx}];
+      if (!variedFilter)
+         variedFilter = MakeVariedFilter(variationName, varIdx);
+      return variedFilter;
+   }
 };
 } // ns RDF
 } // ns Detail
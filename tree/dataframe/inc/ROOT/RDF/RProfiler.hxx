@@ -0,0 +1,168 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/// The time spent in one node of an RDataFrame computation graph, see EnableProfiling()
+struct RNodeProfile {
+   std::string fKind;  ///< "Filter", "Define", "Action" or "Column" (the readers of a dataset column)
+   std::string fName;  ///< Name of the filter, of the defined or dataset column, or of the action
+   double fTime = 0.; ///< Wall-clock seconds spent in the node itself, summed over all processing slots
+   std::vector<double> fTimePerSlot; ///< The contribution of each processing slot to fTime
+   ULong64_t fNCalls = 0;            ///< Number of evaluations, e.g. the number of entries checked by a filter
+};
+
+/// The profile of all the nodes of an RDataFrame computation graph, sorted by decreasing time
+class RProfileReport {
+   std::vector<RNodeProfile> fNodeProfiles;
+
+public:
+   using const_iterator = std::vector<RNodeProfile>::const_iterator;
+
+   RProfileReport() = default;
+   explicit RProfileReport(std::vector<RNodeProfile> nodeProfiles);
+
+   const std::vector<RNodeProfile> &GetNodeProfiles() const { return fNodeProfiles; }
+   const_iterator begin() const { return fNodeProfiles.begin(); }
+   const_iterator end() const { return fNodeProfiles.end(); }
+   /// Print a table with one row per node
+   void Print(std::ostream &os = std::cout) const;
+};
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+/// Collects the time spent in the nodes of a computation graph, per processing slot.
+///
+/// Nodes measure their evaluations with an RProfiledScope. The time of an evaluation is the node's own time: the time
+/// spent in the nested evaluations of other nodes, such as the defines and the columns that it reads, is subtracted.
+/// Every slot only updates its own counters, so that no synchronization is needed during the event loop.
+class RProfiler {
+public:
+   enum class ENodeKind { kFilter, kDefine, kAction, kColumn };
+   using Clock_t = std::chrono::steady_clock;
+
+   /// The counters of one processing slot, indexed by node ID
+   struct RSlotCounters {
+      std::vector<Clock_t::duration> fSelfTime;
+      std::vector<ULong64_t> fNCalls;
+      /// Time spent in the nested evaluations of the node that is currently being evaluated
+      Clock_t::duration fNestedTime{0};
+      char fPadding[64]; ///< avoid false sharing of fNestedTime between slots
+   };
+
+private:
+   struct RNodeInfo {
+      ENodeKind fKind;
+      std::string fName;
+   };
+
+   std::mutex fMutex; ///< Protects the registration of nodes, which can happen concurrently in InitSlot
+   std::vector<RNodeInfo> fNodes;
+   std::unordered_map<const void *, unsigned int> fNodeIDs;
+   /// Dataset columns are profiled by name, summing over the readers of the column held by different nodes
+   std::unordered_map<std::string, unsigned int> fColumnIDs;
+   std::vector<RSlotCounters> fSlots;
+
+public:
+   explicit RProfiler(unsigned int nSlots);
+   RProfiler(const RProfiler &) = delete;
+   RProfiler &operator=(const RProfiler &) = delete;
+
+   /// Return the ID of the given node, registering it if needed
+   unsigned int RegisterNode(ENodeKind kind, const std::string &name, const void *node);
+   /// Return the ID of the given dataset column, registering it if needed
+   unsigned int RegisterColumn(const std::string &name);
+   RSlotCounters &GetSlotCounters(unsigned int slot) { return fSlots[slot]; }
+   /// Wall-clock seconds spent in the given node, summed over all slots
+   double GetTime(unsigned int id) const;
+   ROOT::RDF::Experimental::RProfileReport GetReport() const;
+};
+
+/// Return the time spent in the node, formatted as an additional line for the node's label in SaveGraph(), or an
+/// empty string if `profiler` is null
+std::string GetProfileLabel(const RProfiler *profiler, unsigned int id);
+
+/// Measures one evaluation of a profiled node, from its construction to its destruction
+class RProfiledScope {
+   RProfiler::RSlotCounters &fCounters;
+   const unsigned int fID;
+   const RProfiler::Clock_t::duration fOuterNestedTime;
+   const RProfiler::Clock_t::time_point fStart;
+
+public:
+   RProfiledScope(RProfiler &profiler, unsigned int slot, unsigned int id)
+      : fCounters(profiler.GetSlotCounters(slot)), fID(id), fOuterNestedTime(fCounters.fNestedTime),
+        fStart(RProfiler::Clock_t::now())
+   {
+      fCounters.fNestedTime = RProfiler::Clock_t::duration::zero();
+   }
+   RProfiledScope(const RProfiledScope &) = delete;
+   RProfiledScope &operator=(const RProfiledScope &) = delete;
+
+   ~RProfiledScope()
+   {
+      const auto elapsed = RProfiler::Clock_t::now() - fStart;
+      if (fID >= fCounters.fSelfTime.size()) {
+         // nodes registered after the slot started counting, e.g. column readers created in a later task
+         fCounters.fSelfTime.resize(fID + 1, RProfiler::Clock_t::duration::zero());
+         fCounters.fNCalls.resize(fID + 1, 0);
+      }
+      fCounters.fSelfTime[fID] += elapsed - fCounters.fNestedTime;
+      ++fCounters.fNCalls[fID];
+      fCounters.fNestedTime = fOuterNestedTime + elapsed;
+   }
+};
+
+/// Column reader that measures the time spent reading a dataset column
+class R__CLING_PTRCHECK(off) RProfiledColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
+   std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> fReader;
+   RProfiler &fProfiler;
+   const unsigned int fSlot;
+   const unsigned int fID;
+
+   void *GetImpl(Long64_t entry) final
+   {
+      RProfiledScope scope(fProfiler, fSlot, fID);
+      return fReader->GetImpl(entry);
+   }
+
+public:
+   RProfiledColumnReader(std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> reader, RProfiler &profiler,
+                         unsigned int slot, const std::string &colName)
+      : fReader(std::move(reader)), fProfiler(profiler), fSlot(slot), fID(profiler.RegisterColumn(colName))
+   {
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROFILER
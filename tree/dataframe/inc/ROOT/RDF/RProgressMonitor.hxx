@@ -0,0 +1,103 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROGRESSMONITOR
+#define ROOT_RDF_RPROGRESSMONITOR
+
+#include "RtypesCore.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/// A snapshot of the progress of an event loop, see EnableProgressReport()
+struct RProgressInfo {
+   ULong64_t fNEntries = 0;  ///< Entries processed so far by all slots (sampled, see EnableProgressReport())
+   Long64_t fNEntriesTotal = -1; ///< Entries to be processed by the event loop, or -1 if not known in advance
+   ULong64_t fBytesRead = 0; ///< Bytes read from ROOT files since the start of the event loop, by the whole process
+   double fElapsed = 0.;     ///< Wall-clock seconds since the start of the event loop
+   double fEntriesPerSecond = 0.; ///< Average number of entries processed per second
+   double fMBPerSecond = 0.;      ///< Average number of MB (10^6 bytes) read from ROOT files per second
+   double fRemaining = -1.; ///< Estimated seconds until the end of the event loop, or -1 if the total is not known
+   std::vector<ULong64_t> fNEntriesPerSlot; ///< The contribution of each processing slot to fNEntries
+   std::vector<double> fEntriesPerSecondPerSlot; ///< Average number of entries per second processed by each slot
+   bool fIsDone = false; ///< Whether this is the final report, sent at the end of the event loop
+};
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+/// Samples the number of entries processed by each slot and periodically reports the progress of the event loop.
+///
+/// Every slot counts its entries privately and publishes the count to an atomic every fSampleEveryN entries. Only then
+/// it checks the clock and, if a report is due and no other slot is sending one, calls the callback: the cost per
+/// entry is one increment and one comparison.
+class RProgressMonitor {
+public:
+   using Clock_t = std::chrono::steady_clock;
+   using Callback_t = std::function<void(const ROOT::RDF::Experimental::RProgressInfo &)>;
+
+private:
+   struct RSlotCounter {
+      ULong64_t fNEntries = 0;                 ///< Only accessed by the processing slot
+      std::atomic<ULong64_t> fNPublished{0ull}; ///< The value of fNEntries at the last sample
+      char fPadding[64]; ///< avoid false sharing between slots
+   };
+
+   const Callback_t fCallback;
+   const Clock_t::duration fInterval;
+   const ULong64_t fSampleEveryN;
+   std::vector<RSlotCounter> fSlots;
+   Long64_t fNEntriesTotal = -1;
+   Long64_t fStartBytesRead = 0;
+   Clock_t::time_point fStart;
+   std::atomic<Clock_t::rep> fNextReport{0}; ///< Time of the next report, as a duration since fStart
+   std::mutex fCallbackMutex;               ///< Serializes the calls to fCallback
+
+   ROOT::RDF::Experimental::RProgressInfo MakeInfo(bool isDone) const;
+   void Report(Clock_t::time_point now);
+
+public:
+   RProgressMonitor(Callback_t callback, double intervalSeconds, ULong64_t sampleEveryN, unsigned int nSlots);
+   RProgressMonitor(const RProgressMonitor &) = delete;
+   RProgressMonitor &operator=(const RProgressMonitor &) = delete;
+
+   /// Reset the counters at the beginning of an event loop over `nEntriesTotal` entries (-1 if not known)
+   void Start(Long64_t nEntriesTotal);
+   /// Send the final report of the event loop
+   void Stop();
+
+   /// Count one entry processed by the given slot
+   void Update(unsigned int slot)
+   {
+      auto &counter = fSlots[slot];
+      if (++counter.fNEntries % fSampleEveryN != 0)
+         return;
+      counter.fNPublished.store(counter.fNEntries, std::memory_order_relaxed);
+      const auto now = Clock_t::now();
+      if ((now - fStart).count() >= fNextReport.load(std::memory_order_relaxed))
+         Report(now);
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -98,6 +98,16 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
+   void AddVariations(RDFInternal::RVariationTags_t &variations) const final { fPrevData.AddVariations(variations); }
+
+   std::shared_ptr<RNodeBase> MakeVariedFilter(const std::string &variationName, std::size_t varIdx) final
+   {
+      auto prevDataPtr = std::static_pointer_cast<PrevData>(fPrevData.GetVariedFilter(variationName, varIdx));
+      auto variedRange = std::make_shared<RRange>(fStart, fStop, fStride, std::move(prevDataPtr));
+      fLoopManager->Book(variedRange.get());
+      return variedRange;
+   }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // TODO: Ranges node have no information about custom columns, hence it is not possible now
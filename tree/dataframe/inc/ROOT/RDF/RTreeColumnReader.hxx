@@ -17,24 +17,78 @@
 #include <TTreeReader.h>
 #include <TTreeReaderValue.h>
 #include <TTreeReaderArray.h>
+#include <TBufferFile.h>
+#include <TDataType.h> // EDataType
 
 #include <memory>
 #include <string>
+#include <type_traits>
+
+class TBranch;
+class TTree;
 
 namespace ROOT {
 namespace Internal {
 namespace RDF {
 
+/// Reader of the branches holding one fundamental value per entry, which bypasses the TTreeReader proxies.
+///
+/// The values are read basket by basket with the TBranch bulk API, deserialized in place in a buffer owned by the
+/// reader, and the following entries of the basket are served from that buffer. The reader gives up, returning
+/// nullptr, when the branch of the current tree does not qualify: it must not be a friend or an alias, have a
+/// single leaf of the requested type without count leaf, and support bulk reading.
+class RTreeBulkReader {
+   TTreeReader &fReader;
+   std::string fBranchName;
+   EDataType fType;
+   TTree *fTree = nullptr;     ///< Tree of fBranch
+   Int_t fTreeNumber = -1;     ///< Number of fTree in the chain being read
+   TBranch *fBranch = nullptr; ///< Branch read in fTree
+   TBufferFile fBuffer{TBuffer::kWrite, 32 * 1024}; ///< Deserialized values of the current basket
+   Long64_t fFirstEntry = 0;   ///< First entry of the current basket, local to fTree
+   Long64_t fNEntries = 0;     ///< Number of entries of the current basket
+   Int_t fValueSize;           ///< Size in bytes of one value
+
+   bool UpdateBranch();
+
+public:
+   RTreeBulkReader(TTreeReader &r, const std::string &colName, EDataType type, Int_t valueSize);
+   void *Get();
+};
+
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderValues
+///
+/// The values of fundamental types are read whenever possible with a RTreeBulkReader, falling back to the
+/// TTreeReaderValue otherwise.
 template <typename T>
 class R__CLING_PTRCHECK(off) RTreeColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
    std::unique_ptr<TTreeReaderValue<T>> fTreeValue;
+   std::unique_ptr<RTreeBulkReader> fBulkReader;
+
+   void *GetImpl(Long64_t) final
+   {
+      if (fBulkReader) {
+         if (auto addr = fBulkReader->Get())
+            return addr;
+         fBulkReader.reset();
+      }
+      return fTreeValue->Get();
+   }
+
+   static std::unique_ptr<RTreeBulkReader> MakeBulkReader(TTreeReader &r, const std::string &colName)
+   {
+      if (!std::is_arithmetic<T>::value)
+         return nullptr;
+      const auto type = TDataType::GetType(typeid(T));
+      if (type == kOther_t || type == kNoType_t)
+         return nullptr;
+      return std::make_unique<RTreeBulkReader>(r, colName, type, sizeof(T));
+   }
 
-   void *GetImpl(Long64_t) final { return fTreeValue->Get(); }
 public:
    /// Construct the RTreeColumnReader. Actual initialization is performed lazily by the Init method.
    RTreeColumnReader(TTreeReader &r, const std::string &colName)
-      : fTreeValue(std::make_unique<TTreeReaderValue<T>>(r, colName.c_str()))
+      : fTreeValue(std::make_unique<TTreeReaderValue<T>>(r, colName.c_str())), fBulkReader(MakeBulkReader(r, colName))
    {
    }
 
@@ -46,7 +100,11 @@ public:
    // - Thread #2) a task starts and overwrites thread-local TTreeReaderValues
    // - Thread #1) first task deletes TTreeReader
    // See https://github.com/root-project/root/commit/26e8ace6e47de6794ac9ec770c3bbff9b7f2e945
-   ~RTreeColumnReader() { fTreeValue.reset(); }
+   ~RTreeColumnReader()
+   {
+      fBulkReader.reset();
+      fTreeValue.reset();
+   }
 };
 
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderArrays.
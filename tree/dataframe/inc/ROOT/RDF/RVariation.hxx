@@ -0,0 +1,140 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RVARIATION
+#define ROOT_RDF_RVARIATION
+
+#include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RVariationBase.hxx"
+#include "ROOT/RDF/Utils.hxx"
+#include "ROOT/RStringView.hxx"
+#include "ROOT/TypeTraits.hxx"
+#include "RtypesCore.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility> // std::index_sequence
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Detail {
+namespace RDF {
+
+using namespace ROOT::TypeTraits;
+
+/// The systematic variations of a column, evaluated by a callable that returns all varied values as an RVec.
+template <typename F>
+class R__CLING_PTRCHECK(off) RVariation final : public RVariationBase {
+   using ColumnTypes_t = typename CallableTraits<F>::arg_types;
+   using TypeInd_t = std::make_index_sequence<ColumnTypes_t::list_size>;
+   using ret_type = typename CallableTraits<F>::ret_type;
+   using VariedCol_t = typename ret_type::value_type;
+   // Avoid instantiating vector<bool> as `operator[]` returns temporaries in that case. Use std::deque instead.
+   using Values_t =
+      std::conditional_t<std::is_same<VariedCol_t, bool>::value, std::deque<VariedCol_t>, std::vector<VariedCol_t>>;
+
+   F fExpression;
+   const ColumnNames_t fInputColumns;
+   /// The varied values per slot. They are copied out of the RVec returned by the expression so that their addresses,
+   /// which the column readers of the varied nodes hold on to, do not change from one entry to the next.
+   std::vector<Values_t> fLastResults;
+
+   /// Column readers per slot and per input column
+   std::vector<std::array<std::unique_ptr<RColumnReaderBase>, ColumnTypes_t::list_size>> fValues;
+
+   /// The nth flag signals whether the nth input column is a custom column or not.
+   std::array<bool, ColumnTypes_t::list_size> fIsDefine;
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      const auto results = fExpression(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      if (results.size() != fTags.size()) {
+         throw std::runtime_error("Vary: the expression for variation \"" + fVariationName + "\" returned " +
+                                  std::to_string(results.size()) + " values, but " + std::to_string(fTags.size()) +
+                                  " tags were specified.");
+      }
+      std::copy(results.begin(), results.end(), fLastResults[slot].begin());
+      // silence "unused parameter" warnings in gcc
+      (void)slot;
+      (void)entry;
+   }
+
+public:
+   RVariation(std::string_view colName, std::string_view variationName, const std::vector<std::string> &tags,
+              std::string_view type, F expression, const ColumnNames_t &inputColumns, unsigned int nSlots,
+              const RDFInternal::RBookedDefines &defines,
+              const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds)
+      : RVariationBase(colName, variationName, tags, type, nSlots, defines, DSValuePtrs, ds),
+        fExpression(std::move(expression)), fInputColumns(inputColumns),
+        fLastResults(fNSlots, Values_t(fTags.size())), fValues(fNSlots), fIsDefine()
+   {
+      const auto nColumns = fInputColumns.size();
+      for (auto i = 0u; i < nColumns; ++i)
+         fIsDefine[i] = fDefines.HasName(fInputColumns[i]);
+   }
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final
+   {
+      if (!fIsInitialized[slot]) {
+         fIsInitialized[slot] = true;
+         for (auto &define : fDefines.GetColumns())
+            define.second->InitSlot(r, slot);
+         RDFInternal::RColumnReadersInfo info{fInputColumns, fDefines, fIsDefine.data(), fDSValuePtrs, fDataSource};
+         fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
+         fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+      }
+   }
+
+   void *GetValuePtr(unsigned int slot, std::size_t varIdx) final
+   {
+      return static_cast<void *>(&fLastResults[slot][varIdx]);
+   }
+
+   void Update(unsigned int slot, Long64_t entry) final
+   {
+      if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
+         UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+         fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
+      }
+   }
+
+   const std::type_info &GetTypeId() const final { return typeid(VariedCol_t); }
+
+   void AddDatasetColumns(std::set<std::string> &columns) const final
+   {
+      RDFInternal::AddDatasetColumns(fInputColumns, fDefines, columns);
+   }
+
+   void FinaliseSlot(unsigned int slot) final
+   {
+      if (fIsInitialized[slot]) {
+         for (auto &define : fDefines.GetColumns())
+            define.second->FinaliseSlot(slot);
+         for (auto &v : fValues[slot])
+            v.reset();
+         fIsInitialized[slot] = false;
+      }
+   }
+};
+
+} // namespace RDF
+} // namespace Detail
+} // namespace ROOT
+
+#endif // ROOT_RDF_RVARIATION
@@ -0,0 +1,92 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RVARIATIONBASE
+#define ROOT_RDF_RVARIATIONBASE
+
+#include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace RDF {
+class RDataSource;
+}
+namespace Detail {
+namespace RDF {
+
+namespace RDFInternal = ROOT::Internal::RDF;
+
+class RDefineBase;
+
+/// The systematic variations of a column, booked with RInterface::Vary.
+///
+/// A variation evaluates all the varied values of the column at once, at most once per entry. Each varied value is
+/// exposed to the nodes that process that variation by a define node that takes the place of the nominal column, see
+/// GetVariedValue().
+class RVariationBase {
+protected:
+   const std::string fColumnName;             ///< The name of the varied column
+   const std::string fVariationName;          ///< The name of this set of variations, e.g. "pt"
+   const std::vector<std::string> fTags;      ///< The names of the varied values, e.g. {"down", "up"}
+   const std::string fType;                   ///< The type of the varied column as a text string
+   const unsigned int fNSlots;                ///< number of thread slots used by this node
+   std::vector<Long64_t> fLastCheckedEntry;
+   RDFInternal::RBookedDefines fDefines;      ///< The defines that the expression can read
+   std::deque<bool> fIsInitialized;           // because vector<bool> is not thread-safe
+   const std::map<std::string, std::vector<void *>> &fDSValuePtrs; // reference to RLoopManager's data member
+   ROOT::RDF::RDataSource *fDataSource; ///< non-owning ptr to the RDataSource, if any. Used to retrieve column readers.
+   /// The define nodes that expose the varied values, one per tag, created on demand
+   std::vector<std::shared_ptr<RDefineBase>> fVariedValues;
+
+public:
+   RVariationBase(std::string_view colName, std::string_view variationName, const std::vector<std::string> &tags,
+                  std::string_view type, unsigned int nSlots, const RDFInternal::RBookedDefines &defines,
+                  const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds);
+   RVariationBase(const RVariationBase &) = delete;
+   RVariationBase &operator=(const RVariationBase &) = delete;
+   virtual ~RVariationBase();
+
+   virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
+   /// Return the (type-erased) address of the varied value with index `varIdx` for the given processing slot.
+   virtual void *GetValuePtr(unsigned int slot, std::size_t varIdx) = 0;
+   /// The type of the varied values, i.e. of the varied column.
+   virtual const std::type_info &GetTypeId() const = 0;
+   /// Update the values at the addresses returned by GetValuePtr with the content corresponding to the given entry
+   virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Clean-up operations to be performed at the end of a task.
+   virtual void FinaliseSlot(unsigned int slot) = 0;
+   /// Add the names of the dataset columns read by the expression, directly or through defines, to `columns`.
+   virtual void AddDatasetColumns(std::set<std::string> &columns) const = 0;
+
+   const std::string &GetColumnName() const { return fColumnName; }
+   const std::string &GetVariationName() const { return fVariationName; }
+   const std::vector<std::string> &GetTags() const { return fTags; }
+   std::string GetTypeName() const { return fType; }
+   /// Return the define node that exposes the varied value with index `varIdx` in place of the nominal column.
+   /// The node is shared by all the nodes that process this varied value.
+   std::shared_ptr<RDefineBase> GetVariedValue(std::size_t varIdx);
+};
+
+} // namespace RDF
+} // namespace Detail
+} // namespace ROOT
+
+#endif // ROOT_RDF_RVARIATIONBASE
@@ -22,6 +22,7 @@
 #include <functional>
 #include <memory>
 #include <new> // std::hardware_destructive_interference_size
+#include <stdexcept>
 #include <string>
 #include <type_traits> // std::decay
 #include <vector>
@@ -191,6 +192,21 @@ void Erase(const T &that, std::vector<T> &v)
    v.erase(std::remove(v.begin(), v.end(), that), v.end());
 }
 
+/// Return a copy of the callable `f`, used by the clones of the nodes that process a systematic variation.
+/// `where` is the name of the operation that booked the callable, used in the error message.
+template <typename F, std::enable_if_t<std::is_copy_constructible<F>::value, int> = 0>
+F CopyForVariation(const F &f, const std::string &)
+{
+   return f;
+}
+
+template <typename F, std::enable_if_t<!std::is_copy_constructible<F>::value, int> = 0>
+F CopyForVariation(const F &, const std::string &where)
+{
+   throw std::runtime_error("The callable passed to " + where +
+                            " cannot be copied, so it cannot be used to process systematic variations.");
+}
+
 /// Declare code in the interpreter via the TInterpreter::Declare method, throw in case of errors
 void InterpreterDeclare(const std::string &code);
 
@@ -223,6 +239,18 @@ constexpr std::size_t CacheLineStep() {
    return (kCacheLineSize + sizeof(T) - 1) / sizeof(T);
 }
 
+/// Owns a list of files, which are removed from disk when this object is destroyed
+class RTemporaryFiles {
+   std::vector<std::string> fPaths;
+
+public:
+   RTemporaryFiles() = default;
+   RTemporaryFiles(const RTemporaryFiles &) = delete;
+   RTemporaryFiles &operator=(const RTemporaryFiles &) = delete;
+   ~RTemporaryFiles();
+   void Add(const std::string &path) { fPaths.emplace_back(path); }
+};
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
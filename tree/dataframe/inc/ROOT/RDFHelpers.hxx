@@ -16,6 +16,8 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RResultHandle.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
+#include <ROOT/RDF/RProfiler.hxx>
+#include <ROOT/RDF/RProgressMonitor.hxx>
 #include <ROOT/TypeTraits.hxx>
 
 #include <algorithm> // std::transform
@@ -23,6 +25,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -181,6 +184,223 @@ RNode AsRNode(NodeType node)
 // clang-format on
 void RunGraphs(std::vector<RResultHandle> handles);
 
+// clang-format off
+/// Trigger the event loop of multiple RDataFrames concurrently, reporting when each of them is done
+/// \param[in] handles A vector of RResultHandles
+/// \param[in] onGraphDone Called after the event loop of each computation graph has finished
+///
+/// As RunGraphs(std::vector<RResultHandle>). The computation graphs are numbered in the order in which they first
+/// appear in `handles`: `onGraphDone` receives the index of the graph whose event loop has just finished and the
+/// number of graphs that are done so far. The calls are serialized, so the callback does not need to be thread-safe,
+/// but they can come from any thread and in any order.
+///
+/// With implicit multi-threading enabled, the tasks of all the event loops are scheduled on the same thread pool:
+/// running many small datasets together boils down to interleaving their tasks rather than running them one by one.
+///
+/// ~~~{.cpp}
+/// // one histogram per sample, each from its own RDataFrame
+/// std::vector<ROOT::RDF::RResultHandle> histos = BookHistos(samples);
+/// ROOT::RDF::RunGraphs(histos, [&](unsigned int graphIdx, unsigned int nDone) {
+///    std::cout << samples[graphIdx] << " done (" << nDone << "/" << samples.size() << ")\n";
+/// });
+/// ~~~
+// clang-format on
+void RunGraphs(std::vector<RResultHandle> handles,
+               std::function<void(unsigned int graphIdx, unsigned int nDone)> onGraphDone);
+
+namespace Experimental {
+
+// clang-format off
+/// Run the event loops of the computation graphs of the given results in forked worker processes
+/// \param[in] handles A vector of RResultHandles; the results of all the actions booked in their graphs
+/// \param[in] nWorkers The number of worker processes per computation graph
+///
+/// Every worker process runs the event loop on a different part of the dataset and sends its partial results back to
+/// the calling process, where they are merged via RMergeableValue. Trees and empty sources are split into contiguous
+/// entry ranges of similar size, the entry ranges of data sources are distributed round-robin. The workers are forked
+/// after the computation graph is jitted, so that they inherit it: no code needs to be shipped.
+///
+/// Restrictions:
+/// - the handles must comprise every action booked in their computation graphs, and all the actions must support
+///   GetMergeableValue(), e.g. Count, Sum, Min, Max, Mean, Histo*D, Profile*D, Graph and Stats
+/// - the RDataFrames must be constructed with implicit multi-threading disabled, and must not contain Range nodes
+/// - side effects of user code, e.g. of Foreach or of callbacks registered with OnPartialResult, stay in the workers
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// auto h = df.Histo1D("var1");
+/// auto n = df.Filter("var2 > 0").Count();
+/// ROOT::RDF::Experimental::RunGraphsMP({h, n}, 8);
+/// ~~~
+// clang-format on
+void RunGraphsMP(std::vector<RResultHandle> handles, unsigned int nWorkers);
+
+// clang-format off
+/// Run the event loops of the computation graphs of the given results, reusing the partial results of previous runs
+/// \param[in] handles A vector of RResultHandles; the results of all the actions booked in their graphs
+/// \param[in] cacheDir The directory where the partial results are stored, created if needed
+/// \param[in] nWorkers The maximum number of worker processes running at the same time
+///
+/// The partial result of every action on every input file is stored in `cacheDir`, under a key computed from the
+/// code of the just-in-time-compiled Filters and Defines upstream of the action, the columns it reads, its
+/// configuration (e.g. the model of a histogram) and the identity of the file (its UUID, size, tree name and number of
+/// entries). When the graph is run again, only the files for which some of the results are not in the cache are
+/// processed, each in a forked worker process; the partial results of all the files are then merged via
+/// RMergeableValue. Editing a Filter, a Define or an action, or adding files to the dataset, therefore only reprocesses
+/// the files whose results are affected. Files that are processed are run with all the actions of the graph.
+///
+/// Restrictions, in addition to those of RunGraphsMP():
+/// - the graphs must read a TTree or TChain from files, without friends
+/// - all the Filters and Defines upstream of the actions must be booked with string expressions, whose code is part of
+///   the cache keys: the code of C++ callables cannot be inspected
+/// - the functions called by the expressions are not part of the keys: the cache must be removed when they change
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", {"file1.root", "file2.root"});
+/// auto h = df.Define("pt2", "pt * pt").Histo1D({"h", "h", 100, 0., 1000.}, "pt2");
+/// ROOT::RDF::Experimental::RunGraphsCached({h}, "rdfcache", 4);
+/// ~~~
+// clang-format on
+void RunGraphsCached(std::vector<RResultHandle> handles, const std::string &cacheDir, unsigned int nWorkers = 1);
+
+// clang-format off
+/// Measure the time spent in each node of a computation graph during the following event loops
+/// \param[in] node Any node of the graph; the whole graph is profiled
+///
+/// The profiler measures the wall-clock time spent by every Filter, Define and action in its own code, i.e. excluding
+/// the time spent in the upstream Defines it reads, and the time spent reading each column of the dataset. Every
+/// processing slot keeps its own counters, so profiling does not add synchronization to multi-thread event loops, but
+/// it does add two clock reads per node evaluation: nodes doing very little work per entry appear slower than they are.
+/// The results are returned by GetProfileReport() and are shown in the output of SaveGraph().
+/// Profiles of the worker processes of RunGraphsMP() are not collected.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::Experimental::EnableProfiling(df);
+/// auto h = df.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+/// h->Draw();
+/// ROOT::RDF::Experimental::GetProfileReport(df).Print();
+/// ~~~
+// clang-format on
+void EnableProfiling(RNode node);
+
+/// Return the time spent in each node of the computation graph of `node`, summed over the event loops run since the
+/// call to EnableProfiling(). Throws if profiling was not enabled for this computation graph.
+RProfileReport GetProfileReport(RNode node);
+
+// clang-format off
+/// Periodically report the progress of the following event loops of a computation graph
+/// \param[in] node Any node of the graph; the progress of the event loops of the whole graph is reported
+/// \param[in] callback Called with an RProgressInfo during the event loop, and once more at its end
+/// \param[in] intervalSeconds Minimum wall-clock time between two reports during the event loop
+/// \param[in] sampleEveryN Every processing slot publishes its number of processed entries every `sampleEveryN` entries
+///
+/// The report comprises the number of entries processed so far, in total and per processing slot (e.g. to spot
+/// stragglers), the bytes read from ROOT files since the start of the event loop, average rates and an estimate of the
+/// remaining time, when the number of entries to process is known in advance (empty sources and TTrees, or TChains
+/// whose number of entries is known). Entry counts are sampled: they lag behind by less than `sampleEveryN`
+/// entries per slot, except in the final report. The bytes read are those of the whole process, as returned by
+/// TFile::GetFileBytesRead().
+///
+/// Reports are sent by the processing slots themselves: the callback must return quickly, as the slot that calls it
+/// does not process entries in the meantime. Calls are serialized, so the callback does not need to be thread-safe.
+/// Calling this function again replaces the previous callback.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("Events", "file.root");
+/// ROOT::RDF::Experimental::EnableProgressReport(df, [](const ROOT::RDF::Experimental::RProgressInfo &p) {
+///    std::cout << p.fNEntries << "/" << p.fNEntriesTotal << " entries, ETA " << p.fRemaining << " s\n";
+/// });
+/// ~~~
+// clang-format on
+void EnableProgressReport(RNode node, std::function<void(const RProgressInfo &)> callback, double intervalSeconds = 1.,
+                          ULong64_t sampleEveryN = 1000);
+
+// clang-format off
+/// Leave the branches that are only read downstream of a Filter out of the TTreeCache
+/// \param[in] node Any node of the graph; the setting applies to the event loops of the whole graph
+/// \param[in] enable Whether staged caching is used
+///
+/// By default the TTreeCache prefetches the baskets of all the branches read by the computation graph. With staged
+/// caching, only the branches read by the Filters and actions attached directly to the RDataFrame are prefetched; the
+/// baskets of the other branches are only read when an entry that passes the upstream Filters needs them. This avoids
+/// fetching baskets of events that fail early selective cuts, at the price of one read request per basket for those
+/// branches: it pays off for very selective Filters, and it can be much slower for loose ones, especially with remote
+/// files.
+// clang-format on
+void EnableStagedTreeCache(RNode node, bool enable = true);
+
+// clang-format off
+/// Fill the histograms booked from now on with a single object shared by all processing slots
+/// \param[in] node Any node of the graph; the setting applies to the histograms booked anywhere in the graph afterwards
+/// \param[in] enable Whether shared filling is used
+/// \param[in] bufferSize The number of fills that each slot buffers before replaying them into the shared histogram
+///
+/// By default, multi-thread event loops clone each histogram (Histo1D with axis limits, Histo2D, Histo3D,
+/// Profile1D, Profile2D and Fill with TH1-derived objects) once per processing slot, and merge the clones at the end
+/// of the event loop: memory usage grows with the number of bins times the number of slots. With shared filling, every
+/// slot buffers the arguments of its fills and replays them into the single result histogram under a lock, when its
+/// buffer is full and at the end of each task, so memory usage does not depend on the number of bins. Larger buffers
+/// mean less contention on the lock. Profile1D and Profile2D with fixed axis limits do not use buffers: all slots fill
+/// them at the same time through a TProfileConcurrentFiller, which accumulates the sums of the bins atomically.
+/// Callbacks registered with OnPartialResult are not supported for these histograms.
+///
+/// ~~~{.cpp}
+/// ROOT::EnableImplicitMT(128);
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::Experimental::EnableSharedHistoFill(df);
+/// auto h = df.Histo2D({"h", "h", 1000, 0., 1., 1000, 0., 1.}, "x", "y");
+/// ~~~
+// clang-format on
+void EnableSharedHistoFill(RNode node, bool enable = true, unsigned int bufferSize = 256);
+
+// clang-format off
+/// Write the Filters, Defines and Ranges leading to a node as C++ code in which the types of all columns are resolved
+/// \param[in] node The node whose upstream transformations are written out
+/// \param[in] functionName The name of the generated function
+/// \param[in] headers Headers to include in the generated code, e.g. those declaring the functions used in the expressions
+/// \return The source of a function `ROOT::RDF::RNode functionName(ROOT::RDF::RNode df)` that books the same
+///         transformations on `df`, with typed lambdas instead of just-in-time-compiled expressions
+///
+/// Compiling the generated code ahead of time removes the just-in-time compilation of the expressions at runtime, and
+/// lets the compiler optimize across Defines and Filters. Only Ranges and the Filters and Defines booked with string
+/// expressions can be written out: an exception is thrown if the node depends on other transformations. Aliases are
+/// resolved. The actions booked on the returned node should specify the column types as template parameters, so that
+/// they are not just-in-time compiled either.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("Events", "file.root");
+/// auto sel = df.Define("pt2", "pt * pt").Filter("pt2 > 100", "ptCut");
+/// std::cout << ROOT::RDF::Experimental::GenerateCode(sel, "Selection");
+/// // ROOT::RDF::RNode Selection(ROOT::RDF::RNode df)
+/// // {
+/// //    return df
+/// //       .Define("pt2", [](const float var0){return var0 * var0
+/// // ;}, {"pt"})
+/// //       .Filter([](const float var0){return var0 > 100
+/// // ;}, {"pt2"}, "ptCut");
+/// // }
+/// ~~~
+// clang-format on
+std::string GenerateCode(RNode node, const std::string &functionName = "BuildGraph",
+                         const std::vector<std::string> &headers = {});
+
+// clang-format off
+/// Write the code generated by GenerateCode() in a directory, together with a CMake project that builds it
+/// \param[in] node The node whose upstream transformations are written out
+/// \param[in] name The name of the generated function, of its source files and of the CMake library target
+/// \param[in] directory The output directory, which must exist
+/// \param[in] headers Headers to include in the generated code, e.g. those declaring the functions used in the expressions
+///
+/// The directory receives `name.hxx`, which declares the function, `name.cxx`, which defines it, and a `CMakeLists.txt`
+/// with a shared library target `name` linked to ROOT's DataFrame library, to be built for example with
+/// `cmake -S directory -B build && cmake --build build`.
+// clang-format on
+void SaveGeneratedCode(RNode node, const std::string &name, const std::string &directory = ".",
+                       const std::vector<std::string> &headers = {});
+
+} // namespace Experimental
+
 } // namespace RDF
 } // namespace ROOT
 #endif
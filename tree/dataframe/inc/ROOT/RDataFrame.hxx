@@ -28,6 +28,7 @@ ROOT's RDataFrame allows to analyse data stored in TTrees with a high level inte
 #include <vector>
 
 class TDirectory;
+class TEntryList;
 class TTree;
 
 namespace ROOT {
@@ -51,6 +52,13 @@ public:
    RDataFrame(std::unique_ptr<ROOT::RDF::RDataSource>, const ColumnNames_t &defaultBranches = {});
 };
 
+namespace RDF {
+RDataFrame MakeEntryListDataFrame(TTree &tree, const TEntryList &entries,
+                                  const RDataFrame::ColumnNames_t &defaultBranches = {});
+RDataFrame MakeEntryListDataFrame(TTree &tree, const std::vector<Long64_t> &entries,
+                                  const RDataFrame::ColumnNames_t &defaultBranches = {});
+} // namespace RDF
+
 } // ns ROOT
 
 /// Print a RDataFrame at the prompt
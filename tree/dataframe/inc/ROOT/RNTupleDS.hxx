@@ -22,9 +22,11 @@
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ROOT {
@@ -43,6 +45,10 @@ class RNTupleColumnReader;
 }
 
 class RNTupleDS final : public ROOT::RDF::RDataSource {
+   /// The entry ranges of the event loop are made of whole clusters.  Similar to TTreeProcessorMT, we aim at
+   /// about that many tasks per slot, so that the thread pool can balance the load between the slots.
+   static constexpr unsigned int kTasksPerSlot = 10;
+
    /// Clones of the first source, one for each slot
    std::vector<std::unique_ptr<ROOT::Experimental::Detail::RPageSource>> fSources;
 
@@ -56,6 +62,19 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
 
    unsigned fNSlots = 0;
    bool fHasSeenAllRanges = false;
+   /// Number of entries read at once by the column readers of simple fields; zero disables bulk reading
+   std::size_t fBulkSize = 0;
+
+   /// A value range of a column, used to skip clusters based on the column statistics
+   struct RRangeFilter {
+      DescriptorId_t fColumnId;
+      double fMin;
+      double fMax;
+   };
+   std::vector<RRangeFilter> fRangeFilters;
+   /// Maps the first entry of the ranges returned by GetEntryRanges() to the end of the range; used in InitSlot()
+   /// to restrict the read-ahead of the slot's page source to the slot's current range
+   std::unordered_map<ULong64_t, ULong64_t> fRangeEnds;
 
    /// Provides the RDF column "colName" given the field identified by fieldID. For records and collections,
    /// AddField recurses into the sub fields. The skeinIDs is the list of field IDs of the outer collections
@@ -78,11 +97,23 @@ public:
    bool HasColumn(std::string_view colName) const final;
    std::string GetTypeName(std::string_view colName) const final;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
+   /// Restricts the event loop to the clusters that may contain values of the given field in the closed interval
+   /// [min, max], according to the column statistics stored with the ntuple (see
+   /// RNTupleWriteOptions::SetUseColumnStatistics()).  Only entire clusters are skipped, so the selection still
+   /// needs to be applied with a Filter().  Sub fields are given in the form `parent.child`.
+   void AddRangeFilter(std::string_view fieldName, double min, double max);
+   /// Opt-in bulk reading: the column readers of simple fields, e.g. `float` or `int` columns, fetch the values of up
+   /// to bulkSize consecutive entries in a single call into a contiguous buffer and serve the following entries from
+   /// there, instead of reading the field entry by entry.  Blocks never extend beyond the entry range of the slot.
+   /// Columns of other types are read as usual.  Needs to be set before the event loop starts.
+   void SetBulkSize(std::size_t bulkSize) { fBulkSize = bulkSize; }
+   std::size_t GetBulkSize() const { return fBulkSize; }
    std::string GetLabel() final { return "RNTupleDS"; }
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
 
    void Initialise() final;
+   void InitSlot(unsigned int slot, ULong64_t firstEntry) final;
    void Finalise() final;
 
    std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase>
@@ -16,6 +16,7 @@
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
 
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <typeinfo>
@@ -24,6 +25,12 @@
 namespace ROOT {
 namespace RDF {
 
+class RResultHandle;
+namespace Experimental {
+void RunGraphsMP(std::vector<RResultHandle> handles, unsigned int nWorkers);
+void RunGraphsCached(std::vector<RResultHandle> handles, const std::string &cacheDir, unsigned int nWorkers);
+} // namespace Experimental
+
 class RResultHandle {
    ROOT::Detail::RDF::RLoopManager* fLoopManager; //< Pointer to the loop manager
    /// Owning pointer to the action that will produce this result.
@@ -33,7 +40,10 @@ class RResultHandle {
    const std::type_info& fType; ///< Type of the wrapped result
 
    // The ROOT::RDF::RunGraphs helper has to access the loop manager to check whether two RResultHandles belong to the same computation graph
-   friend void RunGraphs(std::vector<RResultHandle>);
+   friend void RunGraphs(std::vector<RResultHandle>, std::function<void(unsigned int, unsigned int)>);
+   // RunGraphsMP writes the merged results into the wrapped objects
+   friend void Experimental::RunGraphsMP(std::vector<RResultHandle>, unsigned int);
+   friend void Experimental::RunGraphsCached(std::vector<RResultHandle>, const std::string &, unsigned int);
 
    /// Get the pointer to the encapsulated result.
    /// Ownership is not transferred to the caller.
@@ -0,0 +1,143 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RRESULTMAP
+#define ROOT_RDF_RRESULTMAP
+
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "TDirectory.h"
+#include "TObject.h"
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Return a copy of a result that has not been filled yet, to be used as the result of a varied action.
+template <typename T, std::enable_if_t<std::is_base_of<TObject, T>::value, int> = 0>
+std::shared_ptr<T> CloneResult(const T &result)
+{
+   // make sure the clone is not attached to the current directory
+   TDirectory::TContext ctx(nullptr);
+   return std::shared_ptr<T>(static_cast<T *>(result.Clone()));
+}
+
+template <typename T, std::enable_if_t<!std::is_base_of<TObject, T>::value, int> = 0>
+std::shared_ptr<T> CloneResult(const T &result)
+{
+   return std::make_shared<T>(result);
+}
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+namespace Experimental {
+
+/**
+\class ROOT::RDF::Experimental::RResultMap
+\ingroup dataframe
+\brief The nominal result of an action together with its systematic variations, as returned by VariationsFor().
+\tparam T Type of the action result
+
+The results are accessed by key: "nominal" for the nominal result, "<variation name>:<tag>" for the varied ones.
+Accessing any of the results triggers the event loop, which produces all of them at once.
+~~~{.cpp}
+auto h = df.Vary("pt", ...).Histo1D("pt");
+auto hs = ROOT::RDF::Experimental::VariationsFor(h);
+hs["nominal"].Draw();
+hs["pt:up"].Draw("SAME");
+~~~
+*/
+template <typename T>
+class RResultMap {
+   std::vector<std::string> fKeys; ///< The keys of the results, "nominal" first
+   std::map<std::string, RResultPtr<T>> fResults;
+
+   template <typename T1>
+   friend RResultMap<T1> VariationsFor(RResultPtr<T1> resPtr);
+
+   RResultMap(std::vector<std::string> &&keys, std::map<std::string, RResultPtr<T>> &&results)
+      : fKeys(std::move(keys)), fResults(std::move(results))
+   {
+   }
+
+public:
+   /// Return the result with the given key. Triggers the event loop if the results are not ready yet.
+   T &operator[](const std::string &key)
+   {
+      auto it = fResults.find(key);
+      if (it == fResults.end())
+         throw std::runtime_error("RResultMap: no result with key \"" + key + "\".");
+      return *it->second;
+   }
+
+   /// Return the keys of the results: "nominal" followed by "<variation name>:<tag>" for each varied result.
+   const std::vector<std::string> &GetKeys() const { return fKeys; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Book the systematic variations of a result.
+/// \param[in] resPtr The nominal result, which must not have been produced yet.
+/// \return An RResultMap with the nominal result and one result per varied value of each variation that affects it.
+///
+/// The varied results are produced in the same event loop as the nominal one. The variations are the ones booked
+/// with RInterface::Vary upstream of the action that produces `resPtr`. Only a subset of the actions supports
+/// variations (Count, Fill and the Histo*D family, Min, Max, Sum, Mean, StdDev): an exception is thrown for the others.
+/// VariationsFor should be called once per result.
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr)
+{
+   R__ASSERT(resPtr != nullptr && "Calling VariationsFor on an empty RResultPtr");
+   if (resPtr.IsReady())
+      throw std::logic_error("VariationsFor: the result has already been produced, so its variations cannot be booked. "
+                             "Call VariationsFor before triggering the event loop.");
+
+   auto &loopManager = *resPtr.fLoopManager;
+   // jitted nodes only know about their variations once their concrete node exists
+   loopManager.Jit();
+
+   auto &action = *resPtr.fActionPtr;
+   ROOT::Internal::RDF::RVariationTags_t variations;
+   action.AddVariations(variations);
+
+   std::vector<std::string> keys{"nominal"};
+   std::map<std::string, RResultPtr<T>> results{{"nominal", resPtr}};
+   for (const auto &variation : variations) {
+      const auto &variationName = variation.first;
+      const auto &tags = variation.second;
+      for (std::size_t varIdx = 0u; varIdx < tags.size(); ++varIdx) {
+         auto variedResult = ROOT::Internal::RDF::CloneResult(*resPtr.fObjPtr);
+         std::shared_ptr<ROOT::Internal::RDF::RActionBase> variedAction =
+            action.MakeVariedAction(variationName, varIdx, &variedResult);
+         loopManager.Book(variedAction.get());
+         loopManager.AddDataBlockCallback(variedAction->GetDataBlockCallback());
+         auto key = variationName + ":" + tags[varIdx];
+         keys.emplace_back(key);
+         results.emplace(key, ROOT::Detail::RDF::MakeResultPtr(variedResult, loopManager, std::move(variedAction)));
+      }
+   }
+
+   return RResultMap<T>(std::move(keys), std::move(results));
+}
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_RRESULTMAP
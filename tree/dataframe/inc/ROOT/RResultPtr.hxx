@@ -28,6 +28,14 @@ class RResultPtr;
 
 template <typename Proxied, typename DataSource>
 class RInterface;
+
+namespace Experimental {
+template <typename T>
+class RResultMap;
+
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr);
+} // namespace Experimental
 } // namespace RDF
 
 namespace Internal {
@@ -121,6 +129,9 @@ class RResultPtr {
 
    friend class RResultHandle;
 
+   template <typename T1>
+   friend ROOT::RDF::Experimental::RResultMap<T1> ROOT::RDF::Experimental::VariationsFor(RResultPtr<T1> resPtr);
+
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
    struct RIterationHelper {
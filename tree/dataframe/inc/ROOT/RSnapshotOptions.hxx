@@ -18,6 +18,14 @@
 namespace ROOT {
 
 namespace RDF {
+
+/// The format of the dataset written by Snapshot
+enum class ESnapshotOutputFormat {
+   kDefault, ///< Currently a TTree
+   kTTree,   ///< A TTree; multi-threaded snapshots are merged by a TBufferMerger
+   kRNTuple  ///< An RNTuple; every processing slot compresses and writes its own clusters
+};
+
 /// A collection of options to steer the creation of the dataset on file
 struct RSnapshotOptions {
    using ECAlgo = ROOT::ECompressionAlgorithm;
@@ -37,6 +45,12 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   ESnapshotOutputFormat fOutputFormat = ESnapshotOutputFormat::kDefault; ///< Format of the output dataset
+   /// Copy the compressed baskets of the input TTree instead of reading and writing every entry, if all entries are
+   /// written and all columns are branches of the input written unchanged (otherwise a regular Snapshot is performed).
+   /// The output keeps the compression and the basket layout of the input: the compression, auto-flush and split
+   /// level options are ignored.
+   bool fFastClone = false;
 };
 } // ns RDF
 } // ns ROOT
@@ -48,6 +48,10 @@ is used:
   - For expressions ("SELECT 1+1 FROM table"), the type of the first row of the result set determines the column type.
     That can result in a column to be of thought of type NULL where subsequent rows actually have meaningful values.
     The provided SELECT query can be used to avoid such ambiguities.
+
+The rows of the result set are fetched sequentially, in batches of a few thousand rows per processing slot. Each batch
+is split into one entry range per slot, so that with implicit multi-threading the rows of a batch are processed in
+parallel while only the fetching of the rows from the database is serialized.
 */
 class RSqliteDS final : public ROOT::RDF::RDataSource {
 private:
@@ -67,7 +71,6 @@ private:
       explicit Value_t(ETypes type);
 
       ETypes fType;
-      bool fIsActive; ///< Not all columns of the query are necessarily used by the RDF. Allows for skipping them.
       Long64_t fInteger;
       double fReal;
       std::string fText;
@@ -76,15 +79,33 @@ private:
       void *fPtr; ///< Points to one of the values; an address to this pointer is returned by GetColumnReadersImpl.
    };
 
+   /// The values of one column for the rows of the current batch. Only the vector matching the column type is used.
+   struct RColumnBuffer {
+      std::vector<Long64_t> fIntegers;
+      std::vector<double> fReals;
+      std::vector<std::string> fTexts;
+      std::vector<std::vector<unsigned char>> fBlobs;
+   };
+
+   /// Number of rows fetched per processing slot by each GetEntryRanges call
+   static constexpr ULong64_t fgRowsPerSlot = 4096;
+
    void SqliteError(int errcode);
+   void MakeValues();
+   void FetchRow(std::size_t row);
 
    std::unique_ptr<Internal::RSqliteDSDataSet> fDataSet;
    unsigned int fNSlots;
-   ULong64_t fNRow;
+   ULong64_t fNRow;       ///< Number of rows fetched so far in this event loop
+   ULong64_t fBatchBegin; ///< Entry number of the first row of the current batch
+   bool fIsDone;          ///< Whether all rows of the result set have been fetched in this event loop
    std::vector<std::string> fColumnNames;
    std::vector<ETypes> fColumnTypes;
-   /// The data source is inherently single-threaded and returns only one row at a time. This vector holds the results.
-   std::vector<Value_t> fValues;
+   std::vector<bool> fIsActive; ///< Not all columns of the query are necessarily used by the RDF. Allows for skipping them.
+   /// The rows of the current batch, per column
+   std::vector<RColumnBuffer> fBuffers;
+   /// The values of the current entry of each slot, fValues[slot][column]
+   std::vector<std::vector<Value_t>> fValues;
 
    // clang-format off
    /// Corresponds to the types defined in ETypes.
@@ -23,6 +23,21 @@ ROOT::RDF::MakeArrowDataFrame, which accepts one parameter:
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+Numeric columns are read in place from the Arrow buffers, and columns of Arrow
+lists are exposed as RVecs that adopt the memory of the list without copying it.
+Only strings and booleans, which have a different memory layout in Arrow, are
+copied entry by entry.
+
+ROOT::RDF::MakeArrowDataFrame can also read a file, see its documentation.
+Arrow IPC files are memory-mapped, so that no data is read until it is used.
+Parquet files can be read if ROOT was built against an Arrow installation
+that includes the Parquet library.
+
+When the table is made of several chunks, e.g. the record batches of an IPC
+file or the row groups of a Parquet file, and all the selected columns are
+chunked in the same way, the entry ranges processed in parallel follow the
+chunk boundaries.
+
 */
 // clang-format on
 
@@ -41,8 +56,14 @@ arrow::Schema.
 #pragma GCC diagnostic ignored "-Wshadow"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
 #include <arrow/table.h>
 #include <arrow/stl.h>
+#include <arrow/util/config.h>
+#ifdef R__RDF_HAS_PARQUET
+#include <parquet/arrow/reader.h>
+#endif
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
@@ -447,6 +468,8 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    auto nRecords = getRecordsFirstColumn();
    for (auto &columnName : fColumnNames) {
       auto columnIdx = fTable->schema()->GetFieldIndex(columnName);
+      if (columnIdx < 0)
+         throw std::runtime_error("The Arrow table does not have column " + columnName);
       addColumnToGetterIndex(columnIdx);
 
       auto column = fTable->column(columnIdx);
@@ -532,6 +555,24 @@ void splitInEqualRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, in
    ranges.back().second += remainder;
 }
 
+/// Split the entries at the given chunk boundaries, merging adjacent chunks until every range has at least
+/// `nRecords / nSlots` entries (the last range can be smaller).
+void splitAtChunkBoundaries(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges,
+                            const std::vector<ULong64_t> &boundaries, int nRecords, unsigned int nSlots)
+{
+   ranges.clear();
+   const ULong64_t minRangeSize = nRecords / nSlots;
+   ULong64_t start = 0;
+   for (auto boundary : boundaries) {
+      if (boundary - start >= minRangeSize && boundary > start) {
+         ranges.emplace_back(start, boundary);
+         start = boundary;
+      }
+   }
+   if (start < static_cast<ULong64_t>(nRecords))
+      ranges.emplace_back(start, nRecords);
+}
+
 int getNRecords(std::shared_ptr<arrow::Table> &table, std::vector<std::string> &columnNames)
 {
    auto index = table->schema()->GetFieldIndex(columnNames.front());
@@ -586,10 +627,34 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
    return fValueGetters[getterIdx]->SlotPtrs();
 }
 
+/// Return the end entries of the chunks of the given columns, or an empty vector if they are not chunked in the same way.
+std::vector<ULong64_t> getChunkBoundaries(arrow::Table &table, const std::vector<std::pair<size_t, size_t>> &index)
+{
+   std::vector<ULong64_t> boundaries;
+   for (auto &link : index) {
+      std::vector<ULong64_t> columnBoundaries;
+      ULong64_t end = 0;
+      for (auto &chunk : getData(table.column(link.first))->chunks()) {
+         end += chunk->length();
+         columnBoundaries.push_back(end);
+      }
+      if (boundaries.empty())
+         boundaries = std::move(columnBoundaries);
+      else if (boundaries != columnBoundaries)
+         return {};
+   }
+   return boundaries;
+}
+
 void RArrowDS::Initialise()
 {
    auto nRecords = getNRecords(fTable, fColumnNames);
-   splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   const auto boundaries = getChunkBoundaries(*fTable, fGetterIndex);
+   // With fewer chunks than slots, chunk-aligned ranges would leave some of the slots idle
+   if (boundaries.size() >= fNSlots)
+      splitAtChunkBoundaries(fEntryRanges, boundaries, nRecords, fNSlots);
+   else
+      splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
 }
 
 std::string RArrowDS::GetLabel()
@@ -607,6 +672,117 @@ RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<s
    return tdf;
 }
 
+namespace {
+
+#if ARROW_VERSION >= 17000
+template <typename T>
+T valueOrThrow(arrow::Result<T> result, const std::string &what)
+{
+   if (!result.ok())
+      throw std::runtime_error(what + ": " + result.status().ToString());
+   return std::move(result).ValueOrDie();
+}
+
+void throwIfNotOk(const arrow::Status &status, const std::string &what)
+{
+   if (!status.ok())
+      throw std::runtime_error(what + ": " + status.ToString());
+}
+
+/// Read all the record batches of an Arrow IPC file. The file is memory-mapped and the buffers of the table point into
+/// the mapping, which they keep alive.
+std::shared_ptr<arrow::Table> readArrowIPCFile(const std::string &fileName)
+{
+   const auto what = "Cannot read Arrow IPC file " + fileName;
+   auto file = valueOrThrow(arrow::io::MemoryMappedFile::Open(fileName, arrow::io::FileMode::READ), what);
+   auto reader = valueOrThrow(arrow::ipc::RecordBatchFileReader::Open(file), what);
+   std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+   for (int i = 0; i < reader->num_record_batches(); ++i)
+      batches.emplace_back(valueOrThrow(reader->ReadRecordBatch(i), what));
+   return valueOrThrow(arrow::Table::FromRecordBatches(reader->schema(), batches), what);
+}
+
+#ifdef R__RDF_HAS_PARQUET
+/// Whether RArrowDS supports the type and it is stored in a single Parquet column, e.g. a number or a list of numbers.
+bool isSingleLeafType(const std::shared_ptr<arrow::DataType> &type)
+{
+   VerifyValidColumnType verifyType;
+   if (!type->Accept(&verifyType).ok())
+      return false;
+   if (type->id() != arrow::Type::LIST)
+      return true;
+   const auto &valueType = static_cast<const arrow::ListType &>(*type).value_type();
+   return valueType->id() != arrow::Type::LIST && valueType->Accept(&verifyType).ok();
+}
+
+/// Decode the requested columns of a Parquet file, in parallel. Every row group becomes a chunk of the table.
+std::shared_ptr<arrow::Table> readParquetFile(const std::string &fileName, const std::vector<std::string> &columnNames)
+{
+   const auto what = "Cannot read Parquet file " + fileName;
+   auto file = valueOrThrow(arrow::io::ReadableFile::Open(fileName), what);
+   std::unique_ptr<parquet::arrow::FileReader> reader;
+   throwIfNotOk(parquet::arrow::OpenFile(file, arrow::default_memory_pool(), &reader), what);
+   reader->set_use_threads(true);
+
+   std::shared_ptr<arrow::Schema> schema;
+   throwIfNotOk(reader->GetSchema(&schema), what);
+   // Parquet indexes the leaves of nested fields: only select columns when field and leaf indices coincide
+   const bool canSelect = std::all_of(schema->fields().begin(), schema->fields().end(),
+                                      [](const std::shared_ptr<arrow::Field> &f) { return isSingleLeafType(f->type()); });
+   std::shared_ptr<arrow::Table> table;
+   if (columnNames.empty() || !canSelect) {
+      throwIfNotOk(reader->ReadTable(&table), what);
+      return table;
+   }
+   std::vector<int> indices;
+   for (const auto &name : columnNames) {
+      const auto idx = schema->GetFieldIndex(name);
+      if (idx < 0)
+         throw std::runtime_error(what + ": the file does not have column " + name);
+      indices.push_back(idx);
+   }
+   throwIfNotOk(reader->ReadTable(indices, &table), what);
+   return table;
+}
+#endif // R__RDF_HAS_PARQUET
+#endif // ARROW_VERSION >= 17000
+
+bool endsWith(const std::string &s, const std::string &suffix)
+{
+   return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // anonymous namespace
+
+/// Creates a RDataFrame that reads an Apache Arrow IPC file or a Parquet file.
+/// \param[in] fileName the file to read: files with the ".parquet" extension are read as Parquet files, all others
+///            as Arrow IPC files (also known as Feather V2 files).
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the file.
+/// IPC files are memory-mapped, so that only the parts of the file that are used are read. The requested columns of
+/// Parquet files are decoded upfront, in parallel; the row groups become the entry ranges processed by the tasks of
+/// a multi-thread event loop. Requires Arrow >= 0.17, and an Arrow installation that includes Parquet for the latter.
+RDataFrame MakeArrowDataFrame(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   const std::string name(fileName);
+#if ARROW_VERSION >= 17000
+   std::shared_ptr<arrow::Table> table;
+   if (endsWith(name, ".parquet")) {
+#ifdef R__RDF_HAS_PARQUET
+      table = readParquetFile(name, columnNames);
+#else
+      throw std::runtime_error("Cannot read " + name + ": ROOT was built against an Arrow installation without Parquet");
+#endif
+   } else {
+      table = readArrowIPCFile(name);
+   }
+   return MakeArrowDataFrame(std::move(table), columnNames);
+#else
+   (void)columnNames;
+   throw std::runtime_error("Cannot read " + name + ": reading Arrow files requires Arrow >= 0.17");
+#endif
+}
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -65,9 +65,12 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+By default, RCsvDS reads the entire CSV file content into memory before RDataFrame starts
+processing it. Therefore, before creating a CSV RDataFrame, it is important to check both how
+much memory is available and the size of the CSV file. For large files, the `linesChunkSize`
+argument of ROOT::RDF::MakeCsvDataFrame makes RCsvDS read and process the file in chunks of
+that many lines, so that only one chunk is kept in memory at a time.
+The lines of each chunk are parsed in parallel when implicit multi-threading is enabled.
 */
 // clang-format on
 
@@ -76,11 +79,15 @@ important to check both how much memory is available and the size of the CSV fil
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RRawFile.hxx>
 #include <TError.h>
+#include <TROOT.h>      // IsImplicitMTEnabled
+#include <RConfigure.h> // R__USE_IMT
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
 #include <iostream>
 #include <memory>
-#include <sstream>
 #include <string>
 
 namespace ROOT {
@@ -111,41 +118,77 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+/// Parse the given line into the values of the line with index lineIdx in the current chunk.
+/// Can be called concurrently for different lines.
+void RCsvDS::FillRecord(const std::string &line, std::size_t lineIdx)
 {
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
    auto columns = ParseColumns(line);
 
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
+   auto colType = fColTypesList.begin();
+   for (auto i = 0U; i < columns.size() && colType != fColTypesList.end(); ++i, ++colType) {
+      auto &col = columns[i];
+      switch (*colType) {
       case 'd': {
-         record.emplace_back(new double(std::stod(col)));
+         fDoubleValues[i][lineIdx] = std::stod(col);
          break;
       }
       case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
+         fLong64Values[i][lineIdx] = std::stoll(col);
          break;
       }
       case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
+         fBoolValues[i][lineIdx] = (col == "true");
          break;
       }
       case 's': {
-         record.emplace_back(new std::string(col));
+         fStringValues[i][lineIdx] = std::move(col);
          break;
       }
       }
-      ++i;
    }
 }
 
+/// Parse the given lines, which become the current chunk. Contiguous blocks of lines are parsed in parallel if
+/// implicit multi-threading is enabled.
+void RCsvDS::FillRecords(const std::vector<std::string> &lines)
+{
+   const auto nLines = lines.size();
+   auto colIndex = 0U;
+   for (auto colType : fColTypesList) {
+      switch (colType) {
+      case 'd': fDoubleValues[colIndex].resize(nLines); break;
+      case 'l': fLong64Values[colIndex].resize(nLines); break;
+      case 'b': fBoolValues[colIndex].resize(nLines); break;
+      case 's': fStringValues[colIndex].resize(nLines); break;
+      }
+      ++colIndex;
+   }
+
+   auto fillLines = [this, &lines](std::size_t begin, std::size_t end) {
+      for (auto lineIdx = begin; lineIdx < end; ++lineIdx)
+         FillRecord(lines[lineIdx], lineIdx);
+   };
+
+#ifdef R__USE_IMT
+   // a few blocks per thread, each large enough to amortize the scheduling of its task
+   const std::size_t minLinesPerTask = 1024;
+   if (ROOT::IsImplicitMTEnabled() && nLines >= 2 * minLinesPerTask) {
+      const auto nTasks = std::min<std::size_t>(4 * ROOT::GetThreadPoolSize(), nLines / minLinesPerTask);
+      const auto linesPerTask = nLines / nTasks;
+      const auto remainder = nLines % nTasks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(
+         [&](unsigned int task) {
+            const auto begin = task * linesPerTask + std::min<std::size_t>(task, remainder);
+            fillLines(begin, begin + linesPerTask + (task < remainder ? 1 : 0));
+         },
+         ROOT::TSeqU(nTasks));
+      return;
+   }
+#endif
+   fillLines(0, nLines);
+}
+
 void RCsvDS::GenerateHeaders(size_t size)
 {
    for (size_t i = 0; i < size; ++i) {
@@ -216,7 +259,7 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    fColTypesList.push_back(type);
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(const std::string &line) const
 {
    std::vector<std::string> columns;
 
@@ -227,9 +270,9 @@ std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i) const
 {
-   std::stringstream val;
+   std::string val;
    bool quoted = false;
 
    for (; i < line.size(); ++i) {
@@ -240,14 +283,14 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
          if (line[i + 1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            val += line[++i];
          }
       } else {
-         val << line[i];
+         val += line[i];
       }
    }
 
-   columns.emplace_back(val.str());
+   columns.emplace_back(std::move(val));
 
    return i;
 }
@@ -293,6 +336,12 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
       // Infer types of columns with first record
       InferColTypes(columns);
 
+      const auto nColumns = fHeaders.size();
+      fDoubleValues.resize(nColumns);
+      fLong64Values.resize(nColumns);
+      fStringValues.resize(nColumns);
+      fBoolValues.resize(nColumns);
+
       // rewind
       fCsvFile->Seek(fDataPos);
    } else {
@@ -304,31 +353,15 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
-   }
-   fRecords.clear();
+   // release the memory, not just the values: the next chunk is parsed into new vectors anyway
+   for (auto &values : fDoubleValues)
+      std::vector<double>().swap(values);
+   for (auto &values : fLong64Values)
+      std::vector<Long64_t>().swap(values);
+   for (auto &values : fStringValues)
+      std::vector<std::string>().swap(values);
+   for (auto &values : fBoolValues)
+      std::deque<bool>().swap(values);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -358,24 +391,27 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    auto linesToRead = fLinesChunkSize;
    FreeRecords();
 
+   // Reading is sequential, parsing is done in parallel afterwards
+   std::vector<std::string> lines;
    std::string line;
    while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
       if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+      lines.emplace_back(std::move(line));
       --linesToRead;
    }
+   FillRecords(lines);
+   const auto nRecords = lines.size();
+   std::vector<std::string>().swap(lines);
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
+         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", nRecords);
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, nRecords);
       }
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
    if (0 == nRecords)
       return entryRanges;
 
@@ -426,22 +462,21 @@ bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
    const auto recordPos = entry - offset;
    int colIndex = 0;
    for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
       switch (colType) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fDoubleEvtValues[colIndex][slot] = fDoubleValues[colIndex][recordPos];
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fLong64EvtValues[colIndex][slot] = fLong64Values[colIndex][recordPos];
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         fBoolEvtValues[colIndex][slot] = fBoolValues[colIndex][recordPos];
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         fStringEvtValues[colIndex][slot] = fStringValues[colIndex][recordPos];
          break;
       }
       }
@@ -9,6 +9,20 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/InternalTreeUtils.hxx" // GetFileNamesFromTree, GetTreeFullPaths
+#include "TChain.h"
+
+#ifdef R__RDF_HAS_RNTUPLE
+#include <ROOT/REntry.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleDS.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+
+#include <atomic>
+#endif
 
 namespace ROOT {
 namespace Internal {
@@ -264,6 +278,190 @@ void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &tre
    }
 }
 
+SnapshotCloneHelper::SnapshotCloneHelper(std::string_view filename, std::string_view dirname,
+                                         std::string_view treename, const ColumnNames_t &bnames,
+                                         const RSnapshotOptions &options, const TTree &inputTree)
+   : fFileName(filename), fDirName(dirname), fTreeName(treename), fOptions(options), fBranchNames(bnames),
+     fInputTreeName(inputTree.GetName()), fInputFileNames(ROOT::Internal::TreeUtils::GetFileNamesFromTree(inputTree)),
+     fInputTreePaths(ROOT::Internal::TreeUtils::GetTreeFullPaths(inputTree))
+{
+   ValidateSnapshotOutput(fOptions, fTreeName, fFileName);
+}
+
+void SnapshotCloneHelper::Finalize()
+{
+   // a chain of its own over the same trees, so that the branch statuses of the input dataset are left untouched
+   TChain inputChain(fInputTreeName.c_str());
+   for (std::size_t i = 0u; i < fInputFileNames.size(); ++i)
+      inputChain.AddFile(fInputFileNames[i].c_str(), TTree::kMaxEntries, fInputTreePaths[i].c_str());
+   inputChain.SetBranchStatus("*", false);
+   for (const auto &bname : fBranchNames) {
+      UInt_t found = 0u; // passing it silences the error for branches that have no sub-branches
+      inputChain.SetBranchStatus(bname.c_str(), true, &found);
+      inputChain.SetBranchStatus((bname + ".*").c_str(), true, &found);
+   }
+   if (inputChain.LoadTree(0) < 0)
+      throw std::runtime_error("Snapshot: could not read the input tree \"" + fInputTreeName + "\"");
+
+   std::unique_ptr<TFile> outputFile(
+      TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"",
+                  ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel)));
+   if (!outputFile)
+      throw std::runtime_error("Snapshot: could not create output file " + fFileName);
+
+   TDirectory *outputDir = outputFile.get();
+   if (!fDirName.empty()) {
+      TString checkupdate = fOptions.fMode;
+      checkupdate.ToLower();
+      if (checkupdate == "update")
+         outputDir = outputFile->mkdir(fDirName.c_str(), "", true); // do not overwrite existing directory
+      else
+         outputDir = outputFile->mkdir(fDirName.c_str());
+   }
+
+   // CloneTree creates the (empty) clone of the active branches in the current directory
+   TDirectory::TContext ctxt(outputDir);
+   TTree *outputTree = inputChain.CloneTree(0);
+   if (!outputTree)
+      throw std::runtime_error("Snapshot: could not clone the input tree \"" + fInputTreeName + "\"");
+   outputTree->SetName(fTreeName.c_str());
+   outputTree->SetTitle(fTreeName.c_str());
+   // baskets are copied as they are, trees that cannot be cloned (e.g. different branch layouts) are copied entry by
+   // entry
+   outputTree->CopyEntries(&inputChain, -1, "fast");
+   outputTree->ResetBranchAddresses();
+
+   // use AutoSave to flush TTree contents because TTree::Write writes in gDirectory, not in fDirectory
+   outputTree->AutoSave("flushbaskets");
+   // the output TTree is owned and deleted by the output file
+   outputFile->Close();
+}
+
+#ifdef R__RDF_HAS_RNTUPLE
+
+struct RNTupleSnapshotWriter::RImpl {
+   /// The state of a slot; the fill context is created when the slot fills its first entry
+   struct RSlot {
+      std::shared_ptr<ROOT::Experimental::RNTupleFillContext> fFillContext;
+      /// The top-level fields of the fill context's model, in the order of the Snapshot columns
+      std::vector<ROOT::Experimental::Detail::RFieldBase *> fFields;
+      /// Binds the fields to the values of the Snapshot columns; rebuilt when the value addresses change
+      std::unique_ptr<ROOT::Experimental::REntry> fEntry;
+      std::vector<void *> fValueAddresses;
+      ULong64_t fNEntries = 0;
+   };
+
+   std::string fFileName;
+   std::string fNTupleName;
+   std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> fWriter;
+   std::vector<RSlot> fSlots;
+
+   void InitSlot(RSlot &slot)
+   {
+      slot.fFillContext = fWriter->CreateFillContext();
+      auto defaultEntry = slot.fFillContext->CreateEntry();
+      for (auto &value : *defaultEntry)
+         slot.fFields.emplace_back(value.GetField());
+   }
+};
+
+RNTupleSnapshotWriter::RNTupleSnapshotWriter(const std::string &fileName, const std::string &ntupleName,
+                                             const ColumnNames_t &fieldNames,
+                                             const std::vector<std::string> &typeNames, unsigned int nSlots,
+                                             const RSnapshotOptions &options)
+   : fImpl(std::make_unique<RImpl>())
+{
+   using ROOT::Experimental::RNTupleModel;
+   using ROOT::Experimental::RNTupleParallelWriter;
+   using ROOT::Experimental::RNTupleWriteOptions;
+   using ROOT::Experimental::Detail::RFieldBase;
+
+   auto model = RNTupleModel::Create();
+   for (std::size_t i = 0; i < fieldNames.size(); ++i) {
+      auto field = RFieldBase::Create(fieldNames[i], typeNames[i]);
+      if (!field) {
+         throw std::runtime_error("Snapshot: column \"" + fieldNames[i] + "\" of type \"" + typeNames[i] +
+                                  "\" cannot be written to RNTuple");
+      }
+      model->AddField(field.Unwrap());
+   }
+
+   RNTupleWriteOptions writeOptions;
+   writeOptions.SetCompression(ROOT::CompressionSettings(options.fCompressionAlgorithm, options.fCompressionLevel));
+   // Same meaning as TTree::SetAutoFlush(): positive values count entries, negative values count compressed bytes
+   if (options.fAutoFlush > 0)
+      writeOptions.SetNEntriesPerCluster(options.fAutoFlush);
+   else if (options.fAutoFlush < 0)
+      writeOptions.SetApproxZippedClusterSize(-static_cast<std::size_t>(options.fAutoFlush));
+
+   fImpl->fFileName = fileName;
+   fImpl->fNTupleName = ntupleName;
+   fImpl->fWriter = RNTupleParallelWriter::Recreate(std::move(model), ntupleName, fileName, writeOptions);
+   fImpl->fSlots.resize(nSlots);
+}
+
+RNTupleSnapshotWriter::~RNTupleSnapshotWriter() = default;
+
+void RNTupleSnapshotWriter::Fill(unsigned int slotIdx, void *const *values)
+{
+   auto &slot = fImpl->fSlots[slotIdx];
+   if (!slot.fFillContext)
+      fImpl->InitSlot(slot);
+
+   const auto nFields = slot.fFields.size();
+   if (!slot.fEntry || !std::equal(values, values + nFields, slot.fValueAddresses.begin())) {
+      slot.fEntry = std::make_unique<ROOT::Experimental::REntry>();
+      for (std::size_t i = 0; i < nFields; ++i)
+         slot.fEntry->CaptureValue(slot.fFields[i]->CaptureValue(values[i]));
+      slot.fValueAddresses.assign(values, values + nFields);
+   }
+   slot.fFillContext->Fill(*slot.fEntry);
+   slot.fNEntries++;
+}
+
+ULong64_t RNTupleSnapshotWriter::GetNEntries() const
+{
+   ULong64_t nEntries = 0;
+   for (const auto &slot : fImpl->fSlots)
+      nEntries += slot.fNEntries;
+   return nEntries;
+}
+
+void RNTupleSnapshotWriter::Finalize(ROOT::RDF::RInterface<RLoopManager, void> *outputDataFrame)
+{
+   // The fill contexts must be released before the writer, which commits their remaining entries on destruction
+   fImpl->fSlots.clear();
+   fImpl->fWriter.reset();
+   if (outputDataFrame)
+      *outputDataFrame = ROOT::Experimental::MakeNTupleDataFrame(fImpl->fNTupleName, fImpl->fFileName);
+}
+
+#else
+
+struct RNTupleSnapshotWriter::RImpl {
+};
+
+RNTupleSnapshotWriter::RNTupleSnapshotWriter(const std::string &, const std::string &, const ColumnNames_t &,
+                                             const std::vector<std::string> &, unsigned int,
+                                             const RSnapshotOptions &)
+{
+   throw std::runtime_error("Snapshot: ROOT was built without RNTuple support (root7=OFF), the RNTuple output format "
+                            "is not available");
+}
+
+RNTupleSnapshotWriter::~RNTupleSnapshotWriter() = default;
+
+void RNTupleSnapshotWriter::Fill(unsigned int, void *const *) {}
+
+ULong64_t RNTupleSnapshotWriter::GetNEntries() const
+{
+   return 0;
+}
+
+void RNTupleSnapshotWriter::Finalize(ROOT::RDF::RInterface<RLoopManager, void> *) {}
+
+#endif // R__RDF_HAS_RNTUPLE
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
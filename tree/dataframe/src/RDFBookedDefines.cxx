@@ -7,6 +7,8 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RVariationBase.hxx"
 
 namespace ROOT {
 namespace Internal {
@@ -25,6 +27,18 @@ void RBookedDefines::AddColumn(const std::shared_ptr<RDFDetail::RDefineBase> &co
    (*newCols)[colName] = column;
    fDefines = newCols;
    AddName(colName);
+
+   // a Redefine of a varied column replaces the column together with its variations
+   const auto &variations = GetVariations();
+   const auto isOnColumn = [&colName](const std::shared_ptr<RDFDetail::RVariationBase> &v) {
+      return v->GetColumnName() == colName;
+   };
+   if (std::any_of(variations.begin(), variations.end(), isOnColumn)) {
+      auto newVariations = std::make_shared<RVariationBasePtrs_t>(variations);
+      newVariations->erase(std::remove_if(newVariations->begin(), newVariations->end(), isOnColumn),
+                           newVariations->end());
+      fVariations = newVariations;
+   }
 }
 
 void RBookedDefines::AddName(std::string_view name)
@@ -38,6 +52,33 @@ void RBookedDefines::AddName(std::string_view name)
    fDefinesNames = newColsNames;
 }
 
+void RBookedDefines::AddVariation(const std::shared_ptr<RDFDetail::RVariationBase> &variation)
+{
+   auto newVariations = std::make_shared<RVariationBasePtrs_t>(GetVariations());
+   newVariations->emplace_back(variation);
+   fVariations = newVariations;
+}
+
+RBookedDefines RBookedDefines::MakeVaried(const std::string &variationName, std::size_t varIdx) const
+{
+   auto newCols = std::make_shared<RDefineBasePtrMap_t>(GetColumns());
+   for (auto &define : *newCols) {
+      RVariationTags_t defineVariations;
+      define.second->AddVariations(defineVariations);
+      if (defineVariations.count(variationName) > 0)
+         define.second = define.second->GetVariedDefine(variationName, varIdx);
+   }
+
+   RBookedDefines varied(newCols, fDefinesNames);
+   for (const auto &variation : GetVariations()) {
+      if (variation->GetVariationName() == variationName) {
+         (*newCols)[variation->GetColumnName()] = variation->GetVariedValue(varIdx);
+         varied.AddName(variation->GetColumnName());
+      }
+   }
+   return varied;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -10,6 +10,7 @@
 
 #include "ROOT/RDF/RBookedDefines.hxx"
 #include "ROOT/RDF/GraphUtils.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 
 #include <algorithm> // std::find
 
@@ -98,7 +99,8 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RDefine
       return duplicateDefine;
    }
 
-   auto node = std::make_shared<GraphNode>("Define\n" + columnName);
+   auto node = std::make_shared<GraphNode>("Define\n" + columnName +
+                                           GetProfileLabel(columnPtr->GetProfiler(), columnPtr->GetProfilerID()));
    node->SetDefine();
 
    sColumnsMap[columnPtr] = node;
@@ -116,7 +118,8 @@ std::shared_ptr<GraphNode> CreateFilterNode(const ROOT::Detail::RDF::RFilterBase
       return duplicateFilter;
    }
    auto filterName = (filterPtr->HasName() ? filterPtr->GetName() : "Filter");
-   auto node = std::make_shared<GraphNode>(filterName);
+   auto node = std::make_shared<GraphNode>(filterName +
+                                           GetProfileLabel(filterPtr->GetProfiler(), filterPtr->GetProfilerID()));
 
    sFiltersMap[filterPtr] = node;
    node->SetFilter();
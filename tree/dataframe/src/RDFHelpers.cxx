@@ -13,14 +13,27 @@
 #include "TError.h"     // Warning
 #include "RConfigure.h" // R__USE_IMT
 #ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 #endif // R__USE_IMT
 
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
 #include <set>
+#include <stdexcept>
+#include <string>
 
 using ROOT::RDF::RResultHandle;
 
 void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+{
+   RunGraphs(std::move(handles), {});
+}
+
+void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles,
+                          std::function<void(unsigned int graphIdx, unsigned int nDone)> onGraphDone)
 {
    if (handles.empty()) {
       Warning("RunGraphs", "Got an empty list of handles");
@@ -41,19 +54,183 @@ void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
    if (nNotRun == 0)
       return;
 
-   // Find the unique event loops
-   auto sameGraph = [](const RResultHandle &a, const RResultHandle &b) { return a.fLoopManager < b.fLoopManager; };
-   std::set<RResultHandle, decltype(sameGraph)> s(handles.begin(), handles.end(), sameGraph);
-   std::vector<RResultHandle> uniqueLoops(s.begin(), s.end());
+   // Find the unique event loops, in the order in which they first appear in the list of handles
+   std::vector<ROOT::Detail::RDF::RLoopManager *> uniqueLoops;
+   for (const auto &h : handles) {
+      if (std::find(uniqueLoops.begin(), uniqueLoops.end(), h.fLoopManager) == uniqueLoops.end())
+         uniqueLoops.emplace_back(h.fLoopManager);
+   }
+
+   // The code of all jitted nodes goes to the interpreter in one go, from this thread: otherwise the first event loop
+   // to start would jit it while holding the interpreter lock, stalling the tasks of all others
+   uniqueLoops.front()->Jit();
+
+   std::mutex callbackMutex;
+   unsigned int nDone = 0u;
+   auto run = [&](unsigned int graphIdx) {
+      uniqueLoops[graphIdx]->Run();
+      if (onGraphDone) {
+         std::lock_guard<std::mutex> lock(callbackMutex);
+         onGraphDone(graphIdx, ++nDone);
+      }
+   };
 
    // Trigger the unique event loops
-   auto run = [](RResultHandle &h) { h.fLoopManager->Run(); };
 #ifdef R__USE_IMT
    if (ROOT::IsImplicitMTEnabled()) {
-      ROOT::TThreadExecutor{}.Foreach(run, uniqueLoops);
+      // The tasks of all event loops go to the same work-stealing task arena: the ones of small datasets fill the gaps
+      // left by the others, e.g. while they open their files
+      ROOT::TThreadExecutor{}.Foreach(run, ROOT::TSeqU(uniqueLoops.size()));
       return;
    }
 #endif // R__USE_IMT
-   for (auto &h : uniqueLoops)
-      run(h);
+   for (auto graphIdx = 0u; graphIdx < uniqueLoops.size(); ++graphIdx)
+      run(graphIdx);
+}
+
+void ROOT::RDF::Experimental::RunGraphsMP(std::vector<RResultHandle> handles, unsigned int nWorkers)
+{
+   if (handles.empty()) {
+      Warning("RunGraphsMP", "Got an empty list of handles");
+      return;
+   }
+   for (const auto &h : handles) {
+      if (h.IsReady()) {
+         Warning("RunGraphsMP", "Got handles that link to results which are already ready.");
+         return;
+      }
+   }
+
+   // Group the handles by computation graph
+   std::map<ROOT::Detail::RDF::RLoopManager *, std::vector<const RResultHandle *>> graphs;
+   for (const auto &h : handles)
+      graphs[h.fLoopManager].emplace_back(&h);
+
+   for (const auto &graph : graphs) {
+      // The merged results are written to the result objects in the order of the booked actions
+      std::vector<void *> results;
+      for (auto *action : graph.first->GetBookedActions()) {
+         auto itr = std::find_if(graph.second.begin(), graph.second.end(),
+                                 [action](const RResultHandle *h) { return h->fActionPtr.get() == action; });
+         if (itr == graph.second.end())
+            throw std::runtime_error("RunGraphsMP: the handles must comprise all the results booked in a computation "
+                                     "graph.");
+         results.emplace_back((*itr)->fObjPtr.get());
+      }
+      graph.first->RunMultiProcess(nWorkers, results);
+   }
+}
+
+void ROOT::RDF::Experimental::RunGraphsCached(std::vector<RResultHandle> handles, const std::string &cacheDir,
+                                              unsigned int nWorkers)
+{
+   if (handles.empty()) {
+      Warning("RunGraphsCached", "Got an empty list of handles");
+      return;
+   }
+   for (const auto &h : handles) {
+      if (h.IsReady()) {
+         Warning("RunGraphsCached", "Got handles that link to results which are already ready.");
+         return;
+      }
+   }
+
+   // Group the handles by computation graph
+   std::map<ROOT::Detail::RDF::RLoopManager *, std::vector<const RResultHandle *>> graphs;
+   for (const auto &h : handles)
+      graphs[h.fLoopManager].emplace_back(&h);
+
+   for (const auto &graph : graphs) {
+      // The merged results are written to the result objects in the order of the booked actions
+      std::vector<void *> results;
+      for (auto *action : graph.first->GetBookedActions()) {
+         auto itr = std::find_if(graph.second.begin(), graph.second.end(),
+                                 [action](const RResultHandle *h) { return h->fActionPtr.get() == action; });
+         if (itr == graph.second.end())
+            throw std::runtime_error("RunGraphsCached: the handles must comprise all the results booked in a "
+                                     "computation graph.");
+         results.emplace_back((*itr)->fObjPtr.get());
+      }
+      graph.first->RunCached(cacheDir, nWorkers, results);
+   }
+}
+
+ROOT::Detail::RDF::RLoopManager *ROOT::Internal::RDF::GetLoopManager(const ROOT::RDF::RNode &node)
+{
+   return node.GetLoopManager();
+}
+
+void ROOT::RDF::Experimental::EnableProfiling(RNode node)
+{
+   ROOT::Internal::RDF::GetLoopManager(node)->EnableProfiling();
+}
+
+ROOT::RDF::Experimental::RProfileReport ROOT::RDF::Experimental::GetProfileReport(RNode node)
+{
+   const auto *profiler = ROOT::Internal::RDF::GetLoopManager(node)->GetProfiler();
+   if (profiler == nullptr)
+      throw std::runtime_error("GetProfileReport: profiling is not enabled for this computation graph, "
+                               "call EnableProfiling before running the event loop.");
+   return profiler->GetReport();
+}
+
+void ROOT::RDF::Experimental::EnableProgressReport(RNode node, std::function<void(const RProgressInfo &)> callback,
+                                                  double intervalSeconds, ULong64_t sampleEveryN)
+{
+   ROOT::Internal::RDF::GetLoopManager(node)->EnableProgressReport(std::move(callback), intervalSeconds, sampleEveryN);
+}
+
+void ROOT::RDF::Experimental::EnableStagedTreeCache(RNode node, bool enable)
+{
+   ROOT::Internal::RDF::GetLoopManager(node)->SetStagedTreeCache(enable);
+}
+
+void ROOT::RDF::Experimental::EnableSharedHistoFill(RNode node, bool enable, unsigned int bufferSize)
+{
+   if (enable && bufferSize == 0)
+      throw std::invalid_argument("EnableSharedHistoFill: the buffer size must be larger than zero.");
+   ROOT::Internal::RDF::GetLoopManager(node)->SetSharedFillBufferSize(enable ? bufferSize : 0u);
+}
+
+/// Return the #include directives of the generated code
+static std::string GetGeneratedCodeIncludes(const std::vector<std::string> &headers)
+{
+   std::string includes = "#include <ROOT/RDataFrame.hxx>\n#include <ROOT/RVec.hxx>\n#include <TMath.h>\n";
+   for (const auto &header : headers)
+      includes += "#include \"" + header + "\"\n";
+   return includes;
+}
+
+std::string ROOT::RDF::Experimental::GenerateCode(RNode node, const std::string &functionName,
+                                                  const std::vector<std::string> &headers)
+{
+   return "// Generated by ROOT::RDF::Experimental::GenerateCode\n" + GetGeneratedCodeIncludes(headers) +
+          "\nusing namespace ROOT::VecOps;\n\n" + ROOT::Internal::RDF::GenerateGraphCode(node, functionName);
+}
+
+void ROOT::RDF::Experimental::SaveGeneratedCode(RNode node, const std::string &name, const std::string &directory,
+                                                const std::vector<std::string> &headers)
+{
+   // generate the code first, so that no file is written if it cannot be generated
+   const auto source = GenerateCode(node, name, headers);
+
+   auto writeFile = [&directory](const std::string &fileName, const std::string &content) {
+      const auto path = directory + "/" + fileName;
+      std::ofstream out(path);
+      if (!out.is_open())
+         throw std::runtime_error("SaveGeneratedCode: could not open output file \"" + path + "\" for writing");
+      out << content;
+   };
+
+   writeFile(name + ".hxx", "// Generated by ROOT::RDF::Experimental::SaveGeneratedCode\n#ifndef " + name +
+                               "_HXX\n#define " + name + "_HXX\n\n#include <ROOT/RDataFrame.hxx>\n\nROOT::RDF::RNode " +
+                               name + "(ROOT::RDF::RNode df);\n\n#endif\n");
+   writeFile(name + ".cxx", "#include \"" + name + ".hxx\"\n" + source);
+   writeFile("CMakeLists.txt", "# Generated by ROOT::RDF::Experimental::SaveGeneratedCode\n"
+                               "cmake_minimum_required(VERSION 3.16)\n"
+                               "project(" + name + " CXX)\n"
+                               "find_package(ROOT REQUIRED COMPONENTS ROOTDataFrame)\n"
+                               "add_library(" + name + " SHARED " + name + ".cxx)\n"
+                               "target_include_directories(" + name + " PUBLIC ${CMAKE_CURRENT_SOURCE_DIR})\n"
+                               "target_link_libraries(" + name + " PUBLIC ROOT::ROOTDataFrame)\n");
 }
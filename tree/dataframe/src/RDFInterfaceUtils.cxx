@@ -10,18 +10,22 @@
 
 #include <ROOT/RDF/InterfaceUtils.hxx>
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RStringView.hxx>
 #include <ROOT/TSeq.hxx>
 #include <RtypesCore.h>
 #include <TDirectory.h>
+#include <TEnv.h>
 #include <TChain.h>
 #include <TClass.h>
 #include <TClassEdit.h>
 #include <TFriendElement.h>
 #include <TInterpreter.h>
+#include <TLeaf.h>
 #include <TObject.h>
 #include <TPRegexp.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 
 // pragma to disable warnings on Rcpp which have
@@ -37,6 +41,7 @@
 #endif
 
 #include <algorithm>
+#include <functional>
 #include <unordered_set>
 #include <stdexcept>
 #include <string>
@@ -278,9 +283,14 @@ static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &v
    const auto lambdaBaseName = "lambda" + std::to_string(exprMap.size());
    const auto lambdaFullName = "__rdf::" + lambdaBaseName;
 
-   const auto toDeclare = "namespace __rdf {\nauto " + lambdaBaseName + " = " + lambdaExpr + ";\nusing " +
-                          lambdaBaseName + "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" +
-                          lambdaBaseName + ")>::ret_type;\n}";
+   auto toDeclare = "namespace __rdf {\nauto " + lambdaBaseName + " = " + lambdaExpr + ";\nusing " +
+                    lambdaBaseName + "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" +
+                    lambdaBaseName + ")>::ret_type;\n}";
+   // The lambdas are called for every entry: optionally compile them at a given optimization
+   // level, instead of the one of the interpreter
+   const auto optLevel = gEnv->GetValue("Jit.OptimizationLevel", -1);
+   if (optLevel >= 0)
+      toDeclare = "#pragma cling optimize(" + std::to_string(std::min(optLevel, 3)) + ")\n" + toDeclare;
    ROOT::Internal::RDF::InterpreterDeclare(toDeclare.c_str());
 
    // InterpreterDeclare could throw. If it doesn't, mark the lambda as already jitted
@@ -342,6 +352,73 @@ namespace ROOT {
 namespace Internal {
 namespace RDF {
 
+std::string MakeTemporaryFileName(const std::string &prefix)
+{
+   TString path(prefix.c_str());
+   FILE *f = gSystem->TempFileName(path);
+   if (f == nullptr)
+      throw std::runtime_error("Could not create a temporary file in " + std::string(gSystem->TempDirectory()));
+   fclose(f);
+   return path.Data();
+}
+
+ROOT::RDF::RSnapshotOptions GetCacheOnDiskOptions()
+{
+   ROOT::RDF::RSnapshotOptions options;
+   // the cache is read back several times: trade disk space for not having to decompress it every time
+   options.fCompressionLevel = 0;
+#ifdef R__RDF_HAS_RNTUPLE
+   options.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+#else
+   options.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kTTree;
+#endif
+   return options;
+}
+
+bool CanCloneSnapshotBranches(RNodeBase &prevNode, const ColumnNames_t &colNames, const ColumnNames_t &outputColNames,
+                              const RBookedDefines &defines)
+{
+   auto fallBack = [](const std::string &reason) {
+      R__LOG_INFO(ROOT::Detail::RDF::RDFLogChannel())
+         << "Snapshot: the baskets of the input tree cannot be cloned because " << reason
+         << ", all entries are read and written instead.";
+      return false;
+   };
+
+   auto *loopManager = prevNode.GetLoopManagerUnchecked();
+   if (&prevNode != loopManager)
+      return fallBack("there are filters or ranges upstream of the Snapshot");
+   TTree *tree = loopManager->GetTree();
+   if (tree == nullptr || loopManager->GetDataSource() != nullptr)
+      return fallBack("the input dataset is not a TTree");
+   if (loopManager->GetEntryList() != nullptr)
+      return fallBack("the input tree has an entry list");
+   if (tree->GetListOfFriends() != nullptr && tree->GetListOfFriends()->GetEntries() > 0)
+      return fallBack("the input tree has friends");
+   if (colNames != outputColNames)
+      return fallBack("some columns are written with a different name");
+
+   for (const auto &colName : colNames) {
+      if (defines.HasName(colName))
+         return fallBack("column \"" + colName + "\" is a Define");
+      TBranch *branch = tree->GetBranch(colName.c_str());
+      if (branch == nullptr || branch->GetMother() != branch)
+         return fallBack("column \"" + colName + "\" is not a top-level branch");
+      // the sizes of variable-size arrays must be written too
+      for (auto *leaf : ROOT::Detail::TRangeStaticCast<TLeaf>(*branch->GetListOfLeaves())) {
+         TLeaf *countLeaf = leaf->GetLeafCount();
+         if (countLeaf != nullptr &&
+             std::find(colNames.begin(), colNames.end(), countLeaf->GetBranch()->GetName()) == colNames.end())
+            return fallBack("the size of column \"" + colName + "\" is not written");
+      }
+   }
+   // the trees are opened again from their files at the end of the event loop
+   if (tree->GetCurrentFile() == nullptr)
+      return fallBack("the input tree is not stored in a file");
+
+   return true;
+}
+
 /// Take a list of column names, return that list with entries starting by '#' filtered out.
 /// The function throws when filtering out a column this way.
 ColumnNames_t FilterArraySizeColNames(const ColumnNames_t &columnNames, const std::string &action)
@@ -624,15 +701,75 @@ std::string PrettyPrintAddr(const void *const addr)
    return s.str();
 }
 
-void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
-                   std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string_view name,
-                   std::string_view expression, const std::map<std::string, std::string> &aliasMap,
-                   const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds)
+/// Identifies the values computed by a jitted Filter or Define expression: expressions with the same key compute the
+/// same value for every entry. Column names are resolved to the defines that produce them, so that columns with the
+/// same name but a different definition in another branch of the computation graph do not compare equal.
+static std::string GetJittedExprKey(const ParsedExpression &parsedExpr, const RBookedDefines &customCols)
+{
+   const auto &defines = customCols.GetColumns();
+   std::string key = parsedExpr.fExpr;
+   for (const auto &col : parsedExpr.fUsedCols) {
+      const auto it = defines.find(col);
+      key += "\n" + col + " " + PrettyPrintAddr(it == defines.end() ? nullptr : it->second.get());
+   }
+   return key;
+}
+
+/// Return the given string as a C++ string literal
+static std::string QuoteString(const std::string &str)
+{
+   std::string quoted = "\"";
+   for (const char c : str) {
+      if (c == '"' || c == '\\')
+         quoted += '\\';
+      quoted += c;
+   }
+   return quoted + '"';
+}
+
+/// Return the typed lambda of a jitted expression and the list of its input columns, as written in C++ code
+static std::string MakeCodeGenArgs(const ParsedExpression &parsedExpr, const ColumnNames_t &varTypes)
+{
+   std::string args = BuildLambdaString(parsedExpr.fExpr, parsedExpr.fVarNames, varTypes) + ", {";
+   for (auto i = 0u; i < parsedExpr.fUsedCols.size(); ++i)
+      args += (i == 0u ? "" : ", ") + QuoteString(parsedExpr.fUsedCols[i]);
+   return args + "}";
+}
+
+/// Return the defines among the given columns, as pairs of column name and define
+static std::vector<std::pair<std::string, const void *>>
+GetUsedDefines(const ColumnNames_t &columns, const RBookedDefines &defines)
+{
+   std::vector<std::pair<std::string, const void *>> usedDefines;
+   const auto &defineMap = defines.GetColumns();
+   for (const auto &col : columns) {
+      const auto it = defineMap.find(col);
+      if (it != defineMap.end())
+         usedDefines.emplace_back(col, static_cast<const RDFDetail::RDefineBase *>(it->second.get()));
+   }
+   return usedDefines;
+}
+
+std::shared_ptr<RJittedFilter>
+BookFilterJit(RLoopManager *lm, std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string_view name,
+              std::string_view expression, const std::map<std::string, std::string> &aliasMap,
+              const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds)
 {
    const auto &dsColumns = ds ? ds->GetColumnNames() : ColumnNames_t{};
 
    const auto parsedExpr =
       ParseRDFExpression(expression, branches, customCols.GetNames(), dsColumns, aliasMap);
+
+   // An identical filter on the same previous node selects the same entries: share it rather than jitting and
+   // evaluating the same expression twice (e.g. when several analyses booked on the same RDataFrame apply the same
+   // selection)
+   const auto key = std::string(name) + "\n" + PrettyPrintAddr(prevNodeOnHeap->get()) + "\n" +
+                    GetJittedExprKey(parsedExpr, customCols);
+   if (auto bookedFilter = lm->GetJittedFilter(key)) {
+      delete prevNodeOnHeap;
+      return bookedFilter;
+   }
+
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Filter", /*vector2rvec=*/true);
    const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
@@ -640,6 +777,8 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
    if (type != "bool")
       std::runtime_error("Filter: the following expression does not evaluate to bool:\n" + std::string(expression));
 
+   const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(lm, name);
+
    // definesOnHeap is deleted by the jitted call to JitFilterHelper
    ROOT::Internal::RDF::RBookedDefines *definesOnHeap = new ROOT::Internal::RDF::RBookedDefines(customCols);
    const auto definesOnHeapAddr = PrettyPrintAddr(definesOnHeap);
@@ -665,8 +804,19 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
                     << "reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(" << definesOnHeapAddr << ")"
                     << ");\n";
 
-   auto lm = jittedFilter->GetLoopManagerUnchecked();
    lm->ToJitExec(filterInvocation.str());
+   lm->Book(jittedFilter.get());
+   lm->RegisterJittedFilter(key, jittedFilter);
+
+   RCodeGenStep step;
+   step.fObject = jittedFilter;
+   step.fKind = "Filter";
+   step.fName = std::string(name);
+   step.fArgs = MakeCodeGenArgs(parsedExpr, exprVarTypes) + (name.empty() ? "" : ", " + QuoteString(step.fName));
+   step.fPrevNode = prevNodeOnHeap->get();
+   step.fDefines = GetUsedDefines(parsedExpr.fUsedCols, customCols);
+   lm->RegisterCodeGenStep(static_cast<const RDFDetail::RNodeBase *>(jittedFilter.get()), std::move(step));
+   return jittedFilter;
 }
 
 // Jit a Define call
@@ -681,6 +831,14 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
 
    const auto parsedExpr =
       ParseRDFExpression(expression, branches, customCols.GetNames(), dsColumns, aliasMap);
+
+   // An identical define computes the same values: share it to evaluate the expression only once per entry
+   const auto key = std::string(name) + "\n" + GetJittedExprKey(parsedExpr, customCols);
+   if (auto bookedDefine = lm.GetJittedDefine(key)) {
+      delete upcastNodeOnHeap;
+      return bookedDefine;
+   }
+
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Define", /*vector2rvec=*/true);
    const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
@@ -711,6 +869,15 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
                     << PrettyPrintAddr(upcastNodeOnHeap) << "));\n";
 
    lm.ToJitExec(defineInvocation.str());
+   lm.RegisterJittedDefine(key, jittedDefine);
+
+   RCodeGenStep step;
+   step.fObject = jittedDefine;
+   step.fKind = "Define";
+   step.fName = std::string(name);
+   step.fArgs = QuoteString(step.fName) + ", " + MakeCodeGenArgs(parsedExpr, exprVarTypes);
+   step.fDefines = GetUsedDefines(parsedExpr.fUsedCols, customCols);
+   lm.RegisterCodeGenStep(static_cast<const RDFDetail::RDefineBase *>(jittedDefine.get()), std::move(step));
    return jittedDefine;
 }
 
@@ -860,6 +1027,67 @@ void CheckForDuplicateSnapshotColumns(const ColumnNames_t &cols)
    }
 }
 
+std::string GenerateGraphCode(const ROOT::RDF::RNode &node, const std::string &functionName)
+{
+   CheckValidCppVarName(functionName, "GenerateCode");
+   auto &lm = *node.fLoopManager;
+
+   // collect the steps that lead to node: its upstream filters and ranges, its defines, and what they read
+   std::vector<const RCodeGenStep *> steps;
+   std::unordered_set<const void *> collectedDefines;
+   std::function<void(const std::string &, const void *)> collectDefine = [&](const std::string &colName,
+                                                                              const void *define) {
+      if (!collectedDefines.insert(define).second)
+         return;
+      const auto *step = lm.GetCodeGenStep(define);
+      if (step == nullptr) {
+         if (colName == "rdfentry_" || colName == "rdfslot_")
+            return; // always available
+         throw std::runtime_error("GenerateCode: column \"" + colName +
+                                  "\" was not defined with a string expression. Code can only be generated for "
+                                  "just-in-time-compiled Defines.");
+      }
+      steps.emplace_back(step);
+      for (const auto &usedDefine : step->fDefines)
+         collectDefine(usedDefine.first, usedDefine.second);
+   };
+
+   const RNodeBase *root = &lm;
+   for (const RNodeBase *n = node.fProxiedPtr.get(); n != root;) {
+      const auto *step = lm.GetCodeGenStep(n);
+      if (step == nullptr)
+         throw std::runtime_error("GenerateCode: the computation graph contains a Filter that was not booked with a "
+                                  "string expression, or a transformation other than Filter, Define and Range. Code "
+                                  "can only be generated for Ranges and just-in-time-compiled Filters and Defines.");
+      steps.emplace_back(step);
+      for (const auto &usedDefine : step->fDefines)
+         collectDefine(usedDefine.first, usedDefine.second);
+      n = static_cast<const RNodeBase *>(step->fPrevNode);
+   }
+   for (const auto &define : node.fDefines.GetColumns())
+      collectDefine(define.first, static_cast<const RDFDetail::RDefineBase *>(define.second.get()));
+
+   // the steps are written in booking order, in which every step comes after the ones it depends on
+   std::sort(steps.begin(), steps.end(),
+             [](const RCodeGenStep *s1, const RCodeGenStep *s2) { return s1->fIndex < s2->fIndex; });
+
+   // a column that is already there, e.g. a branch of the input TTree, is redefined rather than defined
+   std::unordered_set<std::string> existingColumns(lm.GetBranchNames().begin(), lm.GetBranchNames().end());
+   if (node.fDataSource != nullptr) {
+      const auto &dsColumns = node.fDataSource->GetColumnNames();
+      existingColumns.insert(dsColumns.begin(), dsColumns.end());
+   }
+
+   std::stringstream code;
+   code << "ROOT::RDF::RNode " << functionName << "(ROOT::RDF::RNode df)\n{\n   return df";
+   for (const auto *step : steps) {
+      const bool isRedefine = step->fKind == "Define" && !existingColumns.insert(step->fName).second;
+      code << "\n      ." << (isRedefine ? "Redefine" : step->fKind) << "(" << step->fArgs << ")";
+   }
+   code << ";\n}\n";
+   return code.str();
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
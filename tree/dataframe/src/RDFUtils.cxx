@@ -24,6 +24,7 @@
 #include "TInterpreter.h"
 #include "TLeaf.h"
 #include "TROOT.h" // IsImplicitMTEnabled, GetThreadPoolSize
+#include "TSystem.h"
 #include "TTree.h"
 
 #include <stdexcept>
@@ -367,6 +368,12 @@ unsigned int GetColumnWidth(const std::vector<std::string>& names, const unsigne
    return columnWidth;
 }
 
+RTemporaryFiles::~RTemporaryFiles()
+{
+   for (const auto &path : fPaths)
+      gSystem->Unlink(path.c_str());
+}
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
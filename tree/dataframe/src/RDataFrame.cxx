@@ -10,11 +10,14 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <string>
 
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RDataSource.hxx"
 #include "TChain.h"
 #include "TDirectory.h"
+#include "TEntryList.h"
+#include "TObjArray.h"
 
 // clang-format off
 /**
@@ -68,6 +71,7 @@ You can directly see RDataFrame in action in our [tutorials](https://root.cern.c
    - [Reading data formats other than ROOT trees](\ref other-file-formats)
    - [Call graphs (storing and reusing sets of transformations](\ref callgraphs)
    - [Visualizing the computation graph](\ref representgraph)
+   - [Systematic variations](\ref systematics)
 - [Class reference](\ref reference) -- most methods are implemented in the ROOT::RDF::RInterface base class
 
 \anchor cheatsheet
@@ -84,6 +88,7 @@ Transformations are a way to manipulate the data.
 | DefineSlotEntry() | Same as DefineSlot(), but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | Filter() | Filter rows based on user-defined conditions. |
 | Range() | Filter rows based on entry number (single-thread only). |
+| Vary() | Register systematic variations of a column. The varied results of the actions downstream are produced in the same event loop as the nominal ones, see \ref systematics "Systematic variations". |
 
 ### Actions
 Actions aggregate data into a result. Each one is described in more detail in the reference guide.
@@ -99,6 +104,7 @@ produce many different results in one event loop. Instant actions trigger the ev
 | Aggregate() | Execute a user-defined accumulation operation on the processed column values. |
 | Book() | Book execution of a custom action using a user-defined helper object. |
 | Cache() | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| CacheOnDisk() | Like Cache(), but the entries are written to an uncompressed file (by default a temporary one) that is read back by the returned RDataFrame. Useful to re-process datasets that do not fit in memory. |
 | Count() | Return the number of events processed. Useful e.g. to get a quick count of the number of events passing a Filter. |
 | Display() | Provides a printable representation of the dataset contents. The method returns a RDisplay() instance which can be queried to get a compressed tabular representation on the standard output or a complete representation as a string. |
 | Fill() | Fill a user-defined object with the values of the specified columns, as if by calling `Obj.Fill(col1, col2, ...). |
@@ -406,7 +412,8 @@ auto d15on = d.Range(15, 0);
 auto d15each3 = d.Range(0, 15, 3);
 ~~~
 Note that ranges are not available when multi-threading is enabled. More information on ranges is available
-[here](#ranges).
+[here](#ranges). To process an arbitrary selection of entries, also in multi-thread event loops, see
+[this section](#entry-lists).
 
 ### Executing multiple actions in the same event loop
 As a final example let us apply two different cuts on branch "MET" and fill two different histograms with the "pt\_v" of
@@ -692,6 +699,21 @@ preceding filter*.
 Ranges allow "early quitting": if all branches of execution of a functional graph reached their `end` value of
 processed entries, the event-loop is immediately interrupted. This is useful for debugging and quick data explorations.
 
+\anchor entry-lists
+### Processing a selection of entries
+Jobs that pick a few known events or reprocess the entries selected by a previous pass do not need to read the whole
+dataset: ROOT::RDF::MakeEntryListDataFrame() builds an RDataFrame that processes only the entries listed in a TEntryList,
+or in a vector of global entry numbers. Unlike Range(), this works in multi-thread event loops too, and only the
+clusters that contain selected entries are read:
+~~~{.cpp}
+TChain chain("events");
+chain.Add("run*.root");
+std::vector<Long64_t> picked{42, 1337, 100000}; // global entry numbers in the chain
+auto df = ROOT::RDF::MakeEntryListDataFrame(chain, picked);
+df.Snapshot("events", "picked.root");
+~~~
+Inside the event loop, `rdfentry_` counts the processed entries: it is not the entry number in the TTree.
+
 \anchor custom-columns
 ### Custom columns
 Custom columns are created by invoking `Define(name, f, columnList)`. As usual, `f` can be any callable object
@@ -729,6 +751,23 @@ first parameter is the slot number which ranges from 0 to ROOT::GetThreadPoolSiz
 - `DefineSlotEntry(name, f, columnList)`. In this case the callable f has this signature `R(unsigned int, ULong64_t,
 T1, T2, ...)`: the first parameter is the slot number while the second one the number of the entry being processed.
 
+\anchor systematics
+### Systematic variations
+Vary() registers systematic variations of a column: a callable that returns all the varied values of the column at
+once, as an RVec, and the names (tags) of the varied values. ROOT::RDF::Experimental::VariationsFor() then books the
+varied counterparts of a result, which are all produced in the same event loop as the nominal result:
+~~~{.cpp}
+auto nominal = df.Vary("pt", [](double pt) { return ROOT::RVec<double>{pt * 0.9, pt * 1.1}; }, {"pt"}, {"down", "up"})
+                 .Filter("pt > 10")
+                 .Histo1D("pt");
+auto histos = ROOT::RDF::Experimental::VariationsFor(nominal); // keys: "nominal", "pt:down", "pt:up"
+histos["pt:up"].Draw();
+~~~
+Only the filters and defines that depend on the varied column are evaluated once per varied value, the rest of the
+computation graph is shared with the nominal results. The variations only affect the nodes booked after the Vary()
+call. Count(), Fill() and the Histo*D() family, Min(), Max(), Sum(), Mean() and StdDev() support variations;
+VariationsFor() throws for the other actions.
+
 \anchor actions
 ## Actions
 ### Instant and lazy actions
@@ -753,6 +792,11 @@ ROOT::EnableImplicitMT(i)
 ~~~
 replacing `i` with the number of CPUs/slots that were allocated for this job.
 
+When reading TTrees, each batch of entries is one or more clusters of a file. Datasets made of a few files with a few large
+clusters result in few large batches, and many threads can stay idle while the last batches are processed. In that case,
+ROOT::TTreeProcessorMT::SetMaxTasksPerCluster() lets RDataFrame split clusters into smaller batches. This spreads the load
+more evenly, at the price of decompressing the baskets of a split cluster once per batch.
+
 ### Thread-safety of user-defined expressions
 RDataFrame operations such as Histo1D() or Snapshot() are guaranteed to work correctly in multi-thread event loops.
 User-defined expressions, such as strings or lambdas passed to Filter(), Define(), Foreach(), Reduce() or Aggregate()
@@ -813,9 +857,25 @@ Also make sure not to count the just-in-time compilation time (which happens onc
 auto verbosity = ROOT::Experimental::RLogScopedVerbosity(ROOT::Detail::RDF::RDFLogChannel(), ROOT::Experimental::ELogLevel::kInfo);
 ~~~
 
+To find out which nodes of the computation graph dominate the event loop runtime, ROOT::RDF::Experimental::EnableProfiling() can be called before
+running it. The time spent in each Filter, Define and action, and in reading each column of the dataset, is then available from
+ROOT::RDF::Experimental::GetProfileReport(), and is shown in the labels of the nodes in the output of [SaveGraph](#representgraph):
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "file.root");
+ROOT::RDF::Experimental::EnableProfiling(df);
+auto h = df.Define("pt", computePt, {"px", "py"}).Filter(isGood, {"pt"}).Histo1D<float>("pt");
+h->Draw();
+ROOT::RDF::Experimental::GetProfileReport(df).Print(); // one row per node, sorted by decreasing time
+~~~
+
+When reading TTrees, RDataFrame registers all the branches needed by the computation graph with the TTreeCache before
+the first entry is read, so there is no cache learning phase. If the first Filters are very selective, the branches that are
+only needed downstream of them can be left out of the cache with ROOT::RDF::Experimental::EnableStagedTreeCache(), so that their
+baskets are only read for the events that pass the cuts.
+
 ### Memory usage
 
-There are two reasons why RDataFrame may consume more memory than expected. Firstly, each result is duplicated for each worker thread, which e.g. in case of many (possibly multi-dimensional) histograms with fine binning can result in visible memory consumption during the event loop. The thread-local copies of the results are destroyed when the final result is produced.
+There are two reasons why RDataFrame may consume more memory than expected. Firstly, each result is duplicated for each worker thread, which e.g. in case of many (possibly multi-dimensional) histograms with fine binning can result in visible memory consumption during the event loop. The thread-local copies of the results are destroyed when the final result is produced. For histograms, ROOT::RDF::Experimental::EnableSharedHistoFill() avoids the copies: all threads fill the same histogram, buffering a fixed number of fills each.
 Secondly, just-in-time compilation of string expressions or non-templated actions (see the previous paragraph) causes Cling, ROOT's C++ interpreter, to allocate some memory for the generated code that is only released at the end of the application. This commonly results in memory usage creep in long-running applications that create many RDataFrames one after the other. Possible mitigations include creating and running each RDataFrame event loop in a sub-process, or booking all operations for all different RDataFrame computation graphs before the first event loop is triggered, so that the interpreter is invoked only once for all computation graphs.
 
 \anchor more-features
@@ -888,6 +948,15 @@ and return nothing. RDataFrame will invoke registered callbacks passing partial
 
 Read more on ROOT::RDF::RResultPtr::OnPartialResult().
 
+To monitor a whole event loop rather than a single result, ROOT::RDF::Experimental::EnableProgressReport() registers a
+callback that periodically receives the number of entries processed so far, in total and per processing slot, the
+processing and reading rates and an estimate of the remaining time. It is cheap enough to be left on in production:
+~~~{.cpp}
+ROOT::RDF::Experimental::EnableProgressReport(df, [](const ROOT::RDF::Experimental::RProgressInfo &p) {
+   std::cout << p.fNEntries << " entries, " << p.fEntriesPerSecond << " entries/s, " << p.fMBPerSecond << " MB/s\n";
+});
+~~~
+
 \anchor default-branches
 ### Default branch lists
 When constructing a RDataFrame object, it is possible to specify a **default column list** for your analysis, in the
@@ -952,6 +1021,20 @@ from Filters or Defines. This is typically perfectly fine and avoids certain com
 Classes and other complex types are read by non-constant references to avoid copies and to permit calls to non-const member functions.
 Note that calling non-const member functions will often not be thread-safe.
 
+All code that needs just-in-time compilation is collected while the computation graph is booked and compiled in one
+go right before the first event loop of any RDataFrame runs. The compilation time grows with the number of jitted
+nodes, and it is paid again by every process: the compiled code is not persisted across processes. String
+expressions are cached per process, though: identical expressions, also when they are applied to different columns of
+the same types, are declared to the interpreter only once. Going one step further, a string Filter that is identical to
+one already booked on the same node, or a string Define with the same name and expression as one booked before, reuses
+the existing node if their input columns are the same: the expression is then compiled and evaluated only once per
+entry, e.g. when the selections of several analyses are booked on a common RDataFrame. For short jobs with large computation graphs, in which
+jitting dominates the startup time, it is best to avoid it altogether by passing C++ callables to Filter() and
+Define() and by specifying the column types as template parameters of the actions; the analysis can then be compiled,
+e.g. with ACLiC or as a standalone executable. ROOT::RDF::Experimental::GenerateCode() does the conversion for
+graphs booked with string expressions: it writes out their Filters, Defines and Ranges as a C++ function that uses
+typed lambdas, and ROOT::RDF::Experimental::SaveGeneratedCode() adds a CMake project that builds it as a library.
+
 \anchor generic-actions
 ### Generic actions
 RDataFrame strives to offer a comprehensive set of standard actions that can be performed on each event. At the same
@@ -1224,6 +1307,73 @@ RDataFrame::RDataFrame(std::unique_ptr<ROOT::RDF::RDataSource> ds, const ColumnN
 {
 }
 
+namespace RDF {
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Build a dataframe that processes only the entries of a TTree or TChain listed in a TEntryList.
+/// \param[in] tree The tree or chain to be studied.
+/// \param[in] entries The entries to process, either with global entry numbers or with one sub-list per tree of the
+///                    chain.
+/// \param[in] defaultBranches Collection of default column names to fall back to when none is specified.
+///
+/// The entry list is copied, and it takes precedence over the entry list attached to the tree (if any). Entries are
+/// processed in ascending order; in multi-thread event loops, only the clusters that contain selected entries are
+/// read. See [the corresponding section](\ref entry-lists) of the RDataFrame documentation.
+RDataFrame
+MakeEntryListDataFrame(TTree &tree, const TEntryList &entries, const RDataFrame::ColumnNames_t &defaultBranches)
+{
+   std::unique_ptr<TEntryList> globalEntries;
+   if (entries.GetLists() == nullptr) {
+      globalEntries = std::make_unique<TEntryList>(entries);
+   } else {
+      // sub-lists hold local entry numbers of each tree of a chain: convert them to global entry numbers
+      auto *chain = dynamic_cast<TChain *>(&tree);
+      if (chain == nullptr)
+         throw std::invalid_argument("MakeEntryListDataFrame: the entry list has sub-lists but the input is not a "
+                                     "TChain. Please provide an entry list with global entry numbers instead.");
+      TEntryList entriesCopy(entries); // TEntryList::GetEntryList is not const
+      globalEntries = std::make_unique<TEntryList>();
+      chain->GetEntries(); // computes the offsets of all trees
+      const Long64_t *treeOffsets = chain->GetTreeOffset();
+      TObjArray *files = chain->GetListOfFiles();
+      for (int treeIdx = 0; treeIdx < files->GetEntries(); ++treeIdx) {
+         const auto *element = files->At(treeIdx);
+         TEntryList *subList = entriesCopy.GetEntryList(element->GetName(), element->GetTitle(), "ne");
+         if (subList == nullptr)
+            continue;
+         for (Long64_t i = 0; i < subList->GetN(); ++i)
+            globalEntries->Enter(subList->GetEntry(i) + treeOffsets[treeIdx]);
+      }
+   }
+
+   RDataFrame df(tree, defaultBranches);
+   ROOT::Internal::RDF::GetLoopManager(df)->SetEntryList(std::move(globalEntries));
+   return df;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Build a dataframe that processes only the given entries of a TTree or TChain.
+/// \param[in] tree The tree or chain to be studied.
+/// \param[in] entries The global entry numbers of the entries to process.
+/// \param[in] defaultBranches Collection of default column names to fall back to when none is specified.
+///
+/// The entries are processed in ascending order, and only once if they are repeated. See
+/// [the corresponding section](\ref entry-lists) of the RDataFrame documentation.
+RDataFrame
+MakeEntryListDataFrame(TTree &tree, const std::vector<Long64_t> &entries, const RDataFrame::ColumnNames_t &defaultBranches)
+{
+   TEntryList entryList;
+   for (const auto entry : entries) {
+      if (entry < 0)
+         throw std::invalid_argument("MakeEntryListDataFrame: entry numbers must not be negative, found " +
+                                     std::to_string(entry) + ".");
+      entryList.Enter(entry);
+   }
+   return MakeEntryListDataFrame(tree, entryList, defaultBranches);
+}
+
+} // namespace RDF
+
 } // namespace ROOT
 
 namespace cling {
@@ -9,6 +9,8 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDF/RVariationBase.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h" // Long64_t
@@ -47,3 +49,51 @@ std::string RDefineBase::GetTypeName() const
 {
    return fType;
 }
+
+void RDefineBase::SetProfiler(RDFInternal::RProfiler *profiler)
+{
+   // defines are shared by all the nodes that use them: only register them once
+   if (profiler == fProfiler)
+      return;
+   fProfiler = profiler;
+   if (fProfiler)
+      fProfilerID = fProfiler->RegisterNode(RDFInternal::RProfiler::ENodeKind::kDefine, fName, this);
+   for (auto &define : fDefines.GetColumns())
+      define.second->SetProfiler(profiler);
+}
+
+std::shared_ptr<RDefineBase> RDefineBase::GetVariedDefine(const std::string &variationName, std::size_t varIdx)
+{
+   auto &variedDefine = fVariedDefines[{variationName, varIdx}];
+   if (!variedDefine)
+      variedDefine = MakeVariedDefine(variationName, varIdx);
+   return variedDefine;
+}
+
+void RDFInternal::AddDatasetColumns(const std::vector<std::string> &columns, const RDFInternal::RBookedDefines &defines,
+                                    std::set<std::string> &datasetColumns)
+{
+   const auto &defineMap = defines.GetColumns();
+   for (const auto &column : columns) {
+      const auto defineIt = defineMap.find(column);
+      if (defineIt != defineMap.end())
+         defineIt->second->AddDatasetColumns(datasetColumns);
+      else
+         datasetColumns.insert(column);
+   }
+}
+
+void RDFInternal::AddVariations(const std::vector<std::string> &columns, const RDFInternal::RBookedDefines &defines,
+                                RDFInternal::RVariationTags_t &variations)
+{
+   const auto &defineMap = defines.GetColumns();
+   for (const auto &column : columns) {
+      for (const auto &variation : defines.GetVariations()) {
+         if (variation->GetColumnName() == column)
+            variations.emplace(variation->GetVariationName(), variation->GetTags());
+      }
+      const auto defineIt = defineMap.find(column);
+      if (defineIt != defineMap.end())
+         defineIt->second->AddVariations(variations);
+   }
+}
@@ -9,7 +9,10 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include <numeric> // std::accumulate
 
@@ -50,4 +53,10 @@ void RFilterBase::InitNode()
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots * RDFInternal::CacheLineStep<Long64_t>(), -1);
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
+   fProfiler = fLoopManager->GetProfiler();
+   if (fProfiler)
+      fProfilerID = fProfiler->RegisterNode(RDFInternal::RProfiler::ENodeKind::kFilter,
+                                            HasName() ? fName : "Unnamed Filter", this);
+   for (auto &define : fDefines.GetColumns())
+      define.second->SetProfiler(fProfiler);
 }
@@ -84,6 +84,18 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::Get
    return fConcreteAction->GetGraph();
 }
 
+const ROOT::Detail::RDF::RNodeBase *RJittedAction::GetPrevNode() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetPrevNode();
+}
+
+const ROOT::Internal::RDF::RActionBase &RJittedAction::GetConcreteAction() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return *fConcreteAction;
+}
+
 /**
    Retrieve a wrapper to the result of the action that knows how to merge
    with others of the same type.
@@ -99,3 +111,16 @@ std::function<void(unsigned int)> RJittedAction::GetDataBlockCallback()
    R__ASSERT(fConcreteAction != nullptr);
    return fConcreteAction->GetDataBlockCallback();
 }
+
+void RJittedAction::AddVariations(RVariationTags_t &variations) const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->AddVariations(variations);
+}
+
+std::unique_ptr<ROOT::Internal::RDF::RActionBase>
+RJittedAction::MakeVariedAction(const std::string &variationName, std::size_t varIdx, void *newResult)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->MakeVariedAction(variationName, varIdx, newResult);
+}
@@ -42,3 +42,30 @@ void RJittedDefine::FinaliseSlot(unsigned int slot)
    R__ASSERT(fConcreteDefine != nullptr);
    fConcreteDefine->FinaliseSlot(slot);
 }
+
+void RJittedDefine::SetProfiler(RDFInternal::RProfiler *profiler)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->SetProfiler(profiler);
+   // the concrete define measures itself, we only expose its ID e.g. to the graph drawing code
+   fProfiler = fConcreteDefine->GetProfiler();
+   fProfilerID = fConcreteDefine->GetProfilerID();
+}
+
+void RJittedDefine::AddDatasetColumns(std::set<std::string> &columns) const
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->AddDatasetColumns(columns);
+}
+
+void RJittedDefine::AddVariations(RDFInternal::RVariationTags_t &variations) const
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->AddVariations(variations);
+}
+
+std::shared_ptr<RDefineBase> RJittedDefine::MakeVariedDefine(const std::string &variationName, std::size_t varIdx)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetVariedDefine(variationName, varIdx);
+}
@@ -112,3 +112,20 @@ std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
    }
    throw std::runtime_error("The Jitting should have been invoked before this method.");
 }
+
+void RJittedFilter::AddVariations(RDFInternal::RVariationTags_t &variations) const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->AddVariations(variations);
+}
+
+std::shared_ptr<RNodeBase> RJittedFilter::MakeVariedFilter(const std::string &variationName, std::size_t varIdx)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   // the nodes downstream of this one expect a RJittedFilter as their previous node: wrap the varied concrete filter.
+   // The wrapper is not booked, the varied concrete filter already is.
+   auto variedFilter = std::make_shared<RJittedFilter>(fLoopManager, "");
+   variedFilter->fConcreteFilter =
+      std::static_pointer_cast<RFilterBase>(fConcreteFilter->GetVariedFilter(variationName, varIdx));
+   return variedFilter;
+}
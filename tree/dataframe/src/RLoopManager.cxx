@@ -10,21 +10,33 @@
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RMergeableValue.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDF/RProgressMonitor.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
+#include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RLogger.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RtypesCore.h" // Long64_t
 #include "TStopwatch.h"
 #include "TBranchElement.h"
 #include "TBranchObject.h"
+#include "TBufferFile.h"
 #include "TChain.h"
+#include "TChainElement.h"
+#include "TClass.h"
 #include "TEntryList.h"
 #include "TFile.h"
 #include "TFriendElement.h"
 #include "TInterpreter.h"
+#include "TKey.h"
+#include "TMD5.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TSystem.h"
 #include "TTreeReader.h"
 #include "TTree.h" // For MaxTreeSizeRAII. Revert when #6640 will be solved.
 
@@ -33,12 +45,17 @@
 #include "ROOT/TTreeProcessorMT.hxx"
 #endif
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
 #include <algorithm>
 #include <atomic>
 #include <exception>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -383,6 +400,7 @@ void RLoopManager::RunEmptySourceMT()
 
    // Each task will generate a subrange of entries
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+      R__TRACE_SPAN("rdf", "RDataFrame task");
       RSlotRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
       RCallCleanUpTask cleanup(*this, slot);
@@ -408,11 +426,13 @@ void RLoopManager::RunEmptySourceMT()
 /// Run event loop with no source files, in sequence.
 void RLoopManager::RunEmptySource()
 {
+   R__TRACE_SPAN("rdf", "RDataFrame event loop");
    InitNodeSlots(nullptr, 0);
-   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", 0, fNEmptyEntries, 0u});
+   const auto range = GetPartitionEntryRange(fNEmptyEntries);
+   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, 0u});
    RCallCleanUpTask cleanup(*this);
    try {
-      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
+      for (ULong64_t currEntry = range.first; currEntry < range.second && fNStopsReceived < fNChildren; ++currEntry) {
          RunAndCheckFilters(0, currEntry);
       }
    } catch (...) {
@@ -426,12 +446,13 @@ void RLoopManager::RunTreeProcessorMT()
 {
 #ifdef R__USE_IMT
    RSlotStack slotStack(fNSlots);
-   const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
+   const auto &entryList = GetEntryList() ? *GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList, fNSlots);
 
    std::atomic<ULong64_t> entryCount(0ull);
 
    tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+      R__TRACE_SPAN("rdf", "RDataFrame task");
       RSlotRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
       RCallCleanUpTask cleanup(*this, slot, &r);
@@ -456,9 +477,16 @@ void RLoopManager::RunTreeProcessorMT()
 /// Run event loop over one or multiple ROOT files, in sequence.
 void RLoopManager::RunTreeReader()
 {
-   TTreeReader r(fTree.get(), fTree->GetEntryList());
+   R__TRACE_SPAN("rdf", "RDataFrame event loop");
+   TTreeReader r(fTree.get(), GetEntryList());
    if (0 == fTree->GetEntriesFast())
       return;
+   if (fNPartitions > 1 || fHasPartitionRange) {
+      const auto range = GetPartitionEntryRange(fTree->GetEntries());
+      if (range.first == range.second)
+         return;
+      r.SetEntriesRange(range.first, range.second);
+   }
    RCallCleanUpTask cleanup(*this, 0u, &r);
    InitNodeSlots(&r, 0);
    R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, 0u));
@@ -473,7 +501,11 @@ void RLoopManager::RunTreeReader()
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
    }
-   if (r.GetEntryStatus() != TTreeReader::kEntryNotFound && fNStopsReceived < fNChildren) {
+   // a partial entry range ends with kEntryBeyondEnd rather than kEntryNotFound
+   const bool isAtEnd = r.GetEntryStatus() == TTreeReader::kEntryNotFound ||
+                        ((fNPartitions > 1 || fHasPartitionRange) &&
+                         r.GetEntryStatus() == TTreeReader::kEntryBeyondEnd);
+   if (!isAtEnd && fNStopsReceived < fNChildren) {
       // something went wrong in the TTreeReader event loop
       throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                std::to_string(r.GetEntryStatus()));
@@ -483,15 +515,20 @@ void RLoopManager::RunTreeReader()
 /// Run event loop over data accessed through a DataSource, in sequence.
 void RLoopManager::RunDataSource()
 {
+   R__TRACE_SPAN("rdf", "RDataFrame event loop");
    R__ASSERT(fDataSource != nullptr);
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
+   // in multi-process event loops, the ranges are distributed round-robin among the processes
+   unsigned int rangeIdx = 0;
    while (!ranges.empty() && fNStopsReceived < fNChildren) {
       InitNodeSlots(nullptr, 0u);
       fDataSource->InitSlot(0u, 0ull);
       RCallCleanUpTask cleanup(*this);
       try {
          for (const auto &range : ranges) {
+            if (rangeIdx++ % fNPartitions != fPartitionIdx)
+               continue;
             const auto start = range.first;
             const auto end = range.second;
             R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({fDataSource->GetLabel(), start, end, 0u});
@@ -521,6 +558,7 @@ void RLoopManager::RunDataSourceMT()
 
    // Each task works on a subrange of entries
    auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+      R__TRACE_SPAN("rdf", "RDataFrame task");
       RSlotRAII slotRAII(slotStack);
       const auto slot = slotRAII.fSlot;
       InitNodeSlots(nullptr, slot);
@@ -558,6 +596,8 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
    // data-block callbacks run before the rest of the graph
    if (fDataBlockNotifier.CheckFlag(slot)) {
+      if (!fLazyBranches.empty())
+         DropLazyBranchesFromCache(slot);
       for (auto &callback : fDataBlockCallbacks) {
          callback(slot);
       }
@@ -570,6 +610,8 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       namedFilterPtr->CheckFilters(slot, entry);
    for (auto &callback : fCallbacks)
       callback(slot);
+   if (fProgressMonitor)
+      fProgressMonitor->Update(slot);
 }
 
 /// Build TTreeReaderValues for all nodes
@@ -577,6 +619,8 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// calls their `InitSlot` method, to get them ready for running a task.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   if (!fLazyBranches.empty())
+      fTreeReaders[slot] = r;
    SetupDataBlockCallbacks(r, slot);
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
@@ -607,12 +651,69 @@ void RLoopManager::SetupDataBlockCallbacks(TTreeReader *r, unsigned int slot) {
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   fEagerColumns.clear();
+   fLazyColumns.clear();
    for (auto &filter : fBookedFilters)
       filter->InitNode();
    for (auto &range : fBookedRanges)
       range->InitNode();
    for (auto &ptr : fBookedActions)
       ptr->Initialize();
+   SetupLazyBranches();
+}
+
+/// Called by filters and actions in InitNode/Initialize with the columns they read. Nodes are `eager` if they are
+/// evaluated for every entry, i.e. if they are attached directly to the RLoopManager.
+void RLoopManager::RegisterColumnsRead(const ColumnNames_t &columns, const RDFInternal::RBookedDefines &defines,
+                                       bool eager)
+{
+   if (!fStagedTreeCache)
+      return;
+   RDFInternal::AddDatasetColumns(columns, defines, eager ? fEagerColumns : fLazyColumns);
+}
+
+/// Select the branches to leave out of the TTreeCache: those that are read by nodes downstream of a Filter (or of a
+/// Range) only. Branches that contain a branch which is read for every entry are kept.
+void RLoopManager::SetupLazyBranches()
+{
+   fLazyBranches.clear();
+   if (!fStagedTreeCache || !fTree)
+      return;
+   for (const auto &column : fLazyColumns) {
+      if (fEagerColumns.count(column) > 0)
+         continue;
+      auto isSubBranch = [&column](const std::string &c) {
+         return c.size() > column.size() && c.compare(0, column.size(), column) == 0 && c[column.size()] == '.';
+      };
+      const auto isParentOfEager = std::any_of(fEagerColumns.begin(), fEagerColumns.end(), isSubBranch);
+      if (!isParentOfEager)
+         fLazyBranches.emplace_back(column);
+   }
+   if (fLazyBranches.empty())
+      return;
+   fTreeReaders.assign(fNSlots, nullptr);
+   std::string branchList;
+   for (const auto &branch : fLazyBranches)
+      branchList += " " + branch;
+   R__LOG_INFO(RDFLogChannel()) << "Branches only read downstream of a Filter, not prefetched by the TTreeCache:"
+                                << branchList;
+}
+
+/// Drop fLazyBranches from the TTreeCache of the tree currently processed in the given slot.
+/// Called at the beginning of every data block, after TTreeReader has added all the branches to the cache.
+void RLoopManager::DropLazyBranchesFromCache(unsigned int slot)
+{
+   auto *r = fTreeReaders[slot];
+   if (r == nullptr)
+      return;
+   auto *tree = r->GetTree()->GetTree(); // the current tree in case of a TChain
+   auto *file = tree ? tree->GetCurrentFile() : nullptr;
+   if (file == nullptr || tree->GetReadCache(file, true) == nullptr)
+      return;
+   for (const auto &branch : fLazyBranches) {
+      if (tree->GetBranch(branch.c_str()) != nullptr)
+         tree->DropBranchFromCache(branch.c_str(), /*subbranches=*/true);
+   }
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
@@ -643,6 +744,8 @@ void RLoopManager::CleanUpNodes()
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
 {
+   if (!fLazyBranches.empty())
+      fTreeReaders[slot] = nullptr;
    if (r != nullptr)
       fDataBlockNotifier.GetChainNotifyLink(slot).RemoveLink(*r->GetTree());
    for (auto &ptr : fBookedActions)
@@ -663,6 +766,7 @@ void RLoopManager::Jit()
       R__LOG_INFO(RDFLogChannel()) << "Nothing to jit and execute.";
       return;
    }
+   R__TRACE_SPAN("rdf", "RDataFrame jitting");
 
    TStopwatch s;
    s.Start();
@@ -701,6 +805,9 @@ void RLoopManager::Run()
 
    InitNodes();
 
+   if (fProgressMonitor)
+      fProgressMonitor->Start(GetNEntriesToProcess());
+
    TStopwatch s;
    s.Start();
    switch (fLoopType) {
@@ -713,6 +820,9 @@ void RLoopManager::Run()
    }
    s.Stop();
 
+   if (fProgressMonitor)
+      fProgressMonitor->Stop();
+
    CleanUpNodes();
 
    fNRuns++;
@@ -721,6 +831,431 @@ void RLoopManager::Run()
                                 << s.RealTime() << "s elapsed).";
 }
 
+/// Return the part [begin, end) of the entries [0, nEntries) that is processed by this process; all the entries unless
+/// this is a worker of a multi-process event loop.
+std::pair<ULong64_t, ULong64_t> RLoopManager::GetPartitionEntryRange(ULong64_t nEntries) const
+{
+   if (fHasPartitionRange)
+      return {std::min(fPartitionRange.first, nEntries), std::min(fPartitionRange.second, nEntries)};
+   const ULong64_t base = nEntries / fNPartitions;
+   const ULong64_t rest = nEntries % fNPartitions;
+   const ULong64_t begin = base * fPartitionIdx + std::min<ULong64_t>(fPartitionIdx, rest);
+   return {begin, begin + base + (fPartitionIdx < rest ? 1 : 0)};
+}
+
+/// Return the number of entries that the event loop is going to process, or -1 if it is not known without reading the
+/// dataset. Ranges are not taken into account.
+Long64_t RLoopManager::GetNEntriesToProcess() const
+{
+   if (auto *entryList = GetEntryList())
+      return entryList->GetN();
+   if (fTree) {
+      // for chains whose files have not been opened yet this is TTree::kMaxEntries
+      const auto nEntries = fTree->GetEntriesFast();
+      if (nEntries >= TTree::kMaxEntries)
+         return -1;
+      const auto range = GetPartitionEntryRange(nEntries);
+      return range.second - range.first;
+   }
+   if (fDataSource)
+      return -1;
+   const auto range = GetPartitionEntryRange(fNEmptyEntries);
+   return range.second - range.first;
+}
+
+/// Run the event loop in nWorkers forked processes and merge their partial results into the results of the booked
+/// actions, given by `results` in the order of GetBookedActions().
+/// Every worker processes a different part of the dataset: trees and empty sources are split into contiguous entry
+/// ranges of similar size, the entry ranges of data sources are distributed round-robin. The workers send back their
+/// partial results as streamed RMergeableValue objects, so all the booked actions must provide GetMergeableValue().
+void RLoopManager::RunMultiProcess(unsigned int nWorkers, const std::vector<void *> &results)
+{
+#ifndef R__WIN32
+   if (nWorkers == 0)
+      throw std::invalid_argument("RunGraphsMP: the number of worker processes must be positive.");
+   if (fNSlots > 1)
+      throw std::runtime_error("RunGraphsMP: the RDataFrame must be constructed with implicit multi-threading disabled.");
+   if (!fBookedRanges.empty())
+      throw std::runtime_error("RunGraphsMP: Range is not supported in multi-process event loops.");
+   if (GetEntryList())
+      throw std::runtime_error("RunGraphsMP: trees with an entry list are not supported in multi-process event loops.");
+   R__ASSERT(results.size() == fBookedActions.size());
+
+   // jit before forking, so that the workers inherit the compiled code
+   Jit();
+
+   const auto actions = fBookedActions;
+   // the reply of a worker is its partition index, an error message (empty on success) and a streamed mergeable for
+   // each action
+   auto runPartition = [this, &actions, nWorkers](unsigned int idx) {
+      std::vector<std::string> reply{std::to_string(idx), ""};
+      try {
+         fPartitionIdx = idx;
+         fNPartitions = nWorkers;
+         Run();
+         for (auto *action : actions) {
+            auto mergeable = action->GetMergeableValue();
+            const auto &mergeableType = typeid(*mergeable);
+            auto cl = TClass::GetClass(mergeableType);
+            if (!cl)
+               throw std::runtime_error("no dictionary for " + TypeID2TypeName(mergeableType));
+            TBufferFile buf(TBuffer::kWrite);
+            buf.WriteObjectAny(dynamic_cast<void *>(mergeable.get()), cl);
+            reply.emplace_back(buf.Buffer(), buf.Length());
+         }
+      } catch (const std::exception &e) {
+         reply.resize(2);
+         reply[1] = e.what();
+      }
+      return reply;
+   };
+
+   // with as many partitions as processes, every worker receives exactly one partition
+   ROOT::TProcessExecutor pool(nWorkers);
+   std::vector<unsigned int> partitions(nWorkers);
+   std::iota(partitions.begin(), partitions.end(), 0u);
+   auto replies = pool.Map(runPartition, partitions);
+
+   if (replies.size() != nWorkers)
+      throw std::runtime_error("RunGraphsMP: " + std::to_string(nWorkers - replies.size()) +
+                               " worker process(es) did not return their results.");
+   for (const auto &reply : replies) {
+      if (!reply[1].empty())
+         throw std::runtime_error("RunGraphsMP: worker process " + reply[0] + " failed: " + reply[1]);
+   }
+   // merge in partition order, e.g. for the points of a TGraph to keep the entry order
+   std::sort(replies.begin(), replies.end(), [](const std::vector<std::string> &a, const std::vector<std::string> &b) {
+      return std::stoul(a[0]) < std::stoul(b[0]);
+   });
+
+   auto clBase = TClass::GetClass<RMergeableValueBase>();
+   for (std::size_t i = 0; i < actions.size(); ++i) {
+      std::unique_ptr<RMergeableValueBase> merged;
+      for (auto &reply : replies) {
+         auto &streamed = reply[2 + i];
+         TBufferFile buf(TBuffer::kRead, streamed.size(), &streamed[0], kFALSE);
+         std::unique_ptr<RMergeableValueBase> mergeable(static_cast<RMergeableValueBase *>(buf.ReadObjectAny(clBase)));
+         if (!mergeable)
+            throw std::runtime_error("RunGraphsMP: cannot read the partial result of worker process " + reply[0]);
+         if (merged)
+            merged->MergeAny(*mergeable);
+         else
+            merged = std::move(mergeable);
+      }
+      merged->CopyValueTo(results[i]);
+   }
+
+   // the actions ran in the worker processes: finalizing them again would overwrite the merged results
+   for (auto *action : actions)
+      action->SetHasRun();
+   fRunActions.insert(fRunActions.begin(), fBookedActions.begin(), fBookedActions.end());
+   fBookedActions.clear();
+   CleanUpNodes();
+   fNRuns++;
+#else
+   (void)nWorkers;
+   (void)results;
+   throw std::runtime_error("RunGraphsMP: multi-process event loops are not supported on this platform.");
+#endif
+}
+
+#ifndef R__WIN32
+namespace {
+
+/// Return the MD5 digest of s, as a hexadecimal string
+std::string GetDigest(const std::string &s)
+{
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(s.data()), s.size());
+   md5.Final();
+   return md5.AsString();
+}
+
+TClass *GetMergeableClass(const RMergeableValueBase &mergeable)
+{
+   const auto &mergeableType = typeid(mergeable);
+   auto cl = TClass::GetClass(mergeableType);
+   if (!cl)
+      throw std::runtime_error("RunGraphsCached: no dictionary for " + TypeID2TypeName(mergeableType));
+   return cl;
+}
+
+/// Return the cache key of the result of an action: a digest of the code of the just-in-time-compiled Filters and
+/// Defines upstream of it (see RCodeGenStep), of the columns it reads and of its configuration, e.g. the model of a
+/// histogram, given by its result before the event loop.
+std::string GetActionCacheKey(const RLoopManager &lm, const RActionBase &jittedAction)
+{
+   const auto &action = jittedAction.GetConcreteAction();
+   std::vector<const RCodeGenStep *> steps;
+   std::set<const void *> collectedDefines;
+   std::function<void(const std::string &, const void *)> collectDefine = [&](const std::string &colName,
+                                                                              const void *define) {
+      if (!collectedDefines.insert(define).second)
+         return;
+      const auto *step = lm.GetCodeGenStep(define);
+      if (step == nullptr) {
+         if (colName == "rdfentry_" || colName == "rdfslot_")
+            return; // always available
+         throw std::runtime_error("RunGraphsCached: column \"" + colName +
+                                  "\" was not defined with a string expression. Only the results that depend on "
+                                  "just-in-time-compiled Filters and Defines can be cached.");
+      }
+      steps.emplace_back(step);
+      for (const auto &usedDefine : step->fDefines)
+         collectDefine(usedDefine.first, usedDefine.second);
+   };
+
+   std::string columns;
+   const auto &aliases = lm.GetAliasMap();
+   for (auto colName : action.GetColumnNames()) {
+      const auto alias = aliases.find(colName);
+      if (alias != aliases.end())
+         colName = alias->second;
+      columns += colName + ",";
+      if (action.GetDefines().HasName(colName))
+         collectDefine(colName, action.GetDefines().GetColumns().at(colName).get());
+   }
+   const RNodeBase *root = &lm;
+   for (const RNodeBase *n = action.GetPrevNode(); n != root;) {
+      const auto *step = lm.GetCodeGenStep(n);
+      if (step == nullptr)
+         throw std::runtime_error("RunGraphsCached: the computation graph contains a Filter that was not booked with a "
+                                  "string expression, or a transformation other than Filter and Define. Only the "
+                                  "results that depend on just-in-time-compiled Filters and Defines can be cached.");
+      steps.emplace_back(step);
+      for (const auto &usedDefine : step->fDefines)
+         collectDefine(usedDefine.first, usedDefine.second);
+      n = static_cast<const RNodeBase *>(step->fPrevNode);
+   }
+   std::sort(steps.begin(), steps.end(),
+             [](const RCodeGenStep *s1, const RCodeGenStep *s2) { return s1->fIndex < s2->fIndex; });
+
+   std::string key;
+   for (const auto *step : steps)
+      key += step->fKind + "(" + step->fArgs + ")\n";
+   key += "Action(" + columns + ")\n";
+   const auto mergeable = action.GetMergeableValue();
+   const auto cl = GetMergeableClass(*mergeable);
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteObjectAny(dynamic_cast<const void *>(mergeable.get()), cl);
+   key += std::string(cl->GetName()) + "\n" + std::string(buf.Buffer(), buf.Length());
+   return GetDigest(key);
+}
+
+/// Return the cache key of the tree treeName, with nEntries entries, of file: the UUID of the file changes when it is
+/// rewritten, its size when it is updated.
+std::string GetFileCacheKey(TFile &file, const std::string &treeName, Long64_t nEntries)
+{
+   return GetDigest(std::string(file.GetUUID().AsString()) + " " + std::to_string(file.GetEND()) + " " + treeName +
+                    " " + std::to_string(nEntries));
+}
+
+/// Return whether the cache file at path holds results under all the given keys
+bool HasCachedResults(const std::string &path, const std::vector<std::string> &keys)
+{
+   if (gSystem->AccessPathName(path.c_str()))
+      return false;
+   TDirectory::TContext ctxt;
+   std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+   if (!file || file->IsZombie())
+      return false;
+   for (const auto &key : keys) {
+      if (!file->GetListOfKeys()->FindObject(key.c_str()))
+         return false;
+   }
+   return true;
+}
+
+/// Write the partial results of the actions to the cache file at path, under the given keys. The results that the file
+/// already holds under other keys, e.g. those of other computation graphs, are kept. The file is written under a
+/// temporary name and then renamed, so that it is never seen partially written.
+void WriteCachedResults(const std::string &path, const std::vector<std::string> &keys,
+                        const std::vector<RActionBase *> &actions)
+{
+   TDirectory::TContext ctxt;
+   const auto tmpPath = path + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+   {
+      std::unique_ptr<TFile> out(TFile::Open(tmpPath.c_str(), "RECREATE"));
+      if (!out || out->IsZombie())
+         throw std::runtime_error("cannot create the cache file \"" + tmpPath + "\"");
+      for (std::size_t i = 0; i < actions.size(); ++i) {
+         const auto mergeable = actions[i]->GetMergeableValue();
+         out->WriteObjectAny(dynamic_cast<const void *>(mergeable.get()), GetMergeableClass(*mergeable),
+                             keys[i].c_str());
+      }
+      std::unique_ptr<TFile> old(gSystem->AccessPathName(path.c_str()) ? nullptr : TFile::Open(path.c_str(), "READ"));
+      if (old && !old->IsZombie()) {
+         TIter next(old->GetListOfKeys());
+         while (auto key = static_cast<TKey *>(next())) {
+            if (std::find(keys.begin(), keys.end(), key->GetName()) != keys.end())
+               continue;
+            auto cl = TClass::GetClass(key->GetClassName());
+            void *obj = cl ? key->ReadObjectAny(cl) : nullptr;
+            if (!obj)
+               continue;
+            out->WriteObjectAny(obj, cl, key->GetName());
+            cl->Destructor(obj);
+         }
+      }
+      out->Close();
+   }
+   if (gSystem->Rename(tmpPath.c_str(), path.c_str()) != 0) {
+      gSystem->Unlink(tmpPath.c_str());
+      throw std::runtime_error("cannot write the cache file \"" + path + "\"");
+   }
+}
+
+} // anonymous namespace
+#endif // R__WIN32
+
+/// Run the event loop on the files of the input tree whose partial results are not found in the cache directory
+/// `cacheDir`, store their partial results there, and merge the partial results of all files into the results of the
+/// booked actions, given by `results` in the order of GetBookedActions().
+/// The partial results of an input file are stored in a file named after the cache key of the input file, under the
+/// cache keys of the actions (see GetFileCacheKey() and GetActionCacheKey()). The files are processed in forked
+/// processes, up to nWorkers at a time, which run the event loop on the entry range of one file each.
+void RLoopManager::RunCached(const std::string &cacheDir, unsigned int nWorkers, const std::vector<void *> &results)
+{
+#ifndef R__WIN32
+   if (nWorkers == 0)
+      throw std::invalid_argument("RunGraphsCached: the number of worker processes must be positive.");
+   if (!fTree)
+      throw std::runtime_error("RunGraphsCached: only the results of RDataFrames reading a TTree or a TChain can be "
+                               "cached.");
+   if (fNSlots > 1)
+      throw std::runtime_error(
+         "RunGraphsCached: the RDataFrame must be constructed with implicit multi-threading disabled.");
+   if (!fBookedRanges.empty())
+      throw std::runtime_error("RunGraphsCached: the results of graphs with a Range cannot be cached.");
+   if (GetEntryList())
+      throw std::runtime_error("RunGraphsCached: the results of trees with an entry list cannot be cached.");
+   if (fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetEntries() > 0)
+      throw std::runtime_error("RunGraphsCached: the results of trees with friends cannot be cached.");
+   R__ASSERT(results.size() == fBookedActions.size());
+
+   // jit before forking, so that the workers inherit the compiled code
+   Jit();
+
+   const auto actions = fBookedActions;
+   std::vector<std::string> actionKeys;
+   for (auto *action : actions)
+      actionKeys.emplace_back(GetActionCacheKey(*this, *action));
+
+   // the input files, with their cache keys and their entry ranges
+   std::vector<std::string> fileKeys;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fileRanges;
+   {
+      TDirectory::TContext ctxt;
+      if (auto chain = dynamic_cast<TChain *>(fTree.get())) {
+         chain->GetEntries(); // sets the tree offsets
+         const auto offsets = chain->GetTreeOffset();
+         const auto files = chain->GetListOfFiles();
+         for (int i = 0; i < files->GetEntries(); ++i) {
+            const auto element = static_cast<TChainElement *>(files->At(i));
+            std::unique_ptr<TFile> file(TFile::Open(element->GetTitle(), "READ"));
+            if (!file || file->IsZombie())
+               throw std::runtime_error("RunGraphsCached: cannot open file \"" + std::string(element->GetTitle()) +
+                                        "\".");
+            fileKeys.emplace_back(GetFileCacheKey(*file, element->GetName(), offsets[i + 1] - offsets[i]));
+            fileRanges.emplace_back(offsets[i], offsets[i + 1]);
+         }
+      } else {
+         auto file = fTree->GetCurrentFile();
+         if (!file)
+            throw std::runtime_error("RunGraphsCached: only the results of trees read from files can be cached.");
+         // the path of the tree inside of its file
+         std::string treeName = fTree->GetDirectory()->GetPath();
+         treeName = treeName.substr(treeName.find(':') + 1) + "/" + fTree->GetName();
+         fileKeys.emplace_back(GetFileCacheKey(*file, treeName, fTree->GetEntries()));
+         fileRanges.emplace_back(0ull, fTree->GetEntries());
+      }
+   }
+   if (fileKeys.empty()) {
+      Run();
+      return;
+   }
+
+   gSystem->mkdir(cacheDir.c_str(), kTRUE);
+   auto getCachePath = [&cacheDir, &fileKeys](unsigned int fileIdx) {
+      return cacheDir + "/" + fileKeys[fileIdx] + ".root";
+   };
+   std::vector<unsigned int> filesToProcess;
+   for (unsigned int i = 0; i < fileKeys.size(); ++i) {
+      if (!HasCachedResults(getCachePath(i), actionKeys))
+         filesToProcess.emplace_back(i);
+   }
+   R__LOG_INFO(RDFLogChannel()) << "RunGraphsCached: processing " << filesToProcess.size() << " of "
+                                << fileKeys.size() << " files, the partial results of the others are read from "
+                                << cacheDir;
+
+   // the reply of a worker is the index of its file and an error message, empty on success
+   auto runFile = [&](unsigned int fileIdx) {
+      std::vector<std::string> reply{std::to_string(fileIdx), ""};
+      try {
+         fHasPartitionRange = true;
+         fPartitionRange = fileRanges[fileIdx];
+         Run();
+         WriteCachedResults(getCachePath(fileIdx), actionKeys, actions);
+      } catch (const std::exception &e) {
+         reply[1] = e.what();
+      }
+      return reply;
+   };
+   // a worker can run the event loop only once: each batch of files is processed by new workers, one per file
+   for (std::size_t first = 0; first < filesToProcess.size(); first += nWorkers) {
+      const auto last = std::min(first + nWorkers, filesToProcess.size());
+      const std::vector<unsigned int> batch(filesToProcess.begin() + first, filesToProcess.begin() + last);
+      ROOT::TProcessExecutor pool(batch.size());
+      const auto replies = pool.Map(runFile, batch);
+      if (replies.size() != batch.size())
+         throw std::runtime_error("RunGraphsCached: " + std::to_string(batch.size() - replies.size()) +
+                                  " worker process(es) did not return their results.");
+      for (const auto &reply : replies) {
+         if (!reply[1].empty())
+            throw std::runtime_error("RunGraphsCached: processing file " + reply[0] + " of the dataset failed: " +
+                                     reply[1]);
+      }
+   }
+
+   // merge in file order, e.g. for the points of a TGraph to keep the entry order
+   auto clBase = TClass::GetClass<RMergeableValueBase>();
+   std::vector<std::unique_ptr<RMergeableValueBase>> merged(actions.size());
+   for (unsigned int j = 0; j < fileKeys.size(); ++j) {
+      TDirectory::TContext ctxt;
+      const auto path = getCachePath(j);
+      std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+      if (!file || file->IsZombie())
+         throw std::runtime_error("RunGraphsCached: cannot open the cache file \"" + path + "\".");
+      for (std::size_t i = 0; i < actions.size(); ++i) {
+         std::unique_ptr<RMergeableValueBase> mergeable(
+            static_cast<RMergeableValueBase *>(file->GetObjectChecked(actionKeys[i].c_str(), clBase)));
+         if (!mergeable)
+            throw std::runtime_error("RunGraphsCached: cannot read a partial result from the cache file \"" + path +
+                                     "\".");
+         if (merged[i])
+            merged[i]->MergeAny(*mergeable);
+         else
+            merged[i] = std::move(mergeable);
+      }
+   }
+   for (std::size_t i = 0; i < actions.size(); ++i)
+      merged[i]->CopyValueTo(results[i]);
+
+   // the actions ran in the worker processes, or in previous runs: finalizing them would overwrite the merged results
+   for (auto *action : actions)
+      action->SetHasRun();
+   fRunActions.insert(fRunActions.begin(), fBookedActions.begin(), fBookedActions.end());
+   fBookedActions.clear();
+   CleanUpNodes();
+   fNRuns++;
+#else
+   (void)cacheDir;
+   (void)nWorkers;
+   (void)results;
+   throw std::runtime_error("RunGraphsCached: cached event loops are not supported on this platform.");
+#endif
+}
+
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
 const ColumnNames_t &RLoopManager::GetDefaultColumnNames() const
 {
@@ -732,6 +1267,23 @@ TTree *RLoopManager::GetTree() const
    return fTree.get();
 }
 
+/// Return the entry list that selects the entries to process, or nullptr if all entries of the input TTree are processed
+TEntryList *RLoopManager::GetEntryList() const
+{
+   if (fEntryList)
+      return fEntryList.get();
+   return fTree ? fTree->GetEntryList() : nullptr;
+}
+
+/// Process only the entries of the input TTree in entryList, which must have global entry numbers (no sub-lists).
+/// It takes precedence over the entry list of the TTree itself.
+void RLoopManager::SetEntryList(std::unique_ptr<TEntryList> entryList)
+{
+   R__ASSERT(fTree != nullptr && "Entry lists can only be set on RDataFrames that read a TTree");
+   R__ASSERT(entryList->GetLists() == nullptr && "The entry list must contain global entry numbers");
+   fEntryList = std::move(entryList);
+}
+
 void RLoopManager::Book(RDFInternal::RActionBase *actionPtr)
 {
    fBookedActions.emplace_back(actionPtr);
@@ -864,3 +1416,18 @@ void RLoopManager::AddDataBlockCallback(std::function<void(unsigned int)> &&call
    if (callback)
       fDataBlockCallbacks.emplace_back(std::move(callback));
 }
+
+/// Start collecting the time spent in each node of the computation graph in the following event loops.
+/// The times of subsequent event loops are summed; calling this method again has no effect.
+void RLoopManager::EnableProgressReport(std::function<void(const ROOT::RDF::Experimental::RProgressInfo &)> callback,
+                                        double intervalSeconds, ULong64_t sampleEveryN)
+{
+   fProgressMonitor = std::make_shared<RDFInternal::RProgressMonitor>(std::move(callback), intervalSeconds,
+                                                                      sampleEveryN, fNSlots);
+}
+
+void RLoopManager::EnableProfiling()
+{
+   if (!fProfiler)
+      fProfiler = std::make_shared<RProfiler>(fNSlots);
+}
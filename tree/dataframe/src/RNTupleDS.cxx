@@ -25,6 +25,9 @@
 
 #include <TError.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -107,18 +110,42 @@ class RNTupleColumnReader : public ROOT::Detail::RDF::RColumnReaderBase {
    std::unique_ptr<RFieldBase> fField; ///< The field backing the RDF column
    RFieldValue fValue;                 ///< The memory location used to read from fField
    Long64_t fLastEntry;                ///< Last entry number that was read
+   /// If non-zero, the values of simple fields are read in blocks of up to that many consecutive entries
+   std::size_t fBulkSize;
+   /// Contiguous values of the entries [fBulkFirst, fBulkFirst + fBulkN); only used for simple fields in bulk mode
+   std::unique_ptr<unsigned char[]> fBulkBuffer;
+   Long64_t fBulkFirst = -1;
+   Long64_t fBulkN = 0;
+   /// The number of entries of the column, used to stop blocks at the end of the ntuple
+   NTupleSize_t fNEntries = 0;
+   RPageSource *fSource = nullptr;
+
+   /// Fills the bulk buffer starting from entry, in a single call to the field.  The block ends at the end of the
+   /// ntuple or at the end of the entry range of the page source, whichever comes first.
+   void ReadBulk(Long64_t entry)
+   {
+      NTupleSize_t end = std::min<NTupleSize_t>(entry + fBulkSize, fNEntries);
+      const auto &range = fSource->GetEntryRange();
+      if (range.fNEntries != kInvalidNTupleIndex)
+         end = std::min(end, range.fFirstEntry + range.fNEntries);
+      end = std::max<NTupleSize_t>(end, entry + 1);
+      auto bulkValue = fField->GenerateValue(fBulkBuffer.get());
+      fField->ReadV(static_cast<NTupleSize_t>(entry), end - entry, &bulkValue);
+      fBulkFirst = entry;
+      fBulkN = end - entry;
+   }
 
 public:
-   RNTupleColumnReader(std::unique_ptr<RFieldBase> f)
-      : fField(std::move(f)), fValue(fField->GenerateValue()), fLastEntry(-1)
+   RNTupleColumnReader(std::unique_ptr<RFieldBase> f, std::size_t bulkSize = 0)
+      : fField(std::move(f)), fValue(fField->GenerateValue()), fLastEntry(-1), fBulkSize(bulkSize)
    {
    }
    virtual ~RNTupleColumnReader() { fField->DestroyValue(fValue); }
 
    /// Column readers are created as prototype and then cloned for every slot
-   std::unique_ptr<RNTupleColumnReader> Clone()
+   std::unique_ptr<RNTupleColumnReader> Clone(std::size_t bulkSize)
    {
-      return std::make_unique<RNTupleColumnReader>(fField->Clone(fField->GetName()));
+      return std::make_unique<RNTupleColumnReader>(fField->Clone(fField->GetName()), bulkSize);
    }
 
    /// Connect the field and its subfields to the page source
@@ -127,10 +154,21 @@ public:
       fField->ConnectPageSource(source);
       for (auto &f : *fField)
          f.ConnectPageSource(source);
+      fSource = &source;
+      // Values of simple fields are trivially copyable, so that a block of them can be read in one go
+      if (fBulkSize > 0 && fField->IsSimple()) {
+         fNEntries = fField->GetNElements();
+         fBulkBuffer = std::make_unique<unsigned char[]>(fBulkSize * fField->GetValueSize());
+      }
    }
 
    void *GetImpl(Long64_t entry) final
    {
+      if (fBulkBuffer) {
+         if (entry < fBulkFirst || entry >= fBulkFirst + fBulkN)
+            ReadBulk(entry);
+         return fBulkBuffer.get() + (entry - fBulkFirst) * fField->GetValueSize();
+      }
       if (entry != fLastEntry) {
          fField->Read(entry, &fValue);
          fLastEntry = entry;
@@ -262,7 +300,7 @@ RNTupleDS::GetColumnReaders(unsigned int slot, std::string_view name, const std:
    // at this point we can assume that `name` will be found in fColumnNames, RDF is in charge validation
    // TODO(jblomer): check incoming type
    const auto index = std::distance(fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), name));
-   auto clone = fColumnReaderPrototypes[index]->Clone();
+   auto clone = fColumnReaderPrototypes[index]->Clone(fBulkSize);
    clone->Connect(*fSources[slot]);
    return clone;
 }
@@ -272,26 +310,67 @@ bool RNTupleDS::SetEntry(unsigned int, ULong64_t)
    return true;
 }
 
+void RNTupleDS::AddRangeFilter(std::string_view fieldName, double min, double max)
+{
+   const auto &descriptor = fSources[0]->GetDescriptor();
+   auto fieldId = descriptor.GetFieldZeroId();
+   std::string_view remainder = fieldName;
+   while (fieldId != kInvalidDescriptorId) {
+      const auto posDot = remainder.find('.');
+      fieldId = descriptor.FindFieldId(remainder.substr(0, posDot), fieldId);
+      if (posDot == std::string_view::npos)
+         break;
+      remainder = remainder.substr(posDot + 1);
+   }
+   if (fieldId == kInvalidDescriptorId)
+      throw RException(R__FAIL("no such field: " + std::string(fieldName)));
+   const auto columnId = descriptor.FindColumnId(fieldId, 0);
+   if (columnId == kInvalidDescriptorId)
+      throw RException(R__FAIL("field without columns: " + std::string(fieldName)));
+   fRangeFilters.push_back({columnId, min, max});
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
-   // TODO(jblomer): use cluster boundaries for the entry ranges
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
    if (fHasSeenAllRanges)
       return ranges;
+   fHasSeenAllRanges = true;
 
-   auto nEntries = fSources[0]->GetNEntries();
-   const auto chunkSize = nEntries / fNSlots;
-   const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-   for (auto i : ROOT::TSeqU(fNSlots)) {
-      start = end;
-      end += chunkSize;
-      ranges.emplace_back(start, end);
-      (void)i;
+   // The clusters that pass all range filters, in entry order
+   const auto &descriptor = fSources[0]->GetDescriptor();
+   std::vector<const RClusterDescriptor *> clusters;
+   for (const auto &c : descriptor.GetClusterIterable()) {
+      if (c.GetNEntries() == 0)
+         continue;
+      bool isSelected = std::all_of(fRangeFilters.begin(), fRangeFilters.end(), [&c](const RRangeFilter &f) {
+         return c.MayContainValues(f.fColumnId, f.fMin, f.fMax);
+      });
+      if (isSelected)
+         clusters.emplace_back(&c);
    }
-   ranges.back().second += reminder;
-   fHasSeenAllRanges = true;
+   std::sort(clusters.begin(), clusters.end(),
+             [](const auto *a, const auto *b) { return a->GetFirstEntryIndex() < b->GetFirstEntryIndex(); });
+
+   // Every range comprises up to nClustersPerRange adjacent clusters
+   const std::size_t nRangesTarget = fNSlots * kTasksPerSlot;
+   const std::size_t nClustersPerRange = std::max<std::size_t>(1, (clusters.size() + nRangesTarget - 1) / nRangesTarget);
+   std::size_t nClustersInRange = 0;
+   for (const auto *c : clusters) {
+      const ULong64_t first = c->GetFirstEntryIndex();
+      const ULong64_t last = first + c->GetNEntries();
+      if (!ranges.empty() && ranges.back().second == first && nClustersInRange < nClustersPerRange) {
+         ranges.back().second = last;
+         nClustersInRange++;
+      } else {
+         ranges.emplace_back(first, last);
+         nClustersInRange = 1;
+      }
+   }
+
+   fRangeEnds.clear();
+   for (const auto &r : ranges)
+      fRangeEnds[r.first] = r.second;
    return ranges;
 }
 
@@ -311,6 +390,19 @@ void RNTupleDS::Initialise()
    fHasSeenAllRanges = false;
 }
 
+void RNTupleDS::InitSlot(unsigned int slot, ULong64_t firstEntry)
+{
+   // In the sequential event loop, the slot processes all the ranges
+   if (fNSlots == 1)
+      return;
+   auto itr = fRangeEnds.find(firstEntry);
+   if (itr == fRangeEnds.end()) {
+      fSources[slot]->SetEntryRange(Detail::RPageSource::REntryRange());
+      return;
+   }
+   fSources[slot]->SetEntryRange({firstEntry, itr->second - firstEntry});
+}
+
 void RNTupleDS::Finalise() {}
 
 void RNTupleDS::SetNSlots(unsigned int nSlots)
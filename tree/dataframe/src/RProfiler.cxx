@@ -0,0 +1,135 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+
+#include <algorithm>
+#include <cstdio> // snprintf
+#include <iomanip>
+#include <utility>
+
+using ROOT::Internal::RDF::RProfiler;
+using ROOT::RDF::Experimental::RNodeProfile;
+using ROOT::RDF::Experimental::RProfileReport;
+
+namespace {
+std::string KindToString(RProfiler::ENodeKind kind)
+{
+   switch (kind) {
+   case RProfiler::ENodeKind::kFilter: return "Filter";
+   case RProfiler::ENodeKind::kDefine: return "Define";
+   case RProfiler::ENodeKind::kAction: return "Action";
+   case RProfiler::ENodeKind::kColumn: return "Column";
+   }
+   return "";
+}
+
+double ToSeconds(RProfiler::Clock_t::duration d)
+{
+   return std::chrono::duration<double>(d).count();
+}
+} // anonymous namespace
+
+RProfileReport::RProfileReport(std::vector<RNodeProfile> nodeProfiles) : fNodeProfiles(std::move(nodeProfiles))
+{
+   std::stable_sort(fNodeProfiles.begin(), fNodeProfiles.end(),
+                    [](const RNodeProfile &a, const RNodeProfile &b) { return a.fTime > b.fTime; });
+}
+
+void RProfileReport::Print(std::ostream &os) const
+{
+   double totalTime = 0.;
+   for (const auto &p : fNodeProfiles)
+      totalTime += p.fTime;
+
+   const auto flags = os.flags();
+   os << std::left << std::setw(8) << "Kind" << std::setw(32) << "Name" << std::right << std::setw(14) << "Time [ms]"
+      << std::setw(10) << "Fraction" << std::setw(14) << "Calls" << std::setw(14) << "ns/call" << '\n';
+   for (const auto &p : fNodeProfiles) {
+      const auto fraction = totalTime > 0. ? 100. * p.fTime / totalTime : 0.;
+      const auto perCall = p.fNCalls > 0 ? 1e9 * p.fTime / p.fNCalls : 0.;
+      os << std::left << std::setw(8) << p.fKind << std::setw(32) << p.fName << std::right << std::fixed
+         << std::setprecision(3) << std::setw(14) << 1e3 * p.fTime << std::setprecision(1) << std::setw(9) << fraction
+         << '%' << std::setw(14) << p.fNCalls << std::setw(14) << perCall << '\n';
+   }
+   os.flags(flags);
+}
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RProfiler::RProfiler(unsigned int nSlots) : fSlots(nSlots) {}
+
+unsigned int RProfiler::RegisterNode(ENodeKind kind, const std::string &name, const void *node)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto it = fNodeIDs.find(node);
+   if (it != fNodeIDs.end())
+      return it->second;
+   const auto id = static_cast<unsigned int>(fNodes.size());
+   fNodes.push_back({kind, name});
+   fNodeIDs[node] = id;
+   return id;
+}
+
+unsigned int RProfiler::RegisterColumn(const std::string &name)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto it = fColumnIDs.find(name);
+   if (it != fColumnIDs.end())
+      return it->second;
+   const auto id = static_cast<unsigned int>(fNodes.size());
+   fNodes.push_back({ENodeKind::kColumn, name});
+   fColumnIDs[name] = id;
+   return id;
+}
+
+double RProfiler::GetTime(unsigned int id) const
+{
+   Clock_t::duration time{0};
+   for (const auto &slot : fSlots)
+      if (id < slot.fSelfTime.size())
+         time += slot.fSelfTime[id];
+   return ToSeconds(time);
+}
+
+ROOT::RDF::Experimental::RProfileReport RProfiler::GetReport() const
+{
+   std::vector<RNodeProfile> profiles(fNodes.size());
+   for (auto id = 0u; id < fNodes.size(); ++id) {
+      auto &p = profiles[id];
+      p.fKind = KindToString(fNodes[id].fKind);
+      p.fName = fNodes[id].fName;
+      p.fTimePerSlot.resize(fSlots.size(), 0.);
+      for (auto slot = 0u; slot < fSlots.size(); ++slot) {
+         const auto &counters = fSlots[slot];
+         if (id >= counters.fSelfTime.size())
+            continue;
+         p.fTimePerSlot[slot] = ToSeconds(counters.fSelfTime[id]);
+         p.fTime += p.fTimePerSlot[slot];
+         p.fNCalls += counters.fNCalls[id];
+      }
+   }
+   return RProfileReport(std::move(profiles));
+}
+
+std::string GetProfileLabel(const RProfiler *profiler, unsigned int id)
+{
+   if (!profiler)
+      return "";
+   char buf[64];
+   snprintf(buf, sizeof(buf), "\n%.3f ms", 1e3 * profiler->GetTime(id));
+   return buf;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
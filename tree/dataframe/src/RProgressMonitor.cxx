@@ -0,0 +1,90 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProgressMonitor.hxx"
+#include "TFile.h" // GetFileBytesRead
+
+#include <algorithm>
+#include <stdexcept>
+
+using ROOT::Internal::RDF::RProgressMonitor;
+using ROOT::RDF::Experimental::RProgressInfo;
+
+RProgressMonitor::RProgressMonitor(Callback_t callback, double intervalSeconds, ULong64_t sampleEveryN,
+                                   unsigned int nSlots)
+   : fCallback(std::move(callback)),
+     fInterval(std::chrono::duration_cast<Clock_t::duration>(std::chrono::duration<double>(intervalSeconds))),
+     fSampleEveryN(sampleEveryN), fSlots(nSlots)
+{
+   if (!fCallback)
+      throw std::invalid_argument("EnableProgressReport: the callback must not be empty.");
+   if (intervalSeconds < 0.)
+      throw std::invalid_argument("EnableProgressReport: the interval between reports must not be negative.");
+   if (fSampleEveryN == 0)
+      throw std::invalid_argument("EnableProgressReport: entries must be sampled at least every 1 entry.");
+}
+
+void RProgressMonitor::Start(Long64_t nEntriesTotal)
+{
+   for (auto &counter : fSlots) {
+      counter.fNEntries = 0ull;
+      counter.fNPublished = 0ull;
+   }
+   fNEntriesTotal = nEntriesTotal;
+   fStartBytesRead = TFile::GetFileBytesRead();
+   fStart = Clock_t::now();
+   fNextReport = fInterval.count();
+}
+
+void RProgressMonitor::Stop()
+{
+   // at the end of the event loop all counts are exact
+   for (auto &counter : fSlots)
+      counter.fNPublished = counter.fNEntries;
+   const auto info = MakeInfo(/*isDone=*/true);
+   std::lock_guard<std::mutex> lock(fCallbackMutex);
+   fCallback(info);
+}
+
+void RProgressMonitor::Report(Clock_t::time_point now)
+{
+   std::unique_lock<std::mutex> lock(fCallbackMutex, std::try_to_lock);
+   if (!lock.owns_lock())
+      return; // another slot is reporting
+   const auto elapsed = (now - fStart).count();
+   if (elapsed < fNextReport.load(std::memory_order_relaxed))
+      return; // another slot has just reported
+   fNextReport.store(elapsed + fInterval.count(), std::memory_order_relaxed);
+   fCallback(MakeInfo(/*isDone=*/false));
+}
+
+RProgressInfo RProgressMonitor::MakeInfo(bool isDone) const
+{
+   RProgressInfo info;
+   info.fNEntriesTotal = fNEntriesTotal;
+   info.fBytesRead = TFile::GetFileBytesRead() - fStartBytesRead;
+   info.fElapsed = std::chrono::duration<double>(Clock_t::now() - fStart).count();
+   info.fIsDone = isDone;
+   for (const auto &counter : fSlots) {
+      const auto nEntries = counter.fNPublished.load(std::memory_order_relaxed);
+      info.fNEntries += nEntries;
+      info.fNEntriesPerSlot.emplace_back(nEntries);
+      info.fEntriesPerSecondPerSlot.emplace_back(info.fElapsed > 0. ? nEntries / info.fElapsed : 0.);
+   }
+   if (info.fElapsed > 0.) {
+      info.fEntriesPerSecond = info.fNEntries / info.fElapsed;
+      info.fMBPerSecond = info.fBytesRead / info.fElapsed * 1e-6;
+   }
+   if (isDone)
+      info.fRemaining = 0.;
+   else if (fNEntriesTotal >= 0 && info.fEntriesPerSecond > 0.)
+      info.fRemaining = std::max(0., (fNEntriesTotal - static_cast<double>(info.fNEntries)) / info.fEntriesPerSecond);
+   return info;
+}
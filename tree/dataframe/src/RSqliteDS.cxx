@@ -337,7 +337,7 @@ struct RSqliteDSDataSet {
 }
 
 RSqliteDS::Value_t::Value_t(RSqliteDS::ETypes type)
-   : fType(type), fIsActive(false), fInteger(0), fReal(0.0), fText(), fBlob(), fNull(nullptr)
+   : fType(type), fInteger(0), fReal(0.0), fText(), fBlob(), fNull(nullptr)
 {
    switch (type) {
    case ETypes::kInteger: fPtr = &fInteger; break;
@@ -350,6 +350,7 @@ RSqliteDS::Value_t::Value_t(RSqliteDS::ETypes type)
 }
 
 constexpr char const *RSqliteDS::fgTypeNames[];
+constexpr ULong64_t RSqliteDS::fgRowsPerSlot;
 
 ////////////////////////////////////////////////////////////////////////////
 /// \brief Build the dataframe
@@ -358,7 +359,7 @@ constexpr char const *RSqliteDS::fgTypeNames[];
 ///
 /// The constructor opens the sqlite file, prepares the query engine and determines the column names and types.
 RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
-   : fDataSet(std::make_unique<Internal::RSqliteDSDataSet>()), fNSlots(0), fNRow(0)
+   : fDataSet(std::make_unique<Internal::RSqliteDSDataSet>()), fNSlots(0), fNRow(0), fBatchBegin(0), fIsDone(false)
 {
    static bool hasSqliteVfs = RegisterSqliteVfs();
    if (!hasSqliteVfs)
@@ -380,7 +381,6 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
    if ((retval != SQLITE_ROW) && (retval != SQLITE_DONE))
       SqliteError(retval);
 
-   fValues.reserve(colCount);
    for (int i = 0; i < colCount; ++i) {
       fColumnNames.emplace_back(sqlite3_column_name(fDataSet->fQuery, i));
       int type = SQLITE_NULL;
@@ -406,30 +406,71 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
       }
 
       switch (type) {
-      case SQLITE_INTEGER:
-         fColumnTypes.push_back(ETypes::kInteger);
-         fValues.emplace_back(ETypes::kInteger);
-         break;
-      case SQLITE_FLOAT:
-         fColumnTypes.push_back(ETypes::kReal);
-         fValues.emplace_back(ETypes::kReal);
-         break;
-      case SQLITE_TEXT:
-         fColumnTypes.push_back(ETypes::kText);
-         fValues.emplace_back(ETypes::kText);
-         break;
-      case SQLITE_BLOB:
-         fColumnTypes.push_back(ETypes::kBlob);
-         fValues.emplace_back(ETypes::kBlob);
-         break;
+      case SQLITE_INTEGER: fColumnTypes.push_back(ETypes::kInteger); break;
+      case SQLITE_FLOAT: fColumnTypes.push_back(ETypes::kReal); break;
+      case SQLITE_TEXT: fColumnTypes.push_back(ETypes::kText); break;
+      case SQLITE_BLOB: fColumnTypes.push_back(ETypes::kBlob); break;
       case SQLITE_NULL:
          // TODO: Null values in first rows are not well handled
          fColumnTypes.push_back(ETypes::kNull);
-         fValues.emplace_back(ETypes::kNull);
          break;
       default: throw std::runtime_error("Unhandled data type");
       }
    }
+   fIsActive.resize(colCount, false);
+   fBuffers.resize(colCount);
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Creates the values of the current entry of each slot. Value_t objects point to themselves, so they are constructed
+/// in place and never copied.
+void RSqliteDS::MakeValues()
+{
+   fValues.clear();
+   fValues.resize(fNSlots);
+   for (auto &slotValues : fValues) {
+      slotValues.reserve(fColumnTypes.size());
+      for (auto type : fColumnTypes)
+         slotValues.emplace_back(type);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Copies the active columns of the current row of the result set into the buffers, at position `row`.
+void RSqliteDS::FetchRow(std::size_t row)
+{
+   const auto nColumns = fColumnTypes.size();
+   for (unsigned i = 0; i < nColumns; ++i) {
+      if (!fIsActive[i])
+         continue;
+
+      auto &buffer = fBuffers[i];
+      int nbytes;
+      switch (fColumnTypes[i]) {
+      case ETypes::kInteger: buffer.fIntegers[row] = sqlite3_column_int64(fDataSet->fQuery, i); break;
+      case ETypes::kReal: buffer.fReals[row] = sqlite3_column_double(fDataSet->fQuery, i); break;
+      case ETypes::kText:
+         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
+         if (nbytes == 0) {
+            buffer.fTexts[row].clear();
+         } else {
+            buffer.fTexts[row].assign(reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i)),
+                                      nbytes);
+         }
+         break;
+      case ETypes::kBlob: {
+         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
+         auto &blob = buffer.fBlobs[row];
+         blob.resize(nbytes);
+         if (nbytes > 0) {
+            std::memcpy(blob.data(), sqlite3_column_blob(fDataSet->fQuery, i), nbytes);
+         }
+         break;
+      }
+      case ETypes::kNull: break;
+      default: throw std::runtime_error("Unhandled column type");
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -470,28 +511,56 @@ RDataSource::Record_t RSqliteDS::GetColumnReadersImpl(std::string_view name, con
       throw std::runtime_error(errmsg);
    }
 
-   fValues[index].fIsActive = true;
-   return std::vector<void *>{fNSlots, &fValues[index].fPtr};
+   fIsActive[index] = true;
+   std::vector<void *> ret(fNSlots);
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      ret[slot] = &fValues[slot][index].fPtr;
+   return ret;
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Returns a range of size 1 as long as more rows are available in the SQL result set.
-/// This inherently serialized the RDF independent of the number of slots.
+/// Fetches the next batch of rows of the SQL result set and returns one entry range per slot over them, or an empty
+/// vector once all rows have been fetched. Fetching is sequential, the batch can then be processed in parallel.
 std::vector<std::pair<ULong64_t, ULong64_t>> RSqliteDS::GetEntryRanges()
 {
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   int retval = sqlite3_step(fDataSet->fQuery);
-   switch (retval) {
-   case SQLITE_DONE: return entryRanges;
-   case SQLITE_ROW:
-      entryRanges.emplace_back(fNRow, fNRow + 1);
-      fNRow++;
-      return entryRanges;
-   default:
-      SqliteError(retval);
-      // Never here
-      abort();
+   if (fIsDone)
+      return entryRanges; // stepping again would restart the query
+
+   const auto nSlots = std::max(fNSlots, 1u);
+   const auto batchSize = fgRowsPerSlot * nSlots;
+   for (unsigned i = 0; i < fColumnTypes.size(); ++i) {
+      if (!fIsActive[i])
+         continue;
+      auto &buffer = fBuffers[i];
+      switch (fColumnTypes[i]) {
+      case ETypes::kInteger: buffer.fIntegers.resize(batchSize); break;
+      case ETypes::kReal: buffer.fReals.resize(batchSize); break;
+      case ETypes::kText: buffer.fTexts.resize(batchSize); break;
+      case ETypes::kBlob: buffer.fBlobs.resize(batchSize); break;
+      default: break;
+      }
+   }
+
+   ULong64_t nRows = 0;
+   while (nRows < batchSize) {
+      int retval = sqlite3_step(fDataSet->fQuery);
+      if (retval == SQLITE_DONE) {
+         fIsDone = true;
+         break;
+      }
+      if (retval != SQLITE_ROW)
+         SqliteError(retval);
+      FetchRow(nRows);
+      ++nRows;
    }
+
+   fBatchBegin = fNRow;
+   fNRow += nRows;
+   const auto rowsPerRange = (nRows + nSlots - 1) / nSlots;
+   for (auto begin = fBatchBegin; begin < fNRow; begin += rowsPerRange)
+      entryRanges.emplace_back(begin, std::min(begin + rowsPerRange, fNRow));
+   return entryRanges;
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -520,6 +589,8 @@ bool RSqliteDS::HasColumn(std::string_view colName) const
 void RSqliteDS::Initialise()
 {
    fNRow = 0;
+   fBatchBegin = 0;
+   fIsDone = false;
    int retval = sqlite3_reset(fDataSet->fQuery);
    if (retval != SQLITE_OK)
       throw std::runtime_error("SQlite error, reset");
@@ -541,34 +612,22 @@ RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Stores the result of the current active sqlite query row as a C++ value.
-bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
+/// Stores the values of the given row of the current batch as the C++ values of the slot.
+bool RSqliteDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   R__ASSERT(entry + 1 == fNRow);
-   unsigned N = fValues.size();
-   for (unsigned i = 0; i < N; ++i) {
-      if (!fValues[i].fIsActive)
+   R__ASSERT(entry >= fBatchBegin && entry < fNRow);
+   const auto row = entry - fBatchBegin;
+   auto &values = fValues[slot];
+   const auto nColumns = values.size();
+   for (unsigned i = 0; i < nColumns; ++i) {
+      if (!fIsActive[i])
          continue;
 
-      int nbytes;
-      switch (fValues[i].fType) {
-      case ETypes::kInteger: fValues[i].fInteger = sqlite3_column_int64(fDataSet->fQuery, i); break;
-      case ETypes::kReal: fValues[i].fReal = sqlite3_column_double(fDataSet->fQuery, i); break;
-      case ETypes::kText:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         if (nbytes == 0) {
-            fValues[i].fText = "";
-         } else {
-            fValues[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i));
-         }
-         break;
-      case ETypes::kBlob:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         fValues[i].fBlob.resize(nbytes);
-         if (nbytes > 0) {
-            std::memcpy(fValues[i].fBlob.data(), sqlite3_column_blob(fDataSet->fQuery, i), nbytes);
-         }
-         break;
+      switch (values[i].fType) {
+      case ETypes::kInteger: values[i].fInteger = fBuffers[i].fIntegers[row]; break;
+      case ETypes::kReal: values[i].fReal = fBuffers[i].fReals[row]; break;
+      case ETypes::kText: values[i].fText = fBuffers[i].fTexts[row]; break;
+      case ETypes::kBlob: values[i].fBlob = fBuffers[i].fBlobs[row]; break;
       case ETypes::kNull: break;
       default: throw std::runtime_error("Unhandled column type");
       }
@@ -577,14 +636,11 @@ bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-/// Almost a no-op, many slots can in fact reduce the performance due to thread synchronization.
+/// Creates the per-slot values. Each slot processes a different part of every batch of rows.
 void RSqliteDS::SetNSlots(unsigned int nSlots)
 {
-   if (nSlots > 1) {
-      ::Warning("SetNSlots", "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                             "Consider turning off IMT.");
-   }
    fNSlots = nSlots;
+   MakeValues();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RDF/RTreeColumnReader.hxx>
+#include <TBranch.h>
+#include <TDataType.h>
+#include <TLeaf.h>
+#include <TMath.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+
+ROOT::Internal::RDF::RTreeBulkReader::RTreeBulkReader(TTreeReader &r, const std::string &colName, EDataType type,
+                                                      Int_t valueSize)
+   : fReader(r), fBranchName(colName), fType(type), fValueSize(valueSize)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the branch in the tree currently read, return false if it cannot be read in bulk.
+bool ROOT::Internal::RDF::RTreeBulkReader::UpdateBranch()
+{
+   fBranch = nullptr;
+   fNEntries = 0;
+   auto chainOrTree = fReader.GetTree();
+   fTree = chainOrTree ? chainOrTree->GetTree() : nullptr;
+   fTreeNumber = chainOrTree ? chainOrTree->GetTreeNumber() : -1;
+   if (!fTree)
+      return false;
+
+   auto branch = fTree->GetBranch(fBranchName.c_str());
+   // friend branches have their own entry numbers
+   if (!branch || branch->GetTree() != fTree || branch->IsA() != TBranch::Class() || !branch->SupportsBulkRead())
+      return false;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || leaf->GetLenType() != fValueSize)
+      return false;
+   auto leafType = dynamic_cast<TDataType *>(TDictionary::GetDictionary(leaf->GetTypeName()));
+   if (!leafType || leafType->GetType() != fType)
+      return false;
+
+   fBranch = branch;
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the address of the value of the current entry, or nullptr if the branch cannot be read in bulk.
+void *ROOT::Internal::RDF::RTreeBulkReader::Get()
+{
+   auto chainOrTree = fReader.GetTree();
+   if (!chainOrTree)
+      return nullptr;
+   if (!fBranch || chainOrTree->GetTree() != fTree || chainOrTree->GetTreeNumber() != fTreeNumber) {
+      if (!UpdateBranch())
+         return nullptr;
+   }
+
+   const Long64_t entry = fTree->GetReadEntry();
+   if (entry < fFirstEntry || entry >= fFirstEntry + fNEntries) {
+      // bulk reads start at the first entry of a basket
+      const Int_t basket =
+         TMath::BinarySearch(Long64_t(fBranch->GetWriteBasket() + 1), fBranch->GetBasketEntry(), entry);
+      if (basket < 0 || entry >= fBranch->GetEntries())
+         return nullptr;
+      fFirstEntry = fBranch->GetBasketEntry()[basket];
+      fNEntries = fBranch->GetBulkRead().GetBulkEntries(fFirstEntry, fBuffer);
+      if (fNEntries <= 0 || entry >= fFirstEntry + fNEntries) {
+         fNEntries = 0;
+         return nullptr;
+      }
+   }
+
+   return fBuffer.GetCurrent() + (entry - fFirstEntry) * fValueSize;
+}
@@ -0,0 +1,74 @@
+// Author: Enrico Guiraud, Danilo Piparo CERN  10/2021
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RVariationBase.hxx"
+#include "ROOT/RDF/Utils.hxx"
+
+#include <stdexcept>
+
+using ROOT::Detail::RDF::RDefineBase;
+using ROOT::Detail::RDF::RVariationBase;
+namespace RDFInternal = ROOT::Internal::RDF;
+
+namespace {
+
+/// Exposes one of the values of a RVariationBase as a defined column that replaces the nominal column in the nodes
+/// that process that variation.
+class RVariedValue final : public RDefineBase {
+   RVariationBase &fVariation;
+   const std::size_t fVarIdx;
+
+public:
+   RVariedValue(RVariationBase &variation, std::size_t varIdx, const std::map<std::string, std::vector<void *>> &DSValuePtrs,
+                ROOT::RDF::RDataSource *ds)
+      : RDefineBase(variation.GetColumnName(), variation.GetTypeName(), 0u, RDFInternal::RBookedDefines(),
+                    DSValuePtrs, ds),
+        fVariation(variation), fVarIdx(varIdx)
+   {
+   }
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final { fVariation.InitSlot(r, slot); }
+   void *GetValuePtr(unsigned int slot) final { return fVariation.GetValuePtr(slot, fVarIdx); }
+   const std::type_info &GetTypeId() const final { return fVariation.GetTypeId(); }
+   void Update(unsigned int slot, Long64_t entry) final { fVariation.Update(slot, entry); }
+   void FinaliseSlot(unsigned int slot) final { fVariation.FinaliseSlot(slot); }
+   void AddDatasetColumns(std::set<std::string> &columns) const final { fVariation.AddDatasetColumns(columns); }
+   // varied values are only used by the nodes that process a variation: they are not varied further
+   void AddVariations(RDFInternal::RVariationTags_t &) const final {}
+   std::shared_ptr<RDefineBase> MakeVariedDefine(const std::string &, std::size_t) final
+   {
+      throw std::logic_error("Varied values cannot be varied further.");
+   }
+};
+
+} // anonymous namespace
+
+RVariationBase::RVariationBase(std::string_view colName, std::string_view variationName,
+                               const std::vector<std::string> &tags, std::string_view type, unsigned int nSlots,
+                               const RDFInternal::RBookedDefines &defines,
+                               const std::map<std::string, std::vector<void *>> &DSValuePtrs,
+                               ROOT::RDF::RDataSource *ds)
+   : fColumnName(colName), fVariationName(variationName), fTags(tags), fType(type), fNSlots(nSlots),
+     fLastCheckedEntry(fNSlots * RDFInternal::CacheLineStep<Long64_t>(), -1), fDefines(defines),
+     fIsInitialized(nSlots, false), fDSValuePtrs(DSValuePtrs), fDataSource(ds), fVariedValues(fTags.size())
+{
+}
+
+// pin vtable. Work around cling JIT issue.
+RVariationBase::~RVariationBase() {}
+
+std::shared_ptr<RDefineBase> RVariationBase::GetVariedValue(std::size_t varIdx)
+{
+   auto &variedValue = fVariedValues.at(varIdx);
+   if (!variedValue)
+      variedValue = std::make_shared<RVariedValue>(*this, varIdx, fDSValuePtrs, fDataSource);
+   return variedValue;
+}
@@ -346,3 +346,25 @@ TEST(Cache, Alias)
    auto df4 = df3.Cache({"y"});
    EXPECT_EQ(df4.Sum("y").GetValue(), 3u);
 }
+
+TEST(Cache, OnDisk)
+{
+   ROOT::RDataFrame df(10);
+   auto d = df.Define("i", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Define("x", "i * 0.5");
+
+   // the temporary file is not exposed, check that the cached values can be re-read
+   auto cachedTmp = d.Filter("i % 2 == 0").CacheOnDisk<int, double>({"i", "x"});
+   EXPECT_EQ(*cachedTmp.Count(), 5ull);
+   EXPECT_EQ(*cachedTmp.Sum<int>("i"), 20);
+   EXPECT_DOUBLE_EQ(*cachedTmp.Max<double>("x"), 4.);
+
+   const auto fileName = "dataframe_cache_ondisk.root";
+   {
+      auto cached = d.CacheOnDisk({"x"}, fileName);
+      EXPECT_EQ(cached.GetColumnNames(), std::vector<std::string>{"x"});
+      EXPECT_DOUBLE_EQ(*cached.Sum<double>("x"), 22.5);
+   }
+   // files with an explicit name are kept
+   EXPECT_FALSE(gSystem->AccessPathName(fileName));
+   gSystem->Unlink(fileName);
+}
@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm> // std::sort
+#include <stdexcept>
 #include <vector>
 
 // Write to disk one file for each filename, with TTree "t" with nEntries of branch "e" with increasing values
@@ -104,6 +105,51 @@ void TestChainWithEntryList(bool isMT = false)
    gSystem->Unlink(file2);
 }
 
+void TestMakeEntryListDataFrame(bool isMT = false)
+{
+   const auto nEntries = 10;
+   const auto treename = "t";
+   const auto file1 = "rdfmakeentrylist1.root";
+   const auto file2 = "rdfmakeentrylist2.root";
+   MakeInputFile(file1, nEntries);
+   MakeInputFile(file2, nEntries * 2, /*valueStart=*/nEntries);
+
+   RMTRAII gomt(isMT);
+
+   TChain c(treename);
+   c.Add(file1);
+   c.Add(file2);
+
+   // global entry numbers, in any order and possibly repeated
+   const std::vector<Long64_t> picked{2 * nEntries, 3, nEntries + 1, 3};
+   auto df = ROOT::RDF::MakeEntryListDataFrame(c, picked);
+   auto entries = df.Take<int>("e").GetValue();
+   std::sort(entries.begin(), entries.end()); // could be out of order in MT runs
+   EXPECT_EQ(entries, std::vector<int>({3, nEntries + 1, 2 * nEntries}));
+   EXPECT_EQ(*df.Count(), 3ull);
+
+   // sub-lists with local entry numbers are converted to global entry numbers
+   TEntryList elist1("e", "e", treename, file1);
+   elist1.Enter(nEntries - 1);
+   TEntryList elist2("e", "e", treename, file2);
+   elist2.Enter(0);
+   elist2.Enter(2 * nEntries - 1);
+   TEntryList elists;
+   elists.Add(&elist1);
+   elists.Add(&elist2);
+   entries = ROOT::RDF::MakeEntryListDataFrame(c, elists).Take<int>("e").GetValue();
+   std::sort(entries.begin(), entries.end());
+   EXPECT_EQ(entries, std::vector<int>({nEntries - 1, nEntries, 3 * nEntries - 1}));
+   // the chain itself is left untouched
+   EXPECT_EQ(c.GetEntryList(), nullptr);
+   EXPECT_EQ(*ROOT::RDataFrame(c).Count(), 3ull * nEntries);
+
+   EXPECT_THROW(ROOT::RDF::MakeEntryListDataFrame(c, std::vector<Long64_t>{-1}), std::invalid_argument);
+
+   gSystem->Unlink(file1);
+   gSystem->Unlink(file2);
+}
+
 TEST(RDFEntryList, Chain)
 {
    TestChainWithEntryList();
@@ -114,6 +160,11 @@ TEST(RDFEntryList, Tree)
    TestTreeWithEntryList();
 }
 
+TEST(RDFEntryList, MakeEntryListDataFrame)
+{
+   TestMakeEntryListDataFrame();
+}
+
 #ifdef R__USE_IMT
 TEST(RDFEntryList, ChainMT)
 {
@@ -124,4 +175,9 @@ TEST(RDFEntryList, TreeMT)
 {
    TestTreeWithEntryList(true);
 }
+
+TEST(RDFEntryList, MakeEntryListDataFrameMT)
+{
+   TestMakeEntryListDataFrame(true);
+}
 #endif
@@ -4,13 +4,22 @@
 #include <ROOT/RVec.hxx>
 #include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RResultHandle.hxx>
+#include <TFile.h>
+#include <TInterpreter.h>
 #include <TSystem.h>
+#include <TTree.h>
+#include <TTreeCache.h>
 #include <RConfigure.h>
 
 #include <algorithm>
 #include <deque>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
 #include <vector>
 #include <string>
+#include <tuple>
 
 #include "gtest/gtest.h"
 using namespace ROOT;
@@ -406,6 +415,39 @@ TEST(RunGraphs, RunGraphsWithDisabledIMT)
    EXPECT_EQ(*r2, 3u);
 }
 
+TEST(RunGraphs, OnGraphDone)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+#endif // R__USE_IMT
+
+   ROOT::RDataFrame df1(3);
+   auto r1 = df1.Count();
+   auto r2 = df1.Sum<ULong64_t>("rdfentry_");
+   ROOT::RDataFrame df2(5);
+   auto r3 = df2.Count();
+   ROOT::RDataFrame df3(7);
+   auto r4 = df3.Define("x", "rdfentry_ * 2").Sum<ULong64_t>("x");
+
+   std::vector<unsigned int> doneGraphs;
+   std::vector<unsigned int> nDones;
+   ROOT::RDF::RunGraphs({r1, r3, r2, r4}, [&](unsigned int graphIdx, unsigned int nDone) {
+      doneGraphs.emplace_back(graphIdx);
+      nDones.emplace_back(nDone);
+   });
+
+   std::sort(doneGraphs.begin(), doneGraphs.end());
+   EXPECT_EQ(doneGraphs, std::vector<unsigned int>({0u, 1u, 2u}));
+   EXPECT_EQ(nDones, std::vector<unsigned int>({1u, 2u, 3u}));
+   EXPECT_EQ(*r1, 3u);
+   EXPECT_EQ(*r2, 3u);
+   EXPECT_EQ(*r3, 5u);
+   EXPECT_EQ(*r4, 42u);
+   EXPECT_EQ(df1.GetNRuns(), 1u);
+   EXPECT_EQ(df2.GetNRuns(), 1u);
+   EXPECT_EQ(df3.GetNRuns(), 1u);
+}
+
 TEST(RunGraphs, EmptyListOfHandles)
 {
 #ifdef R__USE_IMT
@@ -432,3 +474,308 @@ TEST(RunGraphs, AlreadyRun)
    ROOT_EXPECT_WARNING(ROOT::RDF::RunGraphs({r1, r2, r3, r4}), "RunGraphs",
                        "Got 4 handles from which 2 link to results which are already ready.");
 }
+
+#ifndef R__WIN32
+TEST(RunGraphs, RunGraphsMP)
+{
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+
+   ROOT::RDataFrame df(100);
+   auto dfx = df.Define("x", "double(rdfentry_)");
+   auto count = dfx.Filter([](double x) { return x >= 50; }, {"x"}).Count();
+   auto sum = dfx.Sum<double>("x");
+   auto mean = dfx.Mean<double>("x");
+   auto max = dfx.Max<double>("x");
+   auto histo = dfx.Histo1D<double>({"h", "h", 10, 0, 100}, "x");
+
+   ROOT::RDF::Experimental::RunGraphsMP({count, sum, mean, max, histo}, 3);
+
+   EXPECT_EQ(df.GetNRuns(), 1u);
+   EXPECT_TRUE(count.IsReady());
+   EXPECT_TRUE(histo.IsReady());
+   EXPECT_EQ(50u, *count);
+   EXPECT_DOUBLE_EQ(99. * 100. / 2., *sum);
+   EXPECT_DOUBLE_EQ(49.5, *mean);
+   EXPECT_DOUBLE_EQ(99., *max);
+   EXPECT_EQ(100, histo->GetEntries());
+   EXPECT_EQ(10, histo->GetBinContent(1));
+}
+
+TEST(RunGraphs, RunGraphsMPMissingHandle)
+{
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+
+   ROOT::RDataFrame df(10);
+   auto count = df.Count();
+   auto sum = df.Sum<ULong64_t>("rdfentry_");
+   EXPECT_THROW(ROOT::RDF::Experimental::RunGraphsMP({count}, 2), std::runtime_error);
+   EXPECT_FALSE(count.IsReady());
+   EXPECT_EQ(45u, *sum);
+}
+
+// Return the inode of every file of the directory, which changes when a cache file is rewritten
+static std::map<std::string, Long_t> GetCacheFiles(const std::string &dir)
+{
+   std::map<std::string, Long_t> files;
+   void *dirp = gSystem->OpenDirectory(dir.c_str());
+   while (const char *entry = gSystem->GetDirEntry(dirp)) {
+      FileStat_t stat;
+      if (entry[0] != '.' && gSystem->GetPathInfo((dir + "/" + entry).c_str(), stat) == 0)
+         files[entry] = stat.fIno;
+   }
+   gSystem->FreeDirectory(dirp);
+   return files;
+}
+
+TEST(RunGraphs, RunGraphsCached)
+{
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+
+   const std::string cacheDir = "RunGraphsCached_cache";
+   gSystem->Exec(("rm -rf " + cacheDir).c_str());
+   std::vector<std::string> fileNames;
+   for (int i = 0; i < 4; ++i) {
+      fileNames.emplace_back("RunGraphsCached_" + std::to_string(i) + ".root");
+      ROOT::RDataFrame(10)
+         .Define("x", "double(rdfentry_ + " + std::to_string(10 * i) + ")")
+         .Snapshot<double>("t", fileNames.back(), {"x"});
+   }
+
+   auto run = [&](std::size_t nFiles, const std::string &cut) {
+      ROOT::RDataFrame df("t", std::vector<std::string>(fileNames.begin(), fileNames.begin() + nFiles));
+      auto sel = df.Define("y", "2 * x").Filter(cut);
+      auto count = sel.Count();
+      auto sum = sel.Sum<double>("y");
+      auto histo = sel.Histo1D<double>({"h", "h", 8, 0, 80}, "x");
+      ROOT::RDF::Experimental::RunGraphsCached({count, sum, histo}, cacheDir, 2);
+      EXPECT_EQ(1u, df.GetNRuns());
+      return std::make_tuple(*count, *sum, histo->GetBinContent(2), histo->GetEntries());
+   };
+
+   // x in [0, 30), y > 10 for x > 5
+   EXPECT_EQ(std::make_tuple(24ull, 2. * (435. - 15.), 10., 24.), run(3, "y > 10"));
+   const auto firstFiles = GetCacheFiles(cacheDir);
+   EXPECT_EQ(3u, firstFiles.size());
+
+   // the same graph reads the partial results of the three files from the cache
+   EXPECT_EQ(std::make_tuple(24ull, 2. * (435. - 15.), 10., 24.), run(3, "y > 10"));
+   EXPECT_EQ(firstFiles, GetCacheFiles(cacheDir));
+
+   // a new file is processed alone
+   EXPECT_EQ(std::make_tuple(34ull, 2. * (780. - 15.), 10., 34.), run(4, "y > 10"));
+   auto files = GetCacheFiles(cacheDir);
+   EXPECT_EQ(4u, files.size());
+   for (const auto &file : firstFiles)
+      EXPECT_EQ(file.second, files[file.first]);
+
+   // a different selection processes all the files again
+   EXPECT_EQ(std::make_tuple(20ull, 2. * (435. - 45.), 10., 20.), run(4, "y >= 20 && y < 60"));
+   for (const auto &file : GetCacheFiles(cacheDir))
+      EXPECT_NE(files[file.first], file.second);
+
+   gSystem->Exec(("rm -rf " + cacheDir).c_str());
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+#endif // R__WIN32
+
+TEST(RDFHelpers, Profiling)
+{
+   ROOT::RDataFrame df(100);
+   EXPECT_THROW(ROOT::RDF::Experimental::GetProfileReport(df), std::runtime_error);
+   ROOT::RDF::Experimental::EnableProfiling(df);
+   auto filtered = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                      .Filter([](int x) { return x % 2 == 0; }, {"x"}, "even");
+   auto sum = filtered.Sum<int>("x");
+   EXPECT_EQ(2450, *sum);
+
+   const auto report = ROOT::RDF::Experimental::GetProfileReport(df);
+   std::map<std::string, ULong64_t> calls;
+   for (const auto &node : report) {
+      calls[node.fKind + ":" + node.fName] = node.fNCalls;
+      EXPECT_GE(node.fTime, 0.);
+      EXPECT_EQ(df.GetNSlots(), node.fTimePerSlot.size());
+   }
+   EXPECT_EQ(100u, calls["Define:x"]);
+   EXPECT_EQ(100u, calls["Filter:even"]);
+   EXPECT_EQ(50u, calls["Action:Sum"]);
+
+   // the times are also shown in the graph
+   const auto graph = ROOT::RDF::SaveGraph(df);
+   EXPECT_NE(graph.find(" ms"), std::string::npos);
+
+   std::stringstream ss;
+   report.Print(ss);
+   EXPECT_NE(ss.str().find("even"), std::string::npos);
+}
+
+TEST(RDFHelpers, ProgressReport)
+{
+   ROOT::RDataFrame df(1000);
+   auto noop = [](const ROOT::RDF::Experimental::RProgressInfo &) {};
+   EXPECT_THROW(ROOT::RDF::Experimental::EnableProgressReport(df, nullptr), std::invalid_argument);
+   EXPECT_THROW(ROOT::RDF::Experimental::EnableProgressReport(df, noop, -1.), std::invalid_argument);
+   EXPECT_THROW(ROOT::RDF::Experimental::EnableProgressReport(df, noop, 1., 0), std::invalid_argument);
+
+   std::vector<ROOT::RDF::Experimental::RProgressInfo> reports;
+   ROOT::RDF::Experimental::EnableProgressReport(
+      df, [&reports](const ROOT::RDF::Experimental::RProgressInfo &p) { reports.emplace_back(p); }, 0., 10);
+   auto c = df.Count();
+   EXPECT_EQ(1000u, *c);
+
+   // with a zero interval, a report is sent at least at the first sample
+   ASSERT_GE(reports.size(), 2u);
+   ULong64_t lastNEntries = 0;
+   for (const auto &p : reports) {
+      EXPECT_EQ(1000, p.fNEntriesTotal);
+      EXPECT_EQ(df.GetNSlots(), p.fNEntriesPerSlot.size());
+      EXPECT_EQ(df.GetNSlots(), p.fEntriesPerSecondPerSlot.size());
+      EXPECT_EQ(p.fNEntries, std::accumulate(p.fNEntriesPerSlot.begin(), p.fNEntriesPerSlot.end(), 0ull));
+      EXPECT_GE(p.fNEntries, lastNEntries);
+      EXPECT_GE(p.fRemaining, -1.);
+      lastNEntries = p.fNEntries;
+   }
+   const auto &last = reports.back();
+   EXPECT_TRUE(last.fIsDone);
+   EXPECT_EQ(1000u, last.fNEntries);
+   EXPECT_EQ(0., last.fRemaining);
+   EXPECT_EQ(1, std::count_if(reports.begin(), reports.end(), [](const auto &p) { return p.fIsDone; }));
+
+   // the counters are reset at every event loop
+   reports.clear();
+   auto s = df.Sum<ULong64_t>("rdfentry_");
+   EXPECT_EQ(499500u, *s);
+   ASSERT_FALSE(reports.empty());
+   EXPECT_EQ(1000u, reports.back().fNEntries);
+}
+
+TEST(RDFHelpers, StagedTreeCache)
+{
+   const auto fileName = "dataframe_helpers_stagedtreecache.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      int x = 0, y = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      for (x = 0; x < 100; ++x) {
+         y = 2 * x;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fileName);
+   auto t = f.Get<TTree>("t");
+   ROOT::RDataFrame df(*t);
+   ROOT::RDF::Experimental::EnableStagedTreeCache(df);
+   auto sumY = df.Filter([](int x) { return x >= 90; }, {"x"}).Sum<int>("y");
+   auto sumX = df.Sum<int>("x");
+   EXPECT_EQ(1890, *sumY);
+   EXPECT_EQ(4950, *sumX);
+
+   // "x" is read for every entry and prefetched, "y" is read only after the Filter
+   auto cache = t->GetReadCache(&f);
+   ASSERT_NE(cache, nullptr);
+   EXPECT_NE(cache->GetCachedBranches()->FindObject("x"), nullptr);
+   EXPECT_EQ(cache->GetCachedBranches()->FindObject("y"), nullptr);
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFHelpers, SharedHistoFill)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   {
+      ROOT::RDataFrame df(1000);
+      auto d = df.Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"})
+                  .Define("xs", [](double x) { return ROOT::RVec<double>{x, x + 0.5}; }, {"x"});
+      auto hParallel = d.Histo2D<double, double>({"hp", "hp", 10, 0., 100., 10, 0., 100.}, "x", "x");
+      auto pParallel = d.Profile2D<double, double, double, double>({"pp", "pp", 10, 0., 100., 10, 0., 100.}, "x",
+                                                                   "x", "x", "x");
+      ROOT::RDF::Experimental::EnableSharedHistoFill(d, true, 7);
+      auto hShared = d.Histo2D<double, double>({"hs", "hs", 10, 0., 100., 10, 0., 100.}, "x", "x");
+      auto hSharedW = d.Histo1D<ROOT::RVec<double>, double>({"hw", "hw", 10, 0., 100.}, "xs", "x");
+      auto pShared = d.Profile1D<double, double>({"p", "p", 10, 0., 100.}, "x", "x");
+      auto pShared2D = d.Profile2D<double, double, double, double>({"p2", "p2", 10, 0., 100., 10, 0., 100.}, "x",
+                                                                   "x", "x", "x");
+
+      EXPECT_EQ(hShared->GetEntries(), 1000.);
+      for (int bin = 0; bin < hParallel->GetNcells(); ++bin)
+         EXPECT_DOUBLE_EQ(hShared->GetBinContent(bin), hParallel->GetBinContent(bin));
+      EXPECT_EQ(hSharedW->GetEntries(), 2000.);
+      EXPECT_DOUBLE_EQ(hSharedW->GetSumOfWeights(), 2. * 49500.);
+      EXPECT_DOUBLE_EQ(pShared->GetMean(2), 49.5);
+      EXPECT_EQ(pShared->GetEntries(), 1000.);
+      EXPECT_EQ(pShared2D->GetEntries(), 1000.);
+      for (int bin = 0; bin < pParallel->GetNcells(); ++bin) {
+         EXPECT_DOUBLE_EQ(pShared2D->GetBinContent(bin), pParallel->GetBinContent(bin));
+         EXPECT_DOUBLE_EQ(pShared2D->GetBinEntries(bin), pParallel->GetBinEntries(bin));
+         EXPECT_DOUBLE_EQ(pShared2D->GetBinError(bin), pParallel->GetBinError(bin));
+      }
+   }
+   EXPECT_THROW(ROOT::RDF::Experimental::EnableSharedHistoFill(ROOT::RDataFrame(1), true, 0), std::invalid_argument);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
+
+TEST(RDFHelpers, GenerateCode)
+{
+   ROOT::RDataFrame df(20);
+   auto sel = df.Define("x", "rdfentry_ * 0.5")
+                 .Filter("x > 2", "xCut")
+                 .Define("y", "x * x")
+                 .Redefine("x", "x + 1")
+                 .Range(10);
+   const auto code = ROOT::RDF::Experimental::GenerateCode(sel, "GeneratedGraph");
+   const std::string expected = "ROOT::RDF::RNode GeneratedGraph(ROOT::RDF::RNode df)\n{\n   return df\n"
+                                "      .Define(\"x\", [](const ULong64_t var0){return var0 * 0.5\n;}, {\"rdfentry_\"})\n"
+                                "      .Filter([](const double var0){return var0 > 2\n;}, {\"x\"}, \"xCut\")\n"
+                                "      .Define(\"y\", [](const double var0){return var0 * var0\n;}, {\"x\"})\n"
+                                "      .Redefine(\"x\", [](const double var0){return var0 + 1\n;}, {\"x\"})\n"
+                                "      .Range(0, 10, 1);\n}\n";
+   EXPECT_NE(code.find(expected), std::string::npos) << code;
+
+   // the generated code books the same transformations
+   ASSERT_TRUE(gInterpreter->Declare(code.c_str()));
+   using Fn_t = ROOT::RDF::RNode (*)(ROOT::RDF::RNode);
+   auto generatedGraph = reinterpret_cast<Fn_t>(gInterpreter->Calc("(long)&GeneratedGraph"));
+   ASSERT_NE(generatedGraph, nullptr);
+   auto generated = generatedGraph(ROOT::RDataFrame(20));
+   EXPECT_EQ(*generated.Take<double>("x"), *sel.Take<double>("x"));
+   EXPECT_EQ(*generated.Take<double>("y"), *sel.Take<double>("y"));
+
+   // C++ callables cannot be written out
+   EXPECT_THROW(ROOT::RDF::Experimental::GenerateCode(sel.Filter([] { return true; })), std::runtime_error);
+   EXPECT_THROW(ROOT::RDF::Experimental::GenerateCode(df.Define("z", [] { return 1; })), std::runtime_error);
+}
+
+TEST(RDFHelpers, SaveGeneratedCode)
+{
+   const std::string dir = "rdfhelpers_generatedcode";
+   gSystem->mkdir(dir.c_str());
+   ROOT::RDataFrame df(1);
+   ROOT::RDF::Experimental::SaveGeneratedCode(df.Define("x", "42"), "MakeX", dir, {"TRandom.h"});
+
+   std::ifstream source(dir + "/MakeX.cxx");
+   std::stringstream content;
+   content << source.rdbuf();
+   EXPECT_NE(content.str().find("#include \"MakeX.hxx\"\n"), std::string::npos);
+   EXPECT_NE(content.str().find("#include \"TRandom.h\"\n"), std::string::npos);
+   EXPECT_NE(content.str().find(".Define(\"x\", [](){return 42\n;}, {})"), std::string::npos);
+   for (const auto fileName : {"MakeX.hxx", "MakeX.cxx", "CMakeLists.txt"}) {
+      const auto path = dir + "/" + fileName;
+      EXPECT_EQ(gSystem->AccessPathName(path.c_str()), kFALSE) << path; // kFALSE means that the file exists
+      gSystem->Unlink(path.c_str());
+   }
+   gSystem->Unlink(dir.c_str());
+}
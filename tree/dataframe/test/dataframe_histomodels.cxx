@@ -285,3 +285,59 @@ TEST(RDataFrameHisto, FillVecBool)
     EXPECT_EQ(h->GetBinContent(2), n);
     EXPECT_EQ(h->GetBinContent(3), 0u);
 }
+
+// Filling from collections goes through FillN where available: check it gives the same result as per-value fills
+TEST(RDataFrameHisto, FillCollections)
+{
+   const auto n = 20u;
+   ROOT::RDataFrame df(n);
+   auto d = df.Define("x", [](ULong64_t e) { return ROOT::RVec<double>{e * 0.5, e * 0.25, -1. * e}; }, {"rdfentry_"})
+               .Define("y", [](ULong64_t e) { return std::vector<float>{1.f * e, 2.f, e * 0.1f}; }, {"rdfentry_"})
+               .Define("w", [](ULong64_t e) { return ROOT::RVec<int>{1, 2, int(e % 3)}; }, {"rdfentry_"})
+               .Define("sw", [](ULong64_t e) { return e * 0.5; }, {"rdfentry_"});
+
+   auto h1 = d.Histo1D<ROOT::RVec<double>>({"h1", "h1", 10, -5., 5.}, "x");
+   auto h1w = d.Histo1D<ROOT::RVec<double>, ROOT::RVec<int>>({"h1w", "h1w", 10, -5., 5.}, "x", "w");
+   auto h1sw = d.Histo1D<std::vector<float>, double>({"h1sw", "h1sw", 10, 0., 20.}, "y", "sw");
+   auto h2 = d.Histo2D<ROOT::RVec<double>, std::vector<float>>({"h2", "h2", 4, -5., 5., 4, 0., 20.}, "x", "y");
+   auto h2w = d.Histo2D<ROOT::RVec<double>, std::vector<float>, ROOT::RVec<int>>({"h2w", "h2w", 4, -5., 5., 4, 0., 20.},
+                                                                                "x", "y", "w");
+   auto p1 = d.Profile1D<ROOT::RVec<double>, std::vector<float>>({"p1", "p1", 4, -5., 5.}, "x", "y");
+   auto p1sw = d.Profile1D<ROOT::RVec<double>, std::vector<float>, double>({"p1sw", "p1sw", 4, -5., 5.}, "x", "y", "sw");
+
+   TH1D rh1("rh1", "rh1", 10, -5., 5.), rh1w("rh1w", "rh1w", 10, -5., 5.), rh1sw("rh1sw", "rh1sw", 10, 0., 20.);
+   TH2D rh2("rh2", "rh2", 4, -5., 5., 4, 0., 20.), rh2w("rh2w", "rh2w", 4, -5., 5., 4, 0., 20.);
+   TProfile rp1("rp1", "rp1", 4, -5., 5.), rp1sw("rp1sw", "rp1sw", 4, -5., 5.);
+   for (auto e = 0ull; e < n; ++e) {
+      const ROOT::RVec<double> x{e * 0.5, e * 0.25, -1. * e};
+      const std::vector<float> y{1.f * e, 2.f, e * 0.1f};
+      const ROOT::RVec<int> w{1, 2, int(e % 3)};
+      const auto sw = e * 0.5;
+      for (auto i = 0u; i < x.size(); ++i) {
+         rh1.Fill(x[i]);
+         rh1w.Fill(x[i], w[i]);
+         rh1sw.Fill(y[i], sw);
+         rh2.Fill(x[i], y[i]);
+         rh2w.Fill(x[i], y[i], w[i]);
+         rp1.Fill(x[i], y[i]);
+         rp1sw.Fill(x[i], y[i], sw);
+      }
+   }
+
+   auto checkEqual = [](const TH1 &h, const TH1 &ref) {
+      EXPECT_EQ(h.GetEntries(), ref.GetEntries()) << h.GetName();
+      EXPECT_DOUBLE_EQ(h.GetMean(), ref.GetMean()) << h.GetName();
+      EXPECT_DOUBLE_EQ(h.GetStdDev(), ref.GetStdDev()) << h.GetName();
+      for (auto bin = 0; bin < ref.GetNcells(); ++bin) {
+         EXPECT_DOUBLE_EQ(h.GetBinContent(bin), ref.GetBinContent(bin)) << h.GetName() << " bin " << bin;
+         EXPECT_DOUBLE_EQ(h.GetBinError(bin), ref.GetBinError(bin)) << h.GetName() << " bin " << bin;
+      }
+   };
+   checkEqual(*h1, rh1);
+   checkEqual(*h1w, rh1w);
+   checkEqual(*h1sw, rh1sw);
+   checkEqual(*h2, rh2);
+   checkEqual(*h2w, rh2w);
+   checkEqual(*p1, rp1);
+   checkEqual(*p1sw, rp1sw);
+}
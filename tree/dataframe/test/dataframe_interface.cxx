@@ -774,3 +774,42 @@ TEST(RDataFrameInterface, SnapshotWithDuplicateColumns)
       std::logic_error);
    EXPECT_THROW((ROOT::RDataFrame(1).Snapshot("t", "neverwritten.root", {"rdfentry_", "rdfentry_"})), std::logic_error);
 }
+
+TEST(RDataFrameInterface, SharedJittedNodes)
+{
+   gInterpreter->Declare("namespace RDFJitSharing { int nCalls = 0; "
+                         "bool IsEven(ULong64_t e) { ++nCalls; return e % 2 == 0; } }");
+   auto getNCalls = [] { return *reinterpret_cast<int *>(gInterpreter->Calc("&RDFJitSharing::nCalls")); };
+
+   ROOT::RDataFrame df(10);
+   // identical filters and defines on the same node are booked only once
+   auto f1 = df.Filter("RDFJitSharing::IsEven(rdfentry_)");
+   auto f2 = df.Filter("RDFJitSharing::IsEven(rdfentry_)");
+   auto d1 = df.Define("even", "RDFJitSharing::IsEven(rdfentry_)");
+   auto d2 = df.Define("x", "rdfentry_").Define("even", "RDFJitSharing::IsEven(rdfentry_)");
+   // a named filter and a define with another name are distinct nodes
+   auto f3 = df.Filter("RDFJitSharing::IsEven(rdfentry_)", "evenEntries");
+   auto d3 = df.Define("odd", "!RDFJitSharing::IsEven(rdfentry_)");
+   auto c1 = f1.Count();
+   auto c2 = f2.Count();
+   auto c3 = f3.Count();
+   auto isTrue = [](bool b) { return b; };
+   auto s1 = d1.Filter(isTrue, {"even"}).Count();
+   auto s2 = d2.Filter(isTrue, {"even"}).Count();
+   auto s3 = d3.Filter(isTrue, {"odd"}).Count();
+   EXPECT_EQ(5u, *c1);
+   EXPECT_EQ(5u, *c2);
+   EXPECT_EQ(5u, *c3);
+   EXPECT_EQ(5u, *s1);
+   EXPECT_EQ(5u, *s2);
+   EXPECT_EQ(5u, *s3);
+   EXPECT_EQ(40, getNCalls());
+
+   // a define that reads a column which is defined differently is not shared
+   auto y1 = df.Define("y", "rdfentry_").Define("z", "y * 2");
+   auto y2 = df.Define("y", "rdfentry_ + 1").Define("z", "y * 2");
+   auto sz1 = y1.Sum<ULong64_t>("z");
+   auto sz2 = y2.Sum<ULong64_t>("z");
+   EXPECT_EQ(90u, *sz1);
+   EXPECT_EQ(110u, *sz2);
+}
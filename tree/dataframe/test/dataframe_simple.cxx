@@ -977,6 +977,49 @@ TEST_P(RDFSimpleTests, FillWithCustomClassJitted)
    EXPECT_EQ(h.GetEntries(), 10);
 }
 
+TEST_P(RDFSimpleTests, FundamentalBranchesManyBaskets)
+{
+   const auto fname1 = "test_fundamentalbranchesmanybaskets_1.root";
+   const auto fname2 = "test_fundamentalbranchesmanybaskets_2.root";
+   for (auto fname : {fname1, fname2}) {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      int i = fname == fname1 ? 0 : 1000;
+      float x = 0.f;
+      t.Branch("i", &i)->SetBasketSize(64);
+      t.Branch("x", &x)->SetBasketSize(64);
+      for (auto e = 0; e < 1000; ++e, ++i) {
+         x = 0.5f * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TChain c("t");
+   c.Add(fname1);
+   c.Add(fname2);
+   ROOT::RDataFrame df(c);
+   auto is = df.Take<int>("i");
+   auto xs = df.Take<float>("x");
+   auto d = df.Define("d", [](int i, float x) { return x - 0.5f * i; }, {"i", "x"}).Max<float>("d");
+   auto sum = df.Sum<int>("i");
+
+   EXPECT_EQ(*sum, 1999 * 1000);
+   EXPECT_FLOAT_EQ(*d, 0.f);
+   auto vi = *is;
+   auto vx = *xs;
+   std::sort(vi.begin(), vi.end());
+   std::sort(vx.begin(), vx.end());
+   ASSERT_EQ(vi.size(), 2000u);
+   for (auto e = 0u; e < vi.size(); ++e) {
+      EXPECT_EQ(vi[e], int(e));
+      EXPECT_FLOAT_EQ(vx[e], 0.5f * e);
+   }
+
+   gSystem->Unlink(fname1);
+   gSystem->Unlink(fname2);
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_SUITE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
@@ -8,6 +8,7 @@
 #include "TTree.h"
 #include "TChain.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <thread>
@@ -826,6 +827,68 @@ TEST(RDFSnapshotMore, ZeroOutputEntries)
    gSystem->Unlink(fname);
 }
 
+TEST(RDFSnapshotMore, FastClone)
+{
+   const auto inFile = "snapshot_fastclone_in.root";
+   const auto outFile = "snapshot_fastclone_out.root";
+   const auto filteredFile = "snapshot_fastclone_filtered.root";
+   {
+      TFile f(inFile, "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      std::vector<float> v;
+      double z = 0.;
+      t.Branch("x", &x);
+      t.Branch("v", &v);
+      t.Branch("z", &z);
+      for (int i = 0; i < 1000; ++i) {
+         x = i;
+         v.assign(i % 5, float(i));
+         z = 2. * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   RDataFrame df("t", inFile);
+   RSnapshotOptions opts;
+   opts.fFastClone = true;
+   opts.fCompressionLevel = 9; // ignored: the baskets keep the compression of the input
+   auto out = df.Snapshot("out", outFile, {"x", "v"}, opts);
+   // the input dataset can still read all of its branches
+   EXPECT_DOUBLE_EQ(*df.Sum<double>("z"), 999000.);
+   // a Filter upstream of the Snapshot falls back to a regular Snapshot
+   df.Filter("x % 2 == 0").Snapshot("out", filteredFile, {"x", "v"}, opts);
+
+   auto colNames = out->GetColumnNames();
+   std::sort(colNames.begin(), colNames.end());
+   EXPECT_EQ(colNames, std::vector<std::string>({"v", "x"}));
+   EXPECT_EQ(*out->Count(), 1000ull);
+   EXPECT_EQ(*out->Sum<int>("x"), 499500);
+   auto nV = out->Define("nV", [](const std::vector<float> &vec, int i) { return vec.size() == std::size_t(i % 5); },
+                         {"v", "x"})
+                .Filter("nV")
+                .Count();
+   EXPECT_EQ(*nV, 1000ull);
+   {
+      TFile fIn(inFile);
+      TFile fOut(outFile);
+      auto *tIn = fIn.Get<TTree>("t");
+      auto *tOut = fOut.Get<TTree>("out");
+      ASSERT_NE(tOut, nullptr);
+      EXPECT_EQ(tOut->GetListOfBranches()->GetEntries(), 2);
+      EXPECT_EQ(tOut->GetBranch("x")->GetZipBytes(), tIn->GetBranch("x")->GetZipBytes());
+      EXPECT_EQ(tOut->GetBranch("v")->GetZipBytes(), tIn->GetBranch("v")->GetZipBytes());
+   }
+
+   RDataFrame filtered("out", filteredFile);
+   EXPECT_EQ(*filtered.Count(), 500ull);
+   EXPECT_EQ(*filtered.Sum<int>("x"), 249500);
+
+   for (auto fname : {inFile, outFile, filteredFile})
+      gSystem->Unlink(fname);
+}
+
 /********* MULTI THREAD TESTS ***********/
 #ifdef R__USE_IMT
 TEST_F(RDFSnapshotMT, Snapshot_update_diff_treename)
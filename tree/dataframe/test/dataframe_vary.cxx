@@ -0,0 +1,109 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RResultMap.hxx>
+#include <ROOT/RVec.hxx>
+#include <TH1D.h>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ROOT::RVec;
+using ROOT::RDF::Experimental::VariationsFor;
+
+namespace {
+// x = 0, 1, ..., 9
+ROOT::RDF::RNode MakeDF()
+{
+   return ROOT::RDataFrame(10).Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+}
+
+RVec<double> ShiftX(double x)
+{
+   return {x - 1., x + 1.};
+}
+} // namespace
+
+TEST(Vary, SimpleSum)
+{
+   auto sum = MakeDF().Vary("x", ShiftX, {"x"}, {"down", "up"}).Sum<double>("x");
+   auto sums = VariationsFor(sum);
+
+   const std::vector<std::string> expectedKeys{"nominal", "x:down", "x:up"};
+   EXPECT_EQ(sums.GetKeys(), expectedKeys);
+   EXPECT_DOUBLE_EQ(sums["nominal"], 45.);
+   EXPECT_DOUBLE_EQ(sums["x:down"], 35.);
+   EXPECT_DOUBLE_EQ(sums["x:up"], 55.);
+   EXPECT_THROW(sums["x:sideways"], std::runtime_error);
+}
+
+TEST(Vary, FilterAndDefine)
+{
+   auto df = MakeDF().Vary("x", ShiftX, {"x"}, {"down", "up"}, "shift");
+   auto filtered = df.Filter([](double x) { return x > 4.5; }, {"x"}, "xcut").Define("y", [](double x) { return 2 * x; },
+                                                                                      {"x"});
+   auto count = filtered.Count();
+   auto max = filtered.Max<double>("y");
+   auto report = filtered.Report();
+   auto counts = VariationsFor(count);
+   auto maxs = VariationsFor(max);
+
+   EXPECT_EQ(counts["nominal"], 5ull);
+   EXPECT_EQ(counts["shift:down"], 4ull);
+   EXPECT_EQ(counts["shift:up"], 6ull);
+   EXPECT_DOUBLE_EQ(maxs["nominal"], 18.);
+   EXPECT_DOUBLE_EQ(maxs["shift:down"], 16.);
+   EXPECT_DOUBLE_EQ(maxs["shift:up"], 20.);
+
+   // all results are produced in the same event loop, and the cloned filters do not show up in the report
+   EXPECT_EQ(df.GetNRuns(), 1u);
+   EXPECT_EQ(std::distance(report->begin(), report->end()), 1);
+   EXPECT_EQ((*report)["xcut"].GetPass(), 5ull);
+}
+
+TEST(Vary, UnaffectedResult)
+{
+   auto df = MakeDF().Define("z", [] { return 1.; }).Vary("x", ShiftX, {"x"}, 2);
+   auto sums = VariationsFor(df.Sum<double>("z"));
+   EXPECT_EQ(sums.GetKeys(), std::vector<std::string>{"nominal"});
+   EXPECT_DOUBLE_EQ(sums["nominal"], 10.);
+
+   auto xs = VariationsFor(df.Sum<double>("x"));
+   EXPECT_DOUBLE_EQ(xs["x:0"], 35.);
+   EXPECT_DOUBLE_EQ(xs["x:1"], 55.);
+}
+
+TEST(Vary, Jitted)
+{
+   auto h = MakeDF().Vary("x", ShiftX, {"x"}, {"down", "up"}).Filter("x > 4.5").Define("y", "x * 2").Histo1D<double>(
+      {"h", "h", 40, 0., 40.}, "y");
+   auto hs = VariationsFor(h);
+   EXPECT_EQ(hs["nominal"].GetEntries(), 5.);
+   EXPECT_EQ(hs["x:down"].GetEntries(), 4.);
+   EXPECT_EQ(hs["x:up"].GetEntries(), 6.);
+   EXPECT_DOUBLE_EQ(hs["x:up"].GetMean(), 14.);
+}
+
+TEST(Vary, Errors)
+{
+   auto df = MakeDF();
+   EXPECT_THROW(df.Vary("x", ShiftX, {"x"}, std::vector<std::string>{}), std::invalid_argument);
+   EXPECT_THROW(df.Vary("x", [](double x) { return RVec<int>{int(x)}; }, {"x"}, 1), std::runtime_error);
+   EXPECT_THROW(df.Vary("x", ShiftX, {"x"}, 2).Vary("x", ShiftX, {"x"}, 2), std::invalid_argument);
+
+   // wrong number of varied values
+   auto wrongSize = df.Vary("x", ShiftX, {"x"}, 3).Sum<double>("x");
+   auto wrongSizes = VariationsFor(wrongSize);
+   EXPECT_THROW(wrongSizes["x:0"], std::runtime_error);
+
+   // actions that do not support variations
+   auto take = df.Vary("x", ShiftX, {"x"}, 2).Take<double>("x");
+   EXPECT_THROW(VariationsFor(take), std::logic_error);
+
+   // results that have already been produced
+   auto count = df.Vary("x", ShiftX, {"x"}, 2).Count();
+   *count;
+   EXPECT_THROW(VariationsFor(count), std::logic_error);
+}
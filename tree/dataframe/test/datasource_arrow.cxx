@@ -112,6 +112,37 @@ TEST(RArrowDS, EntryRanges)
    EXPECT_EQ(6U, ranges[2].second);
 }
 
+TEST(RArrowDS, EntryRangesFollowChunks)
+{
+   std::vector<std::shared_ptr<Array>> chunks(4);
+   arrow::ArrayFromVector<Int64Type, int64_t>({1, 2, 3}, &chunks[0]);
+   arrow::ArrayFromVector<Int64Type, int64_t>({4}, &chunks[1]);
+   arrow::ArrayFromVector<Int64Type, int64_t>({5, 6, 7, 8}, &chunks[2]);
+   arrow::ArrayFromVector<Int64Type, int64_t>({9, 10}, &chunks[3]);
+   auto table = Table::Make(schema({field("x", arrow::int64())}), {std::make_shared<arrow::ChunkedArray>(chunks)});
+
+   RArrowDS tds(table, {});
+   tds.SetNSlots(2U);
+   tds.Initialise();
+
+   // chunks are merged until ranges have at least 10 / 2 entries
+   auto ranges = tds.GetEntryRanges();
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(8U, ranges[0].second);
+   EXPECT_EQ(8U, ranges[1].first);
+   EXPECT_EQ(10U, ranges[1].second);
+
+#ifdef R__B64
+   EXPECT_EQ(55, *ROOT::RDataFrame(std::make_unique<RArrowDS>(table, std::vector<std::string>{})).Sum<Long64_t>("x"));
+#endif
+}
+
+TEST(RArrowDS, MissingColumn)
+{
+   EXPECT_THROW(RArrowDS(createTestTable(), {"Age", "Address"}), std::runtime_error);
+}
+
 TEST(RArrowDS, ColumnReaders)
 {
    RArrowDS tds(createTestTable(), {});
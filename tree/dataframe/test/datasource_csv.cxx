@@ -2,9 +2,11 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -320,6 +322,34 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   // large enough for the lines of a chunk to be parsed by several tasks
+   const auto fileName = "RCsvDS_test_parallel.csv";
+   const auto nLines = 10000u;
+   {
+      std::ofstream f(fileName);
+      f << "i,x,b,s\n";
+      for (auto i = 0u; i < nLines; ++i)
+         f << i << ',' << i + 0.5 << ',' << (i % 2 == 0 ? "true" : "false") << ",\"s," << i << "\"\n";
+   }
+
+   for (auto chunkSize : {-1LL, 3000LL}) {
+      auto df = ROOT::RDF::MakeCsvDataFrame(fileName, true, ',', chunkSize);
+      auto sumI = df.Sum<Long64_t>("i");
+      auto sumX = df.Sum<double>("x");
+      auto nTrue = df.Filter([](bool b) { return b; }, {"b"}).Count();
+      auto nGoodStrings =
+         df.Filter([](Long64_t i, const std::string &s) { return s == "s," + std::to_string(i); }, {"i", "s"}).Count();
+      EXPECT_EQ(nLines * (nLines - 1) / 2, *sumI);
+      EXPECT_DOUBLE_EQ(nLines * 0.5 * nLines, *sumX);
+      EXPECT_EQ(nLines / 2, *nTrue);
+      EXPECT_EQ(nLines, *nGoodStrings);
+   }
+
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
@@ -125,3 +125,122 @@ TEST_F(RNTupleDSTest, ReadMT)
 
    ReadTest(fNtplName, fFileName);
 }
+
+TEST(RNTupleDS, EntryRanges)
+{
+   const std::string fileName = "RNTupleDS_test_ranges.root";
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      ROOT::Experimental::RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(10);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName, options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         ntuple->Fill();
+      }
+   }
+
+   {
+      RNTupleDS ds(RPageSource::Create("ntuple", fileName));
+      ds.SetNSlots(2);
+      ds.Initialise();
+      // 100 clusters and a target of 20 ranges
+      auto ranges = ds.GetEntryRanges();
+      ASSERT_EQ(20U, ranges.size());
+      for (unsigned int i = 0; i < ranges.size(); ++i) {
+         EXPECT_EQ(50U * i, ranges[i].first);
+         EXPECT_EQ(50U * (i + 1), ranges[i].second);
+      }
+      EXPECT_TRUE(ds.GetEntryRanges().empty());
+      ds.Finalise();
+   }
+
+   {
+      IMTRAII _;
+      auto rdf = ROOT::Experimental::MakeNTupleDataFrame("ntuple", fileName);
+      EXPECT_EQ(1000U, *rdf.Count());
+      EXPECT_DOUBLE_EQ(999. * 1000. / 2., *rdf.Sum<float>("pt"));
+   }
+   std::remove(fileName.c_str());
+}
+
+TEST(RNTupleDS, BulkRead)
+{
+   const std::string fileName = "RNTupleDS_test_bulk.root";
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrTag = model->MakeField<std::string>("tag");
+      ROOT::Experimental::RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(100);
+      options.SetNElementsPerPage(16);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName, options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         *wrTag = std::to_string(i);
+         ntuple->Fill();
+      }
+   }
+
+   // Block boundaries fall in the middle of pages and clusters
+   auto ds = std::make_unique<RNTupleDS>(RPageSource::Create("ntuple", fileName));
+   ds->SetBulkSize(37);
+   ROOT::RDataFrame rdf(std::move(ds));
+   auto sumPt = rdf.Sum<float>("pt");
+   auto nMatch =
+      rdf.Filter([](float pt, const std::string &tag) { return std::to_string(int(pt)) == tag; }, {"pt", "tag"})
+         .Count();
+   auto nLarge = rdf.Filter([](float pt) { return pt >= 500; }, {"pt"}).Count();
+   EXPECT_DOUBLE_EQ(999. * 1000. / 2., *sumPt);
+   EXPECT_EQ(1000U, *nMatch);
+   EXPECT_EQ(500U, *nLarge);
+
+   {
+      IMTRAII _;
+      auto dsMT = std::make_unique<RNTupleDS>(RPageSource::Create("ntuple", fileName));
+      dsMT->SetBulkSize(64);
+      ROOT::RDataFrame rdfMT(std::move(dsMT));
+      EXPECT_DOUBLE_EQ(999. * 1000. / 2., *rdfMT.Sum<float>("pt"));
+   }
+   std::remove(fileName.c_str());
+}
+
+TEST(RNTupleDS, SnapshotToRNTuple)
+{
+   const std::string fileName = "RNTupleDS_test_snapshot.root";
+   ROOT::RDF::RSnapshotOptions options;
+   options.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   options.fAutoFlush = 100;
+   auto df = ROOT::RDataFrame(1000)
+                .Define("x", [](ULong64_t e) { return float(e); }, {"rdfentry_"})
+                .Define("v", [](float x) { return ROOT::RVec<int>(int(x) % 4, int(x)); }, {"x"})
+                .Define("s", [](float x) { return std::to_string(int(x)); }, {"x"});
+   {
+      auto snap = df.Snapshot<float, ROOT::RVec<int>, std::string>("ntuple", fileName, {"x", "v", "s"}, options);
+      EXPECT_EQ(1000U, *snap->Count());
+      EXPECT_DOUBLE_EQ(999. * 1000. / 2., *snap->Sum<float>("x"));
+      auto nMatch =
+         snap->Filter([](float x, const std::string &s) { return s == std::to_string(int(x)); }, {"x", "s"}).Count();
+      EXPECT_EQ(1000U, *nMatch);
+      // entry i holds (i % 4) copies of i
+      auto nV = snap->Sum<ROOT::Experimental::ClusterSize_t::ValueType>("__rdf_sizeof_v");
+      auto sumV = snap->Sum<std::vector<int>>("v");
+      EXPECT_EQ(1500U, *nV);
+      double expectedSumV = 0;
+      for (int i = 0; i < 1000; ++i)
+         expectedSumV += (i % 4) * i;
+      EXPECT_DOUBLE_EQ(expectedSumV, *sumV);
+   }
+
+   {
+      IMTRAII _;
+      auto snap = df.Snapshot("ntuple", fileName, {"x", "s"}, options);
+      EXPECT_EQ(1000U, *snap->Count());
+      EXPECT_DOUBLE_EQ(999. * 1000. / 2., *snap->Sum<float>("x"));
+   }
+
+   options.fMode = "UPDATE";
+   EXPECT_THROW(df.Snapshot<float>("ntuple", fileName, {"x"}, options), std::invalid_argument);
+   std::remove(fileName.c_str());
+}
@@ -17,8 +17,10 @@
 #define ROOT7_RClusterPool
 
 #include <ROOT/RCluster.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RPageStorage.hxx> // for ColumnSet_t
+#include <ROOT/RIOTaskPool.hxx>
 
 #include <condition_variable>
 #include <memory>
@@ -44,9 +46,9 @@ class RPageSource;
 The cluster pool steers the preloading of (partial) clusters. There is a two-step pipeline: in a first step,
 compressed pages are read from clusters into a memory buffer. The second pipeline step decompresses the pages
 and pushes them into the page pool. The actual logic of reading and unzipping is implemented by the page source.
-The cluster pool only orchestrates the work queues for reading and unzipping. It uses two threads, one for
-each pipeline step. The I/O thread for reading waits for data from storage and generates no CPU load. In contrast,
-the unzip thread is supposed to submit multi-threaded, CPU heavy work to the application's task scheduler.
+The cluster pool only orchestrates the work queues for reading and unzipping. The reading step runs as a task of
+ROOT's shared I/O task pool, which waits for data from storage and generates no CPU load. In contrast, the unzip
+thread is supposed to submit multi-threaded, CPU heavy work to the application's task scheduler.
 
 The unzipping step of the pipeline therefore behaves differently depending on whether or not implicit multi-threadin
 is turned on. If it is turned off, i.e. in a single-threaded environment, the cluster pool will only read the
@@ -55,7 +57,7 @@ compressed pages and the page source has to uncompresses pages at a later point
 // clang-format on
 class RClusterPool {
 private:
-   /// Maximum number of queued cluster requests for the I/O thread. A single request can span mutliple clusters.
+   /// Maximum number of queued cluster requests for the I/O task. A single request can span mutliple clusters.
    static constexpr unsigned int kWorkQueueLimit = 4;
 
    /// Request to load a subset of the columns of a particular cluster.
@@ -99,26 +101,36 @@ private:
    /// The cache of clusters around the currently active cluster
    std::vector<std::unique_ptr<RCluster>> fPool;
 
+   /// Read-ahead performance counters that get registered in fMetrics
+   struct RCounters {
+      RNTupleAtomicCounter &fNHit;
+      RNTupleAtomicCounter &fNMiss;
+   };
+   RNTupleMetrics fMetrics;
+   std::unique_ptr<RCounters> fCounters;
+
    /// Protects the shared state between the main thread and the pipeline threads, namely the read and unzip
    /// work queues and the in-flight clusters vector
    std::mutex fLockWorkQueue;
-   /// The clusters that were handed off to the I/O thread
+   /// The clusters that were handed off to the I/O task
    std::vector<RInFlightCluster> fInFlightClusters;
-   /// Signals a non-empty I/O work queue
-   std::condition_variable fCvHasReadWork;
-   /// The communication channel to the I/O thread
+   /// The communication channel to the I/O task
    std::queue<RReadItem> fReadQueue;
+   /// Set while an I/O task is submitted that has not yet drained the read queue
+   bool fIsReading = false;
    /// The lock associated with the fCvHasUnzipWork conditional variable
    std::mutex fLockUnzipQueue;
    /// Signals non-empty unzip work queue
    std::condition_variable fCvHasUnzipWork;
-   /// The communication channel between the I/O thread and the unzip thread
+   /// The communication channel between the I/O task and the unzip thread
    std::queue<RUnzipItem> fUnzipQueue;
 
-   /// The I/O thread calls RPageSource::LoadCluster() asynchronously.  The thread is mostly waiting for the
-   /// data to arrive (blocked by the kernel) and therefore can safely run in addition to the application
-   /// main threads.
-   std::thread fThreadIo;
+   /// The I/O task calls RPageSource::LoadCluster() asynchronously.  It is mostly waiting for the data to arrive
+   /// (blocked by the kernel) and therefore runs on the threads of the I/O task pool, in addition to the application
+   /// main threads.  The pool is shared with the other cluster pools of the process.
+   std::shared_ptr<ROOT::Internal::RIOTaskPool> fIOTaskPool;
+   /// Becomes ready when the last submitted I/O task drained the read queue
+   std::future<void> fReadTask;
    /// The unzip thread takes a loaded cluster and passes it to fPageSource->UnzipCluster() on it. If implicit
    /// multi-threading is turned off, the UnzipCluster() call is a no-op. Otherwise, the UnzipCluster() call
    /// schedules the unzipping of pages using the application's task scheduler.
@@ -129,7 +141,8 @@ private:
    /// Returns an index of an unused element in fPool; callers of this function (GetCluster() and WaitFor())
    /// make sure that a free slot actually exists
    size_t FindFreeSlot() const;
-   /// The I/O thread routine, there is exactly one I/O thread in-flight for every cluster pool
+   /// The I/O task routine, loads the clusters of the read queue until it is empty.  There is at most one I/O task
+   /// in-flight for every cluster pool
    void ExecReadClusters();
    /// The unzip thread routine which takes a loaded cluster and passes it to fPageSource.UnzipCluster (which
    /// might be a no-op if IMT is off). Marks the cluster as ready to be picked up by the main thread.
@@ -149,6 +162,8 @@ public:
 
    unsigned int GetWindowPre() const { return fWindowPre; }
    unsigned int GetWindowPost() const { return fWindowPost; }
+   /// Counts cluster requests that were served from the pool (hit) or needed to wait for the I/O (miss)
+   RNTupleMetrics &GetMetrics() { return fMetrics; }
 
    /// Returns the requested cluster either from the pool or, in case of a cache miss, lets the I/O thread load
    /// the cluster in the pool, blocks until done, and then returns it.  Triggers along the way the background loading
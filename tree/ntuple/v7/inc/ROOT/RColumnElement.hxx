@@ -87,6 +87,13 @@ public:
    /// Derived, typed classes tell whether the on-storage layout is bitwise identical to the memory layout
    virtual bool IsMappable() const { R__ASSERT(false); return false; }
    virtual std::size_t GetBitsOnStorage() const { R__ASSERT(false); return 0; }
+   /// Numeric elements update the statistics with the in-memory values in source and return true; other elements
+   /// return false
+   virtual bool UpdateStatistics(const void * /* source */, std::size_t /* count */,
+                                 RColumnStatistics & /* statistics */) const
+   {
+      return false;
+   }
 
    /// If the on-storage layout and the in-memory layout differ, packing creates an on-disk page from an in-memory page
    virtual void Pack(void *destination, void *source, std::size_t count) const
@@ -100,6 +107,16 @@ public:
       std::memcpy(destination, source, count);
    }
 
+protected:
+   template <typename CppT>
+   static void UpdateStatisticsFromValues(const void *source, std::size_t count, RColumnStatistics &statistics)
+   {
+      auto values = reinterpret_cast<const CppT *>(source);
+      for (std::size_t i = 0; i < count; ++i)
+         statistics.Update(static_cast<double>(values[i]));
+   }
+
+public:
    void *GetRawContent() const { return fRawContent; }
    std::size_t GetSize() const { return fSize; }
    std::size_t GetPackedSize(std::size_t nElements) const { return (nElements * GetBitsOnStorage() + 7) / 8; }
@@ -227,6 +244,11 @@ public:
    explicit RColumnElement(float *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<float>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -238,6 +260,11 @@ public:
    explicit RColumnElement(double *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<double>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -249,6 +276,11 @@ public:
    explicit RColumnElement(std::int8_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int8_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -260,6 +292,11 @@ public:
    explicit RColumnElement(std::uint8_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint8_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template<>
@@ -271,6 +308,11 @@ public:
    explicit RColumnElement(std::int16_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int16_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template<>
@@ -282,6 +324,11 @@ public:
    explicit RColumnElement(std::uint16_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint16_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -293,6 +340,11 @@ public:
    explicit RColumnElement(std::int32_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int32_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -304,6 +356,11 @@ public:
    explicit RColumnElement(std::uint32_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint32_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -315,6 +372,11 @@ public:
    explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int64_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -326,6 +388,11 @@ public:
    explicit RColumnElement(std::uint64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint64_t>(source, count, statistics);
+      return true;
+   }
 };
 
 template <>
@@ -384,6 +451,177 @@ public:
    explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int64_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<float, EColumnType::kSplitReal32> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(float);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(float *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<float>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<double, EColumnType::kSplitReal64> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(double);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(double *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<double>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::int16_t, EColumnType::kSplitInt16> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::int16_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::int16_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int16_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::uint16_t, EColumnType::kSplitInt16> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::uint16_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::uint16_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint16_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::int32_t, EColumnType::kSplitInt32> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::int32_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::int32_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int32_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::uint32_t, EColumnType::kSplitInt32> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::uint32_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::uint32_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint32_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::int64_t, EColumnType::kSplitInt64> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::int64_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::int64_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<std::uint64_t, EColumnType::kSplitInt64> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(std::uint64_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(std::uint64_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool UpdateStatistics(const void *source, std::size_t count, RColumnStatistics &statistics) const final
+   {
+      UpdateStatisticsFromValues<std::uint64_t>(source, count, statistics);
+      return true;
+   }
+
+   void Pack(void *dst, void *src, std::size_t count) const final;
+   void Unpack(void *dst, void *src, std::size_t count) const final;
+};
+
+template <>
+class RColumnElement<ClusterSize_t, EColumnType::kSplitIndex> : public RColumnElementBase {
+public:
+   static constexpr bool kIsMappable = false;
+   static constexpr std::size_t kSize = sizeof(ClusterSize_t);
+   static constexpr std::size_t kBitsOnStorage = kSize * 8;
+   explicit RColumnElement(ClusterSize_t *value) : RColumnElementBase(value, kSize) {}
+   bool IsMappable() const final { return kIsMappable; }
+   std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
 
    void Pack(void *dst, void *src, std::size_t count) const final;
    void Unpack(void *dst, void *src, std::size_t count) const final;
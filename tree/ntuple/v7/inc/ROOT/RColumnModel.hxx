@@ -49,6 +49,16 @@ enum class EColumnType {
    kInt64,
    kInt32,
    kInt16,
+   // Split encodings: the bytes of the elements of a page are stored grouped by significance, i.e. first all the
+   // least significant bytes, then all the second least significant bytes etc.  This usually compresses much better
+   // than the plain little-endian layout.
+   kSplitReal64,
+   kSplitReal32,
+   kSplitInt64,
+   kSplitInt32,
+   kSplitInt16,
+   // Like kIndex but stores split differences between consecutive elements of a page
+   kSplitIndex,
 };
 
 // clang-format off
@@ -146,10 +146,12 @@ private:
       DaosEventQueue(std::size_t size);
       ~DaosEventQueue();
       /**
-        \brief Wait for all events in this event queue to complete.
+        \brief Wait for the given number of launched events in this event queue to complete.
         \return Number of events still in the queue. This should be 0 on success.
        */
-      int Poll();
+      int Poll(std::size_t nEvents);
+      /// Number of completed events whose operation failed
+      int GetNErrors() const;
    };
 
    daos_handle_t fContainerHandle{};
@@ -171,14 +173,17 @@ private:
       {
          std::vector<std::tuple<std::unique_ptr<RDaosObject>, RDaosObject::FetchUpdateArgs>> requests{};
          requests.reserve(vec.size());
+         // All the operations are launched before waiting for any of them, so that the round trips overlap
+         int nLaunchFailed = 0;
          for (size_t i = 0; i < vec.size(); ++i) {
            requests.push_back(std::make_tuple(std::unique_ptr<RDaosObject>(new RDaosObject(*this, vec[i].fOid, cid.fCid)),
                                                RDaosObject::FetchUpdateArgs{
                                                  vec[i].fDistributionKey, vec[i].fAttributeKey,
                                                  vec[i].fIovs, &eventQueue.fEvs[i]}));
-            fn(std::get<0>(requests.back()).get(), std::get<1>(requests.back()));
+            if (fn(std::get<0>(requests.back()).get(), std::get<1>(requests.back())) < 0)
+               nLaunchFailed++;
          }
-         ret = eventQueue.Poll();
+         ret = eventQueue.Poll(vec.size() - nLaunchFailed) + nLaunchFailed + eventQueue.GetNErrors();
       }
       return ret;
    }
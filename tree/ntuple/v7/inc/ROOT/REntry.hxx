@@ -18,10 +18,12 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RFieldValue.hxx>
+#include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <TError.h>
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -37,6 +39,8 @@ namespace Experimental {
 
 The entry provides a memory-managed binder for a set of values. Through shared pointers, the memory locations
 that are associated to values are managed.
+
+A lazy entry (see SetLazyIndex()) reads its values only when they are accessed through Get() or GetValue().
 */
 // clang-format on
 class REntry {
@@ -47,6 +51,25 @@ class REntry {
    /// Points into fValues and indicates the values that are owned by the entry and need to be destructed
    std::vector<std::size_t> fManagedValues;
 
+public:
+   /// Reads the given value for the given entry index
+   using LazyLoader_t = std::function<void(NTupleSize_t index, Detail::RFieldValue &value)>;
+
+private:
+   /// If set, values are not read by the reader's LoadEntry() but on first access
+   LazyLoader_t fLazyLoader;
+   NTupleSize_t fLazyIndex = kInvalidNTupleIndex;
+   /// Whether the value with the same index in fValues has been read for fLazyIndex
+   std::vector<bool> fIsLazyValueRead;
+
+   void ReadLazyValue(std::size_t idx)
+   {
+      if (!fLazyLoader || fIsLazyValueRead[idx])
+         return;
+      fLazyLoader(fLazyIndex, fValues[idx]);
+      fIsLazyValueRead[idx] = true;
+   }
+
 public:
    using Iterator_t = decltype(fValues)::iterator;
 
@@ -70,19 +93,38 @@ public:
       return ptr;
    }
 
+   /// Turns the entry into a lazy entry for the given entry index: the values are read by the loader the first time
+   /// they are accessed through Get() or GetValue().  Note that pointers obtained earlier, as well as iterating over
+   /// the entry, do not trigger reading.
+   void SetLazyIndex(NTupleSize_t index, const LazyLoader_t &loader) {
+      fLazyLoader = loader;
+      fLazyIndex = index;
+      fIsLazyValueRead.assign(fValues.size(), false);
+   }
+   /// Reads all the values that have not yet been read for the current lazy index and makes the entry non-lazy
+   void ResolveLazyValues() {
+      for (std::size_t i = 0; i < fValues.size(); ++i)
+         ReadLazyValue(i);
+      fLazyLoader = nullptr;
+   }
+
    Detail::RFieldValue GetValue(std::string_view fieldName) {
-      for (auto& v : fValues) {
-         if (v.GetField()->GetName() == fieldName)
-            return v;
+      for (std::size_t i = 0; i < fValues.size(); ++i) {
+         if (fValues[i].GetField()->GetName() == fieldName) {
+            ReadLazyValue(i);
+            return fValues[i];
+         }
       }
       return Detail::RFieldValue();
    }
 
    template<typename T>
    T* Get(std::string_view fieldName) {
-      for (auto& v : fValues) {
+      for (std::size_t i = 0; i < fValues.size(); ++i) {
+         auto &v = fValues[i];
          if (v.GetField()->GetName() == fieldName) {
             R__ASSERT(v.GetField()->GetType() == RField<T>::TypeName());
+            ReadLazyValue(i);
             return static_cast<T*>(v.GetRawPtr());
          }
       }
@@ -125,6 +125,15 @@ protected:
    ROOT::Experimental::EColumnType EnsureColumnType(const std::vector<EColumnType> &requestedTypes,
                                                     unsigned int columnIndex, const RNTupleDescriptor &desc);
 
+   /// Whether the columns of this field use the split encodings, see RNTupleWriteOptions::SetUseSplitEncoding().
+   /// Set from the write options by ConnectPageSink().  When reading, GenerateColumnsImpl() sets it according to
+   /// the on-disk column types.
+   bool fUseSplitEncoding = false;
+   /// Adds an offset column of type kIndex, or kSplitIndex if fUseSplitEncoding is set, to fColumns
+   void GenerateIndexColumn(std::uint32_t index = 0);
+   /// Throws if the on-disk column is not an offset column and sets fUseSplitEncoding according to its type
+   void EnsureIndexColumnType(unsigned int columnIndex, const RNTupleDescriptor &desc);
+
 public:
    /// Iterates over the sub tree of fields in depth-first search order
    class RSchemaIterator {
@@ -223,6 +232,18 @@ public:
       fPrincipalColumn->Read(clusterIndex, &value->fMappedElement);
    }
 
+   /// Populate count consecutive values, starting with the memory wrapped by value, in a single call to the principal
+   /// column.  Only valid for simple fields, for which an array of in-memory values is laid out like the column's page.
+   void ReadV(const RClusterIndex &clusterIndex, ClusterSize_t::ValueType count, RFieldValue *value) {
+      R__ASSERT(fIsSimple);
+      fPrincipalColumn->ReadV(clusterIndex, count, &value->fMappedElement);
+   }
+
+   void ReadV(NTupleSize_t globalIndex, ClusterSize_t::ValueType count, RFieldValue *value) {
+      R__ASSERT(fIsSimple);
+      fPrincipalColumn->ReadV(globalIndex, count, &value->fMappedElement);
+   }
+
    /// Ensure that all received items are written from page buffers to the storage.
    void Flush() const;
    /// Perform housekeeping tasks for global to cluster-local index translation
@@ -1380,6 +1401,13 @@ protected:
       RClusterIndex collectionStart;
       fPrincipalColumn->GetCollectionInfo(globalIndex, &collectionStart, &nItems);
       typedValue->resize(nItems);
+      if (fSubFields[0]->IsSimple()) {
+         if (nItems > 0) {
+            auto itemValue = fSubFields[0]->CaptureValue(typedValue->data());
+            fSubFields[0]->ReadV(collectionStart, nItems, &itemValue);
+         }
+         return;
+      }
       for (unsigned i = 0; i < nItems; ++i) {
          auto itemValue = fSubFields[0]->GenerateValue(&typedValue->data()[i]);
          fSubFields[0]->Read(collectionStart + i, &itemValue);
@@ -1403,12 +1431,11 @@ public:
    ~RField() = default;
 
    void GenerateColumnsImpl() final {
-      RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-         Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+      GenerateIndexColumn();
    }
    // TODO(jblomer): update together with RVec 2.0
-   void GenerateColumnsImpl(const RNTupleDescriptor & /*desc*/) final {
+   void GenerateColumnsImpl(const RNTupleDescriptor &desc) final {
+      EnsureIndexColumnType(0, desc);
       GenerateColumnsImpl();
    }
    void DestroyValue(const Detail::RFieldValue& value, bool dtorOnly = false) final {
@@ -1492,12 +1519,11 @@ public:
    ~RField() = default;
 
    void GenerateColumnsImpl() final {
-      RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-         Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+      GenerateIndexColumn();
    }
    // TODO(jblomer): update together with RVec 2.0
-   void GenerateColumnsImpl(const RNTupleDescriptor & /*desc*/) final {
+   void GenerateColumnsImpl(const RNTupleDescriptor &desc) final {
+      EnsureIndexColumnType(0, desc);
       GenerateColumnsImpl();
    }
    void DestroyValue(const Detail::RFieldValue& value, bool dtorOnly = false) final {
@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TCollection;
 class TFile;
@@ -155,6 +156,8 @@ private:
       FILE *fFile = nullptr;
       /// Keeps track of the seek offset
       std::uint64_t fFilePos = 0;
+      /// Set if fFilePos was advanced by Reserve() without writing, so that the stream needs to seek before writing
+      bool fNeedsSeek = false;
       /// Keeps track of TFile control structures, which need to be updated on committing the data set
       std::unique_ptr<ROOT::Experimental::Internal::RTFileControlBlock> fControlBlock;
 
@@ -167,6 +170,8 @@ private:
 
       /// Writes bytes in the open stream, either at fFilePos or at the given offset
       void Write(const void *buffer, size_t nbytes, std::int64_t offset = -1);
+      /// Advances fFilePos by nbytes without writing; returns the offset of the reserved range
+      std::uint64_t Reserve(size_t nbytes);
       /// Writes a TKey including the data record, given by buffer, into fFile; returns the file offset to the payload.
       /// The payload is already compressed
       std::uint64_t WriteKey(const void *buffer, std::size_t nbytes, std::size_t len, std::int64_t offset = -1,
@@ -189,6 +194,8 @@ private:
    std::string fNTupleName;
    /// The file name without parent directory; only required when writing with a C file stream
    std::string fFileName;
+   /// The path used to open the C file stream
+   std::string fFilePath;
    /// Header and footer location of the ntuple, written on Commit()
    RNTuple fNTupleAnchor;
 
@@ -200,6 +207,24 @@ private:
    void WriteBareFileSkeleton(int defaultCompression);
 
 public:
+   /// Writes blobs whose space has been reserved by ReserveBlob() through its own C file stream on the same file.
+   /// The object does not share state with the RNTupleFileWriter, so it can be used from a different thread while
+   /// the writer reserves further blobs.
+   class RReservedBlobWriter {
+   private:
+      FILE *fFile = nullptr;
+
+   public:
+      explicit RReservedBlobWriter(const std::string &path);
+      RReservedBlobWriter(const RReservedBlobWriter &other) = delete;
+      RReservedBlobWriter &operator =(const RReservedBlobWriter &other) = delete;
+      ~RReservedBlobWriter();
+
+      /// Returns false on I/O errors
+      bool Write(const void *buffer, std::size_t nbytes, std::uint64_t offset);
+      bool Flush();
+   };
+
    /// Create or truncate the local file given by path with the new empty RNTuple identified by ntupleName.
    /// Uses a C stream for writing
    static RNTupleFileWriter *Recreate(std::string_view ntupleName, std::string_view path, int defaultCompression,
@@ -223,6 +248,14 @@ public:
    std::uint64_t WriteNTupleFooter(const void *data, size_t nbytes, size_t lenFooter);
    /// Writes a new record as an RBlob key into the file
    std::uint64_t WriteBlob(const void *data, size_t nbytes, size_t len);
+   /// Reserves the space for a new blob at the end of the file without writing anything and returns the offset of
+   /// the blob's payload.  The serialized key of the record, if any, is returned in `key`; it needs to be written
+   /// directly in front of the payload.  Only supported if CanReserveBlobs().
+   std::uint64_t ReserveBlob(size_t nbytes, size_t len, std::vector<unsigned char> &key);
+   /// Reserving blobs requires writing through a C file stream; the TFile keeps its own bookkeeping of free space
+   bool CanReserveBlobs() const { return fFileSimple; }
+   /// Opens an independent stream to fill blobs reserved by ReserveBlob()
+   std::unique_ptr<RReservedBlobWriter> CreateReservedBlobWriter() const;
    /// Writes the RNTuple key to the file so that the header and footer keys can be found
    void Commit();
 };
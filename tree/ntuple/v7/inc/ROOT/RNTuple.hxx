@@ -28,8 +28,11 @@
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 class TFile;
 
@@ -52,6 +55,7 @@ enum class ENTupleInfo {
    kSummary,  // The ntuple name, description, number of entries
    kStorageDetails, // size on storage, page sizes, compression factor, etc.
    kMetrics, // internals performance counters, requires that EnableMetrics() was called
+   kMetricsJSON, // same as kMetrics but as a flat JSON object, for consumption by external tools
 };
 
 /**
@@ -113,8 +117,12 @@ private:
    /// is a clone of the original reader.
    std::unique_ptr<RNTupleReader> fDisplayReader;
    Detail::RNTupleMetrics fMetrics;
+   /// In lazy entry mode, the top-level fields of the model that have been connected on first access
+   std::unordered_set<const Detail::RFieldBase *> fLazyConnectedFields;
 
    void ConnectModel(const RNTupleModel &model);
+   /// Connects the field and its sub fields, unless done before; used in lazy entry mode
+   void ConnectFieldLazily(Detail::RFieldBase &field);
    RNTupleReader *GetDisplayReader();
    void InitPageSource();
 
@@ -244,6 +252,13 @@ public:
    }
    /// Fills a user provided entry after checking that the entry has been instantiated from the ntuple model
    void LoadEntry(NTupleSize_t index, REntry &entry) {
+      if (fSource->GetReadOptions().GetUseLazyEntry()) {
+         entry.SetLazyIndex(index, [this](NTupleSize_t i, Detail::RFieldValue &value) {
+            ConnectFieldLazily(*value.GetField());
+            value.GetField()->Read(i, &value);
+         });
+         return;
+      }
       for (auto& value : entry) {
          value.GetField()->Read(index, &value);
       }
@@ -386,7 +401,7 @@ public:
          value.GetField()->Append(value);
       }
       fNEntries++;
-      if ((fNEntries % fSink->GetWriteOptions().GetNEntriesPerCluster()) == 0)
+      if (fSink->IsClusterFull(fNEntries - fLastCommitted))
          CommitCluster();
    }
    /// Ensure that the data from the so far seen Fill calls has been written to storage
@@ -396,6 +411,100 @@ public:
    const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
 };
 
+class RNTupleParallelWriter;
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleFillContext
+\ingroup NTuple
+\brief A per-thread handle to fill an ntuple that is written by an RNTupleParallelWriter
+
+A fill context has its own clone of the writer's model and its own buffered page sink.  Entries are serialized and
+compressed independently of other fill contexts; only when a cluster is committed, the shared sink of the parallel
+writer is locked and the sealed pages are handed over.  A fill context must only be used by one thread at a time.
+*/
+// clang-format on
+class RNTupleFillContext {
+   friend class RNTupleParallelWriter;
+
+private:
+   /// The page sink's parallel page compression scheduler if IMT is on.
+   /// Needs to be destructed after the page sink is destructed and so declared before.
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fZipTasks;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   NTupleSize_t fLastCommitted = 0;
+   NTupleSize_t fNEntries = 0;
+
+   RNTupleFillContext(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+
+public:
+   RNTupleFillContext(const RNTupleFillContext &) = delete;
+   RNTupleFillContext &operator=(const RNTupleFillContext &) = delete;
+   ~RNTupleFillContext();
+
+   /// Creates an entry for this context's model
+   std::unique_ptr<REntry> CreateEntry() { return fModel->CreateEntry(); }
+   /// Fill the default entry of this context's model
+   void Fill() { Fill(*fModel->GetDefaultEntry()); }
+   /// The entry must have been created by CreateEntry() of this fill context
+   void Fill(REntry &entry) {
+      for (auto& value : entry) {
+         value.GetField()->Append(value);
+      }
+      fNEntries++;
+      if (fSink->IsClusterFull(fNEntries - fLastCommitted))
+         CommitCluster();
+   }
+   /// Seal the pages of the so far seen Fill calls and move them as a cluster to the shared sink
+   void CommitCluster();
+
+   /// Returns the number of entries filled through this context
+   NTupleSize_t GetNEntries() const { return fNEntries; }
+};
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleParallelWriter
+\ingroup NTuple
+\brief An RNTuple that is filled concurrently from multiple threads
+
+Each thread obtains its own RNTupleFillContext by CreateFillContext().  Clusters are committed by the fill contexts
+independently; the order of the clusters on storage is therefore the order in which they were committed and not
+related to the order of the threads.  On destruction, the remaining data of all fill contexts is committed and the
+data set is finalized.  Fill contexts must not be used anymore once the parallel writer is destructed.
+*/
+// clang-format on
+class RNTupleParallelWriter {
+private:
+   /// Protects fSink and fFillContexts
+   std::mutex fMutex;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// The model of the shared sink; fill contexts use clones of it
+   std::unique_ptr<RNTupleModel> fModel;
+   Detail::RNTupleMetrics fMetrics;
+   std::vector<std::weak_ptr<RNTupleFillContext>> fFillContexts;
+
+public:
+   /// Throws an exception if the model is null.
+   static std::unique_ptr<RNTupleParallelWriter> Recreate(std::unique_ptr<RNTupleModel> model,
+                                                          std::string_view ntupleName,
+                                                          std::string_view storage,
+                                                          const RNTupleWriteOptions &options = RNTupleWriteOptions());
+   /// Throws an exception if the model or the sink is null.  The sink must not be a buffered sink.
+   RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+   RNTupleParallelWriter(const RNTupleParallelWriter &) = delete;
+   RNTupleParallelWriter &operator=(const RNTupleParallelWriter &) = delete;
+   ~RNTupleParallelWriter();
+
+   /// Creates a new fill context; thread-safe.
+   std::shared_ptr<RNTupleFillContext> CreateFillContext();
+
+   void EnableMetrics() { fMetrics.Enable(); }
+   const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::RCollectionNTuple
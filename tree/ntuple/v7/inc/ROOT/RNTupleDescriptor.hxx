@@ -26,6 +26,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <vector>
 #include <string>
@@ -188,13 +189,14 @@ public:
       /// The usual format for ROOT compression settings (see Compression.h).
       /// The pages of a particular column in a particular cluster are all compressed with the same settings.
       std::int64_t fCompressionSettings = 0;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      /// Value range of the column in the cluster; only available for numeric columns and if the ntuple was written
+      /// with column statistics (see RNTupleWriteOptions::SetUseColumnStatistics())
+      std::optional<RColumnStatistics> fStatistics;
 
       bool operator==(const RColumnRange &other) const {
          return fColumnId == other.fColumnId && fFirstElementIndex == other.fFirstElementIndex &&
-                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings;
+                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings &&
+                fStatistics == other.fStatistics;
       }
 
       bool Contains(NTupleSize_t index) const {
@@ -211,9 +213,15 @@ public:
          ClusterSize_t fNElements = kInvalidClusterIndex;
          /// The meaning of fLocator depends on the storage backend.
          RLocator fLocator;
+         /// Value range of the page, set under the same conditions as the statistics of the column range
+         std::optional<RColumnStatistics> fStatistics;
+         /// XXH64 hash of the unsealed page content, set if the page was written with page checksums
+         /// (see RNTupleWriteOptions::SetUsePageChecksums())
+         std::optional<std::uint64_t> fChecksum;
 
          bool operator==(const RPageInfo &other) const {
-            return fNElements == other.fNElements && fLocator == other.fLocator;
+            return fNElements == other.fNElements && fLocator == other.fLocator && fStatistics == other.fStatistics &&
+                   fChecksum == other.fChecksum;
          }
       };
       struct RPageInfoExtended : RPageInfo {
@@ -264,8 +272,10 @@ private:
    std::unordered_map<DescriptorId_t, RPageRange> fPageRanges;
 
 public:
-   /// In order to handle changes to the serialization routine in future ntuple versions
-   static constexpr std::uint16_t kFrameVersionCurrent = 0;
+   /// In order to handle changes to the serialization routine in future ntuple versions.
+   /// Version 1 adds the column statistics at the end of the cluster summary, which older readers skip.
+   /// Version 2 adds the page checksums after the column statistics.
+   static constexpr std::uint16_t kFrameVersionCurrent = 2;
    static constexpr std::uint16_t kFrameVersionMin = 0;
 
    RClusterDescriptor() = default;
@@ -285,6 +295,9 @@ public:
    const RPageRange &GetPageRange(DescriptorId_t columnId) const { return fPageRanges.at(columnId); }
    bool ContainsColumn(DescriptorId_t columnId) const;
    std::unordered_set<DescriptorId_t> GetColumnIds() const;
+   /// Returns false only if the statistics of the column prove that none of its values in this cluster is in the
+   /// closed interval [min, max].  Without statistics, the cluster may contain any value.
+   bool MayContainValues(DescriptorId_t columnId, double min, double max) const;
 };
 
 
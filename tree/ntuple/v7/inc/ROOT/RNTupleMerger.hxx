@@ -18,11 +18,18 @@
 
 #include <ROOT/RError.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 
 namespace ROOT {
 namespace Experimental {
 
+namespace Detail {
+class RPageSink;
+class RPageSource;
+}
+
 // clang-format off
 /**
 \class ROOT::Experimental::RFieldMerger
@@ -38,6 +45,30 @@ public:
    static RResult<RFieldMerger> Merge(const RFieldDescriptor &lhs, const RFieldDescriptor &rhs);
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleMerger
+\ingroup NTuple
+\brief Concatenates ntuples with identical schema by copying their sealed pages
+
+The pages are neither decompressed nor unpacked: the merger reads the sealed pages of the sources cluster by cluster
+and commits them unchanged to the destination sink.  This requires that all sources have the same schema and that
+their pages are compressed with the compression settings of the destination.  The equivalent for TTrees is the fast
+cloning of TTreeCloner.
+*/
+// clang-format on
+class RNTupleMerger {
+public:
+   /// Returns write options whose compression and column encoding match the pages of the given attached source.
+   /// A destination sink created with these options can take the sealed pages of the source unchanged.
+   static std::unique_ptr<RNTupleWriteOptions> GetMergeOptions(const Detail::RPageSource &source);
+
+   /// Appends all the entries of the sources, in order, to the destination and commits the dataset.  The sources
+   /// must be attached; the destination must not yet be created.  Throws an RException if the schemas of the sources
+   /// differ or if a page's compression does not match the write options of the destination.
+   void Merge(std::span<Detail::RPageSource *> sources, Detail::RPageSink &destination);
+};
+
 } // namespace Experimental
 } // namespace ROOT
 
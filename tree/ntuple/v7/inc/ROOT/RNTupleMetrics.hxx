@@ -293,6 +293,9 @@ private:
    bool fIsEnabled = false;
 
    bool Contains(const std::string &name) const;
+   /// Recursively collects the enabled counters of this and the observed metrics together with their full names
+   void CollectCounters(const std::string &prefix,
+                        std::vector<std::pair<std::string, const RNTuplePerfCounter *>> &counters) const;
 
 public:
    explicit RNTupleMetrics(const std::string &name) : fName(name) {}
@@ -322,6 +325,9 @@ public:
    void ObserveMetrics(RNTupleMetrics &observee);
 
    void Print(std::ostream &output, const std::string &prefix = "") const;
+   /// Writes a flat JSON object that maps the full counter names to their unit, description and value.
+   /// Values that are not a finite number (e.g. an undefined ratio) are written as null.
+   void PrintJSON(std::ostream &output) const;
    void Enable();
    bool IsEnabled() const { return fIsEnabled; }
 };
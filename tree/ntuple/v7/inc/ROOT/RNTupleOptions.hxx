@@ -19,6 +19,9 @@
 #include <Compression.h>
 #include <ROOT/RNTupleUtil.hxx>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ROOT {
 namespace Experimental {
 
@@ -48,8 +51,16 @@ class RNTupleWriteOptions {
    int fCompression{RCompressionSetting::EDefaults::kUseAnalysis};
    ENTupleContainerFormat fContainerFormat{ENTupleContainerFormat::kTFile};
    NTupleSize_t fNEntriesPerCluster = 64000;
+   std::size_t fApproxUnzippedClusterSize = 0;
+   std::size_t fApproxZippedClusterSize = 0;
    NTupleSize_t fNElementsPerPage = 10000;
    bool fUseBufferedWrite = true;
+   bool fUseAsyncWrite = false;
+   std::size_t fAsyncWriteQueueSize = 2;
+   bool fUseSplitEncoding = false;
+   bool fUseColumnStatistics = false;
+   bool fUsePageBufferPool = false;
+   bool fUsePageChecksums = false;
 
 public:
    virtual ~RNTupleWriteOptions() = default;
@@ -71,8 +82,51 @@ public:
    NTupleSize_t GetNEntriesPerCluster() const { return fNEntriesPerCluster; }
    void SetNEntriesPerCluster(NTupleSize_t val) { fNEntriesPerCluster = val; }
 
+   std::size_t GetApproxUnzippedClusterSize() const { return fApproxUnzippedClusterSize; }
+   /// If non-zero, a cluster is committed as soon as the uncompressed size of its committed pages reaches the given
+   /// number of bytes.  Pages that are still being filled are not accounted for, so a cluster can exceed the target
+   /// by up to one page per column.  The number of entries per cluster remains an upper limit.
+   void SetApproxUnzippedClusterSize(std::size_t val) { fApproxUnzippedClusterSize = val; }
+
+   std::size_t GetApproxZippedClusterSize() const { return fApproxZippedClusterSize; }
+   /// If non-zero, a cluster is committed as soon as its estimated compressed size reaches the given number of
+   /// bytes, similar to a negative TTree::SetAutoFlush().  The compressed size is extrapolated from the uncompressed
+   /// size using the compression ratio of the clusters written so far.
+   void SetApproxZippedClusterSize(std::size_t val) { fApproxZippedClusterSize = val; }
+
    bool GetUseBufferedWrite() const { return fUseBufferedWrite; }
    void SetUseBufferedWrite(bool val) { fUseBufferedWrite = val; }
+
+   bool GetUseAsyncWrite() const { return fUseAsyncWrite; }
+   /// If set, the file sink hands the pages of committed clusters to a background I/O thread, so that filling and
+   /// compressing the next cluster overlaps with writing the previous one.  Only effective when writing to a new
+   /// local file through a C file stream; with a TFile, pages are written synchronously.
+   void SetUseAsyncWrite(bool val) { fUseAsyncWrite = val; }
+
+   std::size_t GetAsyncWriteQueueSize() const { return fAsyncWriteQueueSize; }
+   /// The maximum number of committed clusters that are queued or being written by the background I/O thread.
+   /// When the queue is full, committing another cluster blocks until the oldest one is written.
+   void SetAsyncWriteQueueSize(std::size_t val) { fAsyncWriteQueueSize = val; }
+
+   bool GetUseSplitEncoding() const { return fUseSplitEncoding; }
+   /// If set, columns of floating point and integer fields as well as the offset columns of collections are stored
+   /// with the byte-split (and, for offsets, delta) encodings, which compress better than the plain layout.
+   void SetUseSplitEncoding(bool val) { fUseSplitEncoding = val; }
+
+   bool GetUseColumnStatistics() const { return fUseColumnStatistics; }
+   /// If set, the min/max value range of numeric columns is stored in the footer for every page and cluster.
+   /// Readers can use it to skip clusters that cannot contain entries passing a selection (see RNTupleDS).
+   void SetUseColumnStatistics(bool val) { fUseColumnStatistics = val; }
+
+   bool GetUsePageBufferPool() const { return fUsePageBufferPool; }
+   /// If set, page buffers are taken from and given back to the process-wide RPageAllocatorPool instead of being
+   /// allocated and freed for every page.
+   void SetUsePageBufferPool(bool val) { fUsePageBufferPool = val; }
+
+   bool GetUsePageChecksums() const { return fUsePageChecksums; }
+   /// If set, an XXH64 checksum of the content of every page is stored in the footer.  Readers verify the checksums
+   /// when they unzip clusters in the background (see RNTupleReadOptions::SetVerifyPageChecksums()).
+   void SetUsePageChecksums(bool val) { fUsePageChecksums = val; }
 };
 
 // clang-format off
@@ -114,12 +168,63 @@ public:
       kDefault = kOn,
    };
 
+   /// Value of the maximum coalescing gap that lets the page source select the gap from the page layout
+   static constexpr std::uint64_t kAutoCoalesceGap = std::uint64_t(-1);
+
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
+   std::uint64_t fMaxCoalesceGap = kAutoCoalesceGap;
+   std::uint64_t fMaxReadRequestSize = 0;
+   bool fUseMmap = false;
+   std::size_t fSharedPageCacheSize = 0;
+   bool fUsePageBufferPool = false;
+   bool fUseLazyEntry = false;
+   bool fVerifyPageChecksums = true;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
+
+   std::uint64_t GetMaxCoalesceGap() const { return fMaxCoalesceGap; }
+   /// When loading a cluster, pages that are at most the given number of bytes apart on storage are read with a
+   /// single request; the bytes in between are discarded.  By default (kAutoCoalesceGap), the gap is chosen such
+   /// that no more than 25% extra bytes are read.  A value of zero merges only adjacent pages.
+   void SetMaxCoalesceGap(std::uint64_t val) { fMaxCoalesceGap = val; }
+
+   std::uint64_t GetMaxReadRequestSize() const { return fMaxReadRequestSize; }
+   /// Coalesced read requests do not grow beyond the given number of bytes; zero means no limit.  Single pages
+   /// larger than the limit are still read in one request.
+   void SetMaxReadRequestSize(std::uint64_t val) { fMaxReadRequestSize = val; }
+
+   bool GetUseMmap() const { return fUseMmap; }
+   /// If the storage supports it (local files), memory-map the file instead of reading clusters into buffers.
+   /// Uncompressed pages of columns whose in-memory and on-disk layout match are then used in place without a copy.
+   /// Has no effect if the file cannot be memory-mapped.
+   void SetUseMmap(bool val) { fUseMmap = val; }
+
+   std::size_t GetSharedPageCacheSize() const { return fSharedPageCacheSize; }
+   /// If non-zero, unzipped pages are kept in a process-wide page cache that is shared by all the readers of the
+   /// same ntuple (including the ntuples read through friends) with this option set.  Pages that are not in use
+   /// anymore are evicted in least-recently-used order when they exceed the given number of bytes.  The limit is
+   /// a property of the shared cache; the last reader attaching with this option determines it.
+   void SetSharedPageCacheSize(std::size_t val) { fSharedPageCacheSize = val; }
+
+   bool GetUsePageBufferPool() const { return fUsePageBufferPool; }
+   /// If set, the buffers of unzipped pages are taken from and given back to the process-wide RPageAllocatorPool
+   /// instead of being allocated and freed for every page.
+   void SetUsePageBufferPool(bool val) { fUsePageBufferPool = val; }
+
+   bool GetUseLazyEntry() const { return fUseLazyEntry; }
+   /// If set, RNTupleReader::LoadEntry() only records the entry index and the entry values are read the first time
+   /// they are accessed through REntry::Get() or REntry::GetValue().  The fields of the model are connected to the
+   /// page source on first access, too, so that the columns of fields that are never accessed are not read.
+   void SetUseLazyEntry(bool val) { fUseLazyEntry = val; }
+
+   bool GetVerifyPageChecksums() const { return fVerifyPageChecksums; }
+   /// If set and the ntuple has been written with page checksums, the pages are verified when they are unzipped.
+   /// With implicit multi-threading and the cluster cache, this happens in the tasks that unzip the clusters in the
+   /// background, off the reading thread.  Reading a page with a mismatching checksum throws an exception.
+   void SetVerifyPageChecksums(bool val) { fVerifyPageChecksums = val; }
 };
 
 } // namespace Experimental
@@ -16,7 +16,10 @@
 #ifndef ROOT7_RNTupleUtil
 #define ROOT7_RNTupleUtil
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 
 #include <string>
 
@@ -138,6 +141,37 @@ public:
    ClusterSize_t::ValueType GetIndex() const { return fIndex; }
 };
 
+/// Value range of the elements of a numeric column in a page or a cluster, used to skip data in selections.
+/// Values are converted to double, which is exact for all types except 64bit integers beyond 2^53.
+/// NaN values are only counted, they don't contribute to the min/max range.
+struct RColumnStatistics {
+   double fMin = std::numeric_limits<double>::infinity();
+   double fMax = -std::numeric_limits<double>::infinity();
+   std::uint64_t fNNaN = 0;
+
+   void Update(double value) {
+      if (std::isnan(value)) {
+         fNNaN++;
+         return;
+      }
+      if (value < fMin)
+         fMin = value;
+      if (value > fMax)
+         fMax = value;
+   }
+   void Merge(const RColumnStatistics &other) {
+      fMin = std::min(fMin, other.fMin);
+      fMax = std::max(fMax, other.fMax);
+      fNNaN += other.fNNaN;
+   }
+   /// Returns false only if none of the non-NaN values can be in the closed interval [min, max]
+   bool Overlaps(double min, double max) const { return (fMin <= max) && (fMax >= min); }
+
+   bool operator==(const RColumnStatistics &other) const {
+      return fMin == other.fMin && fMax == other.fMax && fNNaN == other.fNNaN;
+   }
+};
+
 /// Every NTuple is identified by a UUID.  TODO(jblomer): should this be a TUUID?
 using RNTupleUuid = std::string;
 
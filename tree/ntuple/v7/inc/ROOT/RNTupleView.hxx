@@ -18,8 +18,10 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -215,6 +217,32 @@ public:
    MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) {
       return fField.MapV(clusterIndex, nItems);
    }
+
+   /// Zero-copy bulk access: returns the elements from globalIndex up to the end of the page that contains
+   /// globalIndex, but no more than maxItems elements.  Ranges spanning several pages take one call per page:
+   /// ~~~ {.cpp}
+   /// for (auto i = first; i < last;) {
+   ///    auto values = view.MapSpan(i, last - i);
+   ///    // ... process values ...
+   ///    i += values.size();
+   /// }
+   /// ~~~
+   /// The span stays valid until the view accesses another page.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapSpan(NTupleSize_t globalIndex, NTupleSize_t maxItems = kInvalidNTupleIndex) {
+      NTupleSize_t nItems = 0;
+      auto buffer = fField.MapV(globalIndex, nItems);
+      return std::span<const C>(buffer, std::min(nItems, maxItems));
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapSpan(const RClusterIndex &clusterIndex, NTupleSize_t maxItems = kInvalidNTupleIndex) {
+      NTupleSize_t nItems = 0;
+      auto buffer = fField.MapV(clusterIndex, nItems);
+      return std::span<const C>(buffer, std::min(nItems, maxItems));
+   }
 };
 
 
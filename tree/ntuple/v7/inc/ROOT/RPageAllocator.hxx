@@ -19,8 +19,12 @@
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RPage.hxx>
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -77,6 +81,66 @@ public:
    static void DeletePage(const RPage &page);
 };
 
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageAllocatorPool
+\ingroup NTuple
+\brief Recycles page buffers instead of returning them to the heap
+
+Buffer sizes are rounded up to the next power of two.  Released buffers are kept in a free list per size class and
+handed out again by subsequent allocations of the same size class, as long as the total size of the kept buffers
+does not exceed a limit.  All buffers are aligned to kAlignment bytes, which is suitable for vector instructions
+and direct I/O.  The pool is thread-safe.
+*/
+// clang-format on
+class RPageAllocatorPool {
+public:
+   static constexpr std::size_t kAlignment = 4096;
+   static constexpr std::size_t kDefaultMaxCachedBytes = 256 * 1024 * 1024;
+
+private:
+   /// Buffers of size class i have 2^i bytes
+   static constexpr std::size_t kNSizeClasses = 64;
+
+   std::array<std::vector<void *>, kNSizeClasses> fFreeLists;
+   std::size_t fMaxCachedBytes = kDefaultMaxCachedBytes;
+   /// Total size of the buffers in the free lists
+   std::size_t fCachedBytes = 0;
+   std::uint64_t fNAllocations = 0;
+   std::uint64_t fNRecycled = 0;
+   std::mutex fLock;
+
+   static std::size_t GetSizeClass(std::size_t nbytes);
+
+public:
+   /// The process-wide pool used by the page sources and sinks with the page buffer pool option set.  It is never
+   /// destructed so that it outlives any page cache.
+   static RPageAllocatorPool &Instance();
+
+   RPageAllocatorPool() = default;
+   RPageAllocatorPool(const RPageAllocatorPool &) = delete;
+   RPageAllocatorPool &operator=(const RPageAllocatorPool &) = delete;
+   ~RPageAllocatorPool();
+
+   /// Returns a buffer of at least nbytes bytes
+   void *Allocate(std::size_t nbytes);
+   /// Gives back a buffer obtained from Allocate() with the same nbytes
+   void Release(void *buffer, std::size_t nbytes);
+
+   /// Like RPageAllocatorHeap::NewPage() but with a recycled buffer, if available
+   RPage NewPage(ColumnId_t columnId, std::size_t elementSize, std::size_t nElements);
+   /// Gives back the buffer of a page that has the capacity set by NewPage()
+   void DeletePage(const RPage &page);
+
+   void SetMaxCachedBytes(std::size_t maxCachedBytes);
+   std::size_t GetCachedBytes();
+   /// Number of calls to Allocate(), including the ones served from the free lists
+   std::uint64_t GetNAllocations();
+   /// Number of calls to Allocate() served from the free lists
+   std::uint64_t GetNRecycled();
+};
+
 } // namespace Detail
 } // namespace Experimental
 } // namespace ROOT
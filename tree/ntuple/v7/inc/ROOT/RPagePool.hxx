@@ -21,7 +21,11 @@
 #include <ROOT/RNTupleUtil.hxx>
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ROOT {
@@ -40,6 +44,11 @@ pages is thread-safe. The page pool does not allocate the memory -- allocation a
 page storage, which might do it in a way optimized to the backing store (e.g., mmap()).
 Multiple page caches can coexist.
 
+Pages are tagged with a storage id, so that a single pool can be shared by page sources reading different ntuples
+(see GetSharedPool()).  A pool with an unused bytes limit (SetMaxUnusedBytes()) keeps pages whose reference counter
+dropped to zero and evicts them in least-recently-used order once the limit is exceeded.  Without a limit, such pages
+are freed immediately.
+
 TODO(jblomer): it should be possible to register pages and to find them by column and index; this would
 facilitate pre-filling a cache, e.g. by read-ahead.
 */
@@ -54,27 +63,62 @@ private:
    std::vector<RPage> fPages;
    std::vector<std::int32_t> fReferences;
    std::vector<RPageDeleter> fDeleters;
+   std::vector<std::uint64_t> fStorageIds;
+   /// Value of fClock when the page was last handed out or returned; used for LRU eviction
+   std::vector<std::uint64_t> fLastUse;
+   std::uint64_t fClock = 0;
+   /// Zero means that unused pages are not kept, as opposed to an unlimited cache
+   std::size_t fMaxUnusedBytes = 0;
+   /// Sum of the page sizes of all the pages with a reference counter of zero
+   std::size_t fUnusedBytes = 0;
+   /// Maps the storage keys given to GetStorageId() to the storage ids
+   std::unordered_map<std::string, std::uint64_t> fStorageKeys;
    std::mutex fLock;
 
+   /// Removes the page with the given index, calling its deleter. Requires the lock to be held.
+   void ErasePage(std::size_t idx);
+   /// Drops the least recently used unused pages until the unused pages fit fMaxUnusedBytes.  Requires the lock.
+   void EvictUnused();
+   /// Common implementation of RegisterPage() and PreloadPage()
+   void AddPage(const RPage &page, const RPageDeleter &deleter, std::int32_t references, std::uint64_t storageId);
+
 public:
    RPagePool() = default;
    RPagePool(const RPagePool&) = delete;
    RPagePool& operator =(const RPagePool&) = delete;
-   ~RPagePool() = default;
+   /// Frees the pages that are not referenced anymore
+   ~RPagePool();
+
+   /// The process-wide page pool shared by the page sources that have the shared page cache enabled
+   static std::shared_ptr<RPagePool> GetSharedPool();
+
+   /// Returns a storage id for the given key, e.g. a file name together with the ntuple's anchor.  The same key
+   /// results in the same id.  Storage ids are larger than zero; zero is used for pages not tagged with a storage id.
+   std::uint64_t GetStorageId(const std::string &key);
+   /// Unused pages exceeding the given number of bytes are evicted, least recently used first.  Zero (default) frees
+   /// pages as soon as their reference counter drops to zero.
+   void SetMaxUnusedBytes(std::size_t maxUnusedBytes);
+   std::size_t GetMaxUnusedBytes() const { return fMaxUnusedBytes; }
+   std::size_t GetUnusedBytes();
+   std::size_t GetNPages();
 
    /// Adds a new page to the pool together with the function to free its space. Upon registration,
    /// the page pool takes ownership of the page's memory. The new page has its reference counter set to 1.
-   void RegisterPage(const RPage &page, const RPageDeleter &deleter);
+   void RegisterPage(const RPage &page, const RPageDeleter &deleter, std::uint64_t storageId = 0);
    /// Like RegisterPage() but the reference counter is initialized to 0
-   void PreloadPage(const RPage &page, const RPageDeleter &deleter);
+   void PreloadPage(const RPage &page, const RPageDeleter &deleter, std::uint64_t storageId = 0);
    /// Tries to find the page corresponding to column and index in the cache. If the page is found, its reference
    /// counter is increased
-   RPage GetPage(ColumnId_t columnId, NTupleSize_t globalIndex);
-   RPage GetPage(ColumnId_t columnId, const RClusterIndex &clusterIndex);
+   RPage GetPage(ColumnId_t columnId, NTupleSize_t globalIndex, std::uint64_t storageId = 0);
+   RPage GetPage(ColumnId_t columnId, const RClusterIndex &clusterIndex, std::uint64_t storageId = 0);
+   /// Checks for a page without changing its reference counter
+   bool ContainsPage(ColumnId_t columnId, const RClusterIndex &clusterIndex, std::uint64_t storageId = 0);
    /// Give back a page to the pool and decrease the reference counter. There must not be any pointers anymore into
    /// this page. If the reference counter drops to zero, the page pool might decide to call the deleter given in
    /// during registration.
    void ReturnPage(const RPage &page);
+   /// Like ReturnPage() but returns false instead of failing if the page is not managed by this pool
+   bool TryReturnPage(const RPage &page);
 };
 
 } // namespace Detail
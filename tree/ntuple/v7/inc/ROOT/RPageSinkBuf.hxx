@@ -33,6 +33,10 @@ namespace Detail {
 \class ROOT::Experimental::Detail::RPageSinkBuf
 \ingroup NTuple
 \brief Wrapper sink that coalesces cluster column page writes
+
+If a task scheduler is set (i.e., with IMT enabled), pages are sealed concurrently as they are committed; the sealing
+tasks run in ROOT's task arena. On CommitCluster(), the sealed pages are passed to the inner sink column by column,
+in the order in which they were committed.
 */
 // clang-format on
 class RPageSinkBuf : public RPageSink {
@@ -46,6 +50,8 @@ private:
          // Compression scratch buffer for fSealedPage.
          std::unique_ptr<unsigned char[]> fBuf;
          RPageStorage::RSealedPage fSealedPage;
+         /// Index of the page in the open page range of the buffered sink, which holds the page's statistics
+         std::size_t fPageInfoIndex = 0;
          explicit RPageZipItem(RPage page)
             : fPage(page), fBuf(nullptr) {}
          bool IsSealed() const {
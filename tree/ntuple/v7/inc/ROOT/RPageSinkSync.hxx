@@ -0,0 +1,69 @@
+/// \file ROOT/RPageSinkSync.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2021-06-14
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSinkSync
+#define ROOT7_RPageSinkSync
+
+#include <ROOT/RPageStorage.hxx>
+
+#include <mutex>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageSynchronizingSink
+\ingroup NTuple
+\brief A page sink that forwards sealed pages and clusters to a shared, synchronized sink
+
+Used by RNTupleFillContext: every fill context owns an RPageSinkBuf wrapping one of these sinks. The buffered sink
+seals its pages locally and only takes the guard returned by GetSinkGuard() to move the finished cluster to the
+shared inner sink. Pages are allocated from the heap so that reserving and releasing pages does not touch the
+shared sink. Cluster entry numbers are translated from the local count of the fill context into the global count of
+the shared sink.
+*/
+// clang-format on
+class RPageSynchronizingSink : public RPageSink {
+private:
+   /// The wrapped inner sink, not owned by this class
+   RPageSink *fInnerSink;
+   /// Protects fInnerSink; shared by all the synchronizing sinks of the same inner sink
+   std::mutex *fMutex;
+
+protected:
+   void CreateImpl(const RNTupleModel &) final {}
+   RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
+   RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
+   void CommitDatasetImpl() final {}
+
+public:
+   RPageSynchronizingSink(RPageSink &inner, std::mutex &mutex);
+   RPageSynchronizingSink(const RPageSynchronizingSink &) = delete;
+   RPageSynchronizingSink &operator=(const RPageSynchronizingSink &) = delete;
+   virtual ~RPageSynchronizingSink() = default;
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) final;
+   void ReleasePage(RPage &page) final;
+
+   RSinkGuard GetSinkGuard() final { return RSinkGuard(fMutex); }
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
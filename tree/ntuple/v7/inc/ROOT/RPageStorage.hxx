@@ -28,7 +28,13 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
 #include <unordered_set>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -83,6 +89,10 @@ public:
       const void *fBuffer = nullptr;
       std::uint32_t fSize = 0;
       std::uint32_t fNElements = 0;
+      /// Optionally the value range of the page, which is forwarded to the descriptor on committing the sealed page
+      std::optional<RColumnStatistics> fStatistics;
+      /// Optionally the checksum of the unsealed page, which is forwarded to the descriptor like the statistics
+      std::optional<std::uint64_t> fChecksum;
 
       RSealedPage() = default;
       RSealedPage(const void *b, std::uint32_t s, std::uint32_t n) : fBuffer(b), fSize(s), fNElements(n) {}
@@ -150,6 +160,30 @@ up to the given entry number are committed.
 */
 // clang-format on
 class RPageSink : public RPageStorage {
+public:
+   /// An RAII wrapper used to synchronize a page sink. See GetSinkGuard().
+   class RSinkGuard {
+      std::mutex *fLock;
+
+   public:
+      explicit RSinkGuard(std::mutex *lock) : fLock(lock)
+      {
+         if (fLock != nullptr) {
+            fLock->lock();
+         }
+      }
+      RSinkGuard(const RSinkGuard &) = delete;
+      RSinkGuard &operator=(const RSinkGuard &) = delete;
+      RSinkGuard(RSinkGuard &&other) : fLock(other.fLock) { other.fLock = nullptr; }
+      RSinkGuard &operator=(RSinkGuard &&) = delete;
+      ~RSinkGuard()
+      {
+         if (fLock != nullptr) {
+            fLock->unlock();
+         }
+      }
+   };
+
 protected:
    /// Default I/O performance counters that get registered in fMetrics
    struct RCounters {
@@ -177,6 +211,11 @@ protected:
    DescriptorId_t fLastColumnId = 0;
    DescriptorId_t fLastClusterId = 0;
    NTupleSize_t fPrevClusterNEntries = 0;
+   /// Uncompressed size of the pages committed to the currently open cluster
+   std::uint64_t fNBytesOpenCluster = 0;
+   /// Uncompressed and compressed sizes of the committed clusters; used to estimate the compression ratio
+   std::uint64_t fNBytesUnzippedCommitted = 0;
+   std::uint64_t fNBytesZippedCommitted = 0;
    /// Keeps track of the number of elements in the currently open cluster. Indexed by column id.
    std::vector<RClusterDescriptor::RColumnRange> fOpenColumnRanges;
    /// Keeps track of the written pages in the currently open cluster. Indexed by column id.
@@ -244,6 +283,36 @@ public:
    void CommitCluster(NTupleSize_t nEntries);
    /// Finalize the current cluster and the entrire data set.
    void CommitDataset() { CommitDatasetImpl(); }
+   /// Returns the number of entries committed so far, i.e. the entry number passed to the last CommitCluster()
+   NTupleSize_t GetNCommittedEntries() const { return fPrevClusterNEntries; }
+   /// Returns the uncompressed size of the pages committed so far to the currently open cluster
+   std::uint64_t GetNBytesOpenCluster() const { return fNBytesOpenCluster; }
+   /// Returns the total compressed size of the committed clusters as recorded in their locators
+   std::uint64_t GetNBytesZippedCommitted() const { return fNBytesZippedCommitted; }
+   /// Returns true if the open cluster with the given number of entries reached one of the cluster size limits set
+   /// in the write options, i.e. at the number of entries per cluster or at the approximate (un)compressed size
+   bool IsClusterFull(NTupleSize_t nEntriesInCluster) const
+   {
+      if (nEntriesInCluster >= fOptions->GetNEntriesPerCluster())
+         return true;
+      const auto maxUnzipped = fOptions->GetApproxUnzippedClusterSize();
+      if (maxUnzipped > 0 && fNBytesOpenCluster >= maxUnzipped)
+         return true;
+      const auto maxZipped = fOptions->GetApproxZippedClusterSize();
+      return maxZipped > 0 && (double(fNBytesOpenCluster) * GetCompressionFactor() >= double(maxZipped));
+   }
+   /// Estimated ratio of compressed to uncompressed bytes, based on the committed clusters; 1 if nothing is known
+   double GetCompressionFactor() const
+   {
+      if (fNBytesUnzippedCommitted == 0 || fNBytesZippedCommitted == 0)
+         return 1.0;
+      return double(fNBytesZippedCommitted) / double(fNBytesUnzippedCommitted);
+   }
+
+   /// Get a guard that must be held while committing sealed pages and clusters. Sinks that are shared between
+   /// several writers (see RPageSynchronizingSink) return a guard that locks the shared sink; a plain sink returns
+   /// a no-op guard.
+   virtual RSinkGuard GetSinkGuard() { return RSinkGuard(nullptr); }
 
    /// Get a new, empty page for the given column that can be filled with up to nElements.  If nElements is zero,
    /// the page sink picks an appropriate size.
@@ -268,6 +337,15 @@ public:
    /// Derived from the model (fields) that are actually being requested at a given point in time
    using ColumnSet_t = std::unordered_set<DescriptorId_t>;
 
+   /// The entries [fFirstEntry, fFirstEntry + fNEntries) that are expected to be read next
+   struct REntryRange {
+      NTupleSize_t fFirstEntry = 0;
+      NTupleSize_t fNEntries = kInvalidNTupleIndex;
+
+      /// Returns true if the cluster has at least one entry in the range
+      bool IntersectsWith(const RClusterDescriptor &clusterDesc) const;
+   };
+
 protected:
    /// Default I/O performance counters that get registered in fMetrics
    struct RCounters {
@@ -279,6 +357,7 @@ protected:
       RNTupleAtomicCounter &fNClusterLoaded;
       RNTupleAtomicCounter &fNPageLoaded;
       RNTupleAtomicCounter &fNPagePopulated;
+      RNTupleAtomicCounter &fNPageCorrupt;
       RNTupleAtomicCounter &fTimeWallRead;
       RNTupleAtomicCounter &fTimeWallUnzip;
       RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuRead;
@@ -293,10 +372,42 @@ protected:
    /// Wraps the I/O counters and is observed by the RNTupleReader metrics
    RNTupleMetrics fMetrics;
 
+   /// Per-column I/O counters.  They are created by AddColumn() in a metrics object named `column<id>`,
+   /// which is observed by fMetrics.
+   class RColumnCounters {
+   public:
+      RNTupleMetrics fMetrics;
+      RNTupleAtomicCounter &fSzReadPayload;
+      RNTupleAtomicCounter &fNPageUnzipped;
+      RNTupleAtomicCounter &fTimeWallUnzip;
+      RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuUnzip;
+      RNTupleAtomicCounter &fTimeWallPopulate;
+      RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuPopulate;
+
+      RColumnCounters(DescriptorId_t columnId, const std::string &fieldName);
+   };
+   /// Indexed by column id; sized on Attach() and only filled, never resized, afterwards so that concurrent
+   /// readers (e.g. the unzip tasks) can safely look up the counters of other columns
+   std::vector<std::unique_ptr<RColumnCounters>> fColumnCounters;
+   /// Returns nullptr if the column has not been added
+   RColumnCounters *GetColumnCounters(DescriptorId_t columnId) const
+   {
+      return (columnId < fColumnCounters.size()) ? fColumnCounters[columnId].get() : nullptr;
+   }
+
    RNTupleReadOptions fOptions;
    RNTupleDescriptor fDescriptor;
    /// The active columns are implicitly defined by the model fields or views
    ColumnSet_t fActiveColumns;
+   /// By default, the entire ntuple
+   REntryRange fEntryRange;
+
+   /// (column id, cluster id, page number) of the pages whose checksum did not match when they were unzipped
+   std::set<std::tuple<DescriptorId_t, DescriptorId_t, NTupleSize_t>> fCorruptPages;
+   /// Protects fCorruptPages, which is filled by the unzip tasks
+   std::mutex fLockCorruptPages;
+   /// Saves the lock on the common path where no corrupt page has been found
+   std::atomic<bool> fHasCorruptPages{false};
 
    /// Helper to unzip pages and header/footer; comprises a 16MB (kMAXZIPBUF) unzip buffer.
    /// Not all page sources need a decompressor (e.g. virtual ones for chains and friends don't), thus we
@@ -313,6 +424,18 @@ protected:
    /// The optimization of directly mapping pages is left to the concrete page source implementations.
    /// Usage of this method requires construction of fDecompressor.
    std::unique_ptr<unsigned char []> UnsealPage(const RSealedPage &sealedPage, const RColumnElementBase &element);
+   /// Like the other overload but unseals into the given buffer, which must be large enough to hold
+   /// sealedPage.fNElements in-memory elements
+   void UnsealPage(const RSealedPage &sealedPage, const RColumnElementBase &element, void *pageBuffer);
+
+   /// Called for an unsealed page of nBytes, usually by the unzip tasks.  If the page has a checksum and checksum
+   /// verification is enabled, compares the checksum to the page content.  On mismatch, the page is recorded as
+   /// corrupt and false is returned; the page must then not be added to the page pool.
+   bool VerifyPageChecksum(DescriptorId_t columnId, DescriptorId_t clusterId, NTupleSize_t pageNo,
+                           const std::optional<std::uint64_t> &checksum, const void *buffer, std::size_t nBytes);
+   /// Throws an RException if the page has been recorded as corrupt by VerifyPageChecksum().  To be called by
+   /// PopulatePage() before a page of a cached cluster is unzipped on demand and after a failed verification.
+   void EnsurePageIntegrity(DescriptorId_t columnId, DescriptorId_t clusterId, NTupleSize_t pageNo);
 
    /// Enables the default set of metrics provided by RPageSource. `prefix` will be used as the prefix for
    /// the counters registered in the internal RNTupleMetrics object.
@@ -342,9 +465,20 @@ public:
    void DropColumn(ColumnHandle_t columnHandle) override;
 
    /// Open the physical storage container for the tree
-   void Attach() { fDescriptor = AttachImpl(); }
+   void Attach()
+   {
+      fDescriptor = AttachImpl();
+      // The counters are observed by fMetrics and are thus never destructed before the page source
+      if (fColumnCounters.size() < fDescriptor.GetNColumns())
+         fColumnCounters.resize(fDescriptor.GetNColumns());
+   }
    NTupleSize_t GetNEntries();
    NTupleSize_t GetNElements(ColumnHandle_t columnHandle);
+   /// Promises to only read the entries in the given range until the next call, e.g. when processing one task of a
+   /// multi-threaded event loop.  Read-ahead does not go beyond the clusters of the range.  Reading other entries
+   /// is still possible but does not benefit from read-ahead.
+   void SetEntryRange(const REntryRange &range) { fEntryRange = range; }
+   const REntryRange &GetEntryRange() const { return fEntryRange; }
    ColumnId_t GetColumnId(ColumnHandle_t columnHandle);
 
    /// Allocates and fills a page that contains the index-th element
@@ -24,6 +24,7 @@
 #include <atomic>
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace ROOT {
@@ -85,6 +86,8 @@ struct RDaosNTupleAnchor {
 \brief Storage provider that writes ntuple pages to into a DAOS container
 
 Currently, an object is allocated for each page + 3 additional objects (anchor/header/footer).
+The pages of a cluster are written together on committing the cluster, using a single batch of asynchronous
+DAOS updates.
 */
 // clang-format on
 class RPageSinkDaos : public RPageSink {
@@ -103,6 +106,19 @@ private:
 
    RDaosNTupleAnchor fNTupleAnchor;
 
+   /// A sealed page that has been assigned an OID but that is not yet written
+   struct RPendingPage {
+      std::uint64_t fOid = 0;
+      std::unique_ptr<unsigned char[]> fBuffer;
+      std::size_t fSize = 0;
+   };
+   /// The pages of the current cluster; written by WritePendingPages()
+   std::vector<RPendingPage> fPendingPages;
+   std::mutex fLockPendingPages;
+
+   /// Writes all pending pages with a single RDaosContainer::WriteV() call
+   void WritePendingPages();
+
 protected:
    void CreateImpl(const RNTupleModel &model) final;
    RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
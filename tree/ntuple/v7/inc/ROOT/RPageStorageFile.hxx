@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 class TFile;
 
@@ -54,6 +55,14 @@ The written file can be either in ROOT format or in RNTuple bare format.
 // clang-format on
 class RPageSinkFile : public RPageSink {
 private:
+   /// A contiguous range of the file, containing the keys and the sealed pages of a committed cluster
+   struct RWriteBatch {
+      std::uint64_t fOffset = 0;
+      std::vector<unsigned char> fBuffer;
+   };
+   /// Background I/O thread with a bounded queue of write batches, used if async writing is requested
+   class RAsyncWriter;
+
    std::unique_ptr<RPageAllocatorHeap> fPageAllocator;
 
    std::unique_ptr<Internal::RNTupleFileWriter> fWriter;
@@ -61,6 +70,12 @@ private:
    std::uint64_t fClusterMinOffset = std::uint64_t(-1);
    /// Byte offset of the end of the last page of the current cluster
    std::uint64_t fClusterMaxOffset = 0;
+   /// Only set for async writing; pages are then copied into fOpenBatch and written when the cluster is committed.
+   /// Space for the pages is reserved right away, so that the page locators are known when the page is committed.
+   std::unique_ptr<RAsyncWriter> fAsyncWriter;
+   RWriteBatch fOpenBatch;
+   /// Reused buffer for the serialized key of a reserved page blob
+   std::vector<unsigned char> fKeyBuffer;
    RPageSinkFile(std::string_view ntupleName, const RNTupleWriteOptions &options);
 
    RClusterDescriptor::RLocator WriteSealedPage(const RPageStorage::RSealedPage &sealedPage,
@@ -119,8 +134,13 @@ public:
 private:
    /// Populated pages might be shared; there memory buffer is managed by the RPageAllocatorFile
    std::unique_ptr<RPageAllocatorFile> fPageAllocator;
-   /// The page pool might, at some point, be used by multiple page sources
+   /// Holds the pages that are specific to this page source, i.e. all pages unless the shared page cache is used.
+   /// Pages pointing into the mapped file always stay here.
    std::shared_ptr<RPagePool> fPagePool;
+   /// If the shared page cache is enabled, unzipped pages are registered with the process-wide page pool
+   std::shared_ptr<RPagePool> fSharedPagePool;
+   /// Identifies the pages of this ntuple in fSharedPagePool; set on attaching
+   std::uint64_t fSharedPoolStorageId = 0;
    /// The last cluster from which a page got populated.  Points into fClusterPool->fPool
    RCluster *fCurrentCluster = nullptr;
    /// An RRawFile is used to request the necessary byte ranges from a local or a remote file
@@ -129,10 +149,28 @@ private:
    Internal::RMiniFileReader fReader;
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
+   /// If mmap mode is used, the entire file is mapped on attaching; on-disk pages and, where possible, populated
+   /// pages point directly into the mapped region.  The mapping lives as long as the page source.
+   void *fMappedFile = nullptr;
+   std::size_t fMappedSize = 0;
 
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
+   /// Maps the file if mmap mode is requested and supported by fFile
+   void MapFile();
+   /// Returns a page whose buffer points into the mapped file if the sealed page can be used in place, i.e. it is
+   /// uncompressed, the element is mappable and the buffer is suitably aligned. Otherwise returns a null page.
+   RPage TryMapPage(DescriptorId_t columnId, const void *sealedBuffer, std::uint32_t bytesOnStorage,
+                    const RColumnElementBase &element, ClusterSize_t::ValueType nElements);
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType idxInCluster);
+   /// Looks up a page first in the local and then in the shared page pool
+   template <typename IndexT>
+   RPage GetCachedPage(ColumnId_t columnId, const IndexT &index);
+   /// Returns a new buffer with the unsealed page, allocated from the page buffer pool if the read options say so
+   void *UnsealToNewBuffer(const RSealedPage &sealedPage, const RColumnElementBase &element);
+   /// Hands over a page with a buffer from UnsealToNewBuffer() to the shared page pool, if in use, or to the local
+   /// pool
+   void AddUnzippedPage(const RPage &page, bool isPreload);
 
 protected:
    RNTupleDescriptor AttachImpl() final;
@@ -16,6 +16,7 @@
 #include <ROOT/RClusterPool.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RPageStorage.hxx>
+#include <ROOT/RTrace.hxx>
 
 #include <TError.h>
 
@@ -50,7 +51,13 @@ bool ROOT::Experimental::Detail::RClusterPool::RInFlightCluster::operator <(cons
 ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int size)
    : fPageSource(pageSource)
    , fPool(size)
-   , fThreadIo(&RClusterPool::ExecReadClusters, this)
+   , fMetrics("RClusterPool")
+   , fCounters(std::unique_ptr<RCounters>(new RCounters{
+        *fMetrics.MakeCounter<RNTupleAtomicCounter *>("nReadAheadHit", "",
+                                                      "number of cluster requests served from the pool"),
+        *fMetrics.MakeCounter<RNTupleAtomicCounter *>("nReadAheadMiss", "",
+                                                      "number of cluster requests that waited for I/O")}))
+   , fIOTaskPool(ROOT::Internal::GetIOTaskPool())
    , fThreadUnzip(&RClusterPool::ExecUnzipClusters, this)
 {
    R__ASSERT(size > 0);
@@ -65,13 +72,9 @@ ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource,
 
 ROOT::Experimental::Detail::RClusterPool::~RClusterPool()
 {
-   {
-      // Controlled shutdown of the I/O thread
-      std::unique_lock<std::mutex> lock(fLockWorkQueue);
-      fReadQueue.emplace(RReadItem());
-      fCvHasReadWork.notify_one();
-   }
-   fThreadIo.join();
+   // The last submitted I/O task is the only one that can still access the pool
+   if (fReadTask.valid())
+      fReadTask.wait();
 
    {
       // Controlled shutdown of the unzip thread
@@ -99,7 +102,10 @@ void ROOT::Experimental::Detail::RClusterPool::ExecUnzipClusters()
          if (!item.fCluster)
             return;
 
-         fPageSource.UnzipCluster(item.fCluster.get());
+         {
+            R__TRACE_SPAN("ntuple", "RClusterPool unzip");
+            fPageSource.UnzipCluster(item.fCluster.get());
+         }
 
          // Afterwards the GetCluster() method in the main thread can pick-up the cluster
          item.fPromise.set_value(std::move(item.fCluster));
@@ -113,7 +119,10 @@ void ROOT::Experimental::Detail::RClusterPool::ExecReadClusters()
       std::vector<RReadItem> readItems;
       {
          std::unique_lock<std::mutex> lock(fLockWorkQueue);
-         fCvHasReadWork.wait(lock, [&]{ return !fReadQueue.empty(); });
+         if (fReadQueue.empty()) {
+            fIsReading = false;
+            return;
+         }
          while (!fReadQueue.empty()) {
             readItems.emplace_back(std::move(fReadQueue.front()));
             fReadQueue.pop();
@@ -121,11 +130,12 @@ void ROOT::Experimental::Detail::RClusterPool::ExecReadClusters()
       }
 
       for (auto &item : readItems) {
-         if (item.fClusterId == kInvalidDescriptorId)
-            return;
-
          // TODO(jblomer): the page source needs to be capable of loading multiple clusters in one go
-         auto cluster = fPageSource.LoadCluster(item.fClusterId, item.fColumns);
+         std::unique_ptr<RCluster> cluster;
+         {
+            R__TRACE_SPAN("ntuple", "RClusterPool read");
+            cluster = fPageSource.LoadCluster(item.fClusterId, item.fColumns);
+         }
 
          // Meanwhile, the user might have requested clusters outside the look-ahead window, so that we don't
          // need the cluster anymore, in which case we simply discard it right away, before moving it to the pool
@@ -239,10 +249,14 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
    // TODO(jblomer): instead of a fixed-sized window, eventually we should determine the window size based on
    // a user-defined memory limit.  The size of the preloaded data can be determined at the beginning of
    // GetCluster from the descriptor and the current contents of fPool.
+   const auto &entryRange = fPageSource.GetEntryRange();
    for (unsigned int i = 1; i < fWindowPost; ++i) {
       next = desc.FindNextClusterId(next);
       if (next == kInvalidDescriptorId)
          break;
+      // Don't preload clusters that the page source is not going to read, e.g. if other threads take care of them
+      if (!entryRange.IntersectsWith(desc.GetClusterDescriptor(next)))
+         break;
       provide.Insert(next, columns);
    }
 
@@ -322,8 +336,10 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
 
          fReadQueue.emplace(std::move(readItem));
       }
-      if (fReadQueue.size() > 0)
-         fCvHasReadWork.notify_one();
+      if (!fReadQueue.empty() && !fIsReading) {
+         fIsReading = true;
+         fReadTask = fIOTaskPool->Submit([this] { ExecReadClusters(); });
+      }
    } // work queue lock guard
 
    return WaitFor(clusterId, columns);
@@ -334,6 +350,7 @@ ROOT::Experimental::Detail::RCluster *
 ROOT::Experimental::Detail::RClusterPool::WaitFor(
    DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns)
 {
+   bool isFirstAttempt = true;
    while (true) {
       // Fast exit: the cluster happens to be already present in the cache pool
       auto result = FindInPool(clusterId);
@@ -346,9 +363,15 @@ ROOT::Experimental::Detail::RClusterPool::WaitFor(
             hasMissingColumn = true;
             break;
          }
-         if (!hasMissingColumn)
+         if (!hasMissingColumn) {
+            if (isFirstAttempt)
+               fCounters->fNHit.Inc();
             return result;
+         }
       }
+      if (isFirstAttempt)
+         fCounters->fNMiss.Inc();
+      isFirstAttempt = false;
 
       // Otherwise the missing data must have been triggered for loading by now, so block and wait
       decltype(fInFlightClusters)::iterator itr;
@@ -360,7 +383,7 @@ ROOT::Experimental::Detail::RClusterPool::WaitFor(
                break;
          }
          R__ASSERT(itr != fInFlightClusters.end());
-         // Note that the fInFlightClusters is accessed concurrently only by the I/O thread.  The I/O thread
+         // Note that the fInFlightClusters is accessed concurrently only by the I/O task.  The I/O task
          // never changes the structure of the in-flight clusters array (it does not add, remove, or swap elements).
          // Therefore, it is safe to access the element pointed to by itr here even after fLockWorkQueue
          // is released.  We need to release the lock before potentially blocking on the cluster future.
@@ -23,6 +23,40 @@
 #include <memory>
 #include <utility>
 
+namespace {
+
+/// Stores the bytes of the count elements of type T in source grouped by significance: byte 0 of all elements,
+/// then byte 1 of all elements etc.  The loops are written such that the writes are contiguous, which allows the
+/// compiler to vectorize them.
+template <typename T>
+void SplitBytes(void *destination, const void *source, std::size_t count)
+{
+   constexpr std::size_t N = sizeof(T);
+   auto splitArray = reinterpret_cast<unsigned char *>(destination);
+   auto src = reinterpret_cast<const unsigned char *>(source);
+   for (std::size_t b = 0; b < N; ++b) {
+      unsigned char *dst = splitArray + b * count;
+      for (std::size_t i = 0; i < count; ++i)
+         dst[i] = src[i * N + b];
+   }
+}
+
+/// Reverse operation of SplitBytes()
+template <typename T>
+void UnsplitBytes(void *destination, const void *source, std::size_t count)
+{
+   constexpr std::size_t N = sizeof(T);
+   auto dst = reinterpret_cast<unsigned char *>(destination);
+   auto splitArray = reinterpret_cast<const unsigned char *>(source);
+   for (std::size_t b = 0; b < N; ++b) {
+      const unsigned char *src = splitArray + b * count;
+      for (std::size_t i = 0; i < count; ++i)
+         dst[i * N + b] = src[i];
+   }
+}
+
+} // anonymous namespace
+
 std::unique_ptr<ROOT::Experimental::Detail::RColumnElementBase>
 ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
    switch (type) {
@@ -44,6 +78,18 @@ ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
       return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kIndex>>(nullptr);
    case EColumnType::kSwitch:
       return std::make_unique<RColumnElement<RColumnSwitch, EColumnType::kSwitch>>(nullptr);
+   case EColumnType::kSplitReal64:
+      return std::make_unique<RColumnElement<double, EColumnType::kSplitReal64>>(nullptr);
+   case EColumnType::kSplitReal32:
+      return std::make_unique<RColumnElement<float, EColumnType::kSplitReal32>>(nullptr);
+   case EColumnType::kSplitInt64:
+      return std::make_unique<RColumnElement<std::int64_t, EColumnType::kSplitInt64>>(nullptr);
+   case EColumnType::kSplitInt32:
+      return std::make_unique<RColumnElement<std::int32_t, EColumnType::kSplitInt32>>(nullptr);
+   case EColumnType::kSplitInt16:
+      return std::make_unique<RColumnElement<std::int16_t, EColumnType::kSplitInt16>>(nullptr);
+   case EColumnType::kSplitIndex:
+      return std::make_unique<RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>>(nullptr);
    default:
       R__ASSERT(false);
    }
@@ -71,6 +117,18 @@ std::size_t ROOT::Experimental::Detail::RColumnElementBase::GetBitsOnStorage(ECo
       return 32;
    case EColumnType::kSwitch:
       return 64;
+   case EColumnType::kSplitReal64:
+      return 64;
+   case EColumnType::kSplitReal32:
+      return 32;
+   case EColumnType::kSplitInt64:
+      return 64;
+   case EColumnType::kSplitInt32:
+      return 32;
+   case EColumnType::kSplitInt16:
+      return 16;
+   case EColumnType::kSplitIndex:
+      return 32;
    default:
       R__ASSERT(false);
    }
@@ -98,6 +156,18 @@ std::string ROOT::Experimental::Detail::RColumnElementBase::GetTypeName(EColumnT
       return "Index";
    case EColumnType::kSwitch:
       return "Switch";
+   case EColumnType::kSplitReal64:
+      return "SplitReal64";
+   case EColumnType::kSplitReal32:
+      return "SplitReal32";
+   case EColumnType::kSplitInt64:
+      return "SplitInt64";
+   case EColumnType::kSplitInt32:
+      return "SplitInt32";
+   case EColumnType::kSplitInt16:
+      return "SplitInt16";
+   case EColumnType::kSplitIndex:
+      return "SplitIndex";
    default:
       return "UNKNOWN";
    }
@@ -157,3 +227,125 @@ void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental
       int64Array[i] = int32Array[i];
    }
 }
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<float>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<float>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<double>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<double>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int16_t, ROOT::Experimental::EColumnType::kSplitInt16>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<std::int16_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int16_t, ROOT::Experimental::EColumnType::kSplitInt16>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<std::int16_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint16_t, ROOT::Experimental::EColumnType::kSplitInt16>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<std::uint16_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint16_t, ROOT::Experimental::EColumnType::kSplitInt16>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<std::uint16_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<std::int32_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<std::int32_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<std::uint32_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint32_t, ROOT::Experimental::EColumnType::kSplitInt32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<std::uint32_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<std::int64_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<std::int64_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<std::uint64_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<std::uint64_t, ROOT::Experimental::EColumnType::kSplitInt64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<std::uint64_t>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                               ROOT::Experimental::EColumnType::kSplitIndex>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   // Offsets are monotonically increasing; their differences are small numbers with mostly zero high bytes.
+   // The page is self-contained: the first element is stored relative to zero.
+   auto indexArray = reinterpret_cast<const ClusterSize_t::ValueType *>(src);
+   auto deltaArray = std::make_unique<ClusterSize_t::ValueType[]>(count);
+   ClusterSize_t::ValueType prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      deltaArray[i] = indexArray[i] - prev;
+      prev = indexArray[i];
+   }
+   SplitBytes<ClusterSize_t::ValueType>(dst, deltaArray.get(), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<ROOT::Experimental::ClusterSize_t,
+                                               ROOT::Experimental::EColumnType::kSplitIndex>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<ClusterSize_t::ValueType>(dst, src, count);
+   auto indexArray = reinterpret_cast<ClusterSize_t::ValueType *>(dst);
+   for (std::size_t i = 1; i < count; ++i)
+      indexArray[i] += indexArray[i - 1];
+}
@@ -113,7 +113,7 @@ int ROOT::Experimental::Detail::RDaosObject::Update(FetchUpdateArgs &args)
 
 
 ROOT::Experimental::Detail::RDaosContainer::DaosEventQueue::DaosEventQueue(std::size_t size)
-  : fSize(size), fEvs(std::unique_ptr<daos_event_t[]>(new daos_event_t[size]))
+  : fSize(size), fEvs(std::unique_ptr<daos_event_t[]>(new daos_event_t[size]()))
 {
    daos_eq_create(&fQueue);
    for (std::size_t i = 0; i < fSize; ++i)
@@ -126,9 +126,9 @@ ROOT::Experimental::Detail::RDaosContainer::DaosEventQueue::~DaosEventQueue() {
    daos_eq_destroy(fQueue, 0);
 }
 
-int ROOT::Experimental::Detail::RDaosContainer::DaosEventQueue::Poll() {
+int ROOT::Experimental::Detail::RDaosContainer::DaosEventQueue::Poll(std::size_t nEvents) {
    auto evp = std::unique_ptr<daos_event_t*[]>(new daos_event_t*[fSize]);
-   std::size_t n = fSize;
+   std::size_t n = nEvents;
    while (n) {
       int c;
       if ((c = daos_eq_poll(fQueue, 0, DAOS_EQ_WAIT, n, evp.get())) < 0)
@@ -138,6 +138,15 @@ int ROOT::Experimental::Detail::RDaosContainer::DaosEventQueue::Poll() {
    return n;
 }
 
+int ROOT::Experimental::Detail::RDaosContainer::DaosEventQueue::GetNErrors() const {
+   int nErrors = 0;
+   for (std::size_t i = 0; i < fSize; ++i) {
+      if (fEvs[i].ev_error != 0)
+         nErrors++;
+   }
+   return nErrors;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
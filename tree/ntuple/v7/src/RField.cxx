@@ -330,9 +330,32 @@ ROOT::Experimental::EColumnType ROOT::Experimental::Detail::RFieldBase::EnsureCo
 }
 
 
+void ROOT::Experimental::Detail::RFieldBase::GenerateIndexColumn(std::uint32_t index)
+{
+   if (fUseSplitEncoding) {
+      RColumnModel modelIndex(EColumnType::kSplitIndex, true /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<ClusterSize_t, EColumnType::kSplitIndex>(modelIndex, index)));
+      return;
+   }
+   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
+   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, index)));
+}
+
+
+void ROOT::Experimental::Detail::RFieldBase::EnsureIndexColumnType(unsigned int columnIndex,
+                                                                    const RNTupleDescriptor &desc)
+{
+   auto type = EnsureColumnType({EColumnType::kIndex, EColumnType::kSplitIndex}, columnIndex, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitIndex);
+}
+
+
 void ROOT::Experimental::Detail::RFieldBase::ConnectPageSink(RPageSink &pageSink)
 {
    R__ASSERT(fColumns.empty());
+   fUseSplitEncoding = pageSink.GetWriteOptions().GetUseSplitEncoding();
    GenerateColumnsImpl();
    if (!fColumns.empty())
       fPrincipalColumn = fColumns[0].get();
@@ -430,14 +453,12 @@ void ROOT::Experimental::RFieldZero::AcceptVisitor(Detail::RFieldVisitor &visito
 
 void ROOT::Experimental::RField<ROOT::Experimental::ClusterSize_t>::GenerateColumnsImpl()
 {
-   RColumnModel model(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(model, 0)));
+   GenerateIndexColumn();
 }
 
 void ROOT::Experimental::RField<ROOT::Experimental::ClusterSize_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kIndex}, 0, desc);
+   EnsureIndexColumnType(0, desc);
    GenerateColumnsImpl();
 }
 
@@ -532,6 +553,12 @@ void ROOT::Experimental::RField<bool>::AcceptVisitor(Detail::RFieldVisitor &visi
 
 void ROOT::Experimental::RField<float>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitReal32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<float, EColumnType::kSplitReal32>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kReal32, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
       Detail::RColumn::Create<float, EColumnType::kReal32>(model, 0)));
@@ -539,7 +566,8 @@ void ROOT::Experimental::RField<float>::GenerateColumnsImpl()
 
 void ROOT::Experimental::RField<float>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kReal32}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kReal32, EColumnType::kSplitReal32}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitReal32);
    GenerateColumnsImpl();
 }
 
@@ -553,6 +581,12 @@ void ROOT::Experimental::RField<float>::AcceptVisitor(Detail::RFieldVisitor &vis
 
 void ROOT::Experimental::RField<double>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitReal64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<double, EColumnType::kSplitReal64>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kReal64, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
       Detail::RColumn::Create<double, EColumnType::kReal64>(model, 0)));
@@ -560,7 +594,8 @@ void ROOT::Experimental::RField<double>::GenerateColumnsImpl()
 
 void ROOT::Experimental::RField<double>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kReal64}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kReal64, EColumnType::kSplitReal64}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitReal64);
    GenerateColumnsImpl();
 }
 
@@ -573,14 +608,21 @@ void ROOT::Experimental::RField<double>::AcceptVisitor(Detail::RFieldVisitor &vi
 
 void ROOT::Experimental::RField<std::int16_t>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitInt16, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::int16_t, EColumnType::kSplitInt16>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kInt16, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(Detail::RColumn::Create<
-      std::int16_t, EColumnType::kInt16>(model, 0)));
+   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+      Detail::RColumn::Create<std::int16_t, EColumnType::kInt16>(model, 0)));
 }
 
 void ROOT::Experimental::RField<std::int16_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kInt16}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kInt16, EColumnType::kSplitInt16}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitInt16);
    GenerateColumnsImpl();
 }
 
@@ -593,14 +635,21 @@ void ROOT::Experimental::RField<std::int16_t>::AcceptVisitor(Detail::RFieldVisit
 
 void ROOT::Experimental::RField<std::uint16_t>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitInt16, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint16_t, EColumnType::kSplitInt16>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kInt16, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(Detail::RColumn::Create<
-      std::uint16_t, EColumnType::kInt16>(model, 0)));
+   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+      Detail::RColumn::Create<std::uint16_t, EColumnType::kInt16>(model, 0)));
 }
 
 void ROOT::Experimental::RField<std::uint16_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kInt16}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kInt16, EColumnType::kSplitInt16}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitInt16);
    GenerateColumnsImpl();
 }
 
@@ -613,14 +662,21 @@ void ROOT::Experimental::RField<std::uint16_t>::AcceptVisitor(Detail::RFieldVisi
 
 void ROOT::Experimental::RField<std::int32_t>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitInt32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::int32_t, EColumnType::kSplitInt32>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kInt32, false /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(Detail::RColumn::Create<
-      std::int32_t, EColumnType::kInt32>(model, 0)));
+   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+      Detail::RColumn::Create<std::int32_t, EColumnType::kInt32>(model, 0)));
 }
 
 void ROOT::Experimental::RField<std::int32_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kInt32}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kInt32, EColumnType::kSplitInt32}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitInt32);
    GenerateColumnsImpl();
 }
 
@@ -633,6 +689,12 @@ void ROOT::Experimental::RField<std::int32_t>::AcceptVisitor(Detail::RFieldVisit
 
 void ROOT::Experimental::RField<std::uint32_t>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitInt32, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint32_t, EColumnType::kSplitInt32>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kInt32, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
       Detail::RColumn::Create<std::uint32_t, EColumnType::kInt32>(model, 0)));
@@ -640,7 +702,8 @@ void ROOT::Experimental::RField<std::uint32_t>::GenerateColumnsImpl()
 
 void ROOT::Experimental::RField<std::uint32_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kInt32}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kInt32, EColumnType::kSplitInt32}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitInt32);
    GenerateColumnsImpl();
 }
 
@@ -653,6 +716,12 @@ void ROOT::Experimental::RField<std::uint32_t>::AcceptVisitor(Detail::RFieldVisi
 
 void ROOT::Experimental::RField<std::uint64_t>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitInt64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::uint64_t, EColumnType::kSplitInt64>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kInt64, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
       Detail::RColumn::Create<std::uint64_t, EColumnType::kInt64>(model, 0)));
@@ -660,7 +729,8 @@ void ROOT::Experimental::RField<std::uint64_t>::GenerateColumnsImpl()
 
 void ROOT::Experimental::RField<std::uint64_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kInt64}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kInt64, EColumnType::kSplitInt64}, 0, desc);
+   fUseSplitEncoding = (type == EColumnType::kSplitInt64);
    GenerateColumnsImpl();
 }
 
@@ -673,6 +743,12 @@ void ROOT::Experimental::RField<std::uint64_t>::AcceptVisitor(Detail::RFieldVisi
 
 void ROOT::Experimental::RField<std::int64_t>::GenerateColumnsImpl()
 {
+   if (fUseSplitEncoding) {
+      RColumnModel model(EColumnType::kSplitInt64, false /* isSorted*/);
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::int64_t, EColumnType::kSplitInt64>(model, 0)));
+      return;
+   }
    RColumnModel model(EColumnType::kInt64, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
       Detail::RColumn::Create<std::int64_t, EColumnType::kInt64>(model, 0)));
@@ -680,11 +756,14 @@ void ROOT::Experimental::RField<std::int64_t>::GenerateColumnsImpl()
 
 void ROOT::Experimental::RField<std::int64_t>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   auto type = EnsureColumnType({EColumnType::kInt64, EColumnType::kInt32}, 0, desc);
+   auto type = EnsureColumnType({EColumnType::kInt64, EColumnType::kInt32, EColumnType::kSplitInt64}, 0, desc);
    RColumnModel model(type, false /* isSorted*/);
    if (type == EColumnType::kInt64) {
       fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
          Detail::RColumn::Create<std::int64_t, EColumnType::kInt64>(model, 0)));
+   } else if (type == EColumnType::kSplitInt64) {
+      fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+         Detail::RColumn::Create<std::int64_t, EColumnType::kSplitInt64>(model, 0)));
    } else {
       fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
          Detail::RColumn::Create<std::int64_t, EColumnType::kInt32>(model, 0)));
@@ -700,9 +779,7 @@ void ROOT::Experimental::RField<std::int64_t>::AcceptVisitor(Detail::RFieldVisit
 
 void ROOT::Experimental::RField<std::string>::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   GenerateIndexColumn();
 
    RColumnModel modelChars(EColumnType::kByte, false /* isSorted*/);
    fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
@@ -711,7 +788,7 @@ void ROOT::Experimental::RField<std::string>::GenerateColumnsImpl()
 
 void ROOT::Experimental::RField<std::string>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kIndex}, 0, desc);
+   EnsureIndexColumnType(0, desc);
    EnsureColumnType({EColumnType::kByte}, 1, desc);
    GenerateColumnsImpl();
 }
@@ -1014,6 +1091,14 @@ void ROOT::Experimental::RVectorField::ReadGlobalImpl(NTupleSize_t globalIndex,
    fPrincipalColumn->GetCollectionInfo(globalIndex, &collectionStart, &nItems);
 
    typedValue->resize(nItems * fItemSize);
+   if (fSubFields[0]->IsSimple()) {
+      // Copy all the items in one go rather than item by item
+      if (nItems > 0) {
+         auto itemValue = fSubFields[0]->CaptureValue(typedValue->data());
+         fSubFields[0]->ReadV(collectionStart, nItems, &itemValue);
+      }
+      return;
+   }
    for (unsigned i = 0; i < nItems; ++i) {
       auto itemValue = fSubFields[0]->GenerateValue(typedValue->data() + (i * fItemSize));
       fSubFields[0]->Read(collectionStart + i, &itemValue);
@@ -1022,14 +1107,12 @@ void ROOT::Experimental::RVectorField::ReadGlobalImpl(NTupleSize_t globalIndex,
 
 void ROOT::Experimental::RVectorField::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   GenerateIndexColumn();
 }
 
 void ROOT::Experimental::RVectorField::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kIndex}, 0, desc);
+   EnsureIndexColumnType(0, desc);
    GenerateColumnsImpl();
 }
 
@@ -1123,14 +1206,12 @@ void ROOT::Experimental::RField<std::vector<bool>>::ReadGlobalImpl(NTupleSize_t
 
 void ROOT::Experimental::RField<std::vector<bool>>::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   GenerateIndexColumn();
 }
 
 void ROOT::Experimental::RField<std::vector<bool>>::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kIndex}, 0, desc);
+   EnsureIndexColumnType(0, desc);
    GenerateColumnsImpl();
 }
 
@@ -1414,14 +1495,12 @@ ROOT::Experimental::RCollectionField::RCollectionField(
 
 void ROOT::Experimental::RCollectionField::GenerateColumnsImpl()
 {
-   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
-   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
-      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+   GenerateIndexColumn();
 }
 
 void ROOT::Experimental::RCollectionField::GenerateColumnsImpl(const RNTupleDescriptor &desc)
 {
-   EnsureColumnType({EColumnType::kIndex}, 0, desc);
+   EnsureIndexColumnType(0, desc);
    GenerateColumnsImpl();
 }
 
@@ -1032,7 +1032,9 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Write(
 {
    R__ASSERT(fFile);
    size_t retval;
-   if ((offset >= 0) && (static_cast<std::uint64_t>(offset) != fFilePos)) {
+   if (offset < 0 && fNeedsSeek)
+      offset = fFilePos;
+   if ((offset >= 0) && (fNeedsSeek || static_cast<std::uint64_t>(offset) != fFilePos)) {
 #ifdef R__SEEK64
       retval = fseeko64(fFile, offset, SEEK_SET);
 #else
@@ -1040,6 +1042,7 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Write(
 #endif
       R__ASSERT(retval == 0);
       fFilePos = offset;
+      fNeedsSeek = false;
    }
    retval = fwrite(buffer, 1, nbytes, fFile);
    R__ASSERT(retval == nbytes);
@@ -1047,6 +1050,15 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Write(
 }
 
 
+std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Reserve(size_t nbytes)
+{
+   auto offset = fFilePos;
+   fFilePos += nbytes;
+   fNeedsSeek = true;
+   return offset;
+}
+
+
 std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::WriteKey(
    const void *buffer, std::size_t nbytes, std::size_t len, std::int64_t offset,
    std::uint64_t directoryOffset,
@@ -1117,6 +1129,46 @@ std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::RFileProper::Writ
 ////////////////////////////////////////////////////////////////////////////////
 
 
+ROOT::Experimental::Internal::RNTupleFileWriter::RReservedBlobWriter::RReservedBlobWriter(const std::string &path)
+{
+#ifdef R__SEEK64
+   fFile = fopen64(path.c_str(), "r+b");
+#else
+   fFile = fopen(path.c_str(), "r+b");
+#endif
+   R__ASSERT(fFile);
+}
+
+
+ROOT::Experimental::Internal::RNTupleFileWriter::RReservedBlobWriter::~RReservedBlobWriter()
+{
+   fclose(fFile);
+}
+
+
+bool ROOT::Experimental::Internal::RNTupleFileWriter::RReservedBlobWriter::Write(
+   const void *buffer, std::size_t nbytes, std::uint64_t offset)
+{
+#ifdef R__SEEK64
+   if (fseeko64(fFile, offset, SEEK_SET) != 0)
+      return false;
+#else
+   if (fseek(fFile, offset, SEEK_SET) != 0)
+      return false;
+#endif
+   return fwrite(buffer, 1, nbytes, fFile) == nbytes;
+}
+
+
+bool ROOT::Experimental::Internal::RNTupleFileWriter::RReservedBlobWriter::Flush()
+{
+   return fflush(fFile) == 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 ROOT::Experimental::Internal::RNTupleFileWriter::RNTupleFileWriter(std::string_view name)
    : fNTupleName(name)
 {
@@ -1147,6 +1199,7 @@ ROOT::Experimental::Internal::RNTupleFileWriter *ROOT::Experimental::Internal::R
    auto writer = new RNTupleFileWriter(ntupleName);
    writer->fFileSimple.fFile = fileStream;
    writer->fFileName = fileName;
+   writer->fFilePath = std::string(path);
 
    switch (containerFormat) {
    case ENTupleContainerFormat::kTFile:
@@ -1244,6 +1297,44 @@ std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::WriteBlob(const v
 }
 
 
+std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::ReserveBlob(size_t nbytes, size_t len,
+                                                                           std::vector<unsigned char> &key)
+{
+   R__ASSERT(fFileSimple);
+   key.clear();
+   if (fIsBare)
+      return fFileSimple.Reserve(nbytes);
+
+   // Same key layout as written by RFileSimple::WriteKey()
+   RTFString strClass{kBlobClassName};
+   RTFString strObject;
+   RTFString strTitle;
+   RTFKey keyHeader(fFileSimple.fFilePos, 100, strClass, strObject, strTitle, len, nbytes);
+   const std::size_t szKey = keyHeader.fKeyHeaderSize + strClass.GetSize() + strObject.GetSize() + strTitle.GetSize();
+   key.resize(szKey);
+   auto pos = key.data();
+   memcpy(pos, &keyHeader, keyHeader.fKeyHeaderSize);
+   pos += keyHeader.fKeyHeaderSize;
+   memcpy(pos, &strClass, strClass.GetSize());
+   pos += strClass.GetSize();
+   memcpy(pos, &strObject, strObject.GetSize());
+   pos += strObject.GetSize();
+   memcpy(pos, &strTitle, strTitle.GetSize());
+
+   return fFileSimple.Reserve(szKey + nbytes) + szKey;
+}
+
+
+std::unique_ptr<ROOT::Experimental::Internal::RNTupleFileWriter::RReservedBlobWriter>
+ROOT::Experimental::Internal::RNTupleFileWriter::CreateReservedBlobWriter() const
+{
+   R__ASSERT(fFileSimple);
+   // Make sure that the new stream sees the file as written so far, in particular the file header
+   fflush(fFileSimple.fFile);
+   return std::make_unique<RReservedBlobWriter>(fFilePath);
+}
+
+
 std::uint64_t ROOT::Experimental::Internal::RNTupleFileWriter::WriteNTupleHeader(
    const void *data, size_t nbytes, size_t lenHeader)
 {
@@ -20,6 +20,7 @@
 #include <ROOT/RPageSourceFriends.hxx>
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageSinkBuf.hxx>
+#include <ROOT/RPageSinkSync.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #ifdef R__USE_IMT
 #include <ROOT/TTaskGroup.hxx>
@@ -76,10 +77,22 @@ void ROOT::Experimental::RNTupleReader::ConnectModel(const RNTupleModel &model)
       if (field.GetOnDiskId() == kInvalidDescriptorId) {
          field.SetOnDiskId(desc.FindFieldId(field.GetName(), field.GetParent()->GetOnDiskId()));
       }
-      field.ConnectPageSource(*fSource);
+      // In lazy mode, the columns are only added to the page source (and thus loaded by the cluster pool) once
+      // the field is accessed
+      if (!fSource->GetReadOptions().GetUseLazyEntry())
+         field.ConnectPageSource(*fSource);
    }
 }
 
+void ROOT::Experimental::RNTupleReader::ConnectFieldLazily(Detail::RFieldBase &field)
+{
+   if (!fLazyConnectedFields.insert(&field).second)
+      return;
+   field.ConnectPageSource(*fSource);
+   for (auto &f : field)
+      f.ConnectPageSource(*fSource);
+}
+
 void ROOT::Experimental::RNTupleReader::InitPageSource()
 {
 #ifdef R__USE_IMT
@@ -211,6 +224,9 @@ void ROOT::Experimental::RNTupleReader::PrintInfo(const ENTupleInfo what, std::o
    case ENTupleInfo::kMetrics:
       fMetrics.Print(output);
       break;
+   case ENTupleInfo::kMetricsJSON:
+      fMetrics.PrintJSON(output);
+      break;
    default:
       // Unhandled case, internal error
       R__ASSERT(false);
@@ -246,6 +262,8 @@ void ROOT::Experimental::RNTupleReader::Show(NTupleSize_t index, const ENTupleSh
       }
 
       reader->LoadEntry(index);
+      // The visitor iterates over the entry, which does not trigger reading of lazy values
+      entry->ResolveLazyValues();
       output << "{";
       for (auto iValue = entry->begin(); iValue != entry->end(); ) {
          output << std::endl;
@@ -341,6 +359,91 @@ void ROOT::Experimental::RNTupleWriter::CommitCluster()
 //------------------------------------------------------------------------------
 
 
+ROOT::Experimental::RNTupleFillContext::RNTupleFillContext(std::unique_ptr<RNTupleModel> model,
+                                                           std::unique_ptr<Detail::RPageSink> sink)
+   : fSink(std::move(sink)), fModel(std::move(model))
+{
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled()) {
+      fZipTasks = std::make_unique<RNTupleImtTaskScheduler>();
+      fSink->SetTaskScheduler(fZipTasks.get());
+   }
+#endif
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleFillContext::~RNTupleFillContext()
+{
+   CommitCluster();
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster()
+{
+   if (fNEntries == fLastCommitted) return;
+   for (auto& field : *fModel->GetFieldZero()) {
+      field.Flush();
+      field.CommitCluster();
+   }
+   fSink->CommitCluster(fNEntries);
+   fLastCommitted = fNEntries;
+}
+
+
+//------------------------------------------------------------------------------
+
+
+ROOT::Experimental::RNTupleParallelWriter::RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model,
+                                                                 std::unique_ptr<Detail::RPageSink> sink)
+   : fSink(std::move(sink)), fModel(std::move(model)), fMetrics("RNTupleParallelWriter")
+{
+   if (!fModel) {
+      throw RException(R__FAIL("null model"));
+   }
+   if (!fSink) {
+      throw RException(R__FAIL("null sink"));
+   }
+   fSink->Create(*fModel.get());
+   fMetrics.ObserveMetrics(fSink->GetMetrics());
+}
+
+ROOT::Experimental::RNTupleParallelWriter::~RNTupleParallelWriter()
+{
+   for (const auto &weakContext : fFillContexts) {
+      if (auto context = weakContext.lock())
+         context->CommitCluster();
+   }
+   fSink->CommitDataset();
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> ROOT::Experimental::RNTupleParallelWriter::Recreate(
+   std::unique_ptr<RNTupleModel> model,
+   std::string_view ntupleName,
+   std::string_view storage,
+   const RNTupleWriteOptions &options)
+{
+   // The fill contexts do the buffering; the shared sink needs to write directly to storage
+   auto sinkOptions = options.Clone();
+   sinkOptions->SetUseBufferedWrite(false);
+   return std::make_unique<RNTupleParallelWriter>(std::move(model),
+                                                  Detail::RPageSink::Create(ntupleName, storage, *sinkOptions));
+}
+
+std::shared_ptr<ROOT::Experimental::RNTupleFillContext> ROOT::Experimental::RNTupleParallelWriter::CreateFillContext()
+{
+   std::lock_guard<std::mutex> g(fMutex);
+
+   auto syncSink = std::make_unique<Detail::RPageSynchronizingSink>(*fSink, fMutex);
+   auto bufSink = std::make_unique<Detail::RPageSinkBuf>(std::move(syncSink));
+   // The context's constructor does not touch the shared sink, so it is safe to hold the lock here
+   auto context = std::shared_ptr<RNTupleFillContext>(new RNTupleFillContext(fModel->Clone(), std::move(bufSink)));
+   fFillContexts.push_back(context);
+   return context;
+}
+
+
+//------------------------------------------------------------------------------
+
+
 ROOT::Experimental::RCollectionNTupleWriter::RCollectionNTupleWriter(std::unique_ptr<REntry> defaultEntry)
    : fOffset(0), fDefaultEntry(std::move(defaultEntry))
 {
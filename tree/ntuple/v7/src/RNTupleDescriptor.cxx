@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
@@ -268,6 +269,33 @@ std::uint32_t DeserializePageInfo(const void *buffer,
    return bytes - base;
 }
 
+std::uint32_t SerializeColumnStatistics(const ROOT::Experimental::RColumnStatistics &val, void *buffer)
+{
+   // Like page infos, no frame around individual statistics.  Doubles are stored by their IEEE 754 bit pattern.
+   if (buffer != nullptr) {
+      auto pos = reinterpret_cast<unsigned char *>(buffer);
+      std::uint64_t bits;
+      memcpy(&bits, &val.fMin, sizeof(bits));
+      pos += SerializeUInt64(bits, pos);
+      memcpy(&bits, &val.fMax, sizeof(bits));
+      pos += SerializeUInt64(bits, pos);
+      pos += SerializeUInt64(val.fNNaN, pos);
+   }
+   return 24;
+}
+
+std::uint32_t DeserializeColumnStatistics(const void *buffer, ROOT::Experimental::RColumnStatistics *statistics)
+{
+   auto bytes = reinterpret_cast<const unsigned char *>(buffer);
+   std::uint64_t bits;
+   bytes += DeserializeUInt64(bytes, &bits);
+   memcpy(&statistics->fMin, &bits, sizeof(bits));
+   bytes += DeserializeUInt64(bytes, &bits);
+   memcpy(&statistics->fMax, &bits, sizeof(bits));
+   bytes += DeserializeUInt64(bytes, &statistics->fNNaN);
+   return 24;
+}
+
 std::uint32_t SerializeCrc32(const unsigned char *data, std::uint32_t length, void *buffer)
 {
    auto checksum = R__crc32(0, nullptr, 0);
@@ -352,6 +380,45 @@ std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescript
    pos += SerializeUInt64(val.GetNEntries(), *where);
    pos += SerializeLocator(val.GetLocator(), *where);
 
+   // Since frame version 1: the statistics of the columns that have them, for the cluster and for every page.
+   // Columns with statistics have them for all their pages.
+   std::vector<ROOT::Experimental::DescriptorId_t> columnIds;
+   for (auto columnId : val.GetColumnIds()) {
+      if (val.GetColumnRange(columnId).fStatistics)
+         columnIds.emplace_back(columnId);
+   }
+   std::sort(columnIds.begin(), columnIds.end());
+   pos += SerializeUInt32(columnIds.size(), *where);
+   for (auto columnId : columnIds) {
+      pos += SerializeUInt64(columnId, *where);
+      pos += SerializeColumnStatistics(*val.GetColumnRange(columnId).fStatistics, *where);
+      const auto &pageInfos = val.GetPageRange(columnId).fPageInfos;
+      pos += SerializeUInt32(pageInfos.size(), *where);
+      for (const auto &pageInfo : pageInfos) {
+         R__ASSERT(pageInfo.fStatistics);
+         pos += SerializeColumnStatistics(*pageInfo.fStatistics, *where);
+      }
+   }
+
+   // Since frame version 2: the checksums of the columns whose pages have them
+   columnIds.clear();
+   for (auto columnId : val.GetColumnIds()) {
+      const auto &pageInfos = val.GetPageRange(columnId).fPageInfos;
+      if (!pageInfos.empty() && pageInfos[0].fChecksum)
+         columnIds.emplace_back(columnId);
+   }
+   std::sort(columnIds.begin(), columnIds.end());
+   pos += SerializeUInt32(columnIds.size(), *where);
+   for (auto columnId : columnIds) {
+      pos += SerializeUInt64(columnId, *where);
+      const auto &pageInfos = val.GetPageRange(columnId).fPageInfos;
+      pos += SerializeUInt32(pageInfos.size(), *where);
+      for (const auto &pageInfo : pageInfos) {
+         R__ASSERT(pageInfo.fChecksum);
+         pos += SerializeUInt64(*pageInfo.fChecksum, *where);
+      }
+   }
+
    auto size = pos - base;
    SerializeUInt32(size, ptrSize);
    return size;
@@ -483,6 +550,15 @@ bool ROOT::Experimental::RClusterDescriptor::ContainsColumn(DescriptorId_t colum
 }
 
 
+bool ROOT::Experimental::RClusterDescriptor::MayContainValues(DescriptorId_t columnId, double min, double max) const
+{
+   auto itr = fColumnRanges.find(columnId);
+   if (itr == fColumnRanges.end() || !itr->second.fStatistics)
+      return true;
+   return itr->second.fStatistics->Overlaps(min, max);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 
@@ -861,6 +937,43 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
       pos += DeserializeLocator(pos, &locator);
       SetClusterLocator(clusterId, locator);
 
+      // Column statistics are only present if the cluster summary was written with frame version >= 1
+      struct RColumnStatisticsEntry {
+         DescriptorId_t fColumnId;
+         RColumnStatistics fStatistics;
+         std::vector<RColumnStatistics> fPageStatistics;
+      };
+      std::vector<RColumnStatisticsEntry> statistics;
+      if (pos < clusterBase + frameSize) {
+         std::uint32_t nStatistics;
+         pos += DeserializeUInt32(pos, &nStatistics);
+         statistics.resize(nStatistics);
+         for (auto &s : statistics) {
+            pos += DeserializeUInt64(pos, &s.fColumnId);
+            pos += DeserializeColumnStatistics(pos, &s.fStatistics);
+            std::uint32_t nPages;
+            pos += DeserializeUInt32(pos, &nPages);
+            s.fPageStatistics.resize(nPages);
+            for (auto &p : s.fPageStatistics)
+               pos += DeserializeColumnStatistics(pos, &p);
+         }
+      }
+      // Page checksums are only present if the cluster summary was written with frame version >= 2
+      std::vector<std::pair<DescriptorId_t, std::vector<std::uint64_t>>> checksums;
+      if (pos < clusterBase + frameSize) {
+         std::uint32_t nChecksums;
+         pos += DeserializeUInt32(pos, &nChecksums);
+         checksums.resize(nChecksums);
+         for (auto &c : checksums) {
+            pos += DeserializeUInt64(pos, &c.first);
+            std::uint32_t nPages;
+            pos += DeserializeUInt32(pos, &nPages);
+            c.second.resize(nPages);
+            for (auto &p : c.second)
+               pos += DeserializeUInt64(pos, &p);
+         }
+      }
+
       pos = clusterBase + frameSize;
 
       std::uint32_t nColumns;
@@ -885,6 +998,21 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
          }
          AddClusterPageRange(clusterId, std::move(pageRange));
       }
+
+      auto &clusterDesc = fDescriptor.fClusterDescriptors[clusterId];
+      for (auto &s : statistics) {
+         auto &pageInfos = clusterDesc.fPageRanges.at(s.fColumnId).fPageInfos;
+         R__ASSERT(pageInfos.size() == s.fPageStatistics.size());
+         clusterDesc.fColumnRanges.at(s.fColumnId).fStatistics = s.fStatistics;
+         for (std::size_t k = 0; k < pageInfos.size(); ++k)
+            pageInfos[k].fStatistics = s.fPageStatistics[k];
+      }
+      for (auto &c : checksums) {
+         auto &pageInfos = clusterDesc.fPageRanges.at(c.first).fPageInfos;
+         R__ASSERT(pageInfos.size() == c.second.size());
+         for (std::size_t k = 0; k < pageInfos.size(); ++k)
+            pageInfos[k].fChecksum = c.second[k];
+      }
    }
 }
 
@@ -14,16 +14,112 @@
  *************************************************************************/
 
 #include <ROOT/RError.hxx>
+#include <ROOT/RField.hxx>
 #include <ROOT/RMiniFile.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleMerger.hxx>
+#include <ROOT/RNTupleModel.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/RPageStorageFile.hxx>
 
+#include <TError.h>
+#include <TFile.h>
+#include <TFileMergeInfo.h>
+#include <TObjString.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Returns the names of the given field and its parents, starting from the top-level field
+std::vector<std::string> GetFieldPath(const ROOT::Experimental::Detail::RFieldBase &field)
+{
+   std::vector<std::string> path;
+   for (auto f = &field; f->GetParent() != nullptr; f = f->GetParent())
+      path.emplace_back(f->GetName());
+   std::reverse(path.begin(), path.end());
+   return path;
+}
+
+ROOT::Experimental::DescriptorId_t
+FindFieldId(const ROOT::Experimental::RNTupleDescriptor &desc, const std::vector<std::string> &path)
+{
+   auto fieldId = desc.GetFieldZeroId();
+   for (const auto &name : path) {
+      fieldId = desc.FindFieldId(name, fieldId);
+      if (fieldId == ROOT::Experimental::kInvalidDescriptorId)
+         break;
+   }
+   return fieldId;
+}
+
+bool IsSplitColumnType(ROOT::Experimental::EColumnType type)
+{
+   using ROOT::Experimental::EColumnType;
+   switch (type) {
+   case EColumnType::kSplitReal64:
+   case EColumnType::kSplitReal32:
+   case EColumnType::kSplitInt64:
+   case EColumnType::kSplitInt32:
+   case EColumnType::kSplitInt16:
+   case EColumnType::kSplitIndex: return true;
+   default: return false;
+   }
+}
+
+} // anonymous namespace
+
+
+/// The first element of `inputs` is a TObjString with the name of the ntuple, the remaining elements are the input
+/// TFiles.  The merged ntuple is written into the file of mergeInfo->fOutputDirectory.
 Long64_t ROOT::Experimental::RNTuple::Merge(TCollection* inputs, TFileMergeInfo* mergeInfo) {
-   if (inputs == nullptr || mergeInfo == nullptr) {
+   if (inputs == nullptr || mergeInfo == nullptr || mergeInfo->fOutputDirectory == nullptr) {
+      return -1;
+   }
+   if (inputs->GetEntries() < 2) {
+      return -1;
+   }
+
+   TIter itr(inputs);
+   auto ntupleName = dynamic_cast<TObjString *>(itr());
+   if (!ntupleName) {
+      Error("RNTuple::Merge", "missing ntuple name in the list of inputs");
+      return -1;
+   }
+   auto outFile = mergeInfo->fOutputDirectory->GetFile();
+   if (!outFile || outFile != mergeInfo->fOutputDirectory) {
+      Error("RNTuple::Merge", "only ntuples in the top-level directory of a file can be merged");
       return -1;
    }
-   return -1;
+
+   try {
+      std::vector<std::unique_ptr<Detail::RPageSource>> sources;
+      std::vector<Detail::RPageSource *> sourcePtrs;
+      while (auto obj = itr()) {
+         auto inFile = dynamic_cast<TFile *>(obj);
+         if (!inFile) {
+            Error("RNTuple::Merge", "unexpected input of type %s", obj->ClassName());
+            return -1;
+         }
+         sources.emplace_back(std::make_unique<Detail::RPageSourceFile>(
+            ntupleName->GetString().Data(), inFile->GetName(), RNTupleReadOptions()));
+         sources.back()->Attach();
+         sourcePtrs.emplace_back(sources.back().get());
+      }
+
+      auto options = RNTupleMerger::GetMergeOptions(*sourcePtrs[0]);
+      Detail::RPageSinkFile destination(ntupleName->GetString().Data(), *outFile, *options);
+      RNTupleMerger merger;
+      merger.Merge(sourcePtrs, destination);
+   } catch (const RException &e) {
+      Error("RNTuple::Merge", "%s", e.what());
+      return -1;
+   }
+   return 0;
 }
 
 
@@ -37,3 +133,119 @@ ROOT::Experimental::RFieldMerger::Merge(const ROOT::Experimental::RFieldDescript
    return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " with field "
       + rhs.GetFieldName() + " (unimplemented!)");
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+std::unique_ptr<ROOT::Experimental::RNTupleWriteOptions>
+ROOT::Experimental::RNTupleMerger::GetMergeOptions(const Detail::RPageSource &source)
+{
+   const auto &desc = source.GetDescriptor();
+   auto options = std::make_unique<RNTupleWriteOptions>();
+   // All the pages written by a sink share the compression settings of its write options
+   if (desc.GetNColumns() > 0) {
+      for (const auto &clusterDesc : desc.GetClusterIterable()) {
+         options->SetCompression(clusterDesc.GetColumnRange(0).fCompressionSettings);
+         break;
+      }
+   }
+   for (DescriptorId_t columnId = 0; columnId < desc.GetNColumns(); ++columnId) {
+      if (IsSplitColumnType(desc.GetColumnDescriptor(columnId).GetModel().GetType())) {
+         options->SetUseSplitEncoding(true);
+         break;
+      }
+   }
+   return options;
+}
+
+
+void ROOT::Experimental::RNTupleMerger::Merge(std::span<Detail::RPageSource *> sources,
+                                              Detail::RPageSink &destination)
+{
+   if (sources.empty())
+      throw RException(R__FAIL("no sources to merge"));
+
+   const auto &firstDesc = sources[0]->GetDescriptor();
+   auto model = firstDesc.GenerateModel();
+   destination.Create(*model);
+
+   // The destination sink issues column ids in the order of the field traversal of the model and, within a field,
+   // in the order of the column index.  Record the field path and the column index of every destination column.
+   struct RColumnInfo {
+      std::vector<std::string> fFieldPath;
+      std::string fFieldType;
+      std::uint32_t fColumnIndex;
+      EColumnType fColumnType;
+   };
+   std::vector<RColumnInfo> columnInfos;
+   for (const auto &field : *model->GetFieldZero()) {
+      auto fieldPath = GetFieldPath(field);
+      auto fieldId = FindFieldId(firstDesc, fieldPath);
+      R__ASSERT(fieldId != kInvalidDescriptorId);
+      for (const auto &columnDesc : firstDesc.GetColumnIterable(fieldId)) {
+         columnInfos.push_back({fieldPath, field.GetType(), columnDesc.GetIndex(), columnDesc.GetModel().GetType()});
+      }
+   }
+
+   const auto compression = destination.GetWriteOptions().GetCompression();
+   std::vector<unsigned char> buffer;
+   NTupleSize_t nEntries = 0;
+   for (auto source : sources) {
+      const auto &desc = source->GetDescriptor();
+      if (desc.GetNFields() != firstDesc.GetNFields() || desc.GetNColumns() != firstDesc.GetNColumns())
+         throw RException(R__FAIL("schema mismatch in ntuple " + desc.GetName()));
+
+      // Maps destination column ids to the column ids of the source
+      std::vector<DescriptorId_t> columnMap;
+      for (const auto &info : columnInfos) {
+         auto fieldId = FindFieldId(desc, info.fFieldPath);
+         if (fieldId == kInvalidDescriptorId || desc.GetFieldDescriptor(fieldId).GetTypeName() != info.fFieldType)
+            throw RException(R__FAIL("schema mismatch in ntuple " + desc.GetName() + " for field " +
+                                     info.fFieldPath.back()));
+         auto columnId = desc.FindColumnId(fieldId, info.fColumnIndex);
+         if (columnId == kInvalidDescriptorId ||
+             desc.GetColumnDescriptor(columnId).GetModel().GetType() != info.fColumnType)
+         {
+            throw RException(R__FAIL("column type mismatch in ntuple " + desc.GetName() + " for field " +
+                                     info.fFieldPath.back()));
+         }
+         columnMap.emplace_back(columnId);
+      }
+
+      std::vector<const RClusterDescriptor *> clusters;
+      for (const auto &clusterDesc : desc.GetClusterIterable())
+         clusters.emplace_back(&clusterDesc);
+      std::sort(clusters.begin(), clusters.end(), [](const RClusterDescriptor *a, const RClusterDescriptor *b) {
+         return a->GetFirstEntryIndex() < b->GetFirstEntryIndex();
+      });
+
+      for (const auto clusterDesc : clusters) {
+         for (DescriptorId_t dstColumnId = 0; dstColumnId < columnMap.size(); ++dstColumnId) {
+            const auto srcColumnId = columnMap[dstColumnId];
+            const auto &columnRange = clusterDesc->GetColumnRange(srcColumnId);
+            if (columnRange.fNElements > 0 && columnRange.fCompressionSettings != compression) {
+               throw RException(R__FAIL("compression mismatch in ntuple " + desc.GetName() + ": " +
+                                        std::to_string(columnRange.fCompressionSettings) + " vs. " +
+                                        std::to_string(compression)));
+            }
+
+            NTupleSize_t firstInPage = 0;
+            for (const auto &pageInfo : clusterDesc->GetPageRange(srcColumnId).fPageInfos) {
+               buffer.resize(std::max<std::size_t>(buffer.size(), pageInfo.fLocator.fBytesOnStorage));
+               Detail::RPageStorage::RSealedPage sealedPage;
+               sealedPage.fBuffer = buffer.data();
+               source->LoadSealedPage(srcColumnId, RClusterIndex(clusterDesc->GetId(), firstInPage), sealedPage);
+               sealedPage.fStatistics = pageInfo.fStatistics;
+               // The page content is unchanged, so is its checksum
+               sealedPage.fChecksum = pageInfo.fChecksum;
+               destination.CommitSealedPage(dstColumnId, sealedPage);
+               firstInPage += pageInfo.fNElements;
+            }
+         }
+         nEntries += clusterDesc->GetNEntries();
+         destination.CommitCluster(nEntries);
+      }
+   }
+   destination.CommitDataset();
+}
@@ -15,10 +15,53 @@
 
 #include <ROOT/RNTupleMetrics.hxx>
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <ostream>
+#include <utility>
 
 #include <iostream>
 
+namespace {
+
+std::string EscapeJSON(const std::string &str)
+{
+   std::string result;
+   result.reserve(str.length());
+   for (auto c : str) {
+      switch (c) {
+      case '"': result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+            result += buf;
+         } else {
+            result += c;
+         }
+      }
+   }
+   return result;
+}
+
+/// Counter values are printed as they are if they represent a finite number, otherwise as null
+std::string ValueToJSON(const std::string &value)
+{
+   if (value.empty())
+      return "null";
+   char *end = nullptr;
+   auto number = std::strtod(value.c_str(), &end);
+   if (*end != '\0' || !std::isfinite(number))
+      return "null";
+   return value;
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RNTuplePerfCounter::~RNTuplePerfCounter()
 {
 }
@@ -78,6 +121,38 @@ void ROOT::Experimental::Detail::RNTupleMetrics::Print(std::ostream &output, con
    }
 }
 
+void ROOT::Experimental::Detail::RNTupleMetrics::CollectCounters(
+   const std::string &prefix, std::vector<std::pair<std::string, const RNTuplePerfCounter *>> &counters) const
+{
+   if (!fIsEnabled)
+      return;
+
+   for (const auto &c : fCounters) {
+      counters.emplace_back(prefix + fName + kNamespaceSeperator + c->GetName(), c.get());
+   }
+   for (const auto c : fObservedMetrics) {
+      c->CollectCounters(prefix + fName + kNamespaceSeperator, counters);
+   }
+}
+
+void ROOT::Experimental::Detail::RNTupleMetrics::PrintJSON(std::ostream &output) const
+{
+   std::vector<std::pair<std::string, const RNTuplePerfCounter *>> counters;
+   CollectCounters("", counters);
+
+   output << "{";
+   bool isFirst = true;
+   for (const auto &c : counters) {
+      output << (isFirst ? "\n" : ",\n");
+      isFirst = false;
+      output << "  \"" << EscapeJSON(c.first) << "\": {"
+             << "\"unit\": \"" << EscapeJSON(c.second->GetUnit()) << "\", "
+             << "\"description\": \"" << EscapeJSON(c.second->GetDescription()) << "\", "
+             << "\"value\": " << ValueToJSON(c.second->GetValueAsString()) << "}";
+   }
+   output << (isFirst ? "}" : "\n}") << std::endl;
+}
+
 void ROOT::Experimental::Detail::RNTupleMetrics::Enable()
 {
    for (auto &c: fCounters)
@@ -18,6 +18,8 @@
 
 #include <TError.h>
 
+#include <new>
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageAllocatorHeap::NewPage(
    ColumnId_t columnId, std::size_t elementSize, std::size_t nElements)
 {
@@ -31,3 +33,116 @@ void ROOT::Experimental::Detail::RPageAllocatorHeap::DeletePage(const RPage& pag
 {
    delete[] reinterpret_cast<unsigned char *>(page.GetBuffer());
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+std::size_t ROOT::Experimental::Detail::RPageAllocatorPool::GetSizeClass(std::size_t nbytes)
+{
+   std::size_t sizeClass = 0;
+   while ((std::size_t(1) << sizeClass) < nbytes)
+      sizeClass++;
+   return sizeClass;
+}
+
+ROOT::Experimental::Detail::RPageAllocatorPool &ROOT::Experimental::Detail::RPageAllocatorPool::Instance()
+{
+   static auto *instance = new RPageAllocatorPool();
+   return *instance;
+}
+
+ROOT::Experimental::Detail::RPageAllocatorPool::~RPageAllocatorPool()
+{
+   for (auto &freeList : fFreeLists) {
+      for (auto buffer : freeList)
+         ::operator delete(buffer, std::align_val_t(kAlignment));
+   }
+}
+
+void *ROOT::Experimental::Detail::RPageAllocatorPool::Allocate(std::size_t nbytes)
+{
+   const auto sizeClass = GetSizeClass(nbytes);
+   R__ASSERT(sizeClass < kNSizeClasses);
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      fNAllocations++;
+      auto &freeList = fFreeLists[sizeClass];
+      if (!freeList.empty()) {
+         auto buffer = freeList.back();
+         freeList.pop_back();
+         fCachedBytes -= std::size_t(1) << sizeClass;
+         fNRecycled++;
+         return buffer;
+      }
+   }
+   return ::operator new(std::size_t(1) << sizeClass, std::align_val_t(kAlignment));
+}
+
+void ROOT::Experimental::Detail::RPageAllocatorPool::Release(void *buffer, std::size_t nbytes)
+{
+   if (!buffer)
+      return;
+   const auto sizeClass = GetSizeClass(nbytes);
+   const auto bufferSize = std::size_t(1) << sizeClass;
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      if (fCachedBytes + bufferSize <= fMaxCachedBytes) {
+         fFreeLists[sizeClass].emplace_back(buffer);
+         fCachedBytes += bufferSize;
+         return;
+      }
+   }
+   ::operator delete(buffer, std::align_val_t(kAlignment));
+}
+
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageAllocatorPool::NewPage(
+   ColumnId_t columnId, std::size_t elementSize, std::size_t nElements)
+{
+   R__ASSERT((elementSize > 0) && (nElements > 0));
+   auto nbytes = elementSize * nElements;
+   return RPage(columnId, Allocate(nbytes), nbytes, elementSize);
+}
+
+void ROOT::Experimental::Detail::RPageAllocatorPool::DeletePage(const RPage &page)
+{
+   Release(page.GetBuffer(), page.GetCapacity());
+}
+
+void ROOT::Experimental::Detail::RPageAllocatorPool::SetMaxCachedBytes(std::size_t maxCachedBytes)
+{
+   std::vector<void *> victims;
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      fMaxCachedBytes = maxCachedBytes;
+      // Drop the largest buffers first
+      for (std::size_t i = kNSizeClasses; (i > 0) && (fCachedBytes > fMaxCachedBytes); --i) {
+         auto &freeList = fFreeLists[i - 1];
+         while (!freeList.empty() && (fCachedBytes > fMaxCachedBytes)) {
+            victims.emplace_back(freeList.back());
+            freeList.pop_back();
+            fCachedBytes -= std::size_t(1) << (i - 1);
+         }
+      }
+   }
+   for (auto buffer : victims)
+      ::operator delete(buffer, std::align_val_t(kAlignment));
+}
+
+std::size_t ROOT::Experimental::Detail::RPageAllocatorPool::GetCachedBytes()
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   return fCachedBytes;
+}
+
+std::uint64_t ROOT::Experimental::Detail::RPageAllocatorPool::GetNAllocations()
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   return fNAllocations;
+}
+
+std::uint64_t ROOT::Experimental::Detail::RPageAllocatorPool::GetNRecycled()
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   return fNRecycled;
+}
@@ -20,25 +20,119 @@
 
 #include <cstdlib>
 
-void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
+ROOT::Experimental::Detail::RPagePool::~RPagePool()
+{
+   for (std::size_t i = 0; i < fPages.size(); ++i) {
+      if (fReferences[i] == 0)
+         fDeleters[i](fPages[i]);
+   }
+}
+
+std::shared_ptr<ROOT::Experimental::Detail::RPagePool> ROOT::Experimental::Detail::RPagePool::GetSharedPool()
+{
+   static auto sharedPool = std::make_shared<RPagePool>();
+   return sharedPool;
+}
+
+std::uint64_t ROOT::Experimental::Detail::RPagePool::GetStorageId(const std::string &key)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
-   fPages.emplace_back(page);
-   fReferences.emplace_back(1);
-   fDeleters.emplace_back(deleter);
+   auto itr = fStorageKeys.find(key);
+   if (itr != fStorageKeys.end())
+      return itr->second;
+   const std::uint64_t storageId = fStorageKeys.size() + 1;
+   fStorageKeys[key] = storageId;
+   return storageId;
 }
 
-void ROOT::Experimental::Detail::RPagePool::PreloadPage(const RPage &page, const RPageDeleter &deleter)
+void ROOT::Experimental::Detail::RPagePool::SetMaxUnusedBytes(std::size_t maxUnusedBytes)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   fMaxUnusedBytes = maxUnusedBytes;
+   EvictUnused();
+}
+
+std::size_t ROOT::Experimental::Detail::RPagePool::GetUnusedBytes()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fUnusedBytes;
+}
+
+std::size_t ROOT::Experimental::Detail::RPagePool::GetNPages()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fPages.size();
+}
+
+void ROOT::Experimental::Detail::RPagePool::ErasePage(std::size_t idx)
+{
+   fDeleters[idx](fPages[idx]);
+   const auto N = fPages.size();
+   fPages[idx] = fPages[N-1];
+   fReferences[idx] = fReferences[N-1];
+   fDeleters[idx] = fDeleters[N-1];
+   fStorageIds[idx] = fStorageIds[N-1];
+   fLastUse[idx] = fLastUse[N-1];
+   fPages.resize(N-1);
+   fReferences.resize(N-1);
+   fDeleters.resize(N-1);
+   fStorageIds.resize(N-1);
+   fLastUse.resize(N-1);
+}
+
+void ROOT::Experimental::Detail::RPagePool::EvictUnused()
+{
+   // Without a limit, unused pages are not accounted for, so that setting the limit to zero drops all unused pages
+   while (fUnusedBytes > fMaxUnusedBytes) {
+      std::size_t victim = fPages.size();
+      for (std::size_t i = 0; i < fPages.size(); ++i) {
+         if (fReferences[i] != 0) continue;
+         if ((victim == fPages.size()) || (fLastUse[i] < fLastUse[victim]))
+            victim = i;
+      }
+      R__ASSERT(victim < fPages.size());
+      fUnusedBytes -= fPages[victim].GetSize();
+      ErasePage(victim);
+   }
+}
+
+void ROOT::Experimental::Detail::RPagePool::AddPage(
+   const RPage &page, const RPageDeleter &deleter, std::int32_t references, std::uint64_t storageId)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
    fPages.emplace_back(page);
-   fReferences.emplace_back(0);
+   fReferences.emplace_back(references);
    fDeleters.emplace_back(deleter);
+   fStorageIds.emplace_back(storageId);
+   fLastUse.emplace_back(++fClock);
+   if (references == 0 && fMaxUnusedBytes > 0) {
+      fUnusedBytes += page.GetSize();
+      EvictUnused();
+   }
+}
+
+void ROOT::Experimental::Detail::RPagePool::RegisterPage(
+   const RPage &page, const RPageDeleter &deleter, std::uint64_t storageId)
+{
+   AddPage(page, deleter, 1, storageId);
+}
+
+void ROOT::Experimental::Detail::RPagePool::PreloadPage(
+   const RPage &page, const RPageDeleter &deleter, std::uint64_t storageId)
+{
+   AddPage(page, deleter, 0, storageId);
 }
 
 void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
 {
    if (page.IsNull()) return;
+   const bool isManaged = TryReturnPage(page);
+   R__ASSERT(isManaged);
+}
+
+bool ROOT::Experimental::Detail::RPagePool::TryReturnPage(const RPage& page)
+{
+   if (page.IsNull()) return true;
    std::lock_guard<std::mutex> lockGuard(fLock);
 
    unsigned int N = fPages.size();
@@ -46,45 +140,65 @@ void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
       if (fPages[i] != page) continue;
 
       if (--fReferences[i] == 0) {
-         fDeleters[i](fPages[i]);
-         fPages[i] = fPages[N-1];
-         fReferences[i] = fReferences[N-1];
-         fDeleters[i] = fDeleters[N-1];
-         fPages.resize(N-1);
-         fReferences.resize(N-1);
-         fDeleters.resize(N-1);
+         if (fMaxUnusedBytes == 0) {
+            ErasePage(i);
+         } else {
+            fLastUse[i] = ++fClock;
+            fUnusedBytes += fPages[i].GetSize();
+            EvictUnused();
+         }
       }
-      return;
+      return true;
    }
-   R__ASSERT(false);
+   return false;
 }
 
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
-   ColumnId_t columnId, NTupleSize_t globalIndex)
+   ColumnId_t columnId, NTupleSize_t globalIndex, std::uint64_t storageId)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
    unsigned int N = fPages.size();
    for (unsigned int i = 0; i < N; ++i) {
       if (fReferences[i] < 0) continue;
+      if (fStorageIds[i] != storageId) continue;
       if (fPages[i].GetColumnId() != columnId) continue;
       if (!fPages[i].Contains(globalIndex)) continue;
-      fReferences[i]++;
+      if (fReferences[i]++ == 0 && fMaxUnusedBytes > 0)
+         fUnusedBytes -= fPages[i].GetSize();
+      fLastUse[i] = ++fClock;
       return fPages[i];
    }
    return RPage();
 }
 
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
-   ColumnId_t columnId, const RClusterIndex &clusterIndex)
+   ColumnId_t columnId, const RClusterIndex &clusterIndex, std::uint64_t storageId)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
    unsigned int N = fPages.size();
    for (unsigned int i = 0; i < N; ++i) {
       if (fReferences[i] < 0) continue;
+      if (fStorageIds[i] != storageId) continue;
       if (fPages[i].GetColumnId() != columnId) continue;
       if (!fPages[i].Contains(clusterIndex)) continue;
-      fReferences[i]++;
+      if (fReferences[i]++ == 0 && fMaxUnusedBytes > 0)
+         fUnusedBytes -= fPages[i].GetSize();
+      fLastUse[i] = ++fClock;
       return fPages[i];
    }
    return RPage();
 }
+
+bool ROOT::Experimental::Detail::RPagePool::ContainsPage(
+   ColumnId_t columnId, const RClusterIndex &clusterIndex, std::uint64_t storageId)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   unsigned int N = fPages.size();
+   for (unsigned int i = 0; i < N; ++i) {
+      if (fStorageIds[i] != storageId) continue;
+      if (fPages[i].GetColumnId() != columnId) continue;
+      if (fPages[i].Contains(clusterIndex))
+         return true;
+   }
+   return false;
+}
@@ -19,6 +19,9 @@
 #include <ROOT/RNTupleZip.hxx>
 #include <ROOT/RPageSinkBuf.hxx>
 
+#include <deque>
+#include <vector>
+
 ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(std::unique_ptr<RPageSink> inner)
    : RPageSink(inner->GetNTupleName(), inner->GetWriteOptions())
    , fMetrics("RPageSinkBuf")
@@ -52,6 +55,8 @@ ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHa
    // CommitCluster().
    RColumnBuf::iterator zipItem =
       fBufferedColumns.at(columnHandle.fId).BufferPage(columnHandle, bufPage);
+   // The page info is added to fOpenPageRanges once this method returns
+   zipItem->fPageInfoIndex = fOpenPageRanges.at(columnHandle.fId).fPageInfos.size();
    if (!fTaskScheduler) {
       return RClusterDescriptor::RLocator{};
    }
@@ -90,20 +95,46 @@ ROOT::Experimental::Detail::RPageSinkBuf::CommitClusterImpl(ROOT::Experimental::
       fTaskScheduler->Reset();
    }
 
+   std::vector<std::deque<RColumnBuf::RPageZipItem>> drainedColumns;
+   drainedColumns.reserve(fBufferedColumns.size());
    for (auto &bufColumn : fBufferedColumns) {
-      for (auto &bufPage : bufColumn.DrainBufferedPages()) {
-         if (bufPage.IsSealed()) {
-            fInnerSink->CommitSealedPage(bufColumn.GetHandle().fId, bufPage.fSealedPage);
-         } else {
-            fInnerSink->CommitPage(bufColumn.GetHandle(), bufPage.fPage);
+      drainedColumns.emplace_back(bufColumn.DrainBufferedPages());
+      // Pages that were not sealed by a parallel task are sealed here, before the inner sink is locked
+      for (auto &bufPage : drainedColumns.back()) {
+         if (bufPage.IsSealed())
+            continue;
+         bufPage.AllocateSealedPageBuf();
+         bufPage.fSealedPage = SealPage(bufPage.fPage, *bufColumn.GetHandle().fColumn->GetElement(),
+                                        GetWriteOptions().GetCompression(), bufPage.fBuf.get());
+      }
+   }
+
+   RClusterDescriptor::RLocator locator;
+   {
+      auto guard = fInnerSink->GetSinkGuard();
+      const auto nBytesZipped = fInnerSink->GetNBytesZippedCommitted();
+      for (std::size_t i = 0; i < fBufferedColumns.size(); ++i) {
+         if (drainedColumns[i].empty())
+            continue;
+         // The statistics and checksums of the buffered pages have been computed when they were committed to this
+         // sink
+         const auto &pageInfos = fOpenPageRanges.at(fBufferedColumns[i].GetHandle().fId).fPageInfos;
+         for (auto &bufPage : drainedColumns[i]) {
+            bufPage.fSealedPage.fStatistics = pageInfos.at(bufPage.fPageInfoIndex).fStatistics;
+            bufPage.fSealedPage.fChecksum = pageInfos.at(bufPage.fPageInfoIndex).fChecksum;
+            fInnerSink->CommitSealedPage(fBufferedColumns[i].GetHandle().fId, bufPage.fSealedPage);
          }
-         ReleasePage(bufPage.fPage);
       }
+      fInnerSink->CommitCluster(nEntries);
+      // Only the size is meaningful; the locator of this sink is never written out
+      locator.fBytesOnStorage = fInnerSink->GetNBytesZippedCommitted() - nBytesZipped;
    }
-   fInnerSink->CommitCluster(nEntries);
-   // we're feeding bad locators to fOpenPageRanges but it should not matter
-   // because they never get written out
-   return RClusterDescriptor::RLocator{};
+
+   for (auto &drained : drainedColumns) {
+      for (auto &bufPage : drained)
+         ReleasePage(bufPage.fPage);
+   }
+   return locator;
 }
 
 void ROOT::Experimental::Detail::RPageSinkBuf::CommitDatasetImpl()
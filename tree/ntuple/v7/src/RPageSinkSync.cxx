@@ -0,0 +1,64 @@
+/// \file RPageSinkSync.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2021-06-14
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RPageSinkSync.hxx>
+
+ROOT::Experimental::Detail::RPageSynchronizingSink::RPageSynchronizingSink(RPageSink &inner, std::mutex &mutex)
+   : RPageSink(inner.GetNTupleName(), inner.GetWriteOptions()), fInnerSink(&inner), fMutex(&mutex)
+{
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSynchronizingSink::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   // The caller holds the guard returned by GetSinkGuard()
+   fInnerSink->CommitPage(columnHandle, page);
+   // The locators of this sink are never written out
+   return RClusterDescriptor::RLocator{};
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSynchronizingSink::CommitSealedPageImpl(DescriptorId_t columnId,
+                                                                         const RSealedPage &sealedPage)
+{
+   fInnerSink->CommitSealedPage(columnId, sealedPage);
+   return RClusterDescriptor::RLocator{};
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSynchronizingSink::CommitClusterImpl(NTupleSize_t nEntries)
+{
+   const auto nBytesZipped = fInnerSink->GetNBytesZippedCommitted();
+   // fPrevClusterNEntries is only updated after CommitClusterImpl() returns
+   fInnerSink->CommitCluster(fInnerSink->GetNCommittedEntries() + (nEntries - fPrevClusterNEntries));
+   RClusterDescriptor::RLocator locator;
+   locator.fBytesOnStorage = fInnerSink->GetNBytesZippedCommitted() - nBytesZipped;
+   return locator;
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSynchronizingSink::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
+{
+   if (nElements == 0)
+      nElements = GetWriteOptions().GetNElementsPerPage();
+   auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   return RPageAllocatorHeap::NewPage(columnHandle.fId, elementSize, nElements);
+}
+
+void ROOT::Experimental::Detail::RPageSynchronizingSink::ReleasePage(RPage &page)
+{
+   RPageAllocatorHeap::DeletePage(page);
+}
@@ -16,6 +16,7 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RColumn.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
@@ -31,6 +32,9 @@
 #include <Compression.h>
 #include <TError.h>
 
+#include <xxhash.h>
+
+#include <algorithm>
 #include <utility>
 
 
@@ -81,14 +85,48 @@ ROOT::Experimental::Detail::RPageSource::AddColumn(DescriptorId_t fieldId, const
    auto columnId = fDescriptor.FindColumnId(fieldId, column.GetIndex());
    R__ASSERT(columnId != kInvalidDescriptorId);
    fActiveColumns.emplace(columnId);
+   if (columnId < fColumnCounters.size() && !fColumnCounters[columnId]) {
+      auto counters = std::make_unique<RColumnCounters>(columnId, fDescriptor.GetQualifiedFieldName(fieldId));
+      fMetrics.ObserveMetrics(counters->fMetrics);
+      if (fMetrics.IsEnabled())
+         counters->fMetrics.Enable();
+      fColumnCounters[columnId] = std::move(counters);
+   }
    return ColumnHandle_t{columnId, &column};
 }
 
+ROOT::Experimental::Detail::RPageSource::RColumnCounters::RColumnCounters(DescriptorId_t columnId,
+                                                                          const std::string &fieldName)
+   : fMetrics("column" + std::to_string(columnId)),
+     fSzReadPayload(*fMetrics.MakeCounter<RNTupleAtomicCounter *>("szReadPayload", "B",
+                                                                  "volume read from storage for " + fieldName)),
+     fNPageUnzipped(*fMetrics.MakeCounter<RNTupleAtomicCounter *>("nPageUnzipped", "",
+                                                                  "number of unzipped pages of " + fieldName)),
+     fTimeWallUnzip(*fMetrics.MakeCounter<RNTupleAtomicCounter *>("timeWallUnzip", "ns",
+                                                                  "wall clock time spent decompressing " + fieldName)),
+     fTimeCpuUnzip(*fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter> *>(
+        "timeCpuUnzip", "ns", "CPU time spent decompressing " + fieldName)),
+     fTimeWallPopulate(*fMetrics.MakeCounter<RNTupleAtomicCounter *>(
+        "timeWallPopulate", "ns", "wall clock time spent populating pages of " + fieldName)),
+     fTimeCpuPopulate(*fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter> *>(
+        "timeCpuPopulate", "ns", "CPU time spent populating pages of " + fieldName))
+{
+}
+
 void ROOT::Experimental::Detail::RPageSource::DropColumn(ColumnHandle_t columnHandle)
 {
    fActiveColumns.erase(columnHandle.fId);
 }
 
+bool ROOT::Experimental::Detail::RPageSource::REntryRange::IntersectsWith(const RClusterDescriptor &clusterDesc) const
+{
+   if (fNEntries == kInvalidNTupleIndex)
+      return true;
+   const auto clusterFirst = clusterDesc.GetFirstEntryIndex();
+   const auto clusterEnd = clusterFirst + clusterDesc.GetNEntries();
+   return (clusterFirst < fFirstEntry + fNEntries) && (fFirstEntry < clusterEnd);
+}
+
 ROOT::Experimental::NTupleSize_t ROOT::Experimental::Detail::RPageSource::GetNEntries()
 {
    return fDescriptor.GetNEntries();
@@ -115,28 +153,67 @@ void ROOT::Experimental::Detail::RPageSource::UnzipCluster(RCluster *cluster)
 std::unique_ptr<unsigned char []> ROOT::Experimental::Detail::RPageSource::UnsealPage(
    const RSealedPage &sealedPage, const RColumnElementBase &element)
 {
-   const auto bytesPacked = element.GetPackedSize(sealedPage.fNElements);
    const auto pageSize = element.GetSize() * sealedPage.fNElements;
+   auto pageBuffer = std::make_unique<unsigned char[]>(pageSize);
+   UnsealPage(sealedPage, element, pageBuffer.get());
+   return pageBuffer;
+}
+
+void ROOT::Experimental::Detail::RPageSource::UnsealPage(
+   const RSealedPage &sealedPage, const RColumnElementBase &element, void *pageBuffer)
+{
+   const auto bytesPacked = element.GetPackedSize(sealedPage.fNElements);
+
+   // Mappable elements are unsealed in place; other elements need an intermediate buffer for the packed data
+   std::unique_ptr<unsigned char []> packedBuffer;
+   void *target = pageBuffer;
+   if (!element.IsMappable()) {
+      packedBuffer = std::make_unique<unsigned char[]>(bytesPacked);
+      target = packedBuffer.get();
+   }
 
-   // TODO(jblomer): We might be able to do better memory handling for unsealing pages than a new malloc for every
-   // new page.
-   auto pageBuffer = std::make_unique<unsigned char[]>(bytesPacked);
    if (sealedPage.fSize != bytesPacked) {
-      fDecompressor->Unzip(sealedPage.fBuffer, sealedPage.fSize, bytesPacked, pageBuffer.get());
+      fDecompressor->Unzip(sealedPage.fBuffer, sealedPage.fSize, bytesPacked, target);
    } else {
       // We cannot simply map the sealed page as we don't know its life time. Specialized page sources
       // may decide to implement to not use UnsealPage but to custom mapping / decompression code.
       // Note that usually pages are compressed.
-      memcpy(pageBuffer.get(), sealedPage.fBuffer, bytesPacked);
+      memcpy(target, sealedPage.fBuffer, bytesPacked);
    }
 
-   if (!element.IsMappable()) {
-      auto unpackedBuffer = new unsigned char[pageSize];
-      element.Unpack(unpackedBuffer, pageBuffer.get(), sealedPage.fNElements);
-      pageBuffer = std::unique_ptr<unsigned char []>(unpackedBuffer);
-   }
+   if (!element.IsMappable())
+      element.Unpack(pageBuffer, packedBuffer.get(), sealedPage.fNElements);
+}
 
-   return pageBuffer;
+bool ROOT::Experimental::Detail::RPageSource::VerifyPageChecksum(DescriptorId_t columnId, DescriptorId_t clusterId,
+                                                                 NTupleSize_t pageNo,
+                                                                 const std::optional<std::uint64_t> &checksum,
+                                                                 const void *buffer, std::size_t nBytes)
+{
+   if (!checksum || !fOptions.GetVerifyPageChecksums())
+      return true;
+   if (XXH64(buffer, nBytes, 0) == *checksum)
+      return true;
+
+   R__LOG_ERROR(NTupleLog()) << "checksum mismatch in page " << pageNo << " of column " << columnId << " in cluster "
+                             << clusterId << " of " << fNTupleName;
+   fCounters->fNPageCorrupt.Inc();
+   std::lock_guard<std::mutex> guard(fLockCorruptPages);
+   fCorruptPages.emplace(columnId, clusterId, pageNo);
+   fHasCorruptPages = true;
+   return false;
+}
+
+void ROOT::Experimental::Detail::RPageSource::EnsurePageIntegrity(DescriptorId_t columnId, DescriptorId_t clusterId,
+                                                                  NTupleSize_t pageNo)
+{
+   if (!fHasCorruptPages)
+      return;
+   std::lock_guard<std::mutex> guard(fLockCorruptPages);
+   if (fCorruptPages.count({columnId, clusterId, pageNo}) > 0) {
+      throw RException(R__FAIL("checksum mismatch in page " + std::to_string(pageNo) + " of column " +
+                               std::to_string(columnId) + " in cluster " + std::to_string(clusterId)));
+   }
 }
 
 void ROOT::Experimental::Detail::RPageSource::EnableDefaultMetrics(const std::string &prefix)
@@ -152,6 +229,7 @@ void ROOT::Experimental::Detail::RPageSource::EnableDefaultMetrics(const std::st
                                                    "number of partial clusters preloaded from storage"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPageLoaded", "", "number of pages loaded from storage"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPagePopulated", "", "number of populated pages"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPageCorrupt", "", "number of pages with a checksum mismatch"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallRead", "ns", "wall clock time spent reading"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallUnzip", "ns", "wall clock time spent decompressing"),
       *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter>*>("timeCpuRead", "ns", "CPU time spent reading"),
@@ -323,9 +401,17 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
 void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHandle, const RPage &page)
 {
    fOpenColumnRanges.at(columnHandle.fId).fNElements += page.GetNElements();
+   fNBytesOpenCluster += page.GetSize();
 
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = page.GetNElements();
+   if (GetWriteOptions().GetUseColumnStatistics()) {
+      RColumnStatistics statistics;
+      if (columnHandle.fColumn->GetElement()->UpdateStatistics(page.GetBuffer(), page.GetNElements(), statistics))
+         pageInfo.fStatistics = statistics;
+   }
+   if (GetWriteOptions().GetUsePageChecksums())
+      pageInfo.fChecksum = XXH64(page.GetBuffer(), page.GetSize(), 0);
    pageInfo.fLocator = CommitPageImpl(columnHandle, page);
    fOpenPageRanges.at(columnHandle.fId).fPageInfos.emplace_back(pageInfo);
 }
@@ -339,6 +425,8 @@ void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(
 
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = sealedPage.fNElements;
+   pageInfo.fStatistics = sealedPage.fStatistics;
+   pageInfo.fChecksum = sealedPage.fChecksum;
    pageInfo.fLocator = CommitSealedPageImpl(columnId, sealedPage);
    fOpenPageRanges.at(columnId).fPageInfos.emplace_back(pageInfo);
 }
@@ -353,6 +441,15 @@ void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NT
                                  ClusterSize_t(nEntries - fPrevClusterNEntries));
    fDescriptorBuilder.SetClusterLocator(fLastClusterId, locator);
    for (auto &range : fOpenColumnRanges) {
+      // The cluster statistics are only set if all the pages of the column have statistics
+      const auto &pageInfos = fOpenPageRanges.at(range.fColumnId).fPageInfos;
+      range.fStatistics.reset();
+      if (!pageInfos.empty() && std::all_of(pageInfos.begin(), pageInfos.end(),
+                                            [](const auto &pi) { return pi.fStatistics.has_value(); })) {
+         range.fStatistics = RColumnStatistics();
+         for (const auto &pi : pageInfos)
+            range.fStatistics->Merge(*pi.fStatistics);
+      }
       fDescriptorBuilder.AddClusterColumnRange(fLastClusterId, range);
       range.fFirstElementIndex += range.fNElements;
       range.fNElements = 0;
@@ -365,6 +462,9 @@ void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NT
    }
    ++fLastClusterId;
    fPrevClusterNEntries = nEntries;
+   fNBytesUnzippedCommitted += fNBytesOpenCluster;
+   fNBytesZippedCommitted += locator.fBytesOnStorage;
+   fNBytesOpenCluster = 0;
 }
 
 ROOT::Experimental::Detail::RPageStorage::RSealedPage
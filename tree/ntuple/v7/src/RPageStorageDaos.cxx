@@ -177,10 +177,15 @@ ROOT::Experimental::Detail::RPageSinkDaos::CommitSealedPageImpl(
    DescriptorId_t /*columnId*/, const RPageStorage::RSealedPage &sealedPage)
 {
    auto offsetData = fOid.fetch_add(1);
+   // The sealed page buffer is only valid during the call; the page is written in WritePendingPages()
+   RPendingPage pendingPage;
+   pendingPage.fOid = offsetData;
+   pendingPage.fBuffer = std::make_unique<unsigned char[]>(sealedPage.fSize);
+   pendingPage.fSize = sealedPage.fSize;
+   memcpy(pendingPage.fBuffer.get(), sealedPage.fBuffer, sealedPage.fSize);
    {
-      RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
-      fDaosContainer->WriteSingleAkey(sealedPage.fBuffer, sealedPage.fSize,
-                                      {offsetData, 0}, kDistributionKey, kAttributeKey);
+      std::lock_guard<std::mutex> guard(fLockPendingPages);
+      fPendingPages.emplace_back(std::move(pendingPage));
    }
 
    RClusterDescriptor::RLocator result;
@@ -198,12 +203,44 @@ ROOT::Experimental::Detail::RPageSinkDaos::CommitSealedPageImpl(
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkDaos::CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */)
 {
+   WritePendingPages();
    return {};
 }
 
 
+void ROOT::Experimental::Detail::RPageSinkDaos::WritePendingPages()
+{
+   std::vector<RPendingPage> pendingPages;
+   {
+      std::lock_guard<std::mutex> guard(fLockPendingPages);
+      std::swap(pendingPages, fPendingPages);
+   }
+   if (pendingPages.empty())
+      return;
+
+   std::vector<RDaosContainer::RWOperation> writeRequests;
+   writeRequests.reserve(pendingPages.size());
+   for (auto &p : pendingPages) {
+      std::vector<d_iov_t> iovs(1);
+      d_iov_set(&iovs[0], p.fBuffer.get(), p.fSize);
+      writeRequests.emplace_back(daos_obj_id_t{p.fOid, 0}, kDistributionKey, kAttributeKey, iovs);
+   }
+
+   int nFailed;
+   {
+      RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
+      nFailed = fDaosContainer->WriteV(writeRequests);
+   }
+   if (nFailed != 0)
+      throw ROOT::Experimental::RException(R__FAIL("failed to write " + std::to_string(nFailed) + " of " +
+                                                   std::to_string(writeRequests.size()) + " pages"));
+}
+
+
 void ROOT::Experimental::Detail::RPageSinkDaos::CommitDatasetImpl()
 {
+   WritePendingPages();
+
    const auto &descriptor = fDescriptorBuilder.GetDescriptor();
    auto szFooter = descriptor.GetFooterSize();
    auto buffer = std::make_unique<unsigned char []>(szFooter);
@@ -389,6 +426,7 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceDaos::P
       auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, idxInCluster));
       if (!cachedPage.IsNull())
          return cachedPage;
+      EnsurePageIntegrity(columnId, clusterId, pageInfo.fPageNo);
 
       ROnDiskPage::Key key(columnId, pageInfo.fPageNo);
       auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
@@ -402,6 +440,9 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceDaos::P
       pageBuffer = UnsealPage({sealedPageBuffer, bytesOnStorage, pageInfo.fNElements}, *element);
       fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
    }
+   if (!VerifyPageChecksum(columnId, clusterId, pageInfo.fPageNo, pageInfo.fChecksum, pageBuffer.get(),
+                           elementSize * pageInfo.fNElements))
+      EnsurePageIntegrity(columnId, clusterId, pageInfo.fPageNo); // throws
 
    const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
    auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), elementSize, pageInfo.fNElements);
@@ -512,10 +553,14 @@ ROOT::Experimental::Detail::RPageSourceDaos::LoadCluster(DescriptorId_t clusterI
    }
    fCounters->fNPageLoaded.Add(onDiskPages.size());
 
+   int nFailed;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
-      fDaosContainer->ReadV(readRequests);
+      nFailed = fDaosContainer->ReadV(readRequests);
    }
+   if (nFailed != 0)
+      throw ROOT::Experimental::RException(R__FAIL("failed to read " + std::to_string(nFailed) + " of " +
+                                                   std::to_string(readRequests.size()) + " pages"));
    fCounters->fNReadV.Inc();
    fCounters->fNRead.Add(readRequests.size());
 
@@ -552,13 +597,17 @@ void ROOT::Experimental::Detail::RPageSourceDaos::UnzipClusterImpl(RCluster *clu
          R__ASSERT(onDiskPage && (onDiskPage->GetSize() == pi.fLocator.fBytesOnStorage));
 
          auto taskFunc =
-            [this, columnId, clusterId, firstInPage, onDiskPage,
+            [this, columnId, clusterId, firstInPage, pageNo, onDiskPage,
              element = allElements.back().get(),
              nElements = pi.fNElements,
+             checksum = pi.fChecksum,
              indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex
             ] () {
                auto pageBuffer = UnsealPage({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
                fCounters->fSzUnzip.Add(element->GetSize() * nElements);
+               if (!VerifyPageChecksum(columnId, clusterId, pageNo, checksum, pageBuffer.get(),
+                                       element->GetSize() * nElements))
+                  return;
 
                auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), element->GetSize(), nElements);
                newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
@@ -33,15 +33,117 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <utility>
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <thread>
 #include <queue>
 
+class ROOT::Experimental::Detail::RPageSinkFile::RAsyncWriter {
+private:
+   std::unique_ptr<Internal::RNTupleFileWriter::RReservedBlobWriter> fBlobWriter;
+   RNTupleAtomicCounter &fTimeWallWrite;
+   RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuWrite;
+   const std::size_t fMaxQueueSize;
+
+   std::mutex fLock;
+   /// Signals new batches or the request to stop to the I/O thread
+   std::condition_variable fCvWork;
+   /// Signals the completion of a batch to the filling thread
+   std::condition_variable fCvDone;
+   /// The front element is the batch currently being written
+   std::deque<RWriteBatch> fQueue;
+   bool fIsStopping = false;
+   /// Set by the I/O thread on failure, reported to the filling thread on the next push or drain
+   std::string fError;
+   std::thread fThread;
+
+   void Work()
+   {
+      std::unique_lock<std::mutex> lock(fLock);
+      while (true) {
+         fCvWork.wait(lock, [this] { return !fQueue.empty() || fIsStopping; });
+         if (fQueue.empty())
+            return;
+
+         auto &batch = fQueue.front();
+         lock.unlock();
+         bool isOk;
+         {
+            RNTupleAtomicTimer timer(fTimeWallWrite, fTimeCpuWrite);
+            isOk = fBlobWriter->Write(batch.fBuffer.data(), batch.fBuffer.size(), batch.fOffset);
+         }
+         lock.lock();
+         if (!isOk && fError.empty())
+            fError = "cannot write " + std::to_string(batch.fBuffer.size()) + " bytes at offset " +
+                     std::to_string(batch.fOffset);
+         fQueue.pop_front();
+         fCvDone.notify_all();
+      }
+   }
+
+   void ThrowOnError()
+   {
+      if (!fError.empty())
+         throw RException(R__FAIL("asynchronous page write failed: " + fError));
+   }
+
+public:
+   RAsyncWriter(std::unique_ptr<Internal::RNTupleFileWriter::RReservedBlobWriter> blobWriter,
+                std::size_t maxQueueSize, RNTupleAtomicCounter &timeWallWrite,
+                RNTupleTickCounter<RNTupleAtomicCounter> &timeCpuWrite)
+      : fBlobWriter(std::move(blobWriter)),
+        fTimeWallWrite(timeWallWrite),
+        fTimeCpuWrite(timeCpuWrite),
+        fMaxQueueSize(std::max(maxQueueSize, std::size_t(1)))
+   {
+      fThread = std::thread(&RAsyncWriter::Work, this);
+   }
+
+   RAsyncWriter(const RAsyncWriter &other) = delete;
+   RAsyncWriter &operator=(const RAsyncWriter &other) = delete;
+
+   /// Queued batches are still written before the I/O thread terminates
+   ~RAsyncWriter()
+   {
+      {
+         std::lock_guard<std::mutex> guard(fLock);
+         fIsStopping = true;
+      }
+      fCvWork.notify_one();
+      fThread.join();
+   }
+
+   /// Blocks while the queue is full
+   void Push(RWriteBatch &&batch)
+   {
+      {
+         std::unique_lock<std::mutex> lock(fLock);
+         fCvDone.wait(lock, [this] { return fQueue.size() < fMaxQueueSize; });
+         ThrowOnError();
+         fQueue.emplace_back(std::move(batch));
+      }
+      fCvWork.notify_one();
+   }
+
+   /// Waits until all queued batches are written and flushed
+   void Drain()
+   {
+      std::unique_lock<std::mutex> lock(fLock);
+      fCvDone.wait(lock, [this] { return fQueue.empty(); });
+      if (!fBlobWriter->Flush() && fError.empty())
+         fError = "cannot flush written pages";
+      ThrowOnError();
+   }
+};
+
+
 ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntupleName,
    const RNTupleWriteOptions &options)
    : RPageSink(ntupleName, options)
@@ -96,6 +198,12 @@ void ROOT::Experimental::Detail::RPageSinkFile::CreateImpl(const RNTupleModel &
    auto szZipHeader = fCompressor->Zip(buffer.get(), szHeader, GetWriteOptions().GetCompression(),
       [&zipBuffer](const void *b, size_t n, size_t o){ memcpy(zipBuffer.get() + o, b, n); } );
    fWriter->WriteNTupleHeader(zipBuffer.get(), szZipHeader, szHeader);
+
+   if (GetWriteOptions().GetUseAsyncWrite() && fWriter->CanReserveBlobs()) {
+      fAsyncWriter = std::make_unique<RAsyncWriter>(fWriter->CreateReservedBlobWriter(),
+                                                    GetWriteOptions().GetAsyncWriteQueueSize(),
+                                                    fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
+   }
 }
 
 
@@ -104,7 +212,17 @@ ROOT::Experimental::Detail::RPageSinkFile::WriteSealedPage(
    const RPageStorage::RSealedPage &sealedPage, std::size_t bytesPacked)
 {
    std::uint64_t offsetData;
-   {
+   if (fAsyncWriter) {
+      offsetData = fWriter->ReserveBlob(sealedPage.fSize, bytesPacked, fKeyBuffer);
+      const auto offsetKey = offsetData - fKeyBuffer.size();
+      if (fOpenBatch.fBuffer.empty())
+         fOpenBatch.fOffset = offsetKey;
+      // Nothing else is written to the file while the ntuple is filled, so the blobs of a cluster are adjacent
+      R__ASSERT(fOpenBatch.fOffset + fOpenBatch.fBuffer.size() == offsetKey);
+      fOpenBatch.fBuffer.insert(fOpenBatch.fBuffer.end(), fKeyBuffer.begin(), fKeyBuffer.end());
+      auto payload = static_cast<const unsigned char *>(sealedPage.fBuffer);
+      fOpenBatch.fBuffer.insert(fOpenBatch.fBuffer.end(), payload, payload + sealedPage.fSize);
+   } else {
       RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
       offsetData = fWriter->WriteBlob(sealedPage.fBuffer, sealedPage.fSize, bytesPacked);
    }
@@ -155,12 +273,24 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitClusterImpl(ROOT::Experimental:
    result.fBytesOnStorage = fClusterMaxOffset - fClusterMinOffset;
    fClusterMinOffset = std::uint64_t(-1);
    fClusterMaxOffset = 0;
+
+   if (fAsyncWriter && !fOpenBatch.fBuffer.empty()) {
+      fAsyncWriter->Push(std::move(fOpenBatch));
+      fOpenBatch = RWriteBatch();
+   }
    return result;
 }
 
 
 void ROOT::Experimental::Detail::RPageSinkFile::CommitDatasetImpl()
 {
+   if (fAsyncWriter) {
+      if (!fOpenBatch.fBuffer.empty())
+         fAsyncWriter->Push(std::move(fOpenBatch));
+      fAsyncWriter->Drain();
+      fAsyncWriter.reset();
+   }
+
    const auto &descriptor = fDescriptorBuilder.GetDescriptor();
    auto szFooter = descriptor.GetFooterSize();
    auto buffer = std::make_unique<unsigned char []>(szFooter);
@@ -180,11 +310,17 @@ ROOT::Experimental::Detail::RPageSinkFile::ReservePage(ColumnHandle_t columnHand
    if (nElements == 0)
       nElements = GetWriteOptions().GetNElementsPerPage();
    auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   if (GetWriteOptions().GetUsePageBufferPool())
+      return RPageAllocatorPool::Instance().NewPage(columnHandle.fId, elementSize, nElements);
    return fPageAllocator->NewPage(columnHandle.fId, elementSize, nElements);
 }
 
 void ROOT::Experimental::Detail::RPageSinkFile::ReleasePage(RPage &page)
 {
+   if (GetWriteOptions().GetUsePageBufferPool()) {
+      RPageAllocatorPool::Instance().DeletePage(page);
+      return;
+   }
    fPageAllocator->DeletePage(page);
 }
 
@@ -220,6 +356,11 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
 {
    fDecompressor = std::make_unique<RNTupleDecompressor>();
    EnableDefaultMetrics("RPageSourceFile");
+   fMetrics.ObserveMetrics(fClusterPool->GetMetrics());
+   if (fOptions.GetSharedPageCacheSize() > 0) {
+      fSharedPagePool = RPagePool::GetSharedPool();
+      fSharedPagePool->SetMaxUnusedBytes(fOptions.GetSharedPageCacheSize());
+   }
 }
 
 
@@ -233,7 +374,46 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
 }
 
 
-ROOT::Experimental::Detail::RPageSourceFile::~RPageSourceFile() = default;
+ROOT::Experimental::Detail::RPageSourceFile::~RPageSourceFile()
+{
+   // The cluster pool may still hold on-disk pages that point into the mapping
+   fClusterPool.reset();
+   if (fMappedFile && fFile)
+      fFile->Unmap(fMappedFile, fMappedSize);
+}
+
+
+void ROOT::Experimental::Detail::RPageSourceFile::MapFile()
+{
+   if (!fOptions.GetUseMmap() || fMappedFile)
+      return;
+   const auto requiredFeatures = ROOT::Internal::RRawFile::kFeatureHasMmap | ROOT::Internal::RRawFile::kFeatureHasSize;
+   if ((fFile->GetFeatures() & requiredFeatures) != requiredFeatures)
+      return;
+
+   const auto fileSize = fFile->GetSize();
+   if (fileSize == 0 || fileSize > std::numeric_limits<std::size_t>::max())
+      return;
+   std::uint64_t mapdOffset = 0;
+   fMappedFile = fFile->Map(fileSize, 0, mapdOffset);
+   R__ASSERT(mapdOffset == 0);
+   fMappedSize = fileSize;
+}
+
+
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::TryMapPage(
+   DescriptorId_t columnId, const void *sealedBuffer, std::uint32_t bytesOnStorage,
+   const RColumnElementBase &element, ClusterSize_t::ValueType nElements)
+{
+   const auto elementSize = element.GetSize();
+   if (!fMappedFile || !element.IsMappable() || (bytesOnStorage != elementSize * nElements) ||
+       (reinterpret_cast<std::uintptr_t>(sealedBuffer) % elementSize != 0))
+   {
+      return RPage();
+   }
+   // The page pool treats the buffer as read-only; the mapping outlives all pages of this page source
+   return fPageAllocator->NewPage(columnId, const_cast<void *>(sealedBuffer), elementSize, nElements);
+}
 
 
 ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Detail::RPageSourceFile::AttachImpl()
@@ -253,6 +433,15 @@ ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Detail::RPageSourceFil
    fDecompressor->Unzip(zipBuffer.get(), ntpl.fNBytesFooter, ntpl.fLenFooter, buffer.get());
    descBuilder.AddClustersFromFooter(buffer.get());
 
+   if (fSharedPagePool) {
+      // The footer location tells apart different ntuples with the same name written to the same path over time
+      fSharedPoolStorageId = fSharedPagePool->GetStorageId(fFile->GetUrl() + ":" + fNTupleName + ":" +
+                                                           std::to_string(ntpl.fSeekFooter) + ":" +
+                                                           std::to_string(ntpl.fNBytesFooter));
+   }
+
+   MapFile();
+
    return descBuilder.MoveDescriptor();
 }
 
@@ -272,11 +461,55 @@ void ROOT::Experimental::Detail::RPageSourceFile::LoadSealedPage(
       fReader.ReadBuffer(const_cast<void *>(sealedPage.fBuffer), bytesOnStorage, pageInfo.fLocator.fPosition);
 }
 
+template <typename IndexT>
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSourceFile::GetCachedPage(ColumnId_t columnId, const IndexT &index)
+{
+   auto cachedPage = fPagePool->GetPage(columnId, index);
+   if (cachedPage.IsNull() && fSharedPagePool)
+      cachedPage = fSharedPagePool->GetPage(columnId, index, fSharedPoolStorageId);
+   return cachedPage;
+}
+
+void *ROOT::Experimental::Detail::RPageSourceFile::UnsealToNewBuffer(const RSealedPage &sealedPage,
+                                                                     const RColumnElementBase &element)
+{
+   if (!fOptions.GetUsePageBufferPool())
+      return UnsealPage(sealedPage, element).release();
+
+   const auto pageSize = element.GetSize() * sealedPage.fNElements;
+   auto pageBuffer = RPageAllocatorPool::Instance().Allocate(pageSize);
+   try {
+      UnsealPage(sealedPage, element, pageBuffer);
+   } catch (...) {
+      RPageAllocatorPool::Instance().Release(pageBuffer, pageSize);
+      throw;
+   }
+   return pageBuffer;
+}
+
+void ROOT::Experimental::Detail::RPageSourceFile::AddUnzippedPage(const RPage &page, bool isPreload)
+{
+   RPageDeleter deleter([](const RPage &p, void * /*userData*/) { RPageAllocatorFile::DeletePage(p); }, nullptr);
+   if (fOptions.GetUsePageBufferPool())
+      deleter = RPageDeleter([](const RPage &p, void *) { RPageAllocatorPool::Instance().DeletePage(p); }, nullptr);
+   auto &pool = fSharedPagePool ? *fSharedPagePool : *fPagePool;
+   const auto storageId = fSharedPagePool ? fSharedPoolStorageId : 0;
+   if (isPreload)
+      pool.PreloadPage(page, deleter, storageId);
+   else
+      pool.RegisterPage(page, deleter, storageId);
+}
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(
    ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor, ClusterSize_t::ValueType idxInCluster)
 {
    const auto columnId = columnHandle.fId;
    const auto clusterId = clusterDescriptor.GetId();
+   auto columnCounters = GetColumnCounters(columnId);
+   std::optional<RNTupleAtomicTimer> populateTimer;
+   if (columnCounters)
+      populateTimer.emplace(columnCounters->fTimeWallPopulate, columnCounters->fTimeCpuPopulate);
 
    auto pageInfo = clusterDescriptor.GetPageRange(columnId).Find(idxInCluster);
 
@@ -288,20 +521,27 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    std::unique_ptr<unsigned char []> directReadBuffer; // only used if cluster pool is turned off
 
    if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
-      directReadBuffer = std::make_unique<unsigned char[]>(bytesOnStorage);
-      fReader.ReadBuffer(directReadBuffer.get(), bytesOnStorage, pageInfo.fLocator.fPosition);
+      if (fMappedFile) {
+         sealedPageBuffer = reinterpret_cast<unsigned char *>(fMappedFile) + pageInfo.fLocator.fPosition;
+      } else {
+         directReadBuffer = std::make_unique<unsigned char[]>(bytesOnStorage);
+         fReader.ReadBuffer(directReadBuffer.get(), bytesOnStorage, pageInfo.fLocator.fPosition);
+         fCounters->fNRead.Inc();
+         fCounters->fSzReadPayload.Add(bytesOnStorage);
+         if (columnCounters)
+            columnCounters->fSzReadPayload.Add(bytesOnStorage);
+         sealedPageBuffer = directReadBuffer.get();
+      }
       fCounters->fNPageLoaded.Inc();
-      fCounters->fNRead.Inc();
-      fCounters->fSzReadPayload.Add(bytesOnStorage);
-      sealedPageBuffer = directReadBuffer.get();
    } else {
       if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
          fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
       R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
 
-      auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, idxInCluster));
+      auto cachedPage = GetCachedPage(columnId, RClusterIndex(clusterId, idxInCluster));
       if (!cachedPage.IsNull())
          return cachedPage;
+      EnsurePageIntegrity(columnId, clusterId, pageInfo.fPageNo);
 
       ROnDiskPage::Key key(columnId, pageInfo.fPageNo);
       auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
@@ -309,21 +549,43 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
       sealedPageBuffer = onDiskPage->GetAddress();
    }
 
-   std::unique_ptr<unsigned char []> pageBuffer;
+   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+   const auto pageSize = elementSize * pageInfo.fNElements;
+   // Pages of clusters unzipped in the background have been verified by the unzip tasks; we only get here for such
+   // pages if another reader of the shared page cache dropped them in the meantime
+   auto newPage = TryMapPage(columnId, sealedPageBuffer, bytesOnStorage, *element, pageInfo.fNElements);
+   if (!newPage.IsNull()) {
+      if (!VerifyPageChecksum(columnId, clusterId, pageInfo.fPageNo, pageInfo.fChecksum, newPage.GetBuffer(),
+                              pageSize))
+         EnsurePageIntegrity(columnId, clusterId, pageInfo.fPageNo); // throws
+      newPage.SetWindow(indexOffset + pageInfo.fFirstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+      fPagePool->RegisterPage(newPage, RPageDeleter([](const RPage &, void *) {}, nullptr));
+      fCounters->fNPagePopulated.Inc();
+      return newPage;
+   }
+
+   void *pageBuffer = nullptr;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
-      pageBuffer = UnsealPage({sealedPageBuffer, bytesOnStorage, pageInfo.fNElements}, *element);
-      fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
+      std::optional<RNTupleAtomicTimer> columnTimer;
+      if (columnCounters)
+         columnTimer.emplace(columnCounters->fTimeWallUnzip, columnCounters->fTimeCpuUnzip);
+      pageBuffer = UnsealToNewBuffer({sealedPageBuffer, bytesOnStorage, pageInfo.fNElements}, *element);
+      fCounters->fSzUnzip.Add(pageSize);
+   }
+   if (columnCounters)
+      columnCounters->fNPageUnzipped.Inc();
+   if (!VerifyPageChecksum(columnId, clusterId, pageInfo.fPageNo, pageInfo.fChecksum, pageBuffer, pageSize)) {
+      if (fOptions.GetUsePageBufferPool())
+         RPageAllocatorPool::Instance().Release(pageBuffer, pageSize);
+      else
+         delete[] static_cast<unsigned char *>(pageBuffer);
+      EnsurePageIntegrity(columnId, clusterId, pageInfo.fPageNo); // throws
    }
 
-   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
-   auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), elementSize, pageInfo.fNElements);
+   newPage = fPageAllocator->NewPage(columnId, pageBuffer, elementSize, pageInfo.fNElements);
    newPage.SetWindow(indexOffset + pageInfo.fFirstInPage, RPage::RClusterInfo(clusterId, indexOffset));
-   fPagePool->RegisterPage(newPage,
-      RPageDeleter([](const RPage &page, void * /*userData*/)
-      {
-         RPageAllocatorFile::DeletePage(page);
-      }, nullptr));
+   AddUnzippedPage(newPage, false /* isPreload */);
    fCounters->fNPagePopulated.Inc();
    return newPage;
 }
@@ -333,7 +595,7 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    ColumnHandle_t columnHandle, NTupleSize_t globalIndex)
 {
    const auto columnId = columnHandle.fId;
-   auto cachedPage = fPagePool->GetPage(columnId, globalIndex);
+   auto cachedPage = GetCachedPage(columnId, globalIndex);
    if (!cachedPage.IsNull())
       return cachedPage;
 
@@ -352,7 +614,7 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto clusterId = clusterIndex.GetClusterId();
    const auto idxInCluster = clusterIndex.GetIndex();
    const auto columnId = columnHandle.fId;
-   auto cachedPage = fPagePool->GetPage(columnId, clusterIndex);
+   auto cachedPage = GetCachedPage(columnId, clusterIndex);
    if (!cachedPage.IsNull())
       return cachedPage;
 
@@ -363,7 +625,10 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
 
 void ROOT::Experimental::Detail::RPageSourceFile::ReleasePage(RPage &page)
 {
-   fPagePool->ReturnPage(page);
+   if (fPagePool->TryReturnPage(page))
+      return;
+   R__ASSERT(fSharedPagePool);
+   fSharedPagePool->ReturnPage(page);
 }
 
 std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Detail::RPageSourceFile::Clone() const
@@ -401,13 +666,33 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
    for (auto columnId : columns) {
       const auto &pageRange = clusterDesc.GetPageRange(columnId);
       NTupleSize_t pageNo = 0;
+      std::uint64_t columnSize = 0;
       for (const auto &pageInfo : pageRange.fPageInfos) {
          const auto &pageLocator = pageInfo.fLocator;
-         activeSize += pageLocator.fBytesOnStorage;
+         columnSize += pageLocator.fBytesOnStorage;
          onDiskPages.emplace_back(ROnDiskPageLocator(
             columnId, pageNo, pageLocator.fPosition, pageLocator.fBytesOnStorage));
          ++pageNo;
       }
+      activeSize += columnSize;
+      if (auto columnCounters = GetColumnCounters(columnId))
+         columnCounters->fSzReadPayload.Add(columnSize);
+   }
+
+   if (fMappedFile) {
+      // The pages are referenced in place; the page map does not own the memory
+      auto pageMap = std::make_unique<ROnDiskPageMap>();
+      for (const auto &s : onDiskPages) {
+         R__ASSERT(s.fOffset + s.fSize <= fMappedSize);
+         ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
+         pageMap->Register(key, ROnDiskPage(reinterpret_cast<unsigned char *>(fMappedFile) + s.fOffset, s.fSize));
+      }
+      fCounters->fNPageLoaded.Add(onDiskPages.size());
+      auto cluster = std::make_unique<RCluster>(clusterId);
+      cluster->Adopt(std::move(pageMap));
+      for (auto colId : columns)
+         cluster->SetColumnAvailable(colId);
+      return cluster;
    }
 
    // Linearize the page requests by file offset
@@ -419,22 +704,27 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
    // The size of the cutoff is given by the fraction of extra bytes we are willing to read in order to reduce
    // the number of read requests.  We thus schedule the lowest number of requests given a tolerable fraction
    // of extra bytes.
+   // The cutoff can also be fixed through the read options, e.g. according to link latency and speed.
    // TODO(jblomer): Eventually we may want to select the parameter at runtime according to link latency and speed,
    // memory consumption, device block size.
-   float maxOverhead = 0.25 * float(activeSize);
-   std::vector<std::size_t> gaps;
-   for (unsigned i = 1; i < onDiskPages.size(); ++i) {
-      gaps.emplace_back(onDiskPages[i].fOffset - (onDiskPages[i-1].fSize + onDiskPages[i-1].fOffset));
-   }
-   std::sort(gaps.begin(), gaps.end());
-   std::size_t gapCut = 0;
-   float szExtra = 0.0;
-   for (auto g : gaps) {
-      szExtra += g;
-      if (szExtra  > maxOverhead)
-         break;
-      gapCut = g;
+   std::uint64_t gapCut = fOptions.GetMaxCoalesceGap();
+   if (gapCut == RNTupleReadOptions::kAutoCoalesceGap) {
+      float maxOverhead = 0.25 * float(activeSize);
+      std::vector<std::size_t> gaps;
+      for (unsigned i = 1; i < onDiskPages.size(); ++i) {
+         gaps.emplace_back(onDiskPages[i].fOffset - (onDiskPages[i-1].fSize + onDiskPages[i-1].fOffset));
+      }
+      std::sort(gaps.begin(), gaps.end());
+      gapCut = 0;
+      float szExtra = 0.0;
+      for (auto g : gaps) {
+         szExtra += g;
+         if (szExtra  > maxOverhead)
+            break;
+         gapCut = g;
+      }
    }
+   const auto maxRequestSize = fOptions.GetMaxReadRequestSize();
 
    // Prepare the input vector for the RRawFile::ReadV() call
    struct RReadRequest {
@@ -455,7 +745,8 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
       R__ASSERT(s.fOffset >= readUpTo);
       auto overhead = s.fOffset - readUpTo;
       szPayload += s.fSize;
-      if (overhead <= gapCut) {
+      const bool fitsRequest = (maxRequestSize == 0) || (req.fSize + overhead + s.fSize <= maxRequestSize);
+      if ((req.fSize > 0) && (overhead <= gapCut) && fitsRequest) {
          szOverhead += overhead;
          s.fBufPos = reinterpret_cast<intptr_t>(req.fBuffer) + req.fSize + overhead;
          req.fSize += overhead + s.fSize;
@@ -513,6 +804,7 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
    const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
 
    std::vector<std::unique_ptr<RColumnElementBase>> allElements;
+   std::size_t nSkipped = 0;
 
    const auto &columnsInCluster = cluster->GetAvailColumns();
    for (const auto columnId : columnsInCluster) {
@@ -528,22 +820,57 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
          auto onDiskPage = cluster->GetOnDiskPage(key);
          R__ASSERT(onDiskPage && (onDiskPage->GetSize() == pi.fLocator.fBytesOnStorage));
 
+         // Another reader of the same ntuple may already have unzipped the page
+         if (fSharedPagePool &&
+             fSharedPagePool->ContainsPage(columnId, RClusterIndex(clusterId, firstInPage), fSharedPoolStorageId))
+         {
+            nSkipped++;
+            firstInPage += pi.fNElements;
+            pageNo++;
+            continue;
+         }
+
          auto taskFunc =
-            [this, columnId, clusterId, firstInPage, onDiskPage,
+            [this, columnId, clusterId, firstInPage, pageNo, onDiskPage,
              element = allElements.back().get(),
              nElements = pi.fNElements,
+             checksum = pi.fChecksum,
              indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex
             ] () {
-               auto pageBuffer = UnsealPage({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
-               fCounters->fSzUnzip.Add(element->GetSize() * nElements);
-
-               auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), element->GetSize(), nElements);
+               const auto pageSize = element->GetSize() * nElements;
+               auto mappedPage = TryMapPage(columnId, onDiskPage->GetAddress(), onDiskPage->GetSize(), *element,
+                                            nElements);
+               if (!mappedPage.IsNull()) {
+                  if (!VerifyPageChecksum(columnId, clusterId, pageNo, checksum, mappedPage.GetBuffer(), pageSize))
+                     return;
+                  mappedPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+                  fPagePool->PreloadPage(mappedPage, RPageDeleter([](const RPage &, void *) {}, nullptr));
+                  return;
+               }
+               void *pageBuffer = nullptr;
+               {
+                  auto columnCounters = GetColumnCounters(columnId);
+                  std::optional<RNTupleAtomicTimer> columnTimer;
+                  if (columnCounters) {
+                     columnTimer.emplace(columnCounters->fTimeWallUnzip, columnCounters->fTimeCpuUnzip);
+                     columnCounters->fNPageUnzipped.Inc();
+                  }
+                  pageBuffer =
+                     UnsealToNewBuffer({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
+               }
+               fCounters->fSzUnzip.Add(pageSize);
+
+               if (!VerifyPageChecksum(columnId, clusterId, pageNo, checksum, pageBuffer, pageSize)) {
+                  if (fOptions.GetUsePageBufferPool())
+                     RPageAllocatorPool::Instance().Release(pageBuffer, pageSize);
+                  else
+                     delete[] static_cast<unsigned char *>(pageBuffer);
+                  return;
+               }
+
+               auto newPage = fPageAllocator->NewPage(columnId, pageBuffer, element->GetSize(), nElements);
                newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
-               fPagePool->PreloadPage(newPage,
-                  RPageDeleter([](const RPage &page, void * /*userData*/)
-                  {
-                     RPageAllocatorFile::DeletePage(page);
-                  }, nullptr));
+               AddUnzippedPage(newPage, true /* isPreload */);
             };
 
          fTaskScheduler->AddTask(taskFunc);
@@ -553,7 +880,7 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
       } // for all pages in column
    } // for all columns in cluster
 
-   fCounters->fNPagePopulated.Add(cluster->GetNOnDiskPages());
+   fCounters->fNPagePopulated.Add(cluster->GetNOnDiskPages() - nSkipped);
 
    fTaskScheduler->Wait();
 }
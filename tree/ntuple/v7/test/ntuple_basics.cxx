@@ -234,6 +234,80 @@ TEST(RNTuple, ClusterEntries)
    EXPECT_EQ(20, ntuple->GetDescriptor().GetNClusters());
 }
 
+TEST(RNTuple, ClusterSize)
+{
+   FileRaii fileGuard("test_ntuple_cluster_size.root");
+   auto model = RNTupleModel::Create();
+   auto field = model->MakeField<float>("pt", 42.0);
+
+   {
+      RNTupleWriteOptions opt;
+      opt.SetNElementsPerPage(100);
+      // 10 pages of 100 floats
+      opt.SetApproxUnzippedClusterSize(4000);
+      auto ntuple = RNTupleWriter::Recreate(
+         std::move(model), "ntuple", fileGuard.GetPath(), opt
+      );
+      for (int i = 0; i < 10000; i++) {
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   EXPECT_EQ(10U, desc.GetNClusters());
+   for (const auto &clusterDesc : desc.GetClusterIterable()) {
+      if (clusterDesc.GetFirstEntryIndex() + clusterDesc.GetNEntries() == desc.GetNEntries())
+         continue;
+      // The cluster is committed once the tenth page is full, i.e. when the next page is started
+      EXPECT_EQ(1001U, clusterDesc.GetNEntries());
+   }
+}
+
+TEST(RNTuple, LazyEntry)
+{
+   FileRaii fileGuard("test_ntuple_lazy_entry.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrVec = model->MakeField<std::vector<double>>("vec");
+      RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(100);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         *wrVec = std::vector<double>(i % 4, static_cast<double>(i));
+         ntuple->Fill();
+      }
+   }
+
+   auto eager = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   eager->EnableMetrics();
+   for (auto i : eager->GetEntryRange())
+      eager->LoadEntry(i);
+   const auto szEager =
+      eager->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.szReadPayload")->GetValueAsInt();
+
+   RNTupleReadOptions options;
+   options.SetUseLazyEntry(true);
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+   ntuple->EnableMetrics();
+   auto entry = ntuple->GetModel()->GetDefaultEntry();
+   for (auto i : ntuple->GetEntryRange()) {
+      ntuple->LoadEntry(i);
+      EXPECT_FLOAT_EQ(static_cast<float>(i), *entry->Get<float>("pt"));
+      if (i == 502)
+         EXPECT_EQ(std::vector<double>(2, 502.), *entry->Get<std::vector<double>>("vec"));
+   }
+   // The pages of the vector field are only read around the accessed entry
+   EXPECT_LT(ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.szReadPayload")->GetValueAsInt(),
+             szEager);
+
+   std::ostringstream os;
+   ntuple->Show(3, ROOT::Experimental::ENTupleShowFormat::kCurrentModelJSON, os);
+   EXPECT_NE(std::string::npos, os.str().find("\"vec\": [3, 3, 3]"));
+}
+
 TEST(RNTuple, ElementsPerPage)
 {
    FileRaii fileGuard("test_ntuple_elements_per_page.root");
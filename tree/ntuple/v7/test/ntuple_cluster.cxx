@@ -272,6 +272,21 @@ TEST(ClusterPool, GetClusterBasics)
 }
 
 
+TEST(ClusterPool, GetClusterEntryRange)
+{
+   RPageSourceMock p1;
+   p1.SetEntryRange({1, 2});
+   {
+      RClusterPool c1(p1, 4);
+      c1.GetCluster(1, {0});
+   }
+   // Read-ahead stops at the end of the entry range
+   ASSERT_EQ(2U, p1.fReqsClusterIds.size());
+   EXPECT_EQ(1U, p1.fReqsClusterIds[0]);
+   EXPECT_EQ(2U, p1.fReqsClusterIds[1]);
+}
+
+
 TEST(ClusterPool, GetClusterIncrementally)
 {
    RPageSourceMock p1;
@@ -331,3 +346,44 @@ TEST(PageStorageFile, LoadCluster)
    ROnDiskPage::Key key(colId, 0);
    EXPECT_NE(nullptr, cluster->GetOnDiskPage(key));
 }
+
+
+TEST(PageStorageFile, LoadClusterCoalescing)
+{
+   FileRaii fileGuard("test_ntuple_clusters_coalescing.root");
+
+   auto modelWrite = ROOT::Experimental::RNTupleModel::Create();
+   auto wrPt = modelWrite->MakeField<float>("pt", 42.0);
+   auto wrTag = modelWrite->MakeField<int32_t>("tag", 0);
+
+   {
+      ROOT::Experimental::RNTupleWriteOptions options;
+      options.SetNElementsPerPage(10);
+      // The buffered sink writes the pages of a column back-to-back
+      auto ntuple = ROOT::Experimental::RNTupleWriter::Recreate(
+         std::move(modelWrite), "myNTuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 100; ++i) {
+         *wrPt = i;
+         *wrTag = i;
+         ntuple->Fill();
+      }
+   }
+
+   auto fnLoadPt = [&](const ROOT::Experimental::RNTupleReadOptions &options) {
+      ROOT::Experimental::Detail::RPageSourceFile source("myNTuple", fileGuard.GetPath(), options);
+      source.Attach();
+      source.GetMetrics().Enable();
+      auto ptId = source.GetDescriptor().FindFieldId("pt");
+      auto colId = source.GetDescriptor().FindColumnId(ptId, 0);
+      auto cluster = source.LoadCluster(0, {colId});
+      EXPECT_EQ(10U, cluster->GetNOnDiskPages());
+      return source.GetMetrics().GetCounter("RPageSourceFile.nRead")->GetValueAsInt();
+   };
+
+   ROOT::Experimental::RNTupleReadOptions options;
+   EXPECT_EQ(1, fnLoadPt(options));
+   options.SetMaxCoalesceGap(0);
+   EXPECT_EQ(1, fnLoadPt(options));
+   options.SetMaxReadRequestSize(1);
+   EXPECT_EQ(10, fnLoadPt(options));
+}
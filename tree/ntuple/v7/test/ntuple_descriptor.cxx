@@ -417,3 +417,58 @@ TEST(RColumnDescriptorIterable, IterateOverColumns)
    }
    EXPECT_EQ(3, counter);
 }
+
+TEST(RClusterDescriptor, ColumnStatistics)
+{
+   FileRaii fileGuard("test_ntuple_descriptor_statistics.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrNHits = model->MakeField<std::uint32_t>("nHits");
+      auto wrTag = model->MakeField<std::string>("tag");
+      RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(100);
+      options.SetNElementsPerPage(50);
+      options.SetUseColumnStatistics(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 200; ++i) {
+         *wrPt = (i == 10) ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(i);
+         *wrNHits = 4000000000U - i;
+         *wrTag = "abc";
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   const auto ptColumnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+   const auto nHitsColumnId = desc.FindColumnId(desc.FindFieldId("nHits"), 0);
+   const auto tagColumnId = desc.FindColumnId(desc.FindFieldId("tag"), 0);
+
+   const auto &cluster0 = desc.GetClusterDescriptor(desc.FindClusterId(ptColumnId, 0));
+   auto ptStatistics = cluster0.GetColumnRange(ptColumnId).fStatistics;
+   ASSERT_TRUE(ptStatistics);
+   EXPECT_EQ(0., ptStatistics->fMin);
+   EXPECT_EQ(99., ptStatistics->fMax);
+   EXPECT_EQ(1U, ptStatistics->fNNaN);
+   const auto &pageInfos = cluster0.GetPageRange(ptColumnId).fPageInfos;
+   ASSERT_EQ(2U, pageInfos.size());
+   ASSERT_TRUE(pageInfos[1].fStatistics);
+   EXPECT_EQ(50., pageInfos[1].fStatistics->fMin);
+   EXPECT_EQ(0U, pageInfos[1].fStatistics->fNNaN);
+
+   // Unsigned integers are not confused with signed ones of the same column type
+   auto nHitsStatistics = cluster0.GetColumnRange(nHitsColumnId).fStatistics;
+   ASSERT_TRUE(nHitsStatistics);
+   EXPECT_EQ(4000000000. - 99., nHitsStatistics->fMin);
+   EXPECT_EQ(4000000000., nHitsStatistics->fMax);
+
+   // No statistics for the offset and character columns
+   EXPECT_FALSE(cluster0.GetColumnRange(tagColumnId).fStatistics);
+   EXPECT_TRUE(cluster0.MayContainValues(tagColumnId, 1000., 2000.));
+
+   EXPECT_TRUE(cluster0.MayContainValues(ptColumnId, 99., 150.));
+   EXPECT_FALSE(cluster0.MayContainValues(ptColumnId, 99.5, 150.));
+   const auto &cluster1 = desc.GetClusterDescriptor(desc.FindClusterId(ptColumnId, 100));
+   EXPECT_TRUE(cluster1.MayContainValues(ptColumnId, 99.5, 150.));
+}
@@ -80,3 +80,105 @@ TEST(RFieldMerger, Merge)
    auto mergeResult = RFieldMerger::Merge(RFieldDescriptor(), RFieldDescriptor());
    EXPECT_FALSE(mergeResult);
 }
+
+namespace {
+
+void WriteMergeInput(const std::string &path, int first, int n, int compression)
+{
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrTracks = model->MakeField<std::vector<std::string>>("tracks");
+   RNTupleWriteOptions options;
+   options.SetCompression(compression);
+   options.SetNEntriesPerCluster(500);
+   auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", path, options);
+   for (int i = first; i < first + n; ++i) {
+      *wrPt = static_cast<float>(i);
+      *wrTracks = std::vector<std::string>(i % 3, std::to_string(i));
+      ntuple->Fill();
+   }
+}
+
+void CheckMergeOutput(const std::string &path, int n)
+{
+   auto ntuple = RNTupleReader::Open("ntuple", path);
+   ASSERT_EQ(static_cast<NTupleSize_t>(n), ntuple->GetNEntries());
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewTracks = ntuple->GetView<std::vector<std::string>>("tracks");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+      EXPECT_EQ(std::vector<std::string>(i % 3, std::to_string(i)), viewTracks(i));
+   }
+}
+
+} // anonymous namespace
+
+TEST(RNTupleMerger, Merge)
+{
+   FileRaii fileGuard1("test_ntuple_merge_in1.root");
+   FileRaii fileGuard2("test_ntuple_merge_in2.root");
+   FileRaii fileGuardOut("test_ntuple_merge_out.root");
+   WriteMergeInput(fileGuard1.GetPath(), 0, 1200, 505);
+   WriteMergeInput(fileGuard2.GetPath(), 1200, 800, 505);
+
+   RPageSourceFile source1("ntuple", fileGuard1.GetPath(), RNTupleReadOptions());
+   RPageSourceFile source2("ntuple", fileGuard2.GetPath(), RNTupleReadOptions());
+   source1.Attach();
+   source2.Attach();
+   std::vector<RPageSource *> sources{&source1, &source2};
+   {
+      auto options = RNTupleMerger::GetMergeOptions(source1);
+      EXPECT_EQ(505, options->GetCompression());
+      RPageSinkFile destination("ntuple", fileGuardOut.GetPath(), *options);
+      RNTupleMerger merger;
+      merger.Merge(sources, destination);
+   }
+
+   CheckMergeOutput(fileGuardOut.GetPath(), 2000);
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuardOut.GetPath());
+   EXPECT_EQ(source1.GetDescriptor().GetNClusters() + source2.GetDescriptor().GetNClusters(),
+             ntuple->GetDescriptor().GetNClusters());
+}
+
+TEST(RNTupleMerger, CompressionMismatch)
+{
+   FileRaii fileGuard1("test_ntuple_merge_mismatch_in1.root");
+   FileRaii fileGuard2("test_ntuple_merge_mismatch_in2.root");
+   FileRaii fileGuardOut("test_ntuple_merge_mismatch_out.root");
+   WriteMergeInput(fileGuard1.GetPath(), 0, 10, 505);
+   WriteMergeInput(fileGuard2.GetPath(), 10, 10, 0);
+
+   RPageSourceFile source1("ntuple", fileGuard1.GetPath(), RNTupleReadOptions());
+   RPageSourceFile source2("ntuple", fileGuard2.GetPath(), RNTupleReadOptions());
+   source1.Attach();
+   source2.Attach();
+   std::vector<RPageSource *> sources{&source1, &source2};
+   auto options = RNTupleMerger::GetMergeOptions(source1);
+   RPageSinkFile destination("ntuple", fileGuardOut.GetPath(), *options);
+   RNTupleMerger merger;
+   try {
+      merger.Merge(sources, destination);
+      FAIL() << "merging pages with different compression should throw";
+   } catch (const RException &err) {
+      EXPECT_THAT(err.what(), testing::HasSubstr("compression mismatch"));
+   }
+}
+
+TEST(RNTupleMerger, TFileMerger)
+{
+   FileRaii fileGuard1("test_ntuple_hadd_in1.root");
+   FileRaii fileGuard2("test_ntuple_hadd_in2.root");
+   FileRaii fileGuardOut("test_ntuple_hadd_out.root");
+   WriteMergeInput(fileGuard1.GetPath(), 0, 700, 505);
+   WriteMergeInput(fileGuard2.GetPath(), 700, 300, 505);
+
+   {
+      TFileMerger merger(kFALSE, kFALSE);
+      merger.OutputFile(fileGuardOut.GetPath().c_str(), "RECREATE", 505);
+      merger.AddFile(fileGuard1.GetPath().c_str());
+      merger.AddFile(fileGuard2.GetPath().c_str());
+      EXPECT_TRUE(merger.Merge());
+   }
+
+   CheckMergeOutput(fileGuardOut.GetPath(), 1000);
+}
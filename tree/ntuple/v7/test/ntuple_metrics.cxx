@@ -112,3 +112,59 @@ TEST(Metrics, RNTupleWriter)
    // one page for the int field, one for the float field
    EXPECT_EQ(2, page_counter->GetValueAsInt());
 }
+
+TEST(Metrics, JSON)
+{
+   RNTupleMetrics inner("inner");
+   auto ctr = inner.MakeCounter<RNTuplePlainCounter *>("plain", "B", "a \"quoted\" example");
+   RNTupleMetrics outer("outer");
+   outer.MakeCounter<ROOT::Experimental::Detail::RNTupleCalcPerf *>(
+      "ratio", "", "undefined ratio", outer, [](const RNTupleMetrics &) { return std::make_pair(false, 0.0); });
+   outer.ObserveMetrics(inner);
+
+   std::ostringstream osDisabled;
+   outer.PrintJSON(osDisabled);
+   EXPECT_EQ("{}\n", osDisabled.str());
+
+   outer.Enable();
+   ctr->SetValue(42);
+   std::ostringstream os;
+   outer.PrintJSON(os);
+   EXPECT_EQ("{\n"
+             "  \"outer.ratio\": {\"unit\": \"\", \"description\": \"undefined ratio\", \"value\": null},\n"
+             "  \"outer.inner.plain\": {\"unit\": \"B\", \"description\": \"a \\\"quoted\\\" example\", \"value\": 42}\n"
+             "}\n",
+             os.str());
+}
+
+TEST(Metrics, RNTupleReader)
+{
+   std::string rootFileName{"test_ntuple_reader_metrics.root"};
+   FileRaii fileGuard(rootFileName);
+   {
+      auto model = RNTupleModel::Create();
+      auto fieldPt = model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", rootFileName);
+      for (int i = 0; i < 10; ++i) {
+         *fieldPt = i;
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", rootFileName);
+   ntuple->EnableMetrics();
+   auto viewPt = ntuple->GetView<float>("pt");
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_EQ(static_cast<float>(i), viewPt(i));
+
+   auto ctrPayload = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.column0.szReadPayload");
+   ASSERT_NE(nullptr, ctrPayload);
+   EXPECT_GT(ctrPayload->GetValueAsInt(), 0);
+   auto ctrMiss = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.RClusterPool.nReadAheadMiss");
+   ASSERT_NE(nullptr, ctrMiss);
+   EXPECT_GE(ctrMiss->GetValueAsInt(), 1);
+
+   std::ostringstream os;
+   ntuple->PrintInfo(ROOT::Experimental::ENTupleInfo::kMetricsJSON, os);
+   EXPECT_NE(std::string::npos, os.str().find("\"RNTupleReader.RPageSourceFile.column0.szReadPayload\""));
+}
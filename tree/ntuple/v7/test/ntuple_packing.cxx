@@ -32,3 +32,56 @@ TEST(Packing, Bitfield)
       EXPECT_EQ(b9[i], e9[i]);
    }
 }
+
+TEST(Packing, SplitReal32)
+{
+   ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32> element(nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   float f[] = {1.0, 2.0, -3.5, 1e30};
+   unsigned char split[sizeof(f)];
+   element.Pack(split, f, 4);
+   // The first four bytes are the least significant bytes of the four floats
+   for (unsigned i = 0; i < 4; ++i) {
+      EXPECT_EQ(reinterpret_cast<unsigned char *>(f)[i * sizeof(float)], split[i]);
+   }
+   float e[4];
+   element.Unpack(e, split, 4);
+   for (unsigned i = 0; i < 4; ++i) {
+      EXPECT_EQ(f[i], e[i]);
+   }
+}
+
+TEST(Packing, SplitInt64)
+{
+   ROOT::Experimental::Detail::RColumnElement<std::int64_t, ROOT::Experimental::EColumnType::kSplitInt64> element(
+      nullptr);
+   std::int64_t i[] = {0, 1, -1, std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min()};
+   unsigned char split[sizeof(i)];
+   element.Pack(split, i, 5);
+   std::int64_t e[5];
+   element.Unpack(e, split, 5);
+   for (unsigned j = 0; j < 5; ++j) {
+      EXPECT_EQ(i[j], e[j]);
+   }
+}
+
+TEST(Packing, SplitIndex)
+{
+   ROOT::Experimental::Detail::RColumnElement<ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex> element(
+      nullptr);
+   ClusterSize_t idx[] = {ClusterSize_t(5), ClusterSize_t(7), ClusterSize_t(7), ClusterSize_t(300000)};
+   std::uint32_t split[4];
+   element.Pack(split, idx, 4);
+   // The low bytes hold the deltas between consecutive elements
+   auto bytes = reinterpret_cast<unsigned char *>(split);
+   EXPECT_EQ(5, bytes[0]);
+   EXPECT_EQ(2, bytes[1]);
+   EXPECT_EQ(0, bytes[2]);
+   ClusterSize_t e[4];
+   element.Unpack(e, split, 4);
+   for (unsigned i = 0; i < 4; ++i) {
+      EXPECT_EQ(idx[i], e[i]);
+   }
+}
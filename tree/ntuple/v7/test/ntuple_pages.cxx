@@ -55,3 +55,83 @@ TEST(Pages, Pool)
    page = pool.GetPage(1, 55);
    EXPECT_TRUE(page.IsNull());
 }
+
+TEST(Pages, PoolLRU)
+{
+   RPagePool pool;
+   pool.SetMaxUnusedBytes(20);
+   EXPECT_EQ(1U, pool.GetStorageId("a"));
+   EXPECT_EQ(2U, pool.GetStorageId("b"));
+   EXPECT_EQ(1U, pool.GetStorageId("a"));
+
+   unsigned char buffer[30];
+   unsigned int nCallDeleter = 0;
+   RPageDeleter deleter([&nCallDeleter](const RPage & /*page*/, void * /*userData*/) { nCallDeleter++; });
+   std::vector<RPage> pages;
+   for (unsigned int i = 0; i < 3; ++i) {
+      pages.emplace_back(RPage(1, &buffer[10 * i], 10, 1));
+      EXPECT_NE(nullptr, pages.back().TryGrow(10));
+      pages.back().SetWindow(10 * i, RPage::RClusterInfo(0, 0));
+   }
+
+   pool.RegisterPage(pages[0], deleter, 1);
+   pool.PreloadPage(pages[1], deleter, 1);
+   EXPECT_EQ(10U, pool.GetUnusedBytes());
+   // The page belongs to a different storage
+   EXPECT_TRUE(pool.GetPage(1, 15, 2).IsNull());
+   EXPECT_TRUE(pool.ContainsPage(1, ROOT::Experimental::RClusterIndex(0, 15), 1));
+
+   // Unused pages are kept
+   pool.ReturnPage(pages[0]);
+   EXPECT_EQ(20U, pool.GetUnusedBytes());
+   EXPECT_EQ(0U, nCallDeleter);
+
+   // Using page 0 again makes page 1 the least recently used one
+   auto page = pool.GetPage(1, 5, 1);
+   EXPECT_EQ(pages[0], page);
+   EXPECT_EQ(10U, pool.GetUnusedBytes());
+   pool.ReturnPage(page);
+
+   pool.PreloadPage(pages[2], deleter, 1);
+   EXPECT_EQ(1U, nCallDeleter);
+   EXPECT_EQ(2U, pool.GetNPages());
+   EXPECT_TRUE(pool.GetPage(1, 15, 1).IsNull());
+   EXPECT_FALSE(pool.TryReturnPage(pages[1]));
+
+   pool.SetMaxUnusedBytes(10);
+   EXPECT_EQ(2U, nCallDeleter);
+   EXPECT_EQ(1U, pool.GetNPages());
+   page = pool.GetPage(1, 25, 1);
+   EXPECT_EQ(pages[2], page);
+   pool.ReturnPage(page);
+}
+
+TEST(Pages, AllocatorPool)
+{
+   RPageAllocatorPool allocator;
+   allocator.SetMaxCachedBytes(1024);
+
+   auto page = allocator.NewPage(42, 4, 100);
+   EXPECT_FALSE(page.IsNull());
+   EXPECT_EQ(400U, page.GetCapacity());
+   EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(page.GetBuffer()) % RPageAllocatorPool::kAlignment);
+   auto buffer = page.GetBuffer();
+   allocator.DeletePage(page);
+   EXPECT_EQ(512U, allocator.GetCachedBytes());
+
+   // Same size class
+   page = allocator.NewPage(43, 8, 60);
+   EXPECT_EQ(buffer, page.GetBuffer());
+   EXPECT_EQ(1U, allocator.GetNRecycled());
+   EXPECT_EQ(0U, allocator.GetCachedBytes());
+
+   // Larger than the cache limit: freed immediately
+   auto largePage = allocator.NewPage(44, 1, 2000);
+   allocator.DeletePage(largePage);
+   EXPECT_EQ(0U, allocator.GetCachedBytes());
+   EXPECT_EQ(3U, allocator.GetNAllocations());
+
+   allocator.DeletePage(page);
+   allocator.SetMaxCachedBytes(0);
+   EXPECT_EQ(0U, allocator.GetCachedBytes());
+}
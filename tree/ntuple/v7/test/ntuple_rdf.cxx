@@ -35,3 +35,30 @@ TEST(RNTuple, RDF)
    EXPECT_EQ(2U, *rdf.Min("__rdf_sizeof_jets"));
    EXPECT_EQ(3U, *rdf.Min("__rdf_sizeof_klass.v1"));
 }
+
+TEST(RNTuple, RDFRangeFilter)
+{
+   FileRaii fileGuard("test_ntuple_rdf_range_filter.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(100);
+      options.SetUseColumnStatistics(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         ntuple->Fill();
+      }
+   }
+
+   auto ds = std::make_unique<ROOT::Experimental::RNTupleDS>(RPageSource::Create("ntuple", fileGuard.GetPath()));
+   ds->AddRangeFilter("pt", 250., 349.5);
+   EXPECT_THROW(ds->AddRangeFilter("eta", 0., 1.), ROOT::Experimental::RException);
+   ROOT::RDataFrame rdf(std::move(ds));
+   // Only the clusters [200, 300) and [300, 400) are read
+   auto nEntries = rdf.Count();
+   auto nSelected = rdf.Filter([](float pt) { return pt >= 250. && pt <= 349.5; }, {"pt"}).Count();
+   EXPECT_EQ(200U, *nEntries);
+   EXPECT_EQ(100U, *nSelected);
+}
@@ -216,3 +216,250 @@ TEST(RPageSinkBuf, ParallelZip) {
       EXPECT_EQ("hi" + std::to_string(i), viewKlassVec(i).at(0).s);
    }
 }
+
+TEST(RNTupleParallelWriter, Basics)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer.root");
+
+   constexpr int kNThreads = 4;
+   constexpr int kNEntriesPerThread = 10000;
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<int>("thread");
+      model->MakeField<int>("i");
+      model->MakeField<std::vector<float>>("v");
+      RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(1000);
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&writer, t] {
+            auto context = writer->CreateFillContext();
+            auto entry = context->CreateEntry();
+            for (int i = 0; i < kNEntriesPerThread; ++i) {
+               *entry->Get<int>("thread") = t;
+               *entry->Get<int>("i") = i;
+               *entry->Get<std::vector<float>>("v") = std::vector<float>(i % 3, static_cast<float>(i));
+               context->Fill(*entry);
+            }
+         });
+      }
+      for (auto &th : threads)
+         th.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   EXPECT_EQ(kNThreads * kNEntriesPerThread, ntuple->GetNEntries());
+   EXPECT_EQ(static_cast<std::size_t>(kNThreads * kNEntriesPerThread / 1000),
+             ntuple->GetDescriptor().GetNClusters());
+
+   auto viewThread = ntuple->GetView<int>("thread");
+   auto viewI = ntuple->GetView<int>("i");
+   auto viewV = ntuple->GetView<std::vector<float>>("v");
+   std::vector<int> nextI(kNThreads, 0);
+   for (auto i : ntuple->GetEntryRange()) {
+      auto t = viewThread(i);
+      ASSERT_GE(t, 0);
+      ASSERT_LT(t, kNThreads);
+      // Entries of a single thread keep their order
+      EXPECT_EQ(nextI[t], viewI(i));
+      EXPECT_EQ(std::vector<float>(nextI[t] % 3, static_cast<float>(nextI[t])), viewV(i));
+      nextI[t]++;
+   }
+   for (auto n : nextI)
+      EXPECT_EQ(kNEntriesPerThread, n);
+}
+
+TEST(RPageSourceFile, Mmap)
+{
+   FileRaii fileGuard("test_ntuple_page_source_mmap.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrVec = model->MakeField<std::vector<double>>("vec");
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      options.SetNEntriesPerCluster(100);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         *wrVec = std::vector<double>(i % 4, static_cast<double>(i));
+         ntuple->Fill();
+      }
+   }
+
+   for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOn, RNTupleReadOptions::EClusterCache::kOff}) {
+      RNTupleReadOptions options;
+      options.SetUseMmap(true);
+      options.SetClusterCache(clusterCache);
+      auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+      ntuple->EnableMetrics();
+      EXPECT_EQ(1000U, ntuple->GetNEntries());
+
+      auto viewPt = ntuple->GetView<float>("pt");
+      auto viewVec = ntuple->GetView<std::vector<double>>("vec");
+      for (auto i : ntuple->GetEntryRange()) {
+         EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+         EXPECT_EQ(std::vector<double>(i % 4, static_cast<double>(i)), viewVec(i));
+      }
+
+      // No read requests are issued for the pages
+      EXPECT_EQ(0, ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nRead")->GetValueAsInt());
+   }
+}
+
+TEST(RPageSourceFile, SharedPageCache)
+{
+   FileRaii fileGuard("test_ntuple_page_source_shared_cache.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(100);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         ntuple->Fill();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetSharedPageCacheSize(64 * 1024 * 1024);
+   for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOff, RNTupleReadOptions::EClusterCache::kOn}) {
+      options.SetClusterCache(clusterCache);
+      auto first = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+      auto second = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+      second->EnableMetrics();
+
+      auto viewFirst = first->GetView<float>("pt");
+      for (auto i : first->GetEntryRange())
+         EXPECT_FLOAT_EQ(static_cast<float>(i), viewFirst(i));
+
+      auto viewSecond = second->GetView<float>("pt");
+      for (auto i : second->GetEntryRange())
+         EXPECT_FLOAT_EQ(static_cast<float>(i), viewSecond(i));
+      // All the pages have been unzipped by the first reader
+      EXPECT_EQ(0, second->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.szUnzip")->GetValueAsInt());
+   }
+   RPagePool::GetSharedPool()->SetMaxUnusedBytes(0);
+}
+
+TEST(RPageStorageFile, PageBufferPool)
+{
+   FileRaii fileGuard("test_ntuple_page_buffer_pool.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrVec = model->MakeField<std::vector<double>>("vec");
+      RNTupleWriteOptions options;
+      options.SetNEntriesPerCluster(100);
+      options.SetUsePageBufferPool(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 1000; ++i) {
+         *wrPt = static_cast<float>(i);
+         *wrVec = std::vector<double>(i % 4, static_cast<double>(i));
+         ntuple->Fill();
+      }
+   }
+
+   const auto nRecycled = RPageAllocatorPool::Instance().GetNRecycled();
+   RNTupleReadOptions options;
+   options.SetUsePageBufferPool(true);
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewVec = ntuple->GetView<std::vector<double>>("vec");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+      EXPECT_EQ(std::vector<double>(i % 4, static_cast<double>(i)), viewVec(i));
+   }
+   // Pages of subsequent clusters reuse the buffers of the previous clusters
+   EXPECT_GT(RPageAllocatorPool::Instance().GetNRecycled(), nRecycled);
+}
+
+TEST(RPageSinkFile, AsyncWrite)
+{
+   for (auto containerFormat : {ENTupleContainerFormat::kTFile, ENTupleContainerFormat::kBare}) {
+      FileRaii fileGuard("test_ntuple_page_sink_async.root");
+      {
+         auto model = RNTupleModel::Create();
+         auto wrPt = model->MakeField<float>("pt");
+         auto wrVec = model->MakeField<std::vector<double>>("vec");
+         RNTupleWriteOptions options;
+         options.SetContainerFormat(containerFormat);
+         options.SetNEntriesPerCluster(100);
+         options.SetUseAsyncWrite(true);
+         options.SetAsyncWriteQueueSize(1);
+         auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+         for (int i = 0; i < 1000; ++i) {
+            *wrPt = static_cast<float>(i);
+            *wrVec = std::vector<double>(i % 4, static_cast<double>(i));
+            ntuple->Fill();
+         }
+      }
+
+      auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+      EXPECT_EQ(1000U, ntuple->GetNEntries());
+      EXPECT_EQ(10U, ntuple->GetDescriptor().GetNClusters());
+      auto viewPt = ntuple->GetView<float>("pt");
+      auto viewVec = ntuple->GetView<std::vector<double>>("vec");
+      for (auto i : ntuple->GetEntryRange()) {
+         EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+         EXPECT_EQ(std::vector<double>(i % 4, static_cast<double>(i)), viewVec(i));
+      }
+   }
+}
+
+TEST(RPageStorageFile, PageChecksums)
+{
+   FileRaii fileGuard("test_ntuple_page_checksums.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      RNTupleWriteOptions options;
+      // Uncompressed, so that a flipped byte on disk does not make decompression fail
+      options.SetCompression(0);
+      options.SetUsePageChecksums(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 100; ++i) {
+         *wrPt = static_cast<float>(i);
+         ntuple->Fill();
+      }
+   }
+
+   std::uint64_t pagePosition;
+   {
+      auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+      const auto &desc = ntuple->GetDescriptor();
+      const auto columnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+      const auto &pageInfo = desc.GetClusterDescriptor(0).GetPageRange(columnId).fPageInfos.at(0);
+      ASSERT_TRUE(pageInfo.fChecksum.has_value());
+      pagePosition = pageInfo.fLocator.fPosition;
+
+      auto viewPt = ntuple->GetView<float>("pt");
+      for (auto i : ntuple->GetEntryRange())
+         EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+   }
+
+   {
+      auto file = fopen(fileGuard.GetPath().c_str(), "r+b");
+      ASSERT_TRUE(file != nullptr);
+      fseek(file, pagePosition, SEEK_SET);
+      unsigned char byte = fgetc(file);
+      fseek(file, pagePosition, SEEK_SET);
+      fputc(byte ^ 0xff, file);
+      fclose(file);
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   ntuple->EnableMetrics();
+   auto viewPt = ntuple->GetView<float>("pt");
+   EXPECT_THROW(viewPt(0), RException);
+   EXPECT_EQ(1, ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPageCorrupt")->GetValueAsInt());
+
+   RNTupleReadOptions options;
+   options.SetVerifyPageChecksums(false);
+   auto ntupleUnverified = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+   auto viewPtUnverified = ntupleUnverified->GetView<float>("pt");
+   EXPECT_FLOAT_EQ(1.0, viewPtUnverified(1));
+}
@@ -106,3 +106,63 @@ TEST(RNTuple, Casting)
    reader->LoadEntry(0);
    EXPECT_EQ(42, *fieldCast);
 }
+
+TEST(RNTuple, SplitEncoding)
+{
+   FileRaii fileGuard("test_ntuple_split_encoding.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldFloat = model->MakeField<float>("float");
+      auto fldDouble = model->MakeField<double>("double");
+      auto fldInt32 = model->MakeField<std::int32_t>("int32");
+      auto fldUInt16 = model->MakeField<std::uint16_t>("uint16");
+      auto fldInt64 = model->MakeField<std::int64_t>("int64");
+      auto fldVec = model->MakeField<std::vector<float>>("vec");
+      auto fldStr = model->MakeField<std::string>("str");
+      RNTupleWriteOptions options;
+      options.SetUseSplitEncoding(true);
+      options.SetNElementsPerPage(7);
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 100; ++i) {
+         *fldFloat = i * 0.5;
+         *fldDouble = -i * 0.25;
+         *fldInt32 = -i;
+         *fldUInt16 = i;
+         *fldInt64 = std::int64_t(i) << 40;
+         *fldVec = std::vector<float>(i % 5, i);
+         *fldStr = std::string(i % 3, 'x');
+         writer->Fill();
+      }
+   }
+
+   auto reader = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   const auto &desc = reader->GetDescriptor();
+   auto columnType = [&](const std::string &fieldName) {
+      auto fieldId = desc.FindFieldId(fieldName);
+      return desc.GetColumnDescriptor(desc.FindColumnId(fieldId, 0)).GetModel().GetType();
+   };
+   EXPECT_EQ(EColumnType::kSplitReal32, columnType("float"));
+   EXPECT_EQ(EColumnType::kSplitReal64, columnType("double"));
+   EXPECT_EQ(EColumnType::kSplitInt32, columnType("int32"));
+   EXPECT_EQ(EColumnType::kSplitInt16, columnType("uint16"));
+   EXPECT_EQ(EColumnType::kSplitInt64, columnType("int64"));
+   EXPECT_EQ(EColumnType::kSplitIndex, columnType("vec"));
+   EXPECT_EQ(EColumnType::kSplitIndex, columnType("str"));
+
+   auto viewFloat = reader->GetView<float>("float");
+   auto viewDouble = reader->GetView<double>("double");
+   auto viewInt32 = reader->GetView<std::int32_t>("int32");
+   auto viewUInt16 = reader->GetView<std::uint16_t>("uint16");
+   auto viewInt64 = reader->GetView<std::int64_t>("int64");
+   auto viewVec = reader->GetView<std::vector<float>>("vec");
+   auto viewStr = reader->GetView<std::string>("str");
+   for (auto i : reader->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(i * 0.5, viewFloat(i));
+      EXPECT_DOUBLE_EQ(-(i * 0.25), viewDouble(i));
+      EXPECT_EQ(-static_cast<std::int32_t>(i), viewInt32(i));
+      EXPECT_EQ(i, viewUInt16(i));
+      EXPECT_EQ(std::int64_t(i) << 40, viewInt64(i));
+      EXPECT_EQ(std::vector<float>(i % 5, i), viewVec(i));
+      EXPECT_EQ(std::string(i % 3, 'x'), viewStr(i));
+   }
+}
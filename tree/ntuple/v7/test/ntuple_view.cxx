@@ -93,6 +93,47 @@ TEST(RNTuple, BulkView)
    }
 }
 
+TEST(RNTuple, BulkViewSpan)
+{
+   FileRaii fileGuard("test_ntuple_bulk_view_span.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto eltsPerPage = 100;
+   {
+      RNTupleWriteOptions opt;
+      opt.SetNElementsPerPage(eltsPerPage);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), opt);
+      for (int i = 0; i < 1000; i++) {
+         *fieldPt = i;
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   auto viewPt = ntuple->GetView<float>("pt");
+
+   auto fullPage = viewPt.MapSpan(0);
+   EXPECT_EQ(static_cast<std::size_t>(eltsPerPage), fullPage.size());
+   auto capped = viewPt.MapSpan(eltsPerPage - 2, 1);
+   ASSERT_EQ(1U, capped.size());
+   EXPECT_EQ(eltsPerPage - 2, capped[0]);
+
+   // Iterate over a range that crosses page boundaries
+   NTupleSize_t first = 150;
+   NTupleSize_t last = 520;
+   NTupleSize_t nCalls = 0;
+   for (auto i = first; i < last; ++nCalls) {
+      auto values = viewPt.MapSpan(i, last - i);
+      ASSERT_FALSE(values.empty());
+      for (std::size_t j = 0; j < values.size(); ++j) {
+         EXPECT_EQ(static_cast<float>(i + j), values[j]);
+      }
+      i += values.size();
+   }
+   EXPECT_EQ(5U, nCalls);
+}
+
 TEST(RNTuple, BulkViewCollection)
 {
    FileRaii fileGuard("test_ntuple_bulk_view_collection.root");
@@ -131,6 +131,47 @@ TEST(RNTuple, RVec)
    EXPECT_EQ(1.0, (*rdJetsAsStdVector)[0]);
 }
 
+TEST(RNTuple, VectorMultiPage)
+{
+   FileRaii fileGuard("test_ntuple_vector_multipage.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrJets = modelWrite->MakeField<std::vector<float>>("jets");
+   auto wrTracks = modelWrite->MakeField<ROOT::VecOps::RVec<std::int32_t>>("tracks");
+
+   {
+      RNTupleWriteOptions options;
+      // Collections span several pages, which are read in one go by the item fields
+      options.SetNElementsPerPage(7);
+      RNTupleWriter ntuple(std::move(modelWrite),
+         std::make_unique<RPageSinkFile>("myNTuple", fileGuard.GetPath(), options));
+      for (int i = 0; i < 20; ++i) {
+         wrJets->clear();
+         wrTracks->clear();
+         for (int j = 0; j < i; ++j) {
+            wrJets->push_back(i + j / 100.);
+            wrTracks->push_back(i * j);
+         }
+         ntuple.Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   ASSERT_EQ(20U, ntuple->GetNEntries());
+   auto viewJets = ntuple->GetView<std::vector<float>>("jets");
+   auto viewTracks = ntuple->GetView<ROOT::VecOps::RVec<std::int32_t>>("tracks");
+   for (auto i : ntuple->GetEntryRange()) {
+      const auto &jets = viewJets(i);
+      const auto &tracks = viewTracks(i);
+      ASSERT_EQ(i, jets.size());
+      ASSERT_EQ(i, tracks.size());
+      for (unsigned j = 0; j < i; ++j) {
+         EXPECT_FLOAT_EQ(i + j / 100., jets[j]);
+         EXPECT_EQ(int(i * j), tracks[j]);
+      }
+   }
+}
+
 TEST(RNTuple, BoolVector)
 {
    FileRaii fileGuard("test_ntuple_boolvec.root");
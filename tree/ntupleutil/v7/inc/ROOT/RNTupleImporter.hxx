@@ -0,0 +1,140 @@
+/// \file ROOT/RNTupleImporter.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2021-07-02
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RNTupleImporter
+#define ROOT7_RNTupleImporter
+
+#include <ROOT/RNTupleMetrics.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+#include <ROOT/RStringView.hxx>
+
+#include <Rtypes.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TLeaf;
+class TTree;
+
+namespace ROOT {
+namespace Experimental {
+
+class RNTupleFillContext;
+class RNTupleModel;
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleImporter
+\ingroup NTuple
+\brief Converts a TTree into an RNTuple with the same schema
+
+On creation, the importer maps the top-level branches of the TTree to RNTuple fields:
+  - Branches with a single leaf of fundamental type become fields of the corresponding type
+  - Fixed-size leaf arrays become std::array fields, variable-size arrays (leaf count) become std::vector fields;
+    the leaf count branch itself is imported as a separate field
+  - Character string leaves (type /C) become std::string fields
+  - Branches of a class type (TBranchElement) become fields of that class type, which requires a dictionary
+Other branches, e.g. branches with several leaves, are rejected with an exception. Dots in branch names are replaced
+by underscores.
+
+Flat leaves are read by TBranch::GetEntry() directly into the memory of the RNTuple entry; no TTreeReader is involved.
+Leaf arrays are read into an intermediate buffer and copied into the field's collection.
+
+The conversion is split along the TTree clusters.  If implicit multi-threading is enabled, each TTree cluster is
+converted by a separate task with its own TTree instance and its own RNTupleFillContext.  In this case, the order of
+the clusters in the RNTuple is the order in which the tasks finish; the order of the entries within a cluster is kept.
+Without implicit multi-threading, the entry order of the TTree is preserved.
+*/
+// clang-format on
+class RNTupleImporter {
+public:
+   /// Copies the content of an intermediate leaf buffer into the memory of the field value
+   using Transform_t = void (*)(const TLeaf &leaf, const unsigned char *buffer, void *to);
+
+private:
+   /// Mapping of a top-level branch to a field of the RNTuple model
+   struct RImportBranch {
+      std::string fBranchName;
+      std::string fFieldName;
+      std::string fFieldType;
+      /// Size of the intermediate buffer that the leaf is read into.  Zero if the branch reads directly into the
+      /// field's memory.
+      std::size_t fBufferSize = 0;
+      /// Moves the data from the intermediate buffer into the field value; only set if fBufferSize > 0
+      Transform_t fTransform = nullptr;
+      /// For class branches, the branch address is the address of a pointer to the object
+      bool fIsObject = false;
+   };
+
+   /// Throughput statistics of the import, registered in fMetrics
+   struct RCounters {
+      Detail::RNTupleAtomicCounter &fNEntries;
+      Detail::RNTupleAtomicCounter &fNClusters;
+      Detail::RNTupleAtomicCounter &fSzRead;
+      Detail::RNTupleAtomicCounter &fSzReadUnzip;
+      Detail::RNTupleAtomicCounter &fTimeWallRead;
+      Detail::RNTupleTickCounter<Detail::RNTupleAtomicCounter> &fTimeCpuRead;
+      Detail::RNTupleAtomicCounter &fTimeWallWrite;
+      Detail::RNTupleTickCounter<Detail::RNTupleAtomicCounter> &fTimeCpuWrite;
+      Detail::RNTupleAtomicCounter &fTimeWallImport;
+      Detail::RNTupleTickCounter<Detail::RNTupleAtomicCounter> &fTimeCpuImport;
+      Detail::RNTupleCalcPerf &fBandwidthImport;
+      Detail::RNTupleCalcPerf &fEntryRate;
+   };
+
+   std::string fSourceFileName;
+   std::string fTreeName;
+   std::string fDestFileName;
+   std::string fNTupleName;
+   RNTupleWriteOptions fWriteOptions;
+   std::vector<RImportBranch> fImportBranches;
+   Detail::RNTupleMetrics fMetrics;
+   std::unique_ptr<RCounters> fCounters;
+
+   RNTupleImporter(std::string_view sourceFileName, std::string_view treeName, std::string_view destFileName);
+   /// Fills fImportBranches from the branches of the tree; throws on unsupported branches
+   void PrepareSchema(TTree &tree);
+   std::unique_ptr<RNTupleModel> CreateModel() const;
+   /// Converts the given TTree clusters, given as [first entry, end entry) pairs, using the fill context.  The tree
+   /// must not be shared with another thread.
+   void ImportClusters(TTree &tree, const std::vector<std::pair<Long64_t, Long64_t>> &clusters,
+                       RNTupleFillContext &fillContext);
+
+public:
+   /// Opens the source tree in order to prepare the schema.  Throws an RException if the tree cannot be opened or if
+   /// it has branches that cannot be converted.  The RNTuple has the name of the tree unless set otherwise.
+   static std::unique_ptr<RNTupleImporter>
+   Create(std::string_view sourceFileName, std::string_view treeName, std::string_view destFileName);
+   RNTupleImporter(const RNTupleImporter &other) = delete;
+   RNTupleImporter &operator=(const RNTupleImporter &other) = delete;
+   ~RNTupleImporter();
+
+   void SetNTupleName(std::string_view name) { fNTupleName = std::string(name); }
+   void SetWriteOptions(const RNTupleWriteOptions &options) { fWriteOptions = options; }
+   const RNTupleWriteOptions &GetWriteOptions() const { return fWriteOptions; }
+
+   /// Writes the converted RNTuple to the destination file; an existing file is overwritten.
+   void Import();
+
+   void EnableMetrics() { fMetrics.Enable(); }
+   const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,342 @@
+/// \file RNTupleImporter.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2021-07-02
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RError.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleImporter.hxx>
+#include <ROOT/RNTupleModel.hxx>
+
+#include <TBranch.h>
+#include <TBranchElement.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TLeafC.h>
+#include <TObjArray.h>
+#include <TROOT.h> // IsImplicitMTEnabled
+#include <TTree.h>
+
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+/// Assigns the values of a leaf array, read into the intermediate buffer, to a std::vector field value
+template <typename T>
+void CopyToVector(const TLeaf &leaf, const unsigned char *buffer, void *to)
+{
+   auto values = reinterpret_cast<const T *>(buffer);
+   static_cast<std::vector<T> *>(to)->assign(values, values + leaf.GetLen());
+}
+
+/// Assigns the null-terminated content of a /C leaf to a std::string field value
+void CopyToString(const TLeaf & /*leaf*/, const unsigned char *buffer, void *to)
+{
+   *static_cast<std::string *>(to) = reinterpret_cast<const char *>(buffer);
+}
+
+struct RLeafType {
+   const char *fLeafTypeName;
+   const char *fFieldTypeName;
+   ROOT::Experimental::RNTupleImporter::Transform_t fToVector;
+};
+
+/// The leaf types that are read as is into the memory of the corresponding RNTuple field
+const RLeafType kLeafTypes[] = {
+   {"Bool_t", "bool", CopyToVector<bool>},
+   {"Char_t", "char", CopyToVector<char>},
+   {"UChar_t", "std::uint8_t", CopyToVector<std::uint8_t>},
+   {"Short_t", "std::int16_t", CopyToVector<std::int16_t>},
+   {"UShort_t", "std::uint16_t", CopyToVector<std::uint16_t>},
+   {"Int_t", "std::int32_t", CopyToVector<std::int32_t>},
+   {"UInt_t", "std::uint32_t", CopyToVector<std::uint32_t>},
+   {"Long64_t", "std::int64_t", CopyToVector<std::int64_t>},
+   {"ULong64_t", "std::uint64_t", CopyToVector<std::uint64_t>},
+   {"Float_t", "float", CopyToVector<float>},
+   {"Float16_t", "float", CopyToVector<float>},
+   {"Double_t", "double", CopyToVector<double>},
+   {"Double32_t", "double", CopyToVector<double>},
+};
+
+const RLeafType *FindLeafType(const std::string &leafTypeName)
+{
+   for (const auto &t : kLeafTypes) {
+      if (leafTypeName == t.fLeafTypeName)
+         return &t;
+   }
+   return nullptr;
+}
+
+/// Resets the branch addresses of the tree before the memory of the imported entry is released
+class RBranchAddressGuard {
+private:
+   TTree &fTree;
+
+public:
+   explicit RBranchAddressGuard(TTree &tree) : fTree(tree) {}
+   RBranchAddressGuard(const RBranchAddressGuard &other) = delete;
+   RBranchAddressGuard &operator=(const RBranchAddressGuard &other) = delete;
+   ~RBranchAddressGuard() { fTree.ResetBranchAddresses(); }
+};
+
+std::unique_ptr<TFile> OpenSourceFile(const std::string &fileName)
+{
+   std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+   if (!file || file->IsZombie())
+      throw ROOT::Experimental::RException(R__FAIL("cannot open source file " + fileName));
+   return file;
+}
+
+TTree *GetSourceTree(TFile &file, const std::string &treeName)
+{
+   auto tree = file.Get<TTree>(treeName.c_str());
+   if (!tree)
+      throw ROOT::Experimental::RException(R__FAIL("cannot find tree " + treeName + " in " + file.GetName()));
+   return tree;
+}
+
+} // anonymous namespace
+
+ROOT::Experimental::RNTupleImporter::RNTupleImporter(std::string_view sourceFileName, std::string_view treeName,
+                                                     std::string_view destFileName)
+   : fSourceFileName(sourceFileName), fTreeName(treeName), fDestFileName(destFileName), fNTupleName(treeName),
+     fMetrics("RNTupleImporter")
+{
+   using Detail::RNTupleAtomicCounter;
+   using Detail::RNTupleCalcPerf;
+   using Detail::RNTupleMetrics;
+   using Detail::RNTupleTickCounter;
+
+   fCounters = std::unique_ptr<RCounters>(new RCounters{
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("nEntries", "", "number of imported entries"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("nClusters", "", "number of imported TTree clusters"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("szRead", "B", "volume read from the source file"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("szReadUnzip", "B", "volume of the unzipped TTree entries"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("timeWallRead", "ns", "wall clock time spent reading the TTree"),
+      *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter> *>("timeCpuRead", "ns",
+                                                                        "CPU time spent reading the TTree"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("timeWallWrite", "ns", "wall clock time spent filling the RNTuple"),
+      *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter> *>("timeCpuWrite", "ns",
+                                                                        "CPU time spent filling the RNTuple"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter *>("timeWallImport", "ns", "wall clock time of the import"),
+      *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter> *>("timeCpuImport", "ns",
+                                                                        "CPU time of the import"),
+      *fMetrics.MakeCounter<RNTupleCalcPerf *>("bwImport", "MB/s", "bandwidth of source bytes imported per second",
+         fMetrics, [](const RNTupleMetrics &metrics) -> std::pair<bool, double> {
+            if (const auto szRead = metrics.GetLocalCounter("szRead")) {
+               if (const auto timeWallImport = metrics.GetLocalCounter("timeWallImport")) {
+                  if (auto walltime = timeWallImport->GetValueAsInt()) {
+                     // unit: bytes / nanosecond = GB/s
+                     return {true, (1000. * szRead->GetValueAsInt()) / walltime};
+                  }
+               }
+            }
+            return {false, -1.};
+         }
+      ),
+      *fMetrics.MakeCounter<RNTupleCalcPerf *>("rtEntries", "1/s", "number of entries imported per second",
+         fMetrics, [](const RNTupleMetrics &metrics) -> std::pair<bool, double> {
+            if (const auto nEntries = metrics.GetLocalCounter("nEntries")) {
+               if (const auto timeWallImport = metrics.GetLocalCounter("timeWallImport")) {
+                  if (auto walltime = timeWallImport->GetValueAsInt()) {
+                     return {true, (1000. * 1000. * 1000. * nEntries->GetValueAsInt()) / walltime};
+                  }
+               }
+            }
+            return {false, -1.};
+         }
+      )
+   });
+}
+
+ROOT::Experimental::RNTupleImporter::~RNTupleImporter() = default;
+
+std::unique_ptr<ROOT::Experimental::RNTupleImporter>
+ROOT::Experimental::RNTupleImporter::Create(std::string_view sourceFileName, std::string_view treeName,
+                                            std::string_view destFileName)
+{
+   auto importer =
+      std::unique_ptr<RNTupleImporter>(new RNTupleImporter(sourceFileName, treeName, destFileName));
+   auto file = OpenSourceFile(importer->fSourceFileName);
+   importer->PrepareSchema(*GetSourceTree(*file, importer->fTreeName));
+   // Fail early if one of the field types cannot be constructed, e.g. due to a missing dictionary
+   importer->CreateModel();
+   return importer;
+}
+
+void ROOT::Experimental::RNTupleImporter::PrepareSchema(TTree &tree)
+{
+   fImportBranches.clear();
+   for (auto obj : *tree.GetListOfBranches()) {
+      auto branch = static_cast<TBranch *>(obj);
+      RImportBranch importBranch;
+      importBranch.fBranchName = branch->GetName();
+      importBranch.fFieldName = importBranch.fBranchName;
+      // Top-level object branches conventionally end with a dot
+      if (!importBranch.fFieldName.empty() && importBranch.fFieldName.back() == '.')
+         importBranch.fFieldName.pop_back();
+      std::replace(importBranch.fFieldName.begin(), importBranch.fFieldName.end(), '.', '_');
+
+      if (auto branchElement = dynamic_cast<TBranchElement *>(branch)) {
+         importBranch.fFieldType = branchElement->GetClassName();
+         if (importBranch.fFieldType.empty()) {
+            throw RException(R__FAIL("unsupported branch " + importBranch.fBranchName + ": no class name"));
+         }
+         importBranch.fIsObject = true;
+         fImportBranches.emplace_back(std::move(importBranch));
+         continue;
+      }
+
+      if (branch->IsA() != TBranch::Class() || branch->GetListOfLeaves()->GetEntries() != 1) {
+         throw RException(R__FAIL("unsupported branch " + importBranch.fBranchName +
+                                  ": only branches with a single leaf are supported"));
+      }
+      auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->First());
+
+      if (dynamic_cast<TLeafC *>(leaf)) {
+         importBranch.fFieldType = "std::string";
+         importBranch.fBufferSize = std::max(leaf->GetMaximum(), leaf->GetLenStatic()) + 1;
+         importBranch.fTransform = CopyToString;
+         fImportBranches.emplace_back(std::move(importBranch));
+         continue;
+      }
+
+      auto leafType = FindLeafType(leaf->GetTypeName());
+      if (!leafType) {
+         throw RException(R__FAIL("unsupported branch " + importBranch.fBranchName + ": leaf type " +
+                                  leaf->GetTypeName()));
+      }
+      if (auto leafCount = leaf->GetLeafCount()) {
+         importBranch.fFieldType = std::string("std::vector<") + leafType->fFieldTypeName + ">";
+         importBranch.fBufferSize =
+            std::max(1, leafCount->GetMaximum()) * std::max(1, leaf->GetLenStatic()) * leaf->GetLenType();
+         importBranch.fTransform = leafType->fToVector;
+      } else if (leaf->GetLenStatic() > 1) {
+         importBranch.fFieldType = std::string("std::array<") + leafType->fFieldTypeName + "," +
+                                   std::to_string(leaf->GetLenStatic()) + ">";
+      } else {
+         importBranch.fFieldType = leafType->fFieldTypeName;
+      }
+      fImportBranches.emplace_back(std::move(importBranch));
+   }
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleModel> ROOT::Experimental::RNTupleImporter::CreateModel() const
+{
+   auto model = RNTupleModel::Create();
+   for (const auto &importBranch : fImportBranches) {
+      model->AddField(Detail::RFieldBase::Create(importBranch.fFieldName, importBranch.fFieldType).Unwrap());
+   }
+   return model;
+}
+
+void ROOT::Experimental::RNTupleImporter::ImportClusters(TTree &tree,
+                                                         const std::vector<std::pair<Long64_t, Long64_t>> &clusters,
+                                                         RNTupleFillContext &fillContext)
+{
+   auto entry = fillContext.CreateEntry();
+   std::unordered_map<std::string, void *> valuePtrs;
+   for (auto &value : *entry) {
+      valuePtrs[value.GetField()->GetName()] = value.GetRawPtr();
+   }
+
+   const auto nBranches = fImportBranches.size();
+   std::vector<void *> fieldPtrs(nBranches);
+   // Class branches take the address of a pointer to the object; the pointers must not move
+   std::vector<void *> objectPtrs(nBranches);
+   std::vector<std::unique_ptr<unsigned char[]>> buffers(nBranches);
+   std::vector<TLeaf *> leaves(nBranches);
+   RBranchAddressGuard addressGuard(tree);
+   for (std::size_t i = 0; i < nBranches; ++i) {
+      const auto &importBranch = fImportBranches[i];
+      auto branch = tree.GetBranch(importBranch.fBranchName.c_str());
+      if (!branch)
+         throw RException(R__FAIL("cannot find branch " + importBranch.fBranchName));
+      fieldPtrs[i] = valuePtrs.at(importBranch.fFieldName);
+      if (importBranch.fIsObject) {
+         objectPtrs[i] = fieldPtrs[i];
+         branch->SetAddress(&objectPtrs[i]);
+      } else if (importBranch.fBufferSize > 0) {
+         buffers[i] = std::make_unique<unsigned char[]>(importBranch.fBufferSize);
+         leaves[i] = static_cast<TLeaf *>(branch->GetListOfLeaves()->First());
+         branch->SetAddress(buffers[i].get());
+      } else {
+         branch->SetAddress(fieldPtrs[i]);
+      }
+   }
+
+   for (const auto &cluster : clusters) {
+      for (auto entryNumber = cluster.first; entryNumber < cluster.second; ++entryNumber) {
+         Int_t nBytes;
+         {
+            Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
+            nBytes = tree.GetEntry(entryNumber);
+            for (std::size_t i = 0; i < nBranches; ++i) {
+               if (buffers[i])
+                  fImportBranches[i].fTransform(*leaves[i], buffers[i].get(), fieldPtrs[i]);
+            }
+         }
+         if (nBytes < 0)
+            throw RException(R__FAIL("cannot read entry " + std::to_string(entryNumber) + " of " + fTreeName));
+         fCounters->fSzReadUnzip.Add(nBytes);
+
+         Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
+         fillContext.Fill(*entry);
+      }
+      fCounters->fNEntries.Add(cluster.second - cluster.first);
+      fCounters->fNClusters.Inc();
+   }
+}
+
+void ROOT::Experimental::RNTupleImporter::Import()
+{
+   Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallImport, fCounters->fTimeCpuImport);
+
+   auto file = OpenSourceFile(fSourceFileName);
+   auto tree = GetSourceTree(*file, fTreeName);
+   std::vector<std::pair<Long64_t, Long64_t>> clusters;
+   const auto nEntries = tree->GetEntries();
+   auto clusterIter = tree->GetClusterIterator(0);
+   Long64_t start;
+   while ((start = clusterIter()) < nEntries) {
+      clusters.emplace_back(start, std::min(clusterIter.GetNextEntry(), nEntries));
+   }
+
+   auto writer = RNTupleParallelWriter::Recreate(CreateModel(), fNTupleName, fDestFileName, fWriteOptions);
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && clusters.size() > 1) {
+      // Every task needs its own TTree instance
+      auto fnImportCluster = [this, &writer](const std::pair<Long64_t, Long64_t> &cluster) {
+         auto taskFile = OpenSourceFile(fSourceFileName);
+         auto fillContext = writer->CreateFillContext();
+         ImportClusters(*GetSourceTree(*taskFile, fTreeName), {cluster}, *fillContext);
+         fCounters->fSzRead.Add(taskFile->GetBytesRead());
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(fnImportCluster, clusters);
+      return;
+   }
+#endif
+
+   auto fillContext = writer->CreateFillContext();
+   ImportClusters(*tree, clusters, *fillContext);
+   fCounters->fSzRead.Add(file->GetBytesRead());
+}
@@ -0,0 +1,152 @@
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleImporter.hxx>
+#include <ROOT/RNTupleModel.hxx>
+
+#include <TFile.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using RException = ROOT::Experimental::RException;
+using RNTupleImporter = ROOT::Experimental::RNTupleImporter;
+using RNTupleReader = ROOT::Experimental::RNTupleReader;
+
+namespace {
+
+/**
+ * An RAII wrapper around an open temporary file on disk. It cleans up the guarded file when the wrapper object
+ * goes out of scope.
+ */
+class FileRaii {
+private:
+   std::string fPath;
+public:
+   explicit FileRaii(const std::string &path) : fPath(path) { }
+   FileRaii(const FileRaii&) = delete;
+   FileRaii& operator=(const FileRaii&) = delete;
+   ~FileRaii() { std::remove(fPath.c_str()); }
+   std::string GetPath() const { return fPath; }
+};
+
+/// Writes a tree with nEntries entries and a cluster every clusterSize entries
+void CreateTree(const std::string &path, int nEntries, int clusterSize)
+{
+   auto file = std::unique_ptr<TFile>(TFile::Open(path.c_str(), "RECREATE"));
+   auto tree = new TTree("tree", "");
+   tree->SetAutoFlush(clusterSize);
+   Int_t n = 0;
+   Float_t pt[8];
+   Double_t pos[3];
+   Bool_t flag = false;
+   char label[16];
+   std::vector<float> energies;
+   tree->Branch("n", &n, "n/I");
+   tree->Branch("pt", pt, "pt[n]/F");
+   tree->Branch("pos", pos, "pos[3]/D");
+   tree->Branch("flag", &flag, "flag/O");
+   tree->Branch("label", label, "label/C");
+   tree->Branch("energies", &energies);
+   for (int i = 0; i < nEntries; ++i) {
+      n = i % 8;
+      for (int j = 0; j < n; ++j)
+         pt[j] = i + j;
+      pos[0] = i;
+      pos[1] = 2 * i;
+      pos[2] = 3 * i;
+      flag = (i % 2) == 0;
+      snprintf(label, sizeof(label), "entry%d", i);
+      energies.assign(i % 3, float(i));
+      tree->Fill();
+   }
+   tree->Write();
+}
+
+} // anonymous namespace
+
+TEST(RNTupleImporter, Basics)
+{
+   FileRaii fileGuardTree("test_ntuple_importer_basics_tree.root");
+   FileRaii fileGuardNTuple("test_ntuple_importer_basics_ntuple.root");
+   CreateTree(fileGuardTree.GetPath(), 20, 1000);
+
+   auto importer = RNTupleImporter::Create(fileGuardTree.GetPath(), "tree", fileGuardNTuple.GetPath());
+   importer->SetNTupleName("ntuple");
+   importer->EnableMetrics();
+   importer->Import();
+   EXPECT_EQ(20, importer->GetMetrics().GetCounter("RNTupleImporter.nEntries")->GetValueAsInt());
+   EXPECT_EQ(1, importer->GetMetrics().GetCounter("RNTupleImporter.nClusters")->GetValueAsInt());
+   EXPECT_GT(importer->GetMetrics().GetCounter("RNTupleImporter.szRead")->GetValueAsInt(), 0);
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuardNTuple.GetPath());
+   ASSERT_EQ(20U, ntuple->GetNEntries());
+   auto entry = ntuple->GetModel()->GetDefaultEntry();
+   for (unsigned i = 0; i < ntuple->GetNEntries(); ++i) {
+      ntuple->LoadEntry(i);
+      EXPECT_EQ(int(i % 8), *entry->Get<std::int32_t>("n"));
+      const auto &pt = *entry->Get<std::vector<float>>("pt");
+      ASSERT_EQ(i % 8, pt.size());
+      for (unsigned j = 0; j < pt.size(); ++j)
+         EXPECT_FLOAT_EQ(float(i + j), pt[j]);
+      const auto &pos = *entry->Get<std::array<double, 3>>("pos");
+      EXPECT_DOUBLE_EQ(double(i), pos[0]);
+      EXPECT_DOUBLE_EQ(double(3 * i), pos[2]);
+      EXPECT_EQ((i % 2) == 0, *entry->Get<bool>("flag"));
+      EXPECT_EQ("entry" + std::to_string(i), *entry->Get<std::string>("label"));
+      EXPECT_EQ(std::vector<float>(i % 3, float(i)), *entry->Get<std::vector<float>>("energies"));
+   }
+}
+
+TEST(RNTupleImporter, UnsupportedBranch)
+{
+   FileRaii fileGuardTree("test_ntuple_importer_unsupported_tree.root");
+   {
+      auto file = std::unique_ptr<TFile>(TFile::Open(fileGuardTree.GetPath().c_str(), "RECREATE"));
+      auto tree = new TTree("tree", "");
+      struct {
+         Int_t a;
+         Float_t b;
+      } leaves;
+      tree->Branch("leaves", &leaves, "a/I:b/F");
+      tree->Fill();
+      tree->Write();
+   }
+   EXPECT_THROW(RNTupleImporter::Create(fileGuardTree.GetPath(), "tree", "unused.root"), RException);
+   EXPECT_THROW(RNTupleImporter::Create(fileGuardTree.GetPath(), "nonexistent", "unused.root"), RException);
+}
+
+#ifdef R__USE_IMT
+TEST(RNTupleImporter, ParallelClusters)
+{
+   FileRaii fileGuardTree("test_ntuple_importer_parallel_tree.root");
+   FileRaii fileGuardNTuple("test_ntuple_importer_parallel_ntuple.root");
+   CreateTree(fileGuardTree.GetPath(), 100, 10);
+
+   ROOT::EnableImplicitMT(4);
+   auto importer = RNTupleImporter::Create(fileGuardTree.GetPath(), "tree", fileGuardNTuple.GetPath());
+   importer->EnableMetrics();
+   importer->Import();
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(10, importer->GetMetrics().GetCounter("RNTupleImporter.nClusters")->GetValueAsInt());
+
+   // The cluster order is not deterministic, the content of the entries is
+   auto ntuple = RNTupleReader::Open("tree", fileGuardNTuple.GetPath());
+   ASSERT_EQ(100U, ntuple->GetNEntries());
+   auto viewPos = ntuple->GetView<std::array<double, 3>>("pos");
+   auto viewN = ntuple->GetView<std::int32_t>("n");
+   double sum = 0;
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(int(viewPos(i)[0]) % 8, viewN(i));
+      sum += viewPos(i)[0];
+   }
+   EXPECT_DOUBLE_EQ(99. * 100. / 2., sum);
+}
+#endif
@@ -0,0 +1,54 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketBufferPool
+#define ROOT_TBasketBufferPool
+
+#include "RtypesCore.h"
+#include "TBuffer.h"
+
+class TBufferFile;
+
+namespace ROOT {
+namespace Internal {
+
+/** \class ROOT::Internal::TBasketBufferPool
+\ingroup tree
+\brief A process-wide pool of the memory buffers of TBasket.
+
+Baskets take the buffers holding their uncompressed and compressed data from this pool and give them back when they
+are deleted or drop their buffers, instead of allocating and freeing them. Trees opened and closed repeatedly, as the
+trees of the tasks of ROOT::TTreeProcessorMT, therefore recycle the buffers of the trees processed before them.
+
+The free buffers are kept in size classes (powers of two) and a buffer is reused only for requests of at least half
+its size. The pool keeps at most GetMaxSize() bytes of free buffers: further buffers are deleted when they are
+released, and Trim() frees the pooled buffers, largest first, e.g. when memory runs short. All methods are
+thread-safe.
+*/
+class TBasketBufferPool {
+public:
+   /// Return a buffer in the given mode with room for at least `size` bytes, from the pool if possible.
+   static TBufferFile *Acquire(TBuffer::EMode mode, Int_t size);
+   /// Give a buffer back to the pool, or delete it if the pool is full or cannot reuse it. Buffers that do not own
+   /// their memory or that are not exactly TBufferFile objects are always deleted.
+   static void Release(TBuffer *buffer);
+   /// Delete pooled buffers, largest first, until at most `maxBytes` bytes are kept.
+   static void Trim(Long64_t maxBytes = 0);
+   /// Set the maximum number of bytes kept in the pool. A value of 0 disables the pooling.
+   static void SetMaxSize(Long64_t maxBytes);
+   static Long64_t GetMaxSize();
+   /// Return the number of bytes of the buffers currently in the pool.
+   static Long64_t GetSize();
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -143,6 +143,7 @@ public:
    Bool_t          GetResetAllocationCount() const { return fResetAllocation; }
 
    Int_t           LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tree = 0);
+   Int_t           LoadBasketBuffersFromMemory(const char *buffer, Int_t len, TFile *file);
    Long64_t        CopyTo(TFile *to);
 
            void    SetBranch(TBranch *branch) { fBranch = branch; }
@@ -31,6 +31,8 @@
 #include "Compression.h"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <vector>
+
 class TTree;
 class TBasket;
 class TBranchElement;
@@ -71,9 +73,11 @@ class TBulkBranchRead {
 
 public:
    Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf);
+   Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf, std::vector<Int_t> &offsets);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf, TBuffer *count_buf);
    Bool_t SupportsBulkRead() const;
+   Bool_t SupportsBulkReadWithOffsets() const;
 
 private:
    TBulkBranchRead(TBranch &parent)
@@ -150,6 +154,11 @@ protected:
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
 
+   UInt_t      fCompressionDictID{0};         ///<! Identifier of the ZSTD dictionary compressing the baskets, 0 if none
+   Bool_t      fCompressionDictDone{kFALSE};  ///<! True once the samples for the compression dictionary have been used
+   std::vector<char>    fDictSamples;         ///<! Uncompressed baskets collected to train the compression dictionary
+   std::vector<ULong_t> fDictSampleSizes;     ///<! Sizes of the baskets in fDictSamples
+
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
@@ -178,6 +187,9 @@ private:
    Int_t    GetBasketAndFirst(TBasket*& basket, Long64_t& first, TBuffer* user_buffer);
    TBasket *GetBasketImpl(Int_t basket, TBuffer* user_buffer);
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
+   Int_t    GetBulkEntries(Long64_t, TBuffer&, std::vector<Int_t>&);
+   Int_t    GetBulkBasket(Long64_t, TBuffer&, TBasket*&);
+   void     ReleaseBulkBasket(TBasket*);
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
@@ -193,6 +205,7 @@ public:
 
    virtual void      AddBasket(TBasket &b, Bool_t ondisk, Long64_t startEntry);
    virtual void      AddLastBasket(Long64_t startEntry);
+           void      AddCompressionDictionarySample(const char *buffer, Int_t len);
            Int_t     BackFill();
    virtual void      Browse(TBrowser *b);
    virtual void      DeleteBaskets(Option_t* option="");
@@ -217,6 +230,7 @@ public:
            Int_t     GetCompressionAlgorithm() const;
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
+           UInt_t    GetCompressionDictionaryID() const { return fCompressionDictID; }
    TDirectory       *GetDirectory() const {return fDirectory;}
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
@@ -283,6 +297,7 @@ public:
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
            Bool_t    SupportsBulkRead() const;
+           Bool_t    SupportsBulkReadWithOffsets() const;
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
 
@@ -314,9 +329,11 @@ namespace Experimental {
 namespace Internal {
 
 inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf) { return fParent.GetBulkEntries(evt, user_buf); }
+inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf, std::vector<Int_t>& offsets) { return fParent.GetBulkEntries(evt, user_buf, offsets); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf) { return fParent.GetEntriesSerialized(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf, TBuffer* count_buf) { return fParent.GetEntriesSerialized(evt, user_buf, count_buf); }
 inline Bool_t TBulkBranchRead::SupportsBulkRead() const { return fParent.SupportsBulkRead(); }
+inline Bool_t TBulkBranchRead::SupportsBulkReadWithOffsets() const { return fParent.SupportsBulkReadWithOffsets(); }
 
 }  // Internal
 }  // Experimental
@@ -30,6 +30,12 @@ class TEntryList;
 class TEventList;
 class TCollection;
 
+namespace ROOT {
+namespace Internal {
+class TChainAsyncOpener;
+}
+}
+
 class TChain : public TTree {
 
 protected:
@@ -43,11 +49,14 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Int_t        fAsyncOpenDepth{0};  ///<! Number of files opened ahead of the current one, see SetAsyncOpen()
+   ROOT::Internal::TChainAsyncOpener *fAsyncOpener{nullptr}; ///<! Files being opened in the background (owned)
 
 private:
    TChain(const TChain&);            // not implemented
    TChain& operator=(const TChain&); // not implemented
    void ParseTreeFilename(const char *name, TString &filename, TString &treename, TString &query, TString &suffix, Bool_t wildcards) const;
+   void FillTreeOffsetsParallel();
 
 protected:
    void InvalidateCurrentTree();
@@ -98,6 +107,7 @@ public:
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall=0);
    virtual Long64_t  GetEntryNumber(Long64_t entry) const;
    virtual Int_t     GetEntryWithIndex(Int_t major, Int_t minor=0);
+           Int_t     GetAsyncOpen() const { return fAsyncOpenDepth; }
    TFile            *GetFile() const;
    virtual TLeaf    *GetLeaf(const char* branchname, const char* leafname);
    virtual TLeaf    *GetLeaf(const char* name);
@@ -138,6 +148,7 @@ public:
    virtual void      ResetBranchAddresses();
    virtual void      SavePrimitive (std::ostream &out, Option_t *option="");
    virtual Long64_t  Scan(const char *varexp="", const char *selection="", Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
+           void      SetAsyncOpen(Int_t nfiles = 1);
    virtual void      SetAutoDelete(Bool_t autodel=kTRUE);
    virtual Int_t     SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
    virtual Int_t     SetBranchAddress(const char *bname,void *add, TBranch **ptr, TClass *realClass, EDataType datatype, Bool_t isptr);
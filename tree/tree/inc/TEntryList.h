@@ -84,6 +84,7 @@ class TEntryList: public TNamed
       return kFALSE;
    }
 
+   virtual void        Intersect(const TEntryList *elist);
    virtual Int_t       Merge(TCollection *list);
 
    virtual Long64_t    Next();
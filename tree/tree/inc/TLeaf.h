@@ -114,6 +114,7 @@ public:
    virtual void     FillBasket(TBuffer &b);
    virtual Int_t   *GenerateOffsetArray(Int_t base, Int_t events) { return GenerateOffsetArrayBase(base, events); }
    TBranch         *GetBranch() const { return fBranch; }
+   virtual Bool_t   GetBulkEntryLayout(Int_t &header, Int_t &valueSize) const;
    virtual DeserializeType GetDeserializeType() const { return DeserializeType::kExternal; }
    virtual TString  GetFullName() const;
    ///  If this leaf stores a variable-sized array or a multi-dimensional array whose last dimension has variable size,
@@ -152,6 +153,7 @@ public:
    virtual void     ReadBasket(TBuffer &) {}
    virtual void     ReadBasketExport(TBuffer &, TClonesArray *, Int_t) {}
    virtual bool     ReadBasketFast(TBuffer&, Long64_t) { return false; }  // Read contents of leaf into a user-provided buffer.
+   virtual bool     ReadBasketFastArray(TBuffer&, Long64_t) { return false; }  // Deserialize in place N contiguous values of this leaf.
    virtual bool     ReadBasketSerialized(TBuffer&, Long64_t) { return true; } 
    virtual void     ReadValue(std::istream & /*s*/, Char_t /*delim*/ = ' ') {
       Error("ReadValue", "Not implemented!");
@@ -50,6 +50,7 @@ public:
    virtual void    SetAddress(void *add=0);
 
    virtual bool    ReadBasketFast(TBuffer&, Long64_t);
+   virtual bool    ReadBasketFastArray(TBuffer&, Long64_t);
 
    ClassDef(TLeafD,1);  //A TLeaf for a 64 bit floating point data type.
 };
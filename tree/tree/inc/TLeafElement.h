@@ -37,9 +37,11 @@ protected:
    Int_t               fType;         ///<  leaf type
    mutable std::atomic<DeserializeType> fDeserializeTypeCache{ DeserializeType::kInvalid }; ///<! Cache of the type of deserialization.
    mutable std::atomic<EDataType> fDataTypeCache{EDataType::kOther_t}; ///<! Cache of the EDataType of deserialization.
+   mutable std::atomic<EDataType> fCollectionTypeCache{EDataType::kNoType_t}; ///<! Cache of the EDataType of the values of a std::vector of fundamental types, kOther_t for any other type.
 
 private:
    virtual Int_t       GetOffsetHeaderSize() const {return 1;}
+   EDataType           GetCollectionValueType() const;
 
 public:
    TLeafElement();
@@ -48,6 +50,7 @@ public:
 
    virtual Bool_t   CanGenerateOffsetArray() { return fLeafCount && fLenType; }
    virtual Int_t   *GenerateOffsetArrayBase(Int_t /*base*/, Int_t /*events*/) { return nullptr; }
+   virtual Bool_t   GetBulkEntryLayout(Int_t &header, Int_t &valueSize) const;
    virtual DeserializeType GetDeserializeType() const;
 
    virtual TString  GetFullName() const;
@@ -63,6 +66,7 @@ public:
    template<typename T> T GetTypedValueSubArray(Int_t i=0, Int_t j=0) const {return ((TBranchElement*)fBranch)->GetTypedValue<T>(i, j, kTRUE);}
 
    virtual bool     ReadBasketFast(TBuffer&, Long64_t);
+   virtual bool     ReadBasketFastArray(TBuffer&, Long64_t);
  
    virtual void    *GetValuePointer() const { return ((TBranchElement*)fBranch)->GetValuePointer(); }
    virtual Bool_t   IncludeRange(TLeaf *);
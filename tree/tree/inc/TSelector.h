@@ -50,6 +50,8 @@ public:
    virtual            ~TSelector();
 
    virtual int         Version() const { return 0; }
+   /// Return kTRUE if workers of this selector can process parts of the tree in parallel, see TSelector
+   virtual Bool_t      IsThreadSafe() const { return kFALSE; }
    virtual void        Init(TTree *) { }
    virtual void        Begin(TTree *) { }
    virtual void        SlaveBegin(TTree *) { }
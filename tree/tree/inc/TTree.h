@@ -137,6 +137,12 @@ protected:
    Bool_t         fCacheDoClusterPrefetch;///<! true if cache is prefetching whole clusters
    Bool_t         fCacheUserSet;          ///<! true if the cache setting was explicitly given by user
    Bool_t         fIMTEnabled;            ///<! true if implicit multi-threading is enabled for this tree
+   Bool_t         fIMTParallelFill{kFALSE}; ///<! true if Fill serializes the top-level branches in parallel when IMT is on
+   Bool_t         fAdaptiveBaskets{kTRUE};  ///<! true if Fill may resize the baskets at each cluster, see SetAdaptiveBaskets()
+   Long64_t       fBasketMemoryBudget{0};   ///<! Maximum total size of the baskets optimized by Fill, 0 for the size of a cluster
+   std::vector<std::pair<Long64_t,Long64_t>> fClusterBasketBytes; ///<! Bytes and entries of the branch of each leaf at the last cluster boundary
+   std::vector<Double_t> fOptimizedBasketShares; ///<! Share of the branch of each leaf in the cluster used for the last basket optimization
+   Int_t          fCompressionDictSize{0};  ///<! Maximum size of the ZSTD dictionary trained for each branch, 0 if disabled
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches to be processed in parallel when IMT is on, sorted by average task time
    std::vector<TBranch*> fSeqBranches;    ///<! Branches to be processed sequentially when IMT is on
@@ -161,6 +167,12 @@ private:
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
    void             MarkEventCluster();
+   void             OptimizeBasketsImpl(ULong64_t maxMemory, Float_t minComp, Bool_t debug,
+                                        const std::vector<std::pair<Long64_t,Long64_t>> *since);
+   void             RebalanceBaskets();
+   void             TrainCompressionDictionaries();
+   void             LoadCompressionDictionaries();
+   void             CopyCompressionDictionaries(const TTree *from);
 
 protected:
    virtual void     KeepCircular();
@@ -217,7 +229,10 @@ protected:
       kLoadTree          = BIT(9),
       kPrint             = BIT(10),
       kRemoveFriend      = BIT(11),
-      kSetBranchStatus   = BIT(12)
+      kSetBranchStatus   = BIT(12),
+      kAddBranchToCache  = BIT(13),
+      kSetCacheEntryRange = BIT(14),
+      kStopCacheLearningPhase = BIT(15)
    };
 
 public:
@@ -441,6 +456,8 @@ public:
 #endif
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
+   virtual Bool_t          GetAdaptiveBaskets() const { return fAdaptiveBaskets; }
+   virtual Long64_t        GetBasketMemoryBudget() const { return fBasketMemoryBudget; }
    virtual TBranch        *GetBranch(const char* name);
    virtual TBranchRef     *GetBranchRef() const { return fBranchRef; };
    virtual Bool_t          GetBranchStatus(const char* branchname) const;
@@ -450,6 +467,7 @@ public:
    virtual Long64_t        GetChainEntryNumber(Long64_t entry) const { return entry; }
    virtual Long64_t        GetChainOffset() const { return fChainOffset; }
    virtual Bool_t          GetClusterPrefetch() const { return fCacheDoClusterPrefetch; }
+   virtual Int_t           GetCompressionDictionarySize() const { return fCompressionDictSize; }
    TFile                  *GetCurrentFile() const;
            Int_t           GetDefaultEntryOffsetLen() const {return fDefaultEntryOffsetLen;}
            Long64_t        GetDebugMax()  const { return fDebugMax; }
@@ -473,6 +491,7 @@ public:
    virtual const char     *GetFriendAlias(TTree*) const;
    TH1                    *GetHistogram() { return GetPlayer()->GetHistogram(); }
    virtual Bool_t          GetImplicitMT() { return fIMTEnabled; }
+   virtual Bool_t          GetParallelFill() const { return fIMTParallelFill; }
    virtual Int_t          *GetIndex() { return &fIndex.fArray[0]; }
    virtual Double_t       *GetIndexValues() { return &fIndexValues.fArray[0]; }
            ROOT::TIOFeatures GetIOFeatures() const;
@@ -576,6 +595,8 @@ public:
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
+   virtual void            SetAdaptiveBaskets(Bool_t enabled = kTRUE);
+   virtual void            SetBasketMemoryBudget(Long64_t maxBytes);
    virtual void            SetBasketSize(const char* bname, Int_t buffsize = 16000);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TClass *realClass, EDataType datatype, Bool_t isptr);
@@ -604,6 +625,7 @@ public:
    virtual void            SetChainOffset(Long64_t offset = 0) { fChainOffset=offset; }
    virtual void            SetCircular(Long64_t maxEntries);
    virtual void            SetClusterPrefetch(Bool_t enabled) { fCacheDoClusterPrefetch = enabled; }
+   virtual void            SetCompressionDictionarySize(Int_t maxBytes = 16384);
    virtual void            SetDebug(Int_t level = 1, Long64_t min = 0, Long64_t max = 9999999); // *MENU*
    virtual void            SetDefaultEntryOffsetLen(Int_t newdefault, Bool_t updateExisting = kFALSE);
    virtual void            SetDirectory(TDirectory* dir);
@@ -633,6 +655,7 @@ public:
    virtual void            SetNotify(TObject* obj) { fNotify = obj; }
 
    virtual void            SetObject(const char* name, const char* title);
+   virtual void            SetParallelFill(Bool_t enabled = kTRUE);
    virtual void            SetParallelUnzip(Bool_t opt=kTRUE, Float_t RelSize=-1);
    virtual void            SetPerfStats(TVirtualPerfStats* perf);
    virtual void            SetScanField(Int_t n = 50) { fScanField = n; } // *MENU*
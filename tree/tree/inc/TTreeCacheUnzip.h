@@ -97,6 +97,11 @@ protected:
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
 
+   std::vector<Int_t>    fUnzipOrder;           ///<! Indices of the baskets in fSeek, sorted by their first entry: the order in which they are consumed
+   std::atomic<Int_t>    fUnzipNext{0};         ///<! Position in fUnzipOrder of the next basket to be unzipped ahead
+   std::atomic<Long64_t> fUnzipPending{0};      ///<! Total size of the unzipped baskets not consumed yet, kept under fUnzipBufferSize
+   std::atomic<Bool_t>   fUnzipThrottled{kFALSE}; ///<! Set when the unzipping tasks stopped because fUnzipBufferSize was reached
+
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
@@ -114,6 +119,11 @@ private:
 
    // Private methods
    void  Init();
+   Int_t NextUnzipIndex();
+   void  StopUnzipTasks();
+#ifdef R__USE_IMT
+   void  UnzipTask();
+#endif
 
 public:
    TTreeCacheUnzip();
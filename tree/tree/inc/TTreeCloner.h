@@ -87,6 +87,8 @@ class TTreeCloner {
    void CreateCache();
    UInt_t FillCache(UInt_t from);
    void RestoreCache();
+   void WriteMemoryBasket(UInt_t j);
+   Bool_t WriteBasketsPipelined();
 
 private:
    TTreeCloner(const TTreeCloner&) = delete;
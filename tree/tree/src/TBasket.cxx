@@ -23,7 +23,9 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/RZipBlocks.hxx"
 #include "RZip.h"
 
 #include <bitset>
@@ -66,7 +68,7 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
    SetTitle(title);
    fClassName   = "TBasket";
    fBuffer = nullptr;
-   fBufferRef   = new TBufferFile(TBuffer::kWrite, fBufferSize);
+   fBufferRef   = ROOT::Internal::TBasketBufferPool::Acquire(TBuffer::kWrite, fBufferSize);
    fVersion    += 1000;
    if (branch->GetDirectory()) {
       TFile *file = branch->GetFile();
@@ -80,7 +82,7 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
 #endif
       fOwnsCompressedBuffer = kFALSE;
       if (!fCompressedBufferRef) {
-         fCompressedBufferRef = new TBufferFile(TBuffer::kRead, fBufferSize);
+         fCompressedBufferRef = ROOT::Internal::TBasketBufferPool::Acquire(TBuffer::kRead, fBufferSize);
          fOwnsCompressedBuffer = kTRUE;
       }
    }
@@ -105,13 +107,13 @@ TBasket::~TBasket()
 {
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef) delete fBufferRef;
+   ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
    fBufferRef = 0;
    fBuffer = 0;
    fDisplacement= 0;
    // Note we only delete the compressed buffer if we own it
    if (fCompressedBufferRef && fOwnsCompressedBuffer) {
-      delete fCompressedBufferRef;
+      ROOT::Internal::TBasketBufferPool::Release(fCompressedBufferRef);
       fCompressedBufferRef = 0;
    }
    // TKey::~TKey will use fMotherDir to attempt to remove they key
@@ -176,8 +178,8 @@ Int_t TBasket::DropBuffers()
 
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef)    delete fBufferRef;
-   if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
+   ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
+   if (fCompressedBufferRef && fOwnsCompressedBuffer) ROOT::Internal::TBasketBufferPool::Release(fCompressedBufferRef);
    fBufferRef   = 0;
    fCompressedBufferRef = 0;
    fBuffer      = 0;
@@ -256,7 +258,7 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
       }
       fBufferRef->SetReadMode();
    } else {
-      fBufferRef = new TBufferFile(TBuffer::kRead, len);
+      fBufferRef = ROOT::Internal::TBasketBufferPool::Acquire(TBuffer::kRead, len);
    }
    fBufferRef->SetParent(file);
    char *buffer = fBufferRef->Buffer();
@@ -303,6 +305,37 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Load basket buffers from the `len` bytes at `buffer`, which hold the
+/// basket (key and data) as it is stored in `file`.
+///
+/// This is the equivalent of LoadBasketBuffers for the bytes of a basket
+/// that were already read, e.g. by TTreeCloner while it writes the previous
+/// baskets. The file is not accessed.
+///
+/// \return 0 on success
+
+Int_t TBasket::LoadBasketBuffersFromMemory(const char *buffer, Int_t len, TFile *file)
+{
+   if (fBufferRef) {
+      fBufferRef->Reset();
+      fBufferRef->SetWriteMode();
+      if (fBufferRef->BufferSize() < len) {
+         fBufferRef->Expand(len);
+      }
+   } else {
+      fBufferRef = ROOT::Internal::TBasketBufferPool::Acquire(TBuffer::kRead, len);
+   }
+   fBufferRef->SetParent(file);
+   memcpy(fBufferRef->Buffer(), buffer, len);
+
+   fBufferRef->SetReadMode();
+   fBufferRef->SetBufferOffset(0);
+   Streamer(*fBufferRef);
+
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove the first dentries of this basket, moving entries at
 /// dentries to the start of the buffer.
@@ -420,7 +453,7 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
       bufferRef->Reset();
       result = bufferRef;
    } else {
-      result = new TBufferFile(TBuffer::kRead, len);
+      result = ROOT::Internal::TBasketBufferPool::Acquire(TBuffer::kRead, len);
    }
    result->SetParent(file);
    return result;
@@ -602,31 +635,25 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, fKeylen);
       char *rawUncompressedObjectBuffer = rawUncompressedBuffer+fKeylen;
       UChar_t *rawCompressedObjectBuffer = (UChar_t*)rawCompressedBuffer+fKeylen;
-      Int_t nin, nbuf;
+      Int_t nin = 0, nbuf = 0;
       Int_t nout = 0, noutot = 0, nintot = 0;
 
-      // Unzip all the compressed objects in the compressed object buffer.
-      while (1) {
+      if (R__unlikely(oldCase)) {
          // Check the header for errors.
          if (R__unlikely(R__unzip_header(&nin, rawCompressedObjectBuffer, &nbuf) != 0)) {
             Error("ReadBasketBuffers", "Inconsistency found in header (nin=%d, nbuf=%d)", nin, nbuf);
-            break;
-         }
-         if (R__unlikely(oldCase && (nin > fObjlen || nbuf > fObjlen))) {
+         } else if (nin > fObjlen || nbuf > fObjlen) {
             //buffer was very likely not compressed in an old version
             memcpy(rawUncompressedBuffer+fKeylen, rawCompressedObjectBuffer+fKeylen, fObjlen);
             goto AfterBuffer;
          }
-
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
-         if (!nout) break;
-         noutot += nout;
-         nintot += nin;
-         if (noutot >= fObjlen) break;
-         rawCompressedObjectBuffer += nin;
-         rawUncompressedObjectBuffer += nout;
       }
 
+      // Unzip all the compressed objects in the compressed object buffer.
+      noutot = ROOT::Internal::UnzipBlocks(rawCompressedObjectBuffer, len - fKeylen, rawUncompressedObjectBuffer,
+                                           fObjlen, &nintot);
+      nout = noutot;
+
       // Make sure the uncompressed numbers are consistent with header.
       if (R__unlikely(noutot != fObjlen)) {
          Error("ReadBasketBuffers", "fNbytes = %d, fKeylen = %d, fObjlen = %d, noutot = %d, nout=%d, nin=%d, nbuf=%d", fNbytes,fKeylen,fObjlen, noutot,nout,nin,nbuf);
@@ -720,7 +747,7 @@ void TBasket::DisownBuffer()
 /// Adopt a buffer from an external entity
 void TBasket::AdoptBuffer(TBuffer *user_buffer)
 {
-   delete fBufferRef;
+   ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
    fBufferRef = user_buffer;
 }
 
@@ -1015,7 +1042,7 @@ void TBasket::Streamer(TBuffer &b)
          fEntryOffset = reinterpret_cast<Int_t *>(-1);
       }
       if (flag == 1 || flag > 10) {
-         fBufferRef = new TBufferFile(TBuffer::kRead,fBufferSize);
+         fBufferRef = ROOT::Internal::TBasketBufferPool::Acquire(TBuffer::kRead, fBufferSize);
          fBufferRef->SetParent(b.GetParent());
          char *buf  = fBufferRef->Buffer();
          if (v > 1) b.ReadFastArray(buf,fLast);
@@ -1204,7 +1231,7 @@ Int_t TBasket::WriteBuffer()
       }
    }
 
-   Int_t nout, noutot, bufmax, nzip;
+   Int_t nout, noutot;
 
    fObjlen = fBufferRef->Length() - fKeylen;
 
@@ -1217,6 +1244,8 @@ Int_t TBasket::WriteBuffer()
    if (cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kInherit)
       cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(file->GetCompressionAlgorithm());
    if (cxlevel > 0) {
+      if (cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD && !fBranch->GetCompressionDictionaryID())
+         fBranch->AddCompressionDictionarySample(fBufferRef->Buffer() + fKeylen, fObjlen);
       Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
       Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
       InitializeCompressedBuffer(buflen, file);
@@ -1228,47 +1257,37 @@ Int_t TBasket::WriteBuffer()
       fBuffer = fCompressedBufferRef->Buffer();
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else bufmax = kMAXZIPBUF;
-         // Compress the buffer.  Note that we allow multiple TBasket compressions to occur at once
-         // for a given TFile: that's because the compression buffer when we use IMT is no longer
-         // shared amongst several threads.
+      // Compress the buffer.  Note that we allow multiple TBasket compressions to occur at once
+      // for a given TFile: that's because the compression buffer when we use IMT is no longer
+      // shared amongst several threads.
 #ifdef R__USE_IMT
-         sentry.unlock();
+      sentry.unlock();
 #endif  // R__USE_IMT
-         // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
-         // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
-         // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+      // NOTE when USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
+      // (see fCompressedBufferRef in constructor).
+      noutot = ROOT::Internal::ZipBlocks(cxlevel, cxAlgorithm, objbuf, fObjlen, bufcur,
+                                         fBranch->GetCompressionDictionaryID());
 #ifdef R__USE_IMT
-         sentry.lock();
+      sentry.lock();
 #endif  // R__USE_IMT
 
-         // test if buffer has really been compressed. In case of small buffers
-         // when the buffer contains random data, it may happen that the compressed
-         // buffer is larger than the input. In this case, we write the original uncompressed buffer
-         if (nout == 0 || nout >= fObjlen) {
-            nout = fObjlen;
-            // We used to delete fBuffer here, we no longer want to since
-            // the buffer (held by fCompressedBufferRef) might be re-used later.
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen,file);
-            fBufferRef->SetBufferOffset(0);
-
-            Streamer(*fBufferRef);         //write key itself again
-            if ((nout+fKeylen)>buflen) {
-               Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
-                  (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
-            }
-            goto WriteFile;
+      // test if buffer has really been compressed. In case of small buffers
+      // when the buffer contains random data, it may happen that the compressed
+      // buffer is larger than the input. In this case, we write the original uncompressed buffer
+      if (noutot == 0) {
+         nout = fObjlen;
+         // We used to delete fBuffer here, we no longer want to since
+         // the buffer (held by fCompressedBufferRef) might be re-used later.
+         fBuffer = fBufferRef->Buffer();
+         Create(fObjlen,file);
+         fBufferRef->SetBufferOffset(0);
+
+         Streamer(*fBufferRef);         //write key itself again
+         if ((nout+fKeylen)>buflen) {
+            Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
+               (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
          }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+         goto WriteFile;
       }
       nout = noutot;
       Create(noutot,file);
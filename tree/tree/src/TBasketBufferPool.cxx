@@ -0,0 +1,174 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBasketBufferPool.hxx"
+#include "TBufferFile.h"
+#include "TStorage.h"
+
+#include <iterator>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+class RBufferPool {
+   static constexpr int kNClasses = 32;
+
+   std::mutex fMutex;
+   /// The free buffers per mode (read, write) and size class, the class of a buffer of n bytes being floor(log2(n))
+   std::vector<TBufferFile *> fBuffers[2][kNClasses];
+   Long64_t fSize = 0;
+   Long64_t fMaxSize = 64 * 1024 * 1024;
+
+   static int GetSizeClass(Int_t size)
+   {
+      int sizeClass = 0;
+      while (size > 1 && sizeClass < kNClasses - 1) {
+         size >>= 1;
+         ++sizeClass;
+      }
+      return sizeClass;
+   }
+
+   void TrimImpl(Long64_t maxBytes)
+   {
+      for (int sizeClass = kNClasses - 1; sizeClass >= 0 && fSize > maxBytes; --sizeClass) {
+         for (auto &buffers : fBuffers) {
+            auto &bucket = buffers[sizeClass];
+            while (!bucket.empty() && fSize > maxBytes) {
+               fSize -= bucket.back()->BufferSize();
+               delete bucket.back();
+               bucket.pop_back();
+            }
+         }
+      }
+   }
+
+public:
+   TBufferFile *Get(bool isWriting, Int_t size)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      // A buffer at most twice as large as requested can only be in the same size class or in the next one
+      const int sizeClass = GetSizeClass(size);
+      for (int c = sizeClass; c <= sizeClass + 1 && c < kNClasses; ++c) {
+         auto &bucket = fBuffers[isWriting][c];
+         // most recently released buffers first, their memory is more likely to be in cache
+         for (auto it = bucket.rbegin(); it != bucket.rend(); ++it) {
+            auto buffer = *it;
+            const Long64_t bufferSize = buffer->BufferSize();
+            if (bufferSize >= size && bufferSize <= 2ll * size) {
+               bucket.erase(std::next(it).base());
+               fSize -= bufferSize;
+               return buffer;
+            }
+         }
+      }
+      return nullptr;
+   }
+
+   // Return false if the buffer was not pooled
+   bool Put(TBufferFile *buffer)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      const Int_t size = buffer->BufferSize();
+      if (fSize + size > fMaxSize)
+         return false;
+      fBuffers[buffer->IsWriting()][GetSizeClass(size)].push_back(buffer);
+      fSize += size;
+      return true;
+   }
+
+   void Trim(Long64_t maxBytes)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      TrimImpl(maxBytes);
+   }
+
+   void SetMaxSize(Long64_t maxBytes)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fMaxSize = maxBytes;
+      TrimImpl(maxBytes);
+   }
+
+   Long64_t GetMaxSize()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fMaxSize;
+   }
+
+   Long64_t GetSize()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fSize;
+   }
+};
+
+RBufferPool &GetPool()
+{
+   // Never destroyed: baskets may still release their buffers while static objects are being destructed
+   static RBufferPool *pool = new RBufferPool;
+   return *pool;
+}
+
+} // anonymous namespace
+
+using ROOT::Internal::TBasketBufferPool;
+
+TBufferFile *TBasketBufferPool::Acquire(TBuffer::EMode mode, Int_t size)
+{
+   auto buffer = GetPool().Get(mode == TBuffer::kWrite, size);
+   if (!buffer)
+      return new TBufferFile(mode, size);
+
+   // make the recycled buffer look like a new one
+   buffer->Reset();
+   buffer->SetParent(nullptr);
+   buffer->SetPidOffset(0);
+   buffer->ResetBit(TBuffer::kCannotHandleMemberWiseStreaming);
+   if (mode == TBuffer::kWrite)
+      buffer->SetWriteMode();
+   else
+      buffer->SetReadMode();
+   return buffer;
+}
+
+void TBasketBufferPool::Release(TBuffer *buffer)
+{
+   if (!buffer)
+      return;
+   // Only buffers that own memory allocated by TStorage can be reused by TBasket as if they were new. The comparison
+   // of the exact type excludes the classes deriving from TBufferFile, e.g. TBufferSQL.
+   const bool canReuse = typeid(*buffer) == typeid(TBufferFile) && buffer->TestBit(TBuffer::kIsOwner) &&
+                         buffer->Buffer() && buffer->GetReAllocFunc() == TStorage::ReAllocChar;
+   if (!canReuse || !GetPool().Put(static_cast<TBufferFile *>(buffer)))
+      delete buffer;
+}
+
+void TBasketBufferPool::Trim(Long64_t maxBytes)
+{
+   GetPool().Trim(maxBytes);
+}
+
+void TBasketBufferPool::SetMaxSize(Long64_t maxBytes)
+{
+   GetPool().SetMaxSize(maxBytes);
+}
+
+Long64_t TBasketBufferPool::GetMaxSize()
+{
+   return GetPool().GetMaxSize();
+}
+
+Long64_t TBasketBufferPool::GetSize()
+{
+   return GetPool().GetSize();
+}
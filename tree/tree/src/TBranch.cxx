@@ -610,6 +610,25 @@ void TBranch::AddBasket(TBasket& b, Bool_t ondisk, Long64_t startEntry)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep a copy of the uncompressed content of a basket written before the ZSTD
+/// compression dictionary of this branch is trained, as a sample to train it
+/// at the end of the cluster (see TTree::SetCompressionDictionarySize()).
+/// Large baskets, which do not profit from a dictionary, are not kept.
+
+void TBranch::AddCompressionDictionarySample(const char *buffer, Int_t len)
+{
+   static const Int_t kMaxSampleSize = 128 * 1024;
+   const Int_t dictSize = fTree ? fTree->GetCompressionDictionarySize() : 0;
+   if (dictSize <= 0 || fCompressionDictDone || len <= 0 || len > kMaxSampleSize)
+      return;
+   // About 100 times the size of the dictionary in samples is enough to train it
+   if (fDictSamples.size() + len > 100 * (size_t)dictSize)
+      return;
+   fDictSamples.insert(fDictSamples.end(), buffer, buffer + len);
+   fDictSampleSizes.push_back(len);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add the start entry of the write basket (not yet created)
 
@@ -1460,12 +1479,131 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
       return -1;
    }
 
+   TBasket *basket = nullptr;
+   Int_t N = GetBulkBasket(entry, user_buf, basket);
+   if (R__unlikely(N < 0)) return -1;
+
+   Int_t bufbegin = basket->GetKeylen();
+   if (R__unlikely(!leaf->ReadBasketFast(user_buf, N))) {
+      Error("GetBulkEntries", "Leaf failed to read.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   ReleaseBulkBasket(basket);
+
+   return N;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if this branch supports bulk IO with an offsets array, false otherwise.
+///
+/// On top of the branches supporting SupportsBulkRead(), this covers the variable-size
+/// arrays of fundamental types (leaf lists with a count leaf, arrays in split objects)
+/// and the std::vector of fundamental types, at top level or in split objects.
+
+Bool_t TBranch::SupportsBulkReadWithOffsets() const {
+   Int_t header = 0;
+   Int_t valueSize = 0;
+   return (fNleaves == 1) &&
+          static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetBulkEntryLayout(header, valueSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read as many events as possible into the given buffer, using zero-copy
+/// mechanisms, also for branches whose entries have a variable number of values.
+///
+/// Returns -1 in case of a failure.  On success, returns a (non-zero) number of
+/// events N currently in the buffer.
+///
+/// On success, the values of all the events are stored contiguously, without any
+/// per-event header, and the caller should be able to access them as
+///
+/// static_cast<T*>(buf.GetCurrent())
+///
+/// where T is the type of the values stored on this branch. The values of event i
+/// are the ones with indices in [offsets[i], offsets[i+1]): offsets is resized to
+/// N + 1 elements and offsets[N] is the total number of values in the buffer.
+///
+/// NOTES:
+/// - This interface is meant to be used by higher-level, type-safe wrappers, not
+///   by end-users.
+/// - See SupportsBulkReadWithOffsets() for the branches supported.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> &offsets)
+{
+   if (R__unlikely(fNleaves != 1)) return -1;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+   Int_t header = 0;
+   Int_t valueSize = 0;
+   if (R__unlikely(!leaf->GetBulkEntryLayout(header, valueSize))) {
+      return -1;
+   }
+
+   TBasket *basket = nullptr;
+   Int_t N = GetBulkBasket(entry, user_buf, basket);
+   if (R__unlikely(N < 0)) return -1;
+
+   Int_t bufbegin = basket->GetKeylen();
+   offsets.resize(N + 1);
+   Long64_t nValues = 0;
+   Int_t *entryOffset = basket->GetEntryOffset();
+   if (!entryOffset) {
+      // All the entries have the same size and no header.
+      const Int_t len = leaf->GetLenStatic();
+      for (Int_t idx = 0; idx < N; ++idx) {
+         offsets[idx] = idx * len;
+      }
+      nValues = static_cast<Long64_t>(N) * len;
+   } else {
+      // Move the values of each entry right after the ones of the previous entry, dropping
+      // the per-entry headers: the values end up contiguous and can be deserialized in one go.
+      char *buffer = user_buf.Buffer();
+      Int_t dest = bufbegin;
+      for (Int_t idx = 0; idx < N; ++idx) {
+         const Int_t begin = entryOffset[idx] + header;
+         const Int_t end = (idx + 1 < N) ? entryOffset[idx + 1] : basket->GetLast();
+         const Int_t size = end - begin;
+         if (R__unlikely(size < 0 || size % valueSize)) {
+            Error("GetBulkEntries", "Unexpected size of entry %lld in branch %s.\n", entry + idx, GetName());
+            return -1;
+         }
+         offsets[idx] = nValues;
+         memmove(buffer + dest, buffer + begin, size);
+         dest += size;
+         nValues += size / valueSize;
+      }
+   }
+   offsets[N] = nValues;
+
+   user_buf.SetBufferOffset(bufbegin);
+   if (R__unlikely(!leaf->ReadBasketFastArray(user_buf, nValues))) {
+      Error("GetBulkEntries", "Leaf failed to read.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   ReleaseBulkBasket(basket);
+
+   return N;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A helper function for the bulk IO: load the basket that starts at the given entry
+/// and make user_buf hold its contents, taking over the memory of the basket when
+/// possible.  It should not be called directly.
+///
+/// Returns -1 in case of failure, including when entry is not the first entry of a
+/// basket.  On success, returns the number of entries in the basket and the buffer
+/// offset of user_buf is set to the beginning of the first entry.
+
+Int_t TBranch::GetBulkBasket(Long64_t entry, TBuffer &user_buf, TBasket *&basket)
+{
    // Remember which entry we are reading.
    fReadEntry = entry;
 
    Bool_t enabled = !TestBit(kDoNotProcess);
    if (R__unlikely(!enabled)) return -1;
-   TBasket *basket = nullptr;
    Long64_t first;
    Int_t result = GetBasketAndFirst(basket, first, &user_buf);
    if (R__unlikely(result < 0)) return -1;
@@ -1508,24 +1646,22 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
       }
    }
 
-   Int_t bufbegin = basket->GetKeylen();
-   user_buf.SetBufferOffset(bufbegin);
+   user_buf.SetBufferOffset(basket->GetKeylen());
 
-   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
-   //printf("Requesting %d events; fNextBasketEntry=%lld; first=%lld.\n", N, fNextBasketEntry, first);
-   if (R__unlikely(!leaf->ReadBasketFast(user_buf, N))) {
-      Error("GetBulkEntries", "Leaf failed to read.\n");
-      return -1;
-   }
-   user_buf.SetBufferOffset(bufbegin);
+   return ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+/// Once the bulk IO is done, keep the basket whose memory was handed to the user
+/// buffer as the extra basket of this branch.
+
+void TBranch::ReleaseBulkBasket(TBasket *basket)
+{
    if (fCurrentBasket == nullptr) {
       R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
       fExtraBasket = basket;
       basket->DisownBuffer();
    }
-
-   return N;
 }
 
 // TODO: Template this and the call above; only difference is the TLeaf function (ReadBasketFast vs
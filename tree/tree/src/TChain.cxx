@@ -62,8 +62,98 @@ the trees in the chain.
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
 ClassImp(TChain);
 
+namespace ROOT {
+namespace Internal {
+
+/// Opens the files of the elements following the current one of a TChain, see TChain::SetAsyncOpen().
+///
+/// With implicit multi-threading enabled, which guarantees that ROOT is thread-safe, each file is opened in a
+/// background thread, which also reads the keys of the file and the header of the tree: TChain::LoadTree then finds
+/// the tree in memory. Otherwise the opening goes through TFile::AsyncOpen, which is asynchronous for the protocols
+/// supporting it (e.g. xrootd) and is completed by TChain::LoadTree.
+class TChainAsyncOpener {
+   struct RPendingFile {
+      Int_t fTreeNumber;
+      std::future<TFile *> fFile;
+   };
+   std::deque<RPendingFile> fPending;
+
+public:
+   TChainAsyncOpener() = default;
+   TChainAsyncOpener(const TChainAsyncOpener &) = delete;
+   TChainAsyncOpener &operator=(const TChainAsyncOpener &) = delete;
+   ~TChainAsyncOpener() { Discard(0, -1); }
+
+   /// Start opening the file of element `treeNumber` of the chain, if not done already.
+   void Request(Int_t treeNumber, const std::string &fileName, const std::string &treeName)
+   {
+      for (const auto &pending : fPending)
+         if (pending.fTreeNumber == treeNumber)
+            return;
+
+      std::future<TFile *> file;
+      if (ROOT::IsImplicitMTEnabled()) {
+         file = std::async(std::launch::async, [fileName, treeName]() {
+            TDirectory::TContext ctxt;
+            TFile *f = TFile::Open(fileName.c_str());
+            if (f && !f->IsZombie())
+               f->Get(treeName.c_str());
+            return f;
+         });
+      } else {
+         TFileOpenHandle *handle = TFile::AsyncOpen(fileName.c_str());
+         file = std::async(std::launch::deferred, [handle]() {
+            TDirectory::TContext ctxt;
+            return handle ? TFile::Open(handle) : nullptr;
+         });
+      }
+      fPending.push_back({treeNumber, std::move(file)});
+   }
+
+   /// Retrieve the file of element `treeNumber`, waiting for its opening to complete.
+   /// Return false if the file was not requested.
+   Bool_t Take(Int_t treeNumber, TFile *&file)
+   {
+      for (auto it = fPending.begin(); it != fPending.end(); ++it) {
+         if (it->fTreeNumber == treeNumber) {
+            file = it->fFile.get();
+            fPending.erase(it);
+            return kTRUE;
+         }
+      }
+      return kFALSE;
+   }
+
+   /// Close the files requested for the elements outside of [first, last].
+   void Discard(Int_t first, Int_t last)
+   {
+      for (auto it = fPending.begin(); it != fPending.end();) {
+         if (it->fTreeNumber < first || it->fTreeNumber > last) {
+            delete it->fFile.get();
+            it = fPending.erase(it);
+         } else {
+            ++it;
+         }
+      }
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
 
@@ -190,6 +280,8 @@ TChain::~TChain()
    }
 
    SafeDelete(fProofChain);
+   delete fAsyncOpener;
+   fAsyncOpener = nullptr;
    fStatus->Delete();
    delete fStatus;
    fStatus = 0;
@@ -955,11 +1047,62 @@ Long64_t TChain::GetEntries() const
       return fProofChain->GetEntries();
    }
    if (fEntries == TTree::kMaxEntries) {
-      const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled())
+         const_cast<TChain*>(this)->FillTreeOffsetsParallel();
+#endif
+      if (fEntries == TTree::kMaxEntries)
+         const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the number of entries of the trees whose number of entries is not
+/// known yet concurrently, and fill the offset table as far as possible.
+///
+/// The files are opened and closed by the tasks, leaving the current tree of the
+/// chain untouched. The trees that cannot be read are left to LoadTree, which
+/// reports the errors.
+
+void TChain::FillTreeOffsetsParallel()
+{
+#ifdef R__USE_IMT
+   std::vector<Int_t> unknown;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      auto element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+      if (element->GetEntries() == TTree::kMaxEntries)
+         unknown.push_back(i);
+   }
+   if (unknown.size() < 2)
+      return;
+
+   auto readEntries = [this](Int_t i) {
+      auto element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(element->GetTitle()));
+      if (!file || file->IsZombie())
+         return TTree::kMaxEntries;
+      auto tree = file->Get<TTree>(element->GetName());
+      return tree ? tree->GetEntries() : TTree::kMaxEntries;
+   };
+   ROOT::TThreadExecutor pool;
+   const auto entries = pool.Map(readEntries, unknown);
+   for (std::size_t k = 0; k < unknown.size(); ++k) {
+      if (entries[k] != TTree::kMaxEntries)
+         static_cast<TChainElement *>(fFiles->UncheckedAt(unknown[k]))->SetNumberEntries(entries[k]);
+   }
+
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      const auto nentries = static_cast<TChainElement *>(fFiles->UncheckedAt(i))->GetEntries();
+      if (nentries == TTree::kMaxEntries)
+         return;
+      fTreeOffset[i + 1] = fTreeOffset[i] + nentries;
+   }
+   fEntries = fTreeOffset[fNtrees];
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get entry from the file to memory.
 ///
@@ -1486,10 +1629,23 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      if (!fAsyncOpener || !fAsyncOpener->Take(treenum, fFile))
+         fFile = TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
    }
 
+   // Start opening the next files while this one is processed
+   if (fAsyncOpenDepth > 0) {
+      if (!fAsyncOpener)
+         fAsyncOpener = new ROOT::Internal::TChainAsyncOpener();
+      const Int_t last = std::min(treenum + fAsyncOpenDepth, fNtrees - 1);
+      fAsyncOpener->Discard(treenum + 1, last);
+      for (Int_t i = treenum + 1; i <= last; ++i) {
+         auto next = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+         fAsyncOpener->Request(i, next->GetTitle(), next->GetName());
+      }
+   }
+
    // ----- Begin of modifications by MvL
    Int_t returnCode = 0;
    if (!fFile || fFile->IsZombie()) {
@@ -2301,6 +2457,8 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+   delete fAsyncOpener;
+   fAsyncOpener = nullptr;
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
@@ -2323,6 +2481,8 @@ void TChain::Reset(Option_t*)
 
 void TChain::ResetAfterMerge(TFileMergeInfo *info)
 {
+   delete fAsyncOpener;
+   fAsyncOpener = nullptr;
    fNtrees         = 0;
    fTreeNumber     = -1;
    fTree           = 0;
@@ -2415,6 +2575,32 @@ Long64_t TChain::Scan(const char* varexp, const char* selection, Option_t* optio
    return TTree::Scan(varexp, selection, option, nentries, firstentry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the files of the next `nfiles` trees of the chain in the background
+/// while the current one is processed.
+///
+/// Opening a remote file can take long, and TChain::LoadTree otherwise opens the
+/// files one at a time when their first entry is requested. If implicit
+/// multi-threading is enabled (see ROOT::EnableImplicitMT()), each file is
+/// opened in a background thread, which also reads the keys of the file and the
+/// header of the tree. Otherwise the files are opened with TFile::AsyncOpen,
+/// which is asynchronous only for the protocols that support it, e.g. xrootd.
+/// Files that were opened ahead but are not needed anymore because the chain
+/// moved to another tree are closed. A value of 0 (the default) disables the
+/// asynchronous opening.
+///
+/// Note that with implicit multi-threading, GetEntries() also reads the number
+/// of entries of the trees concurrently.
+
+void TChain::SetAsyncOpen(Int_t nfiles)
+{
+   fAsyncOpenDepth = nfiles > 0 ? nfiles : 0;
+   if (!fAsyncOpenDepth) {
+      delete fAsyncOpener;
+      fAsyncOpener = nullptr;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the global branch kAutoDelete bit.
 ///
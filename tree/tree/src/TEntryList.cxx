@@ -55,6 +55,12 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - keeps only the entries of the first list that are also in the second
+                list, for the same TTree. If the lists are for TChains, loops over all
+                sub-lists
+
+Add(), Subtract() and Intersect() combine the lists block by block, working on the
+words of the bits representation or on the sorted lists of entries of the blocks.
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -1226,6 +1232,60 @@ void TEntryList::SetTree(const TTree *tree)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries of this entry list that are also contained in elist.
+/// The entries of the trees for which elist has no entries are removed. The
+/// sub-entries of a TEntryListArray are not taken into account.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (fLists){
+      //this list has sublists
+      TIter next(fLists);
+      TEntryList *templist = 0;
+      while ((templist = (TEntryList*)next())){
+         Long64_t oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+      return;
+   }
+   if (!fBlocks) return;
+
+   const TEntryList *other = 0;
+   if (!elist->fLists){
+      if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+          !strcmp(elist->fFileName.Data(),fFileName.Data()))
+         other = elist;
+   } else {
+      //second list has sublists, try to find one for the same tree as this list
+      TIter next(elist->GetLists());
+      TEntryList *templist = 0;
+      while ((templist = (TEntryList*)next())){
+         if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(templist->fFileName.Data(),fFileName.Data())){
+            other = templist;
+            break;
+         }
+      }
+   }
+
+   for (Int_t i=0; i<fNBlocks; i++){
+      TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+      Long64_t nold = block1->GetNPassed();
+      if (other && other->fBlocks && i < other->fNBlocks){
+         TEntryListBlock *block2 = (TEntryListBlock*)other->fBlocks->UncheckedAt(i);
+         fN = fN - nold + block1->Intersect(block2);
+      } else {
+         //no entries of elist in this block
+         *block1 = TEntryListBlock();
+         fN -= nold;
+      }
+   }
+   fLastIndexQueried = -1;
+   fLastIndexReturned = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove all the entries of this entry list, that are contained in elist
 
@@ -1240,12 +1300,16 @@ void TEntryList::Subtract(const TEntryList *elist)
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
             //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -38,6 +38,11 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Intersect__() - keeps only the entries that are also in the other block
+ - __Subtract__()  - removes the entries that are in the other block
+
+The operations combining two blocks work on the 16-bit words of the bits
+representation, the lists of entries that pass being merged directly.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,6 +51,9 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <bitset>
+
 ClassImp(TEntryListBlock);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -207,33 +215,20 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       return result;
    }
    //list
-   if (entry < fCurrent) fCurrent = 0;
-   if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
-   } else {
-      if (!fIndices || fNPassed==0){
-         //all entries pass
-         return kTRUE;
-      }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+   if (!fPassing && (!fIndices || fNPassed==0)){
+      //all entries pass
+      return kTRUE;
    }
-   return 0;
+   //the list is sorted: look first at the position of the previous query, which is the next one when the entries
+   //are queried in order, then search it
+   Int_t i = fCurrent;
+   if (i >= fNPassed || fIndices[i] > entry || (i+1 < fNPassed && fIndices[i+1] <= entry))
+      i = std::lower_bound(fIndices, fIndices + fNPassed, entry) - fIndices;
+   else if (fIndices[i] < entry)
+      i++;
+   fCurrent = i < fNPassed ? i : 0;
+   const Bool_t listed = i < fNPassed && fIndices[i] == entry;
+   return fPassing ? listed : !listed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,7 +237,7 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
@@ -260,33 +255,18 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    }
    if (fType==0){
       //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
+      if (block->fType == 1 && block->fPassing){
+         //the other block stores entries that pass
+         for (i=0; i<block->fNPassed; i++){
+            Enter(block->fIndices[i]);
          }
       } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
+         UShort_t bits[kBlockSize];
+         block->GetBits(bits);
+         fNPassed = 0;
+         for (i=0; i<kBlockSize; i++){
+            fIndices[i] |= bits[i];
+            fNPassed += std::bitset<16>(fIndices[i]).count();
          }
       }
    } else {
@@ -363,6 +343,108 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries that are also in the other block.
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   if (fType==1 && fPassing && block->fType==1 && block->fPassing){
+      //both blocks store the entries that pass, intersect the sorted lists
+      UShort_t *newlist = new UShort_t[std::min(fNPassed, block->fNPassed)];
+      UShort_t *last = std::set_intersection(fIndices, fIndices + fNPassed, block->fIndices,
+                                             block->fIndices + block->fNPassed, newlist);
+      delete [] fIndices;
+      fIndices = newlist;
+      fNPassed = last - newlist;
+      fN = fNPassed;
+   } else {
+      UShort_t *bits = new UShort_t[kBlockSize];
+      UShort_t *other = new UShort_t[kBlockSize];
+      GetBits(bits);
+      block->GetBits(other);
+      for (Int_t i=0; i<kBlockSize; i++)
+         bits[i] &= other[i];
+      delete [] other;
+      AdoptBits(bits);
+   }
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries that are in the other block.
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   if (fType==1 && fPassing && block->fType==1 && block->fPassing){
+      //both blocks store the entries that pass, subtract the sorted lists
+      UShort_t *newlist = new UShort_t[fNPassed];
+      UShort_t *last = std::set_difference(fIndices, fIndices + fNPassed, block->fIndices,
+                                           block->fIndices + block->fNPassed, newlist);
+      delete [] fIndices;
+      fIndices = newlist;
+      fNPassed = last - newlist;
+      fN = fNPassed;
+   } else {
+      UShort_t *bits = new UShort_t[kBlockSize];
+      UShort_t *other = new UShort_t[kBlockSize];
+      GetBits(bits);
+      block->GetBits(other);
+      for (Int_t i=0; i<kBlockSize; i++)
+         bits[i] &= ~other[i];
+      delete [] other;
+      AdoptBits(bits);
+   }
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the kBlockSize words of `bits` with the bits representation of the
+/// entries of this block, whatever the current representation.
+
+void TEntryListBlock::GetBits(UShort_t *bits) const
+{
+   if (!fIndices || fNPassed == 0) {
+      //no entries stored: either none or all pass
+      std::fill(bits, bits + kBlockSize, fPassing ? 0 : 0xFFFF);
+      return;
+   }
+   if (fType==0){
+      std::copy(fIndices, fIndices + kBlockSize, bits);
+      return;
+   }
+   std::fill(bits, bits + kBlockSize, fPassing ? 0 : 0xFFFF);
+   for (Int_t i=0; i<fNPassed; i++)
+      bits[fIndices[i]>>4] ^= 1<<(fIndices[i] & 15);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Use `bits`, an array of kBlockSize words allocated with new[], as the bits
+/// representation of the block and choose the most economical representation.
+
+void TEntryListBlock::AdoptBits(UShort_t *bits)
+{
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = bits;
+   fType = 0;
+   fN = kBlockSize;
+   fPassing = 1;
+   fNPassed = 0;
+   for (Int_t i=0; i<kBlockSize; i++)
+      fNPassed += std::bitset<16>(bits[i]).count();
+   OptimizeStorage();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -218,6 +218,23 @@ Int_t *TLeaf::GenerateOffsetArrayBase(Int_t base, Int_t events) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Describe how the entries of this leaf are laid out in a basket, for the bulk reads
+/// that return an offsets array (see TBranch::GetBulkRead()).
+///
+/// Each entry is stored as `header` bytes followed by the values of the entry, each
+/// `valueSize` bytes long. Returns false if the values of this leaf cannot be
+/// deserialized in place, in which case header and valueSize are left untouched.
+
+Bool_t TLeaf::GetBulkEntryLayout(Int_t &header, Int_t &valueSize) const
+{
+   if (GetDeserializeType() == DeserializeType::kExternal || GetLenType() <= 0)
+      return kFALSE;
+   header = GetOffsetHeaderSize();
+   valueSize = GetLenType();
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the full name (including the parent's branch names) of the leaf.
 
@@ -135,6 +135,14 @@ bool TLeafD::ReadBasketFast(TBuffer &input_buf, Long64_t N) {
    return input_buf.ByteSwapBuffer(fLen*N, kDouble_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place N contiguous values from an input buffer.
+
+bool TLeafD::ReadBasketFastArray(TBuffer &input_buf, Long64_t N)
+{
+   return input_buf.ByteSwapBuffer(N, kDouble_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
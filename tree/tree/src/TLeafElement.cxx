@@ -18,6 +18,7 @@ a TStreamerInfo (i.e. using TBranchElement).
 
 #include "TLeafElement.h"
 
+#include "TVirtualCollectionProxy.h"
 #include "TVirtualStreamerInfo.h"
 #include "Bytes.h"
 #include "TBuffer.h"
@@ -149,6 +150,78 @@ Bool_t TLeafElement::ReadBasketFast(TBuffer &input_buf, Long64_t N)
    return input_buf.ByteSwapBuffer(fLen*N, type);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// If this leaf stores a std::vector of fundamental values that can be deserialized
+/// in place, return the EDataType of the values; return kOther_t otherwise.
+///
+/// Only top-level branches and data members of split objects qualify: the elements
+/// of split collections (TClonesArray or STL) are stored differently.
+
+EDataType TLeafElement::GetCollectionValueType() const
+{
+   EDataType cached = fCollectionTypeCache.load(std::memory_order_relaxed);
+   if (R__likely(cached != EDataType::kNoType_t))
+      return cached;
+
+   EDataType result = EDataType::kOther_t;
+   TClass *clptr = nullptr;
+   EDataType type = EDataType::kOther_t;
+   if (static_cast<TBranchElement *>(fBranch)->GetType() == 0 && !fBranch->GetExpectedType(clptr, type) && clptr) {
+      TVirtualCollectionProxy *proxy = clptr->GetCollectionProxy();
+      if (proxy && proxy->GetCollectionType() == ROOT::kSTLvector && !proxy->GetValueClass()) {
+         switch (proxy->GetType()) {
+         case kChar_t: // fall-through
+         case kUChar_t: // fall-through
+         case kShort_t: // fall-through
+         case kUShort_t: // fall-through
+         case kInt_t: // fall-through
+         case kUInt_t: // fall-through
+         case kFloat_t: // fall-through
+         case kLong64_t: // fall-through
+         case kULong64_t: // fall-through
+         case kDouble_t:
+            result = proxy->GetType();
+            break;
+         default:
+            break;
+         }
+      }
+   }
+   fCollectionTypeCache.store(result, std::memory_order_relaxed);
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Describe how the entries of this leaf are laid out in a basket, see TLeaf::GetBulkEntryLayout.
+///
+/// A std::vector of fundamental values is stored, for each entry, as its byte count
+/// (4 bytes), its class version (2 bytes) and its size (4 bytes), followed by the values.
+
+Bool_t TLeafElement::GetBulkEntryLayout(Int_t &header, Int_t &valueSize) const
+{
+   EDataType type = GetCollectionValueType();
+   if (type != EDataType::kOther_t) {
+      header = sizeof(UInt_t) + sizeof(Version_t) + sizeof(Int_t);
+      valueSize = TDataType::GetDataType(type)->Size();
+      return kTRUE;
+   }
+   return TLeaf::GetBulkEntryLayout(header, valueSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place N contiguous values from an input buffer.
+
+bool TLeafElement::ReadBasketFastArray(TBuffer &input_buf, Long64_t N)
+{
+   EDataType type = GetCollectionValueType();
+   if (type == EDataType::kOther_t) {
+      if (GetDeserializeType() == DeserializeType::kExternal)
+         return false;
+      type = fDataTypeCache.load(std::memory_order_consume);
+   }
+   return input_buf.ByteSwapBuffer(N, type);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns pointer to method corresponding to name name is a string
 /// with the general form "method(list of params)" If list of params is
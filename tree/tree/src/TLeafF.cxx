@@ -139,6 +139,14 @@ bool TLeafF::ReadBasketFast(TBuffer &input_buf, Long64_t N) {
   return input_buf.ByteSwapBuffer(fLen*N, kFloat_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place N contiguous values from an input buffer.
+
+bool TLeafF::ReadBasketFastArray(TBuffer &input_buf, Long64_t N)
+{
+   return input_buf.ByteSwapBuffer(N, kFloat_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -190,6 +190,14 @@ bool TLeafI::ReadBasketFast(TBuffer& input_buf, Long64_t N)
    return input_buf.ByteSwapBuffer(fLen*N, kInt_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place N contiguous values from an input buffer.
+
+bool TLeafI::ReadBasketFastArray(TBuffer &input_buf, Long64_t N)
+{
+   return input_buf.ByteSwapBuffer(N, kInt_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
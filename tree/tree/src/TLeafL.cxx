@@ -201,6 +201,14 @@ bool TLeafL::ReadBasketFast(TBuffer& input_buf, Long64_t N)
    return input_buf.ByteSwapBuffer(fLen*N, kLong64_t);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place N contiguous values from an input buffer.
+
+bool TLeafL::ReadBasketFastArray(TBuffer &input_buf, Long64_t N)
+{
+   return input_buf.ByteSwapBuffer(N, kLong64_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -71,6 +71,22 @@ the pointer to the current Tree to call `GetEntry(entry)`.
 entry is always the local entry number in the current tree.
 Assuming that fChain is the pointer to the TChain being processed,
 use `fChain->GetTree()->GetEntry(entry);`
+
+__Implicit multi-threading:__
+
+a selector returning kTRUE from IsThreadSafe() is processed by
+TTree::Process in parallel tasks over the clusters of the tree when
+implicit multi-threading is enabled (ROOT::EnableImplicitMT()), as it
+would be by PROOF. The class must have a dictionary (ClassDef and
+compiled, e.g. with ACLiC) and Version() must be at least 2. Begin()
+and Terminate() are called on the selector given to TTree::Process,
+while workers, created with its TClass and sharing its input list, are
+processed like PROOF workers: SlaveBegin(), then Init() and Notify()
+for each part of the tree given to them, Process() and at last
+SlaveTerminate(). The objects of the output lists of the workers are
+merged by name into the output list of the selector before Terminate().
+The workers must not share state outside of their data members and must
+not rely on the order of the entries.
 */
 
 #include "TROOT.h"
@@ -169,7 +185,7 @@ TSelector *TSelector::GetSelector(const char *filename)
    // but does not have a dictionary, so we just raise a flag for better
    // diagnostic in the case the class is not found in the CINT ClassInfo table.
    Bool_t autoloaderr = kFALSE;
-   if (!fromFile && gCling->AutoLoad(localname) != 1)
+   if (!fromFile && gInterpreter->AutoLoad(localname) != 1)
       autoloaderr = kTRUE;
 
    TClass *selCl = TClass::GetClass(localname);
@@ -367,6 +367,7 @@ End_Macro
 
 #include "ROOT/TIOFeatures.hxx"
 #include "TArrayC.h"
+#include "TBase64.h"
 #include "TBufferFile.h"
 #include "TBaseClass.h"
 #include "TBasket.h"
@@ -424,6 +425,7 @@ End_Macro
 #include "TFileMergeInfo.h"
 #include "ROOT/StringConv.hxx"
 #include "TVirtualMutex.h"
+#include "RZip.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
@@ -443,6 +445,7 @@ End_Macro
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
+#include <mutex>
 #include <thread>
 #endif
 
@@ -1037,44 +1040,89 @@ TBuffer* TTree::GetTransientBuffer(Int_t size)
    return fTransientBuffer;
 }
 
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(fe, t) for the friends t of a tree which are read at the same
+/// entry numbers as the tree, i.e. the already loaded friends without index.
+/// Their caches can then be given the same branches and entry range as the
+/// cache of the tree, instead of prefetching entries that are never read.
+
+template <typename F>
+void ForEachEntryAlignedFriend(TList *friends, F &&func)
+{
+   if (!friends)
+      return;
+   TIter nextf(friends);
+   TFriendElement *fe;
+   while ((fe = (TFriendElement *)nextf())) {
+      TTree *t = fe->GetTree();
+      if (t && t->GetTree() && !t->GetTreeIndex())
+         func(fe, t);
+   }
+}
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add branch with name bname to the Tree cache.
 /// If bname="*" all branches are added to the cache.
 /// if subbranches is true all the branches of the subbranches are
 /// also put to the cache.
 ///
+/// Branches of the friend trees read at the same entry numbers, i.e. without
+/// index, are added to the cache of their own tree.
+///
 /// Returns:
 /// - 0 branch added or already included
 /// - -1 on error
 
 Int_t TTree::AddBranchToCache(const char*bname, Bool_t subbranches)
 {
+   // We already have been visited while recursively looking
+   // through the friends tree, let return
+   if (kAddBranchToCache & fFriendLockStatus) {
+      return 0;
+   }
+
    if (!GetTree()) {
       if (LoadTree(0)<0) {
          Error("AddBranchToCache","Could not load a tree");
          return -1;
       }
    }
+
+   Int_t res = 0;
    if (GetTree()) {
       if (GetTree() != this) {
-         return GetTree()->AddBranchToCache(bname, subbranches);
+         res = GetTree()->AddBranchToCache(bname, subbranches);
+      } else {
+         TFile *f = GetCurrentFile();
+         if (!f) {
+            Error("AddBranchToCache", "No file is available. Branch was not added to the cache");
+            return -1;
+         }
+         TTreeCache *tc = GetReadCache(f,kTRUE);
+         if (!tc) {
+            Error("AddBranchToCache", "No cache is available, branch not added");
+            return -1;
+         }
+         res = tc->AddBranch(bname,subbranches);
       }
    } else {
       Error("AddBranchToCache", "No tree is available. Branch was not added to the cache");
       return -1;
    }
 
-   TFile *f = GetCurrentFile();
-   if (!f) {
-      Error("AddBranchToCache", "No file is available. Branch was not added to the cache");
-      return -1;
-   }
-   TTreeCache *tc = GetReadCache(f,kTRUE);
-   if (!tc) {
-      Error("AddBranchToCache", "No cache is available, branch not added");
-      return -1;
-   }
-   return tc->AddBranch(bname,subbranches);
+   TFriendLock lock(this, kAddBranchToCache);
+   ForEachEntryAlignedFriend(fFriends, [&](TFriendElement *fe, TTree *t) {
+      // If the alias is present remove it from the name.
+      const char *name = bname;
+      const auto aliasLen = strlen(fe->GetName());
+      if (strncmp(bname, fe->GetName(), aliasLen) == 0 && bname[aliasLen] == '.')
+         name = bname + aliasLen + 1;
+      if (strcmp(name, "*") == 0 || t->GetBranch(name))
+         t->AddBranchToCache(name, subbranches);
+   });
+   return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3769,7 +3817,8 @@ void TTree::Delete(Option_t* option /* = "" */)
    }
 
    // Delete object from CINT symbol table so it can not be used anymore.
-   gCling->DeleteGlobal(this);
+   if (gCling)
+      gCling->DeleteGlobal(this);
 
    // Warning: We have intentional invalidated this object while inside a member function!
    delete this;
@@ -4560,6 +4609,10 @@ void TTree::DropBuffers(Int_t)
 /// \note This method calls `TTree::ChangeFile` when the tree reaches a size
 ///       greater than `TTree::fgMaxTreeSize`. This doesn't happen if the tree is
 ///       attached to a `TMemFile` or derivate.
+///
+/// \note If implicit multi-threading is enabled and SetParallelFill() was
+///       called, the top-level branches are serialized concurrently, see
+///       SetParallelFill().
 
 Int_t TTree::Fill()
 {
@@ -4586,6 +4639,58 @@ Int_t TTree::Fill()
    }
 #endif
 
+   auto reportFillError = [&](TBranch *branch, Int_t nwrite) {
+      if (nerror < 2) {
+         Error("Fill", "Failed filling branch:%s.%s, nbytes=%d, entry=%lld\n"
+                       " This error is symptomatic of a Tree created as a memory-resident Tree\n"
+                       " Instead of doing:\n"
+                       "    TTree *T = new TTree(...)\n"
+                       "    TFile *f = new TFile(...)\n"
+                       " you should do:\n"
+                       "    TFile *f = new TFile(...)\n"
+                       "    TTree *T = new TTree(...)\n\n",
+               GetName(), branch->GetName(), nwrite, fEntries + 1);
+      } else {
+         Error("Fill", "Failed filling branch:%s.%s, nbytes=%d, entry=%lld", GetName(), branch->GetName(), nwrite,
+               fEntries + 1);
+      }
+      ++nerror;
+   };
+
+#ifdef R__USE_IMT
+   if (useIMT && fIMTParallelFill && nbranches > 1 && !fBranchRef) {
+      // Serialize the top-level branches concurrently. Each task fills whole branches and compresses and writes the
+      // baskets that become full synchronously, so the basket flush is parallel too: the file access is serialized
+      // in TBasket::WriteBuffer and the byte counters of the tree are atomic during an IMT flush.
+      ROOT::Internal::TParBranchProcessingRAII pbpRAII;
+
+      std::atomic<Int_t> pos(0);
+      std::atomic<Int_t> nbpar(0);
+      std::mutex errorMutex;
+
+      auto mapFunction = [&]() {
+         // A few tasks pick the branches one at a time, which balances the load between branches of very different
+         // sizes without paying the cost of one task per branch on trees with thousands of small branches.
+         for (Int_t i = pos.fetch_add(1); i < nbranches; i = pos.fetch_add(1)) {
+            TBranch *branch = (TBranch *)fBranches.UncheckedAt(i);
+            if (branch->TestBit(kDoNotProcess))
+               continue;
+            const Int_t nbtask = branch->FillImpl(nullptr);
+            if (nbtask < 0) {
+               std::lock_guard<std::mutex> lock(errorMutex);
+               reportFillError(branch, nbtask);
+            } else {
+               nbpar += nbtask;
+            }
+         }
+      };
+
+      ROOT::TThreadExecutor pool;
+      const auto ntasks = std::min<UInt_t>(nbranches, pool.GetPoolSize());
+      pool.Foreach(mapFunction, ntasks);
+      nbytes += nbpar;
+   } else {
+#endif
    for (Int_t i = 0; i < nbranches; ++i) {
       // Loop over all branches, filling and accumulating bytes written and error counts.
       TBranch *branch = (TBranch *)fBranches.UncheckedAt(i);
@@ -4599,25 +4704,14 @@ Int_t TTree::Fill()
       nwrite = branch->FillImpl(useIMT ? &imtHelper : nullptr);
 #endif
       if (nwrite < 0) {
-         if (nerror < 2) {
-            Error("Fill", "Failed filling branch:%s.%s, nbytes=%d, entry=%lld\n"
-                          " This error is symptomatic of a Tree created as a memory-resident Tree\n"
-                          " Instead of doing:\n"
-                          "    TTree *T = new TTree(...)\n"
-                          "    TFile *f = new TFile(...)\n"
-                          " you should do:\n"
-                          "    TFile *f = new TFile(...)\n"
-                          "    TTree *T = new TTree(...)\n\n",
-                  GetName(), branch->GetName(), nwrite, fEntries + 1);
-         } else {
-            Error("Fill", "Failed filling branch:%s.%s, nbytes=%d, entry=%lld", GetName(), branch->GetName(), nwrite,
-                  fEntries + 1);
-         }
-         ++nerror;
+         reportFillError(branch, nwrite);
       } else {
          nbytes += nwrite;
       }
    }
+#ifdef R__USE_IMT
+   }
+#endif
 
 #ifdef R__USE_IMT
    if (fIMTFlush) {
@@ -4670,11 +4764,20 @@ Int_t TTree::Fill()
             // they will automatically grow to the size needed for an event cluster (with the basket
             // shrinking preventing them from growing too much larger than the actually-used space).
             if (!TestBit(TTree::kOnlyFlushAtCluster)) {
-               OptimizeBaskets(GetTotBytes(), 1, "");
+               Long64_t maxMemory = GetTotBytes();
+               if (fBasketMemoryBudget > 0 && fBasketMemoryBudget < maxMemory)
+                  maxMemory = fBasketMemoryBudget;
+               OptimizeBaskets(maxMemory, 1, "");
                if (gDebug > 0)
                   Info("TTree::Fill", "OptimizeBaskets called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n",
                        fEntries, GetZipBytes(), fFlushedBytes);
+               // With a size-based first cluster, the sizes are adapted later on if the content of the entries changes
+               fClusterBasketBytes.clear();
+               fOptimizedBasketShares.clear();
+               if (fAdaptiveBaskets && fAutoFlush < 0)
+                  RebalanceBaskets();
             }
+            TrainCompressionDictionaries();
             fFlushedBytes = GetZipBytes();
             fAutoFlush = fEntries; // Use test on entries rather than bytes
 
@@ -4723,6 +4826,9 @@ Int_t TTree::Fill()
       if (gDebug > 0)
          Info("TTree::Fill", "FlushBaskets() called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n", fEntries,
               GetZipBytes(), fFlushedBytes);
+      if (!fClusterBasketBytes.empty())
+         RebalanceBaskets();
+      TrainCompressionDictionaries();
       fFlushedBytes = GetZipBytes();
    }
 
@@ -6999,16 +7105,41 @@ Bool_t TTree::Notify()
 /// if option ="d" an analysis report is printed.
 
 void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *option)
+{
+   TString opt( option );
+   opt.ToLower();
+   OptimizeBasketsImpl(maxMemory, minComp, opt.Contains("d"), nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of OptimizeBaskets(). If `since` is not null, the sizes are
+/// computed from the bytes and entries written since the state it holds for the
+/// branch of each leaf (see RebalanceBaskets()) instead of all the bytes and
+/// entries written so far.
+
+void TTree::OptimizeBasketsImpl(ULong64_t maxMemory, Float_t minComp, Bool_t pDebug,
+                                const std::vector<std::pair<Long64_t,Long64_t>> *since)
 {
    //Flush existing baskets if the file is writable
    if (this->GetDirectory()->IsWritable()) this->FlushBasketsImpl();
 
-   TString opt( option );
-   opt.ToLower();
-   Bool_t pDebug = opt.Contains("d");
    TObjArray *leaves = this->GetListOfLeaves();
    Int_t nleaves = leaves->GetEntries();
+   if (since && (Int_t)since->size() != nleaves)
+      return;
+   // Bytes and entries of the branch of the i-th leaf taken into account
+   auto branchTotBytes = [since](TBranch *branch, Int_t i) {
+      return branch->GetTotBytes() - (since ? (*since)[i].first : 0);
+   };
+   auto branchEntries = [since](TBranch *branch, Int_t i) {
+      return branch->GetEntries() - (since ? (*since)[i].second : 0);
+   };
    Double_t treeSize = (Double_t)this->GetTotBytes();
+   if (since) {
+      treeSize = 0;
+      for (Int_t i = 0; i < nleaves; ++i)
+         treeSize += branchTotBytes(((TLeaf*)leaves->At(i))->GetBranch(), i);
+   }
 
    if (nleaves == 0 || treeSize == 0) {
       // We're being called too early, we really have nothing to do ...
@@ -7032,14 +7163,14 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
       for (i=0;i<nleaves;i++) {
          TLeaf *leaf = (TLeaf*)leaves->At(i);
          TBranch *branch = leaf->GetBranch();
-         Double_t totBytes = (Double_t)branch->GetTotBytes();
+         Double_t totBytes = (Double_t)branchTotBytes(branch, i);
          Double_t idealFactor = totBytes/aveSize;
          UInt_t sizeOfOneEntry;
-         if (branch->GetEntries() == 0) {
+         if (branchEntries(branch, i) <= 0) {
             // There is no data, so let's make a guess ...
             sizeOfOneEntry = aveSize;
          } else {
-            sizeOfOneEntry = 1+(UInt_t)(totBytes / (Double_t)branch->GetEntries());
+            sizeOfOneEntry = 1+(UInt_t)(totBytes / (Double_t)branchEntries(branch, i));
          }
          Int_t oldBsize = branch->GetBasketSize();
          oldMemsize += oldBsize;
@@ -7058,7 +7189,7 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
             // we must bump up the size of the branch to account for this extra footprint.
             // If fAutoFlush is not set yet, let's assume that it is 'in the process of being set' to
             // the value of GetEntries().
-            Long64_t clusterSize = (fAutoFlush > 0) ? fAutoFlush : branch->GetEntries();
+            Long64_t clusterSize = (fAutoFlush > 0) ? fAutoFlush : branchEntries(branch, i);
             if (branch->GetEntryOffsetLen()) {
                newBsize = newBsize + (clusterSize * sizeof(Int_t) * 2);
             }
@@ -7086,7 +7217,7 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
          if (pass == 0) continue;
          //Reset the compression level in case the compression factor is small
          Double_t comp = 1;
-         if (branch->GetZipBytes() > 0) comp = totBytes/Double_t(branch->GetZipBytes());
+         if (!since && branch->GetZipBytes() > 0) comp = totBytes/Double_t(branch->GetZipBytes());
          if (comp > 1 && comp < minComp) {
             if (pDebug) Info("OptimizeBaskets", "Disabling compression for branch : %s\n",branch->GetName());
             branch->SetCompressionSettings(ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
@@ -7114,6 +7245,162 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Adapt the basket sizes to the content of the cluster just flushed by Fill.
+///
+/// The sizes are optimized again, from the bytes of this cluster only, if the
+/// share of a branch in the bytes of the cluster changed by more than a factor
+/// 2 since the last optimization, or if the total size of the baskets is more
+/// than a factor 2 away from the size of the cluster (or from the memory budget,
+/// see SetBasketMemoryBudget()). The first call records the state of the
+/// branches at the end of the first cluster.
+
+void TTree::RebalanceBaskets()
+{
+   TObjArray *leaves = GetListOfLeaves();
+   const Int_t nleaves = leaves->GetEntriesFast();
+   std::vector<std::pair<Long64_t,Long64_t>> current(nleaves);
+   std::vector<Double_t> shares(nleaves);
+   Double_t clusterBytes = 0;
+   Double_t basketBytes = 0;
+   const Bool_t sameLeaves = (Int_t)fClusterBasketBytes.size() == nleaves;
+   for (Int_t i = 0; i < nleaves; ++i) {
+      TBranch *branch = ((TLeaf*)leaves->UncheckedAt(i))->GetBranch();
+      current[i] = {branch->GetTotBytes(), branch->GetEntries()};
+      shares[i] = sameLeaves ? current[i].first - fClusterBasketBytes[i].first : current[i].first;
+      clusterBytes += shares[i];
+      basketBytes += branch->GetBasketSize();
+   }
+   if (clusterBytes <= 0) {
+      fClusterBasketBytes.swap(current);
+      return;
+   }
+   for (auto &share : shares)
+      share /= clusterBytes;
+
+   if (sameLeaves && !fOptimizedBasketShares.empty()) {
+      Double_t target = clusterBytes;
+      if (fBasketMemoryBudget > 0 && fBasketMemoryBudget < target)
+         target = fBasketMemoryBudget;
+      Bool_t rebalance = basketBytes > 2 * target || 2 * basketBytes < target;
+      for (Int_t i = 0; i < nleaves && !rebalance; ++i) {
+         const Double_t before = fOptimizedBasketShares[i];
+         const Double_t now = shares[i];
+         // the branches holding less than 1% of the bytes have small baskets anyway
+         if (std::max(before, now) > 0.01 && (now > 2 * before || before > 2 * now))
+            rebalance = kTRUE;
+      }
+      if (rebalance) {
+         OptimizeBasketsImpl(target, 1, kFALSE, &fClusterBasketBytes);
+         fOptimizedBasketShares = shares;
+         if (gDebug > 0)
+            Info("TTree::Fill", "Basket sizes adapted at entry %lld to a cluster of %g bytes", fEntries, clusterBytes);
+      }
+   } else {
+      fOptimizedBasketShares = shares;
+   }
+   fClusterBasketBytes.swap(current);
+}
+
+namespace {
+// Prefix of the names of the TNamed in the user info of the tree holding the ZSTD dictionaries of the branches
+const char *const kCompressionDictPrefix = "ZstdDictionary:";
+const Int_t kCompressionDictPrefixLen = strlen(kCompressionDictPrefix);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Train the ZSTD compression dictionary of the branches that have collected
+/// enough baskets as samples, see SetCompressionDictionarySize().
+///
+/// Each dictionary is stored in the user info of the tree, as a TNamed whose
+/// name is "ZstdDictionary:" followed by the full name of the branch and whose
+/// title is the base64 encoding of the dictionary. The following baskets of
+/// the branch are compressed with the dictionary.
+
+void TTree::TrainCompressionDictionaries()
+{
+   if (fCompressionDictSize <= 0)
+      return;
+   // Fewer samples do not give a useful dictionary: the branch keeps collecting them
+   static const std::size_t kMinSamples = 8;
+   std::vector<char> dict(fCompressionDictSize);
+   TObjArray *leaves = GetListOfLeaves();
+   const Int_t nleaves = leaves->GetEntriesFast();
+   for (Int_t i = 0; i < nleaves; ++i) {
+      TBranch *branch = ((TLeaf*)leaves->UncheckedAt(i))->GetBranch();
+      if (branch->fCompressionDictDone || branch->fDictSampleSizes.size() < kMinSamples)
+         continue;
+      branch->fCompressionDictDone = kTRUE;
+      const ULong_t dictSize =
+         R__zipTrainDictionary(dict.data(), dict.size(), branch->fDictSamples.data(), branch->fDictSampleSizes.data(),
+                               branch->fDictSampleSizes.size());
+      std::vector<char>().swap(branch->fDictSamples);
+      std::vector<ULong_t>().swap(branch->fDictSampleSizes);
+      if (!dictSize)
+         continue;
+      const UInt_t dictID = R__zipLoadDictionary(dict.data(), dictSize);
+      if (!dictID)
+         continue;
+      branch->fCompressionDictID = dictID;
+      GetUserInfo()->Add(new TNamed(TString(kCompressionDictPrefix) + branch->GetFullName(),
+                                    TBase64::Encode(dict.data(), dictSize)));
+      if (gDebug > 0)
+         Info("TTree::Fill", "Compression dictionary of %lu bytes trained for the branch %s", dictSize,
+              branch->GetName());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the ZSTD compression dictionaries stored in the user info of the tree,
+/// so that the baskets compressed with them can be read, and compress the
+/// baskets written later on with the dictionary of their branch.
+
+void TTree::LoadCompressionDictionaries()
+{
+   if (!fUserInfo)
+      return;
+   TIter next(fUserInfo);
+   while (TObject *obj = next()) {
+      if (obj->IsA() != TNamed::Class() || strncmp(obj->GetName(), kCompressionDictPrefix, kCompressionDictPrefixLen))
+         continue;
+      const TString dict = TBase64::Decode(obj->GetTitle());
+      const UInt_t dictID = R__zipLoadDictionary(dict.Data(), dict.Length());
+      if (!dictID) {
+         Warning("LoadCompressionDictionaries", "The compression dictionary %s is not valid", obj->GetName());
+         continue;
+      }
+      if (TBranch *branch = GetBranch(obj->GetName() + kCompressionDictPrefixLen)) {
+         branch->fCompressionDictID = dictID;
+         branch->fCompressionDictDone = kTRUE;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the compression dictionaries of `from` to the user info of this tree,
+/// which receives baskets copied from `from` as they are on file.
+
+void TTree::CopyCompressionDictionaries(const TTree *from)
+{
+   if (!from->fUserInfo)
+      return;
+   TIter next(from->fUserInfo);
+   while (TObject *obj = next()) {
+      if (obj->IsA() != TNamed::Class() || strncmp(obj->GetName(), kCompressionDictPrefix, kCompressionDictPrefixLen))
+         continue;
+      Bool_t found = kFALSE;
+      TIter nextOwn(GetUserInfo());
+      while (TObject *own = nextOwn()) {
+         if (!strcmp(own->GetName(), obj->GetName()) && !strcmp(own->GetTitle(), obj->GetTitle())) {
+            found = kTRUE;
+            break;
+         }
+      }
+      if (!found)
+         fUserInfo->Add(new TNamed(obj->GetName(), obj->GetTitle()));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to the Principal Components Analysis class.
 ///
@@ -8104,6 +8391,8 @@ Bool_t TTree::SetAlias(const char* aliasName, const char* aliasFormula)
 /// When filling the Tree the branch buffers will be flushed to disk when
 /// more than autof bytes have been written to the file. At the first FlushBaskets
 /// TTree::Fill will replace fAutoFlush by the current value of fEntries.
+/// The basket sizes are then optimized, and adapted at the following clusters
+/// if the content of the entries changes (see SetAdaptiveBaskets()).
 ///
 /// Calling this function with autof<0 is interesting when it is hard to estimate
 /// the size of one entry. This value is also independent of the Tree.
@@ -8237,6 +8526,38 @@ void TTree::SetAutoSave(Long64_t autos)
    fAutoSave = autos;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the adaptation of the basket sizes in Fill().
+///
+/// When the first cluster is delimited by a number of bytes (see
+/// SetAutoFlush() with a negative value, the default), Fill() optimizes the
+/// basket sizes at the end of the first cluster (see OptimizeBaskets()). With
+/// this option, which is enabled by default, Fill() also checks at the end of
+/// each following cluster whether the relative sizes of the branches or the
+/// size of the clusters changed significantly and then optimizes the basket
+/// sizes again, from the content of the last cluster. The total size of the
+/// baskets is kept close to the size of a cluster, or to the memory budget if
+/// lower (see SetBasketMemoryBudget()).
+
+void TTree::SetAdaptiveBaskets(Bool_t enabled)
+{
+   fAdaptiveBaskets = enabled;
+   if (!enabled) {
+      fClusterBasketBytes.clear();
+      fOptimizedBasketShares.clear();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum total size, in bytes, of the baskets whose sizes are
+/// optimized by Fill(), see SetAdaptiveBaskets(). 0, the default, lets the
+/// baskets hold a cluster.
+
+void TTree::SetBasketMemoryBudget(Long64_t maxBytes)
+{
+   fBasketMemoryBudget = maxBytes > 0 ? maxBytes : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set a branch's basket size.
 ///
@@ -8712,18 +9033,39 @@ Int_t TTree::SetCacheSizeAux(Bool_t autocache /* = kTRUE */, Long64_t cacheSize
 ////////////////////////////////////////////////////////////////////////////////
 ///interface to TTreeCache to set the cache entry range
 ///
+/// The range is also set on the caches of the friend trees read at the same
+/// entry numbers, i.e. without index, which otherwise prefetch their clusters
+/// up to the end of the tree.
+///
 /// Returns:
 /// - 0 entry range set
 /// - -1 on error
 
 Int_t TTree::SetCacheEntryRange(Long64_t first, Long64_t last)
 {
+   // We already have been visited while recursively looking
+   // through the friends tree, let return
+   if (kSetCacheEntryRange & fFriendLockStatus) {
+      return 0;
+   }
+
    if (!GetTree()) {
       if (LoadTree(0)<0) {
          Error("SetCacheEntryRange","Could not load a tree");
          return -1;
       }
    }
+
+   // The friends read at the same entry numbers do not need to prefetch
+   // entries outside of the range either.
+   {
+      TFriendLock lock(this, kSetCacheEntryRange);
+      ForEachEntryAlignedFriend(fFriends, [&](TFriendElement *, TTree *t) {
+         if (t->GetCurrentFile())
+            t->SetCacheEntryRange(first, last);
+      });
+   }
+
    if (GetTree()) {
       if (GetTree() != this) {
          return GetTree()->SetCacheEntryRange(first, last);
@@ -8806,6 +9148,31 @@ void TTree::SetCircular(Long64_t maxEntries)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the baskets of the branches with a trained ZSTD dictionary of at
+/// most `maxBytes` bytes. 0 disables the training of new dictionaries.
+///
+/// ZSTD, like the other algorithms, compresses small baskets poorly because
+/// it cannot learn much from the few bytes of a basket. The uncompressed baskets
+/// of the first cluster of each branch are kept as samples, and a dictionary is
+/// trained for each branch on them when the cluster is flushed. The dictionary
+/// is stored once in the user info of the tree and is used to compress the
+/// baskets of the following clusters: the compression ratio of branches with
+/// small baskets is typically much better, and their decompression faster.
+///
+/// Only the branches compressed with ZSTD, e.g. with the compression setting
+/// 505, use a dictionary. The dictionaries are loaded when the tree is read and
+/// copied along with the baskets by the fast cloning. Baskets compressed with a
+/// dictionary cannot be read by versions of ROOT without this feature.
+///
+/// This must be called before the first cluster is flushed, e.g. right after
+/// the creation of the tree.
+
+void TTree::SetCompressionDictionarySize(Int_t maxBytes)
+{
+   fCompressionDictSize = maxBytes > 0 ? maxBytes : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the debug level and the debug range.
 ///
@@ -9147,6 +9514,23 @@ void TTree::SetObject(const char* name, const char* title)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the parallel serialization of the branches in Fill().
+///
+/// When implicit multi-threading is enabled (see ROOT::EnableImplicitMT() and
+/// SetImplicitMT()), by default TTree::Fill serializes the branches
+/// sequentially and only compresses the full baskets in parallel. With this
+/// option the top-level branches are also streamed into their baskets
+/// concurrently, which pays off for trees with many branches or with branches
+/// holding complex objects. The top-level branches must not share data, e.g.
+/// through references resolved by a TBranchRef: in that case, or if IMT is
+/// disabled, Fill() falls back to the sequential serialization.
+
+void TTree::SetParallelFill(Bool_t enabled)
+{
+   fIMTParallelFill = enabled;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable or disable parallel unzipping of Tree buffers.
 
@@ -9329,18 +9713,41 @@ void TTree::StartViewer()
 ////////////////////////////////////////////////////////////////////////////////
 /// Stop the cache learning phase
 ///
+/// The learning phase of the caches of the friend trees read at the same entry
+/// numbers, i.e. without index, is stopped as well if they have branches.
+///
 /// Returns:
 /// - 0 learning phase stopped or not active
 /// - -1 on error
 
 Int_t TTree::StopCacheLearningPhase()
 {
+   // We already have been visited while recursively looking
+   // through the friends tree, let return
+   if (kStopCacheLearningPhase & fFriendLockStatus) {
+      return 0;
+   }
+
    if (!GetTree()) {
       if (LoadTree(0)<0) {
          Error("StopCacheLearningPhase","Could not load a tree");
          return -1;
       }
    }
+
+   // The caches of the friends read at the same entry numbers got their
+   // branches from AddBranchToCache: stop their learning phase too, unless
+   // they have no branch yet and still need to learn them.
+   {
+      TFriendLock lock(this, kStopCacheLearningPhase);
+      ForEachEntryAlignedFriend(fFriends, [&](TFriendElement *, TTree *t) {
+         TFile *file = t->GetCurrentFile();
+         TTreeCache *tc = file ? t->GetTree()->GetReadCache(file) : nullptr;
+         if (tc && tc->GetCachedBranches()->GetEntriesFast() > 0)
+            t->StopCacheLearningPhase();
+      });
+   }
+
    if (GetTree()) {
       if (GetTree() != this) {
          return GetTree()->StopCacheLearningPhase();
@@ -9430,6 +9837,7 @@ void TTree::Streamer(TBuffer& b)
          if (fTreeIndex) {
             fTreeIndex->SetTree(this);
          }
+         LoadCompressionDictionaries();
          if (fIndex.fN) {
             Warning("Streamer", "Old style index in this tree is deleted. Rebuild the index via TTree::BuildIndex");
             fIndex.Set(0);
@@ -299,6 +299,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TMath.h"
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
+#include "ROOT/RTrace.hxx"
 #include <limits.h>
 
 Int_t TTreeCache::fgLearnEntries = 100;
@@ -1111,6 +1112,7 @@ struct BasketRanges {
 
 Bool_t TTreeCache::FillBuffer()
 {
+   R__TRACE_SPAN("io", "TTreeCache::FillBuffer");
 
    if (fNbranches <= 0) return kFALSE;
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
@@ -16,6 +16,13 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+When implicit multi-threading is enabled, once the baskets of a cluster have been read
+into the cache they are unzipped ahead of their use by tasks running in the ROOT task
+arena. The baskets are unzipped in the order in which they will be read, i.e. by
+increasing first entry, and at most SetUnzipBufferSize() bytes of unzipped baskets wait
+to be consumed at any time. A basket that is requested before being unzipped is unzipped
+synchronously by the reading thread.
+
 */
 
 #include "TTreeCacheUnzip.h"
@@ -29,11 +36,12 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TMutex.h"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
@@ -234,7 +242,7 @@ void TTreeCacheUnzip::Init()
 
 TTreeCacheUnzip::~TTreeCacheUnzip()
 {
-   ResetCache();
+   ResetCache(); // also waits for the unzipping tasks
    fUnzipState.Clear(fNseekMax);
 }
 
@@ -305,9 +313,15 @@ Bool_t TTreeCacheUnzip::FillBuffer()
       }
    }
 
+   // The unzipping tasks read the list of baskets that we are about to overwrite
+   StopUnzipTasks();
+
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
 
+   // The first entry of each prefetched basket, to unzip them in the order in which they are read
+   std::vector<std::pair<Long64_t, Int_t>> basketEntries;
+
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
       TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
@@ -338,6 +352,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         basketEntries.emplace_back(entries[j], fNseek - 1);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -346,6 +361,13 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    ResetCache();
    fIsLearning = kFALSE;
 
+   // Baskets with the same first entry are kept in the order of the branches
+   std::sort(basketEntries.begin(), basketEntries.end());
+   fUnzipOrder.clear();
+   fUnzipOrder.reserve(basketEntries.size());
+   for (const auto &basketEntry : basketEntries)
+      fUnzipOrder.push_back(basketEntry.second);
+
    return kTRUE;
 }
 
@@ -500,9 +522,15 @@ Int_t TTreeCacheUnzip::GetRecordHeader(char *buf, Int_t maxbytes, Int_t &nbytes,
 
 void TTreeCacheUnzip::ResetCache()
 {
+   // The tasks must not touch the chunks while we wipe them
+   StopUnzipTasks();
+
    // Reset all the lists and wipe all the chunks
    fCycle++;
    fUnzipState.Clear(fNseekMax);
+   fUnzipNext = 0;
+   fUnzipPending = 0;
+   fUnzipThrottled = kFALSE;
 
    if(fNseekMax < fNseek){
       if (gDebug > 0)
@@ -593,6 +621,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
          delete [] ptr;
          return 1;
       }
+      fUnzipPending += loclen; // before publishing the chunk, which can then be consumed right away
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
@@ -604,52 +633,91 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Pick the next basket to be unzipped ahead and mark it as in progress.
+///
+/// The baskets are picked in the order in which they will be consumed, i.e. by
+/// increasing first entry, skipping the ones already taken care of (by a task, or
+/// by the main thread on a miss). Both the unzipping tasks and the main thread,
+/// while it waits for a basket in progress, take their work from here.
+///
+/// Returns -1 if there is no basket left, or if the unzipped baskets that have not
+/// been consumed yet already fill fUnzipBufferSize: the unzipping resumes once
+/// the main thread has consumed some of them.
+
+Int_t TTreeCacheUnzip::NextUnzipIndex()
+{
+   const Int_t nBaskets = fUnzipOrder.size();
+   while (fIsTransferred) {
+      const Long64_t pending = fUnzipPending.load();
+      if (pending > 0 && pending >= fUnzipBufferSize) {
+         fUnzipThrottled = kTRUE;
+         return -1;
+      }
+      const Int_t pos = fUnzipNext.fetch_add(1);
+      if (pos >= nBaskets)
+         return -1;
+      const Int_t index = fUnzipOrder[pos];
+      if (fUnzipState.TryUnzipping(index))
+         return index;
+   }
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cancel the unzipping tasks that did not start yet and wait for the running ones.
+
+void TTreeCacheUnzip::StopUnzipTasks()
+{
 #ifdef R__USE_IMT
+   if (fUnzipTaskGroup) {
+      fUnzipTaskGroup->Cancel();
+      fUnzipTaskGroup.reset();
+   }
+#endif
+}
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// The work of one unzipping task: unzip the next baskets (see NextUnzipIndex)
+/// until their accumulated compressed size reaches fUnzipGroupSize.
+
+void TTreeCacheUnzip::UnzipTask()
+{
+   Int_t accusz = 0;
+   while (accusz < fUnzipGroupSize) {
+      const Int_t index = NextUnzipIndex();
+      if (index < 0)
+         return;
+      accusz += fSeekLen[index];
+      if (UnzipCache(index) && gDebug > 0)
+         Info("UnzipCache", "Unzipping failed or cache is in learning state");
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// Submit to the ROOT task arena enough unzipping tasks to unzip the baskets
+/// that have not been picked yet, each unzipping about fUnzipGroupSize bytes.
+///
+/// The tasks all take their baskets from the same queue (see NextUnzipIndex), so
+/// the baskets about to be consumed are unzipped first and at most
+/// fUnzipBufferSize bytes of unzipped baskets wait to be consumed.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
-         }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
-      }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
-   };
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+
+   Long64_t remaining = 0;
+   for (Int_t pos = fUnzipNext.load(); pos < (Int_t)fUnzipOrder.size(); ++pos)
+      remaining += fSeekLen[fUnzipOrder[pos]];
+   if (remaining == 0)
+      return 0;
+   const Long64_t nTasks = (remaining + fUnzipGroupSize - 1) / fUnzipGroupSize;
 
-   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   for (Long64_t i = 0; i < nTasks; ++i)
+      fUnzipTaskGroup->Run([this] { UnzipTask(); });
 
    return 0;
 }
@@ -683,6 +751,14 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 
    if (fParallel && !fIsLearning) {
 
+#ifdef R__USE_IMT
+      // The tasks stopped on a full unzip buffer: resume them now that there is room again
+      if (fUnzipThrottled && fUnzipTaskGroup && fUnzipPending.load() < fUnzipBufferSize) {
+         fUnzipThrottled = kFALSE;
+         CreateTasks();
+      }
+#endif
+
       if(fNseekMax < fNseek){
          if (gDebug > 0)
             Info("GetUnzipBuffer", "Changing fNseekMax from:%d to:%d", fNseekMax, fNseek);
@@ -714,24 +790,16 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                   *free = kFALSE;
                }
 
+               fUnzipPending -= fUnzipState.fUnzipLen[seekidx];
                fNFound++;
                return fUnzipState.fUnzipLen[seekidx];
             }
 
-            // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
-            Int_t reqi = -1;
-
+            // If the requested basket is being unzipped by a background task, rather than
+            // waiting we unzip the next basket that will be needed.
             if (fUnzipState.IsProgress(seekidx)) {
                if (fEmpty) {
-                  for (Int_t ii = 0; ii < fNseek; ++ii) {
-                     Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
-                     }
-                  }
+                  Int_t reqi = NextUnzipIndex();
                   if (reqi < 0) {
                      fEmpty = kFALSE;
                   } else {
@@ -763,6 +831,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                *free = kFALSE;
             }
 
+            fUnzipPending -= fUnzipState.fUnzipLen[seekidx];
             fNStalls++;
             return fUnzipState.fUnzipLen[seekidx];
          } else {
@@ -791,24 +860,21 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    res = 0;
    if (!ReadBufferExt(fCompBuffer, pos, len, loc)) {
       // Cache is invalidated and we need to wait for all unzipping tasks to be finished before fill new baskets in cache.
-#ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
-         fUnzipTaskGroup->Cancel();
-         fUnzipTaskGroup.reset();
-      }
-#endif
+      StopUnzipTasks();
       {
          // Fill new baskets into cache.
          R__LOCKGUARD(fIOMutex.get());
 	      fFile->Seek(pos);
 	      res = fFile->ReadBuffer(fCompBuffer, len);
       } // end of lock scope
+   }
+
 #ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled()) {
-         CreateTasks();
-      }
-#endif
+   // The baskets of the cluster are now in memory: start unzipping them ahead of the reads
+   if (fParallel && fIsTransferred && !fIsLearning && !fUnzipTaskGroup && ROOT::IsImplicitMTEnabled()) {
+      CreateTasks();
    }
+#endif
 
    if (res) res = -1;
 
@@ -35,8 +35,12 @@ Class implementing or helping  the various TTree cloning method
 #include "TFileCacheRead.h"
 #include "TTreeCache.h"
 #include "snprintf.h"
+#include "TROOT.h"
 
 #include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -228,6 +232,7 @@ Bool_t TTreeCloner::Exec()
    ImportClusterRanges();
    CopyStreamerInfos();
    CopyProcessIds();
+   fToTree->CopyCompressionDictionaries(fFromTree);
    CloseOutWriteBaskets();
    CollectBaskets();
    SortBaskets();
@@ -719,11 +724,137 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
    return fMaxBaskets;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the j-th basket to write, which is in memory, to the output tree.
+
+void TTreeCloner::WriteMemoryBasket(UInt_t j)
+{
+   TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+   TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+   Int_t index = fBasketNum[ fBasketIndex[j] ];
+
+   TBasket *frombasket = from->GetBasket( index );
+   if (frombasket && frombasket->GetNevBuf()>0) {
+      TBasket *tobasket = (TBasket*)frombasket->Clone();
+      tobasket->SetBranch(to);
+      to->AddBasket(*tobasket, kFALSE, fToStartEntries+from->GetBasketEntry()[index]);
+      to->FlushOneBasket(to->GetWriteBasket());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the baskets from the input file to the output file as
+/// WriteBaskets does, reading the next group of baskets in the background
+/// while the current group is written.
+///
+/// This is done when implicit multi-threading is enabled and the file cache
+/// is used (its size is the size of a group): the input file is opened a
+/// second time and this handle is only used by the reading task.
+/// \return false, without having transferred any basket, if the transfer
+/// has to be done by WriteBaskets.
+
+Bool_t TTreeCloner::WriteBasketsPipelined()
+{
+   if (!ROOT::IsImplicitMTEnabled() || IsInPlace() || fCacheSize <= 0 || fMaxBaskets == 0)
+      return kFALSE;
+   TFile *fromfile = fFromTree->GetCurrentFile();
+   if (!fromfile)
+      return kFALSE;
+
+   // Group the baskets to write in windows of consecutive baskets whose bytes on file fit in the cache size
+   struct RWindow {
+      UInt_t fBegin;
+      UInt_t fEnd;
+      std::vector<Long64_t> fSeek;
+      std::vector<Int_t> fLen;
+      std::vector<char> fBuffer;
+   };
+   std::vector<RWindow> windows;
+   Long64_t windowSize = 0;
+   for (UInt_t j = 0; j < fMaxBaskets; ++j) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+      Int_t index = fBasketNum[ fBasketIndex[j] ];
+      Long64_t pos = from->GetBasketSeek(index);
+      if (windows.empty())
+         windows.push_back({0, 0, {}, {}, {}});
+      if (pos == 0)
+         continue;
+      Int_t len = from->GetBasketBytes()[index];
+      if (len <= 0 || from->GetFile(0) != fromfile)
+         return kFALSE; // the length would have to be read from the file, or the basket is in another file
+      if (windowSize + len > fCacheSize && !windows.back().fSeek.empty()) {
+         windows.back().fEnd = j;
+         windows.push_back({j, 0, {}, {}, {}});
+         windowSize = 0;
+      }
+      windows.back().fSeek.push_back(pos);
+      windows.back().fLen.push_back(len);
+      windowSize += len;
+   }
+   windows.back().fEnd = fMaxBaskets;
+   if (windows.size() < 2)
+      return kFALSE; // nothing to overlap
+
+   std::unique_ptr<TFile> reader;
+   {
+      TDirectory::TContext ctxt;
+      reader.reset(TFile::Open(fromfile->GetName(), "READ"));
+   }
+   if (!reader || reader->IsZombie())
+      return kFALSE;
+
+   auto read = [&reader](RWindow &window) {
+      Long64_t size = 0;
+      for (auto len : window.fLen)
+         size += len;
+      window.fBuffer.resize(size);
+      const Int_t nbaskets = window.fSeek.size();
+      return !reader->ReadBuffers(window.fBuffer.data(), window.fSeek.data(), window.fLen.data(), nbaskets);
+   };
+
+   TBasket *basket = new TBasket();
+   std::future<bool> next = std::async(std::launch::async, read, std::ref(windows[0]));
+   for (UInt_t w = 0; w < windows.size(); ++w) {
+      const bool isRead = next.get();
+      if (w + 1 < windows.size())
+         next = std::async(std::launch::async, read, std::ref(windows[w + 1]));
+
+      const char *buffer = windows[w].fBuffer.data();
+      for (UInt_t j = windows[w].fBegin; j < windows[w].fEnd; ++j) {
+         TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+         TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+         Int_t index = fBasketNum[ fBasketIndex[j] ];
+         Long64_t pos = from->GetBasketSeek(index);
+         if (pos == 0) {
+            WriteMemoryBasket(j);
+            continue;
+         }
+         Int_t len = from->GetBasketBytes()[index];
+         if (isRead) {
+            basket->LoadBasketBuffersFromMemory(buffer, len, fromfile);
+            buffer += len;
+         } else {
+            // the error was reported by the reader, try again through the input file
+            basket->LoadBasketBuffers(pos, len, fromfile, fFromTree);
+         }
+         basket->IncrementPidOffset(fPidOffset);
+         basket->CopyTo(fToFile);
+         to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
+      }
+      std::vector<char>().swap(windows[w].fBuffer);
+   }
+   delete basket;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Transfer the basket from the input file to the output file
 
 void TTreeCloner::WriteBaskets()
 {
+   if (WriteBasketsPipelined())
+      return;
+
    TBasket *basket = new TBasket();
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -765,13 +896,7 @@ void TTreeCloner::WriteBaskets()
          basket->CopyTo(tofile);
          to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
       } else {
-         TBasket *frombasket = from->GetBasket( index );
-         if (frombasket && frombasket->GetNevBuf()>0) {
-            TBasket *tobasket = (TBasket*)frombasket->Clone();
-            tobasket->SetBranch(to);
-            to->AddBasket(*tobasket, kFALSE, fToStartEntries+from->GetBasketEntry()[index]);
-            to->FlushOneBasket(to->GetWriteBasket());
-         }
+         WriteMemoryBasket(j);
       }
    }
    delete basket;
@@ -12,6 +12,7 @@
 #include "ROOT/TTreeReaderFast.hxx"
 #include "ROOT/TTreeReaderValueFast.hxx"
 #include "ROOT/TIOFeatures.hxx"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
@@ -235,3 +236,139 @@ TEST_F(BulkApiVariableTest, serializedRead)
    printf("Bulk Serialized API: Successful read of all events.\n");
    printf("Bulk Serialized API: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
 }
+
+TEST_F(BulkApiVariableTest, offsetsRead)
+{
+   auto hfile = TFile::Open(fFileName.c_str());
+   printf("Starting read of file %s.\n", fFileName.c_str());
+   TStopwatch sw;
+
+   printf("Using bulk APIs with offsets.\n");
+
+   auto tree = dynamic_cast<TTree*>(hfile->Get("T"));
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("f");
+   ASSERT_TRUE(branchFloat);
+   auto branchDouble = tree->GetBranch("d");
+   ASSERT_TRUE(branchDouble);
+   auto branchInt = tree->GetBranch("i");
+   ASSERT_TRUE(branchInt);
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchDouble->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchInt->GetBulkRead().SupportsBulkReadWithOffsets());
+
+   int idx_i = 0;
+   float idx_f = 0;
+   double idx_d = 2;
+   Long64_t evt_idx = 0;
+   Long64_t events = fEventCount;
+   Int_t cluster_size = std::min(fClusterSize, fEventCount);
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile intBuf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> floatOffsets, doubleOffsets, intOffsets;
+
+   sw.Start();
+   while (events) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntries(evt_idx, floatBuf, floatOffsets);
+      ASSERT_EQ(count, cluster_size);
+      count = branchDouble->GetBulkRead().GetBulkEntries(evt_idx, doubleBuf, doubleOffsets);
+      ASSERT_EQ(count, cluster_size);
+      count = branchInt->GetBulkRead().GetBulkEntries(evt_idx, intBuf, intOffsets);
+      ASSERT_EQ(count, cluster_size);
+      ASSERT_EQ(floatOffsets.size(), static_cast<size_t>(count + 1));
+      ASSERT_EQ(floatOffsets, doubleOffsets);
+      ASSERT_EQ(floatOffsets, intOffsets);
+
+      events = events > count ? (events - count) : 0;
+
+      auto float_buf = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      auto double_buf = reinterpret_cast<double*>(doubleBuf.GetCurrent());
+      auto int_buf = reinterpret_cast<int*>(intBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         ASSERT_EQ(floatOffsets[idx + 1] - floatOffsets[idx], (evt_idx + idx + 1) % 10);
+         for (Int_t entry_idx = floatOffsets[idx]; entry_idx < floatOffsets[idx + 1]; entry_idx++) {
+            ASSERT_EQ(int_buf[entry_idx], idx_i++);
+            ASSERT_EQ(float_buf[entry_idx], idx_f++);
+            ASSERT_EQ(double_buf[entry_idx], idx_d++);
+         }
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, fEventCount);
+
+   sw.Stop();
+   printf("Bulk API with offsets: Successful read of all events.\n");
+   printf("Bulk API with offsets: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
+}
+
+TEST(BulkApiVariable, stdVectorOffsetsRead)
+{
+   const auto fileName = "BulkApiTestStdVector.root";
+   const Long64_t eventCount = 100000;
+   {
+      TFile hfile(fileName, "RECREATE");
+      TTree tree("T", "A ROOT tree of vectors of primitive types.");
+      std::vector<float> vf;
+      std::vector<double> vd;
+      tree.Branch("vf", &vf);
+      tree.Branch("vd", &vd);
+      for (Long64_t ev = 0; ev < eventCount; ev++) {
+         vf.clear();
+         vd.clear();
+         for (Int_t idx = 0; idx < (ev % 7); idx++) {
+            vf.push_back(ev + idx);
+            vd.push_back(-ev - idx);
+         }
+         tree.Fill();
+      }
+      hfile.Write();
+   }
+
+   TFile hfile(fileName);
+   auto tree = hfile.Get<TTree>("T");
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("vf");
+   auto branchDouble = tree->GetBranch("vd");
+   ASSERT_TRUE(branchFloat && branchDouble);
+   // The serialized vectors cannot be read in place by the bulk APIs without offsets.
+   EXPECT_FALSE(branchFloat->GetBulkRead().SupportsBulkRead());
+   ASSERT_TRUE(branchFloat->GetBulkRead().SupportsBulkReadWithOffsets());
+   ASSERT_TRUE(branchDouble->GetBulkRead().SupportsBulkReadWithOffsets());
+
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile doubleBuf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> floatOffsets, doubleOffsets;
+   Long64_t evt_idx = 0;
+   // The two branches have different basket boundaries: read them one after the other.
+   while (evt_idx < eventCount) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntries(evt_idx, floatBuf, floatOffsets);
+      ASSERT_GT(count, 0);
+      auto float_buf = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         const auto ev = evt_idx + idx;
+         ASSERT_EQ(floatOffsets[idx + 1] - floatOffsets[idx], ev % 7);
+         for (Int_t entry_idx = floatOffsets[idx]; entry_idx < floatOffsets[idx + 1]; entry_idx++)
+            ASSERT_EQ(float_buf[entry_idx], ev + entry_idx - floatOffsets[idx]);
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, eventCount);
+
+   evt_idx = 0;
+   while (evt_idx < eventCount) {
+      auto count = branchDouble->GetBulkRead().GetBulkEntries(evt_idx, doubleBuf, doubleOffsets);
+      ASSERT_GT(count, 0);
+      auto double_buf = reinterpret_cast<double*>(doubleBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         const auto ev = evt_idx + idx;
+         ASSERT_EQ(doubleOffsets[idx + 1] - doubleOffsets[idx], ev % 7);
+         for (Int_t entry_idx = doubleOffsets[idx]; entry_idx < doubleOffsets[idx + 1]; entry_idx++)
+            ASSERT_EQ(double_buf[entry_idx], -ev - (entry_idx - doubleOffsets[idx]));
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, eventCount);
+
+   gSystem->Unlink(fileName);
+}
@@ -1,7 +1,12 @@
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
+
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -28,4 +33,215 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+void CheckParallelUnzip(Long64_t unzipBufferSize)
+{
+   ROOT::EnableImplicitMT();
+   const auto fileName = "parallelUnzipMT.root";
+   const Long64_t nEntries = 200000;
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(10000);
+      int i = 0;
+      double d = 0.;
+      float v[4];
+      t.Branch("i", &i);
+      t.Branch("d", &d);
+      t.Branch("v", v, "v[4]/F");
+      for (; i < nEntries; ++i) {
+         d = 2. * i;
+         for (int j = 0; j < 4; ++j)
+            v[j] = i + j;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   const auto oldMode = TTreeCacheUnzip::GetParallelUnzip();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(fileName);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(t, nullptr);
+      t->SetCacheSize(10000000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(t->GetReadCache(&f));
+      ASSERT_NE(cache, nullptr);
+      if (unzipBufferSize >= 0)
+         cache->SetUnzipBufferSize(unzipBufferSize);
+      int i = -1;
+      double d = -1.;
+      float v[4];
+      t->SetBranchAddress("i", &i);
+      t->SetBranchAddress("d", &d);
+      t->SetBranchAddress("v", v);
+      for (Long64_t e = 0; e < nEntries; ++e) {
+         ASSERT_GT(t->GetEntry(e), 0);
+         ASSERT_EQ(i, e);
+         ASSERT_EQ(d, 2. * e);
+         for (int j = 0; j < 4; ++j)
+            ASSERT_EQ(v[j], e + j);
+      }
+      t->ResetBranchAddresses();
+   }
+   TTreeCacheUnzip::SetParallelUnzip(oldMode);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeImplicitMT, parallelUnzip)
+{
+   CheckParallelUnzip(-1);
+}
+
+// The tasks stop and resume when the unzipped baskets fill the unzip buffer
+TEST(TTreeImplicitMT, parallelUnzipSmallBuffer)
+{
+   CheckParallelUnzip(1);
+}
+
+TEST(TTreeImplicitMT, parallelFill)
+{
+   ROOT::EnableImplicitMT();
+   const auto fileName = "parallelFillMT.root";
+   const int nBranches = 200;
+   const int nEntries = 5000;
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetParallelFill();
+      EXPECT_TRUE(t.GetParallelFill());
+      std::vector<double> values(nBranches);
+      std::vector<float> vec;
+      for (int b = 0; b < nBranches; ++b)
+         t.Branch(("b" + std::to_string(b)).c_str(), &values[b]);
+      t.Branch("vec", &vec);
+      for (int e = 0; e < nEntries; ++e) {
+         for (int b = 0; b < nBranches; ++b)
+            values[b] = e * nBranches + b;
+         vec.assign(e % 10, e);
+         ASSERT_GT(t.Fill(), 0);
+      }
+      EXPECT_EQ(t.GetEntries(), nEntries);
+      t.Write();
+   }
+   {
+      TFile f(fileName);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(t, nullptr);
+      std::vector<double> values(nBranches);
+      std::vector<float> *vec = nullptr;
+      for (int b = 0; b < nBranches; ++b)
+         t->SetBranchAddress(("b" + std::to_string(b)).c_str(), &values[b]);
+      t->SetBranchAddress("vec", &vec);
+      for (int e = 0; e < nEntries; ++e) {
+         ASSERT_GT(t->GetEntry(e), 0);
+         for (int b = 0; b < nBranches; ++b)
+            ASSERT_EQ(values[b], e * nBranches + b);
+         ASSERT_EQ(vec->size(), std::size_t(e % 10));
+         for (auto x : *vec)
+            ASSERT_EQ(x, e);
+      }
+      t->ResetBranchAddresses();
+      delete vec;
+   }
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeImplicitMT, chainAsyncOpenAndGetEntries)
+{
+   ROOT::EnableImplicitMT();
+   const auto treeName = "t";
+   const int nFiles = 8;
+   std::vector<std::string> fileNames;
+   Long64_t nTotal = 0;
+   for (int i = 0; i < nFiles; ++i) {
+      fileNames.emplace_back("chainAsyncOpenMT_" + std::to_string(i) + ".root");
+      TFile f(fileNames.back().c_str(), "RECREATE");
+      TTree t(treeName, treeName);
+      Long64_t x = 0;
+      t.Branch("x", &x);
+      // files of different lengths, one of them empty
+      for (int e = 0; e < 10 * i; ++e) {
+         x = nTotal++;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   {
+      TChain chain(treeName);
+      for (const auto &fileName : fileNames)
+         chain.Add(fileName.c_str());
+      EXPECT_EQ(chain.GetEntries(), nTotal);
+      EXPECT_EQ(chain.GetTreeNumber(), -1); // the entries were read without loading the trees
+   }
+
+   {
+      TChain chain(treeName);
+      for (const auto &fileName : fileNames)
+         chain.Add(fileName.c_str());
+      chain.SetAsyncOpen(3);
+      Long64_t x = -1;
+      chain.SetBranchAddress("x", &x);
+      for (Long64_t e = 0; chain.LoadTree(e) >= 0; ++e) {
+         ASSERT_GT(chain.GetEntry(e), 0);
+         ASSERT_EQ(x, e);
+      }
+      EXPECT_EQ(chain.GetEntries(), nTotal);
+   }
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+TEST(TTreeImplicitMT, fastCloneReadAhead)
+{
+   ROOT::EnableImplicitMT();
+   const auto inputName = "fastCloneReadAheadMT_in.root";
+   const auto outputName = "fastCloneReadAheadMT_out.root";
+   const Long64_t nEntries = 200000;
+   {
+      TFile f(inputName, "RECREATE");
+      TTree t("t", "t");
+      Long64_t x = 0;
+      double y = 0.;
+      t.Branch("x", &x, 4000);
+      t.Branch("y", &y, 4000);
+      for (Long64_t e = 0; e < nEntries; ++e) {
+         x = e;
+         y = 0.5 * e;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   {
+      TFile in(inputName);
+      auto input = in.Get<TTree>("t");
+      ASSERT_NE(input, nullptr);
+      TFile out(outputName, "RECREATE");
+      TTree *output = input->CloneTree(0);
+      // a cache much smaller than the baskets to copy: they are read in many groups, each read while the previous is
+      // written
+      EXPECT_EQ(output->CopyEntries(input, -1, "fast cachesize=65536"), nEntries);
+      output->Write();
+   }
+
+   TFile f(outputName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   ASSERT_EQ(t->GetEntries(), nEntries);
+   Long64_t x = -1;
+   double y = -1.;
+   t->SetBranchAddress("x", &x);
+   t->SetBranchAddress("y", &y);
+   for (Long64_t e = 0; e < nEntries; ++e) {
+      ASSERT_GT(t->GetEntry(e), 0);
+      ASSERT_EQ(x, e);
+      ASSERT_EQ(y, 0.5 * e);
+   }
+
+   gSystem->Unlink(inputName);
+   gSystem->Unlink(outputName);
+}
+
 #endif // R__USE_IMT
@@ -1,5 +1,7 @@
 
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
+#include "TBufferFile.h"
 #include "TBasket.h"
 #include "TBranch.h"
 #include "TEnum.h"
@@ -403,3 +405,94 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, BufferPool)
+{
+   using ROOT::Internal::TBasketBufferPool;
+   const auto oldMaxSize = TBasketBufferPool::GetMaxSize();
+   TBasketBufferPool::SetMaxSize(1024 * 1024);
+   TBasketBufferPool::Trim();
+   EXPECT_EQ(TBasketBufferPool::GetSize(), 0);
+
+   auto buffer = TBasketBufferPool::Acquire(TBuffer::kWrite, 10000);
+   ASSERT_NE(buffer, nullptr);
+   EXPECT_GE(buffer->BufferSize(), 10000);
+   buffer->WriteInt(42);
+   TBasketBufferPool::Release(buffer);
+   EXPECT_EQ(TBasketBufferPool::GetSize(), buffer->BufferSize());
+
+   // a buffer is only reused for requests of the same mode and of at least half its size
+   auto other = TBasketBufferPool::Acquire(TBuffer::kRead, 8000);
+   EXPECT_NE(other, buffer);
+   auto larger = TBasketBufferPool::Acquire(TBuffer::kWrite, 20000);
+   EXPECT_NE(larger, buffer);
+   auto smaller = TBasketBufferPool::Acquire(TBuffer::kWrite, 4000);
+   EXPECT_NE(smaller, buffer);
+   auto recycled = TBasketBufferPool::Acquire(TBuffer::kWrite, 8000);
+   EXPECT_EQ(recycled, buffer);
+   EXPECT_EQ(recycled->Length(), 0);
+   EXPECT_TRUE(recycled->IsWriting());
+   EXPECT_EQ(TBasketBufferPool::GetSize(), 0);
+   for (auto b : {other, larger, smaller, recycled})
+      TBasketBufferPool::Release(b);
+   EXPECT_GT(TBasketBufferPool::GetSize(), 0);
+
+   // buffers that do not own their memory are never pooled
+   TBasketBufferPool::Trim();
+   std::vector<char> memory(1000);
+   TBasketBufferPool::Release(new TBufferFile(TBuffer::kRead, memory.size(), memory.data(), kFALSE));
+   EXPECT_EQ(TBasketBufferPool::GetSize(), 0);
+
+   // deleted baskets give their buffers back to the pool, the baskets created afterwards take them from it
+   TMemFile *f;
+   CreateSampleFile(f);
+   VerifySampleFile(f);
+   EXPECT_GT(TBasketBufferPool::GetSize(), 0);
+   VerifySampleFile(f);
+   f->Close();
+   delete f;
+
+   TBasketBufferPool::SetMaxSize(0);
+   EXPECT_EQ(TBasketBufferPool::GetSize(), 0);
+   TBasketBufferPool::Release(TBasketBufferPool::Acquire(TBuffer::kRead, 1000));
+   EXPECT_EQ(TBasketBufferPool::GetSize(), 0);
+   TBasketBufferPool::SetMaxSize(oldMaxSize);
+}
+
+TEST(TBasket, CompressionDictionary)
+{
+   TMemFile f("tbasket_dictionary.root", "RECREATE", "", 505);
+   Long64_t dictID = 0;
+   {
+      TTree t("t", "t");
+      t.SetAutoFlush(5000);
+      t.SetCompressionDictionarySize(4096);
+      Int_t v[16];
+      auto branch = t.Branch("v", v, "v[16]/I", 2048);
+      for (Int_t i = 0; i < 20000; ++i) {
+         for (Int_t k = 0; k < 16; ++k)
+            v[k] = (i * 7 + k) % 50 + k * 1000;
+         t.Fill();
+         if (i == 4998)
+            EXPECT_EQ(branch->GetCompressionDictionaryID(), 0u);
+      }
+      // the dictionary is trained on the baskets of the first cluster
+      dictID = branch->GetCompressionDictionaryID();
+      EXPECT_NE(dictID, 0);
+      EXPECT_NE(t.GetUserInfo()->FindObject("ZstdDictionary:v"), nullptr);
+      t.Write();
+   }
+
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   ASSERT_NE(t, nullptr);
+   EXPECT_EQ(t->GetBranch("v")->GetCompressionDictionaryID(), dictID);
+   Int_t v[16];
+   t->SetBranchAddress("v", v);
+   for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+      ASSERT_GT(t->GetEntry(i), 0);
+      for (Int_t k = 0; k < 16; ++k)
+         ASSERT_EQ(v[k], (i * 7 + k) % 50 + k * 1000);
+   }
+   delete t;
+}
@@ -1,7 +1,10 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TBranch.h"
+#include "TClonesArray.h"
+#include "TParameter.h"
 #include "TRandom.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
@@ -229,4 +232,44 @@ TEST_F(TBranchTest, branchInheritsCompression)
 {
    for(int mode = 4; mode >= 0; --mode)
       ASSERT_TRUE(nocomp(mode)) << "Failed for mode: " << mode;
-}
\ No newline at end of file
+}
+// The basic data members of the objects of a split TClonesArray are read and written as whole columns
+TEST(TBranchClones, SplitBasicMembers)
+{
+   const auto filename = "TBranchClonesSplitBasicMembers.root";
+   const int nEntries = 3;
+   const int nObjects = 1000; // more than one chunk of values, not a multiple of the chunk size
+   {
+      TFile f(filename, "RECREATE");
+      TTree t("t", "t");
+      TClonesArray arr("TParameter<Long64_t>");
+      t.Branch("arr", &arr, 32000, 99);
+      for (int entry = 0; entry < nEntries; ++entry) {
+         arr.Clear();
+         for (int i = 0; i < nObjects + entry; ++i) {
+            auto par = new (arr[i]) TParameter<Long64_t>("p", (Long64_t(entry) << 40) + i);
+            par->SetUniqueID(i);
+         }
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(filename);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   TClonesArray *arr = nullptr;
+   t->SetBranchAddress("arr", &arr);
+   for (int entry = 0; entry < nEntries; ++entry) {
+      t->GetEntry(entry);
+      ASSERT_EQ(arr->GetEntriesFast(), nObjects + entry);
+      for (int i = 0; i < nObjects + entry; ++i) {
+         auto par = static_cast<TParameter<Long64_t> *>(arr->At(i));
+         EXPECT_EQ(par->GetVal(), (Long64_t(entry) << 40) + i);
+         EXPECT_EQ(par->GetUniqueID(), UInt_t(i));
+      }
+   }
+   t->ResetBranchAddresses();
+   delete arr;
+   gSystem->Unlink(filename);
+}
@@ -5,6 +5,8 @@
  
 #include "gtest/gtest.h"
 
+#include <string>
+
 class TTreeCache;
 
 // ROOT-10672
@@ -30,3 +32,43 @@ TEST(TChain, GetReadCacheBug)
 
    gSystem->Unlink(filename);
 }
+
+TEST(TChain, AsyncOpen)
+{
+   const auto treename = "tree";
+   const int nFiles = 4;
+   const int nEntries = 10;
+   TChain chain(treename);
+   for (int i = 0; i < nFiles; ++i) {
+      const auto filename = "tchain_asyncopen_" + std::to_string(i) + ".root";
+      TFile f(filename.c_str(), "recreate");
+      ASSERT_FALSE(f.IsZombie());
+      TTree t(treename, treename);
+      int x = 0;
+      t.Branch("x", &x);
+      for (int e = 0; e < nEntries; ++e) {
+         x = i * nEntries + e;
+         t.Fill();
+      }
+      t.Write();
+      f.Close();
+      chain.Add(filename.c_str());
+   }
+
+   chain.SetAsyncOpen(2);
+   EXPECT_EQ(chain.GetAsyncOpen(), 2);
+   int x = -1;
+   chain.SetBranchAddress("x", &x);
+   for (Long64_t e = 0; e < nFiles * nEntries; ++e) {
+      ASSERT_GT(chain.GetEntry(e), 0);
+      EXPECT_EQ(x, e);
+   }
+   // going back closes the files opened ahead
+   ASSERT_GT(chain.GetEntry(0), 0);
+   EXPECT_EQ(x, 0);
+   EXPECT_EQ(chain.GetEntries(), nFiles * nEntries);
+   chain.Reset();
+
+   for (int i = 0; i < nFiles; ++i)
+      gSystem->Unlink(("tchain_asyncopen_" + std::to_string(i) + ".root").c_str());
+}
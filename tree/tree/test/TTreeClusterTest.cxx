@@ -2,9 +2,12 @@
 #include "TTree.h"
 #include "TBranch.h"
 #include "TRandom.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class TTreeClusterTest : public ::testing::Test {
 protected:
    virtual void SetUp()
@@ -53,3 +56,32 @@ TEST_F(TTreeClusterTest, countBaskets)
 
    delete file;
 }
+
+// The basket sizes follow the content of the entries when the first cluster is delimited by a number of bytes
+TEST(TTreeAdaptiveBaskets, resizeWhenEntriesChange)
+{
+   auto fill = [](bool adaptive) {
+      TRandom random(1234);
+      TFile file("TTreeAdaptiveBaskets.root", "RECREATE");
+      TTree tree("tree", "tree");
+      tree.SetAutoFlush(-100000);
+      tree.SetAdaptiveBaskets(adaptive);
+      Double_t x = 0;
+      std::vector<Double_t> v;
+      tree.Branch("x", &x);
+      auto branch = tree.Branch("v", &v);
+      for (Int_t ev = 0; ev < 40000; ev++) {
+         x = random.Gaus(100, 7);
+         // the vector branch grows from 1 to 50 values per entry in the second half
+         v.assign(ev < 20000 ? 1 : 50, random.Gaus(0, 1));
+         tree.Fill();
+         if (ev == 19999)
+            EXPECT_GT(tree.GetAutoFlush(), 0); // the first cluster was flushed
+      }
+      return branch->GetBasketSize();
+   };
+   const auto fixedSize = fill(false);
+   const auto adaptedSize = fill(true);
+   EXPECT_GT(adaptedSize, 2 * fixedSize);
+   gSystem->Unlink("TTreeAdaptiveBaskets.root");
+}
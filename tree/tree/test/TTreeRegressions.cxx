@@ -1,3 +1,4 @@
+#include "TEntryList.h"
 #include "TMemFile.h"
 #include "TLeaf.h"
 #include "TTree.h"
@@ -6,6 +7,8 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 // ROOT-10702
@@ -115,3 +118,65 @@ TEST(TTreeRegressions, GetLeafAndFriends)
    EXPECT_EQ(t.GetLeaf("asdklj", "x"), nullptr);
    EXPECT_EQ(t.GetLeaf("asdklj", "vec"), nullptr);
 }
+
+// Combination of entry lists whose blocks are stored as bits (dense) or as lists of entries (sparse)
+TEST(TEntryList, BlockWiseOperations)
+{
+   std::vector<Long64_t> entriesA, entriesB;
+   for (Long64_t i = 0; i < 200000; ++i) {
+      if (i % 2 == 0 && i < 130000)
+         entriesA.push_back(i); // dense in the first two blocks
+      else if (i % 997 == 0)
+         entriesA.push_back(i); // sparse afterwards
+      if (i % 3 == 0 && i > 60000)
+         entriesB.push_back(i); // dense from the middle of the first block
+      else if (i % 1009 == 0 && i < 60000)
+         entriesB.push_back(i);
+   }
+
+   auto makeList = [](const std::vector<Long64_t> &entries) {
+      TEntryList l;
+      for (auto e : entries)
+         l.Enter(e);
+      l.OptimizeStorage();
+      return l;
+   };
+   auto getEntries = [](TEntryList &l) {
+      std::vector<Long64_t> entries;
+      for (Long64_t i = 0; i < l.GetN(); ++i)
+         entries.push_back(l.GetEntry(i));
+      return entries;
+   };
+
+   std::vector<Long64_t> expUnion, expIntersection, expDifference;
+   std::set_union(entriesA.begin(), entriesA.end(), entriesB.begin(), entriesB.end(), std::back_inserter(expUnion));
+   std::set_intersection(entriesA.begin(), entriesA.end(), entriesB.begin(), entriesB.end(),
+                         std::back_inserter(expIntersection));
+   std::set_difference(entriesA.begin(), entriesA.end(), entriesB.begin(), entriesB.end(),
+                       std::back_inserter(expDifference));
+
+   const auto listB = makeList(entriesB);
+
+   auto lUnion = makeList(entriesA);
+   lUnion.Add(&listB);
+   EXPECT_EQ(lUnion.GetN(), (Long64_t)expUnion.size());
+   EXPECT_EQ(getEntries(lUnion), expUnion);
+
+   auto lIntersection = makeList(entriesA);
+   lIntersection.Intersect(&listB);
+   EXPECT_EQ(lIntersection.GetN(), (Long64_t)expIntersection.size());
+   EXPECT_EQ(getEntries(lIntersection), expIntersection);
+
+   auto lDifference = makeList(entriesA);
+   lDifference.Subtract(&listB);
+   EXPECT_EQ(lDifference.GetN(), (Long64_t)expDifference.size());
+   EXPECT_EQ(getEntries(lDifference), expDifference);
+
+   for (Long64_t e : {0ll, 1ll, 997ll, 60003ll, 129998ll, 130000ll, 130558ll, 199999ll}) {
+      const bool inA = std::binary_search(entriesA.begin(), entriesA.end(), e);
+      const bool inB = std::binary_search(entriesB.begin(), entriesB.end(), e);
+      EXPECT_EQ(lIntersection.Contains(e) != 0, inA && inB) << e;
+      EXPECT_EQ(lDifference.Contains(e) != 0, inA && !inB) << e;
+      EXPECT_EQ(lUnion.Contains(e) != 0, inA || inB) << e;
+   }
+}
@@ -86,6 +86,7 @@ private:
 
    std::vector<std::string> FindTreeNames();
    static unsigned int fgTasksPerWorkerHint;
+   static unsigned int fgMaxTasksPerCluster;
 
 public:
    TTreeProcessorMT(std::string_view filename, std::string_view treename = "", UInt_t nThreads = 0u);
@@ -98,6 +99,8 @@ public:
 
    static void SetTasksPerWorkerHint(unsigned int m);
    static unsigned int GetTasksPerWorkerHint();
+   static void SetMaxTasksPerCluster(unsigned int m);
+   static unsigned int GetMaxTasksPerCluster();
 };
 
 } // End of namespace ROOT
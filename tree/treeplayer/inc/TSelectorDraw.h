@@ -67,6 +67,7 @@ protected:
    virtual void      ClearFormula();
    virtual Bool_t    CompileVariables(const char *varexp="", const char *selection="");
    virtual void      InitArrays(Int_t newsize);
+   void              PrepareFill();
 
 private:
    TSelectorDraw(const TSelectorDraw&);             // not implemented
@@ -76,7 +77,9 @@ public:
    TSelectorDraw();
    virtual ~TSelectorDraw();
 
+   void              AddParallelFills(TCollection &objects, Long64_t selectedRows);
    virtual void      Begin(TTree *tree);
+   Bool_t            CanFillInParallel() const;
    virtual Int_t     GetAction() const {return fAction;}
    virtual Bool_t    GetCleanElist() const {return fCleanElist;}
    virtual Int_t     GetDimension() const {return fDimension;}
@@ -107,6 +110,7 @@ public:
    /// See TSelectorDraw::GetVal
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
+   Bool_t            InitWorker(const TSelectorDraw &master, TTree *tree, TObject *object);
    virtual Bool_t    Notify();
    virtual Bool_t    Process(Long64_t /*entry*/) { return kFALSE; }
    virtual void      ProcessFill(Long64_t entry);
@@ -131,6 +131,12 @@ protected:
 
    RealInstanceCache fRealInstanceCache;              ///<! Cache accelerating the GetRealInstance function
 
+   using JitFunc_t = Double_t (*)(const Double_t *);
+   JitFunc_t fJitFunction = nullptr;                  ///<! Compiled version of the formula, taking the values of the leaves
+   Int_t     fJitStatus = 0;                          ///<! 0: not tried yet, 1: fJitFunction is set, -1: cannot be compiled
+   Long64_t  fNJitEvaluations = 0;                    ///<! Number of interpreted evaluations before compiling the formula
+   static Long64_t fgJitThreshold;                    ///<  Number of evaluations after which formulas are compiled
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -162,6 +168,10 @@ protected:
 
    void              Convert(UInt_t fromVersion);
 
+   std::string       GetJitExpression() const;
+   Bool_t            CompileJit();
+   Double_t          EvalJitted();
+
 private:
    // Not implemented yet
    TTreeFormula(const TTreeFormula&) = delete;
@@ -204,6 +214,9 @@ public:
    virtual char       *PrintValue(Int_t mode=0) const;
    virtual char       *PrintValue(Int_t mode, Int_t instance, const char *decform = "9.9") const;
    virtual void        SetAxis(TAxis *axis=0);
+   static  void        SetJitThreshold(Long64_t nevaluations);
+   static  Long64_t    GetJitThreshold();
+           Bool_t      IsJitted() const { return fJitStatus == 1; }
            void        SetQuickLoad(Bool_t quick) { fQuickLoad = quick; }
    virtual void        SetTree(TTree *tree) {fTree = tree;}
    virtual void        ResetLoading();
@@ -32,6 +32,7 @@ A specialized TSelector for TTree::Draw.
 #include "TEventList.h"
 #include "TEntryListArray.h"
 #include "THLimitsFinder.h"
+#include "TMath.h"
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
@@ -908,6 +909,15 @@ void TSelectorDraw::Begin(TTree *tree)
       else            fAction = 6;
    }
    if (varexp) delete[] varexp;
+   PrepareFill();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the buffers of the fills once the variables are compiled.
+
+void TSelectorDraw::PrepareFill()
+{
+   Int_t i;
    for (i = 0; i < fValSize; ++i)
       fVarMultiple[i] = kFALSE;
    fSelectMultiple = kFALSE;
@@ -935,6 +945,79 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the fills of this draw can be done in parallel by workers, see
+/// InitWorker(). This is the case, after Begin(), for the 1-D and 2-D histograms
+/// and the profiles whose axes cannot be extended, filled with numerical
+/// expressions and without progressive drawing (TTree::SetUpdate).
+
+Bool_t TSelectorDraw::CanFillInParallel() const
+{
+   const Int_t action = TMath::Abs(fAction);
+   if (action != 1 && action != 2 && action != 4 && action != 23)
+      return kFALSE;
+   if (fObjEval || !fObject || !fObject->InheritsFrom(TH1::Class()) || !fTree || fTree->GetUpdate())
+      return kFALSE;
+   TH1 *hist = (TH1 *)fObject;
+   if (hist->GetBuffer() || hist->GetXaxis()->CanExtend() || hist->GetYaxis()->CanExtend() ||
+       hist->GetZaxis()->CanExtend())
+      return kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString())
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare this selector to fill object, a clone of the histogram of master,
+/// with the entries of tree, a part of the tree of master, for which
+/// CanFillInParallel() is true. The variables and the selection of master are
+/// compiled again for tree: this must be done under the global lock. Return
+/// kFALSE if they cannot be compiled.
+///
+/// The fills are not drawn and the number of selected rows is only the one of
+/// this worker: the caller adds the histograms of the workers to the one of
+/// master.
+
+Bool_t TSelectorDraw::InitWorker(const TSelectorDraw &master, TTree *tree, TObject *object)
+{
+   SetStatus(0);
+   ResetAbort();
+   fSelectedRows = 0;
+   fTree = tree;
+   fOption = master.fOption;
+   TString varexp;
+   for (Int_t i = 0; i < master.fDimension; ++i) {
+      if (i)
+         varexp += ":";
+      varexp += master.fVar[i]->GetTitle();
+   }
+   if (!CompileVariables(varexp, master.fSelect ? master.fSelect->GetTitle() : ""))
+      return kFALSE;
+   if (fDimension != master.fDimension || fObjEval)
+      return kFALSE;
+   fAction = TMath::Abs(master.fAction);
+   fObject = object;
+   PrepareFill();
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add to the histogram the objects filled by the workers prepared with
+/// InitWorker(), which selected selectedRows rows in total.
+
+void TSelectorDraw::AddParallelFills(TCollection &objects, Long64_t selectedRows)
+{
+   TH1 *hist = (TH1 *)fObject;
+   TIter next(&objects);
+   while (TObject *obj = next())
+      hist->Add((TH1 *)obj);
+   fSelectedRows += selectedRows;
+   if (selectedRows && fAction < 0)
+      fAction = -fAction;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -44,6 +44,7 @@
 #include "strlcpy.h"
 #include "snprintf.h"
 #include "TEntryList.h"
+#include "TVirtualMutex.h"
 
 #include <cctype>
 #include <cstdio>
@@ -51,6 +52,8 @@
 #include <cstdlib>
 #include <typeinfo>
 #include <algorithm>
+#include <map>
+#include <type_traits>
 
 const Int_t kMaxLen     = 1024;
 
@@ -94,6 +97,8 @@ The following method are available from the TFormLeafInfo interface:
 
 ClassImp(TTreeFormula);
 
+Long64_t TTreeFormula::fgJitThreshold = 10000;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 inline static void R__LoadBranch(TBranch* br, Long64_t entry, Bool_t quickLoad)
@@ -4006,6 +4011,13 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T, Double_t>::value && instance == 0 && fJitStatus >= 0) {
+      if (fJitStatus == 0 && fgJitThreshold >= 0 && ++fNJitEvaluations > fgJitThreshold)
+         CompileJit();
+      if (fJitStatus == 1)
+         return EvalJitted();
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4412,6 +4424,223 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of evaluations of a formula after which it is compiled.
+///
+/// Formulas made only of numbers, operators, mathematical functions and
+/// scalar leaves read directly (no arrays, data members, methods, aliases,
+/// strings or cuts) are translated into a C++ function that is compiled by
+/// the interpreter and replaces the evaluation of the operations one by one.
+/// Since compiling takes some time, a formula is compiled only after it has
+/// been evaluated `nevaluations` times for the instance 0 (e.g. on that many
+/// entries in TTree::Draw). The default is 10000, 0 compiles the formulas at
+/// their first evaluation and a negative value disables the compilation.
+
+void TTreeFormula::SetJitThreshold(Long64_t nevaluations)
+{
+   fgJitThreshold = nevaluations;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of evaluations after which a formula is compiled.
+/// See SetJitThreshold().
+
+Long64_t TTreeFormula::GetJitThreshold()
+{
+   return fgJitThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the C++ expression computing this formula from the array `x` of
+/// the values of its leaves, or an empty string if the formula uses an
+/// operation that cannot be compiled. The expression reproduces the special
+/// cases of EvalInstance, e.g. a division by 0 is 0.
+
+std::string TTreeFormula::GetJitExpression() const
+{
+   if (fMultiplicity != 0 || fAxis || fHasCast || TestBit(kIsCharacter) || TestBit(kMissingLeaf))
+      return "";
+   if (fNcodes <= 0 || fAliases.GetEntriesFast() > 0 || fExternalCuts.GetEntriesFast() > 0)
+      return "";
+
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TLeaf *leaf = (TLeaf *)fLeaves.UncheckedAt(code);
+      if (!leaf || fLookupType[code] != kDirect || fCodes[code] < 0)
+         return "";
+      if (leaf->GetLenStatic() != 1 || leaf->GetLeafCount() || leaf->InheritsFrom(TLeafC::Class()) ||
+          leaf->InheritsFrom(TLeafObject::Class()) || IsLeafString(code))
+         return "";
+   }
+
+   std::vector<std::string> stack;
+   auto unary = [&stack](const char *format) {
+      if (stack.empty())
+         return false;
+      stack.back() = TString::Format(format, stack.back().c_str()).Data();
+      return true;
+   };
+   auto binary = [&stack](const char *format) {
+      if (stack.size() < 2)
+         return false;
+      std::string right = stack.back();
+      stack.pop_back();
+      stack.back() = TString::Format(format, stack.back().c_str(), right.c_str()).Data();
+      return true;
+   };
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      Bool_t ok = kTRUE;
+      switch (action) {
+         case kConstant: {
+            const Double_t value = fConst[oper & kTFOperMask];
+            if (!std::isfinite(value))
+               return "";
+            stack.emplace_back(TString::Format("(%.17g)", value).Data());
+            break;
+         }
+         case kDefinedVariable: stack.emplace_back(TString::Format("x[%d]", oper & kTFOperMask).Data()); break;
+         // the expressions are free of side effects: the short-circuit of && and || in C++ gives the same result
+         case kBoolOptimize: break;
+
+         case kAdd:         ok = binary("(%s+%s)"); break;
+         case kSubstract:   ok = binary("(%s-%s)"); break;
+         case kMultiply:    ok = binary("(%s*%s)"); break;
+         case kDivide:      ok = binary("R__TTreeFormulaJit::Divide(%s,%s)"); break;
+         case kModulo:      ok = binary("double((long long)%s%%(long long)%s)"); break;
+
+         case kcos:   ok = unary("TMath::Cos(%s)"); break;
+         case ksin:   ok = unary("TMath::Sin(%s)"); break;
+         case ktan:   ok = unary("R__TTreeFormulaJit::Tan(%s)"); break;
+         case kacos:  ok = unary("R__TTreeFormulaJit::ACos(%s)"); break;
+         case kasin:  ok = unary("R__TTreeFormulaJit::ASin(%s)"); break;
+         case katan:  ok = unary("TMath::ATan(%s)"); break;
+         case kcosh:  ok = unary("TMath::CosH(%s)"); break;
+         case ksinh:  ok = unary("TMath::SinH(%s)"); break;
+         case ktanh:  ok = unary("R__TTreeFormulaJit::TanH(%s)"); break;
+         case kacosh: ok = unary("R__TTreeFormulaJit::ACosH(%s)"); break;
+         case kasinh: ok = unary("TMath::ASinH(%s)"); break;
+         case katanh: ok = unary("R__TTreeFormulaJit::ATanH(%s)"); break;
+         case katan2: ok = binary("TMath::ATan2(%s,%s)"); break;
+         case kfmod:  ok = binary("std::fmod(%s,%s)"); break;
+         case kpow:   ok = binary("TMath::Power(%s,%s)"); break;
+         case ksq:    ok = unary("R__TTreeFormulaJit::Sq(%s)"); break;
+         case ksqrt:  ok = unary("TMath::Sqrt(TMath::Abs(%s))"); break;
+         case kmin:   ok = binary("std::min<double>(%s,%s)"); break;
+         case kmax:   ok = binary("std::max<double>(%s,%s)"); break;
+         case klog:   ok = unary("R__TTreeFormulaJit::Log(%s)"); break;
+         case kexp:   ok = unary("R__TTreeFormulaJit::Exp(%s)"); break;
+         case klog10: ok = unary("R__TTreeFormulaJit::Log10(%s)"); break;
+         case kpi:    stack.emplace_back("TMath::ACos(-1.)"); break;
+         case kabs:   ok = unary("TMath::Abs(%s)"); break;
+         case ksign:  ok = unary("(%s<0?-1.:1.)"); break;
+         case kint:   ok = unary("double((long long)%s)"); break;
+         case kSignInv: ok = unary("(-1*%s)"); break;
+
+         case kAnd:         ok = binary("(%s!=0&&%s!=0?1.:0.)"); break;
+         case kOr:          ok = binary("(%s!=0||%s!=0?1.:0.)"); break;
+         case kEqual:       ok = binary("(%s==%s?1.:0.)"); break;
+         case kNotEqual:    ok = binary("(%s!=%s?1.:0.)"); break;
+         case kLess:        ok = binary("(%s<%s?1.:0.)"); break;
+         case kGreater:     ok = binary("(%s>%s?1.:0.)"); break;
+         case kLessThan:    ok = binary("(%s<=%s?1.:0.)"); break;
+         case kGreaterThan: ok = binary("(%s>=%s?1.:0.)"); break;
+         case kNot:         ok = unary("(%s!=0?0.:1.)"); break;
+
+         case kBitAnd:     ok = binary("double((unsigned long long)%s&(unsigned long long)%s)"); break;
+         case kBitOr:      ok = binary("double((unsigned long long)%s|(unsigned long long)%s)"); break;
+         case kLeftShift:  ok = binary("double((unsigned long long)%s<<(unsigned long long)%s)"); break;
+         case kRightShift: ok = binary("double((unsigned long long)%s>>(unsigned long long)%s)"); break;
+
+         // conditional jumps, random numbers, strings, function calls, ... are only interpreted
+         default: return "";
+      }
+      if (!ok)
+         return "";
+   }
+   if (stack.size() != 1)
+      return "";
+   return stack.back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Try to compile the formula, see SetJitThreshold(). Identical expressions
+/// share the same compiled function. Return true if the formula is compiled.
+
+Bool_t TTreeFormula::CompileJit()
+{
+   fJitStatus = -1;
+   const std::string expression = GetJitExpression();
+   if (expression.empty() || !gInterpreter)
+      return kFALSE;
+
+   static std::map<std::string, JitFunc_t> functions;
+   static Int_t nfunctions = 0;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   auto &function = functions[expression];
+   if (!function) {
+      if (nfunctions == 0) {
+         // Same special cases as in EvalInstance
+         const char *helpers = "#include \"TMath.h\"\n"
+                               "#include <algorithm>\n"
+                               "#include <cmath>\n"
+                               "namespace R__TTreeFormulaJit {\n"
+                               "inline double Divide(double a, double b) { return b == 0 ? 0. : a / b; }\n"
+                               "inline double Sq(double a) { return a * a; }\n"
+                               "inline double Tan(double a) { return TMath::Cos(a) == 0 ? 0. : TMath::Tan(a); }\n"
+                               "inline double ACos(double a) { return TMath::Abs(a) > 1 ? 0. : TMath::ACos(a); }\n"
+                               "inline double ASin(double a) { return TMath::Abs(a) > 1 ? 0. : TMath::ASin(a); }\n"
+                               "inline double TanH(double a) { return TMath::CosH(a) == 0 ? 0. : TMath::TanH(a); }\n"
+                               "inline double ACosH(double a) { return a < 1 ? 0. : TMath::ACosH(a); }\n"
+                               "inline double ATanH(double a) { return TMath::Abs(a) > 1 ? 0. : TMath::ATanH(a); }\n"
+                               "inline double Log(double a) { return a > 0 ? TMath::Log(a) : 0.; }\n"
+                               "inline double Log10(double a) { return a > 0 ? TMath::Log10(a) : 0.; }\n"
+                               "inline double Exp(double a) { return a < -700 ? 0. : TMath::Exp(a > 700 ? 700. : a); }\n"
+                               "}\n";
+         if (!gInterpreter->Declare(helpers)) {
+            functions.erase(expression);
+            return kFALSE;
+         }
+      }
+      const Int_t id = nfunctions++;
+      const TString code = TString::Format(
+         "namespace R__TTreeFormulaJit { double Function%d(const double *x) { return %s; } }", id, expression.c_str());
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      if (gInterpreter->Declare(code.Data())) {
+         const TString address = TString::Format("(Longptr_t)&R__TTreeFormulaJit::Function%d", id);
+         function = reinterpret_cast<JitFunc_t>(gInterpreter->Calc(address.Data(), &error));
+      }
+      if (!function || error != TInterpreter::kNoError) {
+         functions.erase(expression);
+         return kFALSE;
+      }
+   }
+   fJitFunction = function;
+   fJitStatus = 1;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the instance 0 of the formula with its compiled function.
+
+Double_t TTreeFormula::EvalJitted()
+{
+   Double_t x[kMAXCODES];
+   // the compiled function always evaluates all its operands, hence all the branches are loaded
+   fNeedLoading = kFALSE;
+   fDidBooleanOptimization = kFALSE;
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TLeaf *leaf = (TLeaf *)fLeaves.UncheckedAt(code);
+      TBranch *branch = (TBranch *)fBranches.UncheckedAt(code);
+      if (branch)
+         R__LoadBranch(branch, branch->GetTree()->GetReadEntry(), fQuickLoad);
+      x[code] = leaf->GetValue(0);
+   }
+   return fJitFunction(x);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5071,6 +5300,10 @@ Bool_t TTreeFormula::StringToNumber(Int_t oper)
 
 void TTreeFormula::UpdateFormulaLeaves()
 {
+   // The leaves of the new tree may not be compatible with the compiled function, check them again
+   fJitFunction = nullptr;
+   fJitStatus = 0;
+
    Int_t nleaves = fLeafNames.GetEntriesFast();
    ResetBit( kMissingLeaf );
    for (Int_t i=0;i<nleaves;i++) {
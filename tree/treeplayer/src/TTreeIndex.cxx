@@ -18,7 +18,19 @@ A Tree Index with majorname and minorname.
 #include "TTreeFormula.h"
 #include "TTree.h"
 #include "TBuffer.h"
+#include "TBufferFile.h"
+#include "TBranch.h"
+#include "TChain.h"
+#include "TLeaf.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <cstring>
 
 ClassImp(TTreeIndex);
 
@@ -42,6 +54,110 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the entry numbers by index value. With implicit multi-threading, large
+/// indices are sorted in chunks in parallel, then the chunks are merged pairwise,
+/// also in parallel.
+
+void SortIndex(Long64_t *index, Long64_t n, IndexSortComparator comparator)
+{
+#ifdef R__USE_IMT
+   const Long64_t minChunkSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * minChunkSize) {
+      ROOT::TThreadExecutor pool;
+      const Long64_t nChunks = std::min<Long64_t>(pool.GetPoolSize(), n / minChunkSize);
+      const Long64_t chunkSize = (n + nChunks - 1) / nChunks;
+      pool.Foreach([&](unsigned chunk) {
+         Long64_t *begin = index + chunk * chunkSize;
+         std::sort(begin, std::min(begin + chunkSize, index + n), comparator);
+      }, ROOT::TSeqU(nChunks));
+      for (Long64_t width = chunkSize; width < n; width *= 2) {
+         const Long64_t nMerges = (n + 2 * width - 1) / (2 * width);
+         pool.Foreach([&](unsigned merge) {
+            Long64_t *begin = index + merge * 2 * width;
+            Long64_t *middle = std::min(begin + width, index + n);
+            std::inplace_merge(begin, middle, std::min(begin + 2 * width, index + n), comparator);
+         }, ROOT::TSeqU(nMerges));
+      }
+      return;
+   }
+#endif
+   std::sort(index, index + n, comparator);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert the values of a basket read in bulk as TTreeIndex converts the values of its formulas.
+
+template <typename T>
+void ConvertBulkValues(const char *buf, Int_t n, Long64_t *values)
+{
+   for (Int_t i = 0; i < n; ++i) {
+      T value;
+      memcpy(&value, buf + i * sizeof(T), sizeof(T));
+      values[i] = (Long64_t)(LongDouble_t)value;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the branch of tree holding the index value `name`, if it can be read
+/// with the bulk API: a branch of the tree itself (not of a friend or an alias)
+/// with a single fundamental value per entry, whose baskets are all written.
+
+TBranch *GetBulkIndexBranch(TTree *tree, const TString &name)
+{
+   if (tree->GetAlias(name))
+      return nullptr;
+   TBranch *branch = tree->GetBranch(name);
+   if (!branch || branch->GetTree() != tree || !branch->SupportsBulkRead())
+      return nullptr;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (strcmp(leaf->GetName(), branch->GetName()) != 0 || leaf->GetLenStatic() != 1 || leaf->GetLeafCount())
+      return nullptr;
+   // the entries of the basket being filled cannot be read in bulk
+   if (branch->GetEntries() > branch->GetBasketEntry()[branch->GetWriteBasket()])
+      return nullptr;
+   return branch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the index values stored in branch with the bulk API, basket by basket.
+/// Return false if the branch could not be read this way.
+
+Bool_t ReadBulkIndexValues(TBranch &branch, Long64_t nEntries, Long64_t *values)
+{
+   TClass *cl = nullptr;
+   EDataType type = kOther_t;
+   if (branch.GetExpectedType(cl, type) || cl)
+      return kFALSE;
+   TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+   for (Long64_t entry = 0; entry < nEntries;) {
+      const Int_t n = branch.GetBulkRead().GetBulkEntries(entry, buf);
+      if (n <= 0 || entry + n > nEntries)
+         return kFALSE;
+      const char *raw = buf.GetCurrent();
+      switch (type) {
+      case kChar_t: ConvertBulkValues<Char_t>(raw, n, values + entry); break;
+      case kUChar_t: ConvertBulkValues<UChar_t>(raw, n, values + entry); break;
+      case kBool_t: ConvertBulkValues<Bool_t>(raw, n, values + entry); break;
+      case kShort_t: ConvertBulkValues<Short_t>(raw, n, values + entry); break;
+      case kUShort_t: ConvertBulkValues<UShort_t>(raw, n, values + entry); break;
+      case kInt_t: ConvertBulkValues<Int_t>(raw, n, values + entry); break;
+      case kUInt_t: ConvertBulkValues<UInt_t>(raw, n, values + entry); break;
+      case kLong64_t: ConvertBulkValues<Long64_t>(raw, n, values + entry); break;
+      case kULong64_t: ConvertBulkValues<ULong64_t>(raw, n, values + entry); break;
+      case kFloat_t: ConvertBulkValues<Float_t>(raw, n, values + entry); break;
+      case kDouble_t: ConvertBulkValues<Double_t>(raw, n, values + entry); break;
+      default: return kFALSE;
+      }
+      entry += n;
+   }
+   return kTRUE;
+}
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -168,21 +284,62 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+
+   // Index values that are plain branches of a TTree are read with the bulk API, concurrently
+   // with implicit multi-threading, instead of being evaluated entry by entry.
+   Bool_t majorDone = kFALSE;
+   Bool_t minorDone = kFALSE;
+   if (fMinorName == "0") {
+      std::fill(tmp_minor, tmp_minor + fN, 0);
+      minorDone = kTRUE;
+   }
+   if (!dynamic_cast<TChain *>(fTree)) {
+      TBranch *majorBranch = GetBulkIndexBranch(fTree, fMajorName);
+      TBranch *minorBranch = minorDone ? nullptr : GetBulkIndexBranch(fTree, fMinorName);
+      if (minorBranch == majorBranch)
+         minorBranch = nullptr; // read only once, copied below
+      auto readBulk = [&](unsigned which) {
+         if (which == 0 && majorBranch)
+            majorDone = ReadBulkIndexValues(*majorBranch, fN, tmp_major);
+         else if (which == 1 && minorBranch)
+            minorDone = ReadBulkIndexValues(*minorBranch, fN, tmp_minor);
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && majorBranch && minorBranch) {
+         ROOT::Internal::TParBranchProcessingRAII pbpRAII;
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(readBulk, ROOT::TSeqU(2));
+      } else
+#endif
+      {
+         readBulk(0);
+         readBulk(1);
+      }
+      if (majorDone && !minorDone && fMinorName == fMajorName) {
+         std::copy(tmp_major, tmp_major + fN, tmp_minor);
+         minorDone = kTRUE;
+      }
+   }
+
+   if (!majorDone || !minorDone) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         if (!majorDone)
+            tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         if (!minorDone)
+            tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
+   SortIndex(fIndex, fN, IndexSortComparator(tmp_major, tmp_minor));
    //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
@@ -271,7 +428,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+      SortIndex(conv, fN, IndexSortComparator(addValues, addValues2));
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -80,6 +80,16 @@ extra libraries (Histogram, display, etc).
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+#endif
+
 #include "HFitInterface.h"
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
@@ -2201,6 +2211,231 @@ Long64_t TTreePlayer::Process(const char *filename,Option_t *option, Long64_t ne
    return nsel;
 }
 
+#ifdef R__USE_IMT
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a processor of all the entries of tree in parallel tasks over its
+/// clusters, or nullptr if implicit multi-threading is disabled, if only a
+/// part of the entries is processed, if the tree has an entry list or an
+/// event list, or if it is not read from files.
+
+std::unique_ptr<ROOT::TTreeProcessorMT> MakeProcessorMT(TTree *tree, Long64_t nentries, Long64_t firstentry)
+{
+   if (!ROOT::IsImplicitMTEnabled() || ROOT::GetThreadPoolSize() < 2)
+      return nullptr;
+   if (firstentry != 0 || nentries <= 0 || nentries != tree->GetEntries())
+      return nullptr;
+   if (tree->GetEntryList() || tree->GetEventList())
+      return nullptr;
+   try {
+      return std::make_unique<ROOT::TTreeProcessorMT>(*tree);
+   } catch (const std::exception &) {
+      // e.g. an in-memory tree
+      return nullptr;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A selector filling a clone of the histogram of a TTree::Draw.
+
+struct TDrawWorker {
+   TSelectorDraw fSelector;
+   std::unique_ptr<TH1> fHist;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram of draw, for which TSelectorDraw::CanFillInParallel() is
+/// true, with processor. Each task compiles the expressions for its part of the
+/// tree and fills a clone of the histogram; the clones are reused by the next
+/// tasks and added to the histogram at the end. Return kFALSE, leaving the
+/// histogram untouched, if a task cannot compile the expressions.
+
+Bool_t ProcessDrawMT(TSelectorDraw &draw, ROOT::TTreeProcessorMT &processor)
+{
+   TTree *tree = draw.GetTree();
+   TH1 *hist = (TH1 *)draw.GetObject();
+   std::vector<std::unique_ptr<TDrawWorker>> workers;
+   std::vector<TDrawWorker *> idle;
+   std::atomic<Bool_t> failed{kFALSE};
+   std::atomic<Long64_t> selectedRows{0};
+
+   processor.Process([&](TTreeReader &reader) {
+      if (failed)
+         return;
+      TTree *chain = reader.GetTree();
+      TDrawWorker *worker = nullptr;
+      {
+         // the formulas are compiled, and the histograms cloned, under the global lock
+         R__LOCKGUARD(gROOTMutex);
+         if (idle.empty()) {
+            workers.emplace_back(new TDrawWorker);
+            worker = workers.back().get();
+            worker->fHist.reset((TH1 *)hist->Clone());
+            worker->fHist->SetDirectory(nullptr);
+            worker->fHist->Reset();
+         } else {
+            worker = idle.back();
+            idle.pop_back();
+         }
+         if (tree->GetListOfAliases()) {
+            TIter next(tree->GetListOfAliases());
+            while (TObject *alias = next())
+               chain->SetAlias(alias->GetName(), alias->GetTitle());
+         }
+         chain->LoadTree(reader.GetEntriesRange().first);
+         if (!worker->fSelector.InitWorker(draw, chain, worker->fHist.get()))
+            failed = kTRUE;
+      }
+
+      Int_t treeNumber = -1;
+      while (!failed && reader.Next()) {
+         const Long64_t localEntry = chain->LoadTree(reader.GetCurrentEntry());
+         if (localEntry < 0)
+            break;
+         if (chain->GetTreeNumber() != treeNumber) {
+            treeNumber = chain->GetTreeNumber();
+            worker->fSelector.Notify();
+         }
+         worker->fSelector.ProcessFill(localEntry);
+      }
+      if (worker->fSelector.GetNfill())
+         worker->fSelector.TakeAction();
+      selectedRows += worker->fSelector.GetSelectedRows();
+
+      R__LOCKGUARD(gROOTMutex);
+      idle.push_back(worker);
+   });
+
+   if (failed)
+      return kFALSE;
+   TList fills;
+   for (auto &worker : workers)
+      fills.Add(worker->fHist.get());
+   draw.AddParallelFills(fills, selectedRows);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the objects of the output lists of the workers into output, by name.
+/// The objects not found in output are moved to it.
+
+void MergeOutputs(TList *output, const std::vector<std::unique_ptr<TSelector>> &workers)
+{
+   for (auto &worker : workers) {
+      TList *workerOutput = worker->GetOutputList();
+      std::vector<TObject *> moved;
+      TIter next(workerOutput);
+      while (TObject *obj = next()) {
+         TObject *target = output->FindObject(obj->GetName());
+         if (!target) {
+            moved.push_back(obj);
+            continue;
+         }
+         ROOT::MergeFunc_t merge = target->IsA()->GetMerge();
+         if (!merge) {
+            Warning("TTreePlayer::Process", "Cannot merge the outputs %s of class %s of the workers", obj->GetName(),
+                    obj->ClassName());
+            continue;
+         }
+         TList objects;
+         objects.Add(obj);
+         merge(target, &objects, nullptr);
+      }
+      for (TObject *obj : moved) {
+         workerOutput->Remove(obj);
+         output->Add(obj);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process selector, for which TSelector::IsThreadSafe() is true, with
+/// processor: Begin() and Terminate() are called on selector, the entries are
+/// processed by workers created from its class, as PROOF would do. Return the
+/// status of the processing like TTreePlayer::Process.
+
+Long64_t ProcessSelectorMT(TSelector *selector, TTree *tree, Option_t *option, ROOT::TTreeProcessorMT &processor)
+{
+   selector->SetOption(option);
+   selector->Begin(tree);
+   if (selector->GetAbort() == TSelector::kAbortProcess)
+      return -1;
+
+   TClass *cl = selector->IsA();
+   std::mutex mutex;
+   std::vector<std::unique_ptr<TSelector>> workers;
+   std::vector<TSelector *> idle;
+   std::atomic<Bool_t> aborted{kFALSE};
+
+   processor.Process([&](TTreeReader &reader) {
+      if (aborted)
+         return;
+      TTree *chain = reader.GetTree();
+      // the objects created by the workers are not attached to the current directory
+      TDirectory::TContext ctxt(nullptr);
+      TSelector *worker = nullptr;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (!idle.empty()) {
+            worker = idle.back();
+            idle.pop_back();
+         }
+      }
+      if (!worker) {
+         worker = (TSelector *)cl->New();
+         worker->SetOption(selector->GetOption());
+         worker->SetInputList(selector->GetInputList());
+         worker->SlaveBegin(chain);
+         std::lock_guard<std::mutex> lock(mutex);
+         workers.emplace_back(worker);
+      }
+
+      worker->Init(chain);
+      Int_t treeNumber = -1;
+      Int_t skippedTree = -1;
+      while (!aborted && reader.Next()) {
+         const Long64_t localEntry = chain->LoadTree(reader.GetCurrentEntry());
+         if (localEntry < 0)
+            break;
+         if (chain->GetTreeNumber() != treeNumber) {
+            treeNumber = chain->GetTreeNumber();
+            worker->Notify();
+         }
+         if (treeNumber == skippedTree)
+            continue;
+         worker->Process(localEntry);
+         if (worker->GetAbort() == TSelector::kAbortProcess) {
+            aborted = kTRUE;
+         } else if (worker->GetAbort() == TSelector::kAbortFile) {
+            // skip to the next file
+            skippedTree = treeNumber;
+            worker->ResetAbort();
+         }
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      idle.push_back(worker);
+   });
+
+   if (aborted) {
+      selector->Abort("Aborted by a worker");
+      return -1;
+   }
+   Long64_t status = selector->GetStatus();
+   for (auto &worker : workers) {
+      worker->SlaveTerminate();
+      status += worker->GetStatus();
+   }
+   MergeOutputs(selector->GetOutputList(), workers);
+   selector->SetStatus(status);
+   selector->Terminate();
+   return selector->GetStatus();
+}
+
+} // namespace
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Process this tree executing the code in the specified selector.
 /// The return value is -1 in case of error and TSelector::GetStatus() in
@@ -2222,6 +2457,17 @@ Long64_t TTreePlayer::Process(const char *filename,Option_t *option, Long64_t ne
 ///  If the Tree (Chain) has an associated EventList, the loop is on the nentries
 ///  of the EventList, starting at firstentry, otherwise the loop is on the
 ///  specified Tree entries.
+///
+///  When implicit multi-threading is enabled and all the entries of a tree
+///  read from files are processed, without entry or event list, the entries
+///  are processed in parallel tasks over the clusters of the tree:
+///
+/// -  by workers of the selector if TSelector::IsThreadSafe() is true, see
+///    TSelector for the sequence of calls;
+/// -  for the TTree::Draw filling 1-D or 2-D histograms or profiles with fixed
+///    axes (e.g. `"x>>h(100,0,10)"`), see TSelectorDraw::CanFillInParallel.
+///    The histogram is then filled by clones, added together at the end, and
+///    the buffers returned by TTree::GetV1 etc. are not filled.
 
 Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nentries, Long64_t firstentry)
 {
@@ -2229,6 +2475,15 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    TDirectory::TContext ctxt;
 
+#ifdef R__USE_IMT
+   if (selector != fSelector && selector->IsThreadSafe() && selector->Version() >= 2 &&
+       selector->IsA()->IsLoaded() && selector->IsA()->GetTypeInfo() &&
+       *selector->IsA()->GetTypeInfo() == typeid(*selector)) {
+      if (auto processor = MakeProcessorMT(fTree, nentries, firstentry))
+         return ProcessSelectorMT(selector, fTree, option, *processor);
+   }
+#endif
+
    fTree->SetNotify(selector);
 
    selector->SetOption(option);
@@ -2244,7 +2499,14 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    Bool_t process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? kTRUE : kFALSE;
-   if (process) {
+   Bool_t processedMT = kFALSE;
+#ifdef R__USE_IMT
+   if (process && selector == fSelector && fSelector->CanFillInParallel()) {
+      if (auto processor = MakeProcessorMT(fTree, nentries, firstentry))
+         processedMT = ProcessDrawMT(*fSelector, *processor);
+   }
+#endif
+   if (process && !processedMT) {
 
       Long64_t readbytesatstart = 0;
       readbytesatstart = TFile::GetFileBytesRead();
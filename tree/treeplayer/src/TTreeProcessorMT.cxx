@@ -21,11 +21,15 @@ on a subrange of entries by using that TTreeReader.
 The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the subranges,
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
-objects.
+objects. Small clusters are merged into larger subranges (see SetTasksPerWorkerHint()) and, optionally,
+large clusters are split into smaller ones (see SetMaxTasksPerCluster()).
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
+#include "ROOT/TBasketBufferPool.hxx"
+
+#include <algorithm>
 
 using namespace ROOT;
 
@@ -123,13 +127,37 @@ ConvertToElistClusters(std::vector<std::vector<EntryCluster>> &&clusters, TEntry
    return elistClusters;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Split each cluster in up to nSplits contiguous entry ranges of similar size.
+static std::vector<EntryCluster> SplitClusters(const std::vector<EntryCluster> &clusters, unsigned int nSplits)
+{
+   std::vector<EntryCluster> ranges;
+   for (const auto &c : clusters) {
+      const Long64_t nEntries = c.end - c.start;
+      const Long64_t nRanges = std::min<Long64_t>(nSplits, nEntries);
+      const Long64_t base = nEntries / nRanges;
+      Long64_t rest = nEntries % nRanges;
+      Long64_t start = c.start;
+      for (auto i = 0ll; i < nRanges; ++i) {
+         // distribute the remainder onto the first ranges
+         const Long64_t end = start + base + (rest > 0 ? 1 : 0);
+         if (rest > 0)
+            --rest;
+         ranges.emplace_back(EntryCluster{start, end});
+         start = end;
+      }
+   }
+   return ranges;
+}
+
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
 static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
-                                       const std::vector<std::string> &fileNames, const unsigned int maxTasksPerFile)
+                                       const std::vector<std::string> &fileNames, const unsigned int maxTasksPerFile,
+                                       const unsigned int maxTasksPerCluster)
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
@@ -185,6 +213,10 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
    // The criterion according to which we fuse clusters together is to have around
    // TTreeProcessorMT::GetTasksPerWorkerHint() clusters per slot.
    // Concretely, for each file we will cap the number of tasks to ceil(GetTasksPerWorkerHint() * nWorkers / nFiles).
+   //
+   // Conversely, files with fewer clusters than that can leave workers idle at the end of the event loop, when the
+   // last few large tasks are processed. If TTreeProcessorMT::GetMaxTasksPerCluster() is larger than one, the clusters
+   // of such files are split into up to that many entry ranges, to get closer to the desired number of tasks.
 
    std::vector<std::vector<EntryCluster>> eventRangesPerFile(clustersPerFile.size());
    auto clustersPerFileIt = clustersPerFile.begin();
@@ -193,9 +225,17 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
       const auto clustersInThisFileSize = clustersPerFileIt->size();
       const auto nFolds = clustersInThisFileSize / maxTasksPerFile;
       // If the number of clusters is less than maxTasksPerFile
-      // we take the clusters as they are
+      // we take the clusters as they are, or split them if allowed
       if (nFolds == 0) {
-         *eventRangesPerFileIt = std::move(*clustersPerFileIt);
+         const auto nSplits = clustersInThisFileSize == 0
+                                 ? 1u
+                                 : std::min<unsigned int>(maxTasksPerCluster,
+                                                          (maxTasksPerFile + clustersInThisFileSize - 1) /
+                                                             clustersInThisFileSize);
+         if (nSplits > 1)
+            *eventRangesPerFileIt = SplitClusters(*clustersPerFileIt, nSplits);
+         else
+            *eventRangesPerFileIt = std::move(*clustersPerFileIt);
          continue;
       }
       // Otherwise, we have to merge clusters, distributing the reminder evenly
@@ -273,6 +313,7 @@ static std::vector<std::vector<Long64_t>> GetFriendEntries(const Internal::TreeU
 namespace ROOT {
 
 unsigned int TTreeProcessorMT::fgTasksPerWorkerHint = 10U;
+unsigned int TTreeProcessorMT::fgMaxTasksPerCluster = 1U;
 
 namespace Internal {
 
@@ -485,6 +526,7 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    // compute number of tasks per file
    const unsigned int maxTasksPerFile =
       std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) / float(fFileNames.size()));
+   const unsigned int maxTasksPerCluster = GetMaxTasksPerCluster();
 
    // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
    // so we do it here for all files.
@@ -496,7 +538,7 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
    ClustersAndEntries clusterAndEntries{};
    if (shouldRetrieveAllClusters) {
-      clusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile);
+      clusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile, maxTasksPerCluster);
       if (hasEntryList)
          clusterAndEntries.first = ConvertToElistClusters(std::move(clusterAndEntries.first), fEntryList, fTreeNames,
                                                           fFileNames, clusterAndEntries.second);
@@ -517,7 +559,8 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : std::vector<std::string>({fTreeNames[fileIdx]});
       // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
       const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? ClustersAndEntries{} : MakeClusters(theseTrees, theseFiles, maxTasksPerFile);
+         shouldRetrieveAllClusters ? ClustersAndEntries{}
+                                   : MakeClusters(theseTrees, theseFiles, maxTasksPerFile, maxTasksPerCluster);
 
       // All clusters for the file to process, either with global or local entry numbers
       const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
@@ -539,6 +582,9 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
 
    fPool.Foreach(processFile, fileIdxs);
+
+   // The trees of the tasks recycled the basket buffers of each other through the pool, give the memory back now
+   ROOT::Internal::TBasketBufferPool::Trim();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -561,3 +607,26 @@ void TTreeProcessorMT::SetTasksPerWorkerHint(unsigned int tasksPerWorkerHint)
 {
    fgTasksPerWorkerHint = tasksPerWorkerHint;
 }
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Retrieve the current value for the maximum number of tasks a cluster can be split into.
+/// \return The maximum number of entry ranges that a single cluster is split into, 1 (the default) means no splitting.
+unsigned int TTreeProcessorMT::GetMaxTasksPerCluster()
+{
+   return fgMaxTasksPerCluster;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Allow splitting clusters into several tasks.
+/// \param[in] maxTasksPerCluster Maximum number of entry ranges a single cluster is split into.
+///
+/// Files with fewer clusters than GetTasksPerWorkerHint() tasks per worker, e.g. few files with a few large
+/// clusters, result in few large tasks, so that workers idle while the last ones are processed. If
+/// maxTasksPerCluster is larger than one, the clusters of such files are split into smaller entry ranges, so that
+/// around GetTasksPerWorkerHint() tasks per worker are created and the load is balanced better. The price is that
+/// the baskets of a split cluster are read and decompressed once by each task that processes a part of it.
+/// A value of 0 is treated as 1, which is the default and means that clusters are never split.
+void TTreeProcessorMT::SetMaxTasksPerCluster(unsigned int maxTasksPerCluster)
+{
+   fgMaxTasksPerCluster = std::max(maxTasksPerCluster, 1u);
+}
@@ -1,7 +1,11 @@
 #include "TFile.h"
 #include "TSystem.h"
 #include "TChain.h"
+#include "TROOT.h"
 #include "TTree.h"
+#include "TTreeCache.h"
+#include "TTreeFormula.h"
+#include "TTreeIndex.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 
@@ -173,3 +177,139 @@ TEST(TTreeReaderRegressions, IndexedFriend)
 
    gSystem->Unlink(fname);
 }
+
+// The index values read in bulk from plain branches must match the ones evaluated with formulas
+TEST(TTreeIndex, BulkReadMatchesFormulas)
+{
+   const auto fname = "ttreeindex_bulkread.root";
+   const Long64_t nEntries = 300000;
+   {
+      TFile f(fname, "recreate");
+      TTree t("t", "t");
+      int run = 0;
+      Long64_t evt = 0;
+      t.Branch("run", &run);
+      t.Branch("evt", &evt);
+      for (Long64_t e = 0; e < nEntries; ++e) {
+         run = (e * 7919) % 100;
+         evt = (e * 104729) % nEntries;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fname);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+
+   auto checkIndex = [&](const char *major, const char *minor) {
+      TTreeIndex reference(t, "run+0", "evt+0"); // formulas, evaluated entry by entry
+      TTreeIndex index(t, major, minor);
+      ASSERT_EQ(index.GetN(), nEntries);
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         ASSERT_EQ(index.GetIndex()[i], reference.GetIndex()[i]);
+         ASSERT_EQ(index.GetIndexValues()[i], reference.GetIndexValues()[i]);
+         ASSERT_EQ(index.GetIndexValuesMinor()[i], reference.GetIndexValuesMinor()[i]);
+      }
+      t->SetTreeIndex(&index);
+      EXPECT_EQ(t->GetEntryNumberWithIndex((12345 * 7919) % 100, (12345 * 104729) % nEntries), 12345);
+      t->SetTreeIndex(nullptr);
+   };
+
+   checkIndex("run", "evt");
+   checkIndex("run", "evt+0"); // only the major is read in bulk
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4); // parallel bulk read and parallel sort
+   checkIndex("run", "evt");
+   ROOT::DisableImplicitMT();
+#endif
+
+   gSystem->Unlink(fname);
+}
+
+// The compiled formulas must give the same values as the interpreted ones
+TEST(TTreeFormula, JitMatchesInterpreter)
+{
+   TTree t("t", "t");
+   t.SetDirectory(nullptr);
+   double x = 0.;
+   float y = 0.f;
+   int n = 0;
+   t.Branch("x", &x);
+   t.Branch("y", &y);
+   t.Branch("n", &n);
+   for (int e = 0; e < 100; ++e) {
+      x = (e - 50) * 0.37;
+      y = e * 0.5f;
+      n = e % 7;
+      t.Fill();
+   }
+
+   const char *expressions[] = {"x+y*2-n",     "x/n",           "n%3+sqrt(x)",        "log(x)+exp(y)-tan(x)",
+                                "x>0&&y<20",   "x<0||n==3",     "!(x>1)+1.5",         "pow(x,2)-min(x,y)+abs(x)",
+                                "(n&5)|(n<<2)", "int(x)-sign(x)", "acos(x)+atanh(y)",   "fmod(y,3)+atan2(x,y)"};
+   const auto threshold = TTreeFormula::GetJitThreshold();
+   for (auto expression : expressions) {
+      TTreeFormula::SetJitThreshold(-1);
+      TTreeFormula interpreted("interpreted", expression, &t);
+      TTreeFormula::SetJitThreshold(0);
+      TTreeFormula jitted("jitted", expression, &t);
+      for (Long64_t e = 0; e < t.GetEntries(); ++e) {
+         t.LoadTree(e);
+         const double expected = interpreted.EvalInstance();
+         EXPECT_DOUBLE_EQ(jitted.EvalInstance(), expected) << expression << " entry " << e;
+      }
+      EXPECT_TRUE(jitted.IsJitted()) << expression;
+      EXPECT_FALSE(interpreted.IsJitted()) << expression;
+   }
+
+   // unsupported constructs are interpreted
+   TTreeFormula::SetJitThreshold(0);
+   TTreeFormula conditional("conditional", "x>0 ? y : n", &t);
+   t.LoadTree(0);
+   EXPECT_DOUBLE_EQ(conditional.EvalInstance(), 0.);
+   EXPECT_FALSE(conditional.IsJitted());
+   TTreeFormula::SetJitThreshold(threshold);
+}
+
+TEST(TTreeReader, FriendCacheFollowsEntryRange)
+{
+   const auto mainFile = "treereader_friendcache_main.root";
+   const auto friendFile = "treereader_friendcache_friend.root";
+   for (auto fname : {mainFile, friendFile}) {
+      TFile f(fname, "recreate");
+      TTree t(fname == mainFile ? "main" : "aux", "t");
+      int x = 0;
+      t.Branch(fname == mainFile ? "x" : "y", &x);
+      for (x = 0; x < 100; ++x)
+         t.Fill();
+      t.Write();
+   }
+
+   TFile f(mainFile);
+   auto mainTree = f.Get<TTree>("main");
+   mainTree->AddFriend("aux", friendFile);
+   TTreeReader r(mainTree);
+   r.SetEntriesRange(10, 20);
+   TTreeReaderValue<int> x(r, "x");
+   TTreeReaderValue<int> y(r, "aux.y");
+   int n = 0;
+   while (r.Next()) {
+      EXPECT_EQ(*x, *y);
+      ++n;
+   }
+   EXPECT_EQ(n, 10);
+
+   // the cache of the friend is restricted to the entry range and holds the branch read
+   auto auxTree = mainTree->GetFriend("aux");
+   ASSERT_NE(auxTree, nullptr);
+   auto cache = auxTree->GetReadCache(auxTree->GetCurrentFile());
+   ASSERT_NE(cache, nullptr);
+   EXPECT_EQ(cache->GetEntryMin(), 10);
+   EXPECT_EQ(cache->GetEntryMax(), 20);
+   EXPECT_FALSE(cache->IsLearning());
+   EXPECT_NE(cache->GetCachedBranches()->FindObject(auxTree->GetBranch("y")), nullptr);
+
+   gSystem->Unlink(mainFile);
+   gSystem->Unlink(friendFile);
+}
@@ -6,7 +6,11 @@
 #include <thread>
 #include <utility>
 
+#include <TChain.h>
 #include <TFile.h>
+#include <TH1D.h>
+#include <TProfile.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TSystem.h>
 #include <TTreeReader.h>
@@ -518,3 +522,72 @@ TEST(TreeProcessorMT, TreesInSameFile)
    gSystem->Unlink(fname.c_str());
    ROOT::DisableImplicitMT();
 }
+
+TEST(TreeProcessorMT, SplitClusters)
+{
+   // a single cluster of 10 entries
+   const auto filename = "TreeProcessorMT_SplitClusters.root";
+   const auto treename = "t";
+   WriteFiles({treename}, {filename});
+
+   std::mutex m;
+   std::vector<std::pair<Long64_t, Long64_t>> clusters;
+   auto get_clusters = [&m, &clusters](TTreeReader &t) {
+      std::lock_guard<std::mutex> l(m);
+      clusters.emplace_back(t.GetEntriesRange());
+   };
+
+   ROOT::EnableImplicitMT(2);
+   ROOT::TTreeProcessorMT::SetMaxTasksPerCluster(4);
+   {
+      ROOT::TTreeProcessorMT p(filename, treename);
+      p.Process(get_clusters);
+   }
+   ROOT::TTreeProcessorMT::SetMaxTasksPerCluster(1);
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(clusters.size(), 4u);
+   CheckClusters(clusters, 10);
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TreeProcessorMT, ParallelDraw)
+{
+   const auto nFiles = 8u;
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < nFiles; ++i)
+      filenames.emplace_back("treeprocmt_paralleldraw" + std::to_string(i) + ".root");
+   WriteFiles(std::vector<std::string>(nFiles, "t"), filenames);
+
+   TChain chain("t");
+   for (const auto &f : filenames)
+      chain.Add(f.c_str());
+   chain.SetAlias("w", "v % 3 ? 2. : 1.");
+
+   chain.Draw("v>>hseq(100,0,100)", "w * (v > 5)", "goff");
+   chain.Draw("v/2.:v>>pseq(10,0,100)", "", "goff prof");
+   ROOT::EnableImplicitMT(4);
+   const auto nSelected = chain.Draw("v>>hmt(100,0,100)", "w * (v > 5)", "goff");
+   chain.Draw("v/2.:v>>pmt(10,0,100)", "", "goff prof");
+   ROOT::DisableImplicitMT();
+
+   auto hseq = static_cast<TH1 *>(gROOT->FindObject("hseq"));
+   auto hmt = static_cast<TH1 *>(gROOT->FindObject("hmt"));
+   ASSERT_TRUE(hseq && hmt);
+   EXPECT_EQ(nSelected, 75);
+   EXPECT_EQ(hseq->GetEntries(), hmt->GetEntries());
+   for (int bin = 0; bin < hseq->GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(hseq->GetBinContent(bin), hmt->GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(hseq->GetBinError(bin), hmt->GetBinError(bin));
+   }
+   auto pseq = static_cast<TProfile *>(gROOT->FindObject("pseq"));
+   auto pmt = static_cast<TProfile *>(gROOT->FindObject("pmt"));
+   ASSERT_TRUE(pseq && pmt);
+   for (int bin = 0; bin < pseq->GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(pseq->GetBinContent(bin), pmt->GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(pseq->GetBinEntries(bin), pmt->GetBinEntries(bin));
+   }
+
+   DeleteFiles(filenames);
+}
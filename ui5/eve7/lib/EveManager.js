@@ -464,7 +464,15 @@ sap.ui.define([], function() {
             rd.matrix = new Float32Array(rawdata, off, rd.trans_size);
             off += rd.trans_size*4;
          }
-         if (rd.vert_size) {
+         if (rd.vert_size && rd.vert_quant) {
+            // 16-bit quantized components, padded to 4 bytes
+            let q = new Uint16Array(rawdata, off, rd.vert_size),
+                vtx = new Float32Array(rd.vert_size), vq = rd.vert_quant;
+            for (let i = 0; i < rd.vert_size; ++i)
+               vtx[i] = vq[i%3] + q[i]*vq[3 + i%3];
+            rd.vtxBuff = vtx;
+            off += Math.ceil(rd.vert_size/2)*4;
+         } else if (rd.vert_size) {
             rd.vtxBuff = new Float32Array(rawdata, off, rd.vert_size);
             off += rd.vert_size*4;
          }